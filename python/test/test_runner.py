@@ -19,8 +19,8 @@ import tempfile
 import unittest
 
 import pyarrow
-from pyvelox.arrow import to_velox
-from pyvelox.file import DWRF
+from pyvelox.arrow import to_arrow_batches, to_velox
+from pyvelox.file import DWRF, list_files
 from pyvelox.plan_builder import PlanBuilder
 from pyvelox.runner import (
     LocalRunner,
@@ -91,6 +91,31 @@ class TestPyVeloxRunner(unittest.TestCase):
             total_size += vector.size()
         self.assertEqual(total_size, 100)
 
+    def test_arrow_batches(self):
+        vectors = []
+        batch_size = 10
+        num_batches = 10
+
+        for i in range(num_batches):
+            array = pyarrow.array(list(range(i * batch_size, (i + 1) * batch_size)))
+            strings = pyarrow.array([str(x) for x in array.to_pylist()])
+            batch = pyarrow.record_batch([array, strings], names=["c0", "c1"])
+            vectors.append(to_velox(batch))
+
+        plan_builder = PlanBuilder().values(vectors)
+        runner = LocalRunner(plan_builder.get_plan_node())
+
+        # A small buffer keeps the task at most a few batches ahead.
+        values = []
+        for zero_copy in (False, True):
+            values.clear()
+            iterator = runner.execute(max_buffered_bytes=1024)
+            for batch in to_arrow_batches(iterator, zero_copy=zero_copy):
+                self.assertTrue(isinstance(batch, pyarrow.RecordBatch))
+                self.assertEqual(batch.schema.names, ["c0", "c1"])
+                values.extend(batch.column(0).to_pylist())
+            self.assertEqual(values, list(range(batch_size * num_batches)))
+
     def test_values_order_limit(self):
         vectors = []
         batch_size = 10
@@ -368,6 +393,25 @@ class TestPyVeloxRunner(unittest.TestCase):
                 output_rows += vector.size()
             self.assertEqual(output_rows, 6005)
 
+            # Scan the directory again with small splits and multiple drivers.
+            # Each stripe is read by exactly one split.
+            input_files = list_files(temp_dir, "dwrf")
+            self.assertEqual(num_output_files, len(input_files))
+            scan_plan_builder = PlanBuilder()
+            scan_plan_builder.table_scan(
+                output_schema=ROW(["l_orderkey", "l_partkey"], [BIGINT()] * 2),
+                connector_id="hive",
+                input_files=input_files,
+                split_size_bytes=1024,
+            )
+
+            runner = LocalRunner(scan_plan_builder.get_plan_node())
+            output_rows = 0
+
+            for vector in runner.execute(max_drivers=4):
+                output_rows += vector.size()
+            self.assertEqual(output_rows, 6005)
+
     def extract_file(self, output_vector):
         # Parse and return the output file name from the writer's output.
         output_json = json.loads(output_vector.child_at(1)[1])
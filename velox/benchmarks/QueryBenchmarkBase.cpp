@@ -174,6 +174,7 @@ void QueryBenchmarkBase::initialize() {
     options.allocatorCapacity = memoryBytes;
     options.useMmapArena = true;
     options.mmapArenaCapacityRatio = 1;
+    setMemoryManagerOptions(options);
     memory::MemoryManager::testingSetInstance(options);
     std::unique_ptr<cache::SsdCache> ssdCache;
     if (FLAGS_ssd_cache_gb) {
@@ -193,7 +194,9 @@ void QueryBenchmarkBase::initialize() {
         memory::memoryManager()->allocator(), std::move(ssdCache));
     cache::AsyncDataCache::setInstance(cache_.get());
   } else {
-    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+    memory::MemoryManager::Options options;
+    setMemoryManagerOptions(options);
+    memory::MemoryManager::testingSetInstance(options);
   }
   functions::prestosql::registerAllScalarFunctions();
   aggregate::prestosql::registerAllAggregateFunctions();
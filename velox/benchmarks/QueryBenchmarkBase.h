@@ -85,6 +85,10 @@ class QueryBenchmarkBase {
   virtual std::shared_ptr<config::ConfigBase> makeConnectorProperties();
 
  protected:
+  /// Customizes the options of the memory manager created by initialize().
+  virtual void setMemoryManagerOptions(
+      memory::MemoryManager::Options& /*options*/) {}
+
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
   std::shared_ptr<memory::MemoryAllocator> allocator_;
@@ -87,6 +87,21 @@ int main(int argc, char** argv) {
       [](auto row) { return fmt::format("2024-05-{:02d}", 1 + row % 30); });
   auto invalidDateStrings = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto row) { return fmt::format("2024-05...{}", row); });
+  auto validTimestampStrings = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) {
+        return fmt::format(
+            "2024-05-{:02d} {:02d}:{:02d}:{:02d}.{:03d}",
+            1 + row % 30,
+            row % 24,
+            row % 60,
+            (row * 7) % 60,
+            row % 1000);
+      });
+  auto bigintStrings = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) { return std::to_string(row * 1234567891LL); });
+  auto scientificDoubleStrings = vectorMaker.flatVector<std::string>(
+      vectorSize,
+      [](auto row) { return fmt::format("{}.25e-{}", row, row % 20); });
 
   benchmarkBuilder
       .addBenchmarkSet(
@@ -119,6 +134,20 @@ int main(int argc, char** argv) {
           "tryexpr_cast_invalid_input", "try(cast (invalid_date as timestamp))")
       .addExpression("cast_valid", "cast(valid_date as timestamp)");
 
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_varchar_with_time_as_timestamp",
+          vectorMaker.rowVector({"valid"}, {validTimestampStrings}))
+      .addExpression("cast_valid", "cast(valid as timestamp)")
+      .addExpression("try_cast_valid", "try_cast(valid as timestamp)");
+
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_varchar_as_bigint",
+          vectorMaker.rowVector({"valid"}, {bigintStrings}))
+      .addExpression("cast_valid", "cast(valid as bigint)")
+      .addExpression("try_cast_valid", "try_cast(valid as bigint)");
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast_timestamp_as_varchar",
@@ -130,18 +159,23 @@ int main(int argc, char** argv) {
           "cast_varchar_as_double",
           vectorMaker.rowVector(
               {"valid",
+               "valid_scientific",
                "valid_nan",
                "valid_infinity",
                "invalid_nan",
                "invalid_infinity",
                "space"},
               {validDoubleStringInput,
+               scientificDoubleStrings,
                validNaNInput,
                validInfinityInput,
                invalidNaNInput,
                invalidInfinityInput,
                spaceInput}))
       .addExpression("cast_valid", "cast (valid as double)")
+      .addExpression("cast_valid_real", "cast (valid as real)")
+      .addExpression(
+          "cast_valid_scientific", "cast (valid_scientific as double)")
       .addExpression("cast_valid_nan", "cast (valid_nan as double)")
       .addExpression("cast_valid_infinity", "cast (valid_infinity as double)")
       .addExpression("try_cast_invalid_nan", "try_cast (invalid_nan as double)")
@@ -35,11 +35,34 @@ int main(int argc, char** argv) {
   VectorFuzzer fuzzer(options, pool);
   auto vectorMaker = benchmarkBuilder.vectorMaker();
 
+  auto formats = vectorMaker.flatVector<std::string>(
+      options.vectorSize, [](auto row) {
+        return row % 2 == 0 ? "yyyy-MM-dd HH:mm:ss.SSS" : "yyyy-MM-dd";
+      });
   benchmarkBuilder
       .addBenchmarkSet(
           "Benchmark format_datetime",
-          vectorMaker.rowVector({fuzzer.fuzz(TIMESTAMP())}))
+          vectorMaker.rowVector({fuzzer.fuzz(TIMESTAMP()), formats}))
       .addExpression("", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss.SSS')")
+      .addExpression("non_constant_format", "format_datetime(c0, c1)")
+      .disableTesting();
+
+  auto strings = vectorMaker.flatVector<std::string>(
+      options.vectorSize, [](auto row) {
+        return fmt::format(
+            "{}-{:02}-{:02} {:02}:{:02}:{:02}.{:03}",
+            1970 + row % 100,
+            1 + row % 12,
+            1 + row % 28,
+            row % 24,
+            row % 60,
+            (row * 7) % 60,
+            row % 1000);
+      });
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "Benchmark parse_datetime", vectorMaker.rowVector({strings}))
+      .addExpression("", "parse_datetime(c0, 'yyyy-MM-dd HH:mm:ss.SSS')")
       .disableTesting();
 
   benchmarkBuilder.registerBenchmarks();
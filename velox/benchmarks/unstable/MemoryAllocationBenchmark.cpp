@@ -33,6 +33,10 @@ DEFINE_int64(
     memory_free_every_n_operations,
     5,
     "Specifies memory free for every N operations. If it is 5, then we free one of existing memory allocation for every 5 memory operations");
+DEFINE_int64(
+    small_allocation_cache_bytes,
+    256 << 10,
+    "The small allocation cache bytes per thread shard of the leaf memory pool in the small allocation cache benchmarks");
 
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
@@ -50,10 +54,12 @@ class MemoryPoolAllocationBenchMark {
       Type type,
       uint16_t alignment,
       size_t minSize,
-      size_t maxSize)
+      size_t maxSize,
+      int64_t smallAllocationCacheBytes = 0)
       : type_(type), minSize_(minSize), maxSize_(maxSize) {
     MemoryManager::Options options;
     options.alignment = alignment;
+    options.leafSmallAllocationCacheBytes = smallAllocationCacheBytes;
     switch (type_) {
       case Type::kMmap:
         manager_ = std::make_shared<MemoryManager>(options);
@@ -212,6 +218,12 @@ BENCHMARK_RELATIVE_MULTI(MmapAllocateSmall64) {
   return benchmark.runAllocate();
 }
 
+BENCHMARK_RELATIVE_MULTI(MmapAllocateSmall64WithCache) {
+  MemoryPoolAllocationBenchMark benchmark(
+      Type::kMmap, 64, 128, 3072, FLAGS_small_allocation_cache_bytes);
+  return benchmark.runAllocate();
+}
+
 BENCHMARK_MULTI(StdAllocateMidNoAlignment) {
   MemoryPoolAllocationBenchMark benchmark(Type::kStd, 16, 4 << 10, 1 << 20);
   return benchmark.runAllocate();
@@ -293,6 +305,12 @@ BENCHMARK_RELATIVE_MULTI(MmapAllocateZeroFilledSmall64) {
   return benchmark.runAllocateZeroFilled();
 }
 
+BENCHMARK_RELATIVE_MULTI(MmapAllocateZeroFilledSmall64WithCache) {
+  MemoryPoolAllocationBenchMark benchmark(
+      Type::kMmap, 64, 128, 3072, FLAGS_small_allocation_cache_bytes);
+  return benchmark.runAllocateZeroFilled();
+}
+
 BENCHMARK_MULTI(StdAllocateZeroFilledMidNoAlignment) {
   MemoryPoolAllocationBenchMark benchmark(Type::kStd, 16, 4 << 10, 1 << 20);
   return benchmark.runAllocateZeroFilled();
@@ -373,6 +391,12 @@ BENCHMARK_RELATIVE_MULTI(MmapReallocateSmall64) {
   return benchmark.runReallocate();
 }
 
+BENCHMARK_RELATIVE_MULTI(MmapReallocateSmall64WithCache) {
+  MemoryPoolAllocationBenchMark benchmark(
+      Type::kMmap, 64, 128, 3072, FLAGS_small_allocation_cache_bytes);
+  return benchmark.runReallocate();
+}
+
 BENCHMARK_MULTI(StdReallocateMidNoAlignment) {
   MemoryPoolAllocationBenchMark benchmark(Type::kStd, 16, 4 << 10, 1 << 20);
   return benchmark.runReallocate();
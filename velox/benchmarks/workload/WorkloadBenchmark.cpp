@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/benchmarks/workload/WorkloadBenchmark.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/json.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/core/PlanNode.h"
+#include "velox/exec/PartitionFunction.h"
+#include "velox/exec/TaskTraceReader.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+DEFINE_string(
+    workload_file,
+    "",
+    "Path of the JSON file describing the workload. The file has a 'queries' "
+    "array. Each query has a 'name', either a 'plan' path to a PlanNode JSON "
+    "file or a 'taskTraceDir' path to a task trace directory, a 'dataFiles' "
+    "object mapping table scan plan node IDs to lists of data file or "
+    "directory paths, and optionally a 'dataFormat' (parquet or dwrf, "
+    "defaults to --data_format), a 'weight' giving its relative frequency in "
+    "the mix and 'queryConfigs' overriding the traced query configs.");
+namespace {
+static bool notEmpty(const char* /*flagName*/, const std::string& value) {
+  return !value.empty();
+}
+} // namespace
+
+DEFINE_validator(workload_file, &notEmpty);
+
+DEFINE_int32(num_queries, 100, "Number of queries to run");
+DEFINE_double(
+    arrival_rate,
+    0,
+    "Queries per second. The queries arrive as a Poisson process and wait for "
+    "a free slot if --max_concurrent_queries are running. If 0, the queries "
+    "run back to back in --max_concurrent_queries slots");
+DEFINE_int32(max_concurrent_queries, 8, "Maximum number of running queries");
+DEFINE_int32(workload_seed, 0, "Seed of the query mix and arrival times");
+DEFINE_string(
+    workload_arbitrator_kind,
+    "",
+    "Memory arbitrator kind, e.g. SHARED. Uses the default one if empty");
+DEFINE_int64(
+    workload_memory_mb,
+    0,
+    "Memory capacity for all queries in MB. Unlimited if 0");
+DEFINE_int64(
+    query_memory_mb,
+    0,
+    "Memory capacity of each query in MB. Unlimited if 0");
+DEFINE_string(
+    workload_spill_dir,
+    "",
+    "Directory under which each query spills if spilling is enabled in its "
+    "query configs");
+
+DECLARE_int32(num_drivers);
+DECLARE_int32(num_splits_per_file);
+
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace facebook::velox {
+namespace {
+
+std::string readFile(const std::string& path) {
+  std::ifstream file(path);
+  VELOX_USER_CHECK(file.good(), "Failed to open {}", path);
+  return std::string(
+      std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Returns the 'percentile' of the 'sorted' values, with 0 < percentile <= 1.
+uint64_t percentile(const std::vector<uint64_t>& sorted, double percentile) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  const auto index = static_cast<size_t>(std::ceil(percentile * sorted.size()));
+  return sorted[std::clamp<size_t>(index, 1, sorted.size()) - 1];
+}
+
+std::string latencySummary(std::vector<uint64_t> latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  return fmt::format(
+      "p50 {} p95 {} p99 {} max {}",
+      succinctMicros(percentile(latencies, 0.5)),
+      succinctMicros(percentile(latencies, 0.95)),
+      succinctMicros(percentile(latencies, 0.99)),
+      succinctMicros(latencies.empty() ? 0 : latencies.back()));
+}
+
+} // namespace
+
+void WorkloadBenchmark::setMemoryManagerOptions(
+    memory::MemoryManager::Options& options) {
+  if (!FLAGS_workload_arbitrator_kind.empty()) {
+    memory::SharedArbitrator::registerFactory();
+    options.arbitratorKind = FLAGS_workload_arbitrator_kind;
+  }
+  if (FLAGS_workload_memory_mb > 0) {
+    options.arbitratorCapacity = FLAGS_workload_memory_mb << 20;
+  }
+}
+
+void WorkloadBenchmark::initialize() {
+  QueryBenchmarkBase::initialize();
+  Type::registerSerDe();
+  common::Filter::registerSerDe();
+  core::PlanNode::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+  exec::registerPartitionFunctionSerDe();
+  connector::hive::HiveConnector::registerSerDe();
+  pool_ = memory::memoryManager()->addLeafPool("workloadBenchmark");
+  loadWorkload(FLAGS_workload_file);
+}
+
+void WorkloadBenchmark::loadWorkload(const std::string& path) {
+  const auto workload = folly::parseJson(readFile(path));
+  for (const auto& queryObj : workload["queries"]) {
+    WorkloadQuery query;
+    query.name = queryObj["name"].asString();
+    if (const auto* traceDir = queryObj.get_ptr("taskTraceDir")) {
+      const trace::TaskTraceMetadataReader reader(
+          traceDir->asString(), pool_.get());
+      query.plan.plan = reader.queryPlan();
+      query.queryConfigs = reader.queryConfigs();
+    } else {
+      query.plan.plan = ISerializable::deserialize<core::PlanNode>(
+          folly::parseJson(readFile(queryObj["plan"].asString())),
+          pool_.get());
+    }
+    if (const auto* configs = queryObj.get_ptr("queryConfigs")) {
+      for (const auto& [key, value] : configs->items()) {
+        query.queryConfigs[key.asString()] = value.asString();
+      }
+    }
+    if (const auto* dataFiles = queryObj.get_ptr("dataFiles")) {
+      for (const auto& [nodeId, files] : dataFiles->items()) {
+        auto& paths = query.plan.dataFiles[nodeId.asString()];
+        for (const auto& file : files) {
+          paths.push_back(file.asString());
+        }
+      }
+    }
+    query.plan.dataFileFormat = dwio::common::toFileFormat(
+        queryObj.getDefault("dataFormat", FLAGS_data_format).asString());
+    query.weight = queryObj.getDefault("weight", 1.0).asDouble();
+    VELOX_USER_CHECK_GT(
+        query.weight, 0, "Query {} must have a positive weight", query.name);
+    queries_.push_back(std::move(query));
+  }
+  VELOX_USER_CHECK(!queries_.empty(), "Workload {} has no queries", path);
+}
+
+WorkloadQueryRun WorkloadBenchmark::runQuery(
+    int32_t queryIndex,
+    int32_t sequence,
+    std::chrono::steady_clock::time_point arrivalTime) {
+  const auto& query = queries_[queryIndex];
+  WorkloadQueryRun run;
+  run.queryIndex = queryIndex;
+
+  CursorParameters params;
+  params.planNode = query.plan.plan;
+  params.maxDrivers = FLAGS_num_drivers;
+  params.queryConfigs = query.queryConfigs;
+  params.copyResult = false;
+  if (FLAGS_query_memory_mb > 0) {
+    params.maxQueryCapacity = FLAGS_query_memory_mb << 20;
+  }
+  if (!FLAGS_workload_spill_dir.empty()) {
+    params.spillDirectory =
+        fmt::format("{}/{}_{}", FLAGS_workload_spill_dir, query.name, sequence);
+  }
+  auto addSplits = [&](TaskCursor* taskCursor) {
+    if (!taskCursor->noMoreSplits()) {
+      auto& task = taskCursor->task();
+      for (const auto& [nodeId, paths] : query.plan.dataFiles) {
+        for (const auto& path : paths) {
+          for (auto& split :
+               listSplits(path, FLAGS_num_splits_per_file, query.plan)) {
+            task->addSplit(nodeId, exec::Split(std::move(split)));
+          }
+        }
+        task->noMoreSplits(nodeId);
+      }
+    }
+    taskCursor->setNoMoreSplits();
+  };
+
+  try {
+    auto [cursor, results] = readCursor(params, addSplits);
+    ensureTaskCompletion(cursor->task().get());
+    const auto stats = cursor->task()->taskStats();
+    for (const auto& pipeline : stats.pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        run.spilledBytes += op.spilledBytes;
+        if (op.operatorType == "TableScan") {
+          run.rawInputBytes += op.rawInputBytes;
+        }
+      }
+    }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Query " << query.name << " failed: " << e.what();
+    run.failed = true;
+  }
+  run.latencyMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - arrivalTime)
+                          .count();
+  return run;
+}
+
+void WorkloadBenchmark::runMain(std::ostream& out, RunStats& runStats) {
+  std::mt19937 rng(FLAGS_workload_seed);
+  std::vector<double> weights;
+  for (const auto& query : queries_) {
+    weights.push_back(query.weight);
+  }
+  std::discrete_distribution<int32_t> pickQuery(weights.begin(), weights.end());
+  std::exponential_distribution<double> interArrival(
+      FLAGS_arrival_rate > 0 ? FLAGS_arrival_rate : 1);
+
+  std::vector<WorkloadQueryRun> runs(FLAGS_num_queries);
+  const auto arbitrationStatsBefore =
+      memory::memoryManager()->arbitrator()->stats();
+  const auto startTime = std::chrono::steady_clock::now();
+  {
+    folly::CPUThreadPoolExecutor executor(FLAGS_max_concurrent_queries);
+    auto nextArrival = startTime;
+    for (auto i = 0; i < FLAGS_num_queries; ++i) {
+      const auto queryIndex = pickQuery(rng);
+      if (FLAGS_arrival_rate > 0) {
+        nextArrival += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::duration<double>(interArrival(rng)));
+        std::this_thread::sleep_until(nextArrival);
+        executor.add([this, &runs, i, queryIndex, arrival = nextArrival]() {
+          runs[i] = runQuery(queryIndex, i, arrival);
+        });
+      } else {
+        // In the closed loop the latency starts when a slot is free.
+        executor.add([this, &runs, i, queryIndex]() {
+          runs[i] = runQuery(queryIndex, i, std::chrono::steady_clock::now());
+        });
+      }
+    }
+    executor.join();
+  }
+  const auto wallMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - startTime)
+                              .count();
+  const auto arbitrationStats =
+      memory::memoryManager()->arbitrator()->stats() - arbitrationStatsBefore;
+
+  printReport(runs, wallMicros, arbitrationStats, out);
+  runStats.micros = wallMicros;
+  for (const auto& run : runs) {
+    runStats.rawInputBytes += run.rawInputBytes;
+  }
+}
+
+void WorkloadBenchmark::printReport(
+    const std::vector<WorkloadQueryRun>& runs,
+    uint64_t wallMicros,
+    const memory::MemoryArbitrator::Stats& arbitrationStats,
+    std::ostream& out) const {
+  std::vector<uint64_t> latencies;
+  std::vector<std::vector<uint64_t>> queryLatencies(queries_.size());
+  int32_t numFailed = 0;
+  uint64_t spilledBytes = 0;
+  for (const auto& run : runs) {
+    if (run.failed) {
+      ++numFailed;
+      continue;
+    }
+    latencies.push_back(run.latencyMicros);
+    queryLatencies[run.queryIndex].push_back(run.latencyMicros);
+    spilledBytes += run.spilledBytes;
+  }
+
+  out << fmt::format(
+             "Queries: {} succeeded, {} failed in {}, {:.2f} queries/s",
+             latencies.size(),
+             numFailed,
+             succinctMicros(wallMicros),
+             latencies.size() * 1'000'000.0 / std::max<uint64_t>(wallMicros, 1))
+      << std::endl;
+  out << "Latency: " << latencySummary(latencies) << std::endl;
+  out << "Spilled: " << succinctBytes(spilledBytes) << std::endl;
+  out << "Memory arbitration: " << arbitrationStats.toString() << std::endl;
+  for (auto i = 0; i < queries_.size(); ++i) {
+    out << fmt::format(
+               "  {}: {} runs, {}",
+               queries_[i].name,
+               queryLatencies[i].size(),
+               latencySummary(queryLatencies[i]))
+        << std::endl;
+  }
+}
+
+void workloadBenchmarkMain() {
+  WorkloadBenchmark benchmark;
+  benchmark.initialize();
+  if (FLAGS_test_flags_file.empty()) {
+    RunStats ignore;
+    benchmark.runMain(std::cout, ignore);
+  } else {
+    benchmark.runAllCombinations();
+  }
+  benchmark.shutdown();
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/benchmarks/QueryBenchmarkBase.h"
+
+namespace facebook::velox {
+
+/// A query of a workload: a serialized plan with its data files, query
+/// configs and relative frequency in the mix.
+struct WorkloadQuery {
+  std::string name;
+  exec::test::TpchPlan plan;
+  std::unordered_map<std::string, std::string> queryConfigs;
+  double weight{1};
+};
+
+/// The outcome of one execution of a WorkloadQuery.
+struct WorkloadQueryRun {
+  int32_t queryIndex{0};
+  /// Time from the arrival of the query to its completion. Includes the time
+  /// the query waited for a free slot when queries arrive faster than they
+  /// complete.
+  uint64_t latencyMicros{0};
+  uint64_t spilledBytes{0};
+  int64_t rawInputBytes{0};
+  bool failed{false};
+};
+
+/// Replays a mix of serialized plans concurrently and reports the throughput,
+/// the latency percentiles, the memory arbitration stats and the spill volume
+/// of the run. The plans come from task trace directories written by the
+/// query tracer or from PlanNode JSON files, as listed in the workload file
+/// given by --workload_file.
+class WorkloadBenchmark : public QueryBenchmarkBase {
+ public:
+  void initialize() override;
+
+  void runMain(std::ostream& out, RunStats& runStats) override;
+
+ protected:
+  void setMemoryManagerOptions(
+      memory::MemoryManager::Options& options) override;
+
+ private:
+  void loadWorkload(const std::string& path);
+
+  WorkloadQueryRun runQuery(
+      int32_t queryIndex,
+      int32_t sequence,
+      std::chrono::steady_clock::time_point arrivalTime);
+
+  void printReport(
+      const std::vector<WorkloadQueryRun>& runs,
+      uint64_t wallMicros,
+      const memory::MemoryArbitrator::Stats& arbitrationStats,
+      std::ostream& out) const;
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::vector<WorkloadQuery> queries_;
+};
+
+void workloadBenchmarkMain();
+
+} // namespace facebook::velox
@@ -16,6 +16,7 @@
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/io/IoStatistics.h"
 
 namespace facebook::velox {
 
@@ -457,6 +458,25 @@ void registerVeloxMetrics() {
       kMetricArbitratorGlobalArbitrationWaitCount,
       facebook::velox::StatType::COUNT);
 
+  // The number of proactive reclaims run by the arbitrator because the
+  // forecast memory demand would leave too little free capacity.
+  DEFINE_METRIC(
+      kMetricArbitratorProactiveReclaimCount,
+      facebook::velox::StatType::COUNT);
+
+  // The reclaimed bytes distribution of a proactive reclaim in range of [0,
+  // 32GB] with 64 buckets. It is configured to report the reclaimed bytes at
+  // P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorProactiveReclaimBytes,
+      512L << 20,
+      0,
+      32L << 30,
+      50,
+      90,
+      99,
+      100);
+
   // The time distribution of a global arbitration wait [0, 300s] with 20
   // buckets. It is configured to report the latency at P50, P90, P99, and P100
   // percentiles.
@@ -683,5 +703,33 @@ void registerVeloxMetrics() {
   // The number of times that storage IOs get throttled in a storage cluster.
   DEFINE_METRIC(
       kMetricStorageGlobalThrottled, facebook::velox::StatType::COUNT);
+
+  // Tracks the IO latency in range of [0, 10s] with 1ms buckets and the IO
+  // size in range of [0, 64MB] with 256KB buckets per storage and IO purpose,
+  // and reports P50, P90, P99, and P100.
+  for (auto source = 0; source < io::kNumIoSources; ++source) {
+    for (auto purpose = 0; purpose < io::kNumIoPurposes; ++purpose) {
+      const auto ioSource = static_cast<io::IoSource>(source);
+      const auto ioPurpose = static_cast<io::IoPurpose>(purpose);
+      DEFINE_HISTOGRAM_METRIC(
+          io::ioMetricKey(kMetricIoLatencyUs, ioSource, ioPurpose),
+          1'000,
+          0,
+          10'000'000,
+          50,
+          90,
+          99,
+          100);
+      DEFINE_HISTOGRAM_METRIC(
+          io::ioMetricKey(kMetricIoBytes, ioSource, ioPurpose),
+          256L << 10,
+          0,
+          64L << 20,
+          50,
+          90,
+          99,
+          100);
+    }
+  }
 }
 } // namespace facebook::velox
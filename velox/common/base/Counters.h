@@ -107,6 +107,12 @@ constexpr std::string_view kMetricArbitratorGlobalArbitrationWaitCount{
 constexpr std::string_view kMetricArbitratorGlobalArbitrationWaitTimeMs{
     "velox.arbitrator_global_arbitration_wait_time_ms"};
 
+constexpr std::string_view kMetricArbitratorProactiveReclaimCount{
+    "velox.arbitrator_proactive_reclaim_count"};
+
+constexpr std::string_view kMetricArbitratorProactiveReclaimBytes{
+    "velox.arbitrator_proactive_reclaim_bytes"};
+
 constexpr std::string_view kMetricArbitratorAbortedCount{
     "velox.arbitrator_aborted_count"};
 
@@ -363,6 +369,13 @@ constexpr std::string_view kMetricStorageGlobalThrottled{
 constexpr std::string_view kMetricStorageNetworkThrottled{
     "velox.storage_network_throttled_count"};
 
+/// Prefixes of the IO latency and size histograms. The metric of a storage
+/// and IO purpose is named by io::ioMetricKey(), e.g.
+/// "velox.io_latency_us.s3.data".
+constexpr std::string_view kMetricIoLatencyUs{"velox.io_latency_us"};
+
+constexpr std::string_view kMetricIoBytes{"velox.io_bytes"};
+
 constexpr std::string_view kMetricIndexLookupResultRawBytes{
     "velox.index_lookup_result_raw_bytes"};
 
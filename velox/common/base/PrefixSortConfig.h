@@ -27,10 +27,12 @@ struct PrefixSortConfig {
   PrefixSortConfig(
       uint32_t _maxNormalizedKeyBytes,
       uint32_t _minNumRows,
-      uint32_t _maxStringPrefixLength)
+      uint32_t _maxStringPrefixLength,
+      uint32_t _minNumRadixSortRows = 1024)
       : maxNormalizedKeyBytes(_maxNormalizedKeyBytes),
         minNumRows(_minNumRows),
-        maxStringPrefixLength(_maxStringPrefixLength) {}
+        maxStringPrefixLength(_maxStringPrefixLength),
+        minNumRadixSortRows(_minNumRadixSortRows) {}
 
   /// Maximum bytes that can be used to store normalized keys in prefix-sort
   /// buffer per entry. Same with QueryConfig kPrefixSortNormalizedKeyMaxBytes.
@@ -43,5 +45,11 @@ struct PrefixSortConfig {
   /// Maximum number of bytes to be stored in prefix-sort buffer for a string
   /// column.
   uint32_t maxStringPrefixLength{16};
+
+  /// Minimum number of rows to sort the normalized keys with radix sort
+  /// instead of quick sort. Radix sort is only used if the normalized keys
+  /// fully determine the order and take at most 16 bytes. Same with
+  /// QueryConfig kPrefixSortMinRadixSortRows.
+  uint32_t minNumRadixSortRows{1024};
 };
 } // namespace facebook::velox::common
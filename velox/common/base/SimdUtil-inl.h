@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <cstring>
 #include <numeric>
 
 #if XSIMD_WITH_NEON
@@ -1871,7 +1872,9 @@ simdStrstr(const char* s, size_t n, const char* needle, size_t k) {
       return 0;
 
     case 1: {
-      const char* res = strchr(s, needle[0]);
+      // 's' need not be null terminated.
+      const auto* res =
+          reinterpret_cast<const char*>(std::memchr(s, needle[0], n));
 
       return (res != nullptr) ? res - s : std::string::npos;
     }
@@ -18,6 +18,27 @@
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox::common {
+std::string spillFileFormatName(SpillFileFormat format) {
+  switch (format) {
+    case SpillFileFormat::kPresto:
+      return "presto";
+    case SpillFileFormat::kColumnar:
+      return "columnar";
+  }
+  VELOX_UNREACHABLE(
+      "Unknown spill file format: {}", static_cast<int32_t>(format));
+}
+
+SpillFileFormat spillFileFormatFromName(const std::string& name) {
+  if (name == "presto") {
+    return SpillFileFormat::kPresto;
+  }
+  if (name == "columnar") {
+    return SpillFileFormat::kColumnar;
+  }
+  VELOX_USER_FAIL("Unknown spill file format: {}", name);
+}
+
 SpillConfig::SpillConfig(
     GetSpillDirectoryPathCB _getSpillDirPathCb,
     UpdateAndCheckSpillLimitCB _updateAndCheckSpillLimitCb,
@@ -37,7 +58,11 @@ SpillConfig::SpillConfig(
     uint32_t _numMaxMergeFiles,
     std::optional<PrefixSortConfig> _prefixSortConfig,
     const std::string& _fileCreateConfig,
-    uint32_t _windowMinReadBatchRows)
+    uint32_t _windowMinReadBatchRows,
+    const std::string& _fileFormat,
+    bool _asyncWriteEnabled,
+    uint8_t _sortMergePartitionBits,
+    GetSpillDirectoryPathCB _getSpillOverflowDirPathCb)
     : getSpillDirPathCb(std::move(_getSpillDirPathCb)),
       updateAndCheckSpillLimitCb(std::move(_updateAndCheckSpillLimitCb)),
       fileNamePrefix(std::move(_fileNamePrefix)),
@@ -58,7 +83,11 @@ SpillConfig::SpillConfig(
       numMaxMergeFiles(_numMaxMergeFiles),
       prefixSortConfig(_prefixSortConfig),
       fileCreateConfig(_fileCreateConfig),
-      windowMinReadBatchRows(_windowMinReadBatchRows) {
+      windowMinReadBatchRows(_windowMinReadBatchRows),
+      fileFormat(spillFileFormatFromName(_fileFormat)),
+      asyncWriteEnabled(_asyncWriteEnabled),
+      sortMergePartitionBits(_sortMergePartitionBits),
+      getSpillOverflowDirPathCb(std::move(_getSpillOverflowDirPathCb)) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
@@ -67,6 +96,11 @@ SpillConfig::SpillConfig(
       numMaxMergeFiles,
       1,
       "NumMaxMergeFiles should not be 1 as merging should take at least 2 files to make progress");
+  // Same as the max partition bits of a spill level.
+  VELOX_USER_CHECK_LE(
+      sortMergePartitionBits,
+      3,
+      "Sort merge partition bits should not be more than 3");
 }
 
 int32_t SpillConfig::spillLevel(uint8_t startBitOffset) const {
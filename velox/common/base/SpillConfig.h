@@ -57,8 +57,25 @@ struct SpillDiskOptions {
   std::string spillDirPath;
   bool spillDirCreated{true};
   std::function<std::string()> spillDirCreateCb{nullptr};
+  /// The directory for the spill files that overflow the node-wide local
+  /// spill quota, e.g. on an object store. No overflow if empty. The
+  /// directory is created on first use and removed with the spill directory.
+  std::string spillOverflowDirPath;
 };
 
+/// Specifies the serialization format of spill files.
+enum class SpillFileFormat {
+  /// Presto pages. Each page is compressed as a whole.
+  kPresto,
+  /// Column-major batches with per-column encodings and compression. Supports
+  /// reading a subset of the columns.
+  kColumnar,
+};
+
+std::string spillFileFormatName(SpillFileFormat format);
+
+SpillFileFormat spillFileFormatFromName(const std::string& name);
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig() = default;
@@ -81,7 +98,11 @@ struct SpillConfig {
       uint32_t numMaxMergeFiles,
       std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
       const std::string& _fileCreateConfig = {},
-      uint32_t _windowMinReadBatchRows = 1'000);
+      uint32_t _windowMinReadBatchRows = 1'000,
+      const std::string& _fileFormat = "presto",
+      bool _asyncWriteEnabled = false,
+      uint8_t _sortMergePartitionBits = 0,
+      GetSpillDirectoryPathCB _getSpillOverflowDirPathCb = nullptr);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -177,5 +198,26 @@ struct SpillConfig {
 
   /// The minimum number of rows to read when processing spilled window data.
   uint32_t windowMinReadBatchRows;
+
+  /// The serialization format of the spill files.
+  SpillFileFormat fileFormat{SpillFileFormat::kPresto};
+
+  /// If true and 'executor' is set, spill file writes run on 'executor' while
+  /// the spilling thread extracts and serializes the next batch. Each spill
+  /// writer has at most one write in flight.
+  bool asyncWriteEnabled{false};
+
+  /// Number of bits of the key range partitions of sorted spilling. If not
+  /// zero and 'executor' is set, the sort buffer splits the spilled rows into
+  /// up to 2^sortMergePartitionBits key ranges using splitter keys sampled from
+  /// the first spill run, and merges the ranges in parallel on 'executor'.
+  uint8_t sortMergePartitionBits{0};
+
+  /// A callback function that returns the spill overflow directory path, e.g.
+  /// on an object store reached through the registered file systems. If set,
+  /// new spill files are written to this directory instead of the spill
+  /// directory once the node-wide local spill quota is used up. See
+  /// exec::LocalSpillQuota.
+  GetSpillDirectoryPathCB getSpillOverflowDirPathCb;
 };
 } // namespace facebook::velox::common
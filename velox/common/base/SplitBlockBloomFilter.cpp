@@ -18,6 +18,7 @@
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/IOUtils.h"
 
 #include <bit>
 #include <sstream>
@@ -38,6 +39,69 @@ SplitBlockBloomFilter::SplitBlockBloomFilter(const std::span<Block>& blocks)
   VELOX_CHECK_EQ(reinterpret_cast<uintptr_t>(blocks.data()) % sizeof(Block), 0);
 }
 
+namespace {
+// Returns a stream positioned at the first block of 'serialized'.
+common::InputByteStream readHeader(const char* serialized, int32_t& numBlocks) {
+  common::InputByteStream stream(serialized);
+  const auto version = stream.read<int8_t>();
+  VELOX_USER_CHECK_EQ(
+      version,
+      SplitBlockBloomFilter::kSerializedVersion,
+      "Not a serialized split block bloom filter");
+  const auto wordsPerBlock = stream.read<int32_t>();
+  VELOX_USER_CHECK_EQ(
+      wordsPerBlock,
+      xsimd::batch<uint32_t>::size,
+      "Split block bloom filter was built with a different SIMD width");
+  numBlocks = stream.read<int32_t>();
+  VELOX_USER_CHECK_GT(numBlocks, 0);
+  return stream;
+}
+} // namespace
+
+void SplitBlockBloomFilter::serialize(char* output) const {
+  common::OutputByteStream stream(output);
+  stream.appendOne(kSerializedVersion);
+  stream.appendOne(static_cast<int32_t>(xsimd::batch<uint32_t>::size));
+  stream.appendOne(static_cast<int32_t>(blocks_.size()));
+  stream.append(
+      reinterpret_cast<const char*>(blocks_.data()),
+      blocks_.size() * sizeof(Block));
+}
+
+int32_t SplitBlockBloomFilter::serializedNumBlocks(const char* serialized) {
+  int32_t numBlocks;
+  readHeader(serialized, numBlocks);
+  return numBlocks;
+}
+
+void SplitBlockBloomFilter::merge(const char* serialized) {
+  int32_t numBlocks;
+  auto stream = readHeader(serialized, numBlocks);
+  VELOX_USER_CHECK_EQ(
+      numBlocks,
+      static_cast<int64_t>(blocks_.size()),
+      "Cannot merge split block bloom filters of different sizes");
+  // The serialized blocks are not necessarily aligned.
+  const auto* words =
+      reinterpret_cast<const uint32_t*>(serialized + stream.offset());
+  for (auto i = 0; i < numBlocks; ++i) {
+    auto* block = blocks_[i].data;
+    const auto other = xsimd::load_unaligned(
+        words + i * xsimd::batch<uint32_t>::size);
+    (xsimd::load_aligned(block) | other).store_aligned(block);
+  }
+}
+
+void SplitBlockBloomFilter::deserialize(
+    const char* serialized,
+    std::span<Block> blocks) {
+  int32_t numBlocks;
+  auto stream = readHeader(serialized, numBlocks);
+  VELOX_CHECK_EQ(numBlocks, static_cast<int64_t>(blocks.size()));
+  stream.copyTo(blocks.data(), numBlocks);
+}
+
 std::string SplitBlockBloomFilter::debugString() const {
   std::ostringstream out;
   out << "numBlocks=" << blocks_.size() << '\n';
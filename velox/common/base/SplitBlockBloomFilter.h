@@ -94,6 +94,32 @@ class SplitBlockBloomFilter {
 
   std::string debugString() const;
 
+  /// Version byte of the serialized form. Differs from the version of
+  /// BloomFilter so that readers of either form can tell them apart.
+  static constexpr int8_t kSerializedVersion = 2;
+
+  /// Returns the size of the serialized form of a filter with 'numBlocks'
+  /// blocks: the version, the number of 32-bit words per block, the number of
+  /// blocks and the blocks. The bits a hash sets depend on the words per
+  /// block, i.e. on the SIMD width, so a serialized filter can only be read
+  /// by a process with the same width.
+  static int64_t serializedSize(int64_t numBlocks) {
+    return 1 + 2 * sizeof(int32_t) + numBlocks * sizeof(Block);
+  }
+
+  void serialize(char* output) const;
+
+  /// Checks the header of 'serialized' and returns its number of blocks.
+  static int32_t serializedNumBlocks(const char* serialized);
+
+  /// Sets the bits of the serialized filter 'serialized' in 'this'. The
+  /// number of blocks must be the same.
+  void merge(const char* serialized);
+
+  /// Copies the blocks of the serialized filter 'serialized' to 'blocks',
+  /// which has serializedNumBlocks(serialized) elements.
+  static void deserialize(const char* serialized, std::span<Block> blocks);
+
  private:
   static_assert(64 % sizeof(Block) == 0);
 
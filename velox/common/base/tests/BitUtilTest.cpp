@@ -761,6 +761,28 @@ TEST_F(BitUtilTest, crc) {
   EXPECT_EQ(boostCrc, follyCrc);
 }
 
+TEST_F(BitUtilTest, crc32c) {
+  // The check value of CRC-32C.
+  const std::string text = "123456789";
+  bits::Crc32c crc;
+  crc.process_bytes(text.data(), text.size());
+  EXPECT_EQ(crc.checksum(), 0xE3069283);
+
+  // The checksum of a buffer large enough for the interleaved streams does
+  // not depend on how it is split.
+  std::string data(100'000, 0);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = i * 31 % 251;
+  }
+  crc.reset();
+  crc.process_bytes(data.data(), data.size());
+  const auto wholeCrc = crc.checksum();
+  crc.reset();
+  crc.process_bytes(data.data(), 12'345);
+  crc.process_bytes(data.data() + 12'345, data.size() - 12'345);
+  EXPECT_EQ(crc.checksum(), wholeCrc);
+}
+
 TEST_F(BitUtilTest, pad) {
   char bytes[100];
   memset(bytes, 1, sizeof(bytes));
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/SplitBlockBloomFilter.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/RandomSeed.h"
 
 #include <folly/container/F14Set.h>
@@ -118,5 +119,49 @@ TEST(SplitBlockBloomFilterTest, random) {
   }
 }
 
+TEST(SplitBlockBloomFilterTest, serialize) {
+  folly::F14FastSet<int64_t> values;
+  for (int i = 0; i < 1'000; ++i) {
+    values.insert(i * 7);
+  }
+  folly::hasher<int64_t> hasher;
+  std::vector<SplitBlockBloomFilter::Block> blocks;
+  auto filter = makeFilter(values, hasher, blocks);
+  std::string serialized(
+      SplitBlockBloomFilter::serializedSize(blocks.size()), '\0');
+  filter.serialize(serialized.data());
+  ASSERT_EQ(
+      SplitBlockBloomFilter::serializedNumBlocks(serialized.data()),
+      static_cast<int32_t>(blocks.size()));
+
+  std::vector<SplitBlockBloomFilter::Block> copyBlocks(blocks.size());
+  SplitBlockBloomFilter::deserialize(serialized.data(), copyBlocks);
+  SplitBlockBloomFilter copy(copyBlocks);
+  for (auto value : values) {
+    ASSERT_TRUE(copy.mayContain(hasher(value)));
+  }
+
+  // Merge into an empty filter of the same size, from an unaligned copy.
+  std::string unaligned = "x" + serialized;
+  std::vector<SplitBlockBloomFilter::Block> mergedBlocks(blocks.size());
+  SplitBlockBloomFilter merged(mergedBlocks);
+  merged.insert(hasher(-1));
+  merged.merge(unaligned.data() + 1);
+  ASSERT_TRUE(merged.mayContain(hasher(-1)));
+  for (auto value : values) {
+    ASSERT_TRUE(merged.mayContain(hasher(value)));
+  }
+
+  std::vector<SplitBlockBloomFilter::Block> otherBlocks(blocks.size() + 1);
+  SplitBlockBloomFilter other(otherBlocks);
+  VELOX_ASSERT_THROW(
+      other.merge(serialized.data()),
+      "Cannot merge split block bloom filters of different sizes");
+  serialized[0] = 1;
+  VELOX_ASSERT_THROW(
+      SplitBlockBloomFilter::serializedNumBlocks(serialized.data()),
+      "Not a serialized split block bloom filter");
+}
+
 } // namespace
 } // namespace facebook::velox::test
@@ -284,7 +284,8 @@ class TestMemoryPool : public memory::MemoryPool {
   void allocateContiguous(
       memory::MachinePageCount /* unused */,
       memory::ContiguousAllocation& /* unused */,
-      memory::MachinePageCount /* unused */) override {}
+      memory::MachinePageCount /* unused */,
+      bool /* unused */) override {}
 
   void freeContiguous(memory::ContiguousAllocation& /* unused */) override {}
 
@@ -208,6 +208,7 @@ CachePin CacheShard::findOrCreate(
       // retain a valid read pin.
       RECORD_METRIC_VALUE(kMetricMemoryCacheNumStaleEntries);
       ++numStales_;
+      notifyResidencyLocked(key.fileNum, -foundEntry->size());
       foundEntry->key_.fileNum.clear();
       entryMap_.erase(it);
     }
@@ -230,6 +231,7 @@ CachePin CacheShard::findOrCreate(
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
+    notifyResidencyLocked(key.fileNum, size);
   }
   return initEntry(key, entryToInit);
 }
@@ -345,6 +347,7 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
         RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset});
     VELOX_CHECK(it != entryMap_.end());
     entryMap_.erase(it);
+    notifyResidencyLocked(entry->key_.fileNum.id(), -entry->size_);
     entry->key_.fileNum.clear();
   }
   entry->setSsdFile(nullptr, 0);
@@ -366,6 +369,13 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
   entry->size_ = 0;
 }
 
+void CacheShard::notifyResidencyLocked(uint64_t fileNum, int64_t bytes) const {
+  const auto& listener = cache_->residencyListener();
+  if (listener != nullptr && bytes != 0) {
+    listener(fileNum, bytes);
+  }
+}
+
 uint64_t CacheShard::evict(
     uint64_t bytesToFree,
     bool evictAllUnpinned,
@@ -439,7 +449,6 @@ uint64_t CacheShard::evict(
         tinyEvicted += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
-        candidate->size_ = 0;
 
         removeEntryLocked(candidate);
         emptySlots_.push_back(entryIndex);
@@ -645,6 +654,17 @@ bool CacheShard::removeFileEntries(
   return true;
 }
 
+void CacheShard::addFileBytes(
+    const folly::F14FastSet<uint64_t>& fileNums,
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& [key, entry] : entryMap_) {
+    if (fileNums.count(key.fileNum) != 0) {
+      fileBytes[key.fileNum] += entry->size();
+    }
+  }
+}
+
 CacheStats CacheStats::operator-(const CacheStats& other) const {
   CacheStats result;
   result.numHit = numHit - other.numHit;
@@ -975,6 +995,45 @@ bool AsyncDataCache::removeFileEntries(
   return success;
 }
 
+std::vector<AsyncDataCache::FileResidency> AsyncDataCache::fileResidency(
+    const std::vector<std::string>& paths) const {
+  VELOX_USER_CHECK_LE(
+      paths.size(),
+      kMaxResidencyFiles,
+      "Too many files in a cache residency request");
+  std::vector<uint64_t> fileNums(paths.size());
+  folly::F14FastSet<uint64_t> knownFileNums;
+  for (auto i = 0; i < paths.size(); ++i) {
+    // A file without an id has nothing cached.
+    fileNums[i] = fileIds().id(paths[i]);
+    if (fileNums[i] != StringIdMap::kNoId) {
+      knownFileNums.insert(fileNums[i]);
+    }
+  }
+
+  std::vector<FileResidency> residencies(paths.size());
+  if (knownFileNums.empty()) {
+    return residencies;
+  }
+  folly::F14FastMap<uint64_t, uint64_t> ramBytes;
+  for (const auto& shard : shards_) {
+    shard->addFileBytes(knownFileNums, ramBytes);
+  }
+  folly::F14FastMap<uint64_t, uint64_t> ssdBytes;
+  if (ssdCache_ != nullptr) {
+    ssdCache_->addFileBytes(knownFileNums, ssdBytes);
+  }
+  for (auto i = 0; i < paths.size(); ++i) {
+    if (auto it = ramBytes.find(fileNums[i]); it != ramBytes.end()) {
+      residencies[i].ramBytes = it->second;
+    }
+    if (auto it = ssdBytes.find(fileNums[i]); it != ssdBytes.end()) {
+      residencies[i].ssdBytes = it->second;
+    }
+  }
+  return residencies;
+}
+
 CacheStats AsyncDataCache::refreshStats() const {
   CacheStats stats;
   for (auto& shard : shards_) {
@@ -1010,6 +1069,20 @@ std::string AsyncDataCache::toString(bool details) const {
   return out.str();
 }
 
+double CacheStats::ssdHitRate() const {
+  if (ssdStats == nullptr || numNew == 0) {
+    return 0;
+  }
+  return static_cast<double>(ssdStats->entriesRead) / numNew;
+}
+
+double CacheStats::ssdWriteAmplification() const {
+  if (ssdStats == nullptr || ssdStats->bytesRead == 0) {
+    return 0;
+  }
+  return static_cast<double>(ssdStats->bytesWritten) / ssdStats->bytesRead;
+}
+
 std::string CacheStats::toString() const {
   std::stringstream out;
   // Cache size stats.
@@ -1039,6 +1112,15 @@ std::string CacheStats::toString() const {
       << "\n"
       // Cache timing stats.
       << "Alloc Megaclocks " << (allocClocks >> 20);
+  if (ssdStats != nullptr &&
+      (ssdStats->bytesRead != 0 || ssdStats->bytesWritten != 0)) {
+    out << fmt::format(
+        "\nSSD hit rate: {:.2f}% write amplification: {:.2f} throttled "
+        "writes: {}",
+        ssdHitRate() * 100,
+        ssdWriteAmplification(),
+        tsanAtomicValue(ssdStats->writeSsdThrottled));
+  }
   return out.str();
 }
 
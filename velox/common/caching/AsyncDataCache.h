@@ -21,6 +21,7 @@
 #include <fmt/format.h>
 #include <folly/GLog.h>
 #include <folly/chrono/Hardware.h>
+#include <folly/container/F14Map.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
 
@@ -550,6 +551,15 @@ struct CacheStats {
 
   CacheStats operator-(const CacheStats& other) const;
 
+  /// Returns the fraction of the memory cache misses that are read from SSD.
+  /// 0 if there is no SSD cache or no miss.
+  double ssdHitRate() const;
+
+  /// Returns the bytes written to SSD per byte read from SSD. Shows how much
+  /// of the SSD write bandwidth is spent on data that is not read back. 0 if
+  /// there is no SSD cache or no read.
+  double ssdWriteAmplification() const;
+
   std::string toString() const;
 };
 
@@ -627,6 +637,12 @@ class CacheShard {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the size of the entries of 'this' for the files in 'fileNums' to
+  /// the corresponding element of 'fileBytes'.
+  void addFileBytes(
+      const folly::F14FastSet<uint64_t>& fileNums,
+      folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   auto& allocClocks() {
     return allocClocks_;
   }
@@ -641,6 +657,10 @@ class CacheShard {
 
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
+  // Reports the addition or removal of 'bytes' of 'fileNum' to the residency
+  // listener of 'cache_' if one is set.
+  void notifyResidencyLocked(uint64_t fileNum, int64_t bytes) const;
+
   // Returns an unused entry if found.
   //
   // TODO: consider to pass a size hint so as to select the a free entry which
@@ -705,6 +725,22 @@ class AsyncDataCache : public memory::Cache {
  public:
   static constexpr int32_t kDefaultNumShards = 4;
 
+  /// Maximum number of files in a single fileResidency() call.
+  static constexpr int32_t kMaxResidencyFiles = 10'000;
+
+  /// The cached bytes of a file. An entry that is being loaded counts as
+  /// cached in memory. An entry that is both in memory and on SSD counts in
+  /// both.
+  struct FileResidency {
+    uint64_t ramBytes{0};
+    uint64_t ssdBytes{0};
+  };
+
+  /// Called with the file number and the size of each entry added to the
+  /// memory cache, and with the negated size of each entry removed from it.
+  using ResidencyListener =
+      std::function<void(uint64_t fileNum, int64_t bytes)>;
+
   struct Options {
     Options(
         double _maxWriteRatio = 0.7,
@@ -885,6 +921,25 @@ class AsyncDataCache : public memory::Cache {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Returns the bytes cached in memory and on SSD for each of 'paths', e.g.
+  /// for routing the splits of a file to a worker that has it cached. Takes
+  /// the mutex of each shard and of the SSD files of 'paths' once and scans
+  /// their entries. Throws if there are more than kMaxResidencyFiles paths.
+  std::vector<FileResidency> fileResidency(
+      const std::vector<std::string>& paths) const;
+
+  /// Sets a listener that is called with the changes of the bytes cached in
+  /// memory per file, e.g. for publishing them to a split scheduler. The
+  /// listener is called inside the mutex of a shard and must not call into
+  /// the cache. Must be set before the cache is used.
+  void setResidencyListener(ResidencyListener listener) {
+    residencyListener_ = std::move(listener);
+  }
+
+  const ResidencyListener& residencyListener() const {
+    return residencyListener_;
+  }
+
   /// Drops all unpinned entries. Pins stay valid.
   ///
   /// NOTE: it is used by testing and Prestissimo server operation.
@@ -929,6 +984,8 @@ class AsyncDataCache : public memory::Cache {
   CacheStats stats_;
 
   std::function<void(const AsyncDataCacheEntry&)> verifyHook_;
+
+  ResidencyListener residencyListener_;
   // Count of skipped saves to 'ssdCache_' due to 'ssdCache_' being
   // busy with write.
   tsan_atomic<int32_t> numSkippedSaves_{0};
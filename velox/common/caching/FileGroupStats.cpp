@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <folly/hash/Hash.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+
+double CacheAccessCounts::hitRate() const {
+  return lookupBytes() == 0
+      ? 0
+      : bytesSaved() / static_cast<double>(lookupBytes());
+}
+
+void CacheAccessCounts::merge(const CacheAccessCounts& other) {
+  referencedBytes += other.referencedBytes;
+  readBytes += other.readBytes;
+  ramHits += other.ramHits;
+  ramHitBytes += other.ramHitBytes;
+  ssdHits += other.ssdHits;
+  ssdHitBytes += other.ssdHitBytes;
+  misses += other.misses;
+  missBytes += other.missBytes;
+  prefetchBytes += other.prefetchBytes;
+}
+
+std::string CacheAccessCounts::toString() const {
+  return fmt::format(
+      "hit rate {:.1f}% (ram {} {}, ssd {} {}, miss {} {}), saved {}, "
+      "read {} of {} referenced, prefetched {}",
+      hitRate() * 100,
+      ramHits,
+      succinctBytes(ramHitBytes),
+      ssdHits,
+      succinctBytes(ssdHitBytes),
+      misses,
+      succinctBytes(missBytes),
+      succinctBytes(bytesSaved()),
+      succinctBytes(readBytes),
+      succinctBytes(referencedBytes),
+      succinctBytes(prefetchBytes));
+}
+
+bool GhostCache::access(uint64_t key, uint64_t bytes) {
+  ++numAccesses_;
+  accessBytes_ += bytes;
+  auto it = entries_.find(key);
+  const bool hit = it != entries_.end();
+  if (hit) {
+    ++numHits_;
+    hitBytes_ += bytes;
+    size_ -= it->second->second;
+    lru_.erase(it->second);
+    entries_.erase(it);
+  }
+  if (bytes > capacity_) {
+    return hit;
+  }
+  lru_.emplace_front(key, bytes);
+  entries_[key] = lru_.begin();
+  size_ += bytes;
+  while (size_ > capacity_) {
+    const auto& [evictedKey, evictedBytes] = lru_.back();
+    size_ -= evictedBytes;
+    entries_.erase(evictedKey);
+    lru_.pop_back();
+  }
+  return hit;
+}
+
+void GhostCache::clear() {
+  lru_.clear();
+  entries_.clear();
+  size_ = 0;
+  numAccesses_ = 0;
+  numHits_ = 0;
+  accessBytes_ = 0;
+  hitBytes_ = 0;
+}
+
+FileGroupStats::FileGroupStats(
+    std::shared_ptr<SsdAdmissionPolicy> admissionPolicy,
+    const Options& options)
+    : admissionPolicy_(std::move(admissionPolicy)), options_(options) {
+  VELOX_CHECK_GE(options_.maxEntries, 0);
+  simulatedCaches_.reserve(options_.simulatedCapacities.size());
+  for (const auto capacity : options_.simulatedCapacities) {
+    simulatedCaches_.push_back(std::make_unique<GhostCache>(capacity));
+  }
+}
+
+CacheAccessCounts& FileGroupStats::countsLocked(
+    uint64_t groupId,
+    TrackingId trackingId) {
+  const GroupColumnKey key{groupId, trackingId.id()};
+  auto it = groupColumnCounts_.find(key);
+  if (it != groupColumnCounts_.end()) {
+    return it->second;
+  }
+  if (groupColumnCounts_.size() >= options_.maxEntries) {
+    return otherCounts_;
+  }
+  return groupColumnCounts_[key];
+}
+
+void FileGroupStats::recordReference(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  countsLocked(groupId, trackingId).referencedBytes += bytes;
+  totalCounts_.referencedBytes += bytes;
+}
+
+void FileGroupStats::recordRead(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  countsLocked(groupId, trackingId).readBytes += bytes;
+  totalCounts_.readBytes += bytes;
+}
+
+void FileGroupStats::recordCacheAccess(
+    uint64_t fileId,
+    uint64_t offset,
+    uint64_t groupId,
+    TrackingId trackingId,
+    uint64_t bytes,
+    CacheSource source,
+    bool prefetch) {
+  CacheAccessCounts access;
+  switch (source) {
+    case CacheSource::kRam:
+      access.ramHits = 1;
+      access.ramHitBytes = bytes;
+      break;
+    case CacheSource::kSsd:
+      access.ssdHits = 1;
+      access.ssdHitBytes = bytes;
+      break;
+    case CacheSource::kStorage:
+      access.misses = 1;
+      access.missBytes = bytes;
+      break;
+  }
+  if (prefetch && source != CacheSource::kRam) {
+    access.prefetchBytes = bytes;
+  }
+  const auto key = folly::hash::hash_128_to_64(fileId, offset);
+  std::lock_guard<std::mutex> l(mutex_);
+  countsLocked(groupId, trackingId).merge(access);
+  totalCounts_.merge(access);
+  for (auto& simulatedCache : simulatedCaches_) {
+    simulatedCache->access(key, bytes);
+  }
+}
+
+std::vector<FileGroupStats::GroupColumnStats>
+FileGroupStats::groupColumnStats() const {
+  std::vector<GroupColumnStats> result;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    result.reserve(groupColumnCounts_.size());
+    for (const auto& [key, counts] : groupColumnCounts_) {
+      result.push_back({key.first, TrackingId(key.second), counts});
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const auto& x, const auto& y) {
+    return x.counts.lookupBytes() > y.counts.lookupBytes();
+  });
+  return result;
+}
+
+CacheAccessCounts FileGroupStats::totalCacheAccessCounts() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return totalCounts_;
+}
+
+std::vector<FileGroupStats::SimulatedCacheStats>
+FileGroupStats::simulatedCacheStats() const {
+  std::vector<SimulatedCacheStats> result;
+  std::lock_guard<std::mutex> l(mutex_);
+  result.reserve(simulatedCaches_.size());
+  for (const auto& simulatedCache : simulatedCaches_) {
+    result.push_back(
+        {simulatedCache->capacity(),
+         simulatedCache->numAccesses(),
+         simulatedCache->numHits(),
+         simulatedCache->accessBytes(),
+         simulatedCache->hitBytes()});
+  }
+  return result;
+}
+
+std::string FileGroupStats::cacheAccessToString(int32_t maxEntries) const {
+  const auto groupColumns = groupColumnStats();
+  CacheAccessCounts otherCounts;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    otherCounts = otherCounts_;
+  }
+  std::stringstream out;
+  out << "Cache accesses: " << totalCacheAccessCounts().toString();
+  int32_t numPrinted = 0;
+  for (const auto& stats : groupColumns) {
+    if (numPrinted++ >= maxEntries) {
+      out << "\n  ... " << groupColumns.size() - maxEntries << " more";
+      break;
+    }
+    const auto groupName = fileIds().string(stats.groupId);
+    out << "\n  " << (groupName.empty() ? std::to_string(stats.groupId)
+                                         : groupName)
+        << " column " << stats.trackingId.id() << ": "
+        << stats.counts.toString();
+  }
+  if (otherCounts.referencedBytes > 0 || otherCounts.lookupBytes() > 0) {
+    out << "\n  Untracked groups and columns: " << otherCounts.toString();
+  }
+  for (const auto& simulated : simulatedCacheStats()) {
+    out << fmt::format(
+        "\n  Simulated {} cache: hit rate {:.1f}% of {}",
+        succinctBytes(simulated.capacity),
+        simulated.hitRate() * 100,
+        succinctBytes(simulated.accessBytes));
+  }
+  return out.str();
+}
+
+void FileGroupStats::clearCacheAccessStats() {
+  std::lock_guard<std::mutex> l(mutex_);
+  groupColumnCounts_.clear();
+  otherCounts_ = {};
+  totalCounts_ = {};
+  for (auto& simulatedCache : simulatedCaches_) {
+    simulatedCache->clear();
+  }
+}
+
+} // namespace facebook::velox::cache
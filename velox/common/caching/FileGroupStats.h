@@ -16,26 +16,191 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
+#include <list>
+
 #include "velox/common/caching/ScanTracker.h"
+#include "velox/common/caching/SsdAdmissionPolicy.h"
 
 namespace facebook::velox::cache {
 
-// Dummy implementation of SsdCache admission stats.
+/// Where a read of cacheable data is served from.
+enum class CacheSource { kRam, kSsd, kStorage };
+
+/// Cache effectiveness counters of the reads of a column of a file group.
+struct CacheAccessCounts {
+  /// Bytes the scans planned to read, see ScanTracker::recordReference().
+  uint64_t referencedBytes{0};
+  /// Bytes the scans actually read, see ScanTracker::recordRead().
+  uint64_t readBytes{0};
+  /// Planned bytes found in memory, on SSD and missing from both.
+  uint64_t ramHits{0};
+  uint64_t ramHitBytes{0};
+  uint64_t ssdHits{0};
+  uint64_t ssdHitBytes{0};
+  uint64_t misses{0};
+  uint64_t missBytes{0};
+  /// Bytes loaded ahead of use because ScanTracker predicted they get read.
+  uint64_t prefetchBytes{0};
+
+  /// Returns the bytes looked up in the cache.
+  uint64_t lookupBytes() const {
+    return ramHitBytes + ssdHitBytes + missBytes;
+  }
+
+  /// Returns the fraction of the looked up bytes found in memory or on SSD.
+  /// 0 if nothing is looked up.
+  double hitRate() const;
+
+  /// Returns the bytes not read from storage thanks to the cache.
+  uint64_t bytesSaved() const {
+    return ramHitBytes + ssdHitBytes;
+  }
+
+  void merge(const CacheAccessCounts& other);
+
+  std::string toString() const;
+};
+
+/// Simulates an LRU cache of 'capacity' bytes over the keys and the sizes of
+/// the accessed entries without their data, i.e. ghost entries, to tell what
+/// the hit rate would be with a cache of a different size. Not thread-safe.
+class GhostCache {
+ public:
+  explicit GhostCache(uint64_t capacity) : capacity_(capacity) {}
+
+  GhostCache(const GhostCache&) = delete;
+  GhostCache& operator=(const GhostCache&) = delete;
+
+  /// Records an access to the entry 'key' of 'bytes'. Returns true if the
+  /// simulated cache has the entry.
+  bool access(uint64_t key, uint64_t bytes);
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  uint64_t numAccesses() const {
+    return numAccesses_;
+  }
+
+  uint64_t numHits() const {
+    return numHits_;
+  }
+
+  uint64_t accessBytes() const {
+    return accessBytes_;
+  }
+
+  uint64_t hitBytes() const {
+    return hitBytes_;
+  }
+
+  /// Returns the number of entries and their total size.
+  size_t numEntries() const {
+    return entries_.size();
+  }
+
+  uint64_t size() const {
+    return size_;
+  }
+
+  /// Removes all the entries and resets the counters.
+  void clear();
+
+ private:
+  using Lru = std::list<std::pair<uint64_t, uint64_t>>;
+
+  const uint64_t capacity_;
+  // Key and size of the entries, the most recently used first.
+  Lru lru_;
+  folly::F14FastMap<uint64_t, Lru::iterator> entries_;
+  uint64_t size_{0};
+  uint64_t numAccesses_{0};
+  uint64_t numHits_{0};
+  uint64_t accessBytes_{0};
+  uint64_t hitBytes_{0};
+};
+
+// SsdCache admission stats. Forwards the accesses to the admission policy if
+// one is set. Otherwise admits all data.
+//
+// Also collects per file group and column cache effectiveness counters and
+// optionally simulates caches of other sizes, see Options.
 class FileGroupStats {
  public:
+  struct Options {
+    Options() {}
+
+    /// Max number of distinct file group and column pairs with their own
+    /// counters. The accesses to the pairs beyond are only counted in the
+    /// totals. 0 disables the per group and column counters.
+    int32_t maxEntries{10'000};
+
+    /// Capacities in bytes of the simulated LRU caches. Each costs a ghost
+    /// entry of a few dozen bytes per cached entry.
+    std::vector<uint64_t> simulatedCapacities;
+  };
+
+  /// Counters of the file group 'groupId' and the column 'trackingId'.
+  struct GroupColumnStats {
+    uint64_t groupId;
+    TrackingId trackingId;
+    CacheAccessCounts counts;
+  };
+
+  /// The outcome of the simulation of a cache of 'capacity' bytes.
+  struct SimulatedCacheStats {
+    uint64_t capacity;
+    uint64_t numAccesses;
+    uint64_t numHits;
+    uint64_t accessBytes;
+    uint64_t hitBytes;
+
+    double hitRate() const {
+      return accessBytes == 0 ? 0
+                              : hitBytes / static_cast<double>(accessBytes);
+    }
+  };
+
+  explicit FileGroupStats(
+      std::shared_ptr<SsdAdmissionPolicy> admissionPolicy = nullptr,
+      const Options& options = Options());
+
   // Records ScanTracker::recordReference at group level
   void recordReference(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
 
   // Records ScanTracker::recordRead at group level
   void recordRead(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
+
+  /// Records that a scan looked up the 'bytes' at 'offset' in 'fileId' of
+  /// column 'trackingId' in 'groupId' and found them in 'source'. 'prefetch'
+  /// is true if they are loaded ahead of use.
+  void recordCacheAccess(
+      uint64_t fileId,
+      uint64_t offset,
+      uint64_t groupId,
+      TrackingId trackingId,
+      uint64_t bytes,
+      CacheSource source,
+      bool prefetch);
+
+  // Records that a scan reads 'trackingId' in 'groupId'. Called once per
+  // ScanTracker, group and tracking id.
+  void recordScan(uint64_t groupId, TrackingId trackingId) {
+    if (admissionPolicy_ != nullptr) {
+      admissionPolicy_->recordAccess(groupId, trackingId);
+    }
+  }
 
   // Records the existence of a distinct file inside 'groupId'
   void recordFile(
@@ -44,20 +209,68 @@ class FileGroupStats {
       int32_t /*numStripes*/) {}
 
   // Returns true if groupId, trackingId qualify the data to be cached to SSD.
-  bool shouldSaveToSsd(uint64_t /*groupId*/, TrackingId /*trackingId*/) const {
-    return true;
+  bool shouldSaveToSsd(uint64_t groupId, TrackingId trackingId) const {
+    return admissionPolicy_ == nullptr ||
+        admissionPolicy_->shouldAdmit(groupId, trackingId);
   }
 
   // Updates the SSD selection criteria. 'ssdsize' is the capacity,
   // 'decayPct' gives by how much old accesses are discounted.
-  void updateSsdFilter(uint64_t /*ssdSize*/, int32_t /*decayPct*/ = 0) {}
+  void updateSsdFilter(uint64_t /*ssdSize*/, int32_t /*decayPct*/ = 0) {
+    if (admissionPolicy_ != nullptr) {
+      admissionPolicy_->age();
+    }
+  }
 
   // Recalculates the best groups and makes a human readable
   // summary. 'cacheBytes' is used to compute what fraction of the tracked
   // working set can be cached in 'cacheBytes'.
   std::string toString(uint64_t /*cacheBytes*/) {
+    if (admissionPolicy_ != nullptr) {
+      return admissionPolicy_->toString();
+    }
     return "<dummy FileGroupStats>";
   }
+
+  SsdAdmissionPolicy* admissionPolicy() const {
+    return admissionPolicy_.get();
+  }
+
+  /// Returns the counters of the file group and column pairs, the most
+  /// looked up bytes first.
+  std::vector<GroupColumnStats> groupColumnStats() const;
+
+  /// Returns the counters of all the accesses.
+  CacheAccessCounts totalCacheAccessCounts() const;
+
+  /// Returns the outcome of the simulated caches, in the order of
+  /// Options::simulatedCapacities.
+  std::vector<SimulatedCacheStats> simulatedCacheStats() const;
+
+  /// Returns a human readable dump of the totals, the 'maxEntries' file
+  /// group and column pairs with the most looked up bytes and the simulated
+  /// caches.
+  std::string cacheAccessToString(int32_t maxEntries = 20) const;
+
+  /// Clears the cache access counters and the simulated caches.
+  void clearCacheAccessStats();
+
+ private:
+  using GroupColumnKey = std::pair<uint64_t, int32_t>;
+
+  // Returns the counters of 'groupId' and 'trackingId', or the counters of
+  // the accesses beyond 'options_.maxEntries'.
+  CacheAccessCounts& countsLocked(uint64_t groupId, TrackingId trackingId);
+
+  const std::shared_ptr<SsdAdmissionPolicy> admissionPolicy_;
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<GroupColumnKey, CacheAccessCounts> groupColumnCounts_;
+  // Counters of the pairs that do not fit in 'groupColumnCounts_'.
+  CacheAccessCounts otherCounts_;
+  CacheAccessCounts totalCounts_;
+  std::vector<std::unique_ptr<GhostCache>> simulatedCaches_;
 };
 
 } // namespace facebook::velox::cache
@@ -17,6 +17,8 @@
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/FileGroupStats.h"
 
+#include <folly/hash/Hash.h>
+
 #include <sstream>
 
 namespace facebook::velox::cache {
@@ -43,13 +45,24 @@ void ScanTracker::recordRead(
     uint64_t bytes,
     uint64_t fileId,
     uint64_t groupId) {
+  bool firstScan = false;
   if (fileGroupStats_) {
     fileGroupStats_->recordRead(fileId, groupId, id, bytes);
   }
-  std::lock_guard<std::mutex> l(mutex_);
-  auto& data = data_[id];
-  data.readBytes += bytes;
-  sum_.readBytes += bytes;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto& data = data_[id];
+    data.readBytes += bytes;
+    sum_.readBytes += bytes;
+    if (fileGroupStats_) {
+      firstScan =
+          scannedGroups_.insert(folly::hash::hash_128_to_64(groupId, id.id()))
+              .second;
+    }
+  }
+  if (firstScan) {
+    fileGroupStats_->recordScan(groupId, id);
+  }
 }
 
 std::string ScanTracker::toString() const {
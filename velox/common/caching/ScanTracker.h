@@ -17,6 +17,7 @@
 #pragma once
 
 #include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
 #include <cstdint>
 #include <mutex>
 
@@ -164,6 +165,9 @@ class ScanTracker {
   std::mutex mutex_;
   folly::F14FastMap<TrackingId, TrackingData> data_;
   TrackingData sum_;
+  // Hashes of the group and tracking id pairs read by the scan. Used to
+  // record each of them once in 'fileGroupStats_'.
+  folly::F14FastSet<uint64_t> scannedGroups_;
 };
 
 } // namespace facebook::velox::cache
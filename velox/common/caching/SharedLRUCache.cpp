@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SharedLRUCache.h"
+
+#include "velox/common/memory/MemoryArbitrator.h"
+
+namespace facebook::velox {
+
+// Reclaims the memory of the cache by evicting entries. The memory of an
+// evicted value is freed once its holders release it.
+class SharedLRUCache::MemoryReclaimer : public memory::MemoryReclaimer {
+ public:
+  explicit MemoryReclaimer(SharedLRUCache* cache)
+      : memory::MemoryReclaimer(0), cache_(cache) {}
+
+  bool reclaimableBytes(
+      const memory::MemoryPool& /*pool*/,
+      uint64_t& reclaimableBytes) const override {
+    reclaimableBytes = cache_->stats().sizeBytes;
+    return true;
+  }
+
+  uint64_t reclaim(
+      memory::MemoryPool* pool,
+      uint64_t targetBytes,
+      uint64_t /*maxWaitMs*/,
+      Stats& stats) override {
+    return run(
+        [&]() {
+          int64_t reclaimedBytes{0};
+          {
+            memory::ScopedReclaimedBytesRecorder recorder(
+                pool, &reclaimedBytes);
+            cache_->shrink(targetBytes);
+          }
+          return std::max<int64_t>(reclaimedBytes, 0);
+        },
+        stats);
+  }
+
+  void abort(memory::MemoryPool* /*pool*/, const std::exception_ptr& /*error*/)
+      override {
+    cache_->clear();
+  }
+
+ private:
+  SharedLRUCache* const cache_;
+};
+
+SharedLRUCache::SharedLRUCache(
+    uint64_t capacityBytes,
+    const std::string& poolName)
+    : capacityBytes_(capacityBytes), cache_(capacityBytes) {
+  if (!poolName.empty()) {
+    rootPool_ = memory::memoryManager()->addRootPool(
+        poolName, memory::kMaxMemory, std::make_unique<MemoryReclaimer>(this));
+    pool_ = rootPool_->addLeafChild(poolName + ".leaf");
+  }
+}
+
+std::shared_ptr<const void> SharedLRUCache::getEntry(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* value = cache_.get(key);
+  if (value == nullptr) {
+    return nullptr;
+  }
+  // The entry is pinned only while its value is copied out.
+  auto entry = *value;
+  cache_.release(key);
+  return entry;
+}
+
+bool SharedLRUCache::put(
+    const std::string& key,
+    std::shared_ptr<const void> value,
+    uint64_t sizeBytes) {
+  auto entry =
+      std::make_unique<std::shared_ptr<const void>>(std::move(value));
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto numEntries = cache_.stats().numElements;
+  if (!cache_.add(key, entry.get(), sizeBytes)) {
+    return false;
+  }
+  entry.release();
+  numEvictions_ += numEntries + 1 - cache_.stats().numElements;
+  return true;
+}
+
+uint64_t SharedLRUCache::shrink(uint64_t targetBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto numEntries = cache_.stats().numElements;
+  const auto evictedBytes =
+      cache_.free(targetBytes == 0 ? cache_.currentSize() : targetBytes);
+  numEvictions_ += numEntries - cache_.stats().numElements;
+  return evictedBytes;
+}
+
+SharedLRUCache::Stats SharedLRUCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto stats = cache_.stats();
+  return {
+      stats.numElements,
+      stats.curSize,
+      stats.numLookups,
+      stats.numHits,
+      numEvictions_};
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox {
+
+/// A thread-safe LRU cache of immutable values held by shared pointers and
+/// bounded by the total size of the values, built on SimpleLRUCache. The
+/// holders of a value keep it valid after its entry is evicted. If created
+/// with a pool name, the cache owns a root memory pool of that name whose
+/// memory reclaimer evicts entries, so that the memory arbitrator can reclaim
+/// the memory of the values allocated from pool().
+class SharedLRUCache {
+ public:
+  struct Stats {
+    uint64_t numEntries{0};
+    uint64_t sizeBytes{0};
+    uint64_t numLookups{0};
+    uint64_t numHits{0};
+    uint64_t numEvictions{0};
+  };
+
+  explicit SharedLRUCache(
+      uint64_t capacityBytes,
+      const std::string& poolName = "");
+
+  /// Returns the value of type T cached under 'key' or nullptr if there is
+  /// none. The values of a key must all be of the same type.
+  template <typename T>
+  std::shared_ptr<const T> get(const std::string& key) {
+    return std::static_pointer_cast<const T>(getEntry(key));
+  }
+
+  /// Caches 'value' under 'key' and accounts it as 'sizeBytes', evicting
+  /// entries in LRU order to make room. Returns false and does nothing if
+  /// 'key' is already cached or 'sizeBytes' exceeds the capacity.
+  bool put(
+      const std::string& key,
+      std::shared_ptr<const void> value,
+      uint64_t sizeBytes);
+
+  /// Evicts entries in LRU order until at least 'targetBytes' are evicted, or
+  /// all entries if 'targetBytes' is 0. Returns the evicted bytes.
+  uint64_t shrink(uint64_t targetBytes);
+
+  void clear() {
+    shrink(0);
+  }
+
+  uint64_t capacityBytes() const {
+    return capacityBytes_;
+  }
+
+  Stats stats() const;
+
+  /// The pool to allocate the cached values from, nullptr if the cache was
+  /// created without a pool name.
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+ private:
+  class MemoryReclaimer;
+
+  std::shared_ptr<const void> getEntry(const std::string& key);
+
+  const uint64_t capacityBytes_;
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  // Declared after the pools so that the values are freed first.
+  SimpleLRUCache<std::string, std::shared_ptr<const void>> cache_;
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionPolicy.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::cache {
+
+TinyLfuSsdAdmissionPolicy::TinyLfuSsdAdmissionPolicy(const Config& config)
+    : config_(config),
+      mask_(
+          bits::nextPowerOfTwo(std::max<uint32_t>(config.numCounters, 64)) -
+          1),
+      sampleSize_(
+          config.sampleSize == 0 ? 8ULL * (mask_ + 1) : config.sampleSize),
+      counters_(kNumRows * (mask_ + 1), 0),
+      doorKeeper_(mask_ + 1, false) {
+  VELOX_CHECK_GT(config_.minAccesses, 0);
+  VELOX_CHECK_LE(config_.minAccesses, kMaxCount + 1);
+  VELOX_CHECK_GT(config_.writeWindowMs, 0);
+}
+
+// static
+uint64_t TinyLfuSsdAdmissionPolicy::hash(
+    uint64_t groupId,
+    TrackingId trackingId) {
+  return folly::hash::hash_128_to_64(groupId, trackingId.id());
+}
+
+void TinyLfuSsdAdmissionPolicy::recordAccess(
+    uint64_t groupId,
+    TrackingId trackingId) {
+  const auto hashValue = hash(groupId, trackingId);
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numAccesses_;
+  const auto keeperIndex = doorKeeperIndex(hashValue);
+  if (!doorKeeper_[keeperIndex]) {
+    doorKeeper_[keeperIndex] = true;
+  } else {
+    // Conservative update: only the counters at the minimum are incremented.
+    const auto count = minCountLocked(hashValue);
+    if (count < kMaxCount) {
+      for (auto row = 0; row < kNumRows; ++row) {
+        auto& counter =
+            counters_[row * (mask_ + 1) + counterIndex(hashValue, row)];
+        if (counter == count) {
+          ++counter;
+        }
+      }
+    }
+  }
+  if (++numSampled_ >= sampleSize_) {
+    ageLocked();
+  }
+}
+
+uint32_t TinyLfuSsdAdmissionPolicy::minCountLocked(uint64_t hashValue) const {
+  uint32_t count = kMaxCount;
+  for (auto row = 0; row < kNumRows; ++row) {
+    count = std::min<uint32_t>(
+        count, counters_[row * (mask_ + 1) + counterIndex(hashValue, row)]);
+  }
+  return count;
+}
+
+uint32_t TinyLfuSsdAdmissionPolicy::frequencyLocked(uint64_t hashValue) const {
+  return minCountLocked(hashValue) +
+      (doorKeeper_[doorKeeperIndex(hashValue)] ? 1 : 0);
+}
+
+uint32_t TinyLfuSsdAdmissionPolicy::frequency(
+    uint64_t groupId,
+    TrackingId trackingId) const {
+  const auto hashValue = hash(groupId, trackingId);
+  std::lock_guard<std::mutex> l(mutex_);
+  return frequencyLocked(hashValue);
+}
+
+bool TinyLfuSsdAdmissionPolicy::shouldAdmit(
+    uint64_t groupId,
+    TrackingId trackingId) const {
+  const auto hashValue = hash(groupId, trackingId);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (frequencyLocked(hashValue) >= config_.minAccesses) {
+    ++numAdmitted_;
+    return true;
+  }
+  ++numRejected_;
+  return false;
+}
+
+void TinyLfuSsdAdmissionPolicy::age() {
+  std::lock_guard<std::mutex> l(mutex_);
+  ageLocked();
+}
+
+void TinyLfuSsdAdmissionPolicy::ageLocked() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  std::fill(doorKeeper_.begin(), doorKeeper_.end(), false);
+  numSampled_ = 0;
+  ++numAgings_;
+}
+
+uint64_t TinyLfuSsdAdmissionPolicy::acquireWriteBytes(uint64_t bytes) {
+  if (config_.maxWriteBytes == 0) {
+    return bytes;
+  }
+  const auto nowMs = getCurrentTimeMs();
+  std::lock_guard<std::mutex> l(mutex_);
+  if (nowMs >= windowStartMs_ + config_.writeWindowMs) {
+    windowStartMs_ = nowMs;
+    windowBytes_ = 0;
+  }
+  uint64_t granted = bytes;
+  if (windowBytes_ > 0) {
+    granted = windowBytes_ >= config_.maxWriteBytes
+        ? 0
+        : std::min(bytes, config_.maxWriteBytes - windowBytes_);
+  }
+  windowBytes_ += granted;
+  throttledBytes_ += bytes - granted;
+  return granted;
+}
+
+std::string TinyLfuSsdAdmissionPolicy::toString() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return fmt::format(
+      "TinyLFU SSD admission: {} accesses, {} agings, {} admitted, "
+      "{} rejected, {} throttled",
+      numAccesses_,
+      numAgings_,
+      numAdmitted_,
+      numRejected_,
+      succinctBytes(throttledBytes_));
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/ScanTracker.h"
+
+namespace facebook::velox::cache {
+
+/// Decides which data is worth writing to SSD cache. Fed by FileGroupStats
+/// with the accesses recorded by the ScanTrackers of the running scans.
+/// Implementations must be thread safe.
+class SsdAdmissionPolicy {
+ public:
+  virtual ~SsdAdmissionPolicy() = default;
+
+  /// Records that a scan reads the column 'trackingId' of the file group
+  /// 'groupId'. Called once per scan, column and group.
+  virtual void recordAccess(uint64_t groupId, TrackingId trackingId) = 0;
+
+  /// Returns true if the data of 'trackingId' in 'groupId' should be written
+  /// to SSD when evicted from memory.
+  virtual bool shouldAdmit(uint64_t groupId, TrackingId trackingId) const = 0;
+
+  /// Discounts the accesses recorded so far. Called periodically by the cache
+  /// after a large fraction of its memory has been replaced.
+  virtual void age() = 0;
+
+  /// Returns how many of the next 'bytes' to be written to SSD are allowed by
+  /// the write bandwidth limit of the policy, if any. The returned bytes are
+  /// charged to the limit.
+  virtual uint64_t acquireWriteBytes(uint64_t bytes) = 0;
+
+  virtual std::string toString() const = 0;
+};
+
+/// Admits the columns of the file groups that are read by at least
+/// 'minAccesses' scans, TinyLFU style. The access counts are kept in a count
+/// min sketch of small saturating counters behind a door keeper bit set that
+/// absorbs the first access, so that the groups and columns only scanned once
+/// do not take any counter. All counts are halved and the door keeper is
+/// cleared every 'sampleSize' accesses and on age() so that the admission
+/// follows the recent workload.
+///
+/// Optionally caps the SSD write bandwidth to 'maxWriteBytes' per
+/// 'writeWindowMs'. The first write of a window is always allowed so that
+/// entries larger than the budget are not starved.
+class TinyLfuSsdAdmissionPolicy : public SsdAdmissionPolicy {
+ public:
+  struct Config {
+    /// Number of counters in each row of the sketch. Rounded up to a power of
+    /// 2.
+    uint32_t numCounters{1 << 16};
+
+    /// Min number of scans that must read a column of a group for its data to
+    /// be admitted.
+    uint32_t minAccesses{2};
+
+    /// Number of recorded accesses after which all counts are halved. 0 means
+    /// 8 * 'numCounters'.
+    uint64_t sampleSize{0};
+
+    /// Max bytes written to SSD per 'writeWindowMs'. 0 means no limit.
+    uint64_t maxWriteBytes{0};
+
+    uint64_t writeWindowMs{1'000};
+  };
+
+  explicit TinyLfuSsdAdmissionPolicy(const Config& config);
+
+  void recordAccess(uint64_t groupId, TrackingId trackingId) override;
+
+  bool shouldAdmit(uint64_t groupId, TrackingId trackingId) const override;
+
+  void age() override;
+
+  uint64_t acquireWriteBytes(uint64_t bytes) override;
+
+  std::string toString() const override;
+
+  /// Returns the estimated number of scans that read 'trackingId' in
+  /// 'groupId' since the start, discounted by aging.
+  uint32_t frequency(uint64_t groupId, TrackingId trackingId) const;
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  static uint64_t hash(uint64_t groupId, TrackingId trackingId);
+
+  // Returns the index of the counter for 'hash' in 'row' of the sketch.
+  uint32_t counterIndex(uint64_t hash, int32_t row) const {
+    return (hash + row * ((hash >> 32) | 1)) & mask_;
+  }
+
+  uint32_t doorKeeperIndex(uint64_t hash) const {
+    return (hash >> 40) & mask_;
+  }
+
+  // Returns the smallest of the sketch counters of 'hash'.
+  uint32_t minCountLocked(uint64_t hash) const;
+
+  // Returns the smallest counter plus the door keeper bit of 'hash'.
+  uint32_t frequencyLocked(uint64_t hash) const;
+
+  void ageLocked();
+
+  const Config config_;
+  const uint32_t mask_;
+  const uint64_t sampleSize_;
+
+  mutable std::mutex mutex_;
+  // 'kNumRows' rows of counters.
+  std::vector<uint8_t> counters_;
+  std::vector<bool> doorKeeper_;
+  uint64_t numSampled_{0};
+
+  uint64_t windowStartMs_{0};
+  uint64_t windowBytes_{0};
+
+  // Stats.
+  uint64_t numAccesses_{0};
+  uint64_t numAgings_{0};
+  mutable uint64_t numAdmitted_{0};
+  mutable uint64_t numRejected_{0};
+  uint64_t throttledBytes_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -16,6 +16,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
@@ -31,7 +32,9 @@ namespace facebook::velox::cache {
 SsdCache::SsdCache(const Config& config)
     : filePrefix_(config.filePrefix),
       numShards_(config.numShards),
-      groupStats_(std::make_unique<FileGroupStats>()),
+      groupStats_(std::make_unique<FileGroupStats>(
+          config.admissionPolicy,
+          config.groupStatsOptions)),
       executor_(config.executor),
       maxEntries_(config.maxEntries) {
   // Make sure the given path of Ssd files has the prefix for local file system.
@@ -62,6 +65,10 @@ SsdCache::SsdCache(const Config& config)
   // Distribute maxEntries across shards
   const uint64_t maxEntriesPerShard =
       maxEntries_ == 0 ? 0 : bits::divRoundUp(maxEntries_, numShards_);
+  // The shards recover from their checkpoints in parallel on 'executor_'.
+  // move() makes the shards that have not been started on this thread.
+  std::vector<std::shared_ptr<AsyncSource<SsdFile>>> shardMakers;
+  shardMakers.reserve(numShards_);
   for (auto i = 0; i < numShards_; ++i) {
     const auto fileConfig = SsdFile::Config(
         fmt::format("{}{}", filePrefix_, i),
@@ -72,8 +79,28 @@ SsdCache::SsdCache(const Config& config)
         config.checksumEnabled,
         checksumReadVerificationEnabled,
         maxEntriesPerShard,
-        executor_);
-    files_.push_back(std::make_unique<SsdFile>(fileConfig));
+        executor_,
+        config.journalEnabled);
+    shardMakers.push_back(std::make_shared<AsyncSource<SsdFile>>(
+        [fileConfig]() { return std::make_unique<SsdFile>(fileConfig); }));
+    if (numShards_ > 1) {
+      executor_->add([shardMaker = shardMakers.back()]() {
+        shardMaker->prepare();
+      });
+    }
+  }
+  std::exception_ptr error;
+  for (auto& shardMaker : shardMakers) {
+    try {
+      files_.push_back(shardMaker->move());
+    } catch (const std::exception&) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
   }
 }
 
@@ -102,6 +129,28 @@ void SsdCache::write(std::vector<CachePin> pins) {
 
   const auto startTimeUs = getCurrentTimeMicro();
 
+  if (auto* policy = groupStats_->admissionPolicy()) {
+    uint64_t totalBytes = 0;
+    for (const auto& pin : pins) {
+      totalBytes += pin.checkedEntry()->size();
+    }
+    const auto grantedBytes = policy->acquireWriteBytes(totalBytes);
+    if (grantedBytes < totalBytes) {
+      // Keeps the pins that fit in the granted bytes in their original order.
+      uint64_t keptBytes = 0;
+      size_t numKept = 0;
+      for (; numKept < pins.size(); ++numKept) {
+        const auto size = pins[numKept].checkedEntry()->size();
+        if (keptBytes + size > grantedBytes) {
+          break;
+        }
+        keptBytes += size;
+      }
+      numThrottled_ += pins.size() - numKept;
+      pins.resize(numKept);
+    }
+  }
+
   uint64_t bytes = 0;
   std::vector<std::vector<CachePin>> shards(numShards_);
   for (const auto& pin : pins) {
@@ -183,11 +232,26 @@ bool SsdCache::removeFileEntries(
   return success;
 }
 
+void SsdCache::addFileBytes(
+    const folly::F14FastSet<uint64_t>& fileNums,
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  std::vector<bool> shards(numShards_, false);
+  for (const auto fileNum : fileNums) {
+    shards[fileNum % numShards_] = true;
+  }
+  for (auto i = 0; i < numShards_; ++i) {
+    if (shards[i]) {
+      files_[i]->addFileBytes(fileNums, fileBytes);
+    }
+  }
+}
+
 SsdCacheStats SsdCache::stats() const {
   SsdCacheStats stats;
   for (auto& file : files_) {
     file->updateStats(stats);
   }
+  stats.writeSsdThrottled = numThrottled_.load();
   return stats;
 }
 
@@ -44,7 +44,9 @@ class SsdCache {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        uint64_t _maxEntries = 0)
+        uint64_t _maxEntries = 0,
+        std::shared_ptr<SsdAdmissionPolicy> _admissionPolicy = nullptr,
+        bool _journalEnabled = false)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -53,7 +55,9 @@ class SsdCache {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
           executor(_executor),
-          maxEntries(_maxEntries) {}
+          maxEntries(_maxEntries),
+          admissionPolicy(std::move(_admissionPolicy)),
+          journalEnabled(_journalEnabled) {}
 
     std::string filePrefix;
     uint64_t maxBytes;
@@ -79,6 +83,20 @@ class SsdCache {
     /// limit. When the limit is reached, new entry writes will be skipped.
     uint64_t maxEntries;
 
+    /// Selects the data written to SSD and limits the SSD write bandwidth. If
+    /// not set, all the data evicted from memory is written.
+    std::shared_ptr<SsdAdmissionPolicy> admissionPolicy;
+
+    /// If true, each file journals the changes after its last checkpoint so
+    /// that a restart recovers the cache as of the crash rather than as of the
+    /// last checkpoint. Requires checkpointing and checksum read verification.
+    /// See SsdFile::Config::journalEnabled.
+    bool journalEnabled{false};
+
+    /// Configures the per file group and column cache access counters and
+    /// the simulated caches of groupStats().
+    FileGroupStats::Options groupStatsOptions;
+
     std::string toString() const {
       return fmt::format(
           "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
@@ -148,6 +166,13 @@ class SsdCache {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the size of the entries for the files in 'fileNums' to the
+  /// corresponding element of 'fileBytes'. Only scans the shards of
+  /// 'fileNums'.
+  void addFileBytes(
+      const folly::F14FastSet<uint64_t>& fileNums,
+      folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   /// Returns stats aggregated from all shards.
   SsdCacheStats stats() const;
 
@@ -199,6 +224,8 @@ class SsdCache {
 
   // Count of shards with unfinished writes.
   std::atomic_int32_t writesInProgress_{0};
+  // Number of entries not written because of the SSD write bandwidth limit.
+  std::atomic_uint32_t numThrottled_{0};
   bool shutdown_{false};
 
   friend class test::SsdCacheTestHelper;
@@ -22,6 +22,7 @@
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/process/TraceContext.h"
 
@@ -35,6 +36,7 @@
 #include <numeric>
 
 DECLARE_bool(velox_ssd_odirect);
+DECLARE_int32(velox_io_uring_queue_depth);
 DECLARE_bool(velox_ssd_verify_write);
 
 namespace facebook::velox::cache {
@@ -114,9 +116,16 @@ SsdFile::SsdFile(const Config& config)
       shardId_(config.shardId),
       maxEntries_(config.maxEntries),
       executor_(config.executor),
+      journalEnabled_(
+          config.journalEnabled && config.checksumReadVerificationEnabled),
       fs_(filesystems::getFileSystem(fileName_, nullptr)),
       checkpointIntervalBytes_(config.checkpointIntervalBytes) {
   process::TraceContext trace("SsdFile::SsdFile");
+  if (config.journalEnabled && !journalEnabled_) {
+    VELOX_SSD_CACHE_LOG(WARNING)
+        << "SSD cache journal of " << fileName_
+        << " is disabled as checksum read verification is not enabled.";
+  }
   filesystems::FileOptions fileOptions;
   fileOptions.shouldThrowOnFileAlreadyExists = false;
   fileOptions.bufferIo = !FLAGS_velox_ssd_odirect;
@@ -382,6 +391,11 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // With io_uring, LocalWriteFile issues the IOV_MAX sized pieces of a write
+  // concurrently, so a single write may cover up to a full queue of them.
+  const size_t maxWriteIovecs = IoUring::instance() != nullptr
+      ? static_cast<size_t>(IOV_MAX) * FLAGS_velox_io_uring_queue_depth
+      : IOV_MAX;
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
     auto space = getSpace(pins, writeIndex);
@@ -396,13 +410,16 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     uint64_t writeOffset = offset;
     int32_t writeLength = 0;
     std::vector<iovec> writeIovecs;
+    // The checksums of the written entries, computed while collecting their
+    // iovecs so that they stay out of 'mutex_'.
+    std::vector<uint32_t> checksums;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
       const auto entrySize = entry->size();
       const auto numIovecs = numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
-      if (writeIovecs.size() + numIovecs > IOV_MAX) {
-        // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
+      if (writeIovecs.size() + numIovecs > maxWriteIovecs) {
+        // Writes out the accumulated iovecs if it exceeds the iovec limit.
         if (!write(writeOffset, writeLength, writeIovecs)) {
           // If write fails, we return without adding the pins to the cache. The
           // entries are unchanged.
@@ -417,6 +434,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         break;
       }
       addEntryToIovecs(*entry, writeIovecs);
+      if (checksumEnabled_) {
+        checksums.push_back(checksumEntry(*entry));
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
@@ -441,10 +461,8 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         const auto size = entry->size();
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        uint32_t checksum = 0;
-        if (checksumEnabled_) {
-          checksum = checksumEntry(*entry);
-        }
+        const uint32_t checksum =
+            checksumEnabled_ ? checksums[i - writeIndex] : 0;
         entries_[std::move(key)] = SsdRun(offset, size, checksum);
         if (FLAGS_velox_ssd_verify_write) {
           verifyWrite(*entry, SsdRun(offset, size, checksum));
@@ -454,6 +472,10 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         stats_.bytesWritten += size;
         bytesAfterCheckpoint_ += size;
       }
+      if (journalEnabled()) {
+        journalEntriesLocked(
+            pins, writeIndex, writeIndex + numWrittenEntries);
+      }
     }
     writeIndex += numWrittenEntries;
   }
@@ -574,6 +596,11 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
 
 void SsdFile::clear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
+  if (journalEnabled()) {
+    std::vector<int32_t> regions(numRegions_);
+    std::iota(regions.begin(), regions.end(), 0);
+    journalEvictionLocked(regions);
+  }
   entries_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
@@ -582,6 +609,17 @@ void SsdFile::clear() {
   tracker_.clear();
 }
 
+void SsdFile::addFileBytes(
+    const folly::F14FastSet<uint64_t>& fileNums,
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    if (key.fileNum.hasValue() && fileNums.count(key.fileNum.id()) != 0) {
+      fileBytes[key.fileNum.id()] += run.size();
+    }
+  }
+}
+
 bool SsdFile::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -666,11 +704,104 @@ void SsdFile::logEviction(std::vector<int32_t>& regions) {
   const auto length = regions.size() * sizeof(regions[0]);
   const std::vector<iovec> iovecs = {{regions.data(), length}};
   try {
-    evictLogWriteFile_->write(iovecs, 0, static_cast<int64_t>(length));
+    evictLogWriteFile_->write(
+        iovecs,
+        static_cast<int64_t>(evictLogWriteFile_->size()),
+        static_cast<int64_t>(length));
   } catch (const std::exception& e) {
     ++stats_.writeSsdErrors;
     VELOX_SSD_CACHE_LOG(ERROR) << "Failed to log eviction: " << e.what();
   }
+  if (journalEnabled()) {
+    journalEvictionLocked(regions);
+  }
+}
+
+void SsdFile::journalEvictionLocked(const std::vector<int32_t>& regions) {
+  std::string payload;
+  payload.push_back(static_cast<char>(JournalRecordKind::kEviction));
+  const int32_t numRegions = regions.size();
+  payload.append(reinterpret_cast<const char*>(&numRegions), sizeof(int32_t));
+  payload.append(
+      reinterpret_cast<const char*>(regions.data()),
+      regions.size() * sizeof(int32_t));
+  appendJournalLocked(payload);
+}
+
+void SsdFile::journalEntriesLocked(
+    const std::vector<CachePin>& pins,
+    int32_t begin,
+    int32_t end) {
+  if (begin == end) {
+    return;
+  }
+  std::string payload;
+  payload.push_back(static_cast<char>(JournalRecordKind::kEntries));
+  const auto appendNumber = [&](const auto& value) {
+    payload.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  // The pins are sorted by file, so that each file is listed once.
+  std::vector<uint64_t> fileNums;
+  for (auto i = begin; i < end; ++i) {
+    const auto fileNum = pins[i].checkedEntry()->key().fileNum.id();
+    if (fileNums.empty() || fileNums.back() != fileNum) {
+      fileNums.push_back(fileNum);
+    }
+  }
+  appendNumber(static_cast<int32_t>(fileNums.size()));
+  for (const auto fileNum : fileNums) {
+    const auto name = fileIds().string(fileNum);
+    appendNumber(fileNum);
+    appendNumber(static_cast<int32_t>(name.size()));
+    payload.append(name);
+  }
+  appendNumber(static_cast<int32_t>(end - begin));
+  for (auto i = begin; i < end; ++i) {
+    const auto* entry = pins[i].checkedEntry();
+    const auto it = entries_.find(
+        FileCacheKey{
+            entry->key().fileNum, static_cast<uint64_t>(entry->offset())});
+    VELOX_CHECK(it != entries_.end());
+    appendNumber(entry->key().fileNum.id());
+    appendNumber(static_cast<uint64_t>(entry->offset()));
+    appendNumber(it->second.fileBits());
+    appendNumber(it->second.checksum());
+  }
+  appendJournalLocked(payload);
+}
+
+void SsdFile::appendJournalLocked(const std::string& payload) {
+  if (journalWriteFile_ == nullptr) {
+    return;
+  }
+  try {
+    bits::Crc32 crc;
+    crc.process_bytes(payload.data(), payload.size());
+    const uint32_t header[2] = {
+        static_cast<uint32_t>(payload.size()), crc.checksum()};
+    std::string record(reinterpret_cast<const char*>(header), sizeof(header));
+    record.append(payload);
+    journalWriteFile_->append(record);
+  } catch (const std::exception& e) {
+    ++stats_.writeSsdErrors;
+    VELOX_SSD_CACHE_LOG(ERROR) << "Failed to append to journal: " << e.what();
+    // A journal with a missing record must not be replayed. Removing the
+    // header voids the journal until the next checkpoint resets it.
+    try {
+      truncateFile(journalWriteFile_.get());
+    } catch (const std::exception&) {
+    }
+  }
+}
+
+void SsdFile::resetJournal() {
+  VELOX_CHECK_NOT_NULL(journalWriteFile_);
+  journalWriteFile_->truncate(0);
+  std::string header(kJournalMagic, 4);
+  header.append(
+      reinterpret_cast<const char*>(&checkpointId_), sizeof(checkpointId_));
+  journalWriteFile_->append(header);
+  journalWriteFile_->flush();
 }
 
 void SsdFile::deleteCheckpoint(bool keepLog) {
@@ -686,9 +817,31 @@ void SsdFile::deleteCheckpoint(bool keepLog) {
     }
   }
 
+  if (journalWriteFile_ != nullptr) {
+    if (keepLog) {
+      truncateFile(journalWriteFile_.get());
+    } else {
+      deleteFile(std::move(journalWriteFile_));
+    }
+  }
+
   if (checkpointWriteFile_ != nullptr) {
     deleteFile(std::move(checkpointWriteFile_));
   }
+
+  if (journalEnabled_) {
+    // 'checkpointWriteFile_' is the temporary file.
+    const auto checkpointPath = checkpointFilePath();
+    try {
+      if (fs_->exists(checkpointPath)) {
+        fs_->remove(checkpointPath);
+      }
+    } catch (const std::exception& e) {
+      ++stats_.deleteMetaFileErrors;
+      VELOX_SSD_CACHE_LOG(ERROR) << fmt::format(
+          "Error in deleting file {}: {}", checkpointPath, e.what());
+    }
+  }
 }
 
 void SsdFile::truncateFile(WriteFile* file) {
@@ -770,6 +923,25 @@ void SsdFile::flushCheckpointFile() {
   checkpointWriteFile_->flush();
 }
 
+void SsdFile::commitCheckpointFile() {
+  VELOX_CHECK_NOT_NULL(checkpointWriteFile_);
+  const auto tempPath = checkpointTempFilePath();
+  checkpointWriteFile_->close();
+  checkpointWriteFile_.reset();
+  // The rename is atomic, so a crash leaves either the previous or this
+  // checkpoint.
+  fs_->rename(tempPath, checkpointFilePath(), /*overwrite=*/true);
+  filesystems::FileOptions writeFileOptions;
+  writeFileOptions.shouldThrowOnFileAlreadyExists = false;
+  checkpointWriteFile_ = fs_->openFileForWrite(tempPath, writeFileOptions);
+#ifdef linux
+  if (disableFileCow_) {
+    checkpointWriteFile_->setAttributes(
+        {{std::string(LocalWriteFile::Attributes::kNoCow), "true"}});
+  }
+#endif // linux
+}
+
 void SsdFile::checkpoint(bool force) {
   process::TraceContext trace("SsdFile::checkpoint");
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -849,7 +1021,16 @@ void SsdFile::checkpoint(bool force) {
       fileSync->move();
 
       appendToCheckpointBuffer(kCheckpointEndMarker);
+      if (journalEnabled()) {
+        // The id follows the end marker so that the checkpoint stays readable
+        // without the journal.
+        appendToCheckpointBuffer(checkpointId_ + 1);
+      }
       flushCheckpointFile();
+      if (journalEnabled()) {
+        commitCheckpointFile();
+        ++checkpointId_;
+      }
       ++stats_.checkpointsWritten;
     } catch (const std::exception& e) {
       ++stats_.writeCheckpointErrors;
@@ -864,6 +1045,9 @@ void SsdFile::checkpoint(bool force) {
     VELOX_CHECK_NOT_NULL(evictLogWriteFile_);
     evictLogWriteFile_->truncate(0);
     evictLogWriteFile_->flush();
+    if (journalWriteFile_ != nullptr) {
+      resetJournal();
+    }
 
     VELOX_SSD_CACHE_LOG(INFO)
         << "Checkpoint persisted with " << entries_.size() << " cache entries";
@@ -901,7 +1085,8 @@ void SsdFile::initializeCheckpoint() {
   filesystems::FileOptions writeFileOptions;
   writeFileOptions.shouldThrowOnFileAlreadyExists = false;
 
-  const auto checkpointPath = checkpointFilePath();
+  const auto checkpointPath =
+      journalEnabled() ? checkpointTempFilePath() : checkpointFilePath();
   try {
     checkpointWriteFile_ =
         fs_->openFileForWrite(checkpointPath, writeFileOptions);
@@ -922,6 +1107,18 @@ void SsdFile::initializeCheckpoint() {
     VELOX_FAIL("Could not open evict log {}: {}", logPath, e.what());
   }
 
+  if (journalEnabled()) {
+    const auto journalPath = journalFilePath();
+    try {
+      journalWriteFile_ =
+          fs_->openFileForWrite(journalPath, writeFileOptions);
+    } catch (const std::exception& e) {
+      ++stats_.openLogErrors;
+      VELOX_FAIL("Could not open journal {}: {}", journalPath, e.what());
+    }
+  }
+
+  const uint64_t checkpointsRead = stats_.checkpointsRead;
   try {
     readCheckpoint();
   } catch (const std::exception& e) {
@@ -934,10 +1131,23 @@ void SsdFile::initializeCheckpoint() {
     } catch (const std::exception&) {
     }
   }
+
+  // Voids the journal of a checkpoint that is not recovered. A recovered
+  // journal is truncated to its valid part by replayJournal().
+  if (journalWriteFile_ != nullptr &&
+      stats_.checkpointsRead == checkpointsRead) {
+    try {
+      resetJournal();
+    } catch (const std::exception& e) {
+      ++stats_.writeSsdErrors;
+      VELOX_SSD_CACHE_LOG(ERROR) << "Failed to reset journal: " << e.what();
+      journalWriteFile_.reset();
+    }
+  }
 }
 
 uint32_t SsdFile::checksumEntry(const AsyncDataCacheEntry& entry) const {
-  bits::Crc32 crc;
+  bits::Crc32c crc;
   if (entry.tinyData()) {
     crc.process_bytes(entry.tinyData(), entry.size());
   } else {
@@ -1020,6 +1230,120 @@ std::vector<T> readVector(common::FileInputStream* stream, int32_t size) {
 }
 } // namespace
 
+void SsdFile::replayJournal(
+    uint64_t checkpointId,
+    std::unordered_set<uint32_t>& evictedRegions) {
+  VELOX_CHECK_NOT_NULL(journalWriteFile_);
+  std::string journal;
+  try {
+    const auto journalReadFile = fs_->openFileForRead(journalFilePath());
+    journal.resize(journalReadFile->size());
+    journalReadFile->pread(0, journal.size(), journal.data());
+  } catch (const std::exception& e) {
+    VELOX_SSD_CACHE_LOG(WARNING) << "Failed to read journal: " << e.what();
+    journal.clear();
+  }
+  if (checkpointId == 0 || journal.size() < kJournalHeaderSize ||
+      journal.compare(0, 4, kJournalMagic) != 0 ||
+      *reinterpret_cast<const uint64_t*>(journal.data() + 4) != checkpointId) {
+    resetJournal();
+    return;
+  }
+
+  const auto maxFileRegions = static_cast<int32_t>(fileSize_ / kRegionSize);
+  int32_t numRecords = 0;
+  int32_t numEntries = 0;
+  size_t position = kJournalHeaderSize;
+  while (position + kJournalRecordHeaderSize <= journal.size()) {
+    const auto* header =
+        reinterpret_cast<const uint32_t*>(journal.data() + position);
+    const auto payloadSize = header[0];
+    if (position + kJournalRecordHeaderSize + payloadSize > journal.size()) {
+      // Torn write at the end of the journal.
+      break;
+    }
+    const char* payload = journal.data() + position + kJournalRecordHeaderSize;
+    bits::Crc32 crc;
+    crc.process_bytes(payload, payloadSize);
+    if (crc.checksum() != header[1]) {
+      break;
+    }
+    const char* end = payload + payloadSize;
+    const auto read = [&](auto& value) {
+      VELOX_CHECK_LE(payload + sizeof(value), end);
+      ::memcpy(&value, payload, sizeof(value));
+      payload += sizeof(value);
+    };
+    uint8_t kind;
+    read(kind);
+    int32_t count;
+    read(count);
+    if (kind == static_cast<uint8_t>(JournalRecordKind::kEviction)) {
+      std::unordered_set<int32_t> regions;
+      for (auto i = 0; i < count; ++i) {
+        int32_t region;
+        read(region);
+        regions.insert(region);
+        evictedRegions.insert(region);
+      }
+      for (auto it = entries_.begin(); it != entries_.end();) {
+        if (regions.count(regionIndex(it->second.offset())) != 0) {
+          it = entries_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    } else {
+      VELOX_CHECK_EQ(kind, static_cast<uint8_t>(JournalRecordKind::kEntries));
+      folly::F14FastMap<uint64_t, StringIdLease> idMap;
+      for (auto i = 0; i < count; ++i) {
+        uint64_t fileNum;
+        read(fileNum);
+        int32_t length;
+        read(length);
+        VELOX_CHECK_LE(payload + length, end);
+        idMap[fileNum] =
+            StringIdLease(fileIds(), std::string_view(payload, length));
+        payload += length;
+      }
+      read(count);
+      for (auto i = 0; i < count; ++i) {
+        uint64_t fileNum;
+        uint64_t offset;
+        uint64_t fileBits;
+        uint32_t checksum;
+        read(fileNum);
+        read(offset);
+        read(fileBits);
+        read(checksum);
+        const SsdRun run(fileBits, checksum);
+        const auto region = regionIndex(run.offset());
+        if (region >= maxFileRegions) {
+          continue;
+        }
+        const auto it = idMap.find(fileNum);
+        VELOX_CHECK(it != idMap.end());
+        entries_[FileCacheKey{it->second, offset}] = run;
+        // The region was reused after its eviction.
+        evictedRegions.erase(region);
+        numRegions_ = std::max(numRegions_, region + 1);
+        ++numEntries;
+      }
+    }
+    position += kJournalRecordHeaderSize + payloadSize;
+    ++numRecords;
+  }
+
+  // Drops the torn tail, if any, so that new records follow the valid ones.
+  journalWriteFile_->truncate(position);
+  VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
+      "Replayed {} journal records with {} entries of shard {}, dropped {}",
+      numRecords,
+      numEntries,
+      shardId_,
+      succinctBytes(journal.size() - position));
+}
+
 void SsdFile::readCheckpoint() {
   const auto checkpointPath = checkpointFilePath();
   std::unique_ptr<common::FileInputStream> stream;
@@ -1050,6 +1374,13 @@ void SsdFile::readCheckpoint() {
         checkpointPath);
     return;
   }
+  if (checksumEnabled_ && versionMagic != checkpointVersion()) {
+    VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+        "Starting shard {} without checkpoint: the checkpoint was made with a different checksum, so skip the checkpoint recovery, checkpoint file {}",
+        shardId_,
+        checkpointPath);
+    return;
+  }
 
   const auto maxRegions = readNumber<int32_t>(stream.get());
   VELOX_CHECK_EQ(
@@ -1085,7 +1416,6 @@ void SsdFile::readCheckpoint() {
     evictedMap.insert(region);
   }
 
-  std::vector<uint32_t> regionCacheSizes(numRegions_, 0);
   for (;;) {
     const auto fileNum = readNumber<uint64_t>(stream.get());
     if (fileNum == kCheckpointEndMarker) {
@@ -1108,6 +1438,19 @@ void SsdFile::readCheckpoint() {
     VELOX_CHECK(it != idMap.end());
     FileCacheKey key{it->second, offset};
     entries_[std::move(key)] = run;
+  }
+
+  if (journalEnabled()) {
+    // A checkpoint made without journal has no id.
+    const auto checkpointId =
+        stream->atEnd() ? 0 : readNumber<uint64_t>(stream.get());
+    checkpointId_ = std::max(checkpointId_, checkpointId);
+    replayJournal(checkpointId, evictedMap);
+  }
+
+  std::vector<uint32_t> regionCacheSizes(numRegions_, 0);
+  for (const auto& [key, run] : entries_) {
+    const auto region = regionIndex(run.offset());
     regionCacheSizes[region] += run.size();
     regionSizes_[region] = std::max<uint32_t>(
         regionSizes_[region], regionOffset(run.offset()) + run.size());
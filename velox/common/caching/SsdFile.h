@@ -18,6 +18,7 @@
 
 #include <gflags/gflags.h>
 #include <shared_mutex>
+#include <unordered_set>
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
@@ -75,7 +76,7 @@ class SsdRun {
     return (fileBits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
-  /// Returns the checksum computed with crc32.
+  /// Returns the checksum computed with crc32c.
   uint32_t checksum() const {
     return checksum_;
   }
@@ -171,6 +172,7 @@ struct SsdCacheStats {
     writeSsdNoSpaceErrors = tsanAtomicValue(other.writeSsdNoSpaceErrors);
     writeSsdDropped = tsanAtomicValue(other.writeSsdDropped);
     writeSsdExceedEntryLimit = tsanAtomicValue(other.writeSsdExceedEntryLimit);
+    writeSsdThrottled = tsanAtomicValue(other.writeSsdThrottled);
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
@@ -204,6 +206,7 @@ struct SsdCacheStats {
     result.writeSsdDropped = writeSsdDropped - other.writeSsdDropped;
     result.writeSsdExceedEntryLimit =
         writeSsdExceedEntryLimit - other.writeSsdExceedEntryLimit;
+    result.writeSsdThrottled = writeSsdThrottled - other.writeSsdThrottled;
     result.writeCheckpointErrors =
         writeCheckpointErrors - other.writeCheckpointErrors;
     result.readSsdCorruptions = readSsdCorruptions - other.readSsdCorruptions;
@@ -245,6 +248,9 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeSsdNoSpaceErrors{0};
   tsan_atomic<uint32_t> writeSsdDropped{0};
   tsan_atomic<uint32_t> writeSsdExceedEntryLimit{0};
+  /// Number of entries whose write was deferred to a later save by the SSD
+  /// write bandwidth limit of the admission policy.
+  tsan_atomic<uint32_t> writeSsdThrottled{0};
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
@@ -270,7 +276,8 @@ class SsdFile {
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
         uint64_t _maxEntries = 0,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        bool _journalEnabled = false)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -280,7 +287,8 @@ class SsdFile {
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
           maxEntries(_maxEntries),
-          executor(_executor) {}
+          executor(_executor),
+          journalEnabled(_journalEnabled) {}
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -310,6 +318,15 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* const executor;
+
+    /// If true, the entries written and the regions evicted after the last
+    /// checkpoint are appended to a journal that is replayed on top of the
+    /// checkpoint on recovery, and checkpoints are written to a temporary file
+    /// that replaces the previous checkpoint only once complete. The data of
+    /// the journaled entries is not synced, so the recovered entries are
+    /// validated lazily on read by their checksums. Requires checkpointing and
+    /// checksum read verification, ignored otherwise.
+    const bool journalEnabled;
   };
 
   enum class State : uint8_t {
@@ -375,6 +392,12 @@ class SsdFile {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the size of the entries of the files in 'fileNums' to the
+  /// corresponding element of 'fileBytes'.
+  void addFileBytes(
+      const folly::F14FastSet<uint64_t>& fileNums,
+      folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   /// Writes a checkpoint state that can be recovered from. The checkpoint is
   /// serialized on 'mutex_'. If 'force' is false, rechecks that at least
   /// 'checkpointIntervalBytes_' have been written since last checkpoint and
@@ -400,6 +423,17 @@ class SsdFile {
     return fileName_ + kCheckpointExtension;
   }
 
+  /// Returns the path of the file a checkpoint is written to before it
+  /// replaces the checkpoint file. Only used if the journal is enabled.
+  std::string checkpointTempFilePath() const {
+    return checkpointFilePath() + kTempExtension;
+  }
+
+  /// Returns the journal file path.
+  std::string journalFilePath() const {
+    return fileName_ + kJournalExtension;
+  }
+
   /// Resets this' to a post-construction empty state. See SsdCache::clear().
   ///
   /// NOTE: this is only used by test and Prestissimo worker operation.
@@ -412,6 +446,22 @@ class SsdFile {
   // Magic number at end of completed checkpoint file.
   static constexpr int64_t kCheckpointEndMarker = 0xcbedf11e;
 
+  // The journal starts with a header of the magic and the id of the
+  // checkpoint it applies to. It is followed by records of 4 bytes payload
+  // size, 4 bytes crc of the payload and the payload. The payload starts with
+  // a JournalRecordKind.
+  static constexpr const char* kJournalMagic = "JNL1";
+  static constexpr int32_t kJournalHeaderSize = 4 + sizeof(uint64_t);
+  static constexpr int32_t kJournalRecordHeaderSize = 2 * sizeof(uint32_t);
+
+  enum class JournalRecordKind : uint8_t {
+    // int32_t numFiles, {fileId, nameLength, name} * numFiles,
+    // int32_t numEntries, {fileId, offset, SsdRun bits, checksum} * numEntries.
+    kEntries = 1,
+    // int32_t numRegions, region * numRegions.
+    kEviction = 2,
+  };
+
   // Maximum percentage of erased entries in a region before it becomes
   // eligible for clearing and reuse. When more than 50% of a region's
   // entries have been erased (e.g., via TTL eviction), the region can be
@@ -442,8 +492,10 @@ class SsdFile {
 
   // The first 4 bytes of a checkpoint file contains version string to indicate
   // if checksum write is enabled or not.
+  // CPT2 checkpoints have CRC32 entry checksums and CPT3 ones have CRC32C
+  // entry checksums.
   std::string checkpointVersion() const {
-    return checksumEnabled_ ? "CPT2" : "CPT1";
+    return checksumEnabled_ ? "CPT3" : "CPT1";
   }
 
   // Increments the pin count of the region of 'offset'. Caller must hold
@@ -478,6 +530,40 @@ class SsdFile {
   // failed read deletes the checkpoint and leaves the truncated log open.
   void readCheckpoint();
 
+  // Applies the valid prefix of the journal of the checkpoint 'checkpointId'
+  // to 'entries_'. Adds the regions evicted in the journal to
+  // 'evictedRegions'. Does nothing if the journal is of another checkpoint.
+  void replayJournal(
+      uint64_t checkpointId,
+      std::unordered_set<uint32_t>& evictedRegions);
+
+  // Appends a record with 'payload' to the journal. Caller must hold
+  // 'mutex_'.
+  void appendJournalLocked(const std::string& payload);
+
+  // Appends a record of the entries of 'pins' in [begin, end) to the journal.
+  // Caller must hold 'mutex_'.
+  void journalEntriesLocked(
+      const std::vector<CachePin>& pins,
+      int32_t begin,
+      int32_t end);
+
+  // Appends a record of the eviction of 'regions' to the journal. Caller must
+  // hold 'mutex_'.
+  void journalEvictionLocked(const std::vector<int32_t>& regions);
+
+  // Truncates the journal and starts it for the current checkpoint.
+  void resetJournal();
+
+  // Replaces the checkpoint file with the completely written temporary
+  // checkpoint file.
+  void commitCheckpointFile();
+
+  // Returns true if the journal is enabled.
+  bool journalEnabled() const {
+    return journalEnabled_ && checkpointEnabled();
+  }
+
   // Logs an error message, deletes the checkpoint and stop making new
   // checkpoints.
   void checkpointError(int32_t rc, const std::string& error);
@@ -564,11 +650,13 @@ class SsdFile {
   // Returns true if checksum write is enabled for the given version.
   static bool isChecksumEnabledOnCheckpointVersion(
       const std::string& checkpointVersion) {
-    return checkpointVersion == "CPT2";
+    return checkpointVersion == "CPT2" || checkpointVersion == "CPT3";
   }
 
   static constexpr const char* kLogExtension = ".log";
   static constexpr const char* kCheckpointExtension = ".cpt";
+  static constexpr const char* kJournalExtension = ".jnl";
+  static constexpr const char* kTempExtension = ".tmp";
   static constexpr uint32_t kCheckpointBufferSize = 1 << 20; // 1MB
 
   // Name of cache file, used as prefix for checkpoint files.
@@ -595,6 +683,10 @@ class SsdFile {
   // Executor for async fsync in checkpoint.
   folly::Executor* const executor_;
 
+  // If true, the entries and the evictions after the last checkpoint are
+  // journaled.
+  const bool journalEnabled_;
+
   // Serializes access to all private data members.
   mutable std::shared_mutex mutex_;
 
@@ -642,9 +734,17 @@ class SsdFile {
   // WriteFile for evict log file.
   std::unique_ptr<WriteFile> evictLogWriteFile_;
 
-  // WriteFile for checkpoint file.
+  // WriteFile for checkpoint file. Writes the temporary checkpoint file if the
+  // journal is enabled.
   std::unique_ptr<WriteFile> checkpointWriteFile_;
 
+  // WriteFile for journal file. Set if the journal is enabled.
+  std::unique_ptr<WriteFile> journalWriteFile_;
+
+  // Id of the last checkpoint written or recovered. 0 if none. Only set if the
+  // journal is enabled.
+  uint64_t checkpointId_{0};
+
   // Counters.
   SsdCacheStats stats_;
 
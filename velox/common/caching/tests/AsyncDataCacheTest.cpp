@@ -1076,6 +1076,52 @@ TEST_P(AsyncDataCacheTest, staleEntry) {
   ASSERT_EQ(stats.numHit, 1);
 }
 
+TEST_P(AsyncDataCacheTest, fileResidency) {
+  constexpr uint64_t kRamBytes = 1UL << 30;
+  initializeCache(kRamBytes, 0, 0);
+  folly::F14FastMap<uint64_t, int64_t> listenedBytes;
+  cache_->setResidencyListener([&](uint64_t fileNum, int64_t bytes) {
+    listenedBytes[fileNum] += bytes;
+  });
+
+  StringIdLease file1(fileIds(), std::string_view("fileResidency1"));
+  StringIdLease file2(fileIds(), std::string_view("fileResidency2"));
+  std::vector<CachePin> pins;
+  for (auto i = 0; i < 3; ++i) {
+    pins.push_back(cache_->findOrCreate({file1.id(), i * 1000UL}, 1000));
+  }
+  pins.push_back(cache_->findOrCreate({file2.id(), 0}, 100));
+  for (auto& pin : pins) {
+    pin.entry()->setExclusiveToShared();
+  }
+
+  auto residencies = cache_->fileResidency(
+      {"fileResidency1", "fileResidency2", "fileResidencyUnknown"});
+  ASSERT_EQ(residencies.size(), 3);
+  ASSERT_EQ(residencies[0].ramBytes, 3000);
+  ASSERT_EQ(residencies[1].ramBytes, 100);
+  ASSERT_EQ(residencies[2].ramBytes, 0);
+  for (const auto& residency : residencies) {
+    ASSERT_EQ(residency.ssdBytes, 0);
+  }
+  ASSERT_EQ(listenedBytes[file1.id()], 3000);
+  ASSERT_EQ(listenedBytes[file2.id()], 100);
+
+  pins.clear();
+  cache_->clear();
+  residencies = cache_->fileResidency({"fileResidency1", "fileResidency2"});
+  ASSERT_EQ(residencies[0].ramBytes, 0);
+  ASSERT_EQ(residencies[1].ramBytes, 0);
+  ASSERT_EQ(listenedBytes[file1.id()], 0);
+  ASSERT_EQ(listenedBytes[file2.id()], 0);
+
+  VELOX_ASSERT_THROW(
+      cache_->fileResidency(std::vector<std::string>(
+          AsyncDataCache::kMaxResidencyFiles + 1, "fileResidency1")),
+      "Too many files in a cache residency request");
+  cache_->setResidencyListener(nullptr);
+}
+
 TEST_P(AsyncDataCacheTest, shrinkCache) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
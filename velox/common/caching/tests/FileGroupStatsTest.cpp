@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(FileGroupStatsTest, ghostCache) {
+  GhostCache cache(300);
+  EXPECT_FALSE(cache.access(1, 100));
+  EXPECT_FALSE(cache.access(2, 100));
+  EXPECT_FALSE(cache.access(3, 100));
+  EXPECT_TRUE(cache.access(1, 100));
+  // Evicts 2, the least recently used.
+  EXPECT_FALSE(cache.access(4, 100));
+  EXPECT_FALSE(cache.access(2, 100));
+  EXPECT_TRUE(cache.access(1, 100));
+  EXPECT_EQ(cache.numEntries(), 3);
+  EXPECT_EQ(cache.size(), 300);
+
+  // Entries larger than the capacity are never cached.
+  EXPECT_FALSE(cache.access(5, 1'000));
+  EXPECT_FALSE(cache.access(5, 1'000));
+  EXPECT_EQ(cache.numEntries(), 3);
+
+  EXPECT_EQ(cache.numAccesses(), 9);
+  EXPECT_EQ(cache.numHits(), 2);
+  EXPECT_EQ(cache.accessBytes(), 2'700);
+  EXPECT_EQ(cache.hitBytes(), 200);
+
+  cache.clear();
+  EXPECT_EQ(cache.numEntries(), 0);
+  EXPECT_EQ(cache.numAccesses(), 0);
+  EXPECT_FALSE(cache.access(1, 100));
+}
+
+TEST(FileGroupStatsTest, groupColumnStats) {
+  FileGroupStats::Options options;
+  options.maxEntries = 2;
+  FileGroupStats stats(nullptr, options);
+  const TrackingId column1(1);
+  const TrackingId column2(2);
+
+  stats.recordReference(0, 10, column1, 1'000);
+  stats.recordRead(0, 10, column1, 500);
+  stats.recordCacheAccess(
+      0, 0, 10, column1, 600, CacheSource::kRam, /*prefetch=*/true);
+  stats.recordCacheAccess(
+      0, 600, 10, column1, 400, CacheSource::kStorage, /*prefetch=*/true);
+  stats.recordCacheAccess(
+      0, 1'000, 20, column2, 2'000, CacheSource::kSsd, /*prefetch=*/false);
+  // Beyond 'maxEntries'.
+  stats.recordCacheAccess(
+      0, 3'000, 30, column1, 100, CacheSource::kStorage, /*prefetch=*/false);
+
+  const auto groupColumns = stats.groupColumnStats();
+  ASSERT_EQ(groupColumns.size(), 2);
+  // The most looked up bytes first.
+  EXPECT_EQ(groupColumns[0].groupId, 20);
+  EXPECT_EQ(groupColumns[0].trackingId, column2);
+  EXPECT_EQ(groupColumns[0].counts.ssdHitBytes, 2'000);
+  EXPECT_DOUBLE_EQ(groupColumns[0].counts.hitRate(), 1.0);
+
+  const auto& counts = groupColumns[1].counts;
+  EXPECT_EQ(groupColumns[1].groupId, 10);
+  EXPECT_EQ(counts.referencedBytes, 1'000);
+  EXPECT_EQ(counts.readBytes, 500);
+  EXPECT_EQ(counts.ramHits, 1);
+  EXPECT_EQ(counts.misses, 1);
+  EXPECT_EQ(counts.bytesSaved(), 600);
+  EXPECT_DOUBLE_EQ(counts.hitRate(), 0.6);
+  // RAM hits are not loaded.
+  EXPECT_EQ(counts.prefetchBytes, 400);
+
+  const auto total = stats.totalCacheAccessCounts();
+  EXPECT_EQ(total.lookupBytes(), 3'100);
+  EXPECT_EQ(total.missBytes, 500);
+  EXPECT_EQ(total.bytesSaved(), 2'600);
+
+  const auto dump = stats.cacheAccessToString(1);
+  EXPECT_NE(dump.find("Cache accesses: hit rate"), std::string::npos);
+  EXPECT_NE(dump.find("... 1 more"), std::string::npos);
+  EXPECT_NE(dump.find("Untracked groups and columns"), std::string::npos);
+
+  stats.clearCacheAccessStats();
+  EXPECT_TRUE(stats.groupColumnStats().empty());
+  EXPECT_EQ(stats.totalCacheAccessCounts().lookupBytes(), 0);
+}
+
+TEST(FileGroupStatsTest, simulatedCaches) {
+  FileGroupStats::Options options;
+  options.simulatedCapacities = {1'000, 4'000};
+  FileGroupStats stats(nullptr, options);
+  const TrackingId column(1);
+
+  // Scans a working set of 3'000 bytes twice.
+  for (auto pass = 0; pass < 2; ++pass) {
+    for (auto offset = 0; offset < 3'000; offset += 500) {
+      stats.recordCacheAccess(
+          1, offset, 10, column, 500, CacheSource::kStorage, false);
+    }
+  }
+
+  const auto simulated = stats.simulatedCacheStats();
+  ASSERT_EQ(simulated.size(), 2);
+  // A cache smaller than a sequentially scanned working set never hits.
+  EXPECT_EQ(simulated[0].capacity, 1'000);
+  EXPECT_EQ(simulated[0].numAccesses, 12);
+  EXPECT_EQ(simulated[0].numHits, 0);
+  EXPECT_DOUBLE_EQ(simulated[0].hitRate(), 0);
+  EXPECT_EQ(simulated[1].capacity, 4'000);
+  EXPECT_EQ(simulated[1].numHits, 6);
+  EXPECT_DOUBLE_EQ(simulated[1].hitRate(), 0.5);
+  EXPECT_NE(stats.cacheAccessToString().find("Simulated"), std::string::npos);
+}
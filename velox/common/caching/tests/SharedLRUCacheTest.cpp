@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SharedLRUCache.h"
+
+#include "gtest/gtest.h"
+#include "velox/common/memory/MemoryArbitrator.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+class SharedLRUCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  static std::shared_ptr<const int64_t> makeValue(int64_t value) {
+    return std::make_shared<const int64_t>(value);
+  }
+};
+
+TEST_F(SharedLRUCacheTest, getAndPut) {
+  SharedLRUCache cache(100);
+  EXPECT_EQ(cache.pool(), nullptr);
+  EXPECT_EQ(cache.get<int64_t>("a"), nullptr);
+
+  EXPECT_TRUE(cache.put("a", makeValue(1), 10));
+  EXPECT_TRUE(cache.put("b", makeValue(2), 20));
+  EXPECT_EQ(*cache.get<int64_t>("a"), 1);
+  EXPECT_EQ(*cache.get<int64_t>("b"), 2);
+
+  // The first value cached under a key stays.
+  EXPECT_FALSE(cache.put("a", makeValue(3), 30));
+  EXPECT_EQ(*cache.get<int64_t>("a"), 1);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 2);
+  EXPECT_EQ(stats.sizeBytes, 30);
+  EXPECT_EQ(stats.numLookups, 4);
+  EXPECT_EQ(stats.numHits, 3);
+  EXPECT_EQ(stats.numEvictions, 0);
+}
+
+TEST_F(SharedLRUCacheTest, lruEviction) {
+  SharedLRUCache cache(100);
+  cache.put("a", makeValue(1), 40);
+  cache.put("b", makeValue(2), 40);
+  auto held = cache.get<int64_t>("b");
+  // Makes 'b' the least recently used entry.
+  ASSERT_NE(cache.get<int64_t>("a"), nullptr);
+
+  EXPECT_FALSE(cache.put("c", makeValue(3), 101));
+  EXPECT_TRUE(cache.put("c", makeValue(3), 40));
+  EXPECT_EQ(cache.get<int64_t>("b"), nullptr);
+  EXPECT_EQ(*cache.get<int64_t>("a"), 1);
+  EXPECT_EQ(*cache.get<int64_t>("c"), 3);
+  // An evicted value stays valid for its holders.
+  EXPECT_EQ(*held, 2);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 2);
+  EXPECT_EQ(stats.sizeBytes, 80);
+  EXPECT_EQ(stats.numEvictions, 1);
+}
+
+TEST_F(SharedLRUCacheTest, shrink) {
+  SharedLRUCache cache(100);
+  cache.put("a", makeValue(1), 10);
+  cache.put("b", makeValue(2), 20);
+  cache.put("c", makeValue(3), 30);
+  EXPECT_EQ(cache.shrink(15), 30);
+  EXPECT_EQ(cache.get<int64_t>("a"), nullptr);
+  EXPECT_EQ(cache.get<int64_t>("b"), nullptr);
+  EXPECT_EQ(*cache.get<int64_t>("c"), 3);
+
+  cache.clear();
+  EXPECT_EQ(cache.stats().numEntries, 0);
+  EXPECT_EQ(cache.stats().sizeBytes, 0);
+  EXPECT_EQ(cache.stats().numEvictions, 3);
+  EXPECT_EQ(cache.shrink(0), 0);
+}
+
+TEST_F(SharedLRUCacheTest, reclaim) {
+  SharedLRUCache cache(1 << 20, "sharedLRUCacheTest");
+  ASSERT_NE(cache.pool(), nullptr);
+  auto* rootPool = cache.pool()->root();
+  EXPECT_EQ(rootPool->name(), "sharedLRUCacheTest");
+
+  auto* pool = cache.pool();
+  auto makeBuffer = [&]() {
+    return std::shared_ptr<const void>(
+        pool->allocate(1'000),
+        [pool](const void* buffer) {
+          pool->free(const_cast<void*>(buffer), 1'000);
+        });
+  };
+  cache.put("a", makeBuffer(), 1'000);
+  cache.put("b", makeBuffer(), 1'000);
+  auto held = cache.get<void>("b");
+  EXPECT_EQ(rootPool->reclaimableBytes(), 2'000);
+
+  // Reclaiming evicts all the entries and frees the values nobody holds.
+  const auto usedBytes = pool->usedBytes();
+  {
+    memory::ScopedMemoryArbitrationContext arbitrationCtx(rootPool);
+    memory::MemoryReclaimer::Stats stats;
+    rootPool->reclaim(0, 0, stats);
+  }
+  EXPECT_EQ(cache.stats().numEntries, 0);
+  EXPECT_EQ(rootPool->reclaimableBytes(), 0);
+  EXPECT_LT(pool->usedBytes(), usedBytes);
+  EXPECT_GT(pool->usedBytes(), 0);
+
+  held.reset();
+  EXPECT_EQ(pool->usedBytes(), 0);
+}
+
+} // namespace
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionPolicy.h"
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace facebook::velox::cache;
+
+TEST(SsdAdmissionPolicyTest, frequency) {
+  TinyLfuSsdAdmissionPolicy::Config config;
+  config.numCounters = 1 << 10;
+  config.minAccesses = 3;
+  TinyLfuSsdAdmissionPolicy policy(config);
+
+  const TrackingId column(10);
+  EXPECT_EQ(policy.frequency(1, column), 0);
+  EXPECT_FALSE(policy.shouldAdmit(1, column));
+  for (auto i = 1; i <= 3; ++i) {
+    policy.recordAccess(1, column);
+    EXPECT_EQ(policy.frequency(1, column), i);
+  }
+  EXPECT_TRUE(policy.shouldAdmit(1, column));
+  // Other groups and columns are not affected.
+  EXPECT_FALSE(policy.shouldAdmit(2, column));
+  EXPECT_FALSE(policy.shouldAdmit(1, TrackingId(11)));
+
+  // The counters saturate.
+  for (auto i = 0; i < 100; ++i) {
+    policy.recordAccess(1, column);
+  }
+  EXPECT_EQ(policy.frequency(1, column), 16);
+
+  // Aging halves the counts and clears the door keeper.
+  policy.age();
+  EXPECT_EQ(policy.frequency(1, column), 7);
+  policy.age();
+  policy.age();
+  EXPECT_EQ(policy.frequency(1, column), 1);
+  EXPECT_FALSE(policy.shouldAdmit(1, column));
+}
+
+TEST(SsdAdmissionPolicyTest, sampleSize) {
+  TinyLfuSsdAdmissionPolicy::Config config;
+  config.numCounters = 1 << 10;
+  config.sampleSize = 100;
+  TinyLfuSsdAdmissionPolicy policy(config);
+
+  const TrackingId column(1);
+  for (auto i = 0; i < 10; ++i) {
+    policy.recordAccess(1, column);
+  }
+  EXPECT_EQ(policy.frequency(1, column), 10);
+  // Groups seen once take only door keeper bits. The 'sampleSize'th access
+  // halves the counts.
+  for (auto group = 100; group < 190; ++group) {
+    policy.recordAccess(group, column);
+  }
+  EXPECT_EQ(policy.frequency(1, column), 4);
+  EXPECT_TRUE(policy.shouldAdmit(1, column));
+  EXPECT_FALSE(policy.shouldAdmit(150, column));
+}
+
+TEST(SsdAdmissionPolicyTest, writeBudget) {
+  TinyLfuSsdAdmissionPolicy::Config config;
+  config.maxWriteBytes = 1'000;
+  config.writeWindowMs = 100;
+  TinyLfuSsdAdmissionPolicy policy(config);
+
+  // The first write of a window is allowed in full.
+  EXPECT_EQ(policy.acquireWriteBytes(1'500), 1'500);
+  EXPECT_EQ(policy.acquireWriteBytes(100), 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(150)); // NOLINT
+  EXPECT_EQ(policy.acquireWriteBytes(600), 600);
+  EXPECT_EQ(policy.acquireWriteBytes(600), 400);
+  EXPECT_EQ(policy.acquireWriteBytes(600), 0);
+
+  config.maxWriteBytes = 0;
+  TinyLfuSsdAdmissionPolicy unlimited(config);
+  EXPECT_EQ(unlimited.acquireWriteBytes(1UL << 40), 1UL << 40);
+}
+
+TEST(SsdAdmissionPolicyTest, fileGroupStats) {
+  FileGroupStats noPolicy;
+  EXPECT_TRUE(noPolicy.shouldSaveToSsd(1, TrackingId(1)));
+  EXPECT_EQ(noPolicy.toString(0), "<dummy FileGroupStats>");
+
+  TinyLfuSsdAdmissionPolicy::Config config;
+  config.numCounters = 1 << 10;
+  FileGroupStats stats(std::make_shared<TinyLfuSsdAdmissionPolicy>(config));
+  const TrackingId column(1);
+  EXPECT_FALSE(stats.shouldSaveToSsd(1, column));
+
+  // Each scan counts once per group and column however many reads it does.
+  for (auto scan = 0; scan < 2; ++scan) {
+    ScanTracker tracker("scan", nullptr, 8 << 20, &stats);
+    for (auto i = 0; i < 10; ++i) {
+      tracker.recordRead(column, 1'000, i, 1);
+    }
+    EXPECT_EQ(stats.shouldSaveToSsd(1, column), scan == 1);
+  }
+  EXPECT_EQ(
+      stats.toString(0),
+      "TinyLFU SSD admission: 2 accesses, 0 agings, 1 admitted, 2 rejected, "
+      "0B throttled");
+}
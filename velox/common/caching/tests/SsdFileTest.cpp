@@ -97,7 +97,8 @@ class SsdFileTest : public testing::Test {
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
       bool disableFileCow = false,
-      uint64_t maxEntries = 0) {
+      uint64_t maxEntries = 0,
+      bool journalEnabled = false) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -107,7 +108,8 @@ class SsdFileTest : public testing::Test {
         checksumEnabled,
         checksumReadVerificationEnabled,
         maxEntries,
-        ssdExecutor());
+        ssdExecutor(),
+        journalEnabled);
     ssdFile_ = std::make_unique<SsdFile>(config);
     if (ssdFile_ != nullptr) {
       ssdFileHelper_ =
@@ -501,6 +503,91 @@ TEST_F(SsdFileTest, checkpoint) {
   EXPECT_EQ(numEntriesFound, 0);
 }
 
+TEST_F(SsdFileTest, journal) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  // Checkpoints are only made explicitly.
+  const uint64_t checkpointIntervalBytes = 1'000 * SsdFile::kRegionSize;
+  FLAGS_velox_ssd_verify_write = true;
+  initializeCache(kSsdSize, checkpointIntervalBytes, true, true);
+  const auto initializeJournaledFile = [&]() {
+    initializeSsdFile(
+        kSsdSize, checkpointIntervalBytes, true, true, false, 0, true);
+  };
+  initializeJournaledFile();
+
+  const auto writeRegions = [&](int32_t begin,
+                                int32_t end,
+                                std::vector<TestEntry>& entries) {
+    for (auto region = begin; region < end; ++region) {
+      auto pins = makePins(
+          fileName_.id(),
+          region * SsdFile::kRegionSize,
+          4096,
+          2048 * 1025,
+          62 * kMB);
+      ssdFile_->write(pins);
+      for (auto& pin : pins) {
+        EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+        entries.emplace_back(
+            pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+      }
+    }
+  };
+
+  std::vector<TestEntry> checkpointedEntries;
+  writeRegions(0, 4, checkpointedEntries);
+  ssdFile_->checkpoint(true);
+  std::vector<TestEntry> journaledEntries;
+  writeRegions(4, 8, journaledEntries);
+
+  // The entries written after the checkpoint are recovered from the journal.
+  initializeJournaledFile();
+  EXPECT_EQ(checkEntries(checkpointedEntries), checkpointedEntries.size());
+  EXPECT_EQ(checkEntries(journaledEntries), journaledEntries.size());
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(
+      stats.entriesRecovered,
+      checkpointedEntries.size() + journaledEntries.size());
+
+  // A torn record at the end of the journal is dropped.
+  {
+    const auto fd = ::open(ssdFile_->journalFilePath().c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ::lseek(fd, 0, SEEK_END);
+    const char garbage[] = "torn journal record";
+    ASSERT_EQ(::write(fd, garbage, sizeof(garbage)), sizeof(garbage));
+    ::close(fd);
+  }
+  initializeJournaledFile();
+  EXPECT_EQ(checkEntries(checkpointedEntries), checkpointedEntries.size());
+  EXPECT_EQ(checkEntries(journaledEntries), journaledEntries.size());
+
+  // Evictions are journaled too.
+  folly::F14FastSet<uint64_t> filesToRemove{fileName_.id()};
+  folly::F14FastSet<uint64_t> filesRetained;
+  ssdFile_->removeFileEntries(filesToRemove, filesRetained);
+  EXPECT_TRUE(filesRetained.empty());
+  std::vector<TestEntry> newEntries;
+  writeRegions(8, 10, newEntries);
+  initializeJournaledFile();
+  EXPECT_EQ(checkEntries(checkpointedEntries), 0);
+  EXPECT_EQ(checkEntries(journaledEntries), 0);
+  EXPECT_EQ(checkEntries(newEntries), newEntries.size());
+
+  // A checkpoint resets the journal.
+  ssdFile_->checkpoint(true);
+  initializeJournaledFile();
+  EXPECT_EQ(checkEntries(newEntries), newEntries.size());
+
+  // Without journal only the checkpointed entries are recovered.
+  std::vector<TestEntry> unjournaledEntries;
+  writeRegions(10, 12, unjournaledEntries);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, true);
+  EXPECT_EQ(checkEntries(newEntries), newEntries.size());
+  EXPECT_EQ(checkEntries(unjournaledEntries), 0);
+}
+
 TEST_F(SsdFileTest, fileCorruption) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/ZstdCompression.h"
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::common {
+namespace {
+
+constexpr int32_t kZstdDefaultCompressionLevel = 1;
+
+Status zstdError(const char* prefixMessage, size_t errorCode) {
+  return Status::IOError(prefixMessage, ZSTD_getErrorName(errorCode));
+}
+
+class ZstdCodec : public Codec {
+ public:
+  ZstdCodec(
+      int32_t compressionLevel,
+      std::shared_ptr<const std::string> dictionary)
+      : compressionLevel_(
+            compressionLevel == kDefaultCompressionLevel
+                ? kZstdDefaultCompressionLevel
+                : compressionLevel),
+        dictionary_(std::move(dictionary)) {}
+
+  ~ZstdCodec() override {
+    ZSTD_freeCDict(cdict_);
+    ZSTD_freeDDict(ddict_);
+    ZSTD_freeCCtx(cctx_);
+    ZSTD_freeDCtx(dctx_);
+  }
+
+  uint64_t maxCompressedLength(uint64_t inputLength) override {
+    return ZSTD_compressBound(inputLength);
+  }
+
+  Expected<uint64_t> compress(
+      const uint8_t* input,
+      uint64_t inputLength,
+      uint8_t* output,
+      uint64_t outputLength) override {
+    VELOX_CHECK_NOT_NULL(input);
+    VELOX_CHECK_NOT_NULL(output);
+    const auto compressedSize = cdict_ == nullptr
+        ? ZSTD_compressCCtx(
+              cctx_,
+              output,
+              outputLength,
+              input,
+              inputLength,
+              compressionLevel_)
+        : ZSTD_compress_usingCDict(
+              cctx_, output, outputLength, input, inputLength, cdict_);
+    VELOX_RETURN_UNEXPECTED_IF(
+        ZSTD_isError(compressedSize),
+        zstdError("ZSTD compression failed: {}", compressedSize));
+    return static_cast<uint64_t>(compressedSize);
+  }
+
+  Expected<uint64_t> decompress(
+      const uint8_t* input,
+      uint64_t inputLength,
+      uint8_t* output,
+      uint64_t outputLength) override {
+    VELOX_CHECK_NOT_NULL(input);
+    VELOX_CHECK_NOT_NULL(output);
+    const auto decompressedSize = ddict_ == nullptr
+        ? ZSTD_decompressDCtx(dctx_, output, outputLength, input, inputLength)
+        : ZSTD_decompress_usingDDict(
+              dctx_, output, outputLength, input, inputLength, ddict_);
+    VELOX_RETURN_UNEXPECTED_IF(
+        ZSTD_isError(decompressedSize),
+        zstdError("ZSTD decompression failed: {}", decompressedSize));
+    return static_cast<uint64_t>(decompressedSize);
+  }
+
+  Expected<uint64_t> getUncompressedLength(
+      const uint8_t* input,
+      uint64_t inputLength) const override {
+    const auto size = ZSTD_getFrameContentSize(input, inputLength);
+    VELOX_RETURN_UNEXPECTED_IF(
+        size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN,
+        Status::IOError("Cannot get the uncompressed length of ZSTD data."));
+    return static_cast<uint64_t>(size);
+  }
+
+  int32_t minCompressionLevel() const override {
+    return ZSTD_minCLevel();
+  }
+
+  int32_t maxCompressionLevel() const override {
+    return ZSTD_maxCLevel();
+  }
+
+  int32_t defaultCompressionLevel() const override {
+    return kZstdDefaultCompressionLevel;
+  }
+
+  int32_t compressionLevel() const override {
+    return compressionLevel_;
+  }
+
+  CompressionKind compressionKind() const override {
+    return CompressionKind_ZSTD;
+  }
+
+  std::string_view name() const override {
+    return "zstd";
+  }
+
+ private:
+  Status init() override {
+    cctx_ = ZSTD_createCCtx();
+    dctx_ = ZSTD_createDCtx();
+    VELOX_RETURN_IF(
+        cctx_ == nullptr || dctx_ == nullptr,
+        Status::IOError("ZSTD context creation failed."));
+    if (dictionary_ != nullptr && !dictionary_->empty()) {
+      // Digesting the dictionary is costly, so it is done once per codec and
+      // not per call.
+      cdict_ = ZSTD_createCDict(
+          dictionary_->data(), dictionary_->size(), compressionLevel_);
+      ddict_ = ZSTD_createDDict(dictionary_->data(), dictionary_->size());
+      VELOX_RETURN_IF(
+          cdict_ == nullptr || ddict_ == nullptr,
+          Status::IOError("ZSTD dictionary creation failed."));
+    }
+    return Status::OK();
+  }
+
+  const int32_t compressionLevel_;
+  const std::shared_ptr<const std::string> dictionary_;
+  ZSTD_CCtx* cctx_{nullptr};
+  ZSTD_DCtx* dctx_{nullptr};
+  ZSTD_CDict* cdict_{nullptr};
+  ZSTD_DDict* ddict_{nullptr};
+};
+
+} // namespace
+
+std::unique_ptr<Codec> makeZstdCodec(
+    int32_t compressionLevel,
+    std::shared_ptr<const std::string> dictionary) {
+  return std::make_unique<ZstdCodec>(compressionLevel, std::move(dictionary));
+}
+
+Expected<std::string> trainZstdDictionary(
+    const std::vector<std::string_view>& samples,
+    size_t maxDictionaryBytes) {
+  std::string buffer;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    buffer.append(sample);
+    sampleSizes.push_back(sample.size());
+  }
+  std::string dictionary(maxDictionaryBytes, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      dictionary.data(),
+      dictionary.size(),
+      buffer.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  VELOX_RETURN_UNEXPECTED_IF(
+      ZDICT_isError(size),
+      Status::Invalid(
+          "ZSTD dictionary training failed: {}", ZDICT_getErrorName(size)));
+  dictionary.resize(size);
+  return dictionary;
+}
+
+uint32_t zstdDictionaryId(std::string_view dictionary) {
+  return ZDICT_getDictID(dictionary.data(), dictionary.size());
+}
+
+} // namespace facebook::velox::common
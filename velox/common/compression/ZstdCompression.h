@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "velox/common/compression/Compression.h"
+
+namespace facebook::velox::common {
+
+struct ZstdCodecOptions : CodecOptions {
+  explicit ZstdCodecOptions(
+      std::shared_ptr<const std::string> dictionary = nullptr,
+      int32_t compressionLevel = kDefaultCompressionLevel)
+      : CodecOptions(compressionLevel), dictionary(std::move(dictionary)) {}
+
+  /// Dictionary from trainZstdDictionary(). The data must be decompressed
+  /// with the same dictionary it was compressed with. No dictionary if
+  /// nullptr or empty.
+  std::shared_ptr<const std::string> dictionary;
+};
+
+/// Zstd frame format codec. The codec keeps its compression and
+/// decompression contexts and is not thread safe.
+std::unique_ptr<Codec> makeZstdCodec(
+    int32_t compressionLevel = kDefaultCompressionLevel,
+    std::shared_ptr<const std::string> dictionary = nullptr);
+
+/// Trains a Zstd dictionary of at most 'maxDictionaryBytes' on 'samples',
+/// e.g. the first pages of a shuffle or spill stream. Many small samples of
+/// similar data, like serialized pages of one schema, give the best
+/// dictionaries. Returns an error if the samples are too few or too small
+/// to train on.
+Expected<std::string> trainZstdDictionary(
+    const std::vector<std::string_view>& samples,
+    size_t maxDictionaryBytes);
+
+/// Returns the id that identifies 'dictionary' in the frames compressed with
+/// it, 0 if it is not a trained Zstd dictionary.
+uint32_t zstdDictionaryId(std::string_view dictionary);
+
+} // namespace facebook::velox::common
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/compression/ZstdCompression.h"
+
+namespace facebook::velox::common {
+namespace {
+
+void throwsNotOk(const Status& status) {
+  VELOX_USER_FAIL("{}", status.message());
+}
+
+// Small records of a fixed structure, like the rows of a serialized page.
+std::vector<std::string> makeRecords(int32_t count) {
+  std::default_random_engine engine(42);
+  std::uniform_int_distribution<int32_t> dist(0, 1'000'000);
+  static const std::vector<std::string> kCountries = {"US", "BR", "IN", "DE"};
+  std::vector<std::string> records;
+  for (auto i = 0; i < count; ++i) {
+    const auto id = dist(engine);
+    records.push_back(
+        fmt::format(
+            "{{\"user_id\": {}, \"name\": \"user_{}\", \"country\": \"{}\", "
+            "\"status\": \"active\", \"plan\": \"premium\"}}",
+            id,
+            id,
+            kCountries[id % kCountries.size()]));
+  }
+  return records;
+}
+
+std::unique_ptr<Codec> makeCodec(
+    std::shared_ptr<const std::string> dictionary = nullptr) {
+  return Codec::create(CompressionKind_ZSTD, ZstdCodecOptions{dictionary})
+      .thenOrThrow([](auto codec) { return codec; }, throwsNotOk);
+}
+
+std::string compress(Codec& codec, std::string_view data) {
+  std::string compressed(codec.maxCompressedLength(data.size()), '\0');
+  const auto size =
+      codec
+          .compress(
+              reinterpret_cast<const uint8_t*>(data.data()),
+              data.size(),
+              reinterpret_cast<uint8_t*>(compressed.data()),
+              compressed.size())
+          .thenOrThrow(folly::identity, throwsNotOk);
+  compressed.resize(size);
+  return compressed;
+}
+
+Expected<std::string>
+decompress(Codec& codec, std::string_view compressed, size_t size) {
+  std::string data(size, '\0');
+  return codec
+      .decompress(
+          reinterpret_cast<const uint8_t*>(compressed.data()),
+          compressed.size(),
+          reinterpret_cast<uint8_t*>(data.data()),
+          data.size())
+      .then([&](auto decompressedSize) {
+        data.resize(decompressedSize);
+        return data;
+      });
+}
+
+TEST(ZstdCompressionTest, roundtrip) {
+  ASSERT_TRUE(Codec::isAvailable(CompressionKind_ZSTD));
+  ASSERT_TRUE(Codec::supportsGetUncompressedLength(CompressionKind_ZSTD));
+  auto codec = makeCodec();
+  ASSERT_EQ(codec->name(), "zstd");
+  ASSERT_EQ(codec->compressionLevel(), codec->defaultCompressionLevel());
+
+  for (const auto& data :
+       {std::string(), std::string(10'000, 'a'), makeRecords(100)[0]}) {
+    const auto compressed = compress(*codec, data);
+    ASSERT_EQ(
+        codec
+            ->getUncompressedLength(
+                reinterpret_cast<const uint8_t*>(compressed.data()),
+                compressed.size())
+            .value(),
+        data.size());
+    ASSERT_EQ(decompress(*codec, compressed, data.size()).value(), data);
+  }
+}
+
+TEST(ZstdCompressionTest, dictionary) {
+  const auto records = makeRecords(2'000);
+  std::vector<std::string_view> samples(records.begin(), records.end());
+  auto dictionary = std::make_shared<const std::string>(
+      trainZstdDictionary(samples, 4 << 10)
+          .thenOrThrow(folly::identity, throwsNotOk));
+  ASSERT_LE(dictionary->size(), 4 << 10);
+  ASSERT_NE(zstdDictionaryId(*dictionary), 0);
+
+  auto plainCodec = makeCodec();
+  auto dictionaryCodec = makeCodec(dictionary);
+  // New records, like the pages after the ones the dictionary is trained on.
+  const auto page = makeRecords(2'100).back();
+  const auto plain = compress(*plainCodec, page);
+  const auto withDictionary = compress(*dictionaryCodec, page);
+  ASSERT_LT(withDictionary.size(), plain.size());
+
+  // A consumer decompresses with the same dictionary.
+  auto consumerCodec = makeCodec(dictionary);
+  ASSERT_EQ(
+      decompress(*consumerCodec, withDictionary, page.size()).value(), page);
+  VELOX_ASSERT_ERROR_STATUS(
+      decompress(*plainCodec, withDictionary, page.size()).error(),
+      StatusCode::kIOError,
+      "ZSTD decompression failed: Dictionary mismatch");
+}
+
+TEST(ZstdCompressionTest, trainingFailure) {
+  VELOX_ASSERT_ERROR_STATUS(
+      trainZstdDictionary({"a", "b"}, 4 << 10).error(),
+      StatusCode::kInvalid,
+      "ZSTD dictionary training failed");
+  ASSERT_EQ(zstdDictionaryId("not a dictionary"), 0);
+}
+
+} // namespace
+} // namespace facebook::velox::common
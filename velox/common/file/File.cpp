@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -210,6 +211,17 @@ uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers,
     const FileIoContext& context) const {
+  if (auto* ring = IoUring::instance()) {
+    if (const auto bytesRead = preadvIoUring(*ring, offset, buffers).get()) {
+      return *bytesRead;
+    }
+  }
+  return preadvInternal(offset, buffers);
+}
+
+uint64_t LocalReadFile::preadvInternal(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
   static thread_local std::vector<char> droppedBytes(16 * 1024);
@@ -263,10 +275,53 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+folly::SemiFuture<std::optional<uint64_t>> LocalReadFile::preadvIoUring(
+    IoUring& ring,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  std::vector<IoUring::Request> requests;
+  bool startRequest = true;
+  uint64_t totalBytes = 0;
+  for (const auto& range : buffers) {
+    if (!range.data()) {
+      startRequest = true;
+    } else {
+      if (startRequest || requests.back().iovecs.size() >= IOV_MAX) {
+        requests.push_back({fd_, offset + totalBytes, {}});
+        startRequest = false;
+      }
+      requests.back().iovecs.push_back({range.data(), range.size()});
+    }
+    totalBytes += range.size();
+  }
+  return ring.submit(std::move(requests), /*write=*/false)
+      .deferValue(
+          [totalBytes](std::vector<IoUring::Request> completed)
+              -> std::optional<uint64_t> {
+            for (const auto& request : completed) {
+              if (request.result != static_cast<int64_t>(request.size())) {
+                return std::nullopt;
+              }
+            }
+            return totalBytes;
+          });
+}
+
 folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers,
     const FileIoContext& context) const {
+  if (auto* ring = IoUring::instance()) {
+    return preadvIoUring(*ring, offset, buffers)
+        .deferValue(
+            [this, offset, buffers](std::optional<uint64_t> bytesRead) {
+              if (bytesRead.has_value()) {
+                return *bytesRead;
+              }
+              // Reads again synchronously to report the error.
+              return preadvInternal(offset, buffers);
+            });
+  }
   if (!executor_) {
     return ReadFile::preadvAsync(offset, buffers, context);
   }
@@ -282,6 +337,10 @@ folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
   return std::move(future);
 }
 
+bool LocalReadFile::hasPreadvAsync() const {
+  return executor_ != nullptr || IoUring::instance() != nullptr;
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
@@ -407,6 +466,12 @@ void LocalWriteFile::write(
     int64_t length) {
   checkNotClosed(closed_);
   VELOX_CHECK_GE(offset, 0, "Offset cannot be negative.");
+  if (iovecs.size() > IOV_MAX) {
+    if (auto* ring = IoUring::instance()) {
+      writeIoUring(*ring, iovecs, offset, length);
+      return;
+    }
+  }
   const auto bytesWritten = ::pwritev(
       fd_, iovecs.data(), static_cast<ssize_t>(iovecs.size()), offset);
   VELOX_CHECK_EQ(
@@ -418,6 +483,43 @@ void LocalWriteFile::write(
   size_ = std::max<uint64_t>(size_, offset + bytesWritten);
 }
 
+void LocalWriteFile::writeIoUring(
+    IoUring& ring,
+    const std::vector<iovec>& iovecs,
+    int64_t offset,
+    int64_t length) {
+  std::vector<IoUring::Request> requests;
+  uint64_t requestOffset = offset;
+  for (size_t i = 0; i < iovecs.size(); i += IOV_MAX) {
+    const auto end = std::min<size_t>(i + IOV_MAX, iovecs.size());
+    requests.push_back(
+        {fd_,
+         requestOffset,
+         std::vector<iovec>(iovecs.begin() + i, iovecs.begin() + end)});
+    requestOffset += requests.back().size();
+  }
+  // The write is synchronous, so waits for the completion of the requests.
+  requests = ring.submit(std::move(requests), /*write=*/true).get();
+  int64_t bytesWritten = 0;
+  for (const auto& request : requests) {
+    if (request.result < 0) {
+      // Callers such as SsdFile inspect errno to detect a full device.
+      errno = -request.result;
+      VELOX_FAIL(
+          "Failure in LocalWriteFile::write: {}",
+          folly::errnoStr(-request.result));
+    }
+    bytesWritten += request.result;
+  }
+  VELOX_CHECK_EQ(
+      bytesWritten,
+      length,
+      "Failure in LocalWriteFile::write, {} vs {}",
+      bytesWritten,
+      length);
+  size_ = std::max<uint64_t>(size_, offset + bytesWritten);
+}
+
 void LocalWriteFile::truncate(int64_t newSize) {
   checkNotClosed(closed_);
   VELOX_CHECK_GE(newSize, 0, "New size cannot be negative.");
@@ -31,6 +31,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -301,6 +302,8 @@ class InMemoryWriteFile final : public WriteFile {
   std::string* file_;
 };
 
+class IoUring;
+
 /// Current implementation for the local version is quite simple (e.g. no
 /// internal arenaing), as local disk writes are expected to be cheap. Local
 /// files match against any filepath starting with '/'.
@@ -335,9 +338,7 @@ class LocalReadFile final : public ReadFile {
       const std::vector<folly::Range<char*>>& buffers,
       const FileIoContext& context = {}) const override;
 
-  bool hasPreadvAsync() const override {
-    return executor_ != nullptr;
-  }
+  bool hasPreadvAsync() const override;
 
   uint64_t memoryUsage() const final;
 
@@ -359,6 +360,20 @@ class LocalReadFile final : public ReadFile {
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
+  // Reads 'buffers' with synchronous preadv calls.
+  uint64_t preadvInternal(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const;
+
+  // Reads each run of adjacent non-null 'buffers' with a separate request on
+  // 'ring' without blocking. Skipped ranges are not read. The future yields
+  // std::nullopt if a request failed or came back short, in which case the
+  // caller reads synchronously.
+  folly::SemiFuture<std::optional<uint64_t>> preadvIoUring(
+      IoUring& ring,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const;
+
   folly::Executor* const executor_;
   std::string path_;
   int32_t fd_;
@@ -415,6 +430,14 @@ class LocalWriteFile final : public WriteFile {
   }
 
  private:
+  // Writes 'iovecs' in chunks of at most IOV_MAX entries that are issued
+  // concurrently on 'ring'.
+  void writeIoUring(
+      IoUring& ring,
+      const std::vector<iovec>& iovecs,
+      int64_t offset,
+      int64_t length);
+
   // File descriptor.
   int32_t fd_{-1};
   std::string path_;
@@ -15,14 +15,18 @@
  */
 
 #include "velox/common/file/FileInputStream.h"
+#include "velox/common/file/FileIoTracer.h"
 
 namespace facebook::velox::common {
 
 FileInputStream::FileInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    io::IoPurpose ioPurpose)
     : file_(std::move(file)),
+      ioSource_(io::ioSourceOf(file_->getName())),
+      ioPurpose_(ioPurpose),
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize)),
       pool_(pool),
@@ -71,7 +75,6 @@ void FileInputStream::readNextRange() {
       readBytes = readSize();
       VELOX_CHECK_LT(
           0, readBytes, "Read past end of FileInputStream {}", fileSize_);
-      NanosecondTimer timer_2{&readTimeNs};
       file_->pread(fileOffset_, readBytes, buffer()->asMutable<char>());
     }
   }
@@ -81,6 +84,7 @@ void FileInputStream::readNextRange() {
   fileOffset_ += readBytes;
 
   updateStats(readBytes, readTimeNs);
+  recordIoLatency(ioSource_, ioPurpose_, readTimeNs / 1'000, readBytes);
 
   maybeIssueReadahead();
 }
@@ -20,6 +20,7 @@
 
 #include "velox/buffer/Buffer.h"
 #include "velox/common/file/File.h"
+#include "velox/common/io/IoStatistics.h"
 #include "velox/common/memory/ByteStream.h"
 
 namespace facebook::velox::common {
@@ -27,10 +28,13 @@ namespace facebook::velox::common {
 /// Readonly byte input stream backed by file.
 class FileInputStream : public ByteInputStream {
  public:
+  /// 'ioPurpose' is the purpose the reads are recorded under in the IO
+  /// latency histograms, see io::IoLatencyStats.
   FileInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      io::IoPurpose ioPurpose = io::IoPurpose::kOther);
 
   ~FileInputStream() override;
 
@@ -109,6 +113,8 @@ class FileInputStream : public ByteInputStream {
   void updateStats(uint64_t readBytes, uint64_t readTimeNs);
 
   const std::unique_ptr<ReadFile> file_;
+  const io::IoSource ioSource_;
+  const io::IoPurpose ioPurpose_;
   const uint64_t fileSize_;
   const uint64_t bufferSize_;
   memory::MemoryPool* const pool_;
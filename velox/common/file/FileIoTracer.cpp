@@ -18,6 +18,9 @@
 
 #include <glog/logging.h>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+
 namespace facebook::velox {
 
 std::string IoTag::toString() const {
@@ -54,6 +57,60 @@ const IoTag& ScopedIoTag::tag() const {
   return tag_;
 }
 
+namespace {
+// The StatsReporter metric names indexed by source and purpose.
+struct IoMetricKeys {
+  IoMetricKeys() {
+    for (auto source = 0; source < io::kNumIoSources; ++source) {
+      for (auto purpose = 0; purpose < io::kNumIoPurposes; ++purpose) {
+        const auto ioSource = static_cast<io::IoSource>(source);
+        const auto ioPurpose = static_cast<io::IoPurpose>(purpose);
+        latencyUs[source][purpose] =
+            io::ioMetricKey(kMetricIoLatencyUs, ioSource, ioPurpose);
+        bytes[source][purpose] =
+            io::ioMetricKey(kMetricIoBytes, ioSource, ioPurpose);
+      }
+    }
+  }
+
+  std::string latencyUs[io::kNumIoSources][io::kNumIoPurposes];
+  std::string bytes[io::kNumIoSources][io::kNumIoPurposes];
+};
+
+const IoMetricKeys& ioMetricKeys() {
+  static const IoMetricKeys keys;
+  return keys;
+}
+
+io::IoPurpose threadIoPurpose(io::IoPurpose purpose) {
+  for (const auto* tag = threadIoTag(); tag != nullptr; tag = tag->parent) {
+    if (const auto tagPurpose = io::ioPurposeOf(tag->name)) {
+      return *tagPurpose;
+    }
+  }
+  return purpose;
+}
+} // namespace
+
+void recordIoLatency(
+    io::IoSource source,
+    io::IoPurpose purpose,
+    uint64_t latencyMicros,
+    uint64_t bytes,
+    io::IoStatistics* stats) {
+  purpose = threadIoPurpose(purpose);
+  io::IoLatencyStats::global().record(source, purpose, latencyMicros, bytes);
+  if (stats != nullptr) {
+    stats->ioLatency().record(source, purpose, latencyMicros, bytes);
+  }
+  const auto& keys = ioMetricKeys();
+  const auto sourceIndex = static_cast<int32_t>(source);
+  const auto purposeIndex = static_cast<int32_t>(purpose);
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      keys.latencyUs[sourceIndex][purposeIndex], latencyMicros);
+  RECORD_HISTOGRAM_METRIC_VALUE(keys.bytes[sourceIndex][purposeIndex], bytes);
+}
+
 std::string toString(IoType type) {
   switch (type) {
     case IoType::Read:
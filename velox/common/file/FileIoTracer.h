@@ -25,6 +25,8 @@
 #include <string_view>
 #include <vector>
 
+#include "velox/common/io/IoStatistics.h"
+
 namespace facebook::velox {
 
 /// Represents a tag in the IO call stack. Tags are linked together to form
@@ -73,6 +75,17 @@ class ScopedIoTag {
   IoTag tag_;
 };
 
+/// Records the latency and the size of a read from 'source' into
+/// io::IoLatencyStats::global(), the StatsReporter histograms and 'stats' if
+/// not null. The purpose is that of the innermost tag of the thread's IO tag
+/// stack named after a purpose, e.g. ScopedIoTag("spill"), else 'purpose'.
+void recordIoLatency(
+    io::IoSource source,
+    io::IoPurpose purpose,
+    uint64_t latencyMicros,
+    uint64_t bytes,
+    io::IoStatistics* stats = nullptr);
+
 /// Type of IO operation.
 enum class IoType {
   Read,
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <folly/futures/Future.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+
+namespace facebook::velox {
+namespace {
+uint64_t elapsedUs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void addCounter(const FileIoContext& context, const std::string& name) {
+  if (context.ioStats != nullptr) {
+    context.ioStats->addCounter(name, RuntimeCounter(1));
+  }
+}
+} // namespace
+
+HedgedReadPolicy::HedgedReadPolicy(const Options& options)
+    : options_(options),
+      budget_(
+          std::max<double>(options_.maxHedgesPerSecond, 1),
+          std::max<double>(options_.maxHedgesPerSecond, 1)) {
+  VELOX_CHECK_GT(options_.latencyPercentile, 0);
+  VELOX_CHECK_LE(options_.latencyPercentile, 1);
+  latenciesUs_.resize(kMaxSamples);
+}
+
+// static
+std::shared_ptr<HedgedReadPolicy> HedgedReadPolicy::getInstance(
+    const std::string& fileSystem,
+    const Options& options) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<HedgedReadPolicy>>
+      policies;
+  std::lock_guard<std::mutex> l(mutex);
+  auto& policy = policies[fileSystem];
+  if (policy == nullptr) {
+    policy = std::make_shared<HedgedReadPolicy>(options);
+  }
+  return policy;
+}
+
+void HedgedReadPolicy::recordLatency(uint64_t latencyUs) {
+  std::lock_guard<std::mutex> l(mutex_);
+  latenciesUs_[nextLatency_] = latencyUs;
+  nextLatency_ = (nextLatency_ + 1) % kMaxSamples;
+  ++numLatencies_;
+  if (numLatencies_ >= kMinSamples &&
+      numLatencies_ % kRecomputeInterval == 0) {
+    recomputeHedgeDelayLocked();
+  }
+}
+
+void HedgedReadPolicy::recomputeHedgeDelayLocked() {
+  const auto numSamples = std::min<uint64_t>(numLatencies_, kMaxSamples);
+  std::vector<uint64_t> samples(
+      latenciesUs_.begin(), latenciesUs_.begin() + numSamples);
+  const auto index = std::min<uint64_t>(
+      numSamples - 1,
+      std::max<int64_t>(
+          std::ceil(options_.latencyPercentile * numSamples) - 1, 0));
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  // A delay of 0 means not yet computed.
+  hedgeDelayUs_ = std::max<uint64_t>(samples[index], 1);
+}
+
+std::optional<uint64_t> HedgedReadPolicy::hedgeDelayUs() const {
+  const auto delayUs = hedgeDelayUs_.load();
+  if (delayUs == 0) {
+    return std::nullopt;
+  }
+  return delayUs;
+}
+
+bool HedgedReadPolicy::canHedge() const {
+  return options_.maxHedgesPerSecond != 0 && budget_.available() >= 1;
+}
+
+bool HedgedReadPolicy::tryHedge() {
+  if (options_.maxHedgesPerSecond == 0) {
+    return false;
+  }
+  return budget_.consume(1);
+}
+
+HedgedReadFile::HedgedReadFile(
+    std::shared_ptr<ReadFile> file,
+    std::shared_ptr<HedgedReadPolicy> policy,
+    folly::Executor* executor)
+    : file_(std::move(file)), policy_(std::move(policy)), executor_(executor) {
+  VELOX_CHECK_NOT_NULL(file_);
+  VELOX_CHECK_NOT_NULL(policy_);
+  VELOX_CHECK_NOT_NULL(executor_);
+}
+
+std::string_view HedgedReadFile::pread(
+    uint64_t offset,
+    uint64_t length,
+    void* buf,
+    const FileIoContext& context) const {
+  const auto delayUs = hedgeableDelayUs();
+  if (!delayUs.has_value()) {
+    return timedRead(offset, length, buf, context);
+  }
+  const auto data = hedgedRead(offset, length, delayUs.value(), context);
+  ::memcpy(buf, data.data(), data.size());
+  return {static_cast<char*>(buf), data.size()};
+}
+
+uint64_t HedgedReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    const FileIoContext& context) const {
+  const auto delayUs = hedgeableDelayUs();
+  if (!delayUs.has_value()) {
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto numRead = file_->preadv(offset, buffers, context);
+    policy_->recordLatency(elapsedUs(startTime));
+    return numRead;
+  }
+  const auto fileSize = size();
+  if (offset >= fileSize) {
+    return 0;
+  }
+  uint64_t length{0};
+  for (const auto& range : buffers) {
+    length += range.size();
+  }
+  length = std::min(length, fileSize - offset);
+  // Reads the coalesced range, including the gaps, with one request.
+  const auto data = hedgedRead(offset, length, delayUs.value(), context);
+  uint64_t numRead{0};
+  for (const auto& range : buffers) {
+    const auto copySize = std::min<uint64_t>(range.size(), length - numRead);
+    if (range.data() != nullptr) {
+      ::memcpy(range.data(), data.data() + numRead, copySize);
+    }
+    numRead += copySize;
+  }
+  return numRead;
+}
+
+std::optional<uint64_t> HedgedReadFile::hedgeableDelayUs() const {
+  if (!policy_->canHedge()) {
+    return std::nullopt;
+  }
+  return policy_->hedgeDelayUs();
+}
+
+std::string_view HedgedReadFile::timedRead(
+    uint64_t offset,
+    uint64_t length,
+    void* buf,
+    const FileIoContext& context) const {
+  const auto startTime = std::chrono::steady_clock::now();
+  const auto data = file_->pread(offset, length, buf, context);
+  policy_->recordLatency(elapsedUs(startTime));
+  return data;
+}
+
+std::string HedgedReadFile::hedgedRead(
+    uint64_t offset,
+    uint64_t length,
+    uint64_t hedgeDelayUs,
+    const FileIoContext& context) const {
+  auto returnResponse = [&](Response response) {
+    if (context.ioStats != nullptr) {
+      context.ioStats->merge(*response.ioStats);
+    }
+    return std::move(response.data);
+  };
+  auto primary = readAsync(offset, length, context);
+  primary.wait(std::chrono::microseconds(hedgeDelayUs));
+  if (primary.isReady() || !policy_->tryHedge()) {
+    return returnResponse(std::move(primary).get());
+  }
+  addCounter(context, kHedgedReads);
+  std::vector<folly::SemiFuture<Response>> requests;
+  requests.push_back(std::move(primary));
+  requests.push_back(readAsync(offset, length, context));
+  // Returns the first successful response, or the last error if both fail.
+  auto [index, response] =
+      folly::collectAnyWithoutException(std::move(requests)).get();
+  if (index == 1) {
+    addCounter(context, kHedgedReadWins);
+  }
+  return returnResponse(std::move(response));
+}
+
+folly::SemiFuture<HedgedReadFile::Response> HedgedReadFile::readAsync(
+    uint64_t offset,
+    uint64_t length,
+    const FileIoContext& context) const {
+  auto ioStats = std::make_shared<filesystems::File::IoStats>();
+  return folly::via(
+             executor_,
+             [file = file_,
+              policy = policy_,
+              offset,
+              length,
+              requestContext = FileIoContext(
+                  ioStats.get(), context.fileOpts, context.ioTracer),
+              ioStats]() mutable {
+               const auto startTime = std::chrono::steady_clock::now();
+               auto data = file->pread(offset, length, requestContext);
+               policy->recordLatency(elapsedUs(startTime));
+               return Response{std::move(data), std::move(ioStats)};
+             })
+      .semi();
+}
+
+} // namespace facebook::velox
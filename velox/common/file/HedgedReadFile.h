@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/TokenBucket.h>
+
+#include <mutex>
+#include <optional>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+/// Tracks the latency of the recent reads of a file system and decides when a
+/// read is slow enough to issue a duplicate (hedged) request for it. A read
+/// whose latency exceeds the configured percentile of the recent latencies is
+/// hedged as long as the budget of hedged requests per second is not
+/// exhausted. The policy is shared by all the files of a file system.
+class HedgedReadPolicy {
+ public:
+  struct Options {
+    /// The percentile of the recent read latencies after which a read is
+    /// hedged, in (0, 1].
+    double latencyPercentile{0.95};
+
+    /// The maximum number of hedged requests issued per second. 0 disables
+    /// hedging.
+    uint32_t maxHedgesPerSecond{10};
+  };
+
+  /// The number of the recent read latencies the percentile is computed over.
+  static constexpr size_t kMaxSamples{1'024};
+  /// The number of read latencies recorded before the reads are hedged.
+  static constexpr size_t kMinSamples{64};
+  /// The number of read latencies recorded between the recomputations of the
+  /// hedge delay.
+  static constexpr size_t kRecomputeInterval{64};
+
+  explicit HedgedReadPolicy(const Options& options);
+
+  /// Returns the policy of 'fileSystem', creating it with 'options' on the
+  /// first call. The options of the later calls are ignored.
+  static std::shared_ptr<HedgedReadPolicy> getInstance(
+      const std::string& fileSystem,
+      const Options& options);
+
+  /// Records the latency of a completed read request.
+  void recordLatency(uint64_t latencyUs);
+
+  /// Returns the delay after which an outstanding read is hedged, or
+  /// std::nullopt if not enough latencies have been recorded yet.
+  std::optional<uint64_t> hedgeDelayUs() const;
+
+  /// Returns true if the budget has a hedged request left. Does not consume
+  /// it.
+  bool canHedge() const;
+
+  /// Consumes one hedged request from the budget. Returns false if the
+  /// budget is exhausted.
+  bool tryHedge();
+
+  const Options& options() const {
+    return options_;
+  }
+
+ private:
+  void recomputeHedgeDelayLocked();
+
+  const Options options_;
+  folly::TokenBucket budget_;
+
+  std::mutex mutex_;
+  // Ring buffer of the recent read latencies.
+  std::vector<uint64_t> latenciesUs_;
+  size_t nextLatency_{0};
+  uint64_t numLatencies_{0};
+  // 0 until kMinSamples latencies are recorded.
+  std::atomic<uint64_t> hedgeDelayUs_{0};
+};
+
+/// ReadFile wrapper which hedges the slow range reads of a remote file. A
+/// read that can be hedged runs on 'executor' and if it does not complete
+/// within the hedge delay of 'policy', a duplicate request is issued on
+/// 'executor' and the first successful response is returned. The abandoned
+/// request completes in the background. Since either request may be
+/// abandoned, both read into their own buffers and the result is copied into
+/// the caller's buffer. The reads that cannot be hedged, i.e. before the
+/// policy has a hedge delay or while its budget is exhausted, run on the
+/// calling thread directly into the caller's buffer.
+///
+/// Each request records into its own stats, and the stats of the response
+/// returned are merged into the caller's 'ioStats'. An abandoned request may
+/// outlive the caller's stats, so it never records into them directly.
+class HedgedReadFile : public ReadFile {
+ public:
+  /// The number of hedged requests issued.
+  static inline const std::string kHedgedReads = "hedgedReads";
+  /// The number of reads returned from the hedged request.
+  static inline const std::string kHedgedReadWins = "hedgedReadWins";
+
+  HedgedReadFile(
+      std::shared_ptr<ReadFile> file,
+      std::shared_ptr<HedgedReadPolicy> policy,
+      folly::Executor* executor);
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      const FileIoContext& context = {}) const override;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      const FileIoContext& context = {}) const override;
+
+  uint64_t preadv(
+      folly::Range<const common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs,
+      const FileIoContext& context = {}) const override {
+    return file_->preadv(regions, iobufs, context);
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      const FileIoContext& context = {}) const override {
+    return file_->preadvAsync(offset, buffers, context);
+  }
+
+  bool hasPreadvAsync() const override {
+    return file_->hasPreadvAsync();
+  }
+
+  bool shouldCoalesce() const override {
+    return file_->shouldCoalesce();
+  }
+
+  uint64_t size() const override {
+    return file_->size();
+  }
+
+  uint64_t memoryUsage() const override {
+    return file_->memoryUsage();
+  }
+
+  uint64_t bytesRead() const override {
+    return file_->bytesRead();
+  }
+
+  void resetBytesRead() override {
+    file_->resetBytesRead();
+  }
+
+  std::string getName() const override {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return file_->getNaturalReadSize();
+  }
+
+ private:
+  // Reads [offset, offset + length) directly from 'file_' on the calling
+  // thread, recording the latency into 'policy_'.
+  std::string_view timedRead(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      const FileIoContext& context) const;
+
+  // Returns the hedge delay if the read can be hedged, std::nullopt
+  // otherwise.
+  std::optional<uint64_t> hedgeableDelayUs() const;
+
+  // The data read by a request and the stats it recorded.
+  struct Response {
+    std::string data;
+    std::shared_ptr<filesystems::File::IoStats> ioStats;
+  };
+
+  // Reads [offset, offset + length) on 'executor_', hedging the request after
+  // 'hedgeDelayUs'. Merges the stats of the response returned into the
+  // 'ioStats' of 'context'.
+  std::string hedgedRead(
+      uint64_t offset,
+      uint64_t length,
+      uint64_t hedgeDelayUs,
+      const FileIoContext& context) const;
+
+  folly::SemiFuture<Response> readAsync(
+      uint64_t offset,
+      uint64_t length,
+      const FileIoContext& context) const;
+
+  const std::shared_ptr<ReadFile> file_;
+  const std::shared_ptr<HedgedReadPolicy> policy_;
+  folly::Executor* const executor_;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <folly/String.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+#include "velox/common/base/Exceptions.h"
+
+DECLARE_bool(velox_io_uring_enabled);
+DECLARE_int32(velox_io_uring_queue_depth);
+
+namespace facebook::velox {
+
+uint64_t IoUring::Request::size() const {
+  uint64_t size = 0;
+  for (const auto& iov : iovecs) {
+    size += iov.iov_len;
+  }
+  return size;
+}
+
+// static
+IoUring* IoUring::instance() {
+#ifdef VELOX_ENABLE_IO_URING
+  if (!FLAGS_velox_io_uring_enabled) {
+    return nullptr;
+  }
+  // Stays nullptr if the kernel does not support io_uring.
+  static const std::unique_ptr<IoUring> ring =
+      create(FLAGS_velox_io_uring_queue_depth);
+  return ring.get();
+#else
+  return nullptr;
+#endif
+}
+
+folly::SemiFuture<std::vector<IoUring::Request>> IoUring::submit(
+    std::vector<Request> requests,
+    bool write) {
+  if (requests.empty()) {
+    return folly::makeSemiFuture(std::move(requests));
+  }
+  auto batch = std::make_unique<Batch>();
+  batch->requests = std::move(requests);
+  batch->write = write;
+  batch->slots.reserve(batch->requests.size());
+  for (size_t i = 0; i < batch->requests.size(); ++i) {
+    batch->slots.push_back({batch.get(), i});
+  }
+  auto future = batch->promise.getSemiFuture();
+  std::lock_guard<std::mutex> l(mutex_);
+  pending_.push_back(batch.release());
+  submitPendingLocked();
+  return future;
+}
+
+#ifdef VELOX_ENABLE_IO_URING
+
+IoUring::IoUring(std::unique_ptr<struct io_uring> ring, uint32_t queueDepth)
+    : ring_(std::move(ring)), queueDepth_(queueDepth) {
+  completionThread_ = std::thread([this]() { reapCompletions(); });
+}
+
+IoUring::~IoUring() {
+  {
+    // Wakes up the completion thread with a request without user data.
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* sqe = io_uring_get_sqe(ring_.get());
+    VELOX_CHECK_NOT_NULL(sqe);
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(ring_.get());
+  }
+  completionThread_.join();
+  io_uring_queue_exit(ring_.get());
+}
+
+// static
+std::unique_ptr<IoUring> IoUring::create(uint32_t queueDepth) {
+  VELOX_CHECK_GT(queueDepth, 0);
+  auto ring = std::make_unique<struct io_uring>();
+  const auto ret = io_uring_queue_init(queueDepth, ring.get(), 0);
+  if (ret < 0) {
+    LOG(WARNING) << "io_uring_queue_init failed, using synchronous IO: "
+                 << folly::errnoStr(-ret);
+    return nullptr;
+  }
+  return std::unique_ptr<IoUring>(new IoUring(std::move(ring), queueDepth));
+}
+
+void IoUring::submitPendingLocked() {
+  uint32_t numPrepared = 0;
+  while (!pending_.empty() && numInFlight_ < queueDepth_) {
+    auto* sqe = io_uring_get_sqe(ring_.get());
+    if (sqe == nullptr) {
+      break;
+    }
+    auto* batch = pending_.front();
+    auto& request = batch->requests[batch->numSubmitted];
+    if (batch->write) {
+      io_uring_prep_writev(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    } else {
+      io_uring_prep_readv(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    }
+    io_uring_sqe_set_data(sqe, &batch->slots[batch->numSubmitted]);
+    ++numInFlight_;
+    ++numPrepared;
+    if (++batch->numSubmitted == batch->requests.size()) {
+      pending_.pop_front();
+    }
+  }
+  if (numPrepared == 0) {
+    return;
+  }
+  int ret;
+  do {
+    ret = io_uring_submit(ring_.get());
+  } while (ret == -EINTR || ret == -EAGAIN);
+  VELOX_CHECK_GE(ret, 0, "io_uring_submit failed: {}", folly::errnoStr(-ret));
+}
+
+void IoUring::reapCompletions() {
+  for (;;) {
+    struct io_uring_cqe* cqe;
+    const auto ret = io_uring_wait_cqe(ring_.get(), &cqe);
+    if (ret == -EINTR) {
+      continue;
+    }
+    VELOX_CHECK_EQ(
+        ret, 0, "io_uring_wait_cqe failed: {}", folly::errnoStr(-ret));
+    auto* slot = static_cast<Slot*>(io_uring_cqe_get_data(cqe));
+    const int64_t result = cqe->res;
+    io_uring_cqe_seen(ring_.get(), cqe);
+    if (slot == nullptr) {
+      return;
+    }
+
+    std::unique_ptr<Batch> completed;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      --numInFlight_;
+      auto* batch = slot->batch;
+      batch->requests[slot->index].result = result;
+      if (++batch->numCompleted == batch->requests.size()) {
+        completed.reset(batch);
+      }
+      submitPendingLocked();
+    }
+    if (completed != nullptr) {
+      completed->promise.setValue(std::move(completed->requests));
+    }
+  }
+}
+
+#else
+
+IoUring::IoUring(std::unique_ptr<struct io_uring> ring, uint32_t queueDepth)
+    : ring_(std::move(ring)), queueDepth_(queueDepth) {}
+
+IoUring::~IoUring() = default;
+
+// static
+std::unique_ptr<IoUring> IoUring::create(uint32_t /*queueDepth*/) {
+  return nullptr;
+}
+
+void IoUring::submitPendingLocked() {
+  VELOX_UNREACHABLE("Velox is built without io_uring");
+}
+
+void IoUring::reapCompletions() {
+  VELOX_UNREACHABLE("Velox is built without io_uring");
+}
+
+#endif // VELOX_ENABLE_IO_URING
+
+} // namespace facebook::velox
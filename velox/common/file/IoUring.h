@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/uio.h>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <folly/futures/Future.h>
+
+struct io_uring;
+
+namespace facebook::velox {
+
+/// A process-wide io_uring submission and completion queue. LocalReadFile and
+/// LocalWriteFile use it to issue the pieces of a vectored IO as concurrent
+/// requests so that the device queue depth is used by a single caller, e.g.
+/// the coalesced loads of DirectBufferedInput and the SSD cache reads and
+/// writes. Requests are submitted without blocking the caller and a dedicated
+/// thread reaps the completions. io_uring is only available when Velox is
+/// built with VELOX_ENABLE_IO_URING.
+class IoUring {
+ public:
+  /// A vectored read or write of 'iovecs' at 'offset' of 'fd'.
+  struct Request {
+    int32_t fd;
+    uint64_t offset;
+    std::vector<iovec> iovecs;
+    /// Set on completion to the number of bytes transferred or -errno.
+    int64_t result{0};
+
+    uint64_t size() const;
+  };
+
+  ~IoUring();
+
+  /// Returns the process-wide ring, creating it and its completion thread on
+  /// first use. Returns nullptr if Velox is built without io_uring, if it is
+  /// disabled by --velox_io_uring_enabled or if the kernel does not support
+  /// it.
+  static IoUring* instance();
+
+  /// Submits 'requests' as reads or writes and returns right away. The future
+  /// is fulfilled on the completion thread with 'requests' once all of them
+  /// have completed, with Request::result of each set. Keeps at most the queue
+  /// depth of the ring in flight and submits the rest as earlier requests
+  /// complete. The buffers of 'requests' must stay valid until then.
+  folly::SemiFuture<std::vector<Request>> submit(
+      std::vector<Request> requests,
+      bool write);
+
+ private:
+  struct Batch;
+
+  // Identifies a request of a batch in the user data of its submission.
+  struct Slot {
+    Batch* batch;
+    size_t index;
+  };
+
+  struct Batch {
+    std::vector<Request> requests;
+    bool write;
+    std::vector<Slot> slots;
+    size_t numSubmitted{0};
+    size_t numCompleted{0};
+    folly::Promise<std::vector<Request>> promise;
+  };
+
+  IoUring(std::unique_ptr<struct io_uring> ring, uint32_t queueDepth);
+
+  static std::unique_ptr<IoUring> create(uint32_t queueDepth);
+
+  // Prepares the requests of 'pending_' while fewer than the queue depth are
+  // in flight and submits them.
+  void submitPendingLocked();
+
+  // Runs on 'completionThread_'. Sets the results of the completed requests
+  // and fulfils the batches whose requests have all completed.
+  void reapCompletions();
+
+  const std::unique_ptr<struct io_uring> ring_;
+  const uint32_t queueDepth_;
+
+  std::mutex mutex_;
+  // Batches with requests left to submit, in submission order.
+  std::deque<Batch*> pending_;
+  uint32_t numInFlight_{0};
+  std::thread completionThread_;
+};
+
+} // namespace facebook::velox
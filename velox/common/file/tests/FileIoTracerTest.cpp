@@ -344,3 +344,101 @@ TEST_F(FileIoTracerTest, inMemoryFileIoTracerFuzz) {
     }
   }
 }
+
+TEST_F(FileIoTracerTest, ioSourceAndPurpose) {
+  EXPECT_EQ(io::ioSourceOf("/tmp/file"), io::IoSource::kLocal);
+  EXPECT_EQ(io::ioSourceOf("file:/tmp/file"), io::IoSource::kLocal);
+  EXPECT_EQ(io::ioSourceOf("file:///tmp/file"), io::IoSource::kLocal);
+  EXPECT_EQ(io::ioSourceOf("s3a://bucket/key"), io::IoSource::kS3);
+  EXPECT_EQ(io::ioSourceOf("gs://bucket/key"), io::IoSource::kGcs);
+  EXPECT_EQ(io::ioSourceOf("abfss://container/key"), io::IoSource::kAbfs);
+  EXPECT_EQ(io::ioSourceOf("hdfs://host/path"), io::IoSource::kHdfs);
+  EXPECT_EQ(io::ioSourceOf("unknown://path"), io::IoSource::kOther);
+
+  for (auto i = 0; i < io::kNumIoPurposes; ++i) {
+    const auto purpose = static_cast<io::IoPurpose>(i);
+    EXPECT_EQ(io::ioPurposeOf(io::toString(purpose)), purpose);
+  }
+  EXPECT_FALSE(io::ioPurposeOf("ColumnReader").has_value());
+
+  EXPECT_EQ(
+      io::ioMetricKey(
+          "velox.io_latency_us", io::IoSource::kS3, io::IoPurpose::kData),
+      "velox.io_latency_us.s3.data");
+}
+
+TEST_F(FileIoTracerTest, ioHistogram) {
+  io::IoHistogram histogram;
+  EXPECT_EQ(histogram.percentile(50), 0);
+
+  for (auto value = 1; value <= 100; ++value) {
+    histogram.record(value);
+  }
+  histogram.record(0);
+  EXPECT_EQ(histogram.counter().count(), 101);
+  EXPECT_EQ(histogram.counter().max(), 100);
+  EXPECT_EQ(histogram.bucketCount(0), 1);
+  EXPECT_EQ(histogram.bucketCount(1), 1);
+  // [64, 128).
+  EXPECT_EQ(histogram.bucketCount(7), 37);
+  EXPECT_EQ(histogram.percentile(0), 0);
+  // The 51st value is 50, in bucket [32, 64).
+  EXPECT_EQ(histogram.percentile(50), 63);
+  // Capped by the max.
+  EXPECT_EQ(histogram.percentile(99), 100);
+  EXPECT_EQ(histogram.percentile(100), 100);
+
+  io::IoHistogram other;
+  other.record(1'000);
+  histogram.merge(other);
+  EXPECT_EQ(histogram.counter().count(), 102);
+  EXPECT_EQ(histogram.bucketCount(10), 1);
+  EXPECT_EQ(histogram.percentile(100), 1'000);
+}
+
+TEST_F(FileIoTracerTest, recordIoLatency) {
+  io::IoStatistics stats;
+  recordIoLatency(io::IoSource::kS3, io::IoPurpose::kData, 10, 1'024, &stats);
+  {
+    ScopedIoTag operatorTag("HashBuild");
+    ScopedIoTag spillTag("spill");
+    ScopedIoTag readerTag("ColumnReader");
+    // The innermost tag named after a purpose overrides the purpose.
+    recordIoLatency(
+        io::IoSource::kLocal, io::IoPurpose::kOther, 20, 2'048, &stats);
+  }
+
+  const auto& s3Data =
+      stats.ioLatency().histograms(io::IoSource::kS3, io::IoPurpose::kData);
+  EXPECT_EQ(s3Data.latencyMicros.counter().count(), 1);
+  EXPECT_EQ(s3Data.latencyMicros.counter().sum(), 10);
+  EXPECT_EQ(s3Data.bytes.counter().sum(), 1'024);
+
+  const auto& localSpill = stats.ioLatency().histograms(
+      io::IoSource::kLocal, io::IoPurpose::kSpill);
+  EXPECT_EQ(localSpill.latencyMicros.counter().count(), 1);
+  EXPECT_EQ(localSpill.latencyMicros.counter().sum(), 20);
+  EXPECT_EQ(
+      stats.ioLatency()
+          .histograms(io::IoSource::kLocal, io::IoPurpose::kOther)
+          .latencyMicros.counter()
+          .count(),
+      0);
+
+  // The reads are also recorded process-wide.
+  EXPECT_GE(
+      io::IoLatencyStats::global()
+          .histograms(io::IoSource::kLocal, io::IoPurpose::kSpill)
+          .bytes.counter()
+          .count(),
+      1);
+
+  io::IoStatistics merged;
+  merged.merge(stats);
+  EXPECT_EQ(
+      merged.ioLatency()
+          .histograms(io::IoSource::kS3, io::IoPurpose::kData)
+          .bytes.counter()
+          .sum(),
+      1'024);
+}
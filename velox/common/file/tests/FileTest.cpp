@@ -17,16 +17,20 @@
 #include <fcntl.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/system/HardwareConcurrency.h>
+#include <gflags/gflags.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
 #include "gtest/gtest.h"
 
+DECLARE_bool(velox_io_uring_enabled);
+
 using namespace facebook::velox;
 using facebook::velox::common::Region;
 using namespace facebook::velox::tests::utils;
@@ -471,6 +475,64 @@ TEST_P(LocalFileTest, attributes) {
   writeFile->close();
 }
 
+TEST_P(LocalFileTest, ioUring) {
+  constexpr int32_t kChunkSize = 16;
+  for (bool ioUringEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("ioUringEnabled {}", ioUringEnabled));
+    gflags::FlagSaver flagSaver;
+    FLAGS_velox_io_uring_enabled = ioUringEnabled;
+    // A single pwritev takes at most IOV_MAX iovecs.
+    const int32_t numChunks =
+        IoUring::instance() != nullptr ? 2 * IOV_MAX + 1 : IOV_MAX;
+
+    std::vector<std::string> chunks;
+    std::vector<iovec> iovecs;
+    for (auto i = 0; i < numChunks; ++i) {
+      chunks.push_back(std::string(kChunkSize, 'a' + i % 26));
+    }
+    for (auto& chunk : chunks) {
+      iovecs.push_back({chunk.data(), chunk.size()});
+    }
+    auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
+    const auto& filename = tempFile->getPath();
+    auto fs = filesystems::getFileSystem(filename, {});
+    fs->remove(filename);
+    {
+      auto writeFile = fs->openFileForWrite(filename);
+      writeFile->write(iovecs, 0, numChunks * kChunkSize);
+      writeFile->close();
+      ASSERT_EQ(writeFile->size(), numChunks * kChunkSize);
+    }
+
+    // Reads the even chunks and skips the odd ones.
+    auto readFile = fs->openFileForRead(filename);
+    std::vector<std::string> evenChunks((numChunks + 1) / 2);
+    std::vector<folly::Range<char*>> buffers;
+    for (auto i = 0; i < numChunks; ++i) {
+      if (i % 2 == 0) {
+        auto& chunk = evenChunks[i / 2];
+        chunk.resize(kChunkSize);
+        buffers.push_back(folly::Range<char*>(chunk.data(), kChunkSize));
+      } else {
+        buffers.push_back(
+            folly::Range<char*>(nullptr, (char*)(uint64_t)kChunkSize));
+      }
+    }
+    ASSERT_EQ(readFile->preadv(0, buffers), numChunks * kChunkSize);
+    for (auto i = 0; i < evenChunks.size(); ++i) {
+      ASSERT_EQ(evenChunks[i], chunks[2 * i]);
+      evenChunks[i].assign(kChunkSize, ' ');
+    }
+
+    // With io_uring, the requests complete without a thread waiting on them.
+    ASSERT_EQ(
+        readFile->preadvAsync(0, buffers).get(), numChunks * kChunkSize);
+    for (auto i = 0; i < evenChunks.size(); ++i) {
+      ASSERT_EQ(evenChunks[i], chunks[2 * i]);
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     LocalFileTestSuite,
     LocalFileTest,
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include <mutex>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+
+namespace {
+// In-memory file whose reads sleep for the delay returned by 'delayMs' for the
+// read's sequence number. Each read records kNumReads into the stats of its
+// context.
+class SlowReadFile : public InMemoryReadFile {
+ public:
+  SlowReadFile(std::string data, std::function<uint64_t(int32_t)> delayMs)
+      : InMemoryReadFile(std::move(data)), delayMs_(std::move(delayMs)) {}
+
+  static inline const std::string kNumReads = "numReads";
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      const FileIoContext& context = {}) const override {
+    sleep(context);
+    return InMemoryReadFile::pread(offset, length, buf, context);
+  }
+
+  std::string pread(
+      uint64_t offset,
+      uint64_t length,
+      const FileIoContext& context = {}) const override {
+    sleep(context);
+    return InMemoryReadFile::pread(offset, length, context);
+  }
+
+  int32_t numReads() const {
+    return numReads_;
+  }
+
+  std::thread::id lastReadThread() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return lastReadThread_;
+  }
+
+ private:
+  void sleep(const FileIoContext& context) const {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      lastReadThread_ = std::this_thread::get_id();
+    }
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(delayMs_(numReads_++)));
+    if (context.ioStats != nullptr) {
+      context.ioStats->addCounter(kNumReads, RuntimeCounter(1));
+    }
+  }
+
+  const std::function<uint64_t(int32_t)> delayMs_;
+  mutable std::atomic<int32_t> numReads_{0};
+  mutable std::mutex mutex_;
+  mutable std::thread::id lastReadThread_;
+};
+
+std::string makeData(size_t size) {
+  std::string data(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = 'a' + i % 26;
+  }
+  return data;
+}
+
+uint64_t counter(
+    const filesystems::File::IoStats& stats,
+    const std::string& name) {
+  const auto allStats = stats.stats();
+  const auto it = allStats.find(name);
+  return it == allStats.end() ? 0 : it->second.sum;
+}
+} // namespace
+
+class HedgedReadFileTest : public ::testing::Test {
+ protected:
+  // Returns a policy whose hedge delay is 'hedgeDelayUs'. The delay is well
+  // above the latency of the fast reads so that these are never hedged.
+  static std::shared_ptr<HedgedReadPolicy> makePolicy(
+      uint64_t hedgeDelayUs,
+      uint32_t maxHedgesPerSecond) {
+    auto policy = std::make_shared<HedgedReadPolicy>(
+        HedgedReadPolicy::Options{0.95, maxHedgesPerSecond});
+    for (size_t i = 0; i < HedgedReadPolicy::kMinSamples; ++i) {
+      policy->recordLatency(hedgeDelayUs);
+    }
+    return policy;
+  }
+
+  folly::CPUThreadPoolExecutor executor_{4};
+};
+
+TEST_F(HedgedReadFileTest, hedgeDelay) {
+  HedgedReadPolicy policy({0.95, 10});
+  for (size_t i = 1; i < HedgedReadPolicy::kMinSamples; ++i) {
+    policy.recordLatency(i);
+    ASSERT_FALSE(policy.hedgeDelayUs().has_value());
+  }
+  policy.recordLatency(HedgedReadPolicy::kMinSamples);
+  // The 95th percentile of 1..64.
+  ASSERT_EQ(policy.hedgeDelayUs(), 61);
+
+  for (size_t i = HedgedReadPolicy::kMinSamples + 1; i <= 128; ++i) {
+    policy.recordLatency(i);
+  }
+  ASSERT_EQ(policy.hedgeDelayUs(), 122);
+
+  // Only the most recent kMaxSamples latencies are considered.
+  for (size_t i = 0; i < HedgedReadPolicy::kMaxSamples; ++i) {
+    policy.recordLatency(1'000);
+  }
+  ASSERT_EQ(policy.hedgeDelayUs(), 1'000);
+}
+
+TEST_F(HedgedReadFileTest, budget) {
+  HedgedReadPolicy policy({0.95, 2});
+  ASSERT_TRUE(policy.tryHedge());
+  ASSERT_TRUE(policy.tryHedge());
+  ASSERT_FALSE(policy.tryHedge());
+
+  HedgedReadPolicy disabled({0.95, 0});
+  ASSERT_FALSE(disabled.tryHedge());
+}
+
+TEST_F(HedgedReadFileTest, getInstance) {
+  auto policy =
+      HedgedReadPolicy::getInstance("HedgedReadFileTest", {0.99, 10});
+  ASSERT_EQ(policy->options().latencyPercentile, 0.99);
+  ASSERT_EQ(
+      HedgedReadPolicy::getInstance("HedgedReadFileTest", {0.5, 1}), policy);
+  ASSERT_NE(
+      HedgedReadPolicy::getInstance("HedgedReadFileTest2", {0.99, 10}),
+      policy);
+}
+
+TEST_F(HedgedReadFileTest, noHedgeWithoutLatencies) {
+  const auto data = makeData(1'000);
+  auto file = std::make_shared<SlowReadFile>(
+      data, [](int32_t /*read*/) { return 0; });
+  auto policy = std::make_shared<HedgedReadPolicy>(
+      HedgedReadPolicy::Options{0.95, 10});
+  HedgedReadFile hedgedFile(file, policy, &executor_);
+  filesystems::File::IoStats stats;
+  FileIoContext context(&stats);
+  std::string buffer(100, 0);
+  ASSERT_EQ(
+      hedgedFile.pread(10, 100, buffer.data(), context), data.substr(10, 100));
+  ASSERT_EQ(file->numReads(), 1);
+  // The read runs on the calling thread with the caller's stats.
+  ASSERT_EQ(file->lastReadThread(), std::this_thread::get_id());
+  ASSERT_EQ(counter(stats, SlowReadFile::kNumReads), 1);
+  ASSERT_EQ(counter(stats, HedgedReadFile::kHedgedReads), 0);
+}
+
+TEST_F(HedgedReadFileTest, hedgeSlowRead) {
+  const auto data = makeData(10'000);
+  // The first read is slow.
+  auto file = std::make_shared<SlowReadFile>(
+      data, [](int32_t read) { return read == 0 ? 2'000 : 0; });
+  HedgedReadFile hedgedFile(file, makePolicy(100'000, 10), &executor_);
+  filesystems::File::IoStats stats;
+  FileIoContext context(&stats);
+  std::string buffer(1'000, 0);
+  const auto startTime = std::chrono::steady_clock::now();
+  ASSERT_EQ(
+      hedgedFile.pread(100, 1'000, buffer.data(), context),
+      data.substr(100, 1'000));
+  ASSERT_LT(
+      std::chrono::steady_clock::now() - startTime, std::chrono::seconds(1));
+  ASSERT_EQ(counter(stats, HedgedReadFile::kHedgedReads), 1);
+  ASSERT_EQ(counter(stats, HedgedReadFile::kHedgedReadWins), 1);
+  // Only the stats of the winning request are recorded.
+  ASSERT_EQ(counter(stats, SlowReadFile::kNumReads), 1);
+
+  // The fast reads are not hedged.
+  ASSERT_EQ(
+      hedgedFile.pread(2'000, 1'000, buffer.data(), context),
+      data.substr(2'000, 1'000));
+  ASSERT_EQ(counter(stats, HedgedReadFile::kHedgedReads), 1);
+  executor_.join();
+  ASSERT_EQ(file->numReads(), 3);
+}
+
+TEST_F(HedgedReadFileTest, hedgePreadv) {
+  const auto data = makeData(10'000);
+  auto file = std::make_shared<SlowReadFile>(
+      data, [](int32_t read) { return read == 0 ? 2'000 : 0; });
+  HedgedReadFile hedgedFile(file, makePolicy(100'000, 10), &executor_);
+  filesystems::File::IoStats stats;
+  FileIoContext context(&stats);
+  std::string first(100, 0);
+  std::string second(200, 0);
+  // Reads [100, 200) and [300, 500), skipping the gap in between.
+  std::vector<folly::Range<char*>> buffers{
+      {first.data(), first.size()},
+      {nullptr, 100},
+      {second.data(), second.size()}};
+  ASSERT_EQ(hedgedFile.preadv(100, buffers, context), 400);
+  ASSERT_EQ(first, data.substr(100, 100));
+  ASSERT_EQ(second, data.substr(300, 200));
+  ASSERT_EQ(counter(stats, HedgedReadFile::kHedgedReads), 1);
+
+  // The reads past the end of file are truncated.
+  std::vector<folly::Range<char*>> tail{{first.data(), first.size()}};
+  ASSERT_EQ(hedgedFile.preadv(9'950, tail, context), 50);
+  ASSERT_EQ(first.substr(0, 50), data.substr(9'950, 50));
+  executor_.join();
+}
+
+TEST_F(HedgedReadFileTest, budgetExhausted) {
+  const auto data = makeData(1'000);
+  auto file = std::make_shared<SlowReadFile>(
+      data, [](int32_t read) { return read == 0 ? 300 : 0; });
+  HedgedReadFile hedgedFile(file, makePolicy(100'000, 0), &executor_);
+  filesystems::File::IoStats stats;
+  FileIoContext context(&stats);
+  std::string buffer(100, 0);
+  ASSERT_EQ(
+      hedgedFile.pread(0, 100, buffer.data(), context), data.substr(0, 100));
+  ASSERT_EQ(file->numReads(), 1);
+  // A read that cannot be hedged runs on the calling thread.
+  ASSERT_EQ(file->lastReadThread(), std::this_thread::get_id());
+  ASSERT_EQ(counter(stats, HedgedReadFile::kHedgedReads), 0);
+}
+
+TEST_F(HedgedReadFileTest, readError) {
+  auto file = std::make_shared<SlowReadFile>(
+      makeData(1'000), [](int32_t read) -> uint64_t {
+        if (read == 0) {
+          return 300;
+        }
+        VELOX_FAIL("Read failed");
+      });
+  HedgedReadFile hedgedFile(file, makePolicy(100'000, 10), &executor_);
+  std::string buffer(100, 0);
+  // The hedged request fails and the primary one succeeds.
+  ASSERT_EQ(hedgedFile.pread(0, 100, buffer.data()).size(), 100);
+  executor_.join();
+  ASSERT_EQ(file->numReads(), 2);
+}
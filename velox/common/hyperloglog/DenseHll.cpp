@@ -156,6 +156,30 @@ void DenseHll<TAllocator>::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+template <typename TAllocator>
+void DenseHll<TAllocator>::insertHashes(const uint64_t* hashes, int32_t size) {
+  constexpr int32_t kBatchSize = 64;
+  uint32_t indices[kBatchSize];
+  int8_t values[kBatchSize];
+  for (int32_t start = 0; start < size; start += kBatchSize) {
+    const auto numHashes = std::min(kBatchSize, size - start);
+    // No dependency between hashes, so this loop vectorizes.
+    for (auto i = 0; i < numHashes; ++i) {
+      const auto hash = hashes[start + i];
+      indices[i] = computeIndex(hash, indexBitLength_);
+      values[i] = numberOfLeadingZeros(hash, indexBitLength_) + 1;
+    }
+    for (auto i = 0; i < numHashes; ++i) {
+      // Once the HLL has seen enough values most hashes do not raise their
+      // bucket. Skip these without the overflow lookup in insert().
+      if (values[i] - baseline_ <= getDelta(indices[i])) {
+        continue;
+      }
+      insert(indices[i], values[i]);
+    }
+  }
+}
+
 template <typename TAllocator>
 void DenseHll<TAllocator>::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
@@ -87,6 +87,10 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Inserts 'size' hashes. Computes the buckets and values for a batch of
+  /// hashes up front and only updates the buckets whose value increases.
+  void insertHashes(const uint64_t* hashes, int32_t size);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
@@ -267,22 +267,33 @@ void SparseHll<TAllocator>::verify() const {
 
 template <typename TAllocator>
 void SparseHll<TAllocator>::toDense(DenseHll<TAllocator>& denseHll) const {
-  auto indexBitLength = denseHll.indexBitLength();
-
-  for (auto entry : entries_) {
-    auto index = entry >> (32 - indexBitLength);
-    auto shiftedValue = entry << indexBitLength;
-    auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
-
-    // If zeros >= kIndexBitLength - indexBitLength, it means all those bits
-    // were zeros, so look at the entry value, which contains the number of
-    // leading 0 *after* kIndexBitLength.
-    auto bits = kIndexBitLength - indexBitLength;
-    if (zeros >= bits) {
-      zeros = bits + decodeValue(entry);
+  const auto indexBitLength = denseHll.indexBitLength();
+  const auto bits = kIndexBitLength - indexBitLength;
+
+  // The entries are sorted by their 26-bit index, so the entries that map to
+  // the same dense bucket are adjacent. Inserts the max value of each run once
+  // instead of inserting every entry.
+  const auto numEntries = entries_.size();
+  size_t i = 0;
+  while (i < numEntries) {
+    const auto index = entries_[i] >> (32 - indexBitLength);
+    int8_t maxValue = 0;
+    for (; i < numEntries && (entries_[i] >> (32 - indexBitLength)) == index;
+         ++i) {
+      const auto entry = entries_[i];
+      const auto shiftedValue = entry << indexBitLength;
+      int zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
+
+      // If zeros >= kIndexBitLength - indexBitLength, it means all those bits
+      // were zeros, so look at the entry value, which contains the number of
+      // leading 0 *after* kIndexBitLength.
+      if (zeros >= bits) {
+        zeros = bits + decodeValue(entry);
+      }
+      maxValue = std::max<int8_t>(maxValue, zeros + 1);
     }
 
-    denseHll.insert(index, zeros + 1);
+    denseHll.insert(index, maxValue);
   }
 }
 
@@ -16,6 +16,7 @@
 #include "velox/common/hyperloglog/DenseHll.h"
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include "velox/common/hyperloglog/SparseHll.h"
 #include "velox/common/memory/HashStringAllocator.h"
 
 #define XXH_INLINE_ALL
@@ -36,6 +37,9 @@ uint64_t hashOne(T value) {
 // values for hash bits. Larger values of hash bits corresponds to larger
 // digests that are more accurate, but slower to merge. The default number of
 // hash bits is 11, while in practice 16 is common.
+//
+// Also measures inserting hashes one at a time vs. in batches and converting
+// a sparse HLL at its size limit to dense.
 class DenseHllBenchmark {
  public:
   explicit DenseHllBenchmark(memory::MemoryPool* pool) : pool_(pool) {
@@ -43,6 +47,10 @@ class DenseHllBenchmark {
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 1));
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 2));
     }
+    hashes_.reserve(1'000'000);
+    for (int32_t i = 0; i < 1'000'000; ++i) {
+      hashes_.push_back(hashOne(i));
+    }
   }
 
   void run(int hashBits) {
@@ -58,6 +66,44 @@ class DenseHllBenchmark {
     }
   }
 
+  void insert(int hashBits, bool batch) {
+    folly::BenchmarkSuspender suspender;
+
+    HashStringAllocator allocator(pool_);
+    common::hll::DenseHll<> hll(hashBits, &allocator);
+
+    suspender.dismiss();
+
+    if (batch) {
+      hll.insertHashes(hashes_.data(), hashes_.size());
+    } else {
+      for (auto hash : hashes_) {
+        hll.insertHash(hash);
+      }
+    }
+    folly::doNotOptimizeAway(hll);
+  }
+
+  void toDense(int hashBits) {
+    folly::BenchmarkSuspender suspender;
+
+    HashStringAllocator allocator(pool_);
+    common::hll::SparseHll<> sparseHll(&allocator);
+    sparseHll.setSoftMemoryLimit(
+        common::hll::DenseHlls::estimateInMemorySize(hashBits));
+    for (auto hash : hashes_) {
+      if (sparseHll.insertHash(hash)) {
+        break;
+      }
+    }
+    common::hll::DenseHll<> denseHll(hashBits, &allocator);
+
+    suspender.dismiss();
+
+    sparseHll.toDense(denseHll);
+    folly::doNotOptimizeAway(denseHll);
+  }
+
  private:
   std::string makeSerializedHll(int hashBits, int32_t step) {
     HashStringAllocator allocator(pool_);
@@ -82,6 +128,9 @@ class DenseHllBenchmark {
   // List of serialized HLLs to use for merging, keyed by the number of hash
   // bits.
   std::unordered_map<int, std::vector<std::string>> serializedHlls_;
+
+  // Hashes of 1M distinct values to insert.
+  std::vector<uint64_t> hashes_;
 };
 
 } // namespace
@@ -100,6 +149,30 @@ BENCHMARK(mergeSerialized16) {
   benchmark->run(16);
 }
 
+BENCHMARK(insertHash11) {
+  benchmark->insert(11, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes11) {
+  benchmark->insert(11, true);
+}
+
+BENCHMARK(insertHash16) {
+  benchmark->insert(16, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes16) {
+  benchmark->insert(16, true);
+}
+
+BENCHMARK(sparseToDense11) {
+  benchmark->toDense(11);
+}
+
+BENCHMARK(sparseToDense16) {
+  benchmark->toDense(16);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
 
@@ -177,6 +177,28 @@ TYPED_TEST(DenseHllTest, highCardinality) {
   ASSERT_EQ(denseHll.cardinality(), DenseHlls::cardinality(serialized.data()));
 }
 
+TYPED_TEST(DenseHllTest, insertHashes) {
+  for (int8_t indexBitLength : {4, 11, 16}) {
+    DenseHll expected{indexBitLength, this->allocator_};
+    DenseHll denseHll{indexBitLength, this->allocator_};
+
+    std::vector<uint64_t> hashes;
+    for (int i = 0; i < 100'000; i++) {
+      hashes.push_back(hashOne(i));
+      expected.insertHash(hashes.back());
+      // Insert in batches of different sizes.
+      if (hashes.size() >= 1 + static_cast<size_t>(i % 200)) {
+        denseHll.insertHashes(hashes.data(), hashes.size());
+        hashes.clear();
+      }
+    }
+    denseHll.insertHashes(hashes.data(), hashes.size());
+
+    ASSERT_EQ(expected.cardinality(), denseHll.cardinality());
+    ASSERT_EQ(this->serialize(expected), this->serialize(denseHll));
+  }
+}
+
 namespace {
 template <typename T>
 std::vector<T> sequence(T start, T end) {
@@ -16,6 +16,7 @@
 
 #include <glog/logging.h>
 #include <atomic>
+#include <cmath>
 #include <utility>
 
 #include "velox/common/io/IoStatistics.h"
@@ -108,6 +109,114 @@ IoStatistics::operationStats() const {
   return operationStats_;
 }
 
+std::string_view toString(IoSource source) {
+  switch (source) {
+    case IoSource::kLocal:
+      return "local";
+    case IoSource::kS3:
+      return "s3";
+    case IoSource::kGcs:
+      return "gcs";
+    case IoSource::kAbfs:
+      return "abfs";
+    case IoSource::kHdfs:
+      return "hdfs";
+    case IoSource::kSsdCache:
+      return "ssd_cache";
+    case IoSource::kOther:
+      return "other";
+  }
+  return "unknown";
+}
+
+IoSource ioSourceOf(std::string_view path) {
+  const auto schemeEnd = path.find("://");
+  if (schemeEnd == std::string_view::npos) {
+    return IoSource::kLocal;
+  }
+  const auto scheme = path.substr(0, schemeEnd);
+  if (scheme == "file") {
+    return IoSource::kLocal;
+  }
+  if (scheme == "s3" || scheme == "s3a" || scheme == "s3n" ||
+      scheme == "oss" || scheme == "cos" || scheme == "cosn") {
+    return IoSource::kS3;
+  }
+  if (scheme == "gs") {
+    return IoSource::kGcs;
+  }
+  if (scheme == "abfs" || scheme == "abfss") {
+    return IoSource::kAbfs;
+  }
+  if (scheme == "hdfs" || scheme == "viewfs") {
+    return IoSource::kHdfs;
+  }
+  return IoSource::kOther;
+}
+
+std::string_view toString(IoPurpose purpose) {
+  switch (purpose) {
+    case IoPurpose::kFooter:
+      return "footer";
+    case IoPurpose::kData:
+      return "data";
+    case IoPurpose::kIndex:
+      return "index";
+    case IoPurpose::kSpill:
+      return "spill";
+    case IoPurpose::kOther:
+      return "other";
+  }
+  return "unknown";
+}
+
+std::optional<IoPurpose> ioPurposeOf(std::string_view name) {
+  for (auto i = 0; i < kNumIoPurposes; ++i) {
+    const auto purpose = static_cast<IoPurpose>(i);
+    if (name == toString(purpose)) {
+      return purpose;
+    }
+  }
+  return std::nullopt;
+}
+
+uint64_t IoHistogram::percentile(double percentile) const {
+  const auto count = counter_.count();
+  if (count == 0) {
+    return 0;
+  }
+  const auto rank = std::max<uint64_t>(1, std::ceil(count * percentile / 100));
+  uint64_t seen = 0;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    seen += bucketCount(i);
+    if (seen >= rank) {
+      const uint64_t upperBound =
+          i == 0 ? 0 : (i == 64 ? ~0ULL : (1ULL << i) - 1);
+      return std::min(upperBound, counter_.max());
+    }
+  }
+  return counter_.max();
+}
+
+void IoHistogram::merge(const IoHistogram& other) {
+  counter_.merge(other.counter_);
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    buckets_[i].fetch_add(other.bucketCount(i), std::memory_order_relaxed);
+  }
+}
+
+IoLatencyStats& IoLatencyStats::global() {
+  static IoLatencyStats stats;
+  return stats;
+}
+
+void IoLatencyStats::merge(const IoLatencyStats& other) {
+  for (auto i = 0; i < histograms_.size(); ++i) {
+    histograms_[i].latencyMicros.merge(other.histograms_[i].latencyMicros);
+    histograms_[i].bytes.merge(other.histograms_[i].bytes);
+  }
+}
+
 void IoStatistics::merge(const IoStatistics& other) {
   rawBytesRead_ += other.rawBytesRead_;
   rawBytesWritten_ += other.rawBytesWritten_;
@@ -119,6 +228,9 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  coalesceDistance_.merge(other.coalesceDistance_);
+  splitPreloadDepth_.merge(other.splitPreloadDepth_);
+  ioLatency_.merge(other.ioLatency_);
   {
     const auto& otherOperationStats = other.operationStats();
     std::lock_guard<std::mutex> l(operationStatsMutex_);
@@ -16,12 +16,16 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
+#include <fmt/format.h>
 #include <folly/dynamic.h>
 
 namespace facebook::velox::io {
@@ -107,6 +111,122 @@ class IoCounter {
   std::atomic<uint64_t> max_{0};
 };
 
+/// The storage an IO goes to.
+enum class IoSource : uint8_t {
+  kLocal,
+  kS3,
+  kGcs,
+  kAbfs,
+  kHdfs,
+  kSsdCache,
+  kOther,
+};
+
+inline constexpr int32_t kNumIoSources = 7;
+
+std::string_view toString(IoSource source);
+
+/// Returns the storage of the file at 'path' from its scheme. Paths without a
+/// scheme are local.
+IoSource ioSourceOf(std::string_view path);
+
+/// What an IO reads or writes.
+enum class IoPurpose : uint8_t {
+  kFooter,
+  kData,
+  kIndex,
+  kSpill,
+  kOther,
+};
+
+inline constexpr int32_t kNumIoPurposes = 5;
+
+std::string_view toString(IoPurpose purpose);
+
+/// Returns the purpose named 'name', e.g. "footer", or std::nullopt if
+/// 'name' is not the name of a purpose.
+std::optional<IoPurpose> ioPurposeOf(std::string_view name);
+
+/// A distribution of values in power of two buckets, e.g. IO latencies in
+/// microseconds or IO sizes in bytes. Thread-safe.
+class IoHistogram {
+ public:
+  /// Bucket 0 counts the zero values and bucket i > 0 counts the values in
+  /// [2^(i-1), 2^i).
+  static constexpr int32_t kNumBuckets = 65;
+
+  void record(uint64_t value) {
+    counter_.increment(value);
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const IoCounter& counter() const {
+    return counter_;
+  }
+
+  uint64_t bucketCount(int32_t bucket) const {
+    return buckets_[bucket].load(std::memory_order_relaxed);
+  }
+
+  /// Returns the upper bound of the bucket containing the value at
+  /// 'percentile', between 0 and 100, capped by the max recorded value.
+  /// Returns 0 if no value is recorded.
+  uint64_t percentile(double percentile) const;
+
+  void merge(const IoHistogram& other);
+
+ private:
+  static int32_t bucketIndex(uint64_t value) {
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+  }
+
+  IoCounter counter_;
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+};
+
+/// The latency and size distributions of IOs per storage and purpose.
+class IoLatencyStats {
+ public:
+  struct Histograms {
+    IoHistogram latencyMicros;
+    IoHistogram bytes;
+  };
+
+  /// Returns the process-wide distributions of all the IOs.
+  static IoLatencyStats& global();
+
+  void record(
+      IoSource source,
+      IoPurpose purpose,
+      uint64_t latencyMicros,
+      uint64_t bytes) {
+    auto& histograms = histograms_[index(source, purpose)];
+    histograms.latencyMicros.record(latencyMicros);
+    histograms.bytes.record(bytes);
+  }
+
+  const Histograms& histograms(IoSource source, IoPurpose purpose) const {
+    return histograms_[index(source, purpose)];
+  }
+
+  void merge(const IoLatencyStats& other);
+
+ private:
+  static int32_t index(IoSource source, IoPurpose purpose) {
+    return static_cast<int32_t>(source) * kNumIoPurposes +
+        static_cast<int32_t>(purpose);
+  }
+
+  std::array<Histograms, kNumIoSources * kNumIoPurposes> histograms_;
+};
+
+/// Returns the name of the StatsReporter metric of 'source' and 'purpose'
+/// under 'prefix', e.g. "velox.io_latency_us.s3.data".
+inline std::string
+ioMetricKey(std::string_view prefix, IoSource source, IoPurpose purpose) {
+  return fmt::format("{}.{}.{}", prefix, toString(source), toString(purpose));
+}
+
 class IoStatistics {
  public:
   uint64_t rawBytesRead() const;
@@ -145,6 +265,18 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& coalesceDistance() {
+    return coalesceDistance_;
+  }
+
+  IoCounter& splitPreloadDepth() {
+    return splitPreloadDepth_;
+  }
+
+  IoLatencyStats& ioLatency() {
+    return ioLatency_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -189,6 +321,17 @@ class IoStatistics {
   // or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Max coalesce distance in bytes chosen by the adaptive IO planner, one
+  // sample per planned load batch.
+  IoCounter coalesceDistance_;
+
+  // Number of splits to preload per driver chosen by the adaptive IO planner,
+  // one sample per split.
+  IoCounter splitPreloadDepth_;
+
+  // Latency and size distributions of the storage and SSD cache reads.
+  IoLatencyStats ioLatency_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
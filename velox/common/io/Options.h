@@ -104,6 +104,13 @@ class ReaderOptions {
     return *this;
   }
 
+  /// Enables tuning the coalesce distance from the storage latency and
+  /// bandwidth observed by dwio::common::AdaptiveIoPlanner.
+  ReaderOptions& setAdaptiveIoPlanning(bool enabled) {
+    adaptiveIoPlanning_ = enabled;
+    return *this;
+  }
+
   /// Modifies the number of row groups to prefetch.
   ReaderOptions& setPrefetchRowGroups(int32_t numPrefetch) {
     prefetchRowGroups_ = numPrefetch;
@@ -139,6 +146,10 @@ class ReaderOptions {
     return prefetchRowGroups_;
   }
 
+  bool adaptiveIoPlanning() const {
+    return adaptiveIoPlanning_;
+  }
+
   bool noCacheRetention() const {
     return noCacheRetention_;
   }
@@ -155,6 +166,7 @@ class ReaderOptions {
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
+  bool adaptiveIoPlanning_{false};
   bool noCacheRetention_{false};
 };
 } // namespace facebook::velox::io
@@ -190,6 +190,35 @@ bool ArbitrationParticipant::checkCapacityGrowth(uint64_t requestBytes) const {
   return maxGrowCapacity() >= requestBytes;
 }
 
+void ArbitrationParticipant::sampleUsage(uint64_t nowNs) {
+  const uint64_t usedBytes = pool_->reservedBytes();
+  std::lock_guard<std::mutex> l(stateLock_);
+  if (lastUsageSampleTimeNs_ != 0 && nowNs > lastUsageSampleTimeNs_) {
+    const double growthBytes = usedBytes > lastUsageSampleBytes_
+        ? usedBytes - lastUsageSampleBytes_
+        : 0;
+    const double rate = growthBytes * 1'000'000'000 /
+        (nowNs - lastUsageSampleTimeNs_);
+    usageGrowthRate_ = kUsageGrowthRateSmoothing * rate +
+        (1 - kUsageGrowthRateSmoothing) * usageGrowthRate_;
+  }
+  lastUsageSampleTimeNs_ = nowNs;
+  lastUsageSampleBytes_ = usedBytes;
+}
+
+double ArbitrationParticipant::usageGrowthRate() const {
+  std::lock_guard<std::mutex> l(stateLock_);
+  return usageGrowthRate_;
+}
+
+uint64_t ArbitrationParticipant::predictGrowCapacity(uint64_t horizonNs) const {
+  const uint64_t capacity = pool_->capacity();
+  const uint64_t predictedBytes = std::min<uint64_t>(
+      maxCapacity_,
+      pool_->reservedBytes() + usageGrowthRate() * horizonNs / 1'000'000'000);
+  return predictedBytes > capacity ? predictedBytes - capacity : 0;
+}
+
 void ArbitrationParticipant::getGrowTargets(
     uint64_t requestBytes,
     uint64_t& maxGrowBytes,
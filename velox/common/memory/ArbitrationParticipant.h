@@ -213,6 +213,20 @@ class ArbitrationParticipant
   /// capacity under the max capacity limit.
   bool checkCapacityGrowth(uint64_t requestBytes) const;
 
+  /// Records the memory usage of the query memory pool at 'nowNs' and updates
+  /// the smoothed usage growth rate from the previous sample. Invoked
+  /// periodically by the arbitrator to forecast the memory demand.
+  void sampleUsage(uint64_t nowNs);
+
+  /// Returns the smoothed usage growth rate in bytes per second measured by
+  /// sampleUsage(). Shrinking usage counts as no growth.
+  double usageGrowthRate() const;
+
+  /// Returns the capacity the query memory pool is predicted to need beyond
+  /// its current capacity after 'horizonNs' if its usage keeps growing at
+  /// usageGrowthRate(). The prediction is capped by the max capacity.
+  uint64_t predictGrowCapacity(uint64_t horizonNs) const;
+
   /// Invoked to grow the query memory pool capacity by 'growBytes' and commit
   /// used reservation by 'reservationBytes'. The function throws if the growth
   /// fails.
@@ -326,6 +340,9 @@ class ArbitrationParticipant
 
   uint64_t shrinkLocked(bool reclaimAll);
 
+  // The weight of the latest sample in the smoothed usage growth rate.
+  static constexpr double kUsageGrowthRateSmoothing{0.5};
+
   const uint64_t id_;
   const std::weak_ptr<MemoryPool> poolWeakPtr_;
   MemoryPool* const pool_;
@@ -336,6 +353,12 @@ class ArbitrationParticipant
   mutable std::mutex stateLock_;
   bool aborted_{false};
 
+  // The time and memory usage of the last sampleUsage() call, and the smoothed
+  // usage growth rate in bytes per second.
+  uint64_t lastUsageSampleTimeNs_{0};
+  uint64_t lastUsageSampleBytes_{0};
+  double usageGrowthRate_{0};
+
   // Points to the current running arbitration operation on this participant.
   ArbitrationOperation* runningOp_{nullptr};
 
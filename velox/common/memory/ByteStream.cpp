@@ -304,7 +304,8 @@ void ByteOutputStream::flush(OutputStream* out) {
     if (isBits_ && isReverseBitOrder_ && !isReversed_) {
       bits::reverseBits(ranges_[i].buffer, bytes);
     }
-    out->write(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
+    out->writeFromArena(
+        reinterpret_cast<char*>(ranges_[i].buffer), bytes, arena_);
   }
   if (isBits_ && isNegateBits_) {
     isNegated_ = true;
@@ -432,33 +433,93 @@ void freeFunc(void* /*data*/, void* userData) {
 }
 } // namespace
 
+void IOBufOutputStream::writeFromArena(
+    const char* s,
+    std::streamsize count,
+    const StreamArena* arena) {
+  if (arena == nullptr || arena != referenceableArena_ ||
+      count < kMinReferencedBytes) {
+    write(s, count);
+    return;
+  }
+  referencedRanges_.push_back({out_->tellp(), s, count});
+  if (listener_) {
+    listener_->onWrite(s, count);
+  }
+}
+
 std::unique_ptr<folly::IOBuf> IOBufOutputStream::getIOBuf(
     const std::function<void()>& releaseFn) {
-  // Make an IOBuf for each range. The IOBufs keep shared ownership of
-  // 'arena_'.
+  // Make an IOBuf for each range and each referenced range in between. The
+  // IOBufs keep shared ownership of 'arena_' or 'referencedArena_'.
   std::unique_ptr<folly::IOBuf> iobuf;
-  auto& ranges = out_->ranges();
-  for (auto& range : ranges) {
-    auto numValues =
-        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
-    auto userData = newFreeData(arena_, releaseFn);
+  auto append = [&](const char* data,
+                    int64_t size,
+                    const std::shared_ptr<StreamArena>& arena) {
+    if (size == 0) {
+      return;
+    }
+    auto userData = newFreeData(arena, releaseFn);
     auto newBuf = folly::IOBuf::takeOwnership(
-        reinterpret_cast<char*>(range.buffer), numValues, freeFunc, userData);
+        const_cast<char*>(data), size, freeFunc, userData);
     if (iobuf) {
       iobuf->prev()->appendChain(std::move(newBuf));
     } else {
       iobuf = std::move(newBuf);
     }
+  };
+  auto& ranges = out_->ranges();
+  int64_t rangeStart = 0;
+  size_t nextReferenced = 0;
+  for (auto& range : ranges) {
+    const auto* data = reinterpret_cast<const char*>(range.buffer);
+    const int64_t rangeEnd = rangeStart +
+        (&range == &ranges.back() ? out_->lastRangeEnd() : range.size);
+    int64_t offset = rangeStart;
+    while (nextReferenced < referencedRanges_.size() &&
+           referencedRanges_[nextReferenced].position <= rangeEnd) {
+      const auto& referenced = referencedRanges_[nextReferenced++];
+      append(
+          data + offset - rangeStart, referenced.position - offset, arena_);
+      append(referenced.data, referenced.size, referencedArena_);
+      offset = referenced.position;
+    }
+    append(data + offset - rangeStart, rangeEnd - offset, arena_);
+    rangeStart += range.size;
   }
+  VELOX_CHECK_EQ(nextReferenced, referencedRanges_.size());
   return iobuf;
 }
 
 std::streampos IOBufOutputStream::tellp() const {
-  return out_->tellp();
+  const int64_t position = out_->tellp();
+  int64_t referencedBytes = 0;
+  for (const auto& referenced : referencedRanges_) {
+    if (referenced.position > position) {
+      break;
+    }
+    referencedBytes += referenced.size;
+  }
+  return position + referencedBytes;
 }
 
 void IOBufOutputStream::seekp(std::streampos pos) {
-  out_->seekp(pos);
+  // Maps 'pos' to the position in 'out_' by skipping the referenced bytes
+  // before it.
+  const int64_t target = pos;
+  int64_t position = target;
+  for (const auto& referenced : referencedRanges_) {
+    const int64_t start = referenced.position + (target - position);
+    if (target < start) {
+      break;
+    }
+    VELOX_CHECK_GE(
+        target,
+        start + referenced.size,
+        "Cannot seek into referenced bytes of IOBufOutputStream");
+    position -= referenced.size;
+  }
+  out_->seekp(position);
 }
 
 } // namespace facebook::velox
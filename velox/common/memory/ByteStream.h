@@ -59,6 +59,16 @@ class OutputStream {
 
   virtual void write(const char* s, std::streamsize count) = 0;
 
+  /// Writes 'count' bytes at 's' that are held by 'arena'. Streams that can
+  /// keep the memory of 'arena' alive reference the bytes instead of copying
+  /// them.
+  virtual void writeFromArena(
+      const char* s,
+      std::streamsize count,
+      const StreamArena* /*arena*/) {
+    write(s, count);
+  }
+
   virtual std::streampos tellp() const = 0;
 
   virtual void seekp(std::streampos pos) = 0;
@@ -578,17 +588,56 @@ class IOBufOutputStream : public OutputStream {
     }
   }
 
+  void writeFromArena(
+      const char* s,
+      std::streamsize count,
+      const StreamArena* arena) override;
+
   std::streampos tellp() const override;
 
   void seekp(std::streampos pos) override;
 
+  /// Makes writes of at least kMinReferencedBytes held by 'source' reference
+  /// the bytes instead of copying them, so that the IOBufs returned by
+  /// getIOBuf() are a scatter-gather list over the memory of 'source'. The
+  /// caller moves the memory of 'source' to 'holder' with
+  /// StreamArena::transferTo() after the writes and before clearing
+  /// 'source'. The IOBufs keep 'holder' alive. The referenced bytes can not be
+  /// overwritten after seekp().
+  void referenceArena(
+      const StreamArena* source,
+      std::shared_ptr<StreamArena> holder) {
+    referenceableArena_ = source;
+    referencedArena_ = std::move(holder);
+  }
+
   /// 'releaseFn' is executed on iobuf destruction if not null.
   std::unique_ptr<folly::IOBuf> getIOBuf(
       const std::function<void()>& releaseFn = nullptr);
 
+  /// Smaller writes are copied, so that an IOBuf chain does not get many tiny
+  /// buffers.
+  static constexpr int64_t kMinReferencedBytes = 512;
+
  private:
+  // A run of referenced bytes that follows the bytes of 'out_' before
+  // 'position'.
+  struct ReferencedRange {
+    int64_t position;
+    const char* data;
+    int64_t size;
+  };
+
   std::shared_ptr<StreamArena> arena_;
   std::unique_ptr<ByteOutputStream> out_;
+
+  // The arena whose bytes are referenced and the arena that takes over its
+  // memory.
+  const StreamArena* referenceableArena_{nullptr};
+  std::shared_ptr<StreamArena> referencedArena_;
+
+  // Referenced bytes in order of position.
+  std::vector<ReferencedRange> referencedRanges_;
 };
 
 } // namespace facebook::velox
@@ -17,6 +17,8 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SimdUtil.h"
 
+#include <folly/container/F14Set.h>
+
 namespace facebook::velox {
 
 namespace {
@@ -52,6 +54,32 @@ void markAsFree(HashStringAllocator::Header* header) {
     *previousFreeSize(nextHeader) = header->size();
   }
 }
+
+// Calls 'func' with the header of every block, free or not, in the slabs of
+// 'pool'.
+template <typename Func>
+void forEachSlabBlock(const memory::AllocationPool& pool, Func func) {
+  static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
+  for (auto i = 0; i < pool.numRanges(); ++i) {
+    const auto range = pool.rangeAt(i);
+    const int64_t rangeSize = range.size();
+    for (int64_t blockOffset = 0; blockOffset < rangeSize;
+         blockOffset += kHugePageSize) {
+      auto* begin = range.data() + blockOffset;
+      const auto size =
+          std::min<int64_t>(rangeSize - blockOffset, kHugePageSize) -
+          simd::kPadding;
+      auto* end = HashStringAllocator::castToHeader(begin + size);
+      auto* header = HashStringAllocator::castToHeader(begin);
+      while (header != end) {
+        VELOX_CHECK_LT(
+            reinterpret_cast<char*>(header), reinterpret_cast<char*>(end));
+        func(header);
+        header = HashStringAllocator::castToHeader(header->end());
+      }
+    }
+  }
+}
 } // namespace
 
 std::string HashStringAllocator::Header::toString() {
@@ -677,6 +705,157 @@ std::string HashStringAllocator::toString() const {
   return out.str();
 }
 
+const HashStringAllocator::Relocations::Move*
+HashStringAllocator::Relocations::find(const char* ptr) const {
+  auto it = std::upper_bound(
+      moves_.begin(),
+      moves_.end(),
+      ptr,
+      [](const char* target, const Move& move) {
+        return target < move.oldBegin;
+      });
+  if (it == moves_.begin()) {
+    return nullptr;
+  }
+  --it;
+  // A pointer just past the payload is still a valid write position.
+  return ptr <= it->oldBegin + it->size ? &*it : nullptr;
+}
+
+char* HashStringAllocator::Relocations::relocate(const char* ptr) const {
+  const auto* move = find(ptr);
+  if (move == nullptr) {
+    return const_cast<char*>(ptr);
+  }
+  return move->newBegin + (ptr - move->oldBegin);
+}
+
+StringView HashStringAllocator::Relocations::relocate(StringView view) const {
+  if (view.isInline()) {
+    return view;
+  }
+  return StringView(relocate(view.data()), view.size());
+}
+
+HashStringAllocator::Header* HashStringAllocator::Relocations::relocate(
+    Header* header) const {
+  const auto* move = find(header->begin());
+  if (move == nullptr || move->oldBegin != header->begin()) {
+    return header;
+  }
+  return move->newHeader;
+}
+
+HashStringAllocator::Position HashStringAllocator::Relocations::relocate(
+    const Position& position) const {
+  if (!position.isSet()) {
+    return position;
+  }
+  return {relocate(position.header), relocate(position.position)};
+}
+
+int64_t HashStringAllocator::compact() {
+  VELOX_CHECK(canCompact(), "HashStringAllocator cannot be compacted");
+  const auto retainedBytes = retainedSize();
+
+  // Finds the live blocks in the slabs and the blocks that continue another
+  // block. The others are the first parts of the allocations to move.
+  std::vector<Header*> liveBlocks;
+  folly::F14FastSet<Header*> continuations;
+  int64_t liveSlabBytes = 0;
+  forEachSlabBlock(state_.pool(), [&](Header* header) {
+    if (header->isFree()) {
+      return;
+    }
+    liveBlocks.push_back(header);
+    liveSlabBytes += blockBytes(header);
+    if (header->isContinued()) {
+      continuations.insert(header->nextContinued());
+    }
+  });
+
+  // Copies each allocation into a single block. If this throws, 'compacted'
+  // frees the copies and 'this' is unchanged.
+  HashStringAllocator compacted(pool());
+  compacted.state_.pool().setHugePageThreshold(
+      state_.pool().hugePageThreshold());
+  Relocations relocations;
+  std::vector<Header*> continuationsFromPool;
+  for (auto* first : liveBlocks) {
+    if (continuations.contains(first)) {
+      continue;
+    }
+    int64_t size = 0;
+    for (auto* part = first;; part = part->nextContinued()) {
+      size += part->usableSize();
+      if (!part->isContinued()) {
+        break;
+      }
+    }
+    auto* header = compacted.allocate(std::max<int64_t>(size, kMinAlloc), true);
+    auto* destination = header->begin();
+    for (auto* part = first;; part = part->nextContinued()) {
+      const auto partSize = part->usableSize();
+      std::memcpy(destination, part->begin(), partSize);
+      relocations.moves_.push_back(
+          {part->begin(), partSize, header, destination});
+      destination += partSize;
+      if (part != first && state_.allocationsFromPool().contains(part)) {
+        continuationsFromPool.push_back(part);
+      }
+      if (!part->isContinued()) {
+        break;
+      }
+    }
+  }
+  std::sort(
+      relocations.moves_.begin(),
+      relocations.moves_.end(),
+      [](const Relocations::Move& left, const Relocations::Move& right) {
+        return left.oldBegin < right.oldBegin;
+      });
+
+  // Takes over the new slabs and leaves the old ones to 'compacted'.
+  const auto compactedSlabBytes =
+      compacted.state_.currentBytes() - compacted.state_.sizeFromPool();
+  state_.pool().swap(compacted.state_.pool());
+  for (const auto& [ptr, size] : compacted.state_.allocationsFromPool()) {
+    state_.allocationsFromPool()[ptr] = size;
+  }
+  state_.sizeFromPool() += compacted.state_.sizeFromPool();
+  compacted.state_.allocationsFromPool().clear();
+  compacted.state_.sizeFromPool() = 0;
+  compacted.state_.currentBytes() = liveSlabBytes;
+  state_.currentBytes() = compactedSlabBytes + state_.sizeFromPool();
+
+  // Rebuilds the free lists from the free blocks of the new slabs.
+  state_.numFree() = 0;
+  state_.freeBytes() = 0;
+  std::fill(
+      std::begin(state_.freeNonEmpty()), std::end(state_.freeNonEmpty()), 0);
+  for (auto i = 0; i < kNumFreeLists; ++i) {
+    new (&state_.freeLists()[i]) CompactDoubleList();
+  }
+  forEachSlabBlock(state_.pool(), [&](Header* header) {
+    if (!header->isFree()) {
+      return;
+    }
+    const auto index = freeListIndex(header->size());
+    bits::setBit(state_.freeNonEmpty(), index);
+    state_.freeLists()[index].insert(
+        reinterpret_cast<CompactDoubleList*>(header->begin()));
+    ++state_.numFree();
+    state_.freeBytes() += blockBytes(header);
+  });
+
+  for (auto* part : continuationsFromPool) {
+    freeToPool(part, blockBytes(part));
+  }
+  state_.relocationCallback()(relocations);
+  compacted.clear();
+  return retainedBytes - retainedSize();
+}
+
 int64_t HashStringAllocator::checkConsistency() const {
   static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
 
@@ -24,6 +24,8 @@
 
 #include <folly/container/F14Map.h>
 
+#include <functional>
+
 namespace facebook::velox {
 
 template <class T>
@@ -179,6 +181,54 @@ class HashStringAllocator : public StreamArena {
     }
   };
 
+  /// Maps the payload of the blocks moved by compact() to their new location.
+  /// A moved multipart allocation becomes a single contiguous block, so the
+  /// payload of each of its parts is mapped to an offset in that block.
+  class Relocations {
+   public:
+    /// Returns the new address of 'ptr' if it points into the payload of a
+    /// moved block. Otherwise returns 'ptr'.
+    char* relocate(const char* ptr) const;
+
+    /// Returns 'view' pointing to the moved copy of its data. Inline views and
+    /// views into blocks that were not moved are returned unchanged.
+    StringView relocate(StringView view) const;
+
+    /// Returns the position of the same payload byte in the moved copy.
+    Position relocate(const Position& position) const;
+
+    /// Returns the header of the block that holds the payload of 'header'
+    /// after the move, or 'header' if it was not moved.
+    Header* relocate(Header* header) const;
+
+    /// Returns the number of moved blocks, counting each part of a multipart
+    /// allocation.
+    size_t size() const {
+      return moves_.size();
+    }
+
+   private:
+    struct Move {
+      const char* oldBegin;
+      // Usable payload bytes of the old block.
+      int32_t size;
+      Header* newHeader;
+      char* newBegin;
+    };
+
+    // Returns the move whose old payload contains 'ptr' or nullptr.
+    const Move* find(const char* ptr) const;
+
+    // Sorted on 'oldBegin'.
+    std::vector<Move> moves_;
+
+    friend class HashStringAllocator;
+  };
+
+  /// Called by compact() after the live blocks have been copied. Must update
+  /// every pointer into the allocations of 'this' and must not throw.
+  using RelocationCallback = std::function<void(const Relocations&)>;
+
   explicit HashStringAllocator(memory::MemoryPool* pool)
       : StreamArena(pool), state_(pool) {}
 
@@ -337,6 +387,30 @@ class HashStringAllocator : public StreamArena {
 
   std::string toString() const;
 
+  /// Sets the callback that compact() uses to update the owners of the moved
+  /// blocks. Compaction is disabled while no callback is set.
+  void setRelocationCallback(RelocationCallback callback) {
+    state_.relocationCallback() = std::move(callback);
+  }
+
+  /// Returns true if compact() can be called, i.e. a relocation callback is
+  /// set and no write is in progress.
+  bool canCompact() const {
+    return state_.relocationCallback() != nullptr &&
+        state_.currentHeader() == nullptr && state_.pool().numRanges() > 0;
+  }
+
+  /// Copies the live blocks of the slabs into new, densely packed slabs and
+  /// frees the old ones, so that memory lost to fragmentation goes back to
+  /// pool(). Multipart allocations are coalesced into one block. The
+  /// relocation callback is then called to update the owners of the moved
+  /// blocks. Blocks from allocateFromPool() are not moved and must not be
+  /// continued into the slabs. The caller must guarantee that the callback
+  /// reaches every live block in the slabs, including blocks that back STL
+  /// containers via StlAllocator. Returns the number of bytes released from
+  /// retainedSize().
+  int64_t compact();
+
   /// Effectively makes this immutable while executing f, any attempt to access
   /// state_ in a mutable way while f is executing will cause an exception to be
   /// thrown.
@@ -494,6 +568,9 @@ class HashStringAllocator : public StreamArena {
     // Sum of sizes in 'allocationsFromPool_'.
     DECLARE_FIELD_WITH_INIT_VALUE(int64_t, sizeFromPool, 0);
 
+    // Updates the owners of blocks moved by compact().
+    DECLARE_FIELD(RelocationCallback, relocationCallback);
+
 #undef DECLARE_FIELD_WITH_INIT_VALUE
 #undef DECLARE_FIELD
 #undef DECLARE_GETTERS
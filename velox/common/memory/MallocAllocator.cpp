@@ -122,10 +122,12 @@ bool MallocAllocator::allocateContiguousWithoutRetry(
     MachinePageCount numPages,
     Allocation* collateral,
     ContiguousAllocation& allocation,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    bool hugePages) {
   bool result;
   stats_.recordAllocate(AllocationTraits::pageBytes(numPages), 1, [&]() {
-    result = allocateContiguousImpl(numPages, collateral, allocation, maxPages);
+    result = allocateContiguousImpl(
+        numPages, collateral, allocation, maxPages, hugePages);
   });
   return result;
 }
@@ -134,7 +136,8 @@ bool MallocAllocator::allocateContiguousImpl(
     MachinePageCount numPages,
     Allocation* collateral,
     ContiguousAllocation& allocation,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    bool hugePages) {
   if (maxPages == 0) {
     maxPages = numPages;
   } else {
@@ -175,13 +178,7 @@ bool MallocAllocator::allocateContiguousImpl(
   numAllocated_.fetch_add(numPages);
   numMapped_.fetch_add(numPages);
   numExternalMapped_.fetch_add(numPages);
-  void* data = ::mmap(
-      nullptr,
-      AllocationTraits::pageBytes(maxPages),
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
+  void* data = mapContiguous(AllocationTraits::pageBytes(maxPages), hugePages);
   // TODO: add handling of MAP_FAILED.
   allocation.set(
       data,
@@ -94,13 +94,15 @@ class MallocAllocator : public MemoryAllocator {
       MachinePageCount numPages,
       Allocation* collateral,
       ContiguousAllocation& allocation,
-      MachinePageCount maxPages = 0) override;
+      MachinePageCount maxPages = 0,
+      bool hugePages = false) override;
 
   bool allocateContiguousImpl(
       MachinePageCount numPages,
       Allocation* collateral,
       ContiguousAllocation& allocation,
-      MachinePageCount maxPages);
+      MachinePageCount maxPages,
+      bool hugePages);
 
   void freeContiguousImpl(ContiguousAllocation& allocation);
 
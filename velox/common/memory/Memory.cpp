@@ -52,6 +52,8 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.largestSizeClass = options.largestSizeClassPages;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numNumaNodes = options.numNumaNodes;
+    mmapOptions.backgroundTrim = options.mmapBackgroundTrim;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -140,6 +142,8 @@ MemoryManager::MemoryManager(const MemoryManager::Options& options)
       checkUsageLeak_(options.checkUsageLeak),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
       disableMemoryPoolTracking_(options.disableMemoryPoolTracking),
+      leafReservationCacheBytes_(options.leafReservationCacheBytes),
+      leafSmallAllocationCacheBytes_(options.leafSmallAllocationCacheBytes),
       getPreferredSize_(options.getPreferredSize),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       sysRoot_{std::make_shared<MemoryPoolImpl>(
@@ -156,7 +160,9 @@ MemoryManager::MemoryManager(const MemoryManager::Options& options)
               .trackUsage = options.trackDefaultUsage,
               .coreOnAllocationFailureEnabled =
                   options.coreOnAllocationFailureEnabled,
-              .getPreferredSize = getPreferredSize_})},
+              .getPreferredSize = getPreferredSize_,
+              .reservationCacheBytes = leafReservationCacheBytes_,
+              .smallAllocationCacheBytes = leafSmallAllocationCacheBytes_})},
       spillPool_{addLeafPool("__sys_spilling__")},
       cachePool_{addLeafPool("__sys_caching__")},
       tracePool_{addLeafPool("__sys_tracing__")},
@@ -280,7 +286,8 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
     const std::string& name,
     int64_t maxCapacity,
     std::unique_ptr<MemoryReclaimer> reclaimer,
-    const std::optional<MemoryPool::DebugOptions>& poolDebugOpts) {
+    const std::optional<MemoryPool::DebugOptions>& poolDebugOpts,
+    int32_t numaNode) {
   std::string poolName = name;
   if (poolName.empty()) {
     static std::atomic<int64_t> poolId{0};
@@ -294,6 +301,9 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
   options.getPreferredSize = getPreferredSize_;
   options.debugOptions = poolDebugOpts;
+  options.numaNode = numaNode;
+  options.reservationCacheBytes = leafReservationCacheBytes_;
+  options.smallAllocationCacheBytes = leafSmallAllocationCacheBytes_;
 
   auto pool = createRootPool(poolName, reclaimer, options);
   if (!disableMemoryPoolTracking_) {
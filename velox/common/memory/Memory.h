@@ -84,6 +84,18 @@ class MemoryManager {
     /// Disables the memory manager's tracking on memory pools.
     bool disableMemoryPoolTracking{false};
 
+    /// If non-zero, thread-safe leaf memory pools cache up to this many
+    /// reserved bytes per shard of calling threads to serve small reservations
+    /// without taking the pool mutex. See
+    /// MemoryPool::Options::reservationCacheBytes.
+    int64_t leafReservationCacheBytes{0};
+
+    /// If non-zero, leaf memory pools cache up to this many bytes of freed
+    /// small allocations per shard of calling threads to serve later small
+    /// allocations without going to the memory allocator. See
+    /// MemoryPool::Options::smallAllocationCacheBytes.
+    int64_t leafSmallAllocationCacheBytes{0};
+
     /// ================== 'MemoryAllocator' settings ==================
 
     /// Specifies the max memory allocation capacity in bytes enforced by
@@ -112,6 +124,18 @@ class MemoryManager {
     /// NOTE: this only applies for MmapAllocator.
     int32_t mmapArenaCapacityRatio{10};
 
+    /// Number of NUMA nodes with their own memory in MmapAllocator. See
+    /// MmapAllocator::Options::numNumaNodes.
+    ///
+    /// NOTE: this only applies for MmapAllocator.
+    int32_t numNumaNodes{1};
+
+    /// If true, MmapAllocator returns free memory to the system from a
+    /// background thread. See MmapAllocator::Options::backgroundTrim.
+    ///
+    /// NOTE: this only applies for MmapAllocator.
+    bool mmapBackgroundTrim{false};
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
     /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will
@@ -209,13 +233,15 @@ class MemoryManager {
 
   /// Creates a root memory pool with specified 'name' and 'maxCapacity'. If
   /// 'name' is missing, the memory manager generates a default name internally
-  /// to ensure uniqueness.
+  /// to ensure uniqueness. If 'numaNode' is not kNoNumaNode, the memory of the
+  /// pool and its children is placed on that NUMA node.
   std::shared_ptr<MemoryPool> addRootPool(
       const std::string& name = "",
       int64_t maxCapacity = kMaxMemory,
       std::unique_ptr<MemoryReclaimer> reclaimer = nullptr,
       const std::optional<MemoryPool::DebugOptions>& poolDebugOpts =
-          std::nullopt);
+          std::nullopt,
+      int32_t numaNode = kNoNumaNode);
 
   /// Creates a leaf memory pool for direct memory allocation use with specified
   /// 'name'. If 'name' is missing, the memory manager generates a default name
@@ -310,6 +336,8 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool coreOnAllocationFailureEnabled_;
   const bool disableMemoryPoolTracking_;
+  const int64_t leafReservationCacheBytes_;
+  const int64_t leafSmallAllocationCacheBytes_;
   const std::function<size_t(size_t)> getPreferredSize_;
 
   // The destruction callback set for the allocated root memory pools which are
@@ -236,7 +236,8 @@ bool MemoryAllocator::allocateContiguous(
     Allocation* collateral,
     ContiguousAllocation& allocation,
     ReservationCallback reservationCB,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    bool hugePages) {
   const MachinePageCount numCollateralPages =
       allocation.numPages() + (collateral ? collateral->numPages() : 0);
   const uint64_t totalCollateralBytes =
@@ -281,14 +282,14 @@ bool MemoryAllocator::allocateContiguous(
   bool success = false;
   if (cache() == nullptr) {
     success = allocateContiguousWithoutRetry(
-        numPages, collateral, allocation, maxPages);
+        numPages, collateral, allocation, maxPages, hugePages);
   } else {
     success = cache()->makeSpace(
         pagesToAcquire(numPages, numCollateralPages),
         [&](Allocation& acquired) {
           freeNonContiguous(acquired);
           return allocateContiguousWithoutRetry(
-              numPages, collateral, allocation, maxPages);
+              numPages, collateral, allocation, maxPages, hugePages);
         });
   }
 
@@ -372,6 +373,14 @@ Stats Stats::operator-(const Stats& other) const {
     result.sizes[i] = sizes[i] - other.sizes[i];
   }
   result.numAdvise = numAdvise - other.numAdvise;
+  result.numBackgroundTrims = numBackgroundTrims - other.numBackgroundTrims;
+  result.numBackgroundTrimmedPages =
+      numBackgroundTrimmedPages - other.numBackgroundTrimmedPages;
+  result.numHugePageAllocations =
+      numHugePageAllocations - other.numHugePageAllocations;
+  result.hugePageBytes = hugePageBytes - other.hugePageBytes;
+  result.numHugePageFallbacks =
+      numHugePageFallbacks - other.numHugePageFallbacks;
   return result;
 }
 
@@ -386,11 +395,16 @@ std::string Stats::toString() const {
     totalAllocations += sizes[i].numAllocations;
   }
   out << fmt::format(
-      "Alloc: {}MB {} Gigaclocks Allocations={}, advised={} MB\n",
+      "Alloc: {}MB {} Gigaclocks Allocations={}, advised={} MB, background "
+      "trimmed={} MB, huge page allocations={} {}MB fallbacks={}\n",
       totalBytes >> 20,
       totalClocks >> 30,
       totalAllocations,
-      numAdvise >> 8);
+      numAdvise >> 8,
+      numBackgroundTrimmedPages >> 8,
+      numHugePageAllocations,
+      hugePageBytes >> 20,
+      numHugePageFallbacks);
 
   // Sort the size classes by decreasing clocks.
   std::vector<int32_t> indices(sizes.size());
@@ -435,6 +449,44 @@ void MemoryAllocator::useHugePages(
 #endif
 }
 
+void* MemoryAllocator::mapContiguous(uint64_t bytes, bool hugePages) {
+  constexpr auto kHugePageSize = AllocationTraits::kHugePageSize;
+  if (!hugePages || bytes < kHugePageSize) {
+    return ::mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+  }
+  // Maps an extra huge page worth and trims the unaligned head and tail.
+  const auto mappedBytes = bytes + kHugePageSize - AllocationTraits::kPageSize;
+  auto* mapped = reinterpret_cast<char*>(::mmap(
+      nullptr,
+      mappedBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0));
+  if (mapped == MAP_FAILED) {
+    ++numHugePageFallbacks_;
+    return mapContiguous(bytes, false);
+  }
+  auto* aligned = reinterpret_cast<char*>(
+      bits::roundUp(reinterpret_cast<uint64_t>(mapped), kHugePageSize));
+  if (aligned > mapped) {
+    ::munmap(mapped, aligned - mapped);
+  }
+  const auto tailBytes = (mapped + mappedBytes) - (aligned + bytes);
+  if (tailBytes > 0) {
+    ::munmap(aligned + bytes, tailBytes);
+  }
+  ++numHugePageAllocations_;
+  hugePageBytes_ += bytes;
+  return aligned;
+}
+
 void MemoryAllocator::setAllocatorFailureMessage(std::string message) {
   allocatorFailureMessage() = std::move(message);
 }
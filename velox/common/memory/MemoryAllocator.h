@@ -136,6 +136,21 @@ struct Stats {
 
   /// Cumulative count of pages advised away, if the allocator exposes this.
   int64_t numAdvise{0};
+
+  /// Cumulative count of the rounds of background trimming that advised pages
+  /// away and of the pages they advised away. The pages are included in
+  /// 'numAdvise'.
+  int64_t numBackgroundTrims{0};
+  int64_t numBackgroundTrimmedPages{0};
+
+  /// Cumulative count and bytes of the contiguous allocations mapped at huge
+  /// page boundaries on request. See MemoryAllocator::allocateContiguous().
+  int64_t numHugePageAllocations{0};
+  int64_t hugePageBytes{0};
+
+  /// Cumulative count of the huge page requests that got standard pages
+  /// because the aligned mapping failed.
+  int64_t numHugePageFallbacks{0};
 };
 
 class MemoryAllocator;
@@ -276,12 +291,19 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   /// huge pages without declaring the whole range as held by the query. The
   /// reservation will be increased as and if addresses in the range are used.
   /// See growContiguous().
+  ///
+  /// If 'hugePages' is true and the address range is at least
+  /// AllocationTraits::kHugePageSize, the range is mapped at a huge page
+  /// boundary so that all of it can be backed by transparent huge pages. This
+  /// is for large randomly accessed memory like hash tables where TLB misses
+  /// dominate. Falls back to standard pages if the aligned mapping fails.
   bool allocateContiguous(
       MachinePageCount numPages,
       Allocation* collateral,
       ContiguousAllocation& allocation,
       ReservationCallback reservationCB = nullptr,
-      MachinePageCount maxPages = 0);
+      MachinePageCount maxPages = 0,
+      bool hugePages = false);
 
   /// Frees contiguous 'allocation'. 'allocation' is empty on return.
   virtual void freeContiguous(ContiguousAllocation& allocation) = 0;
@@ -344,7 +366,11 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   virtual MachinePageCount numExternalMapped() const = 0;
 
   virtual Stats stats() const {
-    return stats_;
+    auto stats = stats_;
+    stats.numHugePageAllocations = numHugePageAllocations_;
+    stats.hugePageBytes = hugePageBytes_;
+    stats.numHugePageFallbacks = numHugePageFallbacks_;
+    return stats;
   }
 
   virtual std::string toString() const = 0;
@@ -439,7 +465,8 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
       MachinePageCount numPages,
       Allocation* collateral,
       ContiguousAllocation& allocation,
-      MachinePageCount maxPages = 0) = 0;
+      MachinePageCount maxPages = 0,
+      bool hugePages = false) = 0;
 
   virtual bool allocateNonContiguousWithoutRetry(
       const SizeMix& sizeMix,
@@ -486,6 +513,11 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // for the address range.
   void useHugePages(const ContiguousAllocation& data, bool enable);
 
+  // Maps 'bytes' of anonymous memory for a contiguous allocation. If
+  // 'hugePages' is true and 'bytes' is at least a huge page, the mapping starts
+  // at a huge page boundary. Returns MAP_FAILED on failure.
+  void* mapContiguous(uint64_t bytes, bool hugePages);
+
   // The machine page counts corresponding to different sizes in order
   // of increasing size.
   const std::vector<MachinePageCount>
@@ -519,6 +551,10 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   bool isPersistentFailureInjection_{false};
 
   Stats stats_;
+
+  std::atomic<int64_t> numHugePageAllocations_{0};
+  std::atomic<int64_t> hugePageBytes_{0};
+  std::atomic<int64_t> numHugePageFallbacks_{0};
 };
 
 std::ostream& operator<<(std::ostream& out, const MemoryAllocator::Kind& kind);
@@ -17,6 +17,7 @@
 #include "velox/common/memory/MemoryPool.h"
 
 #include <signal.h>
+#include <thread>
 
 #include "velox/common/Casts.h"
 #include "velox/common/base/Counters.h"
@@ -100,6 +101,18 @@ using MemoryUsageHeap =
 
 static constexpr size_t kCapMessageIndentSize = 4;
 
+// Returns the reservation shard of the calling thread out of 'numShards' which
+// is a power of 2.
+FOLLY_ALWAYS_INLINE size_t reservationShardIndex(size_t numShards) {
+  const size_t hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  return hash & (numShards - 1);
+}
+
+// Returns the index of the small allocation size class of 'classSize'.
+FOLLY_ALWAYS_INLINE int32_t smallSizeClass(int64_t classSize) {
+  return __builtin_ctzll(classSize / MemoryPoolImpl::kMinSmallAllocationSize);
+}
+
 std::vector<MemoryUsage> sortMemoryUsages(MemoryUsageHeap& heap) {
   std::vector<MemoryUsage> usages;
   usages.reserve(heap.size());
@@ -228,6 +241,9 @@ MemoryPool::MemoryPool(
       threadSafe_(options.threadSafe),
       debugOptions_(options.debugOptions),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      numaNode_(options.numaNode),
+      reservationCacheBytes_(options.reservationCacheBytes),
+      smallAllocationCacheBytes_(options.smallAllocationCacheBytes),
       getPreferredSize_(
           options.getPreferredSize == nullptr
               ? [](size_t size) { return MemoryPool::getPreferredSize(size); }
@@ -235,6 +251,8 @@ MemoryPool::MemoryPool(
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
+  VELOX_CHECK_GE(reservationCacheBytes_, 0);
+  VELOX_CHECK_GE(smallAllocationCacheBytes_, 0);
   VELOX_CHECK_NOT_NULL(getPreferredSize_);
   MemoryAllocator::alignmentCheck(0, alignment_);
 }
@@ -443,6 +461,16 @@ MemoryPoolImpl::MemoryPoolImpl(
       manager_{memoryManager},
       allocator_{manager_->allocator()},
       arbitrator_{manager_->arbitrator()},
+      reservationShards_(
+          isLeaf() && options.threadSafe && options.trackUsage &&
+                  options.reservationCacheBytes > 0
+              ? std::make_unique<ReservationShard[]>(kNumReservationShards)
+              : nullptr),
+      smallAllocationShards_(
+          isLeaf() && options.trackUsage &&
+                  options.smallAllocationCacheBytes > 0
+              ? std::make_unique<SmallAllocationShard[]>(kNumReservationShards)
+              : nullptr),
       reclaimer_(std::move(reclaimer)),
       // The memory manager sets the capacity through grow() according to the
       // actually used memory arbitration policy.
@@ -457,6 +485,12 @@ MemoryPoolImpl::~MemoryPoolImpl() {
   }
 
   if (isLeaf()) {
+    if (smallAllocationShards_ != nullptr) {
+      releaseSmallAllocationCache();
+    }
+    if (reservationShards_ != nullptr) {
+      releaseReservationCache();
+    }
     if (usedReservationBytes_ > 0) {
       VELOX_MEM_LOG(ERROR) << "Memory leak (Used memory): " << toString();
       RECORD_METRIC_VALUE(
@@ -524,7 +558,11 @@ void* MemoryPoolImpl::allocate(
 
   CHECK_AND_INC_MEM_OP_STATS(this, Allocs);
   const auto alignedSize = sizeAlign(size);
+  if (isSmallAllocation(alignedSize)) {
+    return allocateSmall(size);
+  }
   reserve(alignedSize);
+  ScopedNumaNode numaScope(numaNode_);
   void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
     release(alignedSize);
@@ -544,7 +582,13 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
   CHECK_AND_INC_MEM_OP_STATS(this, Allocs);
   const auto size = sizeEach * numEntries;
   const auto alignedSize = sizeAlign(size);
+  if (isSmallAllocation(alignedSize)) {
+    void* buffer = allocateSmall(size);
+    ::memset(buffer, 0, size);
+    return buffer;
+  }
   reserve(alignedSize);
+  ScopedNumaNode numaScope(numaNode_);
   void* buffer = allocator_->allocateZeroFilled(alignedSize);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
     release(alignedSize);
@@ -564,21 +608,27 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
 void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
   CHECK_AND_INC_MEM_OP_STATS(this, Allocs);
   const auto alignedNewSize = sizeAlign(newSize);
-  reserve(alignedNewSize);
-
-  void* newP = allocator_->allocateBytes(alignedNewSize, alignment_);
-  if (FOLLY_UNLIKELY(newP == nullptr)) {
-    release(alignedNewSize);
-    handleAllocationFailure(
-        fmt::format(
-            "{} failed with new {} and old {} from {} {}",
-            __FUNCTION__,
-            succinctBytes(newSize),
-            succinctBytes(size),
-            toString(),
-            allocator_->getAndClearFailureMessage()));
+  void* newP;
+  if (isSmallAllocation(alignedNewSize)) {
+    newP = allocateSmall(newSize);
+  } else {
+    reserve(alignedNewSize);
+
+    ScopedNumaNode numaScope(numaNode_);
+    newP = allocator_->allocateBytes(alignedNewSize, alignment_);
+    if (FOLLY_UNLIKELY(newP == nullptr)) {
+      release(alignedNewSize);
+      handleAllocationFailure(
+          fmt::format(
+              "{} failed with new {} and old {} from {} {}",
+              __FUNCTION__,
+              succinctBytes(newSize),
+              succinctBytes(size),
+              toString(),
+              allocator_->getAndClearFailureMessage()));
+    }
+    DEBUG_RECORD_ALLOC(this, newP, newSize);
   }
-  DEBUG_RECORD_ALLOC(this, newP, newSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -590,10 +640,108 @@ void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(this, Frees);
   const auto alignedSize = sizeAlign(size);
   DEBUG_RECORD_FREE(p, size);
+  if (isSmallAllocation(alignedSize)) {
+    freeSmall(p, size);
+    return;
+  }
   allocator_->freeBytes(p, alignedSize);
   release(alignedSize);
 }
 
+int64_t MemoryPoolImpl::smallAllocationSize(int64_t alignedSize) {
+  return std::max<int64_t>(
+      kMinSmallAllocationSize, bits::nextPowerOfTwo(alignedSize));
+}
+
+void* MemoryPoolImpl::allocateSmall(int64_t size) {
+  const int64_t classSize = smallAllocationSize(sizeAlign(size));
+  const int32_t sizeClass = smallSizeClass(classSize);
+  void* buffer{nullptr};
+  {
+    auto& shard =
+        smallAllocationShards_[reservationShardIndex(kNumReservationShards)];
+    std::lock_guard<std::mutex> l(shard.mutex);
+    auto& freeAllocations = shard.freeAllocations[sizeClass];
+    if (!freeAllocations.empty()) {
+      buffer = freeAllocations.back();
+      freeAllocations.pop_back();
+      shard.cachedBytes -= classSize;
+    }
+  }
+  if (buffer == nullptr) {
+    // Refills the size class from the allocator. The memory usage is only
+    // updated here and when the allocation is given back to the allocator.
+    reserve(classSize);
+    ScopedNumaNode numaScope(numaNode_);
+    buffer = allocator_->allocateBytes(classSize, alignment_);
+    if (FOLLY_UNLIKELY(buffer == nullptr)) {
+      release(classSize);
+      handleAllocationFailure(
+          fmt::format(
+              "{} failed with {} from {} {}",
+              __FUNCTION__,
+              succinctBytes(size),
+              toString(),
+              allocator_->getAndClearFailureMessage()));
+    }
+  }
+  DEBUG_RECORD_ALLOC(this, buffer, size);
+  return buffer;
+}
+
+void MemoryPoolImpl::freeSmall(void* p, int64_t size) {
+  const int64_t classSize = smallAllocationSize(sizeAlign(size));
+  const int32_t sizeClass = smallSizeClass(classSize);
+  {
+    auto& shard =
+        smallAllocationShards_[reservationShardIndex(kNumReservationShards)];
+    std::lock_guard<std::mutex> l(shard.mutex);
+    if (shard.cachedBytes + classSize <= smallAllocationCacheBytes_) {
+      shard.freeAllocations[sizeClass].push_back(p);
+      shard.cachedBytes += classSize;
+      return;
+    }
+  }
+  allocator_->freeBytes(p, classSize);
+  release(classSize);
+}
+
+void MemoryPoolImpl::releaseSmallAllocationCache() {
+  int64_t freedBytes{0};
+  for (int32_t i = 0; i < kNumReservationShards; ++i) {
+    std::array<std::vector<void*>, kNumSmallSizeClasses> freeAllocations;
+    {
+      auto& shard = smallAllocationShards_[i];
+      std::lock_guard<std::mutex> l(shard.mutex);
+      freeAllocations.swap(shard.freeAllocations);
+      shard.cachedBytes = 0;
+    }
+    for (int32_t sizeClass = 0; sizeClass < kNumSmallSizeClasses;
+         ++sizeClass) {
+      const int64_t classSize = kMinSmallAllocationSize << sizeClass;
+      for (void* buffer : freeAllocations[sizeClass]) {
+        allocator_->freeBytes(buffer, classSize);
+        freedBytes += classSize;
+      }
+    }
+  }
+  if (freedBytes > 0) {
+    release(freedBytes);
+  }
+}
+
+int64_t MemoryPoolImpl::testingCachedSmallAllocationBytes() const {
+  if (smallAllocationShards_ == nullptr) {
+    return 0;
+  }
+  int64_t cachedBytes{0};
+  for (int32_t i = 0; i < kNumReservationShards; ++i) {
+    std::lock_guard<std::mutex> l(smallAllocationShards_[i].mutex);
+    cachedBytes += smallAllocationShards_[i].cachedBytes;
+  }
+  return cachedBytes;
+}
+
 bool MemoryPoolImpl::transferTo(MemoryPool* dest, void* buffer, uint64_t size) {
   if (!isLeaf() || !dest->isLeaf()) {
     return false;
@@ -603,9 +751,15 @@ bool MemoryPoolImpl::transferTo(MemoryPool* dest, void* buffer, uint64_t size) {
   if (allocator_ != destImpl->allocator_) {
     return false;
   }
+  // A small allocation is accounted by its size class which differs between
+  // pools with and without the small allocation cache.
+  const auto alignedSize = sizeAlign(size);
+  if (isSmallAllocation(alignedSize) ||
+      destImpl->isSmallAllocation(destImpl->sizeAlign(size))) {
+    return false;
+  }
 
   CHECK_AND_INC_MEM_OP_STATS(destImpl, Allocs);
-  const auto alignedSize = sizeAlign(size);
   destImpl->reserve(alignedSize);
   DEBUG_RECORD_ALLOC(destImpl, buffer, size);
 
@@ -629,6 +783,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  ScopedNumaNode numaScope(numaNode_);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -674,13 +829,15 @@ const std::vector<MachinePageCount>& MemoryPoolImpl::sizeClasses() const {
 void MemoryPoolImpl::allocateContiguous(
     MachinePageCount numPages,
     ContiguousAllocation& out,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    bool hugePages) {
   CHECK_AND_INC_MEM_OP_STATS(this, Allocs);
   if (!out.empty()) {
     INC_MEM_OP_STATS(Frees);
   }
   VELOX_CHECK_GT(numPages, 0);
   DEBUG_RECORD_FREE(out);
+  ScopedNumaNode numaScope(numaNode_);
   if (!allocator_->allocateContiguous(
           numPages,
           nullptr,
@@ -692,7 +849,8 @@ void MemoryPoolImpl::allocateContiguous(
               release(allocBytes);
             }
           },
-          maxPages)) {
+          maxPages,
+          hugePages)) {
     VELOX_CHECK(out.empty());
     handleAllocationFailure(
         fmt::format(
@@ -720,6 +878,7 @@ void MemoryPoolImpl::freeContiguous(ContiguousAllocation& allocation) {
 void MemoryPoolImpl::growContiguous(
     MachinePageCount increment,
     ContiguousAllocation& allocation) {
+  ScopedNumaNode numaScope(numaNode_);
   if (!allocator_->growContiguous(
           increment, allocation, [this](uint64_t allocBytes, bool preAlloc) {
             if (preAlloc) {
@@ -766,7 +925,7 @@ int64_t MemoryPoolImpl::usedBytes() const {
 
 int64_t MemoryPoolImpl::releasableReservation() const {
   if (isLeaf()) {
-    std::lock_guard<std::mutex> l(mutex_);
+    ReservationGuard l(this);
     return std::max<int64_t>(
         0, reservationBytes_ - quantizedSize(usedReservationBytes_));
   }
@@ -800,7 +959,10 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .threadSafe = threadSafe,
           .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
           .getPreferredSize = getPreferredSize,
-          .debugOptions = debugOptions_});
+          .debugOptions = debugOptions_,
+          .numaNode = numaNode_,
+          .reservationCacheBytes = reservationCacheBytes_,
+          .smallAllocationCacheBytes = smallAllocationCacheBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -838,12 +1000,18 @@ void MemoryPoolImpl::reserve(uint64_t size, bool reserveOnly) {
 void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
   VELOX_CHECK(isLeaf());
 
+  if (reservationShards_ != nullptr && !reserveOnly &&
+      reserveFromCache(size)) {
+    return;
+  }
+
   int32_t numAttempts = 0;
   int64_t increment = 0;
   for (;; ++numAttempts) {
     {
-      std::lock_guard<std::mutex> l(mutex_);
-      increment = reservationSizeLocked(size);
+      ReservationGuard l(this);
+      const int64_t cachedBytes = cachedReservationLocked();
+      increment = reservationSizeLocked(size, cachedBytes);
       if (increment == 0) {
         if (reserveOnly) {
           minReservationBytes_ = tsanAtomicValue(reservationBytes_);
@@ -851,6 +1019,7 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
           usedReservationBytes_ += size;
           cumulativeBytes_ += size;
           maybeUpdatePeakBytesLocked(usedReservationBytes_);
+          refillReservationCacheLocked(cachedBytes);
         }
         sanityCheckLocked();
         break;
@@ -879,6 +1048,113 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
   }
 }
 
+bool MemoryPoolImpl::reserveFromCache(uint64_t size) {
+  auto& shard =
+      reservationShards_[reservationShardIndex(kNumReservationShards)];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  if (shard.cachedBytes < static_cast<int64_t>(size)) {
+    return false;
+  }
+  shard.cachedBytes -= size;
+  const int64_t usedBytes = usedReservationBytes_.fetch_add(size) + size;
+  cumulativeBytes_ += size;
+  maybeUpdatePeakBytesLocked(usedBytes);
+  return true;
+}
+
+bool MemoryPoolImpl::releaseToCache(uint64_t size) {
+  auto& shard =
+      reservationShards_[reservationShardIndex(kNumReservationShards)];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  if (shard.cachedBytes + static_cast<int64_t>(size) >
+      reservationCacheBytes_) {
+    return false;
+  }
+  // Decrement the used bytes first so that the reservation always covers the
+  // used and cached bytes.
+  usedReservationBytes_ -= size;
+  shard.cachedBytes += size;
+  return true;
+}
+
+int64_t MemoryPoolImpl::cachedReservationLocked() const {
+  if (reservationShards_ == nullptr) {
+    return 0;
+  }
+  int64_t cachedBytes{0};
+  for (int32_t i = 0; i < kNumReservationShards; ++i) {
+    cachedBytes += reservationShards_[i].cachedBytes;
+  }
+  return cachedBytes;
+}
+
+void MemoryPoolImpl::refillReservationCacheLocked(int64_t cachedBytes) {
+  if (reservationShards_ == nullptr) {
+    return;
+  }
+  auto& shard =
+      reservationShards_[reservationShardIndex(kNumReservationShards)];
+  const int64_t unusedBytes =
+      reservationBytes_ - usedReservationBytes_ - cachedBytes;
+  shard.cachedBytes += std::max<int64_t>(
+      0, std::min(unusedBytes, reservationCacheBytes_ - shard.cachedBytes));
+}
+
+int64_t MemoryPoolImpl::drainReservationCacheLocked() {
+  if (reservationShards_ == nullptr) {
+    return 0;
+  }
+  int64_t cachedBytes{0};
+  for (int32_t i = 0; i < kNumReservationShards; ++i) {
+    cachedBytes += reservationShards_[i].cachedBytes;
+    reservationShards_[i].cachedBytes = 0;
+  }
+  return cachedBytes;
+}
+
+void MemoryPoolImpl::releaseReservationCache() {
+  int64_t freeable = 0;
+  {
+    ReservationGuard l(this);
+    if (drainReservationCacheLocked() == 0) {
+      return;
+    }
+    const int64_t newQuantized = quantizedSize(
+        std::max<int64_t>(minReservationBytes_, usedReservationBytes_));
+    freeable = reservationBytes_ - newQuantized;
+    if (freeable > 0) {
+      reservationBytes_ = newQuantized;
+    }
+  }
+  if (freeable > 0) {
+    toImpl(parent_)->decrementReservation(freeable);
+  }
+}
+
+int64_t MemoryPoolImpl::testingCachedReservationBytes() const {
+  ReservationGuard l(this);
+  return cachedReservationLocked();
+}
+
+MemoryPoolImpl::ReservationGuard::ReservationGuard(const MemoryPoolImpl* pool)
+    : pool_(pool) {
+  if (pool_->reservationShards_ != nullptr) {
+    for (int32_t i = 0; i < kNumReservationShards; ++i) {
+      pool_->reservationShards_[i].mutex.lock();
+    }
+  }
+  pool_->mutex_.lock();
+}
+
+MemoryPoolImpl::ReservationGuard::~ReservationGuard() {
+  pool_->mutex_.unlock();
+  if (pool_->reservationShards_ != nullptr) {
+    for (int32_t i = kNumReservationShards - 1; i >= 0; --i) {
+      pool_->reservationShards_[i].mutex.unlock();
+    }
+  }
+}
+
 void MemoryPoolImpl::incrementReservationThreadSafe(
     MemoryPool* requestor,
     uint64_t size) {
@@ -960,6 +1236,9 @@ void MemoryPoolImpl::incrementReservationLocked(uint64_t bytes) {
 
 void MemoryPoolImpl::release() {
   CHECK_AND_INC_MEM_OP_STATS(this, Releases);
+  if (smallAllocationShards_ != nullptr) {
+    releaseSmallAllocationCache();
+  }
   release(0, true);
 }
 
@@ -977,21 +1256,28 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
   VELOX_CHECK(isLeaf());
   VELOX_DCHECK_NOT_NULL(parent_);
 
+  if (reservationShards_ != nullptr && !releaseOnly && size > 0 &&
+      releaseToCache(size)) {
+    return;
+  }
+
   int64_t freeable = 0;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    ReservationGuard l(this);
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      const int64_t drainedBytes = drainReservationCacheLocked();
+      if (minReservationBytes_ == 0 && drainedBytes == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
       minReservationBytes_ = 0;
     } else {
       usedReservationBytes_ -= size;
-      const int64_t newCap =
-          std::max(minReservationBytes_, usedReservationBytes_);
+      const int64_t newCap = std::max<int64_t>(
+          minReservationBytes_,
+          usedReservationBytes_ + cachedReservationLocked());
       newQuantized = quantizedSize(newCap);
     }
     freeable = reservationBytes_ - newQuantized;
@@ -16,17 +16,20 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <optional>
 
 #include <fmt/format.h>
+#include <folly/lang/Align.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/memory/Numa.h"
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_capacity_transfer_across_tasks);
@@ -163,6 +166,30 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
 
     /// If non-empty, enables debug mode for the created memory pool.
     std::optional<DebugOptions> debugOptions{std::nullopt};
+
+    /// If not kNoNumaNode, the memory of this pool and its children is placed
+    /// on this NUMA node if the allocator supports it. See
+    /// MmapAllocator::Options::numNumaNodes.
+    int32_t numaNode{kNoNumaNode};
+
+    /// If non-zero, a thread-safe leaf memory pool caches up to this many
+    /// reserved but unused bytes for each shard of calling threads. Small
+    /// reservations and frees are then served from the shard of the calling
+    /// thread without taking the pool mutex. The reservation still grows in
+    /// quantized chunks as before, and a free only goes through the pool mutex
+    /// once its shard is full. The cached bytes are given back to the parent
+    /// on release() and on destruction.
+    int64_t reservationCacheBytes{0};
+
+    /// If non-zero, a leaf memory pool serves allocate() calls of up to
+    /// MemoryPoolImpl::kMaxSmallAllocationSize bytes from power of 2 size
+    /// classes, and keeps up to this many bytes of freed small allocations for
+    /// each shard of calling threads to serve later allocations of the same
+    /// size class without going to the memory allocator. The memory usage is
+    /// only updated when a size class is refilled from or drained to the
+    /// allocator, so the cached allocations count as used memory. They are
+    /// given back to the allocator on release() and on destruction.
+    int64_t smallAllocationCacheBytes{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -291,11 +318,13 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// range of addresses for huge pages. The range can be larger than
   /// is likely to be used because usage can be declared as needed but
   /// the number of huge pages  can be set according to an assumption of large
-  /// utilization.
+  /// utilization. If 'hugePages' is true, a range of at least a huge page is
+  /// mapped at a huge page boundary. See MemoryAllocator::allocateContiguous().
   virtual void allocateContiguous(
       MachinePageCount numPages,
       ContiguousAllocation& out,
-      MachinePageCount maxPages = 0) = 0;
+      MachinePageCount maxPages = 0,
+      bool hugePages = false) = 0;
 
   /// Frees contiguous 'allocation'. 'allocation' is empty on return.
   virtual void freeContiguous(ContiguousAllocation& allocation) = 0;
@@ -315,6 +344,12 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     return alignment_;
   }
 
+  /// Returns the NUMA node the memory of this pool is placed on, kNoNumaNode if
+  /// not bound to a node.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
   /// Resource governing methods used to track and limit the memory usage
   /// through this memory pool object.
 
@@ -565,6 +600,9 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const std::optional<DebugOptions> debugOptions_;
   const bool coreOnAllocationFailureEnabled_;
+  const int32_t numaNode_;
+  const int64_t reservationCacheBytes_;
+  const int64_t smallAllocationCacheBytes_;
   std::function<size_t(size_t)> getPreferredSize_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
@@ -638,7 +676,8 @@ class MemoryPoolImpl : public MemoryPool {
   void allocateContiguous(
       MachinePageCount numPages,
       ContiguousAllocation& out,
-      MachinePageCount maxPages = 0) override;
+      MachinePageCount maxPages = 0,
+      bool hugePages = false) override;
 
   void freeContiguous(ContiguousAllocation& allocation) override;
 
@@ -736,6 +775,19 @@ class MemoryPoolImpl : public MemoryPool {
     return minReservationBytes_;
   }
 
+  /// Returns the reserved bytes cached by the reservation shards of a
+  /// thread-safe leaf memory pool.
+  int64_t testingCachedReservationBytes() const;
+
+  /// Returns the bytes of freed small allocations cached by the small
+  /// allocation shards of a leaf memory pool.
+  int64_t testingCachedSmallAllocationBytes() const;
+
+  /// The smallest and largest size classes served from the small allocation
+  /// cache. See MemoryPool::Options::smallAllocationCacheBytes.
+  static constexpr int64_t kMinSmallAllocationSize{64};
+  static constexpr int64_t kMaxSmallAllocationSize{64 << 10};
+
   /// Structure to store allocation details in debug mode.
   struct AllocationRecord {
     uint64_t size;
@@ -835,6 +887,56 @@ class MemoryPoolImpl : public MemoryPool {
 
   void reserveThreadSafe(uint64_t size, bool reserveOnly = false);
 
+  // Serves a reservation of 'size' from the reservation shard of the calling
+  // thread and returns true if it caches enough bytes. Otherwise returns false
+  // and the reservation goes through reserveThreadSafe().
+  bool reserveFromCache(uint64_t size);
+
+  // Returns a released reservation of 'size' to the reservation shard of the
+  // calling thread and returns true if the shard has room for it. Otherwise
+  // returns false and the release goes through releaseThreadSafe().
+  bool releaseToCache(uint64_t size);
+
+  // Returns the sum of the bytes cached by 'reservationShards_'. The caller
+  // must hold a ReservationGuard.
+  int64_t cachedReservationLocked() const;
+
+  // Moves up to 'reservationCacheBytes_' of the unused reservation into the
+  // reservation shard of the calling thread. The caller must hold a
+  // ReservationGuard.
+  void refillReservationCacheLocked(int64_t cachedBytes);
+
+  // Clears 'reservationShards_' and returns the bytes they cached. The caller
+  // must hold a ReservationGuard.
+  int64_t drainReservationCacheLocked();
+
+  // Gives the bytes cached by 'reservationShards_' back to the parent on
+  // destruction.
+  void releaseReservationCache();
+
+  // Returns true if an allocation of 'alignedSize' is served from
+  // 'smallAllocationShards_'.
+  FOLLY_ALWAYS_INLINE bool isSmallAllocation(int64_t alignedSize) const {
+    return smallAllocationShards_ != nullptr &&
+        alignedSize <= kMaxSmallAllocationSize;
+  }
+
+  // Returns the size class of a small allocation of 'alignedSize'.
+  static int64_t smallAllocationSize(int64_t alignedSize);
+
+  // Returns a small allocation of 'size' from the small allocation shard of
+  // the calling thread, or from the allocator if the shard has no free
+  // allocation of the size class.
+  void* allocateSmall(int64_t size);
+
+  // Returns a small allocation of 'size' to the small allocation shard of the
+  // calling thread, or to the allocator if the shard is full.
+  void freeSmall(void* p, int64_t size);
+
+  // Frees the allocations cached by 'smallAllocationShards_' to the allocator
+  // and releases their memory usage.
+  void releaseSmallAllocationCache();
+
   // Increments the reservation and checks against limits at root memory pool.
   // Provokes root memory pool to grow capacity through arbitrator if exceeds
   // capacity. Should be called without holding 'mutex_'. This function throws
@@ -851,18 +953,24 @@ class MemoryPoolImpl : public MemoryPool {
   }
 
   // Returns the needed reservation size. If there is sufficient unused memory
-  // reservation, this function returns zero.
-  FOLLY_ALWAYS_INLINE int64_t reservationSizeLocked(int64_t size) {
+  // reservation, this function returns zero. 'cachedBytes' is the unused
+  // reservation held by 'reservationShards_' which is not available here.
+  FOLLY_ALWAYS_INLINE int64_t
+  reservationSizeLocked(int64_t size, int64_t cachedBytes = 0) {
     const int64_t neededSize =
-        size - (reservationBytes_ - usedReservationBytes_);
+        size - (reservationBytes_ - usedReservationBytes_ - cachedBytes);
     if (neededSize <= 0) {
       return 0;
     }
     return roundedDelta(reservationBytes_, neededSize);
   }
 
+  // NOTE: the reservation cache of a thread-safe leaf memory pool updates the
+  // peak without holding 'mutex_'.
   FOLLY_ALWAYS_INLINE void maybeUpdatePeakBytesLocked(int64_t newPeak) {
-    peakBytes_ = std::max<int64_t>(peakBytes_, newPeak);
+    int64_t peak = peakBytes_.load(std::memory_order_relaxed);
+    while (newPeak > peak && !peakBytes_.compare_exchange_weak(peak, newPeak)) {
+    }
   }
 
   // Tries to increment the reservation 'size' if it is within the limit and
@@ -902,7 +1010,7 @@ class MemoryPoolImpl : public MemoryPool {
     } else {
       usedReservationBytes_ -= size;
       const int64_t newCap =
-          std::max(minReservationBytes_, usedReservationBytes_);
+          std::max<int64_t>(minReservationBytes_, usedReservationBytes_);
       newQuantized = quantizedSize(newCap);
     }
 
@@ -1047,6 +1155,53 @@ class MemoryPoolImpl : public MemoryPool {
   // the same parent do not have to be serialized.
   mutable std::mutex mutex_;
 
+  // Unused reservation cached for a shard of the threads using a thread-safe
+  // leaf memory pool. The shard mutex only serializes the threads of the
+  // shard.
+  struct alignas(folly::hardware_destructive_interference_size)
+      ReservationShard {
+    std::mutex mutex;
+    int64_t cachedBytes{0};
+  };
+
+  static constexpr int32_t kNumReservationShards{8};
+
+  // Locks all of 'reservationShards_' followed by 'mutex_'. Any update that
+  // reads the unused reservation of a leaf memory pool with a reservation
+  // cache holds this guard so that no shard changes concurrently.
+  class ReservationGuard {
+   public:
+    explicit ReservationGuard(const MemoryPoolImpl* pool);
+
+    ~ReservationGuard();
+
+   private:
+    const MemoryPoolImpl* const pool_;
+  };
+
+  // Allocated only for a thread-safe leaf memory pool with usage tracking
+  // and 'reservationCacheBytes_' set.
+  const std::unique_ptr<ReservationShard[]> reservationShards_;
+
+  static constexpr int32_t kNumSmallSizeClasses{11};
+  static_assert(
+      kMinSmallAllocationSize << (kNumSmallSizeClasses - 1) ==
+      kMaxSmallAllocationSize);
+
+  // Freed small allocations cached for a shard of the threads using a leaf
+  // memory pool. 'freeAllocations[i]' holds the allocations of size
+  // kMinSmallAllocationSize << i.
+  struct alignas(folly::hardware_destructive_interference_size)
+      SmallAllocationShard {
+    std::mutex mutex;
+    std::array<std::vector<void*>, kNumSmallSizeClasses> freeAllocations;
+    int64_t cachedBytes{0};
+  };
+
+  // Allocated only for a leaf memory pool with usage tracking and
+  // 'smallAllocationCacheBytes_' set.
+  const std::unique_ptr<SmallAllocationShard[]> smallAllocationShards_;
+
   DestructionCallback destructionCb_;
 
   // Used by memory arbitration to reclaim memory from the associated query
@@ -1063,15 +1218,15 @@ class MemoryPoolImpl : public MemoryPool {
 
   // The number of used reservation bytes which is maintained at the leaf
   // tracker and protected by mutex for consistent memory reservation/release
-  // decisions.
-  tsan_atomic<int64_t> usedReservationBytes_{0};
+  // decisions. The reservation cache updates it under a shard mutex.
+  std::atomic<int64_t> usedReservationBytes_{0};
 
   // Minimum amount of reserved memory in bytes to hold until explicit
   // release().
   tsan_atomic<int64_t> minReservationBytes_{0};
 
-  tsan_atomic<int64_t> peakBytes_{0};
-  tsan_atomic<int64_t> cumulativeBytes_{0};
+  std::atomic<int64_t> peakBytes_{0};
+  std::atomic<int64_t> cumulativeBytes_{0};
 
   // Stats counters.
   // The number of memory allocations.
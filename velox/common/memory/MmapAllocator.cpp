@@ -22,6 +22,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/memory/Numa.h"
 
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
@@ -37,9 +38,24 @@ MmapAllocator::MmapAllocator(const Options& options)
           bits::roundUp(
               AllocationTraits::numPages(
                   options.capacity - mallocReservedBytes_),
-              64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+              64 * sizeClassSizes_.back())),
+      numNumaNodes_(std::max(options.numNumaNodes, 1)),
+      trimLowWatermark_(capacity_ / 100 * options.trimLowWatermarkPct),
+      trimHighWatermark_(capacity_ / 100 * options.trimHighWatermarkPct),
+      trimWarmReserve_(capacity_ / 100 * options.trimWarmReservePct),
+      trimInterval_(options.trimIntervalMs) {
+  VELOX_CHECK_GE(options.trimLowWatermarkPct, 0);
+  VELOX_CHECK_LE(
+      options.trimLowWatermarkPct,
+      options.trimHighWatermarkPct,
+      "The low trim watermark must not exceed the high one");
+  VELOX_CHECK_LE(options.trimHighWatermarkPct, 100);
+  VELOX_CHECK_GE(options.trimWarmReservePct, 0);
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numNumaNodes_ > 1 ? node : kNoNumaNode));
+    }
   }
 
   if (useMmapArena_) {
@@ -49,9 +65,22 @@ MmapAllocator::MmapAllocator(const Options& options)
     managedArenas_ = std::make_unique<ManagedMmapArenas>(
         std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes));
   }
+
+  if (options.backgroundTrim) {
+    VELOX_CHECK_GT(options.trimIntervalMs, 0);
+    trimmer_ = std::make_unique<std::thread>([this]() { trimmerLoop(); });
+  }
 }
 
 MmapAllocator::~MmapAllocator() {
+  if (trimmer_ != nullptr) {
+    {
+      std::lock_guard<std::mutex> l(trimmerMutex_);
+      stopTrimmer_ = true;
+    }
+    trimmerCv_.notify_one();
+    trimmer_->join();
+  }
   VELOX_CHECK(
       (numAllocated_ == 0) && (numExternalMapped_ == 0), "{}", toString());
 }
@@ -94,14 +123,16 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
   MachinePageCount newMapsNeeded = 0;
+  const auto sizeClassBase = numaSizeClassBase();
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
     stats_.recordAllocate(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
-              sizeMix.sizeCounts[i], newMapsNeeded, out);
+          success =
+              sizeClasses_[sizeClassBase + sizeMix.sizeIndices[i]]->allocate(
+                  sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -150,6 +181,7 @@ bool MmapAllocator::ensureEnoughMappedPages(int32_t newMappedNeeded) {
   std::lock_guard<std::mutex> l(sizeClassBalanceMutex_);
   const auto totalMaps =
       numMapped_.fetch_add(newMappedNeeded) + newMappedNeeded;
+  maybeWakeTrimmer(totalMaps);
   if (totalMaps <= capacity_) {
     // We are not at capacity. No need to advise away.
     return true;
@@ -198,7 +230,7 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
       const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClass->unitSize()));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -211,10 +243,12 @@ bool MmapAllocator::allocateContiguousWithoutRetry(
     MachinePageCount numPages,
     Allocation* collateral,
     ContiguousAllocation& allocation,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    bool hugePages) {
   bool result;
   stats_.recordAllocate(AllocationTraits::pageBytes(numPages), 1, [&]() {
-    result = allocateContiguousImpl(numPages, collateral, allocation, maxPages);
+    result = allocateContiguousImpl(
+        numPages, collateral, allocation, maxPages, hugePages);
   });
   return result;
 }
@@ -223,7 +257,8 @@ bool MmapAllocator::allocateContiguousImpl(
     MachinePageCount numPages,
     Allocation* collateral,
     ContiguousAllocation& allocation,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    bool hugePages) {
   if (maxPages == 0) {
     maxPages = numPages;
   } else {
@@ -333,13 +368,13 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mapContiguous(AllocationTraits::pageBytes(maxPages), hugePages);
+      if (numNumaNodes_ > 1 && data != MAP_FAILED) {
+        bindMemoryToNumaNode(
+            data,
+            AllocationTraits::pageBytes(maxPages),
+            threadNumaNode() % numNumaNodes_);
+      }
     }
   }
   if (data == nullptr || data == MAP_FAILED) {
@@ -513,7 +548,76 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MachinePageCount MmapAllocator::trim() {
+  MachinePageCount numTrimmed{0};
+  for (;;) {
+    const MachinePageCount numMapped = numMapped_;
+    const MachinePageCount numAllocated = numAllocated_;
+    const MachinePageCount numUnmapped =
+        numMapped < capacity_ ? capacity_ - numMapped : 0;
+    if (numTrimmed == 0 ? numUnmapped >= trimLowWatermark_
+                        : numUnmapped >= trimHighWatermark_) {
+      break;
+    }
+    // Allocated pages are mapped, so the difference is the free mapped pages.
+    const MachinePageCount numMappedFree =
+        numMapped > numAllocated ? numMapped - numAllocated : 0;
+    if (numMappedFree <= trimWarmReserve_) {
+      break;
+    }
+    const auto target = std::min(
+        {trimHighWatermark_ - numUnmapped,
+         numMappedFree - trimWarmReserve_,
+         kTrimBatchPages});
+    const auto numAdvised = adviseAway(target);
+    if (numAdvised == 0) {
+      break;
+    }
+    numMapped_.fetch_sub(numAdvised);
+    numTrimmed += numAdvised;
+  }
+  if (numTrimmed > 0) {
+    ++numBackgroundTrims_;
+    numBackgroundTrimmedPages_ += numTrimmed;
+  }
+  return numTrimmed;
+}
+
+void MmapAllocator::trimmerLoop() {
+  std::unique_lock<std::mutex> l(trimmerMutex_);
+  while (!stopTrimmer_) {
+    trimmerCv_.wait_for(
+        l, trimInterval_, [&]() { return stopTrimmer_ || trimRequested_; });
+    if (stopTrimmer_) {
+      break;
+    }
+    trimRequested_ = false;
+    l.unlock();
+    trim();
+    l.lock();
+  }
+}
+
+void MmapAllocator::maybeWakeTrimmer(MachinePageCount numMapped) {
+  if (trimmer_ == nullptr || numMapped + trimLowWatermark_ <= capacity_) {
+    return;
+  }
+  if (!trimRequested_.exchange(true)) {
+    trimmerCv_.notify_one();
+  }
+}
+
+int32_t MmapAllocator::numaSizeClassBase() const {
+  if (numNumaNodes_ == 1) {
+    return 0;
+  }
+  return (threadNumaNode() % numNumaNodes_) * sizeClassSizes_.size();
+}
+
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -542,6 +646,9 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode != kNoNumaNode) {
+    bindMemoryToNumaNode(address_, byteSize_, numaNode);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
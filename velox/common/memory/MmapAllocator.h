@@ -18,10 +18,13 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_set>
 
 #include <folly/ThreadCachedInt.h>
@@ -80,6 +83,30 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If greater than 1, the size classes are replicated for each of
+    /// 'numNumaNodes' NUMA nodes and the memory of each replica is bound to
+    /// its node. An allocation is served from the size classes of
+    /// threadNumaNode(), which the memory pools bound to a node set for their
+    /// allocations. The capacity is shared by all nodes.
+    int32_t numNumaNodes{1};
+
+    /// If true, a background thread advises away free mapped pages of the
+    /// size classes ahead of demand, so that allocations rarely have to
+    /// madvise inline to stay within the capacity. The thread trims when the
+    /// pages that can still be mapped within the capacity drop below
+    /// 'trimLowWatermarkPct'% of the capacity, until they reach
+    /// 'trimHighWatermarkPct'%. It leaves at least 'trimWarmReservePct'% of
+    /// the capacity in free mapped pages, which serve allocation bursts
+    /// without page faults.
+    bool backgroundTrim{false};
+    int32_t trimLowWatermarkPct{5};
+    int32_t trimHighWatermarkPct{10};
+    int32_t trimWarmReservePct{5};
+
+    /// Interval at which the background thread checks the watermarks. It is
+    /// also woken up by allocations that map pages past the low watermark.
+    int32_t trimIntervalMs{100};
   };
 
   explicit MmapAllocator(const Options& options);
@@ -154,13 +181,21 @@ class MmapAllocator : public MemoryAllocator {
   }
 
   Stats stats() const override {
-    auto stats = stats_;
+    auto stats = MemoryAllocator::stats();
     stats.numAdvise = numAdvisedPages_;
+    stats.numBackgroundTrims = numBackgroundTrims_;
+    stats.numBackgroundTrimmedPages = numBackgroundTrimmedPages_;
     return stats;
   }
 
   std::string toString() const override;
 
+  /// Runs one round of the background trimming inline. Returns the number of
+  /// pages advised away.
+  MachinePageCount testingTrim() {
+    return trim();
+  }
+
  private:
   static constexpr uint64_t kAllSet = 0xffffffffffffffff;
 
@@ -168,7 +203,9 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'numaNode' is not kNoNumaNode, the memory of 'this' is bound to the
+    // node.
+    SizeClass(size_t capacity, MachinePageCount unitSize, int32_t numaNode);
 
     ~SizeClass();
 
@@ -326,13 +363,15 @@ class MmapAllocator : public MemoryAllocator {
       MachinePageCount numPages,
       Allocation* collateral,
       ContiguousAllocation& allocation,
-      MachinePageCount maxPages = 0) override;
+      MachinePageCount maxPages = 0,
+      bool hugePages = false) override;
 
   bool allocateContiguousImpl(
       MachinePageCount numPages,
       Allocation* collateral,
       ContiguousAllocation& allocation,
-      MachinePageCount maxPages);
+      MachinePageCount maxPages,
+      bool hugePages);
 
   void freeContiguousImpl(ContiguousAllocation& allocation);
 
@@ -372,6 +411,25 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Advises away free mapped pages in batches of at most 'kTrimBatchPages'
+  // while the pages that can be mapped within 'capacity_' are below the low
+  // watermark, until they reach the high watermark or the free mapped pages
+  // are down to the warm reserve. Does not hold 'sizeClassBalanceMutex_', so
+  // that concurrent allocations do not wait for the madvise calls. Returns
+  // the number of pages advised away.
+  MachinePageCount trim();
+
+  // Body of 'trimmer_'.
+  void trimmerLoop();
+
+  // Wakes up 'trimmer_' if mapping 'numMapped' pages leaves less than the low
+  // watermark of unmapped capacity.
+  void maybeWakeTrimmer(MachinePageCount numMapped);
+
+  // Returns the index in 'sizeClasses_' of the first size class of the NUMA
+  // node of the calling thread.
+  int32_t numaSizeClassBase() const;
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -400,12 +458,24 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  const int32_t numNumaNodes_;
+
+  // Background trimming watermarks in pages. See Options.
+  const MachinePageCount trimLowWatermark_;
+  const MachinePageCount trimHighWatermark_;
+  const MachinePageCount trimWarmReserve_;
+  const std::chrono::milliseconds trimInterval_;
+
+  // The size classes of each NUMA node one after the other, in the order of
+  // 'sizeClassSizes_'.
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
+  std::atomic<uint64_t> numBackgroundTrims_ = 0;
+  std::atomic<uint64_t> numBackgroundTrimmedPages_ = 0;
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
   // Allocations that are larger than largest size classes will be delegated to
@@ -414,6 +484,17 @@ class MmapAllocator : public MemoryAllocator {
   std::unique_ptr<ManagedMmapArenas> managedArenas_;
 
   std::shared_ptr<Cache> cache_;
+
+  // Largest number of pages 'trim()' advises away at a time. Bounds the pages
+  // that are neither free nor allocated while being advised away.
+  static constexpr MachinePageCount kTrimBatchPages = 1024;
+
+  std::mutex trimmerMutex_;
+  std::condition_variable trimmerCv_;
+  bool stopTrimmer_{false};
+  std::atomic_bool trimRequested_{false};
+  // The background trimming thread if Options::backgroundTrim is set.
+  std::unique_ptr<std::thread> trimmer_;
 };
 
 } // namespace facebook::velox::memory
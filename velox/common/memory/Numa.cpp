@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/Numa.h"
+
+#include <fstream>
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::memory {
+namespace {
+thread_local int32_t threadNode{kNoNumaNode};
+
+// Parses a kernel CPU or node list like "0-3,8,10-11".
+std::vector<int32_t> parseList(const std::string& list) {
+  std::vector<int32_t> result;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(list), ranges);
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash = range.find('-');
+    try {
+      if (dash == folly::StringPiece::npos) {
+        result.push_back(folly::to<int32_t>(range));
+      } else {
+        const auto first = folly::to<int32_t>(range.subpiece(0, dash));
+        const auto last = folly::to<int32_t>(range.subpiece(dash + 1));
+        for (auto i = first; i <= last; ++i) {
+          result.push_back(i);
+        }
+      }
+    } catch (const std::exception&) {
+      return {};
+    }
+  }
+  return result;
+}
+
+std::string readFile(const std::string& path) {
+  std::ifstream in(path);
+  std::string content;
+  std::getline(in, content);
+  return content;
+}
+} // namespace
+
+int32_t numNumaNodes() {
+  static const int32_t numNodes = []() {
+    const auto nodes = parseList(readFile("/sys/devices/system/node/online"));
+    return nodes.empty() ? 1 : nodes.back() + 1;
+  }();
+  return numNodes;
+}
+
+std::vector<int32_t> numaNodeCpus(int32_t node) {
+  return parseList(
+      readFile(fmt::format("/sys/devices/system/node/node{}/cpulist", node)));
+}
+
+int32_t threadNumaNode() {
+  if (threadNode != kNoNumaNode) {
+    return threadNode;
+  }
+#ifdef __linux__
+  unsigned cpu;
+  unsigned node;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+void setThreadNumaNode(int32_t node) {
+  threadNode = node;
+}
+
+ScopedNumaNode::ScopedNumaNode(int32_t node)
+    : node_(node), savedNode_(threadNode) {
+  if (node_ != kNoNumaNode) {
+    threadNode = node_;
+  }
+}
+
+ScopedNumaNode::~ScopedNumaNode() {
+  if (node_ != kNoNumaNode) {
+    threadNode = savedNode_;
+  }
+}
+
+bool bindMemoryToNumaNode(void* address, size_t bytes, int32_t node) {
+#ifdef __linux__
+  // MPOL_PREFERRED from <linux/mempolicy.h>. The memory falls back to the
+  // other nodes when 'node' is full.
+  constexpr int kMpolPreferred = 1;
+  constexpr int32_t kMaxNodes = 64;
+  if (node < 0 || node >= kMaxNodes) {
+    return false;
+  }
+  const uint64_t nodeMask = 1ULL << node;
+  if (::syscall(
+          SYS_mbind, address, bytes, kMpolPreferred, &nodeMask, kMaxNodes, 0) ==
+      0) {
+    return true;
+  }
+  LOG_EVERY_N(WARNING, 1000) << "mbind to NUMA node " << node
+                             << " failed: " << folly::errnoStr(errno);
+#endif
+  return false;
+}
+
+bool bindThreadToNumaNode(int32_t node) {
+  setThreadNumaNode(node);
+#ifdef __linux__
+  const auto cpus = numaNodeCpus(node);
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+  if (::sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0) {
+    return true;
+  }
+  LOG(WARNING) << "Failed to bind thread to NUMA node " << node << ": "
+               << folly::errnoStr(errno);
+#endif
+  return false;
+}
+
+std::thread NumaThreadFactory::newThread(folly::Func&& func) {
+  return folly::NamedThreadFactory::newThread(
+      [node = node_, func = std::move(func)]() mutable {
+        bindThreadToNumaNode(node);
+        func();
+      });
+}
+} // namespace facebook::velox::memory
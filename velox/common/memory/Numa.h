@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+/// NUMA helpers for placing memory and threads on the same node. They work
+/// from the kernel interfaces under /sys and the mbind, getcpu and
+/// sched_setaffinity system calls and do not need libnuma. On other platforms
+/// and on machines with a single node, there is one node 0 and binding is a
+/// no-op.
+///
+/// A NUMA aware setup has one executor per node whose threads are bound to
+/// the node with NumaThreadFactory, an MmapAllocator with
+/// Options::numNumaNodes > 1, and runs each query on the executor of the node
+/// its root memory pool is bound to with MemoryPool::Options::numaNode. The
+/// drivers of the query then run on the node that holds its memory.
+namespace facebook::velox::memory {
+
+constexpr int32_t kNoNumaNode = -1;
+
+/// Returns the number of NUMA nodes of the machine, 1 if not known.
+int32_t numNumaNodes();
+
+/// Returns the CPUs of NUMA 'node'. Empty if not known.
+std::vector<int32_t> numaNodeCpus(int32_t node);
+
+/// Returns the NUMA node that the allocations of the calling thread are placed
+/// on: the node set by ScopedNumaNode or setThreadNumaNode() if any, otherwise
+/// the node of the CPU the thread runs on.
+int32_t threadNumaNode();
+
+/// Sets the default NUMA node of the allocations of the calling thread.
+/// kNoNumaNode means the node of the CPU the thread runs on.
+void setThreadNumaNode(int32_t node);
+
+/// Places the allocations made in the scope on 'node'. Does nothing if 'node'
+/// is kNoNumaNode.
+class ScopedNumaNode {
+ public:
+  explicit ScopedNumaNode(int32_t node);
+
+  ~ScopedNumaNode();
+
+ private:
+  const int32_t node_;
+  int32_t savedNode_;
+};
+
+/// Asks the kernel to back the 'bytes' at 'address' with the memory of 'node'
+/// when they are first touched. Returns false if not supported.
+bool bindMemoryToNumaNode(void* address, size_t bytes, int32_t node);
+
+/// Binds the calling thread to the CPUs of 'node' and makes 'node' the default
+/// node of its allocations. Returns false if the CPUs are not known or the
+/// binding failed.
+bool bindThreadToNumaNode(int32_t node);
+
+/// Thread factory for the executors whose threads run on one NUMA node.
+class NumaThreadFactory : public folly::NamedThreadFactory {
+ public:
+  NumaThreadFactory(const std::string& prefix, int32_t node)
+      : folly::NamedThreadFactory(prefix), node_(node) {}
+
+  std::thread newThread(folly::Func&& func) override;
+
+  int32_t node() const {
+    return node_;
+  }
+
+ private:
+  const int32_t node_;
+};
+} // namespace facebook::velox::memory
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/QueryAdmissionController.h"
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::memory {
+
+QueryAdmissionController::QueryAdmissionController(
+    const Config& config,
+    MemoryManager* memoryManager)
+    : config_(config),
+      memoryManager_(memoryManager),
+      capacity_(
+          config.capacity > 0 || memoryManager == nullptr
+              ? config.capacity
+              : memoryManager->capacity()),
+      queues_(config.numPriorities) {
+  VELOX_CHECK_GT(capacity_, 0, "Admission capacity must be set");
+  VELOX_CHECK_GT(config_.maxCpuSlots, 0);
+  VELOX_CHECK_GT(config_.numPriorities, 0);
+  VELOX_CHECK_GT(config_.maxRunsPerFingerprint, 0);
+}
+
+int64_t QueryAdmissionController::predictPeakBytes(
+    const Request& request) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return predictPeakBytesLocked(request);
+}
+
+int64_t QueryAdmissionController::predictPeakBytesLocked(
+    const Request& request) const {
+  int64_t bytes = request.estimatedPeakBytes.value_or(config_.defaultPeakBytes);
+  if (!request.fingerprint.empty()) {
+    auto it = history_.find(request.fingerprint);
+    if (it != history_.end()) {
+      bytes = *std::max_element(it->second.begin(), it->second.end());
+    }
+  }
+  return std::min(std::max<int64_t>(bytes, 0), capacity_);
+}
+
+bool QueryAdmissionController::fitsLocked(int64_t bytes, int64_t cpuSlots)
+    const {
+  if (admitted_.empty()) {
+    return true;
+  }
+  if (stats_.admittedCpuSlots + cpuSlots > config_.maxCpuSlots) {
+    return false;
+  }
+  // The admitted queries may not have reached their predicted peaks yet, and
+  // memory may be used outside of them, so both must leave room.
+  const auto usedBytes = memoryManager_ == nullptr
+      ? 0
+      : memoryManager_->getTotalBytes();
+  return std::max(stats_.admittedBytes, usedBytes) + bytes <= capacity_;
+}
+
+void QueryAdmissionController::admitLocked(
+    const Request& request,
+    int64_t bytes) {
+  auto [it, inserted] = admitted_.try_emplace(request.queryId);
+  VELOX_CHECK(inserted, "Query {} is already admitted", request.queryId);
+  it->second = Admitted{bytes, request.cpuSlots, request.fingerprint};
+  stats_.admittedBytes += bytes;
+  stats_.admittedCpuSlots += request.cpuSlots;
+  ++stats_.numAdmitted;
+}
+
+bool QueryAdmissionController::admit(
+    const Request& request,
+    ContinueFuture* future) {
+  VELOX_CHECK_GE(request.priority, 0);
+  VELOX_CHECK_LT(request.priority, config_.numPriorities);
+  VELOX_CHECK_GT(request.cpuSlots, 0);
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(
+      admitted_.find(request.queryId) == admitted_.end(),
+      "Query {} is already admitted",
+      request.queryId);
+  const auto bytes = predictPeakBytesLocked(request);
+  // Queries that wait at the same or a higher priority go first.
+  bool queuedAhead = false;
+  for (auto priority = 0; priority <= request.priority; ++priority) {
+    queuedAhead |= !queues_[priority].empty();
+  }
+  if (!queuedAhead && fitsLocked(bytes, request.cpuSlots)) {
+    admitLocked(request, bytes);
+    return true;
+  }
+  Queued queued{request, bytes, ContinuePromise("QueryAdmissionController")};
+  *future = queued.promise.getSemiFuture();
+  queues_[request.priority].push_back(std::move(queued));
+  ++stats_.numQueued;
+  return false;
+}
+
+std::vector<ContinuePromise> QueryAdmissionController::admitQueuedLocked() {
+  std::vector<ContinuePromise> promises;
+  for (auto& queue : queues_) {
+    while (!queue.empty()) {
+      auto& queued = queue.front();
+      if (!fitsLocked(queued.bytes, queued.request.cpuSlots)) {
+        // Lower priorities wait for the higher ones.
+        return promises;
+      }
+      admitLocked(queued.request, queued.bytes);
+      ++stats_.numAdmittedAfterWait;
+      --stats_.numQueued;
+      promises.push_back(std::move(queued.promise));
+      queue.pop_front();
+    }
+  }
+  return promises;
+}
+
+void QueryAdmissionController::recordPeakLocked(
+    const std::string& fingerprint,
+    int64_t peakBytes) {
+  auto [it, inserted] = history_.try_emplace(fingerprint);
+  if (inserted) {
+    fingerprints_.push_back(fingerprint);
+    if (fingerprints_.size() > config_.maxFingerprints) {
+      history_.erase(fingerprints_.front());
+      fingerprints_.pop_front();
+    }
+  }
+  auto& runs = history_[fingerprint];
+  runs.push_back(peakBytes);
+  if (runs.size() > config_.maxRunsPerFingerprint) {
+    runs.pop_front();
+  }
+}
+
+void QueryAdmissionController::finish(
+    const std::string& queryId,
+    std::optional<int64_t> peakBytes) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = admitted_.find(queryId);
+    VELOX_CHECK(it != admitted_.end(), "Query {} is not admitted", queryId);
+    stats_.admittedBytes -= it->second.bytes;
+    stats_.admittedCpuSlots -= it->second.cpuSlots;
+    if (peakBytes.has_value() && !it->second.fingerprint.empty()) {
+      recordPeakLocked(it->second.fingerprint, peakBytes.value());
+    }
+    admitted_.erase(it);
+    promises = admitQueuedLocked();
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+bool QueryAdmissionController::cancel(const std::string& queryId) {
+  std::optional<ContinuePromise> promise;
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto& queue : queues_) {
+      auto it = std::find_if(queue.begin(), queue.end(), [&](auto& queued) {
+        return queued.request.queryId == queryId;
+      });
+      if (it != queue.end()) {
+        promise = std::move(it->promise);
+        queue.erase(it);
+        --stats_.numQueued;
+        break;
+      }
+    }
+    if (!promise.has_value()) {
+      return false;
+    }
+    // The cancelled query may have blocked the lower priorities.
+    promises = admitQueuedLocked();
+  }
+  promise->setException(std::runtime_error(
+      fmt::format("Query {} is cancelled while queued", queryId)));
+  for (auto& admittedPromise : promises) {
+    admittedPromise.setValue();
+  }
+  return true;
+}
+
+void QueryAdmissionController::update() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    promises = admitQueuedLocked();
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+QueryAdmissionController::Stats QueryAdmissionController::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numRunning = admitted_.size();
+  return stats;
+}
+
+} // namespace facebook::velox::memory
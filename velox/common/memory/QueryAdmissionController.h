@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/future/VeloxPromise.h"
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::memory {
+
+/// Admits queries based on their predicted peak memory and CPU use instead of
+/// letting all of them start and compete for memory through arbitration. The
+/// peak memory of a query is predicted from the peaks of the previous runs of
+/// the same fingerprint, e.g. a hash of the normalized plan, or from the
+/// caller's estimate of the plan if there are none. A query is admitted if
+/// its prediction fits in the capacity that is neither predicted for the
+/// admitted queries nor already used in the MemoryManager, and its CPU slots
+/// fit next to the admitted queries. The others wait in one FIFO queue per
+/// priority. Queries of a priority are only admitted when all queries of the
+/// higher priorities are, so that a large important query is not starved by
+/// small ones. A query is always admitted when no other query runs, so that a
+/// prediction above the capacity does not block forever.
+class QueryAdmissionController {
+ public:
+  struct Config {
+    /// Memory capacity shared by the admitted queries. 0 means the capacity of
+    /// the MemoryManager.
+    int64_t capacity{0};
+
+    /// CPU slots, e.g. Drivers, shared by the admitted queries.
+    int64_t maxCpuSlots{std::numeric_limits<int64_t>::max()};
+
+    /// Number of priorities. Priority 0 is admitted first.
+    int32_t numPriorities{3};
+
+    /// Predicted peak memory of a query without history or estimate.
+    int64_t defaultPeakBytes{256 << 20};
+
+    /// The prediction from history is the maximum peak of the last so many
+    /// runs of the fingerprint.
+    int32_t maxRunsPerFingerprint{8};
+
+    /// Maximum number of fingerprints with history. The oldest fingerprint is
+    /// forgotten first.
+    int32_t maxFingerprints{10'000};
+  };
+
+  struct Request {
+    std::string queryId;
+
+    /// Identifies the runs of the same query shape. No history is kept if
+    /// empty.
+    std::string fingerprint;
+
+    /// 0 to Config::numPriorities - 1.
+    int32_t priority{0};
+
+    /// Estimated peak memory from the plan, used if the fingerprint has no
+    /// history.
+    std::optional<int64_t> estimatedPeakBytes;
+
+    /// CPU slots the query uses while it runs.
+    int64_t cpuSlots{1};
+  };
+
+  struct Stats {
+    /// Number of running and queued queries.
+    int32_t numRunning{0};
+    int32_t numQueued{0};
+
+    /// Sum of the predictions and CPU slots of the running queries.
+    int64_t admittedBytes{0};
+    int64_t admittedCpuSlots{0};
+
+    /// Number of queries admitted so far and how many of them had to wait.
+    int64_t numAdmitted{0};
+    int64_t numAdmittedAfterWait{0};
+  };
+
+  /// 'memoryManager' is used for the default capacity and the current memory
+  /// usage. If nullptr, Config::capacity must be set and only the predictions
+  /// count.
+  explicit QueryAdmissionController(
+      const Config& config,
+      MemoryManager* memoryManager = nullptr);
+
+  /// Returns the predicted peak memory of 'request', capped at the capacity.
+  int64_t predictPeakBytes(const Request& request) const;
+
+  /// Returns true if 'request' is admitted. Otherwise queues it and sets
+  /// 'future', which is fulfilled when it is admitted or cancelled.
+  bool admit(const Request& request, ContinueFuture* future);
+
+  /// Releases the prediction and CPU slots of the admitted 'queryId' and
+  /// admits queued queries that fit. Adds 'peakBytes' to the history of its
+  /// fingerprint if set.
+  void finish(const std::string& queryId, std::optional<int64_t> peakBytes);
+
+  /// Removes the queued 'queryId' and fulfills its future with an error.
+  /// Returns false if the query is not queued.
+  bool cancel(const std::string& queryId);
+
+  /// Admits queued queries that fit, e.g. after memory is freed outside of
+  /// the admitted queries.
+  void update();
+
+  Stats stats() const;
+
+ private:
+  struct Admitted {
+    int64_t bytes;
+    int64_t cpuSlots;
+    std::string fingerprint;
+  };
+
+  struct Queued {
+    Request request;
+    int64_t bytes;
+    ContinuePromise promise;
+  };
+
+  int64_t predictPeakBytesLocked(const Request& request) const;
+
+  bool fitsLocked(int64_t bytes, int64_t cpuSlots) const;
+
+  void admitLocked(const Request& request, int64_t bytes);
+
+  // Moves the queued queries that fit to the admitted ones and returns their
+  // promises to fulfill outside of the lock.
+  std::vector<ContinuePromise> admitQueuedLocked();
+
+  void recordPeakLocked(const std::string& fingerprint, int64_t peakBytes);
+
+  const Config config_;
+  MemoryManager* const memoryManager_;
+  const int64_t capacity_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Admitted> admitted_;
+  std::vector<std::deque<Queued>> queues_;
+  // Peaks of the last runs by fingerprint, most recent last.
+  folly::F14FastMap<std::string, std::deque<int64_t>> history_;
+  // Fingerprints in 'history_' in order of first run.
+  std::deque<std::string> fingerprints_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::memory
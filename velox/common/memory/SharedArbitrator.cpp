@@ -243,6 +243,25 @@ bool SharedArbitrator::ExtraConfig::globalArbitrationWithoutSpill(
       kDefaultGlobalArbitrationWithoutSpill);
 }
 
+uint64_t SharedArbitrator::ExtraConfig::proactiveReclaimIntervalNs(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             config::toDuration(
+                 getConfig<std::string>(
+                     configs,
+                     kProactiveReclaimInterval,
+                     std::string(kDefaultProactiveReclaimInterval))))
+      .count();
+}
+
+uint32_t SharedArbitrator::ExtraConfig::proactiveReclaimFreeCapacityPct(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return getConfig<uint32_t>(
+      configs,
+      kProactiveReclaimFreeCapacityPct,
+      kDefaultProactiveReclaimFreeCapacityPct);
+}
+
 double SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(
     const std::unordered_map<std::string, std::string>& configs) {
   return getConfig<double>(
@@ -279,6 +298,10 @@ SharedArbitrator::SharedArbitrator(const Config& config)
           ExtraConfig::globalArbitrationAbortTimeRatio(config.extraConfigs)),
       globalArbitrationWithoutSpill_(
           ExtraConfig::globalArbitrationWithoutSpill(config.extraConfigs)),
+      proactiveReclaimIntervalNs_(
+          ExtraConfig::proactiveReclaimIntervalNs(config.extraConfigs)),
+      proactiveReclaimFreeCapacityPct_(
+          ExtraConfig::proactiveReclaimFreeCapacityPct(config.extraConfigs)),
       freeReservedCapacity_(reservedCapacity_),
       freeNonReservedCapacity_(capacity_ - freeReservedCapacity_) {
   VELOX_CHECK_EQ(kind_, config.kind);
@@ -290,6 +313,10 @@ SharedArbitrator::SharedArbitrator(const Config& config)
       globalArbitrationMemoryReclaimPct_,
       100,
       "Invalid globalArbitrationMemoryReclaimPct");
+  VELOX_CHECK_LE(
+      proactiveReclaimFreeCapacityPct_,
+      100,
+      "Invalid proactiveReclaimFreeCapacityPct");
 
   VELOX_CHECK_GT(
       memoryReclaimThreadsHwMultiplier_,
@@ -1045,18 +1072,29 @@ void SharedArbitrator::updateGlobalArbitrationStats(
 void SharedArbitrator::globalArbitrationMain() {
   VELOX_MEM_LOG(INFO) << "Global arbitration controller started";
   while (true) {
+    bool proactiveReclaim{false};
     {
       std::unique_lock<std::mutex> l(stateMutex_);
-      globalArbitrationThreadCv_.wait(l, [&] {
+      const auto wakeup = [&] {
         return hasShutdownLocked() || !globalArbitrationWaiters_.empty();
-      });
+      };
+      if (proactiveReclaimIntervalNs_ == 0) {
+        globalArbitrationThreadCv_.wait(l, wakeup);
+      } else {
+        proactiveReclaim = !globalArbitrationThreadCv_.wait_for(
+            l, std::chrono::nanoseconds(proactiveReclaimIntervalNs_), wakeup);
+      }
       if (hasShutdownLocked()) {
         VELOX_CHECK(globalArbitrationWaiters_.empty());
         break;
       }
     }
     GlobalArbitrationSection section{this};
-    runGlobalArbitration();
+    if (proactiveReclaim) {
+      runProactiveReclaim();
+    } else {
+      runGlobalArbitration();
+    }
   }
   VELOX_MEM_LOG(INFO) << "Global arbitration controller stopped";
 }
@@ -1124,6 +1162,45 @@ void SharedArbitrator::runGlobalArbitration() {
                       << " with " << round << " rounds";
 }
 
+void SharedArbitrator::runProactiveReclaim() {
+  const uint64_t nowNs = getCurrentTimeNano();
+  uint64_t predictedGrowBytes{0};
+  for (const auto& candidate : getCandidates(/*freeCapacityOnly=*/true)) {
+    candidate.participant->sampleUsage(nowNs);
+    predictedGrowBytes +=
+        candidate.participant->predictGrowCapacity(proactiveReclaimIntervalNs_);
+  }
+  const uint64_t minFreeBytes =
+      capacity_ * proactiveReclaimFreeCapacityPct_ / 100;
+  const uint64_t freeBytes = freeNonReservedCapacity_ + freeReservedCapacity_;
+  if (freeBytes >= minFreeBytes + predictedGrowBytes) {
+    return;
+  }
+  const uint64_t targetBytes = minFreeBytes + predictedGrowBytes - freeBytes;
+
+  TestValue::adjust(
+      "facebook::velox::memory::SharedArbitrator::runProactiveReclaim", this);
+
+  uint64_t reclaimedBytes{0};
+  uint64_t reclaimTimeNs{0};
+  {
+    NanosecondTimer timer(&reclaimTimeNs);
+    reclaimedBytes = reclaimUnusedCapacity();
+    if (reclaimedBytes < targetBytes && !globalArbitrationWithoutSpill_) {
+      reclaimedBytes += reclaimUsedMemoryBySpill(targetBytes - reclaimedBytes);
+    }
+  }
+  ++proactiveReclaimRuns_;
+  proactiveReclaimBytes_ += reclaimedBytes;
+  RECORD_METRIC_VALUE(kMetricArbitratorProactiveReclaimCount);
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kMetricArbitratorProactiveReclaimBytes, reclaimedBytes);
+  VELOX_MEM_LOG(INFO) << "Proactive reclaim reclaimed "
+                      << succinctBytes(reclaimedBytes) << " with target "
+                      << succinctBytes(targetBytes) << ", spent "
+                      << succinctNanos(reclaimTimeNs);
+}
+
 uint64_t SharedArbitrator::getGlobalArbitrationTarget() {
   uint64_t targetBytes{0};
   std::lock_guard<std::mutex> l(stateMutex_);
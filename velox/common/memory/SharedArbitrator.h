@@ -242,6 +242,27 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     static bool globalArbitrationWithoutSpill(
         const std::unordered_map<std::string, std::string>& configs);
 
+    /// If not zero, the global arbitration thread wakes up at this interval to
+    /// forecast the memory demand of the running queries from their usage
+    /// growth rate over the next interval. If the forecast leaves less free
+    /// capacity than 'proactive-reclaim-free-capacity-pct', it reclaims the
+    /// difference in the background, first from unused capacity and then by
+    /// spilling low priority queries, before arbitration requests have to wait
+    /// for it. It is only in effect when 'global-arbitration-enabled' is true.
+    static constexpr std::string_view kProactiveReclaimInterval{
+        "proactive-reclaim-interval"};
+    static constexpr std::string_view kDefaultProactiveReclaimInterval{"0ms"};
+    static uint64_t proactiveReclaimIntervalNs(
+        const std::unordered_map<std::string, std::string>& configs);
+
+    /// The free capacity, as percentage of the total arbitrator memory
+    /// capacity, that the proactive reclaim tries to keep.
+    static constexpr std::string_view kProactiveReclaimFreeCapacityPct{
+        "proactive-reclaim-free-capacity-pct"};
+    static constexpr uint32_t kDefaultProactiveReclaimFreeCapacityPct{10};
+    static uint32_t proactiveReclaimFreeCapacityPct(
+        const std::unordered_map<std::string, std::string>& configs);
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -420,6 +441,13 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // Invoked by global arbitration control thread to run global arbitration.
   void runGlobalArbitration();
 
+  // Invoked by global arbitration control thread every
+  // 'proactiveReclaimIntervalNs_' without pending global arbitration requests.
+  // It samples the memory usage of the participants and reclaims memory if
+  // their predicted growth over the next interval would leave less than
+  // 'proactiveReclaimFreeCapacityPct_' of free capacity.
+  void runProactiveReclaim();
+
   // Helper method used by 'runGlobalArbitration()' to decide if current
   // iteration of global run should directly reclaim capacity by aborting
   // queries.
@@ -639,6 +667,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   const uint32_t globalArbitrationMemoryReclaimPct_;
   const double globalArbitrationAbortTimeRatio_;
   const bool globalArbitrationWithoutSpill_;
+  const uint64_t proactiveReclaimIntervalNs_;
+  const uint32_t proactiveReclaimFreeCapacityPct_;
 
   // The executor used to reclaim memory from multiple participants in parallel
   // at the background for global arbitration or external memory reclamation.
@@ -701,6 +731,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   tsan_atomic<uint64_t> globalArbitrationTimeNs_{0};
   tsan_atomic<uint64_t> globalArbitrationBytes_{0};
 
+  tsan_atomic<uint64_t> proactiveReclaimRuns_{0};
+  tsan_atomic<uint64_t> proactiveReclaimBytes_{0};
+
   std::atomic_uint64_t numRequests_{0};
   std::atomic_uint32_t numRunning_{0};
   std::atomic_uint64_t numAborted_{0};
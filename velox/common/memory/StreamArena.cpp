@@ -74,4 +74,25 @@ void StreamArena::clear() {
   size_ = 0;
 }
 
+void StreamArena::transferTo(StreamArena& other) {
+  VELOX_CHECK_NE(this, &other);
+  VELOX_CHECK_EQ(pool_, other.pool_);
+  for (auto& allocation : allocations_) {
+    other.allocations_.push_back(std::move(allocation));
+  }
+  allocations_.clear();
+  if (!allocation_.empty()) {
+    other.allocations_.push_back(
+        std::make_unique<memory::Allocation>(std::move(allocation_)));
+  }
+  currentRun_ = 0;
+  currentOffset_ = 0;
+  for (auto& largeAllocation : largeAllocations_) {
+    other.largeAllocations_.push_back(std::move(largeAllocation));
+  }
+  largeAllocations_.clear();
+  other.size_ += size_;
+  size_ = 0;
+}
+
 } // namespace facebook::velox
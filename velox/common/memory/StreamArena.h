@@ -62,6 +62,12 @@ class StreamArena {
   /// serilizers.
   virtual void clear();
 
+  /// Moves the memory held by 'this' to 'other' and leaves 'this' in
+  /// post-construction state. The ranges given out by 'this' stay valid for
+  /// the lifetime of 'other'. Used to hand the memory of a serialized page
+  /// over to the IOBufs that reference it.
+  void transferTo(StreamArena& other);
+
   memory::MachinePageCount testingAllocationQuantum() const {
     return allocationQuantum_;
   }
@@ -1100,6 +1100,39 @@ TEST_F(ArbitrationParticipantTest, checkCapacityGrowth) {
   }
 }
 
+TEST_F(ArbitrationParticipantTest, usageGrowthForecast) {
+  constexpr uint64_t kSecondNs = 1'000'000'000;
+  constexpr uint64_t kUsedBytes = 32 * MB;
+  auto task = createTask(kMemoryCapacity);
+  const auto config = arbitrationConfig();
+  auto participant = ArbitrationParticipant::create(10, task->pool(), &config);
+  auto scopedParticipant = participant->lock().value();
+  scopedParticipant->shrink(/*reclaimAll=*/true);
+  scopedParticipant->grow(64 * MB, 0);
+  ASSERT_EQ(scopedParticipant->usageGrowthRate(), 0);
+  ASSERT_EQ(scopedParticipant->predictGrowCapacity(kSecondNs), 0);
+
+  // The first sample has nothing to compare with.
+  scopedParticipant->sampleUsage(kSecondNs);
+  ASSERT_EQ(scopedParticipant->usageGrowthRate(), 0);
+
+  // 32MB growth in one second is smoothed to 16MB/s.
+  auto* buffer = task->allocate(kUsedBytes);
+  scopedParticipant->sampleUsage(2 * kSecondNs);
+  ASSERT_EQ(scopedParticipant->usageGrowthRate(), 16 * MB);
+  ASSERT_EQ(scopedParticipant->predictGrowCapacity(kSecondNs), 0);
+  ASSERT_EQ(scopedParticipant->predictGrowCapacity(4 * kSecondNs), kUsedBytes);
+  ASSERT_EQ(
+      scopedParticipant->predictGrowCapacity(1'000 * kSecondNs),
+      kMemoryCapacity - 64 * MB);
+
+  // Shrinking usage counts as no growth and decays the rate.
+  task->free(buffer);
+  scopedParticipant->sampleUsage(3 * kSecondNs);
+  ASSERT_EQ(scopedParticipant->usageGrowthRate(), 8 * MB);
+  ASSERT_EQ(scopedParticipant->predictGrowCapacity(4 * kSecondNs), 0);
+}
+
 TEST_F(ArbitrationParticipantTest, grow) {
   struct {
     uint64_t maxCapacity;
@@ -137,6 +137,72 @@ TEST_F(ByteStreamTest, outputStream) {
   EXPECT_EQ(0, mmapAllocator_->numAllocated());
 }
 
+TEST_F(ByteStreamTest, outputStreamReferencesArena) {
+  auto source = newArena();
+  ByteOutputStream values(source.get());
+  values.startWrite(8192);
+  for (int64_t i = 0; i < 10'000; ++i) {
+    values.appendOne(i);
+  }
+  ByteOutputStream small(source.get());
+  small.startWrite(10);
+  small.appendOne<int32_t>(7);
+
+  std::shared_ptr<StreamArena> pageArena = newArena();
+  auto out = std::make_unique<IOBufOutputStream>(*pool_);
+  out->referenceArena(source.get(), pageArena);
+  std::stringstream referenceSStream;
+  OStreamOutputStream reference(&referenceSStream);
+  const std::vector<OutputStream*> streams{&reference, out.get()};
+  const int32_t header = 0;
+  for (auto* stream : streams) {
+    stream->write(reinterpret_cast<const char*>(&header), sizeof(header));
+    small.flush(stream);
+    values.flush(stream);
+    stream->write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  ASSERT_EQ(reference.tellp(), out->tellp());
+
+  // Fix up the header in place and seek back to the end.
+  const int32_t size = out->tellp();
+  for (auto* stream : streams) {
+    stream->seekp(0);
+    stream->write(reinterpret_cast<const char*>(&size), sizeof(size));
+    stream->seekp(size);
+  }
+  ASSERT_EQ(size, out->tellp());
+  VELOX_ASSERT_THROW(
+      out->seekp(sizeof(header) + sizeof(int32_t) + 1),
+      "Cannot seek into referenced bytes of IOBufOutputStream");
+
+  source->transferTo(*pageArena);
+  EXPECT_EQ(0, source->size());
+  source->clear();
+  pageArena = nullptr;
+
+  auto iobuf = out->getIOBuf();
+  out = nullptr;
+  // The small stream is copied and the first range of the other one is
+  // referenced.
+  std::vector<const uint8_t*> buffers;
+  for (auto range : *iobuf) {
+    buffers.push_back(range.data());
+  }
+  EXPECT_NE(
+      std::find(buffers.begin(), buffers.end(), values.ranges()[0].buffer),
+      buffers.end());
+  EXPECT_EQ(
+      std::find(buffers.begin(), buffers.end(), small.ranges()[0].buffer),
+      buffers.end());
+  auto data = iobuf->coalesce();
+  EXPECT_EQ(
+      referenceSStream.str(),
+      std::string(reinterpret_cast<const char*>(data.data()), data.size()));
+
+  iobuf = nullptr;
+  EXPECT_EQ(0, mmapAllocator_->numAllocated());
+}
+
 TEST_F(ByteStreamTest, bufferedOutputStream) {
   auto arena = newArena();
   auto out = std::make_unique<IOBufOutputStream>(*pool_, nullptr, 10000);
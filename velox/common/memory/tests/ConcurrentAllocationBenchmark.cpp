@@ -38,6 +38,14 @@ DEFINE_uint32(
     memory_allocation_type,
     0,
     "The type of memory allocation. 0 is small allocation, 1 non-contiguous allocation");
+DEFINE_uint64(
+    reservation_cache_bytes,
+    0,
+    "The reserved bytes cached per thread shard of a thread-safe leaf memory pool");
+DEFINE_bool(
+    share_leaf_pool,
+    false,
+    "If true, all the memory threads allocate from one leaf memory pool");
 DEFINE_uint32(
     num_runs,
     32,
@@ -50,15 +58,14 @@ namespace {
 class MemoryOperator {
  public:
   MemoryOperator(
-      MemoryManager* memoryManager,
+      std::shared_ptr<MemoryPool> pool,
       uint64_t maxMemory,
       uint64_t allocationSize,
       uint32_t maxOps)
       : maxMemory_(maxMemory),
         allocationBytes_(allocationSize),
         maxOps_(maxOps),
-        pool_(memoryManager->addLeafPool(
-            fmt::format("MemoryOperator{}", poolId_++))) {
+        pool_(std::move(pool)) {
     rng_.seed(1234);
   }
 
@@ -98,8 +105,6 @@ class MemoryOperator {
 
   void freeNonContiguousAllocation(NonContiguousAllocation& allocation);
 
-  static inline int32_t poolId_{0};
-
   const uint64_t maxMemory_;
   const size_t allocationBytes_;
   const uint32_t allocationType_{FLAGS_memory_allocation_type};
@@ -210,6 +215,8 @@ class MemoryAllocationBenchMark {
     uint64_t allocationBytes;
     uint32_t numThreads;
     uint32_t numOpsPerThread;
+    uint64_t reservationCacheBytes;
+    bool shareLeafPool;
   };
 
   explicit MemoryAllocationBenchMark(const Options& options)
@@ -217,6 +224,8 @@ class MemoryAllocationBenchMark {
     const int64_t maxMemory = options_.maxMemory + (256 << 20);
     MemoryManager::Options memoryManagerOptions;
     memoryManagerOptions.allocatorCapacity = maxMemory;
+    memoryManagerOptions.leafReservationCacheBytes =
+        options_.reservationCacheBytes;
     switch (options_.allocatorType) {
       case Type::kMmap: {
         memoryManagerOptions.useMmapAllocator = true;
@@ -245,6 +254,8 @@ class MemoryAllocationBenchMark {
     uint64_t clockCount;
   };
 
+  static inline int32_t poolId_{0};
+
   const Options options_;
   std::shared_ptr<MemoryManager> manager_;
   std::vector<Result> results_;
@@ -257,11 +268,18 @@ void MemoryAllocationBenchMark::run() {
   operators.reserve(options_.numThreads);
   uint64_t runTimeUs{0};
   uint64_t clockCount{0};
+  std::shared_ptr<MemoryPool> sharedPool;
+  if (options_.shareLeafPool) {
+    sharedPool = manager_->addLeafPool(fmt::format("SharedPool{}", poolId_++));
+  }
   {
     MicrosecondTimer clock(&runTimeUs);
     for (int i = 0; i < options_.numThreads; ++i) {
       auto memOp = std::make_unique<MemoryOperator>(
-          manager_.get(),
+          sharedPool != nullptr
+              ? sharedPool
+              : manager_->addLeafPool(
+                    fmt::format("MemoryOperator{}", poolId_++)),
           options_.maxMemory / options_.numThreads,
           options_.allocationBytes,
           options_.numOpsPerThread);
@@ -305,6 +323,8 @@ int main(int argc, char* argv[]) {
       ? MemoryAllocationBenchMark::Type::kMalloc
       : MemoryAllocationBenchMark::Type::kMmap;
   options.numOpsPerThread = FLAGS_num_allocations_per_thread;
+  options.reservationCacheBytes = FLAGS_reservation_cache_bytes;
+  options.shareLeafPool = FLAGS_share_leaf_pool;
   auto benchmark = std::make_unique<MemoryAllocationBenchMark>(options);
   for (int i = 0; i < FLAGS_num_runs; ++i) {
     benchmark->run();
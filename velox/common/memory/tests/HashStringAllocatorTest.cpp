@@ -339,6 +339,81 @@ TEST_F(HashStringAllocatorTest, multipart) {
   ASSERT_EQ(allocatedBytes, allocator_->currentBytes());
 }
 
+TEST_F(HashStringAllocatorTest, compact) {
+  constexpr int32_t kNumSamples = 10'000;
+  std::vector<Multipart> data(kNumSamples);
+  std::vector<StringView> views;
+  for (auto count = 0; count < 2; ++count) {
+    for (auto i = 0; i < kNumSamples; ++i) {
+      auto chars = randomString();
+      ByteOutputStream stream(allocator_.get());
+      if (data[i].start.header) {
+        allocator_->extendWrite(data[i].current, stream);
+      } else {
+        data[i].start = allocator_->newWrite(stream, chars.size());
+        data[i].current = data[i].start;
+      }
+      stream.appendStringView(chars);
+      data[i].current = allocator_->finishWrite(stream, rand32() % 100).second;
+      data[i].reference.insert(
+          data[i].reference.end(), chars.begin(), chars.end());
+    }
+  }
+  for (auto i = 0; i < 1'000; ++i) {
+    std::string str(24 + i % 100, 'a' + i % 26);
+    views.push_back(StringView(str));
+    allocator_->copyMultipart(views[i], reinterpret_cast<char*>(&views[i]), 0);
+  }
+  // Frees most of the data to leave the slabs fragmented.
+  for (auto i = 0; i < kNumSamples; ++i) {
+    if (i % 4 != 0) {
+      checkAndFree(data[i]);
+    }
+  }
+
+  ASSERT_FALSE(allocator_->canCompact());
+  int32_t numCallbacks = 0;
+  allocator_->setRelocationCallback([&](const HSA::Relocations& relocations) {
+    ++numCallbacks;
+    ASSERT_GT(relocations.size(), 0);
+    for (auto& d : data) {
+      if (d.start.isSet()) {
+        d.start = relocations.relocate(d.start);
+        d.current = relocations.relocate(d.current);
+      }
+    }
+    for (auto& view : views) {
+      view = relocations.relocate(view);
+    }
+  });
+  ASSERT_TRUE(allocator_->canCompact());
+  const auto retainedSize = allocator_->retainedSize();
+  const auto freedBytes = allocator_->compact();
+  ASSERT_EQ(numCallbacks, 1);
+  ASSERT_GT(freedBytes, 0);
+  ASSERT_EQ(allocator_->retainedSize(), retainedSize - freedBytes);
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+
+  for (auto i = 0; i < views.size(); ++i) {
+    ASSERT_EQ(views[i], StringView(std::string(24 + i % 100, 'a' + i % 26)));
+  }
+  // The moved multipart data can be read and appended to.
+  for (auto& d : data) {
+    if (!d.start.isSet()) {
+      continue;
+    }
+    checkMultipart(d);
+    auto chars = randomString();
+    ByteOutputStream stream(allocator_.get());
+    allocator_->extendWrite(d.current, stream);
+    stream.appendStringView(chars);
+    d.current = allocator_->finishWrite(stream, 0).second;
+    d.reference.insert(d.reference.end(), chars.begin(), chars.end());
+    checkMultipart(d);
+  }
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+}
+
 TEST_F(HashStringAllocatorTest, mixedMultipart) {
   // Create multi-part allocation with a mix of block allocated from Arena and
   // MemoryPool.
@@ -1466,6 +1466,40 @@ TEST_P(MemoryAllocatorTest, contiguousAllocation) {
   allocation->clear();
 }
 
+TEST_P(MemoryAllocatorTest, hugePageContiguousAllocation) {
+  const auto statsBefore = instance_->stats();
+  const MachinePageCount kNumPages = 2 * AllocationTraits::numPagesInHugePage();
+  ContiguousAllocation allocation;
+  ASSERT_TRUE(instance_->allocateContiguous(
+      kNumPages, nullptr, allocation, nullptr, 0, true));
+  ASSERT_EQ(allocation.numPages(), kNumPages);
+  ASSERT_EQ(
+      reinterpret_cast<uint64_t>(allocation.data()) %
+          AllocationTraits::kHugePageSize,
+      0);
+  ASSERT_EQ(
+      allocation.hugePageRange().value().size(),
+      AllocationTraits::pageBytes(kNumPages));
+  ::memset(allocation.data(), 1, allocation.size());
+
+  // Below a huge page, the allocation gets standard pages.
+  ContiguousAllocation smallAllocation;
+  ASSERT_TRUE(instance_->allocateContiguous(
+      instance_->largestSizeClass() + 1,
+      nullptr,
+      smallAllocation,
+      nullptr,
+      0,
+      true));
+
+  const auto stats = instance_->stats() - statsBefore;
+  ASSERT_EQ(stats.numHugePageAllocations, 1);
+  ASSERT_EQ(stats.hugePageBytes, AllocationTraits::pageBytes(kNumPages));
+  ASSERT_EQ(stats.numHugePageFallbacks, 0);
+  instance_->freeContiguous(allocation);
+  instance_->freeContiguous(smallAllocation);
+}
+
 TEST_P(MemoryAllocatorTest, allocatorCapacity) {
   const std::vector<size_t> preExistingBytesVec{
       0, kCapacityBytes / 2, kCapacityBytes / 4 * 3};
@@ -1993,4 +2027,130 @@ TEST_F(MmapConfigTest, sizeClasses) {
   }
 }
 
+namespace {
+// Allocates the whole capacity of 'allocator' in runs of the largest size
+// class.
+std::vector<Allocation> allocateAll(MmapAllocator& allocator) {
+  const auto numPages = allocator.sizeClasses().back();
+  std::vector<Allocation> allocations(
+      AllocationTraits::numPages(allocator.capacity()) / numPages);
+  for (auto& allocation : allocations) {
+    VELOX_CHECK(
+        allocator.allocateNonContiguous(numPages, allocation, nullptr, 0));
+  }
+  return allocations;
+}
+} // namespace
+
+TEST(MmapTrimTest, trimToWatermarks) {
+  MmapAllocator::Options options;
+  options.capacity = 64 << 20;
+  MmapAllocator allocator(options);
+  const auto capacityPages = AllocationTraits::numPages(allocator.capacity());
+  const auto highWatermark = capacityPages / 100 * options.trimHighWatermarkPct;
+
+  auto allocations = allocateAll(allocator);
+  EXPECT_EQ(allocator.numMapped(), capacityPages);
+  // Within the warm reserve, nothing is trimmed.
+  allocator.freeNonContiguous(allocations.back());
+  EXPECT_EQ(allocator.testingTrim(), 0);
+
+  for (auto& allocation : allocations) {
+    allocator.freeNonContiguous(allocation);
+  }
+  const auto numTrimmed = allocator.testingTrim();
+  EXPECT_GE(numTrimmed, highWatermark);
+  EXPECT_LT(numTrimmed, highWatermark + allocator.sizeClasses().back());
+  EXPECT_EQ(allocator.numMapped(), capacityPages - numTrimmed);
+  // The pages that can be mapped are above the low watermark.
+  EXPECT_EQ(allocator.testingTrim(), 0);
+  EXPECT_TRUE(allocator.checkConsistency());
+
+  const auto stats = allocator.stats();
+  EXPECT_EQ(stats.numBackgroundTrims, 1);
+  EXPECT_EQ(stats.numBackgroundTrimmedPages, numTrimmed);
+  EXPECT_EQ(stats.numAdvise, numTrimmed);
+}
+
+TEST(MmapTrimTest, backgroundTrim) {
+  MmapAllocator::Options options;
+  options.capacity = 64 << 20;
+  options.backgroundTrim = true;
+  options.trimIntervalMs = 10;
+  MmapAllocator allocator(options);
+  const auto capacityPages = AllocationTraits::numPages(allocator.capacity());
+
+  auto allocations = allocateAll(allocator);
+  for (auto& allocation : allocations) {
+    allocator.freeNonContiguous(allocation);
+  }
+  for (auto i = 0; i < 1'000 && allocator.stats().numBackgroundTrims == 0;
+       ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  EXPECT_GT(allocator.stats().numBackgroundTrims, 0);
+  EXPECT_LT(allocator.numMapped(), capacityPages);
+
+  // The memory advised away in the background is allocated again.
+  allocations = allocateAll(allocator);
+  EXPECT_EQ(allocator.numAllocated(), capacityPages);
+  for (auto& allocation : allocations) {
+    allocator.freeNonContiguous(allocation);
+  }
+  EXPECT_TRUE(allocator.checkConsistency());
+}
+
+TEST(MmapNumaTest, numaNodes) {
+  MmapAllocator::Options options;
+  options.capacity = 256 << 20;
+  options.numNumaNodes = 2;
+  MmapAllocator allocator(options);
+  const auto numPages = allocator.sizeClasses().back();
+
+  std::vector<Allocation> allocations(2);
+  for (auto node = 0; node < 2; ++node) {
+    ScopedNumaNode numaScope(node);
+    EXPECT_EQ(threadNumaNode(), node);
+    ASSERT_TRUE(allocator.allocateNonContiguous(
+        numPages, allocations[node], nullptr, 0));
+    EXPECT_EQ(allocations[node].numPages(), numPages);
+  }
+  // The nodes have separate size classes, so the same request gets memory from
+  // different address ranges, each with the capacity of the whole allocator.
+  const auto* first = allocations[0].runAt(0).data();
+  const auto* second = allocations[1].runAt(0).data();
+  EXPECT_GE(
+      std::abs(first - second),
+      static_cast<int64_t>(allocator.capacity() / 2));
+  EXPECT_EQ(allocator.numAllocated(), 2 * numPages);
+  EXPECT_TRUE(allocator.checkConsistency());
+
+  for (auto& allocation : allocations) {
+    allocator.freeNonContiguous(allocation);
+  }
+  EXPECT_EQ(allocator.numAllocated(), 0);
+  EXPECT_TRUE(allocator.checkConsistency());
+}
+
+TEST(MmapNumaTest, poolNumaNode) {
+  MemoryManager::Options options;
+  options.useMmapAllocator = true;
+  options.allocatorCapacity = 256 << 20;
+  options.numNumaNodes = 2;
+  MemoryManager manager(options);
+  auto root = manager.addRootPool("numaRoot", kMaxMemory, nullptr, {}, 1);
+  EXPECT_EQ(root->numaNode(), 1);
+  auto leaf = root->addLeafChild("numaLeaf");
+  EXPECT_EQ(leaf->numaNode(), 1);
+  EXPECT_EQ(manager.addRootPool("root")->numaNode(), kNoNumaNode);
+
+  ScopedNumaNode numaScope(0);
+  Allocation allocation;
+  leaf->allocateNonContiguous(16, allocation);
+  // The allocation is made on the node of the pool and the node of the thread
+  // is restored.
+  EXPECT_EQ(threadNumaNode(), 0);
+  leaf->freeNonContiguous(allocation);
+}
+
 } // namespace facebook::velox::memory
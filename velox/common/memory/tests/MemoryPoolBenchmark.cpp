@@ -15,6 +15,7 @@
  */
 
 #include <folly/futures/Future.h>
+#include <array>
 #include <limits>
 
 #include "folly/Benchmark.h"
@@ -238,6 +239,51 @@ BENCHMARK(FlatSticks, iters) {
   });
 }
 
+namespace {
+// Allocates and frees small buffers from many threads sharing one thread-safe
+// leaf memory pool with a reservation cache of 'reservationCacheBytes' per
+// thread shard.
+void runSharedLeaf(size_t iters, int64_t reservationCacheBytes) {
+  folly::BenchmarkSuspender suspender;
+  constexpr int32_t kNumThreads = 64;
+  constexpr int32_t kNumLiveBuffers = 16;
+  constexpr int64_t kBufferSize = 4096;
+  MemoryManager::Options options;
+  options.leafReservationCacheBytes = reservationCacheBytes;
+  MemoryManager manager{options};
+  auto root = manager.addRootPool("shared_leaf");
+  auto leaf = root->addLeafChild("leaf");
+  folly::CPUThreadPoolExecutor threadPool(kNumThreads);
+  suspender.dismiss();
+  for (int32_t i = 0; i < kNumThreads; ++i) {
+    threadPool.add([&]() {
+      std::array<void*, kNumLiveBuffers> buffers{};
+      for (size_t j = 0; j < iters; ++j) {
+        auto& buffer = buffers[j % kNumLiveBuffers];
+        if (buffer != nullptr) {
+          leaf->free(buffer, kBufferSize);
+        }
+        buffer = leaf->allocate(kBufferSize);
+      }
+      for (auto* buffer : buffers) {
+        if (buffer != nullptr) {
+          leaf->free(buffer, kBufferSize);
+        }
+      }
+    });
+  }
+  threadPool.join();
+}
+} // namespace
+
+BENCHMARK(SharedLeafAlloc, iters) {
+  runSharedLeaf(iters, 0);
+}
+
+BENCHMARK_RELATIVE(SharedLeafAllocReservationCache, iters) {
+  runSharedLeaf(iters, 1 << 20);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   folly::runBenchmarks();
@@ -2578,6 +2578,168 @@ TEST_P(MemoryPoolTest, concurrentUpdatesToTheSamePool) {
   ASSERT_EQ(root->stats().usedBytes, 0);
 }
 
+TEST_P(MemoryPoolTest, reservationCache) {
+  MemoryManager::Options options;
+  options.leafReservationCacheBytes = 256 * KB;
+  setupMemory(options);
+  auto root = getMemoryManager()->addRootPool("reservationCache");
+  auto leaf = root->addLeafChild("leaf", /*threadSafe=*/true);
+  auto* leafImpl = static_cast<MemoryPoolImpl*>(leaf.get());
+  const int64_t kChunkSize{128};
+
+  // The first allocation reserves a quantized chunk and moves part of the
+  // unused reservation into the shard of this thread.
+  void* buf1 = leaf->allocate(kChunkSize);
+  ASSERT_EQ(leaf->usedBytes(), kChunkSize);
+  ASSERT_EQ(leaf->reservedBytes(), 1 * MB);
+  ASSERT_EQ(leafImpl->testingCachedReservationBytes(), 256 * KB);
+
+  // The next allocation is served from the shard.
+  void* buf2 = leaf->allocate(kChunkSize);
+  ASSERT_EQ(leaf->usedBytes(), 2 * kChunkSize);
+  ASSERT_EQ(leaf->reservedBytes(), 1 * MB);
+  ASSERT_EQ(leafImpl->testingCachedReservationBytes(), 256 * KB - kChunkSize);
+  ASSERT_EQ(leaf->stats().cumulativeBytes, 2 * kChunkSize);
+  ASSERT_EQ(leaf->stats().peakBytes, 2 * kChunkSize);
+
+  // The frees go back to the shard which keeps the reservation.
+  leaf->free(buf1, kChunkSize);
+  leaf->free(buf2, kChunkSize);
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), 1 * MB);
+  ASSERT_EQ(root->reservedBytes(), 1 * MB);
+  ASSERT_EQ(leafImpl->testingCachedReservationBytes(), 256 * KB);
+  ASSERT_EQ(leaf->releasableReservation(), 1 * MB);
+
+  // release() gives the cached reservation back.
+  leaf->release();
+  ASSERT_EQ(leafImpl->testingCachedReservationBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+
+  // A free that doesn't fit into the shard goes through the pool.
+  void* buf3 = leaf->allocate(512 * KB);
+  ASSERT_EQ(leaf->reservedBytes(), 1 * MB);
+  ASSERT_EQ(leafImpl->testingCachedReservationBytes(), 256 * KB);
+  leaf->free(buf3, 512 * KB);
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), 1 * MB);
+  ASSERT_EQ(leafImpl->testingCachedReservationBytes(), 256 * KB);
+
+  // Destruction gives the cached reservation back.
+  leaf.reset();
+  ASSERT_EQ(root->reservedBytes(), 0);
+
+  // Non-thread-safe leaf pools don't cache.
+  auto nonThreadSafeLeaf = root->addLeafChild("nonThreadSafe", false);
+  void* buf4 = nonThreadSafeLeaf->allocate(kChunkSize);
+  ASSERT_EQ(
+      static_cast<MemoryPoolImpl*>(nonThreadSafeLeaf.get())
+          ->testingCachedReservationBytes(),
+      0);
+  nonThreadSafeLeaf->free(buf4, kChunkSize);
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
+TEST_P(MemoryPoolTest, concurrentUpdatesToTheSamePoolWithReservationCache) {
+  MemoryManager::Options options;
+  options.leafReservationCacheBytes = 64 * KB;
+  setupMemory(options);
+  constexpr int64_t kMaxMemory = 8 * GB;
+  auto root = getMemoryManager()->addRootPool();
+  auto leaf = root->addLeafChild("leaf", /*threadSafe=*/true);
+
+  const int32_t kNumThreads = 16;
+  const int32_t kNumOpsPerThread = 5'00;
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      MemoryPoolTester tester(i, kMaxMemory, *leaf);
+      for (int32_t iter = 0; iter < kNumOpsPerThread; ++iter) {
+        tester.run();
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  ASSERT_LE(leaf->stats().peakBytes, leaf->stats().cumulativeBytes);
+  leaf->release();
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
+TEST_P(MemoryPoolTest, smallAllocationCache) {
+  MemoryManager::Options options;
+  options.leafSmallAllocationCacheBytes = 16 * KB;
+  setupMemory(options);
+  auto root = getMemoryManager()->addRootPool("smallAllocationCache");
+  auto leaf = root->addLeafChild("leaf");
+  auto* leafImpl = static_cast<MemoryPoolImpl*>(leaf.get());
+
+  // Small allocations are accounted by their power of 2 size class.
+  void* buf1 = leaf->allocate(100);
+  ASSERT_EQ(leaf->usedBytes(), 128);
+  void* buf2 = leaf->allocateZeroFilled(10, 100);
+  ASSERT_EQ(leaf->usedBytes(), 128 + 1 * KB);
+  for (int32_t i = 0; i < 1'000; ++i) {
+    ASSERT_EQ(static_cast<char*>(buf2)[i], 0);
+  }
+
+  // A free keeps the allocation cached and counted as used memory.
+  leaf->free(buf1, 100);
+  ASSERT_EQ(leaf->usedBytes(), 128 + 1 * KB);
+  ASSERT_EQ(leafImpl->testingCachedSmallAllocationBytes(), 128);
+
+  // An allocation of the same size class reuses the cached allocation.
+  void* buf3 = leaf->allocate(120);
+  ASSERT_EQ(buf3, buf1);
+  ASSERT_EQ(leaf->usedBytes(), 128 + 1 * KB);
+  ASSERT_EQ(leafImpl->testingCachedSmallAllocationBytes(), 0);
+
+  // Reallocation moves between size classes.
+  void* buf4 = leaf->reallocate(buf3, 120, 200);
+  ASSERT_EQ(leaf->usedBytes(), 128 + 256 + 1 * KB);
+  ASSERT_EQ(leafImpl->testingCachedSmallAllocationBytes(), 128);
+
+  // Large allocations are not cached.
+  void* buf5 = leaf->allocate(1 * MB);
+  ASSERT_EQ(leaf->usedBytes(), 1 * MB + 128 + 256 + 1 * KB);
+  leaf->free(buf5, 1 * MB);
+  ASSERT_EQ(leaf->usedBytes(), 128 + 256 + 1 * KB);
+
+  // A free that doesn't fit into the shard goes to the allocator.
+  void* buf6 = leaf->allocate(32 * KB);
+  leaf->free(buf6, 32 * KB);
+  ASSERT_EQ(leaf->usedBytes(), 128 + 256 + 1 * KB);
+  ASSERT_EQ(leafImpl->testingCachedSmallAllocationBytes(), 128);
+
+  // Small allocations are not transferred between pools.
+  auto other = root->addLeafChild("other");
+  ASSERT_FALSE(leaf->transferTo(other.get(), buf4, 200));
+
+  leaf->free(buf2, 1'000);
+  leaf->free(buf4, 200);
+  ASSERT_EQ(leafImpl->testingCachedSmallAllocationBytes(), 128 + 256 + 1 * KB);
+  ASSERT_EQ(leaf->usedBytes(), 128 + 256 + 1 * KB);
+
+  // release() gives the cached allocations back to the allocator.
+  leaf->release();
+  ASSERT_EQ(leafImpl->testingCachedSmallAllocationBytes(), 0);
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+
+  // Destruction gives the cached allocations back to the allocator.
+  void* buf7 = leaf->allocate(64);
+  leaf->free(buf7, 64);
+  ASSERT_EQ(leaf->usedBytes(), 64);
+  leaf.reset();
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
 TEST_P(MemoryPoolTest, concurrentUpdateToSharedPools) {
   // under some conditions bug.
   constexpr int64_t kMaxMemory = 10 * GB;
@@ -704,6 +704,13 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
       SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(
           emptyConfigs),
       SharedArbitrator::ExtraConfig::kDefaultGlobalArbitrationAbortTimeRatio);
+  ASSERT_EQ(
+      SharedArbitrator::ExtraConfig::proactiveReclaimIntervalNs(emptyConfigs),
+      0);
+  ASSERT_EQ(
+      SharedArbitrator::ExtraConfig::proactiveReclaimFreeCapacityPct(
+          emptyConfigs),
+      SharedArbitrator::ExtraConfig::kDefaultProactiveReclaimFreeCapacityPct);
 
   // Testing custom values
   std::unordered_map<std::string, std::string> configs;
@@ -735,6 +742,10 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
       SharedArbitrator::ExtraConfig::kGlobalArbitrationWithoutSpill)] = "true";
   configs[std::string(
       SharedArbitrator::ExtraConfig::kGlobalArbitrationAbortTimeRatio)] = "0.8";
+  configs[std::string(
+      SharedArbitrator::ExtraConfig::kProactiveReclaimInterval)] = "100ms";
+  configs[std::string(
+      SharedArbitrator::ExtraConfig::kProactiveReclaimFreeCapacityPct)] = "20";
 
   ASSERT_EQ(SharedArbitrator::ExtraConfig::reservedCapacity(configs), 100);
   ASSERT_EQ(
@@ -767,6 +778,12 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
   ASSERT_EQ(
       SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(configs),
       0.8);
+  ASSERT_EQ(
+      SharedArbitrator::ExtraConfig::proactiveReclaimIntervalNs(configs),
+      100'000'000UL);
+  ASSERT_EQ(
+      SharedArbitrator::ExtraConfig::proactiveReclaimFreeCapacityPct(configs),
+      20);
 
   // Testing invalid values
   configs[std::string(SharedArbitrator::ExtraConfig::kReservedCapacity)] =
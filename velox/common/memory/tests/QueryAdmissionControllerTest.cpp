@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/QueryAdmissionController.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::memory {
+namespace {
+
+constexpr int64_t kMB = 1 << 20;
+
+QueryAdmissionController::Config makeConfig() {
+  QueryAdmissionController::Config config;
+  config.capacity = 100 * kMB;
+  config.maxCpuSlots = 10;
+  config.numPriorities = 2;
+  config.defaultPeakBytes = 10 * kMB;
+  return config;
+}
+
+QueryAdmissionController::Request makeRequest(
+    const std::string& queryId,
+    std::optional<int64_t> estimatedPeakBytes = std::nullopt,
+    int32_t priority = 0,
+    const std::string& fingerprint = "") {
+  QueryAdmissionController::Request request;
+  request.queryId = queryId;
+  request.fingerprint = fingerprint;
+  request.priority = priority;
+  request.estimatedPeakBytes = estimatedPeakBytes;
+  return request;
+}
+
+TEST(QueryAdmissionControllerTest, memory) {
+  QueryAdmissionController controller(makeConfig());
+  ContinueFuture future;
+  ASSERT_TRUE(controller.admit(makeRequest("q1", 60 * kMB), &future));
+  ASSERT_TRUE(controller.admit(makeRequest("q2", 30 * kMB), &future));
+  ASSERT_FALSE(controller.admit(makeRequest("q3", 20 * kMB), &future));
+  ASSERT_FALSE(future.isReady());
+  // Queued queries are admitted in order even if a later one would fit.
+  ContinueFuture smallFuture;
+  ASSERT_FALSE(controller.admit(makeRequest("q4", 5 * kMB), &smallFuture));
+
+  auto stats = controller.stats();
+  ASSERT_EQ(stats.numRunning, 2);
+  ASSERT_EQ(stats.numQueued, 2);
+  ASSERT_EQ(stats.admittedBytes, 90 * kMB);
+
+  controller.finish("q2", std::nullopt);
+  ASSERT_TRUE(future.isReady());
+  ASSERT_TRUE(smallFuture.isReady());
+  stats = controller.stats();
+  ASSERT_EQ(stats.numRunning, 3);
+  ASSERT_EQ(stats.numQueued, 0);
+  ASSERT_EQ(stats.admittedBytes, 85 * kMB);
+  ASSERT_EQ(stats.numAdmitted, 4);
+  ASSERT_EQ(stats.numAdmittedAfterWait, 2);
+
+  // A query above the capacity runs alone.
+  controller.finish("q1", std::nullopt);
+  controller.finish("q3", std::nullopt);
+  controller.finish("q4", std::nullopt);
+  ASSERT_EQ(
+      controller.predictPeakBytes(makeRequest("q5", 500 * kMB)), 100 * kMB);
+  ASSERT_TRUE(controller.admit(makeRequest("q5", 500 * kMB), &future));
+  ASSERT_FALSE(controller.admit(makeRequest("q6", 1), &future));
+  controller.finish("q5", std::nullopt);
+  ASSERT_TRUE(future.isReady());
+
+  VELOX_ASSERT_THROW(
+      controller.finish("q5", std::nullopt), "Query q5 is not admitted");
+  VELOX_ASSERT_THROW(
+      controller.admit(makeRequest("q6"), &future),
+      "Query q6 is already admitted");
+}
+
+TEST(QueryAdmissionControllerTest, cpuSlots) {
+  QueryAdmissionController controller(makeConfig());
+  ContinueFuture future;
+  auto request = makeRequest("q1", kMB);
+  request.cpuSlots = 8;
+  ASSERT_TRUE(controller.admit(request, &future));
+  request.queryId = "q2";
+  request.cpuSlots = 4;
+  ASSERT_FALSE(controller.admit(request, &future));
+  controller.finish("q1", std::nullopt);
+  ASSERT_TRUE(future.isReady());
+  ASSERT_EQ(controller.stats().admittedCpuSlots, 4);
+}
+
+TEST(QueryAdmissionControllerTest, priorities) {
+  QueryAdmissionController controller(makeConfig());
+  ContinueFuture future;
+  ASSERT_TRUE(controller.admit(makeRequest("q1", 90 * kMB), &future));
+
+  ContinueFuture lowFuture;
+  ASSERT_FALSE(controller.admit(makeRequest("low", 20 * kMB, 1), &lowFuture));
+  ContinueFuture highFuture;
+  ASSERT_FALSE(
+      controller.admit(makeRequest("high", 50 * kMB, 0), &highFuture));
+
+  // A low priority query that fits still waits for the queued high priority
+  // one.
+  ContinueFuture smallFuture;
+  ASSERT_FALSE(controller.admit(makeRequest("small", kMB, 1), &smallFuture));
+
+  controller.finish("q1", std::nullopt);
+  ASSERT_TRUE(highFuture.isReady());
+  ASSERT_TRUE(lowFuture.isReady());
+  ASSERT_TRUE(smallFuture.isReady());
+  ASSERT_EQ(controller.stats().admittedBytes, 71 * kMB);
+}
+
+TEST(QueryAdmissionControllerTest, cancel) {
+  QueryAdmissionController controller(makeConfig());
+  ContinueFuture future;
+  ASSERT_TRUE(controller.admit(makeRequest("q1", 90 * kMB), &future));
+  ContinueFuture bigFuture;
+  ASSERT_FALSE(controller.admit(makeRequest("big", 50 * kMB), &bigFuture));
+  ContinueFuture lowFuture;
+  ASSERT_FALSE(controller.admit(makeRequest("low", 5 * kMB, 1), &lowFuture));
+
+  ASSERT_FALSE(controller.cancel("q1"));
+  ASSERT_TRUE(controller.cancel("big"));
+  ASSERT_TRUE(bigFuture.isReady());
+  ASSERT_TRUE(bigFuture.hasException());
+  // The low priority query is no longer behind the cancelled one.
+  ASSERT_TRUE(lowFuture.isReady());
+  ASSERT_FALSE(lowFuture.hasException());
+  ASSERT_EQ(controller.stats().numQueued, 0);
+}
+
+TEST(QueryAdmissionControllerTest, history) {
+  auto config = makeConfig();
+  config.maxRunsPerFingerprint = 2;
+  config.maxFingerprints = 2;
+  QueryAdmissionController controller(config);
+  ContinueFuture future;
+
+  const auto run = [&](const std::string& fingerprint, int64_t peakBytes) {
+    auto request = makeRequest("q", std::nullopt, 0, fingerprint);
+    ASSERT_TRUE(controller.admit(request, &future));
+    controller.finish("q", peakBytes);
+  };
+
+  // No history, the estimate or the default.
+  ASSERT_EQ(
+      controller.predictPeakBytes(makeRequest("q", std::nullopt, 0, "a")),
+      10 * kMB);
+  ASSERT_EQ(
+      controller.predictPeakBytes(makeRequest("q", 3 * kMB, 0, "a")), 3 * kMB);
+
+  // The maximum of the last 2 runs.
+  run("a", 40 * kMB);
+  run("a", 20 * kMB);
+  ASSERT_EQ(
+      controller.predictPeakBytes(makeRequest("q", 3 * kMB, 0, "a")),
+      40 * kMB);
+  run("a", 30 * kMB);
+  ASSERT_EQ(
+      controller.predictPeakBytes(makeRequest("q", 3 * kMB, 0, "a")),
+      30 * kMB);
+
+  // The oldest fingerprint is forgotten.
+  run("b", kMB);
+  run("c", kMB);
+  ASSERT_EQ(
+      controller.predictPeakBytes(makeRequest("q", 3 * kMB, 0, "a")), 3 * kMB);
+  ASSERT_EQ(
+      controller.predictPeakBytes(makeRequest("q", 3 * kMB, 0, "b")), kMB);
+}
+
+TEST(QueryAdmissionControllerTest, memoryUsage) {
+  auto& manager = MemoryManager::testingSetInstance(MemoryManager::Options{});
+  auto config = makeConfig();
+  config.capacity = 0;
+  QueryAdmissionController defaultCapacity(config, &manager);
+
+  config.capacity = 100 * kMB;
+  QueryAdmissionController controller(config, &manager);
+  auto pool = manager.addLeafPool();
+  ContinueFuture future;
+  ASSERT_TRUE(controller.admit(makeRequest("q1", 10 * kMB), &future));
+
+  // Memory used outside of the admitted queries also counts.
+  const auto usedBytes = 80 * kMB - manager.getTotalBytes();
+  auto* buffer = pool->allocate(usedBytes);
+  ASSERT_FALSE(controller.admit(makeRequest("q2", 30 * kMB), &future));
+  controller.update();
+  ASSERT_FALSE(future.isReady());
+  pool->free(buffer, usedBytes);
+  controller.update();
+  ASSERT_TRUE(future.isReady());
+}
+
+} // namespace
+} // namespace facebook::velox::memory
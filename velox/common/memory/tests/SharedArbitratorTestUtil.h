@@ -70,6 +70,14 @@ class SharedArbitratorTestHelper {
     return arbitrator_->globalArbitrationRuns_;
   }
 
+  uint64_t proactiveReclaimRuns() const {
+    return arbitrator_->proactiveReclaimRuns_;
+  }
+
+  uint64_t proactiveReclaimBytes() const {
+    return arbitrator_->proactiveReclaimBytes_;
+  }
+
   bool hasShutdown() const {
     std::lock_guard<std::mutex> l(arbitrator_->stateMutex_);
     return arbitrator_->hasShutdownLocked();
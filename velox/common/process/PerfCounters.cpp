@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <atomic>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <folly/String.h>
+#include <glog/logging.h>
+
+namespace facebook::velox::process {
+
+namespace {
+// Cleared after the first failure to open the counters so that other threads
+// do not retry on a system without perf events.
+std::atomic_bool perfCountersSupported{true};
+
+#ifdef __linux__
+int32_t openCounter(uint64_t config, int32_t groupFd) {
+  struct perf_event_attr attr {};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return syscall(
+      __NR_perf_event_open, &attr, 0 /*pid*/, -1 /*cpu*/, groupFd, 0);
+}
+#endif
+} // namespace
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+  for (auto fd : fds_) {
+    ::close(fd);
+  }
+#endif
+}
+
+// static
+PerfCounters* PerfCounters::threadCounters() {
+  if (!perfCountersSupported) {
+    return nullptr;
+  }
+  thread_local const std::unique_ptr<PerfCounters> counters = create();
+  return counters.get();
+}
+
+// static
+std::unique_ptr<PerfCounters> PerfCounters::create() {
+#ifdef __linux__
+  static constexpr std::array<uint64_t, kNumCounters> kConfigs = {
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_MISSES};
+  std::array<int32_t, kNumCounters> fds;
+  for (auto i = 0; i < kNumCounters; ++i) {
+    fds[i] = openCounter(kConfigs[i], i == 0 ? -1 : fds[0]);
+    if (fds[i] < 0) {
+      LOG(WARNING) << "perf_event_open failed, hardware counters disabled: "
+                   << folly::errnoStr(errno);
+      for (auto j = 0; j < i; ++j) {
+        ::close(fds[j]);
+      }
+      perfCountersSupported = false;
+      return nullptr;
+    }
+  }
+  return std::unique_ptr<PerfCounters>(new PerfCounters(fds));
+#else
+  perfCountersSupported = false;
+  return nullptr;
+#endif
+}
+
+PerfCounts PerfCounters::read() const {
+  PerfCounts counts;
+#ifdef __linux__
+  // With PERF_FORMAT_GROUP the leader returns the number of counters followed
+  // by their values in the order they were added to the group.
+  std::array<uint64_t, 1 + kNumCounters> values{};
+  if (::read(fds_[0], values.data(), sizeof(values)) != sizeof(values)) {
+    return counts;
+  }
+  counts.instructions = values[1];
+  counts.cycles = values[2];
+  counts.cacheMisses = values[3];
+  counts.branchMisses = values[4];
+#endif
+  return counts;
+}
+
+} // namespace facebook::velox::process
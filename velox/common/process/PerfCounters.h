@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace facebook::velox::process {
+
+/// Hardware event counts of a thread.
+struct PerfCounts {
+  uint64_t instructions{0};
+  uint64_t cycles{0};
+  uint64_t cacheMisses{0};
+  uint64_t branchMisses{0};
+
+  PerfCounts operator-(const PerfCounts& other) const {
+    return {
+        instructions - other.instructions,
+        cycles - other.cycles,
+        cacheMisses - other.cacheMisses,
+        branchMisses - other.branchMisses};
+  }
+};
+
+/// A group of perf_event counters for instructions retired, CPU cycles, last
+/// level cache misses and branch misses of the calling thread. The counters
+/// run from creation. Callers take the difference of two reads. They count
+/// user space only, so they work with the default perf_event_paranoid of 2.
+class PerfCounters {
+ public:
+  ~PerfCounters();
+
+  /// Returns the counters of the calling thread, opening them on the first
+  /// call. Returns nullptr if perf_event_open is not available, e.g. on
+  /// non-Linux systems, in containers that block it or on virtual machines
+  /// without a PMU. Stops trying in all threads after the first failure.
+  static PerfCounters* threadCounters();
+
+  /// Reads the current values of all counters with one system call.
+  PerfCounts read() const;
+
+ private:
+  static constexpr int32_t kNumCounters = 4;
+
+  explicit PerfCounters(const std::array<int32_t, kNumCounters>& fds)
+      : fds_(fds) {}
+
+  static std::unique_ptr<PerfCounters> create();
+
+  // File descriptors of the counters. The first one is the group leader.
+  const std::array<int32_t, kNumCounters> fds_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfettoTrace.h"
+
+#include <fstream>
+#include <mutex>
+
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+PERFETTO_TRACK_EVENT_STATIC_STORAGE_IN_NAMESPACE(
+    facebook::velox::process::trace);
+#endif
+
+namespace facebook::velox::process {
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+namespace {
+// Initializes the in-process Perfetto backend once per process.
+void ensurePerfettoInitialized() {
+  static std::once_flag initialized;
+  std::call_once(initialized, []() {
+    perfetto::TracingInitArgs args;
+    args.backends = perfetto::kInProcessBackend;
+    perfetto::Tracing::Initialize(args);
+    trace::TrackEvent::Register();
+  });
+}
+} // namespace
+#endif
+
+PerfettoTraceSession::PerfettoTraceSession(std::string outputPath)
+    : outputPath_(std::move(outputPath)) {}
+
+// static
+std::unique_ptr<PerfettoTraceSession> PerfettoTraceSession::start(
+    std::string outputPath,
+    uint32_t bufferSizeKb) {
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+  VELOX_CHECK(!outputPath.empty());
+  ensurePerfettoInitialized();
+  perfetto::TraceConfig config;
+  config.add_buffers()->set_size_kb(bufferSizeKb);
+  config.add_data_sources()->mutable_config()->set_name("track_event");
+
+  auto traceSession = std::unique_ptr<PerfettoTraceSession>(
+      new PerfettoTraceSession(std::move(outputPath)));
+  traceSession->session_ = perfetto::Tracing::NewTrace();
+  traceSession->session_->Setup(config);
+  traceSession->session_->StartBlocking();
+  return traceSession;
+#else
+  return nullptr;
+#endif
+}
+
+PerfettoTraceSession::~PerfettoTraceSession() {
+  if (stopped_) {
+    return;
+  }
+  try {
+    stop();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to write Perfetto trace " << outputPath_ << ": "
+                 << e.what();
+  }
+}
+
+void PerfettoTraceSession::stop() {
+  VELOX_CHECK(!stopped_, "Perfetto trace session has been stopped");
+  stopped_ = true;
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+  trace::TrackEvent::Flush();
+  session_->StopBlocking();
+  const std::vector<char> traceData(session_->ReadTraceBlocking());
+  std::ofstream output(outputPath_, std::ios::out | std::ios::binary);
+  VELOX_CHECK(
+      output.good(), "Failed to open Perfetto trace file {}", outputPath_);
+  output.write(traceData.data(), traceData.size());
+#endif
+}
+
+uint64_t registerPerfettoTrack(uint64_t trackId, const std::string& name) {
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+  ensurePerfettoInitialized();
+  const perfetto::Track track(trackId);
+  auto descriptor = track.Serialize();
+  descriptor.set_name(name);
+  trace::TrackEvent::SetTrackDescriptor(track, descriptor);
+#endif
+  return trackId;
+}
+
+void unregisterPerfettoTrack(uint64_t trackId) {
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+  trace::TrackEvent::EraseTrackDescriptor(perfetto::Track(trackId));
+#endif
+}
+
+void PerfettoFileIoTracer::record(
+    IoType type,
+    uint64_t offset,
+    uint64_t length) {
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+  const auto* tag = threadIoTag();
+  VELOX_TRACE_INSTANT(
+      "velox.io",
+      toString(type),
+      "offset",
+      offset,
+      "length",
+      length,
+      "tag",
+      tag == nullptr ? std::string() : tag->toString());
+#endif
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "velox/common/file/FileIoTracer.h"
+
+/// Timeline tracing of the Velox execution with Perfetto. The trace events
+/// are compiled in only if Velox is built with VELOX_ENABLE_PERFETTO_TRACE,
+/// otherwise the VELOX_TRACE_* macros expand to nothing and their arguments
+/// are not evaluated. The events are recorded only while a
+/// PerfettoTraceSession is started.
+///
+/// The categories are:
+///   velox.driver: driver runs, operator calls and blocked drivers.
+///   velox.memory: drivers suspended for memory arbitration.
+///   velox.spill: spill file writes and reads.
+///   velox.io: file IO recorded by PerfettoFileIoTracer.
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+
+#include <perfetto.h>
+
+PERFETTO_DEFINE_CATEGORIES_IN_NAMESPACE(
+    facebook::velox::process::trace,
+    perfetto::Category("velox.driver")
+        .SetDescription("Driver runs, operator calls and blocked drivers"),
+    perfetto::Category("velox.memory")
+        .SetDescription("Drivers suspended for memory arbitration"),
+    perfetto::Category("velox.spill")
+        .SetDescription("Spill file writes and reads"),
+    perfetto::Category("velox.io").SetDescription("File IO operations"));
+
+PERFETTO_USE_CATEGORIES_FROM_NAMESPACE(facebook::velox::process::trace);
+
+/// Records a slice named 'name' until the end of the enclosing scope. The
+/// optional arguments are a track followed by pairs of debug annotation names
+/// and values.
+#define VELOX_TRACE_SCOPED(category, name, ...) \
+  TRACE_EVENT(category, ::perfetto::DynamicString{name}, ##__VA_ARGS__)
+
+/// Begins a slice named 'name'. The slice is ended by VELOX_TRACE_END on the
+/// same track.
+#define VELOX_TRACE_BEGIN(category, name, ...) \
+  TRACE_EVENT_BEGIN(category, ::perfetto::DynamicString{name}, ##__VA_ARGS__)
+
+#define VELOX_TRACE_END(category, ...) TRACE_EVENT_END(category, ##__VA_ARGS__)
+
+/// Records a zero-duration event named 'name'.
+#define VELOX_TRACE_INSTANT(category, name, ...) \
+  TRACE_EVENT_INSTANT(category, ::perfetto::DynamicString{name}, ##__VA_ARGS__)
+
+/// Records a slice named 'name' on the current thread which ended now and
+/// lasted 'durationNs'. Used for the operations which are timed by their
+/// callers.
+#define VELOX_TRACE_COMPLETE(category, name, durationNs, ...)                 \
+  do {                                                                        \
+    const auto _veloxTraceEndNs = ::perfetto::TrackEvent::GetTraceTimeNs();   \
+    TRACE_EVENT_BEGIN(                                                        \
+        category,                                                             \
+        ::perfetto::DynamicString{name},                                      \
+        ::perfetto::ThreadTrack::Current(),                                   \
+        _veloxTraceEndNs - (durationNs),                                      \
+        ##__VA_ARGS__);                                                       \
+    TRACE_EVENT_END(                                                          \
+        category, ::perfetto::ThreadTrack::Current(), _veloxTraceEndNs);      \
+  } while (false)
+
+#else
+
+#define VELOX_TRACE_SCOPED(category, name, ...)
+#define VELOX_TRACE_BEGIN(category, name, ...)
+#define VELOX_TRACE_END(category, ...)
+#define VELOX_TRACE_INSTANT(category, name, ...)
+#define VELOX_TRACE_COMPLETE(category, name, durationNs, ...)
+
+#endif // VELOX_ENABLE_PERFETTO_TRACE
+
+namespace facebook::velox::process {
+
+/// Returns true if Velox is built with the Perfetto trace events.
+constexpr bool perfettoTraceSupported() {
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// Records the Velox trace events of this process into a Perfetto trace file
+/// which can be opened with https://ui.perfetto.dev. The events of all
+/// threads are recorded, so the trace of a task also contains the events of
+/// the other tasks running at the same time.
+class PerfettoTraceSession {
+ public:
+  /// Starts recording the events into a buffer of 'bufferSizeKb'. The trace is
+  /// written to 'outputPath' when the session stops. Returns nullptr if Velox
+  /// is built without the Perfetto trace events.
+  static std::unique_ptr<PerfettoTraceSession> start(
+      std::string outputPath,
+      uint32_t bufferSizeKb = 64 << 10);
+
+  /// Stops the session if it has not been stopped.
+  ~PerfettoTraceSession();
+
+  /// Stops recording and writes the trace to the output path. Can be called
+  /// only once.
+  void stop();
+
+  const std::string& outputPath() const {
+    return outputPath_;
+  }
+
+ private:
+  explicit PerfettoTraceSession(std::string outputPath);
+
+  const std::string outputPath_;
+  bool stopped_{false};
+#ifdef VELOX_ENABLE_PERFETTO_TRACE
+  std::unique_ptr<perfetto::TracingSession> session_;
+#endif
+};
+
+/// Names the track of the events with 'trackId' as 'name' in the traces
+/// started afterwards. Returns 'trackId'. No-op if Velox is built without the
+/// Perfetto trace events.
+uint64_t registerPerfettoTrack(uint64_t trackId, const std::string& name);
+
+/// Removes the track name registered by registerPerfettoTrack().
+void unregisterPerfettoTrack(uint64_t trackId);
+
+/// File IO tracer which records each IO operation as an instant event of the
+/// velox.io category, annotated with the offset, length and IO tag.
+class PerfettoFileIoTracer : public FileIoTracer {
+ public:
+  void record(IoType type, uint64_t offset, uint64_t length) override;
+
+  void finish() override {}
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/SamplingProfiler.h"
+
+#include <fmt/format.h>
+#include <folly/Indestructible.h>
+#include <folly/String.h>
+#include <folly/experimental/symbolizer/StackTrace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/time.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/StackTrace.h"
+#include "velox/common/process/ThreadDebugInfo.h"
+
+namespace facebook::velox::process {
+namespace {
+
+constexpr int32_t kMaxFrames = 64;
+constexpr int32_t kMaxTagLength = 128;
+// Frames of the signal handler and of the signal trampoline.
+constexpr int32_t kSkipFrames = 2;
+
+constexpr int32_t kEmpty = 0;
+constexpr int32_t kWriting = 1;
+constexpr int32_t kFull = 2;
+
+// Operator being called on this thread. Set by ScopedOperator and read by the
+// signal handler on the same thread.
+thread_local const std::string* currentOperatorType = nullptr;
+thread_local const std::string* currentPlanNodeId = nullptr;
+
+// A sample slot. The signal handler claims an empty slot, fills it and marks
+// it full. The aggregator consumes full slots and marks them empty again.
+struct Sample {
+  std::atomic<int32_t> state{kEmpty};
+  int32_t numFrames{0};
+  uintptr_t frames[kMaxFrames];
+  char queryId[kMaxTagLength];
+  char taskId[kMaxTagLength];
+  char operatorType[kMaxTagLength];
+  char planNodeId[kMaxTagLength];
+};
+
+struct ProfilerState {
+  // Serializes start() and stop().
+  std::mutex lifecycleMutex;
+  SamplingProfiler::Options options;
+
+  // State shared with the signal handler.
+  std::atomic<bool> running{false};
+  std::atomic<int32_t> numActiveHandlers{0};
+  std::unique_ptr<Sample[]> samples;
+  int32_t capacity{0};
+  std::atomic<uint64_t> nextSample{0};
+  std::atomic<uint64_t> numDroppedSamples{0};
+  std::atomic<uint64_t> numUnattributedSamples{0};
+  struct sigaction prevAction {};
+
+  // Aggregator thread.
+  std::thread aggregator;
+  std::mutex aggregatorMutex;
+  std::condition_variable aggregatorCv;
+  bool stopAggregator{false};
+
+  // Symbolized frames. Only accessed by the aggregation.
+  std::unordered_map<uintptr_t, std::string> symbols;
+
+  // Folded stacks per query.
+  std::mutex queriesMutex;
+  std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>>
+      queries;
+  // Query IDs in the order of their first sample, used for eviction.
+  std::deque<std::string> queryOrder;
+  uint64_t numSamples{0};
+};
+
+ProfilerState& profilerState() {
+  static folly::Indestructible<ProfilerState> state;
+  return *state;
+}
+
+// Copies 'source' into 'dest' without allocating, truncating it to
+// kMaxTagLength - 1 characters.
+void copyTag(const std::string* source, char* dest) {
+  if (source == nullptr) {
+    dest[0] = '\0';
+    return;
+  }
+  const auto length = std::min<size_t>(source->size(), kMaxTagLength - 1);
+  memcpy(dest, source->data(), length);
+  dest[length] = '\0';
+}
+
+// Runs in the signal handler, so it must be async-signal-safe.
+void recordSample(ProfilerState& state) {
+  const auto* debugInfo = GetThreadDebugInfo();
+  if (debugInfo == nullptr) {
+    state.numUnattributedSamples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  const auto index =
+      state.nextSample.fetch_add(1, std::memory_order_relaxed) %
+      state.capacity;
+  auto& sample = state.samples[index];
+  int32_t expected = kEmpty;
+  if (!sample.state.compare_exchange_strong(
+          expected, kWriting, std::memory_order_acquire)) {
+    state.numDroppedSamples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  uintptr_t frames[kMaxFrames + kSkipFrames];
+  const auto numFrames =
+      folly::symbolizer::getStackTraceSafe(frames, kMaxFrames + kSkipFrames);
+  sample.numFrames = std::max<int32_t>(0, numFrames - kSkipFrames);
+  memcpy(
+      sample.frames,
+      frames + kSkipFrames,
+      sample.numFrames * sizeof(uintptr_t));
+  copyTag(&debugInfo->queryId_, sample.queryId);
+  copyTag(&debugInfo->taskId_, sample.taskId);
+  std::atomic_signal_fence(std::memory_order_acquire);
+  copyTag(currentOperatorType, sample.operatorType);
+  copyTag(currentPlanNodeId, sample.planNodeId);
+  sample.state.store(kFull, std::memory_order_release);
+}
+
+void handleSignal(int /*signum*/, siginfo_t* /*info*/, void* /*context*/) {
+  const auto savedErrno = errno;
+  auto& state = profilerState();
+  state.numActiveHandlers.fetch_add(1);
+  if (state.running.load()) {
+    recordSample(state);
+  }
+  state.numActiveHandlers.fetch_sub(1);
+  errno = savedErrno;
+}
+
+const std::string& symbolize(ProfilerState& state, uintptr_t address) {
+  auto it = state.symbols.find(address);
+  if (it == state.symbols.end()) {
+    auto name = StackTrace::translateFrame(reinterpret_cast<void*>(address));
+    if (name.empty()) {
+      name = fmt::format("{:#x}", address);
+    }
+    it = state.symbols.emplace(address, std::move(name)).first;
+  }
+  return it->second;
+}
+
+// Symbolizes the full samples and adds them to the folded stacks of their
+// queries. Does not run concurrently with itself.
+void aggregateSamples(ProfilerState& state) {
+  std::vector<std::pair<std::string, std::string>> stacks;
+  for (auto i = 0; i < state.capacity; ++i) {
+    auto& sample = state.samples[i];
+    if (sample.state.load(std::memory_order_acquire) != kFull) {
+      continue;
+    }
+    std::string stack = sample.taskId;
+    if (sample.operatorType[0] != '\0') {
+      stack += fmt::format(";{}:{}", sample.operatorType, sample.planNodeId);
+    } else {
+      stack += ";driver";
+    }
+    // Frames are captured from the leaf to the root.
+    for (auto frame = sample.numFrames - 1; frame >= 0; --frame) {
+      stack += ';';
+      stack += symbolize(state, sample.frames[frame]);
+    }
+    stacks.emplace_back(sample.queryId, std::move(stack));
+    sample.state.store(kEmpty, std::memory_order_release);
+  }
+  if (stacks.empty()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> l(state.queriesMutex);
+  for (auto& [queryId, stack] : stacks) {
+    auto it = state.queries.find(queryId);
+    if (it == state.queries.end()) {
+      while (!state.queryOrder.empty() &&
+             state.queries.size() >=
+                 static_cast<size_t>(state.options.maxQueries)) {
+        state.queries.erase(state.queryOrder.front());
+        state.queryOrder.pop_front();
+      }
+      it = state.queries.try_emplace(queryId).first;
+      state.queryOrder.push_back(queryId);
+    }
+    ++it->second[std::move(stack)];
+    ++state.numSamples;
+  }
+}
+
+void runAggregator(ProfilerState& state) {
+  std::unique_lock<std::mutex> l(state.aggregatorMutex);
+  while (!state.stopAggregator) {
+    state.aggregatorCv.wait_for(
+        l, std::chrono::milliseconds(state.options.aggregationIntervalMs));
+    aggregateSamples(state);
+  }
+}
+
+void setTimer(int32_t samplesPerSecond) {
+  itimerval timer{};
+  if (samplesPerSecond > 0) {
+    const int64_t intervalUs =
+        std::max<int64_t>(1, 1'000'000 / samplesPerSecond);
+    timer.it_interval.tv_sec = intervalUs / 1'000'000;
+    timer.it_interval.tv_usec = intervalUs % 1'000'000;
+    timer.it_value = timer.it_interval;
+  }
+  VELOX_CHECK_EQ(
+      setitimer(ITIMER_PROF, &timer, nullptr),
+      0,
+      "Failed to set the profiling timer: {}",
+      folly::errnoStr(errno));
+}
+
+} // namespace
+
+void SamplingProfiler::start(const Options& options) {
+  VELOX_CHECK_GT(options.samplesPerSecond, 0);
+  VELOX_CHECK_GT(options.bufferCapacity, 0);
+  VELOX_CHECK_GT(options.aggregationIntervalMs, 0);
+  VELOX_CHECK_GT(options.maxQueries, 0);
+
+  auto& state = profilerState();
+  std::lock_guard<std::mutex> l(state.lifecycleMutex);
+  VELOX_CHECK(!state.running, "The sampling profiler is already running");
+
+  state.options = options;
+  state.samples = std::make_unique<Sample[]>(options.bufferCapacity);
+  state.capacity = options.bufferCapacity;
+  state.nextSample = 0;
+
+  // Unwinding the first time may initialize state in a way that is not
+  // async-signal-safe, so do it outside of the signal handler.
+  uintptr_t frames[kMaxFrames];
+  folly::symbolizer::getStackTraceSafe(frames, kMaxFrames);
+
+  struct sigaction action {};
+  action.sa_sigaction = handleSignal;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  VELOX_CHECK_EQ(
+      sigaction(SIGPROF, &action, &state.prevAction),
+      0,
+      "Failed to install the SIGPROF handler: {}",
+      folly::errnoStr(errno));
+
+  state.stopAggregator = false;
+  state.aggregator = std::thread([&state]() { runAggregator(state); });
+  state.running = true;
+  setTimer(options.samplesPerSecond);
+}
+
+void SamplingProfiler::stop() {
+  auto& state = profilerState();
+  std::lock_guard<std::mutex> l(state.lifecycleMutex);
+  if (!state.running) {
+    return;
+  }
+  setTimer(0);
+  state.running = false;
+  // Handlers that started before 'running' was cleared may still write a
+  // sample.
+  while (state.numActiveHandlers.load() > 0) {
+    std::this_thread::yield();
+  }
+  sigaction(SIGPROF, &state.prevAction, nullptr);
+
+  {
+    std::lock_guard<std::mutex> aggregatorLock(state.aggregatorMutex);
+    state.stopAggregator = true;
+  }
+  state.aggregatorCv.notify_one();
+  state.aggregator.join();
+  aggregateSamples(state);
+  state.samples.reset();
+  state.capacity = 0;
+}
+
+bool SamplingProfiler::isRunning() {
+  return profilerState().running;
+}
+
+std::unordered_map<std::string, uint64_t> SamplingProfiler::foldedStacks(
+    const std::string& queryId) {
+  auto& state = profilerState();
+  std::lock_guard<std::mutex> l(state.queriesMutex);
+  auto it = state.queries.find(queryId);
+  if (it == state.queries.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+std::string SamplingProfiler::foldedStacksText(const std::string& queryId) {
+  const auto stacks = foldedStacks(queryId);
+  std::vector<const std::pair<const std::string, uint64_t>*> sorted;
+  sorted.reserve(stacks.size());
+  for (const auto& entry : stacks) {
+    sorted.push_back(&entry);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](auto* left, auto* right) {
+    return left->first < right->first;
+  });
+  std::string text;
+  for (const auto* entry : sorted) {
+    text += fmt::format("{} {}\n", entry->first, entry->second);
+  }
+  return text;
+}
+
+void SamplingProfiler::clear() {
+  auto& state = profilerState();
+  {
+    std::lock_guard<std::mutex> l(state.queriesMutex);
+    state.queries.clear();
+    state.queryOrder.clear();
+    state.numSamples = 0;
+  }
+  state.numDroppedSamples = 0;
+  state.numUnattributedSamples = 0;
+}
+
+SamplingProfiler::Stats SamplingProfiler::stats() {
+  auto& state = profilerState();
+  Stats stats;
+  {
+    std::lock_guard<std::mutex> l(state.queriesMutex);
+    stats.numSamples = state.numSamples;
+    stats.numQueries = state.queries.size();
+  }
+  stats.numDroppedSamples = state.numDroppedSamples;
+  stats.numUnattributedSamples = state.numUnattributedSamples;
+  return stats;
+}
+
+SamplingProfiler::ScopedOperator::ScopedOperator(
+    const std::string& operatorType,
+    const std::string& planNodeId)
+    : prevOperatorType_(currentOperatorType),
+      prevPlanNodeId_(currentPlanNodeId) {
+  currentOperatorType = &operatorType;
+  currentPlanNodeId = &planNodeId;
+  std::atomic_signal_fence(std::memory_order_release);
+}
+
+SamplingProfiler::ScopedOperator::~ScopedOperator() {
+  currentOperatorType = prevOperatorType_;
+  currentPlanNodeId = prevPlanNodeId_;
+  std::atomic_signal_fence(std::memory_order_release);
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace facebook::velox::process {
+
+/// In-process sampling CPU profiler that attributes every sample to the
+/// query, task and operator running on the sampled thread. Samples are taken
+/// from a SIGPROF interval timer, so only threads that consume CPU are
+/// sampled. The signal handler copies the raw stack and the attribution tags
+/// of the thread into a lock-free buffer. A background thread symbolizes the
+/// stacks and aggregates them per query into folded stacks, the input format
+/// of flame graph tools. Threads without a ThreadDebugInfo are not attributed
+/// to a query and their samples are dropped.
+///
+/// The profiler is process wide and uses ITIMER_PROF, so it cannot run
+/// together with other profilers using the same timer.
+class SamplingProfiler {
+ public:
+  struct Options {
+    /// Number of samples per second of CPU time consumed by the process. The
+    /// default keeps the overhead well below 1%.
+    int32_t samplesPerSecond{29};
+
+    /// Number of samples buffered between two aggregation rounds. Samples
+    /// that do not fit are dropped and counted in Stats::numDroppedSamples.
+    int32_t bufferCapacity{4'096};
+
+    /// Interval between two aggregation rounds.
+    int32_t aggregationIntervalMs{500};
+
+    /// Maximum number of queries for which folded stacks are retained. The
+    /// stacks of the query that received its first sample the longest time
+    /// ago are evicted first.
+    int32_t maxQueries{64};
+  };
+
+  struct Stats {
+    /// Number of samples aggregated into folded stacks.
+    uint64_t numSamples{0};
+
+    /// Number of samples dropped because the buffer was full.
+    uint64_t numDroppedSamples{0};
+
+    /// Number of samples on threads not running a query.
+    uint64_t numUnattributedSamples{0};
+
+    /// Number of queries with retained folded stacks.
+    uint64_t numQueries{0};
+  };
+
+  /// Starts sampling. Throws if the profiler is already running.
+  static void start(const Options& options);
+
+  /// Stops sampling and aggregates the buffered samples. The folded stacks
+  /// stay available until clear() is called. No-op if not running.
+  static void stop();
+
+  static bool isRunning();
+
+  /// Returns the folded stacks of 'queryId' mapped to their sample counts.
+  /// Each stack lists its frames from the root to the leaf separated by ';'.
+  /// The first two frames are the task ID and '<operatorType>:<planNodeId>'
+  /// of the operator being called, or 'driver' outside of operator calls.
+  static std::unordered_map<std::string, uint64_t> foldedStacks(
+      const std::string& queryId);
+
+  /// Returns the folded stacks of 'queryId' as text, one '<stack> <count>'
+  /// line per stack.
+  static std::string foldedStacksText(const std::string& queryId);
+
+  /// Drops the folded stacks of all queries and resets the stats.
+  static void clear();
+
+  static Stats stats();
+
+  /// Tags the samples taken on this thread during the lifetime of this object
+  /// with the given operator. The strings must outlive this object.
+  class ScopedOperator {
+   public:
+    ScopedOperator(
+        const std::string& operatorType,
+        const std::string& planNodeId);
+
+    ~ScopedOperator();
+
+   private:
+    const std::string* const prevOperatorType_;
+    const std::string* const prevPlanNodeId_;
+  };
+};
+
+} // namespace facebook::velox::process
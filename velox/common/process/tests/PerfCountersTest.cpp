@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <folly/Benchmark.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(PerfCountersTest, countsWork) {
+  auto* counters = PerfCounters::threadCounters();
+  if (counters == nullptr) {
+    GTEST_SKIP() << "perf_event hardware counters are not available";
+  }
+  ASSERT_EQ(counters, PerfCounters::threadCounters());
+
+  const auto before = counters->read();
+  uint64_t sum = 0;
+  for (auto i = 0; i < 1'000'000; ++i) {
+    sum += i * i;
+    folly::doNotOptimizeAway(sum);
+  }
+  const auto delta = counters->read() - before;
+  EXPECT_GT(delta.instructions, 1'000'000);
+  EXPECT_GT(delta.cycles, 0);
+}
+
+TEST(PerfCountersTest, perThread) {
+  auto* counters = PerfCounters::threadCounters();
+  if (counters == nullptr) {
+    GTEST_SKIP() << "perf_event hardware counters are not available";
+  }
+  PerfCounters* otherCounters{nullptr};
+  std::thread([&]() { otherCounters = PerfCounters::threadCounters(); })
+      .join();
+  ASSERT_NE(otherCounters, nullptr);
+  ASSERT_NE(otherCounters, counters);
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfettoTrace.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(PerfettoTraceTest, session) {
+  const auto tracePath =
+      (std::filesystem::temp_directory_path() / "PerfettoTraceTest.trace")
+          .string();
+  std::filesystem::remove(tracePath);
+
+  auto session = PerfettoTraceSession::start(tracePath);
+  if (!perfettoTraceSupported()) {
+    ASSERT_EQ(session, nullptr);
+    return;
+  }
+  ASSERT_NE(session, nullptr);
+  ASSERT_EQ(session->outputPath(), tracePath);
+
+  const auto trackId = registerPerfettoTrack(1234, "test track");
+  {
+    VELOX_TRACE_SCOPED("velox.driver", "scoped", "arg", 1);
+    VELOX_TRACE_INSTANT("velox.io", "instant");
+  }
+  VELOX_TRACE_BEGIN("velox.driver", "trackSlice", perfetto::Track(trackId));
+  VELOX_TRACE_END("velox.driver", perfetto::Track(trackId));
+  VELOX_TRACE_COMPLETE("velox.spill", "complete", 1'000);
+  PerfettoFileIoTracer().record(IoType::Read, 0, 100);
+  unregisterPerfettoTrack(trackId);
+
+  session->stop();
+  ASSERT_TRUE(std::filesystem::exists(tracePath));
+  ASSERT_GT(std::filesystem::file_size(tracePath), 0);
+  VELOX_ASSERT_THROW(session->stop(), "has been stopped");
+  std::filesystem::remove(tracePath);
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/SamplingProfiler.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/ThreadDebugInfo.h"
+
+namespace facebook::velox::process {
+namespace {
+
+class SamplingProfilerTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    SamplingProfiler::stop();
+    SamplingProfiler::clear();
+  }
+
+  // Consumes CPU until 'done' returns true or a timeout expires.
+  template <typename Done>
+  static void burnCpu(Done done) {
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    volatile uint64_t sum = 0;
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+      for (auto i = 0; i < 1'000'000; ++i) {
+        sum = sum + i;
+      }
+    }
+  }
+
+  static SamplingProfiler::Options testOptions() {
+    SamplingProfiler::Options options;
+    options.samplesPerSecond = 500;
+    options.aggregationIntervalMs = 10;
+    return options;
+  }
+};
+
+TEST_F(SamplingProfilerTest, attribution) {
+  SamplingProfiler::start(testOptions());
+  ASSERT_TRUE(SamplingProfiler::isRunning());
+  VELOX_ASSERT_THROW(
+      SamplingProfiler::start(testOptions()), "already running");
+
+  ThreadDebugInfo debugInfo{"query.1", "task.1", nullptr};
+  {
+    ScopedThreadDebugInfo scopedDebugInfo(debugInfo);
+    const std::string operatorType{"TestOperator"};
+    const std::string planNodeId{"7"};
+    SamplingProfiler::ScopedOperator scopedOperator(operatorType, planNodeId);
+    burnCpu([]() { return SamplingProfiler::stats().numSamples >= 10; });
+  }
+  SamplingProfiler::stop();
+  ASSERT_FALSE(SamplingProfiler::isRunning());
+
+  const auto stats = SamplingProfiler::stats();
+  ASSERT_GE(stats.numSamples, 10);
+  ASSERT_EQ(stats.numQueries, 1);
+
+  const auto stacks = SamplingProfiler::foldedStacks("query.1");
+  ASSERT_FALSE(stacks.empty());
+  uint64_t numSamples = 0;
+  for (const auto& [stack, count] : stacks) {
+    ASSERT_EQ(stack.rfind("task.1;TestOperator:7;", 0), 0) << stack;
+    numSamples += count;
+  }
+  ASSERT_EQ(numSamples, stats.numSamples);
+  ASSERT_FALSE(SamplingProfiler::foldedStacksText("query.1").empty());
+  ASSERT_TRUE(SamplingProfiler::foldedStacks("query.2").empty());
+
+  SamplingProfiler::clear();
+  ASSERT_TRUE(SamplingProfiler::foldedStacks("query.1").empty());
+  ASSERT_EQ(SamplingProfiler::stats().numSamples, 0);
+}
+
+TEST_F(SamplingProfilerTest, unattributed) {
+  SamplingProfiler::start(testOptions());
+  burnCpu(
+      []() { return SamplingProfiler::stats().numUnattributedSamples >= 10; });
+  SamplingProfiler::stop();
+
+  const auto stats = SamplingProfiler::stats();
+  ASSERT_GE(stats.numUnattributedSamples, 10);
+  ASSERT_EQ(stats.numSamples, 0);
+  ASSERT_EQ(stats.numQueries, 0);
+}
+
+TEST_F(SamplingProfilerTest, queryEviction) {
+  auto options = testOptions();
+  options.maxQueries = 1;
+  // Restart the profiler for each query so that no sample of the first query
+  // is aggregated after the second one.
+  for (const auto* queryId : {"query.1", "query.2"}) {
+    SamplingProfiler::start(options);
+    {
+      ThreadDebugInfo debugInfo{queryId, "task", nullptr};
+      ScopedThreadDebugInfo scopedDebugInfo(debugInfo);
+      burnCpu([queryId]() {
+        return !SamplingProfiler::foldedStacks(queryId).empty();
+      });
+    }
+    SamplingProfiler::stop();
+  }
+
+  ASSERT_EQ(SamplingProfiler::stats().numQueries, 1);
+  ASSERT_TRUE(SamplingProfiler::foldedStacks("query.1").empty());
+  ASSERT_FALSE(SamplingProfiler::foldedStacks("query.2").empty());
+  for (const auto& [stack, count] : SamplingProfiler::foldedStacks("query.2")) {
+    ASSERT_EQ(stack.rfind("task;driver", 0), 0) << stack;
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -64,6 +64,9 @@ struct ConnectorSplit : public ISerializable {
 
   std::unique_ptr<AsyncSource<DataSource>> dataSource;
 
+  /// True if the split has been passed to Connector::prewarmSplit().
+  bool prewarmed{false};
+
   explicit ConnectorSplit(
       const std::string& _connectorId,
       int64_t _splitWeight = 0,
@@ -81,6 +84,14 @@ struct ConnectorSplit : public ISerializable {
     return 0;
   }
 
+  /// Divides the split into splits covering consecutive parts of its data of
+  /// about 'targetBytes' each, so that different drivers can process the
+  /// parts. Returns an empty vector if the split cannot be divided.
+  virtual std::vector<std::shared_ptr<ConnectorSplit>> divide(
+      uint64_t /*targetBytes*/) const {
+    return {};
+  }
+
   virtual ~ConnectorSplit() {
     if (dataSource) {
       dataSource->close();
@@ -310,6 +321,14 @@ class DataSource {
     return kUnknownRowSize;
   }
 
+  /// Returns the number of splits to preload per driver for the splits like
+  /// the current one, given the configured 'maxSplitPreloadPerDriver'. A
+  /// connector can adapt it to the storage the split is read from. This is
+  /// called after addSplit().
+  virtual int32_t splitPreloadPerDriver(int32_t maxSplitPreloadPerDriver) {
+    return maxSplitPreloadPerDriver;
+  }
+
   /// Returns a Wave delegate that implements the Wave Operator
   /// interface for a GPU table scan. This should be called after
   /// construction and no other methods should be called on 'this'
@@ -634,6 +653,19 @@ class Connector {
     return false;
   }
 
+  /// Returns true if prewarmSplit() does work. If so, TableScan can prewarm
+  /// the splits past the preloaded ones.
+  virtual bool supportsSplitPrewarm() const {
+    return false;
+  }
+
+  /// Does the cheap, cacheable part of reading 'split' ahead of time, e.g.
+  /// opening its file, so that the DataSource finds it done when it reads the
+  /// split. Called on the IO executor. Must not throw.
+  virtual void prewarmSplit(
+      const std::shared_ptr<ConnectorSplit>& /*split*/,
+      const ConnectorQueryCtx* /*connectorQueryCtx*/) {}
+
   /// Returns true if the connector supports index lookup, otherwise false.
   virtual bool supportsIndexLookup() const {
     return false;
@@ -697,10 +729,12 @@ class Connector {
   /// Returns a ScanTracker for 'id'. 'id' uniquely identifies the
   /// tracker and different threads will share the same
   /// instance. 'loadQuantum' is the largest single IO for the query
-  /// being tracked.
+  /// being tracked. 'fileGroupStats' receives the accesses of the scan for
+  /// SSD cache admission, if set.
   static std::shared_ptr<cache::ScanTracker> getTracker(
       const std::string& scanId,
-      int32_t loadQuantum);
+      int32_t loadQuantum,
+      cache::FileGroupStats* fileGroupStats = nullptr);
 
   /// Returns the IOExecutor used by the connector. It is used to run async IO
   /// operations by the connector.
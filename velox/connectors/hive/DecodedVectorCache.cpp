@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/DecodedVectorCache.h"
+
+#include <glog/logging.h>
+
+namespace facebook::velox::connector::hive {
+
+std::unique_ptr<DecodedVectorCache> DecodedVectorCache::instance_ = nullptr;
+
+// static
+DecodedVectorCache* DecodedVectorCache::create(uint64_t capacityBytes) {
+  if (instance_ == nullptr) {
+    instance_ = std::make_unique<DecodedVectorCache>(capacityBytes);
+  }
+  return instance_.get();
+}
+
+void DecodedVectorCache::put(const std::string& key, const Batches& batches) {
+  // Copies outside of the mutex of the cache. An allocation may need
+  // arbitration, which may reclaim from the cache.
+  auto copies = std::make_shared<Batches>();
+  copies->reserve(batches.size());
+  uint64_t sizeBytes{0};
+  try {
+    for (const auto& batch : batches) {
+      auto copy = std::static_pointer_cast<RowVector>(
+          BaseVector::copy(*batch, pool()));
+      sizeBytes += copy->retainedSize();
+      if (sizeBytes > maxEntryBytes()) {
+        return;
+      }
+      copies->push_back(std::move(copy));
+    }
+  } catch (const std::exception& e) {
+    // The cache is only an optimization.
+    LOG(WARNING) << "Failed to cache decoded vectors: " << e.what();
+    return;
+  }
+  SharedLRUCache::put(key, std::move(copies), sizeBytes);
+}
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/SharedLRUCache.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive {
+
+/// A process-wide cache of the decoded output of table scan splits, so that
+/// repeated scans of small hot tables return the vectors of an earlier scan
+/// without reading, decompressing and decoding the files again. An entry holds
+/// all the batches a split produced, after the filters and projections, keyed
+/// on a fingerprint of the scan and on the split. The vectors are copied into
+/// a dedicated root memory pool whose memory reclaimer evicts entries, so that
+/// the memory arbitrator can reclaim the cache. Entries are evicted in LRU
+/// order when their total size exceeds the capacity. Cached vectors are shared
+/// by the scans that return them and must not be modified.
+class DecodedVectorCache : public SharedLRUCache {
+ public:
+  using Batches = std::vector<RowVectorPtr>;
+
+  explicit DecodedVectorCache(uint64_t capacityBytes)
+      : SharedLRUCache(capacityBytes, "hive.decodedVectorCache") {}
+
+  /// Creates and returns the process-wide singleton instance.
+  static DecodedVectorCache* create(uint64_t capacityBytes);
+
+  /// Returns the process-wide singleton instance if it has been created,
+  /// nullptr otherwise.
+  static DecodedVectorCache* getInstance() {
+    return instance_.get();
+  }
+
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+  /// Returns the batches cached under 'key' or nullptr if there are none.
+  std::shared_ptr<const Batches> get(const std::string& key) {
+    return SharedLRUCache::get<Batches>(key);
+  }
+
+  /// Copies 'batches' into the pool of the cache and caches them under 'key'
+  /// unless 'key' is already cached. Does nothing if their size exceeds
+  /// maxEntryBytes() or the copy fails.
+  void put(const std::string& key, const Batches& batches);
+
+  /// Upper bound on the retained size of the batches of an entry. Scans stop
+  /// collecting the batches of a split past this.
+  uint64_t maxEntryBytes() const {
+    return capacityBytes() / kMaxEntryFraction;
+  }
+
+ private:
+  // An entry holds at most 1 / kMaxEntryFraction of the capacity.
+  static constexpr uint64_t kMaxEntryFraction = 8;
+
+  static std::unique_ptr<DecodedVectorCache> instance_;
+};
+
+} // namespace facebook::velox::connector::hive
@@ -19,6 +19,7 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/HiveConfig.h"
 
 #include <atomic>
 
@@ -39,6 +40,19 @@ std::string groupName(const std::string& filename) {
 }
 } // namespace
 
+FileHandleGenerator::FileHandleGenerator(
+    std::shared_ptr<const config::ConfigBase> properties,
+    folly::Executor* hedgedReadExecutor)
+    : properties_(std::move(properties)),
+      hedgedReadExecutor_(hedgedReadExecutor) {
+  if (hedgedReadExecutor_ != nullptr) {
+    const connector::hive::HiveConfig hiveConfig(properties_);
+    hedgedReadOptions_.latencyPercentile =
+        hiveConfig.hedgedReadLatencyPercentile();
+    hedgedReadOptions_.maxHedgesPerSecond = hiveConfig.hedgedReadMaxPerSecond();
+  }
+}
+
 std::unique_ptr<FileHandle> FileHandleGenerator::operator()(
     const FileHandleKey& key,
     const FileProperties* properties,
@@ -61,8 +75,15 @@ std::unique_ptr<FileHandle> FileHandleGenerator::operator()(
       options.fileReadOps = properties->fileReadOps;
     }
     const auto& filename = key.filename;
-    fileHandle->file = filesystems::getFileSystem(filename, properties_)
-                           ->openFileForRead(filename, options);
+    auto fileSystem = filesystems::getFileSystem(filename, properties_);
+    fileHandle->file = fileSystem->openFileForRead(filename, options);
+    // Only the remote files are hedged, which are the ones that coalesce.
+    if (hedgedReadExecutor_ != nullptr && fileHandle->file->shouldCoalesce()) {
+      fileHandle->file = std::make_shared<HedgedReadFile>(
+          std::move(fileHandle->file),
+          HedgedReadPolicy::getInstance(fileSystem->name(), hedgedReadOptions_),
+          hedgedReadExecutor_);
+    }
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
     VLOG(1) << "Generating file handle for: " << filename
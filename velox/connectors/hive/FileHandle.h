@@ -30,6 +30,7 @@
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/HedgedReadFile.h"
 #include "velox/common/file/TokenProvider.h"
 #include "velox/connectors/hive/FileProperties.h"
 
@@ -104,8 +105,11 @@ using FileHandleCache =
 class FileHandleGenerator {
  public:
   FileHandleGenerator() {}
-  FileHandleGenerator(std::shared_ptr<const config::ConfigBase> properties)
-      : properties_(std::move(properties)) {}
+  /// If 'hedgedReadExecutor' is set, the slow reads of the remote files are
+  /// hedged on it. See HedgedReadFile.
+  FileHandleGenerator(
+      std::shared_ptr<const config::ConfigBase> properties,
+      folly::Executor* hedgedReadExecutor = nullptr);
   std::unique_ptr<FileHandle> operator()(
       const FileHandleKey& filename,
       const FileProperties* properties,
@@ -113,6 +117,8 @@ class FileHandleGenerator {
 
  private:
   const std::shared_ptr<const config::ConfigBase> properties_;
+  folly::Executor* const hedgedReadExecutor_{nullptr};
+  HedgedReadPolicy::Options hedgedReadOptions_;
 };
 
 using FileHandleFactory = CachedFactory<
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/FilterResultCache.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <folly/container/F14Map.h>
+#include <folly/json.h>
+#include <glog/logging.h>
+
+namespace facebook::velox::connector::hive {
+namespace {
+// Cache entries are keyed on an id of the split key. The ids are never reused,
+// so that the entries of dropped ids are not found again.
+struct SplitKeyIds {
+  std::mutex mutex;
+  folly::F14FastMap<std::string, uint64_t> ids;
+  uint64_t nextId{0};
+};
+
+SplitKeyIds& splitKeyIds() {
+  static SplitKeyIds ids;
+  return ids;
+}
+
+std::string_view printValue(const std::string& value) {
+  return value;
+}
+
+std::string_view printValue(const std::optional<std::string>& value) {
+  return value.has_value() ? std::string_view(value.value()) : "<null>";
+}
+
+template <typename Map>
+std::string sortedEntries(const Map& map) {
+  std::vector<std::string> entries;
+  entries.reserve(map.size());
+  for (const auto& [name, value] : map) {
+    entries.push_back(fmt::format("{}={}", name, printValue(value)));
+  }
+  std::sort(entries.begin(), entries.end());
+  return fmt::format("{}", fmt::join(entries, ","));
+}
+} // namespace
+
+// static
+std::string FilterResultCache::fingerprint(
+    const common::SubfieldFilters& filters,
+    const core::TypedExprPtr& remainingFilter) {
+  std::vector<std::string> entries;
+  entries.reserve(filters.size() + 1);
+  for (const auto& [subfield, filter] : filters) {
+    // Filter::toString() does not print the values of all the filters.
+    entries.push_back(fmt::format(
+        "{}:{}", subfield.toString(), folly::toJson(filter->serialize())));
+  }
+  std::sort(entries.begin(), entries.end());
+  if (remainingFilter) {
+    entries.push_back(remainingFilter->toString());
+  }
+  return fmt::format("{}", fmt::join(entries, ";"));
+}
+
+// static
+std::optional<std::string> FilterResultCache::splitKey(
+    std::string_view fingerprint,
+    const HiveConnectorSplit& split) {
+  const auto modificationTime = split.properties.has_value()
+      ? split.properties->modificationTime
+      : std::nullopt;
+  if (!modificationTime.has_value()) {
+    return std::nullopt;
+  }
+  return fmt::format(
+      "{}|{}|{}|{}|{}|{}|{}",
+      fingerprint,
+      split.filePath,
+      split.start,
+      split.length,
+      modificationTime.value(),
+      sortedEntries(split.partitionKeys),
+      sortedEntries(split.infoColumns));
+}
+
+std::optional<cache::RawFileCacheKey> FilterResultCache::cacheKey(
+    const HiveConnectorSplit& split,
+    bool create) const {
+  auto key = splitKey(fingerprint_, split);
+  if (!key.has_value()) {
+    return std::nullopt;
+  }
+  auto& ids = splitKeyIds();
+  std::lock_guard<std::mutex> l(ids.mutex);
+  auto it = ids.ids.find(key.value());
+  if (it == ids.ids.end()) {
+    if (!create) {
+      return std::nullopt;
+    }
+    if (ids.ids.size() >= kMaxKeys) {
+      // The entries of the dropped ids are not found again and age out of
+      // the cache.
+      ids.ids.clear();
+    }
+    it = ids.ids.emplace(std::move(key.value()), kFirstId + ids.nextId++)
+             .first;
+  }
+  return cache::RawFileCacheKey{it->second, 0};
+}
+
+bool FilterResultCache::isFiltered(const HiveConnectorSplit& split) const {
+  const auto key = cacheKey(split, false);
+  return key.has_value() && cache_->exists(key.value());
+}
+
+void FilterResultCache::setFiltered(const HiveConnectorSplit& split) {
+  const auto key = cacheKey(split, true);
+  if (!key.has_value()) {
+    return;
+  }
+  try {
+    auto pin = cache_->findOrCreate(key.value(), 1, nullptr);
+    if (pin.empty() || !pin.entry()->isExclusive()) {
+      return;
+    }
+    pin.entry()->tinyData()[0] = 1;
+    pin.entry()->setExclusiveToShared(/*ssdSavable=*/false);
+  } catch (const std::exception& e) {
+    // The result is only an optimization.
+    LOG(WARNING) << "Failed to cache filter result: " << e.what();
+  }
+}
+
+} // namespace facebook::velox::connector::hive
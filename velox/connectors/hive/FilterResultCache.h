@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/core/ITypedExpr.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Remembers across queries the splits on which no row passes the filters of
+/// a table scan, so that repeated scans with the same filters skip these
+/// splits without opening the file. The results are in the AsyncDataCache
+/// and are evicted with the other cache entries. The filters must be
+/// deterministic. They are identified by a fingerprint of their printed form,
+/// and a split by its file, range, modification time, partition keys and
+/// info columns. Splits without a modification time are not cached, since a
+/// file rewritten in place would keep its result.
+class FilterResultCache {
+ public:
+  FilterResultCache(cache::AsyncDataCache* cache, std::string fingerprint)
+      : cache_(cache), fingerprint_(std::move(fingerprint)) {}
+
+  /// Returns the fingerprint of the pushed down 'filters' and the optional
+  /// 'remainingFilter'.
+  static std::string fingerprint(
+      const common::SubfieldFilters& filters,
+      const core::TypedExprPtr& remainingFilter);
+
+  /// Returns true if no row of 'split' passed the filters in an earlier
+  /// scan.
+  bool isFiltered(const HiveConnectorSplit& split) const;
+
+  /// Records that no row of 'split' passes the filters. Does nothing if
+  /// the cache is full or 'split' has no modification time.
+  void setFiltered(const HiveConnectorSplit& split);
+
+  /// Returns a key that identifies the rows of 'split' seen through a scan
+  /// with 'fingerprint'. Returns std::nullopt if 'split' has no modification
+  /// time, since the rows of the file may then change under the same key.
+  static std::optional<std::string> splitKey(
+      std::string_view fingerprint,
+      const HiveConnectorSplit& split);
+
+ private:
+  // Upper bound on the number of split keys that have an id. The ids are
+  // dropped when reached.
+  static constexpr size_t kMaxKeys = 100'000;
+
+  // The ids of the split keys start here, above the file ids of the
+  // AsyncDataCache, so that a split key never matches the data of a file.
+  static constexpr uint64_t kFirstId = 1ULL << 63;
+
+  // Returns the cache key for 'split' or std::nullopt if the key has no id
+  // and 'create' is false.
+  std::optional<cache::RawFileCacheKey> cacheKey(
+      const HiveConnectorSplit& split,
+      bool create) const;
+
+  cache::AsyncDataCache* const cache_;
+  const std::string fingerprint_;
+};
+
+} // namespace facebook::velox::connector::hive
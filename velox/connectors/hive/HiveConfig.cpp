@@ -67,6 +67,13 @@ uint32_t HiveConfig::maxPartitionsPerWriters(
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 128));
 }
 
+uint32_t HiveConfig::clusteredWritePartitionThreshold(
+    const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kClusteredWritePartitionThresholdSession,
+      config_->get<uint32_t>(kClusteredWritePartitionThreshold, 0));
+}
+
 uint32_t HiveConfig::maxBucketCount(const config::ConfigBase* session) const {
   return session->get<uint32_t>(
       kMaxBucketCountSession, config_->get<uint32_t>(kMaxBucketCount, 100'000));
@@ -155,6 +162,13 @@ int32_t HiveConfig::maxCoalescedDistanceBytes(
   return int32_t(distance);
 }
 
+bool HiveConfig::adaptiveIoPlanningEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kAdaptiveIoPlanningEnabledSession,
+      config_->get<bool>(kAdaptiveIoPlanningEnabled, false));
+}
+
 int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
@@ -185,6 +199,10 @@ bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+uint64_t HiveConfig::fileMetadataCacheCapacityBytes() const {
+  return config_->get<uint64_t>(kFileMetadataCacheCapacityBytes, 0);
+}
+
 std::string HiveConfig::writeFileCreateConfig() const {
   return config_->get<std::string>(kWriteFileCreateConfig, "");
 }
@@ -220,6 +238,13 @@ uint64_t HiveConfig::maxTargetFileSizeBytes(
       config::CapacityUnit::BYTE);
 }
 
+bool HiveConfig::asyncFileCloseEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kAsyncFileCloseEnabledSession,
+      config_->get<bool>(kAsyncFileCloseEnabled, false));
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 256UL << 10);
 }
@@ -259,6 +284,47 @@ bool HiveConfig::preserveFlatMapsInMemory(
       config_->get<bool>(kPreserveFlatMapsInMemory, false));
 }
 
+bool HiveConfig::filterResultCacheEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kFilterResultCacheEnabledSession,
+      config_->get<bool>(kFilterResultCacheEnabled, false));
+}
+
+uint64_t HiveConfig::decodedVectorCacheCapacityBytes() const {
+  return config_->get<uint64_t>(kDecodedVectorCacheCapacityBytes, 0);
+}
+
+bool HiveConfig::decodedVectorCacheEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kDecodedVectorCacheEnabledSession,
+      config_->get<bool>(kDecodedVectorCacheEnabled, false));
+}
+
+uint64_t HiveConfig::dwrfDictionaryCacheCapacityBytes() const {
+  return config_->get<uint64_t>(kDwrfDictionaryCacheCapacityBytes, 0);
+}
+
+bool HiveConfig::hedgedReadEnabled() const {
+  return config_->get<bool>(kHedgedReadEnabled, false);
+}
+
+double HiveConfig::hedgedReadLatencyPercentile() const {
+  const auto percentile =
+      config_->get<double>(kHedgedReadLatencyPercentile, 0.95);
+  VELOX_USER_CHECK(
+      percentile > 0 && percentile <= 1,
+      "{} must be in (0, 1]: {}",
+      kHedgedReadLatencyPercentile,
+      percentile);
+  return percentile;
+}
+
+uint32_t HiveConfig::hedgedReadMaxPerSecond() const {
+  return config_->get<uint32_t>(kHedgedReadMaxPerSecond, 10);
+}
+
 std::string HiveConfig::user(const config::ConfigBase* session) const {
   return session->get<std::string>(kUser, config_->get<std::string>(kUser, ""));
 }
@@ -49,6 +49,16 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// Number of distinct partitions a single table writer instance may write
+  /// through one open file writer per partition. Once a non-bucketed
+  /// partitioned write exceeds it, the remaining input is buffered in a
+  /// spillable sort buffer clustered by partition and written out one
+  /// partition at a time at finish. 0 disables the clustered write mode.
+  static constexpr const char* kClusteredWritePartitionThreshold =
+      "clustered-write-partition-threshold";
+  static constexpr const char* kClusteredWritePartitionThresholdSession =
+      "clustered_write_partition_threshold";
+
   /// Maximum number of buckets allowed to output by the table writers.
   static constexpr const char* kMaxBucketCount = "hive.max-bucket-count";
   static constexpr const char* kMaxBucketCountSession = "hive.max_bucket_count";
@@ -114,6 +124,15 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceSession =
       "orc_max_merge_distance";
 
+  /// Whether to tune the max coalesce distance and the number of splits to
+  /// preload per driver from the latency and bandwidth observed on the file
+  /// system the split is read from. The configured values are used until
+  /// enough reads have been observed.
+  static constexpr const char* kAdaptiveIoPlanningEnabled =
+      "adaptive-io-planning-enabled";
+  static constexpr const char* kAdaptiveIoPlanningEnabledSession =
+      "adaptive_io_planning_enabled";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
@@ -135,6 +154,12 @@ class HiveConfig {
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// Capacity in bytes of the process-wide cache of parsed file footers shared
+  /// by the splits of a file. Only splits with a file modification time use
+  /// the cache. 0 disables the cache.
+  static constexpr const char* kFileMetadataCacheCapacityBytes =
+      "file-metadata-cache-capacity-bytes";
+
   /// The size in bytes to be fetched with Meta data together, used when the
   /// data after meta data will be used later. Optimization to decrease small IO
   /// request
@@ -185,6 +210,15 @@ class HiveConfig {
   static constexpr const char* kMaxTargetFileSizeSession =
       "max_target_file_size";
 
+  /// If true, a writer rotated to a new file closes the previous file on the
+  /// connector IO executor, so that encoding the footer and uploading the tail
+  /// of the previous file overlap with writing the next one. The data sink
+  /// waits for the pending close before it reports the written files.
+  static constexpr const char* kAsyncFileCloseEnabled =
+      "async-file-close-enabled";
+  static constexpr const char* kAsyncFileCloseEnabledSession =
+      "async_file_close_enabled";
+
   // The unit for reading timestamps from files.
   static constexpr const char* kReadTimestampUnit =
       "hive.reader.timestamp-unit";
@@ -208,6 +242,50 @@ class HiveConfig {
   static constexpr const char* kPreserveFlatMapsInMemorySession =
       "hive.preserve_flat_maps_in_memory";
 
+  /// Whether to remember in AsyncDataCache the splits where no rows pass the
+  /// filters of a scan, so that later scans with the same filters skip them
+  /// without reading the file. Only splits with a file modification time use
+  /// the cache. Assumes that the files are immutable.
+  static constexpr const char* kFilterResultCacheEnabled =
+      "hive.filter-result-cache-enabled";
+  static constexpr const char* kFilterResultCacheEnabledSession =
+      "hive.filter_result_cache_enabled";
+
+  /// Capacity in bytes of the process-wide cache of the decoded output of
+  /// splits, used by the scans with 'hive.decoded-vector-cache-enabled'. 0
+  /// disables the cache.
+  static constexpr const char* kDecodedVectorCacheCapacityBytes =
+      "hive.decoded-vector-cache-capacity-bytes";
+
+  /// Whether repeated scans of a split with the same columns and filters
+  /// return the vectors decoded by an earlier scan. Only splits with a file
+  /// modification time use the cache. Assumes that the files are immutable.
+  static constexpr const char* kDecodedVectorCacheEnabled =
+      "hive.decoded-vector-cache-enabled";
+  static constexpr const char* kDecodedVectorCacheEnabledSession =
+      "hive.decoded_vector_cache_enabled";
+
+  /// Capacity in bytes of the process-wide cache of decoded DWRF and ORC
+  /// string dictionaries shared by the splits of a file. Only splits with a
+  /// file modification time use the cache. 0 disables the cache.
+  static constexpr const char* kDwrfDictionaryCacheCapacityBytes =
+      "hive.dwrf-dictionary-cache-capacity-bytes";
+
+  /// Whether to hedge the slow reads of the remote files. A read which takes
+  /// longer than 'hedged-read-latency-percentile' of the recent read latencies
+  /// of its file system is duplicated and the first response is used. Needs
+  /// the connector IO executor.
+  static constexpr const char* kHedgedReadEnabled = "hedged-read-enabled";
+
+  /// The percentile of the recent read latencies after which a read is
+  /// hedged.
+  static constexpr const char* kHedgedReadLatencyPercentile =
+      "hedged-read-latency-percentile";
+
+  /// The maximum number of hedged reads issued per second per file system.
+  static constexpr const char* kHedgedReadMaxPerSecond =
+      "hedged-read-max-per-second";
+
   static constexpr const char* kUser = "user";
   static constexpr const char* kSource = "source";
   static constexpr const char* kSchema = "schema";
@@ -217,6 +295,9 @@ class HiveConfig {
 
   uint32_t maxPartitionsPerWriters(const config::ConfigBase* session) const;
 
+  uint32_t clusteredWritePartitionThreshold(
+      const config::ConfigBase* session) const;
+
   uint32_t maxBucketCount(const config::ConfigBase* session) const;
 
   bool immutablePartitions() const;
@@ -248,6 +329,8 @@ class HiveConfig {
 
   int32_t maxCoalescedDistanceBytes(const config::ConfigBase* session) const;
 
+  bool adaptiveIoPlanningEnabled(const config::ConfigBase* session) const;
+
   int32_t prefetchRowGroups() const;
 
   size_t parallelUnitLoadCount(const config::ConfigBase* session) const;
@@ -260,6 +343,8 @@ class HiveConfig {
 
   bool isFileHandleCacheEnabled() const;
 
+  uint64_t fileMetadataCacheCapacityBytes() const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   std::string writeFileCreateConfig() const;
@@ -273,6 +358,8 @@ class HiveConfig {
 
   uint64_t maxTargetFileSizeBytes(const config::ConfigBase* session) const;
 
+  bool asyncFileCloseEnabled(const config::ConfigBase* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
@@ -293,6 +380,22 @@ class HiveConfig {
   /// converting them to MapVectors.
   bool preserveFlatMapsInMemory(const config::ConfigBase* session) const;
 
+  /// Whether to cache the splits where no rows pass the filters of a scan.
+  bool filterResultCacheEnabled(const config::ConfigBase* session) const;
+
+  uint64_t decodedVectorCacheCapacityBytes() const;
+
+  /// Whether scans use the cache of decoded split output.
+  bool decodedVectorCacheEnabled(const config::ConfigBase* session) const;
+
+  uint64_t dwrfDictionaryCacheCapacityBytes() const;
+
+  bool hedgedReadEnabled() const;
+
+  double hedgedReadLatencyPercentile() const;
+
+  uint32_t hedgedReadMaxPerSecond() const;
+
   /// User of the query. Used for storage logging.
   std::string user(const config::ConfigBase* session) const;
 
@@ -16,10 +16,16 @@
 
 #include "velox/connectors/hive/HiveConnector.h"
 
+#include "velox/connectors/hive/BufferedInputBuilder.h"
+#include "velox/connectors/hive/DecodedVectorCache.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/connectors/hive/HiveDataSource.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/dwio/common/DictionaryCache.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/common/ReaderFactory.h"
 
 #include <boost/lexical_cast.hpp>
 #include <memory>
@@ -39,7 +45,9 @@ HiveConnector::HiveConnector(
               ? std::make_unique<SimpleLRUCache<FileHandleKey, FileHandle>>(
                     hiveConfig_->numCacheFileHandles())
               : nullptr,
-          std::make_unique<FileHandleGenerator>(hiveConfig_->config())),
+          std::make_unique<FileHandleGenerator>(
+              hiveConfig_->config(),
+              hiveConfig_->hedgedReadEnabled() ? ioExecutor : nullptr)),
       ioExecutor_(ioExecutor) {
   if (hiveConfig_->isFileHandleCacheEnabled()) {
     LOG(INFO) << "Hive connector " << connectorId()
@@ -51,6 +59,18 @@ HiveConnector::HiveConnector(
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with file handle cache disabled";
   }
+  if (const auto capacity = hiveConfig_->fileMetadataCacheCapacityBytes();
+      capacity > 0) {
+    dwio::common::FileMetadataCache::create(capacity);
+  }
+  if (const auto capacity = hiveConfig_->decodedVectorCacheCapacityBytes();
+      capacity > 0) {
+    DecodedVectorCache::create(capacity);
+  }
+  if (const auto capacity = hiveConfig_->dwrfDictionaryCacheCapacityBytes();
+      capacity > 0) {
+    dwio::common::DictionaryCache::create(capacity);
+  }
 }
 
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
@@ -68,6 +88,54 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       hiveConfig_);
 }
 
+bool HiveConnector::supportsSplitPrewarm() const {
+  return hiveConfig_->isFileHandleCacheEnabled() ||
+      dwio::common::FileMetadataCache::getInstance() != nullptr;
+}
+
+void HiveConnector::prewarmSplit(
+    const std::shared_ptr<ConnectorSplit>& split,
+    const ConnectorQueryCtx* connectorQueryCtx) {
+  auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+  if (hiveSplit == nullptr) {
+    return;
+  }
+  // Failures are left to the read of the split to report.
+  try {
+    FileHandleKey fileHandleKey{
+        .filename = hiveSplit->filePath,
+        .tokenProvider = connectorQueryCtx->fsTokenProvider()};
+    auto fileProperties = hiveSplit->properties.value_or(FileProperties{});
+    auto fileHandle =
+        fileHandleFactory_.generate(fileHandleKey, &fileProperties, nullptr);
+
+    auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+    if (metadataCache == nullptr) {
+      return;
+    }
+    auto key = fileMetadataCacheKey(
+        hiveSplit->filePath, fileHandle->file->size(), fileProperties);
+    if (!key.has_value()) {
+      return;
+    }
+    dwio::common::ReaderOptions readerOptions(connectorQueryCtx->memoryPool());
+    readerOptions.setFileFormat(hiveSplit->fileFormat);
+    readerOptions.setFileMetadataCache(metadataCache, std::move(*key));
+    auto input = BufferedInputBuilder::getInstance()->create(
+        *fileHandle,
+        readerOptions,
+        connectorQueryCtx,
+        std::make_shared<io::IoStatistics>(),
+        std::make_shared<filesystems::File::IoStats>(),
+        ioExecutor_);
+    dwio::common::getReaderFactory(hiveSplit->fileFormat)
+        ->createReader(std::move(input), readerOptions);
+  } catch (const std::exception& e) {
+    VLOG(1) << "Failed to prewarm split " << hiveSplit->toString() << ": "
+            << e.what();
+  }
+}
+
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
     RowTypePtr inputType,
     ConnectorInsertTableHandlePtr connectorInsertTableHandle,
@@ -83,7 +151,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      ioExecutor_);
 }
 
 // static
@@ -48,6 +48,14 @@ class HiveConnector : public Connector {
     return true;
   }
 
+  /// Prewarming opens the file into the file handle cache and, if file
+  /// metadata is cached, parses its footer into the FileMetadataCache.
+  bool supportsSplitPrewarm() const override;
+
+  void prewarmSplit(
+      const std::shared_ptr<ConnectorSplit>& split,
+      const ConnectorQueryCtx* connectorQueryCtx) override;
+
   std::unique_ptr<DataSink> createDataSink(
       RowTypePtr inputType,
       ConnectorInsertTableHandlePtr connectorInsertTableHandle,
@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 
+#include "velox/common/base/BitUtil.h"
+
 namespace facebook::velox::connector::hive {
 
 std::string HiveConnectorSplit::toString() const {
@@ -34,6 +36,55 @@ uint64_t HiveConnectorSplit::size() const {
   return length;
 }
 
+std::vector<std::shared_ptr<ConnectorSplit>> HiveConnectorSplit::divide(
+    uint64_t targetBytes) const {
+  switch (fileFormat) {
+    case dwio::common::FileFormat::DWRF:
+    case dwio::common::FileFormat::ORC:
+    case dwio::common::FileFormat::PARQUET:
+      break;
+    default:
+      return {};
+  }
+  // A split without a length covers the rest of the file.
+  uint64_t end = length > std::numeric_limits<uint64_t>::max() - start
+      ? std::numeric_limits<uint64_t>::max()
+      : start + length;
+  if (properties.has_value() && properties->fileSize.has_value()) {
+    end = std::min<uint64_t>(end, properties->fileSize.value());
+  }
+  if (targetBytes == 0 || end == std::numeric_limits<uint64_t>::max() ||
+      end <= start || end - start < 2 * targetBytes) {
+    return {};
+  }
+  const uint64_t numParts = (end - start) / targetBytes;
+  const uint64_t partBytes = bits::divRoundUp(end - start, numParts);
+  std::vector<std::shared_ptr<ConnectorSplit>> parts;
+  parts.reserve(numParts);
+  for (auto partStart = start; partStart < end; partStart += partBytes) {
+    const auto partLength = std::min(partBytes, end - partStart);
+    parts.push_back(std::make_shared<HiveConnectorSplit>(
+        connectorId,
+        filePath,
+        fileFormat,
+        partStart,
+        partLength,
+        partitionKeys,
+        tableBucketNumber,
+        customSplitInfo,
+        extraFileInfo,
+        serdeParameters,
+        static_cast<int64_t>(
+            static_cast<double>(splitWeight) * partLength / (end - start)),
+        cacheable,
+        infoColumns,
+        properties,
+        rowIdProperties,
+        bucketConversion));
+  }
+  return parts;
+}
+
 std::string HiveConnectorSplit::getFileName() const {
   const auto i = filePath.rfind('/');
   return i == std::string::npos ? filePath : filePath.substr(i + 1);
@@ -110,6 +110,12 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
 
   uint64_t size() const override;
 
+  /// Divides the byte range of the split. The readers of DWRF, ORC and Parquet
+  /// files read the stripes or row groups that start in the range, so the
+  /// parts read disjoint units.
+  std::vector<std::shared_ptr<ConnectorSplit>> divide(
+      uint64_t targetBytes) const override;
+
   std::string toString() const override;
 
   std::string getFileName() const;
@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 
+#include "velox/common/caching/SsdCache.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
@@ -590,6 +591,8 @@ void configureReaderOptions(
       hiveConfig->maxCoalescedBytes(sessionProperties));
   readerOptions.setMaxCoalesceDistance(
       hiveConfig->maxCoalescedDistanceBytes(sessionProperties));
+  readerOptions.setAdaptiveIoPlanning(
+      hiveConfig->adaptiveIoPlanningEnabled(sessionProperties));
   readerOptions.setFileColumnNamesReadAsLowerCase(
       hiveConfig->isFileColumnNamesReadAsLowerCase(sessionProperties));
   readerOptions.setAllowEmptyFile(true);
@@ -728,6 +731,42 @@ bool applyPartitionFilter(
   }
 }
 
+// Returns true if every value of a column with 'stats' in a file of 'numRows'
+// rows passes 'filter'.
+bool testFilterPassesAll(
+    const common::Filter& filter,
+    const dwio::common::ColumnStatistics& stats,
+    uint64_t numRows) {
+  const auto numValues = stats.getNumberOfValues();
+  if (!numValues.has_value()) {
+    return false;
+  }
+  if (*numValues < numRows && !filter.testNull()) {
+    return false;
+  }
+  if (*numValues == 0) {
+    return true;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kAlwaysTrue:
+    case common::FilterKind::kIsNotNull:
+      return true;
+    case common::FilterKind::kBigintRange: {
+      const auto* intStats =
+          dynamic_cast<const dwio::common::IntegerColumnStatistics*>(&stats);
+      if (intStats == nullptr || !intStats->getMinimum().has_value() ||
+          !intStats->getMaximum().has_value()) {
+        return false;
+      }
+      const auto& range = static_cast<const common::BigintRange&>(filter);
+      return range.lower() <= *intStats->getMinimum() &&
+          *intStats->getMaximum() <= range.upper();
+    }
+    default:
+      return false;
+  }
+}
+
 } // namespace
 
 bool testFilters(
@@ -792,6 +831,107 @@ bool testFilters(
   return true;
 }
 
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, HiveColumnHandlePtr>&
+        partitionKeysHandle,
+    bool asLocalTime) {
+  for (const auto& child : scanSpec->children()) {
+    if (!child->filter()) {
+      continue;
+    }
+    const auto iter = partitionKeys.find(child->fieldName());
+    if (iter == partitionKeys.end()) {
+      continue;
+    }
+    if (!iter->second.has_value()) {
+      if (child->filter()->isDeterministic() && !child->filter()->testNull()) {
+        return false;
+      }
+      continue;
+    }
+    const auto handlesIter = partitionKeysHandle.find(child->fieldName());
+    VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+    if (!applyPartitionFilter(
+            handlesIter->second->dataType(),
+            iter->second.value(),
+            handlesIter->second->isPartitionDateValueDaysSinceEpoch(),
+            child->filter(),
+            asLocalTime)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool testFiltersPassAll(
+    const common::ScanSpec* scanSpec,
+    const dwio::common::Reader* reader,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, HiveColumnHandlePtr>&
+        partitionKeysHandle,
+    bool asLocalTime) {
+  const auto totalRows = reader->numberOfRows();
+  if (!totalRows.has_value()) {
+    return false;
+  }
+  const auto& fileTypeWithId = reader->typeWithId();
+  const auto& rowType = reader->rowType();
+  for (const auto& child : scanSpec->children()) {
+    if (!child->filter()) {
+      if (child->hasFilter()) {
+        // Filter on a subfield.
+        return false;
+      }
+      continue;
+    }
+    const auto& name = child->fieldName();
+    if (auto iter = partitionKeys.find(name); iter != partitionKeys.end()) {
+      if (!iter->second.has_value()) {
+        if (!child->filter()->testNull()) {
+          return false;
+        }
+        continue;
+      }
+      const auto handlesIter = partitionKeysHandle.find(name);
+      VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+      if (!applyPartitionFilter(
+              handlesIter->second->dataType(),
+              iter->second.value(),
+              handlesIter->second->isPartitionDateValueDaysSinceEpoch(),
+              child->filter(),
+              asLocalTime)) {
+        return false;
+      }
+      continue;
+    }
+    if (!rowType->containsChild(name)) {
+      return false;
+    }
+    const auto columnStats =
+        reader->columnStatistics(fileTypeWithId->childByName(name)->id());
+    if (columnStats == nullptr ||
+        !testFilterPassesAll(*child->filter(), *columnStats, *totalRows)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<std::string> fileMetadataCacheKey(
+    const std::string& filePath,
+    uint64_t fileSize,
+    const FileProperties& properties) {
+  if (!properties.modificationTime.has_value()) {
+    return std::nullopt;
+  }
+  return fmt::format(
+      "{}:{}:{}", filePath, fileSize, properties.modificationTime.value());
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
@@ -800,14 +940,17 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     std::shared_ptr<filesystems::File::IoStats> fsStats,
     folly::Executor* executor,
     const folly::F14FastMap<std::string, std::string>& fileReadOps) {
-  if (connectorQueryCtx->cache()) {
+  if (auto* cache = connectorQueryCtx->cache()) {
+    auto* ssdCache = cache->ssdCache();
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
         dwio::common::MetricsLog::voidLog(),
         fileHandle.uuid,
-        connectorQueryCtx->cache(),
+        cache,
         Connector::getTracker(
-            connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+            connectorQueryCtx->scanId(),
+            readerOpts.loadQuantum(),
+            ssdCache != nullptr ? &ssdCache->groupStats() : nullptr),
         fileHandle.groupId,
         ioStats,
         std::move(fsStats),
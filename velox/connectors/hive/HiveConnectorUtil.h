@@ -141,6 +141,39 @@ bool testFilters(
         std::shared_ptr<const HiveColumnHandle>>& partitionKeysHandle,
     bool asLocalTime);
 
+/// Returns false if the partition key values of a split prove that no row of
+/// the split passes the filters of 'scanSpec'. Only the filters on partition
+/// keys are tested, so the split can be pruned before its file is opened.
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<const HiveColumnHandle>>& partitionKeysHandle,
+    bool asLocalTime);
+
+/// Returns true if the file statistics and the partition key values prove
+/// that every row of the file passes the filters of 'scanSpec'. Only range
+/// and null filters on integer columns are proven from the statistics; any
+/// other filter on a column of the file returns false.
+bool testFiltersPassAll(
+    const common::ScanSpec* scanSpec,
+    const dwio::common::Reader* reader,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<const HiveColumnHandle>>& partitionKeysHandle,
+    bool asLocalTime);
+
+/// Returns the key of the file in the FileMetadataCache, or nullopt if the
+/// modification time is not known, in which case the metadata is not shared.
+std::optional<std::string> fileMetadataCacheKey(
+    const std::string& filePath,
+    uint64_t fileSize,
+    const FileProperties& properties);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
@@ -41,6 +41,10 @@ namespace {
   memory::NonReclaimableSectionGuard nonReclaimableGuard( \
       writerInfo_[(index)]->nonReclaimableSectionHolder.get())
 
+// The name of the partition id column appended to the data columns stored in
+// the clustered write buffer.
+constexpr const char* kClusterPartitionIdColumn = "$partition_id";
+
 // Appends a sequence number to a filename for file rotation.
 // Returns the original filename if sequenceNumber is 0 (no rotation yet).
 // Example: "file.orc" with seq 0 remains "file.orc"
@@ -468,7 +472,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* ioExecutor)
     : HiveDataSink(
           inputType,
           insertTableHandle,
@@ -487,7 +492,8 @@ HiveDataSink::HiveDataSink(
               inputType,
               insertTableHandle,
               hiveConfig,
-              connectorQueryCtx)) {}
+              connectorQueryCtx),
+          ioExecutor) {}
 
 HiveDataSink::HiveDataSink(
     RowTypePtr inputType,
@@ -499,7 +505,8 @@ HiveDataSink::HiveDataSink(
     std::unique_ptr<core::PartitionFunction> bucketFunction,
     const std::vector<column_index_t>& partitionChannels,
     const std::vector<column_index_t>& dataChannels,
-    std::unique_ptr<PartitionIdGenerator> partitionIdGenerator)
+    std::unique_ptr<PartitionIdGenerator> partitionIdGenerator,
+    folly::Executor* ioExecutor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -521,8 +528,16 @@ HiveDataSink::HiveDataSink(
           connectorQueryCtx->sessionProperties())),
       maxTargetFileBytes_(hiveConfig_->maxTargetFileSizeBytes(
           connectorQueryCtx->sessionProperties())),
+      fileCloseExecutor_(
+          hiveConfig_->asyncFileCloseEnabled(
+              connectorQueryCtx->sessionProperties())
+              ? ioExecutor
+              : nullptr),
       partitionKeyAsLowerCase_(hiveConfig_->isPartitionPathAsLowerCase(
           connectorQueryCtx_->sessionProperties())),
+      clusteredWritePartitionThreshold_(
+          hiveConfig_->clusteredWritePartitionThreshold(
+              connectorQueryCtx_->sessionProperties())),
       fileNameGenerator_(insertTableHandle_->fileNameGenerator()) {
   fileSystemStats_ = std::make_unique<filesystems::File::IoStats>();
 
@@ -568,6 +583,11 @@ HiveDataSink::HiveDataSink(
   }
 }
 
+HiveDataSink::~HiveDataSink() {
+  // The closing writer references the memory pools and io stats of this sink.
+  waitForPendingFileClose(/*throwOnError=*/false);
+}
+
 bool HiveDataSink::canReclaim() const {
   // Currently, we only support memory reclaim on dwrf file writer.
   return (spillConfig_ != nullptr) &&
@@ -591,6 +611,16 @@ void HiveDataSink::appendData(RowVectorPtr input) {
   // Compute partition and bucket numbers.
   computePartitionAndBucketIds(input);
 
+  // Buffer the input clustered by partition once there are too many partitions
+  // to keep one open writer for each of them.
+  if (clusteredWriteEnabled() &&
+      (clusteredWrite() ||
+       partitionIdGenerator_->numPartitions() >
+           clusteredWritePartitionThreshold_)) {
+    appendClusteredData(input);
+    return;
+  }
+
   // All inputs belong to a single non-bucketed partition. The partition id
   // must be zero.
   if (!isBucketed() && partitionIdGenerator_->numPartitions() == 1) {
@@ -615,9 +645,11 @@ void HiveDataSink::appendData(RowVectorPtr input) {
 }
 
 void HiveDataSink::write(size_t index, RowVectorPtr input) {
-  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
-  auto dataInput = makeDataInput(dataChannels_, input);
+  writeData(index, makeDataInput(dataChannels_, input));
+}
 
+void HiveDataSink::writeData(size_t index, const RowVectorPtr& dataInput) {
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   writers_[index]->write(dataInput);
   writerInfo_[index]->inputSizeInBytes += dataInput->estimateFlatSize();
   writerInfo_[index]->numWrittenRows += dataInput->size();
@@ -635,6 +667,159 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
   }
 }
 
+void HiveDataSink::createClusterBuffer() {
+  VELOX_CHECK_NULL(clusterBuffer_);
+  auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+  clusterPool_ = connectorPool->addLeafChild(
+      fmt::format("{}.cluster", connectorPool->name()));
+  if (connectorPool->reclaimer() != nullptr) {
+    clusterPool_->setReclaimer(ClusterBufferReclaimer::create(this));
+  }
+
+  const auto dataType = getNonPartitionTypes(dataChannels_, inputType_);
+  auto names = dataType->names();
+  auto types = dataType->children();
+  names.emplace_back(kClusterPartitionIdColumn);
+  types.emplace_back(BIGINT());
+  clusterBufferType_ = ROW(std::move(names), std::move(types));
+  clusterBuffer_ = std::make_unique<exec::SortBuffer>(
+      clusterBufferType_,
+      std::vector<column_index_t>{
+          static_cast<column_index_t>(dataType->size())},
+      std::vector<CompareFlags>{CompareFlags{
+          true, true, false, CompareFlags::NullHandlingMode::kNullAsValue}},
+      clusterPool_.get(),
+      &nonReclaimableSection_,
+      connectorQueryCtx_->prefixSortConfig(),
+      spillConfig_,
+      &clusterSpillStats_);
+  addThreadLocalRuntimeStat(kClusteredWrite, RuntimeCounter(1));
+}
+
+void HiveDataSink::appendClusteredData(const RowVectorPtr& input) {
+  if (!clusteredWrite()) {
+    createClusterBuffer();
+  }
+
+  const auto numRows = input->size();
+  auto partitionIds = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), numRows, connectorQueryCtx_->memoryPool());
+  auto* rawPartitionIds = partitionIds->mutableRawValues();
+  for (auto row = 0; row < numRows; ++row) {
+    rawPartitionIds[row] = static_cast<int64_t>(partitionIds_[row]);
+  }
+
+  std::vector<VectorPtr> children;
+  children.reserve(dataChannels_.size() + 1);
+  for (const auto dataChannel : dataChannels_) {
+    children.push_back(input->childAt(dataChannel));
+  }
+  children.push_back(std::move(partitionIds));
+
+  memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+  clusterBuffer_->addInput(
+      std::make_shared<RowVector>(
+          input->pool(),
+          clusterBufferType_,
+          nullptr,
+          numRows,
+          std::move(children)));
+}
+
+bool HiveDataSink::finishClusteredWrite() {
+  VELOX_CHECK(clusteredWrite());
+  const uint64_t startTimeMs = getCurrentTimeMs();
+  if (!clusterBufferNoMoreInput_) {
+    memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+    clusterBuffer_->noMoreInput();
+    clusterBufferNoMoreInput_ = true;
+  }
+
+  const auto maxOutputRows = hiveConfig_->sortWriterMaxOutputRows(
+      connectorQueryCtx_->sessionProperties());
+  for (;;) {
+    RowVectorPtr output;
+    {
+      memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+      output = clusterBuffer_->getOutput(maxOutputRows);
+    }
+    if (output == nullptr) {
+      break;
+    }
+    writeClusteredOutput(output);
+    if (getCurrentTimeMs() - startTimeMs > sortWriterFinishTimeSliceLimitMs_) {
+      return false;
+    }
+  }
+
+  closeClusteredWriter();
+  clusterBuffer_.reset();
+  return true;
+}
+
+void HiveDataSink::writeClusteredOutput(const RowVectorPtr& output) {
+  const auto numRows = output->size();
+  const auto partitionIdChannel = clusterBufferType_->size() - 1;
+  const auto* partitionIds =
+      output->childAt(partitionIdChannel)->asFlatVector<int64_t>();
+  VELOX_CHECK_NOT_NULL(partitionIds);
+
+  std::vector<VectorPtr> dataColumns(
+      output->children().begin(),
+      output->children().begin() + partitionIdChannel);
+  const auto dataInput = std::make_shared<RowVector>(
+      output->pool(),
+      getNonPartitionTypes(dataChannels_, inputType_),
+      nullptr,
+      numRows,
+      std::move(dataColumns));
+
+  vector_size_t start = 0;
+  while (start < numRows) {
+    const auto partitionId = partitionIds->valueAt(start);
+    vector_size_t end = start + 1;
+    while (end < numRows && partitionIds->valueAt(end) == partitionId) {
+      ++end;
+    }
+
+    const auto index =
+        ensureWriter(HiveWriterId{static_cast<uint32_t>(partitionId)});
+    if (activeClusteredWriter_.has_value() &&
+        activeClusteredWriter_.value() != index) {
+      closeClusteredWriter();
+    }
+    // The buffer output is sorted by partition id so a partition never comes
+    // back once its writer has been closed.
+    VELOX_CHECK_NOT_NULL(
+        writers_[index],
+        "Partition {} is written after its writer was closed",
+        partitionId);
+    activeClusteredWriter_ = index;
+
+    writeData(
+        index,
+        start == 0 && end == numRows
+            ? dataInput
+            : std::static_pointer_cast<RowVector>(
+                  dataInput->slice(start, end - start)));
+    start = end;
+  }
+}
+
+void HiveDataSink::closeClusteredWriter() {
+  if (!activeClusteredWriter_.has_value()) {
+    return;
+  }
+  const auto index = activeClusteredWriter_.value();
+  activeClusteredWriter_.reset();
+
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+  writers_[index]->close();
+  finalizeWriterFile(index);
+  // Release the writer memory before writing the next partition.
+  writers_[index].reset();
+}
+
 uint64_t HiveDataSink::getCurrentFileBytes(size_t writerIndex) const {
   VELOX_CHECK_LT(writerIndex, ioStats_.size());
   VELOX_CHECK_LT(writerIndex, writerInfo_.size());
@@ -682,14 +867,18 @@ void HiveDataSink::rotateWriter(size_t index) {
   auto& info = writerInfo_[index];
   const auto& originalParams = info->writerParameters;
 
-  // Close the writer first to flush all data including footer.
-  writers_[index]->close();
+  if (fileCloseExecutor_ != nullptr) {
+    closeWriterAsync(index);
+  } else {
+    // Close the writer first to flush all data including footer.
+    writers_[index]->close();
 
-  // Finalize the current file state.
-  finalizeWriterFile(index);
+    // Finalize the current file state.
+    finalizeWriterFile(index);
 
-  // Release old writer's memory pools before creating new writer.
-  writers_[index].reset();
+    // Release old writer's memory pools before creating new writer.
+    writers_[index].reset();
+  }
 
   ++info->fileSequenceNumber;
 
@@ -715,6 +904,58 @@ void HiveDataSink::rotateWriter(size_t index) {
       options);
 }
 
+void HiveDataSink::closeWriterAsync(size_t index) {
+  VELOX_CHECK_NOT_NULL(fileCloseExecutor_);
+  // Only one rotated file is closed in the background at a time.
+  waitForPendingFileClose();
+
+  auto& info = writerInfo_[index];
+  HiveFileInfo fileInfo;
+  fileInfo.writeFileName = info->currentWriteFileName;
+  fileInfo.targetFileName = info->currentTargetFileName;
+  info->writtenFiles.push_back(std::move(fileInfo));
+
+  // The closing writer keeps writing the footer to its io stats, so the next
+  // file gets its own to keep the file sizes apart.
+  rotatedIoStats_.push_back(std::move(ioStats_[index]));
+  ioStats_[index] = std::make_unique<io::IoStatistics>();
+
+  pendingFileClose_ = PendingFileClose{
+      .writerIndex = index,
+      .fileIndex = info->writtenFiles.size() - 1,
+      .ioStats = rotatedIoStats_.back().get(),
+      .baselineBytes = info->cumulativeWrittenBytes,
+      .future =
+          folly::via(
+              fileCloseExecutor_,
+              [writer = std::move(writers_[index])]() mutable {
+                writer->close();
+                // Release the writer memory before the close completes.
+                writer.reset();
+              })
+              .semi()};
+  info->cumulativeWrittenBytes = 0;
+}
+
+void HiveDataSink::waitForPendingFileClose(bool throwOnError) {
+  if (!pendingFileClose_.has_value()) {
+    return;
+  }
+  auto pending = std::move(pendingFileClose_.value());
+  pendingFileClose_.reset();
+  auto result = std::move(pending.future).getTry();
+  if (result.hasException()) {
+    if (throwOnError) {
+      result.throwUnlessValue();
+    }
+    return;
+  }
+  auto& fileInfo =
+      writerInfo_[pending.writerIndex]->writtenFiles[pending.fileIndex];
+  fileInfo.fileSize =
+      pending.ioStats->rawBytesWritten() - pending.baselineBytes;
+}
+
 std::string HiveDataSink::stateString(State state) {
   switch (state) {
     case State::kRunning:
@@ -766,6 +1007,10 @@ DataSink::Stats HiveDataSink::stats() const {
     stats.numWrittenBytes += ioStats->rawBytesWritten();
     stats.writeIOTimeUs += ioStats->writeIOTimeUs();
   }
+  for (const auto& ioStats : rotatedIoStats_) {
+    stats.numWrittenBytes += ioStats->rawBytesWritten();
+    stats.writeIOTimeUs += ioStats->writeIOTimeUs();
+  }
 
   if (state_ != State::kClosed) {
     return stats;
@@ -782,6 +1027,10 @@ DataSink::Stats HiveDataSink::stats() const {
       stats.spillStats += *spillStats;
     }
   }
+  const auto clusterSpillStats = clusterSpillStats_.rlock();
+  if (!clusterSpillStats->empty()) {
+    stats.spillStats += *clusterSpillStats;
+  }
   return stats;
 }
 
@@ -807,13 +1056,13 @@ std::shared_ptr<memory::MemoryPool> HiveDataSink::createWriterPool(
 
 void HiveDataSink::setMemoryReclaimers(
     HiveWriterInfo* writerInfo,
-    io::IoStatistics* ioStats) {
+    size_t writerIndex) {
   auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
   if (connectorPool->reclaimer() == nullptr) {
     return;
   }
   writerInfo->writerPool->setReclaimer(
-      WriterReclaimer::create(this, writerInfo, ioStats));
+      WriterReclaimer::create(this, writerInfo, writerIndex));
   writerInfo->sinkPool->setReclaimer(exec::MemoryReclaimer::create());
   // NOTE: we set the memory reclaimer for sort pool when we construct the sort
   // writer.
@@ -852,6 +1101,10 @@ bool HiveDataSink::finish() {
   // Flush is reentry state.
   setState(State::kFinishing);
 
+  if (clusteredWrite() && !finishClusteredWrite()) {
+    return false;
+  }
+
   // As for now, only sorted writer needs flush buffered data. For non-sorted
   // writer, data is directly written to the underlying file writer.
   if (!sortWrite()) {
@@ -887,11 +1140,13 @@ std::vector<std::string> HiveDataSink::commitMessage() const {
 
     // Build the fileWriteInfos array from all written files.
     folly::dynamic fileWriteInfosArray = folly::dynamic::array;
+    uint64_t onDiskDataSizeInBytes{0};
     for (const auto& fileInfo : info->writtenFiles) {
       fileWriteInfosArray.push_back(
           folly::dynamic::object("writeFileName", fileInfo.writeFileName)(
               "targetFileName", fileInfo.targetFileName)(
               "fileSize", fileInfo.fileSize));
+      onDiskDataSizeInBytes += fileInfo.fileSize;
     }
 
     // clang-format off
@@ -906,7 +1161,7 @@ std::vector<std::string> HiveDataSink::commitMessage() const {
           ("fileWriteInfos", std::move(fileWriteInfosArray))
           ("rowCount", info->numWrittenRows)
           ("inMemoryDataSizeInBytes", info->inputSizeInBytes)
-          ("onDiskDataSizeInBytes", ioStats_.at(i)->rawBytesWritten())
+          ("onDiskDataSizeInBytes", onDiskDataSizeInBytes)
           ("containsNumberedFileNames", true));
     // clang-format on
     partitionUpdates.push_back(partitionUpdateJson);
@@ -931,6 +1186,7 @@ void HiveDataSink::closeInternal() {
   // a new one. If an error occurs during new writer creation, or if abort is
   // called during this window, the writer slot may be empty.
   if (state_ == State::kClosed) {
+    waitForPendingFileClose();
     for (int i = 0; i < writers_.size(); ++i) {
       if (writers_[i] == nullptr) {
         continue;
@@ -940,6 +1196,7 @@ void HiveDataSink::closeInternal() {
       finalizeWriterFile(i);
     }
   } else {
+    waitForPendingFileClose(/*throwOnError=*/false);
     for (int i = 0; i < writers_.size(); ++i) {
       if (writers_[i] == nullptr) {
         continue;
@@ -948,6 +1205,8 @@ void HiveDataSink::closeInternal() {
       writers_[i]->abort();
     }
   }
+  activeClusteredWriter_.reset();
+  clusterBuffer_.reset();
 }
 
 uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
@@ -1022,9 +1281,12 @@ std::shared_ptr<dwio::common::WriterOptions> HiveDataSink::createWriterOptions(
 }
 
 uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
-  // Check max open writers.
-  VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+  // Check max open writers. The clustered write mode closes each buffered
+  // partition's writer before opening the next one.
+  if (!clusteredWrite()) {
+    VELOX_USER_CHECK_LE(
+        writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+  }
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
   VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
 
@@ -1056,7 +1318,7 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   newInfo->currentTargetFileName = newInfo->writerParameters.targetFileName();
   ioStats_.emplace_back(std::make_unique<io::IoStatistics>());
 
-  setMemoryReclaimers(writerInfo_.back().get(), ioStats_.back().get());
+  setMemoryReclaimers(writerInfo_.back().get(), ioStats_.size() - 1);
 
   auto options = createWriterOptions();
 
@@ -1480,9 +1742,9 @@ LocationHandlePtr LocationHandle::create(const folly::dynamic& obj) {
 std::unique_ptr<memory::MemoryReclaimer> HiveDataSink::WriterReclaimer::create(
     HiveDataSink* dataSink,
     HiveWriterInfo* writerInfo,
-    io::IoStatistics* ioStats) {
+    size_t writerIndex) {
   return std::unique_ptr<memory::MemoryReclaimer>(
-      new HiveDataSink::WriterReclaimer(dataSink, writerInfo, ioStats));
+      new HiveDataSink::WriterReclaimer(dataSink, writerInfo, writerIndex));
 }
 
 bool HiveDataSink::WriterReclaimer::reclaimableBytes(
@@ -1517,13 +1779,20 @@ uint64_t HiveDataSink::WriterReclaimer::reclaim(
     return 0;
   }
 
+  // The writer of a rotated file must not be flushed while it is closed in the
+  // background. The close error if any is reported by the data sink close.
+  if (dataSink_->pendingFileClose_.has_value()) {
+    dataSink_->pendingFileClose_->future.wait();
+  }
+
+  const auto* ioStats = dataSink_->ioStats_[writerIndex_].get();
   const uint64_t memoryUsageBeforeReclaim = pool->reservedBytes();
   const std::string memoryUsageTreeBeforeReclaim = pool->treeMemoryUsage();
-  const auto writtenBytesBeforeReclaim = ioStats_->rawBytesWritten();
+  const auto writtenBytesBeforeReclaim = ioStats->rawBytesWritten();
   const auto reclaimedBytes =
       exec::MemoryReclaimer::reclaim(pool, targetBytes, maxWaitMs, stats);
   const auto earlyFlushedRawBytes =
-      ioStats_->rawBytesWritten() - writtenBytesBeforeReclaim;
+      ioStats->rawBytesWritten() - writtenBytesBeforeReclaim;
   addThreadLocalRuntimeStat(
       kEarlyFlushedRawBytes,
       RuntimeCounter(earlyFlushedRawBytes, RuntimeCounter::Unit::kBytes));
@@ -1543,4 +1812,59 @@ uint64_t HiveDataSink::WriterReclaimer::reclaim(
   }
   return reclaimedBytes;
 }
+
+std::unique_ptr<memory::MemoryReclaimer>
+HiveDataSink::ClusterBufferReclaimer::create(HiveDataSink* dataSink) {
+  return std::unique_ptr<memory::MemoryReclaimer>(
+      new HiveDataSink::ClusterBufferReclaimer(dataSink));
+}
+
+bool HiveDataSink::ClusterBufferReclaimer::reclaimableBytes(
+    const memory::MemoryPool& pool,
+    uint64_t& reclaimableBytes) const {
+  VELOX_CHECK_EQ(pool.name(), dataSink_->clusterPool_->name());
+  reclaimableBytes = 0;
+  const auto* clusterBuffer = dataSink_->clusterBuffer_.get();
+  if (clusterBuffer == nullptr || !clusterBuffer->canSpill()) {
+    return false;
+  }
+  reclaimableBytes = pool.usedBytes();
+  return true;
+}
+
+uint64_t HiveDataSink::ClusterBufferReclaimer::reclaim(
+    memory::MemoryPool* pool,
+    uint64_t /*unused*/,
+    uint64_t /*unused*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK_EQ(pool->name(), dataSink_->clusterPool_->name());
+  auto* clusterBuffer = dataSink_->clusterBuffer_.get();
+  if (clusterBuffer == nullptr || !clusterBuffer->canSpill()) {
+    return 0;
+  }
+
+  if (dataSink_->nonReclaimableSection_ ||
+      (dataSink_->state_ != State::kRunning &&
+       dataSink_->state_ != State::kFinishing)) {
+    RECORD_METRIC_VALUE(kMetricMemoryNonReclaimableCount);
+    LOG(WARNING) << "Can't reclaim from hive cluster buffer pool "
+                 << pool->name()
+                 << ", state: " << stateString(dataSink_->state_)
+                 << ", reservation: " << succinctBytes(pool->reservedBytes());
+    ++stats.numNonReclaimableAttempts;
+    return 0;
+  }
+
+  return memory::MemoryReclaimer::run(
+      [&]() {
+        int64_t reclaimedBytes{0};
+        {
+          memory::ScopedReclaimedBytesRecorder recorder(pool, &reclaimedBytes);
+          clusterBuffer->spill();
+          pool->release();
+        }
+        return reclaimedBytes;
+      },
+      stats);
+}
 } // namespace facebook::velox::connector::hive
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/futures/Future.h>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/HiveConfig.h"
@@ -25,6 +27,7 @@
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/SortBuffer.h"
 
 namespace facebook::velox::connector::hive {
 
@@ -516,6 +519,8 @@ class HiveDataSink : public DataSink {
  public:
   /// The list of runtime stats reported by hive data sink
   static constexpr const char* kEarlyFlushedRawBytes = "earlyFlushedRawBytes";
+  /// Set to one when the data sink switches to the clustered write mode.
+  static constexpr const char* kClusteredWrite = "clusteredWrite";
 
   /// Defines the execution states of a hive data sink running internally.
   enum class State {
@@ -542,12 +547,15 @@ class HiveDataSink : public DataSink {
   /// @param commitStrategy Strategy for committing written data (kNoCommit or
   /// kTaskCommit).
   /// @param hiveConfig Hive connector configuration.
+  /// @param ioExecutor Executor used to close rotated files in the background
+  /// if async file close is enabled.
   HiveDataSink(
       RowTypePtr inputType,
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* ioExecutor = nullptr);
 
   /// Constructor with explicit bucketing and partitioning parameters.
   ///
@@ -574,6 +582,8 @@ class HiveDataSink : public DataSink {
   /// @param partitionIdGenerator Generates partition IDs from partition column
   /// values (nullptr if not partitioned). Compute partition key combinations to
   /// unique IDs.
+  /// @param ioExecutor Executor used to close rotated files in the background
+  /// if async file close is enabled.
   HiveDataSink(
       RowTypePtr inputType,
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
@@ -584,7 +594,10 @@ class HiveDataSink : public DataSink {
       std::unique_ptr<core::PartitionFunction> bucketFunction,
       const std::vector<column_index_t>& partitionChannels,
       const std::vector<column_index_t>& dataChannels,
-      std::unique_ptr<PartitionIdGenerator> partitionIdGenerator);
+      std::unique_ptr<PartitionIdGenerator> partitionIdGenerator,
+      folly::Executor* ioExecutor = nullptr);
+
+  ~HiveDataSink() override;
 
   void appendData(RowVectorPtr input) override;
 
@@ -618,7 +631,7 @@ class HiveDataSink : public DataSink {
     static std::unique_ptr<memory::MemoryReclaimer> create(
         HiveDataSink* dataSink,
         HiveWriterInfo* writerInfo,
-        io::IoStatistics* ioStats);
+        size_t writerIndex);
 
     bool reclaimableBytes(
         const memory::MemoryPool& pool,
@@ -634,19 +647,45 @@ class HiveDataSink : public DataSink {
     WriterReclaimer(
         HiveDataSink* dataSink,
         HiveWriterInfo* writerInfo,
-        io::IoStatistics* ioStats)
+        size_t writerIndex)
         : exec::MemoryReclaimer(0),
           dataSink_(dataSink),
           writerInfo_(writerInfo),
-          ioStats_(ioStats) {
+          writerIndex_(writerIndex) {
       VELOX_CHECK_NOT_NULL(dataSink_);
       VELOX_CHECK_NOT_NULL(writerInfo_);
-      VELOX_CHECK_NOT_NULL(ioStats_);
     }
 
     HiveDataSink* const dataSink_;
     HiveWriterInfo* const writerInfo_;
-    io::IoStatistics* const ioStats_;
+    // Index of the writer in 'dataSink_'. The io stats are looked up by
+    // index as an async file close swaps them on rotation.
+    const size_t writerIndex_;
+  };
+
+  // Spills the clustered write buffer under memory pressure.
+  class ClusterBufferReclaimer : public exec::MemoryReclaimer {
+   public:
+    static std::unique_ptr<memory::MemoryReclaimer> create(
+        HiveDataSink* dataSink);
+
+    bool reclaimableBytes(
+        const memory::MemoryPool& pool,
+        uint64_t& reclaimableBytes) const override;
+
+    uint64_t reclaim(
+        memory::MemoryPool* pool,
+        uint64_t targetBytes,
+        uint64_t maxWaitMs,
+        memory::MemoryReclaimer::Stats& stats) override;
+
+   private:
+    explicit ClusterBufferReclaimer(HiveDataSink* dataSink)
+        : exec::MemoryReclaimer(0), dataSink_(dataSink) {
+      VELOX_CHECK_NOT_NULL(dataSink_);
+    }
+
+    HiveDataSink* const dataSink_;
   };
 
   FOLLY_ALWAYS_INLINE bool sortWrite() const {
@@ -663,6 +702,17 @@ class HiveDataSink : public DataSink {
     return bucketCount_ != 0;
   }
 
+  // Returns true if the data sink may switch to the clustered write mode.
+  FOLLY_ALWAYS_INLINE bool clusteredWriteEnabled() const {
+    return clusteredWritePartitionThreshold_ != 0 && isPartitioned() &&
+        !isBucketed();
+  }
+
+  // Returns true if the data sink has switched to the clustered write mode.
+  FOLLY_ALWAYS_INLINE bool clusteredWrite() const {
+    return clusterBuffer_ != nullptr;
+  }
+
   FOLLY_ALWAYS_INLINE bool isCommitRequired() const {
     return commitStrategy_ != CommitStrategy::kNoCommit;
   }
@@ -670,9 +720,7 @@ class HiveDataSink : public DataSink {
   std::shared_ptr<memory::MemoryPool> createWriterPool(
       const HiveWriterId& writerId);
 
-  void setMemoryReclaimers(
-      HiveWriterInfo* writerInfo,
-      io::IoStatistics* ioStats);
+  void setMemoryReclaimers(HiveWriterInfo* writerInfo, size_t writerIndex);
 
   // Returns the bytes written to the current file for the specified writer.
   // This is calculated as total bytes minus cumulative bytes from rotated
@@ -755,6 +803,31 @@ class HiveDataSink : public DataSink {
   // Invoked to write 'input' to the specified file writer.
   void write(size_t index, RowVectorPtr input);
 
+  // Writes 'dataInput' which only contains the data columns to the specified
+  // file writer, and rotates the file if it exceeds the target file size.
+  void writeData(size_t index, const RowVectorPtr& dataInput);
+
+  // Creates the sort buffer used by the clustered write mode. It stores the
+  // data columns followed by the partition id column, sorted by the latter.
+  void createClusterBuffer();
+
+  // Buffers 'input' in 'clusterBuffer_' tagged with the partition ids computed
+  // by 'computePartitionAndBucketIds'.
+  void appendClusteredData(const RowVectorPtr& input);
+
+  // Drains 'clusterBuffer_' in partition order, writing each partition with a
+  // single open writer. Returns false if it yields before the buffer is fully
+  // drained.
+  bool finishClusteredWrite();
+
+  // Writes a sorted batch from 'clusterBuffer_', one contiguous partition run
+  // at a time.
+  void writeClusteredOutput(const RowVectorPtr& output);
+
+  // Closes the writer of the partition being written in the clustered write
+  // mode, if any.
+  void closeClusteredWriter();
+
   /// Rotates the writer at the given index to a new file. This is called when
   /// the current file exceeds maxTargetFileBytes_. The old writer is closed
   /// and a new writer is created for the same partition/bucket.
@@ -765,6 +838,15 @@ class HiveDataSink : public DataSink {
   /// Called by rotateWriter() and closeInternal().
   void finalizeWriterFile(size_t index);
 
+  // Closes the current writer at 'index' on 'fileCloseExecutor_' and sets up
+  // the io stats of the next file. The file size is recorded in
+  // 'writtenFiles' when the close is waited by waitForPendingFileClose().
+  void closeWriterAsync(size_t index);
+
+  // Waits for the rotated file being closed in the background, if any, and
+  // records its file size. Rethrows the close error if 'throwOnError' is true.
+  void waitForPendingFileClose(bool throwOnError = true);
+
   void closeInternal();
 
   // IMPORTANT NOTE: these are passed to writers as raw pointers. HiveDataSink
@@ -773,6 +855,9 @@ class HiveDataSink : public DataSink {
   // these stats will outlive the HiveDataSink instance. This is a reasonable
   // assumption given the semantics of these stats objects.
   std::vector<std::unique_ptr<io::IoStatistics>> ioStats_;
+  // The io stats of the files rotated out by async file close. Each is only
+  // referenced by the sink of a single file, and retained for the totals.
+  std::vector<std::unique_ptr<io::IoStatistics>> rotatedIoStats_;
   // Generic filesystem stats, exposed as RuntimeStats
   std::unique_ptr<filesystems::File::IoStats> fileSystemStats_;
 
@@ -793,7 +878,11 @@ class HiveDataSink : public DataSink {
   const common::SpillConfig* const spillConfig_;
   const uint64_t sortWriterFinishTimeSliceLimitMs_{0};
   const uint64_t maxTargetFileBytes_{0};
+  // Executor to close the rotated files on. Null if async file close is
+  // disabled.
+  folly::Executor* const fileCloseExecutor_;
   const bool partitionKeyAsLowerCase_;
+  const uint32_t clusteredWritePartitionThreshold_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
@@ -824,6 +913,35 @@ class HiveDataSink : public DataSink {
 
   // Strategy for naming writer files
   std::shared_ptr<const FileNameGenerator> fileNameGenerator_;
+
+  // Below are structures for the clustered write mode. 'clusterBuffer_' is
+  // created once the number of partitions exceeds
+  // 'clusteredWritePartitionThreshold_' and buffers all the subsequent input
+  // until finish.
+  std::shared_ptr<memory::MemoryPool> clusterPool_;
+  RowTypePtr clusterBufferType_;
+  folly::Synchronized<common::SpillStats> clusterSpillStats_;
+  std::unique_ptr<exec::SortBuffer> clusterBuffer_;
+  bool clusterBufferNoMoreInput_{false};
+  // The index of the writer in 'writers_' currently written from
+  // 'clusterBuffer_'.
+  std::optional<uint32_t> activeClusteredWriter_;
+
+  // A rotated file whose writer is being closed on 'fileCloseExecutor_'.
+  struct PendingFileClose {
+    size_t writerIndex;
+    // Index of the file in the 'writtenFiles' of the writer.
+    size_t fileIndex;
+    // The io stats of the file sink, owned by 'rotatedIoStats_'.
+    io::IoStatistics* ioStats;
+    // The bytes in 'ioStats' written before the file was opened.
+    uint64_t baselineBytes;
+    folly::SemiFuture<folly::Unit> future;
+  };
+
+  // At most one rotated file is closed in the background at a time to bound
+  // the memory held by the closing writers.
+  std::optional<PendingFileClose> pendingFileClose_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
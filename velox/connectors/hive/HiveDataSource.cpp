@@ -16,14 +16,18 @@
 
 #include "velox/connectors/hive/HiveDataSource.h"
 
+#include <algorithm>
 #include <fmt/ranges.h>
 #include <string>
+#include <typeinfo>
 #include <unordered_map>
 
 #include "velox/common/Casts.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/dwio/common/AdaptiveIoPlanner.h"
 
+#include "velox/expression/ExprConstants.h"
 #include "velox/expression/FieldReference.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -96,24 +100,29 @@ HiveDataSource::HiveDataSource(
   }
 
   std::vector<std::string> readColumnNames;
-  auto readColumnTypes = outputType_->children();
-  for (const auto& outputName : outputType_->names()) {
-    auto it = assignments.find(outputName);
-    VELOX_CHECK(
-        it != assignments.end(),
-        "ColumnHandle is missing for output column: {}",
-        outputName);
-
-    auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
-    readColumnNames.push_back(handle->name());
-    for (auto& subfield : handle->requiredSubfields()) {
-      VELOX_USER_CHECK_EQ(
-          getColumnName(subfield),
-          handle->name(),
-          "Required subfield does not match column name");
-      subfields_[handle->name()].push_back(&subfield);
+  std::vector<TypePtr> readColumnTypes;
+  if (!hiveTableHandle_->aggregates().empty()) {
+    setupAggregates(assignments, readColumnNames, readColumnTypes);
+  } else {
+    readColumnTypes = outputType_->children();
+    for (const auto& outputName : outputType_->names()) {
+      auto it = assignments.find(outputName);
+      VELOX_CHECK(
+          it != assignments.end(),
+          "ColumnHandle is missing for output column: {}",
+          outputName);
+
+      auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
+      readColumnNames.push_back(handle->name());
+      for (auto& subfield : handle->requiredSubfields()) {
+        VELOX_USER_CHECK_EQ(
+            getColumnName(subfield),
+            handle->name(),
+            "Required subfield does not match column name");
+        subfields_[handle->name()].push_back(&subfield);
+      }
+      columnPostProcessors_.push_back(handle->postProcessor());
     }
-    columnPostProcessors_.push_back(handle->postProcessor());
   }
 
   if (hiveConfig_->isFileColumnNamesReadAsLowerCase(
@@ -143,11 +152,13 @@ HiveDataSource::HiveDataSource(
     for (int i = 0; i < readColumnNames.size(); ++i) {
       columnNames[readColumnNames[i]] = i;
     }
+    folly::F14FastSet<std::string> eagerFieldNames;
     for (auto& input : remainingFilterExpr->distinctFields()) {
       auto it = columnNames.find(input->field());
       if (it != columnNames.end()) {
         if (shouldEagerlyMaterialize(*remainingFilterExpr, *input)) {
           multiReferencedFields_.push_back(it->second);
+          eagerFieldNames.insert(input->field());
         }
         continue;
       }
@@ -157,6 +168,8 @@ HiveDataSource::HiveDataSource(
       readColumnNames.push_back(input->field());
       readColumnTypes.push_back(input->type());
     }
+    setupStagedRemainingFilter(remainingFilter, eagerFieldNames);
+    setupSplitConstantFilter(remainingFilter);
     remainingFilterSubfields_ = remainingFilterExpr->extractSubfields();
     if (VLOG_IS_ON(1)) {
       VLOG(1) << fmt::format(
@@ -197,10 +210,144 @@ HiveDataSource::HiveDataSource(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
   }
 
+  if (hiveConfig_->filterResultCacheEnabled(
+          connectorQueryCtx_->sessionProperties()) &&
+      connectorQueryCtx_->cache() != nullptr &&
+      (!filters_.empty() || remainingFilterExprSet_ != nullptr) &&
+      (remainingFilterExprSet_ == nullptr ||
+       remainingFilterExprSet_->expr(0)->isDeterministic())) {
+    filterResultCache_ = std::make_unique<FilterResultCache>(
+        connectorQueryCtx_->cache(),
+        FilterResultCache::fingerprint(filters_, remainingFilter));
+  }
+
+  if (hiveConfig_->decodedVectorCacheEnabled(
+          connectorQueryCtx_->sessionProperties()) &&
+      DecodedVectorCache::getInstance() != nullptr &&
+      hiveTableHandle_->aggregates().empty() &&
+      std::none_of(
+          columnPostProcessors_.begin(),
+          columnPostProcessors_.end(),
+          [](const auto& postProcessor) { return postProcessor != nullptr; }) &&
+      (remainingFilterExprSet_ == nullptr ||
+       remainingFilterExprSet_->expr(0)->isDeterministic())) {
+    std::vector<std::string> columns;
+    columns.reserve(assignments.size());
+    for (const auto& [name, handle] : assignments) {
+      columns.push_back(fmt::format("{}={}", name, handle->toString()));
+    }
+    std::sort(columns.begin(), columns.end());
+    const auto& dataColumns = hiveTableHandle_->dataColumns();
+    decodedVectorCacheFingerprint_ = fmt::format(
+        "{}|{}|{}|{}|{}",
+        outputType_->toString(),
+        fmt::join(columns, ","),
+        dataColumns ? dataColumns->toString() : "",
+        connectorQueryCtx_->sessionTimezone(),
+        FilterResultCache::fingerprint(filters_, remainingFilter));
+  }
+
   ioStats_ = std::make_shared<io::IoStatistics>();
   fsStats_ = std::make_shared<filesystems::File::IoStats>();
 }
 
+void HiveDataSource::setupSplitConstantFilter(
+    const core::TypedExprPtr& remainingFilter) {
+  const auto& remainingFilterExpr = remainingFilterExprSet_->expr(0);
+  if (!remainingFilterExpr->isDeterministic()) {
+    return;
+  }
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto& input : remainingFilterExpr->distinctFields()) {
+    if (partitionKeys_.count(input->field()) == 0 &&
+        infoColumns_.count(input->field()) == 0) {
+      return;
+    }
+    names.push_back(input->field());
+    types.push_back(input->type());
+  }
+  if (names.empty()) {
+    return;
+  }
+  // The field references of an ExprSet cache the field indices of the first
+  // input, so the one-row input needs its own ExprSet.
+  splitConstantFilterType_ = ROW(std::move(names), std::move(types));
+  splitConstantFilterExprSet_ = expressionEvaluator_->compile(remainingFilter);
+}
+
+void HiveDataSource::setupAggregates(
+    const connector::ColumnHandleMap& assignments,
+    std::vector<std::string>& readColumnNames,
+    std::vector<TypePtr>& readColumnTypes) {
+  const auto& aggregates = hiveTableHandle_->aggregates();
+  VELOX_USER_CHECK_EQ(
+      outputType_->size(),
+      aggregates.size(),
+      "A table scan with aggregates must output one column per aggregate");
+  std::vector<std::string> inputNames;
+  std::vector<column_index_t> inputChannels;
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    TypePtr inputType = BIGINT();
+    if (aggregate.input.empty()) {
+      VELOX_USER_CHECK(
+          aggregate.kind == HiveAggregate::Kind::kCount,
+          "Aggregate requires an input: {}",
+          aggregate.toString());
+      inputNames.emplace_back();
+      inputChannels.push_back(0);
+    } else {
+      auto it = assignments.find(aggregate.input);
+      VELOX_CHECK(
+          it != assignments.end(),
+          "ColumnHandle is missing for aggregate input: {}",
+          aggregate.input);
+      auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
+      inputType = handle->dataType();
+      VELOX_USER_CHECK(
+          SplitAggregates::supports(aggregate.kind, inputType),
+          "Aggregate {} is not supported on type {}",
+          aggregate.toString(),
+          inputType->toString());
+      if (handle->columnType() != HiveColumnHandle::ColumnType::kRegular) {
+        aggregatesFromStatistics_ = false;
+      }
+      const auto nameIt = std::find(
+          readColumnNames.begin(), readColumnNames.end(), handle->name());
+      const column_index_t channel = nameIt - readColumnNames.begin();
+      if (channel == readColumnNames.size()) {
+        readColumnNames.push_back(handle->name());
+        readColumnTypes.push_back(inputType);
+      }
+      inputNames.push_back(handle->name());
+      inputChannels.push_back(channel);
+    }
+    const auto resultType =
+        SplitAggregates::resultType(aggregate.kind, inputType);
+    VELOX_USER_CHECK(
+        outputType_->childAt(i)->equivalent(*resultType),
+        "Output type {} does not match the result type {} of aggregate {}",
+        outputType_->childAt(i)->toString(),
+        resultType->toString(),
+        aggregate.toString());
+  }
+  splitAggregates_ = std::make_unique<SplitAggregates>(
+      aggregates,
+      std::move(inputNames),
+      std::move(inputChannels),
+      outputType_);
+}
+
+bool HiveDataSource::canAggregateFromStatistics() const {
+  // Filters the statistics cannot prove, bucket conversion, row ids and
+  // sampling change the rows that pass beyond what the statistics count.
+  return aggregatesFromStatistics_ && remainingFilterExprSet_ == nullptr &&
+      !split_->bucketConversion.has_value() &&
+      !specialColumns_.rowId.has_value() && randomSkip_ == nullptr &&
+      splitReader_->allRowsPassFilters();
+}
+
 std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
   return SplitReader::create(
       split_,
@@ -304,6 +451,32 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     splitReader_.reset();
   }
 
+  splitRowsPassed_ = 0;
+  splitStatisticsChecked_ = false;
+  splitAggregatesReturned_ = false;
+  remainingFilterPassesSplit_ = false;
+  splitSkipped_ = !testSplitFilters() ||
+      (isFilterResultCacheable() && filterResultCache_->isFiltered(*split_));
+  if (splitSkipped_) {
+    ++runtimeStats_.skippedSplits;
+    runtimeStats_.skippedSplitBytes += split_->length;
+    return;
+  }
+
+  resetDecodedVectorCacheState();
+  if (isDecodedVectorCacheable()) {
+    auto key =
+        FilterResultCache::splitKey(decodedVectorCacheFingerprint_, *split_);
+    if (key.has_value()) {
+      cachedBatches_ = DecodedVectorCache::getInstance()->get(key.value());
+      if (cachedBatches_ != nullptr) {
+        ++numDecodedVectorCacheHits_;
+        return;
+      }
+      decodedVectorCacheKey_ = std::move(key);
+    }
+  }
+
   std::vector<column_index_t> bucketChannels;
   if (split_->bucketConversion.has_value()) {
     bucketChannels = setupBucketConversion();
@@ -313,6 +486,7 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   }
 
   splitReader_ = createSplitReader();
+  splitReader_->setConstantCache(&constantCache_);
   if (!bucketChannels.empty()) {
     splitReader_->setBucketConversion(std::move(bucketChannels));
   }
@@ -327,6 +501,19 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     uint64_t size,
     velox::ContinueFuture& /*future*/) {
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+  if (splitSkipped_) {
+    resetSplit();
+    return nullptr;
+  }
+  if (cachedBatches_ != nullptr) {
+    if (nextCachedBatch_ == cachedBatches_->size()) {
+      resetSplit();
+      return nullptr;
+    }
+    const auto& batch = (*cachedBatches_)[nextCachedBatch_++];
+    completedRows_ += batch->size();
+    return batch;
+  }
   VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
 
   TestValue::adjust(
@@ -337,6 +524,22 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     return nullptr;
   }
 
+  if (splitAggregates_ != nullptr) {
+    if (splitAggregatesReturned_) {
+      resetSplit();
+      return nullptr;
+    }
+    if (!splitStatisticsChecked_) {
+      splitStatisticsChecked_ = true;
+      if (canAggregateFromStatistics() &&
+          splitAggregates_->addStatistics(*splitReader_->baseReader())) {
+        ++numStatisticsAggregatedSplits_;
+        splitAggregatesReturned_ = true;
+        return splitAggregates_->finish(pool_);
+      }
+    }
+  }
+
   // Bucket conversion or delta update could add extra column to reader output.
   auto needsExtraColumn = [&] {
     return output_->asUnchecked<RowVector>()->childrenSize() <
@@ -350,6 +553,17 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   completedRows_ += rowsScanned;
   if (rowsScanned == 0) {
     splitReader_->updateRuntimeStats(runtimeStats_);
+    if (splitRowsPassed_ == 0 && isFilterResultCacheable()) {
+      filterResultCache_->setFiltered(*split_);
+    }
+    if (decodedVectorCacheKey_.has_value()) {
+      DecodedVectorCache::getInstance()->put(
+          decodedVectorCacheKey_.value(), collectedBatches_);
+    }
+    if (splitAggregates_ != nullptr) {
+      splitAggregatesReturned_ = true;
+      return splitAggregates_->finish(pool_);
+    }
     resetSplit();
     return nullptr;
   }
@@ -371,7 +585,7 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   BufferPtr remainingIndices;
   filterRows_.resize(rowVector->size());
 
-  if (remainingFilterExprSet_) {
+  if (remainingFilterExprSet_ && !remainingFilterPassesSplit_) {
     rowsRemaining = evaluateRemainingFilter(rowVector);
     VELOX_CHECK_LE(rowsRemaining, rowsScanned);
     if (rowsRemaining == 0) {
@@ -384,9 +598,17 @@ std::optional<RowVectorPtr> HiveDataSource::next(
       remainingIndices = filterEvalCtx_.selectedIndices;
     }
   }
+  splitRowsPassed_ += rowsRemaining;
+
+  if (splitAggregates_ != nullptr) {
+    splitAggregates_->addRows(*rowVector, rowsRemaining, remainingIndices);
+    return getEmptyOutput();
+  }
 
   if (outputType_->size() == 0) {
-    return exec::wrap(rowsRemaining, remainingIndices, rowVector);
+    auto result = exec::wrap(rowsRemaining, remainingIndices, rowVector);
+    collectForDecodedVectorCache(result);
+    return result;
   }
 
   std::vector<VectorPtr> outputColumns;
@@ -405,8 +627,10 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     outputColumns.push_back(std::move(column));
   }
 
-  return std::make_shared<RowVector>(
+  auto result = std::make_shared<RowVector>(
       pool_, outputType_, BufferPtr(nullptr), rowsRemaining, outputColumns);
+  collectForDecodedVectorCache(result);
+  return result;
 }
 
 void HiveDataSource::addDynamicFilter(
@@ -418,6 +642,11 @@ void HiveDataSource::addDynamicFilter(
   if (splitReader_) {
     splitReader_->resetFilterCaches();
   }
+  // The fingerprint does not cover the dynamic filters.
+  filterResultCache_.reset();
+  decodedVectorCacheFingerprint_.clear();
+  decodedVectorCacheKey_.reset();
+  collectedBatches_.clear();
 }
 
 std::unordered_map<std::string, RuntimeMetric>
@@ -469,6 +698,25 @@ HiveDataSource::getRuntimeStats() {
              ioStats_->ssdRead().max(),
              RuntimeCounter::Unit::kBytes)});
   }
+  if (ioStats_->coalesceDistance().count() > 0) {
+    res.insert(
+        {"coalesceDistance",
+         RuntimeMetric(
+             ioStats_->coalesceDistance().sum(),
+             ioStats_->coalesceDistance().count(),
+             ioStats_->coalesceDistance().min(),
+             ioStats_->coalesceDistance().max(),
+             RuntimeCounter::Unit::kBytes)});
+  }
+  if (ioStats_->splitPreloadDepth().count() > 0) {
+    res.insert(
+        {"splitPreloadDepth",
+         RuntimeMetric(
+             ioStats_->splitPreloadDepth().sum(),
+             ioStats_->splitPreloadDepth().count(),
+             ioStats_->splitPreloadDepth().min(),
+             ioStats_->splitPreloadDepth().max())});
+  }
   if (ioStats_->ramHit().count() > 0) {
     res.insert({"numRamRead", RuntimeMetric(ioStats_->ramHit().count())});
     res.insert(
@@ -480,9 +728,50 @@ HiveDataSource::getRuntimeStats() {
              ioStats_->ramHit().max(),
              RuntimeCounter::Unit::kBytes)});
   }
+  for (auto source = 0; source < io::kNumIoSources; ++source) {
+    for (auto purpose = 0; purpose < io::kNumIoPurposes; ++purpose) {
+      const auto ioSource = static_cast<io::IoSource>(source);
+      const auto ioPurpose = static_cast<io::IoPurpose>(purpose);
+      const auto& histograms =
+          ioStats_->ioLatency().histograms(ioSource, ioPurpose);
+      const auto& latency = histograms.latencyMicros.counter();
+      if (latency.count() == 0) {
+        continue;
+      }
+      const auto suffix = fmt::format(
+          ".{}.{}", io::toString(ioSource), io::toString(ioPurpose));
+      res.insert(
+          {"ioLatency" + suffix,
+           RuntimeMetric(
+               latency.sum() * 1000,
+               latency.count(),
+               latency.min() * 1000,
+               latency.max() * 1000,
+               RuntimeCounter::Unit::kNanos)});
+      const auto& bytes = histograms.bytes.counter();
+      res.insert(
+          {"ioBytes" + suffix,
+           RuntimeMetric(
+               bytes.sum(),
+               bytes.count(),
+               bytes.min(),
+               bytes.max(),
+               RuntimeCounter::Unit::kBytes)});
+    }
+  }
   if (numBucketConversion_ > 0) {
     res.insert({"numBucketConversion", RuntimeMetric(numBucketConversion_)});
   }
+  if (numStatisticsAggregatedSplits_ > 0) {
+    res.insert(
+        {"numStatisticsAggregatedSplits",
+         RuntimeMetric(numStatisticsAggregatedSplits_)});
+  }
+  if (numDecodedVectorCacheHits_ > 0) {
+    res.insert(
+        {"numDecodedVectorCacheHits",
+         RuntimeMetric(numDecodedVectorCacheHits_)});
+  }
 
   const auto fsStats = fsStats_->stats();
   for (const auto& storageStats : fsStats) {
@@ -505,7 +794,16 @@ void HiveDataSource::setFromDataSource(
   scanSpec_ = std::move(source->scanSpec_);
   metadataFilter_ = std::move(source->metadataFilter_);
   splitReader_ = std::move(source->splitReader_);
-  splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  if (splitReader_) {
+    splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+    splitReader_->setConstantCache(&constantCache_);
+  }
+  splitSkipped_ = source->splitSkipped_;
+  remainingFilterPassesSplit_ = source->remainingFilterPassesSplit_;
+  splitRowsPassed_ = source->splitRowsPassed_;
+  splitAggregates_ = std::move(source->splitAggregates_);
+  splitStatisticsChecked_ = source->splitStatisticsChecked_;
+  splitAggregatesReturned_ = source->splitAggregatesReturned_;
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStats_->merge(*ioStats_);
@@ -514,6 +812,13 @@ void HiveDataSource::setFromDataSource(
   fsStats_ = std::move(source->fsStats_);
 
   numBucketConversion_ += source->numBucketConversion_;
+  numStatisticsAggregatedSplits_ += source->numStatisticsAggregatedSplits_;
+  decodedVectorCacheKey_ = std::move(source->decodedVectorCacheKey_);
+  collectedBatches_ = std::move(source->collectedBatches_);
+  collectedBytes_ = source->collectedBytes_;
+  cachedBatches_ = std::move(source->cachedBatches_);
+  nextCachedBatch_ = source->nextCachedBatch_;
+  numDecodedVectorCacheHits_ += source->numDecodedVectorCacheHits_;
 }
 
 int64_t HiveDataSource::estimatedRowSize() {
@@ -527,7 +832,115 @@ int64_t HiveDataSource::estimatedRowSize() {
   return rowSize;
 }
 
+int32_t HiveDataSource::splitPreloadPerDriver(
+    int32_t maxSplitPreloadPerDriver) {
+  if (split_ == nullptr || maxSplitPreloadPerDriver == 0 ||
+      !hiveConfig_->adaptiveIoPlanningEnabled(
+          connectorQueryCtx_->sessionProperties())) {
+    return maxSplitPreloadPerDriver;
+  }
+  auto* planner = dwio::common::AdaptiveIoPlanner::getInstance();
+  const auto depth = planner->splitPreloadDepth(
+      dwio::common::AdaptiveIoPlanner::fileSystemKey(split_->filePath),
+      maxSplitPreloadPerDriver);
+  ioStats_->splitPreloadDepth().increment(depth);
+  return depth;
+}
+
+void HiveDataSource::setupStagedRemainingFilter(
+    const core::TypedExprPtr& remainingFilter,
+    const folly::F14FastSet<std::string>& eagerFieldNames) {
+  const auto* call =
+      dynamic_cast<const core::CallTypedExpr*>(remainingFilter.get());
+  if (eagerFieldNames.empty() || call == nullptr ||
+      call->name() != expression::kAnd) {
+    return;
+  }
+
+  // Splits the conjuncts by whether they read an eagerly materialized field.
+  std::vector<core::TypedExprPtr> lazyConjuncts;
+  std::vector<core::TypedExprPtr> eagerConjuncts;
+  for (const auto& input : call->inputs()) {
+    auto exprSet = expressionEvaluator_->compile(input);
+    const auto& fields = exprSet->expr(0)->distinctFields();
+    const auto readsEagerField =
+        std::any_of(fields.begin(), fields.end(), [&](const auto* field) {
+          return eagerFieldNames.count(field->field()) > 0;
+        });
+    (readsEagerField ? eagerConjuncts : lazyConjuncts).push_back(input);
+  }
+  if (lazyConjuncts.empty() || eagerConjuncts.empty()) {
+    return;
+  }
+
+  auto makeConjunction = [&](std::vector<core::TypedExprPtr> conjuncts) {
+    if (conjuncts.size() == 1) {
+      return std::move(conjuncts[0]);
+    }
+    return std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(), std::move(conjuncts), expression::kAnd);
+  };
+  lazyConjunctsExprSet_ =
+      expressionEvaluator_->compile(makeConjunction(std::move(lazyConjuncts)));
+  eagerConjunctsExprSet_ = expressionEvaluator_->compile(
+      makeConjunction(std::move(eagerConjuncts)));
+}
+
+vector_size_t HiveDataSource::evaluateStagedRemainingFilter(
+    RowVectorPtr& rowVector) {
+  uint64_t filterTimeUs{0};
+  vector_size_t rowsRemaining{0};
+  {
+    MicrosecondTimer timer(&filterTimeUs);
+    expressionEvaluator_->evaluate(
+        lazyConjunctsExprSet_.get(), filterRows_, *rowVector, filterResult_);
+    rowsRemaining = exec::processFilterResults(
+        filterResult_, filterRows_, filterEvalCtx_, pool_);
+  }
+
+  if (rowsRemaining > 0) {
+    eagerFilterRows_.resize(rowVector->size());
+    if (rowsRemaining == rowVector->size()) {
+      eagerFilterRows_.setAll();
+    } else {
+      eagerFilterRows_.clearAll();
+      const auto* selected =
+          filterEvalCtx_.selectedIndices->as<vector_size_t>();
+      for (auto i = 0; i < rowsRemaining; ++i) {
+        eagerFilterRows_.setValid(selected[i], true);
+      }
+      eagerFilterRows_.updateBounds();
+    }
+
+    // The eagerly materialized fields are loaded only for the rows that
+    // passed the other conjuncts.
+    for (auto fieldIndex : multiReferencedFields_) {
+      LazyVector::ensureLoadedRows(
+          rowVector->childAt(fieldIndex),
+          eagerFilterRows_,
+          filterLazyDecoded_,
+          filterLazyBaseRows_);
+    }
+
+    MicrosecondTimer timer(&filterTimeUs);
+    expressionEvaluator_->evaluate(
+        eagerConjunctsExprSet_.get(),
+        eagerFilterRows_,
+        *rowVector,
+        filterResult_);
+    rowsRemaining = exec::processFilterResults(
+        filterResult_, eagerFilterRows_, filterEvalCtx_, pool_);
+  }
+  totalRemainingFilterTime_.fetch_add(
+      filterTimeUs * 1000, std::memory_order_relaxed);
+  return rowsRemaining;
+}
+
 vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
+  if (lazyConjunctsExprSet_ != nullptr) {
+    return evaluateStagedRemainingFilter(rowVector);
+  }
+
   for (auto fieldIndex : multiReferencedFields_) {
     LazyVector::ensureLoadedRows(
         rowVector->childAt(fieldIndex),
@@ -551,10 +964,119 @@ vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
 
 void HiveDataSource::resetSplit() {
   split_.reset();
-  splitReader_->resetSplit();
+  splitSkipped_ = false;
+  resetDecodedVectorCacheState();
+  remainingFilterPassesSplit_ = false;
+  if (splitReader_) {
+    splitReader_->resetSplit();
+  }
   // Keep readers around to hold adaptation.
 }
 
+bool HiveDataSource::testSplitFilters() {
+  const bool asLocalTime = hiveConfig_->readTimestampPartitionValueAsLocalTime(
+      connectorQueryCtx_->sessionProperties());
+  if (!testPartitionFilters(
+          scanSpec_.get(),
+          split_->partitionKeys,
+          partitionKeys_,
+          asLocalTime)) {
+    VLOG(1) << "Skipping " << split_->filePath
+            << " based on the partition key values";
+    return false;
+  }
+  if (splitConstantFilterExprSet_ == nullptr) {
+    return true;
+  }
+
+  std::vector<VectorPtr> children;
+  children.reserve(splitConstantFilterType_->size());
+  for (const auto& name : splitConstantFilterType_->names()) {
+    if (auto it = partitionKeys_.find(name); it != partitionKeys_.end()) {
+      auto value = split_->partitionKeys.find(name);
+      if (value == split_->partitionKeys.end()) {
+        // The value is read from the file instead of the split.
+        return true;
+      }
+      children.push_back(constantCache_.get(
+          name,
+          it->second->dataType(),
+          value->second,
+          pool_,
+          asLocalTime,
+          it->second->isPartitionDateValueDaysSinceEpoch()));
+    } else {
+      auto value = split_->infoColumns.find(name);
+      if (value == split_->infoColumns.end()) {
+        return true;
+      }
+      children.push_back(constantCache_.get(
+          name,
+          infoColumns_.at(name)->dataType(),
+          value->second,
+          pool_,
+          asLocalTime,
+          false));
+    }
+  }
+
+  auto input = std::make_shared<RowVector>(
+      pool_, splitConstantFilterType_, nullptr, 1, std::move(children));
+  SelectivityVector rows(1);
+  VectorPtr result;
+  expressionEvaluator_->evaluate(
+      splitConstantFilterExprSet_.get(), rows, *input, result);
+  DecodedVector decoded(*result, rows);
+  remainingFilterPassesSplit_ =
+      !decoded.isNullAt(0) && decoded.valueAt<bool>(0);
+  if (!remainingFilterPassesSplit_) {
+    VLOG(1) << "Skipping " << split_->filePath
+            << " based on the remaining filter on the split constants";
+  }
+  return remainingFilterPassesSplit_;
+}
+
+bool HiveDataSource::isFilterResultCacheable() const {
+  // Bucket conversion, row ids, sampling and the deletes of the split
+  // subclasses change the rows that pass beyond what the split key covers.
+  return filterResultCache_ != nullptr && split_->cacheable &&
+      !split_->bucketConversion.has_value() &&
+      !specialColumns_.rowId.has_value() && randomSkip_ == nullptr &&
+      typeid(*split_) == typeid(HiveConnectorSplit);
+}
+
+bool HiveDataSource::isDecodedVectorCacheable() const {
+  // Same as for the filter results, plus the aggregates and post-processors
+  // excluded when setting the fingerprint.
+  return !decodedVectorCacheFingerprint_.empty() && split_->cacheable &&
+      !split_->bucketConversion.has_value() &&
+      !specialColumns_.rowId.has_value() && randomSkip_ == nullptr &&
+      typeid(*split_) == typeid(HiveConnectorSplit);
+}
+
+void HiveDataSource::collectForDecodedVectorCache(const RowVectorPtr& output) {
+  if (!decodedVectorCacheKey_.has_value()) {
+    return;
+  }
+  // Lazy vectors can only be loaded until the next batch is read.
+  output->loadedVector();
+  collectedBytes_ += output->retainedSize();
+  if (collectedBytes_ > DecodedVectorCache::getInstance()->maxEntryBytes()) {
+    decodedVectorCacheKey_.reset();
+    collectedBatches_.clear();
+    return;
+  }
+  collectedBatches_.push_back(output);
+}
+
+void HiveDataSource::resetDecodedVectorCacheState() {
+  decodedVectorCacheKey_.reset();
+  collectedBatches_.clear();
+  collectedBytes_ = 0;
+  cachedBatches_.reset();
+  nextCachedBatch_ = 0;
+}
+
 HiveDataSource::WaveDelegateHookFunction HiveDataSource::waveDelegateHook_;
 
 std::shared_ptr<wave::WaveDataSource> HiveDataSource::toWaveDataSource() {
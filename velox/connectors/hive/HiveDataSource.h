@@ -15,13 +15,18 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
+
 #include "velox/common/base/RandomUtil.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/DecodedVectorCache.h"
 #include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/FilterResultCache.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/SplitAggregates.h"
 #include "velox/connectors/hive/SplitReader.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/dwio/common/Statistics.h"
@@ -70,6 +75,8 @@ class HiveDataSource : public DataSource {
 
   int64_t estimatedRowSize() override;
 
+  int32_t splitPreloadPerDriver(int32_t maxSplitPreloadPerDriver) override;
+
   const common::SubfieldFilters* getFilters() const override {
     return &filters_;
   }
@@ -130,16 +137,61 @@ class HiveDataSource : public DataSource {
 
   void setupRowIdColumn();
 
+  // Sets up splitAggregates_ for the aggregates of the table handle and adds
+  // their inputs to the columns to read.
+  void setupAggregates(
+      const connector::ColumnHandleMap& assignments,
+      std::vector<std::string>& readColumnNames,
+      std::vector<TypePtr>& readColumnTypes);
+
+  // Returns true if the aggregates of split_ can be computed from the file
+  // statistics instead of the rows.
+  bool canAggregateFromStatistics() const;
+
   // Evaluates remainingFilter_ on the specified vector. Returns number of rows
   // passed. Populates filterEvalCtx_.selectedIndices and selectedBits if only
   // some rows passed the filter. If none or all rows passed
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // Evaluates lazyConjunctsExprSet_ and then eagerConjunctsExprSet_ on the
+  // rows that passed. Same contract as evaluateRemainingFilter().
+  vector_size_t evaluateStagedRemainingFilter(RowVectorPtr& rowVector);
+
+  // Sets lazyConjunctsExprSet_ and eagerConjunctsExprSet_ if 'remainingFilter'
+  // is an AND with conjuncts that don't read any of 'eagerFieldNames'.
+  void setupStagedRemainingFilter(
+      const core::TypedExprPtr& remainingFilter,
+      const folly::F14FastSet<std::string>& eagerFieldNames);
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
 
+  // Sets splitConstantFilterExprSet_ if 'remainingFilter' has the same result
+  // for all the rows of a split.
+  void setupSplitConstantFilter(const core::TypedExprPtr& remainingFilter);
+
+  // Returns false if the partition key and info column values of split_ prove
+  // that no row of the split passes the filters. Sets
+  // remainingFilterPassesSplit_ if the remaining filter passes on the values.
+  bool testSplitFilters();
+
+  // Returns true if the filter result of split_ can be looked up in and
+  // recorded to 'filterResultCache_'.
+  bool isFilterResultCacheable() const;
+
+  // Returns true if the output of split_ can be looked up in and recorded to
+  // the DecodedVectorCache.
+  bool isDecodedVectorCacheable() const;
+
+  // Keeps 'output' for the DecodedVectorCache if the output of split_ is being
+  // collected.
+  void collectForDecodedVectorCache(const RowVectorPtr& output);
+
+  // Drops the batches of split_ from or for the DecodedVectorCache.
+  void resetDecodedVectorCacheState();
+
   const RowVectorPtr& getEmptyOutput() {
     if (!emptyOutput_) {
       emptyOutput_ = RowVector::createEmpty(outputType_, pool_);
@@ -168,6 +220,14 @@ class HiveDataSource : public DataSource {
   common::SubfieldFilters filters_;
   std::shared_ptr<common::MetadataFilter> metadataFilter_;
   std::unique_ptr<exec::ExprSet> remainingFilterExprSet_;
+  // Set if the remaining filter is deterministic and references only partition
+  // keys and info columns, so that its result is the same for all the rows of
+  // a split. Compiled separately from remainingFilterExprSet_ for a one-row
+  // input of type splitConstantFilterType_.
+  std::unique_ptr<exec::ExprSet> splitConstantFilterExprSet_;
+  RowTypePtr splitConstantFilterType_;
+  // Constants of the partition keys and info columns, reused across splits.
+  SplitConstantCache constantCache_;
   RowVectorPtr emptyOutput_;
   dwio::common::RuntimeStatistics runtimeStats_;
   std::atomic<uint64_t> totalRemainingFilterTime_{0};
@@ -177,13 +237,60 @@ class HiveDataSource : public DataSource {
   // columns need to be materialized eagerly to avoid missing values in output.
   std::vector<column_index_t> multiReferencedFields_;
 
+  // If the remaining filter is an AND and only some of its conjuncts read the
+  // 'multiReferencedFields_', these are the other conjuncts and the ones that
+  // read them. The former run first so that the eager fields are loaded only
+  // for the rows that passed them. Null otherwise.
+  std::unique_ptr<exec::ExprSet> lazyConjunctsExprSet_;
+  std::unique_ptr<exec::ExprSet> eagerConjunctsExprSet_;
+
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
+  // Splits on which no row passes the filters, set if
+  // hive.filter-result-cache-enabled.
+  std::unique_ptr<FilterResultCache> filterResultCache_;
+  // Fingerprint of the output columns and filters for the DecodedVectorCache.
+  // Empty if the scan does not use the cache.
+  std::string decodedVectorCacheFingerprint_;
+  // Key of split_ in the DecodedVectorCache if its output is being collected
+  // in 'collectedBatches_'.
+  std::optional<std::string> decodedVectorCacheKey_;
+  DecodedVectorCache::Batches collectedBatches_;
+  uint64_t collectedBytes_{0};
+  // The output of split_ from the DecodedVectorCache, returned instead of
+  // reading the file, and the index of the next batch to return.
+  std::shared_ptr<const DecodedVectorCache::Batches> cachedBatches_;
+  size_t nextCachedBatch_{0};
+  int64_t numDecodedVectorCacheHits_{0};
+  // True if split_ is skipped because no row passed the filters on an
+  // earlier scan or its partition key and info column values fail the
+  // filters.
+  bool splitSkipped_{false};
+  // True if the remaining filter passes on all the rows of split_, in which
+  // case it is not evaluated on the batches.
+  bool remainingFilterPassesSplit_{false};
+  // Number of rows of split_ that passed the filters so far.
+  uint64_t splitRowsPassed_{0};
+
   int64_t numBucketConversion_ = 0;
 
+  // Computes the aggregates of the table handle per split if any, in which
+  // case the output has one row per split instead of the rows.
+  std::unique_ptr<SplitAggregates> splitAggregates_;
+  // False if some aggregate input is not a column of the files, e.g. a
+  // partition key, so that the rows must be read.
+  bool aggregatesFromStatistics_{true};
+  // True once the file statistics of split_ have been tried for the
+  // aggregates.
+  bool splitStatisticsChecked_{false};
+  // True once the aggregates of split_ have been returned.
+  bool splitAggregatesReturned_{false};
+  int64_t numStatisticsAggregatedSplits_ = 0;
+
   // Reusable memory for remaining filter evaluation.
   VectorPtr filterResult_;
   SelectivityVector filterRows_;
+  SelectivityVector eagerFilterRows_;
   DecodedVector filterLazyDecoded_;
   SelectivityVector filterLazyBaseRows_;
   exec::FilterEvalCtx filterEvalCtx_;
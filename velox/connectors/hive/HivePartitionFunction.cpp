@@ -115,6 +115,28 @@ void hashPrimitive(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (
+      TypeTraits<kind>::isFixedWidth && kind != TypeKind::BOOLEAN &&
+      kind != TypeKind::UNKNOWN) {
+    if (rows.isAllSelected() && values.isIdentityMapping() &&
+        !values.mayHaveNulls()) {
+      // Flat values without nulls are hashed straight from the values buffer,
+      // in loops the compiler can vectorize.
+      const auto* rawValues = values.data<T>();
+      const vector_size_t numRows = rows.size();
+      if (mix) {
+        for (auto i = 0; i < numRows; ++i) {
+          hashes[i] = hashes[i] * 31 + hashOne<kind>(rawValues[i]);
+        }
+      } else {
+        for (auto i = 0; i < numRows; ++i) {
+          hashes[i] = hashOne<kind>(rawValues[i]);
+        }
+      }
+      return;
+    }
+  }
   if (rows.isAllSelected()) {
     // The compiler seems to be a little fickle with optimizations.
     // Although rows.applyToSelected should do roughly the same thing, doing
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/SplitAggregates.h"
+
+#include "velox/dwio/common/Statistics.h"
+
+namespace facebook::velox::connector::hive {
+
+namespace {
+
+bool isMinMax(HiveAggregate::Kind kind) {
+  return kind == HiveAggregate::Kind::kMin || kind == HiveAggregate::Kind::kMax;
+}
+
+int64_t integerAt(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    default:
+      VELOX_UNREACHABLE("Unsupported type for min and max: {}", kind);
+  }
+}
+
+Variant toVariant(int64_t value, TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return Variant(static_cast<int8_t>(value));
+    case TypeKind::SMALLINT:
+      return Variant(static_cast<int16_t>(value));
+    case TypeKind::INTEGER:
+      return Variant(static_cast<int32_t>(value));
+    case TypeKind::BIGINT:
+      return Variant(value);
+    default:
+      VELOX_UNREACHABLE("Unsupported type for min and max: {}", kind);
+  }
+}
+
+} // namespace
+
+SplitAggregates::SplitAggregates(
+    std::vector<HiveAggregate> aggregates,
+    std::vector<std::string> inputNames,
+    std::vector<column_index_t> inputChannels,
+    RowTypePtr outputType)
+    : aggregates_(std::move(aggregates)),
+      inputNames_(std::move(inputNames)),
+      inputChannels_(std::move(inputChannels)),
+      outputType_(std::move(outputType)),
+      accumulators_(aggregates_.size()) {
+  VELOX_CHECK_EQ(aggregates_.size(), inputNames_.size());
+  VELOX_CHECK_EQ(aggregates_.size(), inputChannels_.size());
+  VELOX_CHECK_EQ(aggregates_.size(), outputType_->size());
+}
+
+// static
+bool SplitAggregates::supports(
+    HiveAggregate::Kind kind,
+    const TypePtr& type) {
+  if (!isMinMax(kind)) {
+    return true;
+  }
+  if (type->isDecimal() || type->providesCustomComparison()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// static
+TypePtr SplitAggregates::resultType(
+    HiveAggregate::Kind kind,
+    const TypePtr& inputType) {
+  return isMinMax(kind) ? inputType : BIGINT();
+}
+
+void SplitAggregates::Accumulator::merge(const Accumulator& other) {
+  count += other.count;
+  if (other.min.has_value()) {
+    addValue(*other.min);
+  }
+  if (other.max.has_value()) {
+    addValue(*other.max);
+  }
+}
+
+bool SplitAggregates::addStatistics(const dwio::common::Reader& reader) {
+  const auto numRows = reader.numberOfRows();
+  if (!numRows.has_value()) {
+    return false;
+  }
+  std::vector<Accumulator> added(aggregates_.size());
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto kind = aggregates_[i].kind;
+    const auto& name = inputNames_[i];
+    if (name.empty()) {
+      added[i].count = *numRows;
+      continue;
+    }
+    if (!reader.rowType()->containsChild(name)) {
+      // The column is missing from the file, most likely due to schema
+      // evolution, and all its values are null.
+      if (kind == HiveAggregate::Kind::kNullCount) {
+        added[i].count = *numRows;
+      }
+      continue;
+    }
+    const auto stats =
+        reader.columnStatistics(reader.typeWithId()->childByName(name)->id());
+    if (stats == nullptr || !stats->getNumberOfValues().has_value()) {
+      return false;
+    }
+    const auto numValues = *stats->getNumberOfValues();
+    switch (kind) {
+      case HiveAggregate::Kind::kCount:
+        added[i].count = numValues;
+        break;
+      case HiveAggregate::Kind::kNullCount:
+        added[i].count = *numRows - numValues;
+        break;
+      case HiveAggregate::Kind::kMin:
+      case HiveAggregate::Kind::kMax: {
+        if (numValues == 0) {
+          break;
+        }
+        const auto* intStats =
+            dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+                stats.get());
+        if (intStats == nullptr || !intStats->getMinimum().has_value() ||
+            !intStats->getMaximum().has_value()) {
+          return false;
+        }
+        added[i].addValue(
+            kind == HiveAggregate::Kind::kMin ? *intStats->getMinimum()
+                                              : *intStats->getMaximum());
+        break;
+      }
+    }
+  }
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    accumulators_[i].merge(added[i]);
+  }
+  return true;
+}
+
+void SplitAggregates::addRows(
+    const RowVector& input,
+    vector_size_t numRows,
+    const BufferPtr& indices) {
+  const auto* rawIndices =
+      indices != nullptr ? indices->as<vector_size_t>() : nullptr;
+  SelectivityVector rows(input.size());
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& accumulator = accumulators_[i];
+    const auto kind = aggregates_[i].kind;
+    if (inputNames_[i].empty()) {
+      accumulator.count += numRows;
+      continue;
+    }
+    const auto& column = input.childAt(inputChannels_[i]);
+    decoded_.decode(*BaseVector::loadedVectorShared(column), rows);
+    const auto typeKind = column->typeKind();
+    for (vector_size_t j = 0; j < numRows; ++j) {
+      const auto row = rawIndices != nullptr ? rawIndices[j] : j;
+      const bool isNull = decoded_.isNullAt(row);
+      switch (kind) {
+        case HiveAggregate::Kind::kCount:
+          accumulator.count += !isNull;
+          break;
+        case HiveAggregate::Kind::kNullCount:
+          accumulator.count += isNull;
+          break;
+        case HiveAggregate::Kind::kMin:
+        case HiveAggregate::Kind::kMax:
+          if (!isNull) {
+            accumulator.addValue(integerAt(decoded_, row, typeKind));
+          }
+          break;
+      }
+    }
+  }
+}
+
+RowVectorPtr SplitAggregates::finish(memory::MemoryPool* pool) {
+  std::vector<VectorPtr> columns;
+  columns.reserve(aggregates_.size());
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& type = outputType_->childAt(i);
+    const auto& accumulator = accumulators_[i];
+    switch (aggregates_[i].kind) {
+      case HiveAggregate::Kind::kCount:
+      case HiveAggregate::Kind::kNullCount:
+        columns.push_back(
+            BaseVector::createConstant(
+                type, Variant(accumulator.count), 1, pool));
+        break;
+      case HiveAggregate::Kind::kMin:
+      case HiveAggregate::Kind::kMax: {
+        const auto& value = aggregates_[i].kind == HiveAggregate::Kind::kMin
+            ? accumulator.min
+            : accumulator.max;
+        columns.push_back(
+            value.has_value() ? BaseVector::createConstant(
+                                    type,
+                                    toVariant(*value, type->kind()),
+                                    1,
+                                    pool)
+                              : BaseVector::createNullConstant(type, 1, pool));
+        break;
+      }
+    }
+  }
+  std::fill(accumulators_.begin(), accumulators_.end(), Accumulator{});
+  return std::make_shared<RowVector>(
+      pool, outputType_, nullptr, 1, std::move(columns));
+}
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Computes the HiveAggregates of a table handle over the rows of one split,
+/// from the file statistics or from the rows that pass the filters.
+class SplitAggregates {
+ public:
+  /// @param inputNames Names of the aggregate inputs in the file, empty for
+  /// count(*).
+  /// @param inputChannels Channels of the aggregate inputs in the vectors
+  /// passed to addRows(). Ignored for count(*).
+  /// @param outputType Type of the row returned by finish(), one column per
+  /// aggregate.
+  SplitAggregates(
+      std::vector<HiveAggregate> aggregates,
+      std::vector<std::string> inputNames,
+      std::vector<column_index_t> inputChannels,
+      RowTypePtr outputType);
+
+  /// Returns true if 'kind' over a column of 'type' can be computed by the
+  /// scan. kMin and kMax are supported on integer and date columns only, for
+  /// which the file statistics are exact.
+  static bool supports(HiveAggregate::Kind kind, const TypePtr& type);
+
+  /// Returns the type of the result of 'kind' over a column of 'inputType'.
+  static TypePtr resultType(
+      HiveAggregate::Kind kind,
+      const TypePtr& inputType);
+
+  /// Adds all rows of the file of 'reader' from its statistics. Returns false
+  /// without adding anything if the statistics needed are missing.
+  bool addStatistics(const dwio::common::Reader& reader);
+
+  /// Adds 'numRows' rows of 'input', the rows at 'indices' if not null and the
+  /// first 'numRows' otherwise.
+  void addRows(
+      const RowVector& input,
+      vector_size_t numRows,
+      const BufferPtr& indices);
+
+  /// Returns a row with the aggregates of the rows added since the last call.
+  RowVectorPtr finish(memory::MemoryPool* pool);
+
+ private:
+  struct Accumulator {
+    int64_t count{0};
+    std::optional<int64_t> min;
+    std::optional<int64_t> max;
+
+    void addValue(int64_t value) {
+      min = min.has_value() ? std::min(*min, value) : value;
+      max = max.has_value() ? std::max(*max, value) : value;
+    }
+
+    void merge(const Accumulator& other);
+  };
+
+  const std::vector<HiveAggregate> aggregates_;
+  const std::vector<std::string> inputNames_;
+  const std::vector<column_index_t> inputChannels_;
+  const RowTypePtr outputType_;
+
+  std::vector<Accumulator> accumulators_;
+  DecodedVector decoded_;
+};
+
+} // namespace facebook::velox::connector::hive
@@ -88,6 +88,23 @@ VectorPtr newConstantFromString(
       isDaysSinceEpoch);
 }
 
+VectorPtr SplitConstantCache::get(
+    const std::string& name,
+    const TypePtr& type,
+    const std::optional<std::string>& value,
+    velox::memory::MemoryPool* pool,
+    bool isLocalTimestamp,
+    bool isDaysSinceEpoch) {
+  auto& entry = entries_[name];
+  if (entry.constant == nullptr || entry.value != value ||
+      !entry.constant->type()->equivalent(*type)) {
+    entry.constant = newConstantFromString(
+        type, value, pool, isLocalTimestamp, isDaysSinceEpoch);
+    entry.value = value;
+  }
+  return entry.constant;
+}
+
 std::unique_ptr<SplitReader> SplitReader::create(
     const std::shared_ptr<hive::HiveConnectorSplit>& hiveSplit,
     const HiveTableHandlePtr& hiveTableHandle,
@@ -252,6 +269,20 @@ bool SplitReader::emptySplit() const {
   return emptySplit_;
 }
 
+bool SplitReader::allRowsPassFilters() const {
+  if (emptySplit_ || baseReader_ == nullptr || hiveSplit_->start != 0 ||
+      hiveSplit_->length < fileSize_) {
+    return false;
+  }
+  return testFiltersPassAll(
+      scanSpec_.get(),
+      baseReader_.get(),
+      hiveSplit_->partitionKeys,
+      *partitionKeys_,
+      hiveConfig_->readTimestampPartitionValueAsLocalTime(
+          connectorQueryCtx_->sessionProperties()));
+}
+
 void SplitReader::resetSplit() {
   hiveSplit_.reset();
 }
@@ -328,6 +359,8 @@ void SplitReader::createReader(
   // are generated, if CacheTTLController was created. Creator of
   // CacheTTLController needs to make sure a size control strategy was available
   // such as removing aged out entries.
+  fileSize_ = fileHandleCachePtr->file->size();
+
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
@@ -340,6 +373,22 @@ void SplitReader::createReader(
       ioExecutor_,
       fileReadOps);
 
+  // The parsed metadata and decoded dictionaries are shared by the splits of
+  // a file only if the modification time identifies the contents.
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  auto* dictionaryCache = dwio::common::DictionaryCache::getInstance();
+  if (metadataCache != nullptr || dictionaryCache != nullptr) {
+    if (auto key = fileMetadataCacheKey(
+            hiveSplit_->filePath, fileSize_, fileProperties)) {
+      if (dictionaryCache != nullptr) {
+        baseReaderOpts_.setDictionaryCache(dictionaryCache, *key);
+      }
+      if (metadataCache != nullptr) {
+        baseReaderOpts_.setFileMetadataCache(metadataCache, std::move(*key));
+      }
+    }
+  }
+
   baseReader_ = dwio::common::getReaderFactory(baseReaderOpts_.fileFormat())
                     ->createReader(std::move(baseFileInput), baseReaderOpts_);
   if (!baseReader_) {
@@ -427,14 +476,8 @@ std::vector<TypePtr> SplitReader::adaptColumns(
                iter != hiveSplit_->infoColumns.end()) {
       auto infoColumnType =
           readerOutputType_->childAt(readerOutputType_->getChildIdx(fieldName));
-      auto constant = newConstantFromString(
-          infoColumnType,
-          iter->second,
-          connectorQueryCtx_->memoryPool(),
-          hiveConfig_->readTimestampPartitionValueAsLocalTime(
-              connectorQueryCtx_->sessionProperties()),
-          false);
-      childSpec->setConstantValue(constant);
+      childSpec->setConstantValue(
+          newSplitConstant(fieldName, infoColumnType, iter->second, false));
     } else if (
         childSpec->columnType() == common::ScanSpec::ColumnType::kRegular) {
       auto fileTypeIdx = fileType->getChildIdxIfExists(fieldName);
@@ -480,15 +523,36 @@ void SplitReader::setPartitionValue(
       it != partitionKeys_->end(),
       "ColumnHandle is missing for partition key {}",
       partitionKey);
-  auto type = it->second->dataType();
-  auto constant = newConstantFromString(
+  spec->setConstantValue(newSplitConstant(
+      partitionKey,
+      it->second->dataType(),
+      value,
+      it->second->isPartitionDateValueDaysSinceEpoch()));
+}
+
+VectorPtr SplitReader::newSplitConstant(
+    const std::string& name,
+    const TypePtr& type,
+    const std::optional<std::string>& value,
+    bool isDaysSinceEpoch) const {
+  const bool isLocalTimestamp =
+      hiveConfig_->readTimestampPartitionValueAsLocalTime(
+          connectorQueryCtx_->sessionProperties());
+  if (constantCache_ != nullptr) {
+    return constantCache_->get(
+        name,
+        type,
+        value,
+        connectorQueryCtx_->memoryPool(),
+        isLocalTimestamp,
+        isDaysSinceEpoch);
+  }
+  return newConstantFromString(
       type,
       value,
       connectorQueryCtx_->memoryPool(),
-      hiveConfig_->readTimestampPartitionValueAsLocalTime(
-          connectorQueryCtx_->sessionProperties()),
-      it->second->isPartitionDateValueDaysSinceEpoch());
-  spec->setConstantValue(constant);
+      isLocalTimestamp,
+      isDaysSinceEpoch);
 }
 
 } // namespace facebook::velox::connector::hive
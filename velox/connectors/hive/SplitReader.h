@@ -77,6 +77,31 @@ VectorPtr newConstantFromString(
     bool isLocalTimestamp,
     bool isDaysSinceEpoch);
 
+/// Reuses the constant vectors of the partition keys and the info columns,
+/// e.g. $path and $bucket, across the splits that have the same values. The
+/// splits of one partition or of one file then share their constants instead
+/// of parsing the values again for each split.
+class SplitConstantCache {
+ public:
+  /// Returns the constant for 'value' of the column 'name'. The arguments are
+  /// as for newConstantFromString().
+  VectorPtr get(
+      const std::string& name,
+      const TypePtr& type,
+      const std::optional<std::string>& value,
+      velox::memory::MemoryPool* pool,
+      bool isLocalTimestamp,
+      bool isDaysSinceEpoch);
+
+ private:
+  struct Entry {
+    std::optional<std::string> value;
+    VectorPtr constant;
+  };
+
+  folly::F14FastMap<std::string, Entry> entries_;
+};
+
 struct HiveConnectorSplit;
 class HiveTableHandle;
 class HiveColumnHandle;
@@ -119,6 +144,17 @@ class SplitReader {
 
   bool emptySplit() const;
 
+  /// Returns true if the split covers all rows of its file and the file
+  /// statistics prove that all of them pass the filters of the scan spec, so
+  /// that aggregates over the rows of the split can be computed from
+  /// baseReader() statistics. Table formats that remove rows at read time,
+  /// e.g. with delete files, return false.
+  virtual bool allRowsPassFilters() const;
+
+  const dwio::common::Reader* baseReader() const {
+    return baseReader_.get();
+  }
+
   void resetSplit();
 
   int64_t estimatedRowSize() const;
@@ -131,6 +167,12 @@ class SplitReader {
 
   void setBucketConversion(std::vector<column_index_t> bucketChannels);
 
+  /// Sets the cache to take the constants of the partition keys and the info
+  /// columns from. The cache must outlive the split reader.
+  void setConstantCache(SplitConstantCache* constantCache) {
+    constantCache_ = constantCache;
+  }
+
   const RowTypePtr& readerOutputType() const {
     return readerOutputType_;
   }
@@ -205,6 +247,14 @@ class SplitReader {
       const std::string& partitionKey,
       const std::optional<std::string>& value) const;
 
+  // Returns the constant for a partition key or an info column, taken from
+  // constantCache_ if set.
+  VectorPtr newSplitConstant(
+      const std::string& name,
+      const TypePtr& type,
+      const std::optional<std::string>& value,
+      bool isDaysSinceEpoch) const;
+
  private:
   /// Different table formats may have different meatadata columns.
   /// This function will be used to update the scanSpec for these columns.
@@ -234,11 +284,14 @@ class SplitReader {
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
   bool emptySplit_;
+  // Size of the file of the split, set by createReader().
+  uint64_t fileSize_{0};
 
  private:
   folly::F14FastSet<column_index_t> bucketChannels_;
   std::unique_ptr<HivePartitionFunction> partitionFunction_;
   std::vector<uint32_t> partitions_;
+  SplitConstantCache* constantCache_{nullptr};
 };
 
 } // namespace facebook::velox::connector::hive
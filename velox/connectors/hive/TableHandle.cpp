@@ -30,6 +30,15 @@ columnTypeNames() {
   };
 }
 
+std::unordered_map<HiveAggregate::Kind, std::string> aggregateKindNames() {
+  return {
+      {HiveAggregate::Kind::kCount, "Count"},
+      {HiveAggregate::Kind::kMin, "Min"},
+      {HiveAggregate::Kind::kMax, "Max"},
+      {HiveAggregate::Kind::kNullCount, "NullCount"},
+  };
+}
+
 template <typename K, typename V>
 std::unordered_map<V, K> invertMap(const std::unordered_map<K, V>& mapping) {
   std::unordered_map<V, K> inverted;
@@ -104,6 +113,32 @@ void HiveColumnHandle::registerSerDe() {
   registry.Register("HiveColumnHandle", HiveColumnHandle::create);
 }
 
+std::string HiveAggregate::kindName(Kind kind) {
+  static const auto names = aggregateKindNames();
+  return names.at(kind);
+}
+
+HiveAggregate::Kind HiveAggregate::kindFromName(const std::string& name) {
+  static const auto kinds = invertMap(aggregateKindNames());
+  return kinds.at(name);
+}
+
+std::string HiveAggregate::toString() const {
+  return fmt::format(
+      "{}({})", kindName(kind), input.empty() ? "*" : input.c_str());
+}
+
+folly::dynamic HiveAggregate::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["kind"] = kindName(kind);
+  obj["input"] = input;
+  return obj;
+}
+
+HiveAggregate HiveAggregate::create(const folly::dynamic& obj) {
+  return {kindFromName(obj["kind"].asString()), obj["input"].asString()};
+}
+
 HiveTableHandle::HiveTableHandle(
     std::string connectorId,
     const std::string& tableName,
@@ -113,7 +148,8 @@ HiveTableHandle::HiveTableHandle(
     const RowTypePtr& dataColumns,
     const std::unordered_map<std::string, std::string>& tableParameters,
     std::vector<HiveColumnHandlePtr> filterColumnHandles,
-    double sampleRate)
+    double sampleRate,
+    std::vector<HiveAggregate> aggregates)
     : ConnectorTableHandle(std::move(connectorId)),
       tableName_(tableName),
       filterPushdownEnabled_(filterPushdownEnabled),
@@ -122,7 +158,8 @@ HiveTableHandle::HiveTableHandle(
       sampleRate_{sampleRate},
       dataColumns_(dataColumns),
       tableParameters_(tableParameters),
-      filterColumnHandles_(std::move(filterColumnHandles)) {
+      filterColumnHandles_(std::move(filterColumnHandles)),
+      aggregates_(std::move(aggregates)) {
   VELOX_CHECK_GT(sampleRate_, 0.0, "Sample rate must be positive");
   VELOX_CHECK_LE(sampleRate_, 1.0, "Sample rate must not exceed 1.0");
 }
@@ -183,6 +220,16 @@ std::string HiveTableHandle::toString() const {
     }
     out << "]";
   }
+  if (!aggregates_.empty()) {
+    out << ", aggregates: [";
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      if (i > 0) {
+        out << ", ";
+      }
+      out << aggregates_[i].toString();
+    }
+    out << "]";
+  }
   return out.str();
 }
 
@@ -223,6 +270,13 @@ folly::dynamic HiveTableHandle::serialize() const {
     }
     obj["filterColumnHandles"] = filterColumnHandles;
   }
+  if (!aggregates_.empty()) {
+    folly::dynamic aggregates = folly::dynamic::array;
+    for (const auto& aggregate : aggregates_) {
+      aggregates.push_back(aggregate.serialize());
+    }
+    obj["aggregates"] = aggregates;
+  }
 
   return obj;
 }
@@ -275,6 +329,13 @@ ConnectorTableHandlePtr HiveTableHandle::create(
     }
   }
 
+  std::vector<HiveAggregate> aggregates;
+  if (auto it = obj.find("aggregates"); it != obj.items().end()) {
+    for (const auto& aggregate : it->second) {
+      aggregates.push_back(HiveAggregate::create(aggregate));
+    }
+  }
+
   return std::make_shared<const HiveTableHandle>(
       connectorId,
       tableName,
@@ -284,7 +345,8 @@ ConnectorTableHandlePtr HiveTableHandle::create(
       dataColumns,
       tableParameters,
       std::move(filterColumnHandles),
-      sampleRate);
+      sampleRate,
+      std::move(aggregates));
 }
 
 void HiveTableHandle::registerSerDe() {
@@ -158,10 +158,47 @@ using HiveColumnHandlePtr = std::shared_ptr<const HiveColumnHandle>;
 using HiveColumnHandleMap =
     std::unordered_map<std::string, HiveColumnHandlePtr>;
 
+/// An aggregate over the rows of each split that pass the filters, computed by
+/// the scan instead of returning the rows. A scan with aggregates returns one
+/// row per split with one column per aggregate: BIGINT for kCount and
+/// kNullCount, the input type for kMin and kMax. The plan merges these partial
+/// results with a final aggregation, e.g. sum() of the counts. The scan answers
+/// the split from the file statistics when they prove that every row of the
+/// file passes the filters and decodes the rows otherwise.
+struct HiveAggregate {
+  /// NOTE: Make sure to update the mapping in kindNames() when modifying this.
+  enum class Kind {
+    /// count(*) if 'input' is empty, the number of non-null values otherwise.
+    kCount,
+    kMin,
+    kMax,
+    /// The number of null values of 'input'.
+    kNullCount,
+  };
+
+  Kind kind;
+
+  /// Name of the aggregated column in the assignments of the scan. Empty for
+  /// count(*).
+  std::string input;
+
+  static std::string kindName(Kind kind);
+
+  static Kind kindFromName(const std::string& name);
+
+  std::string toString() const;
+
+  folly::dynamic serialize() const;
+
+  static HiveAggregate create(const folly::dynamic& obj);
+};
+
 class HiveTableHandle : public ConnectorTableHandle {
  public:
   /// @param sampleRate Sampling rate in (0, 1] range. 0.1 means 10% sampling.
   /// 1.0 means no sampling. Default is no sampling.
+  /// @param aggregates Aggregates the scan computes per split instead of
+  /// returning the rows. See HiveAggregate.
   HiveTableHandle(
       std::string connectorId,
       const std::string& tableName,
@@ -171,7 +208,8 @@ class HiveTableHandle : public ConnectorTableHandle {
       const RowTypePtr& dataColumns = nullptr,
       const std::unordered_map<std::string, std::string>& tableParameters = {},
       std::vector<HiveColumnHandlePtr> filterColumnHandles = {},
-      double sampleRate = 1.0);
+      double sampleRate = 1.0,
+      std::vector<HiveAggregate> aggregates = {});
 
   const std::string& tableName() const {
     return tableName_;
@@ -228,6 +266,12 @@ class HiveTableHandle : public ConnectorTableHandle {
     return filterColumnHandles_;
   }
 
+  /// Aggregates returned by the scan instead of the rows. Empty if the scan
+  /// returns rows.
+  const std::vector<HiveAggregate>& aggregates() const {
+    return aggregates_;
+  }
+
   std::string toString() const override;
 
   folly::dynamic serialize() const override;
@@ -247,6 +291,7 @@ class HiveTableHandle : public ConnectorTableHandle {
   const RowTypePtr dataColumns_;
   const std::unordered_map<std::string, std::string> tableParameters_;
   const std::vector<HiveColumnHandlePtr> filterColumnHandles_;
+  const std::vector<HiveAggregate> aggregates_;
 };
 
 using HiveTableHandlePtr = std::shared_ptr<const HiveTableHandle>;
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/BufferedInputBuilder.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+
+bool isIntegerKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t integerValueAt(const DecodedVector& decoded, vector_size_t row) {
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+void appendBytes(const T& value, std::string& out) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <TypeKind Kind>
+void appendValue(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    std::string& out) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  if constexpr (std::is_same_v<T, StringView>) {
+    const auto value = decoded.valueAt<StringView>(row);
+    appendBytes(value.size(), out);
+    out.append(value.data(), value.size());
+  } else if constexpr (std::is_same_v<T, bool>) {
+    out.push_back(decoded.valueAt<bool>(row) ? 1 : 0);
+  } else if constexpr (
+      std::is_arithmetic_v<T> || std::is_same_v<T, int128_t> ||
+      std::is_same_v<T, Timestamp>) {
+    appendBytes(decoded.valueAt<T>(row), out);
+  } else {
+    VELOX_NYI(
+        "Unsupported type of Iceberg equality delete column: {}",
+        decoded.base()->type()->toString());
+  }
+}
+
+} // namespace
+
+EqualityDeleteKeySet::EqualityDeleteKeySet(RowTypePtr keyType)
+    : keyType_(std::move(keyType)),
+      singleIntegerKey_(
+          keyType_->size() == 1 &&
+          isIntegerKind(keyType_->childAt(0)->kind())) {
+  VELOX_CHECK_GT(keyType_->size(), 0);
+}
+
+void EqualityDeleteKeySet::add(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t size) {
+  VELOX_CHECK_EQ(keys.size(), keyType_->size());
+  std::vector<DecodedVector> decoded(keys.size());
+  for (auto i = 0; i < keys.size(); ++i) {
+    decoded[i].decode(*keys[i]);
+  }
+  if (singleIntegerKey_) {
+    for (vector_size_t row = 0; row < size; ++row) {
+      if (decoded[0].isNullAt(row)) {
+        hasNullKey_ = true;
+      } else {
+        integerKeys_.insert(integerValueAt(decoded[0], row));
+      }
+    }
+    return;
+  }
+  std::string key;
+  for (vector_size_t row = 0; row < size; ++row) {
+    key.clear();
+    encodeKey(decoded, row, key);
+    if (encodedKeys_.insert(key).second) {
+      encodedKeyBytes_ += key.size();
+    }
+  }
+}
+
+void EqualityDeleteKeySet::probe(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t size,
+    uint64_t* deleted) const {
+  VELOX_CHECK_EQ(keys.size(), keyType_->size());
+  std::vector<DecodedVector> decoded(keys.size());
+  for (auto i = 0; i < keys.size(); ++i) {
+    decoded[i].decode(*keys[i]);
+  }
+  if (singleIntegerKey_) {
+    const auto& column = decoded[0];
+    for (vector_size_t row = 0; row < size; ++row) {
+      if (column.isNullAt(row)
+              ? hasNullKey_
+              : integerKeys_.contains(integerValueAt(column, row))) {
+        bits::setBit(deleted, row);
+      }
+    }
+    return;
+  }
+  std::string key;
+  for (vector_size_t row = 0; row < size; ++row) {
+    key.clear();
+    encodeKey(decoded, row, key);
+    if (encodedKeys_.contains(key)) {
+      bits::setBit(deleted, row);
+    }
+  }
+}
+
+void EqualityDeleteKeySet::encodeKey(
+    const std::vector<DecodedVector>& keys,
+    vector_size_t row,
+    std::string& out) const {
+  for (auto i = 0; i < keys.size(); ++i) {
+    if (keys[i].isNullAt(row)) {
+      out.push_back(1);
+      continue;
+    }
+    out.push_back(0);
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        appendValue, keyType_->childAt(i)->kind(), keys[i], row, out);
+  }
+}
+
+uint64_t EqualityDeleteKeySet::numKeys() const {
+  if (singleIntegerKey_) {
+    return integerKeys_.size() + (hasNullKey_ ? 1 : 0);
+  }
+  return encodedKeys_.size();
+}
+
+uint64_t EqualityDeleteKeySet::sizeBytes() const {
+  return sizeof(*this) + integerKeys_.getAllocatedMemorySize() +
+      encodedKeys_.getAllocatedMemorySize() + encodedKeyBytes_;
+}
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    const RowTypePtr& tableType,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::shared_ptr<filesystems::File::IoStats>& fsStats,
+    const std::string& connectorId)
+    : deleteFile_(deleteFile),
+      tableType_(tableType),
+      fileHandleFactory_(fileHandleFactory),
+      connectorQueryCtx_(connectorQueryCtx),
+      executor_(executor),
+      hiveConfig_(hiveConfig),
+      ioStats_(ioStats),
+      fsStats_(fsStats),
+      connectorId_(connectorId),
+      pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile_.content == FileContent::kEqualityDeletes);
+  VELOX_CHECK(deleteFile_.recordCount);
+  VELOX_CHECK(
+      !deleteFile_.equalityFieldIds.empty(),
+      "Iceberg equality delete file has no equality field ids: {}",
+      deleteFile_.filePath);
+}
+
+std::shared_ptr<const EqualityDeleteKeySet>
+EqualityDeleteFileReader::readKeys() {
+  // Delete files are immutable. The columns that may be keys depend on the
+  // table schema of the query, so the cache key includes it.
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  if (metadataCache == nullptr) {
+    return readKeysFromFile();
+  }
+  const auto cacheKey = fmt::format(
+      "{}:{}:iceberg-equality-deletes:{}",
+      deleteFile_.filePath,
+      deleteFile_.fileSizeInBytes,
+      tableType_->toString());
+  if (auto keys = metadataCache->get<EqualityDeleteKeySet>(cacheKey)) {
+    return keys;
+  }
+  auto keys = readKeysFromFile();
+  metadataCache->put(cacheKey, keys, keys->sizeBytes());
+  return keys;
+}
+
+std::shared_ptr<const EqualityDeleteKeySet>
+EqualityDeleteFileReader::readKeysFromFile() {
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId_,
+      deleteFile_.filePath,
+      deleteFile_.fileFormat,
+      0,
+      deleteFile_.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      hiveConfig_,
+      connectorQueryCtx_,
+      /*fileSchema=*/nullptr,
+      deleteSplit,
+      /*tableParameters=*/{},
+      deleteReaderOpts);
+
+  const FileHandleKey fileHandleKey{
+      .filename = deleteFile_.filePath,
+      .tokenProvider = connectorQueryCtx_->fsTokenProvider()};
+  auto deleteFileHandleCachePtr = fileHandleFactory_->generate(fileHandleKey);
+  auto deleteFileInput = BufferedInputBuilder::getInstance()->create(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx_,
+      ioStats_,
+      fsStats_,
+      executor_);
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  // The equality field ids are not resolved against the file schema, so the
+  // delete file must contain only the equality columns.
+  const auto& fileType = deleteReader->rowType();
+  VELOX_USER_CHECK_EQ(
+      fileType->size(),
+      deleteFile_.equalityFieldIds.size(),
+      "Iceberg equality delete file must contain only the equality columns: {}",
+      deleteFile_.filePath);
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < fileType->size(); ++i) {
+    const auto& name = fileType->nameOf(i);
+    const auto tableIdx = tableType_->getChildIdxIfExists(name);
+    VELOX_USER_CHECK(
+        tableIdx.has_value(),
+        "Iceberg equality delete column {} must be read from the table",
+        name);
+    const auto& tableColumnType = tableType_->childAt(tableIdx.value());
+    VELOX_USER_CHECK(
+        fileType->childAt(i)->equivalent(*tableColumnType),
+        "Iceberg equality delete column {} has type {}, table type is {}",
+        name,
+        fileType->childAt(i)->toString(),
+        tableColumnType->toString());
+    scanSpec->addField(name, i);
+  }
+  const RowTypePtr keyType = fileType;
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      {},
+      scanSpec,
+      nullptr,
+      keyType,
+      deleteSplit,
+      nullptr,
+      nullptr,
+      nullptr,
+      deleteRowReaderOpts);
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
+
+  auto keys = std::make_shared<EqualityDeleteKeySet>(keyType);
+  VectorPtr output = BaseVector::create(keyType, 0, pool_);
+  while (deleteRowReader->next(deleteFile_.recordCount, output) > 0) {
+    if (output->size() == 0) {
+      continue;
+    }
+    const auto* rowVector = output->loadedVector()->asChecked<RowVector>();
+    keys->add(rowVector->children(), rowVector->size());
+  }
+  return keys;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Set.h>
+#include <memory>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// The keys of the rows deleted by an equality delete file. A data row is
+/// deleted if its values of the key columns equal the values of a key. Nulls
+/// compare equal to nulls. The set is immutable after it is built and is shared
+/// by the splits that apply the same delete file.
+class EqualityDeleteKeySet {
+ public:
+  explicit EqualityDeleteKeySet(RowTypePtr keyType);
+
+  /// The names and types of the key columns.
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// Adds the first 'size' rows of 'keys' to the set. 'keys' has one column
+  /// per column of 'keyType()'.
+  void add(const std::vector<VectorPtr>& keys, vector_size_t size);
+
+  /// Sets the bit in 'deleted' of each of the first 'size' rows of 'keys' that
+  /// is in the set. Does not clear the other bits.
+  void probe(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t size,
+      uint64_t* deleted) const;
+
+  /// Number of distinct keys.
+  uint64_t numKeys() const;
+
+  /// Approximate memory used by the set.
+  uint64_t sizeBytes() const;
+
+ private:
+  // Appends the encoding of the key at 'row' of 'keys' to 'out'. The encoding
+  // contains a null flag and the value bytes of each column.
+  void encodeKey(
+      const std::vector<DecodedVector>& keys,
+      vector_size_t row,
+      std::string& out) const;
+
+  const RowTypePtr keyType_;
+  // True if there is one key column of an integer type. Such keys are kept in
+  // 'integerKeys_', the other keys in 'encodedKeys_'.
+  const bool singleIntegerKey_;
+  folly::F14FastSet<int64_t> integerKeys_;
+  // True if 'singleIntegerKey_' and a key is null.
+  bool hasNullKey_{false};
+  folly::F14FastSet<std::string> encodedKeys_;
+  uint64_t encodedKeyBytes_{0};
+};
+
+/// Reads the keys of an equality delete file. The columns of the delete file
+/// are the equality columns and must have the types of the same named columns
+/// of 'tableType'. The key sets are shared through the process-wide
+/// FileMetadataCache if it is enabled.
+class EqualityDeleteFileReader {
+ public:
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      const RowTypePtr& tableType,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::shared_ptr<filesystems::File::IoStats>& fsStats,
+      const std::string& connectorId);
+
+  /// Returns the keys of the delete file, reading the file unless they are
+  /// cached.
+  std::shared_ptr<const EqualityDeleteKeySet> readKeys();
+
+ private:
+  std::shared_ptr<const EqualityDeleteKeySet> readKeysFromFile();
+
+  const IcebergDeleteFile& deleteFile_;
+  const RowTypePtr tableType_;
+  FileHandleFactory* const fileHandleFactory_;
+  const ConnectorQueryCtx* const connectorQueryCtx_;
+  folly::Executor* const executor_;
+  const std::shared_ptr<const HiveConfig> hiveConfig_;
+  const std::shared_ptr<io::IoStatistics> ioStats_;
+  const std::shared_ptr<filesystems::File::IoStats> fsStats_;
+  const std::string connectorId_;
+  memory::MemoryPool* const pool_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
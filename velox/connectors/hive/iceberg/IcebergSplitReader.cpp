@@ -16,9 +16,12 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include <folly/String.h>
+
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 
 using namespace facebook::velox::dwio::common;
 
@@ -48,8 +51,6 @@ IcebergSplitReader::IcebergSplitReader(
           fileHandleFactory,
           executor,
           scanSpec),
-      baseReadOffset_(0),
-      splitOffset_(0),
       deleteBitmap_(nullptr) {}
 
 void IcebergSplitReader::prepareSplit(
@@ -71,32 +72,98 @@ void IcebergSplitReader::prepareSplit(
 
   std::shared_ptr<const HiveIcebergSplit> icebergSplit =
       std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
-  baseReadOffset_ = 0;
-  splitOffset_ = baseRowReader_->nextRowNumber();
-  positionalDeleteFileReaders_.clear();
+  positionalDeletes_.reset();
+  equalityDeletes_.clear();
 
+  std::vector<const IcebergDeleteFile*> positionalDeleteFiles;
   const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
       if (deleteFile.recordCount > 0) {
-        positionalDeleteFileReaders_.push_back(
-            std::make_unique<PositionalDeleteFileReader>(
-                deleteFile,
-                hiveSplit_->filePath,
-                fileHandleFactory_,
-                connectorQueryCtx_,
-                ioExecutor_,
-                hiveConfig_,
-                ioStats_,
-                fsStats_,
-                runtimeStats,
-                splitOffset_,
-                hiveSplit_->connectorId));
+        positionalDeleteFiles.push_back(&deleteFile);
+      }
+    } else if (deleteFile.content == FileContent::kEqualityDeletes) {
+      if (deleteFile.recordCount > 0) {
+        addEqualityDelete(deleteFile);
       }
     } else {
       VELOX_NYI();
     }
   }
+  if (!positionalDeleteFiles.empty()) {
+    positionalDeletes_ =
+        readPositionalDeletes(positionalDeleteFiles, runtimeStats);
+  }
+}
+
+std::shared_ptr<const PositionalDeleteBitmap>
+IcebergSplitReader::readPositionalDeletes(
+    const std::vector<const IcebergDeleteFile*>& deleteFiles,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  // Delete files are immutable, so their paths and sizes identify the
+  // positions. The order of the delete files does not matter.
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  std::string cacheKey;
+  if (metadataCache != nullptr) {
+    std::vector<std::string> deleteFileKeys;
+    deleteFileKeys.reserve(deleteFiles.size());
+    for (const auto* deleteFile : deleteFiles) {
+      deleteFileKeys.push_back(fmt::format(
+          "{}:{}", deleteFile->filePath, deleteFile->fileSizeInBytes));
+    }
+    std::sort(deleteFileKeys.begin(), deleteFileKeys.end());
+    cacheKey = fmt::format(
+        "{}:iceberg-positional-deletes:{}",
+        hiveSplit_->filePath,
+        folly::join(",", deleteFileKeys));
+    if (auto positions = metadataCache->get<PositionalDeleteBitmap>(cacheKey)) {
+      return positions;
+    }
+  }
+
+  auto positions = std::make_shared<PositionalDeleteBitmap>();
+  for (const auto* deleteFile : deleteFiles) {
+    PositionalDeleteFileReader reader(
+        *deleteFile,
+        hiveSplit_->filePath,
+        fileHandleFactory_,
+        connectorQueryCtx_,
+        ioExecutor_,
+        hiveConfig_,
+        ioStats_,
+        fsStats_,
+        runtimeStats,
+        hiveSplit_->connectorId);
+    reader.readDeletePositions(*positions);
+  }
+  positions->seal();
+  if (metadataCache != nullptr) {
+    metadataCache->put(cacheKey, positions, positions->sizeBytes());
+  }
+  return positions;
+}
+
+void IcebergSplitReader::addEqualityDelete(
+    const IcebergDeleteFile& deleteFile) {
+  EqualityDeleteFileReader reader(
+      deleteFile,
+      readerOutputType_,
+      fileHandleFactory_,
+      connectorQueryCtx_,
+      ioExecutor_,
+      hiveConfig_,
+      ioStats_,
+      fsStats_,
+      hiveSplit_->connectorId);
+  auto keys = reader.readKeys();
+  if (keys->numKeys() == 0) {
+    return;
+  }
+  std::vector<column_index_t> channels;
+  for (const auto& name : keys->keyType()->names()) {
+    channels.push_back(readerOutputType_->getChildIdx(name));
+  }
+  equalityDeletes_.push_back({std::move(keys), std::move(channels)});
 }
 
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
@@ -104,43 +171,72 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
   mutation.deletedRows = nullptr;
 
-  if (deleteBitmap_) {
-    std::memset(
-        (void*)(deleteBitmap_->asMutable<int8_t>()), 0L, deleteBitmap_->size());
-  }
-
   const auto actualSize = baseRowReader_->nextReadSize(size);
-  baseReadOffset_ = baseRowReader_->nextRowNumber() - splitOffset_;
   if (actualSize == dwio::common::RowReader::kAtEnd) {
     return 0;
   }
 
-  if (!positionalDeleteFileReaders_.empty()) {
-    auto numBytes = bits::nbytes(actualSize);
-    dwio::common::ensureCapacity<int8_t>(
-        deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool(), false, true);
-
-    for (auto iter = positionalDeleteFileReaders_.begin();
-         iter != positionalDeleteFileReaders_.end();) {
-      (*iter)->readDeletePositions(baseReadOffset_, actualSize, deleteBitmap_);
-
-      if ((*iter)->noMoreData()) {
-        iter = positionalDeleteFileReaders_.erase(iter);
+  // Batches without deleted positions read without a mutation bitmap. Fully
+  // deleted batches are set as a whole, and the reader skips them without
+  // decoding.
+  if (positionalDeletes_) {
+    const uint64_t firstRow = baseRowReader_->nextRowNumber();
+    const uint64_t endRow = firstRow + actualSize;
+    if (!positionalDeletes_->noneDeleted(firstRow, endRow)) {
+      const auto numWords = bits::nwords(actualSize);
+      dwio::common::ensureCapacity<uint64_t>(
+          deleteBitmap_, numWords, connectorQueryCtx_->memoryPool());
+      auto* deletedRows = deleteBitmap_->asMutable<uint64_t>();
+      std::memset(deletedRows, 0, numWords * sizeof(uint64_t));
+      if (positionalDeletes_->allDeleted(firstRow, endRow)) {
+        bits::fillBits(deletedRows, 0, actualSize, true);
       } else {
-        ++iter;
+        positionalDeletes_->fill(firstRow, endRow, deletedRows);
       }
+      mutation.deletedRows = deletedRows;
     }
   }
 
-  mutation.deletedRows = deleteBitmap_ && deleteBitmap_->size() > 0
-      ? deleteBitmap_->as<uint64_t>()
-      : nullptr;
-
   auto rowsScanned = baseRowReader_->next(actualSize, output, &mutation);
+  if (rowsScanned > 0 && output->size() > 0 && !equalityDeletes_.empty()) {
+    applyEqualityDeletes(output);
+  }
 
   return rowsScanned;
 }
 
+void IcebergSplitReader::applyEqualityDeletes(VectorPtr& output) {
+  const auto* rowVector = output->asChecked<RowVector>();
+  const auto numRows = rowVector->size();
+  equalityDeletedRows_.assign(bits::nwords(numRows), 0);
+  std::vector<VectorPtr> keys;
+  for (const auto& equalityDelete : equalityDeletes_) {
+    keys.clear();
+    for (const auto channel : equalityDelete.channels) {
+      keys.push_back(rowVector->childAt(channel));
+    }
+    equalityDelete.keys->probe(keys, numRows, equalityDeletedRows_.data());
+  }
+  if (bits::isAllSet(equalityDeletedRows_.data(), 0, numRows, false)) {
+    return;
+  }
+
+  // Keep the runs of rows that are not deleted.
+  std::vector<BaseVector::CopyRange> ranges;
+  vector_size_t numKept = 0;
+  bits::forEachUnsetBit(
+      equalityDeletedRows_.data(), 0, numRows, [&](vector_size_t row) {
+        if (!ranges.empty() &&
+            ranges.back().sourceIndex + ranges.back().count == row) {
+          ++ranges.back().count;
+        } else {
+          ranges.push_back({row, numKept, 1});
+        }
+        ++numKept;
+      });
+  applyBucketConversion(output, ranges);
+}
+
 std::vector<TypePtr> IcebergSplitReader::adaptColumns(
     const RowTypePtr& fileType,
     const RowTypePtr& tableSchema) const {
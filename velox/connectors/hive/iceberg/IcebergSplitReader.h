@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -49,6 +50,11 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  /// The delete files of the split remove rows that the file statistics count.
+  bool allRowsPassFilters() const override {
+    return false;
+  }
+
  private:
   /// Adapts the data file schema to match the table schema expected by the
   /// query.
@@ -93,13 +99,33 @@ class IcebergSplitReader : public SplitReader {
       const RowTypePtr& fileType,
       const RowTypePtr& tableSchema) const override;
 
-  // The read offset to the beginning of the split in number of rows for the
-  // current batch for the base data file
-  uint64_t baseReadOffset_;
-  // The file position for the first row in the split
-  uint64_t splitOffset_;
-  std::list<std::unique_ptr<PositionalDeleteFileReader>>
-      positionalDeleteFileReaders_;
+  // Returns the deleted positions of the base data file from
+  // 'deleteFiles'. The positions are shared by the splits of the file through
+  // the FileMetadataCache if it is enabled.
+  std::shared_ptr<const PositionalDeleteBitmap> readPositionalDeletes(
+      const std::vector<const IcebergDeleteFile*>& deleteFiles,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
+  // Reads the keys of 'deleteFile' and adds them to 'equalityDeletes_'.
+  void addEqualityDelete(const IcebergDeleteFile& deleteFile);
+
+  // Removes the rows of 'output' whose equality columns match a key of an
+  // equality delete file.
+  void applyEqualityDeletes(VectorPtr& output);
+
+  // The keys of an equality delete file and the channels of its columns in
+  // the reader output.
+  struct EqualityDelete {
+    std::shared_ptr<const EqualityDeleteKeySet> keys;
+    std::vector<column_index_t> channels;
+  };
+
+  // The deleted positions of the base data file from the positional delete
+  // files of the split. Null if the split has no positional deletes.
+  std::shared_ptr<const PositionalDeleteBitmap> positionalDeletes_;
   BufferPtr deleteBitmap_;
+  std::vector<EqualityDelete> equalityDeletes_;
+  // The rows of the current batch deleted by 'equalityDeletes_'.
+  std::vector<uint64_t> equalityDeletedRows_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
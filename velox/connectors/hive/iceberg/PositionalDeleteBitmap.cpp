@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/PositionalDeleteBitmap.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+uint32_t PositionalDeleteBitmap::Chunk::count() const {
+  if (full) {
+    return kChunkSize;
+  }
+  if (!bits.empty()) {
+    return bits::countBits(bits.data(), 0, kChunkSize);
+  }
+  return positions.size();
+}
+
+PositionalDeleteBitmap::Chunk& PositionalDeleteBitmap::chunkFor(uint64_t key) {
+  auto [it, inserted] = chunkIndex_.try_emplace(key, chunks_.size());
+  if (inserted) {
+    chunks_.push_back(Chunk{.key = key});
+  }
+  return chunks_[it->second];
+}
+
+void PositionalDeleteBitmap::add(uint64_t position) {
+  VELOX_CHECK(!sealed_, "Cannot add to a sealed PositionalDeleteBitmap");
+  chunkFor(position >> kChunkBits)
+      .positions.push_back(position & (kChunkSize - 1));
+}
+
+void PositionalDeleteBitmap::seal() {
+  VELOX_CHECK(!sealed_);
+  sealed_ = true;
+  chunkIndex_ = {};
+  std::sort(chunks_.begin(), chunks_.end(), [](const auto& l, const auto& r) {
+    return l.key < r.key;
+  });
+  for (auto& chunk : chunks_) {
+    auto& positions = chunk.positions;
+    std::sort(positions.begin(), positions.end());
+    positions.erase(
+        std::unique(positions.begin(), positions.end()), positions.end());
+    numDeleted_ += positions.size();
+    if (positions.size() == kChunkSize) {
+      chunk.full = true;
+      positions = {};
+    } else if (positions.size() > kMaxArraySize) {
+      chunk.bits.resize(kChunkSize / 64);
+      for (const auto position : positions) {
+        bits::setBit(chunk.bits.data(), position);
+      }
+      positions = {};
+    } else {
+      positions.shrink_to_fit();
+    }
+  }
+}
+
+size_t PositionalDeleteBitmap::lowerBound(uint64_t key) const {
+  return std::lower_bound(
+             chunks_.begin(),
+             chunks_.end(),
+             key,
+             [](const Chunk& chunk, uint64_t key) { return chunk.key < key; }) -
+      chunks_.begin();
+}
+
+template <typename Func>
+bool PositionalDeleteBitmap::forEachChunk(
+    uint64_t begin,
+    uint64_t end,
+    Func func) const {
+  VELOX_DCHECK(sealed_);
+  if (begin >= end) {
+    return true;
+  }
+  const auto lastKey = (end - 1) >> kChunkBits;
+  for (auto i = lowerBound(begin >> kChunkBits);
+       i < chunks_.size() && chunks_[i].key <= lastKey;
+       ++i) {
+    const auto& chunk = chunks_[i];
+    const uint64_t chunkBegin = chunk.key << kChunkBits;
+    const uint32_t lo = std::max(begin, chunkBegin) - chunkBegin;
+    const uint32_t hi = std::min<uint64_t>(end, chunkBegin + kChunkSize) -
+        chunkBegin;
+    if (!func(chunk, chunkBegin, lo, hi)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PositionalDeleteBitmap::noneDeleted(uint64_t begin, uint64_t end) const {
+  return forEachChunk(
+      begin,
+      end,
+      [](const Chunk& chunk, uint64_t /*unused*/, uint32_t lo, uint32_t hi) {
+        if (chunk.full) {
+          return false;
+        }
+        if (!chunk.bits.empty()) {
+          return bits::isAllSet(chunk.bits.data(), lo, hi, false);
+        }
+        auto it = std::lower_bound(
+            chunk.positions.begin(), chunk.positions.end(), lo);
+        return it == chunk.positions.end() || *it >= hi;
+      });
+}
+
+bool PositionalDeleteBitmap::allDeleted(uint64_t begin, uint64_t end) const {
+  // Each position must be in a chunk, so the chunks must be consecutive and
+  // cover [begin, end).
+  uint64_t nextBegin = begin;
+  const bool allInChunks = forEachChunk(
+      begin,
+      end,
+      [&](const Chunk& chunk, uint64_t chunkBegin, uint32_t lo, uint32_t hi) {
+        if (chunkBegin + lo != nextBegin) {
+          return false;
+        }
+        nextBegin = chunkBegin + hi;
+        if (chunk.full) {
+          return true;
+        }
+        if (!chunk.bits.empty()) {
+          return bits::isAllSet(chunk.bits.data(), lo, hi, true);
+        }
+        const auto first = std::lower_bound(
+            chunk.positions.begin(), chunk.positions.end(), lo);
+        const auto last =
+            std::lower_bound(first, chunk.positions.end(), hi);
+        return last - first == hi - lo;
+      });
+  return allInChunks && nextBegin >= end;
+}
+
+void PositionalDeleteBitmap::fill(
+    uint64_t begin,
+    uint64_t end,
+    uint64_t* bits) const {
+  forEachChunk(
+      begin,
+      end,
+      [&](const Chunk& chunk, uint64_t chunkBegin, uint32_t lo, uint32_t hi) {
+        // The bit in 'bits' of the low bits 'lo' of the chunk.
+        const int32_t firstRow = chunkBegin + lo - begin;
+        if (chunk.full) {
+          bits::fillBits(bits, firstRow, firstRow + hi - lo, true);
+        } else if (!chunk.bits.empty()) {
+          bits::forEachSetBit(chunk.bits.data(), lo, hi, [&](int32_t row) {
+            bits::setBit(bits, firstRow + row - lo);
+          });
+        } else {
+          for (auto it = std::lower_bound(
+                   chunk.positions.begin(), chunk.positions.end(), lo);
+               it != chunk.positions.end() && *it < hi;
+               ++it) {
+            bits::setBit(bits, firstRow + *it - lo);
+          }
+        }
+        return true;
+      });
+}
+
+uint64_t PositionalDeleteBitmap::sizeBytes() const {
+  uint64_t size = sizeof(*this) + chunks_.capacity() * sizeof(Chunk);
+  for (const auto& chunk : chunks_) {
+    size += chunk.positions.capacity() * sizeof(uint16_t) +
+        chunk.bits.capacity() * sizeof(uint64_t);
+  }
+  return size;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
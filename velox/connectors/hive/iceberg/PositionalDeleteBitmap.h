@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// A compressed set of the deleted row positions of a data file, built from
+/// the positional delete files of the data file. Like a Roaring bitmap, the
+/// positions are partitioned into chunks of 2^16 positions by their high bits.
+/// A chunk keeps the low 16 bits of few positions in a sorted array, of many
+/// positions in a bitmap and marks a chunk with all positions deleted as full,
+/// so that large deleted spans take no space and are skipped as a whole.
+///
+/// The positions are added in any order. seal() must be called after the
+/// last add() and before the set is read. A sealed set is immutable and may be
+/// shared between threads.
+class PositionalDeleteBitmap {
+ public:
+  /// Adds the deleted row 'position'.
+  void add(uint64_t position);
+
+  /// Sorts and compresses the chunks.
+  void seal();
+
+  /// Returns true if no position in [begin, end) is deleted.
+  bool noneDeleted(uint64_t begin, uint64_t end) const;
+
+  /// Returns true if all positions in [begin, end) are deleted.
+  bool allDeleted(uint64_t begin, uint64_t end) const;
+
+  /// Sets bit 'i' of 'bits' for each deleted position 'begin + i' in [begin,
+  /// end). Does not clear the other bits.
+  void fill(uint64_t begin, uint64_t end, uint64_t* bits) const;
+
+  /// Number of distinct deleted positions.
+  uint64_t numDeleted() const {
+    return numDeleted_;
+  }
+
+  /// Approximate memory used by the set.
+  uint64_t sizeBytes() const;
+
+ private:
+  static constexpr int32_t kChunkBits = 16;
+  static constexpr uint32_t kChunkSize = 1 << kChunkBits;
+  // A chunk with more positions than this keeps a bitmap, which then takes
+  // less space than the array.
+  static constexpr uint32_t kMaxArraySize = kChunkSize / 16;
+
+  struct Chunk {
+    // The high bits of the positions of the chunk.
+    uint64_t key;
+    // The low bits of the positions if the chunk is an array. Unsorted until
+    // seal().
+    std::vector<uint16_t> positions;
+    // kChunkSize bits if the chunk is a bitmap.
+    std::vector<uint64_t> bits;
+    // True if all positions of the chunk are deleted.
+    bool full{false};
+
+    uint32_t count() const;
+  };
+
+  // Returns the index of the first chunk with key >= 'key'.
+  size_t lowerBound(uint64_t key) const;
+
+  // Returns the chunk for 'key', creating it if needed.
+  Chunk& chunkFor(uint64_t key);
+
+  // Calls 'func(chunk, chunkBegin, lo, hi)' for each chunk with positions in
+  // [begin, end), where [lo, hi) is the range of low bits of the chunk in
+  // [begin, end) and 'chunkBegin' is the first position of the chunk. Stops
+  // and returns false if 'func' returns false.
+  template <typename Func>
+  bool forEachChunk(uint64_t begin, uint64_t end, Func func) const;
+
+  // Chunks sorted on key after seal().
+  std::vector<Chunk> chunks_;
+  // Maps the key of a chunk to its index in 'chunks_' before seal().
+  folly::F14FastMap<uint64_t, size_t> chunkIndex_;
+  bool sealed_{false};
+  uint64_t numDeleted_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
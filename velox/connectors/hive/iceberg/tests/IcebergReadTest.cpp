@@ -864,6 +864,75 @@ TEST_F(HiveIcebergTest, partitionColumnsFromHive) {
   AssertQueryBuilder(plan).splits(icebergSplits).assertResults(expectedVectors);
 }
 
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto data = makeRowVector(
+      rowType->names(),
+      {
+          makeNullableFlatVector<int64_t>({1, 2, 3, std::nullopt, 5, 6}),
+          makeNullableFlatVector<std::string>(
+              {"a", "b", std::nullopt, "d", "e", "f"}),
+      });
+  auto dataFilePath = TempFilePath::create();
+  writeToFile(dataFilePath->getPath(), data);
+
+  std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths;
+  auto makeDeleteFile = [&](const RowVectorPtr& deletes,
+                            std::vector<int32_t> fieldIds) {
+    auto deleteFilePath = TempFilePath::create();
+    writeToFile(deleteFilePath->getPath(), deletes);
+    deleteFilePaths.push_back(deleteFilePath);
+    return IcebergDeleteFile(
+        FileContent::kEqualityDeletes,
+        deleteFilePath->getPath(),
+        fileFomat_,
+        deletes->size(),
+        testing::internal::GetFileSize(
+            std::fopen(deleteFilePath->getPath().c_str(), "r")),
+        std::move(fieldIds));
+  };
+
+  // Single integer key. The null key deletes the row with a null c0.
+  auto integerDeletes = makeDeleteFile(
+      makeRowVector(
+          {"c0"}, {makeNullableFlatVector<int64_t>({2, 5, std::nullopt, 7})}),
+      {1});
+  // Multi-column key. Only rows matching all columns are deleted.
+  auto compositeDeletes = makeDeleteFile(
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatVector<int64_t>({3, 6, 1}),
+           makeNullableFlatVector<std::string>({std::nullopt, "x", "a"})}),
+      {1, 2});
+
+  auto plan = PlanBuilder().tableScan(rowType).planNode();
+  AssertQueryBuilder(plan)
+      .splits(makeIcebergSplits(dataFilePath->getPath(), {integerDeletes}))
+      .assertResults(makeRowVector(
+          rowType->names(),
+          {
+              makeFlatVector<int64_t>({1, 3, 6}),
+              makeNullableFlatVector<std::string>({"a", std::nullopt, "f"}),
+          }));
+  AssertQueryBuilder(plan)
+      .splits(makeIcebergSplits(
+          dataFilePath->getPath(), {integerDeletes, compositeDeletes}))
+      .assertResults(makeRowVector(
+          rowType->names(),
+          {
+              makeFlatVector<int64_t>({6}),
+              makeFlatVector<std::string>({"f"}),
+          }));
+
+  // The equality columns must be read by the scan.
+  auto c1Plan = PlanBuilder().tableScan(ROW({"c1"}, {VARCHAR()})).planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(c1Plan)
+          .splits(makeIcebergSplits(dataFilePath->getPath(), {integerDeletes}))
+          .copyResults(pool()),
+      "Iceberg equality delete column c0 must be read from the table");
+}
+
 #ifdef VELOX_ENABLE_PARQUET
 TEST_F(HiveIcebergTest, positionalDeleteFileWithRowGroupFilter) {
   // This file contains three row groups, each with about 100 rows.
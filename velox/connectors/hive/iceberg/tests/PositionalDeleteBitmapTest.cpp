@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/PositionalDeleteBitmap.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+
+// Returns the bits 'fill' sets for [begin, end).
+std::vector<uint64_t>
+fillBits(const PositionalDeleteBitmap& bitmap, uint64_t begin, uint64_t end) {
+  std::vector<uint64_t> bits(bits::nwords(end - begin));
+  bitmap.fill(begin, end, bits.data());
+  return bits;
+}
+
+TEST(PositionalDeleteBitmapTest, sparse) {
+  PositionalDeleteBitmap bitmap;
+  // Out of order and duplicate positions in two chunks.
+  for (auto position : {70'000, 5, 3, 70'000, 100}) {
+    bitmap.add(position);
+  }
+  bitmap.seal();
+  EXPECT_EQ(bitmap.numDeleted(), 4);
+
+  EXPECT_TRUE(bitmap.noneDeleted(6, 100));
+  EXPECT_FALSE(bitmap.noneDeleted(6, 101));
+  EXPECT_TRUE(bitmap.noneDeleted(101, 70'000));
+  EXPECT_FALSE(bitmap.noneDeleted(69'999, 70'001));
+  EXPECT_TRUE(bitmap.allDeleted(70'000, 70'001));
+  EXPECT_FALSE(bitmap.allDeleted(3, 6));
+
+  auto bits = fillBits(bitmap, 2, 102);
+  std::vector<int32_t> deleted;
+  bits::forEachSetBit(bits.data(), 0, 100, [&](auto row) {
+    deleted.push_back(row);
+  });
+  EXPECT_EQ(deleted, std::vector<int32_t>({1, 3, 98}));
+
+  VELOX_ASSERT_THROW(bitmap.add(1), "sealed");
+}
+
+TEST(PositionalDeleteBitmapTest, denseAndFull) {
+  PositionalDeleteBitmap bitmap;
+  constexpr uint64_t kChunkSize = 1 << 16;
+  // Chunk 1 is fully deleted. Chunk 2 has every other position deleted, so it
+  // is kept as a bitmap.
+  for (uint64_t position = kChunkSize; position < 2 * kChunkSize; ++position) {
+    bitmap.add(position);
+  }
+  for (uint64_t position = 2 * kChunkSize; position < 3 * kChunkSize;
+       position += 2) {
+    bitmap.add(position);
+  }
+  bitmap.seal();
+  EXPECT_EQ(bitmap.numDeleted(), kChunkSize + kChunkSize / 2);
+  // The full chunk takes no space for its positions.
+  EXPECT_LT(bitmap.sizeBytes(), kChunkSize / 8 + 1'024);
+
+  EXPECT_TRUE(bitmap.noneDeleted(0, kChunkSize));
+  EXPECT_TRUE(bitmap.allDeleted(kChunkSize, 2 * kChunkSize));
+  EXPECT_TRUE(bitmap.allDeleted(kChunkSize + 10, 2 * kChunkSize + 1));
+  EXPECT_FALSE(bitmap.allDeleted(kChunkSize - 1, 2 * kChunkSize));
+  EXPECT_FALSE(bitmap.allDeleted(kChunkSize, 2 * kChunkSize + 2));
+  EXPECT_TRUE(bitmap.noneDeleted(2 * kChunkSize + 1, 2 * kChunkSize + 2));
+
+  // A range over the end of the full chunk and the start of the bitmap.
+  const uint64_t begin = 2 * kChunkSize - 100;
+  auto bits = fillBits(bitmap, begin, begin + 200);
+  for (auto row = 0; row < 200; ++row) {
+    const bool expected = row < 100 || (row - 100) % 2 == 0;
+    EXPECT_EQ(bits::isBitSet(bits.data(), row), expected) << row;
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::connector::hive::iceberg
@@ -47,6 +47,17 @@ class HdfsFileSystem::Impl {
       driver_->BuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
     }
     driver_->BuilderSetForceNewInstance(builder);
+    // NOTE: the builder keeps the pointers to the config strings until it
+    // connects.
+    const auto clientConfigs = HdfsFileSystem::clientConfigs(config);
+    for (const auto& [key, value] : clientConfigs) {
+      VELOX_CHECK_EQ(
+          driver_->BuilderConfSetStr(builder, key.c_str(), value.c_str()),
+          0,
+          "Unable to set HDFS client config {}={}",
+          key,
+          value);
+    }
     hdfsClient_ = driver_->BuilderConnect(builder);
     VELOX_CHECK_NOT_NULL(
         hdfsClient_,
@@ -132,6 +143,35 @@ void HdfsFileSystem::close() {
   impl_->close();
 }
 
+std::unordered_map<std::string, std::string> HdfsFileSystem::clientConfigs(
+    const config::ConfigBase* config) {
+  std::unordered_map<std::string, std::string> configs;
+  if (config == nullptr ||
+      !config->get<bool>(kShortCircuitReadEnabled, false)) {
+    return configs;
+  }
+  const auto domainSocketPath =
+      config->get<std::string>(kShortCircuitReadDomainSocketPath);
+  VELOX_USER_CHECK(
+      domainSocketPath.has_value() && !domainSocketPath->empty(),
+      "{} is required by the HDFS short-circuit local reads",
+      kShortCircuitReadDomainSocketPath);
+  configs.emplace("dfs.client.read.shortcircuit", "true");
+  configs.emplace("dfs.domain.socket.path", domainSocketPath.value());
+  configs.emplace(
+      "dfs.client.read.shortcircuit.streams.cache.size",
+      std::to_string(config->get<uint32_t>(kShortCircuitReadFdCacheSize, 256)));
+  configs.emplace(
+      "dfs.client.read.shortcircuit.streams.cache.expiry.ms",
+      std::to_string(
+          config->get<uint64_t>(kShortCircuitReadFdCacheExpiryMs, 300'000)));
+  configs.emplace(
+      "dfs.client.read.shortcircuit.skip.checksum",
+      config->get<bool>(kShortCircuitReadSkipChecksum, false) ? "true"
+                                                              : "false");
+  return configs;
+}
+
 bool HdfsFileSystem::isHdfsFile(const std::string_view filePath) {
   return (filePath.find(kScheme) == 0) || (filePath.find(kViewfsScheme) == 0);
 }
@@ -90,6 +90,33 @@ class HdfsFileSystem : public FileSystem {
       const std::string_view filePath,
       const config::ConfigBase* config);
 
+  /// Returns the HDFS client configurations to set on the client builder
+  /// from the velox 'config', e.g. the short-circuit local read settings.
+  static std::unordered_map<std::string, std::string> clientConfigs(
+      const config::ConfigBase* config);
+
+  /// Enables the short-circuit local reads. The HDFS client then reads the
+  /// block replicas stored on the local DataNode directly from the block
+  /// files, whose descriptors the DataNode passes over the domain socket at
+  /// kShortCircuitReadDomainSocketPath, instead of streaming them through the
+  /// DataNode over TCP. The reads of remote replicas are not affected.
+  static constexpr const char* kShortCircuitReadEnabled =
+      "hive.hdfs.short-circuit-read.enabled";
+  /// The path of the DataNode domain socket. Must match the DataNode
+  /// dfs.domain.socket.path.
+  static constexpr const char* kShortCircuitReadDomainSocketPath =
+      "hive.hdfs.short-circuit-read.domain-socket-path";
+  /// The number of local block file descriptors cached by the client.
+  static constexpr const char* kShortCircuitReadFdCacheSize =
+      "hive.hdfs.short-circuit-read.fd-cache-size";
+  /// The time in milliseconds a cached block file descriptor stays open
+  /// unused.
+  static constexpr const char* kShortCircuitReadFdCacheExpiryMs =
+      "hive.hdfs.short-circuit-read.fd-cache-expiry-ms";
+  /// Skips the checksum verification of the local block reads.
+  static constexpr const char* kShortCircuitReadSkipChecksum =
+      "hive.hdfs.short-circuit-read.skip-checksum";
+
   static std::string_view kScheme;
 
   static std::string_view kViewfsScheme;
@@ -307,6 +307,70 @@ TEST_F(HdfsFileSystemTest, fallbackToUseConfig) {
   readData(readFile.get());
 }
 
+TEST_F(HdfsFileSystemTest, shortCircuitReadConfigs) {
+  using filesystems::HdfsFileSystem;
+  ASSERT_TRUE(HdfsFileSystem::clientConfigs(nullptr).empty());
+  {
+    config::ConfigBase config(std::unordered_map<std::string, std::string>{});
+    ASSERT_TRUE(HdfsFileSystem::clientConfigs(&config).empty());
+  }
+  {
+    config::ConfigBase config(
+        {{HdfsFileSystem::kShortCircuitReadEnabled, "true"}});
+    VELOX_ASSERT_USER_THROW(
+        HdfsFileSystem::clientConfigs(&config),
+        "hive.hdfs.short-circuit-read.domain-socket-path is required");
+  }
+  {
+    config::ConfigBase config(
+        {{HdfsFileSystem::kShortCircuitReadEnabled, "true"},
+         {HdfsFileSystem::kShortCircuitReadDomainSocketPath,
+          "/var/lib/hadoop-hdfs/dn_socket"}});
+    const auto configs = HdfsFileSystem::clientConfigs(&config);
+    ASSERT_EQ(configs.size(), 5);
+    ASSERT_EQ(configs.at("dfs.client.read.shortcircuit"), "true");
+    ASSERT_EQ(
+        configs.at("dfs.domain.socket.path"), "/var/lib/hadoop-hdfs/dn_socket");
+    ASSERT_EQ(
+        configs.at("dfs.client.read.shortcircuit.streams.cache.size"), "256");
+    ASSERT_EQ(
+        configs.at("dfs.client.read.shortcircuit.streams.cache.expiry.ms"),
+        "300000");
+    ASSERT_EQ(
+        configs.at("dfs.client.read.shortcircuit.skip.checksum"), "false");
+  }
+  {
+    config::ConfigBase config(
+        {{HdfsFileSystem::kShortCircuitReadEnabled, "true"},
+         {HdfsFileSystem::kShortCircuitReadDomainSocketPath, "/tmp/dn_socket"},
+         {HdfsFileSystem::kShortCircuitReadFdCacheSize, "1024"},
+         {HdfsFileSystem::kShortCircuitReadFdCacheExpiryMs, "60000"},
+         {HdfsFileSystem::kShortCircuitReadSkipChecksum, "true"}});
+    const auto configs = HdfsFileSystem::clientConfigs(&config);
+    ASSERT_EQ(
+        configs.at("dfs.client.read.shortcircuit.streams.cache.size"), "1024");
+    ASSERT_EQ(
+        configs.at("dfs.client.read.shortcircuit.streams.cache.expiry.ms"),
+        "60000");
+    ASSERT_EQ(configs.at("dfs.client.read.shortcircuit.skip.checksum"), "true");
+  }
+
+  // The mini cluster has no domain socket, so the client falls back to the
+  // remote reads.
+  auto config = std::make_shared<const config::ConfigBase>(
+      std::unordered_map<std::string, std::string>{
+          {"hive.hdfs.host", std::string(miniCluster->host())},
+          {"hive.hdfs.port", std::string(miniCluster->nameNodePort())},
+          {HdfsFileSystem::kShortCircuitReadEnabled, "true"},
+          {HdfsFileSystem::kShortCircuitReadDomainSocketPath,
+           "/tmp/velox_not_exist_dn_socket"}});
+  HdfsFileSystem hdfsFileSystem(
+      config,
+      HdfsFileSystem::getServiceEndpoint(kSimpleDestinationPath, config.get()));
+  auto readFile = hdfsFileSystem.openFileForRead(fullDestinationPath_);
+  readData(readFile.get());
+}
+
 TEST_F(HdfsFileSystemTest, oneFsInstanceForOneEndpoint) {
   auto hdfsFileSystem1 =
       filesystems::getFileSystem(fullDestinationPath_, nullptr);
@@ -74,6 +74,14 @@ S3Config::S3Config(
       properties->get<std::string>(kS3PayloadSigningPolicy, "Never");
 }
 
+uint64_t S3Config::readPartSize() const {
+  const auto partSize = config::toCapacity(
+      config_.find(Keys::kReadPartSize)->second.value(),
+      config::CapacityUnit::BYTE);
+  VELOX_USER_CHECK_GT(partSize, 0, "S3 read part size must be positive");
+  return partSize;
+}
+
 std::optional<std::string> S3Config::endpointRegion() const {
   auto region = config_.find(Keys::kEndpointRegion)->second;
   if (!region.has_value()) {
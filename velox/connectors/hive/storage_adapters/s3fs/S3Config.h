@@ -76,6 +76,8 @@ class S3Config {
     kRetryMode,
     kUseProxyFromEnv,
     kCredentialsProvider,
+    kReadPartSize,
+    kReadMaxConcurrency,
     kEnd
   };
 
@@ -114,6 +116,9 @@ class S3Config {
              std::make_pair("use-proxy-from-env", "false")},
             {Keys::kCredentialsProvider,
              std::make_pair("aws-credentials-provider", std::nullopt)},
+            {Keys::kReadPartSize, std::make_pair("read-part-size", "8MB")},
+            {Keys::kReadMaxConcurrency,
+             std::make_pair("read-max-concurrency", "0")},
         };
     return config;
   }
@@ -243,6 +248,16 @@ class S3Config {
     return config_.find(Keys::kCredentialsProvider)->second;
   }
 
+  /// Size in bytes of the ranged GETs a large read is split into.
+  uint64_t readPartSize() const;
+
+  /// Maximum number of ranged GETs in flight per file system for parallel
+  /// and asynchronous reads. 0 disables both and reads on the calling thread.
+  uint32_t readMaxConcurrency() const {
+    auto value = config_.find(Keys::kReadMaxConcurrency)->second.value();
+    return folly::to<uint32_t>(value);
+  }
+
  private:
   std::unordered_map<Keys, std::optional<std::string>> config_;
   std::string payloadSigningPolicy_;
@@ -26,6 +26,7 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -302,10 +303,22 @@ class S3FileSystem::Impl {
 
     client_ = std::make_shared<Aws::S3::S3Client>(
         credentialsProvider, nullptr /* endpointProvider */, clientConfig);
+
+    // Ranged GETs block on the network, so they run on a dedicated pool
+    // sized to the configured concurrency.
+    if (s3Config.readMaxConcurrency() > 0) {
+      readPartSize_ = s3Config.readPartSize();
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          s3Config.readMaxConcurrency(),
+          std::make_shared<folly::NamedThreadFactory>("S3Read"));
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    if (readExecutor_) {
+      readExecutor_->join();
+    }
     client_.reset();
     --fileSystemCount;
   }
@@ -439,6 +452,15 @@ class S3FileSystem::Impl {
     return client_.get();
   }
 
+  // Executor for parallel ranged GETs. Null if parallel reads are disabled.
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
+  uint64_t readPartSize() const {
+    return readPartSize_;
+  }
+
   std::string getLogLevelName() const {
     return getAwsInstance()->getLogLevelName();
   }
@@ -449,6 +471,8 @@ class S3FileSystem::Impl {
 
  private:
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+  uint64_t readPartSize_{0};
 };
 
 S3FileSystem::S3FileSystem(
@@ -471,7 +495,8 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file = std::make_unique<S3ReadFile>(path, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      path, impl_->s3Client(), impl_->readExecutor(), impl_->readPartSize());
   s3file->initialize(options);
   return s3file;
 }
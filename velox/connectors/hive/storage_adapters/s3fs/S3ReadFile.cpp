@@ -15,10 +15,13 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3ReadFile.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Counters.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 
+#include <folly/futures/Future.h>
+
 #include <aws/core/Aws.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/GetObjectRequest.h>
@@ -38,10 +41,17 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
 
 } // namespace
 
-class S3ReadFile ::Impl {
+class S3ReadFile ::Impl : public std::enable_shared_from_this<Impl> {
  public:
-  explicit Impl(std::string_view path, Aws::S3::S3Client* client)
-      : client_(client) {
+  Impl(
+      std::string_view path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor,
+      uint64_t readPartSize)
+      : client_(client), executor_(executor), readPartSize_(readPartSize) {
+    VELOX_CHECK(
+        executor_ == nullptr || readPartSize_ > 0,
+        "S3 read part size must be positive");
     getBucketAndKeyFromPath(path, bucket_, key_);
   }
 
@@ -80,7 +90,7 @@ class S3ReadFile ::Impl {
       uint64_t length,
       void* buffer,
       const FileIoContext& context) const {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    readRange(offset, length, static_cast<char*>(buffer));
     return {static_cast<char*>(buffer), length};
   }
 
@@ -88,7 +98,7 @@ class S3ReadFile ::Impl {
   pread(uint64_t offset, uint64_t length, const FileIoContext& context) const {
     std::string result(length, 0);
     char* position = result.data();
-    preadInternal(offset, length, position);
+    readRange(offset, length, position);
     return result;
   }
 
@@ -102,23 +112,35 @@ class S3ReadFile ::Impl {
     // multi-range. AWS S3 also charges by number of read requests and not size.
     // The idea here is to use a single read spanning all the ranges and then
     // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
-    }
+    const auto length = totalLength(buffers);
     // TODO: allocate from a memory pool
     std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
-    }
+    readRange(offset, length, static_cast<char*>(result.data()));
+    copyToBuffers(result, buffers);
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      const FileIoContext& context) const {
+    VELOX_CHECK(hasPreadvAsync());
+    const auto length = totalLength(buffers);
+    auto result = std::make_shared<std::string>(length, 0);
+    return readParts(offset, length, result->data())
+        .deferValue([self = shared_from_this(),
+                     result,
+                     buffers,
+                     length](auto&& /* unused */) {
+          self->copyToBuffers(*result, buffers);
+          return static_cast<uint64_t>(length);
+        });
+  }
+
+  bool hasPreadvAsync() const {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const {
     return length_;
   }
@@ -138,6 +160,66 @@ class S3ReadFile ::Impl {
   }
 
  private:
+  static size_t totalLength(const std::vector<folly::Range<char*>>& buffers) {
+    size_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    return length;
+  }
+
+  // Copies 'data' read for a span of 'buffers' into the non-gap ranges.
+  static void copyToBuffers(
+      const std::string& data,
+      const std::vector<folly::Range<char*>>& buffers) {
+    size_t dataOffset = 0;
+    for (auto range : buffers) {
+      if (range.data()) {
+        memcpy(range.data(), &(data.data()[dataOffset]), range.size());
+      }
+      dataOffset += range.size();
+    }
+  }
+
+  // Reads 'length' bytes at 'offset' into 'position'. Reads larger than the
+  // part size are split into parallel ranged GETs on 'executor_' while the
+  // calling thread waits.
+  void readRange(uint64_t offset, uint64_t length, char* position) const {
+    if (executor_ == nullptr || length <= readPartSize_) {
+      preadInternal(offset, length, position);
+      return;
+    }
+    readParts(offset, length, position).get();
+  }
+
+  // Issues one ranged GET per part of 'readPartSize_' bytes on 'executor_'.
+  // The returned future fails with the first failing part. The caller keeps
+  // 'position' alive until the future completes.
+  folly::SemiFuture<folly::Unit>
+  readParts(uint64_t offset, uint64_t length, char* position) const {
+    std::vector<folly::SemiFuture<folly::Unit>> parts;
+    parts.reserve(bits::divRoundUp(length, readPartSize_));
+    for (uint64_t partOffset = 0; partOffset < length;
+         partOffset += readPartSize_) {
+      const auto partLength = std::min(readPartSize_, length - partOffset);
+      auto part = folly::via(
+          executor_,
+          [self = shared_from_this(),
+           partStart = offset + partOffset,
+           partLength,
+           partPosition = position + partOffset]() {
+            self->preadInternal(partStart, partLength, partPosition);
+          });
+      parts.push_back(std::move(part).semi());
+    }
+    return folly::collectAll(std::move(parts))
+        .deferValue([](std::vector<folly::Try<folly::Unit>>&& results) {
+          for (auto& result : results) {
+            result.throwUnlessValue();
+          }
+        });
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
@@ -163,14 +245,20 @@ class S3ReadFile ::Impl {
     VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
   }
 
-  Aws::S3::S3Client* client_;
+  Aws::S3::S3Client* const client_;
+  folly::Executor* const executor_;
+  const uint64_t readPartSize_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
 };
 
-S3ReadFile::S3ReadFile(std::string_view path, Aws::S3::S3Client* client) {
-  impl_ = std::make_shared<Impl>(path, client);
+S3ReadFile::S3ReadFile(
+    std::string_view path,
+    Aws::S3::S3Client* client,
+    folly::Executor* executor,
+    uint64_t readPartSize) {
+  impl_ = std::make_shared<Impl>(path, client, executor, readPartSize);
 }
 
 S3ReadFile::~S3ReadFile() = default;
@@ -201,6 +289,20 @@ uint64_t S3ReadFile::preadv(
   return impl_->preadv(offset, buffers, context);
 }
 
+folly::SemiFuture<uint64_t> S3ReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    const FileIoContext& context) const {
+  if (!impl_->hasPreadvAsync()) {
+    return ReadFile::preadvAsync(offset, buffers, context);
+  }
+  return impl_->preadvAsync(offset, buffers, context);
+}
+
+bool S3ReadFile::hasPreadvAsync() const {
+  return impl_->hasPreadvAsync();
+}
+
 uint64_t S3ReadFile::size() const {
   return impl_->size();
 }
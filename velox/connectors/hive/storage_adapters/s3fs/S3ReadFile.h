@@ -22,12 +22,23 @@ namespace Aws::S3 {
 class S3Client;
 }
 
+namespace folly {
+class Executor;
+}
+
 namespace facebook::velox::filesystems {
 
 /// Implementation of s3 read file.
 class S3ReadFile : public ReadFile {
  public:
-  S3ReadFile(std::string_view path, Aws::S3::S3Client* client);
+  /// If 'executor' is set, reads larger than 'readPartSize' are split into
+  /// ranged GETs of 'readPartSize' bytes that run in parallel on 'executor',
+  /// and preadvAsync() is asynchronous.
+  S3ReadFile(
+      std::string_view path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor = nullptr,
+      uint64_t readPartSize = 0);
 
   ~S3ReadFile() override;
 
@@ -47,6 +58,13 @@ class S3ReadFile : public ReadFile {
       const std::vector<folly::Range<char*>>& buffers,
       const FileIoContext& context = {}) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      const FileIoContext& context = {}) const override;
+
+  bool hasPreadvAsync() const override;
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -37,6 +37,8 @@ TEST(S3ConfigTest, defaultConfig) {
   ASSERT_EQ(s3Config.payloadSigningPolicy(), "Never");
   ASSERT_EQ(s3Config.cacheKey("foo", config), "foo");
   ASSERT_EQ(s3Config.bucket(), "");
+  ASSERT_EQ(s3Config.readPartSize(), 8 << 20);
+  ASSERT_EQ(s3Config.readMaxConcurrency(), 0);
 }
 
 TEST(S3ConfigTest, overrideConfig) {
@@ -53,7 +55,9 @@ TEST(S3ConfigTest, overrideConfig) {
       {S3Config::baseConfigKey(S3Config::Keys::kIamRole), "iam"},
       {S3Config::baseConfigKey(S3Config::Keys::kIamRoleSessionName), "velox"},
       {S3Config::baseConfigKey(S3Config::Keys::kCredentialsProvider),
-       "my-credentials-provider"}};
+       "my-credentials-provider"},
+      {S3Config::baseConfigKey(S3Config::Keys::kReadPartSize), "16MB"},
+      {S3Config::baseConfigKey(S3Config::Keys::kReadMaxConcurrency), "32"}};
   auto configBase =
       std::make_shared<config::ConfigBase>(std::move(configFromFile));
   auto s3Config = S3Config("bucket", configBase);
@@ -71,6 +75,8 @@ TEST(S3ConfigTest, overrideConfig) {
   ASSERT_EQ(s3Config.cacheKey("bar", configBase), "endpoint-bar");
   ASSERT_EQ(s3Config.bucket(), "bucket");
   ASSERT_EQ(s3Config.credentialsProvider(), "my-credentials-provider");
+  ASSERT_EQ(s3Config.readPartSize(), 16 << 20);
+  ASSERT_EQ(s3Config.readMaxConcurrency(), 32);
 }
 
 TEST(S3ConfigTest, overrideBucketConfig) {
@@ -76,6 +76,37 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRead) {
+  const char* bucketName = "data";
+  const char* file = "parallel.txt";
+  const auto filename = localPath(bucketName) + "/" + file;
+  const auto s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Split reads into 64KB parts so the 1MB reads fan out to several GETs.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-part-size", "64kB"},
+       {"hive.s3.read-max-concurrency", "4"}});
+  filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  char head[12];
+  char tail[7];
+  const uint64_t gap = 15 + kOneMB - sizeof(head) - sizeof(tail);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)gap),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     std::unordered_map<std::string, std::string> config(
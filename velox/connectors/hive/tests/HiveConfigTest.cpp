@@ -33,6 +33,8 @@ TEST(HiveConfigTest, defaultConfig) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kError);
   ASSERT_EQ(hiveConfig.maxPartitionsPerWriters(emptySession.get()), 128);
+  ASSERT_EQ(hiveConfig.clusteredWritePartitionThreshold(emptySession.get()), 0);
+  ASSERT_FALSE(hiveConfig.adaptiveIoPlanningEnabled(emptySession.get()));
   ASSERT_EQ(hiveConfig.immutablePartitions(), false);
   ASSERT_EQ(hiveConfig.gcsEndpoint(), "");
   ASSERT_EQ(hiveConfig.gcsCredentialsPath(), "");
@@ -55,6 +57,12 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_TRUE(hiveConfig.allowNullPartitionKeys(emptySession.get()));
   ASSERT_EQ(hiveConfig.loadQuantum(emptySession.get()), 8 << 20);
   ASSERT_FALSE(hiveConfig.preserveFlatMapsInMemory(emptySession.get()));
+  ASSERT_FALSE(hiveConfig.filterResultCacheEnabled(emptySession.get()));
+  ASSERT_EQ(hiveConfig.decodedVectorCacheCapacityBytes(), 0);
+  ASSERT_FALSE(hiveConfig.decodedVectorCacheEnabled(emptySession.get()));
+  ASSERT_FALSE(hiveConfig.hedgedReadEnabled());
+  ASSERT_EQ(hiveConfig.hedgedReadLatencyPercentile(), 0.95);
+  ASSERT_EQ(hiveConfig.hedgedReadMaxPerSecond(), 10);
 }
 
 TEST(HiveConfigTest, overrideConfig) {
@@ -78,7 +86,10 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kReadStatsBasedFilterReorderDisabled, "true"},
       {HiveConfig::kLoadQuantum, std::to_string(4 << 20)},
       {HiveConfig::kMaxBucketCount, std::to_string(100'000)},
-      {HiveConfig::kPreserveFlatMapsInMemory, "true"}};
+      {HiveConfig::kPreserveFlatMapsInMemory, "true"},
+      {HiveConfig::kHedgedReadEnabled, "true"},
+      {HiveConfig::kHedgedReadLatencyPercentile, "0.99"},
+      {HiveConfig::kHedgedReadMaxPerSecond, "100"}};
   HiveConfig hiveConfig(
       std::make_shared<config::ConfigBase>(std::move(configFromFile)));
   auto emptySession = std::make_shared<config::ConfigBase>(
@@ -110,6 +121,9 @@ TEST(HiveConfigTest, overrideConfig) {
   ASSERT_EQ(hiveConfig.loadQuantum(emptySession.get()), 4 << 20);
   ASSERT_EQ(hiveConfig.maxBucketCount(emptySession.get()), 100'000);
   ASSERT_TRUE(hiveConfig.preserveFlatMapsInMemory(emptySession.get()));
+  ASSERT_TRUE(hiveConfig.hedgedReadEnabled());
+  ASSERT_EQ(hiveConfig.hedgedReadLatencyPercentile(), 0.99);
+  ASSERT_EQ(hiveConfig.hedgedReadMaxPerSecond(), 100);
 }
 
 TEST(HiveConfigTest, overrideSession) {
@@ -130,6 +144,10 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kReadStatsBasedFilterReorderDisabledSession, "true"},
       {HiveConfig::kLoadQuantumSession, std::to_string(4 << 20)},
       {HiveConfig::kPreserveFlatMapsInMemorySession, "true"},
+      {HiveConfig::kFilterResultCacheEnabledSession, "true"},
+      {HiveConfig::kDecodedVectorCacheEnabledSession, "true"},
+      {HiveConfig::kClusteredWritePartitionThresholdSession, "16"},
+      {HiveConfig::kAdaptiveIoPlanningEnabledSession, "true"},
   };
   const auto session =
       std::make_unique<config::ConfigBase>(std::move(sessionOverride));
@@ -138,6 +156,8 @@ TEST(HiveConfigTest, overrideSession) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kOverwrite);
   ASSERT_EQ(hiveConfig.maxPartitionsPerWriters(session.get()), 128);
+  ASSERT_EQ(hiveConfig.clusteredWritePartitionThreshold(session.get()), 16);
+  ASSERT_TRUE(hiveConfig.adaptiveIoPlanningEnabled(session.get()));
   ASSERT_FALSE(hiveConfig.immutablePartitions());
   ASSERT_EQ(hiveConfig.gcsEndpoint(), "");
   ASSERT_EQ(hiveConfig.gcsCredentialsPath(), "");
@@ -157,4 +177,6 @@ TEST(HiveConfigTest, overrideSession) {
   ASSERT_TRUE(hiveConfig.readStatsBasedFilterReorderDisabled(session.get()));
   ASSERT_EQ(hiveConfig.loadQuantum(session.get()), 4 << 20);
   ASSERT_TRUE(hiveConfig.preserveFlatMapsInMemory(session.get()));
+  ASSERT_TRUE(hiveConfig.filterResultCacheEnabled(session.get()));
+  ASSERT_TRUE(hiveConfig.decodedVectorCacheEnabled(session.get()));
 }
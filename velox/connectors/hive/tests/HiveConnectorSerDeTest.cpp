@@ -135,6 +135,25 @@ TEST_F(HiveConnectorSerDeTest, hiveTableHandle) {
       true,
       {{dwio::common::TableParameter::kSkipHeaderLineCount, "1"}});
   testSerde(*tableHandle);
+
+  auto aggregateHandle = std::make_shared<HiveTableHandle>(
+      exec::test::kHiveConnectorId,
+      "hive_table",
+      true,
+      common::test::SubfieldFiltersBuilder().add("c1", lessThan(10)).build(),
+      parseExpr("c1 > c4", rowType),
+      rowType,
+      std::unordered_map<std::string, std::string>{},
+      std::vector<HiveColumnHandlePtr>{},
+      1.0,
+      std::vector<HiveAggregate>{
+          {HiveAggregate::Kind::kCount, ""},
+          {HiveAggregate::Kind::kMax, "c1"},
+          {HiveAggregate::Kind::kNullCount, "c4"}});
+  ASSERT_NE(
+      aggregateHandle->toString().find("aggregates: [Count(*), Max(c1)"),
+      std::string::npos);
+  testSerde(*aggregateHandle);
 }
 
 TEST_F(HiveConnectorSerDeTest, hiveColumnHandle) {
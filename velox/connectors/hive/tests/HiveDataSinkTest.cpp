@@ -1592,6 +1592,59 @@ TEST_F(HiveDataSinkTest, fileRotationFileInfoConsistency) {
   verifyWrittenData(outputDirectory->getPath(), stats.numWrittenFiles);
 }
 
+TEST_F(HiveDataSinkTest, fileRotationAsyncClose) {
+  const auto outputDirectory = TempDirectoryPath::create();
+
+  std::unordered_map<std::string, std::string> connectorConfig;
+  connectorConfig.emplace("max-target-file-size", "500KB");
+  connectorConfig.emplace("hive.orc.writer.stripe-max-size", "128KB");
+  connectorConfig.emplace("async-file-close-enabled", "true");
+  connectorConfig_ = std::make_shared<HiveConfig>(
+      std::make_shared<config::ConfigBase>(std::move(connectorConfig)));
+
+  auto ioExecutor = std::make_unique<folly::IOThreadPoolExecutor>(2);
+  auto dataSink = std::make_shared<HiveDataSink>(
+      rowType_,
+      createHiveInsertTableHandle(rowType_, outputDirectory->getPath()),
+      connectorQueryCtx_.get(),
+      CommitStrategy::kNoCommit,
+      connectorConfig_,
+      ioExecutor.get());
+
+  const auto vectors = createVectors(500, 50);
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+
+  ASSERT_TRUE(dataSink->finish());
+  const auto partitions = dataSink->close();
+  const auto stats = dataSink->stats();
+  ASSERT_GT(stats.numWrittenFiles, 1);
+  ASSERT_EQ(partitions.size(), 1);
+
+  // The sizes of the files closed in the background match the files on disk.
+  const auto partitionJson = folly::parseJson(partitions[0]);
+  const auto& fileWriteInfos = partitionJson["fileWriteInfos"];
+  ASSERT_EQ(fileWriteInfos.size(), stats.numWrittenFiles);
+  uint64_t totalFileSize{0};
+  for (const auto& fileWriteInfo : fileWriteInfos) {
+    const auto filePath =
+        fs::path(outputDirectory->getPath()) /
+        fileWriteInfo["writeFileName"].asString();
+    const auto fileSize =
+        static_cast<uint64_t>(fileWriteInfo["fileSize"].asInt());
+    ASSERT_EQ(fs::file_size(filePath), fileSize);
+    totalFileSize += fileSize;
+  }
+  ASSERT_EQ(
+      static_cast<uint64_t>(partitionJson["onDiskDataSizeInBytes"].asInt()),
+      totalFileSize);
+  ASSERT_EQ(stats.numWrittenBytes, totalFileSize);
+
+  createDuckDbTable(vectors);
+  verifyWrittenData(outputDirectory->getPath(), stats.numWrittenFiles);
+}
+
 TEST_F(HiveDataSinkTest, fileRotationStatsProgressDuringWrite) {
   // Tests that stats are correctly reported during writing (not just at close).
   // Verifies stats grow monotonically even when rotation happens mid-write.
@@ -1858,6 +1911,60 @@ TEST_F(HiveDataSinkTest, lazyVectorForParquet) {
 
 // Test to verify that each writer has its own nonReclaimableSection
 // pointer when writerOptions is shared.
+TEST_F(HiveDataSinkTest, clusteredWrite) {
+  const auto outputDirectory = TempDirectoryPath::create();
+
+  // The open writer limit is below the number of partitions which is only
+  // allowed in the clustered write mode.
+  std::unordered_map<std::string, std::string> connectorConfig;
+  connectorConfig.emplace(HiveConfig::kMaxPartitionsPerWriters, "8");
+  connectorConfig.emplace(HiveConfig::kClusteredWritePartitionThreshold, "4");
+  connectorConfig_ = std::make_shared<HiveConfig>(
+      std::make_shared<config::ConfigBase>(std::move(connectorConfig)));
+
+  const auto partitionedRowType =
+      ROW({"c0", "c1", "p0"}, {BIGINT(), VARCHAR(), INTEGER()});
+  auto dataSink = createDataSink(
+      partitionedRowType,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {"p0"});
+
+  // The first batches only cover two partitions and are written directly.
+  // The following ones cover all the partitions and switch the data sink to
+  // the clustered write mode.
+  const int32_t numPartitions = 20;
+  const int32_t numBatches = 10;
+  const vector_size_t batchSize = 1'000;
+  for (int32_t i = 0; i < numBatches; ++i) {
+    const auto partitionMod = i < 2 ? 2 : numPartitions;
+    dataSink->appendData(makeRowVector(
+        {makeFlatVector<int64_t>(batchSize, [](auto row) { return row; }),
+         makeFlatVector<std::string>(
+             batchSize, [](auto row) { return std::to_string(row); }),
+         makeFlatVector<int32_t>(batchSize, [&](auto row) {
+           return row % partitionMod;
+         })}));
+  }
+
+  while (!dataSink->finish()) {
+  }
+  const auto partitions = dataSink->close();
+  const auto stats = dataSink->stats();
+
+  // Each partition is written into a single file.
+  ASSERT_EQ(partitions.size(), numPartitions);
+  ASSERT_EQ(stats.numWrittenFiles, numPartitions);
+  int64_t numWrittenRows{0};
+  for (const auto& partition : partitions) {
+    const auto partitionJson = folly::parseJson(partition);
+    ASSERT_EQ(partitionJson["fileWriteInfos"].size(), 1);
+    numWrittenRows += partitionJson["rowCount"].asInt();
+  }
+  ASSERT_EQ(numWrittenRows, numBatches * batchSize);
+  ASSERT_EQ(listFiles(outputDirectory->getPath()).size(), numPartitions);
+}
+
 TEST_F(HiveDataSinkTest, sharedWriterOptionsWithMultipleWriters) {
   const auto outputDirectory = TempDirectoryPath::create();
 
@@ -36,24 +36,33 @@ RowVectorPtr getTpchData(
     size_t maxRows,
     size_t offset,
     double scaleFactor,
+    bool generateComments,
     memory::MemoryPool* pool) {
   switch (table) {
     case Table::TBL_PART:
-      return velox::tpch::genTpchPart(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchPart(
+          pool, maxRows, offset, scaleFactor, generateComments);
     case Table::TBL_SUPPLIER:
-      return velox::tpch::genTpchSupplier(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchSupplier(
+          pool, maxRows, offset, scaleFactor, generateComments);
     case Table::TBL_PARTSUPP:
-      return velox::tpch::genTpchPartSupp(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchPartSupp(
+          pool, maxRows, offset, scaleFactor, generateComments);
     case Table::TBL_CUSTOMER:
-      return velox::tpch::genTpchCustomer(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchCustomer(
+          pool, maxRows, offset, scaleFactor, generateComments);
     case Table::TBL_ORDERS:
-      return velox::tpch::genTpchOrders(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchOrders(
+          pool, maxRows, offset, scaleFactor, generateComments);
     case Table::TBL_LINEITEM:
-      return velox::tpch::genTpchLineItem(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchLineItem(
+          pool, maxRows, offset, scaleFactor, generateComments);
     case Table::TBL_NATION:
-      return velox::tpch::genTpchNation(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchNation(
+          pool, maxRows, offset, scaleFactor, generateComments);
     case Table::TBL_REGION:
-      return velox::tpch::genTpchRegion(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchRegion(
+          pool, maxRows, offset, scaleFactor, generateComments);
   }
   return nullptr;
 }
@@ -111,10 +120,15 @@ TpchDataSource::TpchDataSource(
         handle->name(),
         toTableName(tpchTable_));
     outputColumnMappings_.emplace_back(*idx);
+    if (handle->name().ends_with("_comment")) {
+      generateComments_ = true;
+    }
   }
   outputType_ = outputType;
 
   if (tpchTableHandle->filterExpression()) {
+    // The filter may read any column.
+    generateComments_ = true;
     filterExpression_ = connectorQueryCtx_->expressionEvaluator()->compile(
         tpchTableHandle->filterExpression());
   }
@@ -223,8 +237,13 @@ std::optional<RowVectorPtr> TpchDataSource::next(
   }
 
   size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto outputVector = getTpchData(
+      tpchTable_,
+      maxRows,
+      splitOffset_,
+      scaleFactor_,
+      generateComments_,
+      pool_);
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
@@ -189,6 +189,10 @@ class TpchDataSource : public DataSource {
   // dbgen generated datasets.
   std::vector<column_index_t> outputColumnMappings_;
 
+  // Whether the comment columns are read by the output or the filter. If not,
+  // their generation is skipped.
+  bool generateComments_{false};
+
   std::shared_ptr<TpchConnectorSplit> currentSplit_;
 
   // First (splitOffset_) and last (splitEnd_) row number that should be
@@ -1331,12 +1331,16 @@ const std::vector<PlanNodePtr>& ExchangeNode::sources() const {
 
 void ExchangeNode::addDetails(std::stringstream& stream) const {
   addVectorSerdeKind(serdeKind_, stream);
+  if (broadcast_) {
+    stream << " broadcast";
+  }
 }
 
 folly::dynamic ExchangeNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["outputType"] = ExchangeNode::outputType()->serialize();
   obj["serdeKind"] = VectorSerde::kindName(serdeKind_);
+  obj["broadcast"] = broadcast_;
   return obj;
 }
 
@@ -1351,7 +1355,8 @@ PlanNodePtr ExchangeNode::create(const folly::dynamic& obj, void* context) {
   return std::make_shared<ExchangeNode>(
       deserializePlanNodeId(obj),
       deserializeRowType(obj["outputType"]),
-      VectorSerde::kindByName(obj["serdeKind"].asString()));
+      VectorSerde::kindByName(obj["serdeKind"].asString()),
+      obj.count("broadcast") != 0 && obj["broadcast"].asBool());
 }
 
 UnnestNode::UnnestNode(
@@ -1627,6 +1632,9 @@ folly::dynamic HashJoinNode::serialize() const {
   auto obj = serializeBase();
   obj["nullAware"] = nullAware_;
   obj["useHashTableCache"] = useHashTableCache_;
+  if (!hashTableCacheKey_.empty()) {
+    obj["hashTableCacheKey"] = hashTableCacheKey_;
+  }
   return obj;
 }
 
@@ -1643,6 +1651,7 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
 
   auto nullAware = obj["nullAware"].asBool();
   auto useHashTableCache = obj.getDefault("useHashTableCache", false).asBool();
+  auto hashTableCacheKey = obj.getDefault("hashTableCacheKey", "").asString();
   auto leftKeys = deserializeFields(obj["leftKeys"], context);
   auto rightKeys = deserializeFields(obj["rightKeys"], context);
 
@@ -1663,7 +1672,8 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       sources[0],
       sources[1],
       outputType,
-      useHashTableCache);
+      useHashTableCache,
+      std::move(hashTableCacheKey));
 }
 
 MergeJoinNode::MergeJoinNode(
@@ -3614,6 +3624,9 @@ std::string TraceScanNode::traceDir() const {
 
 void TraceScanNode::addDetails(std::stringstream& stream) const {
   stream << "Trace dir: " << traceDir_;
+  if (inputs_ != nullptr) {
+    stream << ", preloaded";
+  }
 }
 
 void FilterNode::addSummaryDetails(
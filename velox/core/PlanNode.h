@@ -516,17 +516,29 @@ using ArrowStreamNodePtr = std::shared_ptr<const ArrowStreamNode>;
 
 class TraceScanNode final : public PlanNode {
  public:
+  /// Traced input batches preloaded in memory, one list per entry of
+  /// 'driverIds'.
+  using Inputs = std::vector<std::vector<RowVectorPtr>>;
+
+  /// If 'inputs' is set, the scan returns the preloaded batches instead of
+  /// reading the traced data files under 'traceDir'.
   TraceScanNode(
       const PlanNodeId& id,
       const std::string& traceDir,
       uint32_t pipelineId,
       std::vector<uint32_t> driverIds,
-      const RowTypePtr& outputType)
+      const RowTypePtr& outputType,
+      std::shared_ptr<const Inputs> inputs = nullptr)
       : PlanNode(id),
         traceDir_(traceDir),
         pipelineId_(pipelineId),
         driverIds_(std::move(driverIds)),
-        outputType_(outputType) {}
+        outputType_(outputType),
+        inputs_(std::move(inputs)) {
+    if (inputs_ != nullptr) {
+      VELOX_USER_CHECK_EQ(inputs_->size(), driverIds_.size());
+    }
+  }
 
   class Builder {
    public:
@@ -538,6 +550,7 @@ class TraceScanNode final : public PlanNode {
       pipelineId_ = other.pipelineId();
       driverIds_ = other.driverIds();
       outputType_ = other.outputType();
+      inputs_ = other.inputs();
     }
 
     Builder& id(PlanNodeId id) {
@@ -565,6 +578,11 @@ class TraceScanNode final : public PlanNode {
       return *this;
     }
 
+    Builder& inputs(std::shared_ptr<const Inputs> inputs) {
+      inputs_ = std::move(inputs);
+      return *this;
+    }
+
     std::shared_ptr<TraceScanNode> build() const {
       VELOX_USER_CHECK(id_.has_value(), "TraceScanNode id is not set");
       VELOX_USER_CHECK(
@@ -581,7 +599,8 @@ class TraceScanNode final : public PlanNode {
           traceDir_.value(),
           pipelineId_.value(),
           driverIds_.value(),
-          outputType_.value());
+          outputType_.value(),
+          inputs_);
     }
 
    private:
@@ -590,6 +609,7 @@ class TraceScanNode final : public PlanNode {
     std::optional<uint32_t> pipelineId_;
     std::optional<std::vector<uint32_t>> driverIds_;
     std::optional<RowTypePtr> outputType_;
+    std::shared_ptr<const Inputs> inputs_;
   };
 
   const RowTypePtr& outputType() const override {
@@ -620,6 +640,12 @@ class TraceScanNode final : public PlanNode {
     return driverIds_;
   }
 
+  /// Returns the preloaded traced inputs or nullptr if the scan reads the
+  /// traced data files.
+  const std::shared_ptr<const Inputs>& inputs() const {
+    return inputs_;
+  }
+
  private:
   void addDetails(std::stringstream& stream) const override;
 
@@ -628,6 +654,7 @@ class TraceScanNode final : public PlanNode {
   const uint32_t pipelineId_;
   const std::vector<uint32_t> driverIds_;
   const RowTypePtr outputType_;
+  const std::shared_ptr<const Inputs> inputs_;
 };
 
 using TraceScanNodePtr = std::shared_ptr<const TraceScanNode>;
@@ -2080,11 +2107,17 @@ using GroupIdNodePtr = std::shared_ptr<const GroupIdNode>;
 
 class ExchangeNode : public PlanNode {
  public:
+  /// 'broadcast' tells that every consumer task of the exchange receives all
+  /// the rows, i.e. the producers use broadcast output buffers.
   ExchangeNode(
       const PlanNodeId& id,
       RowTypePtr type,
-      VectorSerde::Kind serdeKind)
-      : PlanNode(id), outputType_(type), serdeKind_(serdeKind) {}
+      VectorSerde::Kind serdeKind,
+      bool broadcast = false)
+      : PlanNode(id),
+        outputType_(type),
+        serdeKind_(serdeKind),
+        broadcast_(broadcast) {}
 
   class Builder {
    public:
@@ -2094,6 +2127,7 @@ class ExchangeNode : public PlanNode {
       id_ = other.id();
       outputType_ = other.outputType();
       serdeKind_ = other.serdeKind();
+      broadcast_ = other.isBroadcast();
     }
 
     Builder& id(PlanNodeId id) {
@@ -2111,6 +2145,11 @@ class ExchangeNode : public PlanNode {
       return *this;
     }
 
+    Builder& broadcast(bool broadcast) {
+      broadcast_ = broadcast;
+      return *this;
+    }
+
     std::shared_ptr<ExchangeNode> build() const {
       VELOX_USER_CHECK(id_.has_value(), "ExchangeNode id is not set");
       VELOX_USER_CHECK(
@@ -2119,13 +2158,14 @@ class ExchangeNode : public PlanNode {
           serdeKind_.has_value(), "ExchangeNode serdeKind is not set");
 
       return std::make_shared<ExchangeNode>(
-          id_.value(), outputType_.value(), serdeKind_.value());
+          id_.value(), outputType_.value(), serdeKind_.value(), broadcast_);
     }
 
    private:
     std::optional<PlanNodeId> id_;
     std::optional<RowTypePtr> outputType_;
     std::optional<VectorSerde::Kind> serdeKind_;
+    bool broadcast_{false};
   };
 
   const RowTypePtr& outputType() const override {
@@ -2153,6 +2193,12 @@ class ExchangeNode : public PlanNode {
     return serdeKind_;
   }
 
+  /// Returns true if every consumer task receives all the rows of the
+  /// exchange.
+  bool isBroadcast() const {
+    return broadcast_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -2162,6 +2208,7 @@ class ExchangeNode : public PlanNode {
 
   const RowTypePtr outputType_;
   const VectorSerde::Kind serdeKind_;
+  const bool broadcast_;
 };
 
 using ExchangeNodePtr = std::shared_ptr<const ExchangeNode>;
@@ -2390,6 +2437,18 @@ class PartitionFunction {
   virtual std::optional<uint32_t> partition(
       const RowVector& input,
       std::vector<uint32_t>& partitions) = 0;
+
+  /// Returns the rows of the last 'partition()' input that go to
+  /// 'numReplicas()' consecutive partitions, wrapping around, starting at
+  /// their partition number. The other rows go to one partition.
+  virtual const std::vector<vector_size_t>& replicatedRows() const {
+    static const std::vector<vector_size_t> kEmpty;
+    return kEmpty;
+  }
+
+  virtual int32_t numReplicas() const {
+    return 1;
+  }
 };
 
 /// Factory class for creating PartitionFunction instances.
@@ -3148,7 +3207,8 @@ class HashJoinNode : public AbstractJoinNode {
       PlanNodePtr left,
       PlanNodePtr right,
       RowTypePtr outputType,
-      bool useHashTableCache = false)
+      bool useHashTableCache = false,
+      std::string hashTableCacheKey = "")
       : AbstractJoinNode(
             id,
             joinType,
@@ -3159,8 +3219,12 @@ class HashJoinNode : public AbstractJoinNode {
             std::move(right),
             std::move(outputType)),
         nullAware_{nullAware},
-        useHashTableCache_{useHashTableCache} {
+        useHashTableCache_{useHashTableCache},
+        hashTableCacheKey_{std::move(hashTableCacheKey)} {
     validate();
+    VELOX_USER_CHECK(
+        hashTableCacheKey_.empty() || useHashTableCache_,
+        "Hash table cache key requires hash table caching to be enabled");
 
     if (nullAware) {
       VELOX_USER_CHECK(
@@ -3185,6 +3249,7 @@ class HashJoinNode : public AbstractJoinNode {
         : AbstractJoinNode::Builder<HashJoinNode, Builder>(other) {
       nullAware_ = other.isNullAware();
       useHashTableCache_ = other.useHashTableCache();
+      hashTableCacheKey_ = other.hashTableCacheKey();
     }
 
     Builder& nullAware(bool value) {
@@ -3197,6 +3262,11 @@ class HashJoinNode : public AbstractJoinNode {
       return *this;
     }
 
+    Builder& hashTableCacheKey(std::string value) {
+      hashTableCacheKey_ = std::move(value);
+      return *this;
+    }
+
     std::shared_ptr<HashJoinNode> build() const {
       VELOX_USER_CHECK(id_.has_value(), "HashJoinNode id is not set");
       VELOX_USER_CHECK(
@@ -3224,12 +3294,14 @@ class HashJoinNode : public AbstractJoinNode {
           left_.value(),
           right_.value(),
           outputType_.value(),
-          useHashTableCache_.value_or(false));
+          useHashTableCache_.value_or(false),
+          hashTableCacheKey_.value_or(""));
     }
 
    private:
     std::optional<bool> nullAware_;
     std::optional<bool> useHashTableCache_;
+    std::optional<std::string> hashTableCacheKey_;
   };
 
   std::string_view name() const override {
@@ -3252,12 +3324,22 @@ class HashJoinNode : public AbstractJoinNode {
     return nullAware_;
   }
 
-  /// Returns whether hash table caching is enabled for broadcast joins.
-  /// Only used by Presto-on-Spark.
+  /// Returns whether hash table caching is enabled for broadcast joins. The
+  /// tasks of the query on a node then share one hash table. See also
+  /// QueryConfig::kHashJoinShareBroadcastBuild.
   bool useHashTableCache() const {
     return useHashTableCache_;
   }
 
+  /// If not empty, the built hash table is cached on the node across queries
+  /// under this key instead of only within the query. The key must identify
+  /// the build side plan and the data it reads, e.g. a fingerprint of the
+  /// build side plan plus the snapshot of the tables it scans. Requires
+  /// useHashTableCache().
+  const std::string& hashTableCacheKey() const {
+    return hashTableCacheKey_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -3267,6 +3349,7 @@ class HashJoinNode : public AbstractJoinNode {
 
   const bool nullAware_;
   const bool useHashTableCache_;
+  const std::string hashTableCacheKey_;
 };
 
 using HashJoinNodePtr = std::shared_ptr<const HashJoinNode>;
@@ -81,6 +81,13 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsageForFunctions =
       "expression.track_cpu_usage_for_functions";
 
+  /// If not 0, times one in this many batches of each function call whose
+  /// CPU usage is not otherwise tracked and adds it to the process-wide
+  /// FunctionProfileRegistry, which ranks the functions by CPU time, rows and
+  /// null ratio across queries. 0 by default.
+  static constexpr const char* kExprCpuSamplingInterval =
+      "expression.cpu_sampling_interval";
+
   /// Controls whether non-deterministic expressions are deduplicated during
   /// compilation. This is intended for testing and debugging purposes. By
   /// default, this is set to true to preserve standard behavior. If set to
@@ -94,11 +101,24 @@ class QueryConfig {
   static constexpr const char* kExprDedupNonDeterministic =
       "expression.dedup_non_deterministic";
 
+  /// Whether to evaluate trees of arithmetic and comparison calls over
+  /// columns and constants, e.g. a * b + c > d, as one fused expression that
+  /// computes the calls in one pass over chunks of rows without intermediate
+  /// vectors. False by default.
+  static constexpr const char* kExprFusionEnabled = "expression.fusion_enabled";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to count instructions, CPU cycles, cache misses and branch misses
+  /// of individual operators with perf_event hardware counters. False by
+  /// default. Adds two system calls per operator call and is ignored where
+  /// perf_event_open is not available.
+  static constexpr const char* kOperatorTrackPerfCounters =
+      "track_operator_perf_counters";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -169,6 +189,14 @@ class QueryConfig {
   static constexpr const char* kLocalExchangePartitionBufferPreserveEncoding =
       "local_exchange_partition_buffer_preserve_encoding";
 
+  /// If true, a local exchange consumer pops the small vectors queued behind
+  /// the next one in a single critical section and copies them into one
+  /// output vector of up to 'preferred_output_batch_rows' rows. Reduces the
+  /// per-vector queue and promise overhead when many producers enqueue small
+  /// vectors at the cost of a copy.
+  static constexpr const char* kLocalExchangeCoalesceOutputBatches =
+      "local_exchange_coalesce_output_batches";
+
   /// Maximum number of vectors buffered in each local merge source before
   /// blocking to wait for consumers.
   static constexpr const char* kLocalMergeSourceQueueSize =
@@ -179,6 +207,12 @@ class QueryConfig {
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// If greater than 'exchange.max_buffer_size', the buffer of the exchange
+  /// client grows up to this size while the memory pressure is low, and
+  /// memory arbitration shrinks it back to 'exchange.max_buffer_size'.
+  static constexpr const char* kMaxExchangeBufferSizeLimit =
+      "exchange.max_buffer_size_limit";
+
   /// Maximum size in bytes to accumulate among all sources of the merge
   /// exchange. Enforced approximately, not strictly.
   static constexpr const char* kMaxMergeExchangeBufferSize =
@@ -205,6 +239,13 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If true, a partial aggregation that reaches its memory limit flushes only
+  /// the groups that were not updated again since they were added or since
+  /// the previous flush. The hot groups stay in the hash table. Falls back to
+  /// flushing all groups if most of the groups are hot.
+  static constexpr const char* kPartialAggregationEvictColdGroups =
+      "partial_aggregation_evict_cold_groups";
+
   /// Memory threshold in bytes for triggering string compaction during
   /// global aggregation. When total string storage exceeds this limit with
   /// high unused memory ratio, compaction is triggered to reclaim dead strings.
@@ -223,6 +264,28 @@ class QueryConfig {
   static constexpr const char* kAggregationCompactionUnusedMemoryRatio =
       "aggregation_compaction_unused_memory_ratio";
 
+  /// Size in bytes of the hash table of a final or single aggregation above
+  /// which the groups are radix partitioned into sub-tables on the hash of the
+  /// grouping keys. Each input batch is then probed one partition at a time
+  /// to keep the working set small. Only applies when spilling is disabled.
+  /// 0 disables partitioning.
+  static constexpr const char* kAggregationPartitionThresholdBytes =
+      "aggregation_partition_threshold_bytes";
+
+  /// The number of hash bits (N) used to partition a large aggregation hash
+  /// table into 2 ^ N sub-tables.
+  static constexpr const char* kAggregationPartitionBits =
+      "aggregation_partition_bits";
+
+  /// If true, a single aggregation whose aggregates are all distinct over the
+  /// same column x runs as a distinct aggregation on (grouping keys, x)
+  /// followed by a non-distinct aggregation on the grouping keys. This replaces
+  /// the per-group sets of distinct values with hash table rows that can be
+  /// spilled. Meant to be set by the planner when the number of distinct
+  /// (group, x) pairs is expected to be large.
+  static constexpr const char* kAggregationPreAggregateDistinct =
+      "aggregation_pre_aggregate_distinct";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -295,6 +358,13 @@ class QueryConfig {
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
       "adaptive_filter_reordering_enabled";
 
+  /// If true, the conjunction expression evaluates its cheap inputs on all
+  /// its rows while at least half of them are undecided, instead of
+  /// narrowing the rows after each input. A cheap input is a deterministic
+  /// function of columns without nulls and constants.
+  static constexpr const char* kDenseConjunctEvaluationEnabled =
+      "dense_conjunct_evaluation_enabled";
+
   /// If true, allow hash probe drivers to generate build-side rows in parallel.
   static constexpr const char* kParallelOutputJoinBuildRowsEnabled =
       "parallel_output_join_build_rows_enabled";
@@ -326,6 +396,14 @@ class QueryConfig {
   static constexpr const char* kWindowSpillMinReadBatchRows =
       "window_spill_min_read_batch_rows";
 
+  /// If true and all the window functions can process a partition a batch of
+  /// rows at a time, e.g. rank and row_number, spilled window data is read in
+  /// batches of output size from within a partition instead of in whole
+  /// partitions. The memory is then bounded by the batch instead of the
+  /// largest partition.
+  static constexpr const char* kWindowSpillStreamingEnabled =
+      "window_spill_streaming_enabled";
+
   /// If true, the memory arbitrator will reclaim memory from table writer by
   /// flushing its buffered data to disk. only applies if "spill_enabled" flag
   /// is set.
@@ -375,6 +453,24 @@ class QueryConfig {
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// The serialization format of spill files: 'presto' for Presto pages or
+  /// 'columnar' for column-major batches with per-column encodings and
+  /// compression.
+  static constexpr const char* kSpillFileFormat = "spill_file_format";
+
+  /// If true, spill file writes run on the spill executor in the background
+  /// while the spilling thread extracts and serializes the next batch. Has no
+  /// effect if the query has no spill executor.
+  static constexpr const char* kSpillAsyncWriteEnabled =
+      "spill_async_write_enabled";
+
+  /// Number of bits of the key range partitions used to merge the spilled
+  /// sorted runs of order by in parallel. The spilled rows are split into up
+  /// to 2^bits key ranges that are merged on the spill executor. 0 disables
+  /// the parallel merge. Can not be more than 3.
+  static constexpr const char* kSpillSortMergePartitionBits =
+      "spill_sort_merge_partition_bits";
+
   /// The max number of files to merge at a time when merging sorted files into
   /// a single ordered stream. 0 means unlimited. This is used to reduce memory
   /// pressure by capping the number of open files when merging spilled sorted
@@ -468,6 +564,14 @@ class QueryConfig {
   static constexpr const char* kSparkBloomFilterMaxNumBits =
       "spark.bloom_filter.max_num_bits";
 
+  /// If true, bloom_filter_agg builds a split block bloom filter, which sets
+  /// all bits of a value in one SIMD register sized block and has a lower
+  /// false positive rate for the same size. The serialized form is not
+  /// compatible with Spark, so this is only for filters that are built and
+  /// probed by Velox, like runtime filters. might_contain reads both forms.
+  static constexpr const char* kSparkBloomFilterSplitBlockEnabled =
+      "spark.bloom_filter.split_block_enabled";
+
   /// The current spark partition id.
   static constexpr const char* kSparkPartitionId = "spark.partition_id";
 
@@ -506,6 +610,12 @@ class QueryConfig {
   static constexpr const char* kHashProbeDynamicFilterPushdownEnabled =
       "hash_probe_dynamic_filter_pushdown_enabled";
 
+  /// Whether TopN and TopNRowNumber push the value of their current K-th row
+  /// down to upstream operators as a dynamic range filter on the first
+  /// sorting key.
+  static constexpr const char* kTopNDynamicFilterPushdownEnabled =
+      "topn_dynamic_filter_pushdown_enabled";
+
   /// The maximum byte size of Bloom filter that can be generated from hash
   /// probe.  When set to 0, no Bloom filter will be generated.  To achieve
   /// optimal performance, this should not be too larger than the CPU cache size
@@ -518,6 +628,30 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The number of partitions of the hash join table that are built in
+  /// parallel. Each partition is a disjoint range of the table that is built by
+  /// a separate thread of the query executor. If less than the number of build
+  /// drivers, each build driver builds one partition. At most 255.
+  static constexpr const char* kParallelJoinBuildPartitions =
+      "parallel_join_build_partitions";
+
+  /// The maximum number of row ranges a ParallelProject splits an input batch
+  /// into for evaluating one group of exprs on several threads of the query
+  /// executor. The number of ranges follows the time per row the group took on
+  /// the previous batch, so that only expensive exprs are split. 1 or less
+  /// evaluates each group on the whole batch.
+  static constexpr const char* kParallelProjectMaxMorsels =
+      "parallel_project_max_morsels";
+
+  /// If true, the tasks of the query on a node share one hash table for each
+  /// hash join whose build side reads only broadcast exchanges, see
+  /// ExchangeNode::isBroadcast(). The first task builds the table and it is
+  /// charged once to the query. Joins whose build side reads a partitioned
+  /// exchange or local data, and right, full and right semi joins, keep one
+  /// table per task.
+  static constexpr const char* kHashJoinShareBroadcastBuild =
+      "hash_join_share_broadcast_build";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -528,8 +662,7 @@ class QueryConfig {
 
   /// If true, enable caches in expression evaluation for performance, including
   /// ExecCtx::vectorPool_, ExecCtx::decodedVectorPool_,
-  /// ExecCtx::selectivityVectorPool_, Expr::baseDictionary_,
-  /// Expr::dictionaryCache_, and Expr::cachedDictionaryIndices_. Otherwise,
+  /// ExecCtx::selectivityVectorPool_ and Expr::dictionaryMemos_. Otherwise,
   /// disable the caches.
   static constexpr const char* kEnableExpressionEvaluationCache =
       "enable_expression_evaluation_cache";
@@ -541,13 +674,35 @@ class QueryConfig {
   static constexpr const char* kMaxSharedSubexprResultsCached =
       "max_shared_subexpr_results_cached";
 
+  /// For a given expression over a dictionary encoded input, the maximum
+  /// number of distinct dictionary bases we memoize results for. More than
+  /// one lets the results survive inputs that alternate between a few
+  /// dictionaries, e.g. the stripe dictionaries of a string column. Each
+  /// entry holds a reference to its base and the results computed for it.
+  /// An entry is dropped once no one else holds its base.
+  static constexpr const char* kMaxDictionaryMemoEntries =
+      "max_dictionary_memo_entries";
+
+  /// The maximum number of dictionary encoded vectors in one expression
+  /// evaluation whose decodings are shared by the functions reading them. 0
+  /// disables sharing.
+  static constexpr const char* kMaxDecodedVectorsCached =
+      "max_decoded_vectors_cached";
+
   /// Maximum number of splits to preload. Set to 0 to disable preloading.
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Maximum number of splits per driver past the preloaded ones whose files
+  /// are opened ahead on the IO executor of the connector. This is cheaper
+  /// than preloading, which also makes the data source, and so can reach
+  /// further ahead on scans of many small files. Set to 0 to disable.
+  static constexpr const char* kMaxSplitPrewarmPerDriver =
+      "max_split_prewarm_per_driver";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
-  /// limit.
+  /// limit, except on exec::FairShareExecutor which uses its own time slice.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
@@ -557,6 +712,13 @@ class QueryConfig {
   static constexpr const char* kWindowNumSubPartitions =
       "window_num_sub_partitions";
 
+  /// Maximum number of complete window partitions the Window operator
+  /// evaluates in parallel on the query executor after sorting its input. The
+  /// partitions larger than an output batch are evaluated by the operator
+  /// thread. Use 1 to disable parallel evaluation.
+  static constexpr const char* kWindowParallelEvaluationWorkers =
+      "window_parallel_evaluation_workers";
+
   /// Maximum number of bytes to use for the normalized key in prefix-sort. Use
   /// 0 to disable prefix-sort.
   static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
@@ -571,6 +733,11 @@ class QueryConfig {
   static constexpr const char* kPrefixSortMaxStringPrefixLength =
       "prefixsort_max_string_prefix_length";
 
+  /// Minimum number of rows to sort short fixed width normalized keys with
+  /// radix sort instead of quick sort in prefix-sort.
+  static constexpr const char* kPrefixSortMinRadixSortRows =
+      "prefixsort_min_radix_sort_rows";
+
   /// Enable query tracing flag.
   static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
 
@@ -599,6 +766,13 @@ class QueryConfig {
   static constexpr const char* kOpTraceDirectoryCreateConfig =
       "op_trace_directory_create_config";
 
+  /// Local directory to write a Perfetto timeline trace of each task to,
+  /// named <task id>.perfetto-trace. The trace has the operator calls, the
+  /// blocked and suspended intervals of the drivers and the spill IO. Empty
+  /// disables the trace. Has no effect unless Velox is built with
+  /// VELOX_ENABLE_PERFETTO_TRACE.
+  static constexpr const char* kPerfettoTraceDir = "perfetto_trace_dir";
+
   /// Disable optimization in expression evaluation to peel common dictionary
   /// layer from inputs.
   static constexpr const char* kDebugDisableExpressionWithPeeling =
@@ -711,11 +885,27 @@ class QueryConfig {
   static constexpr const char* kTableScanScaleUpMemoryUsageRatio =
       "table_scan_scale_up_memory_usage_ratio";
 
+  /// If non-zero, a table scan driver that takes a split of at least twice
+  /// this many bytes divides it into parts of about this size, keeps the first
+  /// one and queues the others ahead of the other splits, so that the other
+  /// drivers of the pipeline share a large split instead of idling while one
+  /// driver reads it alone. Only applies to connector splits that support
+  /// division, e.g. Hive splits of DWRF, ORC and Parquet files.
+  static constexpr const char* kTableScanSplitDivisionBytes =
+      "table_scan_split_division_bytes";
+
   /// Specifies the shuffle compression kind which is defined by
   /// CompressionKind. If it is CompressionKind_NONE, then no compression.
   static constexpr const char* kShuffleCompressionKind =
       "shuffle_compression_codec";
 
+  /// If true, the Presto serde picks the codec of each shuffle page from a
+  /// sample of the page bytes: ZSTD for very repetitive data, LZ4 for the
+  /// rest and no compression for data that does not compress. The pages can
+  /// only be read by Velox.
+  static constexpr const char* kShuffleCompressionAdaptive =
+      "shuffle_compression_adaptive";
+
   /// If a key is found in multiple given maps, by default that key's value in
   /// the resulting map comes from the last one of those maps. When true, throw
   /// exception on duplicate map key.
@@ -733,6 +923,26 @@ class QueryConfig {
   static constexpr const char* kIndexLookupJoinSplitOutput =
       "index_lookup_join_split_output";
 
+  /// If this is true, the index join operator sends each distinct lookup key
+  /// of an input batch to the index source once and fans the matches out to
+  /// all the input rows with that key.
+  static constexpr const char* kIndexLookupJoinDedupKeys =
+      "index_lookup_join_dedup_keys";
+
+  /// The max bytes of lookup results that each index join operator keeps in an
+  /// LRU cache keyed by lookup key. Keys found in the cache are not sent to
+  /// the index source. Enables key deduplication if non-zero. Zero disables
+  /// the cache.
+  static constexpr const char* kIndexLookupJoinCacheMaxBytes =
+      "index_lookup_join_cache_max_bytes";
+
+  /// The min number of input rows that the index join operator sends to the
+  /// index source in one lookup. Smaller input batches are merged until they
+  /// reach this number of rows or there is no more input. Zero sends each
+  /// input batch as is.
+  static constexpr const char* kIndexLookupJoinMinBatchRows =
+      "index_lookup_join_min_batch_rows";
+
   // Max wait time for exchange request in seconds.
   static constexpr const char* kRequestDataSizesMaxWaitSec =
       "request_data_sizes_max_wait_sec";
@@ -780,6 +990,15 @@ class QueryConfig {
   static constexpr const char* kEnableOperatorBatchSizeStats =
       "enable_operator_batch_size_stats";
 
+  /// If this is true, the driver accumulates the small output batches an
+  /// operator produces back-to-back, e.g. after selective filters or join
+  /// probes, and hands them to the next operator as batches of up to
+  /// 'preferred_output_batch_rows' rows and 'preferred_output_batch_bytes'
+  /// bytes. Buffered batches are handed over before the driver blocks. Batches
+  /// are always handed over as produced in serial execution mode.
+  static constexpr const char* kCoalesceOperatorOutputBatches =
+      "coalesce_operator_output_batches";
+
   /// If this is true, then the unnest operator might split output for each
   /// input batch based on the output batch size control. Otherwise, it produces
   /// a single output for each input batch.
@@ -790,6 +1009,12 @@ class QueryConfig {
   static constexpr const char* kQueryMemoryReclaimerPriority =
       "query_memory_reclaimer_priority";
 
+  /// Shifts the scheduling level of the query in exec::FairShareExecutor.
+  /// Negative values schedule the query ahead of the queries with the same
+  /// CPU time, positive values after them. Ignored by other executors.
+  static constexpr const char* kQuerySchedulingPriority =
+      "query_scheduling_priority";
+
   /// The max number of input splits to listen to by SplitListener per table
   /// scan node per worker. It's up to the SplitListener implementation to
   /// respect this config.
@@ -890,6 +1115,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  bool partialAggregationEvictColdGroups() const {
+    return get<bool>(kPartialAggregationEvictColdGroups, false);
+  }
+
   uint64_t aggregationCompactionBytesThreshold() const {
     return get<uint64_t>(kAggregationCompactionBytesThreshold, 0);
   }
@@ -898,6 +1127,21 @@ class QueryConfig {
     return get<double>(kAggregationCompactionUnusedMemoryRatio, 0.25);
   }
 
+  uint64_t aggregationPartitionThresholdBytes() const {
+    return get<uint64_t>(kAggregationPartitionThresholdBytes, 32UL << 20);
+  }
+
+  uint8_t aggregationPartitionBits() const {
+    constexpr uint8_t kDefaultBits = 4;
+    constexpr uint8_t kMaxBits = 8;
+    return std::min(
+        kMaxBits, get<uint8_t>(kAggregationPartitionBits, kDefaultBits));
+  }
+
+  bool aggregationPreAggregateDistinct() const {
+    return get<bool>(kAggregationPreAggregateDistinct, false);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -970,6 +1214,10 @@ class QueryConfig {
     return get<bool>(kLocalExchangePartitionBufferPreserveEncoding, false);
   }
 
+  bool localExchangeCoalesceOutputBatches() const {
+    return get<bool>(kLocalExchangeCoalesceOutputBatches, false);
+  }
+
   uint32_t localMergeSourceQueueSize() const {
     return get<uint32_t>(kLocalMergeSourceQueueSize, 2);
   }
@@ -979,6 +1227,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
   }
 
+  uint64_t maxExchangeBufferSizeLimit() const {
+    return get<uint64_t>(kMaxExchangeBufferSizeLimit, 0);
+  }
+
   uint64_t maxMergeExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 128UL << 20;
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
@@ -1029,6 +1281,10 @@ class QueryConfig {
     return get<bool>(kAdaptiveFilterReorderingEnabled, true);
   }
 
+  bool denseConjunctEvaluationEnabled() const {
+    return get<bool>(kDenseConjunctEvaluationEnabled, false);
+  }
+
   bool isLegacyCast() const {
     return get<bool>(kLegacyCast, false);
   }
@@ -1095,6 +1351,10 @@ class QueryConfig {
     return get<uint32_t>(kWindowSpillMinReadBatchRows, 1'000);
   }
 
+  bool windowSpillStreamingEnabled() const {
+    return get<bool>(kWindowSpillStreamingEnabled, false);
+  }
+
   bool writerSpillEnabled() const {
     return get<bool>(kWriterSpillEnabled, true);
   }
@@ -1147,6 +1407,19 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  std::string spillFileFormat() const {
+    return get<std::string>(kSpillFileFormat, "presto");
+  }
+
+  bool spillAsyncWriteEnabled() const {
+    return get<bool>(kSpillAsyncWriteEnabled, false);
+  }
+
+  uint8_t spillSortMergePartitionBits() const {
+    constexpr uint8_t kMaxBits = 3;
+    return std::min(kMaxBits, get<uint8_t>(kSpillSortMergePartitionBits, 0));
+  }
+
   uint32_t spillNumMaxMergeFiles() const {
     constexpr uint32_t kDefaultMergeFiles = 0;
     return get<uint32_t>(kSpillNumMaxMergeFiles, kDefaultMergeFiles);
@@ -1211,6 +1484,10 @@ class QueryConfig {
     return get<std::string>(kOpTraceDirectoryCreateConfig, "");
   }
 
+  std::string perfettoTraceDir() const {
+    return get<std::string>(kPerfettoTraceDir, "");
+  }
+
   bool prestoArrayAggIgnoreNulls() const {
     return get<bool>(kPrestoArrayAggIgnoreNulls, false);
   }
@@ -1242,6 +1519,10 @@ class QueryConfig {
     return value;
   }
 
+  bool sparkBloomFilterSplitBlockEnabled() const {
+    return get<bool>(kSparkBloomFilterSplitBlockEnabled, false);
+  }
+
   int32_t sparkPartitionId() const {
     auto id = get<int32_t>(kSparkPartitionId);
     VELOX_CHECK(id.has_value(), "Spark partition id is not set.");
@@ -1270,14 +1551,26 @@ class QueryConfig {
     return get<std::string>(kExprTrackCpuUsageForFunctions, "");
   }
 
+  uint32_t exprCpuSamplingInterval() const {
+    return get<uint32_t>(kExprCpuSamplingInterval, 0);
+  }
+
   bool exprDedupNonDeterministic() const {
     return get<bool>(kExprDedupNonDeterministic, true);
   }
 
+  bool exprFusionEnabled() const {
+    return get<bool>(kExprFusionEnabled, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackPerfCounters() const {
+    return get<bool>(kOperatorTrackPerfCounters, false);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -1295,6 +1588,10 @@ class QueryConfig {
     return get<bool>(kHashProbeDynamicFilterPushdownEnabled, true);
   }
 
+  bool topNDynamicFilterPushdownEnabled() const {
+    return get<bool>(kTopNDynamicFilterPushdownEnabled, false);
+  }
+
   uint64_t hashProbeBloomFilterPushdownMaxSize() const {
     return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
   }
@@ -1303,6 +1600,20 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint8_t parallelJoinBuildPartitions() const {
+    return std::min<uint32_t>(
+        get<uint32_t>(kParallelJoinBuildPartitions, 0),
+        std::numeric_limits<uint8_t>::max());
+  }
+
+  int32_t parallelProjectMaxMorsels() const {
+    return get<int32_t>(kParallelProjectMaxMorsels, 1);
+  }
+
+  bool hashJoinShareBroadcastBuild() const {
+    return get<bool>(kHashJoinShareBroadcastBuild, false);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -1327,10 +1638,22 @@ class QueryConfig {
     return get<uint32_t>(kMaxSharedSubexprResultsCached, 10);
   }
 
+  uint32_t maxDictionaryMemoEntries() const {
+    return get<uint32_t>(kMaxDictionaryMemoEntries, 4);
+  }
+
+  uint32_t maxDecodedVectorsCached() const {
+    return get<uint32_t>(kMaxDecodedVectorsCached, 4);
+  }
+
   int32_t maxSplitPreloadPerDriver() const {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  int32_t maxSplitPrewarmPerDriver() const {
+    return get<int32_t>(kMaxSplitPrewarmPerDriver, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
@@ -1339,6 +1662,10 @@ class QueryConfig {
     return get<uint32_t>(kWindowNumSubPartitions, 1);
   }
 
+  uint32_t windowParallelEvaluationWorkers() const {
+    return get<uint32_t>(kWindowParallelEvaluationWorkers, 1);
+  }
+
   uint32_t prefixSortNormalizedKeyMaxBytes() const {
     return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
   }
@@ -1351,6 +1678,10 @@ class QueryConfig {
     return get<uint32_t>(kPrefixSortMaxStringPrefixLength, 16);
   }
 
+  uint32_t prefixSortMinRadixSortRows() const {
+    return get<uint32_t>(kPrefixSortMinRadixSortRows, 1024);
+  }
+
   double scaleWriterRebalanceMaxMemoryUsageRatio() const {
     return get<double>(kScaleWriterRebalanceMaxMemoryUsageRatio, 0.7);
   }
@@ -1377,6 +1708,10 @@ class QueryConfig {
     return get<double>(kTableScanScaleUpMemoryUsageRatio, 0.7);
   }
 
+  uint64_t tableScanSplitDivisionBytes() const {
+    return get<uint64_t>(kTableScanSplitDivisionBytes, 0);
+  }
+
   uint32_t indexLookupJoinMaxPrefetchBatches() const {
     return get<uint32_t>(kIndexLookupJoinMaxPrefetchBatches, 0);
   }
@@ -1385,10 +1720,26 @@ class QueryConfig {
     return get<bool>(kIndexLookupJoinSplitOutput, true);
   }
 
+  bool indexLookupJoinDedupKeys() const {
+    return get<bool>(kIndexLookupJoinDedupKeys, false);
+  }
+
+  uint64_t indexLookupJoinCacheMaxBytes() const {
+    return get<uint64_t>(kIndexLookupJoinCacheMaxBytes, 0);
+  }
+
+  uint32_t indexLookupJoinMinBatchRows() const {
+    return get<uint32_t>(kIndexLookupJoinMinBatchRows, 0);
+  }
+
   std::string shuffleCompressionKind() const {
     return get<std::string>(kShuffleCompressionKind, "none");
   }
 
+  bool shuffleCompressionAdaptive() const {
+    return get<bool>(kShuffleCompressionAdaptive, false);
+  }
+
   int32_t requestDataSizesMaxWaitSec() const {
     return get<int32_t>(kRequestDataSizesMaxWaitSec, 10);
   }
@@ -1422,6 +1773,10 @@ class QueryConfig {
     return get<bool>(kOperatorTrackExpressionStats, false);
   }
 
+  bool coalesceOperatorOutputBatches() const {
+    return get<bool>(kCoalesceOperatorOutputBatches, false);
+  }
+
   bool enableOperatorBatchSizeStats() const {
     return get<bool>(kEnableOperatorBatchSizeStats, true);
   }
@@ -1435,6 +1790,10 @@ class QueryConfig {
         kQueryMemoryReclaimerPriority, std::numeric_limits<int32_t>::max());
   }
 
+  int32_t querySchedulingPriority() const {
+    return get<int32_t>(kQuerySchedulingPriority, 0);
+  }
+
   int32_t maxNumSplitsListenedTo() const {
     return get<int32_t>(kMaxNumSplitsListenedTo, 0);
   }
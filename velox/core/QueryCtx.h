@@ -456,6 +456,8 @@ class ExecCtx {
           !queryConfig.debugDisableExpressionsWithLazyInputs();
       maxSharedSubexprResultsCached =
           queryConfig.maxSharedSubexprResultsCached();
+      maxDictionaryMemoEntries = queryConfig.maxDictionaryMemoEntries();
+      maxDecodedVectorsCached = queryConfig.maxDecodedVectorsCached();
     }
 
     /// True if caches in expression evaluation used for performance are
@@ -478,6 +480,12 @@ class ExecCtx {
     /// The maximum number of distinct inputs to cache results in a
     /// given shared subexpression during experssion evaluation.
     uint32_t maxSharedSubexprResultsCached;
+    /// The maximum number of dictionary bases to memoize results for in a
+    /// given expression.
+    uint32_t maxDictionaryMemoEntries;
+    /// The maximum number of dictionary encoded vectors in one expression
+    /// evaluation whose decodings are shared by the functions reading them.
+    uint32_t maxDecodedVectorsCached;
   };
 
   velox::memory::MemoryPool* pool() const {
@@ -768,6 +768,7 @@ class UDFHolder {
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call()/callNullable()/callNullFree() method is
@@ -787,6 +788,7 @@ class UDFHolder {
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
+  // - void callBatch(...)
   // - void initialize(...)
 
   // call():
@@ -903,6 +905,17 @@ class UDFHolder {
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch(): processes 'numRows' consecutive rows of non-null flat inputs
+  // at once, e.g. with SIMD. Used next to call() for functions of fixed width
+  // primitive types.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      int32_t,
+      exec_return_type*,
+      const exec_arg_type<TArgs>*...>::value;
+
   // Detects if initialize() is a template method using SFINAE.
   // Template methods can match any signature via template parameter deduction,
   // causing false positives in trait detection. We probe with a dummy type
@@ -1125,6 +1138,18 @@ class UDFHolder {
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callBatch(
+      int32_t numRows,
+      exec_return_type* out,
+      const typename exec_resolver<TArgs>::in_type*... args) {
+    if constexpr (udf_has_callBatch) {
+      instance_.callBatch(numRows, out, args...);
+    } else {
+      VELOX_UNREACHABLE(
+          "callBatch should never be called if the UDF does not implement callBatch.");
+    }
+  }
+
   // Helper functions to handle void vs bool return type.
 
   FOLLY_ALWAYS_INLINE Status callImpl(
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/AdaptiveIoPlanner.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace facebook::velox::dwio::common {
+
+AdaptiveIoPlanner* AdaptiveIoPlanner::getInstance() {
+  static AdaptiveIoPlanner instance;
+  return &instance;
+}
+
+std::string AdaptiveIoPlanner::fileSystemKey(std::string_view path) {
+  const auto pos = path.find(':');
+  if (pos == std::string_view::npos || pos == 0) {
+    return "file";
+  }
+  std::string scheme(path.substr(0, pos));
+  for (auto& c : scheme) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '+' && c != '-' &&
+        c != '.') {
+      return "file";
+    }
+    c = std::tolower(static_cast<unsigned char>(c));
+  }
+  return scheme;
+}
+
+void AdaptiveIoPlanner::recordRead(
+    const std::string& fsKey,
+    uint64_t bytes,
+    uint64_t latencyUs) {
+  if (bytes == 0) {
+    return;
+  }
+  const double x = bytes;
+  const double y = latencyUs;
+  samples_.withWLock([&](auto& samples) {
+    auto& entry = samples[fsKey];
+    entry.weight = entry.weight * kDecay + 1;
+    entry.sumBytes = entry.sumBytes * kDecay + x;
+    entry.sumLatency = entry.sumLatency * kDecay + y;
+    entry.sumBytesSquare = entry.sumBytesSquare * kDecay + x * x;
+    entry.sumBytesLatency = entry.sumBytesLatency * kDecay + x * y;
+    ++entry.numSamples;
+  });
+}
+
+std::optional<AdaptiveIoPlanner::Estimate> AdaptiveIoPlanner::estimate(
+    const std::string& fsKey) const {
+  Samples entry;
+  {
+    auto samples = samples_.rlock();
+    auto it = samples->find(fsKey);
+    if (it == samples->end()) {
+      return std::nullopt;
+    }
+    entry = it->second;
+  }
+  if (entry.numSamples < kMinSamples) {
+    return std::nullopt;
+  }
+
+  const double meanBytes = entry.sumBytes / entry.weight;
+  const double meanLatency = std::max(entry.sumLatency / entry.weight, 1.0);
+  const double varianceBytes =
+      entry.sumBytesSquare / entry.weight - meanBytes * meanBytes;
+  const double covariance =
+      entry.sumBytesLatency / entry.weight - meanBytes * meanLatency;
+  // Fit latency = latencyUs + bytes / bytesPerUs. This needs some spread in
+  // the read sizes and a cost growing with the size.
+  if (varianceBytes > 0.01 * meanBytes * meanBytes && covariance > 0) {
+    const double usPerByte = covariance / varianceBytes;
+    const double latencyUs = meanLatency - usPerByte * meanBytes;
+    if (latencyUs > 0) {
+      return Estimate{latencyUs, 1 / usPerByte, entry.numSamples};
+    }
+  }
+  // The fixed and the per byte costs can't be told apart, e.g. when all the
+  // reads have about the same size. Splitting the average read time evenly
+  // between the two makes the bandwidth-delay product the average read size.
+  return Estimate{
+      meanLatency / 2, meanBytes / (meanLatency / 2), entry.numSamples};
+}
+
+int32_t AdaptiveIoPlanner::maxCoalesceDistance(
+    const std::string& fsKey,
+    int32_t configuredDistance) const {
+  const auto current = estimate(fsKey);
+  if (!current.has_value()) {
+    return configuredDistance;
+  }
+  const double distance = current->latencyUs * current->bytesPerUs;
+  return static_cast<int32_t>(std::llround(std::clamp<double>(
+      distance, kMinCoalesceDistance, kMaxCoalesceDistance)));
+}
+
+int32_t AdaptiveIoPlanner::splitPreloadDepth(
+    const std::string& fsKey,
+    int32_t configuredDepth) const {
+  const auto current = estimate(fsKey);
+  if (!current.has_value()) {
+    return configuredDepth;
+  }
+  const auto depth = std::ceil(current->latencyUs / kSplitPreloadLatencyUs);
+  return static_cast<int32_t>(
+      std::clamp<double>(depth, 1, kMaxSplitPreloadDepth));
+}
+
+void AdaptiveIoPlanner::testingClear() {
+  samples_.wlock()->clear();
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::dwio::common {
+
+/// A process-wide model of the storage read cost per file system, e.g. local
+/// disk, HDFS or an object store, learned from the storage reads issued by
+/// the readers. Each read of 'bytes' taking 'latencyUs' is modeled as a fixed
+/// request latency plus the transfer time at the storage bandwidth, and the
+/// two are fitted online with exponentially decayed least squares so that the
+/// model follows the changes in the storage behavior. The readers use the
+/// model to tune the IO plan: the max gap worth coalescing between two reads
+/// and the number of splits to preload ahead of the scan.
+class AdaptiveIoPlanner {
+ public:
+  /// Minimum number of observed reads before the planner deviates from the
+  /// configured values.
+  static constexpr uint64_t kMinSamples = 8;
+  /// Weight of the previous observations after each new one.
+  static constexpr double kDecay = 0.95;
+  /// Bounds of the tuned max coalesce distance.
+  static constexpr int32_t kMinCoalesceDistance = 16 << 10;
+  static constexpr int32_t kMaxCoalesceDistance = 16 << 20;
+  /// The request latency that a single preloaded split is expected to hide.
+  static constexpr double kSplitPreloadLatencyUs = 5'000;
+  /// Upper bound of the tuned number of splits to preload per driver.
+  static constexpr int32_t kMaxSplitPreloadDepth = 8;
+
+  struct Estimate {
+    /// Fixed cost of a read request in microseconds.
+    double latencyUs;
+    /// Transfer rate in bytes per microsecond, i.e. MB/s.
+    double bytesPerUs;
+    uint64_t numSamples;
+  };
+
+  /// Returns the process-wide instance.
+  static AdaptiveIoPlanner* getInstance();
+
+  /// Returns the key the reads of 'path' are tracked under, which is the file
+  /// system scheme, e.g. "s3" for "s3://bucket/key", or "file" for a local
+  /// path without scheme.
+  static std::string fileSystemKey(std::string_view path);
+
+  /// Records a storage read of 'bytes' which took 'latencyUs' on the file
+  /// system of 'fsKey'.
+  void recordRead(const std::string& fsKey, uint64_t bytes, uint64_t latencyUs);
+
+  /// Returns the current estimate for 'fsKey', or std::nullopt if it has fewer
+  /// than kMinSamples observed reads.
+  std::optional<Estimate> estimate(const std::string& fsKey) const;
+
+  /// Returns the max distance between two reads on 'fsKey' to coalesce them
+  /// into one. Reading the gap is cheaper than a separate request as long as
+  /// it transfers in less than the request latency, so the distance is the
+  /// bandwidth-delay product. Returns 'configuredDistance' until there are
+  /// enough observations.
+  int32_t maxCoalesceDistance(
+      const std::string& fsKey,
+      int32_t configuredDistance) const;
+
+  /// Returns the number of splits to preload per driver for the splits on
+  /// 'fsKey', which grows with the request latency so that the split open and
+  /// first reads overlap the processing of the current split. Returns
+  /// 'configuredDepth' until there are enough observations.
+  int32_t splitPreloadDepth(const std::string& fsKey, int32_t configuredDepth)
+      const;
+
+  void testingClear();
+
+ private:
+  // Exponentially decayed sums of the (bytes, latencyUs) observations.
+  struct Samples {
+    double weight{0};
+    double sumBytes{0};
+    double sumLatency{0};
+    double sumBytesSquare{0};
+    double sumBytesLatency{0};
+    uint64_t numSamples{0};
+  };
+
+  folly::Synchronized<folly::F14FastMap<std::string, Samples>> samples_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -16,6 +16,7 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/file/FileIoTracer.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -150,6 +151,25 @@ void CacheInputStream::seekToPosition(PositionProvider& seekPosition) {
   position_ = seekPosition.next();
 }
 
+namespace {
+// Keeps the cache entry of a pinned buffer view in memory.
+struct CachePinReleaser {
+  void addRef() const {}
+
+  void release() const {}
+
+  const cache::CachePin pin;
+};
+} // namespace
+
+BufferPtr CacheInputStream::pinnedBuffer() const {
+  if (pin_.empty() || run_ == nullptr) {
+    return nullptr;
+  }
+  return BufferView<CachePinReleaser>::create(
+      run_, runSize_, CachePinReleaser{pin_});
+}
+
 std::string CacheInputStream::getName() const {
   std::string result =
       fmt::format("CacheInputStream {} of {}", position_, region_.length);
@@ -319,6 +339,12 @@ bool CacheInputStream::loadFromSsd(
   pin_ = std::move(pins[0]);
   ioStats_->ssdRead().increment(region.length);
   ioStats_->queryThreadIoLatency().increment(ssdLoadUs);
+  recordIoLatency(
+      io::IoSource::kSsdCache,
+      io::IoPurpose::kData,
+      ssdLoadUs,
+      region.length,
+      ioStats_);
   // Skip no-cache retention setting as data is loaded from ssd.
   entry.setExclusiveToShared();
   return true;
@@ -56,6 +56,10 @@ class CacheInputStream : public SeekableInputStream {
   std::string getName() const override;
   size_t positionSize() const override;
 
+  /// Returns a view of the current run of the cache entry that holds a pin on
+  /// the entry. The entry stays in memory until the view is released.
+  BufferPtr pinnedBuffer() const override;
+
   /// Returns a copy of 'this', ranging over the same bytes. The clone is
   /// initially positioned at the position of 'this' and can be moved
   /// independently within 'region_'.  This is used for first caching a range of
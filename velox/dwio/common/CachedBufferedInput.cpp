@@ -16,8 +16,10 @@
 
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/common/Casts.h"
+#include "velox/common/file/FileIoTracer.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DECLARE_int32(cache_prefetch_min_pct);
@@ -190,6 +192,7 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
         request, trackingData, options_.loadQuantum(), extraRequests);
     for (auto part : parts) {
       if (cache_->exists(part->key)) {
+        recordCacheAccess(*part, cache::CacheSource::kRam, loadIndex == 1);
         continue;
       }
       if (ssdFile != nullptr) {
@@ -200,10 +203,12 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
           part->ssdPin.clear();
         }
         if (!part->ssdPin.empty()) {
+          recordCacheAccess(*part, cache::CacheSource::kSsd, loadIndex == 1);
           ssdLoad[loadIndex].push_back(part);
           continue;
         }
       }
+      recordCacheAccess(*part, cache::CacheSource::kStorage, loadIndex == 1);
       storageLoad[loadIndex].push_back(part);
     }
   }
@@ -216,6 +221,24 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
   makeLoads<true>(ssdLoad);
 }
 
+void CachedBufferedInput::recordCacheAccess(
+    const CacheRequest& request,
+    cache::CacheSource source,
+    bool prefetch) {
+  auto* groupStats = tracker_ != nullptr ? tracker_->fileGroupStats() : nullptr;
+  if (groupStats == nullptr) {
+    return;
+  }
+  groupStats->recordCacheAccess(
+      request.key.fileNum,
+      request.key.offset,
+      groupId_.id(),
+      request.trackingId,
+      request.size,
+      source,
+      prefetch);
+}
+
 template <bool kSsd>
 void CachedBufferedInput::makeLoads(std::vector<CacheRequest*> requests[2]) {
   std::vector<int32_t> groupEnds[2];
@@ -451,7 +474,18 @@ class SsdLoad : public DwioCoalescedLoadBase {
       return pins;
     }
     assert(!ssdPins.empty()); // for lint.
-    const auto stats = ssdPins[0].file()->load(ssdPins, pins);
+    uint64_t ssdLoadUs{0};
+    CoalesceIoStats stats;
+    {
+      MicrosecondTimer timer(&ssdLoadUs);
+      stats = ssdPins[0].file()->load(ssdPins, pins);
+    }
+    recordIoLatency(
+        io::IoSource::kSsdCache,
+        io::IoPurpose::kData,
+        ssdLoadUs,
+        stats.payloadBytes,
+        ioStats_.get());
     updateStats(stats, prefetch, true);
     return pins;
   }
@@ -209,6 +209,13 @@ class CachedBufferedInput : public BufferedInput {
       bool prefetch,
       const std::vector<int32_t>& groupEnds);
 
+  // Records in the FileGroupStats of 'tracker_', if any, that 'request' is
+  // served from 'source'.
+  void recordCacheAccess(
+      const CacheRequest& request,
+      cache::CacheSource source,
+      bool prefetch);
+
   template <bool kSsd>
   void makeLoads(std::vector<CacheRequest*> requests[2]);
 
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/DictionaryCache.h"
+
+namespace facebook::velox::dwio::common {
+
+std::unique_ptr<DictionaryCache> DictionaryCache::instance_ = nullptr;
+
+// static
+DictionaryCache* DictionaryCache::create(uint64_t capacityBytes) {
+  if (instance_ == nullptr) {
+    instance_ = std::make_unique<DictionaryCache>(capacityBytes);
+  }
+  return instance_.get();
+}
+
+void DictionaryCache::put(const std::string& key, Dictionary dictionary) {
+  const uint64_t sizeBytes =
+      (dictionary.values ? dictionary.values->capacity() : 0) +
+      (dictionary.strings ? dictionary.strings->capacity() : 0);
+  if (sizeBytes > maxEntryBytes()) {
+    return;
+  }
+  SharedLRUCache::put(
+      key,
+      std::make_shared<const Dictionary>(std::move(dictionary)),
+      sizeBytes);
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "velox/buffer/Buffer.h"
+#include "velox/common/caching/SharedLRUCache.h"
+
+namespace facebook::velox::dwio::common {
+
+/// A process-wide cache of decoded string dictionaries, shared by the readers
+/// of all splits of a file so that each stripe dictionary is decompressed and
+/// decoded once. Entries are keyed on the identity of the file contents, the
+/// stripe, the column and the offset of the dictionary stream. The readers
+/// decode the dictionaries they miss directly into the dedicated root memory
+/// pool of the cache, whose memory reclaimer evicts entries, so that the
+/// memory arbitrator can reclaim the cache. Entries are evicted in LRU order
+/// when their total size exceeds the capacity. The readers hold the buffers of
+/// an entry by shared pointers and must not modify them.
+class DictionaryCache : public SharedLRUCache {
+ public:
+  /// A decoded string dictionary. 'values' holds 'numValues' StringViews into
+  /// 'strings'.
+  struct Dictionary {
+    BufferPtr values;
+    BufferPtr strings;
+    int32_t numValues{0};
+    // True if 'strings' is all ASCII.
+    bool isAscii{false};
+  };
+
+  explicit DictionaryCache(uint64_t capacityBytes)
+      : SharedLRUCache(capacityBytes, "dwio.dictionaryCache") {}
+
+  /// Creates and returns the process-wide singleton instance.
+  static DictionaryCache* create(uint64_t capacityBytes);
+
+  /// Returns the process-wide singleton instance if it has been created,
+  /// nullptr otherwise.
+  static DictionaryCache* getInstance() {
+    return instance_.get();
+  }
+
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+  /// Returns the dictionary cached under 'key' or nullptr if there is none.
+  std::shared_ptr<const Dictionary> get(const std::string& key) {
+    return SharedLRUCache::get<Dictionary>(key);
+  }
+
+  /// Caches 'dictionary' under 'key' unless 'key' is already cached.
+  /// Dictionaries larger than maxEntryBytes() are not cached. The buffers of
+  /// 'dictionary' are expected to be allocated from pool().
+  void put(const std::string& key, Dictionary dictionary);
+
+  /// Upper bound on the size of the buffers of an entry.
+  uint64_t maxEntryBytes() const {
+    return capacityBytes() / kMaxEntryFraction;
+  }
+
+ private:
+  // An entry holds at most 1 / kMaxEntryFraction of the capacity.
+  static constexpr uint64_t kMaxEntryFraction = 8;
+
+  static std::unique_ptr<DictionaryCache> instance_;
+};
+
+} // namespace facebook::velox::dwio::common
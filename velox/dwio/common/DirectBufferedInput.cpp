@@ -131,7 +131,12 @@ std::vector<int32_t> DirectBufferedInput::groupRequests(
     // eligible to prefetch. This will be loaded by itself on first use.
     return {};
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  int32_t maxDistance = options_.maxCoalesceDistance();
+  if (!ioPlannerKey_.empty()) {
+    maxDistance = AdaptiveIoPlanner::getInstance()->maxCoalesceDistance(
+        ioPlannerKey_, maxDistance);
+    ioStats_->coalesceDistance().increment(maxDistance);
+  }
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
@@ -192,7 +197,8 @@ void DirectBufferedInput::readRegion(
       groupId_.id(),
       requests,
       pool_,
-      options_.loadQuantum());
+      options_.loadQuantum(),
+      ioPlannerKey_);
   coalescedLoads_.push_back(load);
   streamToCoalescedLoad_.withWLock([&](auto& loads) {
     for (auto& request : requests) {
@@ -337,6 +343,10 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
   ioStats_->incTotalScanTime(usecs * 1'000);
   ioStats_->queryThreadIoLatency().increment(usecs);
   ioStats_->incRawOverreadBytes(overread);
+  if (!ioPlannerKey_.empty()) {
+    AdaptiveIoPlanner::getInstance()->recordRead(
+        ioPlannerKey_, size + overread, usecs);
+  }
   if (prefetch) {
     ioStats_->prefetch().increment(size + overread);
   }
@@ -23,6 +23,7 @@
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
+#include "velox/dwio/common/AdaptiveIoPlanner.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/InputStream.h"
@@ -62,12 +63,14 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
       uint64_t /* groupId */,
       const std::vector<LoadRequest*>& requests,
       memory::MemoryPool* pool,
-      int32_t loadQuantum)
+      int32_t loadQuantum,
+      std::string ioPlannerKey = "")
       : CoalescedLoad({}, {}),
         ioStats_(ioStats),
         fsStats_(fsStats),
         input_(std::move(input)),
         loadQuantum_(loadQuantum),
+        ioPlannerKey_(std::move(ioPlannerKey)),
         pool_(pool) {
     VELOX_DCHECK_NOT_NULL(pool_);
     VELOX_DCHECK(
@@ -107,6 +110,9 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   const std::shared_ptr<filesystems::File::IoStats> fsStats_;
   const std::shared_ptr<ReadFileInputStream> input_;
   const int32_t loadQuantum_;
+  // The AdaptiveIoPlanner key to record the storage reads under. Empty if
+  // adaptive IO planning is disabled.
+  const std::string ioPlannerKey_;
   memory::MemoryPool* const pool_;
   std::vector<LoadRequest> requests_;
 };
@@ -142,7 +148,11 @@ class DirectBufferedInput : public BufferedInput {
         fsStats_(std::move(fsStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        ioPlannerKey_(
+            options_.adaptiveIoPlanning()
+                ? AdaptiveIoPlanner::fileSystemKey(input_->getName())
+                : "") {}
 
   ~DirectBufferedInput() override {
     for (auto& load : coalescedLoads_) {
@@ -240,7 +250,11 @@ class DirectBufferedInput : public BufferedInput {
         fsStats_(std::move(fsStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        ioPlannerKey_(
+            options_.adaptiveIoPlanning()
+                ? AdaptiveIoPlanner::fileSystemKey(input_->getName())
+                : "") {}
 
   std::vector<int32_t> groupRequests(
       const std::vector<LoadRequest*>& requests,
@@ -286,6 +300,9 @@ class DirectBufferedInput : public BufferedInput {
   folly::Executor* const executor_;
   const uint64_t fileSize_;
   const io::ReaderOptions options_;
+  // The AdaptiveIoPlanner key of the file system of 'input_'. Empty if
+  // adaptive IO planning is disabled.
+  const std::string ioPlannerKey_;
 
   // Regions that are candidates for loading.
   std::vector<LoadRequest> requests_;
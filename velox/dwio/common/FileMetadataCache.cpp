@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+namespace facebook::velox::dwio::common {
+
+std::unique_ptr<FileMetadataCache> FileMetadataCache::instance_ = nullptr;
+
+// static
+FileMetadataCache* FileMetadataCache::create(uint64_t capacityBytes) {
+  if (instance_ == nullptr) {
+    instance_ = std::make_unique<FileMetadataCache>(capacityBytes);
+  }
+  return instance_.get();
+}
+
+} // namespace facebook::velox::dwio::common
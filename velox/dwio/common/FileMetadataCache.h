@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+
+#include "velox/common/caching/SharedLRUCache.h"
+
+namespace facebook::velox::dwio::common {
+
+/// A process-wide cache of parsed file metadata, e.g. the Parquet FileMetaData
+/// or the DWRF footer, shared by the readers of all splits of a file. Entries
+/// are keyed on a string that identifies the file contents, e.g. the path with
+/// the size and modification time, and on the format, so that a changed file
+/// misses. Entries are evicted in LRU order when their total size exceeds the
+/// capacity. The readers hold the entries by shared pointers, so an eviction
+/// does not affect the readers that use the entry.
+class FileMetadataCache : public SharedLRUCache {
+ public:
+  explicit FileMetadataCache(uint64_t capacityBytes)
+      : SharedLRUCache(capacityBytes) {}
+
+  /// Creates and returns the process-wide singleton instance.
+  static FileMetadataCache* create(uint64_t capacityBytes);
+
+  /// Returns the process-wide singleton instance if it has been created,
+  /// nullptr otherwise.
+  static FileMetadataCache* getInstance() {
+    return instance_.get();
+  }
+
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+ private:
+  static std::unique_ptr<FileMetadataCache> instance_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -27,6 +27,7 @@
 #include <string_view>
 #include <type_traits>
 
+#include "velox/common/file/FileIoTracer.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -42,6 +43,21 @@ int64_t totalBufferSize(const std::vector<folly::Range<char*>>& buffers) {
   }
   return bufferSize;
 }
+
+io::IoPurpose ioPurposeOf(LogType logType) {
+  switch (logType) {
+    case LogType::HEADER:
+    case LogType::FOOTER:
+    case LogType::STRIPE_FOOTER:
+      return io::IoPurpose::kFooter;
+    case LogType::STRIPE_INDEX:
+      return io::IoPurpose::kIndex;
+    case LogType::TEST:
+      return io::IoPurpose::kOther;
+    default:
+      return io::IoPurpose::kData;
+  }
+}
 } // namespace
 
 folly::SemiFuture<uint64_t> InputStream::readAsync(
@@ -68,7 +84,8 @@ ReadFileInputStream::ReadFileInputStream(
     folly::F14FastMap<std::string, std::string> fileOpts)
     : InputStream(readFile->getName(), metricsLog, stats, fsStats),
       fileIoContext_(fsStats, std::move(fileOpts)),
-      readFile_(std::move(readFile)) {}
+      readFile_(std::move(readFile)),
+      ioSource_(io::ioSourceOf(getName())) {}
 
 void ReadFileInputStream::read(
     void* buf,
@@ -83,6 +100,7 @@ void ReadFileInputStream::read(
     MicrosecondTimer timer(&readTimeUs);
     readData = readFile_->pread(offset, length, buf, fileIoContext_);
   }
+  recordIoLatency(ioSource_, ioPurposeOf(purpose), readTimeUs, length, stats_);
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime(readTimeUs * 1'000);
@@ -104,7 +122,14 @@ void ReadFileInputStream::read(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
-  const auto size = readFile_->preadv(offset, buffers, fileIoContext_);
+  uint64_t readTimeUs{0};
+  uint64_t size;
+  {
+    MicrosecondTimer timer(&readTimeUs);
+    size = readFile_->preadv(offset, buffers, fileIoContext_);
+  }
+  recordIoLatency(
+      ioSource_, ioPurposeOf(logType), readTimeUs, bufferSize, stats_);
   VELOX_CHECK_EQ(
       size,
       bufferSize,
@@ -141,9 +166,11 @@ void ReadFileInputStream::vread(
   logRead(regions[0].offset, length, purpose);
   auto readStartMicros = getCurrentTimeMicro();
   readFile_->preadv(regions, iobufs, fileIoContext_);
+  const auto readTimeUs = getCurrentTimeMicro() - readStartMicros;
+  recordIoLatency(ioSource_, ioPurposeOf(purpose), readTimeUs, length, stats_);
   if (stats_) {
     stats_->incRawBytesRead(length);
-    stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
+    stats_->incTotalScanTime(readTimeUs * 1000);
   }
 }
 
@@ -183,6 +183,7 @@ class ReadFileInputStream final : public InputStream {
  private:
   FileIoContext fileIoContext_;
   std::shared_ptr<velox::ReadFile> readFile_;
+  const io::IoSource ioSource_;
 };
 
 } // namespace facebook::velox::dwio::common
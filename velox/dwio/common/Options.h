@@ -28,7 +28,9 @@
 #include "velox/common/io/Options.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/ColumnSelector.h"
+#include "velox/dwio/common/DictionaryCache.h"
 #include "velox/dwio/common/ErrorTolerance.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/FlatMapHelper.h"
 #include "velox/dwio/common/FlushPolicy.h"
 #include "velox/dwio/common/InputStream.h"
@@ -731,6 +733,61 @@ class ReaderOptions : public io::ReaderOptions {
     allowEmptyFile_ = value;
   }
 
+  /// If true, formats with page-level statistics (e.g. the Parquet column
+  /// index) use them to skip the pages that cannot match the scan filters.
+  /// The skipped pages are neither fetched nor decoded.
+  bool pageIndexFilterEnabled() const {
+    return pageIndexFilterEnabled_;
+  }
+
+  void setPageIndexFilterEnabled(bool value) {
+    pageIndexFilterEnabled_ = value;
+  }
+
+  /// If true, formats with dictionary-encoded column chunks (e.g. Parquet)
+  /// skip the row groups where no dictionary entry passes the scan filter.
+  bool dictionaryFilterEnabled() const {
+    return dictionaryFilterEnabled_;
+  }
+
+  void setDictionaryFilterEnabled(bool value) {
+    dictionaryFilterEnabled_ = value;
+  }
+
+  /// The cache of parsed file metadata the reader looks up and populates, or
+  /// nullptr. See FileMetadataCache.
+  FileMetadataCache* fileMetadataCache() const {
+    return fileMetadataCache_;
+  }
+
+  /// Identity of the file contents in 'fileMetadataCache'. The reader adds
+  /// its format to the key.
+  const std::string& fileMetadataCacheKey() const {
+    return fileMetadataCacheKey_;
+  }
+
+  void setFileMetadataCache(FileMetadataCache* cache, std::string key) {
+    fileMetadataCache_ = cache;
+    fileMetadataCacheKey_ = std::move(key);
+  }
+
+  /// The cache of decoded string dictionaries the reader looks up and
+  /// populates, or nullptr. See DictionaryCache.
+  DictionaryCache* dictionaryCache() const {
+    return dictionaryCache_;
+  }
+
+  /// Identity of the file contents in 'dictionaryCache'. The reader adds the
+  /// stripe, column and stream offset to the key.
+  const std::string& dictionaryCacheKey() const {
+    return dictionaryCacheKey_;
+  }
+
+  void setDictionaryCache(DictionaryCache* cache, std::string key) {
+    dictionaryCache_ = cache;
+    dictionaryCacheKey_ = std::move(key);
+  }
+
  private:
   uint64_t tailLocation_;
   FileFormat fileFormat_;
@@ -749,6 +806,12 @@ class ReaderOptions : public io::ReaderOptions {
   bool adjustTimestampToTimezone_{false};
   bool selectiveNimbleReaderEnabled_{false};
   bool allowEmptyFile_{false};
+  bool pageIndexFilterEnabled_{true};
+  bool dictionaryFilterEnabled_{true};
+  FileMetadataCache* fileMetadataCache_{nullptr};
+  std::string fileMetadataCacheKey_;
+  DictionaryCache* dictionaryCache_{nullptr};
+  std::string dictionaryCacheKey_;
 };
 
 struct WriterOptions {
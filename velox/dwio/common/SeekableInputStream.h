@@ -44,6 +44,15 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
 
   virtual bool SkipInt64(int64_t count) = 0;
 
+  /// Returns a buffer that keeps the bytes returned by the last Next() valid
+  /// and unchanged for as long as the buffer is referenced, e.g. by the string
+  /// buffers of a vector. Returns nullptr if the bytes are only valid until
+  /// the next call on 'this', e.g. when they are decompressed into a buffer
+  /// owned by the stream.
+  virtual BufferPtr pinnedBuffer() const {
+    return nullptr;
+  }
+
   bool Skip(int32_t count) final override {
     VELOX_FAIL("Use SkipInt64 instead: {}", count);
   }
@@ -15,6 +15,9 @@
  */
 
 #pragma once
+
+#include <optional>
+
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/RawVector.h"
 #include "velox/common/process/ProcessBase.h"
@@ -45,11 +48,16 @@ struct DictionaryValues {
   /// True if values are in ascending order.
   bool sorted{false};
 
+  /// For a string dictionary, whether 'strings' is all ASCII, if known. Set
+  /// on the dictionary vectors so that string functions do not scan them.
+  std::optional<bool> isAscii;
+
   void clear() {
     values = nullptr;
     strings = nullptr;
     numValues = 0;
     sorted = false;
+    isAscii = std::nullopt;
   }
 
   /// Whether the dictionary values have filter on it.
@@ -705,7 +713,8 @@ class SelectiveColumnReader {
   // Writable contents of 'stringBuffers_.back()'.
   char* rawStringBuffer_ = nullptr;
   // True if a vector can acquire a pin to a stream's buffer and refer
-  // to that as its values.
+  // to that as its values. The reader setting this must add the pinned buffer
+  // to 'stringBuffers_' before adding values that refer to it.
   bool mayUseStreamBuffer_ = false;
   // True if nulls and everything selected, so that nullsInReadRange can be
   // returned as the null flags of the vector in getValues().
@@ -743,7 +752,7 @@ class SelectiveColumnReader {
 template <>
 inline void SelectiveColumnReader::addValue(const std::string_view value) {
   const uint64_t size = value.size();
-  if (formatData().getStringBuffersFromDecoder() ||
+  if (formatData().getStringBuffersFromDecoder() || mayUseStreamBuffer_ ||
       size <= StringView::kInlineSize) {
     reinterpret_cast<StringView*>(rawValues_)[numValues_++] =
         StringView(value.data(), size);
@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 namespace {
@@ -450,7 +451,8 @@ void SelectiveStructColumnReaderBase::read(
     const auto fieldIndex = childSpec->subscript();
     auto* reader = children_.at(fieldIndex);
     if (reader->isTopLevel() && childSpec->projectOut() &&
-        !childSpec->hasFilter() && generateLazyChildren_) {
+        !childSpec->hasFilter() && generateLazyChildren_ &&
+        !parallelDecoding()) {
       // Will make a LazyVector.
       continue;
     }
@@ -472,11 +474,29 @@ void SelectiveStructColumnReaderBase::read(
       if (activeRows.empty()) {
         break;
       }
+    } else if (parallelDecoding()) {
+      deferredChildren_.push_back(reader);
     } else {
       reader->read(offset, activeRows, structNulls);
     }
   }
 
+  if (!deferredChildren_.empty()) {
+    // The children without filters do not change 'activeRows' and are read
+    // concurrently with the rows that passed all the filters.
+    if (!activeRows.empty()) {
+      ParallelFor(
+          decodingExecutor_,
+          0,
+          deferredChildren_.size(),
+          decodingParallelismFactor_)
+          .execute([&](size_t i) {
+            deferredChildren_[i]->read(offset, activeRows, structNulls);
+          });
+    }
+    deferredChildren_.clear();
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -611,7 +631,7 @@ void SelectiveStructColumnReaderBase::getValues(
     }
 
     if (childSpec->hasFilter() || !children_[index]->isTopLevel() ||
-        !generateLazyChildren_) {
+        !generateLazyChildren_ || parallelDecoding()) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 
 namespace facebook::velox::dwio::common {
@@ -104,6 +106,20 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     currentRowNumber_ = value;
   }
 
+  /// Reads the children without filters concurrently on 'executor' once the
+  /// children with filters have produced the rows to read, using up to
+  /// 'parallelismFactor' threads including the calling one. The projected top
+  /// level children are then read eagerly instead of as LazyVectors. The
+  /// child readers must not share state other than the memory pool, which
+  /// holds for the DWRF and Parquet readers since these load the streams of
+  /// a stripe or row group before reading them.
+  void setDecodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelismFactor) {
+    decodingExecutor_ = std::move(executor);
+    decodingParallelismFactor_ = parallelismFactor;
+  }
+
  protected:
   template <typename T, typename KeyNode, typename FormatData>
   friend class SelectiveFlatMapColumnReaderHelper;
@@ -174,6 +190,10 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
  private:
   void fillOutputRowsFromMutation(vector_size_t size);
 
+  bool parallelDecoding() const {
+    return decodingExecutor_ != nullptr && decodingParallelismFactor_ > 1;
+  }
+
   void setOutputRowsForLazy(const RowSet& rows) {
     if (useOutputRows() && rows.size() != outputRows_.size()) {
       setOutputRows(rows);
@@ -206,6 +226,13 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // After read() call mutation_ could go out of scope.  Need to keep this
   // around for lazy columns.
   bool hasDeletion_ = false;
+
+  std::shared_ptr<folly::Executor> decodingExecutor_;
+  size_t decodingParallelismFactor_{0};
+
+  // Children without filters to read after the children with filters when
+  // decoding in parallel. Cleared at the end of each read().
+  std::vector<SelectiveColumnReader*> deferredChildren_;
 };
 
 class SelectiveStructColumnReader : public SelectiveStructColumnReaderBase {
@@ -560,6 +560,10 @@ struct RuntimeStatistics {
   // Number of strides (row groups) processed based on statistics.
   int64_t processedStrides{0};
 
+  // Number of rows in processed strides skipped based on page-level
+  // statistics.
+  int64_t skippedPageRows{0};
+
   int64_t footerBufferOverread{0};
 
   int64_t numStripes{0};
@@ -589,6 +593,9 @@ struct RuntimeStatistics {
     if (processedStrides > 0) {
       result.emplace("processedStrides", RuntimeMetric(processedStrides));
     }
+    if (skippedPageRows > 0) {
+      result.emplace("skippedPageRows", RuntimeMetric(skippedPageRows));
+    }
     if (footerBufferOverread > 0) {
       result.emplace(
           "footerBufferOverread",
@@ -164,8 +164,7 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
 
   // perform decryption
   if (decrypter_) {
-    decryptionBuffer_ =
-        decrypter_->decrypt(std::string_view{input, remainingLength_});
+    decryptionBuffer_ = decryptBlock(input);
     input = reinterpret_cast<const char*>(decryptionBuffer_->data());
     remainingLength_ = decryptionBuffer_->length();
     if (data) {
@@ -212,6 +211,50 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+std::unique_ptr<folly::IOBuf> PagedInputStream::decryptBlock(
+    const char* input) {
+  if (!decryptedBlocks_.empty()) {
+    auto block = std::move(decryptedBlocks_.front());
+    decryptedBlocks_.pop_front();
+    if (block.headerOffset == lastHeaderOffset_) {
+      return std::move(block.data);
+    }
+    decryptedBlocks_.clear();
+  }
+
+  std::vector<std::string_view> blocks{{input, remainingLength_}};
+  std::vector<uint64_t> headerOffsets;
+  if (hasHeaders_) {
+    // The headers and blocks after the current one that are complete in the
+    // current input range can be decrypted without further reads.
+    const char* next = inputBufferPtr_;
+    uint64_t headerOffset = lastHeaderOffset_ + 3 + remainingLength_;
+    while (blocks.size() < kMaxDecryptBatchBlocks &&
+           inputBufferPtrEnd_ - next >= 3) {
+      const auto* bytes = reinterpret_cast<const uint8_t*>(next);
+      const uint32_t header = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16);
+      const size_t length = header >> 1;
+      if (length == 0 || inputBufferPtrEnd_ - next - 3 < length) {
+        break;
+      }
+      blocks.emplace_back(next + 3, length);
+      headerOffsets.push_back(headerOffset);
+      next += 3 + length;
+      headerOffset += 3 + length;
+    }
+  }
+  if (blocks.size() == 1) {
+    return decrypter_->decrypt(blocks[0]);
+  }
+
+  auto decrypted = decrypter_->decryptBatch(blocks);
+  VELOX_CHECK_EQ(decrypted.size(), blocks.size());
+  for (auto i = 1; i < decrypted.size(); ++i) {
+    decryptedBlocks_.push_back({headerOffsets[i - 1], std::move(decrypted[i])});
+  }
+  return std::move(decrypted[0]);
+}
+
 void PagedInputStream::BackUp(int32_t count) {
   VELOX_CHECK_GE(count, 0);
   if (pendingSkip_ > 0) {
@@ -266,6 +309,7 @@ bool PagedInputStream::SkipInt64(int64_t count) {
 }
 
 void PagedInputStream::clearDecompressionState() {
+  decryptedBlocks_.clear();
   state_ = State::HEADER;
   outputBufferLength_ = 0;
   remainingLength_ = 0;
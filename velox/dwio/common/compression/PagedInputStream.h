@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
 
@@ -36,6 +38,7 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
         inputBuffer_(pool_),
         decompressor_{std::move(decompressor)},
         decrypter_{decrypter},
+        hasHeaders_{!useRawDecompression},
         streamDebugInfo_{streamDebugInfo} {
     DWIO_ENSURE(
         decompressor_ || decrypter_,
@@ -93,6 +96,7 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
         inputBuffer_(pool_),
         decompressor_{nullptr},
         decrypter_{nullptr},
+        hasHeaders_{!useRawDecompression},
         streamDebugInfo_{streamDebugInfo} {
     DWIO_ENSURE(
         !useRawDecompression || compressedLength > 0,
@@ -178,8 +182,31 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   int64_t pendingSkip_{0};
 
  private:
+  // Maximum number of blocks decrypted in one Decrypter::decryptBatch() call.
+  static constexpr int32_t kMaxDecryptBatchBlocks = 8;
+
+  // A block that was decrypted together with an earlier block and whose
+  // header starts at 'headerOffset' in 'input_'.
+  struct DecryptedBlock {
+    uint64_t headerOffset;
+    std::unique_ptr<folly::IOBuf> data;
+  };
+
   bool skipAllPending();
 
+  // Returns the decryption of the current block, which starts at 'input' and
+  // has 'remainingLength_' bytes. Decrypts the next blocks that are complete
+  // in the current input range together with it.
+  std::unique_ptr<folly::IOBuf> decryptBlock(const char* input);
+
+  // True if the blocks have headers, i.e. unless the stream is a single raw
+  // block.
+  const bool hasHeaders_;
+
+  // The blocks after the current one decrypted in the same batch, in stream
+  // order.
+  std::deque<DecryptedBlock> decryptedBlocks_;
+
   // Stream Debug Info
   const std::string streamDebugInfo_;
 };
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "folly/Range.h"
 #include "folly/io/IOBuf.h"
 #include "velox/dwio/common/exception/Exception.h"
@@ -85,6 +87,19 @@ class Decrypter {
   virtual std::unique_ptr<folly::IOBuf> decrypt(
       std::string_view input) const = 0;
 
+  /// Decrypts each of 'inputs'. Providers can override this to decrypt the
+  /// blocks with multi-buffer cipher instructions or in one request. The
+  /// default decrypts them one by one.
+  virtual std::vector<std::unique_ptr<folly::IOBuf>> decryptBatch(
+      const std::vector<std::string_view>& inputs) const {
+    std::vector<std::unique_ptr<folly::IOBuf>> outputs;
+    outputs.reserve(inputs.size());
+    for (const auto& input : inputs) {
+      outputs.push_back(decrypt(input));
+    }
+    return outputs;
+  }
+
   virtual std::unique_ptr<Decrypter> clone() const = 0;
 };
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/AdaptiveIoPlanner.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+// Records reads of a range of sizes on a storage with 'latencyUs' request
+// latency and 'bytesPerUs' bandwidth.
+void recordReads(
+    AdaptiveIoPlanner& planner,
+    const std::string& fsKey,
+    double latencyUs,
+    double bytesPerUs,
+    int32_t numReads) {
+  for (auto i = 0; i < numReads; ++i) {
+    const uint64_t bytes = (64 << 10) << (i % 8);
+    planner.recordRead(fsKey, bytes, latencyUs + bytes / bytesPerUs);
+  }
+}
+
+TEST(AdaptiveIoPlannerTest, fileSystemKey) {
+  EXPECT_EQ(AdaptiveIoPlanner::fileSystemKey("s3://bucket/key"), "s3");
+  EXPECT_EQ(AdaptiveIoPlanner::fileSystemKey("S3A://bucket/key"), "s3a");
+  EXPECT_EQ(AdaptiveIoPlanner::fileSystemKey("hdfs://nn:8020/a"), "hdfs");
+  EXPECT_EQ(AdaptiveIoPlanner::fileSystemKey("file:/tmp/a"), "file");
+  EXPECT_EQ(AdaptiveIoPlanner::fileSystemKey("/tmp/a:b"), "file");
+  EXPECT_EQ(AdaptiveIoPlanner::fileSystemKey("/tmp/a"), "file");
+  EXPECT_EQ(AdaptiveIoPlanner::fileSystemKey(""), "file");
+}
+
+TEST(AdaptiveIoPlannerTest, configuredValuesUntilEnoughSamples) {
+  AdaptiveIoPlanner planner;
+  EXPECT_FALSE(planner.estimate("s3").has_value());
+  EXPECT_EQ(planner.maxCoalesceDistance("s3", 512 << 10), 512 << 10);
+  EXPECT_EQ(planner.splitPreloadDepth("s3", 2), 2);
+
+  recordReads(planner, "s3", 20'000, 100, AdaptiveIoPlanner::kMinSamples - 1);
+  EXPECT_FALSE(planner.estimate("s3").has_value());
+  EXPECT_EQ(planner.maxCoalesceDistance("s3", 512 << 10), 512 << 10);
+
+  recordReads(planner, "s3", 20'000, 100, 1);
+  EXPECT_TRUE(planner.estimate("s3").has_value());
+  // Other file systems are tracked separately.
+  EXPECT_FALSE(planner.estimate("hdfs").has_value());
+}
+
+TEST(AdaptiveIoPlannerTest, fitLatencyAndBandwidth) {
+  AdaptiveIoPlanner planner;
+  // An object store with 20ms latency at 100MB/s and a local disk with 100us
+  // latency at 2GB/s.
+  recordReads(planner, "s3", 20'000, 100, 64);
+  recordReads(planner, "file", 100, 2'000, 64);
+
+  const auto s3 = planner.estimate("s3").value();
+  EXPECT_NEAR(s3.latencyUs, 20'000, 1);
+  EXPECT_NEAR(s3.bytesPerUs, 100, 0.1);
+  EXPECT_EQ(s3.numSamples, 64);
+  EXPECT_NEAR(planner.maxCoalesceDistance("s3", 512 << 10), 2'000'000, 1'000);
+  EXPECT_EQ(planner.splitPreloadDepth("s3", 2), 4);
+
+  const auto local = planner.estimate("file").value();
+  EXPECT_NEAR(local.latencyUs, 100, 2);
+  EXPECT_NEAR(local.bytesPerUs, 2'000, 10);
+  EXPECT_NEAR(planner.maxCoalesceDistance("file", 512 << 10), 200'000, 1'000);
+  EXPECT_EQ(planner.splitPreloadDepth("file", 2), 1);
+}
+
+TEST(AdaptiveIoPlannerTest, bounds) {
+  AdaptiveIoPlanner planner;
+  recordReads(planner, "slow", 1'000'000, 1'000, 64);
+  EXPECT_EQ(
+      planner.maxCoalesceDistance("slow", 512 << 10),
+      AdaptiveIoPlanner::kMaxCoalesceDistance);
+  EXPECT_EQ(
+      planner.splitPreloadDepth("slow", 2),
+      AdaptiveIoPlanner::kMaxSplitPreloadDepth);
+
+  recordReads(planner, "fast", 10, 1'000, 64);
+  EXPECT_EQ(
+      planner.maxCoalesceDistance("fast", 512 << 10),
+      AdaptiveIoPlanner::kMinCoalesceDistance);
+  EXPECT_EQ(planner.splitPreloadDepth("fast", 2), 1);
+}
+
+TEST(AdaptiveIoPlannerTest, sameSizeReads) {
+  AdaptiveIoPlanner planner;
+  // The latency can't be told apart from the transfer time so the coalesce
+  // distance falls back to the read size.
+  for (auto i = 0; i < 16; ++i) {
+    planner.recordRead("hdfs", 1 << 20, 4'000);
+  }
+  EXPECT_EQ(planner.maxCoalesceDistance("hdfs", 512 << 10), 1 << 20);
+  EXPECT_EQ(planner.splitPreloadDepth("hdfs", 2), 1);
+}
+
+TEST(AdaptiveIoPlannerTest, followsLatencyChanges) {
+  AdaptiveIoPlanner planner;
+  recordReads(planner, "s3", 50'000, 100, 64);
+  EXPECT_EQ(planner.splitPreloadDepth("s3", 2), 8);
+
+  // The old observations decay away once the storage gets faster.
+  recordReads(planner, "s3", 4'000, 100, 256);
+  EXPECT_NEAR(planner.estimate("s3")->latencyUs, 4'000, 10);
+  EXPECT_EQ(planner.splitPreloadDepth("s3", 2), 1);
+
+  planner.testingClear();
+  EXPECT_FALSE(planner.estimate("s3").has_value());
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
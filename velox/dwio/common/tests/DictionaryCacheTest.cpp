@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/DictionaryCache.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+class DictionaryCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  // Returns a dictionary of 'numValues' empty strings allocated from the pool
+  // of 'cache'.
+  static DictionaryCache::Dictionary makeDictionary(
+      DictionaryCache& cache,
+      int32_t numValues) {
+    DictionaryCache::Dictionary dictionary;
+    dictionary.values =
+        AlignedBuffer::allocate<StringView>(numValues, cache.pool());
+    dictionary.strings = AlignedBuffer::allocate<char>(0, cache.pool());
+    dictionary.numValues = numValues;
+    return dictionary;
+  }
+
+  static uint64_t sizeOf(const DictionaryCache::Dictionary& dictionary) {
+    return dictionary.values->capacity() + dictionary.strings->capacity();
+  }
+};
+
+TEST_F(DictionaryCacheTest, getAndPut) {
+  DictionaryCache cache(1 << 20);
+  EXPECT_EQ(cache.get("a"), nullptr);
+
+  auto dictionary = makeDictionary(cache, 10);
+  const auto* values = dictionary.values.get();
+  const auto sizeBytes = sizeOf(dictionary);
+  cache.put("a", std::move(dictionary));
+  auto cached = cache.get("a");
+  ASSERT_NE(cached, nullptr);
+  EXPECT_EQ(cached->values.get(), values);
+  EXPECT_EQ(cached->numValues, 10);
+  EXPECT_GT(cache.pool()->usedBytes(), 0);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 1);
+  EXPECT_EQ(stats.sizeBytes, sizeBytes);
+  EXPECT_EQ(stats.numLookups, 2);
+  EXPECT_EQ(stats.numHits, 1);
+}
+
+TEST_F(DictionaryCacheTest, lruEviction) {
+  uint64_t sizeBytes;
+  {
+    DictionaryCache probe(1 << 20);
+    sizeBytes = sizeOf(makeDictionary(probe, 1'000));
+  }
+  // Fits 9 entries.
+  DictionaryCache cache(9 * sizeBytes);
+  ASSERT_GE(cache.maxEntryBytes(), sizeBytes);
+  for (auto i = 0; i < 9; ++i) {
+    cache.put(std::to_string(i), makeDictionary(cache, 1'000));
+  }
+  // Makes '1' the least recently used entry.
+  ASSERT_NE(cache.get("0"), nullptr);
+  cache.put("9", makeDictionary(cache, 1'000));
+  EXPECT_EQ(cache.get("1"), nullptr);
+  EXPECT_NE(cache.get("0"), nullptr);
+  EXPECT_NE(cache.get("9"), nullptr);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 9);
+  EXPECT_EQ(stats.sizeBytes, 9 * sizeBytes);
+  EXPECT_EQ(stats.numEvictions, 1);
+}
+
+TEST_F(DictionaryCacheTest, tooLarge) {
+  DictionaryCache cache(1 << 10);
+  cache.put("a", makeDictionary(cache, 1'000));
+  EXPECT_EQ(cache.get("a"), nullptr);
+  EXPECT_EQ(cache.stats().numEntries, 0);
+}
+
+TEST_F(DictionaryCacheTest, shrink) {
+  DictionaryCache cache(1 << 20);
+  cache.put("a", makeDictionary(cache, 100));
+  cache.put("b", makeDictionary(cache, 100));
+  auto held = cache.get("a");
+  EXPECT_GT(cache.shrink(1), 0);
+  EXPECT_EQ(cache.stats().numEntries, 1);
+  EXPECT_EQ(cache.get("b"), nullptr);
+
+  cache.clear();
+  EXPECT_EQ(cache.stats().numEntries, 0);
+  EXPECT_EQ(cache.stats().sizeBytes, 0);
+  // An evicted dictionary stays valid for its holders.
+  EXPECT_EQ(held->numValues, 100);
+  held.reset();
+  EXPECT_EQ(cache.pool()->usedBytes(), 0);
+}
+
+TEST_F(DictionaryCacheTest, singleton) {
+  EXPECT_EQ(DictionaryCache::getInstance(), nullptr);
+  auto* cache = DictionaryCache::create(100);
+  EXPECT_EQ(DictionaryCache::getInstance(), cache);
+  DictionaryCache::testingClear();
+  EXPECT_EQ(DictionaryCache::getInstance(), nullptr);
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
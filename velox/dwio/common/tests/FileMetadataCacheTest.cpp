@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+std::shared_ptr<const void> makeValue(int64_t value) {
+  return std::make_shared<const int64_t>(value);
+}
+
+TEST(FileMetadataCacheTest, getAndPut) {
+  FileMetadataCache cache(100);
+  EXPECT_EQ(cache.get<int64_t>("a"), nullptr);
+
+  cache.put("a", makeValue(1), 10);
+  cache.put("b", makeValue(2), 20);
+  EXPECT_EQ(*cache.get<int64_t>("a"), 1);
+  EXPECT_EQ(*cache.get<int64_t>("b"), 2);
+
+  // The first metadata cached for a file stays.
+  EXPECT_FALSE(cache.put("a", makeValue(3), 30));
+  EXPECT_EQ(*cache.get<int64_t>("a"), 1);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 2);
+  EXPECT_EQ(stats.sizeBytes, 30);
+  EXPECT_EQ(stats.numLookups, 4);
+  EXPECT_EQ(stats.numHits, 3);
+  EXPECT_EQ(stats.numEvictions, 0);
+}
+
+TEST(FileMetadataCacheTest, lruEviction) {
+  FileMetadataCache cache(100);
+  cache.put("a", makeValue(1), 40);
+  cache.put("b", makeValue(2), 40);
+  auto held = cache.get<int64_t>("b");
+  // Makes 'b' the least recently used entry.
+  ASSERT_NE(cache.get<int64_t>("a"), nullptr);
+
+  cache.put("c", makeValue(3), 40);
+  EXPECT_EQ(cache.get<int64_t>("b"), nullptr);
+  EXPECT_EQ(*cache.get<int64_t>("a"), 1);
+  EXPECT_EQ(*cache.get<int64_t>("c"), 3);
+  // An evicted entry stays valid for its holders.
+  EXPECT_EQ(*held, 2);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 2);
+  EXPECT_EQ(stats.sizeBytes, 80);
+  EXPECT_EQ(stats.numEvictions, 1);
+}
+
+TEST(FileMetadataCacheTest, tooLarge) {
+  FileMetadataCache cache(100);
+  cache.put("a", makeValue(1), 40);
+  cache.put("b", makeValue(2), 101);
+  EXPECT_EQ(cache.get<int64_t>("b"), nullptr);
+  EXPECT_EQ(*cache.get<int64_t>("a"), 1);
+  EXPECT_EQ(cache.stats().numEvictions, 0);
+}
+
+TEST(FileMetadataCacheTest, clear) {
+  FileMetadataCache cache(100);
+  cache.put("a", makeValue(1), 40);
+  cache.put("b", makeValue(2), 40);
+  cache.clear();
+  EXPECT_EQ(cache.get<int64_t>("a"), nullptr);
+  EXPECT_EQ(cache.stats().numEntries, 0);
+  EXPECT_EQ(cache.stats().sizeBytes, 0);
+
+  cache.put("a", makeValue(3), 100);
+  EXPECT_EQ(*cache.get<int64_t>("a"), 3);
+}
+
+TEST(FileMetadataCacheTest, singleton) {
+  EXPECT_EQ(FileMetadataCache::getInstance(), nullptr);
+  auto* cache = FileMetadataCache::create(100);
+  EXPECT_EQ(FileMetadataCache::getInstance(), cache);
+  FileMetadataCache::testingClear();
+  EXPECT_EQ(FileMetadataCache::getInstance(), nullptr);
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Sweeps the selective column readers over file format x type x encoding x
+// filter selectivity x null ratio and reports the decode throughput of each
+// combination in rows/s and file bytes/s. The files are generated with
+// VectorFuzzer from a fixed number of distinct values per column so that the
+// dictionary encodings apply when enabled.
+
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <iostream>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/File.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/common/tests/utils/FilterGenerator.h"
+#include "velox/dwio/dwrf/RegisterDwrfReader.h"
+#include "velox/dwio/dwrf/RegisterDwrfWriter.h"
+#include "velox/dwio/dwrf/common/Config.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+#ifdef VELOX_ENABLE_PARQUET
+#include "velox/dwio/parquet/RegisterParquetReader.h"
+#include "velox/dwio/parquet/RegisterParquetWriter.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#endif
+
+DEFINE_string(formats, "dwrf,parquet", "File formats to benchmark");
+DEFINE_string(
+    types,
+    "integer,bigint,double,varchar",
+    "Column types to benchmark");
+DEFINE_string(
+    encodings,
+    "dictionary,plain",
+    "Encodings to benchmark. 'dictionary' enables the dictionary encodings "
+    "of the writer and 'plain' disables them");
+DEFINE_string(
+    selectivities,
+    "100,50,10,1",
+    "Percentages of the rows passing the filter. 100 reads without a filter");
+DEFINE_string(null_ratios, "0,0.2,0.5", "Ratios of null values");
+DEFINE_int32(num_rows, 1'000'000, "Number of rows per file");
+DEFINE_int32(rows_per_batch, 10'000, "Number of rows per written batch");
+DEFINE_int32(read_batch_size, 10'000, "Number of rows per read batch");
+DEFINE_int32(num_distinct, 1'000, "Number of distinct values per column");
+DEFINE_int32(num_iterations, 3, "Reads per combination. The fastest is kept");
+DEFINE_int32(seed, 1, "Seed of the data generation");
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> values;
+  folly::split(',', list, values, true);
+  return values;
+}
+
+TypePtr parseType(const std::string& name) {
+  if (name == "integer") {
+    return INTEGER();
+  }
+  if (name == "bigint") {
+    return BIGINT();
+  }
+  if (name == "double") {
+    return DOUBLE();
+  }
+  if (name == "varchar") {
+    return VARCHAR();
+  }
+  VELOX_USER_FAIL("Unsupported type: {}", name);
+}
+
+FilterKind filterKind(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return FilterKind::kBigintRange;
+    case TypeKind::DOUBLE:
+      return FilterKind::kDoubleRange;
+    case TypeKind::VARCHAR:
+      return FilterKind::kBytesRange;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+struct Result {
+  uint64_t bestMicros{std::numeric_limits<uint64_t>::max()};
+  uint64_t numOutputRows{0};
+};
+
+class SelectiveReaderBenchmark {
+ public:
+  SelectiveReaderBenchmark()
+      : rootPool_(memory::memoryManager()->addRootPool("readerBenchmark")),
+        pool_(rootPool_->addLeafChild("readerBenchmark")),
+        tempDir_(exec::test::TempDirectoryPath::create()) {}
+
+  void run(std::ostream& out) {
+    out << fmt::format(
+               "{:<8} {:<8} {:<10} {:>5} {:>5} {:>12} {:>12} {:>10} {:>10}",
+               "format",
+               "type",
+               "encoding",
+               "sel%",
+               "null%",
+               "Mrows/s",
+               "bytes/s",
+               "out rows",
+               "time")
+        << std::endl;
+    for (const auto& formatName : splitList(FLAGS_formats)) {
+      const auto format = toFileFormat(formatName);
+      if (!hasWriterFactory(format)) {
+        LOG(WARNING) << "Skipping unsupported format " << formatName;
+        continue;
+      }
+      for (const auto& typeName : splitList(FLAGS_types)) {
+        const auto type = parseType(typeName);
+        for (const auto& encoding : splitList(FLAGS_encodings)) {
+          VELOX_USER_CHECK(
+              encoding == "dictionary" || encoding == "plain",
+              "Unsupported encoding: {}",
+              encoding);
+          for (const auto& nullRatio : splitList(FLAGS_null_ratios)) {
+            runFile(
+                out,
+                format,
+                type,
+                encoding == "dictionary",
+                folly::to<double>(nullRatio));
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  // Writes a file for one combination of format, type, encoding and null
+  // ratio, and reads it once per selectivity.
+  void runFile(
+      std::ostream& out,
+      FileFormat format,
+      const TypePtr& type,
+      bool dictionary,
+      double nullRatio) {
+    auto rowType = ROW({"c0"}, {type});
+    const auto batches = makeBatches(rowType, nullRatio);
+    const auto path = fmt::format(
+        "{}/{}_{}_{}_{}",
+        tempDir_->getPath(),
+        toString(format),
+        type->toString(),
+        dictionary,
+        nullRatio);
+    writeFile(path, format, rowType, dictionary, batches);
+    const auto fileSize = LocalReadFile(path).size();
+
+    for (const auto& selectivity : splitList(FLAGS_selectivities)) {
+      const auto selectPct = folly::to<float>(selectivity);
+      std::vector<FilterSpec> filterSpecs;
+      if (selectPct < 100) {
+        filterSpecs.emplace_back(
+            "c0", 0, selectPct, filterKind(type), false, false);
+      }
+      FilterGenerator filterGenerator(rowType, FLAGS_seed);
+      std::vector<uint64_t> hitRows;
+      auto filters = filterGenerator.makeSubfieldFilters(
+          filterSpecs, batches, nullptr, hitRows);
+      auto scanSpec = filterGenerator.makeScanSpec(std::move(filters));
+
+      Result result;
+      for (auto i = 0; i < FLAGS_num_iterations; ++i) {
+        const auto startTime = std::chrono::steady_clock::now();
+        result.numOutputRows = readFile(path, format, rowType, scanSpec);
+        const uint64_t micros =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - startTime)
+                .count();
+        result.bestMicros = std::min(result.bestMicros, micros);
+      }
+
+      const auto seconds = std::max<uint64_t>(result.bestMicros, 1) / 1e6;
+      out << fmt::format(
+                 "{:<8} {:<8} {:<10} {:>5} {:>5} {:>12} {:>12} {:>10} {:>10}",
+                 toString(format),
+                 type->toString(),
+                 dictionary ? "dictionary" : "plain",
+                 selectivity,
+                 nullRatio * 100,
+                 fmt::format("{:.2f}", FLAGS_num_rows / seconds / 1e6),
+                 succinctBytes(fileSize / seconds),
+                 result.numOutputRows,
+                 succinctMicros(result.bestMicros))
+          << std::endl;
+    }
+  }
+
+  // Makes batches of 'rowType' drawing the values from FLAGS_num_distinct
+  // values generated by VectorFuzzer.
+  std::vector<RowVectorPtr> makeBatches(
+      const RowTypePtr& rowType,
+      double nullRatio) {
+    VectorFuzzer::Options options;
+    options.vectorSize = FLAGS_num_distinct;
+    options.nullRatio = 0;
+    options.stringLength = 20;
+    options.stringVariableLength = true;
+    VectorFuzzer fuzzer(options, pool_.get(), FLAGS_seed);
+    const auto values = fuzzer.fuzzFlat(rowType->childAt(0));
+
+    folly::Random::DefaultGenerator rng(FLAGS_seed);
+    std::vector<RowVectorPtr> batches;
+    for (auto row = 0; row < FLAGS_num_rows; row += FLAGS_rows_per_batch) {
+      const auto size = std::min(FLAGS_rows_per_batch, FLAGS_num_rows - row);
+      auto indices = allocateIndices(size, pool_.get());
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      auto nulls = allocateNulls(size, pool_.get());
+      auto* rawNulls = nulls->asMutable<uint64_t>();
+      for (auto i = 0; i < size; ++i) {
+        rawIndices[i] = folly::Random::rand32(FLAGS_num_distinct, rng);
+        bits::setNull(
+            rawNulls, i, folly::Random::randDouble01(rng) < nullRatio);
+      }
+      auto column = BaseVector::create(values->type(), size, pool_.get());
+      column->copy(
+          BaseVector::wrapInDictionary(nulls, indices, size, values).get(),
+          0,
+          0,
+          size);
+      batches.push_back(std::make_shared<RowVector>(
+          pool_.get(),
+          rowType,
+          nullptr,
+          size,
+          std::vector<VectorPtr>{std::move(column)}));
+    }
+    return batches;
+  }
+
+  void writeFile(
+      const std::string& path,
+      FileFormat format,
+      const RowTypePtr& rowType,
+      bool dictionary,
+      const std::vector<RowVectorPtr>& batches) {
+    auto factory = getWriterFactory(format);
+    std::shared_ptr<WriterOptions> options = factory->createWriterOptions();
+    options->schema = rowType;
+    options->memoryPool = rootPool_.get();
+    const auto enabled = dictionary ? "true" : "false";
+    std::unordered_map<std::string, std::string> configs{
+        {dwrf::Config::kOrcWriterIntegerDictionaryEncodingEnabled, enabled},
+        {dwrf::Config::kOrcWriterStringDictionaryEncodingEnabled, enabled}};
+#ifdef VELOX_ENABLE_PARQUET
+    configs.emplace(
+        parquet::WriterOptions::kParquetHiveConnectorEnableDictionary, enabled);
+#endif
+    options->processConfigs(
+        config::ConfigBase(std::move(configs)), config::ConfigBase({}));
+
+    auto sink = std::make_unique<WriteFileSink>(
+        std::make_unique<LocalWriteFile>(path, true, false), path);
+    auto writer = factory->createWriter(std::move(sink), options);
+    for (const auto& batch : batches) {
+      writer->write(batch);
+    }
+    writer->close();
+  }
+
+  // Reads the file at 'path' with 'scanSpec' and returns the number of rows
+  // passing the filter.
+  uint64_t readFile(
+      const std::string& path,
+      FileFormat format,
+      const RowTypePtr& rowType,
+      const std::shared_ptr<ScanSpec>& scanSpec) {
+    ReaderOptions readerOptions{pool_.get()};
+    readerOptions.setFileFormat(format);
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<LocalReadFile>(path), *pool_);
+    auto reader = getReaderFactory(format)->createReader(
+        std::move(input), readerOptions);
+
+    RowReaderOptions rowReaderOptions;
+    rowReaderOptions.select(
+        std::make_shared<ColumnSelector>(rowType, rowType->names()));
+    rowReaderOptions.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOptions);
+
+    VectorPtr result = BaseVector::create(rowType, 0, pool_.get());
+    uint64_t numRows = 0;
+    while (rowReader->next(FLAGS_read_batch_size, result)) {
+      auto* rowVector = result->asUnchecked<RowVector>();
+      rowVector->childAt(0)->loadedVector();
+      numRows += rowVector->size();
+    }
+    return numRows;
+  }
+
+  const std::shared_ptr<memory::MemoryPool> rootPool_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const std::shared_ptr<exec::test::TempDirectoryPath> tempDir_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize(memory::MemoryManager::Options{});
+  dwrf::registerDwrfReaderFactory();
+  dwrf::registerDwrfWriterFactory();
+#ifdef VELOX_ENABLE_PARQUET
+  parquet::registerParquetReaderFactory();
+  parquet::registerParquetWriterFactory();
+#endif
+  SelectiveReaderBenchmark().run(std::cout);
+  return 0;
+}
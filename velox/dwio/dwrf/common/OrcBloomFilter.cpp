@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/OrcBloomFilter.h"
+
+#include <cstring>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwrf {
+namespace {
+
+// Seed and constants of the Murmur3 64 bit hash of the ORC writer.
+constexpr uint64_t kMurmurSeed = 104729;
+constexpr uint64_t kC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kC2 = 0x4cf5ad432745937fULL;
+constexpr uint64_t kM = 5;
+constexpr uint64_t kN1 = 0x52dce729;
+
+inline uint64_t rotateLeft(uint64_t value, int32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t mixK(uint64_t k) {
+  return rotateLeft(k * kC1, 31) * kC2;
+}
+
+inline uint64_t fmix64(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Java's arithmetic right shift of a long.
+inline uint64_t shiftRight(uint64_t value, int32_t shift) {
+  return static_cast<uint64_t>(static_cast<int64_t>(value) >> shift);
+}
+
+} // namespace
+
+OrcBloomFilter::OrcBloomFilter(const proto::orc::BloomFilter& bloomFilter)
+    : numHashFunctions_(bloomFilter.numhashfunctions()) {
+  if (bloomFilter.has_utf8bitset()) {
+    // The bit set of BLOOM_FILTER_UTF8 is serialized as little endian longs.
+    const auto& bytes = bloomFilter.utf8bitset();
+    VELOX_CHECK_EQ(
+        bytes.size() % sizeof(uint64_t), 0, "Malformed ORC bloom filter");
+    bits_.resize(bytes.size() / sizeof(uint64_t));
+    ::memcpy(bits_.data(), bytes.data(), bytes.size());
+  } else {
+    bits_.assign(bloomFilter.bitset().begin(), bloomFilter.bitset().end());
+  }
+}
+
+OrcBloomFilter::OrcBloomFilter(uint64_t numBits, uint32_t numHashFunctions)
+    : numHashFunctions_(numHashFunctions), bits_((numBits + 63) / 64) {
+  VELOX_CHECK_GT(numBits, 0);
+}
+
+// static
+uint64_t OrcBloomFilter::longHash(int64_t value) {
+  auto key = static_cast<uint64_t>(value);
+  key = ~key + (key << 21);
+  key = key ^ shiftRight(key, 24);
+  key = (key + (key << 3)) + (key << 8);
+  key = key ^ shiftRight(key, 14);
+  key = (key + (key << 2)) + (key << 4);
+  key = key ^ shiftRight(key, 28);
+  key = key + (key << 31);
+  return key;
+}
+
+// static
+uint64_t OrcBloomFilter::murmur3Hash64(std::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const auto length = value.size();
+  uint64_t hash = kMurmurSeed;
+  const auto numBlocks = length / 8;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    uint64_t k = 0;
+    for (auto j = 8; j > 0; --j) {
+      k = (k << 8) | data[i * 8 + j - 1];
+    }
+    hash ^= mixK(k);
+    hash = rotateLeft(hash, 27) * kM + kN1;
+  }
+  const auto tailStart = numBlocks * 8;
+  if (tailStart < length) {
+    uint64_t k = 0;
+    for (auto j = length; j > tailStart; --j) {
+      k = (k << 8) | data[j - 1];
+    }
+    hash ^= mixK(k);
+  }
+  hash ^= length;
+  return fmix64(hash);
+}
+
+void OrcBloomFilter::addHash(uint64_t hash) {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = this->numBits();
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto position = combined % numBits;
+    bits_[position / 64] |= 1ULL << (position % 64);
+  }
+}
+
+bool OrcBloomFilter::testHash(uint64_t hash) const {
+  const auto numBits = this->numBits();
+  if (numBits == 0) {
+    return true;
+  }
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto position = combined % numBits;
+    if ((bits_[position / 64] & (1ULL << (position % 64))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::dwrf
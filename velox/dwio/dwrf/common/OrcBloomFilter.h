@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/orc-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+/// The bloom filter of a row group of an ORC column, as read from a
+/// BLOOM_FILTER_UTF8 stream. Hashes values the way the ORC writer does:
+/// integers, dates and the bits of floating point values with Thomas Wang's
+/// 64 bit integer hash, strings and binaries with the 64 bit Murmur3 hash of
+/// their bytes. The k hash functions are derived from the two halves of the
+/// 64 bit hash.
+class OrcBloomFilter {
+ public:
+  explicit OrcBloomFilter(const proto::orc::BloomFilter& bloomFilter);
+
+  /// Creates an empty filter of at least 'numBits' bits.
+  OrcBloomFilter(uint64_t numBits, uint32_t numHashFunctions);
+
+  void addLong(int64_t value) {
+    addHash(longHash(value));
+  }
+
+  void addBytes(std::string_view value) {
+    addHash(murmur3Hash64(value));
+  }
+
+  /// Returns false if 'value' is definitely not in the filter.
+  bool testLong(int64_t value) const {
+    return testHash(longHash(value));
+  }
+
+  bool testBytes(std::string_view value) const {
+    return testHash(murmur3Hash64(value));
+  }
+
+  uint64_t numBits() const {
+    return bits_.size() * 64;
+  }
+
+  uint32_t numHashFunctions() const {
+    return numHashFunctions_;
+  }
+
+  static uint64_t longHash(int64_t value);
+
+  static uint64_t murmur3Hash64(std::string_view value);
+
+ private:
+  void addHash(uint64_t hash);
+
+  bool testHash(uint64_t hash) const;
+
+  uint32_t numHashFunctions_;
+  std::vector<uint64_t> bits_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -19,9 +19,12 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
+#include <folly/lang/Bits.h>
+
 #include <vector>
 
 namespace facebook::velox::dwrf {
@@ -62,6 +65,11 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     skipPending();
+    if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      fastPath<hasNulls>(nulls, visitor);
+      return;
+    }
+
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
 
@@ -100,6 +108,119 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    if (hasNulls) {
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            folly::Range<const int32_t*>(rows, outerVector->size()),
+            outerVector->data(),
+            visitor);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        int32_t tailSkip = -1;
+        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
+             !hasFilter &&
+            !hasHook >
+                (nulls,
+                 rowsAsRange,
+                 *innerVector,
+                 *outerVector,
+                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                 tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          this->template skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            *innerVector, outerVector->data(), visitor);
+        this->template skip<false>(tailSkip, 0, nullptr);
+      }
+    } else {
+      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
+    }
+  }
+
+  // Decodes the values at 'nonNullRows' in one pass and then filters them
+  // and stores the results with 'visitor'. The row numbers are relative to
+  // the current position in the non-null values of the stream.
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void bulkScan(
+      folly::Range<const int32_t*> nonNullRows,
+      const int32_t* scatterRows,
+      Visitor& visitor) {
+    const auto numAllRows = visitor.numRows();
+    visitor.setRows(nonNullRows);
+    const auto numRows = visitor.numRows();
+    auto values = visitor.rawValues(numRows);
+    auto filterHits = hasFilter ? visitor.outputRows(numRows) : nullptr;
+    int32_t numValues = 0;
+    if (Visitor::dense) {
+      readValues(numRows, values);
+    } else {
+      readRows(nonNullRows, values);
+    }
+    visitor.template processRun<hasFilter, hasHook, scatter>(
+        values, numRows, scatterRows, filterHits, values, numValues);
+    visitor.setNumValues(hasFilter ? numValues : numAllRows);
+  }
+
+  // Reads the next 'numValues' values into 'result'.
+  template <typename T>
+  void readValues(int32_t numValues, T* result) {
+    if constexpr (sizeof(T) == sizeof(int64_t)) {
+      next(reinterpret_cast<int64_t*>(result), numValues, nullptr);
+    } else {
+      constexpr int32_t kBatch = 64;
+      int64_t buffer[kBatch];
+      for (int32_t i = 0; i < numValues; i += kBatch) {
+        const auto numRead = std::min(kBatch, numValues - i);
+        next(buffer, numRead, nullptr);
+        for (auto j = 0; j < numRead; ++j) {
+          result[i + j] = buffer[j];
+        }
+      }
+    }
+  }
+
+  // Reads the values at 'rows' into 'result'. The first row is the next
+  // value of the stream. Consecutive rows are read together.
+  template <typename T>
+  void readRows(folly::Range<const int32_t*> rows, T* result) {
+    int32_t row = 0;
+    int32_t i = 0;
+    while (i < rows.size()) {
+      if (rows[i] > row) {
+        this->template skip<false>(rows[i] - row, 0, nullptr);
+      }
+      auto end = i + 1;
+      while (end < rows.size() && rows[end] == rows[end - 1] + 1) {
+        ++end;
+      }
+      readValues(end - i, result + i);
+      row = rows[end - 1] + 1;
+      i = end;
+    }
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap_ = static_cast<uint64_t>(unpackedPatch_[patchIdx_]) >> patchBitSize_;
@@ -161,11 +282,19 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
     uint64_t ret = 0;
-
-    // TODO: unroll to improve performance
-    for (uint64_t i = offset; i < (offset + len); i++) {
-      // skip null positions
-      if (nulls && bits::isBitNull(nulls, i)) {
+    const auto end = offset + len;
+    for (uint64_t i = offset; i < end; i++) {
+      if (!nulls) {
+        // Unpacks what is in the current buffer at once and reads the
+        // values that span buffers bit by bit.
+        const auto numUnpacked = unpackLongs(data + i, end - i, fb);
+        i += numUnpacked;
+        ret += numUnpacked;
+        if (i == end) {
+          break;
+        }
+      } else if (bits::isBitNull(nulls, i)) {
+        // skip null positions
         continue;
       }
       uint64_t result = 0;
@@ -191,6 +320,46 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Unpacks up to 'len' values of 'fb' bits into 'data' with one 8 byte load
+  // per value while the bits are in the current buffer. Leaves the stream
+  // positioned as readLongs() would. Returns the number of values unpacked.
+  uint64_t unpackLongs(int64_t* data, uint64_t len, uint64_t fb) {
+    auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart_;
+    const auto* bufferEnd = dwio::common::IntDecoder<isSigned>::bufferEnd_;
+    // A value of more than 56 bits may span 9 bytes if it is not aligned.
+    if (fb == 0 || (fb > 56 && (fb != 64 || bitsLeft_ != 0)) ||
+        bufferStart == nullptr) {
+      return 0;
+    }
+    // The unread bits of 'curByte_' are the low bits of the byte before
+    // 'bufferStart'.
+    const char* base = bitsLeft_ > 0 ? bufferStart - 1 : bufferStart;
+    uint64_t bitOffset = bitsLeft_ > 0 ? 8 - bitsLeft_ : 0;
+    const uint64_t numBytes = bufferEnd - base;
+    uint64_t numUnpacked = 0;
+    while (numUnpacked < len && (bitOffset >> 3) + 8 <= numBytes) {
+      const auto word = folly::Endian::big(
+          folly::loadUnaligned<uint64_t>(base + (bitOffset >> 3)));
+      data[numUnpacked++] =
+          static_cast<int64_t>((word << (bitOffset & 7)) >> (64 - fb));
+      bitOffset += fb;
+    }
+    if (numUnpacked == 0) {
+      return 0;
+    }
+    base += bitOffset >> 3;
+    const auto bitsUsed = bitOffset & 7;
+    if (bitsUsed == 0) {
+      bufferStart = base;
+      bitsLeft_ = 0;
+    } else {
+      curByte_ = static_cast<unsigned char>(*base);
+      bufferStart = base + 1;
+      bitsLeft_ = 8 - bitsUsed;
+    }
+    return numUnpacked;
+  }
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
@@ -19,15 +19,58 @@
 #include "velox/dwio/common/BufferUtil.h"
 
 namespace facebook::velox::dwrf {
+namespace {
+
+// True if the ORC writer hashes the values of 'type' into the bloom filter
+// with the representation of the values of the filters in the ScanSpec.
+// Decimals and timestamps are hashed as strings.
+bool isBloomFilterApplicable(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !type.isDecimal();
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// True if 'filter' passes a finite set of values and no nulls, so that it can
+// be tested against a bloom filter.
+bool isPointFilter(const common::Filter& filter) {
+  if (filter.testNull()) {
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return filter.as<common::BigintRange>()->isSingleValue();
+    case common::FilterKind::kBytesRange:
+      return filter.as<common::BytesRange>()->isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+    case common::FilterKind::kBytesValues:
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
 
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
-    FlatMapContext flatMapContext)
+    FlatMapContext flatMapContext,
+    bool readBloomFilters)
     : memoryPool_(stripe.getMemoryPool()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
+      format_(stripe.format()),
       stripeRows_{stripe.stripeRows()},
       rowsPerRowGroup_{stripe.rowsPerRowGroup()} {
   EncodingKey encodingKey{fileType_->id(), flatMapContext_.sequence};
@@ -55,6 +98,15 @@ DwrfData::DwrfData(
           proto::orc::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+
+  // Hive writes ORC bloom filters next to the row group index for the columns
+  // in orc.bloom.filter.columns.
+  if (readBloomFilters && format_ == DwrfFormat::kOrc) {
+    bloomFilterStream_ = stripe.getStream(
+        encodingKey.forKind(proto::orc::Stream_Kind_BLOOM_FILTER_UTF8),
+        streamLabels.label(),
+        false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -93,17 +145,39 @@ uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
 }
 
 void DwrfData::ensureRowGroupIndex() {
-  VELOX_CHECK(index_ || indexStream_, "Reader needs to have an index stream");
-  if (indexStream_) {
+  VELOX_CHECK(
+      index_ || orcIndex_ || indexStream_,
+      "Reader needs to have an index stream");
+  if (!indexStream_) {
+    return;
+  }
+  if (format_ == DwrfFormat::kDwrf) {
     index_ = ProtoUtils::readProto<proto::RowIndex>(std::move(indexStream_));
+  } else {
+    orcIndex_ =
+        ProtoUtils::readProto<proto::orc::RowIndex>(std::move(indexStream_));
+  }
+}
+
+void DwrfData::ensureBloomFilters() {
+  if (!bloomFilterStream_) {
+    return;
+  }
+  auto bloomFilterIndex = ProtoUtils::readProto<proto::orc::BloomFilterIndex>(
+      std::move(bloomFilterStream_));
+  bloomFilters_.reserve(bloomFilterIndex->bloomfilter_size());
+  for (const auto& bloomFilter : bloomFilterIndex->bloomfilter()) {
+    bloomFilters_.emplace_back(bloomFilter);
   }
 }
 
 dwio::common::PositionProvider DwrfData::seekToRowGroup(int64_t index) {
   ensureRowGroupIndex();
-  VELOX_CHECK_LT(index, index_->entry_size(), "RowGroup index is corrupted");
+  VELOX_CHECK_LT(
+      index, numRowGroupIndexEntries(), "RowGroup index is corrupted");
 
-  positionsHolder_ = toPositionsInner(index_->entry(index));
+  positionsHolder_ = index_ ? toPositionsInner(index_->entry(index))
+                            : toPositionsInner(orcIndex_->entry(index));
   dwio::common::PositionProvider positionProvider(positionsHolder_);
   if (flatMapContext_.inMapDecoder) {
     flatMapContext_.inMapDecoder->seekToRowGroup(positionProvider);
@@ -155,14 +229,18 @@ void DwrfData::filterRowGroups(
     uint64_t rowGroupSize,
     const dwio::common::StatsContext& writerContext,
     FilterRowGroupsResult& result) {
-  if (!index_ && !indexStream_) {
+  if (!index_ && !orcIndex_ && !indexStream_) {
     return;
   }
 
   ensureRowGroupIndex();
   auto* filter = scanSpec.filter();
   auto* dwrfContext = reinterpret_cast<const StatsContext*>(&writerContext);
-  result.totalCount = std::max(result.totalCount, index_->entry_size());
+  const auto numEntries = numRowGroupIndexEntries();
+  const bool useBloomFilters = filter && isPointFilter(*filter) &&
+      isBloomFilterApplicable(*fileType_->type()) &&
+      (bloomFilterStream_ || !bloomFilters_.empty());
+  result.totalCount = std::max(result.totalCount, numEntries);
   const auto nwords = bits::nwords(result.totalCount);
   if (result.filterResult.size() < nwords) {
     result.filterResult.resize(nwords);
@@ -174,10 +252,11 @@ void DwrfData::filterRowGroups(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
 
-  for (auto i = 0; i < index_->entry_size(); ++i) {
-    const auto& entry = index_->entry(i);
+  for (auto i = 0; i < numEntries; ++i) {
     const auto columnStats = buildColumnStatisticsFromProto(
-        ColumnStatisticsWrapper(&entry.statistics()), *dwrfContext);
+        index_ ? ColumnStatisticsWrapper(&index_->entry(i).statistics())
+               : ColumnStatisticsWrapper(&orcIndex_->entry(i).statistics()),
+        *dwrfContext);
     if (filter &&
         !testFilter(
             filter, columnStats.get(), rowGroupSize, fileType_->type())) {
@@ -185,6 +264,12 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (useBloomFilters && !bloomFilterMayMatch(*filter, i)) {
+      VLOG(1) << "Drop stride " << i << " by bloom filter on "
+              << scanSpec.toString();
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
 
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
@@ -202,4 +287,45 @@ void DwrfData::filterRowGroups(
   }
 }
 
+bool DwrfData::bloomFilterMayMatch(
+    const common::Filter& filter,
+    int32_t rowGroup) {
+  ensureBloomFilters();
+  if (rowGroup >= static_cast<int32_t>(bloomFilters_.size())) {
+    return true;
+  }
+  const auto& bloomFilter = bloomFilters_[rowGroup];
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return bloomFilter.testLong(filter.as<common::BigintRange>()->lower());
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      for (auto value :
+           filter.as<common::BigintValuesUsingHashTable>()->values()) {
+        if (bloomFilter.testLong(value)) {
+          return true;
+        }
+      }
+      return false;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      for (auto value :
+           filter.as<common::BigintValuesUsingBitmask>()->values()) {
+        if (bloomFilter.testLong(value)) {
+          return true;
+        }
+      }
+      return false;
+    case common::FilterKind::kBytesRange:
+      return bloomFilter.testBytes(filter.as<common::BytesRange>()->lower());
+    case common::FilterKind::kBytesValues:
+      for (const auto& value : filter.as<common::BytesValues>()->values()) {
+        if (bloomFilter.testBytes(value)) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      return true;
+  }
+}
+
 } // namespace facebook::velox::dwrf
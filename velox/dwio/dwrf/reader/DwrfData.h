@@ -21,6 +21,7 @@
 #include "velox/dwio/common/TypeWithId.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/dwrf/common/ByteRLE.h"
+#include "velox/dwio/dwrf/common/OrcBloomFilter.h"
 #include "velox/dwio/dwrf/common/RLEv1.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
 #include "velox/dwio/dwrf/reader/EncodingContext.h"
@@ -36,7 +37,8 @@ class DwrfData : public dwio::common::FormatData {
       std::shared_ptr<const dwio::common::TypeWithId> fileType,
       StripeStreams& stripe,
       const StreamLabels& streamLabels,
-      FlatMapContext flatMapContext);
+      FlatMapContext flatMapContext,
+      bool readBloomFilters = false);
 
   void readNulls(
       vector_size_t numValues,
@@ -92,23 +94,45 @@ class DwrfData : public dwio::common::FormatData {
   // if not already decoded. Throws if no index.
   void ensureRowGroupIndex();
 
+  /// Returns the DWRF row group index. Throws on ORC files.
   auto& index() const {
+    VELOX_CHECK_NOT_NULL(index_, "No DWRF row group index");
     return *index_;
   }
 
  private:
-  static std::vector<uint64_t> toPositionsInner(
-      const proto::RowIndexEntry& entry) {
+  template <typename T>
+  static std::vector<uint64_t> toPositionsInner(const T& entry) {
     return std::vector<uint64_t>(
         entry.positions().cbegin(), entry.positions().cend());
   }
 
+  int32_t numRowGroupIndexEntries() const {
+    return index_ ? index_->entry_size() : orcIndex_->entry_size();
+  }
+
+  // Decodes the ORC bloom filters of the row groups of 'this' in the stripe,
+  // if there are any and they are not already decoded.
+  void ensureBloomFilters();
+
+  // Returns false if no value passing 'filter' is in the bloom filter of
+  // 'rowGroup'. 'filter' must not pass nulls.
+  bool bloomFilterMayMatch(const common::Filter& filter, int32_t rowGroup);
+
   memory::MemoryPool& memoryPool_;
   const std::shared_ptr<const dwio::common::TypeWithId> fileType_;
   FlatMapContext flatMapContext_;
   std::unique_ptr<BooleanRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
+  const DwrfFormat format_;
   std::unique_ptr<proto::RowIndex> index_;
+  // The row group index of an ORC file. The ORC and DWRF index entries have
+  // different field numbers in their statistics.
+  std::unique_ptr<proto::orc::RowIndex> orcIndex_;
+  // BLOOM_FILTER_UTF8 stream of an ORC file and the bloom filters decoded
+  // from it, one per row group.
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  std::vector<OrcBloomFilter> bloomFilters_;
   int64_t stripeRows_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
@@ -136,9 +160,15 @@ class DwrfParams : public dwio::common::FormatParams {
 
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
-      const common::ScanSpec& /*scanSpec*/) override {
+      const common::ScanSpec& scanSpec) override {
+    // The bloom filters are only read for the filters known at construction.
+    // Filters pushed down later, e.g. from joins, use the statistics only.
     return std::make_unique<DwrfData>(
-        type, stripeStreams_, streamLabels_, flatMapContext_);
+        type,
+        stripeStreams_,
+        streamLabels_,
+        flatMapContext_,
+        scanSpec.filter() != nullptr);
   }
 
   StripeStreams& stripeStreams() {
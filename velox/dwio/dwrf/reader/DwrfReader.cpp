@@ -20,6 +20,7 @@
 
 #include "velox/dwio/common/OnDemandUnitLoader.h"
 #include "velox/dwio/common/ParallelUnitLoader.h"
+#include "velox/dwio/common/SelectiveStructColumnReader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -187,6 +188,14 @@ void DwrfUnit::ensureDecoders() {
         flatMapContext,
         /*isRoot=*/true);
     selectiveColumnReader_->setIsTopLevel();
+    if (options_.decodingExecutor()) {
+      if (auto* structReader = dynamic_cast<
+              dwio::common::SelectiveStructColumnReaderBase*>(
+              selectiveColumnReader_.get())) {
+        structReader->setDecodingExecutor(
+            options_.decodingExecutor(), options_.decodingParallelismFactor());
+      }
+    }
   } else {
     auto requestedType = columnSelector_->getSchemaWithId();
     auto factory = &ColumnReaderFactory::defaultFactory();
@@ -103,6 +103,14 @@ std::unique_ptr<FooterWrapper> parseFooter(
   return std::make_unique<FooterWrapper>(impl);
 }
 
+// The parsed post script and footer of a file, shared by the readers of the
+// file through the FileMetadataCache.
+struct FileTail {
+  std::unique_ptr<google::protobuf::Arena> arena;
+  std::shared_ptr<const PostScript> postScript;
+  std::shared_ptr<const FooterWrapper> footer;
+};
+
 } // namespace
 
 ReaderBase::ReaderBase(
@@ -141,7 +149,18 @@ ReaderBase::ReaderBase(
 
   VELOX_CHECK_GE(footerOffset, psLength_);
   footerOffset -= psLength_;
-  if (fileFormat() == FileFormat::DWRF) {
+
+  std::string cacheKey;
+  std::shared_ptr<const FileTail> cachedTail;
+  if (auto* cache = options_.fileMetadataCache();
+      cache != nullptr && !options_.fileMetadataCacheKey().empty()) {
+    cacheKey =
+        fmt::format("{}:{}", fileFormat(), options_.fileMetadataCacheKey());
+    cachedTail = cache->get<FileTail>(cacheKey);
+  }
+  if (cachedTail != nullptr) {
+    postScript_ = cachedTail->postScript;
+  } else if (fileFormat() == FileFormat::DWRF) {
     postScript_ = parsePostScript<proto::PostScript>(
         rawFooterBuffer + footerOffset, psLength_);
   } else {
@@ -172,7 +191,8 @@ ReaderBase::ReaderBase(
       "Corrupted File, invalid compression kind ",
       postScript_->compression());
 
-  if (input_->supportSyncLoad() && (tailSize > readSize)) {
+  if (input_->supportSyncLoad() && (tailSize > readSize) &&
+      cachedTail == nullptr) {
     input_->enqueue({fileLength_ - tailSize, tailSize, "footer"});
     input_->load(LogType::FOOTER);
   }
@@ -182,6 +202,10 @@ ReaderBase::ReaderBase(
   if (footerOffset >= footerSize) {
     footerOffset -= footerSize;
     footerStart = rawFooterBuffer + footerOffset;
+  } else if (cachedTail != nullptr) {
+    // The footer is not read and loadCache() reads the stripe metadata cache
+    // from the file.
+    footerOffset = 0;
   } else {
     fullFooterBuffer =
         AlignedBuffer::allocate<char>(footerSize, &options_.memoryPool());
@@ -196,14 +220,33 @@ ReaderBase::ReaderBase(
     ::memcpy(footerStart + remainingBytes, rawFooterBuffer, footerOffset);
     footerOffset = 0;
   }
-  auto decompressed = createDecompressedStream(
-      std::make_unique<dwio::common::SeekableArrayInputStream>(
-          footerStart, footerSize),
-      "File Footer");
-  if (fileFormat() == FileFormat::DWRF) {
-    footer_ = parseFooter<proto::Footer>(decompressed.get(), arena_.get());
+  if (cachedTail != nullptr) {
+    footer_ = cachedTail->footer;
+    cachedTail_ = std::move(cachedTail);
   } else {
-    footer_ = parseFooter<proto::orc::Footer>(decompressed.get(), arena_.get());
+    auto decompressed = createDecompressedStream(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            footerStart, footerSize),
+        "File Footer");
+    // A cached footer lives in an arena of its own since arena_ is also used
+    // for the stripe metadata of this reader.
+    std::unique_ptr<google::protobuf::Arena> footerArena;
+    if (!cacheKey.empty()) {
+      footerArena = std::make_unique<google::protobuf::Arena>();
+    }
+    auto* arena = footerArena != nullptr ? footerArena.get() : arena_.get();
+    if (fileFormat() == FileFormat::DWRF) {
+      footer_ = parseFooter<proto::Footer>(decompressed.get(), arena);
+    } else {
+      footer_ = parseFooter<proto::orc::Footer>(decompressed.get(), arena);
+    }
+    if (footerArena != nullptr) {
+      const auto sizeBytes = footerArena->SpaceUsed() + psLength_;
+      auto tail = std::make_shared<FileTail>(
+          FileTail{std::move(footerArena), postScript_, footer_});
+      options_.fileMetadataCache()->put(cacheKey, tail, sizeBytes);
+      cachedTail_ = std::move(tail);
+    }
   }
 
   stripeMetadataCacheBuffer_ = footerBuffer;
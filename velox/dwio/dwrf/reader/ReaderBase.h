@@ -274,8 +274,11 @@ class ReaderBase {
   int32_t stripeMetadataCacheBufferSize_;
   int32_t footerBufferOverread_;
   std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_;
+  std::shared_ptr<const PostScript> postScript_;
+  std::shared_ptr<const FooterWrapper> footer_;
+  // Owns the arena of 'footer_' if the footer is shared through the
+  // FileMetadataCache.
+  std::shared_ptr<const void> cachedTail_;
   std::unique_ptr<encryption::DecryptionHandler> handler_;
   std::unique_ptr<StripeMetadataCache> cache_;
 
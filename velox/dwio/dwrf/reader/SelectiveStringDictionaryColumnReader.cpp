@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/reader/SelectiveStringDictionaryColumnReader.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::dwrf {
 
@@ -63,14 +64,18 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
       lenVInts,
       dwio::common::INT_BYTE_SIZE);
 
-  blobStream_ = stripe.getStream(
-      StripeStreamsUtil::getStreamForKind(
-          stripe,
-          encodingKey,
-          proto::Stream_Kind_DICTIONARY_DATA,
-          proto::orc::Stream_Kind_DICTIONARY_DATA),
-      params.streamLabels().label(),
-      false);
+  const auto blobId = StripeStreamsUtil::getStreamForKind(
+      stripe,
+      encodingKey,
+      proto::Stream_Kind_DICTIONARY_DATA,
+      proto::orc::Stream_Kind_DICTIONARY_DATA);
+  blobStream_ = stripe.getStream(blobId, params.streamLabels().label(), false);
+  if (auto* cache = stripe.dictionaryCache()) {
+    dictionaryCacheKey_ = stripe.dictionaryCacheKey(blobId);
+    if (!dictionaryCacheKey_.empty()) {
+      dictionaryCache_ = cache;
+    }
+  }
 
   // handle in dictionary stream
   std::unique_ptr<SeekableInputStream> inDictStream = stripe.getStream(
@@ -115,10 +120,11 @@ uint64_t SelectiveStringDictionaryColumnReader::skip(uint64_t numValues) {
 void SelectiveStringDictionaryColumnReader::loadDictionary(
     SeekableInputStream& data,
     IntDecoder</*isSigned*/ false>& lengthDecoder,
-    DictionaryValues& values) {
+    DictionaryValues& values,
+    memory::MemoryPool* pool) {
   // read lengths from length reader
   dwio::common::ensureCapacity<StringView>(
-      values.values, values.numValues, memoryPool_);
+      values.values, values.numValues, pool);
   // The lengths are read in the low addresses of the string views array.
   auto* lengths = values.values->asMutable<int32_t>();
   lengthDecoder.nextLengths(lengths, values.numValues);
@@ -127,8 +133,10 @@ void SelectiveStringDictionaryColumnReader::loadDictionary(
     stringsBytes += lengths[i];
   }
   // read bytes from underlying string
-  values.strings = AlignedBuffer::allocate<char>(stringsBytes, memoryPool_);
+  values.strings = AlignedBuffer::allocate<char>(stringsBytes, pool);
   data.readFully(values.strings->asMutable<char>(), stringsBytes);
+  values.isAscii = functions::stringCore::isAscii(
+      values.strings->as<char>(), stringsBytes);
   // fill the values with StringViews over the strings. 'strings' will
   // exist even if 'stringsBytes' is 0, which can happen if the only
   // content of the dictionary is the empty string.
@@ -162,7 +170,10 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
     strideDictLengthDecoder_->seekToRowGroup(pp);
 
     loadDictionary(
-        *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
+        *strideDictStream_,
+        *strideDictLengthDecoder_,
+        scanState_.dictionary2,
+        memoryPool_);
   }
   lastStrideIndex_ = nextStride;
   dictionaryValues_ = nullptr;
@@ -202,6 +213,12 @@ void SelectiveStringDictionaryColumnReader::makeDictionaryBaseVector() {
         values,
         std::vector<BufferPtr>{
             scanState_.dictionary.strings, scanState_.dictionary2.strings});
+    if (scanState_.dictionary.isAscii.has_value() &&
+        scanState_.dictionary2.isAscii.has_value()) {
+      dictionaryValues_->setAllIsAscii(
+          scanState_.dictionary.isAscii.value() &&
+          scanState_.dictionary2.isAscii.value());
+    }
   } else {
     dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
         memoryPool_,
@@ -210,6 +227,9 @@ void SelectiveStringDictionaryColumnReader::makeDictionaryBaseVector() {
         scanState_.dictionary.numValues /*length*/,
         scanState_.dictionary.values,
         std::vector<BufferPtr>{scanState_.dictionary.strings});
+    if (scanState_.dictionary.isAscii.has_value()) {
+      dictionaryValues_->setAllIsAscii(scanState_.dictionary.isAscii.value());
+    }
   }
 }
 
@@ -311,6 +331,32 @@ void SelectiveStringDictionaryColumnReader::getValues(
       memoryPool_, resultNulls(), numValues_, dictionaryValues_, values_);
 }
 
+void SelectiveStringDictionaryColumnReader::loadStripeDictionary() {
+  auto& dictionary = scanState_.dictionary;
+  if (dictionaryCache_ == nullptr) {
+    loadDictionary(*blobStream_, *lengthDecoder_, dictionary, memoryPool_);
+    return;
+  }
+  if (auto cached = dictionaryCache_->get(dictionaryCacheKey_)) {
+    VELOX_CHECK_EQ(cached->numValues, dictionary.numValues);
+    dictionary.values = cached->values;
+    dictionary.strings = cached->strings;
+    dictionary.isAscii = cached->isAscii;
+    return;
+  }
+  // Decodes into the pool of the cache so that the buffers outlive the query
+  // of this reader. Concurrent readers that miss may each decode the
+  // dictionary, the last one replaces the entry.
+  loadDictionary(
+      *blobStream_, *lengthDecoder_, dictionary, dictionaryCache_->pool());
+  dictionaryCache_->put(
+      dictionaryCacheKey_,
+      {dictionary.values,
+       dictionary.strings,
+       dictionary.numValues,
+       dictionary.isAscii.value_or(false)});
+}
+
 void SelectiveStringDictionaryColumnReader::ensureInitialized() {
   if (LIKELY(initialized_)) {
     return;
@@ -318,7 +364,7 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   ClockTimer timer{initTimeClocks_};
 
-  loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
+  loadStripeDictionary();
 
   if (DictionaryValues::hasFilter(scanSpec_->filter())) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
@@ -72,12 +72,17 @@ class SelectiveStringDictionaryColumnReader
   template <typename TVisitor>
   void readWithVisitor(TVisitor visitor);
 
-  // Fills 'values' from 'data' and 'lengthDecoder'. The count of
-  // values is in 'values.numValues'.
+  // Fills 'values' from 'data' and 'lengthDecoder' with buffers allocated
+  // from 'pool'. The count of values is in 'values.numValues'.
   void loadDictionary(
       dwio::common::SeekableInputStream& data,
       dwio::common::IntDecoder</*isSigned*/ false>& lengthDecoder,
-      dwio::common::DictionaryValues& values);
+      dwio::common::DictionaryValues& values,
+      memory::MemoryPool* pool);
+
+  // Fills the stripe dictionary from 'dictionaryCache_' or decodes it and
+  // adds it to the cache.
+  void loadStripeDictionary();
   void ensureInitialized();
 
   void makeFlat(VectorPtr* result);
@@ -101,6 +106,10 @@ class SelectiveStringDictionaryColumnReader
   // lazy load the dictionary
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> lengthDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> blobStream_;
+  // The cache shared by the readers of the file and the key of the stripe
+  // dictionary in it. Null if the dictionary is not shared.
+  dwio::common::DictionaryCache* dictionaryCache_{nullptr};
+  std::string dictionaryCacheKey_;
   bool initialized_{false};
   int64_t numRowsScanned_;
 };
@@ -82,7 +82,7 @@ void SelectiveStringDirectColumnReader::extractCrossBuffers(
       addValue(value);
     } else {
       auto index = outerNonNullRows_[rowIndex + i];
-      if (size <= StringView::kInlineSize) {
+      if (size <= StringView::kInlineSize || mayUseStreamBuffer_) {
         reinterpret_cast<StringView*>(rawValues_)[index] =
             StringView(value.data(), size);
       } else {
@@ -291,6 +291,14 @@ inline bool SelectiveStringDirectColumnReader::try8Consecutive(
           reinterpret_cast<char*>(result + resultIndex + 1) + length) = 0;
       continue;
     }
+    if (bufferEnd_ != pinnedBufferEnd_) {
+      pinStreamBuffer();
+    }
+    if (mayUseStreamBuffer_) {
+      *reinterpret_cast<const char**>(result + resultIndex + 2) = data;
+      data += length;
+      continue;
+    }
     if (!rawStringBuffer_ || rawUsed + length > rawStringSize_) {
       // Slow path if no space in raw strings
       return false;
@@ -368,15 +376,36 @@ std::string_view SelectiveStringDirectColumnReader::readValue(int32_t length) {
   // bufferStart_ may be null if length is 0 and this is the first string
   // we're reading.
   if (bufferEnd_ - bufferStart_ >= length) {
+    if (length > StringView::kInlineSize) {
+      pinStreamBuffer();
+    }
     bytesToSkip_ = length;
     return std::string_view(bufferStart_, length);
   }
+  // The value straddles ranges of 'blobStream_' and is assembled in
+  // 'tempString_', which must be copied.
+  mayUseStreamBuffer_ = false;
+  pinnedBufferEnd_ = nullptr;
   tempString_.resize(length);
   readBytes(
       length, blobStream_.get(), tempString_.data(), bufferStart_, bufferEnd_);
   return std::string_view(tempString_);
 }
 
+void SelectiveStringDirectColumnReader::pinStreamBuffer() {
+  if (bufferEnd_ == pinnedBufferEnd_ || bufferStart_ == bufferEnd_ ||
+      !scanSpec_->keepValues()) {
+    return;
+  }
+  // A non-empty range is the one returned by the last Next() of the stream.
+  auto pinned = blobStream_->pinnedBuffer();
+  mayUseStreamBuffer_ = pinned != nullptr;
+  if (mayUseStreamBuffer_) {
+    stringBuffers_.push_back(std::move(pinned));
+  }
+  pinnedBufferEnd_ = bufferEnd_;
+}
+
 template <bool kHasNulls, typename Visitor>
 void SelectiveStringDirectColumnReader::decode(
     const uint64_t* nulls,
@@ -474,6 +503,16 @@ void SelectiveStringDirectColumnReader::read(
     const RowSet& rows,
     const uint64_t* incomingNulls) {
   prepareRead<std::string_view>(offset, rows, incomingNulls);
+  if (!stringBuffers_.empty()) {
+    // The values of the previous read were not fetched. Releases the buffers,
+    // including the pins on cache entries, that backed them.
+    stringBuffers_.clear();
+    rawStringBuffer_ = nullptr;
+    rawStringSize_ = 0;
+    rawStringUsed_ = 0;
+  }
+  mayUseStreamBuffer_ = false;
+  pinnedBufferEnd_ = nullptr;
   auto numRows = rows.back() + 1;
   auto numNulls = nullsInReadRange_
       ? BaseVector::countNulls(nullsInReadRange_, 0, numRows)
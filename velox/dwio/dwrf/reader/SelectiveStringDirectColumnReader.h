@@ -51,6 +51,8 @@ class SelectiveStringDirectColumnReader
     rawStringBuffer_ = nullptr;
     rawStringSize_ = 0;
     rawStringUsed_ = 0;
+    mayUseStreamBuffer_ = false;
+    pinnedBufferEnd_ = nullptr;
     getFlatValues<StringView, StringView>(rows, result, requestedType());
   }
 
@@ -60,6 +62,13 @@ class SelectiveStringDirectColumnReader
 
   std::string_view readValue(int32_t length);
 
+  // Adds the pinned buffer of the current range of 'blobStream_' to
+  // 'stringBuffers_' if it is not there yet, so that values can refer to the
+  // range without a copy. Sets 'mayUseStreamBuffer_' to whether the stream
+  // could pin the range. Called only for values that are not inlined, so that
+  // batches of inlined values do not pin cache entries.
+  void pinStreamBuffer();
+
   template <bool hasNulls, typename Visitor>
   void decode(const uint64_t* nulls, Visitor visitor);
 
@@ -97,6 +106,9 @@ class SelectiveStringDirectColumnReader
   int32_t lengthIndex_ = 0;
   const uint32_t* rawLengths_ = nullptr;
   int64_t bytesToSkip_ = 0;
+  // End of the range of 'blobStream_' last given to pinStreamBuffer(). Values
+  // may refer to this range if 'mayUseStreamBuffer_' is true.
+  const char* pinnedBufferEnd_ = nullptr;
   // Storage for a string straddling a buffer boundary. Needed for calling
   // the filter.
   std::string tempString_;
@@ -371,6 +371,27 @@ bool StripeStreamsImpl::getUseVInts(const DwrfStreamIdentifier& si) const {
   return info.getUseVInts();
 }
 
+std::string StripeStreamsImpl::dictionaryCacheKey(
+    const DwrfStreamIdentifier& si) const {
+  const auto& options = readState_->readerBase->readerOptions();
+  if (options.dictionaryCache() == nullptr ||
+      options.dictionaryCacheKey().empty()) {
+    return {};
+  }
+  const auto& info = getStreamInfo(si, false);
+  // Decrypted dictionaries are not shared across readers.
+  if (!info.valid() || getDecrypter(si.encodingKey().node()) != nullptr) {
+    return {};
+  }
+  return fmt::format(
+      "{}:{}:{}:{}:{}",
+      options.dictionaryCacheKey(),
+      stripeIndex_,
+      si.encodingKey().node(),
+      si.encodingKey().sequence(),
+      info.getOffset() + stripeStart_);
+}
+
 std::unique_ptr<dwio::common::SeekableInputStream>
 StripeStreamsImpl::getIndexStreamFromCache(
     const StreamInformation& info) const {
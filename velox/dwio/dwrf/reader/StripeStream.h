@@ -171,6 +171,19 @@ class StripeStreams {
 
   /// Number of rows per row group. Last row group may have fewer rows.
   virtual uint32_t rowsPerRowGroup() const = 0;
+
+  /// Get the cache of decoded string dictionaries shared by the readers of
+  /// the file, or nullptr.
+  virtual dwio::common::DictionaryCache* dictionaryCache() const {
+    return nullptr;
+  }
+
+  /// Get the key of the dictionary stream 'streamId' in dictionaryCache(), or
+  /// an empty string if its decoded dictionary cannot be shared.
+  virtual std::string dictionaryCacheKey(
+      const DwrfStreamIdentifier& /*streamId*/) const {
+    return {};
+  }
 };
 
 class StripeStreamsBase : public StripeStreams {
@@ -338,6 +351,13 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return readState_->readerBase->footer().rowIndexStride();
   }
 
+  dwio::common::DictionaryCache* dictionaryCache() const override {
+    return readState_->readerBase->readerOptions().dictionaryCache();
+  }
+
+  std::string dictionaryCacheKey(
+      const DwrfStreamIdentifier& si) const override;
+
  private:
   const StreamInformation& getStreamInfo(
       const DwrfStreamIdentifier& si,
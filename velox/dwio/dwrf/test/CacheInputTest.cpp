@@ -524,6 +524,46 @@ TEST_F(CacheTest, window) {
   EXPECT_EQ(kMB, ioStats_->rawBytesRead() - previousRead);
 }
 
+TEST_F(CacheTest, pinnedBuffer) {
+  constexpr int32_t kMB = 1 << 20;
+  initializeCache(64 * kMB);
+  StringIdLease fileId;
+  StringIdLease groupId;
+  auto file = inputByPath("test_for_pinned_buffer", fileId, groupId);
+  auto input = std::make_unique<CachedBufferedInput>(
+      file,
+      MetricsLog::voidLog(),
+      fileId,
+      cache_.get(),
+      nullptr,
+      groupId,
+      ioStats_,
+      fsStats_,
+      executor_.get(),
+      io::ReaderOptions(pool_.get()));
+  auto stream = input->read(0, 20 * kMB, LogType::TEST);
+  EXPECT_EQ(stream->pinnedBuffer(), nullptr);
+  const void* buffer;
+  int32_t size;
+  ASSERT_TRUE(stream->Next(&buffer, &size));
+  auto pinned = stream->pinnedBuffer();
+  ASSERT_NE(pinned, nullptr);
+  ASSERT_LE(pinned->as<char>(), buffer);
+  ASSERT_LE(
+      reinterpret_cast<const char*>(buffer) + size,
+      pinned->as<char>() + pinned->size());
+  const std::string expected(reinterpret_cast<const char*>(buffer), size);
+
+  // The pinned bytes stay valid after the stream moves on, is destroyed and
+  // the cache is asked to evict everything.
+  stream->SkipInt64(12 * kMB);
+  ASSERT_TRUE(stream->Next(&buffer, &size));
+  stream.reset();
+  input.reset();
+  cache_->clear();
+  EXPECT_EQ(std::string_view(pinned->as<char>(), expected.size()), expected);
+}
+
 TEST_F(CacheTest, bufferedInput) {
   // Size 160 MB. Frequent evictions and not everything fits in prefetch window.
   initializeCache(160 << 20);
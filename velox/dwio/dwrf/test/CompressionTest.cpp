@@ -285,6 +285,40 @@ TEST_P(CompressionTest, compressProtoBuf) {
   verifyProto(memSink, kind_, block, *pool_, ps, decrypter_);
 }
 
+TEST_P(CompressionTest, batchDecryption) {
+  if (decrypter_ == nullptr) {
+    return;
+  }
+  // Counts the blocks decrypted in batches.
+  class BatchDecrypter : public TestDecrypter {
+   public:
+    std::vector<std::unique_ptr<folly::IOBuf>> decryptBatch(
+        const std::vector<std::string_view>& inputs) const override {
+      ++numBatches;
+      numBatchedBlocks += inputs.size();
+      return Decrypter::decryptBatch(inputs);
+    }
+
+    mutable int32_t numBatches{0};
+    mutable int32_t numBatchedBlocks{0};
+  };
+
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+  uint64_t block = 128;
+  constexpr size_t dataSize = 4096;
+  char testData[dataSize];
+  generateRandomData(testData, dataSize, true);
+  compressAndVerify(
+      kind_, memSink, block, *pool_, testData, dataSize, encrypter_);
+
+  BatchDecrypter decrypter;
+  decrypter.setKey(testDecrypter.getKey());
+  decompressAndVerify(
+      memSink, kind_, block, testData, dataSize, *pool_, &decrypter);
+  ASSERT_GT(decrypter.numBatches, 0);
+  ASSERT_GT(decrypter.numBatchedBlocks, decrypter.numBatches);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     TestCompression,
     CompressionTest,
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -947,6 +948,73 @@ TEST_F(E2EWriterTest, PartialStride) {
   ASSERT_EQ(true, reader->columnStatistics(1)->hasNull().value());
 }
 
+TEST_F(E2EWriterTest, ParallelEncoding) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "bool_val:boolean,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "timestamp_val:timestamp,"
+      "array_val:array<float>,"
+      "map_val:map<bigint,string>,"
+      "struct_val:struct<a:float,b:string>"
+      ">");
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 6; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 2'000, *leafPool_, nullptr, i));
+  }
+
+  // Writes 'batches' encoding the columns on 'executor' and returns the file.
+  auto writeFile = [&](std::shared_ptr<folly::Executor> executor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1'000));
+    config->set<uint64_t>(dwrf::Config::COMPRESSION_BLOCK_SIZE, 1'024);
+    auto sink = std::make_unique<MemorySink>(
+        20 * kSizeMB, dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = std::move(executor);
+    options.encodingParallelismFactor = 4;
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto sequential = writeFile(nullptr);
+  const auto parallel =
+      writeFile(std::make_shared<folly::CPUThreadPoolExecutor>(3));
+  // The streams of each column are the same and are laid out in the same
+  // order.
+  ASSERT_EQ(parallel, sequential);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = std::make_unique<dwrf::DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(parallel), *leafPool_));
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  VectorPtr result;
+  for (const auto& batch : batches) {
+    ASSERT_TRUE(rowReader->next(batch->size(), result));
+    ASSERT_EQ(result->size(), batch->size());
+    for (auto i = 0; i < batch->size(); ++i) {
+      ASSERT_TRUE(result->equalValueAt(batch.get(), i, i))
+          << "Mismatch at " << i;
+    }
+  }
+  ASSERT_FALSE(rowReader->next(1, result));
+}
+
 TEST_F(E2EWriterTest, OversizeRows) {
   auto pool = facebook::velox::memory::memoryManager()->addLeafPool();
 
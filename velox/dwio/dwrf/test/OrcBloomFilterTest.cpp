@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/OrcBloomFilter.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwrf;
+
+TEST(OrcBloomFilterTest, addAndTest) {
+  OrcBloomFilter bloomFilter(10'000, 4);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    bloomFilter.addLong(i * 7);
+    bloomFilter.addBytes(std::to_string(i * 7));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 7'000; ++i) {
+    const bool added = i % 7 == 0;
+    if (added) {
+      EXPECT_TRUE(bloomFilter.testLong(i));
+      EXPECT_TRUE(bloomFilter.testBytes(std::to_string(i)));
+    } else {
+      numFalsePositives += bloomFilter.testLong(i);
+      numFalsePositives += bloomFilter.testBytes(std::to_string(i));
+    }
+  }
+  // 2000 values in 10048 bits with 4 hash functions have a false positive
+  // rate of about 9%.
+  EXPECT_LT(numFalsePositives, 2 * 6'000 / 4);
+}
+
+TEST(OrcBloomFilterTest, fromProto) {
+  proto::orc::BloomFilter empty;
+  empty.set_numhashfunctions(3);
+  empty.mutable_bitset()->Resize(16, 0);
+  EXPECT_FALSE(OrcBloomFilter(empty).testLong(1));
+  EXPECT_FALSE(OrcBloomFilter(empty).testBytes("velox"));
+
+  // Older writers serialize the bit set as longs, newer ones as little endian
+  // bytes.
+  std::vector<uint64_t> words;
+  for (auto i = 0; i < 16; ++i) {
+    words.push_back(0x9e3779b97f4a7c15ULL * (i + 1));
+  }
+  proto::orc::BloomFilter longs;
+  longs.set_numhashfunctions(3);
+  for (auto word : words) {
+    longs.add_bitset(word);
+  }
+  proto::orc::BloomFilter bytes;
+  bytes.set_numhashfunctions(3);
+  bytes.set_utf8bitset(
+      reinterpret_cast<const char*>(words.data()),
+      words.size() * sizeof(uint64_t));
+
+  OrcBloomFilter fromLongs(longs);
+  OrcBloomFilter fromBytes(bytes);
+  EXPECT_EQ(fromLongs.numBits(), 1'024);
+  EXPECT_EQ(fromBytes.numBits(), 1'024);
+  for (int64_t i = -100; i < 100; ++i) {
+    EXPECT_EQ(fromLongs.testLong(i), fromBytes.testLong(i));
+    EXPECT_EQ(
+        fromLongs.testBytes(std::to_string(i)),
+        fromBytes.testBytes(std::to_string(i)));
+  }
+}
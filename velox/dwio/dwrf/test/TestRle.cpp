@@ -673,6 +673,66 @@ TEST_F(RLEv2Test, bitsLeftByPreviousStream) {
   }
 };
 
+TEST_F(RLEv2Test, directWidths) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  // Encoded widths of DIRECT runs and their bit sizes.
+  const std::vector<std::pair<uint8_t, uint32_t>> widths = {
+      {0, 1}, {2, 3}, {6, 7}, {7, 8}, {12, 13}, {23, 24}, {24, 26}, {27, 32},
+      {29, 48}, {30, 56}, {31, 64}};
+  constexpr int32_t kRunLength = 300;
+  // Values of each DIRECT run are 'i * 0x9E3779B97F4A7C15' truncated.
+  auto valueAt = [](int32_t i, uint32_t bitSize) {
+    const uint64_t value = i * 0x9E3779B97F4A7C15ULL;
+    return bitSize == 64 ? value : value & ((1ULL << bitSize) - 1);
+  };
+  std::vector<unsigned char> bytes;
+  std::vector<int64_t> expected;
+  for (const auto [encodedWidth, bitSize] : widths) {
+    bytes.push_back(0x40 | (encodedWidth << 1) | ((kRunLength - 1) >> 8));
+    bytes.push_back((kRunLength - 1) & 0xff);
+    uint32_t numBits = 0;
+    uint8_t current = 0;
+    for (auto i = 0; i < kRunLength; ++i) {
+      const auto value = valueAt(i, bitSize);
+      expected.push_back(value);
+      for (int32_t bit = bitSize - 1; bit >= 0; --bit) {
+        current = (current << 1) | ((value >> bit) & 1);
+        if (++numBits == 8) {
+          bytes.push_back(current);
+          numBits = 0;
+          current = 0;
+        }
+      }
+    }
+    if (numBits > 0) {
+      bytes.push_back(current << (8 - numBits));
+    }
+  }
+
+  // Reads in batches of several sizes from streams of several block sizes,
+  // so that the values both fit and span the buffers.
+  for (const auto blockSize : {0, 1, 7, 100}) {
+    for (const auto batchSize : {1, 13, 1'000}) {
+      SCOPED_TRACE(fmt::format("{} {}", blockSize, batchSize));
+      auto rle = createRleDecoder<false>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              bytes.data(), bytes.size(), blockSize),
+          RleVersion_2,
+          *pool,
+          true /* doesn't matter */,
+          dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+      std::vector<int64_t> data(expected.size());
+      for (auto i = 0; i < data.size(); i += batchSize) {
+        rle->next(
+            data.data() + i,
+            std::min<int32_t>(batchSize, data.size() - i),
+            nullptr);
+      }
+      ASSERT_EQ(expected, data);
+    }
+  }
+}
+
 class RLEv1Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
@@ -142,7 +142,8 @@ class MockMemoryPool : public velox::memory::MemoryPool {
   void allocateContiguous(
       velox::memory::MachinePageCount /*unused*/,
       velox::memory::ContiguousAllocation& /*unused*/,
-      velox::memory::MachinePageCount /*unused*/ = 0) override {
+      velox::memory::MachinePageCount /*unused*/ = 0,
+      bool /*unused*/ = false) override {
     VELOX_UNSUPPORTED("allocateContiguous unsupported");
   }
 
@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -35,7 +36,11 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  // The column writers that run concurrently each use their own rows.
+  std::optional<SelectivityVector> localSelected;
+  auto& selected = context_.concurrentWrites()
+      ? localSelected.emplace(slice->size())
+      : context_.getSharedSelectivityVector(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -1760,7 +1765,21 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
-  if (ranges.size() > 0) {
+  if (ranges.size() > 0 && isRoot() && context_.concurrentWrites()) {
+    // The top level columns are encoded and compressed on the executor.
+    std::vector<uint64_t> childRawSizes(children_.size());
+    ParallelFor(
+        context_.encodingExecutor(),
+        0,
+        children_.size(),
+        context_.encodingParallelismFactor())
+        .execute([&](size_t i) {
+          childRawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+        });
+    for (auto childRawSize : childRawSizes) {
+      rawSize += childRawSize;
+    }
+  } else if (ranges.size() > 0) {
     for (size_t i = 0; i < children_.size(); ++i) {
       rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
     }
@@ -199,6 +199,14 @@ Writer::Writer(
     layoutPlanner_ = std::make_unique<LayoutPlanner>(*schema_);
   }
 
+  // The flat map writers add streams as they see new keys, which the
+  // concurrent writes of the columns do not allow.
+  if (options.encodingExecutor != nullptr &&
+      !context.getConfig(Config::FLATTEN_MAP)) {
+    context.setEncodingExecutor(
+        options.encodingExecutor, options.encodingParallelismFactor);
+  }
+
   if (options.columnWriterFactory == nullptr) {
     writer_ = BaseColumnWriter::create(writerBase_->getContext(), *schema_);
   } else {
@@ -45,6 +45,12 @@ struct WriterOptions : public dwio::common::WriterOptions {
   const tz::TimeZone* sessionTimezone{nullptr};
   bool adjustTimestampToTimezone{false};
   DwrfFormat format{DwrfFormat::kDwrf};
+  /// If set with a parallelism factor above 1, the top level columns are
+  /// encoded and compressed concurrently on this executor, using up to
+  /// 'encodingParallelismFactor' threads including the writing one. Ignored
+  /// if the maps are written as flat maps.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
 
   void processConfigs(
       const config::ConfigBase& connectorConfig,
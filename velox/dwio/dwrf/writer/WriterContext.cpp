@@ -95,13 +95,30 @@ void WriterContext::validateConfigs() const {
 }
 
 void WriterContext::initBuffer() {
-  VELOX_CHECK_NULL(compressionBuffer_);
+  VELOX_CHECK(compressionBuffers_.empty());
   if (compression_ != common::CompressionKind_NONE) {
-    compressionBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
-        *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    compressionBuffers_.push_back(
+        std::make_unique<dwio::common::DataBuffer<char>>(
+            *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE));
   }
 }
 
+std::unique_ptr<dwio::common::DataBuffer<char>> WriterContext::getBuffer(
+    uint64_t size) {
+  std::lock_guard<std::mutex> l(poolMutex_);
+  if (compressionBuffers_.empty()) {
+    VELOX_CHECK(
+        concurrentWrites(), "The compression buffer is not initialized");
+    compressionBuffers_.push_back(
+        std::make_unique<dwio::common::DataBuffer<char>>(
+            *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE));
+  }
+  auto buffer = std::move(compressionBuffers_.back());
+  compressionBuffers_.pop_back();
+  VELOX_CHECK_GE(buffer->size(), size);
+  return buffer;
+}
+
 memory::MemoryPool& WriterContext::getMemoryPool(
     const MemoryUsageCategory& category) {
   switch (category) {
@@ -158,7 +175,7 @@ int64_t WriterContext::releaseMemoryReservation() {
 }
 
 void WriterContext::abort() {
-  compressionBuffer_.reset();
+  compressionBuffers_.clear();
   physicalSizeAggregators_.clear();
   streams_.clear();
   dictEncoders_.clear();
@@ -17,6 +17,10 @@
 #pragma once
 
 #include <limits>
+#include <mutex>
+
+#include <folly/Executor.h>
+
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -255,18 +259,16 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Returns the buffer made by initBuffer(). The column writers that run
+  /// concurrently get additional buffers, which are kept for reuse.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
-      uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
-    VELOX_CHECK_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
-  }
+      uint64_t size) override;
 
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+    std::lock_guard<std::mutex> l(poolMutex_);
+    compressionBuffers_.push_back(std::move(buffer));
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -581,6 +583,8 @@ class WriterContext : public CompressionBufferPool {
     return LocalDecodedVector{*this};
   }
 
+  /// Not to be used by the column writers that run concurrently, see
+  /// concurrentWrites().
   SelectivityVector& getSharedSelectivityVector(velox::vector_size_t size) {
     if (FOLLY_UNLIKELY(selectivityVector_ == nullptr)) {
       selectivityVector_ = std::make_unique<velox::SelectivityVector>(size);
@@ -592,8 +596,31 @@ class WriterContext : public CompressionBufferPool {
 
   void abort();
 
+  /// Makes the root writer write its children concurrently on 'executor',
+  /// using up to 'parallelismFactor' threads including the calling one.
+  void setEncodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = std::move(executor);
+    encodingParallelismFactor_ = parallelismFactor;
+  }
+
+  const std::shared_ptr<folly::Executor>& encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingParallelismFactor_;
+  }
+
+  /// True if the children of the root writer are written concurrently.
+  bool concurrentWrites() const {
+    return encodingExecutor_ != nullptr && encodingParallelismFactor_ > 1;
+  }
+
   dwio::common::DataBuffer<char>* testingCompressionBuffer() const {
-    return compressionBuffer_.get();
+    return compressionBuffers_.empty() ? nullptr
+                                       : compressionBuffers_.front().get();
   }
 
   const tz::TimeZone* sessionTimezone() const {
@@ -608,6 +635,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(poolMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -617,6 +645,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(poolMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -657,7 +686,11 @@ class WriterContext : public CompressionBufferPool {
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
-  std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Serializes the access to the compression buffers and DecodedVectors
+  // from the column writers that run concurrently.
+  std::mutex poolMutex_;
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      compressionBuffers_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -672,6 +705,8 @@ class WriterContext : public CompressionBufferPool {
   AverageRowSizeTracker rowSizeTracker_;
   bool checkLowMemoryMode_;
   bool lowMemoryMode_{false};
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  size_t encodingParallelismFactor_{0};
 
   /// stats
   uint32_t stripeIndex_{0};
@@ -243,3 +243,41 @@ TEST_P(OrcReaderFilterTestP, tests) {
 
   EXPECT_EQ(GetParam().resultsExpected, rowVector->size());
 }
+
+class OrcReaderFilterTest : public testing::Test, public OrcReaderFilterBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+};
+
+TEST_F(OrcReaderFilterTest, rowGroupSkipping) {
+  // 6000 rows in row groups of 2000 rows. The first column has the values 1 to
+  // 6000.
+  dwio::common::ReaderOptions readerOpts{pool()};
+  readerOpts.setFileFormat(dwio::common::FileFormat::ORC);
+  auto reader = DwrfReader::create(
+      createFileBufferedInput(
+          getExamplesFilePath("orc_index_int_string.orc"),
+          readerOpts.memoryPool()),
+      readerOpts);
+  auto rowType = reader->rowType();
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addAllChildFields(*rowType);
+  scanSpec->childByName(rowType->nameOf(0))
+      ->setFilter(std::make_shared<common::BigintRange>(4500, 4500, false));
+
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  VectorPtr batch = BaseVector::create(rowType, 0, pool());
+  vector_size_t numRows = 0;
+  while (rowReader->next(500, batch)) {
+    numRows += batch->size();
+  }
+  EXPECT_EQ(numRows, 1);
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(stats.skippedStrides, 2);
+}
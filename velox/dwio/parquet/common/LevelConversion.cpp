@@ -18,10 +18,12 @@
 
 #include "velox/dwio/parquet/common/LevelConversion.h"
 
+#include <algorithm>
 #include <cassert> // Required for bitmap_writer.h below.
 #include <limits>
 #include <optional>
 
+#include "arrow/util/bit_util.h"
 #include "arrow/util/bitmap_writer.h"
 
 #include "velox/common/base/Exceptions.h"
@@ -30,6 +32,61 @@
 namespace facebook::velox::parquet {
 namespace {
 
+// Returns true if all the levels are of present elements of the lists of
+// 'levelInfo' or their ancestors, i.e. there are no null or empty lists and
+// no elements of nested lists.
+bool AllListElementsPresent(
+    const int16_t* defLevels,
+    const int16_t* repLevels,
+    int64_t numDefLevels,
+    const LevelInfo& levelInfo) {
+  int16_t minDefLevel = std::numeric_limits<int16_t>::max();
+  int16_t maxRepLevel = std::numeric_limits<int16_t>::min();
+  for (int64_t x = 0; x < numDefLevels; ++x) {
+    minDefLevel = std::min(minDefLevel, defLevels[x]);
+    maxRepLevel = std::max(maxRepLevel, repLevels[x]);
+  }
+  return minDefLevel >= levelInfo.defLevel && maxRepLevel <= levelInfo.repLevel;
+}
+
+// Fast path of DefRepLevelsToListInfo for levels that all pass
+// AllListElementsPresent. Every level is an element, and the ones with a
+// repetition level below the list's start a new non-null list.
+template <typename OffsetType>
+void PresentListElementsToListInfo(
+    const int16_t* repLevels,
+    int64_t numDefLevels,
+    LevelInfo levelInfo,
+    ValidityBitmapInputOutput* output,
+    OffsetType* offsets) {
+  int64_t numLists = 0;
+  if (offsets != nullptr) {
+    if (FOLLY_UNLIKELY(
+            numDefLevels > std::numeric_limits<OffsetType>::max() - *offsets)) {
+      VELOX_FAIL("List index overflow.");
+    }
+    OffsetType offset = *offsets;
+    for (int64_t x = 0; x < numDefLevels; ++x) {
+      numLists += repLevels[x] < levelInfo.repLevel;
+      offsets[numLists] = ++offset;
+    }
+  } else {
+    for (int64_t x = 0; x < numDefLevels; ++x) {
+      numLists += repLevels[x] < levelInfo.repLevel;
+    }
+  }
+  if (FOLLY_UNLIKELY(numLists > output->valuesReadUpperBound)) {
+    VELOX_FAIL(
+        "Definition levels exceeded upper bound: {}",
+        output->valuesReadUpperBound);
+  }
+  if (output->validBits) {
+    ::arrow::bit_util::SetBitsTo(
+        output->validBits, output->validBitsOffset, numLists, true);
+  }
+  output->valuesRead = numLists;
+}
+
 template <typename OffsetType>
 void DefRepLevelsToListInfo(
     const int16_t* defLevels,
@@ -38,6 +95,12 @@ void DefRepLevelsToListInfo(
     LevelInfo levelInfo,
     ValidityBitmapInputOutput* output,
     OffsetType* offsets) {
+  if (AllListElementsPresent(defLevels, repLevels, numDefLevels, levelInfo)) {
+    PresentListElementsToListInfo(
+        repLevels, numDefLevels, levelInfo, output, offsets);
+    return;
+  }
+
   OffsetType* origPos = offsets;
   std::optional<::arrow::internal::FirstTimeBitmapWriter> validBitsWriter;
   if (output->validBits) {
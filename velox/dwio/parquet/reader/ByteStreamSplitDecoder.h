@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::parquet {
+
+namespace detail {
+
+// Transposes 'Width' streams of batch size bytes into batch size values of
+// 'Width' bytes with log2(Width) rounds of byte interleaving. Adapted from
+// the SIMD BYTE_STREAM_SPLIT decoding of Apache Arrow.
+template <int32_t Width, typename A = xsimd::default_arch>
+void byteStreamSplitDecodeSimd(
+    const char* data,
+    int64_t numValues,
+    int64_t& numDecoded,
+    char* result) {
+  using Batch = xsimd::batch<uint8_t, A>;
+  constexpr int32_t kBatchSize = Batch::size;
+  constexpr int32_t kNumRounds = Width == 4 ? 2 : 3;
+  const auto* input = reinterpret_cast<const uint8_t*>(data);
+  auto* output = reinterpret_cast<uint8_t*>(result);
+  std::array<Batch, Width> streams;
+  std::array<Batch, Width> interleaved;
+  for (; numDecoded + kBatchSize <= numValues; numDecoded += kBatchSize) {
+    for (auto i = 0; i < Width; ++i) {
+      streams[i] = Batch::load_unaligned(input + i * numValues + numDecoded);
+    }
+    for (auto round = 0; round < kNumRounds; ++round) {
+      for (auto i = 0; i < Width / 2; ++i) {
+        interleaved[2 * i] = xsimd::zip_lo(streams[i], streams[Width / 2 + i]);
+        interleaved[2 * i + 1] =
+            xsimd::zip_hi(streams[i], streams[Width / 2 + i]);
+      }
+      streams = interleaved;
+    }
+    for (auto i = 0; i < Width; ++i) {
+      streams[i].store_unaligned(output + numDecoded * Width + i * kBatchSize);
+    }
+  }
+}
+
+} // namespace detail
+
+/// Decodes 'numValues' values of 'width' bytes in the BYTE_STREAM_SPLIT
+/// encoding at 'data' into the PLAIN layout at 'result'. The encoding stores
+/// the k-th bytes of all values contiguously, so that floating point values
+/// compress better. Values of 4 and 8 bytes are transposed with SIMD shuffles.
+inline void byteStreamSplitDecode(
+    const char* data,
+    int32_t width,
+    int64_t numValues,
+    char* result) {
+  int64_t numDecoded = 0;
+  if (width == 4) {
+    detail::byteStreamSplitDecodeSimd<4>(data, numValues, numDecoded, result);
+  } else if (width == 8) {
+    detail::byteStreamSplitDecodeSimd<8>(data, numValues, numDecoded, result);
+  }
+  for (auto i = numDecoded; i < numValues; ++i) {
+    for (auto j = 0; j < width; ++j) {
+      result[i * width + j] = data[j * numValues + i];
+    }
+  }
+}
+
+} // namespace facebook::velox::parquet
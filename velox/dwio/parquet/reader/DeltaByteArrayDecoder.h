@@ -17,12 +17,32 @@
 #pragma once
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 
 namespace facebook::velox::parquet {
 
-// DeltaByteArrayDecoder is adapted from Apache Arrow:
+namespace detail {
+
+// Returns the inclusive prefix sums of the lanes of 'x'.
+template <size_t kLanes = 1, typename Batch>
+Batch prefixSumLanes(Batch x) {
+  if constexpr (kLanes < Batch::size) {
+    x += xsimd::slide_left<kLanes * sizeof(typename Batch::value_type)>(x);
+    return prefixSumLanes<kLanes * 2>(x);
+  } else {
+    return x;
+  }
+}
+
+} // namespace detail
+
+// DeltaLengthByteArrayDecoder is adapted from Apache Arrow:
 // https://github.com/apache/arrow/blob/apache-arrow-15.0.0/cpp/src/parquet/encoding.cc#L2758-L2889
+//
+// The lengths are turned into offsets with a SIMD prefix sum when the page
+// is opened, so that strings are read and skipped without walking the
+// lengths.
 class DeltaLengthByteArrayDecoder {
  public:
   explicit DeltaLengthByteArrayDecoder(const char* start) {
@@ -31,28 +51,115 @@ class DeltaLengthByteArrayDecoder {
     bufferStart_ = lengthDecoder_->bufferStart();
   }
 
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(lengthIdx_ + numValues, numValidValues_);
+    lengthIdx_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    int32_t numValues = 0;
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            if constexpr (Visitor::kHasHook) {
+              visitor.setNumValues(
+                  Visitor::kHasFilter ? numValues : visitor.numRows());
+            }
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      ++numValues;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        if constexpr (Visitor::kHasHook) {
+          visitor.setNumValues(
+              Visitor::kHasFilter ? numValues : visitor.numRows());
+        }
+        return;
+      }
+    }
+  }
+
   std::string_view readString() {
-    const int64_t length = bufferedLength_[lengthIdx_++];
-    VELOX_CHECK_GE(length, 0, "negative string delta length");
-    bufferStart_ += length;
-    return std::string_view(bufferStart_ - length, length);
+    VELOX_DCHECK_LT(lengthIdx_, numValidValues_);
+    const auto offset = offsets_[lengthIdx_];
+    const auto length = offsets_[++lengthIdx_] - offset;
+    return std::string_view(bufferStart_ + offset, length);
   }
 
  private:
   void decodeLengths() {
-    int64_t numLength = lengthDecoder_->validValuesCount();
-    bufferedLength_.resize(numLength);
-    lengthDecoder_->readValues<uint32_t>(bufferedLength_.data(), numLength);
+    numValidValues_ = lengthDecoder_->validValuesCount();
+    offsets_.resize(numValidValues_ + 1);
+    offsets_[0] = 0;
+    auto* lengths = offsets_.data() + 1;
+    lengthDecoder_->readValues<uint32_t>(lengths, numValidValues_);
 
+    uint64_t totalLength = 0;
+    uint32_t signBits = 0;
+    for (auto i = 0; i < numValidValues_; ++i) {
+      totalLength += lengths[i];
+      signBits |= lengths[i];
+    }
+    VELOX_CHECK_EQ(signBits & (1U << 31), 0, "negative string delta length");
+    VELOX_CHECK_LE(
+        totalLength,
+        std::numeric_limits<uint32_t>::max(),
+        "string delta lengths too large");
+
+    using Batch = xsimd::batch<uint32_t>;
+    constexpr int32_t kBatchSize = Batch::size;
+    uint32_t carry = 0;
+    int32_t i = 0;
+    for (; i + kBatchSize <= numValidValues_; i += kBatchSize) {
+      auto sums = detail::prefixSumLanes(Batch::load_unaligned(lengths + i)) +
+          Batch::broadcast(carry);
+      sums.store_unaligned(lengths + i);
+      carry = lengths[i + kBatchSize - 1];
+    }
+    for (; i < numValidValues_; ++i) {
+      carry += lengths[i];
+      lengths[i] = carry;
+    }
     lengthIdx_ = 0;
-    numValidValues_ = numLength;
   }
 
   const char* bufferStart_;
   std::unique_ptr<DeltaBpDecoder> lengthDecoder_;
   int32_t numValidValues_{0};
   uint32_t lengthIdx_{0};
-  std::vector<uint32_t> bufferedLength_;
+  // Offsets of the strings from 'bufferStart_', with the end of the last string
+  // at the end.
+  std::vector<uint32_t> offsets_;
 };
 
 // DeltaByteArrayDecoder is adapted from Apache Arrow:
@@ -250,6 +250,78 @@ int64_t ColumnChunkMetaDataPtr::totalUncompressedSize() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.total_uncompressed_size;
 }
 
+bool ColumnChunkMetaDataPtr::isDictionaryEncodedOnly() const {
+  if (!hasDictionaryPageOffset()) {
+    return false;
+  }
+  const auto& metadata = thriftColumnChunkPtr(ptr_)->meta_data;
+  auto isDictionaryEncoding = [](thrift::Encoding::type encoding) {
+    return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+        encoding == thrift::Encoding::RLE_DICTIONARY;
+  };
+  if (metadata.__isset.encoding_stats) {
+    for (const auto& stats : metadata.encoding_stats) {
+      if ((stats.page_type == thrift::PageType::DATA_PAGE ||
+           stats.page_type == thrift::PageType::DATA_PAGE_V2) &&
+          stats.count > 0 && !isDictionaryEncoding(stats.encoding)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // RLE and BIT_PACKED are the encodings of the levels.
+  for (const auto encoding : metadata.encodings) {
+    if (!isDictionaryEncoding(encoding) &&
+        encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ColumnChunkMetaDataPtr::hasBloomFilter() const {
+  return hasMetadata() &&
+      thriftColumnChunkPtr(ptr_)->meta_data.__isset.bloom_filter_offset;
+}
+
+int64_t ColumnChunkMetaDataPtr::bloomFilterOffset() const {
+  VELOX_CHECK(hasBloomFilter());
+  return thriftColumnChunkPtr(ptr_)->meta_data.bloom_filter_offset;
+}
+
+bool ColumnChunkMetaDataPtr::hasColumnIndex() const {
+  return thriftColumnChunkPtr(ptr_)->__isset.column_index_offset &&
+      thriftColumnChunkPtr(ptr_)->__isset.column_index_length &&
+      thriftColumnChunkPtr(ptr_)->column_index_length > 0;
+}
+
+int64_t ColumnChunkMetaDataPtr::columnIndexOffset() const {
+  VELOX_CHECK(hasColumnIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::columnIndexLength() const {
+  VELOX_CHECK(hasColumnIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_length;
+}
+
+bool ColumnChunkMetaDataPtr::hasOffsetIndex() const {
+  return thriftColumnChunkPtr(ptr_)->__isset.offset_index_offset &&
+      thriftColumnChunkPtr(ptr_)->__isset.offset_index_length &&
+      thriftColumnChunkPtr(ptr_)->offset_index_length > 0;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  VELOX_CHECK(hasOffsetIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  VELOX_CHECK(hasOffsetIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
 FOLLY_ALWAYS_INLINE const thrift::RowGroup* thriftRowGroupPtr(
     const void* metadata) {
   return reinterpret_cast<const thrift::RowGroup*>(metadata);
@@ -21,6 +21,18 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Builds Velox column statistics for 'type' from Parquet 'statistics'. Used
+/// for both column chunk statistics and page-level statistics from the column
+/// index.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& statistics,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -64,6 +76,11 @@ class ColumnChunkMetaDataPtr {
   /// The compression.
   common::CompressionKind compression() const;
 
+  /// True if the column chunk has a dictionary page and all its data pages
+  /// are dictionary encoded. Chunks without page encoding statistics are only
+  /// known to be dictionary encoded if no plain encoding is listed.
+  bool isDictionaryEncodedOnly() const;
+
   /// Total byte size of all the compressed (and potentially encrypted)
   /// column data in this row group.
   /// This information is optional and may be 0 if omitted.
@@ -74,6 +91,29 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of a bloom filter for this column chunk.
+  bool hasBloomFilter() const;
+
+  /// File offset of the bloom filter header. The bitset follows the header.
+  /// Must check for its presence using hasBloomFilter().
+  int64_t bloomFilterOffset() const;
+
+  /// Check the presence of the ColumnIndex location for this column chunk.
+  bool hasColumnIndex() const;
+
+  /// File offset and length of the serialized ColumnIndex. Must check for its
+  /// presence using hasColumnIndex().
+  int64_t columnIndexOffset() const;
+  int32_t columnIndexLength() const;
+
+  /// Check the presence of the OffsetIndex location for this column chunk.
+  bool hasOffsetIndex() const;
+
+  /// File offset and length of the serialized OffsetIndex. Must check for its
+  /// presence using hasOffsetIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
  private:
   const void* ptr_;
 };
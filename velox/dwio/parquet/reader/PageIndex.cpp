@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+template <typename T>
+T deserializeThrift(const char* data, int32_t length) {
+  auto transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+
+// Appends [begin, end) to 'ranges', merging with the last range if adjacent.
+void appendRange(int64_t begin, int64_t end, RowRanges& ranges) {
+  if (!ranges.empty() && ranges.back().end == begin) {
+    ranges.back().end = end;
+    return;
+  }
+  ranges.push_back({begin, end});
+}
+
+} // namespace
+
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right) {
+  RowRanges result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    const auto begin = std::max(left[i].begin, right[j].begin);
+    const auto end = std::min(left[i].end, right[j].end);
+    if (begin < end) {
+      appendRange(begin, end, result);
+    }
+    if (left[i].end < right[j].end) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
+PageIndex::PageIndex(
+    thrift::ColumnIndex columnIndex,
+    thrift::OffsetIndex offsetIndex,
+    int64_t numRowsInRowGroup)
+    : columnIndex_(std::move(columnIndex)),
+      offsetIndex_(std::move(offsetIndex)),
+      numRowsInRowGroup_(numRowsInRowGroup) {
+  VELOX_CHECK_EQ(
+      columnIndex_.null_pages.size(),
+      offsetIndex_.page_locations.size(),
+      "ColumnIndex and OffsetIndex disagree on the number of pages");
+}
+
+thrift::OffsetIndex deserializeOffsetIndex(const char* data, int32_t length) {
+  return deserializeThrift<thrift::OffsetIndex>(data, length);
+}
+
+std::vector<PageSpan> selectPages(
+    const thrift::OffsetIndex& offsetIndex,
+    const RowRanges& rows,
+    int64_t numRowsInRowGroup) {
+  std::vector<PageSpan> spans;
+  const auto& locations = offsetIndex.page_locations;
+  size_t range = 0;
+  for (auto page = 0; page < locations.size(); ++page) {
+    const auto& location = locations[page];
+    const auto begin = location.first_row_index;
+    const auto end = page + 1 < locations.size()
+        ? locations[page + 1].first_row_index
+        : numRowsInRowGroup;
+    while (range < rows.size() && rows[range].end <= begin) {
+      ++range;
+    }
+    if (range == rows.size()) {
+      break;
+    }
+    if (rows[range].begin >= end) {
+      continue;
+    }
+    if (!spans.empty() &&
+        spans.back().offset + spans.back().length == location.offset) {
+      spans.back().length += location.compressed_page_size;
+    } else {
+      spans.push_back({location.offset, location.compressed_page_size, begin});
+    }
+  }
+  return spans;
+}
+
+// static
+std::unique_ptr<PageIndex> PageIndex::deserialize(
+    const char* columnIndex,
+    int32_t columnIndexLength,
+    const char* offsetIndex,
+    int32_t offsetIndexLength,
+    int64_t numRowsInRowGroup) {
+  return std::make_unique<PageIndex>(
+      deserializeThrift<thrift::ColumnIndex>(columnIndex, columnIndexLength),
+      deserializeThrift<thrift::OffsetIndex>(offsetIndex, offsetIndexLength),
+      numRowsInRowGroup);
+}
+
+int64_t PageIndex::numRows(int32_t page) const {
+  const auto end = page + 1 < numPages() ? firstRow(page + 1)
+                                         : numRowsInRowGroup_;
+  return end - firstRow(page);
+}
+
+RowRanges PageIndex::filterPages(
+    const common::Filter& filter,
+    const TypePtr& type) const {
+  RowRanges ranges;
+  const bool hasNullCounts = columnIndex_.__isset.null_counts &&
+      columnIndex_.null_counts.size() == numPages();
+  for (auto page = 0; page < numPages(); ++page) {
+    const auto pageRows = numRows(page);
+    thrift::Statistics pageStats;
+    if (columnIndex_.null_pages[page]) {
+      pageStats.__set_null_count(pageRows);
+    } else {
+      pageStats.__set_min_value(columnIndex_.min_values[page]);
+      pageStats.__set_max_value(columnIndex_.max_values[page]);
+      if (hasNullCounts) {
+        pageStats.__set_null_count(columnIndex_.null_counts[page]);
+      }
+    }
+    auto columnStats = buildColumnStatisticsFromThrift(
+        pageStats, *type, static_cast<uint64_t>(pageRows));
+    if (common::testFilter(&filter, columnStats.get(), pageRows, type)) {
+      appendRange(firstRow(page), firstRow(page) + pageRows, ranges);
+    }
+  }
+  return ranges;
+}
+
+} // namespace facebook::velox::parquet
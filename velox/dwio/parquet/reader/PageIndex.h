@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// A range of rows [begin, end) relative to the first row of a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  int64_t size() const {
+    return end - begin;
+  }
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// Sorted, non-overlapping and non-adjacent row ranges.
+using RowRanges = std::vector<RowRange>;
+
+/// Returns the rows that are in both 'left' and 'right'.
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right);
+
+/// A run of consecutive pages of a column chunk. 'offset' is the file offset
+/// of the header of the first page, 'length' the size of the pages including
+/// their headers and 'firstRow' the row number of the first row of the first
+/// page relative to the row group.
+struct PageSpan {
+  int64_t offset;
+  int64_t length;
+  int64_t firstRow;
+
+  bool operator==(const PageSpan& other) const {
+    return offset == other.offset && length == other.length &&
+        firstRow == other.firstRow;
+  }
+};
+
+/// Parses a serialized OffsetIndex.
+thrift::OffsetIndex deserializeOffsetIndex(const char* data, int32_t length);
+
+/// Returns the runs of the pages in 'offsetIndex' that contain any of 'rows'.
+/// Adjacent pages in the file are merged into one run. The pages are those of
+/// a column with one value per top level row.
+std::vector<PageSpan> selectPages(
+    const thrift::OffsetIndex& offsetIndex,
+    const RowRanges& rows,
+    int64_t numRowsInRowGroup);
+
+/// Page-level statistics and page locations of a column chunk, i.e. the
+/// ColumnIndex and OffsetIndex structures described in
+/// https://github.com/apache/parquet-format/blob/master/PageIndex.md.
+class PageIndex {
+ public:
+  PageIndex(
+      thrift::ColumnIndex columnIndex,
+      thrift::OffsetIndex offsetIndex,
+      int64_t numRowsInRowGroup);
+
+  /// Parses a PageIndex from serialized ColumnIndex and OffsetIndex.
+  static std::unique_ptr<PageIndex> deserialize(
+      const char* columnIndex,
+      int32_t columnIndexLength,
+      const char* offsetIndex,
+      int32_t offsetIndexLength,
+      int64_t numRowsInRowGroup);
+
+  int32_t numPages() const {
+    return offsetIndex_.page_locations.size();
+  }
+
+  /// Row number of the first row in 'page' relative to the row group.
+  int64_t firstRow(int32_t page) const {
+    return offsetIndex_.page_locations[page].first_row_index;
+  }
+
+  /// Number of top level rows in 'page'.
+  int64_t numRows(int32_t page) const;
+
+  /// Returns the rows of the pages that may contain values passing 'filter'
+  /// according to the page min/max values and null counts. Pages whose
+  /// statistics are not usable are included.
+  RowRanges filterPages(const common::Filter& filter, const TypePtr& type)
+      const;
+
+ private:
+  const thrift::ColumnIndex columnIndex_;
+  const thrift::OffsetIndex offsetIndex_;
+  const int64_t numRowsInRowGroup_;
+};
+
+} // namespace facebook::velox::parquet
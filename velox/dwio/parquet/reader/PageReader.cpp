@@ -22,6 +22,7 @@
 #include "velox/dwio/common/ColumnVisitors.h"
 #include "velox/dwio/parquet/common/LevelConversion.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
+#include "velox/functions/lib/string/StringCore.h"
 #include "velox/vector/FlatVector.h"
 
 #include <thrift/protocol/TCompactProtocol.h> // @manual
@@ -44,6 +45,11 @@ void PageReader::seekToPage(int64_t row) {
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
+    if (!pageSpans_.empty() && !seekToPageSpan()) {
+      numRepDefsInPage_ = 0;
+      numRowsInPage_ = 0;
+      break;
+    }
     if (chunkSize_ <= pageStart_) {
       // This may happen if seeking to exactly end of row group.
       numRepDefsInPage_ = 0;
@@ -81,6 +87,50 @@ void PageReader::seekToPage(int64_t row) {
   }
 }
 
+void PageReader::setPageSpans(
+    std::vector<PageSpan> spans,
+    std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams,
+    int64_t chunkOffset,
+    int64_t numRows) {
+  VELOX_CHECK(isTopLevel_);
+  VELOX_CHECK(!spans.empty());
+  VELOX_CHECK_EQ(spans.size(), streams.size());
+  VELOX_CHECK_EQ(pageSpanIndex_, -1);
+  for (auto& span : spans) {
+    VELOX_CHECK_GE(span.offset, chunkOffset);
+    span.offset -= chunkOffset;
+  }
+  pageSpans_ = std::move(spans);
+  pageSpanStreams_ = std::move(streams);
+  numRowsInChunk_ = numRows;
+}
+
+bool PageReader::seekToPageSpan() {
+  if (pageSpanIndex_ >= 0) {
+    if (pageSpanIndex_ == pageSpans_.size()) {
+      return false;
+    }
+    const auto& span = pageSpans_[pageSpanIndex_];
+    if (pageStart_ < span.offset + span.length) {
+      return true;
+    }
+  }
+  if (++pageSpanIndex_ == pageSpans_.size()) {
+    inputStream_.reset();
+    rowOfPage_ = numRowsInChunk_;
+    return false;
+  }
+  // The pages between the spans are not read. The next page starts at the
+  // first row of the span.
+  const auto& span = pageSpans_[pageSpanIndex_];
+  inputStream_ = std::move(pageSpanStreams_[pageSpanIndex_]);
+  bufferStart_ = bufferEnd_ = nullptr;
+  pageStart_ = span.offset;
+  rowOfPage_ = span.firstRow;
+  numRowsInPage_ = 0;
+  return true;
+}
+
 PageHeader PageReader::readPageHeader() {
   TestValue::adjust(
       "facebook::velox::parquet::PageReader::readPageHeader", this);
@@ -334,6 +384,15 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   }
 }
 
+bool PageReader::readDictionaryPage() {
+  const auto pageHeader = readPageHeader();
+  if (pageHeader.type != thrift::PageType::DICTIONARY_PAGE) {
+    return false;
+  }
+  prepareDictionary(pageHeader);
+  return true;
+}
+
 void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   dictionary_.numValues = pageHeader.dictionary_page_header.num_values;
   dictionaryEncoding_ = pageHeader.dictionary_page_header.encoding;
@@ -464,12 +523,16 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
         stats_.pageLoadTimeNs.increment(readUs * 1'000);
       }
       auto header = strings;
+      bool isAscii = true;
       for (auto i = 0; i < dictionary_.numValues; ++i) {
         auto length = *reinterpret_cast<const int32_t*>(header);
         values[i] = StringView(header + sizeof(int32_t), length);
+        isAscii = isAscii &&
+            functions::stringCore::isAscii(header + sizeof(int32_t), length);
         header += length + sizeof(int32_t);
       }
       VELOX_CHECK_EQ(header, strings + numBytes);
+      dictionary_.isAscii = isAscii;
       break;
     }
     case thrift::Type::FIXED_LEN_BYTE_ARRAY: {
@@ -775,6 +838,47 @@ void PageReader::makeDecoder() {
           VELOX_UNSUPPORTED("RLE decoder only supports BOOLEAN");
       }
       break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+        case thrift::Type::INT32:
+        case thrift::Type::INT64: {
+          // The values are transposed back to the PLAIN layout, which the
+          // direct decoder reads with its fast paths and filters.
+          const auto valueSize = parquetTypeBytes(parquetType);
+          VELOX_CHECK_EQ(
+              encodedDataSize_ % valueSize,
+              0,
+              "Invalid BYTE_STREAM_SPLIT page size: {}",
+              encodedDataSize_);
+          dwio::common::ensureCapacity<char>(
+              byteStreamSplitValues_,
+              encodedDataSize_ + simd::kPadding,
+              &pool_);
+          auto* values = byteStreamSplitValues_->asMutable<char>();
+          byteStreamSplitDecode(
+              pageData_, valueSize, encodedDataSize_ / valueSize, values);
+          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+              std::make_unique<dwio::common::SeekableArrayInputStream>(
+                  values, encodedDataSize_),
+              false,
+              valueSize);
+          break;
+        }
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports FLOAT, DOUBLE, INT32 "
+              "and INT64");
+      }
+      break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType == thrift::Type::BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_ =
+            std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+        break;
+      }
+      [[fallthrough]];
     case Encoding::DELTA_BYTE_ARRAY:
       if (parquetType == thrift::Type::BYTE_ARRAY) {
         deltaByteArrDecoder_ =
@@ -792,15 +896,18 @@ void PageReader::skip(int64_t numRows) {
     // Return if no skip and position not at end of page or before first page.
     return;
   }
-  auto toSkip = numRows;
-  if (firstUnvisited_ + numRows >= rowOfPage_ + numRowsInPage_) {
-    seekToPage(firstUnvisited_ + numRows);
+  const auto end = firstUnvisited_ + numRows;
+  if (end >= rowOfPage_ + numRowsInPage_) {
+    seekToPage(end);
     if (hasChunkRepDefs_) {
       numLeafNullsConsumed_ = rowOfPage_;
     }
-    toSkip -= rowOfPage_ - firstUnvisited_;
   }
-  firstUnvisited_ += numRows;
+  // The decoders are at the later of 'firstUnvisited_' and the start of the
+  // page. The rows before the page are in pages pruned by setPageSpans().
+  int64_t toSkip = std::max<int64_t>(
+      0, end - std::max<int64_t>(firstUnvisited_, rowOfPage_));
+  firstUnvisited_ = end;
 
   if (toSkip == 0) {
     return;
@@ -824,6 +931,8 @@ void PageReader::skip(int64_t numRows) {
     deltaBpDecoder_->skip(toSkip);
   } else if (deltaByteArrDecoder_) {
     deltaByteArrDecoder_->skip(toSkip);
+  } else if (deltaLengthByteArrDecoder_) {
+    deltaLengthByteArrDecoder_->skip(toSkip);
   } else if (rleBooleanDecoder_) {
     rleBooleanDecoder_->skip(toSkip);
   } else {
@@ -857,14 +966,13 @@ void PageReader::skipNullsOnly(int64_t numRows) {
     // Return if no skip and position not at end of page or before first page.
     return;
   }
-  auto toSkip = numRows;
-  if (firstUnvisited_ + numRows >= rowOfPage_ + numRowsInPage_) {
-    seekToPage(firstUnvisited_ + numRows);
-    firstUnvisited_ += numRows;
-    toSkip = firstUnvisited_ - rowOfPage_;
-  } else {
-    firstUnvisited_ += numRows;
+  const auto end = firstUnvisited_ + numRows;
+  if (end >= rowOfPage_ + numRowsInPage_) {
+    seekToPage(end);
   }
+  const auto toSkip = std::max<int64_t>(
+      0, end - std::max<int64_t>(firstUnvisited_, rowOfPage_));
+  firstUnvisited_ = end;
 
   // Skip nulls
   skipNulls(toSkip);
@@ -878,11 +986,19 @@ void PageReader::readNullsOnly(int64_t numValues, BufferPtr& buffer) {
   }
   nullConcatenation_.reset(buffer);
   while (toRead) {
-    auto availableOnPage = rowOfPage_ + numRowsInPage_ - firstUnvisited_;
-    if (!availableOnPage) {
+    if (firstUnvisited_ >= rowOfPage_ + numRowsInPage_) {
       seekToPage(firstUnvisited_);
-      availableOnPage = numRowsInPage_;
     }
+    if (firstUnvisited_ < rowOfPage_) {
+      // The rows are in pages pruned by setPageSpans(). They are not selected
+      // by the caller and are returned as not null.
+      const auto numPruned = std::min(rowOfPage_ - firstUnvisited_, toRead);
+      nullConcatenation_.appendOnes(numPruned);
+      toRead -= numPruned;
+      firstUnvisited_ += numPruned;
+      continue;
+    }
+    auto availableOnPage = rowOfPage_ + numRowsInPage_ - firstUnvisited_;
     auto numRead = std::min(availableOnPage, toRead);
     auto nulls = readNulls(numRead, nullsInReadRange_);
     toRead -= numRead;
@@ -939,6 +1055,8 @@ bool PageReader::rowsForPage(
   auto rowZero = visitBase_ + visitorRows_[currentVisitorRow_];
   if (rowZero >= rowOfPage_ + numRowsInPage_) {
     seekToPage(rowZero);
+    // The rows to visit are never in pages pruned by setPageSpans().
+    VELOX_DCHECK_GE(rowZero, rowOfPage_);
     if (hasChunkRepDefs_) {
       numLeafNullsConsumed_ = rowOfPage_;
     }
@@ -989,15 +1107,18 @@ bool PageReader::rowsForPage(
   }
   // If the page did not change and this is the first call, we can return a view
   // on the original visitor rows.
-  if (rowOfPage_ == initialRowOfPage_ && currentVisitorRow_ == 0) {
+  if (rowOfPage_ == initialRowOfPage_ && currentVisitorRow_ == 0 &&
+      visitBase_ >= rowOfPage_) {
     nulls =
         readNulls(visitorRows_[numToVisit - 1] + 1, reader.nullsInReadRange());
     rowNumberBias_ = 0;
     rows = folly::Range<const vector_size_t*>(visitorRows_, numToVisit);
   } else {
     // We scale row numbers to be relative to first on this page.
+    // The decoders are at the start of the page.
     auto pageOffset = rowOfPage_ - visitBase_;
     rowNumberBias_ = visitorRows_[currentVisitorRow_];
+    firstUnvisited_ = rowOfPage_;
     skip(rowNumberBias_ - pageOffset);
     // The decoder is positioned at 'visitorRows_[currentVisitorRow_']'
     // We copy the rows to visit with a bias, so that the first to visit has
@@ -1026,13 +1147,17 @@ bool PageReader::rowsForPage(
 
 const VectorPtr& PageReader::dictionaryValues(const TypePtr& type) {
   if (!dictionaryValues_) {
-    dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
+    auto values = std::make_shared<FlatVector<StringView>>(
         &pool_,
         type,
         nullptr,
         dictionary_.numValues,
         dictionary_.values,
         std::vector<BufferPtr>{dictionary_.strings});
+    if (dictionary_.isAscii.has_value()) {
+      values->setAllIsAscii(dictionary_.isAscii.value());
+    }
+    dictionaryValues_ = std::move(values);
   }
   return dictionaryValues_;
 }
@@ -23,8 +23,10 @@
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/common/RleEncodingInternal.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -80,6 +82,18 @@ class PageReader {
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
+  /// Restricts reading to 'spans' of the column chunk, e.g. the pages left
+  /// after pruning by the page index. 'streams' has the data of each of
+  /// 'spans'. 'chunkOffset' is the file offset of the column chunk and
+  /// 'numRows' its number of rows. The rows outside of 'spans' have no values
+  /// and may only be skipped. Only for top level columns. Must be called
+  /// before the first read.
+  void setPageSpans(
+      std::vector<PageSpan> spans,
+      std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams,
+      int64_t chunkOffset,
+      int64_t numRows);
+
   /// Decodes repdefs for 'numTopLevelRows'. Use getLengthsAndNulls()
   /// to access the lengths and nulls for the different nesting
   /// levels.
@@ -120,6 +134,16 @@ class PageReader {
   // Returns the current string dictionary as a FlatVector<StringView>.
   const VectorPtr& dictionaryValues(const TypePtr& type);
 
+  /// Reads the dictionary page at the start of the column chunk into
+  /// dictionary(). Returns false if the first page is not a dictionary page.
+  /// Used for testing a filter against the dictionary without reading the
+  /// data pages.
+  bool readDictionaryPage();
+
+  const dwio::common::DictionaryValues& dictionary() const {
+    return dictionary_;
+  }
+
   // True if the current page holds dictionary indices.
   bool isDictionary() const {
     return encoding_ == thrift::Encoding::PLAIN_DICTIONARY ||
@@ -187,6 +211,10 @@ class PageReader {
   // allowed for non-top level columns.
   void seekToPage(int64_t row);
 
+  // Moves to the next of 'pageSpans_' if the pages of the current one are all
+  // read. Returns false if there is no next span.
+  bool seekToPageSpan();
+
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
   // reads ahead for repdefs and the other tracks the data. This is
@@ -316,6 +344,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         nullsFromFastPath = false;
         deltaByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -326,6 +357,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         deltaByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -454,6 +487,9 @@ class PageReader {
   // contiguous run of bytes.
   const char* pageData_{nullptr};
 
+  // Values of a BYTE_STREAM_SPLIT page in the PLAIN layout.
+  BufferPtr byteStreamSplitValues_;
+
   // Dictionary contents.
   dwio::common::DictionaryValues dictionary_;
   thrift::Encoding::type dictionaryEncoding_;
@@ -464,6 +500,22 @@ class PageReader {
   // Offset of first byte after current page' header.
   uint64_t pageDataStart_{0};
 
+  // Runs of pages to read, with offsets from the start of the ColumnChunk.
+  // Empty if all the pages are read from 'inputStream_'.
+  std::vector<PageSpan> pageSpans_;
+
+  // The data of each of 'pageSpans_'. Moved to 'inputStream_' when the span
+  // is reached.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      pageSpanStreams_;
+
+  // Index of the span being read in 'pageSpans_'. -1 before the first.
+  int32_t pageSpanIndex_{-1};
+
+  // Number of rows in the ColumnChunk. The position after the last of
+  // 'pageSpans_'.
+  int64_t numRowsInChunk_{0};
+
   // Number of bytes starting at pageData_ for current encoded data.
   int32_t encodedDataSize_{0};
 
@@ -520,6 +572,7 @@ class PageReader {
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
   std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrDecoder_;
   std::unique_ptr<RleBpDataDecoder> rleBooleanDecoder_;
   // Add decoders for other encodings here.
 };
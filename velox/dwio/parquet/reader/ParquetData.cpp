@@ -16,8 +16,12 @@
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/StreamUtil.h"
 #include "velox/dwio/parquet/reader/ParquetStatsContext.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 namespace facebook::velox::parquet {
 
@@ -28,6 +32,177 @@ std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
       type, metaData_, pool(), runtimeStatistics(), sessionTimezone_);
 }
 
+namespace {
+
+// Upper bound for the serialized size of a BloomFilterHeader. The header is a
+// few bytes in practice.
+constexpr uint64_t kBloomFilterHeaderSizeGuess = 256;
+
+// Bloom filters larger than this are not read for row group filtering.
+constexpr int32_t kMaxBloomFilterBytes = 16 << 20;
+
+// True if the values in the column of 'type' are hashed into the bloom filter
+// with the same representation as the values of the filters in the ScanSpec.
+bool isBloomFilterApplicable(const ParquetTypeWithId& type) {
+  if (!type.parquetType_.has_value() || type.type()->isDecimal()) {
+    return false;
+  }
+  if (type.convertedType_.has_value()) {
+    switch (type.convertedType_.value()) {
+      case thrift::ConvertedType::UINT_8:
+      case thrift::ConvertedType::UINT_16:
+      case thrift::ConvertedType::UINT_32:
+      case thrift::ConvertedType::UINT_64:
+        return false;
+      default:
+        break;
+    }
+  }
+  if (type.logicalType_.has_value() && type.logicalType_->__isset.INTEGER &&
+      !type.logicalType_->INTEGER.isSigned) {
+    return false;
+  }
+  switch (type.parquetType_.value()) {
+    case thrift::Type::INT32:
+      return type.type()->kind() == TypeKind::TINYINT ||
+          type.type()->kind() == TypeKind::SMALLINT ||
+          type.type()->kind() == TypeKind::INTEGER;
+    case thrift::Type::INT64:
+      return type.type()->kind() == TypeKind::BIGINT;
+    case thrift::Type::BYTE_ARRAY:
+      return type.type()->kind() == TypeKind::VARCHAR ||
+          type.type()->kind() == TypeKind::VARBINARY;
+    default:
+      return false;
+  }
+}
+
+// True if 'filter' passes a finite set of values, so that it can be tested
+// against a bloom filter.
+bool isPointFilter(const common::Filter& filter) {
+  if (filter.testNull()) {
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return filter.as<common::BigintRange>()->isSingleValue();
+    case common::FilterKind::kBytesRange:
+      return filter.as<common::BytesRange>()->isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+    case common::FilterKind::kBytesValues:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool mayContainInteger(
+    const BlockSplitBloomFilter& bloomFilter,
+    thrift::Type::type physicalType,
+    int64_t value) {
+  if (physicalType == thrift::Type::INT64) {
+    return bloomFilter.findHash(bloomFilter.hash(value));
+  }
+  if (value < std::numeric_limits<int32_t>::min() ||
+      value > std::numeric_limits<int32_t>::max()) {
+    // Not representable in the column.
+    return false;
+  }
+  return bloomFilter.findHash(bloomFilter.hash(static_cast<int32_t>(value)));
+}
+
+bool mayContainBytes(
+    const BlockSplitBloomFilter& bloomFilter,
+    std::string_view value) {
+  ByteArray byteArray(value);
+  return bloomFilter.findHash(bloomFilter.hash(&byteArray));
+}
+
+// Returns false if none of the values passing 'filter' is in 'bloomFilter'.
+// 'filter' must satisfy isPointFilter().
+bool bloomFilterMayMatch(
+    const BlockSplitBloomFilter& bloomFilter,
+    thrift::Type::type physicalType,
+    const common::Filter& filter) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return mayContainInteger(
+          bloomFilter,
+          physicalType,
+          filter.as<common::BigintRange>()->lower());
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      for (auto value :
+           filter.as<common::BigintValuesUsingHashTable>()->values()) {
+        if (mayContainInteger(bloomFilter, physicalType, value)) {
+          return true;
+        }
+      }
+      return false;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      for (auto value :
+           filter.as<common::BigintValuesUsingBitmask>()->values()) {
+        if (mayContainInteger(bloomFilter, physicalType, value)) {
+          return true;
+        }
+      }
+      return false;
+    case common::FilterKind::kBytesRange:
+      return mayContainBytes(
+          bloomFilter, filter.as<common::BytesRange>()->lower());
+    case common::FilterKind::kBytesValues:
+      for (const auto& value : filter.as<common::BytesValues>()->values()) {
+        if (mayContainBytes(bloomFilter, value)) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      return true;
+  }
+}
+
+// Returns true if an entry of 'dictionary' of a column of 'physicalType'
+// passes 'filter'.
+bool dictionaryMayMatch(
+    const dwio::common::DictionaryValues& dictionary,
+    thrift::Type::type physicalType,
+    const common::Filter& filter) {
+  switch (physicalType) {
+    case thrift::Type::INT32: {
+      const auto* values = dictionary.values->as<int32_t>();
+      for (auto i = 0; i < dictionary.numValues; ++i) {
+        if (filter.testInt64(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case thrift::Type::INT64: {
+      const auto* values = dictionary.values->as<int64_t>();
+      for (auto i = 0; i < dictionary.numValues; ++i) {
+        if (filter.testInt64(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case thrift::Type::BYTE_ARRAY: {
+      const auto* values = dictionary.values->as<StringView>();
+      for (auto i = 0; i < dictionary.numValues; ++i) {
+        if (filter.testBytes(values[i].data(), values[i].size())) {
+          return true;
+        }
+      }
+      return false;
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace
+
 void ParquetData::filterRowGroups(
     const common::ScanSpec& scanSpec,
     uint64_t /*rowsPerRowGroup*/,
@@ -70,6 +245,209 @@ void ParquetData::filterRowGroups(
   }
 }
 
+void ParquetData::filterRowGroupsByBloomFilter(
+    const common::ScanSpec& scanSpec,
+    const std::vector<uint32_t>& rowGroups,
+    dwio::common::BufferedInput& input,
+    FilterRowGroupsResult& result) const {
+  auto* filter = scanSpec.filter();
+  if (!filter || !isPointFilter(*filter) || !isBloomFilterApplicable(*type_)) {
+    return;
+  }
+  result.totalCount =
+      std::max<int>(result.totalCount, fileMetaDataPtr_.numRowGroups());
+  const auto nwords = bits::nwords(result.totalCount);
+  if (result.filterResult.size() < nwords) {
+    result.filterResult.resize(nwords);
+  }
+  std::vector<uint32_t> candidates;
+  for (auto rowGroup : rowGroups) {
+    if (bits::isBitSet(result.filterResult.data(), rowGroup)) {
+      continue;
+    }
+    if (fileMetaDataPtr_.rowGroup(rowGroup)
+            .columnChunk(type_->column())
+            .hasBloomFilter()) {
+      candidates.push_back(rowGroup);
+    }
+  }
+  if (candidates.empty()) {
+    return;
+  }
+  auto bloomFilters = readBloomFilters(candidates, input);
+  for (auto i = 0; i < candidates.size(); ++i) {
+    if (bloomFilters[i] &&
+        !bloomFilterMayMatch(
+            *bloomFilters[i], type_->parquetType_.value(), *filter)) {
+      bits::setBit(result.filterResult.data(), candidates[i]);
+    }
+  }
+}
+
+void ParquetData::filterRowGroupsByDictionary(
+    const common::ScanSpec& scanSpec,
+    const std::vector<uint32_t>& rowGroups,
+    dwio::common::BufferedInput& input,
+    FilterRowGroupsResult& result) const {
+  auto* filter = scanSpec.filter();
+  // The dictionary values have the representation of the filter values for
+  // the same types as the bloom filters. A row group with nulls may pass a
+  // filter that passes nulls without any dictionary entry passing.
+  if (!filter || filter->testNull() || !isBloomFilterApplicable(*type_) ||
+      type_->maxRepeat_ > 0) {
+    return;
+  }
+  result.totalCount =
+      std::max<int>(result.totalCount, fileMetaDataPtr_.numRowGroups());
+  const auto nwords = bits::nwords(result.totalCount);
+  if (result.filterResult.size() < nwords) {
+    result.filterResult.resize(nwords);
+  }
+  std::vector<uint32_t> candidates;
+  for (auto rowGroup : rowGroups) {
+    if (bits::isBitSet(result.filterResult.data(), rowGroup)) {
+      continue;
+    }
+    const auto chunk =
+        fileMetaDataPtr_.rowGroup(rowGroup).columnChunk(type_->column());
+    if (chunk.isDictionaryEncodedOnly() &&
+        chunk.dictionaryPageOffset() >= 4 &&
+        chunk.dictionaryPageOffset() < chunk.dataPageOffset()) {
+      candidates.push_back(rowGroup);
+    }
+  }
+  if (candidates.empty()) {
+    return;
+  }
+
+  // Reads the dictionary pages, which precede the data pages of the chunks.
+  auto dictionaryInput = input.clone();
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams;
+  streams.reserve(candidates.size());
+  for (auto rowGroup : candidates) {
+    const auto chunk =
+        fileMetaDataPtr_.rowGroup(rowGroup).columnChunk(type_->column());
+    streams.push_back(dictionaryInput->enqueue(
+        {static_cast<uint64_t>(chunk.dictionaryPageOffset()),
+         static_cast<uint64_t>(
+             chunk.dataPageOffset() - chunk.dictionaryPageOffset())}));
+  }
+  dictionaryInput->load(dwio::common::LogType::STRIPE_INDEX);
+
+  dwio::common::ColumnReaderStatistics stats;
+  for (auto i = 0; i < candidates.size(); ++i) {
+    const auto chunk =
+        fileMetaDataPtr_.rowGroup(candidates[i]).columnChunk(type_->column());
+    PageReader reader(
+        std::move(streams[i]),
+        pool_,
+        type_,
+        chunk.compression(),
+        chunk.dataPageOffset() - chunk.dictionaryPageOffset(),
+        stats,
+        sessionTimezone_);
+    try {
+      if (!reader.readDictionaryPage()) {
+        continue;
+      }
+    } catch (const std::exception& e) {
+      VLOG(1) << "Ignoring unreadable dictionary page: " << e.what();
+      continue;
+    }
+    if (!dictionaryMayMatch(
+            reader.dictionary(), type_->parquetType_.value(), *filter)) {
+      bits::setBit(result.filterResult.data(), candidates[i]);
+    }
+  }
+}
+
+std::vector<std::unique_ptr<BlockSplitBloomFilter>>
+ParquetData::readBloomFilters(
+    const std::vector<uint32_t>& rowGroups,
+    dwio::common::BufferedInput& input) const {
+  const uint64_t fileSize = input.getReadFile()->size();
+  std::vector<int64_t> offsets;
+  offsets.reserve(rowGroups.size());
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams;
+  streams.reserve(rowGroups.size());
+  auto headerInput = input.clone();
+  for (auto rowGroup : rowGroups) {
+    const auto offset = fileMetaDataPtr_.rowGroup(rowGroup)
+                            .columnChunk(type_->column())
+                            .bloomFilterOffset();
+    VELOX_CHECK_LT(offset, fileSize, "Bloom filter offset is past end of file");
+    offsets.push_back(offset);
+    streams.push_back(headerInput->enqueue(
+        {static_cast<uint64_t>(offset),
+         std::min(kBloomFilterHeaderSizeGuess, fileSize - offset)}));
+  }
+  headerInput->load(dwio::common::LogType::STRIPE_INDEX);
+
+  // Parse the headers and enqueue the bitsets of the supported bloom filters.
+  std::vector<int32_t> numBytes(rowGroups.size(), 0);
+  auto bitsetInput = input.clone();
+  std::vector<char> header;
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    const auto headerReadSize =
+        std::min(kBloomFilterHeaderSizeGuess, fileSize - offsets[i]);
+    header.resize(headerReadSize);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        headerReadSize, streams[i].get(), header.data(), bufferStart, bufferEnd);
+    thrift::BloomFilterHeader bloomFilterHeader;
+    uint32_t headerSize;
+    try {
+      auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+          header.data(), headerReadSize);
+      apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+          protocol(transport);
+      headerSize = bloomFilterHeader.read(&protocol);
+    } catch (const std::exception& e) {
+      VLOG(1) << "Ignoring unreadable bloom filter header: " << e.what();
+      streams[i].reset();
+      continue;
+    }
+    if (!bloomFilterHeader.algorithm.__isset.BLOCK ||
+        !bloomFilterHeader.hash.__isset.XXHASH ||
+        !bloomFilterHeader.compression.__isset.UNCOMPRESSED ||
+        bloomFilterHeader.numBytes <
+            BlockSplitBloomFilter::kMinimumBloomFilterBytes ||
+        bloomFilterHeader.numBytes > kMaxBloomFilterBytes ||
+        (bloomFilterHeader.numBytes & (bloomFilterHeader.numBytes - 1)) !=
+            0 ||
+        static_cast<uint64_t>(offsets[i]) + headerSize +
+                bloomFilterHeader.numBytes >
+            fileSize) {
+      streams[i].reset();
+      continue;
+    }
+    numBytes[i] = bloomFilterHeader.numBytes;
+    streams[i] = bitsetInput->enqueue(
+        {static_cast<uint64_t>(offsets[i] + headerSize),
+         static_cast<uint64_t>(numBytes[i])});
+  }
+  bitsetInput->load(dwio::common::LogType::STRIPE_INDEX);
+
+  std::vector<std::unique_ptr<BlockSplitBloomFilter>> bloomFilters(
+      rowGroups.size());
+  std::vector<char> bitset;
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    if (!streams[i]) {
+      continue;
+    }
+    bitset.resize(numBytes[i]);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        numBytes[i], streams[i].get(), bitset.data(), bufferStart, bufferEnd);
+    bloomFilters[i] = std::make_unique<BlockSplitBloomFilter>(&pool_);
+    bloomFilters[i]->init(
+        reinterpret_cast<const uint8_t*>(bitset.data()), numBytes[i]);
+  }
+  return bloomFilters;
+}
+
 bool ParquetData::rowGroupMatches(
     uint32_t rowGroupId,
     const common::Filter* filter) {
@@ -91,16 +469,187 @@ bool ParquetData::rowGroupMatches(
   return true;
 }
 
-void ParquetData::enqueueRowGroup(
-    uint32_t index,
+std::vector<std::optional<RowRanges>> ParquetData::filterPages(
+    const common::ScanSpec& scanSpec,
+    const std::vector<uint32_t>& rowGroups,
+    const dwio::common::StatsContext& writerContext,
+    dwio::common::BufferedInput& input) const {
+  std::vector<std::optional<RowRanges>> result(rowGroups.size());
+  auto* filter = scanSpec.filter();
+  if (!filter || maxRepeat_ > 0) {
+    return result;
+  }
+  auto parquetStatsContext =
+      reinterpret_cast<const ParquetStatsContext*>(&writerContext);
+  if (type_->parquetType_.has_value() &&
+      parquetStatsContext->shouldIgnoreStatistics(
+          type_->parquetType_.value())) {
+    return result;
+  }
+  auto pageIndexes = readPageIndexes(rowGroups, input);
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    if (pageIndexes[i]) {
+      result[i] = pageIndexes[i]->filterPages(*filter, type_->type());
+    }
+  }
+  return result;
+}
+
+std::vector<std::unique_ptr<PageIndex>> ParquetData::readPageIndexes(
+    const std::vector<uint32_t>& rowGroups,
+    dwio::common::BufferedInput& input) const {
+  std::vector<std::unique_ptr<PageIndex>> pageIndexes(rowGroups.size());
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      columnIndexStreams(rowGroups.size());
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams(rowGroups.size());
+  // The ColumnIndex and OffsetIndex of a chunk are usually adjacent in the
+  // file and the load merges them with the indexes of the other row groups.
+  auto indexInput = input.clone();
+  bool anyIndex = false;
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    auto columnChunk =
+        fileMetaDataPtr_.rowGroup(rowGroups[i]).columnChunk(type_->column());
+    if (!columnChunk.hasColumnIndex() || !columnChunk.hasOffsetIndex()) {
+      continue;
+    }
+    columnIndexStreams[i] = indexInput->enqueue(
+        {static_cast<uint64_t>(columnChunk.columnIndexOffset()),
+         static_cast<uint64_t>(columnChunk.columnIndexLength())});
+    offsetIndexStreams[i] = indexInput->enqueue(
+        {static_cast<uint64_t>(columnChunk.offsetIndexOffset()),
+         static_cast<uint64_t>(columnChunk.offsetIndexLength())});
+    anyIndex = true;
+  }
+  if (!anyIndex) {
+    return pageIndexes;
+  }
+  indexInput->load(dwio::common::LogType::STRIPE_INDEX);
+
+  std::vector<char> columnIndex;
+  std::vector<char> offsetIndex;
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    if (!columnIndexStreams[i]) {
+      continue;
+    }
+    auto rowGroup = fileMetaDataPtr_.rowGroup(rowGroups[i]);
+    auto columnChunk = rowGroup.columnChunk(type_->column());
+    const auto columnIndexLength = columnChunk.columnIndexLength();
+    const auto offsetIndexLength = columnChunk.offsetIndexLength();
+    columnIndex.resize(columnIndexLength);
+    offsetIndex.resize(offsetIndexLength);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        columnIndexLength,
+        columnIndexStreams[i].get(),
+        columnIndex.data(),
+        bufferStart,
+        bufferEnd);
+    bufferStart = nullptr;
+    bufferEnd = nullptr;
+    dwio::common::readBytes(
+        offsetIndexLength,
+        offsetIndexStreams[i].get(),
+        offsetIndex.data(),
+        bufferStart,
+        bufferEnd);
+    pageIndexes[i] = PageIndex::deserialize(
+        columnIndex.data(),
+        columnIndexLength,
+        offsetIndex.data(),
+        offsetIndexLength,
+        rowGroup.numRows());
+  }
+  return pageIndexes;
+}
+
+void ParquetData::setPageRowRanges(
+    const std::vector<uint32_t>& rowGroups,
+    const std::vector<RowRanges>& rowRanges,
     dwio::common::BufferedInput& input) {
+  VELOX_CHECK_EQ(rowGroups.size(), rowRanges.size());
+  if (maxRepeat_ > 0 || maxDefine_ > 1) {
+    return;
+  }
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams(rowGroups.size());
+  auto indexInput = input.clone();
+  bool anyIndex = false;
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    auto columnChunk =
+        fileMetaDataPtr_.rowGroup(rowGroups[i]).columnChunk(type_->column());
+    if (!columnChunk.hasOffsetIndex()) {
+      continue;
+    }
+    offsetIndexStreams[i] = indexInput->enqueue(
+        {static_cast<uint64_t>(columnChunk.offsetIndexOffset()),
+         static_cast<uint64_t>(columnChunk.offsetIndexLength())});
+    anyIndex = true;
+  }
+  if (!anyIndex) {
+    return;
+  }
+  indexInput->load(dwio::common::LogType::STRIPE_INDEX);
+
+  pageSpans_.resize(fileMetaDataPtr_.numRowGroups());
+  std::vector<char> serialized;
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    if (!offsetIndexStreams[i]) {
+      continue;
+    }
+    auto rowGroup = fileMetaDataPtr_.rowGroup(rowGroups[i]);
+    const auto length =
+        rowGroup.columnChunk(type_->column()).offsetIndexLength();
+    serialized.resize(length);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        length,
+        offsetIndexStreams[i].get(),
+        serialized.data(),
+        bufferStart,
+        bufferEnd);
+    const auto offsetIndex = deserializeOffsetIndex(serialized.data(), length);
+    auto spans = selectPages(offsetIndex, rowRanges[i], rowGroup.numRows());
+    const auto [chunkOffset, chunkSize] = chunkRegion(rowGroups[i]);
+    if (spans.empty() || offsetIndex.page_locations[0].offset < chunkOffset ||
+        spans.back().offset + spans.back().length > chunkOffset + chunkSize) {
+      // Read the whole chunk if the OffsetIndex does not match it.
+      continue;
+    }
+    // The pages before the first data page, e.g. the dictionary, are always
+    // read.
+    const int64_t firstPageOffset = offsetIndex.page_locations[0].offset;
+    if (firstPageOffset > chunkOffset) {
+      if (spans.front().offset == firstPageOffset) {
+        spans.front().length += firstPageOffset - chunkOffset;
+        spans.front().offset = chunkOffset;
+      } else {
+        spans.insert(
+            spans.begin(),
+            PageSpan{
+                static_cast<int64_t>(chunkOffset),
+                firstPageOffset - static_cast<int64_t>(chunkOffset),
+                0});
+      }
+    }
+    if (spans.size() == 1 &&
+        spans.back().offset + spans.back().length ==
+            chunkOffset + chunkSize) {
+      // All the pages are read.
+      continue;
+    }
+    pageSpans_[rowGroups[i]] = std::move(spans);
+  }
+}
+
+std::pair<uint64_t, uint64_t> ParquetData::chunkRegion(uint32_t index) const {
   auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
-  streams_.resize(fileMetaDataPtr_.numRowGroups());
   VELOX_CHECK(
       chunk.hasMetadata(),
       "ColumnMetaData does not exist for schema Id ",
       type_->column());
-  ;
 
   uint64_t chunkReadOffset = chunk.dataPageOffset();
   if (chunk.hasDictionaryPageOffset() && chunk.dictionaryPageOffset() >= 4) {
@@ -112,16 +661,45 @@ void ParquetData::enqueueRowGroup(
       (chunk.compression() == common::CompressionKind::CompressionKind_NONE)
       ? chunk.totalUncompressedSize()
       : chunk.totalCompressedSize();
+  return {chunkReadOffset, readSize};
+}
 
+void ParquetData::enqueueRowGroup(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  streams_.resize(fileMetaDataPtr_.numRowGroups());
+  const auto [chunkReadOffset, readSize] = chunkRegion(index);
   auto id = dwio::common::StreamIdentifier(type_->column());
+  if (index < pageSpans_.size() && !pageSpans_[index].empty()) {
+    // Only the pages with rows in the page row ranges are read.
+    pageSpanStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    auto& spanStreams = pageSpanStreams_[index];
+    spanStreams.clear();
+    for (const auto& span : pageSpans_[index]) {
+      spanStreams.push_back(input.enqueue(
+          {static_cast<uint64_t>(span.offset),
+           static_cast<uint64_t>(span.length)},
+          &id));
+    }
+    return;
+  }
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
   static std::vector<uint64_t> empty;
   VELOX_CHECK_LT(index, streams_.size());
-  VELOX_CHECK(streams_[index], "Stream not enqueued for column");
-  auto metadata = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  const bool hasPageSpans =
+      index < pageSpans_.size() && !pageSpans_[index].empty();
+  if (hasPageSpans) {
+    VELOX_CHECK(
+        index < pageSpanStreams_.size() && !pageSpanStreams_[index].empty(),
+        "Stream not enqueued for column");
+  } else {
+    VELOX_CHECK(streams_[index], "Stream not enqueued for column");
+  }
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto metadata = rowGroup.columnChunk(type_->column());
   reader_ = std::make_unique<PageReader>(
       std::move(streams_[index]),
       pool_,
@@ -130,6 +708,13 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
       metadata.totalCompressedSize(),
       stats_,
       sessionTimezone_);
+  if (hasPageSpans) {
+    reader_->setPageSpans(
+        std::move(pageSpans_[index]),
+        std::move(pageSpanStreams_[index]),
+        chunkRegion(index).first,
+        rowGroup.numRows());
+  }
   return dwio::common::PositionProvider(empty);
 }
 
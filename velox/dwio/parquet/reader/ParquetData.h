@@ -17,7 +17,9 @@
 #pragma once
 
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 
 namespace facebook::velox::common {
@@ -74,9 +76,21 @@ class ParquetData : public dwio::common::FormatData {
         stats_(stats),
         sessionTimezone_(sessionTimezone) {}
 
-  /// Prepares to read data for 'index'th row group.
+  /// Prepares to read data for 'index'th row group. If setPageRowRanges()
+  /// selected pages of the row group, only those pages are enqueued.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
 
+  /// Selects the pages of each of 'rowGroups' that contain any of the
+  /// corresponding 'rowRanges', using the OffsetIndex of the column chunk.
+  /// The other pages are not enqueued by enqueueRowGroup() and the rows
+  /// outside of 'rowRanges' must not be read. Only applies to top level
+  /// columns with one value per row. The OffsetIndexes are read in one
+  /// coalesced load from 'input'.
+  void setPageRowRanges(
+      const std::vector<uint32_t>& rowGroups,
+      const std::vector<RowRanges>& rowRanges,
+      dwio::common::BufferedInput& input);
+
   /// Positions 'this' at 'index'th row group. loadRowGroup must be called
   /// first. The returned PositionProvider is empty and should not be used.
   /// Other formats may use it.
@@ -88,6 +102,39 @@ class ParquetData : public dwio::common::FormatData {
       const dwio::common::StatsContext& writerContext,
       FilterRowGroupsResult&) override;
 
+  /// Sets the bit in 'result.filterResult' for each of 'rowGroups' whose
+  /// bloom filter rules out all the values passing the filter of 'scanSpec'.
+  /// Only point filters, e.g. equality and IN-lists, are tested. Row groups
+  /// already excluded in 'result' are not read.
+  void filterRowGroupsByBloomFilter(
+      const common::ScanSpec& scanSpec,
+      const std::vector<uint32_t>& rowGroups,
+      dwio::common::BufferedInput& input,
+      FilterRowGroupsResult& result) const;
+
+  /// Sets the bit in 'result.filterResult' for each of 'rowGroups' whose
+  /// column chunk is dictionary encoded and has no dictionary entry passing
+  /// the filter of 'scanSpec'. Only integer and string columns with filters
+  /// that fail nulls are tested. Row groups already excluded in 'result' are
+  /// not read.
+  void filterRowGroupsByDictionary(
+      const common::ScanSpec& scanSpec,
+      const std::vector<uint32_t>& rowGroups,
+      dwio::common::BufferedInput& input,
+      FilterRowGroupsResult& result) const;
+
+  /// Returns for each of 'rowGroups' the rows that may pass the filter of
+  /// 'scanSpec' according to the page-level statistics in the ColumnIndex of
+  /// the column chunk. An element is std::nullopt if there is no filter, the
+  /// column chunk has no page index or the statistics are not trusted. Only
+  /// applies to columns with one value per top level row, i.e. columns
+  /// without repetition.
+  std::vector<std::optional<RowRanges>> filterPages(
+      const common::ScanSpec& scanSpec,
+      const std::vector<uint32_t>& rowGroups,
+      const dwio::common::StatsContext& writerContext,
+      dwio::common::BufferedInput& input) const;
+
   PageReader* reader() const {
     return reader_.get();
   }
@@ -208,10 +255,29 @@ class ParquetData : public dwio::common::FormatData {
   std::pair<int64_t, int64_t> getRowGroupRegion(uint32_t index) const;
 
  private:
+  // Returns the <offset, length> of the column chunk of 'this' in the
+  // 'index'th row group.
+  std::pair<uint64_t, uint64_t> chunkRegion(uint32_t index) const;
+
   /// True if 'filter' may have hits for the column of 'this' according to the
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, const common::Filter* filter);
 
+  /// Reads the bloom filters of the column chunks of 'rowGroups' from
+  /// 'input'. The headers of all the bloom filters are fetched in one
+  /// coalesced load and the bitsets in another. An element of the result is
+  /// nullptr if the bloom filter is unsupported or too large.
+  std::vector<std::unique_ptr<BlockSplitBloomFilter>> readBloomFilters(
+      const std::vector<uint32_t>& rowGroups,
+      dwio::common::BufferedInput& input) const;
+
+  /// Reads the page indexes of the column chunks of 'rowGroups' from 'input'
+  /// in one coalesced load. An element of the result is nullptr if the column
+  /// chunk has no ColumnIndex or OffsetIndex.
+  std::vector<std::unique_ptr<PageIndex>> readPageIndexes(
+      const std::vector<uint32_t>& rowGroups,
+      dwio::common::BufferedInput& input) const;
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
@@ -220,6 +286,15 @@ class ParquetData : public dwio::common::FormatData {
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Runs of pages to read for each row group from setPageRowRanges(). Empty
+  // if the whole column chunk is read.
+  std::vector<std::vector<PageSpan>> pageSpans_;
+
+  // Streams for each of 'pageSpans_'. Used instead of 'streams_' if
+  // 'pageSpans_' of the row group is not empty.
+  std::vector<std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>>
+      pageSpanStreams_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
@@ -78,10 +78,18 @@ class ReaderBase {
     return fileLength_;
   }
 
-  thrift::FileMetaData& thriftFileMetaData() const {
+  const thrift::FileMetaData& thriftFileMetaData() const {
     return *fileMetaData_;
   }
 
+  /// Drops the column chunks of a row group that is not read to save memory.
+  /// Does nothing if the metadata is shared through the FileMetadataCache.
+  void releaseRowGroupColumns(int32_t rowGroupIndex) {
+    if (ownedFileMetaData_ != nullptr) {
+      ownedFileMetaData_->row_groups[rowGroupIndex].columns.clear();
+    }
+  }
+
   FileMetaDataPtr fileMetaData() const {
     return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_.get()));
   }
@@ -131,6 +139,10 @@ class ReaderBase {
   // Reads and parses file footer.
   void loadFileMetaData();
 
+  // Returns the key of the file in options_.fileMetadataCache() or an empty
+  // string if the file is not cached.
+  std::string fileMetadataCacheKey() const;
+
   void initializeSchema();
 
   void initializeVersion();
@@ -162,7 +174,10 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
+  // Same as 'fileMetaData_' if owned by 'this', nullptr if shared through the
+  // FileMetadataCache.
+  thrift::FileMetaData* ownedFileMetaData_{nullptr};
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -190,7 +205,24 @@ ReaderBase::ReaderBase(
   initializeVersion();
 }
 
+std::string ReaderBase::fileMetadataCacheKey() const {
+  if (options_.fileMetadataCache() == nullptr ||
+      options_.fileMetadataCacheKey().empty()) {
+    return "";
+  }
+  return "parquet:" + options_.fileMetadataCacheKey();
+}
+
 void ReaderBase::loadFileMetaData() {
+  const auto cacheKey = fileMetadataCacheKey();
+  if (!cacheKey.empty()) {
+    fileMetaData_ =
+        options_.fileMetadataCache()->get<thrift::FileMetaData>(cacheKey);
+    if (fileMetaData_ != nullptr) {
+      return;
+    }
+  }
+
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -237,8 +269,24 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  if (cacheKey.empty()) {
+    ownedFileMetaData_ = fileMetaData.get();
+  } else {
+    // The parsed metadata takes about as much memory as the encoded footer
+    // plus the fixed size of its column chunks.
+    uint64_t numColumnChunks = 0;
+    for (const auto& rowGroup : fileMetaData->row_groups) {
+      numColumnChunks += rowGroup.columns.size();
+    }
+    options_.fileMetadataCache()->put(
+        cacheKey,
+        fileMetaData,
+        footerLength + numColumnChunks * sizeof(thrift::ColumnChunk) +
+            fileMetaData->schema.size() * sizeof(thrift::SchemaElement));
+  }
+  fileMetaData_ = std::move(fileMetaData);
 }
 
 void ReaderBase::initializeSchema() {
@@ -1218,6 +1266,12 @@ class ParquetRowReader::Impl {
         params,
         *options_.scanSpec());
     columnReader_->setIsTopLevel();
+    if (options_.decodingExecutor()) {
+      static_cast<StructColumnReader&>(*columnReader_)
+          .setDecodingExecutor(
+              options_.decodingExecutor(),
+              options_.decodingParallelismFactor());
+    }
 
     filterRowGroups();
     if (!rowGroupIds_.empty()) {
@@ -1234,6 +1288,7 @@ class ParquetRowReader::Impl {
   void filterRowGroups() {
     rowGroupIds_.reserve(rowGroups_.size());
     firstRowOfRowGroup_.reserve(rowGroups_.size());
+    pageRowRanges_.reserve(rowGroups_.size());
 
     ParquetData::FilterRowGroupsResult res;
     columnReader_->filterRowGroups(0, parquetStatsContext_, res);
@@ -1241,8 +1296,7 @@ class ParquetRowReader::Impl {
       metadataFilter->eval(res.metadataFilterResults, res.filterResult);
     }
 
-    uint64_t rowNumber = 0;
-    for (auto i = 0; i < rowGroups_.size(); i++) {
+    auto isRowGroupInRange = [&](int32_t i) {
       VELOX_CHECK_GT(rowGroups_[i].columns.size(), 0);
       auto fileOffset = rowGroups_[i].__isset.file_offset
           ? rowGroups_[i].file_offset
@@ -1250,24 +1304,91 @@ class ParquetRowReader::Impl {
           ? rowGroups_[i].columns[0].meta_data.dictionary_page_offset
           : rowGroups_[i].columns[0].meta_data.data_page_offset;
       VELOX_CHECK_GT(fileOffset, 0);
-      auto rowGroupInRange =
-          (fileOffset >= options_.offset() && fileOffset < options_.limit());
+      return fileOffset >= options_.offset() && fileOffset < options_.limit();
+    };
+
+    // Test the point filters against the bloom filters of the non-empty row
+    // groups of the split that passed the statistics.
+    std::vector<uint32_t> bloomFilterCandidates;
+    for (auto i = 0; i < rowGroups_.size(); i++) {
+      if (isRowGroupInRange(i) && rowGroups_[i].num_rows > 0 &&
+          !(i < res.totalCount && bits::isBitSet(res.filterResult.data(), i))) {
+        bloomFilterCandidates.push_back(i);
+      }
+    }
+    if (!bloomFilterCandidates.empty()) {
+      static_cast<const StructColumnReader&>(*columnReader_)
+          .filterRowGroupsByBloomFilter(
+              bloomFilterCandidates, readerBase_->bufferedInput(), res);
+      // Then the filters against the dictionaries of the chunks that are
+      // entirely dictionary encoded. The row groups excluded by the bloom
+      // filters are skipped.
+      if (readerBase_->options().dictionaryFilterEnabled()) {
+        static_cast<const StructColumnReader&>(*columnReader_)
+            .filterRowGroupsByDictionary(
+                bloomFilterCandidates, readerBase_->bufferedInput(), res);
+      }
+    }
+
+    // Narrow the rows to read by the page-level statistics of the remaining
+    // candidates. The page indexes of a column are read in one load.
+    std::vector<std::optional<RowRanges>> candidatePageRowRanges;
+    std::vector<uint32_t> pageIndexCandidates;
+    if (readerBase_->options().pageIndexFilterEnabled()) {
+      for (auto i : bloomFilterCandidates) {
+        if (!(i < res.totalCount &&
+              bits::isBitSet(res.filterResult.data(), i))) {
+          pageIndexCandidates.push_back(i);
+        }
+      }
+      if (!pageIndexCandidates.empty()) {
+        candidatePageRowRanges =
+            static_cast<const StructColumnReader&>(*columnReader_)
+                .filterPages(
+                    pageIndexCandidates,
+                    parquetStatsContext_,
+                    readerBase_->bufferedInput());
+      }
+    }
+
+    uint64_t rowNumber = 0;
+    auto nextPageIndexCandidate = 0;
+    for (auto i = 0; i < rowGroups_.size(); i++) {
+      auto rowGroupInRange = isRowGroupInRange(i);
 
       auto isExcluded =
           (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i));
       auto isEmpty = rowGroups_[i].num_rows == 0;
 
+      // The row group is excluded if no page can match.
+      std::optional<RowRanges> pageRowRanges;
+      if (nextPageIndexCandidate < pageIndexCandidates.size() &&
+          pageIndexCandidates[nextPageIndexCandidate] == i) {
+        pageRowRanges =
+            std::move(candidatePageRowRanges[nextPageIndexCandidate++]);
+        if (pageRowRanges.has_value()) {
+          if (pageRowRanges->empty()) {
+            isExcluded = true;
+          } else if (
+              pageRowRanges->size() == 1 &&
+              pageRowRanges->front().size() == rowGroups_[i].num_rows) {
+            pageRowRanges.reset();
+          }
+        }
+      }
+
       // Add a row group to read if it is within range and not empty and not in
       // the excluded list.
       if (rowGroupInRange && !isExcluded && !isEmpty) {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
+        pageRowRanges_.push_back(std::move(pageRowRanges));
       } else {
         if (i != 0) {
           // Clear the metadata of row groups that are not read. This helps
           // reduce the memory consumption. ColumnChunks consume the most
           // memory. Skip the 0th RowGroup as it is used by estimatedRowSize().
-          rowGroups_[i].columns.clear();
+          readerBase_->releaseRowGroupColumns(i);
         }
         if (rowGroupInRange) {
           skippedStrides_++;
@@ -1276,6 +1397,21 @@ class ParquetRowReader::Impl {
 
       rowNumber += rowGroups_[i].num_rows;
     }
+
+    // Only the pages with rows in the ranges are read.
+    std::vector<uint32_t> prunedRowGroups;
+    std::vector<RowRanges> prunedRowRanges;
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      if (pageRowRanges_[i].has_value()) {
+        prunedRowGroups.push_back(rowGroupIds_[i]);
+        prunedRowRanges.push_back(pageRowRanges_[i].value());
+      }
+    }
+    if (!prunedRowGroups.empty()) {
+      static_cast<StructColumnReader&>(*columnReader_)
+          .setPageRowRanges(
+              prunedRowGroups, prunedRowRanges, readerBase_->bufferedInput());
+    }
   }
 
   int64_t nextRowNumber() {
@@ -1303,6 +1439,7 @@ class ParquetRowReader::Impl {
       return 0;
     }
     VELOX_DCHECK_GT(rowsToRead, 0);
+    mutation = applyPageRowRanges(rowsToRead, mutation);
     columnReader_->setCurrentRowNumber(nextRowNumber());
     if (!options_.rowNumberColumnInfo().has_value()) {
       columnReader_->next(rowsToRead, result, mutation);
@@ -1336,6 +1473,7 @@ class ParquetRowReader::Impl {
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += skippedStrides_;
     stats.processedStrides += rowGroupIds_.size();
+    stats.skippedPageRows += skippedPageRows_;
     stats.columnReaderStatistics.pageLoadTimeNs.merge(
         columnReaderStats_.pageLoadTimeNs);
   }
@@ -1349,6 +1487,47 @@ class ParquetRowReader::Impl {
   }
 
  private:
+  // Returns a mutation that deletes the rows in the next 'numRows' rows of the
+  // current row group that are outside the page row ranges of the row group,
+  // in addition to the deletions in 'mutation'. Returns 'mutation' if all the
+  // rows are in the ranges.
+  const dwio::common::Mutation* applyPageRowRanges(
+      uint64_t numRows,
+      const dwio::common::Mutation* mutation) {
+    const auto& ranges = pageRowRanges_[nextRowGroupIdsIdx_ - 1];
+    if (!ranges.has_value()) {
+      return mutation;
+    }
+    const int64_t begin = currentRowInGroup_;
+    const int64_t end = begin + numRows;
+    pageSkippedRows_.resize(bits::nwords(numRows));
+    bits::fillBits(pageSkippedRows_.data(), 0, numRows, true);
+    for (const auto& range : ranges.value()) {
+      if (range.end <= begin) {
+        continue;
+      }
+      if (range.begin >= end) {
+        break;
+      }
+      bits::fillBits(
+          pageSkippedRows_.data(),
+          std::max(range.begin, begin) - begin,
+          std::min(range.end, end) - begin,
+          false);
+    }
+    const auto numSkipped = bits::countBits(pageSkippedRows_.data(), 0, numRows);
+    if (numSkipped == 0) {
+      return mutation;
+    }
+    skippedPageRows_ += numSkipped;
+    if (mutation && mutation->deletedRows) {
+      bits::orBits(pageSkippedRows_.data(), mutation->deletedRows, 0, numRows);
+    }
+    pageMutation_.deletedRows = pageSkippedRows_.data();
+    pageMutation_.randomSkip = mutation ? mutation->randomSkip : nullptr;
+    return &pageMutation_;
+  }
+
   bool advanceToNextRowGroup() {
     if (nextRowGroupIdsIdx_ == rowGroupIds_.size()) {
       return false;
@@ -1373,10 +1552,18 @@ class ParquetRowReader::Impl {
   dwio::common::ColumnReaderOptions columnReaderOptions_;
 
   // All row groups from file metadata.
-  std::vector<thrift::RowGroup>& rowGroups_;
+  const std::vector<thrift::RowGroup>& rowGroups_;
   // Indices of row groups where stats match filters.
   std::vector<uint32_t> rowGroupIds_;
   std::vector<uint64_t> firstRowOfRowGroup_;
+  // Rows that may pass the filters according to the page-level statistics
+  // for each of 'rowGroupIds_'. std::nullopt if all rows must be read.
+  std::vector<std::optional<RowRanges>> pageRowRanges_;
+  // Rows of the current batch outside of the page row ranges, combined with
+  // the deleted rows of the caller's mutation.
+  std::vector<uint64_t> pageSkippedRows_;
+  dwio::common::Mutation pageMutation_;
+  int64_t skippedPageRows_{0};
   uint32_t nextRowGroupIdsIdx_;
   const thrift::RowGroup* currentRowGroupPtr_{nullptr};
   uint64_t rowsInCurrentRowGroup_;
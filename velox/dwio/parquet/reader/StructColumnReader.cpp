@@ -208,4 +208,80 @@ void StructColumnReader::filterRowGroups(
   }
 }
 
+void StructColumnReader::filterRowGroupsByBloomFilter(
+    const std::vector<uint32_t>& rowGroups,
+    dwio::common::BufferedInput& input,
+    dwio::common::FormatData::FilterRowGroupsResult& result) const {
+  for (const auto& child : children_) {
+    if (auto structChild = dynamic_cast<const StructColumnReader*>(child)) {
+      structChild->filterRowGroupsByBloomFilter(rowGroups, input, result);
+    } else if (
+        child->fileType().type()->kind() != TypeKind::ARRAY &&
+        child->fileType().type()->kind() != TypeKind::MAP) {
+      child->formatData().as<ParquetData>().filterRowGroupsByBloomFilter(
+          *child->scanSpec(), rowGroups, input, result);
+    }
+  }
+}
+
+void StructColumnReader::filterRowGroupsByDictionary(
+    const std::vector<uint32_t>& rowGroups,
+    dwio::common::BufferedInput& input,
+    dwio::common::FormatData::FilterRowGroupsResult& result) const {
+  for (const auto& child : children_) {
+    if (auto structChild = dynamic_cast<const StructColumnReader*>(child)) {
+      structChild->filterRowGroupsByDictionary(rowGroups, input, result);
+    } else if (
+        child->fileType().type()->kind() != TypeKind::ARRAY &&
+        child->fileType().type()->kind() != TypeKind::MAP) {
+      child->formatData().as<ParquetData>().filterRowGroupsByDictionary(
+          *child->scanSpec(), rowGroups, input, result);
+    }
+  }
+}
+
+std::vector<std::optional<RowRanges>> StructColumnReader::filterPages(
+    const std::vector<uint32_t>& rowGroups,
+    const dwio::common::StatsContext& context,
+    dwio::common::BufferedInput& input) const {
+  std::vector<std::optional<RowRanges>> result(rowGroups.size());
+  for (const auto& child : children_) {
+    std::vector<std::optional<RowRanges>> childRanges;
+    if (auto structChild = dynamic_cast<const StructColumnReader*>(child)) {
+      childRanges = structChild->filterPages(rowGroups, context, input);
+    } else if (
+        child->fileType().type()->kind() != TypeKind::ARRAY &&
+        child->fileType().type()->kind() != TypeKind::MAP) {
+      childRanges = child->formatData().as<ParquetData>().filterPages(
+          *child->scanSpec(), rowGroups, context, input);
+    } else {
+      continue;
+    }
+    for (auto i = 0; i < rowGroups.size(); ++i) {
+      if (!childRanges[i].has_value()) {
+        continue;
+      }
+      result[i] = result[i].has_value()
+          ? intersectRowRanges(result[i].value(), childRanges[i].value())
+          : std::move(childRanges[i]);
+    }
+  }
+  return result;
+}
+
+void StructColumnReader::setPageRowRanges(
+    const std::vector<uint32_t>& rowGroups,
+    const std::vector<RowRanges>& rowRanges,
+    dwio::common::BufferedInput& input) {
+  for (auto& child : children_) {
+    if (dynamic_cast<StructColumnReader*>(child) ||
+        child->fileType().type()->kind() == TypeKind::ARRAY ||
+        child->fileType().type()->kind() == TypeKind::MAP) {
+      continue;
+    }
+    child->formatData().as<ParquetData>().setPageRowRanges(
+        rowGroups, rowRanges, input);
+  }
+}
+
 } // namespace facebook::velox::parquet
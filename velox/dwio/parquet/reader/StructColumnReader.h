@@ -19,6 +19,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SelectiveStructColumnReader.h"
 #include "velox/dwio/parquet/common/LevelConversion.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 
 namespace facebook::velox::dwio::common {
 class BufferedInput;
@@ -77,6 +78,42 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       const dwio::common::StatsContext&,
       dwio::common::FormatData::FilterRowGroupsResult&) const override;
 
+  /// Sets the bit in 'result.filterResult' for each of 'rowGroups' for which
+  /// the bloom filter of a leaf column under 'this' rules out all the values
+  /// passing the filter on the column.
+  void filterRowGroupsByBloomFilter(
+      const std::vector<uint32_t>& rowGroups,
+      dwio::common::BufferedInput& input,
+      dwio::common::FormatData::FilterRowGroupsResult& result) const;
+
+  /// Sets the bit in 'result.filterResult' for each of 'rowGroups' for which
+  /// no entry in the dictionary of a leaf column under 'this' passes the
+  /// filter on the column.
+  void filterRowGroupsByDictionary(
+      const std::vector<uint32_t>& rowGroups,
+      dwio::common::BufferedInput& input,
+      dwio::common::FormatData::FilterRowGroupsResult& result) const;
+
+  /// Returns for each of 'rowGroups' the rows that may pass the filters on
+  /// the leaf columns under 'this' according to the page-level statistics of
+  /// the column chunks. The row ranges of the filtered columns are
+  /// intersected so that all columns skip the same rows. An element is
+  /// std::nullopt if no filtered column has a usable page index in the row
+  /// group. The page indexes of a column are read in one coalesced load.
+  std::vector<std::optional<RowRanges>> filterPages(
+      const std::vector<uint32_t>& rowGroups,
+      const dwio::common::StatsContext& context,
+      dwio::common::BufferedInput& input) const;
+
+  /// Restricts the reads of the leaf children of 'this' in each of
+  /// 'rowGroups' to the pages containing the corresponding 'rowRanges'. Only
+  /// applies to the leaves directly under the root of the table. Other
+  /// columns read the whole column chunk.
+  void setPageRowRanges(
+      const std::vector<uint32_t>& rowGroups,
+      const std::vector<RowRanges>& rowRanges,
+      dwio::common::BufferedInput& input);
+
  private:
   dwio::common::SelectiveColumnReader* findBestLeaf();
 
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/common/LevelConversion.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+using namespace facebook::velox::parquet;
+
+namespace {
+
+constexpr int32_t kNumLevels = 1'000'000;
+
+// The levels of a column of ARRAY<BIGINT> if 'nested' is false or of
+// ARRAY<ARRAY<BIGINT>> otherwise. The lists have 1 to 8 elements. The
+// innermost lists are null with 'nullPct' percent probability.
+struct Levels {
+  Levels(bool nested, int32_t nullPct) {
+    folly::Random::DefaultGenerator rng(1);
+    const auto numElements = [&]() {
+      return 1 + folly::Random::rand32(8, rng);
+    };
+    const auto isNull = [&]() {
+      return folly::Random::rand32(100, rng) < nullPct;
+    };
+    while (defLevels.size() < kNumLevels) {
+      if (!nested) {
+        if (isNull()) {
+          add(0, 0);
+          continue;
+        }
+        const auto size = numElements();
+        for (auto i = 0; i < size; ++i) {
+          add(3, i == 0 ? 0 : 1);
+        }
+        continue;
+      }
+      const auto numLists = numElements();
+      for (auto i = 0; i < numLists; ++i) {
+        const int16_t listRepLevel = i == 0 ? 0 : 1;
+        if (isNull()) {
+          add(2, listRepLevel);
+          continue;
+        }
+        const auto size = numElements();
+        for (auto j = 0; j < size; ++j) {
+          add(5, j == 0 ? listRepLevel : 2);
+        }
+      }
+    }
+    offsets.resize(defLevels.size() + 1);
+    validBits.resize(defLevels.size() / 8 + 1);
+  }
+
+  void add(int16_t defLevel, int16_t repLevel) {
+    defLevels.push_back(defLevel);
+    repLevels.push_back(repLevel);
+  }
+
+  int64_t toList(const LevelInfo& levelInfo) {
+    ValidityBitmapInputOutput output;
+    output.valuesReadUpperBound = defLevels.size();
+    output.validBits = validBits.data();
+    offsets[0] = 0;
+    DefRepLevelsToList(
+        defLevels.data(),
+        repLevels.data(),
+        defLevels.size(),
+        levelInfo,
+        &output,
+        offsets.data());
+    return output.valuesRead;
+  }
+
+  std::vector<int16_t> defLevels;
+  std::vector<int16_t> repLevels;
+  std::vector<int32_t> offsets;
+  std::vector<uint8_t> validBits;
+};
+
+LevelInfo outerList() {
+  LevelInfo levelInfo;
+  levelInfo.repLevel = 1;
+  levelInfo.defLevel = 2;
+  return levelInfo;
+}
+
+LevelInfo innerList() {
+  LevelInfo levelInfo;
+  levelInfo.repLevel = 2;
+  levelInfo.defLevel = 4;
+  levelInfo.repeatedAncestorDefLevel = 2;
+  return levelInfo;
+}
+
+void run(uint32_t iterations, bool nested, int32_t nullPct, bool inner) {
+  folly::BenchmarkSuspender suspender;
+  Levels levels(nested, nullPct);
+  const auto levelInfo = inner ? innerList() : outerList();
+  suspender.dismiss();
+  for (auto i = 0; i < iterations; ++i) {
+    folly::doNotOptimizeAway(levels.toList(levelInfo));
+  }
+}
+
+} // namespace
+
+BENCHMARK(singleLevelNoNulls, n) {
+  run(n, false, 0, false);
+}
+
+BENCHMARK_RELATIVE(singleLevelNulls, n) {
+  run(n, false, 10, false);
+}
+
+BENCHMARK(nestedOuterNoNulls, n) {
+  run(n, true, 0, false);
+}
+
+BENCHMARK_RELATIVE(nestedInnerNoNulls, n) {
+  run(n, true, 0, true);
+}
+
+BENCHMARK_RELATIVE(nestedInnerNulls, n) {
+  run(n, true, 10, true);
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
@@ -361,6 +361,45 @@ TYPED_TEST(NestedListTest, SimpleLongList) {
       "1");
 }
 
+TYPED_TEST(NestedListTest, AllElementsPresent) {
+  // [[1, 2], [3]], [[4]]
+  MultiLevelTestData testData;
+  testData.defLevels = std::vector<int16_t>{5, 5, 5, 5};
+  testData.repLevels = std::vector<int16_t>{0, 2, 1, 0};
+
+  // The inner lists have no null or empty list and no nested elements.
+  LevelInfo innerLevelInfo;
+  innerLevelInfo.repLevel = 2;
+  innerLevelInfo.defLevel = 4;
+  innerLevelInfo.repeatedAncestorDefLevel = 2;
+  this->InitForLength(3);
+  EXPECT_EQ(this->Run(testData, innerLevelInfo), this->offsets_.data() + 3);
+  EXPECT_THAT(this->offsets_, testing::ElementsAre(0, 2, 3, 4));
+  EXPECT_EQ(this->validityIo_.nullCount, 0);
+  EXPECT_EQ(BitmapToString(this->validityIo_.validBits, /*length=*/3), "111");
+
+  // The outer lists skip the elements of the inner lists.
+  LevelInfo outerLevelInfo;
+  outerLevelInfo.repLevel = 1;
+  outerLevelInfo.defLevel = 2;
+  this->InitForLength(2);
+  EXPECT_EQ(this->Run(testData, outerLevelInfo), this->offsets_.data() + 2);
+  EXPECT_THAT(this->offsets_, testing::ElementsAre(0, 2, 3));
+  EXPECT_EQ(BitmapToString(this->validityIo_.validBits, /*length=*/2), "11");
+
+  // The first level continues the inner list before the range.
+  testData.defLevels = std::vector<int16_t>{5, 5, 5};
+  testData.repLevels = std::vector<int16_t>{2, 1, 0};
+  this->InitForLength(2);
+  EXPECT_EQ(this->Run(testData, innerLevelInfo), this->offsets_.data() + 2);
+  EXPECT_THAT(this->offsets_, testing::ElementsAre(1, 2, 3));
+  EXPECT_EQ(this->validityIo_.valuesRead, 2);
+
+  // More lists than the upper bound.
+  this->InitForLength(1);
+  ASSERT_THROW(this->Run(testData, innerLevelInfo), VeloxException);
+}
+
 TYPED_TEST(NestedListTest, TestOverflow) {
   LevelInfo levelInfo;
   levelInfo.repLevel = 1;
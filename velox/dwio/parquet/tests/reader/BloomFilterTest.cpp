@@ -24,6 +24,8 @@
 #include <vector>
 
 #include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
 
 #include "velox/dwio/common/OutputStream.h"
 #include "velox/dwio/parquet/common/BloomFilter.h"
@@ -31,6 +33,7 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::parquet;
@@ -395,3 +398,149 @@ TEST_F(BloomFilterTest, TestBloomFilterHashes) {
         << "Hash with seed 0 Error: " << i;
   }
 }
+
+namespace {
+
+std::string serializeBloomFilter(
+    const BlockSplitBloomFilter& bloomFilter,
+    memory::MemoryPool& pool) {
+  dwio::common::DataBufferHolder bufferHolder{pool, 1024};
+  dwio::common::AppendOnlyBufferedStream sink(
+      std::make_unique<dwio::common::BufferedOutputStream>(bufferHolder));
+  bloomFilter.writeTo(&sink);
+  sink.flush();
+  std::string buffer;
+  for (auto& tmpBuffer : bufferHolder.getBuffers()) {
+    buffer.append(tmpBuffer.data(), tmpBuffer.size());
+  }
+  return buffer;
+}
+
+// Returns a copy of the Parquet file 'file' whose single BIGINT column has a
+// bloom filter per row group built from 'rowGroupValues'. The Velox writer
+// does not write bloom filters, so they are appended after the data pages and
+// referenced from a rewritten footer.
+std::string addBloomFilters(
+    const std::string& file,
+    const std::vector<std::vector<int64_t>>& rowGroupValues,
+    memory::MemoryPool& pool) {
+  uint32_t footerLength;
+  memcpy(&footerLength, file.data() + file.size() - 8, sizeof(footerLength));
+  const auto footerStart = file.size() - 8 - footerLength;
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      file.data() + footerStart, footerLength);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::FileMetaData fileMetaData;
+  fileMetaData.read(&protocol);
+  EXPECT_EQ(fileMetaData.row_groups.size(), rowGroupValues.size());
+
+  std::string result = file.substr(0, footerStart);
+  for (auto i = 0; i < rowGroupValues.size(); ++i) {
+    BlockSplitBloomFilter bloomFilter(&pool);
+    bloomFilter.init(BlockSplitBloomFilter::optimalNumOfBytes(
+        rowGroupValues[i].size(), 0.001));
+    for (auto value : rowGroupValues[i]) {
+      bloomFilter.insertHash(bloomFilter.hash(value));
+    }
+    fileMetaData.row_groups[i].columns[0].meta_data.__set_bloom_filter_offset(
+        result.size());
+    result += serializeBloomFilter(bloomFilter, pool);
+  }
+
+  auto memBuffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolFactoryT<
+      apache::thrift::transport::TMemoryBuffer>
+      factory;
+  fileMetaData.write(factory.getProtocol(memBuffer).get());
+  uint8_t* footer;
+  uint32_t newFooterLength;
+  memBuffer->getBuffer(&footer, &newFooterLength);
+  result.append(reinterpret_cast<const char*>(footer), newFooterLength);
+  result.append(
+      reinterpret_cast<const char*>(&newFooterLength), sizeof(newFooterLength));
+  result.append("PAR1");
+  return result;
+}
+
+} // namespace
+
+TEST_F(BloomFilterTest, filterRowGroups) {
+  // Every row group interleaves its values with the others so that min/max
+  // statistics cannot exclude any of them: row group 'g' holds the even
+  // values 2 * v where v is congruent to 'g' modulo kNumRowGroups.
+  constexpr int32_t kNumRowGroups = 4;
+  constexpr int32_t kRowsPerGroup = 1'000;
+  auto data = makeRowVector(
+      {"a"},
+      {makeFlatVector<int64_t>(kNumRowGroups * kRowsPerGroup, [](auto row) {
+        return 2 *
+            ((row % kRowsPerGroup) * kNumRowGroups + row / kRowsPerGroup);
+      })});
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.flushPolicyFactory = [] {
+    return std::make_unique<DefaultFlushPolicy>(
+        kRowsPerGroup, 128 * 1'024 * 1'024);
+  };
+  auto* sink = write(data, writerOptions);
+
+  std::vector<std::vector<int64_t>> rowGroupValues(kNumRowGroups);
+  for (auto row = 0; row < data->size(); ++row) {
+    rowGroupValues[row / kRowsPerGroup].push_back(
+        data->childAt(0)->asFlatVector<int64_t>()->valueAt(row));
+  }
+  auto file = addBloomFilters(
+      std::string(sink->data(), sink->size()), rowGroupValues, *leafPool_);
+
+  auto rowType = asRowType(data->type());
+  // Reads with 'filter' on "a" and returns the number of skipped row groups.
+  auto readWithFilter = [&](std::unique_ptr<common::Filter> filter,
+                            const std::vector<int64_t>& expected) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    // The dictionaries would also exclude the row groups.
+    readerOptions.setDictionaryFilterEnabled(false);
+    auto reader = std::make_unique<ParquetReader>(
+        std::make_unique<dwio::common::BufferedInput>(
+            std::make_shared<InMemoryReadFile>(file), *leafPool_),
+        readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("a")->setFilter(std::move(filter));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    std::vector<int64_t> actual;
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    while (rowReader->next(kRowsPerGroup, result) > 0) {
+      auto* values =
+          result->as<RowVector>()->childAt(0)->asFlatVector<int64_t>();
+      for (auto i = 0; i < result->size(); ++i) {
+        actual.push_back(values->valueAt(i));
+      }
+    }
+    EXPECT_EQ(actual, expected);
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.skippedStrides;
+  };
+
+  EXPECT_EQ(
+      readWithFilter(
+          std::make_unique<common::BigintRange>(802, 802, false), {802}),
+      kNumRowGroups - 1);
+  EXPECT_EQ(
+      readWithFilter(
+          common::createBigintValues({804, 4'002}, false), {4'002, 804}),
+      kNumRowGroups - 2);
+  // Values within the min/max range of every row group but in none of them.
+  EXPECT_EQ(
+      readWithFilter(
+          common::createBigintValues({801, 3'001, 5'001}, false), {}),
+      kNumRowGroups);
+  // Range filters cannot use bloom filters.
+  EXPECT_EQ(
+      readWithFilter(
+          std::make_unique<common::BigintRange>(802, 804, false), {802, 804}),
+      0);
+}
@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/Mutation.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -1163,6 +1166,280 @@ TEST_F(ParquetReaderTest, filterRowGroups) {
   EXPECT_EQ(reader->numberOfRows(), 10ULL);
 }
 
+TEST_F(ParquetReaderTest, intersectRowRanges) {
+  RowRanges left{{0, 10}, {20, 30}, {40, 50}};
+  RowRanges right{{5, 25}, {29, 45}};
+  EXPECT_EQ(
+      intersectRowRanges(left, right),
+      (RowRanges{{5, 10}, {20, 25}, {29, 30}, {40, 45}}));
+  EXPECT_EQ(intersectRowRanges(left, {}), RowRanges{});
+  EXPECT_EQ(intersectRowRanges(left, {{10, 20}}), RowRanges{});
+  EXPECT_EQ(intersectRowRanges({{0, 100}}, left), left);
+}
+
+TEST_F(ParquetReaderTest, selectPages) {
+  // Four pages of 100 rows and 1000 bytes each starting at offset 4.
+  thrift::OffsetIndex offsetIndex;
+  for (auto i = 0; i < 4; ++i) {
+    thrift::PageLocation location;
+    location.__set_offset(4 + i * 1'000);
+    location.__set_compressed_page_size(1'000);
+    location.__set_first_row_index(i * 100);
+    offsetIndex.page_locations.push_back(location);
+  }
+  EXPECT_EQ(
+      selectPages(offsetIndex, {{0, 400}}, 400),
+      (std::vector<PageSpan>{{4, 4'000, 0}}));
+  EXPECT_EQ(
+      selectPages(offsetIndex, {{50, 60}, {350, 351}}, 400),
+      (std::vector<PageSpan>{{4, 1'000, 0}, {3'004, 1'000, 300}}));
+  EXPECT_EQ(
+      selectPages(offsetIndex, {{199, 201}}, 400),
+      (std::vector<PageSpan>{{1'004, 2'000, 100}}));
+  EXPECT_EQ(selectPages(offsetIndex, {}, 400), std::vector<PageSpan>{});
+}
+
+TEST_F(ParquetReaderTest, pageIndexFilter) {
+  constexpr int32_t kSize = 20'000;
+  auto data = makeRowVector(
+      {"a", "b"},
+      {makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+       makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; })});
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.enableDictionary = false;
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.batchSize = 100;
+  writerOptions.enableWritePageIndex = true;
+  auto* sink = write(data, writerOptions);
+  auto file = std::make_shared<InMemoryReadFile>(
+      std::string(sink->data(), sink->size()));
+
+  auto rowType = asRowType(data->type());
+  auto makeExpected = [&](const std::vector<int64_t>& rows) {
+    return makeRowVector(
+        {"a", "b"},
+        {makeFlatVector<int64_t>(rows),
+         makeFlatVector<double>(
+             rows.size(), [&](auto row) { return rows[row] * 0.5; })});
+  };
+
+  struct Result {
+    int64_t skippedPageRows;
+    uint64_t bytesRead;
+  };
+
+  // Reads with a filter on "a" and returns the number of rows skipped by the
+  // page index and the bytes read after the footer.
+  auto readWithFilter = [&](std::unique_ptr<Filter> filter,
+                            const RowVectorPtr& expected,
+                            bool pageIndexFilterEnabled) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setPageIndexFilterEnabled(pageIndexFilterEnabled);
+    readerOptions.setFilePreloadThreshold(0);
+    readerOptions.setFooterEstimatedSize(256);
+    // The loads are not merged so that the bytes read are those enqueued.
+    auto reader = std::make_unique<ParquetReader>(
+        std::make_unique<dwio::common::BufferedInput>(
+            file,
+            *leafPool_,
+            MetricsLog::voidLog(),
+            nullptr,
+            nullptr,
+            /*maxMergeDistance=*/0),
+        readerOptions);
+    file->resetBytesRead();
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("a")->setFilter(std::move(filter));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    vector_size_t total = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      assertEqualVectorPart(expected, result, total);
+      total += result->size();
+    }
+    EXPECT_EQ(total, expected->size());
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return Result{stats.skippedPageRows, file->bytesRead()};
+  };
+
+  EXPECT_TRUE(
+      dwio::common::ReaderOptions{leafPool_.get()}.pageIndexFilterEnabled());
+
+  // One range of pages in the middle of the row group.
+  std::vector<int64_t> rows;
+  for (auto i = 5'000; i < 5'100; ++i) {
+    rows.push_back(i);
+  }
+  auto expected = makeExpected(rows);
+  auto makeRange = [] {
+    return std::make_unique<BigintRange>(5'000, 5'099, false);
+  };
+  const auto unfiltered = readWithFilter(makeRange(), expected, false);
+  EXPECT_EQ(unfiltered.skippedPageRows, 0);
+  const auto filtered = readWithFilter(makeRange(), expected, true);
+  EXPECT_GT(filtered.skippedPageRows, kSize / 2);
+  EXPECT_LE(filtered.skippedPageRows, kSize - expected->size());
+  // The pruned pages of both columns are not read.
+  EXPECT_LT(filtered.bytesRead * 4, unfiltered.bytesRead);
+
+  // Pages at both ends of the row group, with the pages between them pruned.
+  expected = makeExpected({150, 19'950});
+  auto makeValues = [] {
+    return common::createBigintValues({150, 19'950}, false);
+  };
+  const auto unfilteredEnds = readWithFilter(makeValues(), expected, false);
+  const auto filteredEnds = readWithFilter(makeValues(), expected, true);
+  EXPECT_GT(filteredEnds.skippedPageRows, kSize / 2);
+  EXPECT_LT(filteredEnds.bytesRead * 4, unfilteredEnds.bytesRead);
+}
+
+TEST_F(ParquetReaderTest, dictionaryFilter) {
+  // Two row groups of dictionary encoded values with the same min/max: the
+  // first has the even values in [0, 198] and the second the odd values in
+  // [1, 199].
+  constexpr int32_t kRowsPerGroup = 1'000;
+  auto data = makeRowVector(
+      {"a", "b"},
+      {makeFlatVector<int64_t>(
+           2 * kRowsPerGroup,
+           [](auto row) {
+             return (row % 100) * 2 + (row < kRowsPerGroup ? 0 : 1);
+           }),
+       makeFlatVector<StringView>(2 * kRowsPerGroup, [](auto row) {
+         return StringView(row < kRowsPerGroup ? "apple" : "cherry");
+       })});
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.flushPolicyFactory = [] {
+    return std::make_unique<DefaultFlushPolicy>(
+        kRowsPerGroup, 128 * 1'024 * 1'024);
+  };
+  auto* sink = write(data, writerOptions);
+
+  auto rowType = asRowType(data->type());
+  // Reads with 'filter' on 'column' and returns the number of skipped row
+  // groups.
+  auto readWithFilter = [&](const std::string& column,
+                            std::unique_ptr<common::Filter> filter,
+                            vector_size_t expectedRows,
+                            bool dictionaryFilterEnabled = true) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setDictionaryFilterEnabled(dictionaryFilterEnabled);
+    auto reader = createReaderInMemory(*sink, readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName(column)->setFilter(std::move(filter));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    vector_size_t total = 0;
+    while (rowReader->next(kRowsPerGroup, result) > 0) {
+      total += result->size();
+    }
+    EXPECT_EQ(total, expectedRows);
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.skippedStrides;
+  };
+
+  EXPECT_EQ(
+      readWithFilter("a", std::make_unique<BigintRange>(51, 51, false), 10),
+      1);
+  EXPECT_EQ(
+      readWithFilter(
+          "a", std::make_unique<BigintRange>(51, 51, false), 10, false),
+      0);
+  EXPECT_EQ(
+      readWithFilter("a", std::make_unique<BigintRange>(20, 21, false), 20),
+      0);
+  EXPECT_EQ(
+      readWithFilter(
+          "b",
+          std::make_unique<BytesValues>(
+              std::vector<std::string>{"banana", "cherry"}, false),
+          kRowsPerGroup),
+      1);
+  // A filter that passes nulls cannot exclude row groups by the dictionary.
+  EXPECT_EQ(
+      readWithFilter("a", std::make_unique<BigintRange>(51, 51, true), 10),
+      0);
+}
+
+TEST_F(ParquetReaderTest, parallelDecoding) {
+  constexpr int32_t kSize = 10'000;
+  constexpr int32_t kNumColumns = 8;
+  std::vector<std::string> names;
+  std::vector<VectorPtr> columns;
+  for (auto i = 0; i < kNumColumns; ++i) {
+    names.push_back(fmt::format("c{}", i));
+    if (i % 2 == 0) {
+      columns.push_back(makeFlatVector<int64_t>(
+          kSize, [i](auto row) { return row * kNumColumns + i; }));
+    } else {
+      columns.push_back(makeFlatVector<std::string>(
+          kSize,
+          [i](auto row) { return fmt::format("value {} {}", row, i); },
+          [](auto row) { return row % 7 == 0; }));
+    }
+  }
+  auto data = makeRowVector(names, columns);
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.flushPolicyFactory = [] {
+    return std::make_unique<DefaultFlushPolicy>(3'000, 128 * 1'024 * 1'024);
+  };
+  auto* sink = write(data, writerOptions);
+
+  auto rowType = asRowType(data->type());
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(3);
+  // Reads every third row with a filter on "c0", decoding on
+  // 'decodingExecutor', and compares the result with 'data'.
+  auto readWithExecutor = [&](std::shared_ptr<folly::Executor>
+                                  decodingExecutor) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sink, readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    std::vector<int64_t> values;
+    for (auto row = 0; row < kSize; row += 3) {
+      values.push_back(row * kNumColumns);
+    }
+    scanSpec->childByName("c0")->setFilter(
+        common::createBigintValues(values, false));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    rowReaderOpts.setDecodingExecutor(decodingExecutor);
+    rowReaderOpts.setDecodingParallelismFactor(decodingExecutor ? 4 : 0);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    vector_size_t total = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      auto* row = result->as<RowVector>();
+      for (auto i = 0; i < row->size(); ++i) {
+        const auto expectedRow = 3 * (total + i);
+        ASSERT_TRUE(row->equalValueAt(data.get(), i, expectedRow))
+            << row->toString(i) << " vs " << data->toString(expectedRow);
+      }
+      if (decodingExecutor) {
+        for (const auto& child : row->children()) {
+          EXPECT_FALSE(isLazyNotLoaded(*child));
+        }
+      }
+      total += result->size();
+    }
+    EXPECT_EQ(total, (kSize + 2) / 3);
+  };
+
+  readWithExecutor(nullptr);
+  readWithExecutor(executor);
+}
+
 TEST_F(ParquetReaderTest, parseLongTagged) {
   // This is a case for long with annonation read
   const std::string sample(getExampleFilePath("tagged_long.parquet"));
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/EncodingSelector.h"
+
+#include <folly/Random.h>
+#include <gtest/gtest.h>
+
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::parquet {
+namespace {
+
+using arrow::Encoding;
+using Selection = EncodingSelector::Selection;
+
+class EncodingSelectorTest : public ::testing::Test,
+                             public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  const EncodingSelector selector_{
+      /*dictionaryEnabled=*/true,
+      /*compressed=*/false};
+};
+
+TEST_F(EncodingSelectorTest, integers) {
+  // Sorted values have small deltas.
+  auto sorted =
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row * 3; });
+  EXPECT_EQ(
+      selector_.select(*sorted),
+      (Selection{false, Encoding::DELTA_BINARY_PACKED}));
+
+  // Few distinct values are dictionary encoded. The small deltas are the
+  // fallback.
+  auto repeated = makeFlatVector<int32_t>(
+      10'000, [](auto row) { return row % 4; }, nullEvery(5));
+  EXPECT_EQ(
+      selector_.select(*repeated),
+      (Selection{true, Encoding::DELTA_BINARY_PACKED}));
+  const EncodingSelector noDictionary{
+      /*dictionaryEnabled=*/false,
+      /*compressed=*/false};
+  EXPECT_EQ(
+      noDictionary.select(*repeated),
+      (Selection{false, Encoding::DELTA_BINARY_PACKED}));
+
+  // Random values are plain encoded.
+  folly::Random::DefaultGenerator rng(1);
+  auto random = makeFlatVector<int64_t>(
+      10'000, [&](auto /*row*/) { return folly::Random::rand64(rng); });
+  EXPECT_EQ(selector_.select(*random), (Selection{false, Encoding::PLAIN}));
+
+  // Encodings are looked through. The deltas are too large to fall back to.
+  auto dictionary = wrapInDictionary(
+      makeIndices(10'000, [](auto row) { return row % 4; }),
+      makeFlatVector<int64_t>(
+          {std::numeric_limits<int64_t>::min(),
+           std::numeric_limits<int64_t>::max(),
+           5,
+           -7}));
+  EXPECT_EQ(
+      selector_.select(*dictionary), (Selection{true, Encoding::PLAIN}));
+}
+
+TEST_F(EncodingSelectorTest, floatingPoint) {
+  auto values = makeFlatVector<double>(4'096, [](auto row) { return row; });
+  // The byte streams only pay off with compression.
+  EXPECT_EQ(selector_.select(*values), (Selection{false, Encoding::PLAIN}));
+  const EncodingSelector compressed{
+      /*dictionaryEnabled=*/true,
+      /*compressed=*/true};
+  EXPECT_EQ(
+      compressed.select(*values),
+      (Selection{false, Encoding::BYTE_STREAM_SPLIT}));
+
+  auto repeated =
+      makeFlatVector<float>(4'096, [](auto row) { return row % 3 * 0.5; });
+  EXPECT_TRUE(compressed.select(*repeated).value().dictionary);
+}
+
+TEST_F(EncodingSelectorTest, strings) {
+  // Values with long common prefixes.
+  auto prefixed = makeFlatVector<std::string>(10'000, [](auto row) {
+    return fmt::format("a common prefix {}", row);
+  });
+  EXPECT_EQ(
+      selector_.select(*prefixed),
+      (Selection{false, Encoding::DELTA_BYTE_ARRAY}));
+
+  auto repeated = makeFlatVector<std::string>(10'000, [](auto row) {
+    return fmt::format("value {}", row % 10);
+  });
+  EXPECT_TRUE(selector_.select(*repeated).value().dictionary);
+
+  folly::Random::DefaultGenerator rng(1);
+  auto random = makeFlatVector<std::string>(10'000, [&](auto /*row*/) {
+    return std::to_string(folly::Random::rand64(rng));
+  });
+  EXPECT_EQ(selector_.select(*random), (Selection{false, Encoding::PLAIN}));
+}
+
+TEST_F(EncodingSelectorTest, unsupported) {
+  EXPECT_FALSE(selector_.select(*makeAllNullFlatVector<int64_t>(100)));
+  EXPECT_FALSE(selector_.select(*makeFlatVector<int64_t>({})));
+  EXPECT_FALSE(selector_.select(*makeFlatVector<bool>({true, false})));
+  EXPECT_FALSE(selector_.select(*makeArrayVector<int64_t>({{1, 2}, {3}})));
+  EXPECT_FALSE(
+      selector_.select(*makeFlatVector<int64_t>({1, 2}, DECIMAL(10, 2))));
+}
+
+} // namespace
+} // namespace facebook::velox::parquet
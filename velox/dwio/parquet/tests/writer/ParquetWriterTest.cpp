@@ -787,6 +787,73 @@ TEST_F(ParquetWriterTest, allNulls) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 }
 
+TEST_F(ParquetWriterTest, adaptiveEncoding) {
+  auto schema = ROW({"c0"}, {BIGINT()});
+  constexpr int64_t kRows = 10'000;
+  const auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kRows, [](auto row) { return row * 7; })});
+
+  const auto writeAndReadPageHeader = [&](bool enableAdaptiveEncoding) {
+    parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = rootPool_.get();
+    writerOptions.enableAdaptiveEncoding = enableAdaptiveEncoding;
+    auto* sinkPtr = write(data, writerOptions);
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+    return readPageHeader(sinkPtr, 0);
+  };
+
+  // The sorted values are delta encoded instead of dictionary encoded.
+  const auto adaptiveHeader = writeAndReadPageHeader(true);
+  EXPECT_EQ(adaptiveHeader.type, thrift::PageType::type::DATA_PAGE);
+  EXPECT_EQ(
+      adaptiveHeader.data_page_header.encoding,
+      thrift::Encoding::DELTA_BINARY_PACKED);
+
+  const auto defaultHeader = writeAndReadPageHeader(false);
+  EXPECT_EQ(
+      defaultHeader.data_page_header.encoding,
+      thrift::Encoding::RLE_DICTIONARY);
+}
+
+TEST_F(ParquetWriterTest, stringViews) {
+  // The strings are exported as Arrow string views, which reference the
+  // string buffers of the vector.
+  auto schema = ROW({"c0", "c1"}, {VARCHAR(), VARBINARY()});
+  constexpr int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          kRows,
+          [](auto row) {
+            return row % 3 == 0 ? fmt::format("short {}", row % 100)
+                                : fmt::format("a longer string {}", row);
+          },
+          nullEvery(7)),
+      makeFlatVector<std::string>(
+          kRows,
+          [](auto row) { return std::string(row % 20, 'x'); },
+          nullEvery(11),
+          VARBINARY()),
+  });
+
+  for (const bool enableDictionary : {true, false}) {
+    SCOPED_TRACE(fmt::format("enableDictionary {}", enableDictionary));
+    parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = rootPool_.get();
+    writerOptions.enableDictionary = enableDictionary;
+    auto* sinkPtr = write(data, writerOptions);
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), kRows);
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+  }
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
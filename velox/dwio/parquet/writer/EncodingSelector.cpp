@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/EncodingSelector.h"
+
+#include <array>
+#include <cmath>
+
+#include <folly/container/F14Set.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::parquet {
+
+using arrow::Encoding;
+
+namespace {
+
+// Number of bits needed to represent 'value'.
+int32_t bitWidth(uint64_t value) {
+  return 64 - bits::countLeadingZeros(value);
+}
+
+// Size of a value zigzag encoded as a varint.
+int32_t zigzagVarintSize(int64_t value) {
+  const auto zigzag =
+      (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  return std::max(1, bits::divRoundUp(bitWidth(zigzag), 7));
+}
+
+// Estimates the DELTA_BINARY_PACKED size of 'values'. The deltas of a block of
+// 128 values are bit packed by miniblocks of 32 after subtracting the minimum
+// delta of the block. Deltas are truncated to 'maxBits'.
+uint64_t deltaBinaryPackedSize(
+    const std::vector<int64_t>& values,
+    int32_t maxBits) {
+  constexpr size_t kBlockSize = 128;
+  constexpr size_t kMiniBlockSize = 32;
+  const auto delta = [&](size_t i) {
+    return static_cast<int64_t>(
+        static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(values[i - 1]));
+  };
+  // Block size, number of miniblocks, number of values and first value.
+  uint64_t size = 8 + (values.empty() ? 0 : zigzagVarintSize(values[0]));
+  for (size_t block = 1; block < values.size(); block += kBlockSize) {
+    const auto blockEnd = std::min(block + kBlockSize, values.size());
+    auto minDelta = std::numeric_limits<int64_t>::max();
+    for (auto i = block; i < blockEnd; ++i) {
+      minDelta = std::min(minDelta, delta(i));
+    }
+    // The minimum delta and the bit widths of the 4 miniblocks.
+    size += zigzagVarintSize(minDelta) + 4;
+    for (auto miniBlock = block; miniBlock < blockEnd;
+         miniBlock += kMiniBlockSize) {
+      const auto miniBlockEnd = std::min(miniBlock + kMiniBlockSize, blockEnd);
+      uint64_t maxDelta = 0;
+      for (auto i = miniBlock; i < miniBlockEnd; ++i) {
+        maxDelta = std::max(
+            maxDelta,
+            static_cast<uint64_t>(delta(i)) - static_cast<uint64_t>(minDelta));
+      }
+      size += kMiniBlockSize * std::min(bitWidth(maxDelta), maxBits) / 8;
+    }
+  }
+  return size;
+}
+
+// Estimates the size of a dictionary of 'numDistinct' values of
+// 'dictionaryBytes' in total and of the bit packed indices of 'numValues'.
+uint64_t dictionarySize(
+    uint64_t numValues,
+    uint64_t numDistinct,
+    uint64_t dictionaryBytes) {
+  const auto indexBits = std::max(1, bitWidth(numDistinct - 1));
+  return dictionaryBytes + bits::divRoundUp(numValues * indexBits, 8);
+}
+
+// Shannon entropy in bits per byte of 'counts', a histogram of 'total' bytes.
+double entropy(const std::array<uint64_t, 256>& counts, uint64_t total) {
+  double result = 0;
+  for (auto count : counts) {
+    if (count > 0) {
+      const double probability = static_cast<double>(count) / total;
+      result -= probability * std::log2(probability);
+    }
+  }
+  return result;
+}
+
+// Calls 'func' with the non-null values of the first 'maxSamples' rows of
+// 'column'. Returns the number of values.
+template <typename T, typename Func>
+vector_size_t
+forEachSample(const BaseVector& column, vector_size_t maxSamples, Func func) {
+  const DecodedVector decoded(column);
+  const auto numRows = std::min(column.size(), maxSamples);
+  vector_size_t numValues = 0;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    if (!decoded.isNullAt(row)) {
+      func(decoded.valueAt<T>(row));
+      ++numValues;
+    }
+  }
+  return numValues;
+}
+
+} // namespace
+
+EncodingSelector::EncodingSelector(
+    bool dictionaryEnabled,
+    bool compressed,
+    vector_size_t maxSamples,
+    double minSizeRatio)
+    : dictionaryEnabled_(dictionaryEnabled),
+      compressed_(compressed),
+      maxSamples_(maxSamples),
+      minSizeRatio_(minSizeRatio) {
+  VELOX_CHECK_GT(maxSamples_, 0);
+  VELOX_CHECK_GT(minSizeRatio_, 0);
+  VELOX_CHECK_LE(minSizeRatio_, 1);
+}
+
+std::optional<EncodingSelector::Selection> EncodingSelector::select(
+    const BaseVector& column) const {
+  const auto& type = column.type();
+  if (type->isDecimal()) {
+    return std::nullopt;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+      return selectInteger<int8_t>(column, sizeof(int32_t));
+    case TypeKind::SMALLINT:
+      return selectInteger<int16_t>(column, sizeof(int32_t));
+    case TypeKind::INTEGER:
+      return selectInteger<int32_t>(column, sizeof(int32_t));
+    case TypeKind::BIGINT:
+      return selectInteger<int64_t>(column, sizeof(int64_t));
+    case TypeKind::REAL:
+      return selectFloatingPoint<float>(column);
+    case TypeKind::DOUBLE:
+      return selectFloatingPoint<double>(column);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return selectString(column);
+    default:
+      return std::nullopt;
+  }
+}
+
+template <typename T>
+std::optional<EncodingSelector::Selection> EncodingSelector::selectInteger(
+    const BaseVector& column,
+    int32_t valueSize) const {
+  std::vector<int64_t> values;
+  folly::F14FastSet<int64_t> distinct;
+  forEachSample<T>(column, maxSamples_, [&](T value) {
+    values.push_back(value);
+    distinct.insert(value);
+  });
+  if (values.empty()) {
+    return std::nullopt;
+  }
+
+  std::vector<std::pair<Encoding::type, uint64_t>> candidates;
+  candidates.emplace_back(Encoding::PLAIN, values.size() * valueSize);
+  if (dictionaryEnabled_) {
+    candidates.emplace_back(
+        Encoding::RLE_DICTIONARY,
+        dictionarySize(
+            values.size(), distinct.size(), distinct.size() * valueSize));
+  }
+  candidates.emplace_back(
+      Encoding::DELTA_BINARY_PACKED,
+      deltaBinaryPackedSize(values, valueSize * 8));
+  return pick(candidates);
+}
+
+template <typename T>
+std::optional<EncodingSelector::Selection>
+EncodingSelector::selectFloatingPoint(const BaseVector& column) const {
+  // Byte histograms of the values and of each byte position.
+  std::array<uint64_t, 256> counts{};
+  std::array<std::array<uint64_t, 256>, sizeof(T)> streamCounts{};
+  folly::F14FastSet<T> distinct;
+  const auto numValues = forEachSample<T>(column, maxSamples_, [&](T value) {
+    distinct.insert(value);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    for (auto i = 0; i < sizeof(T); ++i) {
+      ++counts[bytes[i]];
+      ++streamCounts[i][bytes[i]];
+    }
+  });
+  if (numValues == 0) {
+    return std::nullopt;
+  }
+
+  const uint64_t plainSize = numValues * sizeof(T);
+  std::vector<std::pair<Encoding::type, uint64_t>> candidates;
+  candidates.emplace_back(Encoding::PLAIN, plainSize);
+  if (dictionaryEnabled_) {
+    candidates.emplace_back(
+        Encoding::RLE_DICTIONARY,
+        dictionarySize(numValues, distinct.size(), distinct.size() * sizeof(T)));
+  }
+  if (compressed_) {
+    // BYTE_STREAM_SPLIT does not change the size by itself. Its size is the
+    // plain size scaled by how much better the byte streams compress than
+    // the interleaved bytes, as estimated by their entropies.
+    const double plainEntropy = entropy(counts, plainSize);
+    double streamEntropy = 0;
+    for (const auto& stream : streamCounts) {
+      streamEntropy += entropy(stream, numValues);
+    }
+    if (plainEntropy > 0) {
+      candidates.emplace_back(
+          Encoding::BYTE_STREAM_SPLIT,
+          plainSize * streamEntropy / (plainEntropy * sizeof(T)));
+    }
+  }
+  return pick(candidates);
+}
+
+std::optional<EncodingSelector::Selection> EncodingSelector::selectString(
+    const BaseVector& column) const {
+  std::vector<int64_t> lengths;
+  std::vector<int64_t> prefixLengths;
+  std::vector<int64_t> suffixLengths;
+  folly::F14FastSet<std::string_view> distinct;
+  uint64_t totalBytes = 0;
+  uint64_t distinctBytes = 0;
+  uint64_t suffixBytes = 0;
+  std::string_view previous;
+  forEachSample<StringView>(column, maxSamples_, [&](StringView value) {
+    const std::string_view view(value);
+    lengths.push_back(view.size());
+    totalBytes += view.size();
+    if (distinct.insert(view).second) {
+      distinctBytes += view.size();
+    }
+    const auto maxPrefix = std::min(view.size(), previous.size());
+    size_t prefix = 0;
+    while (prefix < maxPrefix && view[prefix] == previous[prefix]) {
+      ++prefix;
+    }
+    prefixLengths.push_back(prefix);
+    suffixLengths.push_back(view.size() - prefix);
+    suffixBytes += view.size() - prefix;
+    previous = view;
+  });
+  if (lengths.empty()) {
+    return std::nullopt;
+  }
+
+  const auto numValues = lengths.size();
+  std::vector<std::pair<Encoding::type, uint64_t>> candidates;
+  candidates.emplace_back(
+      Encoding::PLAIN, totalBytes + numValues * sizeof(uint32_t));
+  if (dictionaryEnabled_) {
+    candidates.emplace_back(
+        Encoding::RLE_DICTIONARY,
+        dictionarySize(
+            numValues,
+            distinct.size(),
+            distinctBytes + distinct.size() * sizeof(uint32_t)));
+  }
+  candidates.emplace_back(
+      Encoding::DELTA_LENGTH_BYTE_ARRAY,
+      totalBytes + deltaBinaryPackedSize(lengths, 32));
+  candidates.emplace_back(
+      Encoding::DELTA_BYTE_ARRAY,
+      suffixBytes + deltaBinaryPackedSize(prefixLengths, 32) +
+          deltaBinaryPackedSize(suffixLengths, 32));
+  return pick(candidates);
+}
+
+EncodingSelector::Selection EncodingSelector::pick(
+    const std::vector<std::pair<Encoding::type, uint64_t>>& candidates) const {
+  VELOX_CHECK(!candidates.empty());
+  VELOX_CHECK_EQ(candidates[0].first, Encoding::PLAIN);
+  // The best encoding overall and the best one that is not a dictionary,
+  // which is the fallback of the dictionary.
+  auto best = candidates[0];
+  auto bestNonDictionary = candidates[0];
+  for (auto i = 1; i < candidates.size(); ++i) {
+    const auto& [encoding, size] = candidates[i];
+    if (size < minSizeRatio_ * best.second) {
+      best = candidates[i];
+    }
+    if (encoding != Encoding::RLE_DICTIONARY &&
+        size < minSizeRatio_ * bestNonDictionary.second) {
+      bestNonDictionary = candidates[i];
+    }
+  }
+  if (best.first == Encoding::RLE_DICTIONARY) {
+    return {true, bestNonDictionary.first};
+  }
+  return {false, best.first};
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/dwio/parquet/writer/arrow/Types.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::parquet {
+
+/// Picks the encoding of a Parquet column from a sample of its first values.
+/// The encoded size of the sample is estimated for each encoding that
+/// applies to the physical type of the column: PLAIN and RLE_DICTIONARY for
+/// all, DELTA_BINARY_PACKED for integers, BYTE_STREAM_SPLIT for floating
+/// point and DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY for strings. The
+/// encodings are considered from the fastest to the slowest to decode and a
+/// slower one is only picked if it is smaller than 'minSizeRatio' of the
+/// size of the current pick.
+class EncodingSelector {
+ public:
+  /// The encoding picked for a column.
+  struct Selection {
+    /// Whether the column is dictionary encoded.
+    bool dictionary;
+    /// The encoding of the column if 'dictionary' is false, or the encoding
+    /// the writer falls back to if the dictionary grows too large.
+    arrow::Encoding::type encoding;
+
+    bool operator==(const Selection& other) const {
+      return dictionary == other.dictionary && encoding == other.encoding;
+    }
+  };
+
+  static constexpr vector_size_t kDefaultMaxSamples = 4'096;
+  static constexpr double kDefaultMinSizeRatio = 0.8;
+
+  /// 'dictionaryEnabled' enables RLE_DICTIONARY. 'compressed' tells whether
+  /// the pages are compressed, which BYTE_STREAM_SPLIT relies on.
+  EncodingSelector(
+      bool dictionaryEnabled,
+      bool compressed,
+      vector_size_t maxSamples = kDefaultMaxSamples,
+      double minSizeRatio = kDefaultMinSizeRatio);
+
+  /// Returns the encoding for the values of 'column' or std::nullopt if the
+  /// type of 'column' is not supported, e.g. a complex type, or 'column' has
+  /// no non-null value.
+  std::optional<Selection> select(const BaseVector& column) const;
+
+ private:
+  template <typename T>
+  std::optional<Selection> selectInteger(
+      const BaseVector& column,
+      int32_t valueSize) const;
+
+  template <typename T>
+  std::optional<Selection> selectFloatingPoint(const BaseVector& column) const;
+
+  std::optional<Selection> selectString(const BaseVector& column) const;
+
+  // Returns the selection for 'candidates', which are encodings with their
+  // estimated sizes in decreasing order of decode speed. RLE_DICTIONARY
+  // stands for dictionary encoding.
+  Selection pick(
+      const std::vector<std::pair<arrow::Encoding::type, uint64_t>>&
+          candidates) const;
+
+  const bool dictionaryEnabled_;
+  const bool compressed_;
+  const vector_size_t maxSamples_;
+  const double minSizeRatio_;
+};
+
+} // namespace facebook::velox::parquet
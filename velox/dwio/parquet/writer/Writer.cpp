@@ -101,6 +101,7 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
 struct ArrowContext {
   std::unique_ptr<FileWriter> writer;
   std::shared_ptr<::arrow::Schema> schema;
+  WriterProperties::Builder propertiesBuilder;
   std::shared_ptr<WriterProperties> properties;
   uint64_t stagingRows = 0;
   int64_t stagingBytes = 0;
@@ -127,7 +128,7 @@ Compression::type getArrowParquetCompression(
 
 namespace {
 
-std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
+WriterProperties::Builder getArrowParquetWriterOptions(
     const parquet::WriterOptions& options,
     const std::unique_ptr<DefaultFlushPolicy>& flushPolicy) {
   auto builder = WriterProperties::Builder();
@@ -165,10 +166,13 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     properties =
         properties->data_page_version(arrow::ParquetDataPageVersion::V1);
   }
+  if (options.enableWritePageIndex.value_or(false)) {
+    properties = properties->enable_write_page_index();
+  }
   if (options.createdBy.has_value()) {
     properties = properties->created_by(options.createdBy.value());
   }
-  return properties->build();
+  return builder;
 }
 
 void validateSchemaRecursive(
@@ -331,6 +335,21 @@ std::optional<bool> isParquetEnableDictionary(
   return std::nullopt;
 }
 
+std::optional<bool> isParquetEnableAdaptiveEncoding(
+    const config::ConfigBase& config,
+    const char* configKey) {
+  try {
+    if (const auto enableAdaptiveEncoding = config.get<bool>(configKey)) {
+      return enableAdaptiveEncoding.value();
+    }
+  } catch (const folly::ConversionError& e) {
+    VELOX_USER_FAIL(
+        "Invalid parquet writer enable adaptive encoding option: {}",
+        e.what());
+  }
+  return std::nullopt;
+}
+
 std::optional<bool> getParquetDataPageVersion(
     const config::ConfigBase& config,
     const char* configKey) {
@@ -406,8 +425,16 @@ Writer::Writer(
   options_.timestampTimeZone = options.parquetWriteTimestampTimeZone;
   common::testutil::TestValue::adjust(
       "facebook::velox::parquet::Writer::Writer", &options_);
-  arrowContext_->properties =
+  arrowContext_->propertiesBuilder =
       getArrowParquetWriterOptions(options, flushPolicy_);
+  arrowContext_->properties = arrowContext_->propertiesBuilder.build();
+  if (options.enableAdaptiveEncoding.value_or(false)) {
+    encodingSelector_ = std::make_unique<EncodingSelector>(
+        options.enableDictionary.value_or(
+            facebook::velox::parquet::arrow::DEFAULT_IS_DICTIONARY_ENABLED),
+        options.compressionKind.value_or(common::CompressionKind_NONE) !=
+            common::CompressionKind_NONE);
+  }
   setMemoryReclaimers();
   writeInt96AsTimestamp_ = options.writeInt96AsTimestamp;
   arrowMemoryPool_ = options.arrowMemoryPool;
@@ -530,6 +557,13 @@ void Writer::write(const VectorPtr& data) {
     }
   }
 
+  // The encodings are picked from the first batch with rows, before the file
+  // writer is created with the properties.
+  if (encodingSelector_ && data->size() > 0 && !arrowContext_->writer) {
+    selectEncodings(*data->asChecked<RowVector>());
+    encodingSelector_.reset();
+  }
+
   auto bytes = data->estimateFlatSize();
   auto numRows = data->size();
   if (flushPolicy_->shouldFlush(getStripeProgress(
@@ -571,6 +605,24 @@ void Writer::abort() {
   arrowContext_.reset();
 }
 
+void Writer::selectEncodings(const RowVector& data) {
+  auto& builder = arrowContext_->propertiesBuilder;
+  for (auto i = 0; i < data.childrenSize(); ++i) {
+    const auto selection = encodingSelector_->select(*data.childAt(i));
+    if (!selection.has_value()) {
+      continue;
+    }
+    const auto& path = schema_->nameOf(i);
+    if (selection->dictionary) {
+      builder.enable_dictionary(path);
+    } else {
+      builder.disable_dictionary(path);
+    }
+    builder.encoding(path, selection->encoding);
+  }
+  arrowContext_->properties = builder.build();
+}
+
 void Writer::setMemoryReclaimers() {
   VELOX_CHECK(
       !pool_->isLeaf(),
@@ -666,6 +718,17 @@ void WriterOptions::processConfigs(
               connectorConfig, kParquetHiveConnectorEnableDictionary);
   }
 
+  if (!enableAdaptiveEncoding) {
+    enableAdaptiveEncoding =
+        isParquetEnableAdaptiveEncoding(
+            session, kParquetSessionEnableAdaptiveEncoding)
+            .has_value()
+        ? isParquetEnableAdaptiveEncoding(
+              session, kParquetSessionEnableAdaptiveEncoding)
+        : isParquetEnableAdaptiveEncoding(
+              connectorConfig, kParquetHiveConnectorEnableAdaptiveEncoding);
+  }
+
   if (!dictionaryPageSizeLimit) {
     dictionaryPageSizeLimit =
         getParquetPageSize(session, kParquetSessionDictionaryPageSizeLimit)
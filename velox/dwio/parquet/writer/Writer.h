@@ -26,6 +26,7 @@
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
 #include "velox/dwio/parquet/ParquetFieldId.h"
+#include "velox/dwio/parquet/writer/EncodingSelector.h"
 #include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/dwio/parquet/writer/arrow/util/Compression.h"
 #include "velox/vector/ComplexVector.h"
@@ -112,7 +113,14 @@ struct WriterOptions : public dwio::common::WriterOptions {
   std::optional<int64_t> dataPageSize;
   std::optional<int64_t> dictionaryPageSizeLimit;
   std::optional<bool> enableDictionary;
+  /// If true, the encoding of each top level column of a primitive type is
+  /// picked from a sample of the first batch written, see EncodingSelector.
+  /// The picks override 'encoding' for these columns.
+  std::optional<bool> enableAdaptiveEncoding;
   std::optional<bool> useParquetDataPageV2;
+  /// If true, writes the ColumnIndex and OffsetIndex of each column chunk so
+  /// that readers can skip pages by their statistics.
+  std::optional<bool> enableWritePageIndex;
   std::optional<std::string> createdBy;
 
   std::shared_ptr<arrow::MemoryPool> arrowMemoryPool;
@@ -135,6 +143,10 @@ struct WriterOptions : public dwio::common::WriterOptions {
       "hive.parquet.writer.enable_dictionary";
   static constexpr const char* kParquetHiveConnectorEnableDictionary =
       "hive.parquet.writer.enable-dictionary";
+  static constexpr const char* kParquetSessionEnableAdaptiveEncoding =
+      "hive.parquet.writer.enable_adaptive_encoding";
+  static constexpr const char* kParquetHiveConnectorEnableAdaptiveEncoding =
+      "hive.parquet.writer.enable-adaptive-encoding";
   static constexpr const char* kParquetSessionDictionaryPageSizeLimit =
       "hive.parquet.writer.dictionary_page_size_limit";
   static constexpr const char* kParquetHiveConnectorDictionaryPageSizeLimit =
@@ -220,6 +232,10 @@ class Writer : public dwio::common::Writer {
   // 'exportFlattenedVector' in Arrow export.
   bool needFlatten(const VectorPtr& data) const;
 
+  // Sets the encodings of the top level columns of the file from a sample of
+  // 'data'.
+  void selectEncodings(const RowVector& data);
+
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
@@ -234,9 +250,15 @@ class Writer : public dwio::common::Writer {
 
   std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
 
+  // Set until the encodings are picked if adaptive encoding is enabled.
+  std::unique_ptr<EncodingSelector> encodingSelector_;
+
   const RowTypePtr schema_;
 
-  ArrowOptions options_{.flattenDictionary = true, .flattenConstant = true};
+  ArrowOptions options_{
+      .flattenDictionary = true,
+      .flattenConstant = true,
+      .exportToStringView = true};
 
   // Whether to write Int96 timestamps in Arrow Parquet write.
   bool writeInt96AsTimestamp_;
@@ -138,6 +138,19 @@ struct ValueBufferSlicer {
             pool_, data->buffers[1]->data(), data->offset, data->length));
     return Status::OK();
   }
+
+  Status Visit(
+      const ::arrow::BinaryViewArray& array,
+      std::shared_ptr<Buffer>* buffer) {
+    return VisitViews(array, buffer);
+  }
+
+  Status Visit(
+      const ::arrow::StringViewArray& array,
+      std::shared_ptr<Buffer>* buffer) {
+    return VisitViews(array, buffer);
+  }
+
 #define NOT_IMPLEMENTED_VISIT(ArrowTypePrefix)            \
   Status Visit(                                           \
       const ::arrow::ArrowTypePrefix##Array& array,       \
@@ -157,11 +170,21 @@ struct ValueBufferSlicer {
   NOT_IMPLEMENTED_VISIT(Dictionary);
   NOT_IMPLEMENTED_VISIT(RunEndEncoded);
   NOT_IMPLEMENTED_VISIT(Extension);
-  NOT_IMPLEMENTED_VISIT(BinaryView);
-  NOT_IMPLEMENTED_VISIT(StringView);
 
 #undef NOT_IMPLEMENTED_VISIT
 
+  // Slices the views. The data buffers they point to are not sliced.
+  Status VisitViews(
+      const ::arrow::BinaryViewArray& array,
+      std::shared_ptr<Buffer>* buffer) {
+    auto data = array.data();
+    *buffer = SliceBuffer(
+        data->buffers[1],
+        data->offset * sizeof(::arrow::BinaryViewType::c_type),
+        data->length * sizeof(::arrow::BinaryViewType::c_type));
+    return Status::OK();
+  }
+
   MemoryPool* pool_;
 };
 
@@ -2709,7 +2732,9 @@ Status TypedColumnWriterImpl<ByteArrayType>::WriteArrowDense(
     const ::arrow::Array& array,
     ArrowWriteContext* ctx,
     bool maybe_parent_nulls) {
-  if (!::arrow::is_base_binary_like(array.type()->id())) {
+  if (!::arrow::is_base_binary_like(array.type()->id()) &&
+      array.type_id() != ::arrow::Type::BINARY_VIEW &&
+      array.type_id() != ::arrow::Type::STRING_VIEW) {
     ARROW_UNSUPPORTED();
   }
 
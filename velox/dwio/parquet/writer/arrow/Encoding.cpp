@@ -98,6 +98,46 @@ std::shared_ptr<ResizableBuffer> AllocateBuffer(
 // unsigned, but the Java implementation uses signed ints.
 constexpr size_t kMaxByteArraySize = std::numeric_limits<int32_t>::max();
 
+bool IsBinaryView(const ::arrow::Array& values) {
+  return values.type_id() == ::arrow::Type::BINARY_VIEW ||
+      values.type_id() == ::arrow::Type::STRING_VIEW;
+}
+
+// Calls 'valid_func' with each non-null value of 'array', which is a binary,
+// binary view or fixed size binary array.
+template <typename ArrayType, typename ValidFunc>
+Status VisitBinaryValues(const ArrayType& array, ValidFunc&& valid_func) {
+  if constexpr (std::is_same_v<ArrayType, ::arrow::BinaryViewArray>) {
+    for (int64_t i = 0; i < array.length(); ++i) {
+      if (array.IsValid(i)) {
+        RETURN_NOT_OK(valid_func(array.GetView(i)));
+      }
+    }
+    return Status::OK();
+  } else {
+    return ::arrow::VisitArraySpanInline<typename ArrayType::TypeClass>(
+        *array.data(),
+        std::forward<ValidFunc>(valid_func),
+        []() { return Status::OK(); });
+  }
+}
+
+// Returns the total size of the values of the binary or binary view 'array'.
+template <typename ArrayType>
+int64_t BinaryValuesSize(const ArrayType& array) {
+  if constexpr (std::is_same_v<ArrayType, ::arrow::BinaryViewArray>) {
+    int64_t total_bytes = 0;
+    for (int64_t i = 0; i < array.length(); ++i) {
+      if (array.IsValid(i)) {
+        total_bytes += array.GetView(i).size();
+      }
+    }
+    return total_bytes;
+  } else {
+    return array.value_offset(array.length()) - array.value_offset(0);
+  }
+}
+
 class EncoderImpl : virtual public Encoder {
  public:
   EncoderImpl(
@@ -190,24 +230,18 @@ class PlainEncoder : public EncoderImpl, virtual public TypedEncoder<DType> {
  protected:
   template <typename ArrayType>
   void PutBinaryArray(const ArrayType& array) {
-    const int64_t total_bytes =
-        array.value_offset(array.length()) - array.value_offset(0);
+    const int64_t total_bytes = BinaryValuesSize(array);
     PARQUET_THROW_NOT_OK(
         sink_.Reserve(total_bytes + array.length() * sizeof(uint32_t)));
 
-    PARQUET_THROW_NOT_OK(
-        ::arrow::VisitArraySpanInline<typename ArrayType::TypeClass>(
-            *array.data(),
-            [&](std::string_view view) {
-              if (ARROW_PREDICT_FALSE(view.size() > kMaxByteArraySize)) {
-                return Status::Invalid(
-                    "Parquet cannot store strings with size 2GB or more");
-              }
-              UnsafePutByteArray(
-                  view.data(), static_cast<uint32_t>(view.size()));
-              return Status::OK();
-            },
-            []() { return Status::OK(); }));
+    PARQUET_THROW_NOT_OK(VisitBinaryValues(array, [&](std::string_view view) {
+      if (ARROW_PREDICT_FALSE(view.size() > kMaxByteArraySize)) {
+        return Status::Invalid(
+            "Parquet cannot store strings with size 2GB or more");
+      }
+      UnsafePutByteArray(view.data(), static_cast<uint32_t>(view.size()));
+      return Status::OK();
+    }));
   }
 
   ::arrow::BufferBuilder sink_;
@@ -289,8 +323,10 @@ void PlainEncoder<DType>::Put(const ::arrow::Array& values) {
 }
 
 void AssertBaseBinary(const ::arrow::Array& values) {
-  if (!::arrow::is_base_binary_like(values.type_id())) {
-    throw ParquetException("Only BaseBinaryArray and subclasses supported");
+  if (!::arrow::is_base_binary_like(values.type_id()) &&
+      !IsBinaryView(values)) {
+    throw ParquetException(
+        "Only BaseBinaryArray, BinaryViewArray and subclasses supported");
   }
 }
 
@@ -300,6 +336,8 @@ inline void PlainEncoder<ByteArrayType>::Put(const ::arrow::Array& values) {
 
   if (::arrow::is_binary_like(values.type_id())) {
     PutBinaryArray(checked_cast<const ::arrow::BinaryArray&>(values));
+  } else if (IsBinaryView(values)) {
+    PutBinaryArray(checked_cast<const ::arrow::BinaryViewArray&>(values));
   } else {
     VELOX_DCHECK(::arrow::is_large_binary_like(values.type_id()));
     PutBinaryArray(checked_cast<const ::arrow::LargeBinaryArray&>(values));
@@ -650,18 +688,14 @@ class DictEncoderImpl : public EncoderImpl, virtual public DictEncoder<DType> {
 
   template <typename ArrayType>
   void PutBinaryArray(const ArrayType& array) {
-    PARQUET_THROW_NOT_OK(
-        ::arrow::VisitArraySpanInline<typename ArrayType::TypeClass>(
-            *array.data(),
-            [&](std::string_view view) {
-              if (ARROW_PREDICT_FALSE(view.size() > kMaxByteArraySize)) {
-                return Status::Invalid(
-                    "Parquet cannot store strings with size 2GB or more");
-              }
-              PutByteArray(view.data(), static_cast<uint32_t>(view.size()));
-              return Status::OK();
-            },
-            []() { return Status::OK(); }));
+    PARQUET_THROW_NOT_OK(VisitBinaryValues(array, [&](std::string_view view) {
+      if (ARROW_PREDICT_FALSE(view.size() > kMaxByteArraySize)) {
+        return Status::Invalid(
+            "Parquet cannot store strings with size 2GB or more");
+      }
+      PutByteArray(view.data(), static_cast<uint32_t>(view.size()));
+      return Status::OK();
+    }));
   }
 
   template <typename ArrayType>
@@ -830,6 +864,8 @@ void DictEncoderImpl<ByteArrayType>::Put(const ::arrow::Array& values) {
   AssertBaseBinary(values);
   if (::arrow::is_binary_like(values.type_id())) {
     PutBinaryArray(checked_cast<const ::arrow::BinaryArray&>(values));
+  } else if (IsBinaryView(values)) {
+    PutBinaryArray(checked_cast<const ::arrow::BinaryViewArray&>(values));
   } else {
     VELOX_DCHECK(::arrow::is_large_binary_like(values.type_id()));
     PutBinaryArray(checked_cast<const ::arrow::LargeBinaryArray&>(values));
@@ -890,6 +926,9 @@ void DictEncoderImpl<ByteArrayType>::PutDictionary(
 
   if (::arrow::is_binary_like(values.type_id())) {
     PutBinaryDictionaryArray(checked_cast<const ::arrow::BinaryArray&>(values));
+  } else if (IsBinaryView(values)) {
+    PutBinaryDictionaryArray(
+        checked_cast<const ::arrow::BinaryViewArray&>(values));
   } else {
     VELOX_DCHECK(::arrow::is_large_binary_like(values.type_id()));
     PutBinaryDictionaryArray(
@@ -3045,19 +3084,15 @@ class DeltaLengthByteArrayEncoder : public EncoderImpl,
  protected:
   template <typename ArrayType>
   void PutBinaryArray(const ArrayType& array) {
-    PARQUET_THROW_NOT_OK(
-        ::arrow::VisitArraySpanInline<typename ArrayType::TypeClass>(
-            *array.data(),
-            [&](std::string_view view) {
-              if (ARROW_PREDICT_FALSE(view.size() > kMaxByteArraySize)) {
-                return Status::Invalid(
-                    "Parquet cannot store strings with size 2GB or more");
-              }
-              length_encoder_.Put({static_cast<int32_t>(view.length())}, 1);
-              PARQUET_THROW_NOT_OK(sink_.Append(view.data(), view.length()));
-              return Status::OK();
-            },
-            []() { return Status::OK(); }));
+    PARQUET_THROW_NOT_OK(VisitBinaryValues(array, [&](std::string_view view) {
+      if (ARROW_PREDICT_FALSE(view.size() > kMaxByteArraySize)) {
+        return Status::Invalid(
+            "Parquet cannot store strings with size 2GB or more");
+      }
+      length_encoder_.Put({static_cast<int32_t>(view.length())}, 1);
+      PARQUET_THROW_NOT_OK(sink_.Append(view.data(), view.length()));
+      return Status::OK();
+    }));
   }
 
   ::arrow::BufferBuilder sink_;
@@ -3070,6 +3105,8 @@ void DeltaLengthByteArrayEncoder<DType>::Put(const ::arrow::Array& values) {
   AssertBaseBinary(values);
   if (::arrow::is_binary_like(values.type_id())) {
     PutBinaryArray(checked_cast<const ::arrow::BinaryArray&>(values));
+  } else if (IsBinaryView(values)) {
+    PutBinaryArray(checked_cast<const ::arrow::BinaryViewArray&>(values));
   } else {
     PutBinaryArray(checked_cast<const ::arrow::LargeBinaryArray&>(values));
   }
@@ -3624,47 +3661,43 @@ class DeltaByteArrayEncoder : public EncoderImpl,
     auto previous_len = static_cast<uint32_t>(last_value_.length());
     std::string_view last_value_view = last_value_;
 
-    PARQUET_THROW_NOT_OK(
-        ::arrow::VisitArraySpanInline<typename ArrayType::TypeClass>(
-            *array.data(),
-            [&](std::string_view view) {
-              if (ARROW_PREDICT_FALSE(view.size() >= kMaxByteArraySize)) {
-                return Status::Invalid(
-                    "Parquet cannot store strings with size 2GB or more");
-              }
-              const ByteArray src{std::string_view(view.data(), view.size())};
-
-              uint32_t common_prefix_length = 0;
-              const uint32_t len = src.len;
-              const uint32_t maximum_common_prefix_length =
-                  std::min(previous_len, len);
-              while (common_prefix_length < maximum_common_prefix_length) {
-                if (last_value_view[common_prefix_length] !=
-                    view[common_prefix_length]) {
-                  break;
-                }
-                common_prefix_length++;
-              }
-              previous_len = len;
-              prefix_length_encoder_.Put(
-                  {static_cast<int32_t>(common_prefix_length)}, 1);
-
-              last_value_view = std::string_view(view.data(), view.size());
-              const auto suffix_length =
-                  static_cast<uint32_t>(len - common_prefix_length);
-              if (suffix_length == 0) {
-                suffix_encoder_.Put(&empty_, 1);
-                return Status::OK();
-              }
-              const uint8_t* suffix_ptr = src.ptr + common_prefix_length;
-              // Convert to ByteArray, so it can be passed to the
-              // suffix_encoder_.
-              const ByteArray suffix(suffix_length, suffix_ptr);
-              suffix_encoder_.Put(&suffix, 1);
-
-              return Status::OK();
-            },
-            []() { return Status::OK(); }));
+    PARQUET_THROW_NOT_OK(VisitBinaryValues(array, [&](std::string_view view) {
+      if (ARROW_PREDICT_FALSE(view.size() >= kMaxByteArraySize)) {
+        return Status::Invalid(
+            "Parquet cannot store strings with size 2GB or more");
+      }
+      const ByteArray src{std::string_view(view.data(), view.size())};
+
+      uint32_t common_prefix_length = 0;
+      const uint32_t len = src.len;
+      const uint32_t maximum_common_prefix_length =
+          std::min(previous_len, len);
+      while (common_prefix_length < maximum_common_prefix_length) {
+        if (last_value_view[common_prefix_length] !=
+            view[common_prefix_length]) {
+          break;
+        }
+        common_prefix_length++;
+      }
+      previous_len = len;
+      prefix_length_encoder_.Put(
+          {static_cast<int32_t>(common_prefix_length)}, 1);
+
+      last_value_view = std::string_view(view.data(), view.size());
+      const auto suffix_length =
+          static_cast<uint32_t>(len - common_prefix_length);
+      if (suffix_length == 0) {
+        suffix_encoder_.Put(&empty_, 1);
+        return Status::OK();
+      }
+      const uint8_t* suffix_ptr = src.ptr + common_prefix_length;
+      // Convert to ByteArray, so it can be passed to the
+      // suffix_encoder_.
+      const ByteArray suffix(suffix_length, suffix_ptr);
+      suffix_encoder_.Put(&suffix, 1);
+
+      return Status::OK();
+    }));
     last_value_ = last_value_view;
   }
 
@@ -3726,6 +3759,8 @@ void DeltaByteArrayEncoder<DType>::Put(const ::arrow::Array& values) {
     PutBinaryArray(checked_cast<const ::arrow::BinaryArray&>(values));
   } else if (::arrow::is_large_binary_like(values.type_id())) {
     PutBinaryArray(checked_cast<const ::arrow::LargeBinaryArray&>(values));
+  } else if (IsBinaryView(values)) {
+    PutBinaryArray(checked_cast<const ::arrow::BinaryViewArray&>(values));
   } else if (::arrow::is_fixed_size_binary(values.type_id())) {
     PutBinaryArray(checked_cast<const ::arrow::FixedSizeBinaryArray&>(values));
   } else {
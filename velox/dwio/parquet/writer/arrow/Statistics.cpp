@@ -536,6 +536,15 @@ std::pair<ByteArray, ByteArray> GetMinMaxBinaryHelper(
   if (::arrow::is_binary_like(values.type_id())) {
     ::arrow::VisitArraySpanInline<::arrow::BinaryType>(
         *values.data(), std::move(valid_func), std::move(null_func));
+  } else if (
+      values.type_id() == ::arrow::Type::BINARY_VIEW ||
+      values.type_id() == ::arrow::Type::STRING_VIEW) {
+    const auto& views = checked_cast<const ::arrow::BinaryViewArray&>(values);
+    for (int64_t i = 0; i < views.length(); ++i) {
+      if (views.IsValid(i)) {
+        valid_func(views.GetView(i));
+      }
+    }
   } else {
     VELOX_DCHECK(::arrow::is_large_binary_like(values.type_id()));
     ::arrow::VisitArraySpanInline<::arrow::LargeBinaryType>(
@@ -19,7 +19,10 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <string>
 
+#include "velox/common/base/Nulls.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/encode/Base64.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/common/exception/Exceptions.h"
 #include "velox/type/fbhive/HiveTypeParser.h"
 
@@ -45,6 +48,37 @@ static std::string emptyString = std::string();
 
 constexpr const int32_t kDecompressionBufferFactor = 3;
 
+// Minimum size of the buffer the chunked reader collects the rows of a batch
+// in.
+constexpr uint64_t kMinChunkSize = 1 << 20;
+
+// Minimum number of rows decoded by each thread of the chunked reader.
+constexpr vector_size_t kMinRowsPerDecodeTask = 4096;
+
+// Returns the offset of the first byte in 'data' that is 'a' or 'b', or
+// 'size' if there is none.
+uint64_t findFirstOf(const char* data, uint64_t size, char a, char b) {
+  using Batch = xsimd::batch<uint8_t>;
+  const auto aBatch = Batch::broadcast(a);
+  const auto bBatch = Batch::broadcast(b);
+  uint64_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    const auto batch =
+        Batch::load_unaligned(reinterpret_cast<const uint8_t*>(data + i));
+    const uint32_t mask =
+        simd::toBitMask((batch == aBatch) | (batch == bBatch));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  for (; i < size; ++i) {
+    if (data[i] == a || data[i] == b) {
+      return i;
+    }
+  }
+  return size;
+}
+
 void resizeVector(
     BaseVector* FOLLY_NULLABLE data,
     const vector_size_t insertionIdx) {
@@ -186,6 +220,7 @@ TextRowReader::TextRowReader(
     if (opts.skipRows() > 0) {
       (void)seekToRow(opts.skipRows());
     }
+    chunked_ = canReadChunked();
   } else {
     // compressed text files, the first split reads the whole file, rest read 0
     if (pos_ != 0) {
@@ -244,6 +279,14 @@ uint64_t TextRowReader::next(
   auto rowVecPtr = BaseVector::create<RowVector>(
       reqT->type(), (vector_size_t)rows, &contents_->pool);
 
+  if (chunked_) {
+    const auto rowsRead = nextChunked(rows, *rowVecPtr);
+    currentRow_ += rowsRead;
+    rowVecPtr->resize(rowsRead);
+    result = projectColumns(rowVecPtr, *scanSpec_, mutation);
+    return rowsRead;
+  }
+
   vector_size_t rowsRead = 0;
   const auto initialPos = pos_;
   while (!atEOF_ && rowsRead < rows) {
@@ -355,6 +398,15 @@ uint64_t TextRowReader::seekToRow(uint64_t rowNumber) {
   VELOX_CHECK_GT(
       rowNumber, currentRow_, "Text file cannot seek to earlier row");
 
+  if (chunk_ != nullptr) {
+    // Hand the bytes the chunked reader has not consumed to skipLine().
+    const auto consumed = pos_ - chunkOffset_;
+    unreadData_.assign(
+        chunk_->as<char>() + consumed, chunk_->size() - consumed);
+    unreadIdx_ = 0;
+    chunk_ = nullptr;
+  }
+
   while (currentRow_ < rowNumber && !skipLine()) {
     currentRow_++;
     resetLine();
@@ -747,33 +799,44 @@ void TextRowReader::resetLine() {
   atSOL_ = true;
 }
 
-template <typename T>
-T TextRowReader::getInteger(TextRowReader& th, bool& isNull, DelimType& delim) {
-  const std::string& str = getString(th, isNull, delim);
-
-  if (str.empty()) {
-    isNull = true;
-  }
-  if (isNull) {
-    return 0;
-  }
+namespace {
 
+// Parses a non-empty integer field. Sets 'isNull' if 'str' is not an
+// acceptable integer for the warehouse or does not fit in T.
+template <typename T>
+T parseInteger(std::string_view str, bool& isNull) {
   // Test if s is not acceptable integer format for
   // the warehouse, for cases accepted by stol().
-  char c = str[0];
+  const char c = str[0];
   if (c != '-' && !std::isdigit(static_cast<unsigned char>(c))) {
     isNull = true;
     return 0;
   }
 
+  // Accumulates the negated value so that the minimum int64_t does not
+  // overflow.
+  const bool negative = c == '-';
+  const uint64_t firstDigit = negative ? 1 : 0;
+  uint64_t scanPos = firstDigit;
   int64_t v = 0;
-  unsigned long long scanPos = 0;
-  errno = 0;
-  auto scanCount = sscanf(str.c_str(), "%" SCNd64 "%lln", &v, &scanPos);
-  if (scanCount != 1 || errno == ERANGE) {
+  for (; scanPos < str.size() &&
+       std::isdigit(static_cast<unsigned char>(str[scanPos]));
+       ++scanPos) {
+    if (__builtin_mul_overflow(v, 10, &v) ||
+        __builtin_sub_overflow(v, str[scanPos] - '0', &v)) {
+      isNull = true;
+      return 0;
+    }
+  }
+  if (scanPos == firstDigit ||
+      (!negative && v == std::numeric_limits<int64_t>::min())) {
     isNull = true;
     return 0;
   }
+  if (!negative) {
+    v = -v;
+  }
+
   if (scanPos < str.size()) {
     // Check if the string is a valid decimal.
     for (uint64_t i = scanPos; i < str.size(); i++) {
@@ -797,24 +860,29 @@ T TextRowReader::getInteger(TextRowReader& th, bool& isNull, DelimType& delim) {
   return static_cast<T>(v);
 }
 
-namespace {
-
-static constexpr std::string_view kTrueStringView{"TRUE"};
-static constexpr std::string_view kFalseStringView{"FALSE"};
-
 } // namespace
 
-bool TextRowReader::getBoolean(
-    TextRowReader& th,
-    bool& isNull,
-    DelimType& delim) {
+template <typename T>
+T TextRowReader::getInteger(TextRowReader& th, bool& isNull, DelimType& delim) {
   const std::string& str = getString(th, isNull, delim);
+
   if (str.empty()) {
     isNull = true;
   }
   if (isNull) {
-    return false;
+    return 0;
   }
+  return parseInteger<T>(str, isNull);
+}
+
+namespace {
+
+static constexpr std::string_view kTrueStringView{"TRUE"};
+static constexpr std::string_view kFalseStringView{"FALSE"};
+
+// Parses a non-empty boolean field. Sets 'isNull' if 'str' is not TRUE or
+// FALSE in any case.
+bool parseBoolean(std::string_view str, bool& isNull) {
   if (str.compare(kTrueStringView) == 0) {
     return true;
   }
@@ -841,6 +909,22 @@ bool TextRowReader::getBoolean(
   return false;
 }
 
+} // namespace
+
+bool TextRowReader::getBoolean(
+    TextRowReader& th,
+    bool& isNull,
+    DelimType& delim) {
+  const std::string& str = getString(th, isNull, delim);
+  if (str.empty()) {
+    isNull = true;
+  }
+  if (isNull) {
+    return false;
+  }
+  return parseBoolean(str, isNull);
+}
+
 namespace {
 
 static constexpr std::string_view kNaNStringView{"NaN"};
@@ -895,37 +979,34 @@ void trimStringInPlace(std::string& s) {
   s = s.substr(start, last - start + 1);
 }
 
-} // namespace
-
-float TextRowReader::getFloat(
-    TextRowReader& th,
-    bool& isNull,
-    DelimType& delim) {
-  std::string& str = getString(th, isNull, delim);
-  if (str.empty()) {
-    isNull = true;
-  }
-  if (isNull) {
-    return 0;
-  }
-
+// Parses a non-empty float or double field. Trims 'str' in place. Sets
+// 'isNull' if 'str' is not an acceptable floating point value.
+template <typename T>
+T parseFloatingPoint(std::string& str, bool& isNull) {
   trimStringInPlace(str);
 
   if (str.data()[0] == '.') {
-    th.ownedString_.insert(th.ownedString_.begin(), '0');
-    str = th.ownedString_;
+    str.insert(str.begin(), '0');
   }
 
+  // Filter out values from non-warehouse sources which
+  // other readers translate to null. Warehouse
+  // readers require upper-case values.
   if (unacceptableFloatingPoint(str)) {
     isNull = true;
     return 0.0;
   }
 
-  float v = 0.0;
+  T v = 0.0;
   unsigned long long scanPos = 0;
-  // We ignore ERANGE, since denormalized floats and
+  // We ignore ERANGE, since denormalized values and
   // infinities are acceptable.
-  auto scanCount = sscanf(str.c_str(), "%f%lln", &v, &scanPos);
+  int scanCount;
+  if constexpr (std::is_same_v<T, float>) {
+    scanCount = sscanf(str.c_str(), "%f%lln", &v, &scanPos);
+  } else {
+    scanCount = sscanf(str.c_str(), "%lf%lln", &v, &scanPos);
+  }
   if (scanCount != 1 || scanPos < str.size()) {
     isNull = true;
     return 0.0;
@@ -933,6 +1014,22 @@ float TextRowReader::getFloat(
   return v;
 }
 
+} // namespace
+
+float TextRowReader::getFloat(
+    TextRowReader& th,
+    bool& isNull,
+    DelimType& delim) {
+  std::string& str = getString(th, isNull, delim);
+  if (str.empty()) {
+    isNull = true;
+  }
+  if (isNull) {
+    return 0;
+  }
+  return parseFloatingPoint<float>(str, isNull);
+}
+
 double
 TextRowReader::getDouble(TextRowReader& th, bool& isNull, DelimType& delim) {
   std::string& str = getString(th, isNull, delim);
@@ -943,32 +1040,262 @@ TextRowReader::getDouble(TextRowReader& th, bool& isNull, DelimType& delim) {
   if (isNull) {
     return 0.0;
   }
+  return parseFloatingPoint<double>(str, isNull);
+}
 
-  trimStringInPlace(str);
+bool TextRowReader::canReadChunked() {
+  if (contents_->compression != CompressionKind::CompressionKind_NONE ||
+      contents_->serDeOptions.isEscaped || options_.projectSelectedType()) {
+    return false;
+  }
+  const auto& type = getType();
+  for (auto i = 0; i < type->size(); ++i) {
+    if (!isSelectedField(schemaWithId_->childAt(i))) {
+      continue;
+    }
+    const auto& childType = type->childAt(i);
+    switch (childType->kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+        // Logical types such as DATE and DECIMAL are parsed by readElement().
+        if (*childType != *createScalarType(childType->kind())) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
 
-  if (str.data()[0] == '.') {
-    th.ownedString_.insert(th.ownedString_.begin(), '0');
-    str = th.ownedString_;
+vector_size_t TextRowReader::nextChunked(
+    uint64_t rows,
+    RowVector& rowVector) {
+  // Start a new chunk with the bytes after the last row read. The previous
+  // chunk may be referenced by the VARCHAR values of the previous batch.
+  const char* unread = unreadData_.data() + unreadIdx_;
+  uint64_t unreadSize = unreadData_.size() - unreadIdx_;
+  uint64_t chunkSize = kMinChunkSize;
+  if (chunk_ != nullptr) {
+    unread = chunk_->as<char>() + (pos_ - chunkOffset_);
+    unreadSize = chunk_->size() - (pos_ - chunkOffset_);
+    chunkSize = chunk_->capacity();
+  }
+  auto chunk = AlignedBuffer::allocate<char>(
+      std::max(chunkSize, unreadSize), &contents_->pool);
+  memcpy(chunk->asMutable<char>(), unread, unreadSize);
+  chunk->setSize(unreadSize);
+  chunk_ = std::move(chunk);
+  chunkOffset_ = pos_;
+  unreadData_.clear();
+  unreadIdx_ = 0;
+
+  // Find the lines of the batch. A line ends at '\n', '\r' or '\r\n'.
+  lines_.clear();
+  uint64_t lineBegin = 0;
+  uint64_t scanPos = 0;
+  while (lines_.size() < rows) {
+    const auto size = chunk_->size();
+    const auto lineEnd = scanPos +
+        findFirstOf(chunk_->as<char>() + scanPos, size - scanPos, '\n', '\r');
+    if (lineEnd == size) {
+      if (loadChunk()) {
+        scanPos = lineEnd;
+        continue;
+      }
+      // The last line of the file may not be terminated.
+      if (lineBegin < size) {
+        lines_.emplace_back(lineBegin, size);
+        lineBegin = size;
+      }
+      setEOF();
+      break;
+    }
+    auto next = lineEnd + 1;
+    if (chunk_->as<char>()[lineEnd] == '\r') {
+      if (next == chunk_->size()) {
+        (void)loadChunk();
+      }
+      if (next < chunk_->size() && chunk_->as<char>()[next] == '\n') {
+        ++next;
+      }
+    }
+    lines_.emplace_back(lineBegin, lineEnd);
+    lineBegin = next;
+    scanPos = next;
+
+    // Same split boundary as skipLine(), see the TODO there.
+    const auto pos = chunkOffset_ + lineBegin;
+    if (pos > limit_ || pos >= getLength()) {
+      setEOF();
+      break;
+    }
+  }
+  pos_ = chunkOffset_ + lineBegin;
+
+  const vector_size_t numRows = lines_.size();
+  const auto& type = getType();
+  chunkedColumns_.clear();
+  for (auto i = 0; i < type->size(); ++i) {
+    auto& child = rowVector.childAt(i);
+    ChunkedColumn column{type->childAt(i)->kind(), nullptr, nullptr};
+    if (child != nullptr) {
+      column.nulls = child->mutableRawNulls();
+      if (isSelectedField(schemaWithId_->childAt(i))) {
+        column.values = child->values()->asMutable<void>();
+        if (column.kind == TypeKind::VARCHAR) {
+          memset(column.values, 0, numRows * sizeof(StringView));
+          child->asFlatVector<StringView>()->addStringBuffer(chunk_);
+        }
+      } else {
+        bits::fillBits(column.nulls, 0, numRows, bits::kNull);
+      }
+    }
+    chunkedColumns_.push_back(column);
   }
 
-  // Filter out values from non-warehouse sources which
-  // other readers translate to null. Warehouse
-  // readers require upper-case values.
-  if (unacceptableFloatingPoint(str)) {
-    isNull = true;
-    return 0.0;
+  const auto& executor = options_.decodingExecutor();
+  const vector_size_t numTasks = executor == nullptr
+      ? 1
+      : std::min<vector_size_t>(
+            options_.decodingParallelismFactor(),
+            numRows / kMinRowsPerDecodeTask);
+  if (numTasks <= 1) {
+    decodeLines(0, numRows);
+  } else {
+    // Each task decodes a multiple of 64 rows so that no two threads set bits
+    // in the same word of the nulls or boolean values.
+    const vector_size_t rowsPerTask =
+        bits::roundUp(bits::divRoundUp(numRows, numTasks), 64);
+    dwio::common::ParallelFor(executor, 0, numTasks, numTasks)
+        .execute([&](size_t task) {
+          const vector_size_t begin = task * rowsPerTask;
+          const vector_size_t end = std::min(numRows, begin + rowsPerTask);
+          if (begin < end) {
+            decodeLines(begin, end);
+          }
+        });
   }
+  return numRows;
+}
 
-  double v = 0.0;
-  unsigned long long scanPos = 0;
-  // We ignore ERANGE, since denormalized doubles and
-  // infinities are acceptable.
-  auto scanCount = sscanf(str.c_str(), "%lf%lln", &v, &scanPos);
-  if (scanCount != 1 || scanPos < str.size()) {
-    isNull = true;
-    return 0.0;
+bool TextRowReader::loadChunk() {
+  const void* buffer = nullptr;
+  int32_t length = 0;
+  if (!contents_->inputStream->Next(&buffer, &length) || length <= 0) {
+    return false;
+  }
+  VELOX_CHECK_NOT_NULL(buffer);
+  const auto size = chunk_->size();
+  if (size + length > chunk_->capacity()) {
+    AlignedBuffer::reallocate<char>(
+        &chunk_, std::max<uint64_t>(2 * chunk_->capacity(), size + length));
+  }
+  memcpy(chunk_->asMutable<char>() + size, buffer, length);
+  chunk_->setSize(size + length);
+  return true;
+}
+
+void TextRowReader::decodeLines(vector_size_t begin, vector_size_t end) {
+  const auto* data = chunk_->as<char>();
+  const auto separator =
+      static_cast<char>(contents_->serDeOptions.separators.at(0));
+  const auto& nullString = contents_->serDeOptions.nullString;
+  std::string scratch;
+  for (auto row = begin; row < end; ++row) {
+    const char* field = data + lines_[row].first;
+    const char* lineEnd = data + lines_[row].second;
+    column_index_t i = 0;
+    for (; i < chunkedColumns_.size() && field <= lineEnd; ++i) {
+      const char* fieldEnd =
+          field + findFirstOf(field, lineEnd - field, separator, separator);
+      if (chunkedColumns_[i].values != nullptr) {
+        decodeField(
+            chunkedColumns_[i],
+            row,
+            std::string_view(field, fieldEnd - field),
+            nullString,
+            scratch);
+      }
+      field = fieldEnd + 1;
+    }
+    // Fields missing at the end of the line are null.
+    for (; i < chunkedColumns_.size(); ++i) {
+      if (chunkedColumns_[i].nulls != nullptr) {
+        bits::setNull(chunkedColumns_[i].nulls, row);
+      }
+    }
+  }
+}
+
+// static
+void TextRowReader::decodeField(
+    const ChunkedColumn& column,
+    vector_size_t row,
+    std::string_view field,
+    const std::string& nullString,
+    std::string& scratch) {
+  if (field == nullString) {
+    bits::setNull(column.nulls, row);
+    return;
+  }
+  if (column.kind == TypeKind::VARCHAR) {
+    static_cast<StringView*>(column.values)[row] =
+        StringView(field.data(), static_cast<int32_t>(field.size()));
+    return;
+  }
+  if (field.empty()) {
+    bits::setNull(column.nulls, row);
+    return;
+  }
+
+  bool isNull = false;
+  switch (column.kind) {
+    case TypeKind::BOOLEAN: {
+      const auto value = parseBoolean(field, isNull);
+      bits::setBit(static_cast<uint64_t*>(column.values), row, value);
+      break;
+    }
+    case TypeKind::TINYINT:
+      static_cast<int8_t*>(column.values)[row] =
+          parseInteger<int8_t>(field, isNull);
+      break;
+    case TypeKind::SMALLINT:
+      static_cast<int16_t*>(column.values)[row] =
+          parseInteger<int16_t>(field, isNull);
+      break;
+    case TypeKind::INTEGER:
+      static_cast<int32_t*>(column.values)[row] =
+          parseInteger<int32_t>(field, isNull);
+      break;
+    case TypeKind::BIGINT:
+      static_cast<int64_t*>(column.values)[row] =
+          parseInteger<int64_t>(field, isNull);
+      break;
+    case TypeKind::REAL:
+      scratch.assign(field);
+      static_cast<float*>(column.values)[row] =
+          parseFloatingPoint<float>(scratch, isNull);
+      break;
+    case TypeKind::DOUBLE:
+      scratch.assign(field);
+      static_cast<double*>(column.values)[row] =
+          parseFloatingPoint<double>(scratch, isNull);
+      break;
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported type for chunked reading: {}", column.kind);
+  }
+  if (isNull) {
+    bits::setNull(column.nulls, row);
   }
-  return v;
 }
 
 /// TODO: Reconsider error handling strategy for malformed data
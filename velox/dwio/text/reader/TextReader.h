@@ -189,6 +189,43 @@ class TextRowReader : public dwio::common::RowReader {
 
   static double getDouble(TextRowReader& th, bool& isNull, DelimType& delim);
 
+  // A column decoded by the chunked reader. 'values' and 'nulls' are the raw
+  // buffers of the child vector. 'values' is nullptr for columns that are not
+  // selected.
+  struct ChunkedColumn {
+    TypeKind kind;
+    void* values;
+    uint64_t* nulls;
+  };
+
+  /// Returns true if the rows can be read in chunks, i.e. the file is not
+  /// compressed or escaped and all selected columns are of primitive types
+  /// the chunked decoder supports.
+  bool canReadChunked();
+
+  /// Reads up to 'rows' rows into 'rowVector' using the chunked reader.
+  /// Finds the line terminators of the next rows with a SIMD scan and then
+  /// decodes the fields of sub-ranges of the rows in parallel on the decoding
+  /// executor of the row reader options, or in the calling thread if there
+  /// is none. Returns the number of rows read.
+  vector_size_t nextChunked(uint64_t rows, RowVector& rowVector);
+
+  /// Appends the next buffer of the input stream to 'chunk_'. Returns false
+  /// at the end of the stream.
+  bool loadChunk();
+
+  /// Decodes the fields of 'lines_[begin]' to 'lines_[end - 1]'.
+  void decodeLines(vector_size_t begin, vector_size_t end);
+
+  /// Decodes 'field' into row 'row' of 'column'. 'scratch' is used to parse
+  /// floating point values.
+  static void decodeField(
+      const ChunkedColumn& column,
+      vector_size_t row,
+      std::string_view field,
+      const std::string& nullString,
+      std::string& scratch);
+
   void readElement(
       const std::shared_ptr<const Type>& t,
       const std::shared_ptr<const Type>& reqT,
@@ -233,6 +270,19 @@ class TextRowReader : public dwio::common::RowReader {
   uint64_t fileLength_;
   std::string ownedString_;
   std::shared_ptr<dwio::common::DataBuffer<char>> varBinBuf_;
+
+  // True if rows are read with nextChunked().
+  bool chunked_{false};
+  // Bytes of the input starting at file offset 'chunkOffset_'. The rows of a
+  // batch are found in 'chunk_' and VARCHAR values point into it, so each
+  // batch gets a new chunk that starts with the unconsumed bytes of the
+  // previous one.
+  BufferPtr chunk_;
+  uint64_t chunkOffset_{0};
+  // Begin and end offsets of the rows of the current batch in 'chunk_',
+  // excluding the line terminators.
+  std::vector<std::pair<uint64_t, uint64_t>> lines_;
+  std::vector<ChunkedColumn> chunkedColumns_;
 };
 
 } // namespace facebook::velox::text
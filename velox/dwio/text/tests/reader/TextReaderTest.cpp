@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/text/RegisterTextReader.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 extern int daylight;
@@ -1199,6 +1202,84 @@ TEST_F(TextReaderTest, simpleTypes) {
   }
 }
 
+TEST_F(TextReaderTest, chunkedParallelDecoding) {
+  // Rows with nulls, missing fields and both line terminators, enough for
+  // several decoding tasks per batch.
+  constexpr int32_t kNumRows = 20'000;
+  std::string data;
+  for (auto i = 0; i < kNumRows; ++i) {
+    if (i % 7 == 0) {
+      data += fmt::format("{}\x01\\N\x01{}.5", i, i);
+    } else {
+      data += fmt::format(
+          "{}\x01{}\x01{}.5\x01non-inlined string {}\x01{}",
+          i,
+          i * 1'000L,
+          i,
+          i,
+          i % 2 == 0 ? "TRUE" : "false");
+    }
+    if (i < kNumRows - 1) {
+      data += i % 3 == 0 ? "\r\n" : "\n";
+    }
+  }
+  auto file = exec::test::TempFilePath::create();
+  file->append(data);
+
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          kNumRows,
+          [](auto row) { return row * 1'000L; },
+          [](auto row) { return row % 7 == 0; }),
+      makeFlatVector<double>(kNumRows, [](auto row) { return row + 0.5; }),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return fmt::format("non-inlined string {}", row); },
+          [](auto row) { return row % 7 == 0; }),
+      makeFlatVector<bool>(
+          kNumRows,
+          [](auto row) { return row % 2 == 0; },
+          [](auto row) { return row % 7 == 0; }),
+  });
+  auto type = ROW(
+      {{"c0", INTEGER()},
+       {"c1", BIGINT()},
+       {"c2", DOUBLE()},
+       {"c3", VARCHAR()},
+       {"c4", BOOLEAN()}});
+
+  auto factory = dwio::common::getReaderFactory(dwio::common::FileFormat::TEXT);
+  auto readFile = std::make_shared<LocalReadFile>(file->getPath());
+  auto readerOptions = dwio::common::ReaderOptions(pool());
+  readerOptions.setFileSchema(type);
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+
+  for (const auto parallelism : {0, 4}) {
+    SCOPED_TRACE(fmt::format("parallelism: {}", parallelism));
+    auto input =
+        std::make_unique<dwio::common::BufferedInput>(readFile, poolRef());
+    auto reader = factory->createReader(std::move(input), readerOptions);
+    dwio::common::RowReaderOptions rowReaderOptions;
+    setScanSpec(*type, rowReaderOptions);
+    if (parallelism > 0) {
+      rowReaderOptions.setDecodingExecutor(executor);
+      rowReaderOptions.setDecodingParallelismFactor(parallelism);
+    }
+    auto rowReader = reader->createRowReader(rowReaderOptions);
+
+    VectorPtr result;
+    vector_size_t offset = 0;
+    for (const auto batchSize : {12'345, 12'345}) {
+      const auto numRows = rowReader->next(batchSize, result);
+      ASSERT_EQ(numRows, std::min(batchSize, kNumRows - offset));
+      assertEqualVectors(expected->slice(offset, numRows), result);
+      offset += numRows;
+    }
+    ASSERT_EQ(rowReader->next(10, result), 0);
+  }
+}
+
 TEST_F(TextReaderTest, primitiveLimitsStressTest) {
   // Create expected vectors with 100 min values followed by 100 max values
   std::vector<int8_t> tinyintValues;
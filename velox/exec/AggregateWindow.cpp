@@ -15,8 +15,12 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+
+#include <folly/container/F14Set.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/AggregateFunctionRegistry.h"
 #include "velox/exec/WindowFunction.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/vector/FlatVector.h"
@@ -25,6 +29,22 @@ namespace facebook::velox::exec {
 
 namespace {
 
+// Fanout of the segment tree over the partition rows used for sliding frames.
+// Each frame is covered by at most 2 * (kSegmentTreeFanout - 1) nodes per
+// tree level.
+constexpr vector_size_t kSegmentTreeFanout = 16;
+
+// Returns true if 'name' is an aggregate whose result does not depend on how
+// its input is split into partial aggregations or on the order in which the
+// partial results are combined. Such aggregates can be evaluated over the
+// nodes of a segment tree.
+bool supportsSegmentTree(const std::string& name) {
+  static const folly::F14FastSet<std::string> kSupported = {
+      "sum", "count", "min", "max", "avg"};
+  // Strip the catalog and schema prefix of the registered name, if any.
+  return kSupported.contains(name.substr(name.rfind('.') + 1));
+}
+
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
@@ -100,6 +120,10 @@ class AggregateWindowFunction : public exec::WindowFunction {
     // the aggregate to the final result.
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
+    if (supportsSegmentTree(name)) {
+      intermediateType_ = resolveIntermediateType(name, argTypes_);
+    }
+
     computeDefaultAggregateValue(resultType);
   }
 
@@ -116,6 +140,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTreeBuilt_ = false;
+    segmentTreeArgs_.clear();
+    segmentTreeLevels_.clear();
   }
 
   void apply(
@@ -163,6 +190,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+      segmentTreeAggregation(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -345,6 +375,186 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are better computed from a
+  // segment tree than by aggregating each frame from scratch. This is the case
+  // for large sliding frames, e.g. ROWS BETWEEN 100 PRECEDING AND CURRENT ROW.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    // A partial partition drops processed rows, so the tree cannot be built
+    // over all its rows upfront.
+    if (intermediateType_ == nullptr || partition_->partial()) {
+      return false;
+    }
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    return numFrameRows > kSegmentTreeFanout * validRows.countSelected();
+  }
+
+  // Allocates and initializes 'numGroups' accumulators in 'buffer'. Returns
+  // pointers to them.
+  std::vector<char*> initializeGroups(
+      vector_size_t numGroups,
+      BufferPtr& buffer) {
+    const auto rowSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    buffer = AlignedBuffer::allocate<char>(numGroups * rowSize, pool_, char(0));
+    std::vector<char*> groups(numGroups);
+    std::vector<vector_size_t> indices(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      groups[i] = buffer->asMutable<char>() + i * rowSize;
+      indices[i] = i;
+    }
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(groups.data(), indices);
+    return groups;
+  }
+
+  // Builds the segment tree over all rows of the partition. Level k of the
+  // tree has a node for every kSegmentTreeFanout nodes of level k - 1. Level 0
+  // is the raw arguments in 'segmentTreeArgs_'. The intermediate results of
+  // the nodes of level k > 0 are in segmentTreeLevels_[k - 1]. The top level
+  // has at most kSegmentTreeFanout nodes.
+  void buildSegmentTree() {
+    const auto numRows = partition_->numRows();
+    segmentTreeArgs_.resize(argIndices_.size());
+    for (auto i = 0; i < argIndices_.size(); ++i) {
+      if (argIndices_[i] == kConstantChannel) {
+        segmentTreeArgs_[i] =
+            BaseVector::wrapInConstant(numRows, 0, argVectors_[i]);
+      } else {
+        segmentTreeArgs_[i] = BaseVector::create(argTypes_[i], numRows, pool_);
+        partition_->extractColumn(
+            argIndices_[i], 0, numRows, 0, segmentTreeArgs_[i]);
+      }
+    }
+
+    auto numChildren = numRows;
+    while (numChildren > kSegmentTreeFanout) {
+      const auto numNodes = bits::divRoundUp(numChildren, kSegmentTreeFanout);
+      BufferPtr nodesBuffer;
+      auto nodes = initializeGroups(numNodes, nodesBuffer);
+      std::vector<char*> groups(numChildren);
+      for (auto i = 0; i < numChildren; ++i) {
+        groups[i] = nodes[i / kSegmentTreeFanout];
+      }
+      SelectivityVector rows(numChildren);
+      if (segmentTreeLevels_.empty()) {
+        aggregate_->addRawInput(groups.data(), rows, segmentTreeArgs_, false);
+      } else {
+        aggregate_->addIntermediateResults(
+            groups.data(), rows, {segmentTreeLevels_.back()}, false);
+      }
+      auto level = BaseVector::create(intermediateType_, numNodes, pool_);
+      aggregate_->extractAccumulators(nodes.data(), numNodes, &level);
+      aggregate_->destroy(folly::Range(nodes.data(), nodes.size()));
+      segmentTreeLevels_.push_back(std::move(level));
+      numChildren = numNodes;
+    }
+  }
+
+  // Computes the aggregate of each frame from the segment tree nodes covering
+  // it. All frames of the block are aggregated together: one addRawInput call
+  // for the rows at the frame edges and one addIntermediateResults call per
+  // tree level.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    if (!segmentTreeBuilt_) {
+      buildSegmentTree();
+      segmentTreeBuilt_ = true;
+    }
+    const auto numLevels = segmentTreeLevels_.size() + 1;
+
+    const auto numFrames = validRows.countSelected();
+    BufferPtr groupsBuffer;
+    auto groups = initializeGroups(numFrames, groupsBuffer);
+
+    // For each tree level, the nodes to add and the frame they are added to.
+    std::vector<std::vector<vector_size_t>> levelNodes(numLevels);
+    std::vector<std::vector<char*>> levelGroups(numLevels);
+    auto addNodes = [&](size_t level,
+                        vector_size_t begin,
+                        vector_size_t end,
+                        char* group) {
+      for (auto node = begin; node < end; ++node) {
+        levelNodes[level].push_back(node);
+        levelGroups[level].push_back(group);
+      }
+    };
+
+    vector_size_t frame = 0;
+    validRows.applyToSelected([&](auto i) {
+      auto* group = groups[frame++];
+      // Half-open range of nodes of the current level in the frame.
+      vector_size_t begin = rawFrameStarts[i];
+      vector_size_t end = rawFrameEnds[i] + 1;
+      for (size_t level = 0; begin < end; ++level) {
+        if (level == numLevels - 1) {
+          addNodes(level, begin, end, group);
+          break;
+        }
+        const auto leftEnd = std::min<vector_size_t>(
+            bits::roundUp(begin, kSegmentTreeFanout), end);
+        addNodes(level, begin, leftEnd, group);
+        if (leftEnd == end) {
+          break;
+        }
+        const vector_size_t rightBegin = std::max<vector_size_t>(
+            end / kSegmentTreeFanout * kSegmentTreeFanout, leftEnd);
+        addNodes(level, rightBegin, end, group);
+        begin = leftEnd / kSegmentTreeFanout;
+        end = rightBegin / kSegmentTreeFanout;
+      }
+    });
+
+    for (auto level = 0; level < numLevels; ++level) {
+      const vector_size_t numNodes = levelNodes[level].size();
+      if (numNodes == 0) {
+        continue;
+      }
+      auto indices = allocateIndices(numNodes, pool_);
+      std::copy(
+          levelNodes[level].begin(),
+          levelNodes[level].end(),
+          indices->asMutable<vector_size_t>());
+      SelectivityVector rows(numNodes);
+      if (level == 0) {
+        std::vector<VectorPtr> args;
+        args.reserve(segmentTreeArgs_.size());
+        for (const auto& arg : segmentTreeArgs_) {
+          args.push_back(
+              BaseVector::wrapInDictionary(nullptr, indices, numNodes, arg));
+        }
+        aggregate_->addRawInput(levelGroups[level].data(), rows, args, false);
+      } else {
+        aggregate_->addIntermediateResults(
+            levelGroups[level].data(),
+            rows,
+            {BaseVector::wrapInDictionary(
+                nullptr, indices, numNodes, segmentTreeLevels_[level - 1])},
+            false);
+      }
+    }
+
+    auto frameResults = BaseVector::create(resultType(), numFrames, pool_);
+    aggregate_->extractValues(groups.data(), numFrames, &frameResults);
+    aggregate_->destroy(folly::Range(groups.data(), groups.size()));
+    frame = 0;
+    validRows.applyToSelected([&](auto i) {
+      result->copy(frameResults.get(), resultOffset + i, frame++, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -385,6 +595,17 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // This vector is used to copy from the aggregate to the result.
   VectorPtr aggregateResultVector_;
 
+  // Intermediate type of the aggregate if it can be evaluated over a segment
+  // tree. nullptr otherwise.
+  TypePtr intermediateType_;
+
+  // Arguments for all rows of the partition and the intermediate results of
+  // the nodes of each level of the segment tree above them. Built on first
+  // use for a partition. See buildSegmentTree().
+  bool segmentTreeBuilt_{false};
+  std::vector<VectorPtr> segmentTreeArgs_;
+  std::vector<VectorPtr> segmentTreeLevels_;
+
   // Stores metadata about the previous output block of the partition
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/BatchCoalescer.h"
+#include "velox/common/Casts.h"
+#include "velox/exec/Operator.h"
+#include "velox/vector/EncodedVectorCopy.h"
+
+namespace facebook::velox::exec {
+
+bool BatchCoalescer::isSmall(const RowVectorPtr& input, uint64_t inputBytes)
+    const {
+  if (input->containsLazyNotLoaded()) {
+    // Lazy vectors must be loaded by the next operator before the producing
+    // operator advances.
+    return false;
+  }
+  return input->size() < maxRows_ / 2 &&
+      (maxBytes_ == 0 || inputBytes < maxBytes_ / 2);
+}
+
+RowVectorPtr BatchCoalescer::add(RowVectorPtr input, uint64_t inputBytes) {
+  VELOX_CHECK_NULL(ready_);
+  if (!isSmall(input, inputBytes)) {
+    if (pending_.empty()) {
+      return input;
+    }
+    ready_ = std::move(input);
+    return flush();
+  }
+
+  RowVectorPtr output;
+  if (!pending_.empty() &&
+      (pendingRows_ + input->size() > maxRows_ ||
+       (maxBytes_ > 0 && pendingBytes_ + inputBytes > maxBytes_))) {
+    output = flush();
+  }
+  pendingRows_ += input->size();
+  pendingBytes_ += inputBytes;
+  pending_.push_back(std::move(input));
+  if (output == nullptr && pendingRows_ >= maxRows_) {
+    output = flush();
+  }
+  return output;
+}
+
+RowVectorPtr BatchCoalescer::flush() {
+  if (pending_.empty()) {
+    return nullptr;
+  }
+
+  RowVectorPtr output;
+  if (pending_.size() == 1) {
+    output = std::move(pending_[0]);
+  } else {
+    VectorPtr target;
+    const EncodedVectorCopyOptions options{op_->pool(), false};
+    vector_size_t targetIndex{0};
+    for (const auto& batch : pending_) {
+      const BaseVector::CopyRange range{0, targetIndex, batch->size()};
+      encodedVectorCopy(options, batch, {&range, 1}, target);
+      targetIndex += batch->size();
+    }
+    VELOX_CHECK_EQ(targetIndex, pendingRows_);
+    output = checkedPointerCast<RowVector, BaseVector>(target);
+    op_->addRuntimeStat(kCoalescedBatches, RuntimeCounter(pending_.size()));
+  }
+
+  pending_.clear();
+  pendingRows_ = 0;
+  pendingBytes_ = 0;
+  return output;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+class Operator;
+
+/// Accumulates the small batches an operator produces back-to-back into fewer
+/// larger ones before the driver hands them to the next operator. Used by the
+/// Driver when 'coalesce_operator_output_batches' is enabled.
+///
+/// A batch is small if it has fewer than half of 'maxRows' rows and, if
+/// 'maxBytes' is not zero, is smaller than half of 'maxBytes'. Small batches
+/// are buffered until adding another one would exceed 'maxRows' or 'maxBytes'
+/// and are then copied into a single vector, preserving dictionary and
+/// constant encodings where possible. Batches that are not small or that
+/// contain not loaded lazy vectors are never buffered.
+class BatchCoalescer {
+ public:
+  /// The number of small batches merged into each coalesced batch, recorded
+  /// in the runtime stats of the producing operator.
+  static inline const std::string kCoalescedBatches{"coalescedBatches"};
+
+  BatchCoalescer(Operator* op, vector_size_t maxRows, uint64_t maxBytes)
+      : op_(op), maxRows_(maxRows), maxBytes_(maxBytes) {}
+
+  /// Adds 'input' produced by the operator. 'inputBytes' is the estimated
+  /// flat size of 'input' or zero if not known. Returns the batch to hand to
+  /// the next operator or nullptr if 'input' has been buffered.
+  RowVectorPtr add(RowVectorPtr input, uint64_t inputBytes);
+
+  /// Returns the buffered batches as a single vector or nullptr if there are
+  /// none.
+  RowVectorPtr flush();
+
+  /// Returns true if there is a batch that must be handed to the next
+  /// operator before asking the operator for more output. This is a batch
+  /// that arrived behind buffered ones and could not be merged with them.
+  bool hasReady() const {
+    return ready_ != nullptr;
+  }
+
+  RowVectorPtr takeReady() {
+    return std::move(ready_);
+  }
+
+  /// Returns true if there are buffered batches not yet returned by flush().
+  bool hasPending() const {
+    return !pending_.empty();
+  }
+
+ private:
+  bool isSmall(const RowVectorPtr& input, uint64_t inputBytes) const;
+
+  Operator* const op_;
+  const vector_size_t maxRows_;
+  const uint64_t maxBytes_;
+
+  std::vector<RowVectorPtr> pending_;
+  vector_size_t pendingRows_{0};
+  uint64_t pendingBytes_{0};
+  RowVectorPtr ready_;
+};
+
+} // namespace facebook::velox::exec
@@ -224,11 +224,15 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
         queryCtx_->isExecutorSupplied(),
         "Executor should be set in parallel task cursor");
 
-    queue_ =
-        std::make_shared<TaskQueue>(params.bufferedBytes, params.outputPool);
+    VELOX_CHECK_GE(params.numConsumers, 1);
+    std::vector<std::weak_ptr<TaskQueue>> queueHolders;
+    for (auto i = 0; i < params.numConsumers; ++i) {
+      queues_.push_back(
+          std::make_shared<TaskQueue>(params.bufferedBytes, params.outputPool));
+      // Captured as a shared_ptr by the consumer callbacks of task_.
+      queueHolders.push_back(queues_.back());
+    }
 
-    // Captured as a shared_ptr by the consumer callback of task_.
-    auto queueHolder = std::weak_ptr(queue_);
     std::optional<common::SpillDiskOptions> spillDiskOpts;
     if (!taskSpillDirectory_.empty()) {
       spillDiskOpts = common::SpillDiskOptions{
@@ -236,53 +240,64 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
           .spillDirCreated = taskSpillDirectoryCb_ == nullptr,
           .spillDirCreateCb = taskSpillDirectoryCb_};
     }
+    // Each output driver gets the consumer of the next queue.
+    ConsumerSupplier consumerSupplier =
+        [queueHolders,
+         nextQueue = std::make_shared<std::atomic<int32_t>>(0),
+         copyResult = params.copyResult,
+         taskId = taskId_]() -> Consumer {
+      auto queueHolder = queueHolders[(*nextQueue)++ % queueHolders.size()];
+      return [queueHolder, copyResult, taskId](
+                 const RowVectorPtr& vector,
+                 bool drained,
+                 velox::ContinueFuture* future) {
+        auto queue = queueHolder.lock();
+        if (queue == nullptr) {
+          LOG(ERROR) << "TaskQueue has been destroyed, taskId: " << taskId;
+          return exec::BlockingReason::kNotBlocked;
+        }
+        VELOX_CHECK(!drained, "Unexpected drain in multithreaded task cursor");
+        if (!vector || !copyResult) {
+          return queue->enqueue(vector, future);
+        }
+        // Make sure to load lazy vector if not loaded already.
+        for (auto& child : vector->children()) {
+          child->loadedVector();
+        }
+        auto copy = BaseVector::create<RowVector>(
+            vector->type(), vector->size(), queue->pool());
+        copy->copy(vector.get(), 0, 0, vector->size());
+        return queue->enqueue(std::move(copy), future);
+      };
+    };
     task_ = Task::create(
         taskId_,
         std::move(planFragment_),
         params.destination,
         std::move(queryCtx_),
         Task::ExecutionMode::kParallel,
-        // consumer
-        [queueHolder, copyResult = params.copyResult, taskId = taskId_](
-            const RowVectorPtr& vector,
-            bool drained,
-            velox::ContinueFuture* future) {
-          auto queue = queueHolder.lock();
-          if (queue == nullptr) {
-            LOG(ERROR) << "TaskQueue has been destroyed, taskId: " << taskId;
-            return exec::BlockingReason::kNotBlocked;
-          }
-          VELOX_CHECK(
-              !drained, "Unexpected drain in multithreaded task cursor");
-          if (!vector || !copyResult) {
-            return queue->enqueue(vector, future);
-          }
-          // Make sure to load lazy vector if not loaded already.
-          for (auto& child : vector->children()) {
-            child->loadedVector();
-          }
-          auto copy = BaseVector::create<RowVector>(
-              vector->type(), vector->size(), queue->pool());
-          copy->copy(vector.get(), 0, 0, vector->size());
-          return queue->enqueue(std::move(copy), future);
-        },
+        std::move(consumerSupplier),
         0,
         std::move(spillDiskOpts),
-        [queueHolder, taskId = taskId_](std::exception_ptr) {
-          // onError close the queue to unblock producers and consumers.
+        [queueHolders, taskId = taskId_](std::exception_ptr) {
+          // onError close the queues to unblock producers and consumers.
           // moveNext will handle rethrowing the error once it's
           // unblocked.
-          auto queue = queueHolder.lock();
-          if (queue == nullptr) {
-            LOG(ERROR) << "TaskQueue has been destroyed, taskId: " << taskId;
-            return;
+          for (const auto& queueHolder : queueHolders) {
+            auto queue = queueHolder.lock();
+            if (queue == nullptr) {
+              LOG(ERROR) << "TaskQueue has been destroyed, taskId: " << taskId;
+              continue;
+            }
+            queue->close();
           }
-          queue->close();
         });
   }
 
   ~MultiThreadedTaskCursor() override {
-    queue_->close();
+    for (auto& queue : queues_) {
+      queue->close();
+    }
     if (task_ && !atEnd_) {
       task_->requestCancel();
     }
@@ -294,7 +309,15 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
       started_ = true;
       try {
         task_->start(maxDrivers_, numConcurrentSplitGroups_);
-        queue_->setNumProducers(numSplitGroups_ * task_->numOutputDrivers());
+        // The output drivers of all split groups are assigned to the queues
+        // round-robin in the order of their creation.
+        const int32_t numProducers =
+            numSplitGroups_ * task_->numOutputDrivers();
+        const int32_t numQueues = queues_.size();
+        for (auto i = 0; i < numQueues; ++i) {
+          queues_[i]->setNumProducers(
+              numProducers / numQueues + (i < numProducers % numQueues));
+        }
       } catch (const VeloxException& e) {
         // Could not find output pipeline, due to Task terminated before
         // start. Do not override the error.
@@ -309,20 +332,37 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
   /// Fetches another batch from the task queue.
   /// Starts the task if not started yet.
   bool moveNext() override {
+    VELOX_CHECK_EQ(
+        queues_.size(), 1, "Use next(consumer) with multiple consumers");
     start();
+    current_ = next(0);
+    if (!current_) {
+      atEnd_ = true;
+    }
+    return current_ != nullptr;
+  }
+
+  int32_t numConsumers() const override {
+    return queues_.size();
+  }
+
+  RowVectorPtr next(int32_t consumer) override {
+    VELOX_CHECK_LT(consumer, queues_.size());
+    if (queues_.size() > 1) {
+      VELOX_CHECK(started_, "start() must be called before next(consumer)");
+    } else {
+      start();
+    }
     if (error_) {
       std::rethrow_exception(error_);
     }
 
     // Task might be aborted before start.
     checkTaskError();
-    current_ = queue_->dequeue();
+    auto vector = queues_[consumer]->dequeue();
 
     checkTaskError();
-    if (!current_) {
-      atEnd_ = true;
-    }
-    return current_ != nullptr;
+    return vector;
   }
 
   void setNoMoreSplits() override {
@@ -335,7 +375,12 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
   }
 
   bool hasNext() override {
-    return queue_->hasNext();
+    for (auto& queue : queues_) {
+      if (queue->hasNext()) {
+        return true;
+      }
+    }
+    return false;
   }
 
   RowVectorPtr& current() override {
@@ -375,7 +420,8 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
   const int32_t numSplitGroups_;
 
   bool started_{false};
-  std::shared_ptr<TaskQueue> queue_;
+  // One queue per consumer stream.
+  std::vector<std::shared_ptr<TaskQueue>> queues_;
   std::shared_ptr<exec::Task> task_;
   RowVectorPtr current_;
   bool atEnd_{false};
@@ -388,6 +434,7 @@ class SingleThreadedTaskCursor : public TaskCursorBase {
   explicit SingleThreadedTaskCursor(const CursorParameters& params)
       : TaskCursorBase(params, nullptr) {
     VELOX_CHECK(params.serialExecution);
+    VELOX_CHECK_EQ(params.numConsumers, 1);
     VELOX_CHECK(
         !queryCtx_->isExecutorSupplied(),
         "Executor should not be set in serial task cursor");
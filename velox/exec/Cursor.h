@@ -85,6 +85,13 @@ struct CursorParameters {
 
   bool barrierExecution = false;
 
+  /// Number of independent result streams of a parallel cursor. The output
+  /// drivers are assigned to the streams round-robin and each stream returns
+  /// the batches of its drivers, so that the streams can be consumed by
+  /// different threads, e.g. to write the results to several files in
+  /// parallel. Must be 1 for serial execution.
+  int32_t numConsumers{1};
+
   /// If both 'queryConfigs' and 'queryCtx' are specified, the configurations
   /// in 'queryCtx' will be overridden by 'queryConfig'.
   std::unordered_map<std::string, std::string> queryConfigs;
@@ -163,6 +170,19 @@ class TaskCursor {
 
   virtual RowVectorPtr& current() = 0;
 
+  /// Returns the number of result streams. See CursorParameters::numConsumers.
+  virtual int32_t numConsumers() const {
+    return 1;
+  }
+
+  /// Returns the next batch of the result stream 'consumer' or nullptr if the
+  /// stream is at end. Different streams may be consumed concurrently, one
+  /// thread per stream, after start().
+  virtual RowVectorPtr next(int32_t consumer) {
+    VELOX_CHECK_EQ(consumer, 0);
+    return moveNext() ? current() : nullptr;
+  }
+
   virtual void setError(std::exception_ptr error) = 0;
 
   virtual bool noMoreSplits() const = 0;
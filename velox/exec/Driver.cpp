@@ -16,7 +16,13 @@
 
 #include "velox/exec/Driver.h"
 
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/process/PerfCounters.h"
+#include "velox/common/process/PerfettoTrace.h"
+#include "velox/common/process/SamplingProfiler.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/exec/FairShareExecutor.h"
 #include "velox/exec/Task.h"
 #include "velox/vector/LazyVector.h"
 
@@ -48,6 +54,19 @@ void recordSilentThrows(Operator& op) {
   }
 }
 
+void addPerfCounts(Operator& op, const process::PerfCounts& counts) {
+  op.stats().withWLock([&](auto& lockedStats) {
+    lockedStats.addRuntimeStat(
+        Operator::kPerfInstructions, RuntimeCounter(counts.instructions));
+    lockedStats.addRuntimeStat(
+        Operator::kPerfCycles, RuntimeCounter(counts.cycles));
+    lockedStats.addRuntimeStat(
+        Operator::kPerfCacheMisses, RuntimeCounter(counts.cacheMisses));
+    lockedStats.addRuntimeStat(
+        Operator::kPerfBranchMisses, RuntimeCounter(counts.branchMisses));
+  });
+}
+
 // Used to generate context for exceptions that are thrown while executing an
 // operator. Eg output: 'Operator: FilterProject(1) PlanNodeId: 1 TaskId:
 // test_cursor_1 PipelineId: 0 DriverId: 0 OperatorAddress: 0x61a000003c80'
@@ -120,6 +139,12 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this]() -> std::string_view {
     return task->getOrCreateSpillDirectory();
   };
+  common::GetSpillDirectoryPathCB getSpillOverflowDirPathCb;
+  if (!task->spillOverflowDirectory().empty()) {
+    getSpillOverflowDirPathCb = [this]() -> std::string_view {
+      return task->getOrCreateSpillOverflowDirectory();
+    };
+  }
   const auto& spillFilePrefix =
       fmt::format("{}_{}_{}", pipelineId, driverId, operatorId);
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb =
@@ -147,7 +172,11 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
           ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
           : std::nullopt,
       queryConfig.spillFileCreateConfig(),
-      queryConfig.windowSpillMinReadBatchRows());
+      queryConfig.windowSpillMinReadBatchRows(),
+      queryConfig.spillFileFormat(),
+      queryConfig.spillAsyncWriteEnabled(),
+      queryConfig.spillSortMergePartitionBits(),
+      std::move(getSpillOverflowDirPathCb));
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -168,6 +197,14 @@ BlockingState::BlockingState(
   // Set before leaving the thread.
   driver_->state().hasBlockingFuture = true;
   numBlockedDrivers_++;
+  VELOX_TRACE_BEGIN(
+      "velox.driver",
+      std::string(BlockingReasonName::toName(reason_)),
+      perfetto::Track(driver_->perfettoTrackId()),
+      "operator",
+      operator_->operatorType(),
+      "planNodeId",
+      operator_->planNodeId());
 }
 
 // static
@@ -180,6 +217,8 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         auto& driver = state->driver_;
         auto& task = driver->task();
 
+        VELOX_TRACE_END(
+            "velox.driver", perfetto::Track(driver->perfettoTrackId()));
         std::lock_guard<std::timed_mutex> l(task->mutex());
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(state->sinceUs_, state->reason_);
@@ -242,8 +281,16 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* queryCtx = driver->task()->queryCtx().get();
+  auto* executor = queryCtx->executor();
+  if (auto* fairShareExecutor = dynamic_cast<FairShareExecutor*>(executor)) {
+    fairShareExecutor->add(
+        queryCtx->queryId(),
+        queryCtx->queryConfig().querySchedulingPriority(),
+        [driver]() { Driver::run(driver); });
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -258,6 +305,24 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorPerfCounters_ =
+      ctx_->queryConfig().operatorTrackPerfCounters();
+  if (process::perfettoTraceSupported() &&
+      !ctx_->queryConfig().perfettoTraceDir().empty()) {
+    perfettoTrackId_ = process::registerPerfettoTrack(
+        reinterpret_cast<uintptr_t>(this),
+        fmt::format(
+            "{} pipeline {} driver {}",
+            ctx_->task->taskId(),
+            ctx_->pipelineId,
+            ctx_->driverId));
+  }
+}
+
+Driver::~Driver() {
+  if (perfettoTrackId_ != 0) {
+    process::unregisterPerfettoTrack(perfettoTrackId_);
+  }
 }
 
 void Driver::initializeOperators() {
@@ -268,6 +333,22 @@ void Driver::initializeOperators() {
   for (auto& op : operators_) {
     op->initialize();
   }
+
+  // Output coalescing is not used in serial execution mode, the only mode
+  // supporting barriers, as draining requires the output of each operator to
+  // be handed downstream before the next operator starts draining.
+  const auto& queryConfig = ctx_->queryConfig();
+  if (queryConfig.coalesceOperatorOutputBatches() &&
+      task()->executionMode() == Task::ExecutionMode::kParallel) {
+    outputCoalescers_.reserve(operators_.size() - 1);
+    for (auto i = 0; i < operators_.size() - 1; ++i) {
+      outputCoalescers_.push_back(
+          std::make_unique<BatchCoalescer>(
+              operators_[i].get(),
+              queryConfig.preferredOutputBatchRows(),
+              queryConfig.preferredOutputBatchBytes()));
+    }
+  }
 }
 
 RowVectorPtr Driver::next(
@@ -324,6 +405,15 @@ void Driver::enqueueInternal() {
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
+    VELOX_TRACE_SCOPED(                                                    \
+        "velox.driver",                                                    \
+        operatorMethod,                                                    \
+        "operator",                                                        \
+        operatorPtr->operatorType(),                                       \
+        "planNodeId",                                                      \
+        operatorPtr->planNodeId());                                        \
+    process::SamplingProfiler::ScopedOperator samplingOperator(            \
+        operatorPtr->operatorType(), operatorPtr->planNodeId());           \
     ExceptionContextSetter exceptionContext(                               \
         {addContextOnException, operatorPtr, true});                       \
     auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
@@ -504,6 +594,65 @@ StopReason Driver::runInternal(
     const int32_t numOperators = operators_.size();
     ContinueFuture future = ContinueFuture::makeEmpty();
 
+    auto batchBytes = [&](const RowVectorPtr& batch) -> uint64_t {
+      return enableOperatorBatchSizeStats() ? batch->estimateFlatSize() : 0;
+    };
+
+    // Hands 'input' produced by the operator at 'opId' to the next operator.
+    auto addInputToNext = [&](int32_t opId,
+                              const RowVectorPtr& input,
+                              uint64_t inputBytes) {
+      Operator* nextOp = operators_[opId + 1].get();
+      withDeltaCpuWallTimer(nextOp, &OperatorStats::addInputTiming, [&]() {
+        {
+          auto lockedStats = nextOp->stats().wlock();
+          lockedStats->addInputVector(inputBytes, input->size());
+        }
+
+        nextOp->traceInput(input);
+        TestValue::adjust(
+            "facebook::velox::exec::Driver::runInternal::addInput", nextOp);
+
+        CALL_OPERATOR(
+            addInput(nextOp, input), nextOp, opId + 1, kOpMethodAddInput);
+      });
+    };
+
+    // Hands the batches buffered by the output coalescers of the operators at
+    // or after 'blockedOpId' to the next operators before the driver goes off
+    // thread, so that coalescing never holds back data behind a blocked
+    // operator. The next operators were not blocked when the batches were
+    // buffered and have received no input since.
+    auto flushOutputCoalescers = [&](int32_t blockedOpId) {
+      if (outputCoalescers_.empty()) {
+        return;
+      }
+      for (auto j = blockedOpId; j < numOperators - 1; ++j) {
+        auto* coalescer = outputCoalescers_[j].get();
+        if (!coalescer->hasReady() && !coalescer->hasPending()) {
+          continue;
+        }
+        Operator* nextOp = operators_[j + 1].get();
+        bool needsInput;
+        CALL_OPERATOR(
+            needsInput = nextOp->needsInput(),
+            nextOp,
+            j + 1,
+            kOpMethodNeedsInput);
+        if (!needsInput) {
+          continue;
+        }
+        RowVectorPtr batch;
+        CALL_OPERATOR(
+            batch = coalescer->hasReady() ? coalescer->takeReady()
+                                          : coalescer->flush(),
+            operators_[j].get(),
+            j,
+            kOpMethodGetOutput);
+        addInputToNext(j, batch, batchBytes(batch));
+      }
+    };
+
     for (;;) {
       for (int32_t i = numOperators - 1; i >= 0; --i) {
         stop = task()->shouldStop();
@@ -547,6 +696,7 @@ StopReason Driver::runInternal(
               kOpMethodIsBlocked);
         });
         if (blockingReason_ != BlockingReason::kNotBlocked) {
+          flushOutputCoalescers(i);
           return blockDriver(self, i, std::move(future), blockingState, guard);
         }
 
@@ -561,6 +711,7 @@ StopReason Driver::runInternal(
                 kOpMethodIsBlocked);
           });
           if (blockingReason_ != BlockingReason::kNotBlocked) {
+            flushOutputCoalescers(i + 1);
             return blockDriver(
                 self, i + 1, std::move(future), blockingState, guard);
           }
@@ -575,49 +726,60 @@ StopReason Driver::runInternal(
           if (needsInput) {
             uint64_t resultBytes = 0;
             RowVectorPtr intermediateResult;
-
-            withDeltaCpuWallTimer(op, &OperatorStats::getOutputTiming, [&]() {
-              TestValue::adjust(
-                  "facebook::velox::exec::Driver::runInternal::getOutput", op);
-              CALL_OPERATOR(
-                  getOutput(op, intermediateResult),
-                  op,
-                  curOperatorId_,
-                  kOpMethodGetOutput);
-              if (intermediateResult) {
-                validateOperatorOutputResult(intermediateResult, *op);
-                if (enableOperatorBatchSizeStats()) {
-                  resultBytes = intermediateResult->estimateFlatSize();
+            auto* coalescer = outputCoalescers_.empty()
+                ? nullptr
+                : outputCoalescers_[i].get();
+            // Set if 'op' produced a batch that has been buffered to be
+            // coalesced with the next ones.
+            bool coalesced{false};
+
+            if (coalescer != nullptr && coalescer->hasReady()) {
+              intermediateResult = coalescer->takeReady();
+              resultBytes = batchBytes(intermediateResult);
+            } else {
+              withDeltaCpuWallTimer(op, &OperatorStats::getOutputTiming, [&]() {
+                TestValue::adjust(
+                    "facebook::velox::exec::Driver::runInternal::getOutput",
+                    op);
+                CALL_OPERATOR(
+                    getOutput(op, intermediateResult),
+                    op,
+                    curOperatorId_,
+                    kOpMethodGetOutput);
+                if (intermediateResult) {
+                  validateOperatorOutputResult(intermediateResult, *op);
+                  resultBytes = batchBytes(intermediateResult);
+                  {
+                    auto lockedStats = op->stats().wlock();
+                    lockedStats->addOutputVector(
+                        resultBytes, intermediateResult->size());
+                  }
+                  if (coalescer != nullptr) {
+                    const auto* produced = intermediateResult.get();
+                    CALL_OPERATOR(
+                        intermediateResult = coalescer->add(
+                            std::move(intermediateResult), resultBytes),
+                        op,
+                        curOperatorId_,
+                        kOpMethodGetOutput);
+                    coalesced = intermediateResult == nullptr;
+                    if (!coalesced && intermediateResult.get() != produced) {
+                      resultBytes = batchBytes(intermediateResult);
+                    }
+                  }
                 }
-                auto lockedStats = op->stats().wlock();
-                lockedStats->addOutputVector(
-                    resultBytes, intermediateResult->size());
-              }
-            });
+              });
+            }
             if (intermediateResult) {
-              withDeltaCpuWallTimer(
-                  nextOp, &OperatorStats::addInputTiming, [&]() {
-                    {
-                      auto lockedStats = nextOp->stats().wlock();
-                      lockedStats->addInputVector(
-                          resultBytes, intermediateResult->size());
-                    }
-
-                    nextOp->traceInput(intermediateResult);
-                    TestValue::adjust(
-                        "facebook::velox::exec::Driver::runInternal::addInput",
-                        nextOp);
-
-                    CALL_OPERATOR(
-                        addInput(nextOp, intermediateResult),
-                        nextOp,
-                        curOperatorId_ + 1,
-                        kOpMethodAddInput);
-                  });
+              addInputToNext(i, intermediateResult, resultBytes);
               // The next iteration will see if operators_[i + 1] has
               // output now that it got input.
               i += 2;
               continue;
+            } else if (coalesced) {
+              // Ask 'op' for more output to coalesce with the buffered batch.
+              ++i;
+              continue;
             } else {
               stop = task()->shouldStop();
               if (stop != StopReason::kNone) {
@@ -638,6 +800,7 @@ StopReason Driver::runInternal(
                     kOpMethodIsBlocked);
               });
               if (blockingReason_ != BlockingReason::kNotBlocked) {
+                flushOutputCoalescers(i);
                 return blockDriver(
                     self, i, std::move(future), blockingState, guard);
               }
@@ -650,6 +813,18 @@ StopReason Driver::runInternal(
                     curOperatorId_,
                     kOpMethodIsFinished);
               });
+              if (finished && coalescer != nullptr &&
+                  coalescer->hasPending()) {
+                RowVectorPtr batch;
+                CALL_OPERATOR(
+                    batch = coalescer->flush(),
+                    op,
+                    curOperatorId_,
+                    kOpMethodGetOutput);
+                addInputToNext(i, batch, batchBytes(batch));
+                i += 2;
+                continue;
+              }
               if (finished) {
                 withDeltaCpuWallTimer(
                     nextOp, &OperatorStats::finishTiming, [this, &nextOp]() {
@@ -737,6 +912,15 @@ void Driver::recordYieldCount() {
 // static
 void Driver::run(std::shared_ptr<Driver> self) {
   process::TraceContext trace("Driver::run");
+  VELOX_TRACE_SCOPED(
+      "velox.driver",
+      "Driver::run",
+      "task",
+      self->task()->taskId(),
+      "pipelineId",
+      self->driverCtx()->pipelineId,
+      "driverId",
+      self->driverCtx()->driverId);
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
@@ -798,6 +982,9 @@ void Driver::initializeOperatorStats(std::vector<OperatorStats>& stats) {
 }
 
 void Driver::closeOperators() {
+  // Release the buffered batches before the operator memory pools go away.
+  outputCoalescers_.clear();
+
   // Close operators.
   for (auto& op : operators_) {
     op->close();
@@ -1181,6 +1368,20 @@ void Driver::withDeltaCpuWallTimer(
     Operator* op,
     TimingMemberPtr opTimingMember,
     Func&& opFunction) {
+  // If 'trackOperatorPerfCounters_' is true, add the hardware counter deltas
+  // of the opFunction to the runtime stats of 'op'. Unlike the timing, these
+  // include the lazy loads triggered by 'op'.
+  auto* perfCounters = trackOperatorPerfCounters_
+      ? process::PerfCounters::threadCounters()
+      : nullptr;
+  const auto perfStart =
+      perfCounters != nullptr ? perfCounters->read() : process::PerfCounts{};
+  auto perfGuard = folly::makeGuard([&]() {
+    if (perfCounters != nullptr) {
+      addPerfCounts(*op, perfCounters->read() - perfStart);
+    }
+  });
+
   // If 'trackOperatorCpuUsage_' is true, create and initialize the timer object
   // to track cpu and wall time of the opFunction.
   if (!trackOperatorCpuUsage_) {
@@ -26,6 +26,7 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanFragment.h"
+#include "velox/exec/BatchCoalescer.h"
 #include "velox/exec/BlockingReason.h"
 #include "velox/exec/trace/TraceCtx.h"
 
@@ -261,7 +262,8 @@ struct DriverCtx {
     return common::PrefixSortConfig{
         queryConfig().prefixSortNormalizedKeyMaxBytes(),
         queryConfig().prefixSortMinRows(),
-        queryConfig().prefixSortMaxStringPrefixLength()};
+        queryConfig().prefixSortMaxStringPrefixLength(),
+        queryConfig().prefixSortMinRadixSortRows()};
   }
 };
 
@@ -338,6 +340,8 @@ using PipelinePushdownFilters =
 
 class Driver : public std::enable_shared_from_this<Driver> {
  public:
+  ~Driver();
+
   static void enqueue(std::shared_ptr<Driver> instance);
 
   /// Run the pipeline until it produces a batch of data or gets blocked.
@@ -464,6 +468,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return ctx_.get();
   }
 
+  /// Returns the id of the Perfetto track which shows the blocked intervals of
+  /// this driver, or 0 if the Perfetto trace is disabled.
+  uint64_t perfettoTrackId() const {
+    return perfettoTrackId_;
+  }
+
   const std::shared_ptr<Task>& task() const {
     return ctx_->task;
   }
@@ -629,6 +639,9 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   std::unique_ptr<DriverCtx> ctx_;
 
+  // See perfettoTrackId().
+  uint64_t perfettoTrackId_{0};
+
   // If set, the operator output batch size stats will be collected during
   // driver execution.
   bool enableOperatorBatchSizeStats_{false};
@@ -657,11 +670,19 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   std::vector<std::unique_ptr<Operator>> operators_;
 
+  // If 'coalesce_operator_output_batches' is enabled, accumulates the small
+  // output batches of operators_[i] for operators_[i + 1]. Empty otherwise.
+  std::vector<std::unique_ptr<BatchCoalescer>> outputCoalescers_;
+
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   size_t blockedOperatorId_{0};
 
   bool trackOperatorCpuUsage_;
 
+  // True if the hardware counters of operator calls are added to the runtime
+  // stats of the operators.
+  bool trackOperatorPerfCounters_{false};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -19,6 +19,7 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/serializers/CompactRowSerializer.h"
+#include "velox/serializers/StreamDictionarySerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -80,7 +81,15 @@ Exchange::Exchange(
           serdeKind_)},
       processSplits_{operatorCtx_->driverCtx()->driverId == 0},
       driverId_{driverCtx->driverId},
-      exchangeClient_{std::move(exchangeClient)} {}
+      exchangeClient_{std::move(exchangeClient)} {
+  if (serdeKind_ == VectorSerde::Kind::kStreamDictionary &&
+      exchangeClient_ != nullptr) {
+    // The drivers share the dictionaries that the exchange client registers.
+    checkedPointerCast<serializer::StreamDictionaryVectorSerde::
+                           StreamDictionaryOptions>(serdeOptions_.get())
+        ->dictionaries = exchangeClient_->streamDictionaries(outputType_);
+  }
+}
 
 void Exchange::addRemoteTaskIds(std::vector<std::string>& remoteTaskIds) {
   std::shuffle(std::begin(remoteTaskIds), std::end(remoteTaskIds), rng_);
@@ -203,6 +212,9 @@ RowVectorPtr Exchange::getOutputFromColumnarPages(VectorSerde* serde) {
   // Should be either starting fresh or continuing from a previous partial page
   VELOX_CHECK(
       inputStream_ == nullptr || columnarPageIdx_ < currentPages_.size());
+  // The serde deserializes into 'result_' in place if the consumer of the
+  // previous batch has released it.
+  recordOutputVectorReuse(result_ != nullptr && result_.use_count() == 1);
 
   // Iterate through pages
   while (columnarPageIdx_ < currentPages_.size()) {
@@ -238,8 +250,13 @@ RowVectorPtr Exchange::getOutputFromColumnarPages(VectorSerde* serde) {
       ++columnarPageIdx_;
     }
 
-    // Stop if accumulated enough rows for this batch.
-    if (resultOffset >= numRows) {
+    // Stop if accumulated enough rows for this batch. The pages of a stream
+    // dictionary exchange are not combined so that their dictionaries are
+    // kept without copy, nor are the pages of a string reference exchange so
+    // that their strings stay lazy.
+    if (resultOffset >= numRows ||
+        serdeKind_ == VectorSerde::Kind::kStreamDictionary ||
+        serdeKind_ == VectorSerde::Kind::kStringReference) {
       break;
     }
   }
@@ -285,6 +302,7 @@ RowVectorPtr Exchange::getOutputFromRowPages(VectorSerde* serde) {
         kInitialOutputRows);
   }
 
+  recordOutputVectorReuse(result_ != nullptr && result_.use_count() == 1);
   // Check if the serde supports batched deserialization
   serde->deserialize(
       inputStream_.get(),
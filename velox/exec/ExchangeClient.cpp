@@ -140,6 +140,14 @@ ExchangeClient::collectStatsLocked() const {
       "averageReceivedPageBytes",
       RuntimeMetric(
           queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes));
+  if (maxQueuedBytesLimit_ > minQueuedBytes_) {
+    stats.insert_or_assign(
+        "maxQueuedBytes",
+        RuntimeMetric(maxQueuedBytes_.load(), RuntimeCounter::Unit::kBytes));
+    stats.insert_or_assign("numBufferGrows", RuntimeMetric(numGrows_));
+    stats.insert_or_assign(
+        "numBufferShrinks", RuntimeMetric(numShrinks_.load()));
+  }
 
   return stats;
 }
@@ -162,6 +170,14 @@ std::vector<std::unique_ptr<SerializedPageBase>> ExchangeClient::next(
     *atEnd = false;
     pages = queue_->dequeueLocked(
         consumerId, maxBytes, atEnd, future, &stalePromise);
+    if (streamDictionaries_ != nullptr) {
+      // Registered under the queue lock so that the dictionaries of a page are
+      // known before any later page of the same stream is dequeued.
+      for (const auto& page : pages) {
+        streamDictionaries_->addDictionaries(
+            *page->getIOBuf(), streamDictionaryType_, pool_);
+      }
+    }
     if (*atEnd) {
       return pages;
     }
@@ -170,6 +186,9 @@ std::vector<std::unique_ptr<SerializedPageBase>> ExchangeClient::next(
       return pages;
     }
 
+    if (pages.empty()) {
+      maybeGrowLocked();
+    }
     requestSpecs = pickSourcesToRequestLocked();
   }
 
@@ -181,6 +200,16 @@ std::vector<std::unique_ptr<SerializedPageBase>> ExchangeClient::next(
   return pages;
 }
 
+std::shared_ptr<serializer::StreamDictionaryCache>
+ExchangeClient::streamDictionaries(const RowTypePtr& type) {
+  std::lock_guard<std::mutex> l(queue_->mutex());
+  if (streamDictionaries_ == nullptr) {
+    streamDictionaries_ = std::make_shared<serializer::StreamDictionaryCache>();
+    streamDictionaryType_ = type;
+  }
+  return streamDictionaries_;
+}
+
 void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   auto self = shared_from_this();
   for (auto& spec : requestSpecs) {
@@ -302,7 +331,7 @@ ExchangeClient::pickSourcesToRequestLocked() {
     auto& source = producingSources_.front().source;
     auto requestBytes = producingSources_.front().remainingBytes.at(0);
     LOG(INFO) << "Requesting large single page " << requestBytes
-              << " bytes, exceeding capacity " << maxQueuedBytes_;
+              << " bytes, exceeding capacity " << maxQueuedBytes_.load();
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
     producingSources_.pop();
@@ -348,6 +377,66 @@ ExchangeClient::pickupSingleSourceToRequestLocked() {
   return requestSpecs;
 }
 
+void ExchangeClient::maybeGrowLocked() {
+  const int64_t capacity = maxQueuedBytes_;
+  if (closed_ || capacity >= maxQueuedBytesLimit_ ||
+      producingSources_.empty()) {
+    return;
+  }
+  const auto* root = pool_->root();
+  if (root->reservedBytes() > root->capacity() * kMaxGrowthReservedRatio) {
+    return;
+  }
+  maxQueuedBytes_ = std::min(capacity * 2, maxQueuedBytesLimit_);
+  ++numGrows_;
+}
+
+int64_t ExchangeClient::shrink() {
+  const auto capacity = maxQueuedBytes_.exchange(minQueuedBytes_);
+  if (capacity == minQueuedBytes_) {
+    return 0;
+  }
+  ++numShrinks_;
+  return capacity - minQueuedBytes_;
+}
+
+int64_t ExchangeClient::reclaimableBytes() const {
+  if (maxQueuedBytes_ == minQueuedBytes_) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> l(queue_->mutex());
+  return std::max<int64_t>(0, queue_->totalBytes() - minQueuedBytes_);
+}
+
+// static
+std::unique_ptr<ExchangeClient::MemoryReclaimer>
+ExchangeClient::MemoryReclaimer::create() {
+  return std::unique_ptr<MemoryReclaimer>(new MemoryReclaimer());
+}
+
+bool ExchangeClient::MemoryReclaimer::reclaimableBytes(
+    const memory::MemoryPool& /*pool*/,
+    uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  auto client = client_.rlock()->lock();
+  if (client == nullptr) {
+    return false;
+  }
+  reclaimableBytes = client->reclaimableBytes();
+  return true;
+}
+
+uint64_t ExchangeClient::MemoryReclaimer::reclaim(
+    memory::MemoryPool* /*pool*/,
+    uint64_t /*targetBytes*/,
+    uint64_t /*maxWaitMs*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  if (auto client = client_.rlock()->lock()) {
+    client->shrink();
+  }
+  return 0;
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
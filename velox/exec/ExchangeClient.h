@@ -17,6 +17,8 @@
 
 #include "velox/exec/ExchangeQueue.h"
 #include "velox/exec/ExchangeSource.h"
+#include "velox/exec/MemoryReclaimer.h"
+#include "velox/serializers/StreamDictionarySerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -27,6 +29,15 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   static constexpr int32_t kDefaultMaxQueuedBytes = 32 << 20; // 32 MB.
   static constexpr std::chrono::milliseconds kRequestDataMaxWait{100};
 
+  /// The buffer only grows while the root memory pool of the client has
+  /// reserved less than this fraction of its capacity.
+  static constexpr double kMaxGrowthReservedRatio = 0.5;
+
+  /// If 'maxQueuedBytesLimit' is greater than 'maxQueuedBytes', the buffer
+  /// starts at 'maxQueuedBytes' and doubles, up to 'maxQueuedBytesLimit', each
+  /// time a consumer finds it empty while some sources have data that does not
+  /// fit, as long as the memory pressure is low. The MemoryReclaimer of the
+  /// pool shrinks it back to 'maxQueuedBytes' under memory arbitration.
   ExchangeClient(
       std::string taskId,
       int destination,
@@ -37,9 +48,12 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
       folly::Executor* executor,
       int32_t requestDataSizesMaxWaitSec = 10,
       bool skipRequestDataSizeWithSingleSource = false,
-      bool lazyFetching = false)
+      bool lazyFetching = false,
+      int64_t maxQueuedBytesLimit = 0)
       : taskId_{std::move(taskId)},
         destination_(destination),
+        minQueuedBytes_{maxQueuedBytes},
+        maxQueuedBytesLimit_{std::max(maxQueuedBytes, maxQueuedBytesLimit)},
         maxQueuedBytes_{maxQueuedBytes},
         requestDataSizesMaxWaitSec_{requestDataSizesMaxWaitSec},
         pool_(pool),
@@ -110,6 +124,14 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::vector<std::unique_ptr<SerializedPageBase>>
   next(int consumerId, uint32_t maxBytes, bool* atEnd, ContinueFuture* future);
 
+  /// Returns the dictionaries of the pages of a
+  /// VectorSerde::Kind::kStreamDictionary exchange of 'type'. Once called,
+  /// next() registers the dictionaries of each page as it is dequeued, so
+  /// that the consumers can deserialize the pages that reference the
+  /// dictionaries of the pages dequeued by other consumers.
+  std::shared_ptr<serializer::StreamDictionaryCache> streamDictionaries(
+      const RowTypePtr& type);
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
@@ -122,6 +144,53 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
     return remoteTaskIds_;
   }
 
+  /// Returns the current capacity of the buffer.
+  int64_t maxQueuedBytes() const {
+    return maxQueuedBytes_;
+  }
+
+  /// Shrinks the buffer back to its initial capacity. The client does not
+  /// request more data, and so pauses the sources, until the consumers drain
+  /// the queue below the capacity. Returns the number of bytes the capacity
+  /// shrank by.
+  int64_t shrink();
+
+  /// Returns the queued bytes above the initial capacity of a grown buffer.
+  /// These are released once shrink() has stopped the queue from refilling
+  /// and the consumers process them.
+  int64_t reclaimableBytes() const;
+
+  /// Memory reclaimer of the pool of a client with a growable buffer. It
+  /// reports the queued bytes above the initial capacity as reclaimable so
+  /// that arbitration picks the client, and reclaim shrinks the buffer. The
+  /// queued pages cannot be dropped, so the memory is released as the
+  /// consumers process them.
+  class MemoryReclaimer : public exec::MemoryReclaimer {
+   public:
+    static std::unique_ptr<MemoryReclaimer> create();
+
+    /// Sets the client whose buffer to shrink. The client is created after
+    /// its pool.
+    void setClient(const std::shared_ptr<ExchangeClient>& client) {
+      *client_.wlock() = client;
+    }
+
+    bool reclaimableBytes(
+        const memory::MemoryPool& pool,
+        uint64_t& reclaimableBytes) const override;
+
+    uint64_t reclaim(
+        memory::MemoryPool* pool,
+        uint64_t targetBytes,
+        uint64_t maxWaitMs,
+        memory::MemoryReclaimer::Stats& stats) override;
+
+   private:
+    MemoryReclaimer() : exec::MemoryReclaimer(0) {}
+
+    folly::Synchronized<std::weak_ptr<ExchangeClient>> client_;
+  };
+
  private:
   struct RequestSpec {
     std::shared_ptr<ExchangeSource> source;
@@ -156,6 +225,10 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // capacity is unavailable or requests are already pending, returns empty
   // vector.
   std::vector<RequestSpec> pickupSingleSourceToRequestLocked();
+
+  // Doubles the buffer capacity if it is below 'maxQueuedBytesLimit_', some
+  // sources have data that does not fit and the memory pressure is low.
+  void maybeGrowLocked();
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   /// Returns true if skip request data size optimization is enabled for single
@@ -170,7 +243,16 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
-  const int64_t maxQueuedBytes_;
+  // The initial capacity of the buffer.
+  const int64_t minQueuedBytes_;
+  // The max capacity of the buffer.
+  const int64_t maxQueuedBytesLimit_;
+  // The current capacity of the buffer. Updated under the queue lock, except
+  // by shrink() which may run from memory arbitration.
+  std::atomic<int64_t> maxQueuedBytes_;
+  // Number of times the buffer grew and shrank.
+  int32_t numGrows_{0};
+  std::atomic<int32_t> numShrinks_{0};
   const std::chrono::seconds requestDataSizesMaxWaitSec_;
 
   memory::MemoryPool* const pool_;
@@ -199,6 +281,10 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // Total number of bytes in flight.
   int64_t totalPendingBytes_{0};
 
+  // Set by streamDictionaries().
+  std::shared_ptr<serializer::StreamDictionaryCache> streamDictionaries_;
+  RowTypePtr streamDictionaryType_;
+
   // A queue of sources that have returned non-empty response from the latest
   // request.
   std::queue<ProducingSource> producingSources_;
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/FairShareExecutor.h"
+
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/ProcessBase.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+namespace {
+std::vector<uint64_t> makeLevelThresholds(
+    const FairShareExecutor::Options& options) {
+  VELOX_CHECK_GT(options.numLevels, 0);
+  VELOX_CHECK_GT(options.levelTimeMultiplier, 0);
+  std::vector<uint64_t> thresholds;
+  uint64_t threshold = options.level0ThresholdMs * 1'000'000;
+  for (auto level = 0; level < options.numLevels - 1; ++level) {
+    thresholds.push_back(threshold);
+    threshold *= options.levelTimeMultiplier;
+  }
+  return thresholds;
+}
+} // namespace
+
+FairShareExecutor::FairShareExecutor(
+    folly::Executor* executor,
+    const Options& options)
+    : executor_(executor),
+      options_(options),
+      levelThresholdNanos_(makeLevelThresholds(options_)),
+      levels_(options_.numLevels),
+      levelUsage_(options_.numLevels, 0),
+      levelCpuNanos_(options_.numLevels, 0) {
+  VELOX_CHECK_NOT_NULL(executor_);
+}
+
+void FairShareExecutor::add(folly::Func func) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    unowned_.push_back(std::move(func));
+  }
+  executor_->add([this]() { runNext(); });
+}
+
+void FairShareExecutor::add(
+    const std::string& queryId,
+    int32_t priority,
+    folly::Func func) {
+  const auto nowMs = getCurrentTimeMs();
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    expireQueriesLocked(nowMs);
+    auto& query = queries_[queryId];
+    if (query.lastRunMs == 0) {
+      query.lastRunMs = nowMs;
+    }
+    query.priority = priority;
+    query.pending.push_back(std::move(func));
+    if (!query.queued) {
+      scheduleLocked(&query);
+    }
+  }
+  executor_->add([this]() { runNext(); });
+}
+
+int32_t FairShareExecutor::levelLocked(const Query& query) const {
+  int32_t level = 0;
+  while (level < levelThresholdNanos_.size() &&
+         query.cpuNanos >= levelThresholdNanos_[level]) {
+    ++level;
+  }
+  return std::clamp<int32_t>(
+      level + query.priority, 0, options_.numLevels - 1);
+}
+
+void FairShareExecutor::scheduleLocked(Query* query) {
+  VELOX_CHECK(!query->queued);
+  const auto level = levelLocked(*query);
+  if (levels_[level].empty()) {
+    // A level that was idle does not get the CPU time it did not use. The
+    // shares restart when all levels were idle.
+    const auto next = nextLevelLocked();
+    if (next >= 0) {
+      levelUsage_[level] = std::max(levelUsage_[level], levelUsage_[next]);
+    } else {
+      std::fill(levelUsage_.begin(), levelUsage_.end(), 0);
+    }
+  }
+  levels_[level].push_back(query);
+  query->queued = true;
+}
+
+int32_t FairShareExecutor::nextLevelLocked() const {
+  int32_t next = -1;
+  for (auto level = 0; level < options_.numLevels; ++level) {
+    if (!levels_[level].empty() &&
+        (next < 0 || levelUsage_[level] < levelUsage_[next])) {
+      next = level;
+    }
+  }
+  return next;
+}
+
+folly::Func FairShareExecutor::takeNextLocked(int32_t& level, Query*& query) {
+  if (!unowned_.empty()) {
+    auto func = std::move(unowned_.front());
+    unowned_.pop_front();
+    level = 0;
+    query = nullptr;
+    return func;
+  }
+  for (;;) {
+    level = nextLevelLocked();
+    // There is one run per pending function.
+    VELOX_CHECK_GE(level, 0);
+    query = levels_[level].front();
+    levels_[level].pop_front();
+    query->queued = false;
+    if (levelLocked(*query) != level) {
+      // The query changed level since it was queued.
+      scheduleLocked(query);
+      continue;
+    }
+    auto func = std::move(query->pending.front());
+    query->pending.pop_front();
+    ++query->numRunning;
+    if (!query->pending.empty()) {
+      scheduleLocked(query);
+    }
+    return func;
+  }
+}
+
+void FairShareExecutor::runNext() {
+  int32_t level;
+  Query* query;
+  folly::Func func;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    func = takeNextLocked(level, query);
+  }
+  const auto startCpuNanos = process::threadCpuNanos();
+  try {
+    func();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Exception in FairShareExecutor: " << e.what();
+  }
+  func = nullptr;
+  const auto cpuNanos = process::threadCpuNanos() - startCpuNanos;
+
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numRuns_;
+  levelCpuNanos_[level] += cpuNanos;
+  if (query == nullptr) {
+    return;
+  }
+  levelUsage_[level] +=
+      static_cast<double>(cpuNanos) * (1UL << level) / 1'000'000;
+  query->cpuNanos += cpuNanos;
+  query->lastRunMs = getCurrentTimeMs();
+  --query->numRunning;
+}
+
+void FairShareExecutor::expireQueriesLocked(uint64_t nowMs) {
+  if (nowMs < lastExpirationMs_ + options_.queryExpirationMs) {
+    return;
+  }
+  lastExpirationMs_ = nowMs;
+  for (auto it = queries_.begin(); it != queries_.end();) {
+    const auto& query = it->second;
+    if (query.pending.empty() && query.numRunning == 0 &&
+        nowMs >= query.lastRunMs + options_.queryExpirationMs) {
+      it = queries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+int32_t FairShareExecutor::queryLevel(const std::string& queryId) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto it = queries_.find(queryId);
+  if (it == queries_.end()) {
+    return 0;
+  }
+  return levelLocked(it->second);
+}
+
+FairShareExecutor::Stats FairShareExecutor::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numRuns = numRuns_;
+  stats.numQueries = queries_.size();
+  stats.levelCpuNanos = levelCpuNanos_;
+  return stats;
+}
+
+} // namespace facebook::velox::exec
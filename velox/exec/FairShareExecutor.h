@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <folly/Executor.h>
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::exec {
+
+/// Executor that shares the threads of 'executor' between queries by CPU time
+/// with multi-level feedback queues. The Drivers enqueued by Driver::enqueue
+/// are grouped by query. A query starts at level 0 and goes down one level
+/// each time its accumulated CPU time exceeds the threshold of its level, so
+/// that short interactive queries run ahead of the long running ones. Each
+/// level gets a share of the CPU time that halves from one level to the next,
+/// so that the long running queries are not starved. Within a level, the
+/// queries are served round robin.
+///
+/// The Drivers yield at operator boundaries after 'driverTimeSliceMs' of CPU
+/// time unless the query sets its own driver_cpu_time_slice_limit_ms, so that
+/// a long running Driver does not hold a thread away from the queries above
+/// it.
+///
+/// Each add() schedules one run on 'executor' which picks the highest
+/// priority pending function at the time it runs, not necessarily the one
+/// that was added. 'executor' must outlive this and this must outlive all the
+/// queries that use it.
+class FairShareExecutor : public folly::Executor {
+ public:
+  struct Options {
+    /// Number of feedback levels.
+    int32_t numLevels{5};
+
+    /// Accumulated CPU time of a query after which it goes from level 0 to
+    /// level 1. The threshold of each next level is 'levelTimeMultiplier'
+    /// times the previous one.
+    uint64_t level0ThresholdMs{1'000};
+
+    uint32_t levelTimeMultiplier{4};
+
+    /// Time slice of the Drivers of the queries that do not set
+    /// driver_cpu_time_slice_limit_ms. 0 means no time slicing.
+    uint32_t driverTimeSliceMs{100};
+
+    /// Time after which the accumulated CPU time of a query that has no
+    /// pending functions is forgotten.
+    uint64_t queryExpirationMs{60'000};
+  };
+
+  struct Stats {
+    uint64_t numRuns{0};
+    uint64_t numQueries{0};
+    /// CPU time run at each level.
+    std::vector<uint64_t> levelCpuNanos;
+  };
+
+  FairShareExecutor(folly::Executor* executor, const Options& options);
+
+  /// Adds 'func' without query. It is scheduled at level 0 without charging
+  /// its CPU time to any query.
+  void add(folly::Func func) override;
+
+  /// Adds 'func' on behalf of 'queryId'. 'priority' shifts the level of the
+  /// query: a negative value moves it up, a positive value down. The CPU time
+  /// of 'func' is charged to 'queryId'.
+  void add(const std::string& queryId, int32_t priority, folly::Func func);
+
+  const Options& options() const {
+    return options_;
+  }
+
+  /// Returns the level the next function of 'queryId' is scheduled at.
+  int32_t queryLevel(const std::string& queryId) const;
+
+  Stats stats() const;
+
+ private:
+  struct Query {
+    uint64_t cpuNanos{0};
+    int32_t priority{0};
+    // Number of functions of the query being run.
+    int32_t numRunning{0};
+    uint64_t lastRunMs{0};
+    // True if the query is in 'levels_'.
+    bool queued{false};
+    std::deque<folly::Func> pending;
+  };
+
+  // Returns the level of 'query' from its CPU time and priority.
+  int32_t levelLocked(const Query& query) const;
+
+  // Queues 'query' at its level.
+  void scheduleLocked(Query* query);
+
+  // Takes the next function of the query at the front of the level to run
+  // next. Sets 'level' to the level and 'query' to the query of the function.
+  folly::Func takeNextLocked(int32_t& level, Query*& query);
+
+  // Returns the level to run next, the non-empty level with the least CPU
+  // time relative to its share.
+  int32_t nextLevelLocked() const;
+
+  // Runs the highest priority pending function.
+  void runNext();
+
+  // Forgets the idle queries that expired.
+  void expireQueriesLocked(uint64_t nowMs);
+
+  folly::Executor* const executor_;
+  const Options options_;
+  // CPU time after which a query leaves each level.
+  const std::vector<uint64_t> levelThresholdNanos_;
+
+  mutable std::mutex mutex_;
+  // Node map for stable Query pointers.
+  folly::F14NodeMap<std::string, Query> queries_;
+  // Queries with pending functions by level. A query is queued in one level
+  // at a time.
+  std::vector<std::deque<Query*>> levels_;
+  // Functions added without query.
+  std::deque<folly::Func> unowned_;
+  // CPU time run at each level divided by the share of the level.
+  std::vector<double> levelUsage_;
+  // CPU time run at each level.
+  std::vector<uint64_t> levelCpuNanos_;
+  uint64_t numRuns_{0};
+  uint64_t lastExpirationMs_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -15,7 +15,10 @@
  */
 #include "velox/exec/FilterProject.h"
 #include "velox/core/Expressions.h"
+#include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/ConjunctExpr.h"
+#include "velox/expression/ExprCompiler.h"
 #include "velox/expression/FieldReference.h"
 
 namespace facebook::velox::exec {
@@ -128,12 +131,11 @@ void FilterProject::initialize() {
     isIdentityProjection_ = true;
   }
   numExprs_ = allExprs.size();
-  exprs_ = makeExprSetFromFlag(
-      std::move(allExprs), operatorCtx_->execCtx(), lazyDereference_);
+  exprs_ = makeExprSet(std::move(allExprs));
 
+  const auto inputType = project_ ? project_->sources()[0]->outputType()
+                                  : filter_->sources()[0]->outputType();
   if (numExprs_ > 0 && !identityProjections_.empty()) {
-    const auto inputType = project_ ? project_->sources()[0]->outputType()
-                                    : filter_->sources()[0]->outputType();
     std::unordered_set<uint32_t> distinctFieldIndices;
     for (auto field : exprs_->distinctFields()) {
       auto fieldIndex = inputType->getChildIdx(field->name());
@@ -146,10 +148,62 @@ void FilterProject::initialize() {
       }
     }
   }
+  if (hasFilter_ && !lazyDereference_ &&
+      !isExprEvalSimplified(operatorCtx_->driverCtx()->queryConfig())) {
+    maybeLoadOnFilteredRows(inputType);
+  }
   filter_.reset();
   project_.reset();
 }
 
+void FilterProject::maybeLoadOnFilteredRows(const RowTypePtr& inputType) {
+  auto* conjunct = dynamic_cast<ConjunctExpr*>(exprs_->expr(0).get());
+  if (conjunct == nullptr || !conjunct->isAnd()) {
+    return;
+  }
+  std::unordered_set<std::string> fieldsAfterFilter;
+  for (auto i = 1; i < numExprs_; ++i) {
+    for (auto* field : exprs_->expr(i)->distinctFields()) {
+      fieldsAfterFilter.insert(field->name());
+    }
+  }
+  for (const auto& projection : identityProjections_) {
+    fieldsAfterFilter.insert(inputType->nameOf(projection.inputChannel));
+  }
+  std::unordered_set<FieldReference*> sharedFields;
+  for (auto* field : conjunct->distinctFields()) {
+    if (fieldsAfterFilter.count(field->name()) > 0) {
+      sharedFields.insert(field);
+    }
+  }
+  // The rows that pass the AND are a subset of the undecided rows of each of
+  // its inputs, so that the shared fields are loaded for the rows the
+  // projections read.
+  conjunct->setFieldsToLoadOnUndecidedRows(sharedFields);
+  exprs_->setDeferredLoads(0, std::move(sharedFields));
+  loadOnFilteredRows_ = true;
+}
+
+std::unique_ptr<ExprSet> FilterProject::makeExprSet(
+    std::vector<core::TypedExprPtr>&& exprs) {
+  auto* execCtx = operatorCtx_->execCtx();
+  if (exprs.empty() ||
+      isExprEvalSimplified(execCtx->queryCtx()->queryConfig())) {
+    return makeExprSetFromFlag(std::move(exprs), execCtx, lazyDereference_);
+  }
+  // Constant folding evaluates the constant subtrees and is the costly part
+  // of the compilation. Fold once for all Drivers of the task.
+  const auto optimized =
+      operatorCtx_->task()->getOptimizedExprs(planNodeId(), [&]() {
+        return optimizeExpressions(exprs, execCtx);
+      });
+  return makeExprSetFromFlag(
+      std::vector<core::TypedExprPtr>(*optimized),
+      execCtx,
+      lazyDereference_,
+      /*enableConstantFolding=*/false);
+}
+
 void FilterProject::addInput(RowVectorPtr input) {
   input_ = std::move(input);
 }
@@ -174,7 +228,7 @@ RowVectorPtr FilterProject::getOutput() {
   EvalCtx evalCtx(
       operatorCtx_->execCtx(), exprs_.get(), input_.get(), lazyDereference_);
 
-  if (!lazyDereference_) {
+  if (!lazyDereference_ && !loadOnFilteredRows_) {
     // Pre-load lazy vectors which are referenced by both expressions and
     // identity projections.
     for (auto fieldIdx : multiplyReferencedFieldIndices_) {
@@ -196,12 +250,19 @@ RowVectorPtr FilterProject::getOutput() {
   }
 
   const bool allRowsSelected = (numOut == size);
+  if (!allRowsSelected && (!isIdentityProjection_ || loadOnFilteredRows_)) {
+    rows->setFromBits(filterEvalCtx_.selectedBits->as<uint64_t>(), size);
+  }
+  if (loadOnFilteredRows_) {
+    // The fields shared with the filter are loaded already. The others are
+    // loaded for the rows that passed.
+    for (auto fieldIdx : multiplyReferencedFieldIndices_) {
+      evalCtx.ensureFieldLoaded(fieldIdx, *rows);
+    }
+  }
   // evaluate projections (if present)
   std::vector<VectorPtr> results;
   if (!isIdentityProjection_) {
-    if (!allRowsSelected) {
-      rows->setFromBits(filterEvalCtx_.selectedBits->as<uint64_t>(), size);
-    }
     results = project(*rows, evalCtx);
   }
 
@@ -89,6 +89,10 @@ class FilterProject : public Operator {
   }
 
  private:
+  // Compiles 'exprs'. The rewrites and constant folding are shared with the
+  // FilterProjects of the same plan node in the other Drivers of the task.
+  std::unique_ptr<ExprSet> makeExprSet(std::vector<core::TypedExprPtr>&& exprs);
+
   // Evaluate filter on all rows. Return number of rows that passed the filter.
   // Populate filterEvalCtx_.selectedBits and selectedIndices with the indices
   // of the passing rows if only some rows pass the filter. If all or no rows
@@ -96,6 +100,12 @@ class FilterProject : public Operator {
   // updated.
   vector_size_t filter(EvalCtx& evalCtx, const SelectivityVector& allRows);
 
+  // If the filter is an AND, makes it load the lazy fields that the
+  // projections also read only for the rows that pass its earlier inputs,
+  // and defers loading the other fields referenced by both expressions and
+  // identity projections until after the filter. Sets 'loadOnFilteredRows_'.
+  void maybeLoadOnFilteredRows(const RowTypePtr& inputType);
+
   // Evaluate projections on the specified rows and return the results.
   // pre-condition: !isIdentityProjection_
   std::vector<VectorPtr> project(
@@ -127,5 +137,10 @@ class FilterProject : public Operator {
   // will load c1 only for rows where f(c0) is true. However, c1 identity
   // projection needs all rows.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  // True if the fields shared by the filter and the projections are loaded
+  // only for the rows that reach them in the filter. See
+  // maybeLoadOnFilteredRows().
+  bool loadOnFilteredRows_{false};
 };
 } // namespace facebook::velox::exec
@@ -39,6 +39,46 @@ bool areAllLazyNotLoaded(const std::vector<VectorPtr>& vectors) {
   });
 }
 
+// Returns the size of the hash table above which a grouping set is
+// partitioned, or 0 if it cannot be partitioned. Partial aggregations flush
+// or abandon instead, distinct aggregations produce output from the lookup of
+// each input batch and sorted and distinct aggregates keep their inputs
+// outside of the accumulators, so that their groups cannot be moved to
+// another table by intermediate results.
+uint64_t partitionThresholdBytes(
+    const core::QueryConfig& queryConfig,
+    bool isPartial,
+    bool isGlobal,
+    const std::vector<column_index_t>& preGroupedKeys,
+    const std::vector<AggregateInfo>& aggregates,
+    const common::SpillConfig* spillConfig) {
+  if (isPartial || isGlobal || aggregates.empty() || !preGroupedKeys.empty() ||
+      spillConfig != nullptr || queryConfig.aggregationPartitionBits() == 0) {
+    return 0;
+  }
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return 0;
+    }
+  }
+  return queryConfig.aggregationPartitionThresholdBytes();
+}
+
+// Returns true if a full partial aggregation flushes only its cold groups.
+// Partial distinct aggregations produce output from the lookup of each input
+// batch instead.
+bool evictColdGroups(
+    const core::QueryConfig& queryConfig,
+    bool isPartial,
+    bool isGlobal,
+    const std::vector<AggregateInfo>& aggregates) {
+  return isPartial && !isGlobal && !aggregates.empty() &&
+      queryConfig.partialAggregationEvictColdGroups();
+}
+
+// Number of groups moved at a time from the hash table to its partitions.
+constexpr int32_t kPartitionBatchSize = 1'024;
+
 } // namespace
 
 GroupingSet::GroupingSet(
@@ -72,10 +112,20 @@ GroupingSet::GroupingSet(
       groupIdChannel_(groupIdChannel),
       spillConfig_(spillConfig),
       nonReclaimableSection_(nonReclaimableSection),
+      evictColdGroups_(
+          evictColdGroups(*queryConfig_, isPartial_, isGlobal_, aggregates_)),
       stringAllocator_(pool_),
       rows_(pool_),
       isAdaptive_(queryConfig_->hashAdaptivityEnabled()),
-      spillStats_(spillStats) {
+      spillStats_(spillStats),
+      partitionThresholdBytes_(partitionThresholdBytes(
+          *queryConfig_,
+          isPartial_,
+          isGlobal_,
+          preGroupedKeyChannels_,
+          aggregates_,
+          spillConfig_)),
+      partitionBits_(64 - queryConfig_->aggregationPartitionBits(), 64) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
   VELOX_CHECK(pool_->trackUsage());
 
@@ -130,6 +180,12 @@ GroupingSet::~GroupingSet() {
   if (isGlobal_) {
     destroyGlobalAggregations();
   }
+  // The accumulators of a sub-table are freed through its string allocator.
+  partitionLookups_.clear();
+  for (auto& table : partitionTables_) {
+    setAllocators(*table->rows());
+    table.reset();
+  }
 }
 
 std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
@@ -239,6 +295,10 @@ void GroupingSet::addInputForActiveRows(
     const RowVectorPtr& input,
     bool mayPushdown) {
   VELOX_CHECK(!isGlobal_);
+  if (isPartitioned()) {
+    addPartitionedInput(input);
+    return;
+  }
   if (!table_) {
     createHashTable();
   }
@@ -247,10 +307,15 @@ void GroupingSet::addInputForActiveRows(
   TestValue::adjust(
       "facebook::velox::exec::GroupingSet::addInputForActiveRows", this);
 
+  // With a dictionary encoded key only the first row of each distinct index
+  // probes the table. With runs of equal keys only the first row of each run
+  // probes the table.
+  const bool useDictionaryKeys = findDictionaryKeys(input);
+  const bool reuseGroups = useDictionaryKeys || findKeyRuns(input);
   table_->prepareForGroupProbe(
       *lookup_,
       input,
-      activeRows_,
+      reuseGroups ? keyRunHeads_ : activeRows_,
       BaseHashTable::kNoSpillInputStartPartitionBit);
   if (lookup_->rows.empty()) {
     // No rows to probe. Can happen when ignoreNullKeys_ is true and all rows
@@ -259,11 +324,56 @@ void GroupingSet::addInputForActiveRows(
   }
 
   table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
-  masks_.addInput(input, activeRows_);
+  if (reuseGroups) {
+    const auto numRows = activeRows_.end();
+    auto& hits = lookup_->hits;
+    hits.resize(numRows);
+    for (auto row = 0; row < numRows; ++row) {
+      hits[row] = hits[keyRunStarts_[row]];
+    }
+    const auto numReused = numRows - lookup_->rows.size();
+    if (useDictionaryKeys) {
+      numDictionaryKeyRows_ += numReused;
+    } else {
+      numKeyRunRows_ += numReused;
+    }
+  }
+  updateAggregates(
+      lookup_->hits.data(), lookup_->newGroups, input, mayPushdown);
+  if (evictColdGroups_) {
+    markHotGroups();
+  }
 
-  auto* groups = lookup_->hits.data();
-  const auto& newGroups = lookup_->newGroups;
+  if (shouldPartition()) {
+    partitionTable();
+  }
+}
 
+void GroupingSet::markHotGroups() {
+  const auto probedFlagOffset = table_->rows()->probedFlagOffset();
+  auto& hits = lookup_->hits;
+  for (auto row : lookup_->rows) {
+    if (!bits::isBitSet(hits[row], probedFlagOffset)) {
+      bits::setBit(hits[row], probedFlagOffset);
+      ++numHotGroups_;
+    }
+  }
+  // A new group becomes hot once a later input batch updates it. A group added
+  // and updated again within one batch stays cold.
+  for (auto row : lookup_->newGroups) {
+    bits::clearBit(hits[row], probedFlagOffset);
+    --numHotGroups_;
+  }
+}
+
+void GroupingSet::updateAggregates(
+    char** groups,
+    const std::vector<vector_size_t>& newGroups,
+    const RowVectorPtr& input,
+    bool mayPushdown) {
+  masks_.addInput(input, activeRows_);
+
+  const auto blockRows = updateBlockRows();
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
       continue;
@@ -287,6 +397,12 @@ void GroupingSet::addInputForActiveRows(
       function->initializeNewGroups(groups, newGroups);
     }
 
+    // The blocked update below adds the input after all the new groups are
+    // initialized.
+    if (blockRows > 0) {
+      continue;
+    }
+
     // Check is mask is false for all rows.
     if (!rows.hasSelections()) {
       continue;
@@ -304,6 +420,10 @@ void GroupingSet::addInputForActiveRows(
       function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
     }
   }
+
+  if (blockRows > 0) {
+    updateAggregatesBlocked(groups, input, blockRows);
+  }
   tempVectors_.clear();
 
   if (sortedAggregations_) {
@@ -314,6 +434,283 @@ void GroupingSet::addInputForActiveRows(
   }
 }
 
+template <typename UpdateFunc>
+void GroupingSet::probePartitions(const RowVectorPtr& keys, UpdateFunc update) {
+  const auto numRows = activeRows_.size();
+  partitionHashes_.resize(numRows);
+  for (auto i = 0; i < partitionHashers_.size(); ++i) {
+    partitionHashers_[i]->decode(*keys->childAt(i), activeRows_);
+    partitionHashers_[i]->hash(activeRows_, i > 0, partitionHashes_);
+  }
+
+  for (auto& rows : partitionRows_) {
+    rows.resizeFill(numRows, false);
+  }
+  // The partition is taken from the mixed hash since the hash of a single
+  // small integer key has no high bits. The sub-tables use the low bits of
+  // the unmixed hash for their buckets.
+  activeRows_.applyToSelected([&](auto row) {
+    const auto partition =
+        partitionBits_.partition(bits::hashMix(partitionHashes_[row], 0));
+    partitionRows_[partition].setValid(row, true);
+  });
+
+  for (auto partition = 0; partition < partitionRows_.size(); ++partition) {
+    auto& rows = partitionRows_[partition];
+    rows.updateBounds();
+    if (!rows.hasSelections()) {
+      continue;
+    }
+    activeRows_ = rows;
+    auto& table = *partitionTables_[partition];
+    auto& lookup = *partitionLookups_[partition];
+    setAllocators(*table.rows());
+    table.prepareForGroupProbe(
+        lookup,
+        keys,
+        activeRows_,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    if (lookup.rows.empty()) {
+      continue;
+    }
+    table.groupProbe(lookup, BaseHashTable::kNoSpillInputStartPartitionBit);
+    update(lookup);
+  }
+}
+
+bool GroupingSet::shouldPartition() const {
+  return partitionThresholdBytes_ > 0 &&
+      table_->allocatedBytes() > partitionThresholdBytes_;
+}
+
+void GroupingSet::partitionTable() {
+  VELOX_CHECK(!isPartitioned());
+  auto* rows = table_->rows();
+  const auto& keyTypes = rows->keyTypes();
+  const auto numKeys = keyTypes.size();
+  const auto numPartitions = partitionBits_.numPartitions();
+
+  partitionTables_.reserve(numPartitions);
+  partitionLookups_.reserve(numPartitions);
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    for (auto i = 0; i < numKeys; ++i) {
+      hashers.push_back(VectorHasher::create(keyTypes[i], i));
+    }
+    partitionTables_.push_back(makeHashTable(std::move(hashers)));
+    partitionLookups_.push_back(std::make_unique<HashLookup>(
+        partitionTables_.back()->hashers(), pool_));
+  }
+  for (auto i = 0; i < numKeys; ++i) {
+    partitionHashers_.push_back(VectorHasher::create(keyTypes[i], i));
+  }
+  partitionKeyType_ = ROW(std::vector<TypePtr>(keyTypes));
+  partitionRows_.resize(numPartitions);
+
+  // Moves the groups as keys and intermediate results. The sub-tables merge
+  // them the same way groups are merged when reading spilled data.
+  const auto batchType = makeSpillType();
+  std::vector<char*> groups(kPartitionBatchSize);
+  std::vector<VectorPtr> args(1);
+  RowContainerIterator iterator;
+  for (;;) {
+    const auto numGroups = rows->listRows(
+        &iterator, kPartitionBatchSize, RowContainer::kUnlimited, groups.data());
+    if (numGroups == 0) {
+      break;
+    }
+    auto batch = BaseVector::create<RowVector>(batchType, numGroups, pool_);
+    for (auto i = 0; i < numKeys; ++i) {
+      rows->extractColumn(groups.data(), numGroups, i, batch->childAt(i));
+    }
+    setAllocators(*rows);
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      aggregates_[i].function->extractAccumulators(
+          groups.data(), numGroups, &batch->childAt(numKeys + i));
+    }
+
+    activeRows_.resize(numGroups);
+    activeRows_.setAll();
+    probePartitions(batch, [&](HashLookup& lookup) {
+      for (auto i = 0; i < aggregates_.size(); ++i) {
+        auto& function = aggregates_[i].function;
+        if (!lookup.newGroups.empty()) {
+          function->initializeNewGroups(lookup.hits.data(), lookup.newGroups);
+        }
+        args[0] = batch->childAt(numKeys + i);
+        function->addIntermediateResults(
+            lookup.hits.data(), activeRows_, args, false);
+      }
+    });
+  }
+
+  setAllocators(*rows);
+  lookup_.reset();
+  table_.reset();
+}
+
+void GroupingSet::addPartitionedInput(const RowVectorPtr& input) {
+  // Each partition reads a different subset of the rows. Load lazy vectors
+  // for all rows up front and do not push the aggregation down into them.
+  for (const auto& child : input->children()) {
+    child->loadedVector();
+  }
+  std::vector<VectorPtr> keys;
+  keys.reserve(keyChannels_.size());
+  for (auto channel : keyChannels_) {
+    keys.push_back(input->childAt(channel));
+  }
+  auto keyInput = std::make_shared<RowVector>(
+      pool_, partitionKeyType_, nullptr, input->size(), std::move(keys));
+
+  probePartitions(keyInput, [&](HashLookup& lookup) {
+    updateAggregates(
+        lookup.hits.data(), lookup.newGroups, input, /*mayPushdown=*/false);
+  });
+}
+
+bool GroupingSet::findKeyRuns(const RowVectorPtr& input) {
+  if (!isPartial_ || ignoreNullKeys_ || !activeRows_.isAllSelected() ||
+      activeRows_.size() < kKeyRunSampleRows) {
+    return false;
+  }
+
+  const auto numSampled = kKeyRunSampleRows;
+  vector_size_t numRuns = 1;
+  for (auto row = 1; row < numSampled; ++row) {
+    if (!equalKeys(keyChannels_, input, row - 1, row)) {
+      ++numRuns;
+    }
+  }
+  if (numRuns * kMinKeyRunLength > numSampled) {
+    return false;
+  }
+
+  const auto numRows = activeRows_.size();
+  keyRunHeads_.resize(numRows);
+  keyRunHeads_.clearAll();
+  keyRunStarts_.resize(numRows);
+  vector_size_t start = 0;
+  keyRunHeads_.setValid(0, true);
+  keyRunStarts_[0] = 0;
+  for (auto row = 1; row < numRows; ++row) {
+    if (!equalKeys(keyChannels_, input, row - 1, row)) {
+      start = row;
+      keyRunHeads_.setValid(row, true);
+    }
+    keyRunStarts_[row] = start;
+  }
+  keyRunHeads_.updateBounds();
+  return true;
+}
+
+bool GroupingSet::findDictionaryKeys(const RowVectorPtr& input) {
+  if (keyChannels_.size() != 1 || ignoreNullKeys_ ||
+      !activeRows_.isAllSelected()) {
+    return false;
+  }
+  const auto& key = input->childAt(keyChannels_[0]);
+  if (key->encoding() != VectorEncoding::Simple::DICTIONARY) {
+    return false;
+  }
+
+  const auto numRows = activeRows_.size();
+  dictionaryKey_.decode(*key, activeRows_);
+  if (dictionaryKey_.isIdentityMapping() ||
+      dictionaryKey_.isConstantMapping()) {
+    return false;
+  }
+  const auto baseSize = dictionaryKey_.base()->size();
+  if (baseSize * kMinRowsPerDictionaryKey > numRows) {
+    return false;
+  }
+
+  // A null row may have any index, so all null rows share the last slot.
+  dictionaryKeyRows_.assign(baseSize + 1, -1);
+  keyRunHeads_.resize(numRows);
+  keyRunHeads_.clearAll();
+  keyRunStarts_.resize(numRows);
+  const auto* indices = dictionaryKey_.indices();
+  for (auto row = 0; row < numRows; ++row) {
+    const auto slot = dictionaryKey_.isNullAt(row) ? baseSize : indices[row];
+    auto& firstRow = dictionaryKeyRows_[slot];
+    if (firstRow < 0) {
+      firstRow = row;
+      keyRunHeads_.setValid(row, true);
+    }
+    keyRunStarts_[row] = firstRow;
+  }
+  keyRunHeads_.updateBounds();
+  return true;
+}
+
+int32_t GroupingSet::updateBlockRows() const {
+  int32_t numAggregates = 0;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (!aggregates_[i].distinct && aggregates_[i].sortingKeys.empty()) {
+      ++numAggregates;
+    }
+  }
+  if (numAggregates < kMinBlockedUpdateAggregates) {
+    return 0;
+  }
+
+  // The groups fit in cache, so updating one aggregate at a time over all
+  // the input rows does not reload them.
+  const auto* rows = isPartitioned() ? partitionTables_.front()->rows()
+                                     : table_->rows();
+  const int64_t rowSize = rows->fixedRowSize();
+  if (numRows() * rowSize <= kBlockedUpdateBytes) {
+    return 0;
+  }
+  const auto blockRows = std::max<int64_t>(
+      kMinBlockedUpdateRows, kBlockedUpdateBytes / rowSize);
+  return activeRows_.countSelected() > blockRows ? blockRows : 0;
+}
+
+void GroupingSet::updateAggregatesBlocked(
+    char** groups,
+    const RowVectorPtr& input,
+    int32_t blockRows) {
+  // Applies all the aggregates to one block of input rows before moving to the
+  // next block. The groups hit by the block stay in cache while each
+  // aggregate updates its accumulator in them, instead of every aggregate
+  // walking all the groups of the batch. Pushdown into lazy vectors needs the
+  // whole batch and is not used.
+  const auto end = activeRows_.end();
+  for (auto begin = activeRows_.begin(); begin < end; begin += blockRows) {
+    const auto blockEnd = std::min<vector_size_t>(begin + blockRows, end);
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      if (aggregates_[i].distinct || !aggregates_[i].sortingKeys.empty()) {
+        continue;
+      }
+
+      blockRows_ = getSelectivityVector(i);
+      blockRows_.setValidRange(0, begin, false);
+      blockRows_.setValidRange(blockEnd, blockRows_.size(), false);
+      blockRows_.updateBounds();
+      if (!blockRows_.hasSelections()) {
+        continue;
+      }
+
+      populateTempVectors(i, input);
+      auto& function = aggregates_[i].function;
+      if (isRawInput_) {
+        function->addRawInput(groups, blockRows_, tempVectors_, false);
+      } else {
+        function->addIntermediateResults(
+            groups, blockRows_, tempVectors_, false);
+      }
+    }
+  }
+}
+
+void GroupingSet::setAllocators(RowContainer& rows) {
+  for (auto& aggregate : aggregates_) {
+    aggregate.function->setAllocator(&rows.stringAllocator());
+  }
+}
+
 void GroupingSet::addRemainingInput() {
   activeRows_.resize(remainingInput_->size());
   activeRows_.clearAll();
@@ -375,15 +772,24 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
 }
 
 void GroupingSet::createHashTable() {
+  table_ = makeHashTable(std::move(hashers_));
+  lookup_ = std::make_unique<HashLookup>(table_->hashers(), pool_);
+}
+
+std::unique_ptr<BaseHashTable> GroupingSet::makeHashTable(
+    std::vector<std::unique_ptr<VectorHasher>> hashers) {
+  std::unique_ptr<BaseHashTable> table;
+  // The probed flag of a group row is its hot flag for partial aggregations
+  // that evict cold groups.
   if (ignoreNullKeys_) {
-    table_ = HashTable<true>::createForAggregation(
-        std::move(hashers_), accumulators(false), pool_);
+    table = HashTable<true>::createForAggregation(
+        std::move(hashers), accumulators(false), pool_, evictColdGroups_);
   } else {
-    table_ = HashTable<false>::createForAggregation(
-        std::move(hashers_), accumulators(false), pool_);
+    table = HashTable<false>::createForAggregation(
+        std::move(hashers), accumulators(false), pool_, evictColdGroups_);
   }
 
-  RowContainer& rows = *table_->rows();
+  RowContainer& rows = *table->rows();
   initializeAggregates(aggregates_, rows, false);
 
   auto numColumns = rows.keyTypes().size() + aggregates_.size();
@@ -419,10 +825,10 @@ void GroupingSet::createHashTable() {
     }
   }
 
-  lookup_ = std::make_unique<HashLookup>(table_->hashers(), pool_);
-  if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
-    table_->forceGenericHashMode(BaseHashTable::kNoSpillInputStartPartitionBit);
+  if (!isAdaptive_ && table->hashMode() != BaseHashTable::HashMode::kHash) {
+    table->forceGenericHashMode(BaseHashTable::kNoSpillInputStartPartitionBit);
   }
+  return table;
 }
 
 void GroupingSet::initializeGlobalAggregation() {
@@ -756,6 +1162,11 @@ bool GroupingSet::getOutput(
   }
   VELOX_CHECK(!isDistinct());
 
+  if (isPartitioned()) {
+    return getPartitionedOutput(
+        maxOutputRows, maxOutputBytes, iterator, result);
+  }
+
   // @lint-ignore CLANGTIDY
   std::vector<char*> groups(maxOutputRows);
   const int32_t numGroups = table_
@@ -773,6 +1184,31 @@ bool GroupingSet::getOutput(
   return true;
 }
 
+bool GroupingSet::getPartitionedOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes,
+    RowContainerIterator& iterator,
+    const RowVectorPtr& result) {
+  // @lint-ignore CLANGTIDY
+  std::vector<char*> groups(maxOutputRows);
+  while (outputPartition_ < partitionTables_.size()) {
+    auto& table = partitionTables_[outputPartition_];
+    auto* rows = table->rows();
+    setAllocators(*rows);
+    const int32_t numGroups = rows->listRows(
+        &iterator, maxOutputRows, maxOutputBytes, groups.data());
+    if (numGroups > 0) {
+      extractGroups(
+          rows, folly::Range<char**>(groups.data(), numGroups), result);
+      return true;
+    }
+    table->clear(/*freeTable=*/true);
+    ++outputPartition_;
+    iterator.reset();
+  }
+  return false;
+}
+
 void GroupingSet::extractGroups(
     RowContainer* rowContainer,
     folly::Range<char**> groups,
@@ -820,11 +1256,61 @@ void GroupingSet::resetTable(bool freeTable) {
   if (table_ != nullptr) {
     table_->clear(freeTable);
   }
+  numHotGroups_ = 0;
+  evictedGroups_.clear();
+  for (auto& table : partitionTables_) {
+    setAllocators(*table->rows());
+    table->clear(freeTable);
+  }
+}
+
+int64_t GroupingSet::numDistinct() const {
+  int64_t numDistinct = table_ ? table_->numDistinct() : 0;
+  for (const auto& table : partitionTables_) {
+    numDistinct += table->numDistinct();
+  }
+  return numDistinct;
+}
+
+int64_t GroupingSet::numRows() const {
+  int64_t numRows = table_ ? table_->rows()->numRows() : 0;
+  for (const auto& table : partitionTables_) {
+    numRows += table->rows()->numRows();
+  }
+  return numRows;
+}
+
+HashTableStats GroupingSet::hashTableStats() const {
+  if (!isPartitioned()) {
+    return table_ ? table_->stats() : HashTableStats{};
+  }
+  HashTableStats stats;
+  for (const auto& table : partitionTables_) {
+    const auto partitionStats = table->stats();
+    stats.capacity += partitionStats.capacity;
+    stats.numRehashes += partitionStats.numRehashes;
+    stats.numDistinct += partitionStats.numDistinct;
+    stats.numTombstones += partitionStats.numTombstones;
+  }
+  return stats;
 }
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
   VELOX_CHECK(isPartial_);
-  if (!table_ || allocatedBytes() <= maxBytes) {
+  if (!table_) {
+    return false;
+  }
+  // New groups reuse the rows and strings freed by evicting cold groups.
+  auto usedBytes = [&]() -> int64_t {
+    int64_t bytes = allocatedBytes();
+    if (evictColdGroups_) {
+      const auto* rows = table_->rows();
+      const auto [numFreeRows, freeBytes] = rows->freeSpace();
+      bytes -= numFreeRows * rows->fixedRowSize() + freeBytes;
+    }
+    return bytes;
+  };
+  if (usedBytes() <= maxBytes) {
     return false;
   }
   if (table_->hashMode() != BaseHashTable::HashMode::kArray) {
@@ -841,7 +1327,63 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
     table_->decideHashMode(
         0, BaseHashTable::kNoSpillInputStartPartitionBit, true);
   }
-  return allocatedBytes() > maxBytes;
+  return usedBytes() > maxBytes;
+}
+
+bool GroupingSet::startColdGroupEviction() {
+  VELOX_CHECK(isPartial_);
+  if (!evictColdGroups_ || table_ == nullptr) {
+    return false;
+  }
+  VELOX_CHECK(evictedGroups_.empty());
+  const auto numGroups = table_->numDistinct();
+  return numGroups > 0 && numHotGroups_ * 100 <= numGroups * kMaxHotGroupsPct;
+}
+
+bool GroupingSet::getColdGroupOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes,
+    RowContainerIterator& iterator,
+    RowVectorPtr& result) {
+  VELOX_CHECK(evictColdGroups_);
+  eraseEvictedGroups();
+
+  auto* rows = table_->rows();
+  evictedGroups_.resize(maxOutputRows);
+  const auto numGroups =
+      rows->listRows<RowContainer::ProbeType::kNotProbed>(
+          &iterator, maxOutputRows, maxOutputBytes, evictedGroups_.data());
+  evictedGroups_.resize(numGroups);
+  if (numGroups > 0) {
+    extractGroups(rows, folly::Range(evictedGroups_.data(), numGroups), result);
+    numEvictedColdGroups_ += numGroups;
+    return true;
+  }
+
+  // Every remaining group must be updated again to stay in the table on the
+  // next flush.
+  const auto probedFlagOffset = rows->probedFlagOffset();
+  std::vector<char*> hotGroups(maxOutputRows);
+  RowContainerIterator hotIterator;
+  while (const auto numHotGroups =
+             rows->listRows<RowContainer::ProbeType::kProbed>(
+                 &hotIterator,
+                 maxOutputRows,
+                 RowContainer::kUnlimited,
+                 hotGroups.data())) {
+    for (auto i = 0; i < numHotGroups; ++i) {
+      bits::clearBit(hotGroups[i], probedFlagOffset);
+    }
+  }
+  numHotGroups_ = 0;
+  return false;
+}
+
+void GroupingSet::eraseEvictedGroups() {
+  if (!evictedGroups_.empty()) {
+    table_->erase(folly::Range(evictedGroups_.data(), evictedGroups_.size()));
+    evictedGroups_.clear();
+  }
 }
 
 uint64_t GroupingSet::allocatedBytes() const {
@@ -851,6 +1393,10 @@ uint64_t GroupingSet::allocatedBytes() const {
   }
   if (table_ != nullptr) {
     totalBytes += table_->allocatedBytes();
+  } else if (isPartitioned()) {
+    for (const auto& table : partitionTables_) {
+      totalBytes += table->allocatedBytes();
+    }
   } else {
     totalBytes += (stringAllocator_.retainedSize() + rows_.allocatedBytes());
   }
@@ -858,7 +1404,7 @@ uint64_t GroupingSet::allocatedBytes() const {
 }
 
 const HashLookup& GroupingSet::hashLookup() const {
-  return *lookup_;
+  return isPartitioned() ? *partitionLookups_[0] : *lookup_;
 }
 
 void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
@@ -1006,6 +1552,23 @@ std::optional<common::SpillStats> GroupingSet::spilledStats() const {
   return outputSpiller_->stats();
 }
 
+int64_t GroupingSet::compactRows() {
+  // Moving the data is only worth it if at least a quarter of its memory is
+  // free.
+  constexpr int64_t kMinFreeDivisor = 4;
+  if (table_ == nullptr || table_->numDistinct() == 0) {
+    return 0;
+  }
+  auto* rows = table_->rows();
+  const auto& allocator = rows->stringAllocator();
+  if (!rows->canCompactStrings() ||
+      static_cast<int64_t>(allocator.freeSpace()) <
+          allocator.retainedSize() / kMinFreeDivisor) {
+    return 0;
+  }
+  return rows->compactStrings();
+}
+
 void GroupingSet::spill() {
   // NOTE: if the disk spilling is triggered by the memory arbitrator, then it
   // is possible that the grouping set hasn't processed any input data yet.
@@ -1564,6 +2127,9 @@ void GroupingSet::toIntermediate(
 }
 
 std::optional<int64_t> GroupingSet::estimateOutputRowSize() const {
+  if (isPartitioned()) {
+    return partitionTables_[0]->rows()->estimateRowSize();
+  }
   if (table_ == nullptr) {
     return std::nullopt;
   }
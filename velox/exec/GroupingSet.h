@@ -30,6 +30,23 @@ class AggregationOutputSpiller;
 
 class GroupingSet {
  public:
+  /// Runtime stat reporting the number of sub-tables of a partitioned hash
+  /// table.
+  static inline const std::string kNumPartitions{"hashtable.numPartitions"};
+
+  /// Runtime stat reporting the number of input rows of a partial aggregation
+  /// that were grouped by runs of equal keys without probing the hash table.
+  static inline const std::string kKeyRunRows{"keyRunRows"};
+
+  /// Runtime stat reporting the number of input rows with a dictionary encoded
+  /// grouping key that reused the group of an earlier row with the same
+  /// dictionary index without probing the hash table.
+  static inline const std::string kDictionaryKeyRows{"dictionaryKeyRows"};
+
+  /// Runtime stat reporting the number of groups of a partial aggregation that
+  /// were flushed as cold while the hot groups stayed in the hash table.
+  static inline const std::string kEvictedColdGroups{"evictedColdGroups"};
+
   GroupingSet(
       const RowTypePtr& inputType,
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
@@ -94,11 +111,30 @@ class GroupingSet {
   /// based on value ranges to one based on value ids can save a lot.
   bool isPartialFull(int64_t maxBytes);
 
-  /// Returns the count of the hash table, if any.
-  int64_t numDistinct() const {
-    return table_ ? table_->numDistinct() : 0;
+  /// Starts flushing the cold groups of a full partial aggregation, i.e. the
+  /// groups that were not updated again since they were added or since the
+  /// previous flush. Returns false if eviction of cold groups is disabled or
+  /// if most groups are hot. The caller then flushes all groups.
+  bool startColdGroupEviction();
+
+  /// Extracts up to 'maxOutputRows' cold groups into 'result' and removes them
+  /// from the hash table. Returns false once all cold groups have been
+  /// returned. The remaining groups then become cold until they are updated
+  /// again.
+  bool getColdGroupOutput(
+      int32_t maxOutputRows,
+      int32_t maxOutputBytes,
+      RowContainerIterator& iterator,
+      RowVectorPtr& result);
+
+  /// Returns the number of groups flushed by getColdGroupOutput() so far.
+  int64_t numEvictedColdGroups() const {
+    return numEvictedColdGroups_;
   }
 
+  /// Returns the count of the hash table, if any.
+  int64_t numDistinct() const;
+
   /// Returns number of global grouping sets rows if there is default output.
   std::optional<vector_size_t> numDefaultGlobalGroupingSetRows() const {
     if (hasDefaultGlobalGroupingSetOutput()) {
@@ -109,6 +145,11 @@ class GroupingSet {
 
   const HashLookup& hashLookup() const;
 
+  /// Compacts the variable width data of the rows in the hash table if enough
+  /// of its memory is free and no accumulator uses external memory. Returns
+  /// the number of bytes released.
+  int64_t compactRows();
+
   /// Spills all the rows in container.
   void spill();
 
@@ -123,14 +164,34 @@ class GroupingSet {
   /// Returns true if spilling has triggered on this grouping set.
   bool hasSpilled() const;
 
-  /// Returns the hashtable stats.
-  HashTableStats hashTableStats() const {
-    return table_ ? table_->stats() : HashTableStats{};
-  }
+  /// Returns the hashtable stats. If the table has been partitioned, returns
+  /// the sum over the partitions.
+  HashTableStats hashTableStats() const;
 
   /// Return the number of rows kept in memory.
-  int64_t numRows() const {
-    return table_ ? table_->rows()->numRows() : 0;
+  int64_t numRows() const;
+
+  /// Returns the number of input rows that reused the group of the previous row
+  /// with equal keys instead of probing the hash table.
+  int64_t numKeyRunRows() const {
+    return numKeyRunRows_;
+  }
+
+  /// Returns the number of input rows that reused the group of an earlier row
+  /// with the same dictionary index of the grouping key instead of probing the
+  /// hash table.
+  int64_t numDictionaryKeyRows() const {
+    return numDictionaryKeyRows_;
+  }
+
+  /// Returns true if the groups have been radix partitioned into sub-tables.
+  bool isPartitioned() const {
+    return !partitionTables_.empty();
+  }
+
+  /// Returns the number of sub-tables, 0 if not partitioned.
+  int32_t numPartitions() const {
+    return partitionTables_.size();
   }
 
   /// Frees hash tables and other state when giving up partial aggregation as
@@ -183,6 +244,86 @@ class GroupingSet {
 
   void createHashTable();
 
+  // Creates a hash table for 'hashers' and sets the accumulator offsets of the
+  // aggregates for its row layout.
+  std::unique_ptr<BaseHashTable> makeHashTable(
+      std::vector<std::unique_ptr<VectorHasher>> hashers);
+
+  // Updates the accumulators of 'groups' with the rows of 'input' selected by
+  // 'activeRows_'. 'newGroups' are the rows that created new groups.
+  void updateAggregates(
+      char** groups,
+      const std::vector<vector_size_t>& newGroups,
+      const RowVectorPtr& input,
+      bool mayPushdown);
+
+  // Returns the number of input rows per block for updateAggregatesBlocked()
+  // or 0 if the accumulators of the batch are updated one aggregate at a time.
+  // Blocks are used when there are at least 'kMinBlockedUpdateAggregates'
+  // plain aggregates and the groups do not fit in 'kBlockedUpdateBytes'.
+  int32_t updateBlockRows() const;
+
+  // Updates the non-distinct, non-sorted aggregates of 'groups' with blocks of
+  // 'blockRows' rows of 'activeRows_', applying all the aggregates to a block
+  // before moving to the next.
+  void updateAggregatesBlocked(
+      char** groups,
+      const RowVectorPtr& input,
+      int32_t blockRows);
+
+  // Returns true if the rows of 'input' come in runs of equal grouping keys,
+  // as they do for clustered data. Checks a sample at the start of the batch
+  // and returns false if the runs are short. Otherwise, sets 'keyRunHeads_' to
+  // the first row of each run and 'keyRunStarts_' to the first row of the run
+  // of each row. Only used for partial aggregation with all rows active.
+  bool findKeyRuns(const RowVectorPtr& input);
+
+  // Returns true if 'input' has a single grouping key that is dictionary
+  // encoded over a base with few values compared to the rows. Then sets
+  // 'keyRunHeads_' to the first row of each distinct dictionary index and
+  // null, and 'keyRunStarts_' to that row for each row, so that the hash
+  // table is probed once per distinct index instead of once per row. Used
+  // with all rows active and null keys kept.
+  bool findDictionaryKeys(const RowVectorPtr& input);
+
+  // Sets the hot flag of the groups updated by the current input, except for
+  // the groups it added. Used for evicting cold groups of a partial
+  // aggregation.
+  void markHotGroups();
+
+  // Erases the groups returned by the previous getColdGroupOutput() call.
+  void eraseEvictedGroups();
+
+  // Returns true if 'table_' has outgrown 'partitionThresholdBytes_' and the
+  // aggregation can be partitioned.
+  bool shouldPartition() const;
+
+  // Replaces 'table_' with 2 ^ 'partitionBits_.numBits()' sub-tables and moves
+  // the groups of 'table_' to the sub-tables by their intermediate results.
+  void partitionTable();
+
+  // Adds 'input' to the sub-tables after the table has been partitioned.
+  void addPartitionedInput(const RowVectorPtr& input);
+
+  // Splits the rows of 'keys' selected by 'activeRows_' by partition. For each
+  // partition, probes its sub-table with its rows and calls 'update' with the
+  // lookup while 'activeRows_' selects the partition's rows. 'keys' has the
+  // grouping keys in the order of 'keyChannels_'.
+  template <typename UpdateFunc>
+  void probePartitions(const RowVectorPtr& keys, UpdateFunc update);
+
+  // Produces output from the sub-tables one partition at a time. Frees each
+  // partition once its groups are returned.
+  bool getPartitionedOutput(
+      int32_t maxOutputRows,
+      int32_t maxOutputBytes,
+      RowContainerIterator& iterator,
+      const RowVectorPtr& result);
+
+  // Points the aggregates at the string allocator of 'rows'. The sub-tables
+  // share the row layout but not the allocator.
+  void setAllocators(RowContainer& rows);
+
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
   // If the given aggregation has mask, the method returns reference to the
@@ -334,6 +475,64 @@ class GroupingSet {
 
   // Place for the arguments of the aggregate being updated.
   std::vector<VectorPtr> tempVectors_;
+
+  // Minimum number of plain aggregates for updating the accumulators in
+  // blocks of input rows.
+  static constexpr int32_t kMinBlockedUpdateAggregates = 4;
+
+  // Size of the groups touched by one block of input rows. Roughly the size of
+  // an L2 cache.
+  static constexpr int64_t kBlockedUpdateBytes = 256 << 10;
+
+  static constexpr int32_t kMinBlockedUpdateRows = 64;
+
+  // Rows of the block being updated by updateAggregatesBlocked().
+  SelectivityVector blockRows_;
+
+  // Number of rows sampled by findKeyRuns().
+  static constexpr vector_size_t kKeyRunSampleRows = 128;
+
+  // Minimum average length of the runs of equal keys in the sample for
+  // probing the hash table once per run.
+  static constexpr vector_size_t kMinKeyRunLength = 8;
+
+  // First row of each run of equal keys in the current input.
+  SelectivityVector keyRunHeads_;
+
+  // First row of the run of equal keys of each row in the current input.
+  std::vector<vector_size_t> keyRunStarts_;
+
+  int64_t numKeyRunRows_{0};
+
+  // Minimum average number of rows per base value of a dictionary encoded
+  // grouping key for probing the hash table once per dictionary index.
+  static constexpr vector_size_t kMinRowsPerDictionaryKey = 4;
+
+  // Decoded grouping key used by findDictionaryKeys().
+  DecodedVector dictionaryKey_;
+
+  // First row of each dictionary index of the grouping key in the current
+  // input, -1 if not seen yet. The last entry is for null keys.
+  std::vector<vector_size_t> dictionaryKeyRows_;
+
+  int64_t numDictionaryKeyRows_{0};
+
+  // True if a full partial aggregation flushes its cold groups only. See
+  // QueryConfig::kPartialAggregationEvictColdGroups.
+  const bool evictColdGroups_;
+
+  // Flushes all groups instead of the cold ones if more than this percentage
+  // of the groups is hot.
+  static constexpr int64_t kMaxHotGroupsPct = 50;
+
+  // Number of groups with the hot flag set.
+  int64_t numHotGroups_{0};
+
+  // Cold groups returned by the last getColdGroupOutput() call. These are
+  // erased from the table on the next call.
+  std::vector<char*> evictedGroups_;
+
+  int64_t numEvictedColdGroups_{0};
   std::unique_ptr<BaseHashTable> table_;
   std::unique_ptr<HashLookup> lookup_;
   SelectivityVector activeRows_;
@@ -415,6 +614,30 @@ class GroupingSet {
   std::vector<char*> firstGroup_;
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
+
+  // Size of 'table_' above which the groups are partitioned. 0 if the
+  // aggregation is not partitioned.
+  const uint64_t partitionThresholdBytes_;
+
+  // Hash bits selecting the sub-table of a group once partitioned.
+  const HashBitRange partitionBits_;
+
+  // Sub-tables and their lookups, one per partition. Empty until
+  // partitionTable() replaces 'table_'.
+  std::vector<std::unique_ptr<BaseHashTable>> partitionTables_;
+  std::vector<std::unique_ptr<HashLookup>> partitionLookups_;
+
+  // Hashers for computing the partition of the grouping keys, independent of
+  // the hash mode of the sub-tables.
+  std::vector<std::unique_ptr<VectorHasher>> partitionHashers_;
+  // Type of the grouping keys passed to the sub-tables. The sub-table hashers
+  // read key 'i' from channel 'i'.
+  RowTypePtr partitionKeyType_;
+  raw_vector<uint64_t> partitionHashes_;
+  std::vector<SelectivityVector> partitionRows_;
+
+  // The sub-table being read in getPartitionedOutput().
+  int32_t outputPartition_{0};
 };
 
 class AggregationInputSpiller : public SpillerBase {
@@ -197,6 +197,8 @@ void HashAggregation::addInput(RowVectorPtr input) {
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
     partialFull_ = true;
+    evictingColdGroups_ =
+        !abandonPartialEarly && groupingSet_->startColdGroupEviction();
   }
 
   if (isDistinct_) {
@@ -243,17 +245,26 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (groupingSet_->isPartitioned()) {
+    runtimeStats[GroupingSet::kNumPartitions] =
+        RuntimeMetric(groupingSet_->numPartitions());
+  }
+  if (groupingSet_->numKeyRunRows() > 0) {
+    runtimeStats[GroupingSet::kKeyRunRows] =
+        RuntimeMetric(groupingSet_->numKeyRunRows());
+  }
+  if (groupingSet_->numDictionaryKeyRows() > 0) {
+    runtimeStats[GroupingSet::kDictionaryKeyRows] =
+        RuntimeMetric(groupingSet_->numDictionaryKeyRows());
+  }
+  if (groupingSet_->numEvictedColdGroups() > 0) {
+    runtimeStats[GroupingSet::kEvictedColdGroups] =
+        RuntimeMetric(groupingSet_->numEvictedColdGroups());
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
-  if (output_) {
-    VectorPtr output = std::move(output_);
-    BaseVector::prepareForReuse(output, size);
-    output_ = std::static_pointer_cast<RowVector>(output);
-  } else {
-    output_ = std::static_pointer_cast<RowVector>(
-        BaseVector::create(outputType_, size, pool()));
-  }
+  prepareReusableOutput(output_, size);
 }
 
 void HashAggregation::resetPartialOutputIfNeed() {
@@ -352,6 +363,15 @@ RowVectorPtr HashAggregation::getOutput() {
     return getDistinctOutput();
   }
 
+  if (evictingColdGroups_) {
+    if (auto output = getColdGroupOutput()) {
+      return output;
+    }
+    if (!noMoreInput_) {
+      return nullptr;
+    }
+  }
+
   const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
   const auto maxOutputRows =
       isGlobal_ ? 1 : outputBatchRows(estimatedOutputRowSize_);
@@ -375,6 +395,28 @@ RowVectorPtr HashAggregation::getOutput() {
   return output_;
 }
 
+RowVectorPtr HashAggregation::getColdGroupOutput() {
+  VELOX_CHECK(evictingColdGroups_);
+  const auto maxOutputRows = outputBatchRows(estimatedOutputRowSize_);
+  prepareOutput(maxOutputRows);
+  if (groupingSet_->getColdGroupOutput(
+          maxOutputRows,
+          operatorCtx_->driverCtx()->queryConfig().preferredOutputBatchBytes(),
+          resultIterator_,
+          output_)) {
+    numOutputRows_ += output_->size();
+    return output_;
+  }
+
+  // The hot groups stay in the table. Accept input again.
+  resultIterator_.reset();
+  evictingColdGroups_ = false;
+  partialFull_ = false;
+  addRuntimeStat("flushTimes", RuntimeCounter(1));
+  updateRuntimeStats();
+  return nullptr;
+}
+
 RowVectorPtr HashAggregation::getDistinctOutput() {
   VELOX_CHECK(isDistinct_);
   VELOX_CHECK(!finished_);
@@ -479,8 +521,16 @@ void HashAggregation::reclaim(
     // 'resultIterator_'.
     groupingSet_->spill(resultIterator_);
   } else {
-    // TODO: support fine-grain disk spilling based on 'targetBytes' after
-    // having row container memory compaction support later.
+    // Compacting the rows is cheaper than spilling, so try it first and only
+    // spill if it does not release 'targetBytes'.
+    const auto reservedBytes = pool()->reservedBytes();
+    if (groupingSet_->compactRows() > 0) {
+      pool()->release();
+      if (reservedBytes - pool()->reservedBytes() >= targetBytes) {
+        return;
+      }
+    }
+    // TODO: support fine-grain disk spilling based on 'targetBytes'.
     groupingSet_->spill();
   }
   VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
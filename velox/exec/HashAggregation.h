@@ -72,6 +72,10 @@ class HashAggregation : public Operator {
 
   RowVectorPtr getDistinctOutput();
 
+  // Returns the next batch of cold groups flushed by a full partial
+  // aggregation, or null once all of them have been returned.
+  RowVectorPtr getColdGroupOutput();
+
   // Setups the projections for accessing grouping keys stored in grouping
   // set.
   // For 'groupingKeyInputChannels', the index is the key column index from
@@ -106,6 +110,8 @@ class HashAggregation : public Operator {
   std::optional<int64_t> estimatedOutputRowSize_;
 
   bool partialFull_ = false;
+  // True while a full partial aggregation flushes its cold groups only.
+  bool evictingColdGroups_ = false;
   bool newDistincts_ = false;
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
@@ -136,18 +136,23 @@ void HashBuild::initialize() {
 }
 
 bool HashBuild::setupCachedHashTable() {
-  if (!joinNode_->useHashTableCache()) {
+  if (!shareHashTable(
+          *joinNode_, operatorCtx_->driverCtx()->queryConfig())) {
     return false;
   }
 
-  const auto& queryId = operatorCtx_->task()->queryCtx()->queryId();
-  cacheKey_ = fmt::format("{}:{}", queryId, planNodeId());
-
   // Get or create the cache entry (which includes the pool).
   // If another task is already building, future_ will be set.
   auto* cache = HashTableCache::instance();
-  auto* queryCtx = operatorCtx_->task()->queryCtx().get();
-  cacheEntry_ = cache->get(cacheKey_, taskId(), queryCtx, &future_);
+  if (!joinNode_->hashTableCacheKey().empty()) {
+    cacheKey_ = fmt::format("shared:{}", joinNode_->hashTableCacheKey());
+    cacheEntry_ = cache->getCrossQuery(cacheKey_, taskId(), &future_);
+  } else {
+    const auto& queryId = operatorCtx_->task()->queryCtx()->queryId();
+    cacheKey_ = fmt::format("{}:{}", queryId, planNodeId());
+    auto* queryCtx = operatorCtx_->task()->queryCtx().get();
+    cacheEntry_ = cache->get(cacheKey_, taskId(), queryCtx, &future_);
+  }
   VELOX_CHECK_NOT_NULL(cacheEntry_);
   VELOX_CHECK_NOT_NULL(cacheEntry_->tablePool);
 
@@ -205,10 +210,17 @@ bool HashBuild::receivedCachedHashTable() {
     return false;
   }
   // We were waiting on cached table from another task.
-  // Ensure that table is ready.
-  VELOX_CHECK(
-      cacheEntry_->buildComplete,
-      "Signalled that cache table is ready but it is not built yet.");
+  // Ensure that table is ready. A cross-query entry is abandoned if its
+  // builder task fails.
+  if (!cacheEntry_->buildComplete) {
+    VELOX_CHECK(
+        cacheEntry_->crossQuery,
+        "Signalled that cache table is ready but it is not built yet.");
+    VELOX_FAIL(
+        "Build of cached hash table {} was abandoned by task {}",
+        cacheKey_,
+        cacheEntry_->builderTaskId);
+  }
   // Proceed through normal noMoreInput flow which will use the cache.
   setRunning();
   noMoreInput();
@@ -865,8 +877,11 @@ bool HashBuild::finishHashBuild() {
   // TODO: Get accurate signal if parallel join build is going to be applied
   //  from hash table. Currently there is still a chance inside hash table that
   //  it might decide it is not going to trigger parallel join build.
+  const auto numParallelBuildPartitions =
+      operatorCtx_->driverCtx()->queryConfig().parallelJoinBuildPartitions();
   const bool allowParallelJoinBuild =
-      !otherTables.empty() && spillPartitions.empty();
+      (!otherTables.empty() || numParallelBuildPartitions > 1) &&
+      spillPartitions.empty();
 
   SCOPE_EXIT {
     // Make a guard to release the unused memory reservation since we have
@@ -886,7 +901,8 @@ bool HashBuild::finishHashBuild() {
         vectorHasherMaxNumDistinct_,
         dropDuplicates_,
         allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
-                               : nullptr);
+                               : nullptr,
+        numParallelBuildPartitions);
   }
   stats_.wlock()->addRuntimeStat(
       BaseHashTable::kBuildWallNanos,
@@ -894,10 +910,19 @@ bool HashBuild::finishHashBuild() {
 
   addRuntimeStats();
 
+  // Left semi and anti joins without filter only check the key presence, so
+  // an array mode table can be reduced to a bitmap of its keys.
+  if (joinNode_->canDropDuplicates() && table_->convertToKeySet()) {
+    stats_.wlock()->addRuntimeStat(
+        BaseHashTable::kKeySetBytes,
+        RuntimeCounter(
+            bits::nbytes(table_->capacity()), RuntimeCounter::Unit::kBytes));
+  }
+
   // Setup spill function for spilling hash table directly from hash join
   // bridge after transferring of table ownership.
   HashJoinTableSpillFunc tableSpillFunc;
-  if (canReclaim()) {
+  if (canReclaim() && !table_->isKeySet()) {
     VELOX_CHECK_NOT_NULL(spiller_);
     tableSpillFunc =
         [hashBitRange = spiller_->hashBits(),
@@ -1361,6 +1386,14 @@ bool HashBuild::nonReclaimableState() const {
 void HashBuild::close() {
   Operator::close();
 
+  // A cross-query entry outlives the query, so a failed builder task must
+  // release it for the waiting and later queries.
+  if (useHashTableCache() && cacheEntry_ != nullptr &&
+      cacheEntry_->crossQuery && !cacheEntry_->buildComplete &&
+      !operatorCtx_->task()->isRunning()) {
+    HashTableCache::instance()->abandon(cacheKey_, taskId());
+  }
+
   {
     // Free up major memory usage. Gate access to them as they can be accessed
     // by the last build thread that finishes building the hash table.
@@ -1370,6 +1403,8 @@ void HashBuild::close() {
     spiller_.reset();
     table_.reset();
   }
+  // Lets the cache evict a cross-query entry once no query uses it.
+  cacheEntry_.reset();
 }
 
 HashBuildSpiller::HashBuildSpiller(
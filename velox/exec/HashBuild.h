@@ -290,7 +290,8 @@ class HashBuild final : public Operator {
 
   // For hash table caching: the cache key passed in at construction.
   // If set, this operator coordinates via HashTableCache.
-  // Key format: "queryId:planNodeId"
+  // Key format: "queryId:planNodeId", or "shared:<HashJoinNode cache key>" for
+  // tables cached across queries.
   std::string cacheKey_;
 
   // For hash table caching: cached entry containing the shared table and pool.
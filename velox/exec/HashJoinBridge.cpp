@@ -293,6 +293,7 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
     buildResult_ = HashBuildResult{};
     restoringSpillPartitionId_.reset();
     spillPartitionSet_.clear();
+    probeSpilledBytes_.clear();
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -317,7 +318,21 @@ std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
   return std::nullopt;
 }
 
-void HashJoinBridge::probeFinished(bool restart) {
+void HashJoinBridge::addProbeSpilledPartitions(
+    const SpillPartitionSet& partitionSet,
+    const SpillPartitionIdSet& partitionIds) {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& id : partitionIds) {
+    auto it = partitionSet.find(id);
+    VELOX_CHECK(it != partitionSet.end());
+    probeSpilledBytes_[id] += it->second->size();
+  }
+}
+
+SpillPartitionIdSet HashJoinBridge::probeFinished(
+    bool restart,
+    bool skipEmptyProbePartitions) {
+  SpillPartitionIdSet skippedPartitionIds;
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -344,16 +359,34 @@ void HashJoinBridge::probeFinished(bool restart) {
       buildResult_->spillPartitionIds =
           toSpillPartitionIdSet(spillPartitionSet_.spillPartitions());
       spillPartitionSet_.reset();
-      return;
+      probeSpilledBytes_.clear();
+      return skippedPartitionIds;
+    }
+    std::optional<SpillPartition> nextSpillPartition;
+    while (spillPartitionSet_.hasNext()) {
+      auto spillPartition = spillPartitionSet_.next();
+      const auto it = probeSpilledBytes_.find(spillPartition.id());
+      const bool emptyProbe =
+          it != probeSpilledBytes_.end() && it->second == 0;
+      if (it != probeSpilledBytes_.end()) {
+        probeSpilledBytes_.erase(it);
+      }
+      if (skipEmptyProbePartitions && emptyProbe) {
+        // There is no probe input for this partition, hence no need to build
+        // a table from it.
+        skippedPartitionIds.insert(spillPartition.id());
+        continue;
+      }
+      nextSpillPartition.emplace(std::move(spillPartition));
+      break;
     }
-    if (spillPartitionSet_.hasNext()) {
+    if (nextSpillPartition.has_value()) {
       // Finished probing one restored table from an unspilled partition. Wait
       // for the hash build operator to build a new table from the next spill
       // partition.
       buildResult_.reset();
-      auto nextSpillPartition = spillPartitionSet_.next();
-      restoringSpillPartitionId_ = nextSpillPartition.id();
-      restoringSpillShards_ = nextSpillPartition.split(numBuilders_);
+      restoringSpillPartitionId_ = nextSpillPartition->id();
+      restoringSpillShards_ = nextSpillPartition->split(numBuilders_);
       VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
     } else {
       // Probe fully completed, resetting 'buildResult_' to signal build side to
@@ -363,6 +396,7 @@ void HashJoinBridge::probeFinished(bool restart) {
     promises = std::move(promises_);
   }
   notify(std::move(promises));
+  return skippedPartitionIds;
 }
 
 std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
@@ -121,7 +121,23 @@ class HashJoinBridge : public JoinBridge {
   /// one.  If 'restart' is true, join bridge will reset the state to prepare
   /// for a new probing process. This is used in mixed grouped execution mode of
   /// a hash join (grouped probe, ungrouped build).
-  void probeFinished(bool restart = false);
+  ///
+  /// If 'skipEmptyProbePartitions' is true, the bridge skips restoring the
+  /// spilled table partitions that have no spilled probe input, as reported by
+  /// addProbeSpilledPartitions(). This only applies to join types which produce
+  /// no output for a table partition without probe input. The function returns
+  /// the skipped partition ids which the probe operators must drop from their
+  /// own spilled input partitions.
+  SpillPartitionIdSet probeFinished(
+      bool restart = false,
+      bool skipEmptyProbePartitions = false);
+
+  /// Invoked by HashProbe operator after it finishes spilling its input into
+  /// 'partitionIds' to record the spilled probe bytes of each partition from
+  /// 'partitionSet'. The bytes are accumulated across all the probe operators.
+  void addProbeSpilledPartitions(
+      const SpillPartitionSet& partitionSet,
+      const SpillPartitionIdSet& partitionIds);
 
   /// Contains the spill input for one HashBuild operator: a shard of previously
   /// spilled partition data. 'spillPartition' is null if there is no more spill
@@ -190,6 +206,11 @@ class HashJoinBridge : public JoinBridge {
   // memory and engages in recursive spilling.
   IterableSpillPartitionSet spillPartitionSet_;
 
+  // The total spilled probe input bytes of each spilled table partition
+  // reported by the probe operators. A partition with zero bytes has no probe
+  // input and might be skipped from restoring.
+  std::map<SpillPartitionId, uint64_t> probeSpilledBytes_;
+
   // A flag indicating if any probe operator has poked 'this' join bridge to
   // attempt to get table. It is reset after probe side finish the (sub) table
   // processing.
@@ -37,8 +37,18 @@ HashPartitionFunction::HashPartitionFunction(
     int numPartitions,
     const RowTypePtr& inputType,
     const std::vector<column_index_t>& keyChannels,
-    const std::vector<VectorPtr>& constValues)
-    : localExchange_{localExchange}, numPartitions_{numPartitions} {
+    const std::vector<VectorPtr>& constValues,
+    const SkewedKeys& skewedKeys)
+    : localExchange_{localExchange},
+      numPartitions_{numPartitions},
+      skewedHashes_{
+          skewedKeys.empty() ? folly::F14FastSet<uint64_t>{}
+                             : folly::F14FastSet<uint64_t>(
+                                   skewedKeys.hashes.begin(),
+                                   skewedKeys.hashes.end())},
+      spreadFactor_{std::min(skewedKeys.spreadFactor, numPartitions)},
+      replicate_{skewedKeys.replicate && !skewedHashes_.empty()} {
+  VELOX_CHECK_GT(skewedKeys.spreadFactor, 0);
   init(inputType, keyChannels, constValues);
 }
 
@@ -49,7 +59,9 @@ HashPartitionFunction::HashPartitionFunction(
     const std::vector<VectorPtr>& constValues)
     : localExchange_{false},
       numPartitions_{hashBitRange.numPartitions()},
-      hashBitRange_(hashBitRange) {
+      hashBitRange_(hashBitRange),
+      spreadFactor_{1},
+      replicate_{false} {
   VELOX_CHECK_GT(hashBitRange.numPartitions(), 0);
   VELOX_CHECK(!keyChannels.empty());
   init(inputType, keyChannels, constValues);
@@ -73,13 +85,7 @@ void HashPartitionFunction::init(
   }
 }
 
-std::optional<uint32_t> HashPartitionFunction::partition(
-    const RowVector& input,
-    std::vector<uint32_t>& partitions) {
-  if (hashers_.empty()) {
-    return 0u;
-  }
-
+void HashPartitionFunction::computeHashes(const RowVector& input) {
   const auto size = input.size();
   rows_.resize(size);
   rows_.setAll();
@@ -94,7 +100,41 @@ std::optional<uint32_t> HashPartitionFunction::partition(
       hashers_[i]->hashPrecomputed(rows_, i > 0, hashes_);
     }
   }
+}
+
+std::vector<uint64_t> HashPartitionFunction::hashKeys(const RowVector& input) {
+  VELOX_CHECK(!hashers_.empty());
+  computeHashes(input);
+  return std::vector<uint64_t>(hashes_.begin(), hashes_.end());
+}
+
+void HashPartitionFunction::spreadSkewedKeys(
+    std::vector<uint32_t>& partitions) {
+  const auto size = partitions.size();
+  for (auto i = 0; i < size; ++i) {
+    if (!skewedHashes_.contains(hashes_[i])) {
+      continue;
+    }
+    if (replicate_) {
+      replicatedRows_.push_back(i);
+    } else {
+      partitions[i] = (partitions[i] + nextSpread_) % numPartitions_;
+      nextSpread_ = (nextSpread_ + 1) % spreadFactor_;
+    }
+  }
+}
+
+std::optional<uint32_t> HashPartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  replicatedRows_.clear();
+  if (hashers_.empty()) {
+    return 0u;
+  }
 
+  computeHashes(input);
+
+  const auto size = input.size();
   partitions.resize(size);
   if (hashBitRange_.has_value()) {
     if (localExchange_) {
@@ -118,14 +158,46 @@ std::optional<uint32_t> HashPartitionFunction::partition(
     }
   }
 
+  if (!skewedHashes_.empty()) {
+    spreadSkewedKeys(partitions);
+  }
   return std::nullopt;
 }
 
+folly::dynamic SkewedKeys::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  // The hashes use all 64 bits, so they are stored as int64.
+  folly::dynamic serializedHashes = folly::dynamic::array;
+  for (const auto hash : hashes) {
+    serializedHashes.push_back(static_cast<int64_t>(hash));
+  }
+  obj["hashes"] = std::move(serializedHashes);
+  obj["spreadFactor"] = spreadFactor;
+  obj["replicate"] = replicate;
+  return obj;
+}
+
+// static
+SkewedKeys SkewedKeys::deserialize(const folly::dynamic& obj) {
+  SkewedKeys skewedKeys;
+  for (const auto& hash : obj["hashes"]) {
+    skewedKeys.hashes.push_back(static_cast<uint64_t>(hash.asInt()));
+  }
+  skewedKeys.spreadFactor = obj["spreadFactor"].asInt();
+  skewedKeys.replicate = obj["replicate"].asBool();
+  return skewedKeys;
+}
+
 std::unique_ptr<core::PartitionFunction> HashPartitionFunctionSpec::create(
     int numPartitions,
     bool localExchange) const {
   return std::make_unique<exec::HashPartitionFunction>(
-      localExchange, numPartitions, inputType_, keyChannels_, constValues_);
+      localExchange,
+      numPartitions,
+      inputType_,
+      keyChannels_,
+      constValues_,
+      skewedKeys_);
 }
 
 std::string HashPartitionFunctionSpec::toString() const {
@@ -143,6 +215,14 @@ std::string HashPartitionFunctionSpec::toString() const {
     }
   }
 
+  if (!skewedKeys_.empty()) {
+    return fmt::format(
+        "HASH({}) SKEWED({} keys, {} {})",
+        keys.str(),
+        skewedKeys_.hashes.size(),
+        skewedKeys_.replicate ? "replicate" : "spread",
+        skewedKeys_.spreadFactor);
+  }
   return fmt::format("HASH({})", keys.str());
 }
 
@@ -158,6 +238,9 @@ folly::dynamic HashPartitionFunctionSpec::serialize() const {
     constValues.emplace_back(value);
   }
   obj["constants"] = ISerializable::serialize(constValues);
+  if (!skewedKeys_.empty()) {
+    obj["skewedKeys"] = skewedKeys_.serialize();
+  }
   return obj;
 }
 
@@ -177,7 +260,14 @@ core::PartitionFunctionSpecPtr HashPartitionFunctionSpec::deserialize(
   for (const auto& value : constTypeExprs) {
     constValues.emplace_back(value->toConstantVector(pool));
   }
+  SkewedKeys skewedKeys;
+  if (obj.count("skewedKeys")) {
+    skewedKeys = SkewedKeys::deserialize(obj["skewedKeys"]);
+  }
   return std::make_shared<HashPartitionFunctionSpec>(
-      ISerializable::deserialize<RowType>(obj["inputType"]), keys, constValues);
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      keys,
+      constValues,
+      std::move(skewedKeys));
 }
 } // namespace facebook::velox::exec
@@ -15,12 +15,42 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
 #include <velox/exec/HashBitRange.h>
 #include <velox/exec/VectorHasher.h>
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::exec {
 
+/// The hot keys of a skewed hash shuffle, e.g. the most frequent join keys
+/// from the column statistics. A hot key is identified by the hash of its
+/// partition keys, see HashPartitionFunction::hashKeys(). The rows of a hot key
+/// go to 'spreadFactor' consecutive partitions, wrapping around, starting at
+/// the partition of its hash. If 'replicate' is true, each row goes to all of
+/// them, e.g. on the build side of a join. Otherwise, the rows are spread
+/// round robin, e.g. on the probe side. Both sides of a join must use the same
+/// hot keys and spread factor.
+///
+/// NOTE: Replicating the build side is only correct for joins which output
+/// build rows only together with matching probe rows: inner, left, left semi
+/// and anti joins. Right, full and right semi joins output build rows on their
+/// own, e.g. the unmatched rows of a right join, and would output each
+/// replicated build row once per replica. The partition function does not know
+/// the join type, so the plan must not set 'replicate' for those joins.
+struct SkewedKeys {
+  std::vector<uint64_t> hashes;
+  int32_t spreadFactor{1};
+  bool replicate{false};
+
+  bool empty() const {
+    return hashes.empty() || spreadFactor <= 1;
+  }
+
+  folly::dynamic serialize() const;
+
+  static SkewedKeys deserialize(const folly::dynamic& obj);
+};
+
 /// Calculates partition number for each row of the specified vector using a
 /// hash function. The constructor with hashBitRange parameter requires both
 /// hashBitRange and keyChannels to be non-empty. The constructor with
@@ -34,7 +64,8 @@ class HashPartitionFunction : public core::PartitionFunction {
       int numPartitions,
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
-      const std::vector<VectorPtr>& constValues = {});
+      const std::vector<VectorPtr>& constValues = {},
+      const SkewedKeys& skewedKeys = {});
 
   HashPartitionFunction(
       const HashBitRange& hashBitRange,
@@ -48,21 +79,46 @@ class HashPartitionFunction : public core::PartitionFunction {
       const RowVector& input,
       std::vector<uint32_t>& partitions) override;
 
+  const std::vector<vector_size_t>& replicatedRows() const override {
+    return replicatedRows_;
+  }
+
+  int32_t numReplicas() const override {
+    return replicate_ ? spreadFactor_ : 1;
+  }
+
   int numPartitions() const {
     return numPartitions_;
   }
 
+  /// Returns the hashes of the partition keys of the rows of 'input', e.g. to
+  /// identify the hot keys of a SkewedKeys.
+  std::vector<uint64_t> hashKeys(const RowVector& input);
+
  private:
   void init(
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
       const std::vector<VectorPtr>& constValues);
 
+  // Sets 'hashes_' to the hashes of the partition keys of 'input'.
+  void computeHashes(const RowVector& input);
+
+  // Spreads or replicates the rows of the hot keys.
+  void spreadSkewedKeys(std::vector<uint32_t>& partitions);
+
   const bool localExchange_;
   const int numPartitions_;
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
+  const folly::F14FastSet<uint64_t> skewedHashes_;
+  const int32_t spreadFactor_;
+  const bool replicate_;
+  // The next of 'spreadFactor_' partitions to send a hot key row to.
+  uint32_t nextSpread_{0};
+  std::vector<vector_size_t> replicatedRows_;
+
   // Reusable memory.
   SelectivityVector rows_;
   raw_vector<uint64_t> hashes_;
@@ -78,10 +134,12 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   HashPartitionFunctionSpec(
       RowTypePtr inputType,
       std::vector<column_index_t> keyChannels,
-      std::vector<VectorPtr> constValues = {})
+      std::vector<VectorPtr> constValues = {},
+      SkewedKeys skewedKeys = {})
       : inputType_{std::move(inputType)},
         keyChannels_{std::move(keyChannels)},
-        constValues_{std::move(constValues)} {}
+        constValues_{std::move(constValues)},
+        skewedKeys_{std::move(skewedKeys)} {}
 
   std::unique_ptr<core::PartitionFunction> create(
       int numPartitions,
@@ -95,9 +153,18 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
       const folly::dynamic& obj,
       void* context);
 
+  const std::vector<column_index_t>& keyChannels() const {
+    return keyChannels_;
+  }
+
+  const SkewedKeys& skewedKeys() const {
+    return skewedKeys_;
+  }
+
  private:
   const RowTypePtr inputType_;
   const std::vector<column_index_t> keyChannels_;
   const std::vector<VectorPtr> constValues_;
+  const SkewedKeys skewedKeys_;
 };
 } // namespace facebook::velox::exec
@@ -18,6 +18,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -274,9 +275,15 @@ void HashProbe::maybeSetupInputSpiller(
   // partition set accordingly.
   if (noMoreSpillInput_) {
     inputSpiller_->finishSpill(inputSpillPartitionSet_);
+    reportInputSpillPartitions();
   }
 }
 
+void HashProbe::reportInputSpillPartitions() {
+  joinBridge_->addProbeSpilledPartitions(
+      inputSpillPartitionSet_, spillInputPartitionIds_);
+}
+
 void HashProbe::maybeSetupSpillInputReader(
     const std::optional<SpillPartitionId>& restoredPartitionId) {
   VELOX_CHECK_NULL(spillInputReader_);
@@ -394,11 +401,19 @@ void HashProbe::pushdownDynamicFilters() {
           if (!filter) {
             return false;
           }
-          auto* bloomFilter =
-              checkedPointerCast<const common::BigintValuesUsingBloomFilter>(
-                  filter.get());
-          addRuntimeStat(
-              "bloomFilterSize", RuntimeCounter(bloomFilter->blocksByteSize()));
+          int64_t bloomFilterSize;
+          if (filter->kind() ==
+              common::FilterKind::kBytesValuesUsingBloomFilter) {
+            bloomFilterSize =
+                filter->as<common::BytesValuesUsingBloomFilter>()
+                    ->blocksByteSize();
+          } else {
+            bloomFilterSize =
+                checkedPointerCast<const common::BigintValuesUsingBloomFilter>(
+                    filter.get())
+                    ->blocksByteSize();
+          }
+          addRuntimeStat("bloomFilterSize", RuntimeCounter(bloomFilterSize));
         }
         dynamicFiltersProducedOnChannels_.insert(sourceChannel);
         for (auto* peer : findPeerOperators()) {
@@ -515,13 +530,30 @@ void HashProbe::prepareForSpillRestore() {
     return;
   }
   // Notify the hash build operators to build the next hash table.
-  joinBridge_->probeFinished();
+  const auto skippedPartitionIds = joinBridge_->probeFinished(
+      /*restart=*/false, canSkipEmptySpillPartitions());
+  removeSkippedSpillPartitions(skippedPartitionIds);
 
   wakeupPeerOperators();
 
   lastProber_ = false;
 }
 
+void HashProbe::removeSkippedSpillPartitions(
+    const SpillPartitionIdSet& skippedPartitionIds) {
+  if (skippedPartitionIds.empty()) {
+    return;
+  }
+  addRuntimeStat(
+      kSkippedSpillPartitions, RuntimeCounter(skippedPartitionIds.size()));
+  // NOTE: the peer operators are all blocked waiting for the last prober.
+  for (auto* probeOp : findPeerOperators()) {
+    for (const auto& id : skippedPartitionIds) {
+      VELOX_CHECK_EQ(probeOp->inputSpillPartitionSet_.erase(id), 1);
+    }
+  }
+}
+
 void HashProbe::wakeupPeerOperators() {
   VELOX_CHECK(lastProber_);
   auto promises = std::move(promises_);
@@ -791,13 +823,7 @@ void HashProbe::prepareOutput(vector_size_t size) {
   // We expect output vectors containing probe-side data to be null (reset in
   // clearIdentityProjectedOutput). BaseVector::prepareForReuse keeps null
   // children unmodified and makes non-null (build side) children reusable.
-  if (output_) {
-    VectorPtr output = std::move(output_);
-    BaseVector::prepareForReuse(output, size);
-    output_ = std::static_pointer_cast<RowVector>(output);
-  } else {
-    output_ = BaseVector::create<RowVector>(outputType_, size, pool());
-  }
+  prepareReusableOutput(output_, size);
 }
 
 namespace {
@@ -986,7 +1012,7 @@ bool HashProbe::canSpill() const {
   // Hash table caching is incompatible with spilling. When the table is
   // cached and shared across tasks, clearing it after probe would corrupt
   // the cache for subsequent tasks.
-  if (joinNode_->useHashTableCache()) {
+  if (shareHashTable(*joinNode_, operatorCtx_->driverCtx()->queryConfig())) {
     return false;
   }
   if (operatorCtx_->task()->hasMixedExecutionGroupJoin(joinNode_.get())) {
@@ -998,6 +1024,16 @@ bool HashProbe::canSpill() const {
   return true;
 }
 
+bool HashProbe::canSkipEmptySpillPartitions() const {
+  if (nullAware_ ||
+      operatorCtx_->task()->hasMixedExecutionGroupJoin(joinNode_.get())) {
+    return false;
+  }
+  return isInnerJoin(joinType_) || isLeftJoin(joinType_) ||
+      isLeftSemiFilterJoin(joinType_) || isLeftSemiProjectJoin(joinType_) ||
+      isAntiJoin(joinType_) || isRightSemiFilterJoin(joinType_);
+}
+
 bool HashProbe::hasMoreSpillData() const {
   VELOX_CHECK(inputSpillPartitionSet_.empty() || canSpill());
   return !inputSpillPartitionSet_.empty() || needToSpillInput();
@@ -1088,7 +1124,13 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
 
     if (hasMoreSpillData()) {
       prepareForSpillRestore();
-      asyncWaitForHashTable();
+      if (hasMoreSpillData()) {
+        asyncWaitForHashTable();
+      } else {
+        // All the remaining spilled partitions have been skipped by the join
+        // bridge as they have no probe input.
+        setState(ProbeOperatorState::kFinish);
+      }
     } else {
       if (lastProber_ && canSpill()) {
         if (operatorCtx_->task()->hasMixedExecutionGroupJoin(joinNode_.get())) {
@@ -1744,6 +1786,7 @@ void HashProbe::noMoreInputInternal() {
         inputSpiller_->state().spilledPartitionIdSet().size());
     inputSpiller_->finishSpill(inputSpillPartitionSet_);
     VELOX_CHECK_EQ(spillStats_->rlock()->spillSortTimeNanos, 0);
+    reportInputSpillPartitions();
   }
 
   std::vector<ContinuePromise> promises;
@@ -1861,7 +1904,9 @@ void HashProbe::ensureOutputFits() {
 }
 
 bool HashProbe::canReclaim() const {
-  return canSpill() && !exceededMaxSpillLevelLimit_;
+  // A key set table holds no rows to spill.
+  return canSpill() && !exceededMaxSpillLevelLimit_ &&
+      (table_ == nullptr || !table_->isKeySet());
 }
 
 void HashProbe::reclaim(
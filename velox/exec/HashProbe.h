@@ -26,6 +26,11 @@ namespace facebook::velox::exec {
 // Probes a hash table made by HashBuild.
 class HashProbe : public Operator {
  public:
+  /// The number of spilled table partitions skipped from restoring as they
+  /// have no spilled probe input. Reported by the last prober.
+  static inline const std::string kSkippedSpillPartitions{
+      "skippedSpillPartitions"};
+
   HashProbe(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -259,6 +264,21 @@ class HashProbe : public Operator {
   // the current probe inputs.
   bool hasMoreSpillData() const;
 
+  // Indicates if a spilled table partition without any spilled probe input can
+  // be skipped from restoring. This applies to the join types which produce no
+  // output for a table partition without probe input.
+  bool canSkipEmptySpillPartitions() const;
+
+  // Invoked after the operator finishes spilling its input to report the
+  // spilled probe bytes of each spilled partition to the join bridge.
+  void reportInputSpillPartitions();
+
+  // Invoked by the last prober to drop the spilled table partitions skipped by
+  // the join bridge from the spilled input partitions of all the peer
+  // operators.
+  void removeSkippedSpillPartitions(
+      const SpillPartitionIdSet& skippedPartitionIds);
+
   // Indicates if the operator needs to spill probe inputs. It is true if parts
   // of the build-side rows have been spilled. Hence, the probe operator needs
   // to spill the corresponding probe-side rows as well.
@@ -69,6 +69,7 @@ HashTable<ignoreNullKeys>::HashTable(
       hashMode_ = HashMode::kHash;
     }
   }
+  keyLayout_ = keyLayout(hashers_);
 
   rows_ = std::make_unique<RowContainer>(
       keys,
@@ -378,6 +379,118 @@ bool HashTable<ignoreNullKeys>::compareKeys(
   return true;
 }
 
+namespace {
+// Returns true if the BIGINT key at 'column' of 'group' equals the key at
+// 'row' of 'decoded'. A null is equal to a null only.
+template <bool mayHaveNulls>
+FOLLY_ALWAYS_INLINE bool bigintKeyEquals(
+    const char* group,
+    RowColumn column,
+    const DecodedVector& decoded,
+    vector_size_t row) {
+  if constexpr (mayHaveNulls) {
+    const bool groupIsNull = RowContainer::isNullAt(group, column);
+    const bool rowIsNull = decoded.isNullAt(row);
+    if (groupIsNull || rowIsNull) {
+      return groupIsNull == rowIsNull;
+    }
+  }
+  return *reinterpret_cast<const int64_t*>(group + column.offset()) ==
+      decoded.valueAt<int64_t>(row);
+}
+
+// Same as bigintKeyEquals() for a string key. Only strings that are not
+// inlined in their StringView go through the general RowContainer compare,
+// since their stored value may span multiple allocations.
+template <bool mayHaveNulls>
+FOLLY_ALWAYS_INLINE bool stringKeyEquals(
+    const RowContainer& rows,
+    const char* group,
+    RowColumn column,
+    const DecodedVector& decoded,
+    vector_size_t row) {
+  if constexpr (mayHaveNulls) {
+    const bool groupIsNull = RowContainer::isNullAt(group, column);
+    const bool rowIsNull = decoded.isNullAt(row);
+    if (groupIsNull || rowIsNull) {
+      return groupIsNull == rowIsNull;
+    }
+  }
+  const auto stored =
+      *reinterpret_cast<const StringView*>(group + column.offset());
+  const auto value = decoded.valueAt<StringView>(row);
+  if (stored.size() != value.size()) {
+    return false;
+  }
+  if (stored.isInline()) {
+    return stored == value;
+  }
+  return rows.compare<false>(
+             group,
+             column,
+             decoded,
+             row,
+             CompareFlags::equality(
+                 CompareFlags::NullHandlingMode::kNullAsValue)) == 0;
+}
+} // namespace
+
+template <bool ignoreNullKeys>
+typename HashTable<ignoreNullKeys>::KeyLayout
+HashTable<ignoreNullKeys>::keyLayout(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers) {
+  const auto isKind = [&](int32_t i, TypeKind kind) {
+    const auto& type = hashers[i]->type();
+    return type->kind() == kind && !type->providesCustomComparison();
+  };
+  if (hashers.size() == 1) {
+    if (isKind(0, TypeKind::BIGINT)) {
+      return KeyLayout::kOneBigint;
+    }
+    if (isKind(0, TypeKind::VARCHAR) || isKind(0, TypeKind::VARBINARY)) {
+      return KeyLayout::kOneString;
+    }
+  } else if (
+      hashers.size() == 2 && isKind(0, TypeKind::BIGINT) &&
+      isKind(1, TypeKind::BIGINT)) {
+    return KeyLayout::kTwoBigints;
+  }
+  return KeyLayout::kGeneric;
+}
+
+template <bool ignoreNullKeys>
+template <typename HashTable<ignoreNullKeys>::KeyLayout layout>
+FOLLY_ALWAYS_INLINE bool HashTable<ignoreNullKeys>::compareKeys(
+    const char* group,
+    HashLookup& lookup,
+    vector_size_t row) {
+  constexpr bool mayHaveNulls = !ignoreNullKeys;
+  if constexpr (layout == KeyLayout::kOneBigint) {
+    return bigintKeyEquals<mayHaveNulls>(
+        group, rows_->columnAt(0), lookup.hashers[0]->decodedVector(), row);
+  } else if constexpr (layout == KeyLayout::kTwoBigints) {
+    return bigintKeyEquals<mayHaveNulls>(
+               group,
+               rows_->columnAt(0),
+               lookup.hashers[0]->decodedVector(),
+               row) &&
+        bigintKeyEquals<mayHaveNulls>(
+               group,
+               rows_->columnAt(1),
+               lookup.hashers[1]->decodedVector(),
+               row);
+  } else if constexpr (layout == KeyLayout::kOneString) {
+    return stringKeyEquals<mayHaveNulls>(
+        *rows_,
+        group,
+        rows_->columnAt(0),
+        lookup.hashers[0]->decodedVector(),
+        row);
+  } else {
+    return compareKeys(group, lookup, row);
+  }
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::compareKeys(
     const char* group,
@@ -393,7 +506,10 @@ bool HashTable<ignoreNullKeys>::compareKeys(
 }
 
 template <bool ignoreNullKeys>
-template <bool isJoin, bool isNormalizedKey>
+template <
+    bool isJoin,
+    bool isNormalizedKey,
+    typename HashTable<ignoreNullKeys>::KeyLayout layout>
 FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
     HashLookup& lookup,
     ProbeState& state,
@@ -420,7 +536,9 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
   lookup.hits[state.row()] = state.fullProbe<op>(
       *this,
       0,
-      [&](char* group, int32_t row) { return compareKeys(group, lookup, row); },
+      [&](char* group, int32_t row) INLINE_LAMBDA {
+        return compareKeys<layout>(group, lookup, row);
+      },
       [&](int32_t row, uint64_t index) {
         return isJoin ? nullptr : insertEntry(lookup, index, row);
       },
@@ -483,6 +601,25 @@ void HashTable<ignoreNullKeys>::groupProbe(
     groupNormalizedKeyProbe(lookup);
     return;
   }
+  switch (keyLayout_) {
+    case KeyLayout::kOneBigint:
+      hashGroupProbe<KeyLayout::kOneBigint>(lookup);
+      break;
+    case KeyLayout::kTwoBigints:
+      hashGroupProbe<KeyLayout::kTwoBigints>(lookup);
+      break;
+    case KeyLayout::kOneString:
+      hashGroupProbe<KeyLayout::kOneString>(lookup);
+      break;
+    case KeyLayout::kGeneric:
+      hashGroupProbe<KeyLayout::kGeneric>(lookup);
+      break;
+  }
+}
+
+template <bool ignoreNullKeys>
+template <typename HashTable<ignoreNullKeys>::KeyLayout layout>
+void HashTable<ignoreNullKeys>::hashGroupProbe(HashLookup& lookup) {
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -505,16 +642,16 @@ void HashTable<ignoreNullKeys>::groupProbe(
     state3.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
     state4.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
 
-    fullProbe<false>(lookup, state1, false);
-    fullProbe<false>(lookup, state2, true);
-    fullProbe<false>(lookup, state3, true);
-    fullProbe<false>(lookup, state4, true);
+    fullProbe<false, false, layout>(lookup, state1, false);
+    fullProbe<false, false, layout>(lookup, state2, true);
+    fullProbe<false, false, layout>(lookup, state3, true);
+    fullProbe<false, false, layout>(lookup, state4, true);
   }
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
     state1.firstProbe(*this, 0);
-    fullProbe<false>(lookup, state1, false);
+    fullProbe<false, false, layout>(lookup, state1, false);
   }
 }
 
@@ -605,6 +742,14 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
   }
 }
 
+namespace {
+// Returned as the hit of a probe key which is present in a key set table.
+char* keySetHit() {
+  static char hit;
+  return &hit;
+}
+} // namespace
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
@@ -617,6 +762,25 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
+  switch (keyLayout_) {
+    case KeyLayout::kOneBigint:
+      hashJoinProbe<KeyLayout::kOneBigint>(lookup);
+      break;
+    case KeyLayout::kTwoBigints:
+      hashJoinProbe<KeyLayout::kTwoBigints>(lookup);
+      break;
+    case KeyLayout::kOneString:
+      hashJoinProbe<KeyLayout::kOneString>(lookup);
+      break;
+    case KeyLayout::kGeneric:
+      hashJoinProbe<KeyLayout::kGeneric>(lookup);
+      break;
+  }
+}
+
+template <bool ignoreNullKeys>
+template <typename HashTable<ignoreNullKeys>::KeyLayout layout>
+void HashTable<ignoreNullKeys>::hashJoinProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
@@ -637,16 +801,16 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     state2.firstProbe(*this, 0);
     state3.firstProbe(*this, 0);
     state4.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-    fullProbe<true>(lookup, state2, false);
-    fullProbe<true>(lookup, state3, false);
-    fullProbe<true>(lookup, state4, false);
+    fullProbe<true, false, layout>(lookup, state1, false);
+    fullProbe<true, false, layout>(lookup, state2, false);
+    fullProbe<true, false, layout>(lookup, state3, false);
+    fullProbe<true, false, layout>(lookup, state4, false);
   }
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
     state1.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
+    fullProbe<true, false, layout>(lookup, state1, false);
   }
 }
 
@@ -657,6 +821,15 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
   auto hashes = lookup.hashes.data();
   auto hits = lookup.hits.data();
   auto numRows = rows.size();
+  if (keySet_ != nullptr) {
+    const auto* rawKeySet = keySet_->as<uint64_t>();
+    for (auto row : rows) {
+      VELOX_DCHECK_LT(hashes[row], capacity_);
+      hits[row] =
+          bits::isBitSet(rawKeySet, hashes[row]) ? keySetHit() : nullptr;
+    }
+    return;
+  }
   int32_t i = 0;
   constexpr int32_t kBatchSize = xsimd::batch<int64_t>::size;
   constexpr int32_t kStep = kBatchSize * 2;
@@ -727,6 +900,47 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::allocateTables(
     uint64_t size,
     int8_t spillInputStartPartitionBit) {
+  setTableSize(size, spillInputStartPartitionBit);
+  // The total size is 8 bytes per slot, in groups of 16 slots with 16 bytes of
+  // tags and 16 * 6 bytes of pointers and a padding of 16 bytes to round up the
+  // cache line.
+  const auto numPages =
+      memory::AllocationTraits::numPages(size * tableSlotSize());
+  // A group-by table keeps growing with the input, so it reserves addresses
+  // for growing in place. The reserved addresses take no memory.
+  const auto maxPages =
+      isJoinBuild_ ? 0 : numPages * kGroupByTableAddressReserveFactor;
+  rows_->pool()->allocateContiguous(
+      numPages, tableAllocation_, maxPages, /*hugePages=*/true);
+  table_ = tableAllocation_.data<char*>();
+  ::memset(table_, 0, capacity_ * sizeof(char*));
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::growTables(
+    uint64_t size,
+    int8_t spillInputStartPartitionBit) {
+  const auto numPages =
+      memory::AllocationTraits::numPages(size * tableSlotSize());
+  if (isJoinBuild_ || table_ == nullptr ||
+      tableAllocation_.maxSize() <
+          memory::AllocationTraits::pageBytes(numPages)) {
+    allocateTables(size, spillInputStartPartitionBit);
+    return;
+  }
+  if (numPages > tableAllocation_.numPages()) {
+    rows_->pool()->growContiguous(
+        numPages - tableAllocation_.numPages(), tableAllocation_);
+  }
+  setTableSize(size, spillInputStartPartitionBit);
+  // The rehash inserts all the rows again.
+  ::memset(table_, 0, capacity_ * sizeof(char*));
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::setTableSize(
+    uint64_t size,
+    int8_t spillInputStartPartitionBit) {
   VELOX_CHECK(bits::isPowerOfTwo(size), "Size is not a power of two: {}", size);
   VELOX_CHECK_GT(size, 0);
   capacity_ = size;
@@ -738,14 +952,30 @@ void HashTable<ignoreNullKeys>::allocateTables(
   sizeBits_ = __builtin_popcountll(sizeMask_);
   checkHashBitsOverlap(spillInputStartPartitionBit);
   bucketOffsetMask_ = sizeMask_ & ~(kBucketSize - 1);
-  // The total size is 8 bytes per slot, in groups of 16 slots with 16 bytes of
-  // tags and 16 * 6 bytes of pointers and a padding of 16 bytes to round up the
-  // cache line.
-  const auto numPages =
-      memory::AllocationTraits::numPages(size * tableSlotSize());
-  rows_->pool()->allocateContiguous(numPages, tableAllocation_);
-  table_ = tableAllocation_.data<char*>();
-  ::memset(table_, 0, capacity_ * sizeof(char*));
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::convertToKeySet() {
+  if (!isJoinBuild_ || hashMode_ != HashMode::kArray || table_ == nullptr ||
+      keySet_ != nullptr || hasDuplicates_.check() ||
+      rows_->columnTypes().size() != hashers_.size() ||
+      rows_->probedFlagOffset() != 0) {
+    return false;
+  }
+  keySet_ = AlignedBuffer::allocate<bool>(capacity_, rows_->pool(), false);
+  auto* rawKeySet = keySet_->asMutable<uint64_t>();
+  for (int64_t i = 0; i < capacity_; ++i) {
+    if (table_[i] != nullptr) {
+      bits::setBit(rawKeySet, i);
+    }
+  }
+  // Only the key presence is needed from now on.
+  for (auto* rowContainer : allRows()) {
+    rowContainer->clear();
+  }
+  rows_->pool()->freeContiguous(tableAllocation_);
+  table_ = nullptr;
+  return true;
 }
 
 template <bool ignoreNullKeys>
@@ -753,6 +983,10 @@ void HashTable<ignoreNullKeys>::clear(bool freeTable) {
   for (auto* rowContainer : allRows()) {
     rowContainer->clear();
   }
+  if (keySet_ != nullptr) {
+    keySet_.reset();
+    capacity_ = 0;
+  }
   if (table_) {
     if (!freeTable) {
       // All modes have 8 bytes per slot.
@@ -799,7 +1033,7 @@ void HashTable<ignoreNullKeys>::checkSize(
     // NOTE: we need to plus one here as number itself could be power of two.
     const auto newCapacity = bits::nextPowerOfTwo(
         std::max(newNumDistincts, capacity_ - numTombstones_) + 1);
-    allocateTables(newCapacity, spillInputStartPartitionBit);
+    growTables(newCapacity, spillInputStartPartitionBit);
     rehash(initNormalizedKeys, spillInputStartPartitionBit);
   }
 }
@@ -850,21 +1084,49 @@ bool HashTable<ignoreNullKeys>::hashRows(
 
 namespace {
 
+template <typename T>
+using BloomFilterFor = std::conditional_t<
+    std::is_same_v<T, StringView>,
+    common::BytesValuesUsingBloomFilter,
+    common::BigintValuesUsingBloomFilter>;
+
+// Returns the key of 'row' at 'offset' in the form inserted into the bloom
+// filter. Inline strings and strings that do not fit in one block of the row
+// container are copied to 'storage', so that the result does not refer to a
+// temporary StringView.
+template <typename T>
+auto bloomFilterKey(const char* row, int32_t offset, std::string& storage) {
+  if constexpr (std::is_same_v<T, StringView>) {
+    const auto value = HashStringAllocator::contiguousString(
+        folly::loadUnaligned<StringView>(row + offset), storage);
+    if (value.isInline()) {
+      storage.assign(value.data(), value.size());
+      return std::string_view(storage);
+    }
+    return std::string_view(value.data(), value.size());
+  } else {
+    return folly::loadUnaligned<T>(row + offset);
+  }
+}
+
 template <typename T>
 void partitionBloomFilterRowsImpl(
     int32_t offset,
-    const common::BigintValuesUsingBloomFilter& filter,
+    const common::Filter& filter,
     const RowContainer& rowContainer,
     uint8_t partitionMask,
     RowPartitions& rowPartitions) {
+  const auto& typedFilter = *filter.as<BloomFilterFor<T>>();
   char* rows[kHashBatchSize];
   uint8_t partitions[kHashBatchSize];
+  std::string storage;
   RowContainerIterator iter;
   while (auto numRows = rowContainer.listRows(
              &iter, kHashBatchSize, RowContainer::kUnlimited, rows)) {
     for (int i = 0; i < numRows; ++i) {
-      auto value = folly::loadUnaligned<T>(rows[i] + offset);
-      partitions[i] = filter.blockIndex(value) & partitionMask;
+      partitions[i] =
+          typedFilter.blockIndex(bloomFilterKey<T>(rows[i], offset, storage)) &
+          partitionMask;
     }
     rowPartitions.appendPartitions(
         folly::Range<const uint8_t*>(partitions, numRows));
@@ -874,7 +1136,7 @@ void partitionBloomFilterRowsImpl(
 void partitionBloomFilterRows(
     const VectorHasher& hasher,
     int32_t offset,
-    const common::BigintValuesUsingBloomFilter& filter,
+    const common::Filter& filter,
     const RowContainer& rowContainer,
     uint8_t numPartitions,
     RowPartitions& rowPartitions) {
@@ -889,6 +1151,11 @@ void partitionBloomFilterRows(
       partitionBloomFilterRowsImpl<int64_t>(
           offset, filter, rowContainer, numPartitions - 1, rowPartitions);
       break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      partitionBloomFilterRowsImpl<StringView>(
+          offset, filter, rowContainer, numPartitions - 1, rowPartitions);
+      break;
     default:
       VELOX_UNREACHABLE();
   }
@@ -899,9 +1166,11 @@ void buildBloomFilterImpl(
     int32_t offset,
     char** rows,
     int numRows,
-    common::BigintValuesUsingBloomFilter& filter) {
+    common::Filter& filter) {
+  auto& typedFilter = *filter.as<BloomFilterFor<T>>();
+  std::string storage;
   for (int i = 0; i < numRows; ++i) {
-    filter.insert(folly::loadUnaligned<T>(rows[i] + offset));
+    typedFilter.insert(bloomFilterKey<T>(rows[i], offset, storage));
   }
 }
 
@@ -910,7 +1179,7 @@ void buildBloomFilter(
     int32_t offset,
     char** rows,
     int numRows,
-    common::BigintValuesUsingBloomFilter& filter) {
+    common::Filter& filter) {
   VELOX_DCHECK(hasher.supportsBloomFilter());
   switch (hasher.typeKind()) {
     case TypeKind::INTEGER:
@@ -919,11 +1188,32 @@ void buildBloomFilter(
     case TypeKind::BIGINT:
       buildBloomFilterImpl<int64_t>(offset, rows, numRows, filter);
       break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      buildBloomFilterImpl<StringView>(offset, rows, numRows, filter);
+      break;
     default:
       VELOX_UNREACHABLE();
   }
 }
 
+// Returns an empty bloom filter for the keys of 'hasher' with room for
+// 'capacity' distinct values.
+std::shared_ptr<common::Filter> makeBloomFilter(
+    const VectorHasher& hasher,
+    int64_t capacity) {
+  VELOX_DCHECK(hasher.supportsBloomFilter());
+  switch (hasher.typeKind()) {
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return std::make_shared<common::BytesValuesUsingBloomFilter>(
+          capacity, false);
+    default:
+      return std::make_shared<common::BigintValuesUsingBloomFilter>(
+          capacity, false);
+  }
+}
+
 template <typename Source>
 void syncWorkItems(
     std::vector<std::shared_ptr<Source>>& items,
@@ -984,11 +1274,18 @@ bool HashTable<ignoreNullKeys>::canApplyParallelJoinBuild() const {
   if (hashMode_ == HashMode::kArray) {
     return false;
   }
-  if (otherTables_.empty()) {
+  const auto numPartitions = numParallelBuildPartitions();
+  if (numPartitions <= 1) {
     return false;
   }
-  return (capacity_ / (1 + otherTables_.size())) >
-      minTableSizeForParallelJoinBuild_;
+  return (capacity_ / numPartitions) > minTableSizeForParallelJoinBuild_;
+}
+
+template <bool ignoreNullKeys>
+uint8_t HashTable<ignoreNullKeys>::numParallelBuildPartitions() const {
+  VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
+  return std::max<uint8_t>(
+      1 + otherTables_.size(), numParallelBuildPartitions_);
 }
 
 template <bool ignoreNullKeys>
@@ -996,8 +1293,8 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   process::TraceContext trace("HashTable::parallelJoinBuild");
   TestValue::adjust(
       "facebook::velox::exec::HashTable::parallelJoinBuild", rows_->pool());
-  VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
-  const uint8_t numPartitions = 1 + otherTables_.size();
+  const uint8_t numPartitions = numParallelBuildPartitions();
+  const size_t numTables = 1 + otherTables_.size();
   VELOX_CHECK_GT(
       capacity_ / numPartitions,
       minTableSizeForParallelJoinBuild_,
@@ -1078,16 +1375,16 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   // This step can involve large memory allocations, so there is a chance of
   // OOMs here. Do it before any async work is started to reduce the chances of
   // concurrency issues.
-  rowPartitions.reserve(numPartitions);
-  for (auto i = 0; i < numPartitions; ++i) {
+  rowPartitions.reserve(numTables);
+  for (auto i = 0; i < numTables; ++i) {
     auto* table = getTable(i);
     rowPartitions.push_back(table->rows()->createRowPartitions(*rows_->pool()));
   }
 
   // The parallel table partitioning step.
-  for (auto i = 0; i < numPartitions; ++i) {
+  for (auto i = 0; i < numTables; ++i) {
     auto* table = getTable(i);
-    bool last = i == numPartitions - 1;
+    bool last = i == numTables - 1;
     runStep(
         partitionSteps,
         [this, table, rawRowPartitions = rowPartitions[i].get()] {
@@ -1123,11 +1420,10 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
       if (!hashers_[i]->supportsBloomFilter()) {
         continue;
       }
-      auto filter = std::make_shared<common::BigintValuesUsingBloomFilter>(
-          numDistinct_, false);
+      auto filter = makeBloomFilter(*hashers_[i], numDistinct_);
       hashers_[i]->setBloomFilter(filter);
-      for (auto j = 0; j < numPartitions; ++j) {
-        bool last = j == numPartitions - 1;
+      for (auto j = 0; j < numTables; ++j) {
+        bool last = j == numTables - 1;
         auto* rows = getTable(j)->rows();
         rowPartitions[j]->reset();
         runStep(
@@ -1180,8 +1476,10 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
         folly::Range<char**>(overflows.data(), overflows.size()),
         false,
         hashes));
-    auto table = i == 0 ? this : otherTables_[i - 1].get();
     insertForJoin(overflows.data(), hashes.data(), overflows.size(), nullptr);
+  }
+  for (auto i = 0; i < numTables; ++i) {
+    auto* table = getTable(i);
     VELOX_CHECK_EQ(table->rows()->numRows(), table->numParallelBuildRows_);
   }
 }
@@ -1242,12 +1540,12 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
     std::vector<char*>& overflow) {
   raw_vector<char*> rows(kHashBatchSize, pool_);
   raw_vector<uint64_t> hashes(kHashBatchSize, pool_);
-  const int32_t numPartitions = 1 + otherTables_.size();
+  const int32_t numTables = 1 + otherTables_.size();
   TableInsertPartitionInfo partitionInfo{
       buildPartitionBounds_[partition],
       buildPartitionBounds_[partition + 1],
       overflow};
-  for (auto i = 0; i < numPartitions; ++i) {
+  for (auto i = 0; i < numTables; ++i) {
     auto* table = i == 0 ? this : otherTables_[i - 1].get();
     RowContainerIterator iter;
     while (
@@ -1269,8 +1567,8 @@ void HashTable<true>::buildBloomFilterPartition(
   for (auto i = 0; i < 1 + otherTables_.size(); ++i) {
     auto* table = i == 0 ? this : otherTables_[i - 1].get();
     auto rowColumn = table->rows_->columnAt(columnIndex);
-    auto* filter = checkedPointerCast<common::BigintValuesUsingBloomFilter>(
-        hashers_[columnIndex]->getBloomFilter().get());
+    auto* filter = hashers_[columnIndex]->getBloomFilter().get();
+    VELOX_CHECK_NOT_NULL(filter);
     RowContainerIterator iter;
     while (auto numRows = table->rows_->listPartitionRows(
                iter, partition, kHashBatchSize, *rowPartitions[i], rows)) {
@@ -1511,15 +1809,14 @@ void HashTable<ignoreNullKeys>::rehash(
   hashes.resize(kHashBatchSize);
   char* groups[kHashBatchSize];
   const bool shouldBuildBloomFilter = bloomFilterSupported();
-  std::vector<common::BigintValuesUsingBloomFilter*> bloomFilters;
+  std::vector<common::Filter*> bloomFilters;
   if (shouldBuildBloomFilter) {
     bloomFilters.resize(hashers_.size());
     for (int i = 0; i < hashers_.size(); ++i) {
       if (!hashers_[i]->supportsBloomFilter()) {
         continue;
       }
-      auto filter = std::make_shared<common::BigintValuesUsingBloomFilter>(
-          numDistinct_, false);
+      auto filter = makeBloomFilter(*hashers_[i], numDistinct_);
       bloomFilters[i] = filter.get();
       hashers_[i]->setBloomFilter(filter);
     }
@@ -1566,7 +1863,8 @@ void HashTable<ignoreNullKeys>::setHashMode(
   if (mode == HashMode::kArray) {
     const auto bytes = capacity_ * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
-    rows_->pool()->allocateContiguous(numPages, tableAllocation_);
+    rows_->pool()->allocateContiguous(
+        numPages, tableAllocation_, 0, /*hugePages=*/true);
     table_ = tableAllocation_.data<char*>();
     memset(table_, 0, bytes);
     hashMode_ = HashMode::kArray;
@@ -1952,8 +2250,10 @@ void HashTable<ignoreNullKeys>::prepareJoinTable(
     int8_t spillInputStartPartitionBit,
     size_t vectorHasherMaxNumDistinct,
     bool dropDuplicates,
-    folly::Executor* executor) {
+    folly::Executor* executor,
+    uint8_t numParallelBuildPartitions) {
   buildExecutor_ = executor;
+  numParallelBuildPartitions_ = numParallelBuildPartitions;
   if (dropDuplicates) {
     if (table_ != nullptr) {
       // Reset table_ and capacity_ to trigger rehash.
@@ -147,6 +147,7 @@ class BaseHashTable {
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
+  static inline const std::string kKeySetBytes{"hashtable.keySetBytes"};
   static inline const std::string kParallelJoinPartitionWallNanos{
       "hashtable.parallelJoinPartitionWallNanos"};
   static inline const std::string kParallelJoinPartitionCpuNanos{
@@ -346,12 +347,16 @@ class BaseHashTable {
       char** rows,
       const std::vector<std::unique_ptr<VectorHasher>>& hashers) = 0;
 
+  /// 'numParallelBuildPartitions' is the number of partitions of the table
+  /// that are built in parallel on 'executor'. If it is less than the number
+  /// of tables, there is one partition per table.
   virtual void prepareJoinTable(
       std::vector<std::unique_ptr<BaseHashTable>> tables,
       int8_t spillInputStartPartitionBit,
       size_t vectorHasherMaxNumDistinct,
       bool dropDuplicates = false,
-      folly::Executor* executor = nullptr) = 0;
+      folly::Executor* executor = nullptr,
+      uint8_t numParallelBuildPartitions = 0) = 0;
 
   /// The hash table used for join build in left semi and anti join may not
   /// retain duplicate join keys when allowDuplicates_ is false. This is
@@ -399,6 +404,16 @@ class BaseHashTable {
   /// Returns true if the hash table contains rows with duplicate keys.
   virtual bool hasDuplicateKeys() const = 0;
 
+  /// Converts a join table in array mode whose rows carry no payload into a
+  /// bitmap of the present keys and frees the rows. This applies to the left
+  /// semi and anti joins which only check if a probe key has a match. Returns
+  /// false if 'this' is not eligible. A converted table returns a non-null
+  /// placeholder for a hit which must not be dereferenced.
+  virtual bool convertToKeySet() = 0;
+
+  /// Returns true if convertToKeySet() has converted 'this'.
+  virtual bool isKeySet() const = 0;
+
   /// Returns the hash mode. This is needed for the caller to calculate
   /// the hash numbers using the appropriate method of the
   /// VectorHashers of 'this'.
@@ -550,17 +565,20 @@ class HashTable : public BaseHashTable {
 
   ~HashTable() override = default;
 
+  /// 'hasProbedFlag' reserves a bit in every group row, e.g. for tracking the
+  /// groups updated since the last partial aggregation flush.
   static std::unique_ptr<HashTable> createForAggregation(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool hasProbedFlag = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         accumulators,
         std::vector<TypePtr>{},
         false, // allowDuplicates
         false, // isJoinBuild
-        false, // hasProbedFlag
+        hasProbedFlag,
         0, // minTableSizeForParallelJoinBuild
         pool);
   }
@@ -675,6 +693,12 @@ class HashTable : public BaseHashTable {
     return hasDuplicates_.check();
   }
 
+  bool convertToKeySet() override;
+
+  bool isKeySet() const override {
+    return keySet_ != nullptr;
+  }
+
   void setAllowDuplicates(const bool allowDuplicates) override {
     allowDuplicates_ = allowDuplicates;
   }
@@ -705,7 +729,8 @@ class HashTable : public BaseHashTable {
       int8_t spillInputStartPartitionBit,
       size_t vectorHasherMaxNumDistinct,
       bool dropDuplicates = false,
-      folly::Executor* executor = nullptr) override;
+      folly::Executor* executor = nullptr,
+      uint8_t numParallelBuildPartitions = 0) override;
 
   void prepareForJoinProbe(
       HashLookup& lookup,
@@ -831,6 +856,10 @@ class HashTable : public BaseHashTable {
   static_assert(sizeof(Bucket) == 128);
   static constexpr uint64_t kBucketSize = sizeof(Bucket);
 
+  // A group-by table reserves addresses for this many times its size, so
+  // that it can double in place twice before being allocated anew.
+  static constexpr uint64_t kGroupByTableAddressReserveFactor = 4;
+
   // Returns the bucket at byte offset 'offset' from 'table_'.
   Bucket* bucketAt(int64_t offset) const {
     VELOX_DCHECK_EQ(0, offset & (kBucketSize - 1));
@@ -920,6 +949,17 @@ class HashTable : public BaseHashTable {
   // a power of 2.
   void allocateTables(uint64_t size, int8_t spillInputStartPartitionBit);
 
+  // Grows the tables to 'size' slots for a rehash. A group-by table grows in
+  // place inside the address range reserved by allocateTables() while it
+  // fits, so that the pages of the current table are neither unmapped nor
+  // faulted in again. Otherwise allocates new tables. The size must be a
+  // power of 2.
+  void growTables(uint64_t size, int8_t spillInputStartPartitionBit);
+
+  // Sets 'capacity_' and the masks and bits derived from it for a table of
+  // 'size' slots.
+  void setTableSize(uint64_t size, int8_t spillInputStartPartitionBit);
+
   // 'initNormalizedKeys' is passed to 'rehash' --> 'rehash' --> 'insertBatch'.
   // If it's false and the table is in normalized keys mode,
   // the keys are retrieved from the row and the hash is made
@@ -962,19 +1002,23 @@ class HashTable : public BaseHashTable {
   // Checks if we can apply parallel table build optimization for hash join.
   // The function returns true if all of the following conditions:
   // 1. the hash table is built for parallel join;
-  // 2. there is more than one sub-tables;
+  // 2. there is more than one build partition;
   // 3. the build executor has been set;
   // 4. the table is not in kArray mode;
   // 5. the number of table entries per each parallel build shard is no less
   //    than a pre-defined threshold: 1000 for now.
   bool canApplyParallelJoinBuild() const;
 
-  // Builds a join table with '1 + otherTables_.size()' independent
+  // Returns the number of partitions of the parallel join build. This is the
+  // larger of the number of tables and 'numParallelBuildPartitions_'.
+  uint8_t numParallelBuildPartitions() const;
+
+  // Builds a join table with numParallelBuildPartitions() independent
   // threads using 'executor_'. First all RowContainers get partition
-  // numbers assigned to each row. Next, all threads pick all rows
-  // assigned to their thread-specific partition and insert these. If
-  // a row would overflow past the end of its partition it is added to
-  // a set of overflow rows that are sequentially inserted after all
+  // numbers assigned to each row, one thread per RowContainer. Next, all
+  // threads pick all rows assigned to their thread-specific partition and
+  // insert these. If a row would overflow past the end of its partition it is
+  // added to a set of overflow rows that are sequentially inserted after all
   // else.
   void parallelJoinBuild();
 
@@ -1020,13 +1064,47 @@ class HashTable : public BaseHashTable {
 
   char* insertEntry(HashLookup& lookup, uint64_t index, vector_size_t row);
 
+  // Layouts of the keys for which the kHash mode probe loops are specialized.
+  // kGeneric compares each key through RowContainer::compare with a type
+  // dispatch per key and row. The others compare the values in place.
+  enum class KeyLayout {
+    kGeneric,
+    // A single BIGINT key.
+    kOneBigint,
+    // Two BIGINT keys.
+    kTwoBigints,
+    // A single VARCHAR or VARBINARY key. Strings of up to
+    // StringView::kInlineSize bytes are compared without a type dispatch.
+    kOneString,
+  };
+
+  // Returns the layout for keys hashed by 'hashers'. Types with custom
+  // comparison always use kGeneric.
+  static KeyLayout keyLayout(
+      const std::vector<std::unique_ptr<VectorHasher>>& hashers);
+
+  bool compareKeys(const char* group, HashLookup& lookup, vector_size_t row);
+
+  // Same as the above for keys of 'layout'.
+  template <KeyLayout layout>
   bool compareKeys(const char* group, HashLookup& lookup, vector_size_t row);
 
   bool compareKeys(const char* group, const char* inserted);
 
-  template <bool isJoin, bool isNormalizedKey = false>
+  template <
+      bool isJoin,
+      bool isNormalizedKey = false,
+      KeyLayout layout = KeyLayout::kGeneric>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
+  // Probe loops of groupProbe() and joinProbe() in kHash mode for keys of
+  // 'layout'.
+  template <KeyLayout layout>
+  void hashGroupProbe(HashLookup& lookup);
+
+  template <KeyLayout layout>
+  void hashJoinProbe(HashLookup& lookup);
+
   // Shortcut path for group by with normalized keys.
   void groupNormalizedKeyProbe(HashLookup& lookup);
 
@@ -1174,6 +1252,10 @@ class HashTable : public BaseHashTable {
   char** table_ = nullptr;
   memory::ContiguousAllocation tableAllocation_;
 
+  // Set by convertToKeySet() with one bit per array mode slot which replaces
+  // 'table_' and the rows.
+  BufferPtr keySet_;
+
   // Number of slots across all buckets.
   int64_t capacity_{0};
 
@@ -1191,6 +1273,8 @@ class HashTable : public BaseHashTable {
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
   HashMode hashMode_ = HashMode::kArray;
+  // Selects the compare code of the kHash mode probe loops.
+  KeyLayout keyLayout_{KeyLayout::kGeneric};
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
   std::vector<std::unique_ptr<HashTable<ignoreNullKeys>>> otherTables_;
@@ -1223,6 +1307,10 @@ class HashTable : public BaseHashTable {
   // execute the parallel build steps.
   folly::Executor* buildExecutor_{nullptr};
 
+  // Minimum number of partitions of the parallel join build. See
+  // numParallelBuildPartitions().
+  uint8_t numParallelBuildPartitions_{0};
+
   //  Counts parallel build rows. Used for consistency check.
   std::atomic<int64_t> numParallelBuildRows_{0};
 
@@ -16,12 +16,84 @@
 
 #include "velox/exec/HashTableCache.h"
 
+#include <algorithm>
+
 #include <fmt/format.h>
 
+#include "velox/common/memory/Memory.h"
 #include "velox/core/QueryCtx.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+
+// Returns true if all the leaves of 'node' are broadcast exchanges, i.e. every
+// task running 'node' sees the same rows.
+bool readsOnlyBroadcastExchanges(const core::PlanNode& node) {
+  if (const auto* exchange = dynamic_cast<const core::ExchangeNode*>(&node)) {
+    return exchange->isBroadcast();
+  }
+  const auto& sources = node.sources();
+  if (sources.empty()) {
+    return false;
+  }
+  return std::all_of(sources.begin(), sources.end(), [](const auto& source) {
+    return readsOnlyBroadcastExchanges(*source);
+  });
+}
+
+// Evicts unused cross-query hash tables when the memory arbitrator reclaims
+// from the memory pool of the cache.
+class HashTableCacheReclaimer : public memory::MemoryReclaimer {
+ public:
+  HashTableCacheReclaimer() : memory::MemoryReclaimer(0) {}
+
+  bool reclaimableBytes(
+      const memory::MemoryPool& /*pool*/,
+      uint64_t& reclaimableBytes) const override {
+    reclaimableBytes = HashTableCache::instance()->evictableBytes();
+    return true;
+  }
+
+  uint64_t reclaim(
+      memory::MemoryPool* /*pool*/,
+      uint64_t targetBytes,
+      uint64_t /*maxWaitMs*/,
+      Stats& stats) override {
+    return run(
+        [&]() -> int64_t {
+          return HashTableCache::instance()->evict(targetBytes);
+        },
+        stats);
+  }
+
+  void abort(memory::MemoryPool* /*pool*/, const std::exception_ptr& /*error*/)
+      override {
+    // The tables in use are released when the queries using them are aborted
+    // through their own pools.
+    HashTableCache::instance()->evict(0);
+  }
+};
+
+} // namespace
+
+bool shareHashTable(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& queryConfig) {
+  if (joinNode.useHashTableCache()) {
+    return true;
+  }
+  if (!queryConfig.hashJoinShareBroadcastBuild()) {
+    return false;
+  }
+  // These joins track the probed build rows, so their table is per task.
+  if (joinNode.isRightJoin() || joinNode.isFullJoin() ||
+      joinNode.isRightSemiFilterJoin() || joinNode.isRightSemiProjectJoin()) {
+    return false;
+  }
+  return readsOnlyBroadcastExchanges(*joinNode.sources()[1]);
+}
+
 HashTableCache* HashTableCache::instance() {
   static HashTableCache instance;
   return &instance;
@@ -36,28 +108,78 @@ std::shared_ptr<HashTableCacheEntry> HashTableCache::get(
   VELOX_CHECK_NOT_NULL(queryCtx, "queryCtx parameter must not be null");
 
   std::lock_guard<std::mutex> guard(lock_);
+  bool created{false};
+  auto entry = getLocked(
+      key,
+      taskId,
+      [&]() {
+        return queryCtx->pool()->addLeafChild(
+            fmt::format("cached_table_{}", key));
+      },
+      /*crossQuery=*/false,
+      future,
+      created);
+  if (created) {
+    // Register callback to clean up this cache entry when QueryCtx is
+    // destroyed. This ensures tablePool memory is freed before the query
+    // pool is destroyed.
+    queryCtx->addReleaseCallback(
+        [cacheKey = key]() { HashTableCache::instance()->drop(cacheKey); });
+  }
+  return entry;
+}
 
+std::shared_ptr<HashTableCacheEntry> HashTableCache::getCrossQuery(
+    const std::string& key,
+    const std::string& taskId,
+    ContinueFuture* future) {
+  VELOX_CHECK_NOT_NULL(future, "future parameter must not be null");
+  auto* cachePool = pool();
+
+  std::lock_guard<std::mutex> guard(lock_);
+  bool created{false};
+  return getLocked(
+      key,
+      taskId,
+      [&]() {
+        // An abandoned entry may still be referenced, so the pool name of a
+        // new entry for the same key must differ.
+        return cachePool->addLeafChild(
+            fmt::format("cached_table_{}_{}", key, useCounter_));
+      },
+      /*crossQuery=*/true,
+      future,
+      created);
+}
+
+std::shared_ptr<HashTableCacheEntry> HashTableCache::getLocked(
+    const std::string& key,
+    const std::string& taskId,
+    const std::function<std::shared_ptr<memory::MemoryPool>()>& makePool,
+    bool crossQuery,
+    ContinueFuture* future,
+    bool& created) {
   auto it = tables_.find(key);
   if (it == tables_.end()) {
     // No entry exists - create a placeholder for this task to build the table.
-    auto* queryPool = queryCtx->pool();
     auto entry = std::make_shared<HashTableCacheEntry>(
-        key,
-        taskId,
-        queryPool->addLeafChild(fmt::format("cached_table_{}", key)));
+        key, taskId, makePool(), crossQuery);
+    entry->lastUse = ++useCounter_;
     tables_.insert({key, entry});
-
-    // Register callback to clean up this cache entry when QueryCtx is
-    // destroyed. This ensures tablePool memory is freed before the query
-    // pool is destroyed.
-    queryCtx->addReleaseCallback(
-        [cacheKey = key]() { HashTableCache::instance()->drop(cacheKey); });
+    created = true;
 
     // Return entry with pool, table will be filled later.
     return entry;
   }
 
   auto& entry = it->second;
+  VELOX_CHECK_EQ(
+      entry->crossQuery,
+      crossQuery,
+      "Hash table cache key '{}' is used for both per-query and cross-query "
+      "caching",
+      key);
+  entry->lastUse = ++useCounter_;
 
   // Check if build is complete
   if (entry->buildComplete) {
@@ -130,4 +252,90 @@ void HashTableCache::drop(const std::string& key) {
   }
 }
 
+void HashTableCache::abandon(const std::string& key, const std::string& taskId) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = tables_.find(key);
+    if (it == tables_.end() || it->second->buildComplete ||
+        it->second->builderTaskId != taskId) {
+      return;
+    }
+    promises = std::move(it->second->buildPromises);
+    tables_.erase(it);
+  }
+
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+// static
+bool HashTableCache::isEvictable(
+    const std::shared_ptr<HashTableCacheEntry>& entry) {
+  // The entry is referenced only by the cache and its table only by the entry,
+  // i.e. no HashBuild or join bridge of a running query uses them.
+  return entry->crossQuery && entry->buildComplete &&
+      entry.use_count() == 1 &&
+      (entry->table == nullptr || entry->table.use_count() == 1);
+}
+
+uint64_t HashTableCache::evict(uint64_t targetBytes) {
+  std::vector<std::shared_ptr<HashTableCacheEntry>> victims;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    std::vector<HashTableCacheEntry*> candidates;
+    for (const auto& [key, entry] : tables_) {
+      if (isEvictable(entry)) {
+        candidates.push_back(entry.get());
+      }
+    }
+    std::sort(
+        candidates.begin(), candidates.end(), [](const auto* x, const auto* y) {
+          return x->lastUse < y->lastUse;
+        });
+    uint64_t evictedBytes = 0;
+    for (auto* candidate : candidates) {
+      if (targetBytes != 0 && evictedBytes >= targetBytes) {
+        break;
+      }
+      evictedBytes += candidate->tablePool->reservedBytes();
+      auto it = tables_.find(candidate->cacheKey);
+      victims.push_back(std::move(it->second));
+      tables_.erase(it);
+    }
+  }
+
+  // Free the tables outside the lock.
+  uint64_t freedBytes = 0;
+  for (auto& entry : victims) {
+    const auto reservedBytes = entry->tablePool->reservedBytes();
+    entry->table.reset();
+    freedBytes += reservedBytes - entry->tablePool->reservedBytes();
+  }
+  return freedBytes;
+}
+
+uint64_t HashTableCache::evictableBytes() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  uint64_t bytes = 0;
+  for (const auto& [key, entry] : tables_) {
+    if (isEvictable(entry)) {
+      bytes += entry->tablePool->reservedBytes();
+    }
+  }
+  return bytes;
+}
+
+memory::MemoryPool* HashTableCache::pool() {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (pool_ == nullptr) {
+    pool_ = memory::memoryManager()->addRootPool(
+        kPoolName,
+        memory::kMaxMemory,
+        std::make_unique<HashTableCacheReclaimer>());
+  }
+  return pool_.get();
+}
+
 } // namespace facebook::velox::exec
@@ -15,11 +15,14 @@
  */
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 
+#include "velox/core/PlanNode.h"
+#include "velox/core/QueryConfig.h"
 #include "velox/exec/HashTable.h"
 
 namespace facebook::velox::core {
@@ -33,26 +36,40 @@ struct HashTableCacheEntry {
   HashTableCacheEntry(
       std::string _cacheKey,
       std::string _builderTaskId,
-      std::shared_ptr<memory::MemoryPool> _tablePool)
+      std::shared_ptr<memory::MemoryPool> _tablePool,
+      bool _crossQuery = false)
       : cacheKey(std::move(_cacheKey)),
         builderTaskId(std::move(_builderTaskId)),
-        tablePool(std::move(_tablePool)) {}
+        tablePool(std::move(_tablePool)),
+        crossQuery(_crossQuery) {}
 
   const std::string cacheKey;
   const std::string builderTaskId;
   const std::shared_ptr<memory::MemoryPool> tablePool;
+  // True if the entry is shared across queries. See
+  // HashTableCache::getCrossQuery().
+  const bool crossQuery;
   std::shared_ptr<BaseHashTable> table;
   bool hasNullKeys{false};
   tsan_atomic<bool> buildComplete{false};
   std::vector<ContinuePromise> buildPromises;
+  // Sequence number of the last get() of the entry. Used to evict the least
+  // recently used cross-query entries first.
+  uint64_t lastUse{0};
 };
 
-/// Global cache for hash tables shared across tasks within the same query.
-/// First task builds the table, subsequent tasks wait and reuse it.
+/// Global cache for hash tables shared across tasks. Per-query entries are
+/// shared by the tasks of one query and dropped when the query completes.
+/// Cross-query entries are shared by all queries on the node and stay until
+/// evicted by the memory arbitrator. First task builds the table, subsequent
+/// tasks wait and reuse it.
 class HashTableCache {
  public:
   static HashTableCache* instance();
 
+  /// Name of the root memory pool of the cross-query entries.
+  static inline const std::string kPoolName{"hash_table_cache"};
+
   /// Gets or creates a cache entry. First caller becomes the builder.
   /// Subsequent callers from different tasks get a future to wait on.
   /// When a new entry is created, a release callback is registered on queryCtx
@@ -64,6 +81,16 @@ class HashTableCache {
       core::QueryCtx* queryCtx,
       ContinueFuture* future);
 
+  /// Gets or creates an entry that is shared across queries. Same as get()
+  /// except that the table is allocated from the memory pool of the cache
+  /// instead of the query pool and the entry outlives the query. 'key' must
+  /// identify both the build side plan and the data it reads, e.g. a
+  /// fingerprint of the build side plan plus the snapshot of its tables.
+  std::shared_ptr<HashTableCacheEntry> getCrossQuery(
+      const std::string& key,
+      const std::string& taskId,
+      ContinueFuture* future);
+
   /// Stores a built hash table and notifies waiting tasks.
   void put(
       const std::string& key,
@@ -73,11 +100,52 @@ class HashTableCache {
   /// Removes a cache entry.
   void drop(const std::string& key);
 
+  /// Removes the entry for 'key' if it is still being built by 'taskId', e.g.
+  /// because the builder task failed. The tasks waiting for the entry are
+  /// woken up and find it not built. Later queries build the table again.
+  void abandon(const std::string& key, const std::string& taskId);
+
+  /// Evicts cross-query entries that are built and not used by any running
+  /// query, least recently used first, until at least 'targetBytes' are freed.
+  /// Evicts all such entries if 'targetBytes' is 0. Returns the freed bytes.
+  uint64_t evict(uint64_t targetBytes);
+
+  /// Returns the bytes that evict() can free.
+  uint64_t evictableBytes() const;
+
+  /// Returns the root memory pool of the cross-query entries. It is created on
+  /// first use with a reclaimer that evicts entries on memory arbitration.
+  memory::MemoryPool* pool();
+
  private:
   HashTableCache() = default;
 
-  std::mutex lock_;
+  // Returns the entry for 'key', creating it with 'makePool' if not present.
+  // Sets 'created' if the entry is new.
+  std::shared_ptr<HashTableCacheEntry> getLocked(
+      const std::string& key,
+      const std::string& taskId,
+      const std::function<std::shared_ptr<memory::MemoryPool>()>& makePool,
+      bool crossQuery,
+      ContinueFuture* future,
+      bool& created);
+
+  // Returns true if 'entry' is a cross-query entry that can be evicted.
+  static bool isEvictable(
+      const std::shared_ptr<HashTableCacheEntry>& entry);
+
+  mutable std::mutex lock_;
   std::unordered_map<std::string, std::shared_ptr<HashTableCacheEntry>> tables_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  uint64_t useCounter_{0};
 };
 
+/// Returns true if the tasks of the query on a node share one hash table for
+/// 'joinNode', either because the plan asks for it or because the build side
+/// reads only broadcast exchanges, see ExchangeNode::isBroadcast() and
+/// QueryConfig::kHashJoinShareBroadcastBuild.
+bool shareHashTable(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& queryConfig);
+
 } // namespace facebook::velox::exec
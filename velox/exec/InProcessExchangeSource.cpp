@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+
+#include <folly/futures/Future.h>
+
+#include "velox/common/time/CpuWallTimer.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+namespace {
+// Frees a page copied by InProcessExchangeSource::copyToPool().
+struct PoolBuffer {
+  std::shared_ptr<memory::MemoryPool> pool;
+  int64_t size;
+};
+
+void freePoolBuffer(void* data, void* userData) {
+  auto* buffer = reinterpret_cast<PoolBuffer*>(userData);
+  buffer->pool->free(data, buffer->size);
+  delete buffer;
+}
+} // namespace
+
+InProcessExchangeSource::InProcessExchangeSource(
+    const std::string& remoteTaskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool)
+    : ExchangeSource(remoteTaskId, destination, std::move(queue), pool),
+      producerTaskId_(remoteTaskId.substr(kScheme.size())),
+      buffers_(OutputBufferManager::getInstanceRef()) {
+  VELOX_CHECK(
+      remoteTaskId.compare(0, kScheme.size(), kScheme) == 0,
+      "Not an in-process task id: {}",
+      remoteTaskId);
+  VELOX_CHECK_NOT_NULL(buffers_, "invalid OutputBufferManager");
+}
+
+// static
+std::shared_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& remoteTaskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  if (remoteTaskId.compare(0, kScheme.size(), kScheme) != 0) {
+    return nullptr;
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      remoteTaskId, destination, std::move(queue), pool);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  VELOX_CHECK(requestPending_);
+  auto promise = VeloxPromise<Response>("InProcessExchangeSource::request");
+  auto future = promise.getSemiFuture();
+  int64_t requestedSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    promise_ = std::move(promise);
+    requestedSequence = sequence_;
+  }
+
+  // The producer keeps the callbacks until it has data. They must not keep
+  // 'this' alive after the consumer is gone.
+  std::weak_ptr<ExchangeSource> weakSelf = shared_from_this();
+  const bool found = buffers_->getData(
+      producerTaskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      [weakSelf, requestedSequence](
+          std::vector<std::unique_ptr<folly::IOBuf>> data,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        if (auto self = weakSelf.lock()) {
+          static_cast<InProcessExchangeSource*>(self.get())
+              ->onData(
+                  requestedSequence,
+                  std::move(data),
+                  sequence,
+                  std::move(remainingBytes));
+        }
+      },
+      [weakSelf]() {
+        auto self = weakSelf.lock();
+        return self != nullptr &&
+            !static_cast<InProcessExchangeSource*>(self.get())->closed_;
+      });
+  if (found) {
+    return future;
+  }
+
+  // The producer task is not created yet. The client asks again after an
+  // empty response.
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+  }
+  setEmptyResponse();
+  return folly::futures::sleep(maxWait).deferValue(
+      [](auto&&) { return Response{0, false, {}}; });
+}
+
+void InProcessExchangeSource::onData(
+    int64_t requestedSequence,
+    std::vector<std::unique_ptr<folly::IOBuf>> data,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes) {
+  if (requestedSequence > sequence && !data.empty()) {
+    const int64_t numExtra = requestedSequence - sequence;
+    VELOX_CHECK_LT(numExtra, data.size());
+    data.erase(data.cbegin(), data.cbegin() + numExtra);
+    sequence = requestedSequence;
+  }
+  if (data.empty()) {
+    sequence = requestedSequence;
+  }
+
+  std::vector<std::unique_ptr<SerializedPageBase>> pages;
+  bool atEnd = false;
+  int64_t totalBytes = 0;
+  try {
+    DeltaCpuWallTimer timer([&](const CpuWallTiming& timing) {
+      copyCpuNanos_ += timing.cpuNanos;
+    });
+    for (const auto& iobuf : data) {
+      if (iobuf == nullptr) {
+        atEnd = true;
+        // Keep looping, there could be extra end markers.
+        continue;
+      }
+      totalBytes += iobuf->computeChainDataLength();
+      pages.push_back(
+          std::make_unique<PrestoSerializedPage>(copyToPool(*iobuf)));
+    }
+  } catch (const std::exception& e) {
+    // The consumer's pool is out of memory.
+    queue_->setError(e.what());
+    setEmptyResponse();
+    return;
+  }
+  numPages_ += pages.size();
+  totalBytes_ += totalBytes;
+
+  VeloxPromise<Response> requestPromise;
+  std::vector<ContinuePromise> queuePromises;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+    requestPromise = std::move(promise_);
+    for (auto& page : pages) {
+      queue_->enqueueLocked(std::move(page), queuePromises);
+    }
+    if (atEnd) {
+      queue_->enqueueLocked(nullptr, queuePromises);
+      atEnd_ = true;
+    }
+    if (!data.empty()) {
+      sequence_ = sequence + pages.size();
+    }
+  }
+  // Outside of queue mutex.
+  for (auto& promise : queuePromises) {
+    promise.setValue();
+  }
+  // The producer's copies of the pages are freed here if at end, otherwise
+  // on the next request.
+  if (atEnd) {
+    buffers_->deleteResults(producerTaskId_, destination_);
+  }
+  if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+    requestPromise.setValue(Response{totalBytes, atEnd, remainingBytes});
+  }
+}
+
+std::unique_ptr<folly::IOBuf> InProcessExchangeSource::copyToPool(
+    const folly::IOBuf& iobuf) {
+  const int64_t size = iobuf.computeChainDataLength();
+  auto* data = reinterpret_cast<char*>(pool_->allocate(size));
+  auto* position = data;
+  for (const auto& range : iobuf) {
+    ::memcpy(position, range.data(), range.size());
+    position += range.size();
+  }
+  return folly::IOBuf::takeOwnership(
+      data, size, freePoolBuffer, new PoolBuffer{pool_, size});
+}
+
+void InProcessExchangeSource::setEmptyResponse() {
+  VeloxPromise<Response> promise{VeloxPromise<Response>::makeEmpty()};
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+  }
+}
+
+void InProcessExchangeSource::pause() {
+  int64_t ackSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    ackSequence = sequence_;
+  }
+  buffers_->acknowledge(producerTaskId_, destination_, ackSequence);
+}
+
+void InProcessExchangeSource::close() {
+  closed_ = true;
+  setEmptyResponse();
+  buffers_->deleteResults(producerTaskId_, destination_);
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {"inProcessExchangeSource.numPages", RuntimeMetric(numPages_)},
+      {"inProcessExchangeSource.totalBytes",
+       RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+      {Operator::kBackgroundCpuTimeNanos,
+       RuntimeMetric(copyCpuNanos_, RuntimeCounter::Unit::kNanos)},
+  };
+}
+
+} // namespace facebook::velox::exec
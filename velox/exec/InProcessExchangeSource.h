@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource for a producer task that runs in the same process as the
+/// consumer, e.g. when several stages of a query are scheduled on one worker.
+/// The pages are fetched from the producer's OutputBufferManager directly,
+/// without an HTTP request or a round trip through the network stack.
+///
+/// Each page is copied once into memory allocated from the consumer's pool.
+/// This moves the ownership of the page between the memory pools: the
+/// producer's memory is released when the page is acknowledged, which is on
+/// the next request, and the consumer's copy is charged to the consumer until
+/// the page is deserialized. The producer task may thus finish while the
+/// consumer still holds its pages.
+///
+/// The remote task id is kScheme followed by the id of the producer task.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  static constexpr std::string_view kScheme{"inprocess://"};
+
+  InProcessExchangeSource(
+      const std::string& remoteTaskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  /// ExchangeSource::Factory. Returns nullptr if 'remoteTaskId' does not
+  /// start with kScheme.
+  static std::shared_ptr<ExchangeSource> create(
+      const std::string& remoteTaskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  /// Returns the remote task id that refers to the producer 'taskId'.
+  static std::string remoteTaskId(const std::string& taskId) {
+    return fmt::format("{}{}", kScheme, taskId);
+  }
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  /// Responds when the producer has data or is at end. If the producer task
+  /// is not created yet, responds with no data after 'maxWait'.
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override {
+    return request(0, maxWait);
+  }
+
+  void pause() override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+ private:
+  // Called by the producer's output buffer with the pages starting at
+  // 'sequence'.
+  void onData(
+      int64_t requestedSequence,
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      int64_t sequence,
+      std::vector<int64_t> remainingBytes);
+
+  // Returns a copy of 'iobuf' in a single buffer allocated from 'pool_'. The
+  // copy holds a reference on 'pool_' until it is freed.
+  std::unique_ptr<folly::IOBuf> copyToPool(const folly::IOBuf& iobuf);
+
+  // Fulfills the pending request, if any, with an empty response.
+  void setEmptyResponse();
+
+  // Id of the producer task in 'buffers_'.
+  const std::string producerTaskId_;
+  const std::shared_ptr<OutputBufferManager> buffers_;
+
+  std::atomic_bool closed_{false};
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<uint64_t> totalBytes_{0};
+  // CPU time spent copying pages into 'pool_'.
+  std::atomic<uint64_t> copyCpuNanos_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -22,6 +22,7 @@
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/row/CompactRow.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -172,9 +173,18 @@ IndexLookupJoin::IndexLookupJoin(
       connector_(connector::getConnector(lookupTableHandle_->connectorId())),
       maxNumInputBatches_(
           1 + driverCtx->queryConfig().indexLookupJoinMaxPrefetchBatches()),
+      dedupKeys_(driverCtx->queryConfig().indexLookupJoinDedupKeys()),
+      minBatchRows_(static_cast<vector_size_t>(std::min<uint32_t>(
+          driverCtx->queryConfig().indexLookupJoinMinBatchRows(),
+          std::numeric_limits<vector_size_t>::max()))),
       joinNode_{joinNode} {
   duplicateJoinKeyCheck(joinNode_->leftKeys());
   duplicateJoinKeyCheck(joinNode_->rightKeys());
+  const auto cacheMaxBytes =
+      driverCtx->queryConfig().indexLookupJoinCacheMaxBytes();
+  if (cacheMaxBytes > 0) {
+    lookupCache_ = std::make_unique<LookupCache>(cacheMaxBytes);
+  }
 }
 
 void IndexLookupJoin::initialize() {
@@ -468,7 +478,7 @@ bool IndexLookupJoin::collectIndexSplits(ContinueFuture* future) {
 }
 
 bool IndexLookupJoin::startDrain() {
-  return numInputBatches() != 0;
+  return numInputBatches() != 0 || !pendingInputs_.empty();
 }
 
 bool IndexLookupJoin::needsInput() const {
@@ -537,21 +547,76 @@ void IndexLookupJoin::endLookupBlockWait() {
 
 void IndexLookupJoin::addInput(RowVectorPtr input) {
   VELOX_CHECK_GT(input->size(), 0);
+  auto lookupInput = mergeInput(std::move(input));
+  if (lookupInput == nullptr) {
+    return;
+  }
+  addInputBatch(std::move(lookupInput));
+}
+
+void IndexLookupJoin::addInputBatch(RowVectorPtr input) {
   auto& batch = nextInputBatch();
   VELOX_CHECK_LE(numInputBatches(), maxNumInputBatches_);
   batch.input = std::move(input);
   ensureInputLoaded(batch);
   decodeAndDetectNonNullKeys(batch);
   prepareLookup(batch);
+  if (dedupKeys()) {
+    prepareLookupRequest(batch);
+  }
   startLookup(batch);
 }
 
+RowVectorPtr IndexLookupJoin::mergeInput(RowVectorPtr input) {
+  if (minBatchRows_ == 0 ||
+      (pendingInputs_.empty() && input->size() >= minBatchRows_)) {
+    return input;
+  }
+  // Load the buffered input in arrival order, as ensureInputLoaded() does.
+  loadColumns(input, *operatorCtx_->execCtx());
+  numPendingRows_ += input->size();
+  pendingInputs_.push_back(std::move(input));
+  if (numPendingRows_ < minBatchRows_) {
+    return nullptr;
+  }
+  return flushPendingInputs();
+}
+
+void IndexLookupJoin::maybeFlushPendingInputs() {
+  if (pendingInputs_.empty() || (!noMoreInput_ && !isDraining()) ||
+      (numInputBatches() >= maxNumInputBatches_)) {
+    return;
+  }
+  addInputBatch(flushPendingInputs());
+}
+
+RowVectorPtr IndexLookupJoin::flushPendingInputs() {
+  VELOX_CHECK(!pendingInputs_.empty());
+  SCOPE_EXIT {
+    pendingInputs_.clear();
+    numPendingRows_ = 0;
+  };
+  if (pendingInputs_.size() == 1) {
+    return std::move(pendingInputs_[0]);
+  }
+  auto merged = BaseVector::create<RowVector>(
+      pendingInputs_[0]->type(), numPendingRows_, pool());
+  vector_size_t offset = 0;
+  for (const auto& input : pendingInputs_) {
+    merged->copy(input.get(), offset, 0, input->size());
+    offset += input->size();
+  }
+  numMergedInputBatches_ += pendingInputs_.size();
+  return merged;
+}
+
 RowVectorPtr IndexLookupJoin::getOutput() {
   SCOPE_EXIT {
-    if (numInputBatches() == 0 && isDraining()) {
+    if (numInputBatches() == 0 && pendingInputs_.empty() && isDraining()) {
       finishDrain();
     }
   };
+  maybeFlushPendingInputs();
 
   auto& batch = currentInputBatch();
   if (batch.empty()) {
@@ -672,9 +737,26 @@ void IndexLookupJoin::mergeLookupResults(InputBatchState& batch) {
 }
 
 bool IndexLookupJoin::getLookupResults(InputBatchState& batch) {
+  if (batch.lookupRequest == nullptr) {
+    return fetchLookupResults(batch);
+  }
+  if (batch.lookupResultExpanded) {
+    return true;
+  }
+  // The lookup is skipped if all keys are found in the cache.
+  if ((batch.lookupResultIter != nullptr) && !fetchLookupResults(batch)) {
+    return false;
+  }
+  expandLookupResult(batch);
+  return true;
+}
+
+bool IndexLookupJoin::fetchLookupResults(InputBatchState& batch) {
   VELOX_CHECK_NOT_NULL(batch.lookupInput);
   VELOX_CHECK_NOT_NULL(batch.lookupResultIter);
   VELOX_CHECK(!batch.lookupFuture.valid());
+  // The results of deduplicated keys are fanned out after all are fetched.
+  const bool splitOutput = splitOutput_ && (batch.lookupRequest == nullptr);
 
   // Result is ready.
   if (batch.lookupResult != nullptr) {
@@ -691,8 +773,8 @@ bool IndexLookupJoin::getLookupResults(InputBatchState& batch) {
     }
     VELOX_CHECK(!batch.lookupFuture.valid());
 
-    // Either splitOutput_ is true, or no more results, or first result is null.
-    if (splitOutput_ || !batch.lookupResultIter->hasNext()) {
+    // Either splitOutput is true, or no more results, or first result is null.
+    if (splitOutput || !batch.lookupResultIter->hasNext()) {
       batch.lookupResult = std::move(lookupResultOr).value();
       return true;
     }
@@ -701,10 +783,10 @@ bool IndexLookupJoin::getLookupResults(InputBatchState& batch) {
     batch.partialOutputs.push_back(std::move(lookupResultOr).value());
   }
 
-  // Continue accumulating remaining results when splitOutput_ is false.
+  // Continue accumulating remaining results when splitOutput is false.
   // This handles both initial accumulation and resuming after async
   // interruption.
-  VELOX_CHECK(!splitOutput_);
+  VELOX_CHECK(!splitOutput);
   VELOX_CHECK(!batch.partialOutputs.empty());
   VELOX_CHECK_NULL(batch.lookupResult);
 
@@ -763,13 +845,223 @@ void IndexLookupJoin::startLookup(InputBatchState& batch) {
     return;
   }
 
-  // Create the lookup result iterator.
-  batch.lookupResultIter = indexSource_->lookup(
-      connector::IndexSource::LookupRequest{batch.lookupInput});
+  const auto& request = batch.lookupRequest != nullptr ? batch.lookupRequest
+                                                       : batch.lookupInput;
+  if (request->size() != 0) {
+    // Create the lookup result iterator.
+    batch.lookupResultIter =
+        indexSource_->lookup(connector::IndexSource::LookupRequest{request});
+  }
 
   getLookupResults(batch);
 }
 
+void IndexLookupJoin::prepareLookupRequest(InputBatchState& batch) {
+  VELOX_CHECK_NULL(batch.lookupRequest);
+  const vector_size_t numLookupRows = batch.lookupInput->size();
+  if (numLookupRows == 0) {
+    return;
+  }
+  batch.requestRows.resize(numLookupRows);
+  batch.cachedMatches.resize(numLookupRows);
+
+  // The serialized lookup input row is the key. Two rows with the same key
+  // make the same request to the index source.
+  const row::CompactRow compactRow(batch.lookupInput);
+  const auto fixedRowSize = row::CompactRow::fixedRowSize(lookupInputType_);
+  folly::F14FastMap<std::string, vector_size_t> requestRowByKey;
+  auto requestIndices = allocateIndices(numLookupRows, pool());
+  auto* rawRequestIndices = requestIndices->asMutable<vector_size_t>();
+  vector_size_t numRequestRows = 0;
+  std::string key;
+  for (vector_size_t row = 0; row < numLookupRows; ++row) {
+    key.assign(
+        fixedRowSize.has_value() ? fixedRowSize.value()
+                                 : compactRow.rowSize(row),
+        '\0');
+    compactRow.serialize(row, key.data());
+    if (lookupCache_ != nullptr) {
+      if (auto* matches = lookupCache_->get(key)) {
+        batch.cachedMatches[row] = *matches;
+        lookupCache_->release(key);
+        batch.requestRows[row] = -1;
+        ++numLookupCacheHits_;
+        continue;
+      }
+    }
+    const auto [it, inserted] = requestRowByKey.emplace(key, numRequestRows);
+    if (inserted) {
+      rawRequestIndices[numRequestRows++] = row;
+    } else {
+      ++numDedupedLookupKeys_;
+    }
+    batch.requestRows[row] = it->second;
+  }
+
+  batch.requestKeys.resize(numRequestRows);
+  for (auto& [requestKey, requestRow] : requestRowByKey) {
+    batch.requestKeys[requestRow] = requestKey;
+  }
+  if (numRequestRows == numLookupRows) {
+    batch.lookupRequest = batch.lookupInput;
+    return;
+  }
+  requestIndices->setSize(numRequestRows * sizeof(vector_size_t));
+  std::vector<VectorPtr> children;
+  children.reserve(lookupInputType_->size());
+  for (const auto& child : batch.lookupInput->children()) {
+    children.push_back(BaseVector::wrapInDictionary(
+        nullptr, requestIndices, numRequestRows, child));
+  }
+  batch.lookupRequest = std::make_shared<RowVector>(
+      pool(), lookupInputType_, nullptr, numRequestRows, std::move(children));
+}
+
+void IndexLookupJoin::expandLookupResult(InputBatchState& batch) {
+  VELOX_CHECK(!batch.lookupResultExpanded);
+  VELOX_CHECK(batch.partialOutputs.empty());
+  batch.lookupResultExpanded = true;
+  auto requestResult = std::move(batch.lookupResult);
+  const vector_size_t numLookupRows = batch.lookupInput->size();
+  const vector_size_t numRequestRows = batch.lookupRequest->size();
+
+  // Groups the rows of 'requestResult' by request row. The matches of request
+  // row 'i' are the result rows in 'requestMatchRows' from
+  // 'requestMatchOffsets[i]' to 'requestMatchOffsets[i + 1]'.
+  std::vector<vector_size_t> requestMatchOffsets(numRequestRows + 1, 0);
+  std::vector<vector_size_t> requestMatchRows;
+  if (requestResult != nullptr) {
+    const auto* inputHits = requestResult->inputHits->as<vector_size_t>();
+    const vector_size_t numResultRows = requestResult->size();
+    for (vector_size_t i = 0; i < numResultRows; ++i) {
+      ++requestMatchOffsets[inputHits[i] + 1];
+    }
+    for (vector_size_t i = 0; i < numRequestRows; ++i) {
+      requestMatchOffsets[i + 1] += requestMatchOffsets[i];
+    }
+    requestMatchRows.resize(numResultRows);
+    std::vector<vector_size_t> fill(
+        requestMatchOffsets.begin(), requestMatchOffsets.end() - 1);
+    for (vector_size_t i = 0; i < numResultRows; ++i) {
+      requestMatchRows[fill[inputHits[i]]++] = i;
+    }
+  }
+  const auto numRequestMatches = [&](vector_size_t requestRow) {
+    return requestMatchOffsets[requestRow + 1] -
+        requestMatchOffsets[requestRow];
+  };
+
+  if (lookupCache_ != nullptr) {
+    for (vector_size_t i = 0; i < numRequestRows; ++i) {
+      RowVectorPtr matches;
+      if (numRequestMatches(i) > 0) {
+        matches = BaseVector::create<RowVector>(
+            lookupOutputType_, numRequestMatches(i), pool());
+        matches->copy(
+            requestResult->output.get(),
+            SelectivityVector(numRequestMatches(i)),
+            requestMatchRows.data() + requestMatchOffsets[i]);
+      }
+      const auto size = batch.requestKeys[i].size() +
+          (matches == nullptr ? 0 : matches->retainedSize());
+      auto* value = new RowVectorPtr(std::move(matches));
+      if (!lookupCache_->add(batch.requestKeys[i], value, size)) {
+        delete value;
+      }
+    }
+  }
+
+  vector_size_t numOutputRows = 0;
+  bool hasCachedMatches = false;
+  for (vector_size_t row = 0; row < numLookupRows; ++row) {
+    const auto requestRow = batch.requestRows[row];
+    if (requestRow >= 0) {
+      numOutputRows += numRequestMatches(requestRow);
+    } else if (batch.cachedMatches[row] != nullptr) {
+      numOutputRows += batch.cachedMatches[row]->size();
+      hasCachedMatches = true;
+    }
+  }
+  if (numOutputRows == 0) {
+    return;
+  }
+
+  // Lists the matches of each lookup input row in row order.
+  auto inputHits = allocateIndices(numOutputRows, pool());
+  auto* rawInputHits = inputHits->asMutable<vector_size_t>();
+  auto resultIndices = allocateIndices(numOutputRows, pool());
+  auto* rawResultIndices = resultIndices->asMutable<vector_size_t>();
+  // Pairs of a lookup input row served from the cache and its first output
+  // row.
+  std::vector<std::pair<vector_size_t, vector_size_t>> cachedOutputs;
+  vector_size_t outputRow = 0;
+  for (vector_size_t row = 0; row < numLookupRows; ++row) {
+    const auto requestRow = batch.requestRows[row];
+    if (requestRow < 0) {
+      const auto& cached = batch.cachedMatches[row];
+      if (cached != nullptr) {
+        std::fill_n(rawInputHits + outputRow, cached->size(), row);
+        cachedOutputs.emplace_back(row, outputRow);
+        outputRow += cached->size();
+      }
+      continue;
+    }
+    for (auto i = requestMatchOffsets[requestRow];
+         i < requestMatchOffsets[requestRow + 1];
+         ++i) {
+      rawInputHits[outputRow] = row;
+      rawResultIndices[outputRow++] = requestMatchRows[i];
+    }
+  }
+  VELOX_CHECK_EQ(outputRow, numOutputRows);
+
+  RowVectorPtr output;
+  if (!hasCachedMatches) {
+    // All matches are in 'requestResult'.
+    std::vector<VectorPtr> children;
+    children.reserve(requestResult->output->childrenSize());
+    for (const auto& child : requestResult->output->children()) {
+      children.push_back(BaseVector::wrapInDictionary(
+          nullptr, resultIndices, numOutputRows, child));
+    }
+    output = std::make_shared<RowVector>(
+        pool(),
+        requestResult->output->type(),
+        nullptr,
+        numOutputRows,
+        std::move(children));
+  } else {
+    output =
+        BaseVector::create<RowVector>(lookupOutputType_, numOutputRows, pool());
+    if (requestResult != nullptr) {
+      // Copies the matches from 'requestResult' to their output rows.
+      SelectivityVector requestOutputRows(numOutputRows, false);
+      vector_size_t target = 0;
+      for (vector_size_t row = 0; row < numLookupRows; ++row) {
+        const auto requestRow = batch.requestRows[row];
+        if (requestRow < 0) {
+          if (batch.cachedMatches[row] != nullptr) {
+            target += batch.cachedMatches[row]->size();
+          }
+          continue;
+        }
+        requestOutputRows.setValidRange(
+            target, target + numRequestMatches(requestRow), true);
+        target += numRequestMatches(requestRow);
+      }
+      requestOutputRows.updateBounds();
+      output->copy(
+          requestResult->output.get(), requestOutputRows, rawResultIndices);
+    }
+    for (const auto& [row, firstOutputRow] : cachedOutputs) {
+      const auto& cached = batch.cachedMatches[row];
+      output->copy(cached.get(), firstOutputRow, 0, cached->size());
+    }
+  }
+  batch.lookupResult = std::make_unique<LookupResult>(
+      std::move(inputHits), std::move(output));
+}
+
 RowVectorPtr IndexLookupJoin::getOutputFromLookupResult(
     InputBatchState& batch) {
   VELOX_CHECK(!batch.empty());
@@ -902,14 +1194,17 @@ bool IndexLookupJoin::hasRemainingOutputForLeftJoin(
 
 void IndexLookupJoin::finishInput(InputBatchState& batch) {
   VELOX_CHECK_NOT_NULL(batch.input);
-  VELOX_CHECK_EQ(
-      batch.lookupInput->size() == 0, batch.lookupResultIter == nullptr);
+  if (batch.lookupRequest == nullptr) {
+    VELOX_CHECK_EQ(
+        batch.lookupInput->size() == 0, batch.lookupResultIter == nullptr);
+  }
   VELOX_CHECK(!batch.lookupFuture.valid());
 
   batch.input = nullptr;
   batch.lookupResultIter = nullptr;
   batch.lookupResult = nullptr;
   batch.lookupInputHasNullKeys = false;
+  batch.resetDedup();
   lastProcessedInputRow_ = std::nullopt;
   nextOutputResultRow_ = 0;
   ++startBatchIndex_;
@@ -917,7 +1212,8 @@ void IndexLookupJoin::finishInput(InputBatchState& batch) {
   if (numInputBatches() != 0) {
     auto& nextBatch = currentInputBatch();
     VELOX_CHECK(!nextBatch.empty());
-    if (nextBatch.lookupResult != nullptr) {
+    if (nextBatch.lookupResult != nullptr ||
+        nextBatch.lookupResultExpanded) {
       VELOX_CHECK(!nextBatch.lookupFuture.valid());
     } else {
       VELOX_CHECK_EQ(
@@ -1225,6 +1521,23 @@ void IndexLookupJoin::prepareOutputRowMappings(size_t outputBatchSize) {
 
 void IndexLookupJoin::close() {
   recordConnectorStats();
+  {
+    auto lockedStats = stats_.wlock();
+    if (numDedupedLookupKeys_ > 0) {
+      lockedStats->addRuntimeStat(
+          kNumDedupedLookupKeys, RuntimeCounter(numDedupedLookupKeys_));
+    }
+    if (numLookupCacheHits_ > 0) {
+      lockedStats->addRuntimeStat(
+          kNumLookupCacheHits, RuntimeCounter(numLookupCacheHits_));
+    }
+    if (numMergedInputBatches_ > 0) {
+      lockedStats->addRuntimeStat(
+          kNumMergedInputBatches, RuntimeCounter(numMergedInputBatches_));
+    }
+  }
+  lookupCache_.reset();
+  pendingInputs_.clear();
   // TODO: add close method for index source if needed to free up resource
   // or shutdown index source gracefully.
   indexSource_.reset();
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
@@ -39,7 +40,7 @@ class IndexLookupJoin : public Operator {
   RowVectorPtr getOutput() override;
 
   bool isFinished() override {
-    return noMoreInput_ && (numInputBatches() == 0);
+    return noMoreInput_ && (numInputBatches() == 0) && pendingInputs_.empty();
   }
 
   void close() override;
@@ -81,6 +82,15 @@ class IndexLookupJoin : public Operator {
   /// The number of lookup results received from remote storage with error.
   static inline const std::string kClientNumErrorResults{
       "clientNumErrorResults"};
+  /// The number of lookup input rows whose key was already sent to the index
+  /// source for another row of the same input batch.
+  static inline const std::string kNumDedupedLookupKeys{
+      "numDedupedLookupKeys"};
+  /// The number of lookup input rows served from the lookup result cache.
+  static inline const std::string kNumLookupCacheHits{"numLookupCacheHits"};
+  /// The number of input batches merged into a larger lookup.
+  static inline const std::string kNumMergedInputBatches{
+      "numMergedInputBatches"};
 
  private:
   using LookupResultIter = connector::IndexSource::LookupResultIterator;
@@ -125,6 +135,22 @@ class IndexLookupJoin : public Operator {
     // accumulation.
     std::vector<std::unique_ptr<LookupResult>> partialOutputs;
 
+    // The following are set if lookup keys are deduplicated. 'lookupRequest'
+    // has one row for each distinct key in 'lookupInput' that is not found in
+    // the result cache, and is sent to the index source instead of
+    // 'lookupInput'. 'requestRows' maps each row in 'lookupInput' to its row
+    // in 'lookupRequest', or to -1 if the row is served from the cache, in
+    // which case 'cachedMatches' has the cached matches of the row or null if
+    // there are none. 'requestKeys' has the serialized key of each row in
+    // 'lookupRequest' for adding its matches to the cache.
+    RowVectorPtr lookupRequest;
+    std::vector<vector_size_t> requestRows;
+    std::vector<RowVectorPtr> cachedMatches;
+    std::vector<std::string> requestKeys;
+    // Set after the lookup results of 'lookupRequest' are fanned out to the
+    // rows of 'lookupInput' in 'lookupResult'.
+    bool lookupResultExpanded{false};
+
     InputBatchState() : lookupFuture(ContinueFuture::makeEmpty()) {}
 
     void reset() {
@@ -133,6 +159,15 @@ class IndexLookupJoin : public Operator {
       lookupFuture = ContinueFuture::makeEmpty();
       lookupResult = nullptr;
       partialOutputs.clear();
+      resetDedup();
+    }
+
+    void resetDedup() {
+      lookupRequest = nullptr;
+      requestRows.clear();
+      cachedMatches.clear();
+      requestKeys.clear();
+      lookupResultExpanded = false;
     }
 
     // Indicates if this input batch is empty.
@@ -170,6 +205,37 @@ class IndexLookupJoin : public Operator {
   void prepareLookup(InputBatchState& batch);
   void startLookup(InputBatchState& batch);
 
+  // Returns true if lookup keys are deduplicated before being sent to the
+  // index source.
+  bool dedupKeys() const {
+    return dedupKeys_ || lookupCache_ != nullptr;
+  }
+
+  // Sets the dedup state of 'batch' from its 'lookupInput'. Looks up each
+  // distinct key in the result cache and puts the others in 'lookupRequest'.
+  void prepareLookupRequest(InputBatchState& batch);
+
+  // Makes 'lookupResult' of 'batch' from the lookup results of
+  // 'lookupRequest' and the cached matches, with the matches of each row in
+  // 'lookupInput' in row order. Adds the matches of the requested keys to the
+  // result cache.
+  void expandLookupResult(InputBatchState& batch);
+
+  // Buffers 'input' if it is smaller than minBatchRows_. Returns the input to
+  // look up, which combines the buffered inputs, or null if more input is
+  // needed to reach minBatchRows_.
+  RowVectorPtr mergeInput(RowVectorPtr input);
+
+  // Starts the lookup of the buffered input if there is no more input or the
+  // operator is draining, and there is room for another input batch.
+  void maybeFlushPendingInputs();
+
+  // Combines 'pendingInputs_' into a single input batch.
+  RowVectorPtr flushPendingInputs();
+
+  // Starts the lookup of a new input batch.
+  void addInputBatch(RowVectorPtr input);
+
   // Helper function to merge batch.partialOutputs into a single
   // batch.lookupResult. This is used when splitOutput_ is false to ensure all
   // results from an iterator are combined into one output batch.
@@ -178,8 +244,10 @@ class IndexLookupJoin : public Operator {
   // already fetched, and when splitOutput_ is false, accumulates all remaining
   // results into a single batch. Handles both initial lookup and resuming
   // accumulation after async interruption. Returns true if results are ready,
-  // false if an async operation is pending.
+  // false if an async operation is pending. If lookup keys are deduplicated,
+  // all results are accumulated and then fanned out by expandLookupResult().
   bool getLookupResults(InputBatchState& batch);
+  bool fetchLookupResults(InputBatchState& batch);
 
   void startLookupBlockWait();
   void endLookupBlockWait();
@@ -298,6 +366,23 @@ class IndexLookupJoin : public Operator {
   const std::shared_ptr<connector::ConnectorQueryCtx> connectorQueryCtx_;
   const std::shared_ptr<connector::Connector> connector_;
   const size_t maxNumInputBatches_;
+  const bool dedupKeys_;
+  const vector_size_t minBatchRows_;
+
+  // Lookup results keyed by the serialized lookup input row. The value has
+  // the matches of the key, or is null if there are none. Set if the cache is
+  // enabled by config.
+  using LookupCache = SimpleLRUCache<std::string, RowVectorPtr>;
+  std::unique_ptr<LookupCache> lookupCache_;
+
+  // Input batches smaller than minBatchRows_ that are buffered to be looked
+  // up together.
+  std::vector<RowVectorPtr> pendingInputs_;
+  vector_size_t numPendingRows_{0};
+
+  uint64_t numDedupedLookupKeys_{0};
+  uint64_t numLookupCacheHits_{0};
+  uint64_t numMergedInputBatches_{0};
 
   // The lookup join plan node used to initialize this operator and reset after
   // that.
@@ -31,28 +31,34 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numWaiters_;
+  if (bufferedBytes_ < maxBufferSize_) {
+    // A consumer freed enough memory in the meantime.
+    --numWaiters_;
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
   std::vector<ContinuePromise> promises;
-  {
-    std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      numWaiters_ == 0) {
+    return promises;
+  }
 
-    if (bufferedBytes_ < maxBufferSize_) {
-      promises = std::move(promises_);
-    }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (bufferedBytes_ < maxBufferSize_) {
+    promises = std::move(promises_);
+    numWaiters_ = 0;
   }
   return promises;
 }
@@ -166,9 +172,13 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data,
-    bool& drained) {
+    bool& drained,
+    vector_size_t maxCoalescedRows) {
   drained = false;
   int64_t size{0};
+  // The vectors popped after '*data' to be coalesced with it.
+  std::vector<std::pair<RowVectorPtr, int64_t>> coalesced;
+  vector_size_t numRows{0};
   std::vector<ContinuePromise> memoryPromises;
   const auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
@@ -190,14 +200,41 @@ BlockingReason LocalExchangeQueue::next(
     std::tie(*data, size) = std::move(queue.front());
     queue.pop();
 
-    memoryPromises = memoryManager_->decreaseMemoryUsage(size);
+    numRows = (*data)->size();
+    int64_t totalSize = size;
+    while (!queue.empty() &&
+           numRows + queue.front().first->size() <= maxCoalescedRows) {
+      numRows += queue.front().first->size();
+      totalSize += queue.front().second;
+      coalesced.push_back(std::move(queue.front()));
+      queue.pop();
+    }
+
+    memoryPromises = memoryManager_->decreaseMemoryUsage(totalSize);
     return BlockingReason::kNotBlocked;
   });
 
   notify(memoryPromises);
-  if (*data != nullptr) {
+  if (*data == nullptr) {
+    return blockingReason;
+  }
+
+  if (coalesced.empty()) {
     vectorPool_->push(*data, size);
+    return blockingReason;
+  }
+
+  auto first = std::move(*data);
+  *data = BaseVector::create<RowVector>(first->type(), numRows, pool);
+  (*data)->copy(first.get(), 0, 0, first->size());
+  vector_size_t offset = first->size();
+  vectorPool_->push(first, size);
+  for (auto& [vector, vectorSize] : coalesced) {
+    (*data)->copy(vector.get(), offset, 0, vector->size());
+    offset += vector->size();
+    vectorPool_->push(vector, vectorSize);
   }
+  VELOX_CHECK_EQ(offset, numRows);
   return blockingReason;
 }
 
@@ -266,6 +303,10 @@ LocalExchange::LocalExchange(
           planNodeId,
           "LocalExchange"),
       partition_{partition},
+      maxCoalescedRows_{
+          ctx->queryConfig().localExchangeCoalesceOutputBatches()
+              ? ctx->queryConfig().preferredOutputBatchRows()
+              : 0},
       queue_{operatorCtx_->task()->getLocalExchangeQueue(
           ctx->splitGroupId,
           planNodeId,
@@ -289,7 +330,8 @@ RowVectorPtr LocalExchange::getOutput() {
 
   RowVectorPtr data;
   bool drained{false};
-  blockingReason_ = queue_->next(&future_, pool(), &data, drained);
+  blockingReason_ =
+      queue_->next(&future_, pool(), &data, drained, maxCoalescedRows_);
   if (blockingReason_ != BlockingReason::kNotBlocked) {
     VELOX_CHECK(future_.valid());
     VELOX_CHECK(!drained);
@@ -544,7 +586,7 @@ void LocalPartition::populateAndEnqueuePartitions(
   auto balancedTotalPartitionBufferSize =
       totalPartitionBufferSizeExcludingString +
       (totalPartitionStringBufferSize / nonEmptyPartitionCount);
-  auto inputRetainedSize = input->retainedSize();
+  const auto retainedSize = inputRetainedSize(input);
 
   // Enqueue all partitions if one of the following conditions is met:
   // 1. This operator is not in buffer mode.
@@ -555,7 +597,7 @@ void LocalPartition::populateAndEnqueuePartitions(
           singlePartitionBufferSize_ * numPartitions_) {
     auto perPartitionAmortizedSize =
         (singlePartitionBufferSize_ > 0 ? balancedTotalPartitionBufferSize
-                                        : inputRetainedSize) /
+                                        : retainedSize) /
         nonEmptyPartitionCount;
     for (auto partition = 0; partition < numPartitions_; partition++) {
       auto partitionSize = numRowsPerPartition[partition];
@@ -576,6 +618,11 @@ void LocalPartition::populateAndEnqueuePartitions(
   }
 }
 
+uint64_t LocalPartition::inputRetainedSize(const RowVectorPtr& input) {
+  RetainedBufferSet retainedBuffers;
+  return input->retainedSize(retainedBuffers);
+}
+
 void LocalPartition::addInput(RowVectorPtr input) {
   prepareForInput(input);
   if (input->size() == 0) {
@@ -588,7 +635,7 @@ void LocalPartition::addInput(RowVectorPtr input) {
   if (singlePartition.has_value()) {
     ContinueFuture future;
     auto blockingReason = queues_[singlePartition.value()]->enqueue(
-        input, input->retainedSize(), &future);
+        input, inputRetainedSize(input), &future);
     if (blockingReason != BlockingReason::kNotBlocked) {
       blockingReasons_.push_back(blockingReason);
       futures_.push_back(std::move(future));
@@ -28,12 +28,13 @@ class LocalExchangeMemoryManager {
       : maxBufferSize_{maxBufferSize} {}
 
   /// Returns 'true' if memory limit is reached or exceeded and sets future that
-  /// will be complete when memory usage is update to be below the limit.
+  /// will be complete when memory usage is update to be below the limit. Only
+  /// takes 'mutex_' when the limit is reached.
   bool increaseMemoryUsage(ContinueFuture* future, int64_t added);
 
   /// Decreases the memory usage by 'removed' bytes. If the memory usage goes
   /// below the limit after the decrease, the function returns 'promises_' to
-  /// caller to fulfill.
+  /// caller to fulfill. Only takes 'mutex_' when there are blocked producers.
   std::vector<ContinuePromise> decreaseMemoryUsage(int64_t removed);
 
   /// Returns the maximum buffer size in bytes.
@@ -49,7 +50,11 @@ class LocalExchangeMemoryManager {
  private:
   const int64_t maxBufferSize_;
   std::mutex mutex_;
-  tsan_atomic<int64_t> bufferedBytes_{0};
+  std::atomic<int64_t> bufferedBytes_{0};
+  // Number of producers registered in 'promises_'. Incremented under 'mutex_'
+  // before re-checking 'bufferedBytes_' so that a concurrent decrease below
+  // the limit either observes the waiter or is observed by the re-check.
+  std::atomic<int32_t> numWaiters_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -117,11 +122,16 @@ class LocalExchangeQueue {
   /// @param pool Memory pool used to copy the data before returning.
   /// @param drained Set to true if all the producers of this queue have been
   /// drained under barrier processing.
+  /// @param maxCoalescedRows If non-zero, the queued vectors following the
+  /// first one are popped in the same critical section and copied together
+  /// with it into a single vector of up to 'maxCoalescedRows' rows allocated
+  /// from 'pool'.
   BlockingReason next(
       ContinueFuture* future,
       memory::MemoryPool* pool,
       RowVectorPtr* data,
-      bool& drained);
+      bool& drained,
+      vector_size_t maxCoalescedRows = 0);
 
   bool isFinished();
 
@@ -195,6 +205,9 @@ class LocalExchange : public SourceOperator {
 
  private:
   const int partition_;
+  // Maximum number of rows to assemble from small queued vectors. Zero if
+  // coalescing is disabled.
+  const vector_size_t maxCoalescedRows_;
   const std::shared_ptr<LocalExchangeQueue> queue_{nullptr};
   ContinueFuture future_;
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
@@ -240,6 +253,11 @@ class LocalPartition : public Operator {
 
   void allocateIndexBuffers(const std::vector<vector_size_t>& sizes);
 
+  /// Returns the retained size of 'input' counting each buffer only once, e.g.
+  /// the string buffers of slices or dictionary bases wrapped by several
+  /// columns.
+  uint64_t inputRetainedSize(const RowVectorPtr& input);
+
   /// Create partitions from 'input' according to 'numRowsPerPartition' and
   /// 'indexBuffers', and enqueue the partitions to LocalExchangeQueues. The
   /// behavior of partition vector creation varies depending on
@@ -25,6 +25,7 @@
 #include "velox/exec/GroupId.h"
 #include "velox/exec/HashAggregation.h"
 #include "velox/exec/HashBuild.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashProbe.h"
 #include "velox/exec/IndexLookupJoin.h"
 #include "velox/exec/Limit.h"
@@ -70,6 +71,165 @@ bool eagerFlush(const core::PlanNode& node) {
   return eagerFlush(*node.sources()[0]);
 }
 
+// Returns true if 'node' is a local repartition of a single input on a hash of
+// 'keys'. If the input is produced by a single driver, each partition has the
+// rows of the input in their original order.
+bool isHashPartitionedOn(
+    const core::PlanNode& node,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys) {
+  const auto* localPartition =
+      dynamic_cast<const core::LocalPartitionNode*>(&node);
+  if (localPartition == nullptr ||
+      localPartition->type() != core::LocalPartitionNode::Type::kRepartition ||
+      localPartition->scaleWriter() || localPartition->sources().size() != 1) {
+    return false;
+  }
+  const auto* spec = dynamic_cast<const HashPartitionFunctionSpec*>(
+      &localPartition->partitionFunctionSpec());
+  if (spec == nullptr || !spec->skewedKeys().empty() ||
+      spec->keyChannels().size() != keys.size()) {
+    return false;
+  }
+  const auto& inputType = localPartition->outputType();
+  for (auto i = 0; i < keys.size(); ++i) {
+    const auto channel = inputType->getChildIdxIfExists(keys[i]->name());
+    if (!channel.has_value() || channel.value() != spec->keyChannels()[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if both inputs of 'join' are repartitioned on a hash of the
+// join keys. Rows with equal keys then land in partitions with the same number
+// on both sides, so that each pair of partitions can be merged by a separate
+// driver.
+bool isPartitionedMergeJoin(const core::PlanNode& node) {
+  const auto* join = dynamic_cast<const core::MergeJoinNode*>(&node);
+  return join != nullptr &&
+      isHashPartitionedOn(*join->sources()[0], join->leftKeys()) &&
+      isHashPartitionedOn(*join->sources()[1], join->rightKeys());
+}
+
+// Lets a merge join over partitioned inputs run one driver per partition. The
+// pipelines on both sides of the join must have the same number of drivers
+// for their partitions to match. The pipelines producing the partitioned
+// inputs run single-threaded to keep each partition sorted.
+void adjustPartitionedMergeJoinDrivers(
+    std::vector<std::unique_ptr<DriverFactory>>& driverFactories) {
+  auto findFactory = [&](const core::PlanNode* consumer) -> DriverFactory* {
+    for (auto& factory : driverFactories) {
+      if (factory->consumerNode.get() == consumer) {
+        return factory.get();
+      }
+    }
+    return nullptr;
+  };
+
+  for (auto& factory : driverFactories) {
+    for (const auto& node : factory->planNodes) {
+      if (!isPartitionedMergeJoin(*node)) {
+        continue;
+      }
+      auto* rightFactory = findFactory(node.get());
+      VELOX_CHECK_NOT_NULL(rightFactory);
+      const auto numDrivers =
+          std::min(factory->numDrivers, rightFactory->numDrivers);
+      factory->numDrivers = numDrivers;
+      rightFactory->numDrivers = numDrivers;
+      for (const auto& source : node->sources()) {
+        auto* producerFactory = findFactory(source.get());
+        VELOX_CHECK_NOT_NULL(producerFactory);
+        producerFactory->maxDrivers = 1;
+        producerFactory->numDrivers = 1;
+      }
+    }
+  }
+}
+
+// Returns the column that all the aggregates of 'node' are distinct over or
+// nullptr if 'node' does not qualify for pre-aggregating the distinct values.
+// Qualifies a single, hash-based aggregation whose aggregates are all distinct
+// over the same input column with no masks or sorting keys.
+core::FieldAccessTypedExprPtr distinctPreAggregationColumn(
+    const core::AggregationNode& node) {
+  if (node.step() != core::AggregationNode::Step::kSingle ||
+      node.isPreGrouped() || !node.globalGroupingSets().empty() ||
+      node.groupId().has_value() || node.ignoreNullKeys() ||
+      node.aggregates().empty()) {
+    return nullptr;
+  }
+
+  core::FieldAccessTypedExprPtr column;
+  for (const auto& aggregate : node.aggregates()) {
+    if (!aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty() ||
+        aggregate.call->inputs().size() != 1) {
+      return nullptr;
+    }
+    auto field = std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+        aggregate.call->inputs()[0]);
+    if (field == nullptr || !field->isInputColumn()) {
+      return nullptr;
+    }
+    if (column == nullptr) {
+      column = field;
+    } else if (column->name() != field->name()) {
+      return nullptr;
+    }
+  }
+
+  for (const auto& key : node.groupingKeys()) {
+    if (key->name() == column->name()) {
+      return nullptr;
+    }
+  }
+  return column;
+}
+
+// Replaces the qualifying distinct aggregations in 'planNodes' with a distinct
+// aggregation on (grouping keys, x) followed by the same aggregation without
+// 'distinct' on the grouping keys. The first one keeps each (group, x) pair in
+// a hash table row instead of a per-group set of x values, so it spills like
+// any other aggregation. The second one keeps the id of the original node.
+void preAggregateDistinct(
+    std::vector<std::shared_ptr<const core::PlanNode>>& planNodes) {
+  for (auto i = 0; i < planNodes.size(); ++i) {
+    auto aggregationNode =
+        std::dynamic_pointer_cast<const core::AggregationNode>(planNodes[i]);
+    if (aggregationNode == nullptr) {
+      continue;
+    }
+    auto column = distinctPreAggregationColumn(*aggregationNode);
+    if (column == nullptr) {
+      continue;
+    }
+
+    auto groupingKeys = aggregationNode->groupingKeys();
+    groupingKeys.push_back(column);
+    auto distinctNode =
+        core::AggregationNode::Builder(*aggregationNode)
+            .id(fmt::format("{}.distinct", aggregationNode->id()))
+            .groupingKeys(std::move(groupingKeys))
+            .aggregateNames({})
+            .aggregates({})
+            .build();
+
+    auto aggregates = aggregationNode->aggregates();
+    for (auto& aggregate : aggregates) {
+      aggregate.distinct = false;
+    }
+    auto node = core::AggregationNode::Builder(*aggregationNode)
+                    .aggregates(std::move(aggregates))
+                    .source(distinctNode)
+                    .build();
+
+    planNodes[i] = std::move(node);
+    planNodes.insert(planNodes.begin() + i, std::move(distinctNode));
+    ++i;
+  }
+}
+
 } // namespace
 
 namespace detail {
@@ -190,8 +350,8 @@ OperatorSupplier makeOperatorSupplier(
           std::dynamic_pointer_cast<const core::MergeJoinNode>(planNode)) {
     auto planNodeId = planNode->id();
     return [planNodeId](int32_t operatorId, DriverCtx* ctx) {
-      auto source =
-          ctx->task->getMergeJoinSource(ctx->splitGroupId, planNodeId);
+      auto source = ctx->task->getMergeJoinSource(
+          ctx->splitGroupId, planNodeId, ctx->driverId);
       auto consumer =
           [source](RowVectorPtr input, bool drained, ContinueFuture* future) {
             if (drained) {
@@ -254,8 +414,10 @@ void plan(
 // Sometimes consumer limits the number of drivers its producer can run.
 uint32_t maxDriversForConsumer(
     const std::shared_ptr<const core::PlanNode>& node) {
-  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node)) {
-    // MergeJoinNode must run single-threaded.
+  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node) &&
+      !isPartitionedMergeJoin(*node)) {
+    // MergeJoinNode must run single-threaded unless its inputs are
+    // partitioned on the join keys.
     return 1;
   }
   return std::numeric_limits<uint32_t>::max();
@@ -316,8 +478,11 @@ uint32_t maxDrivers(
       // Merge exchange must run single-threaded.
       return 1;
     } else if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node)) {
-      // Merge join must run single-threaded.
-      return 1;
+      // Merge join must run single-threaded unless its inputs are partitioned
+      // on the join keys.
+      if (!isPartitionedMergeJoin(*node)) {
+        return 1;
+      }
     } else if (
         auto join = std::dynamic_pointer_cast<const core::HashJoinNode>(node)) {
       // Null-aware right semi project doesn't support multi-threaded
@@ -377,6 +542,12 @@ void LocalPlanner::plan(
       detail::makeOperatorSupplier(std::move(consumerSupplier)),
       driverFactories);
 
+  if (queryConfig.aggregationPreAggregateDistinct()) {
+    for (auto& factory : *driverFactories) {
+      preAggregateDistinct(factory->planNodes);
+    }
+  }
+
   (*driverFactories)[0]->outputDriver = true;
 
   if (planFragment.isGroupedExecution()) {
@@ -388,7 +559,10 @@ void LocalPlanner::plan(
   for (auto& factory : *driverFactories) {
     factory->maxDrivers = detail::maxDrivers(*factory, queryConfig);
     factory->numDrivers = std::min(factory->maxDrivers, maxDrivers);
+  }
+  adjustPartitionedMergeJoinDrivers(*driverFactories);
 
+  for (auto& factory : *driverFactories) {
     // Pipelines running grouped/bucketed execution would have separate groups
     // of drivers dealing with separate split groups (one driver can access
     // splits from only one designated split group), hence we will have total
@@ -661,7 +835,8 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
         auto mergeJoin =
             std::dynamic_pointer_cast<const core::MergeJoinNode>(planNode)) {
       auto mergeJoinOp = std::make_unique<MergeJoin>(id, ctx.get(), mergeJoin);
-      ctx->task->createMergeJoinSource(ctx->splitGroupId, mergeJoin->id());
+      ctx->task->createMergeJoinSource(
+          ctx->splitGroupId, mergeJoin->id(), ctx->driverId);
       operators.push_back(std::move(mergeJoinOp));
     } else if (
         auto localPartitionNode =
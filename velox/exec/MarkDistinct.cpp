@@ -16,12 +16,30 @@
 
 #include "velox/exec/MarkDistinct.h"
 #include "velox/common/base/Range.h"
+#include "velox/vector/DecodedVector.h"
 #include "velox/vector/FlatVector.h"
 
 #include <algorithm>
+#include <unordered_set>
 #include <utility>
 
 namespace facebook::velox::exec {
+namespace {
+bool sameKeySet(
+    const std::vector<core::FieldAccessTypedExprPtr>& left,
+    const std::vector<core::FieldAccessTypedExprPtr>& right) {
+  if (left.size() != right.size()) {
+    return false;
+  }
+  std::unordered_set<std::string> names;
+  for (const auto& key : left) {
+    names.insert(key->name());
+  }
+  return std::all_of(right.begin(), right.end(), [&](const auto& key) {
+    return names.count(key->name()) > 0;
+  });
+}
+} // namespace
 
 MarkDistinct::MarkDistinct(
     int32_t operatorId,
@@ -42,17 +60,65 @@ MarkDistinct::MarkDistinct(
 
   // We will use result[0] for distinct mask output.
   resultProjections_.emplace_back(0, inputType->size());
+  results_.resize(1);
+
+  findReusableMarker(planNode->sources()[0], planNode->distinctKeys());
+  if (reusedMarkerChannel_.has_value()) {
+    if (!reusedFromRowNumber_) {
+      // The upstream marker is passed through as is.
+      resultProjections_.clear();
+      identityProjections_.emplace_back(
+          reusedMarkerChannel_.value(), inputType->size());
+    }
+    addRuntimeStat(kReusedMarker, RuntimeCounter(1));
+    return;
+  }
 
   groupingSet_ = GroupingSet::createForMarkDistinct(
       inputType,
       createVectorHashers(inputType, planNode->distinctKeys()),
       operatorCtx_.get(),
       &nonReclaimableSection_);
+}
 
-  results_.resize(1);
+void MarkDistinct::findReusableMarker(
+    const core::PlanNodePtr& source,
+    const std::vector<core::FieldAccessTypedExprPtr>& distinctKeys) {
+  // MarkDistinct passes all input columns through, so markers computed further
+  // upstream are still present in the input. The first match in the chain is
+  // used.
+  auto node = source;
+  while (node != nullptr) {
+    if (auto markDistinct =
+            std::dynamic_pointer_cast<const core::MarkDistinctNode>(node)) {
+      if (sameKeySet(markDistinct->distinctKeys(), distinctKeys)) {
+        reusedMarkerChannel_ =
+            node->outputType()->getChildIdx(markDistinct->markerName());
+        return;
+      }
+      node = node->sources()[0];
+      continue;
+    }
+    if (auto rowNumber =
+            std::dynamic_pointer_cast<const core::RowNumberNode>(node)) {
+      // The row number column is the last output column. Rows past the limit
+      // are dropped, but row number 1 is always produced for each partition.
+      if (rowNumber->generateRowNumber() &&
+          sameKeySet(rowNumber->partitionKeys(), distinctKeys)) {
+        reusedMarkerChannel_ = node->outputType()->size() - 1;
+        reusedFromRowNumber_ = true;
+      }
+    }
+    return;
+  }
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
+  if (reusedMarkerChannel_.has_value()) {
+    input_ = std::move(input);
+    return;
+  }
+
   groupingSet_->addInput(input, /*mayPushdown=*/false);
 
   input_ = std::move(input);
@@ -64,6 +130,12 @@ RowVectorPtr MarkDistinct::getOutput() {
   }
 
   auto outputSize = input_->size();
+  if (reusedMarkerChannel_.has_value() && !reusedFromRowNumber_) {
+    auto output = fillOutput(outputSize, nullptr);
+    input_ = nullptr;
+    return output;
+  }
+
   // Re-use memory for the ID vector if possible.
   VectorPtr& result = results_[0];
   if (result && result.use_count() == 1) {
@@ -79,8 +151,17 @@ RowVectorPtr MarkDistinct::getOutput() {
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
   bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
-    bits::setBit(resultBits, i, true);
+  if (reusedFromRowNumber_) {
+    DecodedVector rowNumbers(*input_->childAt(reusedMarkerChannel_.value()));
+    for (auto i = 0; i < outputSize; ++i) {
+      if (rowNumbers.valueAt<int64_t>(i) == 1) {
+        bits::setBit(resultBits, i, true);
+      }
+    }
+  } else {
+    for (const auto i : groupingSet_->hashLookup().newGroups) {
+      bits::setBit(resultBits, i, true);
+    }
   }
   auto output = fillOutput(outputSize, nullptr);
 
@@ -23,6 +23,10 @@ namespace facebook::velox::exec {
 
 class MarkDistinct : public Operator {
  public:
+  /// Number of operators that derived the marker from an upstream MarkDistinct
+  /// or RowNumber over the same keys instead of building a hash table.
+  static inline const std::string kReusedMarker{"reusedMarker"};
+
   MarkDistinct(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -47,6 +51,21 @@ class MarkDistinct : public Operator {
   bool isFinished() override;
 
  private:
+  // Looks for an upstream MarkDistinct or RowNumber in the same chain of plan
+  // nodes whose keys are the same set as 'distinctKeys'. Sets
+  // 'reusedMarkerChannel_' and 'reusedFromRowNumber_' if found.
+  void findReusableMarker(
+      const core::PlanNodePtr& source,
+      const std::vector<core::FieldAccessTypedExprPtr>& distinctKeys);
+
+  // Input channel of the upstream marker or row number column this operator
+  // derives its marker from. Unset if this operator has its own hash table.
+  std::optional<column_index_t> reusedMarkerChannel_;
+
+  // True if 'reusedMarkerChannel_' is a row number column. The first row of
+  // each partition, row number 1, is the distinct one.
+  bool reusedFromRowNumber_{false};
+
   // TODO: Document spilling configuration in spilling.rst.
   std::unique_ptr<GroupingSet> groupingSet_;
 };
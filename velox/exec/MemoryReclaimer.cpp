@@ -16,6 +16,7 @@
 
 #include "velox/exec/MemoryReclaimer.h"
 
+#include "velox/common/process/PerfettoTrace.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/Task.h"
 
@@ -43,6 +44,7 @@ void MemoryReclaimer::enterArbitration() {
     // terminated.
     VELOX_FAIL("Terminate detected when entering suspension");
   }
+  VELOX_TRACE_BEGIN("velox.memory", "arbitration");
 }
 
 void MemoryReclaimer::leaveArbitration() noexcept {
@@ -53,6 +55,7 @@ void MemoryReclaimer::leaveArbitration() noexcept {
     return;
   }
   Driver* const driver = driverThreadCtx->driverCtx()->driver;
+  VELOX_TRACE_END("velox.memory");
   driver->task()->leaveSuspended(driver->state());
 }
 
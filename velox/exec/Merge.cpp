@@ -20,6 +20,8 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
+#include "velox/vector/DecodedVector.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -405,6 +407,17 @@ RowVectorPtr SourceMerger::getOutput(
       return std::move(output_);
     }
 
+    // Pass a whole batch of at least the output batch size through if it
+    // sorts before the current rows of all other streams. With sources over
+    // disjoint key ranges, e.g. range partitioned sorted runs, the merge
+    // becomes a concatenation.
+    if (outputRows_ == 0 && stream->batchPrecedes(streams_, outputBatchRows_)) {
+      auto batch = stream->takeBatch(sourceBlockingFutures);
+      const auto numRows = batch->size();
+      return std::make_shared<RowVector>(
+          pool_, type_, nullptr, numRows, std::move(batch->children()));
+    }
+
     if (stream->setOutputRow(outputRows_)) {
       // The stream is at end of input batch. Need to copy out the rows before
       // fetching next batch in 'pop'.
@@ -436,28 +449,67 @@ RowVectorPtr SourceMerger::getOutput(
 
 bool SourceStream::operator<(const MergeStream& other) const {
   const auto& otherCursor = static_cast<const SourceStream&>(other);
-  for (auto i = 0; i < sortingKeys_.size(); ++i) {
+  return compareRows(
+             currentSourceRow_, otherCursor, otherCursor.currentSourceRow_) < 0;
+}
+
+int32_t SourceStream::compareRows(
+    vector_size_t row,
+    const SourceStream& other,
+    vector_size_t otherRow) const {
+  auto firstKey = 0;
+  if (prefixSize_ != 0 && other.prefixSize_ == prefixSize_) {
+    if (const auto result = std::memcmp(
+            prefix(row), other.prefix(otherRow), prefixSize_)) {
+      return result;
+    }
+    firstKey = 1;
+  }
+  for (auto i = firstKey; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullAsValue(), "not supported null handling mode");
-    if (auto result = keyColumns_[i]
-                          ->compare(
-                              otherCursor.keyColumns_[i],
-                              currentSourceRow_,
-                              otherCursor.currentSourceRow_,
-                              compareFlags)
-                          .value()) {
-      return result < 0;
+    if (auto result =
+            keyColumns_[i]
+                ->compare(other.keyColumns_[i], row, otherRow, compareFlags)
+                .value()) {
+      return result;
     }
   }
-  return false;
+  return 0;
+}
+
+bool SourceStream::batchPrecedes(
+    const std::vector<SourceStream*>& streams,
+    vector_size_t minRows) const {
+  if (currentSourceRow_ != 0 || data_->size() < minRows) {
+    return false;
+  }
+  const auto lastRow = data_->size() - 1;
+  for (const auto* other : streams) {
+    if (other == this || !other->hasData()) {
+      continue;
+    }
+    if (other->needData_ ||
+        compareRows(lastRow, *other, other->currentSourceRow_) > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+RowVectorPtr SourceStream::takeBatch(std::vector<ContinueFuture>& futures) {
+  VELOX_CHECK(outputRanges_.empty());
+  auto batch = std::move(data_);
+  fetchMoreData(futures);
+  return batch;
 }
 
 bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
   ++currentSourceRow_;
   if (currentSourceRow_ == data_->size()) {
     // Make sure all current data has been copied out.
-    VELOX_CHECK(!outputRows_.hasSelections());
+    VELOX_CHECK(outputRanges_.empty());
     return fetchMoreData(futures);
   }
 
@@ -465,28 +517,14 @@ bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
 }
 
 void SourceStream::copyToOutput(RowVectorPtr& output) {
-  outputRows_.updateBounds();
-
-  if (!outputRows_.hasSelections()) {
+  if (outputRanges_.empty()) {
     return;
   }
 
-  vector_size_t sourceRow = firstSourceRow_;
-  outputRows_.applyToSelected(
-      [&](auto row) { sourceRows_[row] = sourceRow++; });
-
   for (auto i = 0; i < output->type()->size(); ++i) {
-    output->childAt(i)->copy(
-        data_->childAt(i).get(), outputRows_, sourceRows_.data());
-  }
-
-  outputRows_.clearAll();
-
-  if (sourceRow == data_->size()) {
-    firstSourceRow_ = 0;
-  } else {
-    firstSourceRow_ = sourceRow;
+    output->childAt(i)->copyRanges(data_->childAt(i).get(), outputRanges_);
   }
+  outputRanges_.clear();
 }
 
 bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
@@ -510,10 +548,58 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
     for (const auto& key : sortingKeys_) {
       keyColumns_.push_back(data_->childAt(key.first).get());
     }
+    encodePrefixes();
   }
   return false;
 }
 
+void SourceStream::encodePrefixes() {
+  prefixSize_ = 0;
+  if (sortingKeys_.empty() ||
+      keyColumns_[0]->type()->providesCustomComparison()) {
+    return;
+  }
+  switch (keyColumns_[0]->typeKind()) {
+    case TypeKind::SMALLINT:
+      return encodePrefixes<TypeKind::SMALLINT>(*keyColumns_[0]);
+    case TypeKind::INTEGER:
+      return encodePrefixes<TypeKind::INTEGER>(*keyColumns_[0]);
+    case TypeKind::BIGINT:
+      return encodePrefixes<TypeKind::BIGINT>(*keyColumns_[0]);
+    case TypeKind::HUGEINT:
+      return encodePrefixes<TypeKind::HUGEINT>(*keyColumns_[0]);
+    case TypeKind::REAL:
+      return encodePrefixes<TypeKind::REAL>(*keyColumns_[0]);
+    case TypeKind::DOUBLE:
+      return encodePrefixes<TypeKind::DOUBLE>(*keyColumns_[0]);
+    case TypeKind::TIMESTAMP:
+      return encodePrefixes<TypeKind::TIMESTAMP>(*keyColumns_[0]);
+    default:
+      return;
+  }
+}
+
+template <TypeKind Kind>
+void SourceStream::encodePrefixes(const BaseVector& keys) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto& compareFlags = sortingKeys_[0].second;
+  const prefixsort::PrefixSortEncoder encoder(
+      compareFlags.ascending, compareFlags.nullsFirst);
+  prefixSize_ =
+      prefixsort::PrefixSortEncoder::encodedSize(Kind, 0, true).value();
+  const auto numRows = keys.size();
+  prefixes_.resize(numRows * prefixSize_);
+  DecodedVector decoded(keys);
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    encoder.encode(
+        decoded.isNullAt(row) ? std::nullopt
+                              : std::optional<T>(decoded.valueAt<T>(row)),
+        prefixes_.data() + row * prefixSize_,
+        prefixSize_,
+        true);
+  }
+}
+
 SpillMerger::SpillMerger(
     const std::vector<SpillSortKey>& sortingKeys,
     const RowTypePtr& type,
@@ -191,11 +191,9 @@ class SourceStream final : public MergeStream {
       MergeSource* source,
       const std::vector<SpillSortKey>& sortingKeys,
       uint32_t outputBatchSize)
-      : source_{source},
-        sortingKeys_{sortingKeys},
-        outputRows_(outputBatchSize, false),
-        sourceRows_(outputBatchSize) {
+      : source_{source}, sortingKeys_{sortingKeys} {
     keyColumns_.reserve(sortingKeys.size());
+    outputRanges_.reserve(outputBatchSize);
   }
 
   /// Returns true and appends a future to 'futures' if needs to wait for the
@@ -224,6 +222,18 @@ class SourceStream final : public MergeStream {
   /// 'other'.
   bool operator<(const MergeStream& other) const override;
 
+  /// Returns true if the current row is the first in a batch of at least
+  /// 'minRows' rows and the last row of the batch doesn't sort after the
+  /// current row of any other stream in 'streams' that has data.
+  bool batchPrecedes(
+      const std::vector<SourceStream*>& streams,
+      vector_size_t minRows) const;
+
+  /// Returns the current batch and fetches the next one. Must be called only
+  /// if batchPrecedes() is true. Appends a future to 'futures' if needs to
+  /// wait for the source to produce the next batch.
+  RowVectorPtr takeBatch(std::vector<ContinueFuture>& futures);
+
   /// Advances to the next row. Returns true and appends a future to 'futures'
   /// if runs out of rows in the current batch and needs to wait for the
   /// source to produce the next batch. The return flag has the meaning of
@@ -236,18 +246,45 @@ class SourceStream final : public MergeStream {
   /// call 'setOutputRow' before calling 'pop'. The output rows must
   /// monotonically increase in between calls to 'copyToOutput'.
   bool setOutputRow(vector_size_t row) {
-    outputRows_.setValid(row, true);
+    if (!outputRanges_.empty()) {
+      auto& last = outputRanges_.back();
+      if (last.targetIndex + last.count == row) {
+        // The source rows of a stream are always consecutive.
+        ++last.count;
+        return currentSourceRow_ == data_->size() - 1;
+      }
+    }
+    outputRanges_.push_back({currentSourceRow_, row, 1});
     return currentSourceRow_ == data_->size() - 1;
   }
 
   /// Called if either current row is the last row in the current batch or the
   /// caller accumulated enough output rows across all sources to produce an
-  /// output batch.
+  /// output batch. Copies each run of consecutive output rows from this
+  /// stream with one copyRanges() call.
   void copyToOutput(RowVectorPtr& output);
 
  private:
+  // Compares 'row' of this stream's batch with 'otherRow' of the batch of
+  // 'other'.
+  int32_t compareRows(
+      vector_size_t row,
+      const SourceStream& other,
+      vector_size_t otherRow) const;
+
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Encodes the first sorting key of each row of 'data_' into 'prefixes_' if
+  // the key is of a fixed width type supported by PrefixSortEncoder.
+  void encodePrefixes();
+
+  template <TypeKind Kind>
+  void encodePrefixes(const BaseVector& keys);
+
+  const char* prefix(vector_size_t row) const {
+    return prefixes_.data() + row * prefixSize_;
+  }
+
   MergeSource* source_;
 
   const std::vector<SpillSortKey>& sortingKeys_;
@@ -259,6 +296,13 @@ class SourceStream final : public MergeStream {
   /// order as 'sortingKeys_'.
   std::vector<BaseVector*> keyColumns_;
 
+  /// Memcmp comparable encodings of the first sorting key of the rows of
+  /// 'data_', 'prefixSize_' bytes per row. The encodings are complete, i.e.
+  /// two rows with equal prefixes have equal first keys. Empty if the first
+  /// key is not of a supported type.
+  std::vector<char> prefixes_;
+  uint32_t prefixSize_{0};
+
   /// Index of the current row.
   vector_size_t currentSourceRow_{0};
 
@@ -269,14 +313,9 @@ class SourceStream final : public MergeStream {
   /// returned by 'source_->next()'.
   bool needData_{true};
 
-  /// First source row that hasn't been copied out yet.
-  vector_size_t firstSourceRow_{0};
-
-  /// Output row numbers for source rows that haven't been copied out yet.
-  SelectivityVector outputRows_;
-
-  /// Reusable memory.
-  std::vector<vector_size_t> sourceRows_;
+  /// Runs of consecutive source rows that haven't been copied out yet and
+  /// their output rows.
+  std::vector<BaseVector::CopyRange> outputRanges_;
 };
 
 /// A utility class for sort-merging data from data spilled by the `LocalMerge`
@@ -721,8 +721,112 @@ vector_size_t firstNonNull(
   }
   return rowVector->size();
 }
+
+bool mayHaveNullKeys(
+    const RowVectorPtr& rowVector,
+    const std::vector<column_index_t>& keys) {
+  for (auto key : keys) {
+    if (rowVector->childAt(key)->loadedVector()->mayHaveNulls()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the first row in ['begin', 'end') for which 'isLess' is false, given
+// that it is true for some prefix of the rows and false for the rest. Probes
+// at exponentially growing distances from 'begin', then binary searches the
+// last step.
+template <typename IsLess>
+vector_size_t gallop(vector_size_t begin, vector_size_t end, IsLess isLess) {
+  vector_size_t step = 1;
+  while (begin + step < end && isLess(begin + step)) {
+    begin += step;
+    step *= 2;
+  }
+  end = std::min(end, begin + step);
+  ++begin;
+  while (begin < end) {
+    const auto middle = begin + (end - begin) / 2;
+    if (isLess(middle)) {
+      begin = middle + 1;
+    } else {
+      end = middle;
+    }
+  }
+  return begin;
+}
+
+template <typename T>
+vector_size_t flatLowerBound(
+    const BaseVector& keys,
+    vector_size_t begin,
+    const BaseVector& otherKeys,
+    vector_size_t otherIndex) {
+  const auto* rawValues = keys.asUnchecked<FlatVector<T>>()->rawValues();
+  const auto key = otherKeys.asUnchecked<FlatVector<T>>()->valueAt(otherIndex);
+  return std::lower_bound(rawValues + begin, rawValues + keys.size(), key) -
+      rawValues;
+}
+
+// Returns the first row at or after 'begin' of 'keys' that is not less than
+// row 'otherIndex' of 'otherKeys' if both are flat vectors of the same integer
+// type, or std::nullopt otherwise.
+std::optional<vector_size_t> flatIntegerLowerBound(
+    const BaseVector& keys,
+    vector_size_t begin,
+    const BaseVector& otherKeys,
+    vector_size_t otherIndex) {
+  if (keys.encoding() != VectorEncoding::Simple::FLAT ||
+      otherKeys.encoding() != VectorEncoding::Simple::FLAT ||
+      keys.typeKind() != otherKeys.typeKind() ||
+      keys.type()->providesCustomComparison() ||
+      otherKeys.isNullAt(otherIndex)) {
+    return std::nullopt;
+  }
+  switch (keys.typeKind()) {
+    case TypeKind::TINYINT:
+      return flatLowerBound<int8_t>(keys, begin, otherKeys, otherIndex);
+    case TypeKind::SMALLINT:
+      return flatLowerBound<int16_t>(keys, begin, otherKeys, otherIndex);
+    case TypeKind::INTEGER:
+      return flatLowerBound<int32_t>(keys, begin, otherKeys, otherIndex);
+    case TypeKind::BIGINT:
+      return flatLowerBound<int64_t>(keys, begin, otherKeys, otherIndex);
+    default:
+      return std::nullopt;
+  }
+}
 } // namespace
 
+// static
+vector_size_t MergeJoin::lowerBound(
+    const std::vector<column_index_t>& keys,
+    const RowVectorPtr& batch,
+    vector_size_t startRow,
+    const std::vector<column_index_t>& otherKeys,
+    const RowVectorPtr& otherBatch,
+    vector_size_t otherIndex) {
+  const auto numRows = batch->size();
+  auto isLess = [&](vector_size_t row) {
+    return compare(keys, batch, row, otherKeys, otherBatch, otherIndex) < 0;
+  };
+  // Most of the time the next row already catches up.
+  if (startRow >= numRows || !isLess(startRow)) {
+    return startRow;
+  }
+  if (keys.size() == 1) {
+    if (auto row = flatIntegerLowerBound(
+            *batch->childAt(keys[0])->loadedVector(),
+            startRow + 1,
+            *otherBatch->childAt(otherKeys[0])->loadedVector(),
+            otherIndex)) {
+      return row.value();
+    }
+  }
+  return gallop(startRow, numRows, isLess);
+}
+
 RowVectorPtr MergeJoin::filterOutputForAntiJoin(const RowVectorPtr& output) {
   const auto numRows = output->size();
   const auto& filterRows = joinTracker_->matchingRows(numRows);
@@ -835,7 +939,9 @@ bool MergeJoin::getNextFromRightSide() {
   VELOX_CHECK(needsInputFromRightSide());
   if (rightSource_ == nullptr) {
     rightSource_ = operatorCtx_->task()->getMergeJoinSource(
-        operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+        operatorCtx_->driverCtx()->splitGroupId,
+        planNodeId(),
+        operatorCtx_->driverCtx()->driverId);
   }
 
   while (!rightHasNoInput() && !rightInput_) {
@@ -955,6 +1061,14 @@ RowVectorPtr MergeJoin::doGetOutput() {
         if (!tryAddOutputRowForLeftJoin()) {
           return std::move(output_);
         }
+      } else if (!mayHaveNullKeys(input_, leftKeyChannels_)) {
+        leftRowIndex_ = lowerBound(
+            leftKeyChannels_,
+            input_,
+            leftRowIndex_ + 1,
+            rightKeyChannels_,
+            rightInput_,
+            rightRowIndex_);
       } else {
         leftRowIndex_ =
             firstNonNull(input_, leftKeyChannels_, leftRowIndex_ + 1);
@@ -979,6 +1093,14 @@ RowVectorPtr MergeJoin::doGetOutput() {
         if (!tryAddOutputRowForRightJoin()) {
           return std::move(output_);
         }
+      } else if (!mayHaveNullKeys(rightInput_, rightKeyChannels_)) {
+        rightRowIndex_ = lowerBound(
+            rightKeyChannels_,
+            rightInput_,
+            rightRowIndex_ + 1,
+            leftKeyChannels_,
+            input_,
+            leftRowIndex_);
       } else {
         rightRowIndex_ =
             firstNonNull(rightInput_, rightKeyChannels_, rightRowIndex_ + 1);
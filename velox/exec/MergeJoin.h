@@ -88,6 +88,19 @@ class MergeJoin : public Operator {
       const RowVectorPtr& otherBatch,
       vector_size_t otherIndex);
 
+  // Returns the first row at or after 'startRow' of 'batch' whose keys are not
+  // less than the keys of row 'otherIndex' of 'otherBatch', or the size of
+  // 'batch' if there is none. The keys of 'batch' must have no nulls. Checks
+  // 'startRow' first, then gallops over the rows that are less. A single
+  // integer key of flat vectors is compared on the raw values.
+  static vector_size_t lowerBound(
+      const std::vector<column_index_t>& keys,
+      const RowVectorPtr& batch,
+      vector_size_t startRow,
+      const std::vector<column_index_t>& otherKeys,
+      const RowVectorPtr& otherBatch,
+      vector_size_t otherIndex);
+
   // Compare rows on the left and right at index_ and rightIndex_ respectively.
   int32_t compare() const {
     return compare(
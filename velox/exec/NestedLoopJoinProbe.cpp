@@ -45,8 +45,194 @@ std::vector<IdentityProjection> extractProjections(
   return projections;
 }
 
+// Returns the name of a function without the catalog and schema prefix.
+std::string_view functionName(const std::string& name) {
+  const auto pos = name.rfind('.');
+  if (pos == std::string::npos) {
+    return name;
+  }
+  return std::string_view(name).substr(pos + 1);
+}
+
+bool isRangeKeyType(const TypePtr& type) {
+  if (type->providesCustomComparison()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the operator to use when the operands of 'op' are swapped.
+NestedLoopJoinRangeKey::Op flip(NestedLoopJoinRangeKey::Op op) {
+  using Op = NestedLoopJoinRangeKey::Op;
+  switch (op) {
+    case Op::kLt:
+      return Op::kGt;
+    case Op::kLte:
+      return Op::kGte;
+    case Op::kGt:
+      return Op::kLt;
+    case Op::kGte:
+      return Op::kLte;
+  }
+  VELOX_UNREACHABLE();
+}
+
+std::optional<NestedLoopJoinRangeKey> rangeKeyFromComparison(
+    NestedLoopJoinRangeKey::Op op,
+    const core::TypedExprPtr& left,
+    const core::TypedExprPtr& right,
+    const RowType& probeType,
+    const RowType& buildType) {
+  auto* leftField = left->asUnchecked<core::FieldAccessTypedExpr>();
+  auto* rightField = right->asUnchecked<core::FieldAccessTypedExpr>();
+  if (leftField == nullptr || rightField == nullptr ||
+      !leftField->isInputColumn() || !rightField->isInputColumn() ||
+      !left->type()->equivalent(*right->type()) ||
+      !isRangeKeyType(left->type())) {
+    return std::nullopt;
+  }
+  auto probeChannel = probeType.getChildIdxIfExists(leftField->name());
+  auto buildChannel = buildType.getChildIdxIfExists(rightField->name());
+  if (probeChannel.has_value() && buildChannel.has_value()) {
+    return NestedLoopJoinRangeKey{
+        probeChannel.value(), buildChannel.value(), op};
+  }
+  probeChannel = probeType.getChildIdxIfExists(rightField->name());
+  buildChannel = buildType.getChildIdxIfExists(leftField->name());
+  if (probeChannel.has_value() && buildChannel.has_value()) {
+    return NestedLoopJoinRangeKey{
+        probeChannel.value(), buildChannel.value(), flip(op)};
+  }
+  return std::nullopt;
+}
+
+std::optional<NestedLoopJoinRangeKey> findRangeKey(
+    const core::TypedExprPtr& expr,
+    const RowType& probeType,
+    const RowType& buildType) {
+  using Op = NestedLoopJoinRangeKey::Op;
+  if (!expr->isCallKind()) {
+    return std::nullopt;
+  }
+  const auto* call = expr->asUnchecked<core::CallTypedExpr>();
+  const auto name = functionName(call->name());
+  const auto& inputs = call->inputs();
+  if (name == "and") {
+    for (const auto& input : inputs) {
+      if (auto key = findRangeKey(input, probeType, buildType)) {
+        return key;
+      }
+    }
+    return std::nullopt;
+  }
+  if (name == "between" && inputs.size() == 3) {
+    // 'x BETWEEN low AND high' implies 'x >= low' and 'x <= high'.
+    if (auto key = rangeKeyFromComparison(
+            Op::kGte, inputs[0], inputs[1], probeType, buildType)) {
+      return key;
+    }
+    return rangeKeyFromComparison(
+        Op::kLte, inputs[0], inputs[2], probeType, buildType);
+  }
+  if (inputs.size() != 2) {
+    return std::nullopt;
+  }
+  static const folly::F14FastMap<std::string_view, Op> kComparisons = {
+      {"lt", Op::kLt},
+      {"lte", Op::kLte},
+      {"gt", Op::kGt},
+      {"gte", Op::kGte},
+  };
+  auto it = kComparisons.find(name);
+  if (it == kComparisons.end()) {
+    return std::nullopt;
+  }
+  return rangeKeyFromComparison(
+      it->second, inputs[0], inputs[1], probeType, buildType);
+}
+
 } // namespace
 
+// static
+std::optional<NestedLoopJoinRangeKey> NestedLoopJoinRangeKey::find(
+    const core::NestedLoopJoinNode& joinNode) {
+  if (joinNode.joinCondition() == nullptr) {
+    return std::nullopt;
+  }
+  return findRangeKey(
+      joinNode.joinCondition(),
+      *joinNode.sources()[0]->outputType(),
+      *joinNode.sources()[1]->outputType());
+}
+
+std::vector<vector_size_t> NestedLoopJoinRangeKey::sortBuildRows(
+    const RowVector& buildVector) const {
+  const auto& keys = buildVector.childAt(buildChannel);
+  std::vector<vector_size_t> rows;
+  rows.reserve(buildVector.size());
+  for (auto row = 0; row < buildVector.size(); ++row) {
+    // A null key never satisfies the comparison.
+    if (!keys->isNullAt(row)) {
+      rows.push_back(row);
+    }
+  }
+  keys->sortIndices(rows, CompareFlags());
+  return rows;
+}
+
+std::pair<vector_size_t, vector_size_t> NestedLoopJoinRangeKey::candidateRows(
+    const RowVector& probeVector,
+    vector_size_t probeRow,
+    const RowVector& buildVector,
+    const std::vector<vector_size_t>& sortedBuildRows) const {
+  const auto& probeKeys = probeVector.childAt(probeChannel);
+  if (probeKeys->isNullAt(probeRow)) {
+    return {0, 0};
+  }
+  const auto& buildKeys = buildVector.childAt(buildChannel);
+  const vector_size_t numRows = sortedBuildRows.size();
+  // Returns the offset of the first sorted build row whose key is greater
+  // than the probe key, or greater than or equal to it if 'orEqual' is true.
+  auto partitionPoint = [&](bool orEqual) {
+    vector_size_t begin = 0;
+    vector_size_t end = numRows;
+    while (begin < end) {
+      const auto middle = begin + (end - begin) / 2;
+      const auto result = buildKeys->compare(
+          probeKeys.get(), sortedBuildRows[middle], probeRow);
+      if (orEqual ? result < 0 : result <= 0) {
+        begin = middle + 1;
+      } else {
+        end = middle;
+      }
+    }
+    return begin;
+  };
+  switch (op) {
+    case Op::kLt:
+      return {partitionPoint(false), numRows};
+    case Op::kLte:
+      return {partitionPoint(true), numRows};
+    case Op::kGt:
+      return {0, partitionPoint(true)};
+    case Op::kGte:
+      return {0, partitionPoint(false)};
+  }
+  VELOX_UNREACHABLE();
+}
+
 NestedLoopJoinProbe::NestedLoopJoinProbe(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -75,6 +261,7 @@ void NestedLoopJoinProbe::initialize() {
         joinNode_->joinCondition(),
         joinNode_->sources()[0]->outputType(),
         joinNode_->sources()[1]->outputType());
+    rangeKey_ = NestedLoopJoinRangeKey::find(*joinNode_);
   }
 
   joinNode_.reset();
@@ -184,6 +371,7 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
     probeSideEmpty_ = false;
   }
   VELOX_CHECK_EQ(buildIndex_, 0);
+  filterTileProbeRows_ = 0;
 }
 
 void NestedLoopJoinProbe::noMoreInput() {
@@ -211,6 +399,12 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   }
 
   buildVectors_ = std::move(buildData);
+  if (rangeKey_.has_value()) {
+    sortedBuildRows_.reserve(buildVectors_->size());
+    for (const auto& buildVector : buildVectors_.value()) {
+      sortedBuildRows_.push_back(rangeKey_->sortBuildRows(*buildVector));
+    }
+  }
   return true;
 }
 
@@ -376,12 +570,18 @@ bool NestedLoopJoinProbe::addToOutput() {
 
     // Only re-calculate the filter if we have a new build vector.
     if (buildRow_ == 0) {
+      if (!selectCandidateBuildRows(*currentBuild)) {
+        ++buildIndex_;
+        continue;
+      }
       evaluateJoinFilter(currentBuild);
     }
 
     // Iterate over the filter results. For each match, add an output record.
-    for (size_t i = buildRow_; i < decodedFilterResult_.size(); ++i) {
-      if (!isJoinConditionMatch(i)) {
+    for (size_t i = std::max(buildRow_, filterInputRows_.begin());
+         i < filterInputRows_.end();
+         ++i) {
+      if (!filterInputRows_.isValid(i) || !isJoinConditionMatch(i)) {
         continue;
       }
 
@@ -486,6 +686,36 @@ void NestedLoopJoinProbe::prepareOutput() {
 }
 
 void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
+  const auto tileProbeRows = filterTileProbeRows(*buildVector);
+  if (tileProbeRows > 1) {
+    if (filterTileProbeRows_ == 0 || probeRow_ < filterTileProbeStart_ ||
+        probeRow_ >= filterTileProbeStart_ + filterTileProbeRows_) {
+      filterTileProbeStart_ = probeRow_;
+      filterTileProbeRows_ =
+          std::min(tileProbeRows, input_->size() - probeRow_);
+      auto filterInput = genCrossProductTile(
+          buildVector,
+          filterInputType_,
+          filterProbeProjections_,
+          filterBuildProjections_,
+          filterTileProbeStart_,
+          filterTileProbeRows_);
+      filterTileRows_.resizeFill(filterInput->size(), true);
+
+      std::vector<VectorPtr> filterResult;
+      EvalCtx evalCtx(
+          operatorCtx_->execCtx(), joinCondition_.get(), filterInput.get());
+      joinCondition_->eval(0, 1, true, filterTileRows_, evalCtx, filterResult);
+      filterOutput_ = filterResult[0];
+      decodedFilterResult_.decode(*filterOutput_, filterTileRows_);
+    }
+    filterTileOffset_ =
+        (probeRow_ - filterTileProbeStart_) * buildVector->size();
+    return;
+  }
+  filterTileProbeRows_ = 0;
+  filterTileOffset_ = 0;
+
   // First step to process is to get a batch so we can evaluate the join
   // filter.
   auto filterInput = getNextCrossProductBatch(
@@ -494,10 +724,7 @@ void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
       filterProbeProjections_,
       filterBuildProjections_);
 
-  if (filterInputRows_.size() != filterInput->size()) {
-    filterInputRows_.resizeFill(filterInput->size(), true);
-  }
-  VELOX_CHECK(filterInputRows_.isAllSelected());
+  VELOX_CHECK_EQ(filterInputRows_.size(), filterInput->size());
 
   std::vector<VectorPtr> filterResult;
   EvalCtx evalCtx(
@@ -507,6 +734,47 @@ void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
   decodedFilterResult_.decode(*filterOutput_, filterInputRows_);
 }
 
+vector_size_t NestedLoopJoinProbe::filterTileProbeRows(
+    const RowVector& buildVector) const {
+  // Left semi project join stops at the first match of a probe row, so a tile
+  // would evaluate the condition over rows that are otherwise skipped.
+  if (rangeKey_.has_value() || !isSingleBuildVector() ||
+      isLeftSemiProjectJoin(joinType_)) {
+    return 1;
+  }
+  uint64_t rowBytes{1};
+  for (const auto& type : filterInputType_->children()) {
+    rowBytes += type->isFixedWidth() ? type->cppSizeInBytes()
+                                     : sizeof(StringView);
+  }
+  const uint64_t tileRows = kFilterTileBytes / rowBytes;
+  return std::max<uint64_t>(1, tileRows / buildVector.size());
+}
+
+bool NestedLoopJoinProbe::selectCandidateBuildRows(
+    const RowVector& buildVector) {
+  if (!rangeKey_.has_value()) {
+    if (filterInputRows_.size() != buildVector.size()) {
+      filterInputRows_.resizeFill(buildVector.size(), true);
+    }
+    return true;
+  }
+
+  const auto& sortedRows = sortedBuildRows_[buildIndex_];
+  const auto [begin, end] =
+      rangeKey_->candidateRows(*input_, probeRow_, buildVector, sortedRows);
+  numSkippedBuildRows_ += buildVector.size() - (end - begin);
+  if (begin == end) {
+    return false;
+  }
+  filterInputRows_.resizeFill(buildVector.size(), false);
+  for (auto i = begin; i < end; ++i) {
+    filterInputRows_.setValid(sortedRows[i], true);
+  }
+  filterInputRows_.updateBounds();
+  return true;
+}
+
 RowVectorPtr NestedLoopJoinProbe::getNextCrossProductBatch(
     const RowVectorPtr& buildVector,
     const RowTypePtr& outputType,
@@ -558,7 +826,6 @@ RowVectorPtr NestedLoopJoinProbe::genCrossProductSingleBuildVector(
     const std::vector<IdentityProjection>& probeProjections,
     const std::vector<IdentityProjection>& buildProjections) {
   VELOX_CHECK(isSingleBuildVector());
-  std::vector<VectorPtr> projectedChildren(outputType->size());
   const auto buildRowCount = buildVector->size();
 
   // Calculate how many probe rows we can cover without exceeding
@@ -569,22 +836,40 @@ RowVectorPtr NestedLoopJoinProbe::genCrossProductSingleBuildVector(
     probeRowCount_ =
         std::min(outputBatchSize_ / buildRowCount, input_->size() - probeRow_);
   }
-  const size_t numOutputRows = probeRowCount_ * buildRowCount;
+  return genCrossProductTile(
+      buildVector,
+      outputType,
+      probeProjections,
+      buildProjections,
+      probeRow_,
+      probeRowCount_);
+}
+
+RowVectorPtr NestedLoopJoinProbe::genCrossProductTile(
+    const RowVectorPtr& buildVector,
+    const RowTypePtr& outputType,
+    const std::vector<IdentityProjection>& probeProjections,
+    const std::vector<IdentityProjection>& buildProjections,
+    vector_size_t probeRowStart,
+    vector_size_t numProbeRows) {
+  std::vector<VectorPtr> projectedChildren(outputType->size());
+  const auto buildRowCount = buildVector->size();
+  const size_t numOutputRows = numProbeRows * buildRowCount;
 
   // Generate probe dictionary indices.
   auto rawProbeIndices =
       initializeRowNumberMapping(probeIndices_, numOutputRows, pool());
-  for (auto i = 0; i < probeRowCount_; ++i) {
+  for (auto i = 0; i < numProbeRows; ++i) {
     std::fill(
         rawProbeIndices.begin() + i * buildRowCount,
         rawProbeIndices.begin() + (i + 1) * buildRowCount,
-        probeRow_ + i);
+        probeRowStart + i);
   }
 
   // Generate build dictionary indices.
   auto rawBuildIndices_ =
       initializeRowNumberMapping(buildIndices_, numOutputRows, pool());
-  for (auto i = 0; i < probeRowCount_; ++i) {
+  for (auto i = 0; i < numProbeRows; ++i) {
     std::iota(
         rawBuildIndices_.begin() + i * buildRowCount,
         rawBuildIndices_.begin() + (i + 1) * buildRowCount,
@@ -693,6 +978,12 @@ void NestedLoopJoinProbe::finishProbeInput() {
   buildIndex_ = 0;
   probeRow_ = 0;
 
+  if (numSkippedBuildRows_ > 0) {
+    addRuntimeStat(
+        "rangeJoinSkippedBuildRows", RuntimeCounter(numSkippedBuildRows_));
+    numSkippedBuildRows_ = 0;
+  }
+
   if (!noMoreInput_) {
     return;
   }
@@ -21,6 +21,38 @@
 
 namespace facebook::velox::exec {
 
+/// A conjunct of a nested loop join condition of the form 'probe <op> build',
+/// where 'probe' and 'build' are columns of the probe and build inputs of the
+/// same type, e.g. 'p.ts >= b.start_ts'. Once the rows of a build vector are
+/// sorted on 'build', the rows that can satisfy the conjunct for a given probe
+/// value are a contiguous range of the sorted rows, which is found by binary
+/// search.
+struct NestedLoopJoinRangeKey {
+  enum class Op { kLt, kLte, kGt, kGte };
+
+  column_index_t probeChannel;
+  column_index_t buildChannel;
+  Op op;
+
+  /// Returns the first conjunct of the join condition of 'joinNode' that can
+  /// be used as a range key, or std::nullopt if there is none.
+  static std::optional<NestedLoopJoinRangeKey> find(
+      const core::NestedLoopJoinNode& joinNode);
+
+  /// Returns the rows of 'buildVector' with a non-null key, sorted on the
+  /// key.
+  std::vector<vector_size_t> sortBuildRows(const RowVector& buildVector) const;
+
+  /// Returns the begin and end offsets into 'sortedBuildRows' of the build
+  /// rows that may satisfy the conjunct for row 'probeRow' of 'probeVector'.
+  /// No other build row satisfies it.
+  std::pair<vector_size_t, vector_size_t> candidateRows(
+      const RowVector& probeVector,
+      vector_size_t probeRow,
+      const RowVector& buildVector,
+      const std::vector<vector_size_t>& sortedBuildRows) const;
+};
+
 /// Implements a Nested Loop Join (NLJ) between records from the probe (input_)
 /// and build (NestedLoopJoinBridge) sides. It supports inner, left, right and
 /// full outer joins.
@@ -38,7 +70,9 @@ namespace facebook::velox::exec {
 /// input, using the following steps:
 ///
 /// 1. Materialize a cross-product batch across probe and build.
-/// 2. Evaluate the join condition.
+/// 2. Evaluate the join condition. If the join condition has a range key (see
+///    NestedLoopJoinRangeKey), it is only evaluated on the build rows whose
+///    key is in the range allowed by the probe row.
 /// 3. Add key matches to the output.
 /// 4. Once all build vectors are processed for a particular probe row, check if
 ///    a probe mismatch is needed (only for left and full outer joins).
@@ -143,11 +177,25 @@ class NestedLoopJoinProbe : public Operator {
 
   // Evaluates the joinCondition for a given build vector. This method sets
   // `filterOutput_` and `decodedFilterResult_`, which will be ready to be used
-  // by `isJoinConditionMatch(buildRow)` below.
+  // by `isJoinConditionMatch(buildRow)` below. Only the build rows selected in
+  // `filterInputRows_` are evaluated. If `filterTileProbeRows()` is more than
+  // one, the condition is evaluated for a tile of probe rows at once and the
+  // successive probe rows reuse the results.
   void evaluateJoinFilter(const RowVectorPtr& buildVector);
 
+  // Returns the number of probe rows to evaluate the join condition for at
+  // once against 'buildVector'. The tile of cross product rows is sized to
+  // keep the filter input within `kFilterTileBytes`. Returns 1 if tiling does
+  // not apply.
+  vector_size_t filterTileProbeRows(const RowVector& buildVector) const;
+
+  // Selects in `filterInputRows_` the rows of the current build vector that may
+  // match the current probe row. Returns false if there are none.
+  bool selectCandidateBuildRows(const RowVector& buildVector);
+
   // Checks if the join condition matched for a particular row.
   bool isJoinConditionMatch(vector_size_t i) const {
+    i += filterTileOffset_;
     return (
         !decodedFilterResult_.isNullAt(i) &&
         decodedFilterResult_.valueAt<bool>(i));
@@ -182,6 +230,17 @@ class NestedLoopJoinProbe : public Operator {
       const std::vector<IdentityProjection>& probeProjections,
       const std::vector<IdentityProjection>& buildProjections);
 
+  // Generates the cross product of 'numProbeRows' probe rows starting at
+  // 'probeRowStart' and all the rows of 'buildVector'. Both sides are wrapped
+  // in dictionaries without copy.
+  RowVectorPtr genCrossProductTile(
+      const RowVectorPtr& buildVector,
+      const RowTypePtr& outputType,
+      const std::vector<IdentityProjection>& probeProjections,
+      const std::vector<IdentityProjection>& buildProjections,
+      vector_size_t probeRowStart,
+      vector_size_t numProbeRows);
+
   // As a fallback, process the current probe row to as much build data as
   // possible (probe row as constant, and flat copied data for build records).
   RowVectorPtr genCrossProductMultipleBuildVectors(
@@ -321,6 +380,22 @@ class NestedLoopJoinProbe : public Operator {
   VectorPtr filterOutput_;
   DecodedVector decodedFilterResult_;
 
+  // The target size of the filter input of an evaluation tile. About half of a
+  // typical L2 cache.
+  static constexpr uint64_t kFilterTileBytes{512 << 10};
+
+  // The first probe row and the number of probe rows of the tile the join
+  // condition was last evaluated over. 'filterTileProbeRows_' is 0 if the
+  // condition was not evaluated over a tile.
+  vector_size_t filterTileProbeStart_{0};
+  vector_size_t filterTileProbeRows_{0};
+
+  // Offset of the current probe row results in `decodedFilterResult_`.
+  vector_size_t filterTileOffset_{0};
+
+  // Selects all the rows of a filter evaluation tile.
+  SelectivityVector filterTileRows_;
+
   // Join metadata and state.
   std::shared_ptr<const core::NestedLoopJoinNode> joinNode_;
 
@@ -361,6 +436,19 @@ class NestedLoopJoinProbe : public Operator {
   // Row being currently processed from `buildVectors_[buildIndex_]`.
   vector_size_t buildRow_{0};
 
+  // Set if the join condition compares a probe column with a build column
+  // using <, <=, > or >=. In that case, the join condition is only evaluated on
+  // the build rows whose key is in the range allowed by the probe row.
+  std::optional<NestedLoopJoinRangeKey> rangeKey_;
+
+  // Rows of each build vector with a non-null key, sorted on the key. Only
+  // set if 'rangeKey_' is set.
+  std::vector<std::vector<vector_size_t>> sortedBuildRows_;
+
+  // Number of build rows that the join condition was not evaluated on because
+  // they are outside of the range allowed by the probe row.
+  uint64_t numSkippedBuildRows_{0};
+
   // Keep track of the build rows that had matches (only used for right or full
   // outer joins).
   std::vector<SelectivityVector> buildMatched_;
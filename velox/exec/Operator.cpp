@@ -18,6 +18,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/process/PerfettoTrace.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/OperatorUtils.h"
@@ -285,6 +286,27 @@ RowVectorPtr Operator::fillOutput(
   return fillOutput(size, mapping, results_);
 }
 
+void Operator::prepareReusableOutput(
+    RowVectorPtr& output,
+    vector_size_t size) {
+  if (output == nullptr) {
+    output = BaseVector::create<RowVector>(outputType_, size, pool());
+    recordOutputVectorReuse(false);
+    return;
+  }
+  const auto* previous = output.get();
+  VectorPtr vector = std::move(output);
+  BaseVector::prepareForReuse(vector, size);
+  output = std::static_pointer_cast<RowVector>(vector);
+  recordOutputVectorReuse(output.get() == previous);
+}
+
+void Operator::recordOutputVectorReuse(bool reused) {
+  addRuntimeStat(
+      reused ? kOutputVectorReuses : kOutputVectorAllocations,
+      RuntimeCounter(1));
+}
+
 OperatorStats Operator::stats(bool clear) {
   OperatorStats stats;
   if (!clear) {
@@ -666,6 +688,7 @@ void Operator::MemoryReclaimer::enterArbitration() {
     // terminated.
     VELOX_FAIL("Terminate detected when entering suspension");
   }
+  VELOX_TRACE_BEGIN("velox.memory", "arbitration");
 }
 
 void Operator::MemoryReclaimer::leaveArbitration() noexcept {
@@ -684,6 +707,7 @@ void Operator::MemoryReclaimer::leaveArbitration() noexcept {
           "The current running driver and the request driver must be from the same task");
     }
   }
+  VELOX_TRACE_END("velox.memory");
   runningDriver->task()->leaveSuspended(runningDriver->state());
 }
 
@@ -157,6 +157,21 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kBackgroundCpuTimeNanos =
       "backgroundCpuTimeNanos";
 
+  /// The names of the hardware counter stats collected when
+  /// QueryConfig::kOperatorTrackPerfCounters is enabled.
+  static inline const std::string kPerfInstructions{"perfInstructions"};
+  static inline const std::string kPerfCycles{"perfCycles"};
+  static inline const std::string kPerfCacheMisses{"perfCacheMisses"};
+  static inline const std::string kPerfBranchMisses{"perfBranchMisses"};
+
+  /// The number of output batches an operator produced into a recycled and a
+  /// newly allocated RowVector. Reported by operators that recycle their
+  /// output vectors. The reuse hit rate is kOutputVectorReuses divided by the
+  /// sum of both.
+  static inline const std::string kOutputVectorReuses{"outputVectorReuses"};
+  static inline const std::string kOutputVectorAllocations{
+      "outputVectorAllocations"};
+
   /// The name of the runtime spill stats collected and reported by operators
   /// that support spilling.
 
@@ -598,6 +613,18 @@ class Operator : public BaseRuntimeStatWriter {
   /// 'identityProjections_' and 'resultProjections_'.
   RowVectorPtr fillOutput(vector_size_t size, const BufferPtr& mapping);
 
+  /// Makes 'output' a RowVector of 'outputType_' with 'size' rows for the next
+  /// output batch. Keeps 'output' and its buffers if the consumers of the
+  /// previous batch have released all references to it, otherwise allocates a
+  /// new vector. Children that are not singly referenced are reallocated and
+  /// null children are left as is, see BaseVector::prepareForReuse().
+  void prepareReusableOutput(RowVectorPtr& output, vector_size_t size);
+
+  /// Records whether the next output batch is produced into a recycled vector.
+  /// Called by prepareReusableOutput() and by operators that recycle their
+  /// output by other means.
+  void recordOutputVectorReuse(bool reused);
+
   /// Invoked by the operator to notify driver that it has finished draining
   /// output.
   virtual void finishDrain();
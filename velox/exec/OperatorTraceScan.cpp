@@ -28,7 +28,12 @@ OperatorTraceScan::OperatorTraceScan(
           traceScanNode->outputType(),
           operatorId,
           traceScanNode->id(),
-          "OperatorTraceScan") {
+          "OperatorTraceScan"),
+      inputs_(traceScanNode->inputs()) {
+  if (inputs_ != nullptr) {
+    driverInputs_ = &inputs_->at(driverCtx->driverId);
+    return;
+  }
   traceReader_ = std::make_unique<OperatorTraceInputReader>(
       getOpTraceDirectory(
           traceScanNode->traceDir(),
@@ -39,6 +44,13 @@ OperatorTraceScan::OperatorTraceScan(
 }
 
 RowVectorPtr OperatorTraceScan::getOutput() {
+  if (driverInputs_ != nullptr) {
+    if (nextInput_ < driverInputs_->size()) {
+      return (*driverInputs_)[nextInput_++];
+    }
+    finished_ = true;
+    return nullptr;
+  }
   RowVectorPtr batch;
   if (traceReader_->read(batch)) {
     return batch;
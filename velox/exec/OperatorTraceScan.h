@@ -39,6 +39,9 @@ namespace facebook::velox::exec::trace {
 /// It can be found from the QueryReplayScanNode. However the pipeline ID and
 /// driver ID are only known during operator creation, so we need to figure out
 /// the input traced data file and the output type dynamically.
+///
+/// If the TraceScanNode carries preloaded inputs, the operator returns the
+/// batches of its driver from memory and does not read any file.
 class OperatorTraceScan final : public SourceOperator {
  public:
   OperatorTraceScan(
@@ -55,6 +58,10 @@ class OperatorTraceScan final : public SourceOperator {
   bool isFinished() override;
 
  private:
+  // Set if the inputs are preloaded. Keeps 'driverInputs_' alive.
+  const std::shared_ptr<const core::TraceScanNode::Inputs> inputs_;
+  const std::vector<RowVectorPtr>* driverInputs_{nullptr};
+  size_t nextInput_{0};
   std::unique_ptr<OperatorTraceInputReader> traceReader_;
   bool finished_{false};
 };
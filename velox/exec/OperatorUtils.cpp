@@ -18,6 +18,8 @@
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/serializers/PrestoSerializer.h"
+#include "velox/serializers/StreamDictionarySerializer.h"
+#include "velox/serializers/StringReferenceSerializer.h"
 #include "velox/vector/ConstantVector.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/LazyVector.h"
@@ -581,11 +583,23 @@ std::unique_ptr<Operator> BlockedOperatorFactory::toOperator(
 std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
     common::CompressionKind compressionKind,
     VectorSerde::Kind kind,
-    std::optional<float> minCompressionRatio) {
-  std::unique_ptr<VectorSerde::Options> options =
-      kind == VectorSerde::Kind::kPresto
-      ? std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>()
-      : std::make_unique<VectorSerde::Options>();
+    std::optional<float> minCompressionRatio,
+    bool adaptiveCompression) {
+  std::unique_ptr<VectorSerde::Options> options;
+  if (kind == VectorSerde::Kind::kPresto) {
+    auto prestoOptions = std::make_unique<
+        serializer::presto::PrestoVectorSerde::PrestoOptions>();
+    prestoOptions->adaptiveCompression = adaptiveCompression;
+    options = std::move(prestoOptions);
+  } else if (kind == VectorSerde::Kind::kStreamDictionary) {
+    options = std::make_unique<serializer::StreamDictionaryVectorSerde::
+                                   StreamDictionaryOptions>();
+  } else if (kind == VectorSerde::Kind::kStringReference) {
+    options = std::make_unique<serializer::StringReferenceVectorSerde::
+                                   StringReferenceOptions>();
+  } else {
+    options = std::make_unique<VectorSerde::Options>();
+  }
   options->compressionKind = compressionKind;
   if (minCompressionRatio.has_value()) {
     options->minCompressionRatio = minCompressionRatio.value();
@@ -312,10 +312,13 @@ class BlockedOperatorFactory : public Operator::PlanNodeTranslator {
 };
 
 /// Creates VectorSerde::Options for the given VectorSerde kind with compression
-/// settings. Optionally configures minimum compression ratio.
+/// settings. Optionally configures minimum compression ratio. If
+/// 'adaptiveCompression' is true, the Presto serde picks the codec of each
+/// page. See PrestoVectorSerde::PrestoOptions::adaptiveCompression.
 std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
     common::CompressionKind compressionKind,
     VectorSerde::Kind kind,
-    std::optional<float> minCompressionRatio = std::nullopt);
+    std::optional<float> minCompressionRatio = std::nullopt,
+    bool adaptiveCompression = false);
 
 } // namespace facebook::velox::exec
@@ -16,9 +16,13 @@
 
 #include "velox/exec/ParallelProject.h"
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Task.h"
 
+using facebook::velox::common::testutil::TestValue;
+
 namespace facebook::velox::exec {
 
 ParallelProject::ParallelProject(
@@ -82,6 +86,7 @@ void ParallelProject::initialize() {
     ++exprIdx;
     if (exprIdx == unitSize) {
       // It may be that the only work is loading lazies.
+      work_.back().exprs = unitExprs;
       auto tempExprs =
           makeExprSetFromFlag(std::move(unitExprs), operatorCtx_->execCtx());
       std::shared_ptr<ExprSet> shared(tempExprs.release());
@@ -105,6 +110,8 @@ void ParallelProject::initialize() {
     auto idx = sourceType->getChildIdx(name);
     identityProjections_.emplace_back(idx, outputIdx++);
   }
+  maxMorsels_ = std::max<int32_t>(
+      1, operatorCtx_->driverCtx()->queryConfig().parallelProjectMaxMorsels());
 }
 
 void ParallelProject::addInput(RowVectorPtr input) {
@@ -135,16 +142,31 @@ RowVectorPtr ParallelProject::getOutput() {
   vector_size_t size = input_->size();
   allRows_.resize(size);
   allRows_.setAll();
-  std::vector<std::shared_ptr<AsyncSource<WorkResult>>> pending;
-  std::vector<VectorPtr> results(outputType_->size());
+  std::vector<int32_t> numWorkMorsels(work_.size());
+  for (auto i = 0; i < work_.size(); ++i) {
+    numWorkMorsels[i] = numMorsels(work_[i], size);
+    if (numWorkMorsels[i] > 1) {
+      loadInputs(work_[i]);
+    }
+  }
 
+  std::vector<std::shared_ptr<AsyncSource<WorkResult>>> pending;
+  // Results of each morsel of each work unit.
+  std::vector<std::vector<std::vector<VectorPtr>>> morselResults(work_.size());
   for (auto i = 0; i < work_.size(); ++i) {
-    pending.push_back(
-        std::make_shared<AsyncSource<WorkResult>>(
-            [i, &results, this]() { return doWork(i, results); }));
-    auto item = pending.back();
-    operatorCtx_->task()->queryCtx()->executor()->add(
-        [item]() { item->prepare(); });
+    const auto numMorsels = numWorkMorsels[i];
+    morselResults[i].resize(numMorsels);
+    for (auto morsel = 0; morsel < numMorsels; ++morsel) {
+      pending.push_back(
+          std::make_shared<AsyncSource<WorkResult>>(
+              [i, morsel, numMorsels, &morselResults, this]() {
+                return doWork(
+                    i, morsel, numMorsels, morselResults[i][morsel]);
+              }));
+      auto item = pending.back();
+      operatorCtx_->task()->queryCtx()->executor()->add(
+          [item]() { item->prepare(); });
+    }
   }
   std::exception_ptr error;
   for (auto i = 0; i < pending.size(); ++i) {
@@ -158,6 +180,32 @@ RowVectorPtr ParallelProject::getOutput() {
     std::rethrow_exception(error);
   }
 
+  std::vector<VectorPtr> results(outputType_->size());
+  for (auto i = 0; i < work_.size(); ++i) {
+    const auto numMorsels = numWorkMorsels[i];
+    for (auto& projection : work_[i].resultProjections) {
+      auto& result = results[projection.outputChannel];
+      if (numMorsels == 1) {
+        result = std::move(morselResults[i][0][projection.inputChannel]);
+        continue;
+      }
+      // Each morsel has values for its rows only. Flat results reference the
+      // string buffers of the morsels instead of copying the strings.
+      result = BaseVector::create(
+          outputType_->childAt(projection.outputChannel),
+          size,
+          operatorCtx_->pool());
+      for (auto morsel = 0; morsel < numMorsels; ++morsel) {
+        const auto begin = morselBegin(morsel, numMorsels);
+        result->copy(
+            morselResults[i][morsel][projection.inputChannel].get(),
+            begin,
+            begin,
+            morselBegin(morsel + 1, numMorsels) - begin);
+      }
+    }
+  }
+
   for (auto& projection : identityProjections_) {
     results[projection.outputChannel] =
         input_->childAt(projection.inputChannel);
@@ -168,22 +216,78 @@ RowVectorPtr ParallelProject::getOutput() {
       operatorCtx_->pool(), outputType_, nullptr, size, std::move(results));
 }
 
+int32_t ParallelProject::numMorsels(WorkUnit& work, vector_size_t numRows) {
+  if (maxMorsels_ <= 1 || work.exprs.empty()) {
+    return 1;
+  }
+  TestValue::adjust(
+      "facebook::velox::exec::ParallelProject::numMorsels", &work.nanosPerRow);
+  const int64_t expectedNanos = work.nanosPerRow * numRows;
+  const auto numMorsels = std::max<int64_t>(
+      1,
+      std::min<int64_t>(
+          {maxMorsels_,
+           numRows / kMinMorselRows,
+           expectedNanos / static_cast<int64_t>(kMinMorselNanos)}));
+  while (static_cast<int64_t>(work.morselExprSets.size()) < numMorsels - 1) {
+    work.morselExecCtxs.push_back(
+        std::make_unique<core::ExecCtx>(
+            operatorCtx_->pool(),
+            operatorCtx_->driverCtx()->task->queryCtx().get()));
+    work.morselExprSets.push_back(makeExprSetFromFlag(
+        std::vector<core::TypedExprPtr>(work.exprs),
+        work.morselExecCtxs.back().get()));
+  }
+  return numMorsels;
+}
+
+void ParallelProject::loadInputs(WorkUnit& work) {
+  const auto& inputType = asRowType(input_->type());
+  EvalCtx evalCtx(work.execCtx.get(), work.exprSet.get(), input_.get());
+  for (auto channel : work.loadOnly) {
+    evalCtx.ensureFieldLoaded(channel, allRows_);
+  }
+  for (auto* field : work.exprSet->distinctFields()) {
+    if (!field->inputs().empty()) {
+      continue;
+    }
+    if (auto channel = inputType->getChildIdxIfExists(field->field())) {
+      evalCtx.ensureFieldLoaded(channel.value(), allRows_);
+    }
+  }
+}
+
 std::unique_ptr<ParallelProject::WorkResult> ParallelProject::doWork(
     int32_t workIdx,
+    int32_t morsel,
+    int32_t numMorsels,
     std::vector<VectorPtr>& results) {
   auto& work = work_[workIdx];
-  EvalCtx evalCtx(work.execCtx.get(), work.exprSet.get(), input_.get());
+  auto* execCtx =
+      morsel == 0 ? work.execCtx.get() : work.morselExecCtxs[morsel - 1].get();
+  auto* exprSet =
+      morsel == 0 ? work.exprSet.get() : work.morselExprSets[morsel - 1].get();
+  EvalCtx evalCtx(execCtx, exprSet, input_.get());
   try {
-    for (auto channel : work.loadOnly) {
-      evalCtx.ensureFieldLoaded(channel, allRows_);
+    if (numMorsels == 1) {
+      for (auto channel : work.loadOnly) {
+        evalCtx.ensureFieldLoaded(channel, allRows_);
+      }
     }
 
-    std::vector<VectorPtr> localResults;
-    work.exprSet->eval(
-        0, work.exprSet->exprs().size(), true, allRows_, evalCtx, localResults);
-    for (auto& projection : work.resultProjections) {
-      results[projection.outputChannel] =
-          std::move(localResults[projection.inputChannel]);
+    const auto begin = morselBegin(morsel, numMorsels);
+    const auto end = morselBegin(morsel + 1, numMorsels);
+    SelectivityVector rows(end);
+    rows.setValidRange(0, begin, false);
+    rows.updateBounds();
+    uint64_t nanos{0};
+    {
+      NanosecondTimer timer(&nanos);
+      exprSet->eval(
+          0, exprSet->exprs().size(), true, rows, evalCtx, results);
+    }
+    if (morsel == 0 && end > begin) {
+      work.nanosPerRow = nanos / (end - begin);
     }
   } catch (const std::exception&) {
     return std::make_unique<WorkResult>(std::current_exception());
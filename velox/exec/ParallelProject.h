@@ -57,6 +57,9 @@ class ParallelProject : public Operator {
       if (work.exprSet) {
         work.exprSet->clear();
       }
+      for (auto& exprSet : work.morselExprSets) {
+        exprSet->clear();
+      }
     }
   }
 
@@ -70,6 +73,15 @@ class ParallelProject : public Operator {
     std::vector<column_index_t> loadOnly;
     std::unique_ptr<core::ExecCtx> execCtx;
     std::shared_ptr<ExprSet> exprSet;
+    // The exprs of 'exprSet', for compiling the ExprSets of morsels.
+    std::vector<core::TypedExprPtr> exprs;
+    // ExprSets and their contexts for evaluating row ranges of a batch
+    // concurrently. The first morsel uses 'exprSet' and 'execCtx', morsel i
+    // uses the (i - 1)th of these.
+    std::vector<std::unique_ptr<core::ExecCtx>> morselExecCtxs;
+    std::vector<std::shared_ptr<ExprSet>> morselExprSets;
+    // Wall time per input row of the exprs on the last batch.
+    uint64_t nanosPerRow{0};
   };
 
   struct WorkResult {
@@ -82,9 +94,33 @@ class ParallelProject : public Operator {
   // should return nullptr.
   bool allInputProcessed();
 
+  // Evaluates the exprs of work unit 'workIdx' on the rows of morsel 'morsel'
+  // of 'numMorsels' into 'results'.
   std::unique_ptr<WorkResult> doWork(
       int32_t workIdx,
-      std::vector<VectorPtr>& result);
+      int32_t morsel,
+      int32_t numMorsels,
+      std::vector<VectorPtr>& results);
+
+  // Returns the number of row ranges to split a batch of 'numRows' rows into
+  // for evaluating the exprs of 'work' concurrently, based on their cost per
+  // row on the previous batch. Makes the ExprSets for the morsels.
+  int32_t numMorsels(WorkUnit& work, vector_size_t numRows);
+
+  // Loads the lazy input columns read by 'work', so that its morsels do not
+  // load them concurrently.
+  void loadInputs(WorkUnit& work);
+
+  // Returns the first row of morsel 'morsel' out of 'numMorsels'.
+  vector_size_t morselBegin(int32_t morsel, int32_t numMorsels) const {
+    return static_cast<int64_t>(input_->size()) * morsel / numMorsels;
+  }
+
+  // Minimum number of rows of a morsel.
+  static constexpr vector_size_t kMinMorselRows = 128;
+
+  // Minimum expected wall time of the exprs of a work unit on a morsel.
+  static constexpr uint64_t kMinMorselNanos = 500'000;
 
   // Cached ParallelProject node for lazy initialization. After
   // initialization, they will be reset, and initialized_ will be set to true.
@@ -94,6 +130,9 @@ class ParallelProject : public Operator {
 
   std::vector<WorkUnit> work_;
   SelectivityVector allRows_;
+  // Maximum number of morsels of a work unit. See
+  // QueryConfig::kParallelProjectMaxMorsels.
+  int32_t maxMorsels_{1};
   int32_t numProcessedInputRows_{0};
 };
 
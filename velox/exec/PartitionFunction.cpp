@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <velox/exec/HashPartitionFunction.h>
+#include <velox/exec/RangePartitionFunction.h>
 #include <velox/exec/RoundRobinPartitionFunction.h>
 #include "velox/core/PlanNode.h"
 
@@ -24,6 +25,8 @@ void registerPartitionFunctionSerDe() {
 
   registry.Register(
       "HashPartitionFunctionSpec", HashPartitionFunctionSpec::deserialize);
+  registry.Register(
+      "RangePartitionFunctionSpec", RangePartitionFunctionSpec::deserialize);
   registry.Register(
       "RoundRobinPartitionFunctionSpec",
       RoundRobinPartitionFunctionSpec::deserialize);
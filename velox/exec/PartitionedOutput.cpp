@@ -18,6 +18,7 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
+#include "velox/vector/FlatMapVector.h"
 
 namespace facebook::velox::exec {
 
@@ -89,7 +90,10 @@ BlockingReason Destination::advance(
     VELOX_CHECK_NOT_NULL(outputUnsafeRow);
     current_->append(*outputUnsafeRow, rows, sizes);
   } else {
-    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
+    VELOX_CHECK(
+        serde_->kind() == VectorSerde::Kind::kPresto ||
+        serde_->kind() == VectorSerde::Kind::kStreamDictionary ||
+        serde_->kind() == VectorSerde::Kind::kStringReference);
     current_->append(output, rows, scratch);
   }
 
@@ -114,13 +118,16 @@ BlockingReason Destination::flush(
   // Upper limit of message size with no columns.
   constexpr int32_t kMinMessageSize = 128;
   auto listener = bufferManager.newListener();
-  IOBufOutputStream stream(
-      *current_->pool(),
-      listener.get(),
-      std::max<int64_t>(kMinMessageSize, current_->size()));
+  IOBufOutputStream stream(*current_->pool(), listener.get(), kMinMessageSize);
+  // The page references the serialized streams of 'current_' instead of
+  // copying them into one buffer. Their memory moves to 'pageArena', which
+  // the page keeps alive.
+  auto pageArena = std::make_shared<StreamArena>(current_->pool());
+  stream.referenceArena(current_.get(), pageArena);
   const int64_t flushedRows = rowsInCurrent_;
 
   current_->flush(&stream);
+  current_->transferTo(*pageArena);
   current_->clear();
 
   const int64_t flushedBytes = stream.tellp();
@@ -194,10 +201,20 @@ PartitionedOutput::PartitionedOutput(
                                               ->queryConfig()
                                               .shuffleCompressionKind()),
           planNode->serdeKind(),
-          PartitionedOutput::minCompressionRatio())) {
+          PartitionedOutput::minCompressionRatio(),
+          operatorCtx_->driverCtx()
+              ->queryConfig()
+              .shuffleCompressionAdaptive())) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
+  // The pages of a stream dictionary destination reference the dictionaries
+  // of its earlier pages, so they must all go to the same consumer.
+  VELOX_USER_CHECK(
+      serde_->kind() != VectorSerde::Kind::kStreamDictionary ||
+          planNode->kind() !=
+              core::PartitionedOutputNode::Kind::kArbitrary,
+      "StreamDictionary serde is not supported with arbitrary output buffers");
   if (numDestinations_ == 1) {
     VELOX_USER_CHECK(keyChannels_.empty());
     VELOX_USER_CHECK_NULL(partitionFunction_);
@@ -230,9 +247,22 @@ void PartitionedOutput::initializeInput(RowVectorPtr input) {
         outputColumns);
   }
 
-  // Lazy load all the input columns.
+  // Lazy load all the input columns. The serialized pages have no flat map
+  // layout, so flat maps are converted once here instead of once per
+  // destination.
   for (auto i = 0; i < output_->childrenSize(); ++i) {
-    output_->childAt(i)->loadedVector();
+    auto* child = output_->childAt(i)->loadedVector();
+    if (child->encoding() == VectorEncoding::Simple::FLAT_MAP) {
+      if (output_ == input_) {
+        output_ = std::make_shared<RowVector>(
+            input_->pool(),
+            outputType_,
+            nullptr /*nulls*/,
+            input_->size(),
+            input_->children());
+      }
+      output_->childAt(i) = child->asUnchecked<FlatMapVector>()->toMapVector();
+    }
   }
 
   if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
@@ -289,7 +319,10 @@ void PartitionedOutput::estimateRowSizes() {
     serde_->estimateSerializedSize(
         outputUnsafeRow_.get(), rows, sizePointers_.data());
   } else {
-    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
+    VELOX_CHECK(
+        serde_->kind() == VectorSerde::Kind::kPresto ||
+        serde_->kind() == VectorSerde::Kind::kStreamDictionary ||
+        serde_->kind() == VectorSerde::Kind::kStringReference);
     serde_->estimateSerializedSize(
         output_.get(), rows, sizePointers_.data(), scratch_);
   }
@@ -310,10 +343,11 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
     destinations_[0]->addRows(IndexRange{0, numInput});
   } else {
     auto singlePartition = partitionFunction_->partition(*input_, partitions_);
+    // The rows before 'start' go to all destinations.
+    vector_size_t start = 0;
     if (replicateNullsAndAny_) {
       collectNullRows();
 
-      vector_size_t start = 0;
       if (!replicatedAny_) {
         for (auto& destination : destinations_) {
           destination->addRow(0);
@@ -345,6 +379,19 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
         }
       }
     }
+    // The rows of the hot keys of a skewed shuffle also go to the next
+    // partitions of their key.
+    const auto& replicatedRows = partitionFunction_->replicatedRows();
+    const auto numReplicas = partitionFunction_->numReplicas();
+    for (const auto row : replicatedRows) {
+      if (row < start || (replicateNullsAndAny_ && nullRows_.isValid(row))) {
+        continue;
+      }
+      for (auto replica = 1; replica < numReplicas; ++replica) {
+        destinations_[(partitions_[row] + replica) % numDestinations_]->addRow(
+            row);
+      }
+    }
   }
 }
 
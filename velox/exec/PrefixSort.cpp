@@ -277,8 +277,19 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
 PrefixSort::PrefixSort(
     const RowContainer* rowContainer,
     const PrefixSortLayout& sortLayout,
-    memory::MemoryPool* pool)
-    : rowContainer_(rowContainer), sortLayout_(sortLayout), pool_(pool) {}
+    memory::MemoryPool* pool,
+    bool radixSort)
+    : rowContainer_(rowContainer),
+      sortLayout_(sortLayout),
+      pool_(pool),
+      radixSort_(radixSort) {
+  if (radixSort_) {
+    VELOX_CHECK(!sortLayout_.hasNonNormalizedKey);
+    VELOX_CHECK_EQ(
+        sortLayout_.nonPrefixSortStartIndex, sortLayout_.numNormalizedKeys);
+    VELOX_CHECK_LE(sortLayout_.normalizedBufferSize, kMaxRadixSortKeyBytes);
+  }
+}
 
 void PrefixSort::extractRowAndEncodePrefixKeys(char* row, char* prefixBuffer) {
   for (auto i = 0; i < sortLayout_.numNormalizedKeys; ++i) {
@@ -324,7 +335,11 @@ uint64_t PrefixSort::maxRequiredBytes(
     return 0;
   }
 
-  const PrefixSort prefixSort(rowContainer, sortLayout, pool);
+  const PrefixSort prefixSort(
+      rowContainer,
+      sortLayout,
+      pool,
+      useRadixSort(sortLayout, rowContainer->numRows(), config));
   return prefixSort.maxRequiredBytes();
 }
 
@@ -349,8 +364,8 @@ uint64_t PrefixSort::maxRequiredBytes() const {
   const auto numRows = rowContainer_->numRows();
   const auto numPages =
       memory::AllocationTraits::numPages(numRows * sortLayout_.entrySize);
-  // Prefix data size + swap buffer size.
-  return memory::AllocationTraits::pageBytes(numPages) +
+  // Prefix data size + radix sort buffer size + swap buffer size.
+  return memory::AllocationTraits::pageBytes(numPages) * (radixSort_ ? 2 : 1) +
       pool_->preferredSize(
           checkedPlus<size_t>(
               sortLayout_.entrySize, AlignedBuffer::kPaddedSize)) +
@@ -388,7 +403,17 @@ void PrefixSort::sortInternal(
           RuntimeCounter(
               sortLayout_.numNormalizedKeys, RuntimeCounter::Unit::kNone));
     }
-    if (sortLayout_.hasNonNormalizedKey ||
+    if (radixSort_) {
+      memory::ContiguousAllocation radixBufferAlloc;
+      pool_->allocateContiguous(
+          prefixBufferAlloc.numPages(), radixBufferAlloc);
+      sortRunner.radixSort(
+          prefixBufferStart,
+          prefixBufferEnd,
+          sortLayout_.normalizedBufferSize,
+          radixBufferAlloc.data<char>());
+    } else if (
+        sortLayout_.hasNonNormalizedKey ||
         sortLayout_.nonPrefixSortStartIndex < sortLayout_.numNormalizedKeys) {
       sortRunner.quickSort(
           prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
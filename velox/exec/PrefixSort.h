@@ -99,10 +99,14 @@ struct PrefixSortLayout {
 
 class PrefixSort {
  public:
+  /// @param radixSort Sorts the prefixes with radix sort instead of quick
+  /// sort. Requires the normalized keys to fully determine the order and to
+  /// take at most kMaxRadixSortKeyBytes.
   PrefixSort(
       const RowContainer* rowContainer,
       const PrefixSortLayout& sortLayout,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      bool radixSort = false);
 
   /// Follow the steps below to sort the data in RowContainer:
   /// 1. Allocate a contiguous block of memory to store normalized keys.
@@ -146,7 +150,11 @@ class PrefixSort {
       return;
     }
 
-    PrefixSort prefixSort(rowContainer, sortLayout, pool);
+    PrefixSort prefixSort(
+        rowContainer,
+        sortLayout,
+        pool,
+        useRadixSort(sortLayout, rowContainer->numRows(), config));
     prefixSort.sortInternal(rows);
   }
 
@@ -163,6 +171,11 @@ class PrefixSort {
   /// The number of prefix sort keys.
   static inline const std::string kNumPrefixSortKeys{"numPrefixSortKeys"};
 
+  /// Maximum bytes of normalized keys, including the padding, to sort with
+  /// radix sort. Radix sort makes one pass over the prefixes per key byte and
+  /// is only faster than quick sort for short keys.
+  static constexpr uint32_t kMaxRadixSortKeyBytes = 16;
+
  private:
   /// Fallback to stdSort when prefix sort conditions such as config and memory
   /// are not satisfied. stdSort provides >2X performance win than std::sort for
@@ -203,8 +216,21 @@ class PrefixSort {
         maxStringLengths);
   }
 
-  // Estimates the memory required for prefix sort such as prefix buffer and
-  // swap buffer.
+  // Returns true if 'numRows' rows with 'sortLayout' should be sorted with
+  // radix sort. Radix sort orders the prefixes by the normalized key bytes
+  // only, so it requires all keys to be fully normalized.
+  FOLLY_ALWAYS_INLINE static bool useRadixSort(
+      const PrefixSortLayout& sortLayout,
+      uint64_t numRows,
+      const velox::common::PrefixSortConfig& config) {
+    return numRows >= config.minNumRadixSortRows &&
+        !sortLayout.hasNonNormalizedKey &&
+        sortLayout.nonPrefixSortStartIndex == sortLayout.numNormalizedKeys &&
+        sortLayout.normalizedBufferSize <= kMaxRadixSortKeyBytes;
+  }
+
+  // Estimates the memory required for prefix sort such as prefix buffer,
+  // swap buffer and radix sort buffer.
   uint64_t maxRequiredBytes() const;
 
   void sortInternal(std::vector<char*, memory::StlAllocator<char*>>& rows);
@@ -225,5 +251,6 @@ class PrefixSort {
   const RowContainer* const rowContainer_;
   const PrefixSortLayout sortLayout_;
   memory::MemoryPool* const pool_;
+  const bool radixSort_;
 };
 } // namespace facebook::velox::exec
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RangePartitionFunction.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::exec {
+
+RangePartitionFunction::RangePartitionFunction(
+    int numPartitions,
+    std::vector<column_index_t> keyChannels,
+    std::vector<core::SortOrder> sortOrders,
+    RowVectorPtr splitPoints)
+    : keyChannels_{std::move(keyChannels)},
+      splitPoints_{std::move(splitPoints)} {
+  VELOX_USER_CHECK_EQ(
+      numPartitions,
+      splitPoints_->size() + 1,
+      "Range partitioning needs one partition more than split points");
+  VELOX_CHECK_EQ(keyChannels_.size(), sortOrders.size());
+  VELOX_CHECK_EQ(keyChannels_.size(), splitPoints_->childrenSize());
+  compareFlags_.reserve(sortOrders.size());
+  for (const auto& sortOrder : sortOrders) {
+    compareFlags_.push_back(
+        {sortOrder.isNullsFirst(),
+         sortOrder.isAscending(),
+         false,
+         CompareFlags::NullHandlingMode::kNullAsValue});
+  }
+}
+
+uint32_t RangePartitionFunction::upperBound(
+    const RowVector& input,
+    vector_size_t row) const {
+  uint32_t low = 0;
+  uint32_t high = splitPoints_->size();
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    int32_t result = 0;
+    for (auto i = 0; i < keyChannels_.size() && result == 0; ++i) {
+      result = input.childAt(keyChannels_[i])
+                   ->compare(
+                       splitPoints_->childAt(i).get(),
+                       row,
+                       middle,
+                       compareFlags_[i])
+                   .value();
+    }
+    if (result < 0) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return low;
+}
+
+std::optional<uint32_t> RangePartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  const auto numRows = input.size();
+  partitions.resize(numRows);
+  for (auto row = 0; row < numRows; ++row) {
+    partitions[row] = upperBound(input, row);
+  }
+  return std::nullopt;
+}
+
+RangePartitionFunctionSpec::RangePartitionFunctionSpec(
+    RowTypePtr inputType,
+    std::vector<column_index_t> keyChannels,
+    std::vector<core::SortOrder> sortOrders,
+    RowVectorPtr splitPoints)
+    : inputType_{std::move(inputType)},
+      keyChannels_{std::move(keyChannels)},
+      sortOrders_{std::move(sortOrders)},
+      splitPoints_{std::move(splitPoints)} {
+  VELOX_USER_CHECK_EQ(keyChannels_.size(), sortOrders_.size());
+  VELOX_USER_CHECK_EQ(keyChannels_.size(), splitPoints_->childrenSize());
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    VELOX_USER_CHECK(
+        inputType_->childAt(keyChannels_[i])
+            ->equivalent(*splitPoints_->type()->childAt(i)),
+        "Split point type doesn't match range partitioning key: {} vs. {}",
+        splitPoints_->type()->childAt(i)->toString(),
+        inputType_->childAt(keyChannels_[i])->toString());
+  }
+}
+
+std::unique_ptr<core::PartitionFunction> RangePartitionFunctionSpec::create(
+    int numPartitions,
+    bool /*localExchange*/) const {
+  return std::make_unique<RangePartitionFunction>(
+      numPartitions, keyChannels_, sortOrders_, splitPoints_);
+}
+
+std::string RangePartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]) << " "
+         << sortOrders_[i].toString();
+  }
+  return fmt::format(
+      "RANGE({}) {} split points", keys.str(), splitPoints_->size());
+}
+
+folly::dynamic RangePartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "RangePartitionFunctionSpec";
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  auto sortOrders = folly::dynamic::array();
+  for (const auto& sortOrder : sortOrders_) {
+    sortOrders.push_back(sortOrder.serialize());
+  }
+  obj["sortOrders"] = std::move(sortOrders);
+
+  // Serialize split points using VectorSaver.
+  std::ostringstream out;
+  saveVector(*splitPoints_, out);
+  const auto serialized = out.str();
+  obj["splitPoints"] =
+      encoding::Base64::encode(serialized.data(), serialized.size());
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr RangePartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  std::vector<core::SortOrder> sortOrders;
+  for (const auto& sortOrder : obj["sortOrders"]) {
+    sortOrders.push_back(core::SortOrder::deserialize(sortOrder));
+  }
+
+  const auto serialized =
+      encoding::Base64::decode(obj["splitPoints"].asString());
+  std::istringstream in(serialized);
+  auto* pool = static_cast<memory::MemoryPool*>(context);
+  auto splitPoints =
+      std::dynamic_pointer_cast<RowVector>(restoreVector(in, pool));
+
+  return std::make_shared<RangePartitionFunctionSpec>(
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      ISerializable::deserialize<std::vector<column_index_t>>(
+          obj["keyChannels"], context),
+      std::move(sortOrders),
+      std::move(splitPoints));
+}
+} // namespace facebook::velox::exec
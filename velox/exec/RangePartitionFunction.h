@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Assigns rows to partitions by ranges of the sort keys. 'splitPoints' has
+/// one column per key channel and N - 1 rows sorted by 'sortOrders' for N
+/// partitions. A row goes to partition i if it sorts at or after split point
+/// i - 1 and before split point i. Partition i therefore holds only keys that
+/// sort before the keys of partition i + 1, so sorting each partition and
+/// concatenating them in partition order gives a total order. The split
+/// points are typically quantiles of a sample of the keys.
+class RangePartitionFunction : public core::PartitionFunction {
+ public:
+  RangePartitionFunction(
+      int numPartitions,
+      std::vector<column_index_t> keyChannels,
+      std::vector<core::SortOrder> sortOrders,
+      RowVectorPtr splitPoints);
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+ private:
+  // Returns the index of the first split point that sorts after 'row' of
+  // 'input', or the number of split points if there is none.
+  uint32_t upperBound(const RowVector& input, vector_size_t row) const;
+
+  const std::vector<column_index_t> keyChannels_;
+  const RowVectorPtr splitPoints_;
+  std::vector<CompareFlags> compareFlags_;
+};
+
+/// Factory class to create RangePartitionFunction. The number of partitions
+/// must be one more than the number of split points.
+class RangePartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  RangePartitionFunctionSpec(
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels,
+      std::vector<core::SortOrder> sortOrders,
+      RowVectorPtr splitPoints);
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions,
+      bool localExchange) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+  const std::vector<core::SortOrder> sortOrders_;
+  const RowVectorPtr splitPoints_;
+};
+} // namespace facebook::velox::exec
@@ -16,6 +16,8 @@
 
 #include "velox/exec/RowContainer.h"
 
+#include <folly/ScopeGuard.h>
+
 #include "velox/common/memory/RawVector.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/ContainerRowSerde.h"
@@ -166,7 +168,8 @@ RowContainer::RowContainer(
   // columns or accumulators, i.e. ones that allocate extra space, this space is
   // tracked by a uint32_t after the dependent columns. If this is a hash join
   // build side, the pointer to the next row with the same key is after the
-  // optional row size.
+  // optional row size. See 'compactKeys_' for a join build layout that puts
+  // both before the dependent fields.
   //
   // In most cases, rows are prefixed with a normalized_key_t at index
   // -1, 8 bytes below the pointer. This space is reserved for a 64
@@ -235,17 +238,38 @@ RowContainer::RowContainer(
     offsets_.push_back(offset);
     offset += accumulator.fixedWidthSize();
   }
+  auto addRowSizeAndNext = [&]() {
+    if (isVariableWidth) {
+      rowSizeOffset_ = offset;
+      offset += sizeof(uint32_t);
+    }
+    if (hasNext) {
+      nextOffset_ = offset;
+      offset += sizeof(void*);
+    }
+  };
+  // A hash join build with narrow keys and a wide payload puts the row size
+  // and the next row pointer before the dependents. Probes compare the keys,
+  // check the flags and follow the duplicates within the first cache line of
+  // the row and only touch the payload for the hits.
+  int32_t dependentsSize = 0;
+  for (auto& type : dependentTypes) {
+    dependentsSize += typeKindSize(type->kind());
+  }
+  const int32_t keysSize = offset +
+      (isVariableWidth ? sizeof(uint32_t) : 0) + (hasNext ? sizeof(void*) : 0);
+  compactKeys_ = isJoinBuild_ && accumulators.empty() &&
+      keysSize <= kCompactKeysBytes &&
+      keysSize + dependentsSize > kCompactKeysBytes;
+  if (compactKeys_) {
+    addRowSizeAndNext();
+  }
   for (auto& type : dependentTypes) {
     offsets_.push_back(offset);
     offset += typeKindSize(type->kind());
   }
-  if (isVariableWidth) {
-    rowSizeOffset_ = offset;
-    offset += sizeof(uint32_t);
-  }
-  if (hasNext) {
-    nextOffset_ = offset;
-    offset += sizeof(void*);
+  if (!compactKeys_) {
+    addRowSizeAndNext();
   }
   fixedRowSize_ = bits::roundUp(offset, alignment_);
   originalNormalizedKeySize_ = hasNormalizedKeys_
@@ -826,9 +850,12 @@ int32_t RowContainer::compareStringAsc(
     StringView left,
     const DecodedVector& decoded,
     vector_size_t index) {
+  const auto right = decoded.valueAt<StringView>(index);
+  if (const auto result = left.comparePrefix(right)) {
+    return *result;
+  }
   std::string storage;
-  return HashStringAllocator::contiguousString(left, storage)
-      .compare(decoded.valueAt<StringView>(index));
+  return HashStringAllocator::contiguousString(left, storage).compare(right);
 }
 
 // static
@@ -845,6 +872,10 @@ int RowContainer::compareComplexType(
 }
 
 int32_t RowContainer::compareStringAsc(StringView left, StringView right) {
+  // Decide on the inlined part first to avoid copying non-contiguous strings.
+  if (const auto result = left.comparePrefix(right)) {
+    return *result;
+  }
   std::string leftStorage;
   std::string rightStorage;
   return HashStringAllocator::contiguousString(left, leftStorage)
@@ -957,6 +988,75 @@ void RowContainer::hash(
   }
 }
 
+bool RowContainer::canCompactStrings() const {
+  for (const auto& accumulator : accumulators_) {
+    if (accumulator.usesExternalMemory()) {
+      return false;
+    }
+  }
+  return numRows_ > 0 && stringAllocator_->retainedSize() > 0;
+}
+
+int64_t RowContainer::compactStrings() {
+  VELOX_CHECK(canCompactStrings());
+  std::vector<column_index_t> columns;
+  for (auto i = 0; i < typeKinds_.size(); ++i) {
+    if (!types_[i]->isFixedWidth()) {
+      columns.push_back(i);
+    }
+  }
+
+  constexpr int32_t kBatch = 1000;
+  std::vector<char*> rows(kBatch);
+  std::vector<char*> allRows;
+  allRows.reserve(numRows_);
+  RowContainerIterator iter;
+  while (auto numRows = listRows(&iter, kBatch, rows.data())) {
+    for (auto i = 0; i < numRows; ++i) {
+      // 'rowPointers_' may list erased rows.
+      if (!bits::isBitSet(rows[i], freeFlagOffset_)) {
+        allRows.push_back(rows[i]);
+      }
+    }
+  }
+
+  // 'rowPointers_' lives in 'stringAllocator_'. Frees it before the move and
+  // restores it after.
+  const std::vector<char*> rowPointers(
+      rowPointers_.begin(), rowPointers_.end());
+  rowPointers_.clear();
+  rowPointers_.shrink_to_fit();
+
+  stringAllocator_->setRelocationCallback(
+      [&](const HashStringAllocator::Relocations& relocations) {
+        for (auto column : columns) {
+          const auto rowColumn = rowColumns_[column];
+          const bool isString = is_string_kind(typeKinds_[column]);
+          for (auto* row : allRows) {
+            if (isNullAt(row, rowColumn)) {
+              continue;
+            }
+            if (isString) {
+              auto& view = valueAt<StringView>(row, rowColumn.offset());
+              view = relocations.relocate(view);
+            } else {
+              auto& view = valueAt<std::string_view>(row, rowColumn.offset());
+              if (!view.empty()) {
+                view = std::string_view(
+                    relocations.relocate(view.data()), view.size());
+              }
+            }
+          }
+        }
+      });
+  SCOPE_EXIT {
+    stringAllocator_->setRelocationCallback(nullptr);
+  };
+  const auto freedBytes = stringAllocator_->compact();
+  rowPointers_.assign(rowPointers.begin(), rowPointers.end());
+  return freedBytes;
+}
+
 void RowContainer::clear() {
   if (usesExternalMemory_) {
     constexpr int32_t kBatch = 1000;
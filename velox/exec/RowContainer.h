@@ -779,6 +779,16 @@ class RowContainer {
     return nextOffset_;
   }
 
+  /// True if the row size and the next row pointer of a join build row come
+  /// before the dependent fields, so that the keys, the flags and the next
+  /// pointer fit in the first kCompactKeysBytes of a row with a wide payload.
+  bool compactKeys() const {
+    return compactKeys_;
+  }
+
+  /// The cache line size a row with compact keys gets its keys in.
+  static constexpr int32_t kCompactKeysBytes = 64;
+
   /// Creates a next-row-vector if it doesn't exist. Appends the row address to
   /// the next-row-vector, and store the address of the next-row-vector in the
   /// 'nextOffset_' slot for all duplicate rows.
@@ -805,6 +815,17 @@ class RowContainer {
         stringAllocator_->freeSpace());
   }
 
+  /// Returns true if compactStrings() can move the variable width data of
+  /// 'this'. This is false if an accumulator uses external memory since its
+  /// pointers into stringAllocator() cannot be relocated.
+  bool canCompactStrings() const;
+
+  /// Moves the variable width keys and dependent columns into densely packed
+  /// memory to undo the fragmentation left by freed rows and updates the rows
+  /// to point to the moved data. Returns the number of bytes released. See
+  /// HashStringAllocator::compact().
+  int64_t compactStrings();
+
   /// Returns the average size of rows in bytes stored in this container.
   std::optional<int64_t> estimateRowSize() const;
 
@@ -1551,6 +1572,8 @@ class RowContainer {
   // Bit position of free bit.
   int32_t freeFlagOffset_ = 0;
   int32_t rowSizeOffset_ = 0;
+  // True if the row size and the next pointer precede the dependents.
+  bool compactKeys_{false};
 
   int32_t fixedRowSize_;
   // How many bytes do the flags (null, probed, free) occupy.
@@ -20,17 +20,6 @@
 
 namespace facebook::velox::exec {
 
-namespace {
-bool hasRangeFrame(const std::shared_ptr<const core::WindowNode>& windowNode) {
-  for (const auto& function : windowNode->windowFunctions()) {
-    if (function.frame.type == core::WindowNode::WindowType::kRange) {
-      return true;
-    }
-  }
-  return false;
-}
-} // namespace
-
 RowsStreamingWindowBuild::RowsStreamingWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     velox::memory::MemoryPool* pool,
@@ -95,7 +95,7 @@ void ScaleWriterPartitioningLocalPartition::addInput(RowVectorPtr input) {
   if (numPartitions_ == 1) {
     ContinueFuture future;
     auto blockingReason =
-        queues_[0]->enqueue(input, input->retainedSize(), &future);
+        queues_[0]->enqueue(input, inputRetainedSize(input), &future);
     if (blockingReason != BlockingReason::kNotBlocked) {
       blockingReasons_.push_back(blockingReason);
       futures_.push_back(std::move(future));
@@ -129,7 +129,7 @@ void ScaleWriterPartitioningLocalPartition::addInput(RowVectorPtr input) {
       partitionFunction_->partition(*input, partitions_);
 
   const auto numInput = input->size();
-  const int64_t totalInputBytes = input->retainedSize();
+  const int64_t totalInputBytes = inputRetainedSize(input);
   // Reset the value of partition row count for the new input.
   std::fill(
       tablePartitionRowCounts_.begin(), tablePartitionRowCounts_.end(), 0);
@@ -252,7 +252,7 @@ void ScaleWriterLocalPartition::initialize() {
 void ScaleWriterLocalPartition::addInput(RowVectorPtr input) {
   prepareForInput(input);
 
-  const int64_t totalInputBytes = input->retainedSize();
+  const int64_t totalInputBytes = inputRetainedSize(input);
   processedDataBytes_ += totalInputBytes;
 
   uint32_t writerId = 0;
@@ -263,7 +263,7 @@ void ScaleWriterLocalPartition::addInput(RowVectorPtr input) {
 
   ContinueFuture future;
   auto blockingReason =
-      queues_[writerId]->enqueue(input, input->retainedSize(), &future);
+      queues_[writerId]->enqueue(input, totalInputBytes, &future);
   if (blockingReason != BlockingReason::kNotBlocked) {
     blockingReasons_.push_back(blockingReason);
     futures_.push_back(std::move(future));
@@ -248,6 +248,36 @@ class SimpleAggregateAdapter : public Aggregate {
         group, rows, std::make_index_sequence<FUNC::InputType::size_>{});
   }
 
+  // Input rows of the same group are contiguous, e.g. in streaming
+  // aggregation. Every simple function supports this: the accumulator of each
+  // group is resolved once per run of rows instead of once per row.
+  bool supportsAddRawClusteredInput() const override {
+    return true;
+  }
+
+  // Similar to addRawInput, but rows of the same group are contiguous.
+  // 'groupBoundaries' are the indices of the row after the last row of each
+  // group.
+  void addRawClusteredInput(
+      char** groups,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      const folly::Range<const vector_size_t*>& groupBoundaries) override {
+    if (inputDecoded_.size() < args.size()) {
+      inputDecoded_.resize(args.size());
+    }
+
+    for (column_index_t i = 0; i < args.size(); ++i) {
+      inputDecoded_[i].decode(*args[i], rows);
+    }
+
+    addRawClusteredInputImpl(
+        groups,
+        rows,
+        groupBoundaries,
+        std::make_index_sequence<FUNC::InputType::size_>{});
+  }
+
   bool supportsToIntermediate() const override {
     return support_to_intermediate_;
   }
@@ -429,39 +459,69 @@ class SimpleAggregateAdapter : public Aggregate {
   void addSingleGroupRawInputImpl(
       char* group,
       const SelectivityVector& rows,
-      std::index_sequence<Is...>) {
+      std::index_sequence<Is...> indices) {
+    std::tuple<VectorReader<typename FUNC::InputType::template type_at<Is>>...>
+        readers{&inputDecoded_[Is]...};
+    addGroupRawInput(group, rows, rows.begin(), rows.end(), readers, indices);
+  }
+
+  template <std::size_t... Is>
+  void addRawClusteredInputImpl(
+      char** groups,
+      const SelectivityVector& rows,
+      const folly::Range<const vector_size_t*>& groupBoundaries,
+      std::index_sequence<Is...> indices) {
     std::tuple<VectorReader<typename FUNC::InputType::template type_at<Is>>...>
         readers{&inputDecoded_[Is]...};
+    vector_size_t groupStart = 0;
+    for (auto groupEnd : groupBoundaries) {
+      const auto begin = std::max(groupStart, rows.begin());
+      const auto end = std::min(groupEnd, rows.end());
+      if (begin < end) {
+        addGroupRawInput(groups[begin], rows, begin, end, readers, indices);
+      }
+      groupStart = groupEnd;
+    }
+  }
+
+  // Adds the selected rows in [begin, end) of the input to the accumulator of
+  // 'group'. The row size is tracked and the null flag is cleared once for the
+  // whole range.
+  template <typename Readers, std::size_t... Is>
+  void addGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      vector_size_t begin,
+      vector_size_t end,
+      Readers& readers,
+      std::index_sequence<Is...>) {
     auto accumulator = value<typename FUNC::AccumulatorType>(group);
+    std::optional<RowSizeTracker<char, uint32_t>> tracker;
+    if constexpr (!accumulator_is_fixed_size_) {
+      tracker.emplace(group[rowSizeOffset_], *allocator_);
+    }
 
+    bool nonNull = false;
     if constexpr (aggregate_default_null_behavior_) {
-      rows.applyToSelected([&](auto row) {
+      bits::forEachSetBit(rows.asRange().bits(), begin, end, [&](auto row) {
         // If any input is null, we ignore the whole row.
         if (!(std::get<Is>(readers).isSet(row) && ...)) {
           return;
         }
-        std::optional<RowSizeTracker<char, uint32_t>> tracker;
-        if constexpr (!accumulator_is_fixed_size_) {
-          tracker.emplace(group[rowSizeOffset_], *allocator_);
-        }
         accumulator->addInput(allocator_, std::get<Is>(readers)[row]...);
-        clearNull(group);
+        nonNull = true;
       });
     } else {
-      rows.applyToSelected([&](auto row) {
-        std::optional<RowSizeTracker<char, uint32_t>> tracker;
-        if constexpr (!accumulator_is_fixed_size_) {
-          tracker.emplace(group[rowSizeOffset_], *allocator_);
-        }
-        bool nonNull = accumulator->addInput(
+      bits::forEachSetBit(rows.asRange().bits(), begin, end, [&](auto row) {
+        nonNull |= accumulator->addInput(
             allocator_,
             OptionalAccessor<typename FUNC::InputType::template type_at<Is>>{
                 &std::get<Is>(readers), (int64_t)row}...);
-        if (nonNull) {
-          clearNull(group);
-        }
       });
     }
+    if (nonNull) {
+      clearNull(group);
+    }
   }
 
   template <std::size_t... Is>
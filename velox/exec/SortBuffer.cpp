@@ -15,6 +15,7 @@
  */
 
 #include "SortBuffer.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Spiller.h"
 
@@ -80,6 +81,9 @@ SortBuffer::SortBuffer(
 }
 
 SortBuffer::~SortBuffer() {
+  for (auto& merge : rangeMerges_) {
+    merge->close();
+  }
   pool_->release();
 }
 
@@ -349,12 +353,66 @@ void SortBuffer::spillInput() {
     VELOX_CHECK(!noMoreInput_);
     const auto sortingKeys = SpillState::makeSortingKeys(sortCompareFlags_);
     inputSpiller_ = std::make_unique<SortInputSpiller>(
-        data_.get(), spillerStoreType_, sortingKeys, spillConfig_, spillStats_);
+        data_.get(),
+        spillerStoreType_,
+        sortingKeys,
+        spillConfig_,
+        spillStats_,
+        sampleSplitters());
   }
   inputSpiller_->spill();
   data_->clear();
 }
 
+RowVectorPtr SortBuffer::sampleSplitters() const {
+  // Number of sampled rows per key range.
+  constexpr uint32_t kNumSamplesPerRange = 64;
+  if (spillConfig_->sortMergePartitionBits == 0 ||
+      spillConfig_->executor == nullptr) {
+    return nullptr;
+  }
+  const uint32_t numRanges = 1 << spillConfig_->sortMergePartitionBits;
+  const auto numRows = data_->numRows();
+  if (numRows < numRanges * kNumSamplesPerRange) {
+    return nullptr;
+  }
+
+  std::vector<char*> rows(numRows);
+  RowContainerIterator iter;
+  data_->listRows(&iter, numRows, rows.data());
+  const auto numSamples = numRanges * kNumSamplesPerRange;
+  std::vector<char*> samples(numSamples);
+  for (uint32_t i = 0; i < numSamples; ++i) {
+    samples[i] = rows[i * numRows / numSamples];
+  }
+  std::sort(samples.begin(), samples.end(), [&](auto* left, auto* right) {
+    return data_->compareRows(left, right, sortCompareFlags_) < 0;
+  });
+
+  // Takes the quantiles of the samples as splitters, skipping duplicates to
+  // not produce empty ranges.
+  std::vector<char*> splitterRows;
+  for (uint32_t i = 1; i < numRanges; ++i) {
+    auto* splitter = samples[i * kNumSamplesPerRange];
+    if (!splitterRows.empty() &&
+        data_->compareRows(splitterRows.back(), splitter) == 0) {
+      continue;
+    }
+    splitterRows.push_back(splitter);
+  }
+
+  const auto keyType = ROW(std::vector<TypePtr>(
+      spillerStoreType_->children().begin(),
+      spillerStoreType_->children().begin() + sortCompareFlags_.size()));
+  auto splitters = BaseVector::create<RowVector>(
+      keyType, splitterRows.size(), pool_);
+  for (auto i = 0; i < sortCompareFlags_.size(); ++i) {
+    data_->extractColumn(
+        splitterRows.data(), splitterRows.size(), i, splitters->childAt(i));
+  }
+  return splitters;
+}
+
 void SortBuffer::spillOutput() {
   if (hasSpilled()) {
     // Already spilled.
@@ -421,7 +479,13 @@ void SortBuffer::getOutputWithSpill() {
   bool isEndOfBatch = false;
   while (outputRow + outputSize < output_->size()) {
     SpillMergeStream* stream = spillMerger_->next();
-    VELOX_CHECK_NOT_NULL(stream);
+    if (stream == nullptr) {
+      // The current key range is exhausted. Its last row is at the end of a
+      // batch so all its rows have been copied out.
+      VELOX_CHECK_EQ(outputSize, 0);
+      VELOX_CHECK(nextRangeMerger());
+      continue;
+    }
 
     spillSources_[outputSize] = &stream->current();
     spillSourceRows_[outputSize] = stream->currentIndex(&isEndOfBatch);
@@ -473,7 +537,8 @@ void SortBuffer::finishSpill() {
     VELOX_CHECK(!outputSpiller_->finalized());
     outputSpiller_->finishSpill(spillPartitionSet_);
   }
-  VELOX_CHECK_EQ(spillPartitionSet_.size(), 1);
+  VELOX_CHECK_GE(spillPartitionSet_.size(), 1);
+  VELOX_CHECK(inputSpiller_ != nullptr || spillPartitionSet_.size() == 1);
 }
 
 void SortBuffer::prepareOutputWithSpill() {
@@ -483,9 +548,54 @@ void SortBuffer::prepareOutputWithSpill() {
     return;
   }
 
-  VELOX_CHECK_EQ(spillPartitionSet_.size(), 1);
-  spillMerger_ = spillPartitionSet_.begin()->second->createOrderedReader(
-      *spillConfig_, pool(), spillStats_);
+  // The partitions are ordered by partition number, which is the order of
+  // their key ranges. The first range is merged while producing the output and
+  // the others are merged ahead in the background.
+  VELOX_CHECK_GE(spillPartitionSet_.size(), 1);
+  std::vector<std::unique_ptr<SpillPartition>> partitions;
+  partitions.reserve(spillPartitionSet_.size());
+  for (auto& [_, partition] : spillPartitionSet_) {
+    partitions.push_back(std::move(partition));
+  }
   spillPartitionSet_.clear();
+  spillMerger_ =
+      partitions[0]->createOrderedReader(*spillConfig_, pool(), spillStats_);
+  partitions.erase(partitions.begin());
+  startRangeMerges(std::move(partitions));
+}
+
+void SortBuffer::startRangeMerges(
+    std::vector<std::unique_ptr<SpillPartition>> partitions) {
+  if (partitions.empty()) {
+    return;
+  }
+  VELOX_CHECK_NOT_NULL(spillConfig_->executor);
+  for (auto& partition : partitions) {
+    rangeMerges_.push_back(
+        memory::createAsyncMemoryReclaimTask<SpillPartition>(
+            [partition = std::shared_ptr<SpillPartition>(std::move(partition)),
+             this]() {
+              partition->mergeFiles(
+                  *spillConfig_, 1, memory::spillMemoryPool(), spillStats_);
+              return std::make_unique<SpillPartition>(std::move(*partition));
+            }));
+    spillConfig_->executor->add(
+        [merge = rangeMerges_.back()]() { merge->prepare(); });
+  }
+}
+
+bool SortBuffer::nextRangeMerger() {
+  spillMerger_.reset();
+  if (rangeMerges_.empty()) {
+    return false;
+  }
+  // Merges the partition on this thread if the executor has not started it.
+  auto partition = rangeMerges_.front()->move();
+  rangeMerges_.pop_front();
+  VELOX_CHECK_NOT_NULL(partition);
+  spillMerger_ =
+      partition->createOrderedReader(*spillConfig_, pool(), spillStats_);
+  VELOX_CHECK_NOT_NULL(spillMerger_);
+  return true;
 }
 } // namespace facebook::velox::exec
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
@@ -97,6 +100,20 @@ class SortBuffer {
   // Spill during input stage.
   void spillInput();
 
+  // Returns the splitter keys of the key range partitions to spill the input
+  // to, sampled from the rows in 'data_'. Returns nullptr if the spilled rows
+  // are not range partitioned.
+  RowVectorPtr sampleSplitters() const;
+
+  // Starts merging the files of each of 'partitions' into a single file on
+  // the spill executor.
+  void startRangeMerges(
+      std::vector<std::unique_ptr<SpillPartition>> partitions);
+
+  // Sets 'spillMerger_' to read the next key range partition. Returns false if
+  // all the key ranges have been read.
+  bool nextRangeMerger();
+
   // Spill during output stage.
   void spillOutput();
 
@@ -156,6 +173,11 @@ class SortBuffer {
   // Used to merge the sorted runs from in-memory rows and spilled rows on disk.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerger_;
 
+  // The pending merges of the key range partitions after the one read by
+  // 'spillMerger_', in key order. Each produces one partition with a single
+  // sorted file. Only set if the input is spilled to key range partitions.
+  std::deque<std::shared_ptr<AsyncSource<SpillPartition>>> rangeMerges_;
+
   // Records the source rows to copy to 'output_' in order.
   std::vector<const RowVector*> spillSources_;
 
@@ -47,9 +47,12 @@ SortWindowBuild::SortWindowBuild(
     const common::SpillConfig* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection,
     folly::Synchronized<OperatorStats>* opStats,
-    folly::Synchronized<common::SpillStats>* spillStats)
+    folly::Synchronized<common::SpillStats>* spillStats,
+    bool spillStreaming)
     : WindowBuild(node, pool, spillConfig, nonReclaimableSection),
       numPartitionKeys_{node->partitionKeys().size()},
+      spillStreaming_{spillStreaming},
+      hasRangeFrame_{hasRangeFrame(node)},
       compareFlags_{makeCompareFlags(numPartitionKeys_, node->sortingOrders())},
       pool_(pool),
       prefixSortConfig_(prefixSortConfig),
@@ -333,25 +336,8 @@ void SortWindowBuild::loadNextPartitionBatchFromSpill() {
       break;
     }
 
-    bool newPartition = false;
-    if (!sortedRows_.empty()) {
-      CompareFlags compareFlags =
-          CompareFlags::equality(CompareFlags::NullHandlingMode::kNullAsValue);
-
-      for (auto i = 0; i < numPartitionKeys_; ++i) {
-        if (data_->compare(
-                sortedRows_.back(),
-                data_->columnAt(i),
-                next->decoded(i),
-                next->currentIndex(),
-                compareFlags)) {
-          newPartition = true;
-          break;
-        }
-      }
-    }
-
-    if (newPartition) {
+    if (!sortedRows_.empty() &&
+        keysDiffer(sortedRows_.back(), *next, 0, numPartitionKeys_)) {
       partitionStartRows_.push_back(sortedRows_.size());
       if (sortedRows_.size() >= minReadBatchRows) {
         break;
@@ -377,7 +363,98 @@ void SortWindowBuild::loadNextPartitionBatchFromSpill() {
   }
 }
 
+bool SortWindowBuild::keysDiffer(
+    const char* row,
+    SpillMergeStream& stream,
+    column_index_t begin,
+    column_index_t end) {
+  const auto compareFlags =
+      CompareFlags::equality(CompareFlags::NullHandlingMode::kNullAsValue);
+  for (auto i = begin; i < end; ++i) {
+    if (data_->compare(
+            row,
+            data_->columnAt(i),
+            stream.decoded(i),
+            stream.currentIndex(),
+            compareFlags)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SortWindowBuild::hasNextStreamingPartition() {
+  if (streamingPartition_ != nullptr &&
+      (!streamingPartition_->complete() ||
+       streamingPartition_->numRows() > 0)) {
+    return true;
+  }
+  streamingPartition_ = nullptr;
+  if (merge_->next() == nullptr) {
+    auto lockedOpStats = opStats_->wlock();
+    lockedOpStats->runtimeStats[Window::kWindowSpillReadNumBatches] =
+        RuntimeMetric(numSpillReadBatches_);
+    return false;
+  }
+  streamingPartition_ = std::make_shared<WindowPartition>(
+      data_.get(), inversedInputChannels_, sortKeyInfo_);
+  loadStreamingPartitionRows();
+  return true;
+}
+
+void SortWindowBuild::loadStreamingPartitionRows() {
+  const column_index_t numKeys = numPartitionKeys_ + sortKeyInfo_.size();
+  std::vector<char*> rows;
+  bool complete = false;
+  for (;;) {
+    auto* next = merge_->next();
+    if (next == nullptr) {
+      complete = true;
+      break;
+    }
+    if (lastStreamedRow_ != nullptr) {
+      if (keysDiffer(lastStreamedRow_, *next, 0, numPartitionKeys_)) {
+        complete = true;
+        break;
+      }
+      // Range frames need the whole peer group of a row.
+      if (rows.size() >= numRowsPerOutput_ &&
+          (!hasRangeFrame_ ||
+           keysDiffer(lastStreamedRow_, *next, numPartitionKeys_, numKeys))) {
+        break;
+      }
+    }
+
+    auto* newRow = data_->newRow();
+    for (auto i = 0; i < inputChannels_.size(); ++i) {
+      data_->store(next->decoded(i), next->currentIndex(), newRow, i);
+    }
+    rows.push_back(newRow);
+    lastStreamedRow_ = newRow;
+    next->pop();
+  }
+
+  ++numSpillReadBatches_;
+  streamingPartition_->addRows(rows);
+  if (complete) {
+    streamingPartition_->setComplete();
+    lastStreamedRow_ = nullptr;
+  }
+}
+
+void SortWindowBuild::loadPartialPartitionRows() {
+  if (streamsSpill() && streamingPartition_ != nullptr &&
+      !streamingPartition_->complete() && streamingPartition_->numRows() == 0) {
+    loadStreamingPartitionRows();
+  }
+}
+
 std::shared_ptr<WindowPartition> SortWindowBuild::nextPartition() {
+  if (streamsSpill()) {
+    VELOX_CHECK_NOT_NULL(
+        streamingPartition_, "No window partitions available");
+    return streamingPartition_;
+  }
   VELOX_CHECK(!partitionStartRows_.empty(), "No window partitions available");
 
   currentPartition_++;
@@ -397,6 +474,9 @@ std::shared_ptr<WindowPartition> SortWindowBuild::nextPartition() {
 }
 
 bool SortWindowBuild::hasNextPartition() {
+  if (streamsSpill()) {
+    return hasNextStreamingPartition();
+  }
   if (merge_ != nullptr) {
     loadNextPartitionBatchFromSpill();
   }
@@ -404,4 +484,14 @@ bool SortWindowBuild::hasNextPartition() {
   return partitionStartRows_.size() > 0 &&
       currentPartition_ < static_cast<int>(partitionStartRows_.size() - 2);
 }
+
+bool SortWindowBuild::hasNextBufferedPartition() {
+  // A batch of partitions read from spill stays in 'data_' until the next
+  // batch is loaded, which only hasNextPartition() does.
+  if (streamsSpill()) {
+    return false;
+  }
+  return partitionStartRows_.size() > 0 &&
+      currentPartition_ < static_cast<int>(partitionStartRows_.size() - 2);
+}
 } // namespace facebook::velox::exec
@@ -24,6 +24,12 @@ namespace facebook::velox::exec {
 // Sorts input data of the Window by {partition keys, sort keys}
 // to identify window partitions. This sort fully orders
 // rows as needed for window function computation.
+//
+// If 'spillStreaming' is set and the data was spilled, the sort-merged
+// spilled rows are returned in partial partitions of up to the output batch
+// size, like RowsStreamingWindowBuild does for sorted input, so that a large
+// partition is never read into memory as a whole. This requires all window
+// functions to process partitions a batch of rows at a time.
 class SortWindowBuild : public WindowBuild {
  public:
   SortWindowBuild(
@@ -33,7 +39,8 @@ class SortWindowBuild : public WindowBuild {
       const common::SpillConfig* spillConfig,
       tsan_atomic<bool>* nonReclaimableSection,
       folly::Synchronized<OperatorStats>* opStats,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      bool spillStreaming = false);
 
   ~SortWindowBuild() override {
     pool_->release();
@@ -58,8 +65,12 @@ class SortWindowBuild : public WindowBuild {
 
   bool hasNextPartition() override;
 
+  bool hasNextBufferedPartition() override;
+
   std::shared_ptr<WindowPartition> nextPartition() override;
 
+  void loadPartialPartitionRows() override;
+
   void ensureInputFits(const RowVectorPtr& input);
 
  private:
@@ -85,8 +96,35 @@ class SortWindowBuild : public WindowBuild {
   // from spilled data into 'data_' and set pointers in 'sortedRows_'.
   void loadNextPartitionBatchFromSpill();
 
+  // Returns true if the partitions are streamed from the spilled data.
+  bool streamsSpill() const {
+    return spillStreaming_ && merge_ != nullptr;
+  }
+
+  // Starts the next streamed partition if the current one is consumed.
+  // Returns false if all spilled data is consumed.
+  bool hasNextStreamingPartition();
+
+  // Adds the next up to 'numRowsPerOutput_' rows of the streamed partition
+  // from the spilled data. Completes the partition if its last row is added.
+  void loadStreamingPartitionRows();
+
+  // Returns true if 'row' of 'data_' and the current row of 'stream' differ
+  // in any column in [begin, end).
+  bool keysDiffer(
+      const char* row,
+      SpillMergeStream& stream,
+      column_index_t begin,
+      column_index_t end);
+
   const size_t numPartitionKeys_;
 
+  const bool spillStreaming_;
+
+  // True if a window function has a range frame. The rows of a peer group are
+  // then streamed together.
+  const bool hasRangeFrame_;
+
   // Compare flags for partition and sorting keys. Compare flags for partition
   // keys are set to default values. Compare flags for sorting keys match
   // sorting order specified in the plan node.
@@ -131,7 +169,15 @@ class SortWindowBuild : public WindowBuild {
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
-  // Number of batches of whole partitions read from spilled data.
+  // Number of batches of whole partitions read from spilled data, or of the
+  // batches of streamed partitions.
   uint64_t numSpillReadBatches_ = 0;
+
+  // The partial partition being streamed from the spilled data.
+  std::shared_ptr<WindowPartition> streamingPartition_;
+
+  // The last row added to 'streamingPartition_'. Null at the start of a
+  // partition.
+  char* lastStreamedRow_{nullptr};
 };
 } // namespace facebook::velox::exec
@@ -292,7 +292,7 @@ bool SortedAggregations::compareRowsWithKeys(
 }
 
 void SortedAggregations::sortSingleGroup(
-    std::vector<char*>& groupRows,
+    folly::Range<char**> groupRows,
     const SortingSpec& sortingSpec) {
   std::sort(
       groupRows.begin(),
@@ -302,39 +302,35 @@ void SortedAggregations::sortSingleGroup(
       });
 }
 
-vector_size_t SortedAggregations::extractSingleGroup(
-    std::vector<char*>& groupRows,
+void SortedAggregations::extractInputs(
+    const std::vector<char*>& groupRows,
     const AggregateInfo& aggregate,
-    std::vector<VectorPtr>& inputVectors) {
-  const auto numGroupRows = groupRows.size();
+    std::vector<VectorPtr>& inputVectors,
+    SelectivityVector& rows) {
+  const auto numRows = groupRows.size();
+  rows.resizeFill(numRows, true);
 
-  std::vector<vector_size_t> rowNumbers;
   if (aggregate.mask) {
     FlatVectorPtr<bool> mask = BaseVector::create<FlatVector<bool>>(
-        BOOLEAN(), numGroupRows, inputData_->pool());
+        BOOLEAN(), numRows, inputData_->pool());
     inputData_->extractColumn(
-        groupRows.data(),
-        numGroupRows,
-        inputMapping_[aggregate.mask.value()],
-        mask);
-
-    rowNumbers.reserve(numGroupRows);
-    for (auto i = 0; i < numGroupRows; ++i) {
-      if (!mask->isNullAt(i) && mask->valueAt(i)) {
-        rowNumbers.push_back(i);
+        groupRows.data(), numRows, inputMapping_[aggregate.mask.value()], mask);
+
+    for (auto i = 0; i < numRows; ++i) {
+      if (mask->isNullAt(i) || !mask->valueAt(i)) {
+        rows.setValid(i, false);
       }
     }
+    rows.updateBounds();
 
-    if (rowNumbers.empty()) {
-      return 0;
+    if (!rows.hasSelections()) {
+      return;
     }
   }
 
   const auto numInputs = aggregate.inputs.size();
   VELOX_CHECK_EQ(numInputs, inputVectors.size());
 
-  const auto numRows = aggregate.mask ? rowNumbers.size() : numGroupRows;
-
   for (auto i = 0; i < numInputs; ++i) {
     if (aggregate.inputs[i] == kConstantChannel) {
       inputVectors[i] = aggregate.constantInputs[i];
@@ -347,21 +343,10 @@ vector_size_t SortedAggregations::extractSingleGroup(
         BaseVector::prepareForReuse(inputVectors[i], numRows);
       }
 
-      if (aggregate.mask) {
-        inputData_->extractColumn(
-            groupRows.data(),
-            folly::Range(rowNumbers.data(), rowNumbers.size()),
-            columnIndex,
-            0, // resultOffset
-            inputVectors[i]);
-      } else {
-        inputData_->extractColumn(
-            groupRows.data(), numRows, columnIndex, inputVectors[i]);
-      }
+      inputData_->extractColumn(
+          groupRows.data(), numRows, columnIndex, inputVectors[i]);
     }
   }
-
-  return numRows;
 }
 
 void SortedAggregations::extractValues(
@@ -369,7 +354,9 @@ void SortedAggregations::extractValues(
     const RowVectorPtr& result) {
   raw_vector<int32_t> indices(pool_);
   SelectivityVector rows;
+  // Sorted input rows of a batch of groups and the group of each row.
   std::vector<char*> groupRows;
+  std::vector<char*> rowGroups;
   for (const auto& [sortingSpec, aggregates] : aggregates_) {
     std::vector<VectorPtr> inputVectors;
     size_t numInputColumns = 0;
@@ -378,17 +365,34 @@ void SortedAggregations::extractValues(
     }
     inputVectors.resize(numInputColumns);
 
-    // For each group, sort inputs, add them to aggregate.
-    for (auto* group : groups) {
-      auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
-      if (accumulator->size == 0) {
-        continue;
-      }
+    // Sort the inputs of each group and collect the sorted runs of many groups
+    // into one batch. Each aggregate then receives the whole batch in one
+    // addRawInput call instead of one call per group. Rows of a group are
+    // contiguous and in sort order within the batch.
+    size_t nextGroup = 0;
+    while (nextGroup < groups.size()) {
+      groupRows.clear();
+      rowGroups.clear();
+      for (; nextGroup < groups.size() && groupRows.size() < kMaxBatchRows;
+           ++nextGroup) {
+        auto* group = groups[nextGroup];
+        auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
+        if (accumulator->size == 0) {
+          continue;
+        }
 
-      groupRows.resize(accumulator->size);
-      accumulator->read(folly::Range(groupRows.data(), groupRows.size()));
+        const auto numRows = groupRows.size();
+        groupRows.resize(numRows + accumulator->size);
+        auto groupRange =
+            folly::Range(groupRows.data() + numRows, accumulator->size);
+        accumulator->read(groupRange);
+        sortSingleGroup(groupRange, sortingSpec);
+        rowGroups.resize(groupRows.size(), group);
+      }
 
-      sortSingleGroup(groupRows, sortingSpec);
+      if (groupRows.empty()) {
+        continue;
+      }
 
       size_t firstInputColumn = 0;
       for (const auto& aggregate : aggregates) {
@@ -399,20 +403,12 @@ void SortedAggregations::extractValues(
               std::move(inputVectors[firstInputColumn + i]));
         }
 
-        // TODO Process group rows in batches to avoid creating very large input
-        // vectors.
-        const auto numRows =
-            extractSingleGroup(groupRows, *aggregate, aggregateInputs);
-        if (numRows == 0) {
-          firstInputColumn += aggregateInputs.size();
-          // Mask must be false for all 'groupRows'.
-          continue;
+        extractInputs(groupRows, *aggregate, aggregateInputs, rows);
+        if (rows.hasSelections()) {
+          aggregate->function->addRawInput(
+              rowGroups.data(), rows, aggregateInputs, false);
         }
 
-        rows.resize(numRows);
-        aggregate->function->addSingleGroupRawInput(
-            group, rows, aggregateInputs, false);
-
         for (auto i = 0; i < aggregate->inputs.size(); ++i) {
           inputVectors[firstInputColumn + i] = std::move(aggregateInputs[i]);
         }
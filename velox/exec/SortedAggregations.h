@@ -103,13 +103,16 @@ class SortedAggregations {
       const SortingSpec& sortingSpec);
 
   void sortSingleGroup(
-      std::vector<char*>& groupRows,
+      folly::Range<char**> groupRows,
       const SortingSpec& sortingSpec);
 
-  vector_size_t extractSingleGroup(
-      std::vector<char*>& groupRows,
+  // Extracts the inputs of 'aggregate' for 'groupRows' into 'inputVectors' and
+  // sets 'rows' to the rows that pass the mask of the aggregate.
+  void extractInputs(
+      const std::vector<char*>& groupRows,
       const AggregateInfo& aggregate,
-      std::vector<VectorPtr>& inputVectors);
+      std::vector<VectorPtr>& inputVectors,
+      SelectivityVector& rows);
 
   void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
 
@@ -142,6 +145,11 @@ class SortedAggregations {
     }
   };
 
+  // Soft limit on the number of sorted input rows passed to the aggregates in
+  // one call. The rows of several groups are combined until the limit is
+  // reached. A single group is never split.
+  static constexpr size_t kMaxBatchRows = 10'000;
+
   memory::MemoryPool* const pool_;
 
   // Aggregates grouped by sorting keys and orders.
@@ -17,6 +17,10 @@
 #include <algorithm>
 #include <vector>
 
+#include <folly/Executor.h>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/HilbertIndex.h"
 #include "velox/exec/SpatialIndex.h"
@@ -44,45 +48,185 @@ std::vector<size_t> RTreeLevel::query(
   return result;
 }
 
-namespace {
-std::pair<RTreeLevel, std::vector<Envelope>> buildLevel(
-    uint32_t branchSize,
-    const std::vector<Envelope>& envelopes) {
-  std::vector<float> minXs;
-  minXs.reserve(envelopes.size());
-  std::vector<float> minYs;
-  minYs.reserve(envelopes.size());
-  std::vector<float> maxXs;
-  maxXs.reserve(envelopes.size());
-  std::vector<float> maxYs;
-  maxYs.reserve(envelopes.size());
-
-  std::vector<Envelope> parentEnvelopes;
-  parentEnvelopes.reserve((envelopes.size() + branchSize - 1) / branchSize);
-  Envelope currentBounds = Envelope::empty();
-
-  uint32_t idx = 0;
-  for (const auto& env : envelopes) {
-    ++idx;
-    currentBounds.maxX = std::max(currentBounds.maxX, env.maxX);
-    currentBounds.maxY = std::max(currentBounds.maxY, env.maxY);
-    currentBounds.minX = std::min(currentBounds.minX, env.minX);
-    currentBounds.minY = std::min(currentBounds.minY, env.minY);
-    if (idx % branchSize == 0) {
-      parentEnvelopes.push_back(currentBounds);
-      currentBounds = Envelope::empty();
+std::vector<std::pair<size_t, vector_size_t>> RTreeLevel::query(
+    const std::vector<Envelope>& queryEnvs,
+    const std::vector<std::pair<size_t, vector_size_t>>& candidates) const {
+  std::vector<std::pair<size_t, vector_size_t>> result;
+
+  size_t begin = 0;
+  while (begin < candidates.size()) {
+    const size_t branchIdx = candidates[begin].first;
+    size_t end = begin + 1;
+    while (end < candidates.size() && candidates[end].first == branchIdx) {
+      ++end;
     }
+    size_t startIdx = branchIdx * branchSize_;
+    size_t endIdx = std::min(startIdx + branchSize_, minXs_.size());
+    for (size_t idx = startIdx; idx < endIdx; ++idx) {
+      for (size_t i = begin; i < end; ++i) {
+        const auto& queryEnv = queryEnvs[candidates[i].second];
+        bool intersects = (queryEnv.maxX >= minXs_[idx]) &&
+            (queryEnv.maxY >= minYs_[idx]) && (queryEnv.minX <= maxXs_[idx]) &&
+            (queryEnv.minY <= maxYs_[idx]);
+        if (intersects) {
+          result.emplace_back(idx, candidates[i].second);
+        }
+      }
+    }
+    begin = end;
+  }
+
+  return result;
+}
 
-    minXs.push_back(env.minX);
-    minYs.push_back(env.minY);
-    maxXs.push_back(env.maxX);
-    maxYs.push_back(env.maxY);
+namespace {
+// Minimum number of envelopes for each step of a parallel build.
+constexpr size_t kMinEnvelopesPerBuildStep = 64 << 10;
+
+// Maximum number of parallel steps in each phase of a build.
+constexpr size_t kMaxBuildSteps = 32;
+
+size_t numBuildSteps(size_t numEnvelopes, folly::Executor* executor) {
+  if (executor == nullptr) {
+    return 1;
+  }
+  return std::clamp<size_t>(
+      numEnvelopes / kMinEnvelopesPerBuildStep, 1, kMaxBuildSteps);
+}
+
+// Runs 'work' for each step number in [0, numSteps). If 'executor' is set, all
+// but the last step are run on 'executor' and the last on the calling thread.
+// Returns after all steps are done.
+template <typename Work>
+void runBuildSteps(folly::Executor* executor, size_t numSteps, Work&& work) {
+  if (executor == nullptr || numSteps <= 1) {
+    for (size_t step = 0; step < numSteps; ++step) {
+      work(step);
+    }
+    return;
+  }
+  std::vector<std::shared_ptr<AsyncSource<bool>>> steps;
+  steps.reserve(numSteps - 1);
+  for (size_t step = 0; step + 1 < numSteps; ++step) {
+    auto source = std::make_shared<AsyncSource<bool>>([&work, step] {
+      work(step);
+      return std::make_unique<bool>(true);
+    });
+    steps.push_back(source);
+    executor->add([source]() { source->prepare(); });
   }
+  std::exception_ptr error;
+  try {
+    work(numSteps - 1);
+  } catch (const std::exception&) {
+    error = std::current_exception();
+  }
+  // All steps must be waited for since they refer to the caller's state.
+  for (auto& source : steps) {
+    try {
+      source->move();
+    } catch (const std::exception&) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Returns 'envelopes' sorted by the Hilbert index of their lower left corner.
+// The Hilbert index of each envelope is computed once. Ranges of the sort keys
+// are sorted in parallel and then merged pairwise.
+std::vector<Envelope> sortByHilbertIndex(
+    const Envelope& bounds,
+    const std::vector<Envelope>& envelopes,
+    folly::Executor* executor) {
+  HilbertIndex hilbert(bounds.minX, bounds.minY, bounds.maxX, bounds.maxY);
+  const size_t numEnvelopes = envelopes.size();
+  const size_t numSteps = numBuildSteps(numEnvelopes, executor);
+  const size_t stepSize = bits::divRoundUp(numEnvelopes, numSteps);
 
-  if (!currentBounds.isEmpty()) {
-    parentEnvelopes.push_back(currentBounds);
+  // The high 32 bits of a key are the Hilbert index and the low 32 bits are
+  // the position in 'envelopes'.
+  std::vector<uint64_t> keys(numEnvelopes);
+  runBuildSteps(executor, numSteps, [&](size_t step) {
+    const size_t begin = step * stepSize;
+    const size_t end = std::min(begin + stepSize, numEnvelopes);
+    for (size_t i = begin; i < end; ++i) {
+      keys[i] = (static_cast<uint64_t>(hilbert.indexOf(
+                     envelopes[i].minX, envelopes[i].minY))
+                 << 32) |
+          i;
+    }
+    std::sort(keys.begin() + begin, keys.begin() + end);
+  });
+
+  for (size_t width = stepSize; width < numEnvelopes; width *= 2) {
+    runBuildSteps(
+        executor,
+        bits::divRoundUp(numEnvelopes, 2 * width),
+        [&, width](size_t step) {
+          const size_t begin = step * 2 * width;
+          const size_t middle = std::min(begin + width, numEnvelopes);
+          const size_t end = std::min(begin + 2 * width, numEnvelopes);
+          std::inplace_merge(
+              keys.begin() + begin,
+              keys.begin() + middle,
+              keys.begin() + end);
+        });
   }
 
+  std::vector<Envelope> sorted(numEnvelopes);
+  runBuildSteps(executor, numSteps, [&](size_t step) {
+    const size_t begin = step * stepSize;
+    const size_t end = std::min(begin + stepSize, numEnvelopes);
+    for (size_t i = begin; i < end; ++i) {
+      sorted[i] = envelopes[keys[i] & std::numeric_limits<uint32_t>::max()];
+    }
+  });
+  return sorted;
+}
+
+std::pair<RTreeLevel, std::vector<Envelope>> buildLevel(
+    uint32_t branchSize,
+    const std::vector<Envelope>& envelopes,
+    folly::Executor* executor) {
+  const size_t numEnvelopes = envelopes.size();
+  std::vector<float> minXs(numEnvelopes);
+  std::vector<float> minYs(numEnvelopes);
+  std::vector<float> maxXs(numEnvelopes);
+  std::vector<float> maxYs(numEnvelopes);
+
+  const size_t numBranches = bits::divRoundUp(numEnvelopes, branchSize);
+  std::vector<Envelope> parentEnvelopes(numBranches);
+
+  // Each step fills whole branches, so that steps write disjoint ranges.
+  const size_t numSteps =
+      std::min(numBuildSteps(numEnvelopes, executor), numBranches);
+  const size_t branchesPerStep =
+      numSteps == 0 ? 0 : bits::divRoundUp(numBranches, numSteps);
+  runBuildSteps(executor, numSteps, [&](size_t step) {
+    const size_t beginBranch = step * branchesPerStep;
+    const size_t endBranch =
+        std::min(beginBranch + branchesPerStep, numBranches);
+    for (size_t branch = beginBranch; branch < endBranch; ++branch) {
+      Envelope currentBounds = Envelope::empty();
+      const size_t begin = branch * branchSize;
+      const size_t end = std::min<size_t>(begin + branchSize, numEnvelopes);
+      for (size_t idx = begin; idx < end; ++idx) {
+        const auto& env = envelopes[idx];
+        currentBounds.merge(env);
+        minXs[idx] = env.minX;
+        minYs[idx] = env.minY;
+        maxXs[idx] = env.maxX;
+        maxYs[idx] = env.maxY;
+      }
+      parentEnvelopes[branch] = currentBounds;
+    }
+  });
+
   return {
       RTreeLevel(
           branchSize,
@@ -97,19 +241,13 @@ std::pair<RTreeLevel, std::vector<Envelope>> buildLevel(
 SpatialIndex::SpatialIndex(
     Envelope bounds,
     std::vector<Envelope> envelopes,
-    uint32_t branchSize)
+    uint32_t branchSize,
+    folly::Executor* executor)
     : branchSize_(branchSize), bounds_(std::move(bounds)) {
   VELOX_CHECK_GT(branchSize_, 1);
 
   if (!bounds_.isEmpty()) {
-    HilbertIndex hilbert(
-        bounds_.minX, bounds_.minY, bounds_.maxX, bounds_.maxY);
-
-    std::sort(
-        envelopes.begin(), envelopes.end(), [&](const auto& a, const auto& b) {
-          return hilbert.indexOf(a.minX, a.minY) <
-              hilbert.indexOf(b.minX, b.minY);
-        });
+    envelopes = sortByHilbertIndex(bounds_, envelopes, executor);
   }
 
   rowIndices_.reserve(envelopes.size());
@@ -128,13 +266,14 @@ SpatialIndex::SpatialIndex(
   }
 
   while (envelopes.size() > branchSize_) {
-    auto [level, parentEnvelopes] = buildLevel(branchSize_, envelopes);
+    auto [level, parentEnvelopes] =
+        buildLevel(branchSize_, envelopes, executor);
     levels_.push_back(std::move(level));
     envelopes = std::move(parentEnvelopes);
   }
 
   if (envelopes.size() > 1 || levels_.empty()) {
-    levels_.push_back(buildLevel(branchSize_, envelopes).first);
+    levels_.push_back(buildLevel(branchSize_, envelopes, executor).first);
   }
 
   VELOX_CHECK_GT(branchSize_ + 1, levels_.back().size());
@@ -172,6 +311,40 @@ std::vector<vector_size_t> SpatialIndex::query(const Envelope& queryEnv) const {
   return result;
 }
 
+std::vector<std::vector<vector_size_t>> SpatialIndex::query(
+    const std::vector<Envelope>& queryEnvs) const {
+  std::vector<std::vector<vector_size_t>> result(queryEnvs.size());
+
+  // Pairs of a branch index in the current level and an index into
+  // 'queryEnvs'. The top level has only one branch.
+  std::vector<std::pair<size_t, vector_size_t>> candidates;
+  candidates.reserve(queryEnvs.size());
+  for (vector_size_t i = 0; i < queryEnvs.size(); ++i) {
+    if (Envelope::intersects(queryEnvs[i], bounds_)) {
+      candidates.emplace_back(0, i);
+    }
+  }
+  if (candidates.empty()) {
+    return result;
+  }
+
+  VELOX_CHECK_GT(levels_.back().size(), 0);
+  VELOX_CHECK_GT(branchSize_ + 1, levels_.back().size());
+  // The internal indices matched in a level are the branch indices of the
+  // level below.
+  for (size_t thisLevel = levels_.size(); thisLevel > 0 && !candidates.empty();
+       --thisLevel) {
+    candidates = levels_[thisLevel - 1].query(queryEnvs, candidates);
+  }
+
+  // The internal indices of level 0 index into rowIndices.
+  for (const auto& [idx, queryIdx] : candidates) {
+    result[queryIdx].push_back(rowIndices_[idx]);
+  }
+
+  return result;
+}
+
 Envelope SpatialIndex::bounds() const {
   return bounds_;
 }
@@ -19,9 +19,14 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <utility>
 #include <vector>
 #include "velox/vector/TypeAliases.h"
 
+namespace folly {
+class Executor;
+} // namespace folly
+
 namespace facebook::velox::exec {
 
 /// A minimal envelope for a geometry.
@@ -170,6 +175,15 @@ class RTreeLevel {
       const Envelope& queryEnv,
       const std::vector<size_t>& branchIndices) const;
 
+  /// Batched form of the above over 'queryEnvs'. 'candidates' are pairs of a
+  /// branch index and an index into 'queryEnvs', sorted by branch index.
+  /// Returns pairs of an internal index and an index into 'queryEnvs' for
+  /// each intersecting envelope, sorted by internal index. Each envelope of a
+  /// branch is loaded once and checked against all queries of the branch.
+  std::vector<std::pair<size_t, vector_size_t>> query(
+      const std::vector<Envelope>& queryEnvs,
+      const std::vector<std::pair<size_t, vector_size_t>>& candidates) const;
+
   size_t size() const {
     return minXs_.size();
   }
@@ -206,16 +220,26 @@ class SpatialIndex {
   /// Constructs a spatial index from envelopes contained with `bounds`.
   /// `bounds` must contain all envelopes in `envelopes`, otherwise the
   /// an assertio will fail.  Envelopes should not contain NaN coordinates.
+  /// If 'executor' is set, large inputs are sorted along the Hilbert curve
+  /// and packed into the leaf level in parallel steps on 'executor'. The
+  /// resulting index is the same as with a serial build.
   explicit SpatialIndex(
       Envelope bounds,
       std::vector<Envelope> envelopes,
-      uint32_t branchSize = kDefaultRTreeBranchSize);
+      uint32_t branchSize = kDefaultRTreeBranchSize,
+      folly::Executor* executor = nullptr);
 
   /// Returns the row indices of all envelopes that probeEnv intersects.
   /// Order of the returned indices is an implementation detail and cannot be
   /// relied upon.
   std::vector<vector_size_t> query(const Envelope& queryEnv) const;
 
+  /// Returns the result of query() for each of 'queryEnvs'. The tree is
+  /// walked one level at a time for all of 'queryEnvs' together, so that a
+  /// node reached by several queries is scanned once for all of them.
+  std::vector<std::vector<vector_size_t>> query(
+      const std::vector<Envelope>& queryEnvs) const;
+
   /// Returns the envelope of the all envelopes in the index.
   /// The returned envelope will have index = -1.
   Envelope bounds() const;
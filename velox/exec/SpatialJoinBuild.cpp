@@ -206,7 +206,12 @@ SpatialIndex SpatialJoinBuild::buildSpatialIndex(
     }
     offset += vector->size();
   }
-  return SpatialIndex(std::move(bounds), std::move(envelopes));
+  // Large indexes are sorted and packed in parallel on the query executor.
+  return SpatialIndex(
+      std::move(bounds),
+      std::move(envelopes),
+      SpatialIndex::kDefaultRTreeBranchSize,
+      operatorCtx_->task()->queryCtx()->executor());
 }
 
 void SpatialJoinBuild::noMoreInput() {
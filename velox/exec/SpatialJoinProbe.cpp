@@ -453,19 +453,37 @@ std::vector<int32_t> SpatialJoinProbe::querySpatialIndex() {
   VELOX_CHECK(spatialIndex_.has_value());
   VELOX_CHECK_NOT_NULL(spatialIndex_.value());
 
-  if (decodedGeometryCol_.isNullAt(probeRow_)) {
-    return std::vector<int32_t>{};
+  if (probeRow_ < probeBatchStart_ ||
+      probeRow_ >= probeBatchStart_ +
+              static_cast<vector_size_t>(probeBatchCandidates_.size())) {
+    queryProbeBatch();
   }
-
-  // Always apply radius to build side, not probe side.
-  Envelope envelope = SpatialJoinBuild::readEnvelope(
-      decodedGeometryCol_.valueAt<StringView>(probeRow_), 0 /* radius */);
-  std::vector<int32_t> candidates = spatialIndex_.value()->query(envelope);
+  std::vector<int32_t> candidates =
+      std::move(probeBatchCandidates_[probeRow_ - probeBatchStart_]);
   std::sort(candidates.begin(), candidates.end());
 
   return candidates;
 }
 
+void SpatialJoinProbe::queryProbeBatch() {
+  const vector_size_t end =
+      std::min<vector_size_t>(input_->size(), probeRow_ + kProbeBatchSize);
+  std::vector<Envelope> envelopes;
+  envelopes.reserve(end - probeRow_);
+  for (vector_size_t row = probeRow_; row < end; ++row) {
+    if (decodedGeometryCol_.isNullAt(row)) {
+      // An empty envelope intersects nothing.
+      envelopes.push_back(Envelope::empty());
+      continue;
+    }
+    // Always apply radius to build side, not probe side.
+    envelopes.push_back(SpatialJoinBuild::readEnvelope(
+        decodedGeometryCol_.valueAt<StringView>(row), 0 /* radius */));
+  }
+  probeBatchStart_ = probeRow_;
+  probeBatchCandidates_ = spatialIndex_.value()->query(envelopes);
+}
+
 BufferPtr SpatialJoinProbe::makeBuildVectorIndices(vector_size_t vectorSize) {
   // Find the slice of candidates that are in this build vector.
   vector_size_t endIndex = candidateIndex_;
@@ -551,6 +569,8 @@ void SpatialJoinProbe::finishProbeInput() {
   VELOX_CHECK_NOT_NULL(input_);
   input_.reset();
   probeRow_ = 0;
+  probeBatchCandidates_.clear();
+  probeBatchStart_ = 0;
 
   if (noMoreInput_) {
     setState(ProbeOperatorState::kFinish);
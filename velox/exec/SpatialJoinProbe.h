@@ -220,6 +220,10 @@ class SpatialJoinProbe : public Operator {
   // row. This should be done each time the probe is advanced.
   std::vector<int32_t> querySpatialIndex();
 
+  // Queries spatialIndex_ for up to kProbeBatchSize probe rows starting at
+  // probeRow_ and stores the candidates in probeBatchCandidates_.
+  void queryProbeBatch();
+
   // Evaluates the spatial joinCondition for a given build vector. This method
   // sets `filterOutput_` and `decodedFilterResult_`, which will be ready to
   // be used by `isSpatialJoinConditionMatch()` below.
@@ -380,6 +384,14 @@ class SpatialJoinProbe : public Operator {
   // the first vector, and 101 is the 2nd entry of the second vector.
   std::vector<vector_size_t> candidateBuildRows_{};
 
+  // Number of probe rows for which spatialIndex_ is queried together.
+  static constexpr vector_size_t kProbeBatchSize = 256;
+
+  // Candidate build rows of the probe rows starting at probeBatchStart_ in
+  // input_. Filled by queryProbeBatch() and consumed by querySpatialIndex().
+  std::vector<std::vector<vector_size_t>> probeBatchCandidates_{};
+  vector_size_t probeBatchStart_{0};
+
   // Index of candidate currently being processed from
   // `buildVectors_[buildIndex_]`.
   vector_size_t candidateIndex_{0};
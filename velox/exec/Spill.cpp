@@ -18,6 +18,7 @@
 #include "velox/common/Casts.h"
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/process/PerfettoTrace.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
@@ -139,8 +140,12 @@ SpillState::SpillState(
     const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    common::SpillFileFormat fileFormat,
+    folly::Executor* writeExecutor,
+    const common::GetSpillDirectoryPathCB& getSpillOverflowDirPathCb)
     : getSpillDirPathCb_(getSpillDirPathCb),
+      getSpillOverflowDirPathCb_(getSpillOverflowDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
       sortingKeys_(sortingKeys),
@@ -149,6 +154,8 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       prefixSortConfig_(prefixSortConfig),
       fileCreateConfig_(fileCreateConfig),
+      fileFormat_(fileFormat),
+      writeExecutor_(writeExecutor),
       pool_(pool),
       stats_(stats) {}
 
@@ -218,20 +225,32 @@ uint64_t SpillState::appendToPartition(
   partitionWriters_.withWLock([&](auto& lockedWriters) {
     // Ensure that partition exist before writing.
     if (!lockedWriters.contains(id)) {
+      const auto fileName =
+          fmt::format("{}-spill-{}", fileNamePrefix_, id.encodedId());
+      std::function<std::string()> overflowPathPrefixCb;
+      if (getSpillOverflowDirPathCb_ != nullptr) {
+        overflowPathPrefixCb = [getDirCb = getSpillOverflowDirPathCb_,
+                                fileName]() {
+          return fmt::format("{}/{}", getDirCb(), fileName);
+        };
+      }
       lockedWriters.emplace(
           id,
           std::make_unique<SpillWriter>(
               std::static_pointer_cast<const RowType>(rows->type()),
               sortingKeys_,
               compressionKind_,
-              fmt::format(
-                  "{}/{}-spill-{}", spillDir, fileNamePrefix_, id.encodedId()),
+              fmt::format("{}/{}", spillDir, fileName),
               targetFileSize_,
               writeBufferSize_,
               fileCreateConfig_,
               updateAndCheckSpillLimitCb_,
               pool_,
-              stats_));
+              stats_,
+              fileFormat_,
+              writeExecutor_,
+              std::string(spillDir),
+              std::move(overflowPathPrefixCb)));
     }
   });
 
@@ -466,7 +485,8 @@ SpillFileInfo mergeSpillFiles(
       fileCreateConfig,
       updateAndCheckSpillLimitCb,
       pool,
-      spillStats);
+      spillStats,
+      files[0].fileFormat);
 
   while (mergeTree->next()) {
     VectorPtr tmpRowVector = std::move(mergeParams.rowVector);
@@ -505,10 +525,25 @@ SpillPartition::createOrderedReader(
     folly::Synchronized<common::SpillStats>* spillStats) {
   const auto numMaxMergeFiles = spillConfig.numMaxMergeFiles;
   VELOX_CHECK_NE(numMaxMergeFiles, 1);
-  if (numMaxMergeFiles == 0 || files_.size() <= numMaxMergeFiles) {
-    return createOrderedReaderInternal(
-        spillConfig.readBufferSize, pool, spillStats);
+  if (numMaxMergeFiles != 0) {
+    mergeFiles(spillConfig, numMaxMergeFiles, pool, spillStats);
   }
+  return createOrderedReaderInternal(
+      spillConfig.readBufferSize, pool, spillStats);
+}
+
+void SpillPartition::mergeFiles(
+    const common::SpillConfig& spillConfig,
+    uint32_t maxNumFiles,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  VELOX_CHECK_GT(maxNumFiles, 0);
+  if (files_.size() <= maxNumFiles) {
+    return;
+  }
+  const uint64_t numMaxMergeFiles = spillConfig.numMaxMergeFiles == 0
+      ? files_.size()
+      : spillConfig.numMaxMergeFiles;
 
   SpillFileHeap orderedFiles(files_.begin(), files_.end());
   SpillFiles files;
@@ -517,10 +552,10 @@ SpillPartition::createOrderedReader(
   SpillFileMergeParams mergeParams(files_[0].type, pool);
 
   // Recursively merge the files.
-  for (uint32_t round = 0; orderedFiles.size() > numMaxMergeFiles; ++round) {
+  for (uint32_t round = 0; orderedFiles.size() > maxNumFiles; ++round) {
     const uint64_t numMergeFiles = std::min(
-        static_cast<uint64_t>(numMaxMergeFiles),
-        static_cast<uint64_t>(orderedFiles.size() + 1 - numMaxMergeFiles));
+        numMaxMergeFiles,
+        static_cast<uint64_t>(orderedFiles.size() + 1 - maxNumFiles));
     // Choose the top 'numMergeFiles' smallest files for merging to minimize IO.
     for (uint32_t i = 0; i < numMergeFiles; i++) {
       files.push_back(orderedFiles.top());
@@ -541,12 +576,12 @@ SpillPartition::createOrderedReader(
   }
 
   files_.clear();
+  size_ = 0;
   while (!orderedFiles.empty()) {
+    size_ += orderedFiles.top().size;
     files_.push_back(orderedFiles.top());
     orderedFiles.pop();
   }
-  return createOrderedReaderInternal(
-      spillConfig.readBufferSize, pool, spillStats);
 }
 
 IterableSpillPartitionSet::IterableSpillPartitionSet() {
@@ -612,6 +647,7 @@ uint32_t FileSpillMergeStream::id() const {
 
 void FileSpillMergeStream::nextBatch() {
   VELOX_CHECK(!closed_);
+  VELOX_TRACE_SCOPED("velox.spill", "spillRead", "fileId", spillFile_->id());
   index_ = 0;
   if (!spillFile_->nextBatch(rowVector_)) {
     size_ = 0;
@@ -516,6 +516,16 @@ class SpillPartition {
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* spillStats);
 
+  /// Merges the sorted files of this partition until there are no more than
+  /// 'maxNumFiles' files left. Each merge reads at most
+  /// spillConfig.numMaxMergeFiles files at a time, or all of them if it is 0.
+  /// The smallest files are merged first to minimize IO.
+  void mergeFiles(
+      const common::SpillConfig& spillConfig,
+      uint32_t maxNumFiles,
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
   std::string toString() const;
 
  private:
@@ -586,7 +596,9 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. 'fileFormat' is the serialization format of the spill files.
+  /// If 'writeExecutor' is set, the spill file writes run on it in the
+  /// background, overlapped with the serialization of the next batch.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -598,7 +610,11 @@ class SpillState {
       const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto,
+      folly::Executor* writeExecutor = nullptr,
+      const common::GetSpillDirectoryPathCB& getSpillOverflowDirPathCb =
+          nullptr);
 
   static std::vector<SpillSortKey> makeSortingKeys(
       const std::vector<CompareFlags>& compareFlags = {});
@@ -623,6 +639,10 @@ class SpillState {
     return compressionKind_;
   }
 
+  common::SpillFileFormat fileFormat() const {
+    return fileFormat_;
+  }
+
   const std::optional<common::PrefixSortConfig>& prefixSortConfig() const {
     return prefixSortConfig_;
   }
@@ -689,6 +709,10 @@ class SpillState {
   // Implementations can use it to ensure the path exists before returning.
   common::GetSpillDirectoryPathCB getSpillDirPathCb_;
 
+  // Returns the directory for the spill files that overflow the local spill
+  // quota. Not set if there is no overflow directory.
+  common::GetSpillDirectoryPathCB getSpillOverflowDirPathCb_;
+
   // Updates the aggregated spill bytes of this query, and throws if exceeds
   // the max spill bytes limit.
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
@@ -701,6 +725,8 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   const std::optional<common::PrefixSortConfig> prefixSortConfig_;
   const std::string fileCreateConfig_;
+  const common::SpillFileFormat fileFormat_;
+  folly::Executor* const writeExecutor_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
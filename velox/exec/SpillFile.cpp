@@ -16,6 +16,8 @@
 
 #include "velox/exec/SpillFile.h"
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/process/PerfettoTrace.h"
+#include "velox/serializers/ColumnarSerializer.h"
 #include "velox/serializers/SerializedPageFile.h"
 
 namespace facebook::velox::exec {
@@ -26,8 +28,55 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// Returns the serde options for the spill files of 'fileFormat'.
+std::unique_ptr<VectorSerde::Options> makeSerdeOptions(
+    common::SpillFileFormat fileFormat,
+    common::CompressionKind compressionKind) {
+  if (fileFormat == common::SpillFileFormat::kColumnar) {
+    return std::make_unique<
+        serializer::ColumnarVectorSerde::ColumnarOptions>(compressionKind);
+  }
+  return std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>(
+      kDefaultUseLosslessTimestamp,
+      compressionKind,
+      0.8,
+      /*_nullsFirst=*/true);
+}
+
+VectorSerde* spillSerde(common::SpillFileFormat fileFormat) {
+  if (fileFormat == common::SpillFileFormat::kColumnar) {
+    // The columnar serde is only used for spilling, so it does not need to be
+    // registered.
+    static serializer::ColumnarVectorSerde columnarSerde;
+    return &columnarSerde;
+  }
+  return getNamedVectorSerde(VectorSerde::Kind::kPresto);
+}
 } // namespace
 
+// static
+LocalSpillQuota& LocalSpillQuota::instance() {
+  static LocalSpillQuota quota;
+  return quota;
+}
+
+void LocalSpillQuota::add(const std::string& directory, uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  directoryBytes_[directory] += bytes;
+  usedBytes_ += bytes;
+}
+
+void LocalSpillQuota::removeDirectory(const std::string& directory) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = directoryBytes_.find(directory);
+  if (it == directoryBytes_.end()) {
+    return;
+  }
+  usedBytes_ -= it->second;
+  directoryBytes_.erase(it);
+}
+
 SpillWriter::SpillWriter(
     const RowTypePtr& type,
     const std::vector<SpillSortKey>& sortingKeys,
@@ -38,24 +87,33 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    common::SpillFileFormat fileFormat,
+    folly::Executor* writeExecutor,
+    const std::string& localDirectory,
+    std::function<std::string()> overflowPathPrefixCb)
     : serializer::SerializedPageFileWriter(
           pathPrefix,
           targetFileSize,
           writeBufferSize,
           fileCreateConfig,
-          std::make_unique<
-              serializer::presto::PrestoVectorSerde::PrestoOptions>(
-              kDefaultUseLosslessTimestamp,
-              compressionKind,
-              0.8,
-              /*_nullsFirst=*/true),
-          getNamedVectorSerde(VectorSerde::Kind::kPresto),
-          pool),
+          makeSerdeOptions(fileFormat, compressionKind),
+          spillSerde(fileFormat),
+          pool,
+          writeExecutor),
       type_(type),
       sortingKeys_(sortingKeys),
+      fileFormat_(fileFormat),
       stats_(stats),
-      updateAndCheckLimitCb_(updateAndCheckSpillLimitCb) {}
+      updateAndCheckLimitCb_(updateAndCheckSpillLimitCb),
+      localDirectory_(localDirectory),
+      overflowPathPrefixCb_(std::move(overflowPathPrefixCb)) {}
+
+std::string SpillWriter::nextFilePathPrefix() {
+  fileOverflows_ = overflowPathPrefixCb_ != nullptr &&
+      LocalSpillQuota::instance().exceeded();
+  return fileOverflows_ ? overflowPathPrefixCb_() : pathPrefix_;
+}
 
 void SpillWriter::updateAppendStats(
     uint64_t numRows,
@@ -77,6 +135,8 @@ void SpillWriter::updateWriteStats(
   ++statsLocked->spillWrites;
   common::updateGlobalSpillWriteStats(
       spilledBytes, flushTimeNs, fileWriteTimeNs);
+  VELOX_TRACE_COMPLETE(
+      "velox.spill", "spillWrite", fileWriteTimeNs, "bytes", spilledBytes);
   updateAndCheckLimitCb_(spilledBytes);
 }
 
@@ -86,6 +146,13 @@ void SpillWriter::updateFileStats(
   addThreadLocalRuntimeStat(
       "spillFileSize", RuntimeCounter(file.size, RuntimeCounter::Unit::kBytes));
   common::incrementGlobalSpilledFiles();
+  if (fileOverflows_) {
+    addThreadLocalRuntimeStat(
+        "spillOverflowFileSize",
+        RuntimeCounter(file.size, RuntimeCounter::Unit::kBytes));
+  } else if (!localDirectory_.empty()) {
+    LocalSpillQuota::instance().add(localDirectory_, file.size);
+  }
 }
 
 SpillFiles SpillWriter::finish() {
@@ -101,7 +168,8 @@ SpillFiles SpillWriter::finish() {
             .path = fileInfo.path,
             .size = fileInfo.size,
             .sortingKeys = sortingKeys_,
-            .compressionKind = serdeOptions_->compressionKind});
+            .compressionKind = serdeOptions_->compressionKind,
+            .fileFormat = fileFormat_});
   }
   return spillFiles;
 }
@@ -147,6 +215,7 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.type,
       fileInfo.sortingKeys,
       fileInfo.compressionKind,
+      fileInfo.fileFormat,
       pool,
       stats));
 }
@@ -159,20 +228,17 @@ SpillReadFile::SpillReadFile(
     const RowTypePtr& type,
     const std::vector<SpillSortKey>& sortingKeys,
     common::CompressionKind compressionKind,
+    common::SpillFileFormat fileFormat,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats)
     : serializer::SerializedPageFileReader(
           path,
           bufferSize,
           type,
-          getNamedVectorSerde(VectorSerde::Kind::kPresto),
-          std::make_unique<
-              serializer::presto::PrestoVectorSerde::PrestoOptions>(
-              kDefaultUseLosslessTimestamp,
-              compressionKind,
-              0.8,
-              /*_nullsFirst=*/true),
-          pool),
+          spillSerde(fileFormat),
+          makeSerdeOptions(fileFormat, compressionKind),
+          pool,
+          io::IoPurpose::kSpill),
       id_(id),
       path_(path),
       size_(size),
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include <folly/container/F14Set.h>
+#include <mutex>
 #include <optional>
 
 #include "velox/common/base/SpillConfig.h"
@@ -43,10 +45,55 @@ struct SpillFileInfo {
   uint64_t size;
   std::vector<SpillSortKey> sortingKeys;
   common::CompressionKind compressionKind;
+  common::SpillFileFormat fileFormat{common::SpillFileFormat::kPresto};
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
 
+/// Node-wide quota on the bytes of the spill files in the local spill
+/// directories. Once the quota is used up, the spill writers that have an
+/// overflow directory write their next files there, so that a query that
+/// spills more than the local disks hold completes instead of failing. The
+/// bytes of the files of a spill directory are released when the task removes
+/// the directory. The quota is checked before opening a file, so each writer
+/// may exceed it by up to one file.
+class LocalSpillQuota {
+ public:
+  static LocalSpillQuota& instance();
+
+  /// Sets the quota in bytes. 0 means no quota.
+  void setMaxBytes(uint64_t maxBytes) {
+    maxBytes_ = maxBytes;
+  }
+
+  uint64_t maxBytes() const {
+    return maxBytes_;
+  }
+
+  /// Returns true if the spill files in the local spill directories use up
+  /// the quota.
+  bool exceeded() const {
+    const auto maxBytes = maxBytes_.load();
+    return maxBytes != 0 && usedBytes_ >= maxBytes;
+  }
+
+  /// Adds 'bytes' of spill files written to 'directory'.
+  void add(const std::string& directory, uint64_t bytes);
+
+  /// Releases the bytes of the spill files in 'directory'.
+  void removeDirectory(const std::string& directory);
+
+  uint64_t usedBytes() const {
+    return usedBytes_;
+  }
+
+ private:
+  std::atomic<uint64_t> maxBytes_{0};
+  std::atomic<uint64_t> usedBytes_{0};
+  std::mutex mutex_;
+  folly::F14FastMap<std::string, uint64_t> directoryBytes_;
+};
+
 /// Used to write the spilled data to a sequence of files for one partition. If
 /// data is sorted, each file is sorted. The globally sorted order is produced
 /// by merging the constituent files.
@@ -59,7 +106,12 @@ class SpillWriter : public serializer::SerializedPageFileWriter {
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. 'fileFormat' is the serialization format of the
+  /// files. If 'writeExecutor' is set, the file writes run on it in the
+  /// background while the next batch is serialized. If 'localDirectory' is
+  /// set, the files in it count towards the LocalSpillQuota. Once the quota is
+  /// used up, new files are written with the path prefix returned by
+  /// 'overflowPathPrefixCb' if set.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -73,7 +125,11 @@ class SpillWriter : public serializer::SerializedPageFileWriter {
       const std::string& fileCreateConfig,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto,
+      folly::Executor* writeExecutor = nullptr,
+      const std::string& localDirectory = {},
+      std::function<std::string()> overflowPathPrefixCb = nullptr);
 
   /// Finishes this file writer and returns the written spill files info.
   ///
@@ -99,15 +155,27 @@ class SpillWriter : public serializer::SerializedPageFileWriter {
       uint64_t flushTimeUs,
       uint64_t writeTimeUs) override;
 
+  // Returns the overflow path prefix if the local spill quota is used up.
+  std::string nextFilePathPrefix() override;
+
   const RowTypePtr type_;
 
   const std::vector<SpillSortKey> sortingKeys_;
 
+  const common::SpillFileFormat fileFormat_;
+
   folly::Synchronized<common::SpillStats>* const stats_;
 
   // Updates the aggregated bytes of this query, and throws if exceeds
   // the max bytes limit.
   const common::UpdateAndCheckSpillLimitCB updateAndCheckLimitCb_;
+
+  const std::string localDirectory_;
+
+  const std::function<std::string()> overflowPathPrefixCb_;
+
+  // True if the current file is in the overflow directory.
+  bool fileOverflows_{false};
 };
 
 /// Represents a spill file for read which turns the serialized spilled data
@@ -151,6 +219,7 @@ class SpillReadFile : public serializer::SerializedPageFileReader {
       const RowTypePtr& type,
       const std::vector<SpillSortKey>& sortingKeys,
       common::CompressionKind compressionKind,
+      common::SpillFileFormat fileFormat,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats);
 
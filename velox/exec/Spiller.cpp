@@ -64,7 +64,10 @@ SpillerBase::SpillerBase(
           spillConfig->prefixSortConfig,
           memory::spillMemoryPool(),
           spillStats,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          spillConfig->fileFormat,
+          spillConfig->asyncWriteEnabled ? spillConfig->executor : nullptr,
+          spillConfig->getSpillOverflowDirPathCb) {
   TestValue::adjust("facebook::velox::exec::SpillerBase", this);
 }
 
@@ -95,7 +98,7 @@ bool SpillerBase::fillSpillRuns(RowContainerIterator* iterator) {
 
     // Number of rows to hash and divide into spill partitions at a time.
     constexpr int32_t kHashBatchSize = 4096;
-    std::vector<uint64_t> hashes(kHashBatchSize);
+    std::vector<uint32_t> partitions(kHashBatchSize);
     std::vector<char*> rows(kHashBatchSize);
     const bool isSinglePartition = bits_.numPartitions() == 1;
 
@@ -113,18 +116,12 @@ bool SpillerBase::fillSpillRuns(RowContainerIterator* iterator) {
       auto rowSet = folly::Range<char**>(rows.data(), numRows);
 
       if (!isSinglePartition) {
-        for (auto i = 0; i < container_->keyTypes().size(); ++i) {
-          container_->hash(i, rowSet, i > 0, hashes.data());
-        }
+        partitionRows(rowSet, partitions);
       }
 
       // Put each in its run.
       for (auto i = 0; i < numRows; ++i) {
-        // TODO: consider to cache the hash bits in row container so we only
-        // need to calculate them once.
-        const auto partitionNum =
-            isSinglePartition ? 0 : bits_.partition(hashes[i]);
-        VELOX_DCHECK_GE(partitionNum, 0);
+        const auto partitionNum = isSinglePartition ? 0 : partitions[i];
         // TODO: Fully integrate nested spill id into spiller partitioning,
         // replacing integer based partitioning.
         auto& spillRun = createOrGetSpillRun(SpillPartitionId(partitionNum));
@@ -143,6 +140,20 @@ bool SpillerBase::fillSpillRuns(RowContainerIterator* iterator) {
   return lastRun;
 }
 
+void SpillerBase::partitionRows(
+    folly::Range<char**> rows,
+    std::vector<uint32_t>& partitions) {
+  // TODO: consider to cache the hash bits in row container so we only need to
+  // calculate them once.
+  std::vector<uint64_t> hashes(rows.size());
+  for (auto i = 0; i < container_->keyTypes().size(); ++i) {
+    container_->hash(i, rows, i > 0, hashes.data());
+  }
+  for (auto i = 0; i < rows.size(); ++i) {
+    partitions[i] = bits_.partition(hashes[i]);
+  }
+}
+
 void SpillerBase::runSpill(bool lastRun) {
   ++spillStats_->wlock()->spillRuns;
 
@@ -429,10 +440,89 @@ void NoRowContainerSpiller::spill(
   state_.appendToPartition(partitionId, spillVector);
 }
 
+namespace {
+// Returns the hash bits to address the key range partitions of 'splitters'.
+HashBitRange splitterBits(const RowVectorPtr& splitters) {
+  if (splitters == nullptr) {
+    return HashBitRange{};
+  }
+  const auto numPartitions = splitters->size() + 1;
+  uint8_t numBits = 0;
+  while ((1 << numBits) < numPartitions) {
+    ++numBits;
+  }
+  return HashBitRange(0, numBits);
+}
+} // namespace
+
+SortInputSpiller::SortInputSpiller(
+    RowContainer* container,
+    RowTypePtr rowType,
+    const std::vector<SpillSortKey>& sortingKeys,
+    const common::SpillConfig* spillConfig,
+    folly::Synchronized<common::SpillStats>* spillStats,
+    RowVectorPtr splitters)
+    : SpillerBase(
+          container,
+          std::move(rowType),
+          splitterBits(splitters),
+          sortingKeys,
+          std::numeric_limits<uint64_t>::max(),
+          spillConfig->maxSpillRunRows,
+          std::nullopt,
+          spillConfig,
+          spillStats),
+      splitters_(std::move(splitters)) {
+  if (splitters_ == nullptr) {
+    return;
+  }
+  VELOX_CHECK_GT(splitters_->size(), 0);
+  VELOX_CHECK_EQ(splitters_->childrenSize(), container_->keyTypes().size());
+  VELOX_CHECK_LE(
+      bits_.numPartitions(), 1 << SpillPartitionId::kMaxPartitionBits);
+  decodedSplitters_.reserve(splitters_->childrenSize());
+  for (const auto& child : splitters_->children()) {
+    decodedSplitters_.emplace_back(*child);
+  }
+}
+
 void SortInputSpiller::spill() {
   SpillerBase::spill(nullptr);
 }
 
+void SortInputSpiller::partitionRows(
+    folly::Range<char**> rows,
+    std::vector<uint32_t>& partitions) {
+  VELOX_CHECK_NOT_NULL(splitters_);
+  for (auto i = 0; i < rows.size(); ++i) {
+    partitions[i] = numSplittersNotAfter(rows[i]);
+  }
+}
+
+uint32_t SortInputSpiller::numSplittersNotAfter(const char* row) const {
+  // Binary search for the first splitter that sorts after 'row'.
+  uint32_t low = 0;
+  uint32_t high = splitters_->size();
+  while (low < high) {
+    const auto mid = (low + high) / 2;
+    int32_t result = 0;
+    for (auto key = 0; key < decodedSplitters_.size() && result == 0; ++key) {
+      result = container_->compare(
+          row,
+          container_->columnAt(key),
+          decodedSplitters_[key],
+          mid,
+          compareFlags_[key]);
+    }
+    if (result < 0) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return low;
+}
+
 SortOutputSpiller::SortOutputSpiller(
     RowContainer* container,
     RowTypePtr rowType,
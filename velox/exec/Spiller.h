@@ -78,6 +78,13 @@ class SpillerBase {
 
   virtual std::string type() const = 0;
 
+  // Sets the spill partition number of each of 'rows' in 'partitions'. Only
+  // called if there is more than one spill partition. The rows are
+  // partitioned by the hash of their keys by default.
+  virtual void partitionRows(
+      folly::Range<char**> rows,
+      std::vector<uint32_t>& partitions);
+
   // Marks all the seen partitions in 'spillRuns_' have been spilled in spill
   // state.
   void markSeenPartitionsSpilled();
@@ -260,22 +267,19 @@ class SortInputSpiller : public SpillerBase {
  public:
   static constexpr std::string_view kType = "SortInputSpiller";
 
+  /// If 'splitters' is set, the spilled rows are split into key ranges and
+  /// each range is spilled to its own partition. 'splitters' has the sorting
+  /// keys of 'container' as columns and its rows are in ascending order. A row
+  /// goes to partition i if it sorts before splitter i and not before splitter
+  /// i - 1. The last partition has the rows that do not sort before the last
+  /// splitter. All rows of a partition sort before the rows of the next one.
   SortInputSpiller(
       RowContainer* container,
       RowTypePtr rowType,
       const std::vector<SpillSortKey>& sortingKeys,
       const common::SpillConfig* spillConfig,
-      folly::Synchronized<common::SpillStats>* spillStats)
-      : SpillerBase(
-            container,
-            std::move(rowType),
-            HashBitRange{},
-            sortingKeys,
-            std::numeric_limits<uint64_t>::max(),
-            spillConfig->maxSpillRunRows,
-            std::nullopt,
-            spillConfig,
-            spillStats) {}
+      folly::Synchronized<common::SpillStats>* spillStats,
+      RowVectorPtr splitters = nullptr);
 
   void spill();
 
@@ -287,6 +291,18 @@ class SortInputSpiller : public SpillerBase {
   bool needSort() const override {
     return true;
   }
+
+  void partitionRows(
+      folly::Range<char**> rows,
+      std::vector<uint32_t>& partitions) override;
+
+  // Returns the number of splitters that do not sort after 'row'.
+  uint32_t numSplittersNotAfter(const char* row) const;
+
+  const RowVectorPtr splitters_;
+
+  // Decoded columns of 'splitters_'.
+  std::vector<DecodedVector> decodedSplitters_;
 };
 
 class SortOutputSpiller : public SpillerBase {
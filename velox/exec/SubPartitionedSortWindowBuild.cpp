@@ -189,4 +189,13 @@ bool SubPartitionedSortWindowBuild::hasNextPartition() {
   }
   return false;
 }
+
+bool SubPartitionedSortWindowBuild::hasNextBufferedPartition() {
+  // Switching to the next sub partition releases the rows of the current one.
+  if (currentSubPartition_ < 0 || currentSubPartition_ >= numSubPartitions_) {
+    return false;
+  }
+  VELOX_CHECK_NOT_NULL(subWindowBuilds_[currentSubPartition_]);
+  return subWindowBuilds_[currentSubPartition_]->hasNextBufferedPartition();
+}
 } // namespace facebook::velox::exec
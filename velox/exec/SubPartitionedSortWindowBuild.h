@@ -59,6 +59,8 @@ class SubPartitionedSortWindowBuild : public WindowBuild {
 
   bool hasNextPartition() override;
 
+  bool hasNextBufferedPartition() override;
+
   std::shared_ptr<WindowPartition> nextPartition() override;
 
   std::optional<int64_t> estimateRowSize() override;
@@ -82,6 +82,10 @@ TableScan::TableScan(
       driverCtx_(driverCtx),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      maxSplitPrewarmPerDriver_(
+          driverCtx_->queryConfig().maxSplitPrewarmPerDriver()),
+      splitDivisionBytes_(
+          driverCtx_->queryConfig().tableScanSplitDivisionBytes()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       connectorPool_(driverCtx_->task->addConnectorPoolLocked(
           planNodeId(),
@@ -250,6 +254,11 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (numPrewarmedSplits_ > 0) {
+        lockedStats->addRuntimeStat(
+            "prewarmedSplits", RuntimeCounter(numPrewarmedSplits_));
+        numPrewarmedSplits_ = 0;
+      }
       currNumRawInputRows = lockedStats->rawInputPositions;
     }
     VELOX_CHECK_LE(rawInputRowsSinceLastSplit_, currNumRawInputRows);
@@ -282,7 +291,9 @@ bool TableScan::getSplit() {
       split,
       blockingFuture_,
       maxPreloadedSplits_,
-      splitPreloader_);
+      splitPreloader_,
+      maxPrewarmedSplits_,
+      splitPrewarmer_);
   if (blockingReason_ != BlockingReason::kNotBlocked) {
     return false;
   }
@@ -317,6 +328,10 @@ bool TableScan::getSplit() {
       "connectorSplitSize", RuntimeCounter(split.connectorSplit->size()));
   const auto& connectorSplit = split.connectorSplit;
   currentSplitWeight_ = connectorSplit->splitWeight;
+  // The task accounts the weight of the taken split, also if it is divided.
+  if (splitDivisionBytes_ > 0) {
+    maybeDivideSplit(split);
+  }
   needNewSplit_ = false;
 
   // A point for test code injection.
@@ -384,10 +399,38 @@ bool TableScan::getSplit() {
         "dataSourceAddSplitWallNanos",
         RuntimeCounter(addSplitTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
   }
+  if (maxSplitPreloadPerDriver_ > 0) {
+    splitPreloadPerDriver_ =
+        dataSource_->splitPreloadPerDriver(maxSplitPreloadPerDriver_);
+  }
   ++stats_.wlock()->numSplits;
   return true;
 }
 
+void TableScan::maybeDivideSplit(exec::Split& split) {
+  // A preloaded split already has a data source for its whole range.
+  if (split.connectorSplit->dataSource != nullptr ||
+      driverCtx_->task->numDrivers(driverCtx_->driver) <= 1) {
+    return;
+  }
+  auto parts = split.connectorSplit->divide(splitDivisionBytes_);
+  if (parts.size() <= 1) {
+    return;
+  }
+  std::vector<exec::Split> otherParts;
+  otherParts.reserve(parts.size() - 1);
+  for (size_t i = 1; i < parts.size(); ++i) {
+    otherParts.emplace_back(std::move(parts[i]), split.groupId);
+  }
+  if (!driverCtx_->task->addDividedSplits(
+          driverCtx_->splitGroupId, planNodeId(), std::move(otherParts))) {
+    return;
+  }
+  split.connectorSplit = std::move(parts[0]);
+  stats_.wlock()->addRuntimeStat(
+      "numDividedSplitParts", RuntimeCounter(parts.size()));
+}
+
 bool TableScan::shouldWaitForScaleUp() {
   if (scaledController_ == nullptr) {
     return false;
@@ -459,23 +502,48 @@ void TableScan::preload(
 
 void TableScan::checkPreload() {
   auto* ioExecutor = connector_->ioExecutor();
-  if (maxSplitPreloadPerDriver_ == 0 || !ioExecutor ||
-      !connector_->supportsSplitPreload()) {
+  if (!ioExecutor) {
     return;
   }
-  maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
-      maxSplitPreloadPerDriver_;
-  if (!splitPreloader_) {
-    splitPreloader_ =
-        [ioExecutor,
-         this](const std::shared_ptr<connector::ConnectorSplit>& split) {
-          preload(split);
-
-          ioExecutor->add([connectorSplit = split]() mutable {
-            connectorSplit->dataSource->prepare();
-            connectorSplit.reset();
-          });
-        };
+  const auto numDrivers = driverCtx_->task->numDrivers(driverCtx_->driver);
+  if (maxSplitPreloadPerDriver_ > 0 && connector_->supportsSplitPreload()) {
+    maxPreloadedSplits_ = numDrivers *
+        splitPreloadPerDriver_.value_or(maxSplitPreloadPerDriver_);
+    if (!splitPreloader_) {
+      splitPreloader_ =
+          [ioExecutor,
+           this](const std::shared_ptr<connector::ConnectorSplit>& split) {
+            preload(split);
+
+            ioExecutor->add([connectorSplit = split]() mutable {
+              connectorSplit->dataSource->prepare();
+              connectorSplit.reset();
+            });
+          };
+    }
+  }
+  if (maxSplitPrewarmPerDriver_ > 0 && connector_->supportsSplitPrewarm()) {
+    maxPrewarmedSplits_ = numDrivers * maxSplitPrewarmPerDriver_;
+    if (!splitPrewarmer_) {
+      splitPrewarmer_ =
+          [ioExecutor,
+           this](const std::shared_ptr<connector::ConnectorSplit>& split) {
+            if (!prewarmConnectorQueryCtx_) {
+              prewarmConnectorQueryCtx_ =
+                  operatorCtx_->createConnectorQueryCtx(
+                      split->connectorId, planNodeId(), connectorPool_);
+            }
+            ++numPrewarmedSplits_;
+            ioExecutor->add([connector = connector_,
+                             ctx = prewarmConnectorQueryCtx_,
+                             task = operatorCtx_->task(),
+                             split]() {
+              if (!task->isCancelled()) {
+                connector->prewarmSplit(split, ctx.get());
+              }
+            });
+          };
+    }
   }
 }
 
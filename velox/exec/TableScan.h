@@ -85,9 +85,15 @@ class TableScan : public SourceOperator {
   // Returns true if a new split is fetched from the task otherwise false.
   bool getSplit();
 
+  // Divides 'split' into parts of about 'splitDivisionBytes_' if it is large
+  // enough, keeps the first part in 'split' and queues the others on the task
+  // for the other drivers of the pipeline.
+  void maybeDivideSplit(exec::Split& split);
+
   // Sets 'maxPreloadSplits' and 'splitPreloader' if prefetching splits is
   // appropriate. The preloader will be applied to the 'first 'maxPreloadSplits'
-  // of the Task's split queue for 'this' when getting splits.
+  // of the Task's split queue for 'this' when getting splits. Likewise sets
+  // 'maxPrewarmedSplits_' and 'splitPrewarmer_' for the splits after these.
   void checkPreload();
 
   // Sets 'split->dataSource' to be an AsyncSource that makes a DataSource to
@@ -112,6 +118,8 @@ class TableScan : public SourceOperator {
   const connector::ColumnHandleMap columnHandles_;
   DriverCtx* const driverCtx_;
   const int32_t maxSplitPreloadPerDriver_{0};
+  const int32_t maxSplitPrewarmPerDriver_{0};
+  const uint64_t splitDivisionBytes_{0};
   const vector_size_t maxReadBatchSize_;
   memory::MemoryPool* const connectorPool_;
   const std::shared_ptr<connector::Connector> connector_;
@@ -135,6 +143,10 @@ class TableScan : public SourceOperator {
 
   int32_t maxPreloadedSplits_{0};
 
+  // Number of splits to preload per driver as adapted by 'dataSource_' to the
+  // last split. Unset before the first split.
+  std::optional<int32_t> splitPreloadPerDriver_;
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -148,6 +160,20 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  int32_t maxPrewarmedSplits_{0};
+
+  // Callback passed to getSplitOrFuture() for triggering async prewarm of the
+  // splits past the preloaded ones. Like for 'splitPreloader_', the prewarms
+  // capture a shared_ptr to the Task.
+  std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>
+      splitPrewarmer_{nullptr};
+
+  // Connector query context shared by the prewarms of 'this'.
+  std::shared_ptr<connector::ConnectorQueryCtx> prewarmConnectorQueryCtx_;
+
+  // Count of splits that started background prewarm.
+  int32_t numPrewarmedSplits_{0};
+
   double maxFilteringRatio_{0};
 
   // Row size estimate from the file reader. It is set to the last known
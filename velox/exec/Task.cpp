@@ -26,6 +26,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/FairShareExecutor.h"
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/LocalPlanner.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -35,6 +36,7 @@
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/SpatialJoinBuild.h"
+#include "velox/exec/SpillFile.h"
 #include "velox/exec/TableScan.h"
 #include "velox/exec/Task.h"
 
@@ -200,9 +202,12 @@ class QueueSplitsStore : public SplitsStore {
       Split& split,
       ContinueFuture& future,
       int maxPreloadSplits,
-      const ConnectorSplitPreloadFunc& preload) override {
+      const ConnectorSplitPreloadFunc& preload,
+      int maxPrewarmSplits,
+      const ConnectorSplitPreloadFunc& prewarm) override {
     if (!splits_.empty()) {
-      split = getSplit(maxPreloadSplits, preload);
+      split =
+          getSplit(maxPreloadSplits, preload, maxPrewarmSplits, prewarm);
       return true;
     }
     if (noMoreSplits_) {
@@ -456,6 +461,7 @@ Task::~Task() {
   CLEAR(exchangeClientByPlanNode_.clear());
   CLEAR(exchangeClients_.clear());
   CLEAR(exception_ = nullptr);
+  CLEAR(optimizedExprs_.clear());
   CLEAR(nodePools_.clear());
   CLEAR(childPools_.clear());
   CLEAR(pool_.reset());
@@ -547,6 +553,7 @@ void Task::setSpillDiskConfig(
   spillDirectory_ = std::move(spillDiskOpts->spillDirPath);
   spillDirectoryCreated_ = spillDiskOpts->spillDirCreated;
   spillDirectoryCallback_ = std::move(spillDiskOpts->spillDirCreateCb);
+  spillOverflowDirectory_ = std::move(spillDiskOpts->spillOverflowDirPath);
 }
 
 Task::TaskList& Task::taskList() {
@@ -659,10 +666,48 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
+const std::string& Task::getOrCreateSpillOverflowDirectory() {
+  VELOX_CHECK(
+      !spillOverflowDirectory_.empty(),
+      "Spill overflow directory must be set");
+  if (spillOverflowDirectoryCreated_) {
+    return spillOverflowDirectory_;
+  }
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  if (spillOverflowDirectoryCreated_) {
+    return spillOverflowDirectory_;
+  }
+  try {
+    auto fileSystem =
+        filesystems::getFileSystem(spillOverflowDirectory_, nullptr);
+    fileSystem->mkdir(spillOverflowDirectory_);
+  } catch (const std::exception& e) {
+    VELOX_FAIL(
+        "Failed to create spill overflow directory '{}' for Task {}: {}",
+        spillOverflowDirectory_,
+        taskId(),
+        e.what());
+  }
+  spillOverflowDirectoryCreated_ = true;
+  return spillOverflowDirectory_;
+}
+
 void Task::removeSpillDirectoryIfExists() {
+  if (!spillOverflowDirectory_.empty() && spillOverflowDirectoryCreated_) {
+    try {
+      auto fs = filesystems::getFileSystem(spillOverflowDirectory_, nullptr);
+      fs->rmdir(spillOverflowDirectory_);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove spill overflow directory '"
+                 << spillOverflowDirectory_ << "' for Task " << taskId()
+                 << ": " << e.what();
+    }
+  }
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
   }
+  LocalSpillQuota::instance().removeDirectory(spillDirectory_);
   try {
     auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
     fs->rmdir(spillDirectory_);
@@ -673,9 +718,19 @@ void Task::removeSpillDirectoryIfExists() {
 }
 
 uint64_t Task::driverCpuTimeSliceLimitMs() const {
-  return mode_ == Task::ExecutionMode::kSerial
-      ? 0
-      : queryCtx_->queryConfig().driverCpuTimeSliceLimitMs();
+  if (mode_ == Task::ExecutionMode::kSerial) {
+    return 0;
+  }
+  const auto sliceMs = queryCtx_->queryConfig().driverCpuTimeSliceLimitMs();
+  if (sliceMs != 0) {
+    return sliceMs;
+  }
+  // The Drivers must yield for the fair share executor to preempt them.
+  if (const auto* fairShareExecutor =
+          dynamic_cast<const FairShareExecutor*>(queryCtx_->executor())) {
+    return fairShareExecutor->options().driverTimeSliceMs;
+  }
+  return 0;
 }
 
 void Task::initTaskPool() {
@@ -799,14 +854,30 @@ velox::memory::MemoryPool* Task::addMergeSourcePool(
   return childPools_.back().get();
 }
 
+std::shared_ptr<const std::vector<core::TypedExprPtr>> Task::getOptimizedExprs(
+    const core::PlanNodeId& planNodeId,
+    const std::function<std::vector<core::TypedExprPtr>()>& optimize) {
+  std::lock_guard<std::mutex> l(optimizedExprsMutex_);
+  auto& exprs = optimizedExprs_[planNodeId];
+  if (exprs == nullptr) {
+    exprs =
+        std::make_shared<const std::vector<core::TypedExprPtr>>(optimize());
+  }
+  return exprs;
+}
+
 velox::memory::MemoryPool* Task::addExchangeClientPool(
     const core::PlanNodeId& planNodeId,
-    uint32_t pipelineId) {
+    uint32_t pipelineId,
+    std::unique_ptr<memory::MemoryReclaimer> reclaimer) {
   auto* nodePool = getOrAddNodePool(planNodeId);
+  if (reclaimer == nullptr || pool()->reclaimer() == nullptr) {
+    reclaimer = createExchangeClientReclaimer();
+  }
   childPools_.push_back(nodePool->addLeafChild(
       fmt::format("exchangeClient.{}.{}", planNodeId, pipelineId),
       true,
-      createExchangeClientReclaimer()));
+      std::move(reclaimer)));
   return childPools_.back().get();
 }
 
@@ -976,6 +1047,7 @@ void Task::start(uint32_t maxDrivers, uint32_t concurrentSplitGroups) {
         return;
       }
       createDriverFactoriesLocked(maxDrivers);
+      maybeStartPerfettoTraceLocked();
     }
     initializePartitionOutput();
     createAndStartDrivers(concurrentSplitGroups);
@@ -1657,6 +1729,40 @@ void Task::addSplitToStoreLocked(
   queueSplitsStore->addSplit(split, promises);
 }
 
+bool Task::addDividedSplits(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    std::vector<exec::Split> splits) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::timed_mutex> l(mutex_);
+    if (!isRunningLocked()) {
+      return false;
+    }
+    auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
+    auto* queueSplitsStore = dynamic_cast<QueueSplitsStore*>(
+        splitsState.groupSplitsStores[splitGroupId].get());
+    if (queueSplitsStore == nullptr) {
+      return false;
+    }
+    // Adds the parts in reverse to keep their order at the front.
+    for (auto it = splits.rbegin(); it != splits.rend(); ++it) {
+      ++taskStats_.numTotalSplits;
+      ++taskStats_.numQueuedSplits;
+      if (splitsState.sourceIsTableScan) {
+        ++taskStats_.numQueuedTableScanSplits;
+        taskStats_.queuedTableScanSplitWeights +=
+            it->connectorSplit->splitWeight;
+      }
+      queueSplitsStore->addDividedSplit(std::move(*it), promises);
+    }
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return true;
+}
+
 void Task::noMoreSplitsForGroup(
     const core::PlanNodeId& planNodeId,
     int32_t splitGroupId) {
@@ -1972,7 +2078,9 @@ BlockingReason Task::getSplitOrFuture(
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t maxPrewarmSplits,
+    const ConnectorSplitPreloadFunc& prewarm) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
   auto& splitsStore = splitsState.groupSplitsStores[splitGroupId];
@@ -1981,7 +2089,13 @@ BlockingReason Task::getSplitOrFuture(
         splitsStore,
         std::make_unique<QueueSplitsStore>(!splitsState.sourceIsTableScan));
   }
-  return splitsStore->nextSplit(split, future, maxPreloadSplits, preload)
+  return splitsStore->nextSplit(
+             split,
+             future,
+             maxPreloadSplits,
+             preload,
+             maxPrewarmSplits,
+             prewarm)
       ? BlockingReason::kNotBlocked
       : BlockingReason::kWaitForSplit;
 }
@@ -2557,7 +2671,8 @@ ContinueFuture Task::terminate(TaskState terminalState) {
           while (!store->allSplitsConsumed()) {
             auto future = ContinueFuture::makeEmpty();
             VELOX_CHECK(
-                store->nextSplit(splits.emplace_back(), future, 0, nullptr));
+                store->nextSplit(
+                    splits.emplace_back(), future, 0, nullptr, 0, nullptr));
           }
         }
         if (!splits.empty()) {
@@ -2722,6 +2837,60 @@ TaskStats Task::taskStats() const {
   return taskStats;
 }
 
+TaskProgress Task::taskProgress() const {
+  TaskProgress progress;
+  progress.timeMs = getCurrentTimeMs();
+
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  progress.numTotalSplits = taskStats_.numTotalSplits;
+  progress.numFinishedSplits = taskStats_.numFinishedSplits;
+  progress.numRunningSplits = taskStats_.numRunningSplits;
+  progress.numQueuedSplits = taskStats_.numQueuedSplits;
+  progress.noMoreSplits = allNodesReceivedNoMoreSplitsMessageLocked();
+  progress.finished = !isRunningLocked();
+
+  // Start from the cumulative stats of the finished drivers.
+  progress.pipelines.resize(taskStats_.pipelineStats.size());
+  for (auto pipelineId = 0; pipelineId < progress.pipelines.size();
+       ++pipelineId) {
+    const auto& pipelineStats = taskStats_.pipelineStats[pipelineId];
+    auto& pipeline = progress.pipelines[pipelineId];
+    pipeline.numFinishedDrivers = pipelineStats.driverStats.size();
+    pipeline.operators.reserve(pipelineStats.operatorStats.size());
+    for (const auto& stats : pipelineStats.operatorStats) {
+      auto& op = pipeline.operators.emplace_back();
+      op.planNodeId = stats.planNodeId;
+      op.operatorType = stats.operatorType;
+      op.inputRows = stats.inputPositions;
+      op.outputRows = stats.outputPositions;
+      op.blockedWallNanos = stats.blockedWallNanos;
+      op.peakMemoryBytes = stats.memoryStats.peakTotalMemoryReservation;
+    }
+  }
+
+  // Add the counters of the drivers that are still running.
+  for (const auto& driver : drivers_) {
+    if (driver == nullptr) {
+      continue;
+    }
+    auto& pipeline = progress.pipelines[driver->driverCtx()->pipelineId];
+    ++pipeline.numRunningDrivers;
+    for (auto* op : driver->operators()) {
+      auto& opProgress = pipeline.operators.at(op->operatorId());
+      {
+        const auto lockedStats = op->stats().rlock();
+        opProgress.inputRows += lockedStats->inputPositions;
+        opProgress.outputRows += lockedStats->outputPositions;
+        opProgress.blockedWallNanos += lockedStats->blockedWallNanos;
+      }
+      opProgress.memoryBytes += op->pool()->reservedBytes();
+      opProgress.peakMemoryBytes = std::max<uint64_t>(
+          opProgress.peakMemoryBytes, op->pool()->peakBytes());
+    }
+  }
+  return progress;
+}
+
 bool Task::getLongRunningOpCalls(
     std::chrono::nanoseconds lockTimeout,
     size_t thresholdDurationMs,
@@ -2795,7 +2964,28 @@ Task::DriverCounts Task::driverCounts() const {
   return ret;
 }
 
+void Task::maybeStartPerfettoTraceLocked() {
+  if (!process::perfettoTraceSupported()) {
+    return;
+  }
+  const auto traceDir = queryCtx_->queryConfig().perfettoTraceDir();
+  if (traceDir.empty()) {
+    return;
+  }
+  perfettoTraceSession_ = process::PerfettoTraceSession::start(
+      fmt::format("{}/{}.perfetto-trace", traceDir, taskId_));
+}
+
 void Task::onTaskCompletion() {
+  std::unique_ptr<process::PerfettoTraceSession> perfettoTraceSession;
+  {
+    std::lock_guard<std::timed_mutex> l(mutex_);
+    perfettoTraceSession = std::move(perfettoTraceSession_);
+  }
+  // Writes the trace. The failure to write it is logged and does not fail the
+  // task.
+  perfettoTraceSession.reset();
+
   listeners().withRLock([&](auto& listeners) {
     if (listeners.empty()) {
       return;
@@ -3001,30 +3191,36 @@ const std::vector<std::shared_ptr<MergeSource>>& Task::getLocalMergeSources(
 
 void Task::createMergeJoinSource(
     uint32_t splitGroupId,
-    const core::PlanNodeId& planNodeId) {
-  auto& splitGroupState = splitGroupStates_[splitGroupId];
+    const core::PlanNodeId& planNodeId,
+    uint32_t driverId) {
+  auto& sources = splitGroupStates_[splitGroupId].mergeJoinSources[planNodeId];
+  if (sources.size() <= driverId) {
+    sources.resize(driverId + 1);
+  }
 
-  VELOX_CHECK(
-      splitGroupState.mergeJoinSources.find(planNodeId) ==
-          splitGroupState.mergeJoinSources.end(),
-      "Merge join sources already exist: {}",
-      planNodeId);
+  VELOX_CHECK_NULL(
+      sources[driverId],
+      "Merge join sources already exist: {}, driver {}",
+      planNodeId,
+      driverId);
 
-  splitGroupState.mergeJoinSources.insert(
-      {planNodeId, std::make_shared<MergeJoinSource>()});
+  sources[driverId] = std::make_shared<MergeJoinSource>();
 }
 
 std::shared_ptr<MergeJoinSource> Task::getMergeJoinSource(
     uint32_t splitGroupId,
-    const core::PlanNodeId& planNodeId) {
+    const core::PlanNodeId& planNodeId,
+    uint32_t driverId) {
   auto& splitGroupState = splitGroupStates_[splitGroupId];
 
   auto it = splitGroupState.mergeJoinSources.find(planNodeId);
   VELOX_CHECK(
-      it != splitGroupState.mergeJoinSources.end(),
-      "Merge join source for specified plan node doesn't exist: {}",
-      planNodeId);
-  return it->second;
+      it != splitGroupState.mergeJoinSources.end() &&
+          driverId < it->second.size() && it->second[driverId] != nullptr,
+      "Merge join source for specified plan node doesn't exist: {}, driver {}",
+      planNodeId,
+      driverId);
+  return it->second[driverId];
 }
 
 void Task::createLocalExchangeQueuesLocked(
@@ -3429,19 +3625,33 @@ void Task::createExchangeClientLocked(
       getExchangeClientLocked(planNodeId),
       "Exchange client has been created for planNode: {}",
       planNodeId);
+  const auto& queryConfig = queryCtx()->queryConfig();
+  // A buffer that grows can be shrunk by memory arbitration.
+  std::unique_ptr<ExchangeClient::MemoryReclaimer> reclaimer;
+  ExchangeClient::MemoryReclaimer* rawReclaimer{nullptr};
+  if (queryConfig.maxExchangeBufferSizeLimit() >
+          queryConfig.maxExchangeBufferSize() &&
+      pool()->reclaimer() != nullptr) {
+    reclaimer = ExchangeClient::MemoryReclaimer::create();
+    rawReclaimer = reclaimer.get();
+  }
   // Low-water mark for filling the exchange queue is 1/2 of the per worker
   // buffer size of the producers.
   exchangeClients_[pipelineId] = std::make_shared<ExchangeClient>(
       taskId_,
       destination_,
-      queryCtx()->queryConfig().maxExchangeBufferSize(),
+      queryConfig.maxExchangeBufferSize(),
       numberOfConsumers,
-      queryCtx()->queryConfig().minExchangeOutputBatchBytes(),
-      addExchangeClientPool(planNodeId, pipelineId),
+      queryConfig.minExchangeOutputBatchBytes(),
+      addExchangeClientPool(planNodeId, pipelineId, std::move(reclaimer)),
       queryCtx()->executor(),
-      queryCtx()->queryConfig().requestDataSizesMaxWaitSec(),
-      queryCtx()->queryConfig().singleSourceExchangeOptimizationEnabled(),
-      queryCtx()->queryConfig().exchangeLazyFetchingEnabled());
+      queryConfig.requestDataSizesMaxWaitSec(),
+      queryConfig.singleSourceExchangeOptimizationEnabled(),
+      queryConfig.exchangeLazyFetchingEnabled(),
+      queryConfig.maxExchangeBufferSizeLimit());
+  if (rawReclaimer != nullptr) {
+    rawReclaimer->setClient(exchangeClients_[pipelineId]);
+  }
   exchangeClientByPlanNode_.emplace(planNodeId, exchangeClients_[pipelineId]);
 }
 
@@ -18,6 +18,7 @@
 #include <folly/container/IntrusiveList.h>
 
 #include "velox/common/base/SkewedPartitionBalancer.h"
+#include "velox/common/process/PerfettoTrace.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
@@ -25,6 +26,7 @@
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/ScaledScanController.h"
+#include "velox/exec/TaskProgress.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
 #include "velox/exec/trace/TraceCtx.h"
@@ -195,6 +197,10 @@ class Task : public std::enable_shared_from_this<Task> {
   /// next().
   bool supportSerialExecutionMode() const;
 
+  ExecutionMode executionMode() const {
+    return mode_;
+  }
+
   /// Single-threaded execution API. Runs the query and returns results one
   /// batch at a time. Returns nullptr if the query is finished or has reached
   /// to a task barrier.
@@ -252,6 +258,16 @@ class Task : public std::enable_shared_from_this<Task> {
   /// Note that, the operation is silently ignored if Task is not running.
   void addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split);
 
+  /// Adds the parts of a split of the source operator of 'planNodeId' that a
+  /// driver of split group 'splitGroupId' took and divided, ahead of the
+  /// queued splits, so that the other drivers of the pipeline pick them up
+  /// next. Returns false and adds nothing if the splits of the node do not
+  /// come from the default split queue.
+  bool addDividedSplits(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      std::vector<exec::Split> splits);
+
   /// We mark that for the given group there would be no more splits coming.
   void noMoreSplitsForGroup(
       const core::PlanNodeId& planNodeId,
@@ -327,6 +343,11 @@ class Task : public std::enable_shared_from_this<Task> {
   /// structure.
   TaskStats taskStats() const;
 
+  /// Returns the split counts and the per-operator rows, blocked time and
+  /// memory of the task. Much cheaper than taskStats() for frequent polling
+  /// as it reads only a few counters of each operator.
+  TaskProgress taskProgress() const;
+
   /// Information about an operator call that helps debugging stuck calls.
   struct OpCallInfo {
     size_t durationMs;
@@ -424,6 +445,15 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t pipelineId,
       uint32_t sourceId);
 
+  /// Returns the expressions of 'planNodeId' after rewrites and constant
+  /// folding. The first caller computes them with 'optimize', which runs under
+  /// a lock, and the other Drivers of the task get the same immutable result,
+  /// so that each Driver only compiles the expressions instead of folding
+  /// them again.
+  std::shared_ptr<const std::vector<core::TypedExprPtr>> getOptimizedExprs(
+      const core::PlanNodeId& planNodeId,
+      const std::function<std::vector<core::TypedExprPtr>()>& optimize);
+
   /// Removes driver from the set of drivers in 'self'. The task will be kept
   /// alive by 'self'. 'self' going out of scope may cause the Task to
   /// be freed. This happens if a cancelled task is decoupled from the
@@ -437,14 +467,18 @@ class Task : public std::enable_shared_from_this<Task> {
   /// that will complete when split becomes available or no-more-splits
   /// signal is received. If 'maxPreloadSplits' is given, ensures that
   /// so many of splits at the head of the queue are preloading. If
-  /// they are not, calls preload on them to start preload.
+  /// they are not, calls preload on them to start preload. If
+  /// 'maxPrewarmSplits' is given, calls prewarm once on each of so many
+  /// splits after the preloading ones.
   BlockingReason getSplitOrFuture(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
       exec::Split& split,
       ContinueFuture& future,
       int32_t maxPreloadSplits = 0,
-      const ConnectorSplitPreloadFunc& preload = nullptr);
+      const ConnectorSplitPreloadFunc& preload = nullptr,
+      int32_t maxPrewarmSplits = 0,
+      const ConnectorSplitPreloadFunc& prewarm = nullptr);
 
   /// Returns the scaled scan controller for a given table scan node if the
   /// query has configured.
@@ -471,13 +505,19 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Creates the source of right side data for the MergeJoin operator of
+  /// driver 'driverId'. A merge join runs on more than one driver only if both
+  /// of its inputs are partitioned on the join keys, in which case each driver
+  /// joins one partition, see LocalPlanner.
   void createMergeJoinSource(
       uint32_t splitGroupId,
-      const core::PlanNodeId& planNodeId);
+      const core::PlanNodeId& planNodeId,
+      uint32_t driverId);
 
   std::shared_ptr<MergeJoinSource> getMergeJoinSource(
       uint32_t splitGroupId,
-      const core::PlanNodeId& planNodeId);
+      const core::PlanNodeId& planNodeId,
+      uint32_t driverId);
 
   void createLocalExchangeQueuesLocked(
       uint32_t splitGroupId,
@@ -740,6 +780,15 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  const std::string& spillOverflowDirectory() const {
+    return spillOverflowDirectory_;
+  }
+
+  /// Returns the spill overflow directory path after creating the directory
+  /// on first call. Is thread safe. Must only be called if
+  /// spillOverflowDirectory() is not empty.
+  const std::string& getOrCreateSpillOverflowDirectory();
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -908,10 +957,12 @@ class Task : public std::enable_shared_from_this<Task> {
 
   // Creates new instance of MemoryPool for the exchange client of an
   // ExchangeNode in a pipeline, stores it in the task to ensure lifetime and
-  // returns a raw pointer.
+  // returns a raw pointer. Uses 'reclaimer' if not null and the task memory
+  // pool has set memory reclaimer.
   velox::memory::MemoryPool* addExchangeClientPool(
       const core::PlanNodeId& planNodeId,
-      uint32_t pipelineId);
+      uint32_t pipelineId,
+      std::unique_ptr<memory::MemoryReclaimer> reclaimer = nullptr);
 
   // Invoked to remove this task from the output buffer manager if it has set
   // output buffer.
@@ -1017,6 +1068,9 @@ class Task : public std::enable_shared_from_this<Task> {
   // Notifies listeners that the task is now complete.
   void onTaskCompletion();
 
+  // Starts the Perfetto trace of this task if 'perfetto_trace_dir' is set.
+  void maybeStartPerfettoTraceLocked();
+
   void onAddSplit(const core::PlanNodeId& planNodeId, const exec::Split& split);
 
   // Returns true if all splits are finished processing and there are no more
@@ -1167,6 +1221,10 @@ class Task : public std::enable_shared_from_this<Task> {
 
   const std::unique_ptr<trace::TraceCtx> traceCtx_;
 
+  // Records the timeline of this task from start to completion. Null if the
+  // Perfetto trace is disabled.
+  std::unique_ptr<process::PerfettoTraceSession> perfettoTraceSession_;
+
   inline static std::atomic_uint64_t numCreatedTasks_;
 
   // Hook in the system wide task list.
@@ -1404,6 +1462,21 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // Directory for the spill files that overflow the node-wide local spill
+  // quota. Created under 'spillDirCreateMutex_' on first use.
+  std::string spillOverflowDirectory_;
+  std::atomic<bool> spillOverflowDirectoryCreated_{false};
+
+  // Serializes getOptimizedExprs().
+  std::mutex optimizedExprsMutex_;
+
+  // Rewritten and constant folded expressions keyed by plan node id. Holds
+  // constants allocated from the operator pools in 'childPools_'.
+  folly::F14FastMap<
+      core::PlanNodeId,
+      std::shared_ptr<const std::vector<core::TypedExprPtr>>>
+      optimizedExprs_;
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TaskProgress.h"
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+std::optional<double> TaskProgress::completion() const {
+  if (finished) {
+    return 1.0;
+  }
+  if (numTotalSplits == 0) {
+    return std::nullopt;
+  }
+  return std::min(
+      1.0,
+      (numFinishedSplits + 0.5 * numRunningSplits) / numTotalSplits);
+}
+
+TaskProgress TaskProgress::delta(const TaskProgress& previous) const {
+  TaskProgress result = *this;
+  if (previous.pipelines.size() != pipelines.size()) {
+    return result;
+  }
+  for (auto pipelineId = 0; pipelineId < pipelines.size(); ++pipelineId) {
+    auto& operators = result.pipelines[pipelineId].operators;
+    const auto& previousOperators = previous.pipelines[pipelineId].operators;
+    if (previousOperators.size() != operators.size()) {
+      continue;
+    }
+    for (auto operatorId = 0; operatorId < operators.size(); ++operatorId) {
+      auto& op = operators[operatorId];
+      const auto& previousOp = previousOperators[operatorId];
+      op.inputRows -= std::min(op.inputRows, previousOp.inputRows);
+      op.outputRows -= std::min(op.outputRows, previousOp.outputRows);
+      op.blockedWallNanos -=
+          std::min(op.blockedWallNanos, previousOp.blockedWallNanos);
+    }
+  }
+  return result;
+}
+
+std::string TaskProgress::toString() const {
+  const auto done = completion();
+  std::stringstream out;
+  out << fmt::format(
+      "splits {}/{} finished, {} running, {} queued, completion {}{}",
+      numFinishedSplits,
+      numTotalSplits,
+      numRunningSplits,
+      numQueuedSplits,
+      done.has_value() ? fmt::format("{:.1f}%", *done * 100) : "unknown",
+      finished ? ", finished" : "");
+  for (auto pipelineId = 0; pipelineId < pipelines.size(); ++pipelineId) {
+    const auto& pipeline = pipelines[pipelineId];
+    out << fmt::format(
+        "\nPipeline {}: {} running drivers, {} finished drivers",
+        pipelineId,
+        pipeline.numRunningDrivers,
+        pipeline.numFinishedDrivers);
+    for (const auto& op : pipeline.operators) {
+      out << fmt::format(
+          "\n  {}[{}]: input rows {}, output rows {}, blocked {}, memory {}, "
+          "peak memory {}",
+          op.operatorType,
+          op.planNodeId,
+          op.inputRows,
+          op.outputRows,
+          succinctNanos(op.blockedWallNanos),
+          succinctBytes(op.memoryBytes),
+          succinctBytes(op.peakMemoryBytes));
+    }
+  }
+  return out.str();
+}
+
+TaskProgressReporter::TaskProgressReporter(
+    Callback callback,
+    const Options& options)
+    : callback_(std::move(callback)), options_(options) {
+  VELOX_CHECK_NOT_NULL(callback_);
+  VELOX_CHECK_GT(options_.intervalMs, 0);
+}
+
+TaskProgressReporter::~TaskProgressReporter() {
+  stop();
+}
+
+void TaskProgressReporter::addTask(const std::shared_ptr<Task>& task) {
+  VELOX_CHECK_NOT_NULL(task);
+  tasks_.wlock()->push_back({task, {}});
+}
+
+void TaskProgressReporter::start() {
+  scheduler_.add("report_task_progress", [this]() noexcept {
+    try {
+      report();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Error reporting task progress: " << e.what();
+    }
+    return std::chrono::milliseconds(options_.intervalMs);
+  });
+}
+
+void TaskProgressReporter::stop() {
+  scheduler_.stop();
+}
+
+void TaskProgressReporter::report() {
+  std::lock_guard<std::mutex> l(reportMutex_);
+  // Takes the tasks out so that the callbacks run without holding 'tasks_'.
+  // Tasks added meanwhile are appended on return.
+  std::vector<ReportedTask> tasks;
+  tasks_.withWLock([&](auto& lockedTasks) { std::swap(tasks, lockedTasks); });
+
+  std::vector<ReportedTask> runningTasks;
+  runningTasks.reserve(tasks.size());
+  for (auto& reportedTask : tasks) {
+    const auto task = reportedTask.task.lock();
+    if (task == nullptr) {
+      continue;
+    }
+    auto progress = task->taskProgress();
+    callback_(*task, progress.delta(reportedTask.progress));
+    if (!progress.finished) {
+      reportedTask.progress = std::move(progress);
+      runningTasks.push_back(std::move(reportedTask));
+    }
+  }
+
+  tasks_.withWLock([&](auto& lockedTasks) {
+    for (auto& reportedTask : lockedTasks) {
+      runningTasks.push_back(std::move(reportedTask));
+    }
+    std::swap(lockedTasks, runningTasks);
+  });
+}
+
+size_t TaskProgressReporter::numTasks() const {
+  return tasks_.rlock()->size();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/executors/ThreadedRepeatingFunctionRunner.h>
+
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+class Task;
+
+/// Cumulative counters of one operator of a pipeline over all its drivers. A
+/// small subset of OperatorStats that is cheap to collect from a running
+/// task.
+struct OperatorProgress {
+  core::PlanNodeId planNodeId;
+  std::string operatorType;
+  uint64_t inputRows{0};
+  uint64_t outputRows{0};
+  uint64_t blockedWallNanos{0};
+  /// Memory currently reserved by the instances of the operator in the
+  /// running drivers.
+  uint64_t memoryBytes{0};
+  /// Peak memory reservation of any instance of the operator.
+  uint64_t peakMemoryBytes{0};
+};
+
+struct PipelineProgress {
+  /// The subscript is the operator id.
+  std::vector<OperatorProgress> operators;
+  uint32_t numRunningDrivers{0};
+  uint32_t numFinishedDrivers{0};
+};
+
+/// A lightweight snapshot of the progress of a task returned by
+/// Task::taskProgress(). Unlike Task::taskStats(), it copies no runtime stats
+/// or driver stats.
+struct TaskProgress {
+  /// Epoch time (ms) of the snapshot.
+  uint64_t timeMs{0};
+  int32_t numTotalSplits{0};
+  int32_t numFinishedSplits{0};
+  int32_t numRunningSplits{0};
+  int32_t numQueuedSplits{0};
+  /// True if all the source nodes received their last split, so that
+  /// 'numTotalSplits' is final.
+  bool noMoreSplits{false};
+  /// True if the task is no longer running.
+  bool finished{false};
+  /// The subscript is the pipeline id.
+  std::vector<PipelineProgress> pipelines;
+
+  /// Returns the estimated fraction of the task that is done, between 0 and
+  /// 1, from the completed splits. Running splits count half. The estimate
+  /// overshoots while more splits may arrive. Returns std::nullopt if the
+  /// task got no split yet.
+  std::optional<double> completion() const;
+
+  /// Returns the change since 'previous', an earlier snapshot of the same
+  /// task. The row counts and the blocked time are differences. The other
+  /// fields are as of this snapshot.
+  TaskProgress delta(const TaskProgress& previous) const;
+
+  std::string toString() const;
+};
+
+/// Manages a background thread that streams the progress of a set of tasks
+/// as deltas at a fixed interval. It is a cheap alternative to polling
+/// Task::taskStats() of all the running tasks.
+class TaskProgressReporter {
+ public:
+  struct Options {
+    Options() {}
+
+    uint64_t intervalMs{1'000};
+  };
+
+  /// Receives the change of the progress of 'task' since the previous call
+  /// for the same task. The first call for a task gets its progress since
+  /// start. The last call is made once the task finishes.
+  using Callback =
+      std::function<void(const Task& task, const TaskProgress& delta)>;
+
+  TaskProgressReporter(Callback callback, const Options& options = Options());
+
+  ~TaskProgressReporter();
+
+  /// Adds 'task' to the tasks to report. The reporter keeps a weak reference
+  /// and stops reporting once the task finishes or is deleted.
+  void addTask(const std::shared_ptr<Task>& task);
+
+  /// Starts the report thread.
+  void start();
+
+  /// Stops the report thread.
+  void stop();
+
+  /// Reports the progress of all the tasks once. Invoked by the report
+  /// thread.
+  void report();
+
+  /// Returns the number of tasks being reported.
+  size_t numTasks() const;
+
+ private:
+  struct ReportedTask {
+    std::weak_ptr<Task> task;
+    // The progress as of the last report.
+    TaskProgress progress;
+  };
+
+  const Callback callback_;
+  const Options options_;
+
+  folly::Synchronized<std::vector<ReportedTask>> tasks_;
+  // Serializes report() so that the deltas of a task are reported in order.
+  std::mutex reportMutex_;
+
+  folly::ThreadedRepeatingFunctionRunner scheduler_;
+};
+
+} // namespace facebook::velox::exec
@@ -31,6 +31,18 @@ void SplitsStore::addSplit(
   promises_.pop_back();
 }
 
+void SplitsStore::addDividedSplit(
+    Split split,
+    std::vector<ContinuePromise>& promises) {
+  VELOX_CHECK(split.hasConnectorSplit());
+  splits_.push_front(std::move(split));
+  if (promises_.empty()) {
+    return;
+  }
+  promises.push_back(std::move(promises_.back()));
+  promises_.pop_back();
+}
+
 ContinueFuture SplitsStore::makeFuture() {
   auto [promise, future] =
       makeVeloxContinuePromiseContract("SplitsStore::makeFuture");
@@ -40,7 +52,24 @@ ContinueFuture SplitsStore::makeFuture() {
 
 Split SplitsStore::getSplit(
     int maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int maxPrewarmSplits,
+    const ConnectorSplitPreloadFunc& prewarm) {
+  if (maxPrewarmSplits > 0) {
+    const size_t begin = std::max(maxPreloadSplits, 0);
+    const size_t end =
+        std::min<size_t>(begin + maxPrewarmSplits, splits_.size());
+    for (auto i = begin; i < end; ++i) {
+      if (splits_[i].isBarrier()) {
+        continue;
+      }
+      auto& connectorSplit = splits_[i].connectorSplit;
+      if (!connectorSplit->prewarmed && !connectorSplit->dataSource) {
+        connectorSplit->prewarmed = true;
+        prewarm(connectorSplit);
+      }
+    }
+  }
   int readySplitIndex = -1;
   if (maxPreloadSplits > 0) {
     for (int i = 0, end = std::min<size_t>(maxPreloadSplits, splits_.size());
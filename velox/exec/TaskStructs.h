@@ -91,12 +91,16 @@ class SplitsStore {
   virtual void requestBarrier(std::vector<ContinuePromise>& promises) = 0;
 
   /// Return true when split is set or there is no more splits; false when
-  /// caller should retry when the future is fulfilled.
+  /// caller should retry when the future is fulfilled. 'preload' is applied to
+  /// the first 'maxPreloadSplits' queued splits and 'prewarm' to the ones up to
+  /// 'maxPrewarmSplits' after these.
   virtual bool nextSplit(
       Split& split,
       ContinueFuture& future,
       int maxPreloadSplits,
-      const ConnectorSplitPreloadFunc& preload) = 0;
+      const ConnectorSplitPreloadFunc& preload,
+      int maxPrewarmSplits,
+      const ConnectorSplitPreloadFunc& prewarm) = 0;
 
   /// Return whether all splits has been consumed and there will be no more
   /// splits.
@@ -111,6 +115,11 @@ class SplitsStore {
   /// any waiters on the splits.
   void addSplit(Split split, std::vector<ContinuePromise>& promises);
 
+  /// Adds a part of a split that a driver took and divided, ahead of the
+  /// queued splits. Unlike addSplit(), may be called after noMoreSplits(), as
+  /// long as the driver that divided the split has not finished.
+  void addDividedSplit(Split split, std::vector<ContinuePromise>& promises);
+
   /// Return the number of waiters waiting for new splits.
   int numWaiters() const {
     return promises_.size();
@@ -135,7 +144,9 @@ class SplitsStore {
  protected:
   Split getSplit(
       int maxPreloadSplits,
-      const ConnectorSplitPreloadFunc& preload);
+      const ConnectorSplitPreloadFunc& preload,
+      int maxPrewarmSplits,
+      const ConnectorSplitPreloadFunc& prewarm);
 
   ContinueFuture makeFuture();
 
@@ -199,8 +210,11 @@ struct SplitGroupState {
       unordered_map<core::PlanNodeId, std::vector<std::shared_ptr<MergeSource>>>
           localMergeSources;
 
-  /// Map of merge join sources keyed on MergeJoinNode plan node ID.
-  std::unordered_map<core::PlanNodeId, std::shared_ptr<MergeJoinSource>>
+  /// Map of merge join sources keyed on MergeJoinNode plan node ID. There is
+  /// one source per MergeJoin driver, indexed by driver ID.
+  std::unordered_map<
+      core::PlanNodeId,
+      std::vector<std::shared_ptr<MergeJoinSource>>>
       mergeJoinSources;
 
   /// Map of local exchanges keyed on LocalPartition plan node ID.
@@ -55,6 +55,13 @@ TopN::TopN(
       }
     }
   }
+  if (count_ > 0) {
+    dynamicFilter_ = TopNDynamicFilter::create(
+        this,
+        sortingKeyColumns_[0],
+        outputType_->childAt(sortingKeyColumns_[0]),
+        topNNode->sortingOrders()[0]);
+  }
 }
 
 void TopN::addInput(RowVectorPtr input) {
@@ -104,6 +111,10 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  if (dynamicFilter_ != nullptr && topRows_.size() == count_) {
+    dynamicFilter_->update(*data_, topRows_.top(), sortingKeyColumns_[0]);
+  }
 }
 
 RowVectorPtr TopN::getOutput() {
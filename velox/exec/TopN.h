@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/TopNDynamicFilter.h"
 
 namespace facebook::velox::exec {
 
@@ -68,5 +69,10 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Pushes the first sorting key of the top of 'topRows_' down to the
+  // upstream operators once 'topRows_' has 'count_' rows. Not set if the
+  // pushdown is disabled or not supported for the key.
+  std::unique_ptr<TopNDynamicFilter> dynamicFilter_;
 };
 } // namespace facebook::velox::exec
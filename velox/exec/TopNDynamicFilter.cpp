@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/TopNDynamicFilter.h"
+
+#include <cmath>
+
+#include "velox/exec/Driver.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+bool isSupported(const TypePtr& type, const core::SortOrder& sortOrder) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      // NaN sorts after all other values but does not pass a range filter
+      // with an unbounded upper end.
+      return sortOrder.isAscending();
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+T thresholdValue(const VectorPtr& vector) {
+  return vector->asUnchecked<SimpleVector<T>>()->valueAt(0);
+}
+
+template <typename T>
+common::FilterPtr makeBigintRange(
+    const VectorPtr& threshold,
+    bool ascending,
+    bool nullAllowed) {
+  const int64_t value = thresholdValue<T>(threshold);
+  return std::make_shared<common::BigintRange>(
+      ascending ? std::numeric_limits<int64_t>::min() : value,
+      ascending ? value : std::numeric_limits<int64_t>::max(),
+      nullAllowed);
+}
+
+template <typename T>
+common::FilterPtr makeFloatingPointRange(
+    const VectorPtr& threshold,
+    bool nullAllowed) {
+  const auto value = thresholdValue<T>(threshold);
+  if (std::isnan(value)) {
+    return nullptr;
+  }
+  return std::make_shared<common::FloatingPointRange<T>>(
+      0, true, false, value, false, false, nullAllowed);
+}
+} // namespace
+
+// static
+std::unique_ptr<TopNDynamicFilter> TopNDynamicFilter::create(
+    Operator* op,
+    column_index_t channel,
+    const TypePtr& type,
+    const core::SortOrder& sortOrder) {
+  if (!op->operatorCtx()
+           ->driverCtx()
+           ->queryConfig()
+           .topNDynamicFilterPushdownEnabled() ||
+      !isSupported(type, sortOrder)) {
+    return nullptr;
+  }
+  return std::unique_ptr<TopNDynamicFilter>(
+      new TopNDynamicFilter(op, channel, type, sortOrder));
+}
+
+TopNDynamicFilter::TopNDynamicFilter(
+    Operator* op,
+    column_index_t channel,
+    const TypePtr& type,
+    const core::SortOrder& sortOrder)
+    : op_(op),
+      channel_(channel),
+      type_(type),
+      sortOrder_(sortOrder),
+      threshold_(BaseVector::create(type_, 1, op_->pool())),
+      pushedThreshold_(BaseVector::create(type_, 1, op_->pool())) {
+  pushedThreshold_->setNull(0, true);
+}
+
+bool TopNDynamicFilter::canPushdown() {
+  if (!canPushdown_.has_value()) {
+    const auto* driver = op_->operatorCtx()->driver();
+    canPushdown_ = driver != nullptr &&
+        !driver->canPushdownFilters(op_, {channel_}).empty();
+  }
+  return canPushdown_.value();
+}
+
+void TopNDynamicFilter::update(
+    const RowContainer& data,
+    const char* row,
+    column_index_t column) {
+  if (!canPushdown()) {
+    return;
+  }
+  data.extractColumn(&row, 1, column, threshold_);
+  if (threshold_->isNullAt(0)) {
+    return;
+  }
+  if (!pushedThreshold_->isNullAt(0) &&
+      threshold_->equalValueAt(pushedThreshold_.get(), 0, 0)) {
+    return;
+  }
+  auto filter = makeFilter();
+  if (filter == nullptr) {
+    return;
+  }
+  op_->operatorCtx()->driver()->pushdownFilters(
+      op_,
+      {channel_},
+      [&](column_index_t /*sourceChannel*/, common::FilterPtr& pushedFilter) {
+        pushedFilter = std::move(filter);
+        return true;
+      });
+  std::swap(threshold_, pushedThreshold_);
+}
+
+common::FilterPtr TopNDynamicFilter::makeFilter() const {
+  // Nulls sort before the threshold only if they sort first.
+  const bool nullAllowed = sortOrder_.isNullsFirst();
+  const bool ascending = sortOrder_.isAscending();
+  switch (type_->kind()) {
+    case TypeKind::TINYINT:
+      return makeBigintRange<int8_t>(threshold_, ascending, nullAllowed);
+    case TypeKind::SMALLINT:
+      return makeBigintRange<int16_t>(threshold_, ascending, nullAllowed);
+    case TypeKind::INTEGER:
+      return makeBigintRange<int32_t>(threshold_, ascending, nullAllowed);
+    case TypeKind::BIGINT:
+      return makeBigintRange<int64_t>(threshold_, ascending, nullAllowed);
+    case TypeKind::REAL:
+      return makeFloatingPointRange<float>(threshold_, nullAllowed);
+    case TypeKind::DOUBLE:
+      return makeFloatingPointRange<double>(threshold_, nullAllowed);
+    case TypeKind::TIMESTAMP: {
+      const auto value = thresholdValue<Timestamp>(threshold_);
+      return std::make_shared<common::TimestampRange>(
+          ascending ? Timestamp::min() : value,
+          ascending ? value : Timestamp::max(),
+          nullAllowed);
+    }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      const auto value = std::string(thresholdValue<StringView>(threshold_));
+      return std::make_shared<common::BytesRange>(
+          ascending ? "" : value,
+          ascending,
+          false,
+          ascending ? value : "",
+          !ascending,
+          false,
+          nullAllowed);
+    }
+    default:
+      VELOX_UNREACHABLE("Unsupported type: {}", type_->toString());
+  }
+}
+} // namespace facebook::velox::exec
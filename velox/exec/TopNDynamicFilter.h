@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/RowContainer.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::exec {
+
+class Operator;
+
+/// Pushes the running threshold of an operator that keeps the top K rows, e.g.
+/// TopN, down to the upstream operators as a dynamic range filter on the first
+/// sorting key. Once the operator holds K rows, the rows that sort after the
+/// worst of them on the first key can not make it into the top K. The filter
+/// lets the table scan drop these rows and skip the row groups and stripes
+/// whose min/max stats are out of the range.
+///
+/// The filter passes the values equal to the threshold, so it is correct with
+/// multiple sorting keys and for rank(). The filters pushed by the drivers of
+/// the same plan node are combined, which is correct because any of them only
+/// drops rows that can not be in the top K of its driver.
+class TopNDynamicFilter {
+ public:
+  /// Returns nullptr if dynamic filter pushdown is disabled for 'op' or if a
+  /// range filter on 'type' can not be made for 'sortOrder'. 'channel' is the
+  /// input channel of the first sorting key of 'op'.
+  static std::unique_ptr<TopNDynamicFilter> create(
+      Operator* op,
+      column_index_t channel,
+      const TypePtr& type,
+      const core::SortOrder& sortOrder);
+
+  /// Pushes down a filter that passes the values of the first sorting key that
+  /// sort before or equal to its value in 'row' of 'data'. 'column' is the
+  /// column of the key in 'data'. Does nothing if the value is null or is the
+  /// same as in the last pushed filter, or if no upstream operator accepts a
+  /// dynamic filter on the key.
+  void update(const RowContainer& data, const char* row, column_index_t column);
+
+ private:
+  TopNDynamicFilter(
+      Operator* op,
+      column_index_t channel,
+      const TypePtr& type,
+      const core::SortOrder& sortOrder);
+
+  // Returns true if an upstream operator accepts a dynamic filter on
+  // 'channel_'. Checked on first use because the driver of 'op_' is not set
+  // when the operator is created.
+  bool canPushdown();
+
+  // Returns the filter for the value in 'threshold_'.
+  common::FilterPtr makeFilter() const;
+
+  Operator* const op_;
+  const column_index_t channel_;
+  const TypePtr type_;
+  const core::SortOrder sortOrder_;
+
+  std::optional<bool> canPushdown_;
+
+  // Single row vectors with the current threshold and the threshold of the
+  // last pushed filter.
+  VectorPtr threshold_;
+  VectorPtr pushedThreshold_;
+};
+} // namespace facebook::velox::exec
@@ -192,6 +192,13 @@ TopNRowNumber::TopNRowNumber(
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
     singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    if (limit_ > 0) {
+      dynamicFilter_ = TopNDynamicFilter::create(
+          this,
+          inputChannels_[0],
+          inputType_->childAt(0),
+          node->sortingOrders()[0]);
+    }
   }
 
   if (generateRowNumber_) {
@@ -259,6 +266,12 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
     }
   } else {
     RANK_FUNCTION_DISPATCH(processInputRowLoop, rankFunction_, numInput);
+    // Rows that sort after the top row are rejected once the top rank has
+    // reached the limit.
+    if (dynamicFilter_ != nullptr && singlePartition_->topRank >= limit_ &&
+        !singlePartition_->rows.empty()) {
+      dynamicFilter_->update(*data_, singlePartition_->rows.top(), 0);
+    }
   }
 }
 
@@ -398,21 +411,6 @@ char* TopNRowNumber::processRowExceedingLimit<
   return newRow;
 }
 
-template <>
-char* TopNRowNumber::processRowExceedingLimit<
-    core::TopNRowNumberNode::RankFunction::kRowNumber>(
-    vector_size_t /*index*/,
-    TopRows& partition) {
-  // The new row has rank < highest (aka top) rank at 'limit' function value.
-  // For row_number, such rows are added to the accumulator queue and the
-  // top rank row is popped out. The topRank remains the same.
-  auto& topRows = partition.rows;
-  char* topRow = topRows.top();
-  topRows.pop();
-  // Reuses the space of the popped row itself for the new row.
-  return data_->initializeRow(topRow, true /* reuse */);
-}
-
 template <core::TopNRowNumberNode::RankFunction TRank>
 void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
   auto& topRows = partition.rows;
@@ -442,7 +440,22 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     }
 
     else if (result < 0) {
-      newRow = processRowExceedingLimit<TRank>(index, partition);
+      if constexpr (
+          TRank == core::TopNRowNumberNode::RankFunction::kRowNumber) {
+        // The new row has rank < highest (aka top) rank at 'limit' function
+        // value. For row_number, it replaces the top rank row and the top
+        // rank remains the same. The space of the top row is reused and the
+        // heap order is restored with a single sift-down, so a limit of 1
+        // becomes a plain best row per partition replace.
+        newRow = data_->initializeRow(topRow, /*reuse=*/true);
+        for (auto col = 0; col < decodedVectors_.size(); ++col) {
+          data_->store(decodedVectors_[col], index, newRow, col);
+        }
+        topRows.updateTop();
+        return;
+      } else {
+        newRow = processRowExceedingLimit<TRank>(index, partition);
+      }
     }
   }
 
@@ -939,6 +952,7 @@ void TopNRowNumber::close() {
   SCOPE_EXIT {
     table_.reset();
     singlePartition_.reset();
+    dynamicFilter_.reset();
     data_.reset();
     allocator_.reset();
   };
@@ -1076,22 +1090,31 @@ void TopNRowNumber::setupSpiller() {
       spillStats_.get());
 }
 
-// Using the underlying vector of the priority queue for the algorithms to
-// check duplicates and count the number of top rank rows. This makes the
-// algorithms O(n). There could be other approaches to make the
-// algorithms O(1), but would trade memory efficiency.
-namespace {
-template <class T, class S, class C>
-S& PriorityQueueVector(std::priority_queue<T, S, C>& q) {
-  struct PrivateQueue : private std::priority_queue<T, S, C> {
-    static S& Container(std::priority_queue<T, S, C>& q) {
-      return q.*&PrivateQueue::c;
+void TopNRowNumber::TopRows::RowHeap::updateTop() {
+  const auto size = rows_.size();
+  size_t index = 0;
+  for (;;) {
+    const auto left = 2 * index + 1;
+    if (left >= size) {
+      return;
     }
-  };
-  return PrivateQueue::Container(q);
+    auto largest = left;
+    const auto right = left + 1;
+    if (right < size && compare_(rows_[left], rows_[right])) {
+      largest = right;
+    }
+    if (!compare_(rows_[index], rows_[largest])) {
+      return;
+    }
+    std::swap(rows_[index], rows_[largest]);
+    index = largest;
+  }
 }
-} // namespace
 
+// The algorithms to check duplicates and count the number of top rank rows
+// scan the underlying vector of the heap. This makes the algorithms O(n).
+// There could be other approaches to make the algorithms O(1), but would
+// trade memory efficiency.
 char* TopNRowNumber::TopRows::removeTopRankRows() {
   VELOX_CHECK(!rows.empty());
 
@@ -1112,9 +1135,7 @@ vector_size_t TopNRowNumber::TopRows::numTopRankRows() {
   VELOX_CHECK(!rows.empty());
   char* topRow = rows.top();
   vector_size_t numRows = 0;
-  const std::vector<char*, StlAllocator<char*>> partitionRowsVector =
-      PriorityQueueVector(rows);
-  for (const char* row : partitionRowsVector) {
+  for (const char* row : rows.rows()) {
     if (rowComparator.compare(topRow, row) == 0) {
       numRows += 1;
     } else {
@@ -1127,9 +1148,7 @@ vector_size_t TopNRowNumber::TopRows::numTopRankRows() {
 bool TopNRowNumber::TopRows::isDuplicate(
     const std::vector<DecodedVector>& decodedVectors,
     vector_size_t index) {
-  const std::vector<char*, StlAllocator<char*>> partitionRowsVector =
-      PriorityQueueVector(rows);
-  for (const char* row : partitionRowsVector) {
+  for (const char* row : rows.rows()) {
     if (rowComparator.compare(decodedVectors, index, row) == 0) {
       return true;
     }
@@ -18,6 +18,7 @@
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spiller.h"
+#include "velox/exec/TopNDynamicFilter.h"
 
 namespace facebook::velox::exec {
 class TopNRowNumberSpiller;
@@ -109,8 +110,8 @@ class TopNRowNumber : public Operator {
       override;
 
  private:
-  // This structure holds the top rows for a partition. It uses a priority
-  // queue to maintain the top rows in order of their ranks. Note the rank
+  // This structure holds the top rows for a partition. It uses a max-heap
+  // to maintain the top rows in order of their ranks. Note the rank
   // logic depends on the respective function (row_number, rank or dense_rank).
   // However, a common requirement across all three is to maintain the rows in
   // order of their sort keys so that the greatest rank row is always at the top
@@ -135,8 +136,52 @@ class TopNRowNumber : public Operator {
       }
     };
 
-    std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
-        rows;
+    // A max-heap of rows with the same interface as std::priority_queue. In
+    // addition, it exposes the underlying vector and allows restoring the
+    // heap order after the top row has been overwritten in place, which
+    // replaces the pop() and push() pair with a single sift-down.
+    class RowHeap {
+     public:
+      RowHeap(Compare compare, StlAllocator<char*> allocator)
+          : compare_{compare}, rows_{allocator} {}
+
+      bool empty() const {
+        return rows_.empty();
+      }
+
+      size_t size() const {
+        return rows_.size();
+      }
+
+      char* top() const {
+        return rows_.front();
+      }
+
+      void push(char* row) {
+        rows_.push_back(row);
+        std::push_heap(rows_.begin(), rows_.end(), compare_);
+      }
+
+      void pop() {
+        std::pop_heap(rows_.begin(), rows_.end(), compare_);
+        rows_.pop_back();
+      }
+
+      // Restores the heap order after the contents of the top row changed to
+      // sort at or before their previous position.
+      void updateTop();
+
+      // Returns the rows in heap order.
+      const std::vector<char*, StlAllocator<char*>>& rows() const {
+        return rows_;
+      }
+
+     private:
+      Compare compare_;
+      std::vector<char*, StlAllocator<char*>> rows_;
+    };
+
+    RowHeap rows;
 
     RowComparator& rowComparator;
 
@@ -183,8 +228,10 @@ class TopNRowNumber : public Operator {
   template <core::TopNRowNumberNode::RankFunction TRank>
   char* processRowWithinLimit(vector_size_t index, TopRows& partition);
 
-  // Handles input row when the partition has already accumulated 'limit' rows.
-  // Returns a pointer to the row to add to the partition accumulator.
+  // Handles input row when the partition has already accumulated 'limit' rows
+  // for rank and dense_rank. Returns a pointer to the row to add to the
+  // partition accumulator. row_number overwrites the top row in place in
+  // processInputRow() instead.
   template <core::TopNRowNumberNode::RankFunction TRank>
   char* processRowExceedingLimit(vector_size_t index, TopRows& partition);
 
@@ -348,6 +395,12 @@ class TopNRowNumber : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
 
+  // Pushes the first sorting key of the top row of 'singlePartition_' down to
+  // the upstream operators once its top rank reaches 'limit_'. Not set if there
+  // are partition keys or if the pushdown is disabled or not supported for the
+  // key.
+  std::unique_ptr<TopNDynamicFilter> dynamicFilter_;
+
   bool finished_{false};
 
   // Size of a single output row estimated using 'data_->estimateRowSize()'.
@@ -307,10 +307,12 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
         } else if (!currentDecoded.isNullAt(row)) {
           const auto offset = currentOffsets[currentIndices[row]];
           const auto unnestSize = currentSizes[currentIndices[row]];
-          // The 'identityMapping' is false when there exists a partially
-          // processed row.
-          if (index != offset || start != 0 || end != rawMaxSizes_[row] ||
-              unnestSize < end) {
+          // The output stays a zero-copy slice of the elements while the
+          // elements of consecutive rows are contiguous and no null padding
+          // is needed. Partially processed first and last rows qualify as
+          // long as their elements follow on from the previous row.
+          if (unnestSize < end ||
+              (index > 0 && rawInnerRowIndices[0] + index != offset + start)) {
             identityMapping = false;
           }
           const auto currentUnnestSize = std::min(end, unnestSize);
@@ -487,34 +489,4 @@ VectorPtr Unnest::UnnestChannelEncoding::wrap(
 bool Unnest::isFinished() {
   return noMoreInput_ && input_ == nullptr;
 }
-
-void Unnest::RowRange::forEachRow(
-    const std::function<void(
-        vector_size_t /*row*/,
-        vector_size_t /*start*/,
-        vector_size_t /*size*/)>& func,
-    const vector_size_t* rawMaxSizes,
-    vector_size_t firstInnerRowStart) const {
-  // Process the first row.
-  const auto firstInnerRowEnd = numInputRows == 1 && lastInnerRowEnd.has_value()
-      ? lastInnerRowEnd.value()
-      : rawMaxSizes[startInputRow];
-  func(
-      startInputRow, firstInnerRowStart, firstInnerRowEnd - firstInnerRowStart);
-
-  const auto lastInputRow = startInputRow + numInputRows - 1;
-  // Process the middle rows.
-  for (auto inputRow = startInputRow + 1; inputRow < lastInputRow; ++inputRow) {
-    func(inputRow, 0, rawMaxSizes[inputRow]);
-  }
-
-  // Process the last row if exists.
-  if (numInputRows > 1) {
-    if (lastInnerRowEnd.has_value()) {
-      func(lastInputRow, 0, lastInnerRowEnd.value());
-    } else {
-      func(lastInputRow, 0, rawMaxSizes[lastInputRow]);
-    }
-  }
-}
 } // namespace facebook::velox::exec
@@ -74,13 +74,40 @@ class Unnest : public Operator {
     // @param rawMaxSizes Used to compute the end of each row.
     // @param firstInnerRowStart The index to start processing the first row.
     // Same with Unnest member firstInnerRowStart_.
+    //
+    // Defined inline as a template so that 'func' is inlined into the per-row
+    // loop instead of being invoked through std::function.
+    template <typename TFunc>
     void forEachRow(
-        const std::function<void(
-            vector_size_t /*row*/,
-            vector_size_t /*start*/,
-            vector_size_t /*size*/)>& func,
+        TFunc&& func,
         const vector_size_t* rawMaxSizes,
-        vector_size_t firstInnerRowStart) const;
+        vector_size_t firstInnerRowStart) const {
+      // Process the first row.
+      const auto firstInnerRowEnd =
+          numInputRows == 1 && lastInnerRowEnd.has_value()
+          ? lastInnerRowEnd.value()
+          : rawMaxSizes[startInputRow];
+      func(
+          startInputRow,
+          firstInnerRowStart,
+          firstInnerRowEnd - firstInnerRowStart);
+
+      const auto lastInputRow = startInputRow + numInputRows - 1;
+      // Process the middle rows.
+      for (auto inputRow = startInputRow + 1; inputRow < lastInputRow;
+           ++inputRow) {
+        func(inputRow, 0, rawMaxSizes[inputRow]);
+      }
+
+      // Process the last row if exists.
+      if (numInputRows > 1) {
+        func(
+            lastInputRow,
+            0,
+            lastInnerRowEnd.has_value() ? lastInnerRowEnd.value()
+                                        : rawMaxSizes[lastInputRow]);
+      }
+    }
 
     // First input row in 'input_' to be included in the output.
     const vector_size_t startInputRow;
@@ -237,6 +237,48 @@ bool VectorHasher::makeValueIdsFlatNoNulls(
   return success;
 }
 
+template <>
+bool VectorHasher::makeValueIdsFlatNoNulls<StringView>(
+    const SelectivityVector& rows,
+    uint64_t* result) {
+  const auto* values = decoded_.data<StringView>();
+  if (!rows.isAllSelected() || rows.size() < 2) {
+    bool success = true;
+    rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
+      makeValueIdForOneRow<StringView, false>(
+          nullptr, row, values, row, result, success);
+    });
+    return success;
+  }
+
+  // Compare each string with its predecessor in a batch so that runs of equal
+  // strings are looked up once.
+  const auto numRows = rows.size();
+  equalToPrevious_.resize(bits::nwords(numRows - 1));
+  StringView::equalsBatch(
+      values + 1, values, numRows - 1, equalToPrevious_.data());
+
+  bool success = true;
+  uint64_t id = kUnmappable;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    const auto& value = values[row];
+    if (!success) {
+      analyzeValue(value);
+      continue;
+    }
+    if (row == 0 || !bits::isBitSet(equalToPrevious_.data(), row - 1)) {
+      id = valueId(value);
+      if (id == kUnmappable) {
+        success = false;
+        analyzeValue(value);
+        continue;
+      }
+    }
+    result[row] = multiplier_ == 1 ? id : result[row] + multiplier_ * id;
+  }
+  return success;
+}
+
 template <typename T>
 bool VectorHasher::makeValueIdsFlatWithNulls(
     const SelectivityVector& rows,
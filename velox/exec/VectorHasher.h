@@ -261,6 +261,10 @@ class VectorHasher {
       case TypeKind::INTEGER:
       case TypeKind::BIGINT:
         return distinctOverflow_;
+      // getFilter() does not produce filters for strings.
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return true;
       default:
         return false;
     }
@@ -631,6 +635,10 @@ class VectorHasher {
   std::vector<std::string> uniqueValuesStorage_;
   uint64_t distinctStringsBytes_ = 0;
 
+  // Bit 'i' is set if the string at row 'i + 1' equals the one at row 'i'.
+  // Used for reusing value ids over runs of equal strings.
+  std::vector<uint64_t> equalToPrevious_;
+
   common::FilterPtr bloomFilter_;
 };
 
@@ -758,6 +766,11 @@ bool VectorHasher::makeValueIdsFlatNoNulls<bool>(
     const SelectivityVector& rows,
     uint64_t* result);
 
+template <>
+bool VectorHasher::makeValueIdsFlatNoNulls<StringView>(
+    const SelectivityVector& rows,
+    uint64_t* result);
+
 template <>
 bool VectorHasher::makeValueIdsFlatWithNulls<bool>(
     const SelectivityVector& rows,
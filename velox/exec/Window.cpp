@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/Window.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PartitionStreamingWindowBuild.h"
 #include "velox/exec/RowsStreamingWindowBuild.h"
@@ -29,7 +30,8 @@ common::PrefixSortConfig makePrefixSortConfig(
   return common::PrefixSortConfig{
       queryConfig.prefixSortNormalizedKeyMaxBytes(),
       queryConfig.prefixSortMinRows(),
-      queryConfig.prefixSortMaxStringPrefixLength()};
+      queryConfig.prefixSortMaxStringPrefixLength(),
+      queryConfig.prefixSortMinRadixSortRows()};
 }
 
 } // namespace
@@ -48,9 +50,7 @@ Window::Window(
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       numInputColumns_(windowNode->inputType()->size()),
-      windowNode_(windowNode),
-      currentPartition_(nullptr),
-      stringAllocator_(pool()) {
+      windowNode_(windowNode) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (spillConfig == nullptr &&
@@ -87,7 +87,9 @@ Window::Window(
           spillConfig,
           &nonReclaimableSection_,
           &stats_,
-          spillStats_.get());
+          spillStats_.get(),
+          driverCtx->queryConfig().windowSpillStreamingEnabled() &&
+              supportRowsStreaming());
     }
   }
 }
@@ -95,8 +97,26 @@ Window::Window(
 void Window::initialize() {
   Operator::initialize();
   VELOX_CHECK_NOT_NULL(windowNode_);
-  createWindowFunctions();
-  createPeerAndFrameBuffers();
+  // TODO: This computation needs to be revised. It only takes into account
+  // the input columns size. We need to also account for the output columns.
+  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
+
+  // The partitions of sorted input are complete and stay in memory while the
+  // next ones are evaluated, so that the workers can evaluate them in parallel.
+  uint32_t numEvaluators = 1;
+  if (!windowNode_->inputsSorted() &&
+      operatorCtx_->task()->queryCtx()->executor() != nullptr) {
+    numEvaluators = std::max<uint32_t>(
+        1,
+        operatorCtx_->driverCtx()
+            ->queryConfig()
+            .windowParallelEvaluationWorkers());
+  }
+  for (uint32_t i = 0; i < numEvaluators; ++i) {
+    evaluators_.push_back(std::make_unique<Evaluator>(pool()));
+    createWindowFunctions(*evaluators_.back());
+    createPeerAndFrameBuffers(*evaluators_.back());
+  }
   windowBuild_->setNumRowsPerOutput(numRowsPerOutput_);
   windowNode_.reset();
 }
@@ -201,10 +221,10 @@ Window::WindowFrame Window::createWindowFrame(
        std::move(endFrameArg)});
 }
 
-void Window::createWindowFunctions() {
+void Window::createWindowFunctions(Evaluator& evaluator) {
   VELOX_CHECK_NOT_NULL(windowNode_);
-  VELOX_CHECK(windowFunctions_.empty());
-  VELOX_CHECK(windowFrames_.empty());
+  VELOX_CHECK(evaluator.windowFunctions.empty());
+  VELOX_CHECK(evaluator.windowFrames.empty());
 
   const auto& inputType = windowNode_->sources()[0]->outputType();
   for (const auto& windowNodeFunction : windowNode_->windowFunctions()) {
@@ -221,17 +241,17 @@ void Window::createWindowFunctions() {
       }
     }
 
-    windowFunctions_.push_back(
+    evaluator.windowFunctions.push_back(
         WindowFunction::create(
             windowNodeFunction.functionCall->name(),
             functionArgs,
             windowNodeFunction.functionCall->type(),
             windowNodeFunction.ignoreNulls,
             operatorCtx_->pool(),
-            &stringAllocator_,
+            &evaluator.stringAllocator,
             operatorCtx_->driverCtx()->queryConfig()));
 
-    windowFrames_.push_back(
+    evaluator.windowFrames.push_back(
         createWindowFrame(windowNode_, windowNodeFunction.frame, inputType));
   }
 }
@@ -285,29 +305,25 @@ void Window::reclaim(
   windowBuild_->spill();
 }
 
-void Window::createPeerAndFrameBuffers() {
-  // TODO: This computation needs to be revised. It only takes into account
-  // the input columns size. We need to also account for the output columns.
-  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
-
-  peerStartBuffer_ = AlignedBuffer::allocate<vector_size_t>(
+void Window::createPeerAndFrameBuffers(Evaluator& evaluator) {
+  evaluator.peerStartBuffer = AlignedBuffer::allocate<vector_size_t>(
       numRowsPerOutput_, operatorCtx_->pool());
-  peerEndBuffer_ = AlignedBuffer::allocate<vector_size_t>(
+  evaluator.peerEndBuffer = AlignedBuffer::allocate<vector_size_t>(
       numRowsPerOutput_, operatorCtx_->pool());
 
-  const auto numFuncs = windowFunctions_.size();
-  frameStartBuffers_.reserve(numFuncs);
-  frameEndBuffers_.reserve(numFuncs);
-  validFrames_.reserve(numFuncs);
+  const auto numFuncs = evaluator.windowFunctions.size();
+  evaluator.frameStartBuffers.reserve(numFuncs);
+  evaluator.frameEndBuffers.reserve(numFuncs);
+  evaluator.validFrames.reserve(numFuncs);
 
   for (auto i = 0; i < numFuncs; i++) {
     BufferPtr frameStartBuffer = AlignedBuffer::allocate<vector_size_t>(
         numRowsPerOutput_, operatorCtx_->pool());
     BufferPtr frameEndBuffer = AlignedBuffer::allocate<vector_size_t>(
         numRowsPerOutput_, operatorCtx_->pool());
-    frameStartBuffers_.push_back(frameStartBuffer);
-    frameEndBuffers_.push_back(frameEndBuffer);
-    validFrames_.push_back(SelectivityVector(numRowsPerOutput_));
+    evaluator.frameStartBuffers.push_back(frameStartBuffer);
+    evaluator.frameEndBuffers.push_back(frameEndBuffer);
+    evaluator.validFrames.push_back(SelectivityVector(numRowsPerOutput_));
   }
 }
 
@@ -316,15 +332,16 @@ void Window::noMoreInput() {
   windowBuild_->noMoreInput();
 }
 
-void Window::callResetPartition() {
-  partitionOffset_ = 0;
-  peerStartRow_ = 0;
-  peerEndRow_ = 0;
-  currentPartition_ = nullptr;
-  if (windowBuild_->hasNextPartition()) {
-    currentPartition_ = windowBuild_->nextPartition();
-    for (int i = 0; i < windowFunctions_.size(); ++i) {
-      windowFunctions_[i]->resetPartition(currentPartition_.get());
+void Window::callResetPartition(
+    Evaluator& evaluator,
+    std::shared_ptr<WindowPartition> partition) {
+  evaluator.partitionOffset = 0;
+  evaluator.peerStartRow = 0;
+  evaluator.peerEndRow = 0;
+  evaluator.partition = std::move(partition);
+  if (evaluator.partition != nullptr) {
+    for (int i = 0; i < evaluator.windowFunctions.size(); ++i) {
+      evaluator.windowFunctions[i]->resetPartition(evaluator.partition.get());
     }
   }
 }
@@ -372,6 +389,7 @@ void updateKRowsOffsetsColumn(
 } // namespace
 
 void Window::updateKRowsFrameBounds(
+    Evaluator& evaluator,
     bool isKPreceding,
     const FrameChannelArg& frameArg,
     vector_size_t startRow,
@@ -417,8 +435,8 @@ void Window::updateKRowsFrameBounds(
     }
     std::iota(rawFrameBounds, rawFrameBounds + numRows, startValue);
   } else {
-    currentPartition_->extractColumn(
-        frameArg.index, partitionOffset_, numRows, 0, frameArg.value);
+    evaluator.partition->extractColumn(
+        frameArg.index, evaluator.partitionOffset, numRows, 0, frameArg.value);
     if (frameArg.value->typeKind() == TypeKind::INTEGER) {
       updateKRowsOffsetsColumn<int32_t>(
           isKPreceding, frameArg.value, startRow, numRows, rawFrameBounds);
@@ -430,6 +448,7 @@ void Window::updateKRowsFrameBounds(
 }
 
 void Window::updateFrameBounds(
+    Evaluator& evaluator,
     const WindowFrame& windowFrame,
     const bool isStartBound,
     const vector_size_t startRow,
@@ -450,7 +469,7 @@ void Window::updateFrameBounds(
       std::fill_n(rawFrameBounds, numRows, 0);
       break;
     case core::WindowNode::BoundType::kUnboundedFollowing:
-      std::fill_n(rawFrameBounds, numRows, currentPartition_->numRows() - 1);
+      std::fill_n(rawFrameBounds, numRows, evaluator.partition->numRows() - 1);
       break;
     case core::WindowNode::BoundType::kCurrentRow: {
       if (windowType == core::WindowNode::WindowType::kRange) {
@@ -466,9 +485,14 @@ void Window::updateFrameBounds(
     case core::WindowNode::BoundType::kPreceding: {
       if (windowType == core::WindowNode::WindowType::kRows) {
         updateKRowsFrameBounds(
-            true, frameArg.value(), startRow, numRows, rawFrameBounds);
+            evaluator,
+            true,
+            frameArg.value(),
+            startRow,
+            numRows,
+            rawFrameBounds);
       } else {
-        currentPartition_->computeKRangeFrameBounds(
+        evaluator.partition->computeKRangeFrameBounds(
             isStartBound,
             true,
             frameArg.value().index,
@@ -483,9 +507,14 @@ void Window::updateFrameBounds(
     case core::WindowNode::BoundType::kFollowing: {
       if (windowType == core::WindowNode::WindowType::kRows) {
         updateKRowsFrameBounds(
-            false, frameArg.value(), startRow, numRows, rawFrameBounds);
+            evaluator,
+            false,
+            frameArg.value(),
+            startRow,
+            numRows,
+            rawFrameBounds);
       } else {
-        currentPartition_->computeKRangeFrameBounds(
+        evaluator.partition->computeKRangeFrameBounds(
             isStartBound,
             false,
             frameArg.value().index,
@@ -537,41 +566,52 @@ void computeValidFrames(
 } // namespace
 
 void Window::computePeerAndFrameBuffers(
+    Evaluator& evaluator,
     vector_size_t startRow,
     vector_size_t endRow) {
   const vector_size_t numRows = endRow - startRow;
-  const vector_size_t numFuncs = windowFunctions_.size();
+  const vector_size_t numFuncs = evaluator.windowFunctions.size();
 
   // Size buffers for the call to WindowFunction::apply.
   const auto bufferSize = numRows * sizeof(vector_size_t);
-  peerStartBuffer_->setSize(bufferSize);
-  peerEndBuffer_->setSize(bufferSize);
-  auto* rawPeerStarts = peerStartBuffer_->asMutable<vector_size_t>();
-  auto* rawPeerEnds = peerEndBuffer_->asMutable<vector_size_t>();
+  evaluator.peerStartBuffer->setSize(bufferSize);
+  evaluator.peerEndBuffer->setSize(bufferSize);
+  auto* rawPeerStarts = evaluator.peerStartBuffer->asMutable<vector_size_t>();
+  auto* rawPeerEnds = evaluator.peerEndBuffer->asMutable<vector_size_t>();
 
   std::vector<vector_size_t*> rawFrameStarts;
   std::vector<vector_size_t*> rawFrameEnds;
   rawFrameStarts.reserve(numFuncs);
   rawFrameEnds.reserve(numFuncs);
   for (auto i = 0; i < numFuncs; ++i) {
-    frameStartBuffers_[i]->setSize(bufferSize);
-    frameEndBuffers_[i]->setSize(bufferSize);
+    evaluator.frameStartBuffers[i]->setSize(bufferSize);
+    evaluator.frameEndBuffers[i]->setSize(bufferSize);
 
-    auto* rawFrameStart = frameStartBuffers_[i]->asMutable<vector_size_t>();
-    auto* rawFrameEnd = frameEndBuffers_[i]->asMutable<vector_size_t>();
+    auto* rawFrameStart =
+        evaluator.frameStartBuffers[i]->asMutable<vector_size_t>();
+    auto* rawFrameEnd =
+        evaluator.frameEndBuffers[i]->asMutable<vector_size_t>();
     rawFrameStarts.push_back(rawFrameStart);
     rawFrameEnds.push_back(rawFrameEnd);
   }
 
-  std::tie(peerStartRow_, peerEndRow_) = currentPartition_->computePeerBuffers(
-      startRow, endRow, peerStartRow_, peerEndRow_, rawPeerStarts, rawPeerEnds);
+  std::tie(evaluator.peerStartRow, evaluator.peerEndRow) =
+      evaluator.partition->computePeerBuffers(
+          startRow,
+          endRow,
+          evaluator.peerStartRow,
+          evaluator.peerEndRow,
+          rawPeerStarts,
+          rawPeerEnds);
 
   for (auto i = 0; i < numFuncs; ++i) {
-    const auto& windowFrame = windowFrames_[i];
+    const auto& windowFrame = evaluator.windowFrames[i];
+    auto& validFrames = evaluator.validFrames[i];
     // Default all rows to have validFrames. The invalidity of frames is only
     // computed for k rows/range frames at a later point.
-    validFrames_[i].resizeFill(numRows, true);
+    validFrames.resizeFill(numRows, true);
     updateFrameBounds(
+        evaluator,
         windowFrame,
         true,
         startRow,
@@ -579,8 +619,9 @@ void Window::computePeerAndFrameBuffers(
         rawPeerStarts,
         rawPeerEnds,
         rawFrameStarts[i],
-        validFrames_[i]);
+        validFrames);
     updateFrameBounds(
+        evaluator,
         windowFrame,
         false,
         startRow,
@@ -588,8 +629,8 @@ void Window::computePeerAndFrameBuffers(
         rawPeerStarts,
         rawPeerEnds,
         rawFrameEnds[i],
-        validFrames_[i]);
-    if (windowFrames_[i].start || windowFrames_[i].end) {
+        validFrames);
+    if (windowFrame.start || windowFrame.end) {
       // k preceding and k following bounds can be problematic. They can go over
       // the partition limits or result in empty frames. Fix the frame
       // boundaries and compute the validFrames SelectivityVector for these
@@ -597,28 +638,34 @@ void Window::computePeerAndFrameBuffers(
       // do not care about frames. So the function decides further what to do
       // with empty frames.
       computeValidFrames(
-          currentPartition_->numRows() - 1,
+          evaluator.partition->numRows() - 1,
           numRows,
           rawFrameStarts[i],
           rawFrameEnds[i],
-          validFrames_[i]);
+          validFrames);
     }
   }
 }
 
 void Window::getInputColumns(
+    Evaluator& evaluator,
     vector_size_t startRow,
     vector_size_t endRow,
     vector_size_t resultOffset,
     const RowVectorPtr& result) {
   const auto numRows = endRow - startRow;
   for (int i = 0; i < numInputColumns_; ++i) {
-    currentPartition_->extractColumn(
-        i, partitionOffset_, numRows, resultOffset, result->childAt(i));
+    evaluator.partition->extractColumn(
+        i,
+        evaluator.partitionOffset,
+        numRows,
+        resultOffset,
+        result->childAt(i));
   }
 }
 
 void Window::callApplyForPartitionRows(
+    Evaluator& evaluator,
     vector_size_t startRow,
     vector_size_t endRow,
     vector_size_t resultOffset,
@@ -627,62 +674,65 @@ void Window::callApplyForPartitionRows(
   // processed rows (used for peer group comparison) will be deleted by
   // computePeerAndFrameBuffers after peer group comparison. Hence we need to
   // call getInputColumns after computePeerAndFrameBuffers.
-  computePeerAndFrameBuffers(startRow, endRow);
+  computePeerAndFrameBuffers(evaluator, startRow, endRow);
 
-  getInputColumns(startRow, endRow, resultOffset, result);
-  vector_size_t numFuncs = windowFunctions_.size();
+  getInputColumns(evaluator, startRow, endRow, resultOffset, result);
+  vector_size_t numFuncs = evaluator.windowFunctions.size();
   for (auto i = 0; i < numFuncs; ++i) {
-    windowFunctions_[i]->apply(
-        peerStartBuffer_,
-        peerEndBuffer_,
-        frameStartBuffers_[i],
-        frameEndBuffers_[i],
-        validFrames_[i],
+    evaluator.windowFunctions[i]->apply(
+        evaluator.peerStartBuffer,
+        evaluator.peerEndBuffer,
+        evaluator.frameStartBuffers[i],
+        evaluator.frameEndBuffers[i],
+        evaluator.validFrames[i],
         resultOffset,
         result->childAt(numInputColumns_ + i));
   }
 
   const vector_size_t numRows = endRow - startRow;
-  numProcessedRows_ += numRows;
-  partitionOffset_ += numRows;
+  evaluator.partitionOffset += numRows;
 
-  if (currentPartition_->partial()) {
-    currentPartition_->removeProcessedRows(numRows);
+  if (evaluator.partition->partial()) {
+    evaluator.partition->removeProcessedRows(numRows);
   }
 }
 
 vector_size_t Window::callApplyLoop(
+    Evaluator& evaluator,
     vector_size_t numOutputRows,
-    const RowVectorPtr& result) {
+    const RowVectorPtr& result,
+    const NextPartition& nextPartition) {
   // Compute outputs by traversing as many partitions as possible. This
   // logic takes care of partial partitions output also.
   vector_size_t resultIndex = 0;
   vector_size_t numOutputRowsLeft = numOutputRows;
 
-  // This function requires that the currentPartition_ is available for output.
-  VELOX_DCHECK_NOT_NULL(currentPartition_);
+  // This function requires that the evaluator's partition is available for
+  // output.
+  VELOX_DCHECK_NOT_NULL(evaluator.partition);
   while (numOutputRowsLeft > 0) {
     const auto numPartitionRows =
-        currentPartition_->numRowsForProcessing(partitionOffset_);
+        evaluator.partition->numRowsForProcessing(evaluator.partitionOffset);
     if (numPartitionRows <= numOutputRowsLeft) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
       callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + numPartitionRows,
+          evaluator,
+          evaluator.partitionOffset,
+          evaluator.partitionOffset + numPartitionRows,
           resultIndex,
           result);
       resultIndex += numPartitionRows;
       numOutputRowsLeft -= numPartitionRows;
 
-      if (!currentPartition_->complete()) {
+      if (!evaluator.partition->complete()) {
         // There are more data need to process for a partial partition.
-        VELOX_CHECK(currentPartition_->partial());
+        VELOX_CHECK(evaluator.partition->partial());
         break;
       }
 
-      callResetPartition();
-      if (currentPartition_ == nullptr) {
+      callResetPartition(evaluator, nextPartition());
+      if (evaluator.partition == nullptr) {
         // The WindowBuild doesn't have any more partitions to process right
         // now. So break until the next getOutput call.
         break;
@@ -692,8 +742,9 @@ vector_size_t Window::callApplyLoop(
       // Call apply for the rows that can fit in the buffer and break from
       // outputting.
       callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + numOutputRowsLeft,
+          evaluator,
+          evaluator.partitionOffset,
+          evaluator.partitionOffset + numOutputRowsLeft,
           resultIndex,
           result);
       numOutputRowsLeft = 0;
@@ -705,11 +756,162 @@ vector_size_t Window::callApplyLoop(
   return numOutputRows - numOutputRowsLeft;
 }
 
+std::shared_ptr<WindowPartition> Window::nextBuildPartition() {
+  if (nextPartition_ != nullptr) {
+    return std::move(nextPartition_);
+  }
+  if (windowBuild_->hasNextPartition()) {
+    return windowBuild_->nextPartition();
+  }
+  return nullptr;
+}
+
+bool Window::evaluatePartitionsInParallel() {
+  const auto numWorkers = evaluators_.size();
+  if (numWorkers <= 1) {
+    return false;
+  }
+
+  // Takes partitions until there is an output batch of rows per worker. A
+  // partition larger than an output batch is evaluated on the operator thread
+  // so that its output is produced a batch at a time.
+  const int64_t maxPartitionRows =
+      static_cast<int64_t>(numRowsPerOutput_) * numWorkers;
+  Partitions partitions;
+  int64_t numPartitionRows{0};
+  auto partition = nextBuildPartition();
+  while (partition != nullptr) {
+    if (partition->partial() || partition->numRows() > numRowsPerOutput_) {
+      nextPartition_ = std::move(partition);
+      break;
+    }
+    numPartitionRows += partition->numRows();
+    partitions.push_back(std::move(partition));
+    if (numPartitionRows >= maxPartitionRows ||
+        !windowBuild_->hasNextBufferedPartition()) {
+      break;
+    }
+    partition = windowBuild_->nextPartition();
+  }
+  if (partitions.empty()) {
+    return false;
+  }
+
+  // Divides the partitions into runs of consecutive partitions with about the
+  // same number of rows.
+  const auto numGroups = std::min(numWorkers, partitions.size());
+  const int64_t groupRows = bits::divRoundUp(numPartitionRows, numGroups);
+  std::vector<Partitions> groups(1);
+  int64_t numGroupRows{0};
+  for (auto& groupPartition : partitions) {
+    if (numGroupRows >= groupRows && groups.size() < numGroups) {
+      groups.emplace_back();
+      numGroupRows = 0;
+    }
+    numGroupRows += groupPartition->numRows();
+    groups.back().push_back(std::move(groupPartition));
+  }
+
+  // Passes the driver context to the workers so that they can be suspended
+  // for memory arbitration like the operator thread.
+  const DriverCtx* driverCtx = operatorCtx_->driverCtx();
+  using Batches = std::vector<RowVectorPtr>;
+  std::vector<std::shared_ptr<AsyncSource<Batches>>> pending;
+  pending.reserve(groups.size());
+  for (auto i = 0; i < groups.size(); ++i) {
+    pending.push_back(
+        std::make_shared<AsyncSource<Batches>>([this, i, &groups]() {
+          return std::make_unique<Batches>(
+              evaluatePartitions(*evaluators_[i], groups[i]));
+        }));
+    // The operator thread evaluates the first group.
+    if (i > 0) {
+      auto item = pending.back();
+      operatorCtx_->task()->queryCtx()->executor()->add([driverCtx, item]() {
+        ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+        item->prepare();
+      });
+    }
+  }
+
+  // Waits for all the groups before rethrowing an error since they reference
+  // 'groups' and the evaluators.
+  std::exception_ptr error;
+  std::vector<std::unique_ptr<Batches>> results(groups.size());
+  uint64_t cpuNanos{0};
+  for (auto i = 0; i < pending.size(); ++i) {
+    try {
+      results[i] = pending[i]->move();
+    } catch (const std::exception&) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+    cpuNanos += pending[i]->prepareTiming().cpuNanos;
+  }
+  addRuntimeStat(
+      kParallelPartitionsCpuTime,
+      RuntimeCounter(cpuNanos, RuntimeCounter::Unit::kNanos));
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  for (auto& batches : results) {
+    VELOX_CHECK_NOT_NULL(batches);
+    for (auto& batch : *batches) {
+      parallelOutput_.push_back(std::move(batch));
+    }
+  }
+  addRuntimeStat(kNumParallelPartitions, RuntimeCounter(partitions.size()));
+  return true;
+}
+
+std::vector<RowVectorPtr> Window::evaluatePartitions(
+    Evaluator& evaluator,
+    const Partitions& partitions) {
+  int64_t numRowsLeft{0};
+  for (const auto& partition : partitions) {
+    numRowsLeft += partition->numRows();
+  }
+  size_t nextPartition{0};
+  const NextPartition next = [&]() -> std::shared_ptr<WindowPartition> {
+    return nextPartition < partitions.size() ? partitions[nextPartition++]
+                                             : nullptr;
+  };
+
+  std::vector<RowVectorPtr> batches;
+  callResetPartition(evaluator, next());
+  while (evaluator.partition != nullptr) {
+    const vector_size_t numOutputRows =
+        std::min<int64_t>(numRowsPerOutput_, numRowsLeft);
+    auto batch = BaseVector::create<RowVector>(
+        outputType_, numOutputRows, operatorCtx_->pool());
+    const auto numResultRows =
+        callApplyLoop(evaluator, numOutputRows, batch, next);
+    VELOX_CHECK_EQ(numResultRows, numOutputRows);
+    numRowsLeft -= numResultRows;
+    batches.push_back(std::move(batch));
+  }
+  return batches;
+}
+
+RowVectorPtr Window::nextParallelOutput() {
+  VELOX_CHECK(!parallelOutput_.empty());
+  auto output = std::move(parallelOutput_.front());
+  parallelOutput_.pop_front();
+  numProcessedRows_ += output->size();
+  return output;
+}
+
 RowVectorPtr Window::getOutput() {
   if (numRows_ == 0) {
     return nullptr;
   }
 
+  if (!parallelOutput_.empty()) {
+    return nextParallelOutput();
+  }
+
   const auto numRowsLeft = numRows_ - numProcessedRows_;
   if (numRowsLeft == 0) {
     if (windowBuild_ != nullptr) {
@@ -718,25 +920,40 @@ RowVectorPtr Window::getOutput() {
     return nullptr;
   }
 
-  if (currentPartition_ == nullptr) {
-    callResetPartition();
-    if (currentPartition_ == nullptr) {
+  auto& evaluator = *evaluators_[0];
+  if (evaluator.partition == nullptr) {
+    if (evaluatePartitionsInParallel()) {
+      return nextParallelOutput();
+    }
+    callResetPartition(evaluator, nextBuildPartition());
+    if (evaluator.partition == nullptr) {
       // WindowBuild doesn't have a partition to output.
       return nullptr;
     }
   }
 
-  if (!currentPartition_->complete() &&
-      (currentPartition_->numRowsForProcessing(partitionOffset_) == 0)) {
-    return nullptr;
+  if (!evaluator.partition->complete() &&
+      (evaluator.partition->numRowsForProcessing(evaluator.partitionOffset) ==
+       0)) {
+    windowBuild_->loadPartialPartitionRows();
+    if (evaluator.partition->numRowsForProcessing(evaluator.partitionOffset) ==
+        0) {
+      return nullptr;
+    }
   }
 
   const auto numOutputRows = std::min(numRowsPerOutput_, numRowsLeft);
   auto result = BaseVector::create<RowVector>(
       outputType_, numOutputRows, operatorCtx_->pool());
 
-  // Compute the output values of window functions.
-  auto numResultRows = callApplyLoop(numOutputRows, result);
+  // Compute the output values of window functions. With parallel evaluation,
+  // stops at the end of the partition so that the next partitions are taken
+  // by evaluatePartitionsInParallel().
+  const bool parallel = evaluators_.size() > 1;
+  auto numResultRows = callApplyLoop(evaluator, numOutputRows, result, [&]() {
+    return parallel ? nullptr : nextBuildPartition();
+  });
+  numProcessedRows_ += numResultRows;
   return numResultRows < numOutputRows
       ? std::dynamic_pointer_cast<RowVector>(result->slice(0, numResultRows))
       : result;
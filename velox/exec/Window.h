@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/WindowBuild.h"
@@ -72,6 +74,17 @@ class Window : public Operator {
   static inline const std::string kWindowSpillReadNumBatches{
       "windowSpillReadNumBatches"};
 
+  /// Runtime statistics holding the number of window partitions evaluated in
+  /// parallel.
+  static inline const std::string kNumParallelPartitions{
+      "numParallelPartitions"};
+
+  /// Runtime statistics holding the CPU time of evaluating the window
+  /// partitions in parallel, summed over the threads. The getOutput timing
+  /// only includes the share of the operator thread.
+  static inline const std::string kParallelPartitionsCpuTime{
+      "parallelPartitionsCpuNanos"};
+
  private:
   // Used for k preceding/following frames. Index is the column index if k is a
   // column. value is used to read column values from the column index when k
@@ -93,13 +106,77 @@ class Window : public Operator {
     const std::optional<FrameChannelArg> end;
   };
 
+  // The state of the evaluation of the window functions over the rows of a
+  // partition. The operator thread uses 'evaluators_[0]'. The parallel
+  // evaluation of complete partitions uses one evaluator per worker.
+  struct Evaluator {
+    explicit Evaluator(memory::MemoryPool* pool) : stringAllocator(pool) {}
+
+    // HashStringAllocator required by functions that allocate out of line
+    // buffers.
+    HashStringAllocator stringAllocator;
+
+    // WindowFunction is the base API implemented by all the window functions.
+    // The functions are ordered by their positions in the output columns.
+    std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions;
+
+    // WindowFrames corresponding to each windowFunction above. It represents
+    // the frame spec for the function computation.
+    std::vector<WindowFrame> windowFrames;
+
+    // The following 4 Buffers are used to pass peer and frame start and end
+    // values to the WindowFunction::apply method. These buffers can be
+    // allocated once and reused across all the getOutput calls.
+    // Only a single peer start and peer end buffer is needed across all
+    // functions (as the peer values are based on the ORDER BY clause).
+    BufferPtr peerStartBuffer;
+    BufferPtr peerEndBuffer;
+    // A separate BufferPtr is required for the frame indexes of each function.
+    // Each function has its own frame clause and style. So we have as many
+    // buffers as the number of functions.
+    std::vector<BufferPtr> frameStartBuffers;
+    std::vector<BufferPtr> frameEndBuffers;
+
+    // Frame types for kPreceding or kFollowing could result in empty frames if
+    // the frameStart > frameEnds, or frameEnds < firstPartitionRow or
+    // frameStarts > lastPartitionRow. Such frames usually evaluate to NULL in
+    // the window function.
+    // This SelectivityVector captures the valid (non-empty) frames in the
+    // buffer being worked on. The window function can use this to compute
+    // output values. There is one SelectivityVector per window function.
+    std::vector<SelectivityVector> validFrames;
+
+    // Used to access window partition rows and columns by the window
+    // operator and functions. This structure is owned by the WindowBuild.
+    std::shared_ptr<WindowPartition> partition;
+
+    // Tracks how far along the partition rows have been output.
+    vector_size_t partitionOffset = 0;
+
+    // When traversing input partition rows, the peers are the rows with the
+    // same values for the ORDER BY clause. These rows are equal in some ways
+    // and affect the results of ranking functions. Since all rows between the
+    // peerStartRow and peerEndRow have the same values for peerStartRow and
+    // peerEndRow, we needn't compute them for each row independently. Since
+    // these rows might cross getOutput boundaries and be called in subsequent
+    // calls to computePeerBuffers they are saved here.
+    vector_size_t peerStartRow = 0;
+    vector_size_t peerEndRow = 0;
+  };
+
+  using Partitions = std::vector<std::shared_ptr<WindowPartition>>;
+
+  // Returns the next partition to evaluate or nullptr if the WindowBuild
+  // doesn't have one.
+  using NextPartition = std::function<std::shared_ptr<WindowPartition>()>;
+
   // Returns if a window operator support rows-wise streaming processing or not.
   // Currently we supports 'rank', 'dense_rank' and 'row_number' functions with
   // any frame type. Also supports the agg window function with default frame.
   bool supportRowsStreaming();
 
-  // Creates WindowFunction and frame objects for this operator.
-  void createWindowFunctions();
+  // Creates WindowFunction and frame objects of 'evaluator'.
+  void createWindowFunctions(Evaluator& evaluator);
 
   // Converts WindowNode::Frame to Window::WindowFrame.
   WindowFrame createWindowFrame(
@@ -109,14 +186,19 @@ class Window : public Operator {
 
   // Creates the buffers for peer and frame row
   // indices to send in window function apply invocations.
-  void createPeerAndFrameBuffers();
+  void createPeerAndFrameBuffers(Evaluator& evaluator);
 
   // Compute the peer and frame buffers for rows between
   // startRow and endRow in the current partition.
-  void computePeerAndFrameBuffers(vector_size_t startRow, vector_size_t endRow);
+  void computePeerAndFrameBuffers(
+      Evaluator& evaluator,
+      vector_size_t startRow,
+      vector_size_t endRow);
 
-  // Updates all the state for the next partition.
-  void callResetPartition();
+  // Updates all the state of 'evaluator' for 'partition'.
+  void callResetPartition(
+      Evaluator& evaluator,
+      std::shared_ptr<WindowPartition> partition);
 
   // Computes the result vector for a subset of the current
   // partition rows starting from startRow to endRow. A single partition
@@ -125,6 +207,7 @@ class Window : public Operator {
   // offset in the result vector corresponding to the current range of
   // partition rows.
   void callApplyForPartitionRows(
+      Evaluator& evaluator,
       vector_size_t startRow,
       vector_size_t endRow,
       vector_size_t resultOffset,
@@ -133,6 +216,7 @@ class Window : public Operator {
   // Gets the input columns of the current window partition
   // between startRow and endRow in result at resultOffset.
   void getInputColumns(
+      Evaluator& evaluator,
       vector_size_t startRow,
       vector_size_t endRow,
       vector_size_t resultOffset,
@@ -140,14 +224,18 @@ class Window : public Operator {
 
   // Computes the result vector for a single output block. The result
   // consists of all the input columns followed by the results of the
-  // window function.
+  // window function. Continues with the partitions from 'nextPartition' when
+  // the current partition is complete.
   // @return The number of rows processed in the loop.
   vector_size_t callApplyLoop(
+      Evaluator& evaluator,
       vector_size_t numOutputRows,
-      const RowVectorPtr& result);
+      const RowVectorPtr& result,
+      const NextPartition& nextPartition);
 
   // Update frame bounds for kPreceding, kFollowing row frames.
   void updateKRowsFrameBounds(
+      Evaluator& evaluator,
       bool isKPreceding,
       const FrameChannelArg& frameArg,
       vector_size_t startRow,
@@ -158,6 +246,7 @@ class Window : public Operator {
   // Unselect rows from validFrames where the frame bounds are NaN that are
   // invalid.
   void updateFrameBounds(
+      Evaluator& evaluator,
       const WindowFrame& windowFrame,
       const bool isStartBound,
       const vector_size_t startRow,
@@ -167,6 +256,25 @@ class Window : public Operator {
       vector_size_t* rawFrameBounds,
       SelectivityVector& validFrames);
 
+  // Returns 'nextPartition_' if set, otherwise the next partition of
+  // 'windowBuild_' or nullptr if there is none.
+  std::shared_ptr<WindowPartition> nextBuildPartition();
+
+  // Takes consecutive complete partitions of at most an output batch of rows
+  // from 'windowBuild_', divides them among the workers and appends their
+  // output to 'parallelOutput_' in partition order. Returns false if the next
+  // partition is to be evaluated on the operator thread.
+  bool evaluatePartitionsInParallel();
+
+  // Evaluates the window functions over 'partitions' with 'evaluator'.
+  // Returns the output in batches of at most 'numRowsPerOutput_' rows.
+  std::vector<RowVectorPtr> evaluatePartitions(
+      Evaluator& evaluator,
+      const Partitions& partitions);
+
+  // Returns the first batch of 'parallelOutput_'.
+  RowVectorPtr nextParallelOutput();
+
   const vector_size_t numInputColumns_;
 
   // WindowBuild is used to store input rows and return WindowPartitions
@@ -177,44 +285,16 @@ class Window : public Operator {
   // reset after the initialization.
   std::shared_ptr<const core::WindowNode> windowNode_;
 
-  // Used to access window partition rows and columns by the window
-  // operator and functions. This structure is owned by the WindowBuild.
-  std::shared_ptr<WindowPartition> currentPartition_;
-
-  // HashStringAllocator required by functions that allocate out of line
-  // buffers.
-  HashStringAllocator stringAllocator_;
-
-  // Vector of WindowFunction objects required by this operator.
-  // WindowFunction is the base API implemented by all the window functions.
-  // The functions are ordered by their positions in the output columns.
-  std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions_;
-
-  // Vector of WindowFrames corresponding to each windowFunction above.
-  // It represents the frame spec for the function computation.
-  std::vector<WindowFrame> windowFrames_;
-
-  // The following 4 Buffers are used to pass peer and frame start and end
-  // values to the WindowFunction::apply method. These buffers can be allocated
-  // once and reused across all the getOutput calls.
-  // Only a single peer start and peer end buffer is needed across all
-  // functions (as the peer values are based on the ORDER BY clause).
-  BufferPtr peerStartBuffer_;
-  BufferPtr peerEndBuffer_;
-  // A separate BufferPtr is required for the frame indexes of each function.
-  // Each function has its own frame clause and style. So we have as many
-  // buffers as the number of functions.
-  std::vector<BufferPtr> frameStartBuffers_;
-  std::vector<BufferPtr> frameEndBuffers_;
-
-  // Frame types for kPreceding or kFollowing could result in empty frames if
-  // the frameStart > frameEnds, or frameEnds < firstPartitionRow or frameStarts
-  // > lastPartitionRow. Such frames usually evaluate to NULL in the window
-  // function.
-  // This SelectivityVector captures the valid (non-empty) frames in the buffer
-  // being worked on. The window function can use this to compute output values.
-  // There is one SelectivityVector per window function.
-  std::vector<SelectivityVector> validFrames_;
+  // The evaluator of the operator thread followed by the evaluators of the
+  // parallel workers, if any.
+  std::vector<std::unique_ptr<Evaluator>> evaluators_;
+
+  // A partition taken from 'windowBuild_' that did not qualify for parallel
+  // evaluation. It is evaluated next on the operator thread.
+  std::shared_ptr<WindowPartition> nextPartition_;
+
+  // The output of the partitions evaluated in parallel, in partition order.
+  std::deque<RowVectorPtr> parallelOutput_;
 
   // Number of input rows.
   vector_size_t numRows_ = 0;
@@ -227,19 +307,6 @@ class Window : public Operator {
   // value is updated as the WindowFunction::apply() function is
   // called on the partition blocks.
   vector_size_t numProcessedRows_ = 0;
-
-  // Tracks how far along the partition rows have been output.
-  vector_size_t partitionOffset_ = 0;
-
-  // When traversing input partition rows, the peers are the rows with the same
-  // values for the ORDER BY clause. These rows are equal in some ways and
-  // affect the results of ranking functions. Since all rows between the
-  // peerStartRow_ and peerEndRow_ have the same values for peerStartRow_ and
-  // peerEndRow_, we needn't compute them for each row independently. Since
-  // these rows might cross getOutput boundaries and be called in subsequent
-  // calls to computePeerBuffers they are saved here.
-  vector_size_t peerStartRow_ = 0;
-  vector_size_t peerEndRow_ = 0;
 };
 
 } // namespace facebook::velox::exec
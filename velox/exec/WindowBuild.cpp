@@ -115,6 +115,17 @@ WindowBuild::WindowBuild(
   }
 }
 
+// static
+bool WindowBuild::hasRangeFrame(
+    const std::shared_ptr<const core::WindowNode>& windowNode) {
+  for (const auto& function : windowNode->windowFunctions()) {
+    if (function.frame.type == core::WindowNode::WindowType::kRange) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool WindowBuild::compareRowsWithKeys(
     const char* lhs,
     const char* rhs,
@@ -68,6 +68,20 @@ class WindowBuild {
   /// called when no partition is available.
   virtual std::shared_ptr<WindowPartition> nextPartition() = 0;
 
+  /// Returns true if nextPartition() can return a complete partition without
+  /// releasing the rows of the partitions it returned before. Unlike
+  /// hasNextPartition(), does not load or switch to more rows. The Window
+  /// operator evaluates such partitions in parallel.
+  virtual bool hasNextBufferedPartition() {
+    return false;
+  }
+
+  /// The Window operator invokes this function when the partial partition
+  /// returned by nextPartition() is not complete and has no rows left to
+  /// process. Builds that add the rows of partial partitions in addInput() do
+  /// nothing.
+  virtual void loadPartialPartitionRows() {}
+
   /// Returns the average size of input rows in bytes stored in the data
   /// container of the WindowBuild.
   virtual std::optional<int64_t> estimateRowSize() {
@@ -87,6 +101,10 @@ class WindowBuild {
   }
 
  protected:
+  // Returns true if 'windowNode' has a function with a range frame.
+  static bool hasRangeFrame(
+      const std::shared_ptr<const core::WindowNode>& windowNode);
+
   bool compareRowsWithKeys(
       const char* lhs,
       const char* rhs,
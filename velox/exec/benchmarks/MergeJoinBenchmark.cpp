@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include "velox/common/memory/Memory.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace facebook::velox::exec {
+namespace {
+
+struct BenchmarkParams {
+  // Number of rows on the left side.
+  int32_t numLeftRows;
+  // Every 'leftStep'-th key on the left side has a match. The keys in between
+  // are skipped by the join.
+  int32_t leftStep;
+  // Number of drivers. If greater than 1, both inputs are repartitioned on the
+  // join key and each driver merges one partition.
+  int32_t numDrivers;
+};
+
+// Benchmark for merge join of two inputs sorted on a single BIGINT key. The
+// right side has a key for every 'leftStep'-th key of the left side, so that
+// the join mostly skips over left rows without a match.
+class MergeJoinBenchmark : public VectorTestBase {
+ public:
+  void makeBenchmark(const BenchmarkParams& params) {
+    constexpr int32_t kBatchSize = 10'000;
+    auto testCase = std::make_unique<TestCase>();
+    for (auto start = 0; start < params.numLeftRows; start += kBatchSize) {
+      testCase->left.push_back(makeRowVector(
+          {"t0", "t1"},
+          {
+              makeFlatVector<int64_t>(
+                  kBatchSize, [&](auto row) { return start + row; }),
+              makeFlatVector<int64_t>(kBatchSize, [](auto row) { return row; }),
+          }));
+    }
+    const auto numRightRows = params.numLeftRows / params.leftStep;
+    for (auto start = 0; start < numRightRows; start += kBatchSize) {
+      const auto size = std::min(kBatchSize, numRightRows - start);
+      testCase->right.push_back(makeRowVector(
+          {"u0", "u1"},
+          {
+              makeFlatVector<int64_t>(
+                  size,
+                  [&](auto row) { return (start + row) * params.leftStep; }),
+              makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          }));
+    }
+
+    const bool partitioned = params.numDrivers > 1;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto leftPlan = PlanBuilder(planNodeIdGenerator).values(testCase->left);
+    auto rightPlan = PlanBuilder(planNodeIdGenerator).values(testCase->right);
+    if (partitioned) {
+      leftPlan.localPartition({"t0"});
+      rightPlan.localPartition({"u0"});
+    }
+    testCase->plan = leftPlan
+                         .mergeJoin(
+                             {"t0"},
+                             {"u0"},
+                             rightPlan.planNode(),
+                             "",
+                             {"t0", "t1", "u1"},
+                             core::JoinType::kInner)
+                         .planNode();
+
+    const auto name = fmt::format(
+        "{}_rows_1_in_{}_match_{}_drivers",
+        params.numLeftRows,
+        params.leftStep,
+        params.numDrivers);
+    folly::addBenchmark(
+        __FILE__,
+        name,
+        [plan = &testCase->plan, numDrivers = params.numDrivers]() {
+          exec::test::AssertQueryBuilder(*plan)
+              .maxDrivers(numDrivers)
+              .countResults();
+          return 1;
+        });
+
+    cases_.push_back(std::move(testCase));
+  }
+
+ private:
+  struct TestCase {
+    std::vector<RowVectorPtr> left;
+    std::vector<RowVectorPtr> right;
+    core::PlanNodePtr plan;
+  };
+
+  std::vector<std::unique_ptr<TestCase>> cases_;
+};
+
+} // namespace
+} // namespace facebook::velox::exec
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  memory::initializeMemoryManager(memory::MemoryManager::Options{});
+
+  MergeJoinBenchmark bm;
+  for (auto leftStep : {1, 10, 1'000}) {
+    for (auto numDrivers : {1, 4}) {
+      bm.makeBenchmark(
+          {.numLeftRows = 1'000'000,
+           .leftStep = leftStep,
+           .numDrivers = numDrivers});
+    }
+    BENCHMARK_DRAW_LINE();
+  }
+
+  folly::runBenchmarks();
+
+  return 0;
+}
@@ -101,8 +101,16 @@ class TestCase {
 };
 
 // You could config threshold, e.i. 0, to test prefix-sort for small
-// dateset.
-static const common::PrefixSortConfig kDefaultSortConfig(1024, 100, 50);
+// dateset. Radix sort is disabled to benchmark the quick sort path.
+static const common::PrefixSortConfig kDefaultSortConfig(
+    1024,
+    100,
+    50,
+    std::numeric_limits<uint32_t>::max());
+
+// Same as above but sorts the normalized keys with radix sort whenever they
+// are short enough. The keys that do not qualify use quick sort.
+static const common::PrefixSortConfig kRadixSortConfig(1024, 100, 50, 0);
 
 // For small dataset, in some test environments, if std-sort is defined in the
 // benchmark file, the test results may be strangely regressed. When the
@@ -126,6 +134,16 @@ class PrefixSortBenchmark {
         rowContainer, compareFlags, kDefaultSortConfig, pool_, sortedRows);
   }
 
+  void runRadixSort(
+      const std::vector<char*>& rows,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags) {
+    auto sortedRows = std::vector<char*, memory::StlAllocator<char*>>(
+        rows.begin(), rows.end(), *pool_);
+    PrefixSort::sort(
+        rowContainer, compareFlags, kRadixSortConfig, pool_, sortedRows);
+  }
+
   void runStdSort(
       const std::vector<char*>& rows,
       RowContainer* rowContainer,
@@ -145,7 +163,8 @@ class PrefixSortBenchmark {
       int numKeys) {
     auto testCase =
         std::make_unique<TestCase>(pool_, testName, numRows, rowType, numKeys);
-    // Add benchmarks for std-sort and prefix-sort.
+    // Add benchmarks for std-sort, prefix-sort and prefix-sort with radix
+    // sort.
     {
       folly::addBenchmark(
           __FILE__,
@@ -173,6 +192,19 @@ class PrefixSortBenchmark {
             }
             return rows.size() * iterations;
           });
+      folly::addBenchmark(
+          __FILE__,
+          "%RadixSort",
+          [rows = testCase->rows(),
+           container = testCase->rowContainer(),
+           sortFlags = testCase->compareFlags(),
+           iterations = iterations,
+           this]() {
+            for (auto i = 0; i < iterations; ++i) {
+              runRadixSort(rows, container, sortFlags);
+            }
+            return rows.size() * iterations;
+          });
     }
     testCases_.push_back(std::move(testCase));
   }
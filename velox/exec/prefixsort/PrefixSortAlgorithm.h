@@ -15,9 +15,11 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
@@ -143,6 +145,66 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts the entries in [start, end) by their first 'keySize' bytes using a
+  /// least significant digit radix sort. The key is compared as a sequence of
+  /// 8 byte words, each as a native uint64_t, which is how PrefixSort compares
+  /// the normalized keys. Makes one pass over the entries per key byte and
+  /// skips the bytes that are the same in all entries, e.g. padding and the
+  /// null bytes of columns without nulls. The sort is stable.
+  ///
+  /// Assumes a little-endian system like the normalized key encoding does.
+  /// @param keySize A multiple of 8 that is not larger than entrySize.
+  /// @param tmpBuffer The buffer must be at least 'end - start' bytes long.
+  void radixSort(char* start, char* end, uint32_t keySize, char* tmpBuffer)
+      const {
+    VELOX_CHECK(end >= start, "Invalid sort range.");
+    VELOX_CHECK_EQ(keySize % sizeof(uint64_t), 0);
+    VELOX_CHECK_LE(keySize, entrySize_);
+    VELOX_CHECK_NOT_NULL(tmpBuffer);
+    const uint64_t numEntries = (end - start) / entrySize_;
+    if (numEntries < 2) {
+      return;
+    }
+
+    // Builds the histograms of all key bytes in a single pass.
+    std::vector<uint64_t> counts(keySize * kRadixSize, 0);
+    for (auto* entry = start; entry < end; entry += entrySize_) {
+      for (uint32_t i = 0; i < keySize; ++i) {
+        ++counts[i * kRadixSize + static_cast<uint8_t>(entry[i])];
+      }
+    }
+
+    char* source = start;
+    char* target = tmpBuffer;
+    std::array<uint64_t, kRadixSize> offsets;
+    // The last word is the least significant one. Within a word, the first
+    // byte is the least significant one on little-endian.
+    for (int32_t word = keySize / sizeof(uint64_t) - 1; word >= 0; --word) {
+      for (uint32_t i = 0; i < sizeof(uint64_t); ++i) {
+        const uint32_t byte = word * sizeof(uint64_t) + i;
+        const auto* byteCounts = counts.data() + byte * kRadixSize;
+        if (byteCounts[static_cast<uint8_t>(source[byte])] == numEntries) {
+          continue;
+        }
+        uint64_t offset = 0;
+        for (auto digit = 0; digit < kRadixSize; ++digit) {
+          offsets[digit] = offset;
+          offset += byteCounts[digit];
+        }
+        const char* sourceEnd = source + numEntries * entrySize_;
+        for (auto* entry = source; entry < sourceEnd; entry += entrySize_) {
+          auto& digitOffset = offsets[static_cast<uint8_t>(entry[byte])];
+          simd::memcpy(target + digitOffset * entrySize_, entry, entrySize_);
+          ++digitOffset;
+        }
+        std::swap(source, target);
+      }
+    }
+    if (source != start) {
+      simd::memcpy(start, source, numEntries * entrySize_);
+    }
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -331,6 +393,9 @@ class PrefixSortRunner {
     }
   }
 
+  // Number of buckets per radix sort pass, one per byte value.
+  static constexpr int32_t kRadixSize = 256;
+
   const uint64_t entrySize_;
   char* const swapBuffer_;
 };
@@ -70,6 +70,42 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  // Each entry has a 16 byte key compared as two uint64_t words, followed by
+  // its index in the input.
+  constexpr uint32_t kKeySize = 16;
+  constexpr uint32_t kEntrySize = kKeySize + sizeof(uint64_t);
+  for (const auto size : {0, 1, 2, 100, 10'000}) {
+    SCOPED_TRACE(fmt::format("size: {}", size));
+    std::vector<std::array<uint64_t, 3>> data(size);
+    for (auto i = 0; i < size; ++i) {
+      // Use few distinct values in the first word to test the ties and the
+      // skipped passes.
+      data[i] = {
+          folly::Random::rand64(4),
+          folly::Random::rand64(),
+          static_cast<uint64_t>(i)};
+    }
+    auto expected = data;
+    std::stable_sort(
+        expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+          return std::tie(a[0], a[1]) < std::tie(b[0], b[1]);
+        });
+
+    auto swapBuffer = AlignedBuffer::allocate<char>(kEntrySize, pool());
+    auto tmpBuffer =
+        AlignedBuffer::allocate<char>(std::max(size, 1) * kEntrySize, pool());
+    PrefixSortRunner sortRunner(kEntrySize, swapBuffer->asMutable<char>());
+    char* start = reinterpret_cast<char*>(data.data());
+    sortRunner.radixSort(
+        start,
+        start + size * kEntrySize,
+        kKeySize,
+        tmpBuffer->asMutable<char>());
+    ASSERT_EQ(data, expected);
+  }
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
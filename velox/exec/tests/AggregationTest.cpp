@@ -835,6 +835,259 @@ TEST_F(AggregationTest, rangeToDistinct) {
       " GROUP BY c0, c1, c2, c3, c4, c5");
 }
 
+TEST_F(AggregationTest, blockedUpdate) {
+  // Enough groups and aggregates for the accumulators to be updated in blocks
+  // of input rows. One aggregate has a mask and one is distinct.
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 5; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            10'000, [&](auto row) { return (i * 7'919 + row) % 40'000; }),
+        makeFlatVector<int64_t>(10'000, [&](auto row) { return row + i; }),
+        makeFlatVector<double>(
+            10'000, [](auto row) { return row * 0.5; }, nullEvery(11)),
+        makeFlatVector<int32_t>(10'000, [](auto row) { return row % 17; }),
+        makeFlatVector<bool>(10'000, [](auto row) { return row % 3 == 0; }),
+    }));
+  }
+  createDuckDbTable(batches);
+
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .singleAggregation(
+                      {"c0"},
+                      {"sum(c1)",
+                       "count(c2)",
+                       "min(c1)",
+                       "max(c2)",
+                       "sum(c3)",
+                       "max(c3)",
+                       "sum(c1)",
+                       "count(distinct c3)"},
+                      {"", "", "", "", "", "", "c4", ""})
+                  .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT c0, sum(c1), count(c2), min(c1), max(c2), sum(c3), max(c3), "
+      "sum(c1) FILTER (WHERE c4), count(distinct c3) FROM tmp GROUP BY c0");
+}
+
+TEST_F(AggregationTest, partitionedHashTable) {
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 10; ++i) {
+    inputs.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [&](auto row) { return i * 500 + row; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [](auto row) { return fmt::format("string {}", row % 13); },
+            nullEvery(11)),
+    }));
+  }
+  createDuckDbTable(inputs);
+
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation(
+                      {"c0"},
+                      {"sum(c1)", "count(c2)", "max(c2)", "array_agg(c1)"})
+                  .project({"c0", "a0", "a1", "a2", "cardinality(a3)"})
+                  .planNode();
+
+  for (int numPartitionBits : {1, 3, 8}) {
+    SCOPED_TRACE(fmt::format("numPartitionBits: {}", numPartitionBits));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(QueryConfig::kAggregationPartitionThresholdBytes, 1)
+            .config(
+                QueryConfig::kAggregationPartitionBits,
+                std::to_string(numPartitionBits))
+            .assertResults(
+                "SELECT c0, sum(c1), count(c2), max(c2), count(*) "
+                "FROM tmp GROUP BY c0");
+    auto stats = task->taskStats().pipelineStats[0].operatorStats[1];
+    ASSERT_EQ(
+        stats.runtimeStats[GroupingSet::kNumPartitions].max,
+        1 << numPartitionBits);
+    ASSERT_EQ(stats.runtimeStats[BaseHashTable::kNumDistinct].max, 5'500);
+  }
+
+  // Partitioning is disabled with spilling.
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->getPath())
+                  .config(QueryConfig::kSpillEnabled, true)
+                  .config(QueryConfig::kAggregationSpillEnabled, true)
+                  .config(QueryConfig::kAggregationPartitionThresholdBytes, 1)
+                  .assertResults(
+                      "SELECT c0, sum(c1), count(c2), max(c2), count(*) "
+                      "FROM tmp GROUP BY c0");
+  ASSERT_EQ(
+      task->taskStats().pipelineStats[0].operatorStats[1].runtimeStats.count(
+          GroupingSet::kNumPartitions),
+      0);
+}
+
+TEST_F(AggregationTest, partialAggregationKeyRuns) {
+  // Batches clustered on the keys come in runs of 20 equal keys. The last
+  // batch has no runs and probes the hash table for every row.
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 5; ++i) {
+    inputs.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) / 20; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [](auto row) { return fmt::format("key {}", row / 100); },
+            [](auto row) { return row / 100 == 3; }),
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  inputs.push_back(makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 37; }),
+      makeFlatVector<std::string>(
+          1'000, [](auto row) { return fmt::format("key {}", row % 3); }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+  }));
+  createDuckDbTable(inputs);
+
+  core::PlanNodeId partialNodeId;
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .partialAggregation(
+                      {"c0", "c1"}, {"sum(c2)", "count(c2)", "max(c2)"})
+                  .capturePlanNodeId(partialNodeId)
+                  .finalAggregation()
+                  .planNode();
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .assertResults(
+                      "SELECT c0, c1, sum(c2), count(c2), max(c2) "
+                      "FROM tmp GROUP BY c0, c1");
+  const auto stats = toPlanStats(task->taskStats()).at(partialNodeId);
+  // All but the first row of each run reuse the group of the previous row.
+  ASSERT_EQ(
+      stats.customStats.at(GroupingSet::kKeyRunRows).sum, 5 * (1'000 - 50));
+}
+
+TEST_F(AggregationTest, dictionaryKeys) {
+  // The grouping key is a dictionary over 10 strings with null rows at the
+  // dictionary level. The hash table is probed once per distinct index and
+  // once for the nulls. The last batch has more distinct values than the
+  // threshold and probes the hash table for every row.
+  auto base = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("key {}", row); });
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 4; ++i) {
+    inputs.push_back(makeRowVector({
+        BaseVector::wrapInDictionary(
+            makeNulls(1'000, [](auto row) { return row % 17 == 0; }),
+            makeIndices(1'000, [&](auto row) { return (row * 7 + i) % 10; }),
+            1'000,
+            base),
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  auto largeBase = makeFlatVector<std::string>(
+      500, [](auto row) { return fmt::format("key {}", row); });
+  inputs.push_back(makeRowVector({
+      wrapInDictionary(
+          makeIndices(1'000, [](auto row) { return row % 500; }),
+          1'000,
+          largeBase),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+  }));
+  createDuckDbTable(inputs);
+
+  core::PlanNodeId aggregationNodeId;
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation({"c0"}, {"sum(c1)", "count(c1)"})
+                  .capturePlanNodeId(aggregationNodeId)
+                  .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .assertResults("SELECT c0, sum(c1), count(c1) FROM tmp GROUP BY c0");
+  const auto stats = toPlanStats(task->taskStats()).at(aggregationNodeId);
+  ASSERT_EQ(
+      stats.customStats.at(GroupingSet::kDictionaryKeyRows).sum,
+      4 * (1'000 - 11));
+}
+
+TEST_F(AggregationTest, partialAggregationEvictColdGroups) {
+  // Every batch updates the same 50 hot keys and adds 500 keys seen once.
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 20; ++i) {
+    inputs.push_back(makeRowVector({
+        makeFlatVector<std::string>(
+            1'000,
+            [&](auto row) {
+              return row % 2 == 0
+                  ? fmt::format("hot key {}", row % 50)
+                  : fmt::format("cold key {}", i * 1'000 + row);
+            }),
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(inputs);
+
+  core::PlanNodeId partialNodeId;
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .partialAggregation(
+                      {"c0"}, {"sum(c1)", "count(c1)", "array_agg(c1)"})
+                  .capturePlanNodeId(partialNodeId)
+                  .finalAggregation()
+                  .project({"c0", "a0", "a1", "array_sort(a2)"})
+                  .planNode();
+
+  for (const auto maxPartialMemory : {1, 1 << 16}) {
+    SCOPED_TRACE(fmt::format("maxPartialMemory: {}", maxPartialMemory));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(QueryConfig::kMaxPartialAggregationMemory, maxPartialMemory)
+            .config(QueryConfig::kPartialAggregationEvictColdGroups, true)
+            .assertResults(
+                "SELECT c0, sum(c1), count(c1), array_sort(array_agg(c1)) "
+                "FROM tmp GROUP BY c0");
+    const auto stats = toPlanStats(task->taskStats()).at(partialNodeId);
+    ASSERT_GT(stats.customStats.at(GroupingSet::kEvictedColdGroups).sum, 0);
+    ASSERT_GT(stats.customStats.at("flushTimes").sum, 0);
+  }
+}
+
+TEST_F(AggregationTest, recycleOutputVectors) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 7; }),
+  });
+  createDuckDbTable({data});
+
+  // The project releases each aggregation output batch before the next one is
+  // produced.
+  core::PlanNodeId aggregationId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .singleAggregation({"c0"}, {"sum(c1)"})
+                  .capturePlanNodeId(aggregationId)
+                  .project({"c0 + 1", "a0 * 2"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(QueryConfig::kPreferredOutputBatchRows, 100)
+          .assertResults("SELECT c0 + 1, sum(c1) * 2 FROM tmp GROUP BY c0");
+  const auto stats = toPlanStats(task->taskStats()).at(aggregationId);
+  const auto numReuses =
+      stats.customStats.at(Operator::kOutputVectorReuses).sum;
+  ASSERT_GT(numReuses, 0);
+  // The last attempt to produce output finds no more groups.
+  ASSERT_GE(
+      numReuses + stats.customStats.at(Operator::kOutputVectorAllocations).sum,
+      stats.outputVectors);
+}
+
 TEST_F(AggregationTest, allKeyTypes) {
   // Covers different key types. Unlike the integer/string tests, the
   // hash table begins life in the generic mode, not array or
@@ -1405,6 +1658,68 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsAggregation) {
+  vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "k3", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 3; }, nullEvery(7)),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  core::PlanNodePtr aggregationNode;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .groupingSetsAggregation(
+                      {"k1", "k2", "k3"},
+                      {{"k1", "k2", "k3"},
+                       {"k1", "k2"},
+                       {"k1", "k3"},
+                       {"k2", "k3"},
+                       {"k1"},
+                       {"k2"},
+                       {"k3"},
+                       {}},
+                      {"count(1) as count_1",
+                       "sum(a) as sum_a",
+                       "max(b) as max_b",
+                       "avg(a) as avg_a"})
+                  .capturePlanNode(aggregationNode)
+                  .project(
+                      {"k1", "k2", "k3", "count_1", "sum_a", "max_b", "avg_a"})
+                  .planNode();
+
+  auto task = assertQuery(
+      plan,
+      "SELECT k1, k2, k3, count(1), sum(a), max(b), avg(a) FROM tmp GROUP BY CUBE (k1, k2, k3)");
+
+  // GroupId replicates the 748 pre-aggregated groups, not the raw input.
+  const auto groupIdNodeId = aggregationNode->sources()[0]->id();
+  const auto groupIdStats = toPlanStats(task->taskStats()).at(groupIdNodeId);
+  ASSERT_EQ(groupIdStats.inputRows, 748);
+  ASSERT_EQ(groupIdStats.outputRows, 748 * 8);
+
+  // Global grouping set over empty input.
+  plan = PlanBuilder()
+             .values({data})
+             .filter("k1 < 0")
+             .groupingSetsAggregation(
+                 {"k1"}, {{"k1"}, {}}, {"count(b) as count_b"})
+             .project({"count_b"})
+             .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT count(b) FROM tmp WHERE k1 < 0 GROUP BY GROUPING SETS ((k1), ())");
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -2181,6 +2496,32 @@ TEST_F(AggregationTest, spillingForAggrsWithSorting) {
       plan, "SELECT c0 % 7, array_agg(c1 ORDER BY c1) FROM tmp GROUP BY 1");
 }
 
+TEST_F(AggregationTest, sortedAggregationManySmallGroups) {
+  // 10K groups of 3 rows each. The sorted inputs of many groups are passed to
+  // the aggregates in batches of multiple groups.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(30'000, [](auto row) { return row / 3; }),
+      makeFlatVector<int32_t>(30'000, [](auto row) { return row * 7 % 11; }),
+      makeFlatVector<bool>(30'000, [](auto row) { return row % 2 == 0; }),
+  });
+  createDuckDbTable({data});
+
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .singleAggregation(
+                      {"c0"},
+                      {"array_agg(c1 ORDER BY c1 DESC)",
+                       "array_agg(c1 ORDER BY c1)",
+                       "sum(c1)"},
+                      {"", "c2", ""})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT c0, array_agg(c1 ORDER BY c1 DESC), "
+          "array_agg(c1 ORDER BY c1) FILTER (WHERE c2), sum(c1) "
+          "FROM tmp GROUP BY 1");
+}
+
 TEST_F(AggregationTest, spillPrefixSortOptimization) {
   const RowTypePtr rowType{
       ROW({"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8"},
@@ -3478,6 +3819,70 @@ TEST_F(AggregationTest, noAggregationsNoGroupingKeys) {
 
 // Reproduces hang in partial distinct aggregation described in
 // https://github.com/facebookincubator/velox/issues/7967 .
+TEST_F(AggregationTest, preAggregateDistinct) {
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 10; ++i) {
+    inputs.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; }),
+        makeFlatVector<int32_t>(
+            1'000, [i](auto row) { return (row + i) % 300; }, nullEvery(7)),
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 13; }),
+    }));
+  }
+  createDuckDbTable(inputs);
+
+  struct {
+    std::vector<std::string> keys;
+    std::vector<std::string> aggregates;
+    std::string sql;
+    bool preAggregated;
+  } testSettings[] = {
+      {{"c0"},
+       {"count(distinct c1)", "sum(distinct c1)", "max(distinct c1)"},
+       "SELECT c0, count(distinct c1), sum(distinct c1), max(distinct c1) "
+       "FROM tmp GROUP BY c0",
+       true},
+      {{},
+       {"count(distinct c1)", "min(distinct c1)"},
+       "SELECT count(distinct c1), min(distinct c1) FROM tmp",
+       true},
+      // Distinct over different columns is not rewritten.
+      {{"c0"},
+       {"count(distinct c1)", "count(distinct c2)"},
+       "SELECT c0, count(distinct c1), count(distinct c2) FROM tmp GROUP BY c0",
+       false}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(folly::join(", ", testData.aggregates));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    core::PlanNodeId aggrNodeId;
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(QueryConfig::kSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillEnabled, true)
+            .config(QueryConfig::kAggregationPreAggregateDistinct, true)
+            .plan(PlanBuilder()
+                      .values(inputs)
+                      .singleAggregation(testData.keys, testData.aggregates)
+                      .capturePlanNodeId(aggrNodeId)
+                      .planNode())
+            .assertResults(testData.sql);
+
+    // The distinct values are de-duplicated by a spillable aggregation.
+    const auto planNodeStatsMap = toPlanStats(task->taskStats());
+    const auto distinctNodeId = aggrNodeId + ".distinct";
+    ASSERT_EQ(
+        planNodeStatsMap.count(distinctNodeId), testData.preAggregated ? 1 : 0);
+    if (testData.preAggregated) {
+      ASSERT_GT(planNodeStatsMap.at(distinctNodeId).spilledBytes, 0);
+    }
+    task.reset();
+    waitForAllTasksToBeDeleted();
+  }
+}
+
 TEST_F(AggregationTest, distinctHang) {
   static const int64_t kMin = std::numeric_limits<int32_t>::min();
   static const int64_t kMax = std::numeric_limits<int32_t>::max();
@@ -19,6 +19,7 @@
 #include <memory>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Cursor.h"
@@ -606,6 +607,32 @@ TEST_F(DriverTest, pause) {
   EXPECT_EQ(operators[1].outputPositions, 10 * hits);
 }
 
+TEST_F(DriverTest, perfCounters) {
+  if (process::PerfCounters::threadCounters() == nullptr) {
+    GTEST_SKIP() << "perf_event hardware counters are not available";
+  }
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row; })});
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .filter("c0 % 3 = 0")
+                  .project({"c0 * 2"})
+                  .planNode();
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOperatorTrackPerfCounters, "true")
+      .copyResults(pool(), task);
+  const auto taskStats = task->taskStats();
+  ASSERT_EQ(taskStats.pipelineStats.size(), 1);
+  const auto& filterProject = taskStats.pipelineStats[0].operatorStats[1];
+  ASSERT_EQ(filterProject.runtimeStats.count(Operator::kPerfInstructions), 1);
+  ASSERT_EQ(filterProject.runtimeStats.count(Operator::kPerfCycles), 1);
+  EXPECT_GT(filterProject.runtimeStats.at(Operator::kPerfInstructions).sum, 0);
+  EXPECT_GT(filterProject.runtimeStats.at(Operator::kPerfCycles).sum, 0);
+  ASSERT_EQ(filterProject.runtimeStats.count(Operator::kPerfCacheMisses), 1);
+  ASSERT_EQ(filterProject.runtimeStats.count(Operator::kPerfBranchMisses), 1);
+}
+
 TEST_F(DriverTest, yield) {
   constexpr int32_t kNumTasks = 20;
   constexpr int32_t kThreadsPerTask = 5;
@@ -1184,6 +1211,48 @@ TEST_F(DriverTest, enableOperatorBatchSizeStatsConfig) {
   EXPECT_GT(operatorStats[1].outputBytes, 0);
 }
 
+TEST_F(DriverTest, coalesceOperatorOutputBatches) {
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 100; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        100, [i](auto row) { return i * 100 + row; })}));
+  }
+  createDuckDbTable(batches);
+
+  // The filter keeps 5 rows of each 100 rows input batch.
+  auto plan = PlanBuilder().values(batches).filter("c0 % 20 = 0").planNode();
+  for (const bool coalesce : {false, true}) {
+    SCOPED_TRACE(fmt::format("coalesce: {}", coalesce));
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+                    .config(
+                        core::QueryConfig::kCoalesceOperatorOutputBatches,
+                        coalesce ? "true" : "false")
+                    .assertResults("SELECT * FROM tmp WHERE c0 % 20 = 0");
+
+    const auto& operatorStats =
+        task->taskStats().pipelineStats[0].operatorStats;
+    ASSERT_EQ(operatorStats.size(), 3);
+    const auto& filterStats = operatorStats[1];
+    ASSERT_EQ(filterStats.outputVectors, 100);
+    ASSERT_EQ(filterStats.outputPositions, 500);
+    const auto& sinkStats = operatorStats[2];
+    ASSERT_EQ(sinkStats.inputPositions, 500);
+    if (!coalesce) {
+      ASSERT_EQ(sinkStats.inputVectors, 100);
+      ASSERT_EQ(
+          filterStats.runtimeStats.count(BatchCoalescer::kCoalescedBatches), 0);
+      continue;
+    }
+    // Every 20 filter outputs are merged into one 100 rows batch.
+    ASSERT_EQ(sinkStats.inputVectors, 5);
+    const auto& coalescedBatches =
+        filterStats.runtimeStats.at(BatchCoalescer::kCoalescedBatches);
+    ASSERT_EQ(coalescedBatches.count, 5);
+    ASSERT_EQ(coalescedBatches.sum, 100);
+  }
+}
+
 DEBUG_ONLY_TEST_F(DriverTest, driverSuspensionRaceWithTaskPause) {
   struct {
     int numDrivers;
@@ -19,6 +19,7 @@
 #include <atomic>
 #include <thread>
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/memory/SharedArbitrator.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -43,6 +44,7 @@ class ExchangeClientTest
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+    memory::SharedArbitrator::registerFactory();
     if (!isRegisteredNamedVectorSerde(VectorSerde::Kind::kPresto)) {
       serializer::presto::PrestoVectorSerde::registerNamedVectorSerde();
     }
@@ -54,6 +56,10 @@ class ExchangeClientTest
     }
   }
 
+  static void TearDownTestCase() {
+    memory::SharedArbitrator::unregisterFactory();
+  }
+
   void SetUp() override {
     serdeKind_ = GetParam();
     test::testingStartLocalExchangeSource();
@@ -285,6 +291,156 @@ TEST_P(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+TEST_P(ExchangeClientTest, growableBuffer) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  auto page = test::toSerializedPage(data, serdeKind_, bufferManager_, pool());
+
+  // Start at 1.5 pages and grow up to 12.
+  const int64_t initialBytes = page->size() * 1.5;
+  const int64_t limitBytes = page->size() * 12;
+  auto client = std::make_shared<ExchangeClient>(
+      "growable.buffer",
+      17,
+      initialBytes,
+      1,
+      1024,
+      pool(),
+      executor(),
+      10,
+      false,
+      false,
+      limitBytes);
+  auto reclaimer = ExchangeClient::MemoryReclaimer::create();
+  uint64_t reclaimableBytes;
+  ASSERT_FALSE(reclaimer->reclaimableBytes(*pool(), reclaimableBytes));
+  reclaimer->setClient(client);
+  // Nothing is reclaimable until the buffer grows.
+  ASSERT_TRUE(reclaimer->reclaimableBytes(*pool(), reclaimableBytes));
+  ASSERT_EQ(reclaimableBytes, 0);
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 10; ++i) {
+    auto taskId = fmt::format("local://t{}", i);
+    auto task = makeTask(taskId);
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+    for (auto j = 0; j < 3; ++j) {
+      enqueue(taskId, 17, data);
+    }
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  fetchPages(1, *client, 3 * tasks.size());
+
+  const auto stats = client->stats();
+  EXPECT_EQ(30, stats.at("numReceivedPages").sum);
+  EXPECT_LE(stats.at("peakBytes").sum, limitBytes + page->size());
+  EXPECT_LE(client->maxQueuedBytes(), limitBytes);
+  EXPECT_EQ(
+      client->maxQueuedBytes() > initialBytes,
+      stats.at("numBufferGrows").sum > 0);
+
+  // Memory arbitration shrinks the buffer back to its initial capacity.
+  memory::MemoryReclaimer::Stats reclaimStats;
+  ASSERT_EQ(reclaimer->reclaim(pool(), 0, 0, reclaimStats), 0);
+  EXPECT_EQ(client->maxQueuedBytes(), initialBytes);
+  EXPECT_EQ(client->shrink(), 0);
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+
+  client->close();
+}
+
+TEST_P(ExchangeClientTest, growableBufferArbitration) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  auto page = test::toSerializedPage(data, serdeKind_, bufferManager_, pool());
+
+  memory::MemoryManager::Options options;
+  options.allocatorCapacity = 8L << 30;
+  options.arbitratorCapacity = 4L << 30;
+  options.arbitratorKind = "SHARED";
+  using ExtraConfig = memory::SharedArbitrator::ExtraConfig;
+  options.extraArbitratorConfigs = {
+      {std::string(ExtraConfig::kMemoryPoolInitialCapacity), "256MB"},
+      {std::string(ExtraConfig::kMemoryPoolReservedCapacity), "0B"},
+      {std::string(ExtraConfig::kMemoryPoolMinReclaimBytes), "0B"},
+      {std::string(ExtraConfig::kMemoryPoolMinReclaimPct), "0"},
+      {std::string(ExtraConfig::kGlobalArbitrationEnabled), "true"},
+  };
+  memory::MemoryManager manager(options);
+  auto rootPool = manager.addRootPool(
+      "growableBufferArbitration",
+      memory::kMaxMemory,
+      exec::MemoryReclaimer::create());
+  auto reclaimer = ExchangeClient::MemoryReclaimer::create();
+  auto* clientReclaimer = reclaimer.get();
+  auto clientPool = rootPool->addLeafChild(
+      "exchangeClient", true, std::move(reclaimer));
+
+  const int64_t initialBytes = page->size() * 1.5;
+  const int64_t limitBytes = page->size() * 12;
+  auto client = std::make_shared<ExchangeClient>(
+      "growable.buffer.arbitration",
+      17,
+      initialBytes,
+      1,
+      1024,
+      clientPool.get(),
+      executor(),
+      10,
+      false,
+      false,
+      limitBytes);
+  clientReclaimer->setClient(client);
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 10; ++i) {
+    auto taskId = fmt::format("local://t{}", i);
+    auto task = makeTask(taskId);
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+    for (auto j = 0; j < 3; ++j) {
+      enqueue(taskId, 17, data);
+    }
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  // Consume until the buffer grows, then stop consuming and let it fill up
+  // above its initial capacity.
+  int32_t numFetchedPages{0};
+  while (client->maxQueuedBytes() == initialBytes && numFetchedPages < 20) {
+    fetchPages(1, *client, 1);
+    ++numFetchedPages;
+  }
+  ASSERT_GT(client->maxQueuedBytes(), initialBytes);
+  for (auto i = 0; i < 300 && client->reclaimableBytes() == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_GT(client->reclaimableBytes(), 0);
+
+  // A global arbitration picks the client as a victim and shrinks its buffer.
+  memory::testingRunArbitration(rootPool.get());
+  EXPECT_EQ(client->maxQueuedBytes(), initialBytes);
+  EXPECT_EQ(client->stats().at("numBufferShrinks").sum, 1);
+  EXPECT_EQ(client->reclaimableBytes(), 0);
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+  client->close();
+}
+
 // Test that small pages will block and we will keep
 // requesting from the queue if we do not have enough buffer
 // to fillout minOutputBatchBytes
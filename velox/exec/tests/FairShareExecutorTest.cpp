@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FairShareExecutor.h"
+
+#include <fmt/format.h>
+#include <folly/executors/ManualExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/ProcessBase.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+// Burns 'ms' of CPU time on the calling thread.
+void spin(uint64_t ms) {
+  const auto start = process::threadCpuNanos();
+  while (process::threadCpuNanos() - start < ms * 1'000'000) {
+  }
+}
+
+class FairShareExecutorTest : public testing::Test {
+ protected:
+  FairShareExecutor::Options options() const {
+    FairShareExecutor::Options options;
+    options.numLevels = 3;
+    options.level0ThresholdMs = 1;
+    options.levelTimeMultiplier = 1'000;
+    return options;
+  }
+
+  folly::ManualExecutor manualExecutor_;
+};
+
+TEST_F(FairShareExecutorTest, demotion) {
+  FairShareExecutor executor(&manualExecutor_, options());
+  executor.add("long", 0, []() { spin(5); });
+  EXPECT_EQ(executor.queryLevel("long"), 0);
+  manualExecutor_.run();
+  // The query used more than the 1ms of level 0.
+  EXPECT_EQ(executor.queryLevel("long"), 1);
+  EXPECT_EQ(executor.queryLevel("short"), 0);
+
+  // New queries run ahead of the demoted one.
+  std::vector<std::string> order;
+  executor.add("long", 0, [&]() { order.push_back("long"); });
+  executor.add("short", 0, [&]() { order.push_back("short"); });
+  manualExecutor_.run();
+  EXPECT_EQ(order, (std::vector<std::string>{"short", "long"}));
+
+  const auto stats = executor.stats();
+  EXPECT_EQ(stats.numRuns, 3);
+  EXPECT_EQ(stats.numQueries, 2);
+  EXPECT_GE(stats.levelCpuNanos[0], 5'000'000);
+}
+
+TEST_F(FairShareExecutorTest, priority) {
+  FairShareExecutor executor(&manualExecutor_, options());
+  EXPECT_EQ(executor.options().numLevels, 3);
+  std::vector<std::string> order;
+  for (auto i = 0; i < 2; ++i) {
+    executor.add("low", 2, [&, i]() {
+      spin(2);
+      order.push_back(fmt::format("low{}", i));
+    });
+  }
+  for (auto i = 0; i < 2; ++i) {
+    executor.add("high", 0, [&, i]() {
+      spin(2);
+      order.push_back(fmt::format("high{}", i));
+    });
+  }
+  EXPECT_EQ(executor.queryLevel("low"), 2);
+  manualExecutor_.run();
+  // Level 2 gets a quarter of the CPU time of level 0 but is not starved.
+  EXPECT_EQ(
+      order, (std::vector<std::string>{"high0", "low0", "high1", "low1"}));
+}
+
+TEST_F(FairShareExecutorTest, unownedFirst) {
+  FairShareExecutor executor(&manualExecutor_, options());
+  std::vector<std::string> order;
+  executor.add("query", 0, [&]() { order.push_back("query"); });
+  executor.add([&]() { order.push_back("unowned"); });
+  // Exceptions do not stop the executor.
+  executor.add("query", 0, []() { VELOX_FAIL("Expected"); });
+  manualExecutor_.run();
+  EXPECT_EQ(order, (std::vector<std::string>{"unowned", "query"}));
+  EXPECT_EQ(executor.stats().numRuns, 3);
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
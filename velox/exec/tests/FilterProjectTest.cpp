@@ -294,6 +294,49 @@ TEST_F(FilterProjectTest, projectAndIdentityOverLazy) {
   assertQuery(plan, "SELECT c0 < 10 AND c1 < 10, c1 FROM tmp");
 }
 
+TEST_F(FilterProjectTest, filterLoadsSharedLazyOnPassingRows) {
+  // A lazy column that the filter and the projections read is loaded only for
+  // the rows that reach it in the filter.
+  const vector_size_t size = 1'000;
+  auto valueAt = [](auto row) -> int64_t { return row; };
+  auto vectors = makeRowVector({
+      makeFlatVector<int64_t>(size, valueAt),
+      makeFlatVector<int64_t>(size, valueAt),
+  });
+  createDuckDbTable({vectors});
+
+  auto makeLazyVectors = [&](vector_size_t& numLoadedRows) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(size, valueAt),
+        std::make_shared<LazyVector>(
+            pool(),
+            BIGINT(),
+            size,
+            std::make_unique<SimpleVectorLoader>([&, this](RowSet rows) {
+              numLoadedRows = rows.size();
+              return makeFlatVector<int64_t>(rows.back() + 1, valueAt);
+            })),
+    });
+  };
+
+  for (const auto& projections : std::vector<std::vector<std::string>>{
+           {"c0", "c1 + 1"}, {"c0", "c1"}}) {
+    SCOPED_TRACE(folly::join(", ", projections));
+    vector_size_t numLoadedRows = 0;
+    auto plan = test::PlanBuilder()
+                    .values({makeLazyVectors(numLoadedRows)})
+                    .filter("c0 % 10 = 0 AND c1 % 4 = 0")
+                    .project(projections)
+                    .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT {} FROM tmp WHERE c0 % 10 = 0 AND c1 % 4 = 0",
+            folly::join(", ", projections)));
+    EXPECT_EQ(numLoadedRows, size / 10);
+  }
+}
+
 // Verify the optimization of avoiding copy in null propagation does not break
 // the case when the field is shared between multiple parents.
 TEST_F(FilterProjectTest, nestedFieldReferenceSharedChild) {
@@ -466,5 +509,50 @@ TEST_F(FilterProjectTest, lazyDereference) {
   }
 }
 
+TEST_F(FilterProjectTest, optimizedExprsSharedAcrossDrivers) {
+  auto vectors = makeTestVectors();
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId projectId;
+  auto plan = test::PlanBuilder()
+                  .values(vectors, true)
+                  .filter("c0 % (5 + 5) > 0")
+                  .project({"c0 + (1 + 2) AS x"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  auto task = test::AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .maxDrivers(4)
+                  .assertResults("SELECT c0 + 3 FROM tmp WHERE c0 % 10 > 0");
+
+  // The filter and the project are fused into one operator. The Drivers have
+  // folded the constants once and added the result to the task.
+  const auto exprs = task->getOptimizedExprs(
+      projectId, []() -> std::vector<core::TypedExprPtr> { VELOX_FAIL(); });
+  ASSERT_EQ(exprs->size(), 2);
+  ASSERT_TRUE(exprs->at(0)->inputs()[0]->inputs()[1]->isConstantKind());
+  ASSERT_TRUE(exprs->at(1)->inputs()[1]->isConstantKind());
+}
+
+TEST_F(FilterProjectTest, optimizedExprsReleasedWithTask) {
+  auto vectors = makeTestVectors();
+  createDuckDbTable(vectors);
+
+  // The folded constant is a string with a buffer in an operator pool. The
+  // task releases it before its pools.
+  auto plan = test::PlanBuilder()
+                  .values(vectors, true)
+                  .project(
+                      {"concat(cast(c0 AS varchar), "
+                       "concat('0123456789abcdef', '0123456789abcdef')) AS x"})
+                  .planNode();
+  auto task =
+      test::AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .maxDrivers(4)
+          .assertResults(
+              "SELECT concat(cast(c0 AS varchar), "
+              "'0123456789abcdef0123456789abcdef') FROM tmp");
+  task.reset();
+}
+
 } // namespace
 } // namespace facebook::velox::exec
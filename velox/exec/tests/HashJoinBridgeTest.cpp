@@ -406,6 +406,82 @@ TEST_P(HashJoinBridgeTest, withSpill) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, skipEmptyProbePartitions) {
+  for (const bool skipEmptyProbePartitions : {false, true}) {
+    SCOPED_TRACE(
+        fmt::format("skipEmptyProbePartitions: {}", skipEmptyProbePartitions));
+    auto joinBridge = createJoinBridge();
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      joinBridge->addBuilder();
+    }
+    joinBridge->start();
+
+    // Spill four table partitions of which only partitions 1 and 3 have probe
+    // input.
+    const int32_t numPartitions = 4;
+    SpillPartitionSet tablePartitionSet;
+    SpillPartitionSet probePartitionSet;
+    for (int32_t partition = 0; partition < numPartitions; ++partition) {
+      const SpillPartitionId id(partition);
+      tablePartitionSet.emplace(
+          id,
+          std::make_unique<SpillPartition>(
+              id, makeFakeSpillFiles(numSpillFilesPerPartition_)));
+      probePartitionSet.emplace(
+          id,
+          std::make_unique<SpillPartition>(
+              id,
+              partition % 2 == 1 ? makeFakeSpillFiles(1) : SpillFiles{}));
+    }
+    const auto partitionIds = toSpillPartitionIdSet(tablePartitionSet);
+    joinBridge->setHashTable(
+        createFakeHashTable(), std::move(tablePartitionSet), false, nullptr);
+
+    auto futures = createEmptyFutures(1);
+    for (int32_t i = 0; i < numProbers_; ++i) {
+      ASSERT_TRUE(joinBridge->tableOrFuture(&futures[0]).has_value());
+      joinBridge->addProbeSpilledPartitions(probePartitionSet, partitionIds);
+    }
+
+    std::vector<int32_t> restoredPartitions;
+    int32_t numSkippedPartitions{0};
+    while (true) {
+      const auto skippedPartitionIds =
+          joinBridge->probeFinished(false, skipEmptyProbePartitions);
+      for (const auto& id : skippedPartitionIds) {
+        ASSERT_EQ(id.partitionNumber() % 2, 0U);
+      }
+      numSkippedPartitions += skippedPartitionIds.size();
+
+      futures = createEmptyFutures(numBuilders_);
+      std::optional<SpillPartitionId> restoringPartitionId;
+      for (int32_t i = 0; i < numBuilders_; ++i) {
+        auto inputOr = joinBridge->spillInputOrFuture(&futures[i]);
+        ASSERT_TRUE(inputOr.has_value());
+        if (inputOr.value().spillPartition == nullptr) {
+          ASSERT_FALSE(restoringPartitionId.has_value());
+          continue;
+        }
+        restoringPartitionId = inputOr.value().spillPartition->id();
+      }
+      if (!restoringPartitionId.has_value()) {
+        break;
+      }
+      restoredPartitions.push_back(restoringPartitionId->partitionNumber());
+      joinBridge->setHashTable(createFakeHashTable(), {}, false, nullptr);
+      ASSERT_TRUE(joinBridge->tableOrFuture(&futures[0]).has_value());
+    }
+    if (skipEmptyProbePartitions) {
+      ASSERT_EQ(numSkippedPartitions, 2);
+      ASSERT_EQ(restoredPartitions, std::vector<int32_t>({1, 3}));
+    } else {
+      ASSERT_EQ(numSkippedPartitions, 0);
+      ASSERT_EQ(restoredPartitions, std::vector<int32_t>({0, 1, 2, 3}));
+    }
+    ASSERT_FALSE(joinBridge->testingHasMoreSpilledPartitions());
+  }
+}
+
 TEST_P(HashJoinBridgeTest, multiThreading) {
   for (int32_t iter = 0; iter < 10; ++iter) {
     std::vector<std::thread> builderThreads;
@@ -3457,6 +3457,65 @@ TEST_P(HashJoinTest, lazyVectors) {
   }
 }
 
+TEST_P(HashJoinTest, lazyPayloadLoadedOnlyForMatches) {
+  // Probes a wide batch with a 1% hit rate and verifies that the non-key
+  // probe columns are loaded only for the matching rows.
+  constexpr vector_size_t kNumRows = 10'000;
+  std::vector<vector_size_t> numLoadedRows(2, 0);
+  auto makePayload = [&](int32_t column) {
+    auto loader = std::make_unique<velox::test::SimpleVectorLoader>(
+        [&, column](RowSet rows) {
+          numLoadedRows[column] += rows.size();
+          return makeFlatVector<int64_t>(
+              rows.back() + 1, [column](auto row) { return row * column; });
+        });
+    return std::make_shared<LazyVector>(
+        pool(), BIGINT(), kNumRows, std::move(loader));
+  };
+  auto probe = makeRowVector(
+      {"t0", "t1", "t2"},
+      {makeFlatVector<int32_t>(kNumRows, folly::identity),
+       makePayload(0),
+       makePayload(1)});
+  auto build = makeRowVector(
+      {"u0"},
+      {makeFlatVector<int32_t>(kNumRows / 100, [](auto row) {
+        return row * 100;
+      })});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"t0", "t1", "t2"})
+                  .project({"t0", "t1 + 1", "t2 + 1"})
+                  .planNode();
+
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(
+          kNumRows / 100, [](auto row) { return row * 100; }),
+      makeFlatVector<int64_t>(kNumRows / 100, [](auto /*row*/) { return 1; }),
+      makeFlatVector<int64_t>(
+          kNumRows / 100, [](auto row) { return row * 100 + 1; }),
+  });
+  // The values nodes are not parallelizable, so a single probe driver loads
+  // the lazy vectors, whatever the number of drivers.
+  AssertQueryBuilder(plan)
+      .maxDrivers(numDrivers_)
+      .config(
+          core::QueryConfig::kParallelOutputJoinBuildRowsEnabled,
+          parallelBuildSideRowsEnabled_)
+      .assertResults(expected);
+  EXPECT_EQ(numLoadedRows[0], kNumRows / 100);
+  EXPECT_EQ(numLoadedRows[1], kNumRows / 100);
+}
+
 TEST_P(HashJoinTest, lazyVectorNotLoadedInFilter) {
   // Ensure that if lazy vectors are temporarily wrapped during a filter's
   // execution and remain unloaded, the temporary wrap is promptly
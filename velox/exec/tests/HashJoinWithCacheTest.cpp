@@ -570,5 +570,61 @@ DEBUG_ONLY_TEST_F(HashJoinWithCacheTest, probeOOMWithCachedTable) {
   // Cache should be cleaned up by QueryCtx destructor via release callback.
 }
 
+// Tests which joins share their hash table when broadcast builds are shared.
+TEST_F(HashJoinWithCacheTest, shareBroadcastBuild) {
+  const auto probeType = ROW({"t_k", "t_v"}, {INTEGER(), BIGINT()});
+  const auto buildType = ROW({"u_k", "u_v"}, {INTEGER(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const auto exchangeBuild =
+      PlanBuilder(planNodeIdGenerator)
+          .exchange(buildType, VectorSerde::Kind::kPresto, /*broadcast=*/true)
+          .filter("u_v > 0")
+          .planNode();
+  const auto partitionedBuild =
+      PlanBuilder(planNodeIdGenerator)
+          .exchange(buildType, VectorSerde::Kind::kPresto)
+          .filter("u_v > 0")
+          .planNode();
+  const auto valuesBuild = PlanBuilder(planNodeIdGenerator)
+                               .values({BaseVector::create<RowVector>(
+                                   buildType, 0, pool())})
+                               .planNode();
+  const auto makeJoin = [&](const core::PlanNodePtr& build,
+                            core::JoinType joinType) {
+    return std::dynamic_pointer_cast<const core::HashJoinNode>(
+        PlanBuilder(planNodeIdGenerator)
+            .exchange(probeType, VectorSerde::Kind::kPresto)
+            .hashJoin({"t_k"}, {"u_k"}, build, "", {"u_v"}, joinType)
+            .planNode());
+  };
+
+  const core::QueryConfig disabled({});
+  const core::QueryConfig enabled(
+      {{core::QueryConfig::kHashJoinShareBroadcastBuild, "true"}});
+  const auto innerJoin = makeJoin(exchangeBuild, core::JoinType::kInner);
+  EXPECT_FALSE(shareHashTable(*innerJoin, disabled));
+  EXPECT_TRUE(shareHashTable(*innerJoin, enabled));
+  EXPECT_TRUE(shareHashTable(
+      *makeJoin(exchangeBuild, core::JoinType::kLeft), enabled));
+
+  // Each task reads only its partition of the build side.
+  EXPECT_FALSE(shareHashTable(
+      *makeJoin(partitionedBuild, core::JoinType::kInner), enabled));
+  EXPECT_FALSE(shareHashTable(
+      *makeJoin(partitionedBuild, core::JoinType::kLeft), enabled));
+
+  // The build side reads data of its own.
+  EXPECT_FALSE(shareHashTable(
+      *makeJoin(valuesBuild, core::JoinType::kInner), enabled));
+
+  // The joins that track the probed build rows.
+  for (const auto joinType :
+       {core::JoinType::kRight,
+        core::JoinType::kFull,
+        core::JoinType::kRightSemiFilter}) {
+    EXPECT_FALSE(shareHashTable(*makeJoin(exchangeBuild, joinType), enabled));
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::exec::test
@@ -264,3 +264,76 @@ TEST_F(HashPartitionFunctionTest, noKeyAndBitRange) {
     EXPECT_EQ(singlePartition.value(), 0u);
   }
 }
+
+TEST_F(HashPartitionFunctionTest, skewedKeys) {
+  const int numRows = 1'000;
+  const int numPartitions = 8;
+  // Key 7 is on every other row.
+  auto input = makeRowVector({makeFlatVector<int32_t>(
+      numRows, [](auto row) { return row % 2 == 0 ? 7 : row; })});
+  auto rowType = asRowType(input->type());
+
+  HashPartitionFunction plain(false, numPartitions, rowType, {0});
+  std::vector<uint32_t> plainPartitions;
+  plain.partition(*input, plainPartitions);
+  const auto hotHash =
+      plain.hashKeys(*makeRowVector({makeFlatVector<int32_t>({7})}))[0];
+  const auto hotPartition = plainPartitions[0];
+
+  // The probe side spreads the hot key round robin over 3 partitions.
+  SkewedKeys skewedKeys{{hotHash}, 3, false};
+  HashPartitionFunction spread(
+      false, numPartitions, rowType, {0}, {}, skewedKeys);
+  std::vector<uint32_t> partitions;
+  spread.partition(*input, partitions);
+  EXPECT_TRUE(spread.replicatedRows().empty());
+  EXPECT_EQ(spread.numReplicas(), 1);
+  std::vector<int> hotRowCounts(numPartitions);
+  for (auto row = 0; row < numRows; ++row) {
+    if (row % 2 == 0) {
+      ++hotRowCounts[partitions[row]];
+    } else {
+      EXPECT_EQ(partitions[row], plainPartitions[row]);
+    }
+  }
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    const auto offset =
+        (partition - hotPartition + numPartitions) % numPartitions;
+    if (offset < 3) {
+      EXPECT_GE(hotRowCounts[partition], numRows / 2 / 3);
+    } else {
+      EXPECT_EQ(hotRowCounts[partition], 0);
+    }
+  }
+
+  // The build side replicates the hot key to the same 3 partitions.
+  skewedKeys.replicate = true;
+  HashPartitionFunction replicate(
+      false, numPartitions, rowType, {0}, {}, skewedKeys);
+  replicate.partition(*input, partitions);
+  EXPECT_EQ(partitions, plainPartitions);
+  EXPECT_EQ(replicate.numReplicas(), 3);
+  ASSERT_EQ(replicate.replicatedRows().size(), numRows / 2);
+  for (auto i = 0; i < numRows / 2; ++i) {
+    EXPECT_EQ(replicate.replicatedRows()[i], i * 2);
+  }
+
+  // The spread factor is capped by the number of partitions.
+  skewedKeys.spreadFactor = 100;
+  HashPartitionFunction capped(false, 2, rowType, {0}, {}, skewedKeys);
+  capped.partition(*input, partitions);
+  EXPECT_EQ(capped.numReplicas(), 2);
+
+  // The hot keys are serialized with the spec.
+  auto spec = std::make_shared<HashPartitionFunctionSpec>(
+      rowType,
+      std::vector<column_index_t>{0},
+      std::vector<VectorPtr>{},
+      SkewedKeys{{hotHash, ~0ULL}, 3, true});
+  ASSERT_EQ("HASH(c0) SKEWED(2 keys, replicate 3)", spec->toString());
+  auto copy = HashPartitionFunctionSpec::deserialize(spec->serialize(), pool());
+  ASSERT_EQ(spec->toString(), copy->toString());
+  auto function = copy->create(numPartitions, false);
+  function->partition(*input, partitions);
+  EXPECT_EQ(function->replicatedRows().size(), numRows / 2);
+}
@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/core/QueryCtx.h"
@@ -222,4 +223,96 @@ TEST_F(HashTableCacheTest, builderTaskDriversDoNotWait) {
   EXPECT_FALSE(future2.valid());
 }
 
+TEST_F(HashTableCacheTest, crossQuery) {
+  auto* cache = HashTableCache::instance();
+  const std::string key = "shared:fingerprint1";
+  trackKey(key);
+
+  ContinueFuture future1 = ContinueFuture::makeEmpty();
+  auto entry1 = cache->getCrossQuery(key, "task1", &future1);
+  ASSERT_NE(entry1, nullptr);
+  EXPECT_TRUE(entry1->crossQuery);
+  EXPECT_FALSE(future1.valid());
+  // The table is allocated from the cache pool, not from a query pool.
+  EXPECT_EQ(entry1->tablePool->parent(), cache->pool());
+  EXPECT_EQ(cache->pool()->name(), HashTableCache::kPoolName);
+
+  // A task of another query waits for the build.
+  ContinueFuture future2 = ContinueFuture::makeEmpty();
+  auto entry2 = cache->getCrossQuery(key, "task2", &future2);
+  EXPECT_EQ(entry1, entry2);
+  EXPECT_TRUE(future2.valid());
+
+  cache->put(key, nullptr, false);
+  EXPECT_TRUE(future2.isReady());
+
+  // A per-query lookup must not alias a cross-query entry.
+  ContinueFuture future3 = ContinueFuture::makeEmpty();
+  VELOX_ASSERT_THROW(
+      cache->get(key, "task3", queryCtx_.get(), &future3),
+      "is used for both per-query and cross-query caching");
+}
+
+TEST_F(HashTableCacheTest, evict) {
+  auto* cache = HashTableCache::instance();
+  const std::string usedKey = "shared:used";
+  const std::string unusedKey = "shared:unused";
+  const std::string buildingKey = "shared:building";
+  const std::string perQueryKey = "query8:node1";
+  for (const auto& key : {usedKey, unusedKey, buildingKey, perQueryKey}) {
+    trackKey(key);
+  }
+
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  auto usedEntry = cache->getCrossQuery(usedKey, "task1", &future);
+  cache->put(usedKey, nullptr, false);
+  cache->getCrossQuery(unusedKey, "task1", &future);
+  cache->put(unusedKey, nullptr, false);
+  cache->getCrossQuery(buildingKey, "task1", &future);
+  cache->get(perQueryKey, "task1", queryCtx_.get(), &future);
+  cache->put(perQueryKey, nullptr, false);
+
+  // Only the built cross-query entry that nobody references is evicted.
+  cache->evict(0);
+  ContinueFuture lookupFuture = ContinueFuture::makeEmpty();
+  EXPECT_EQ(cache->getCrossQuery(usedKey, "task2", &lookupFuture), usedEntry);
+  EXPECT_FALSE(lookupFuture.valid());
+  auto newEntry = cache->getCrossQuery(unusedKey, "task2", &lookupFuture);
+  EXPECT_FALSE(newEntry->buildComplete);
+  EXPECT_EQ(newEntry->builderTaskId, "task2");
+  EXPECT_EQ(
+      cache->getCrossQuery(buildingKey, "task1", &lookupFuture)->builderTaskId,
+      "task1");
+  EXPECT_TRUE(
+      cache->get(perQueryKey, "task2", queryCtx_.get(), &lookupFuture)
+          ->buildComplete);
+}
+
+TEST_F(HashTableCacheTest, abandon) {
+  auto* cache = HashTableCache::instance();
+  const std::string key = "shared:abandon";
+  trackKey(key);
+
+  ContinueFuture future1 = ContinueFuture::makeEmpty();
+  auto entry1 = cache->getCrossQuery(key, "task1", &future1);
+  ContinueFuture future2 = ContinueFuture::makeEmpty();
+  cache->getCrossQuery(key, "task2", &future2);
+  ASSERT_TRUE(future2.valid());
+
+  // Only the builder task can abandon the entry.
+  cache->abandon(key, "task2");
+  EXPECT_FALSE(future2.isReady());
+
+  cache->abandon(key, "task1");
+  EXPECT_TRUE(future2.isReady());
+  EXPECT_FALSE(entry1->buildComplete);
+
+  // The next query builds the table again.
+  ContinueFuture future3 = ContinueFuture::makeEmpty();
+  auto entry3 = cache->getCrossQuery(key, "task3", &future3);
+  EXPECT_NE(entry1, entry3);
+  EXPECT_EQ(entry3->builderTaskId, "task3");
+  EXPECT_FALSE(future3.valid());
+}
+
 } // namespace facebook::velox::exec::test
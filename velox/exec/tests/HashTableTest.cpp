@@ -28,6 +28,7 @@
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 #include <memory>
+#include <unordered_set>
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -161,7 +162,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
         BaseHashTable::kNoSpillInputStartPartitionBit,
         1'000'000,
         false,
-        executor_.get());
+        executor_.get(),
+        numParallelBuildPartitions_);
     ASSERT_GE(
         estimatedTableSize,
         topTable_->rows()->pool()->usedBytes() - usedMemoryBytes);
@@ -595,6 +597,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
   int64_t keySpacing_ = 1;
   // Base string for varchar fields when making string vector.
   std::string baseString_;
+  // Minimum number of partitions of the parallel join build.
+  uint8_t numParallelBuildPartitions_{0};
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -639,6 +643,37 @@ TEST_P(HashTableTest, structKey) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 1);
 }
 
+TEST_P(HashTableTest, parallelBuildPartitionsOneTable) {
+  auto type =
+      ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
+  keySpacing_ = 1000;
+  numParallelBuildPartitions_ = 8;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 1, type, 1);
+  const auto& stats = topTable_->parallelJoinBuildStats();
+  if (GetParam()) {
+    // The rows of the single table are inserted by 8 threads.
+    ASSERT_EQ(stats.partitionTimings.size(), 1);
+    ASSERT_EQ(stats.buildTimings.size(), 8);
+  } else {
+    ASSERT_TRUE(stats.buildTimings.empty());
+  }
+}
+
+TEST_P(HashTableTest, parallelBuildPartitionsMultipleTables) {
+  auto type =
+      ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
+  keySpacing_ = 1000;
+  numParallelBuildPartitions_ = 8;
+  testCycle(BaseHashTable::HashMode::kHash, 50000, 3, type, 1);
+  const auto& stats = topTable_->parallelJoinBuildStats();
+  if (GetParam()) {
+    ASSERT_EQ(stats.partitionTimings.size(), 3);
+    ASSERT_EQ(stats.buildTimings.size(), 8);
+  } else {
+    ASSERT_TRUE(stats.buildTimings.empty());
+  }
+}
+
 TEST_P(HashTableTest, mixed6Sparse) {
   auto type =
       ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
@@ -1007,6 +1042,46 @@ TEST_P(HashTableTest, checkSizeValidation) {
   ASSERT_EQ(table->capacity(), 512 << 10);
 }
 
+TEST_P(HashTableTest, groupByTableGrowsInPlace) {
+  auto rowType = ROW({"a"}, {BIGINT()});
+  auto table = createHashTableForAggregation(rowType, 1);
+  auto lookup = std::make_unique<HashLookup>(table->hashers(), pool());
+  auto testHelper = HashTableTestHelper<false>::create(table.get());
+
+  // The initial table of 256K entries reserves addresses for 1M entries.
+  testHelper.setHashMode(BaseHashTable::HashMode::kHash, 131'072);
+  ASSERT_EQ(table->capacity(), 256 << 10);
+  auto* const initialTable = table->testingTable();
+
+  int64_t numKeys = 0;
+  auto insertNewKeys = [&](int32_t count) {
+    auto input = makeRowVector({makeFlatVector<int64_t>(
+        count, [&](auto row) { return numKeys + row; })});
+    insertGroups(*input, *lookup, *table);
+    numKeys += count;
+    ASSERT_EQ(table->numDistinct(), numKeys);
+  };
+  insertNewKeys(131'072);
+  insertNewKeys(131'072);
+  ASSERT_EQ(table->capacity(), 512 << 10);
+  ASSERT_EQ(table->testingTable(), initialTable);
+
+  insertNewKeys(262'144);
+  ASSERT_EQ(table->capacity(), 1 << 20);
+  ASSERT_EQ(table->testingTable(), initialTable);
+
+  // Past the reserved addresses the table is allocated anew.
+  insertNewKeys(524'288);
+  ASSERT_EQ(table->capacity(), 2 << 20);
+
+  // The keys are found after the rehashes.
+  auto input = makeRowVector({makeFlatVector<int64_t>(
+      131'072, [&](auto row) { return row * (numKeys / 131'072); })});
+  insertGroups(*input, *lookup, *table);
+  ASSERT_TRUE(lookup->newGroups.empty());
+  ASSERT_EQ(table->numDistinct(), numKeys);
+}
+
 TEST_P(HashTableTest, listNullKeyRows) {
   VectorPtr keys = makeFlatVector<int64_t>(500, folly::identity);
   testListNullKeyRows(keys, BaseHashTable::HashMode::kArray);
@@ -1018,6 +1093,115 @@ TEST_P(HashTableTest, listNullKeyRows) {
   testListNullKeyRows(keys, BaseHashTable::HashMode::kHash);
 }
 
+TEST_P(HashTableTest, keyLayouts) {
+  // Feeds the same keys twice to a table in kHash mode and checks that each
+  // key finds the group made for it the first time. Covers the compare code
+  // specialized for BIGINT and string keys, with nulls and with strings that
+  // are not inlined.
+  auto test = [&](const RowVectorPtr& data) {
+    SCOPED_TRACE(data->type()->toString());
+    std::unordered_set<std::string> keys;
+    for (auto i = 0; i < data->size(); ++i) {
+      keys.insert(data->toString(i));
+    }
+    const int64_t numDistinct = keys.size();
+    auto table =
+        createHashTableForAggregation(data->type(), data->type()->size());
+    table->forceGenericHashMode(BaseHashTable::kNoSpillInputStartPartitionBit);
+    auto lookup = std::make_unique<HashLookup>(table->hashers(), pool());
+    insertGroups(*data, *lookup, *table);
+    ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+    ASSERT_EQ(table->numDistinct(), numDistinct);
+    const std::vector<char*> groups(
+        lookup->hits.begin(), lookup->hits.begin() + data->size());
+
+    insertGroups(*data, *lookup, *table);
+    ASSERT_EQ(table->numDistinct(), numDistinct);
+    for (auto i = 0; i < data->size(); ++i) {
+      ASSERT_EQ(lookup->hits[i], groups[i]) << i;
+    }
+  };
+
+  const vector_size_t size = 10'000;
+  auto bigints = makeFlatVector<int64_t>(
+      size, [](auto row) { return row % 1'000; }, nullEvery(7));
+  auto otherBigints =
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 3; });
+  auto strings = makeFlatVector<std::string>(
+      size,
+      [](auto row) {
+        return std::string(row % 3 == 0 ? 20 : 2, 'x') +
+            std::to_string(row % 1'000);
+      },
+      nullEvery(11));
+
+  test(makeRowVector({bigints}));
+  test(makeRowVector({bigints, otherBigints}));
+  test(makeRowVector({strings}));
+  test(makeRowVector({bigints, otherBigints, strings}));
+}
+
+TEST_P(HashTableTest, keySet) {
+  auto makeTable = [&](const std::vector<TypePtr>& dependentTypes) {
+    std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+    keyHashers.emplace_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+    auto table = HashTable<true>::createForJoin(
+        std::move(keyHashers), dependentTypes, false, false, 1'000, pool());
+    std::vector<TypePtr> types{BIGINT()};
+    types.insert(types.end(), dependentTypes.begin(), dependentTypes.end());
+    std::vector<VectorPtr> children;
+    for (const auto& type : types) {
+      children.push_back(
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row * 2; }));
+    }
+    copyVectorsToTable({makeRowVector(children)}, 0, table.get());
+    table->prepareJoinTable(
+        {},
+        BaseHashTable::kNoSpillInputStartPartitionBit,
+        1'000'000,
+        true,
+        executor_.get());
+    EXPECT_EQ(table->hashMode(), BaseHashTable::HashMode::kArray);
+    return table;
+  };
+
+  // A table with dependent columns needs its rows.
+  auto table = makeTable({BIGINT()});
+  ASSERT_FALSE(table->convertToKeySet());
+  ASSERT_FALSE(table->isKeySet());
+
+  table = makeTable({});
+  ASSERT_TRUE(table->convertToKeySet());
+  ASSERT_TRUE(table->isKeySet());
+  ASSERT_FALSE(table->convertToKeySet());
+  ASSERT_EQ(table->numDistinct(), 1'000U);
+  ASSERT_EQ(table->rows()->numRows(), 0);
+
+  const vector_size_t numProbes = 2'000;
+  auto probe = makeFlatVector<int64_t>(numProbes, [](auto row) { return row; });
+  auto lookup = std::make_unique<HashLookup>(table->hashers(), pool());
+  lookup->reset(numProbes);
+  SelectivityVector rows(numProbes);
+  VectorHasher::ScratchMemory scratchMemory;
+  table->hashers()[0]->lookupValueIds(
+      *probe, rows, scratchMemory, lookup->hashes);
+  constexpr int32_t kPadding = simd::kPadding / sizeof(int32_t);
+  lookup->rows.resize(bits::roundUp(numProbes + kPadding, kPadding));
+  const auto numRows = simd::indicesOfSetBits(
+      rows.asRange().bits(), 0, numProbes, lookup->rows.data());
+  lookup->rows.resize(numRows);
+  // 1999 is out of the key range.
+  ASSERT_EQ(numRows, numProbes - 1);
+  table->joinProbe(*lookup);
+  for (auto row : lookup->rows) {
+    ASSERT_EQ(lookup->hits[row] != nullptr, row % 2 == 0) << row;
+  }
+
+  table->clear(true);
+  ASSERT_FALSE(table->isKeySet());
+  ASSERT_EQ(table->numDistinct(), 0);
+}
+
 TEST(HashTableTest, modeString) {
   ASSERT_EQ("HASH", BaseHashTable::modeString(BaseHashTable::HashMode::kHash));
   ASSERT_EQ(
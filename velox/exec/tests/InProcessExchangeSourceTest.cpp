@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/exec/ExchangeClient.h"
+#include "velox/exec/Task.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/SerializedPageUtil.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+class InProcessExchangeSourceTest : public testing::Test,
+                                    public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+    if (!isRegisteredNamedVectorSerde(VectorSerde::Kind::kPresto)) {
+      serializer::presto::PrestoVectorSerde::registerNamedVectorSerde();
+    }
+  }
+
+  void SetUp() override {
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+    ExchangeSource::factories().clear();
+    ExchangeSource::registerFactory(InProcessExchangeSource::create);
+    bufferManager_ = OutputBufferManager::getInstanceRef();
+    consumerPool_ = rootPool_->addLeafChild("consumer");
+  }
+
+  std::shared_ptr<Task> makeTask(const std::string& taskId) {
+    auto queryCtx = core::QueryCtx::create(executor_.get());
+    queryCtx->testingOverrideMemoryPool(
+        memory::memoryManager()->addRootPool(queryCtx->queryId()));
+    auto plan = test::PlanBuilder().values({}).planNode();
+    return Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        std::move(queryCtx),
+        Task::ExecutionMode::kParallel,
+        Consumer{});
+  }
+
+  void enqueue(
+      const std::string& taskId,
+      int32_t destination,
+      const RowVectorPtr& data) {
+    ContinueFuture unused;
+    bufferManager_->enqueue(
+        taskId,
+        destination,
+        test::toSerializedPage(
+            data, VectorSerde::Kind::kPresto, bufferManager_, pool()),
+        &unused);
+  }
+
+  std::unique_ptr<SerializedPageBase> next(ExchangeClient& client) {
+    bool atEnd{false};
+    ContinueFuture future;
+    auto pages = client.next(0, 1, &atEnd, &future);
+    while (!atEnd && pages.empty()) {
+      std::move(future).wait();
+      pages = client.next(0, 1, &atEnd, &future);
+    }
+    if (atEnd) {
+      EXPECT_TRUE(pages.empty());
+      return nullptr;
+    }
+    EXPECT_EQ(pages.size(), 1);
+    return std::move(pages[0]);
+  }
+
+  RowVectorPtr deserialize(SerializedPageBase& page, const RowTypePtr& type) {
+    auto input = page.prepareStreamForDeserialize();
+    RowVectorPtr result;
+    getNamedVectorSerde(VectorSerde::Kind::kPresto)
+        ->deserialize(input.get(), pool(), type, &result, nullptr);
+    return result;
+  }
+
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::shared_ptr<OutputBufferManager> bufferManager_;
+  std::shared_ptr<memory::MemoryPool> consumerPool_;
+};
+
+TEST_F(InProcessExchangeSourceTest, create) {
+  auto queue = std::make_shared<ExchangeQueue>(1, 0);
+  EXPECT_EQ(
+      InProcessExchangeSource::create("local://t1", 0, queue, pool()),
+      nullptr);
+  EXPECT_EQ(InProcessExchangeSource::remoteTaskId("t1"), "inprocess://t1");
+  EXPECT_NE(
+      InProcessExchangeSource::create("inprocess://t1", 0, queue, pool()),
+      nullptr);
+}
+
+TEST_F(InProcessExchangeSourceTest, fetch) {
+  const std::string taskId = "inProcessProducer";
+  auto task = makeTask(taskId);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 2, 1);
+
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 3; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i; }),
+        makeFlatVector<std::string>(
+            1'000, [](auto row) { return fmt::format("value {}", row); }),
+    }));
+    enqueue(taskId, 1, data.back());
+  }
+  bufferManager_->noMoreData(taskId);
+
+  auto client = std::make_shared<ExchangeClient>(
+      "consumer", 1, 1 << 20, 1, 0, consumerPool_.get(), executor_.get());
+  client->addRemoteTaskId(InProcessExchangeSource::remoteTaskId(taskId));
+  client->noMoreRemoteTasks();
+
+  std::vector<std::unique_ptr<SerializedPageBase>> pages;
+  uint64_t pageBytes{0};
+  for (auto i = 0; i < data.size(); ++i) {
+    pages.push_back(next(*client));
+    ASSERT_NE(pages.back(), nullptr);
+    pageBytes += pages.back()->size();
+  }
+  EXPECT_EQ(next(*client), nullptr);
+
+  // The pages are owned by the consumer's pool.
+  EXPECT_GE(consumerPool_->usedBytes(), pageBytes);
+  for (auto i = 0; i < data.size(); ++i) {
+    test::assertEqualVectors(
+        data[i], deserialize(*pages[i], asRowType(data[i]->type())));
+  }
+
+  const auto metrics = client->stats();
+  EXPECT_EQ(metrics.at("inProcessExchangeSource.numPages").sum, data.size());
+  EXPECT_EQ(metrics.at("inProcessExchangeSource.totalBytes").sum, pageBytes);
+
+  client->close();
+  pages.clear();
+  EXPECT_EQ(consumerPool_->usedBytes(), 0);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
+TEST_F(InProcessExchangeSourceTest, producerNotCreated) {
+  auto queue = std::make_shared<ExchangeQueue>(1, 0);
+  auto source = InProcessExchangeSource::create(
+      "inprocess://notCreated", 0, queue, pool());
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    ASSERT_TRUE(source->shouldRequestLocked());
+  }
+  const auto response =
+      source->request(1 << 20, std::chrono::milliseconds(10)).get();
+  EXPECT_EQ(response.bytes, 0);
+  EXPECT_FALSE(response.atEnd);
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    EXPECT_TRUE(source->shouldRequestLocked());
+  }
+  source->close();
+}
+
+} // namespace
+} // namespace facebook::velox::exec
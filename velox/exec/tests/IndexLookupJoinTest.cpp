@@ -3056,6 +3056,105 @@ TEST_P(IndexLookupJoinTest, tableRowsWithDuplicateKeys) {
       "SELECT u.c0, u.c1, u.c2, u.c3, u.c4, u.c5 FROM t, u WHERE t.c0 = u.c0 AND t.c1 = u.c1 AND u.c2 = t.c2");
 }
 
+TEST_P(IndexLookupJoinTest, dedupCacheAndMergeInput) {
+  IndexTableData tableData;
+  generateIndexTableData({10, 1, 1}, tableData, pool_);
+  // Probe mostly repeated keys in many small batches so that deduplication,
+  // caching and input merging all kick in.
+  const auto probeVectors = generateProbeInput(
+      20, 16, 1, tableData, pool_, {"t0", "t1", "t2"}, false, {}, {}, 100);
+  std::vector<std::shared_ptr<TempFilePath>> probeFiles =
+      createProbeFiles(probeVectors);
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", {tableData.tableVectors});
+
+  const auto indexTable = TestIndexTable::create(
+      /*numEqualJoinKeys=*/3,
+      tableData.keyVectors,
+      tableData.valueVectors,
+      *pool());
+  const auto indexTableHandle = makeIndexTableHandle(
+      indexTable, GetParam().asyncLookup, GetParam().needsIndexSplit);
+
+  struct {
+    bool dedupKeys;
+    uint64_t cacheMaxBytes;
+    uint32_t minBatchRows;
+
+    std::string debugString() const {
+      return fmt::format(
+          "dedupKeys: {}, cacheMaxBytes: {}, minBatchRows: {}",
+          dedupKeys,
+          cacheMaxBytes,
+          minBatchRows);
+    }
+  } testSettings[] = {
+      {true, 0, 0},
+      {false, 1 << 20, 0},
+      {false, 0, 64},
+      {true, 1 << 20, 64},
+      {true, 1, 0}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    const auto indexScanNode = makeIndexScanNode(
+        planNodeIdGenerator,
+        indexTableHandle,
+        makeScanOutputType({"u0", "u1", "u2", "u5"}),
+        makeIndexColumnHandles({"u0", "u1", "u2", "u5"}));
+    auto plan = makeLookupPlan(
+        planNodeIdGenerator,
+        indexScanNode,
+        {"t0", "t1", "t2"},
+        {"u0", "u1", "u2"},
+        {},
+        /*filter=*/"",
+        /*hasMarker=*/false,
+        core::JoinType::kLeft,
+        {"t4", "u5"});
+    AssertQueryBuilder queryBuilder(duckDbQueryRunner_);
+    queryBuilder.plan(plan)
+        .config(
+            core::QueryConfig::kIndexLookupJoinMaxPrefetchBatches,
+            std::to_string(GetParam().numPrefetches))
+        .config(
+            core::QueryConfig::kIndexLookupJoinDedupKeys,
+            testData.dedupKeys ? "true" : "false")
+        .config(
+            core::QueryConfig::kIndexLookupJoinCacheMaxBytes,
+            std::to_string(testData.cacheMaxBytes))
+        .config(
+            core::QueryConfig::kIndexLookupJoinMinBatchRows,
+            std::to_string(testData.minBatchRows))
+        .splits(probeScanNodeId_, makeHiveConnectorSplits(probeFiles))
+        .serialExecution(GetParam().serialExecution)
+        .barrierExecution(GetParam().serialExecution);
+    if (GetParam().needsIndexSplit) {
+      queryBuilder.split(
+          indexScanNodeId_,
+          Split(
+              std::make_shared<TestIndexConnectorSplit>(
+                  kTestIndexConnectorName)));
+    }
+    const auto task = queryBuilder.assertResults(
+        "SELECT t.c4, u.c5 FROM t LEFT JOIN u ON t.c0 = u.c0 AND t.c1 = u.c1 AND t.c2 = u.c2");
+
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(joinNodeId_).customStats;
+    ASSERT_EQ(
+        runtimeStats.count(IndexLookupJoin::kNumDedupedLookupKeys) > 0,
+        testData.dedupKeys || testData.cacheMaxBytes > 0);
+    ASSERT_EQ(
+        runtimeStats.count(IndexLookupJoin::kNumLookupCacheHits) > 0,
+        testData.cacheMaxBytes > 1);
+    ASSERT_EQ(
+        runtimeStats.count(IndexLookupJoin::kNumMergedInputBatches) > 0,
+        testData.minBatchRows > 0);
+  }
+}
+
 TEST_P(IndexLookupJoinTest, withFilter) {
   struct {
     std::vector<int> keyCardinalities;
@@ -1179,6 +1179,98 @@ TEST_F(LocalPartitionTest, vectorPool) {
   ASSERT_FALSE(vectorPool.pop());
 }
 
+TEST_F(LocalPartitionTest, memoryManager) {
+  LocalExchangeMemoryManager memoryManager(100);
+  ContinueFuture future;
+  ASSERT_FALSE(memoryManager.increaseMemoryUsage(&future, 60));
+  ASSERT_FALSE(future.valid());
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(10).empty());
+
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&future, 60));
+  ASSERT_TRUE(future.valid());
+  ASSERT_EQ(memoryManager.bufferedBytes(), 110);
+  // Still at the limit.
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(10).empty());
+  ASSERT_FALSE(future.isReady());
+
+  auto promises = memoryManager.decreaseMemoryUsage(1);
+  ASSERT_EQ(promises.size(), 1);
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  ASSERT_TRUE(future.isReady());
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(99).empty());
+  ASSERT_EQ(memoryManager.bufferedBytes(), 0);
+}
+
+TEST_F(LocalPartitionTest, queueCoalescing) {
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(1 << 20);
+  LocalExchangeQueue queue(
+      memoryManager, std::make_shared<LocalExchangeVectorPool>(1 << 20), 0);
+  queue.addProducer();
+  queue.noMoreProducers();
+
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({makeFlatSequence<int32_t>(i * 10, 10)}));
+    ContinueFuture future;
+    ASSERT_EQ(
+        queue.enqueue(vectors.back(), 100, &future),
+        BlockingReason::kNotBlocked);
+  }
+  ASSERT_EQ(memoryManager->bufferedBytes(), 1'000);
+
+  // Up to 3 queued vectors are copied into one, the last vector is returned
+  // as is.
+  int32_t start = 0;
+  for (const auto expectedSize : {30, 30, 30, 10}) {
+    ContinueFuture future;
+    RowVectorPtr data;
+    bool drained{false};
+    ASSERT_EQ(
+        queue.next(&future, pool(), &data, drained, 35),
+        BlockingReason::kNotBlocked);
+    ASSERT_NE(data, nullptr);
+    assertEqualVectors(
+        makeRowVector({makeFlatSequence<int32_t>(start, expectedSize)}), data);
+    ASSERT_EQ(data == vectors.back(), expectedSize == 10);
+    start += expectedSize;
+  }
+  ASSERT_EQ(memoryManager->bufferedBytes(), 0);
+
+  queue.noMoreData();
+  ASSERT_TRUE(queue.isFinished());
+}
+
+TEST_F(LocalPartitionTest, coalesceOutputBatches) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 100; ++i) {
+    vectors.push_back(makeRowVector({makeFlatSequence<int32_t>(i * 10, 10)}));
+  }
+  createDuckDbTable(vectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto valuesNode = [&](int start) {
+    return PlanBuilder(planNodeIdGenerator)
+        .values(std::vector<RowVectorPtr>(
+            vectors.begin() + start, vectors.begin() + start + 50))
+        .planNode();
+  };
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .localPartition({}, {valuesNode(0), valuesNode(50)})
+                  .planNode();
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+                  .config(
+                      core::QueryConfig::kLocalExchangeCoalesceOutputBatches,
+                      "true")
+                  .assertResults("SELECT * FROM tmp");
+  auto stats = task->taskStats().pipelineStats[0].operatorStats.front();
+  ASSERT_EQ(stats.inputPositions, 1'000);
+  ASSERT_LE(stats.inputVectors, 100);
+}
+
 TEST_F(LocalPartitionTest, barrier) {
   const auto rowType = ROW({"c0"}, {BIGINT()});
   std::vector<RowVectorPtr> vectors;
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include "velox/exec/MarkDistinct.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -141,3 +143,83 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, reuseUpstreamMarker) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 7; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 11; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 13; }),
+  });
+
+  createDuckDbTable({data});
+
+  // The third MarkDistinct uses the same key set as the first one and derives
+  // its marker from it.
+  auto plan =
+      PlanBuilder()
+          .values({data, data})
+          .markDistinct("m1", {"c0", "c1"})
+          .markDistinct("m2", {"c0", "c2"})
+          .markDistinct("m3", {"c1", "c0"})
+          .singleAggregation(
+              {"c0"}, {"sum(c1)", "sum(c2)", "count(c1)"}, {"m1", "m2", "m3"})
+          .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .assertResults(
+              "SELECT c0, sum(distinct c1), sum(distinct c2), count(distinct c1) FROM tmp GROUP BY 1");
+
+  const auto& operatorStats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(operatorStats.size(), 5);
+  auto countReused = [&](const core::PlanNodePtr& node) {
+    const auto& runtimeStats = operatorStats.at(node->id()).customStats;
+    auto it = runtimeStats.find(exec::MarkDistinct::kReusedMarker);
+    return it == runtimeStats.end() ? 0 : it->second.count;
+  };
+  auto markDistinct = plan->sources()[0];
+  ASSERT_EQ(countReused(markDistinct), 1);
+  ASSERT_EQ(countReused(markDistinct->sources()[0]), 0);
+  ASSERT_EQ(countReused(markDistinct->sources()[0]->sources()[0]), 0);
+}
+
+TEST_F(MarkDistinctTest, reuseRowNumber) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 17; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+  });
+
+  createDuckDbTable({data});
+
+  for (const auto& limit : std::vector<std::optional<int32_t>>{
+           std::nullopt, 1, 5}) {
+    SCOPED_TRACE(limit.has_value() ? std::to_string(limit.value()) : "none");
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .rowNumber({"c0"}, limit)
+                    .markDistinct("m", {"c0"})
+                    .project({"c0", "m"})
+                    .planNode();
+
+    auto result = AssertQueryBuilder(plan).copyResults(pool());
+    auto markers = result->childAt(1)->asFlatVector<bool>();
+    vector_size_t numDistinct = 0;
+    for (auto i = 0; i < result->size(); ++i) {
+      numDistinct += markers->valueAt(i);
+    }
+    ASSERT_EQ(numDistinct, 17);
+
+    // The partition keys must match the distinct keys exactly.
+    plan = PlanBuilder()
+               .values({data})
+               .rowNumber({"c0"}, limit)
+               .markDistinct("m", {"c0", "c1"})
+               .singleAggregation({"c0"}, {"count(c1)"}, {"m"})
+               .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .assertResults(fmt::format(
+            "SELECT c0, count(distinct c1) FROM (SELECT * FROM (SELECT *, row_number() over (partition by c0) as rn FROM tmp) {}) GROUP BY 1",
+            limit.has_value() ? fmt::format("WHERE rn <= {}", limit.value())
+                              : ""));
+  }
+}
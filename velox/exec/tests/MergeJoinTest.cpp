@@ -889,6 +889,84 @@ TEST_F(MergeJoinTest, numDrivers) {
   EXPECT_EQ(2, task->numFinishedDrivers());
 }
 
+TEST_F(MergeJoinTest, partitionedInputs) {
+  // Both inputs are sorted on (c0, c1). Most keys on the left side have no
+  // match on the right side and vice versa.
+  std::vector<RowVectorPtr> left;
+  std::vector<RowVectorPtr> right;
+  for (auto i = 0; i < 5; ++i) {
+    left.push_back(makeRowVector(
+        {"t_c0", "t_c1"},
+        {
+            makeFlatVector<int64_t>(
+                1'000, [&](auto row) { return (i * 1'000 + row) / 3; }),
+            makeFlatVector<int32_t>(1'000, [](auto row) { return row % 3; }),
+        }));
+    right.push_back(makeRowVector(
+        {"u_c0", "u_c1"},
+        {
+            makeFlatVector<int64_t>(
+                500, [&](auto row) { return (i * 500 + row) * 7; }),
+            makeFlatVector<int32_t>(500, [](auto row) { return row % 2; }),
+        }));
+  }
+  createDuckDbTable("t", left);
+  createDuckDbTable("u", right);
+
+  struct {
+    std::vector<std::string> leftKeys;
+    std::vector<std::string> rightKeys;
+    std::string condition;
+  } testSettings[] = {
+      {{"t_c0"}, {"u_c0"}, "t_c0 = u_c0"},
+      {{"t_c0", "t_c1"},
+       {"u_c0", "u_c1"},
+       "t_c0 = u_c0 AND t_c1 = u_c1"},
+  };
+  for (const auto& testData : testSettings) {
+    for (const auto joinType :
+         {core::JoinType::kInner,
+          core::JoinType::kLeft,
+          core::JoinType::kRight,
+          core::JoinType::kFull}) {
+      SCOPED_TRACE(
+          fmt::format(
+              "{}, {}",
+              testData.condition,
+              core::JoinTypeName::toName(joinType)));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values(left)
+                      .localPartition(testData.leftKeys)
+                      .mergeJoin(
+                          testData.leftKeys,
+                          testData.rightKeys,
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(right)
+                              .localPartition(testData.rightKeys)
+                              .planNode(),
+                          "",
+                          {"t_c0", "t_c1", "u_c0", "u_c1"},
+                          joinType)
+                      .planNode();
+
+      auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                      .maxDrivers(4)
+                      .assertResults(
+                          fmt::format(
+                              "SELECT t_c0, t_c1, u_c0, u_c1 FROM t {} JOIN u "
+                              "ON {}",
+                              core::JoinTypeName::toName(joinType),
+                              testData.condition));
+
+      // The pipelines producing the partitioned inputs run single-threaded.
+      // The merge join and its right side pipeline run one driver per
+      // partition.
+      EXPECT_EQ(10, task->numTotalDrivers());
+    }
+  }
+}
+
 TEST_F(MergeJoinTest, lazyVectors) {
   // A dataset of multiple row groups with multiple columns. We create
   // different dictionary wrappings for different columns and load the
@@ -19,6 +19,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/RangePartitionFunction.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -819,6 +820,90 @@ TEST_F(MergeTest, localMerge) {
   testTwoKeys(vectors, "c3", "c0");
 }
 
+TEST_F(MergeTest, localMergeRangePartitioned) {
+  // Range partitions the input, sorts the partitions in parallel and merges
+  // the sorted runs. The runs hold disjoint key ranges, so the merge passes
+  // their batches through.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return (i * 1'000 + row) * 7'919 % 10'000; }),
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return i; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto partitionFunctionSpec = std::make_shared<RangePartitionFunctionSpec>(
+      asRowType(vectors[0]->type()),
+      std::vector<column_index_t>{0},
+      std::vector<core::SortOrder>{core::kAscNullsLast},
+      makeRowVector({makeFlatVector<int64_t>({2'500, 5'000, 7'500})}));
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto sorted = PlanBuilder(planNodeIdGenerator)
+                    .values(vectors)
+                    .addNode([&](auto nodeId, auto source) {
+                      return std::make_shared<core::LocalPartitionNode>(
+                          nodeId,
+                          core::LocalPartitionNode::Type::kRepartition,
+                          /*scaleWriter=*/false,
+                          partitionFunctionSpec,
+                          std::vector<core::PlanNodePtr>{source});
+                    })
+                    .orderBy({"c0"}, true)
+                    .planNode();
+  core::PlanNodeId localMergeNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .localMerge({"c0"}, {sorted})
+                  .capturePlanNodeId(localMergeNodeId)
+                  .planNode();
+
+  CursorParameters params;
+  params.planNode = plan;
+  params.maxDrivers = 4;
+  params.queryCtx =
+      createQueryCtx({{core::QueryConfig::kPreferredOutputBatchRows, "500"}});
+  auto task = assertQueryOrdered(params, "SELECT * FROM tmp ORDER BY c0", {0});
+
+  const auto mergeStats = toPlanStats(task->taskStats()).at(localMergeNodeId);
+  ASSERT_EQ(mergeStats.outputRows, 10'000);
+  ASSERT_EQ(mergeStats.outputVectors, 20);
+}
+
+TEST_F(MergeTest, localMergePrefixKeys) {
+  // The first sorting key of these types is compared by its prefix encoding.
+  // Duplicate keys check that the ties are broken by the second key.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    static constexpr vector_size_t kBatchSize = 100;
+    auto c0 = makeFlatVector<int16_t>(
+        kBatchSize,
+        [&](auto row) { return (row * 7 + i) % 23 - 11; },
+        nullEvery(7));
+    auto c1 = makeFlatVector<float>(
+        kBatchSize,
+        [&](auto row) { return row % 3 == 0 ? -0.0 : (row % 13) * -0.5; },
+        nullEvery(9));
+    auto c2 = makeFlatVector<Timestamp>(
+        kBatchSize,
+        [&](auto row) {
+          return Timestamp(row % 17 - 8, (row * 13) % 1'000 * 1'000);
+        },
+        nullEvery(6));
+    auto c3 = makeFlatVector<int32_t>(
+        kBatchSize, [&](auto row) { return kBatchSize * i + row; });
+    vectors.push_back(makeRowVector({c0, c1, c2, c3}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c0");
+  testTwoKeys(vectors, "c0", "c3");
+  testTwoKeys(vectors, "c1", "c3");
+  testTwoKeys(vectors, "c2", "c3");
+}
+
 DEBUG_ONLY_TEST_F(MergeTest, localMergeStart) {
   const auto data1 = makeRowVector({
       makeFlatVector<int64_t>({0, 1, 10}),
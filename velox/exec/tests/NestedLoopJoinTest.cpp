@@ -16,6 +16,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -688,6 +689,144 @@ TEST_F(NestedLoopJoinTest, leftSemiJoinWithNullsAndFilter) {
   assertEqualVectors(expected, result);
 }
 
+TEST_F(NestedLoopJoinTest, rangeKey) {
+  auto probeVectors = makeRowVector(
+      {"t0", "t1"},
+      {
+          makeNullableFlatVector<int64_t>(
+              {20, 3, std::nullopt, 75, 120, 50, 51, 0, 99, 64}),
+          makeFlatVector<StringView>(
+              {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"}),
+      });
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 3; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {
+            makeFlatVector<int64_t>(
+                30,
+                [&](auto row) { return (row * 7 + i * 13) % 100; },
+                [](auto row) { return row % 11 == 5; }),
+            makeFlatVector<StringView>(
+                30, [](auto row) { return row % 2 ? "b" : "g"; }),
+        }));
+  }
+  createDuckDbTable("t", {probeVectors});
+  createDuckDbTable("u", buildVectors);
+
+  // Every condition compares a probe and a build column with <, <=, > or >=,
+  // so that only part of the build rows are evaluated for each probe row.
+  const std::vector<std::string> conditions{
+      "t0 < u0",
+      "u0 <= t0",
+      "t0 between u0 - 10 and u0",
+      "t0 > u0 and t1 < u1",
+      "t0 >= u0 and t0 < u0 + 5",
+  };
+  const std::vector<core::JoinType> joinTypes{
+      core::JoinType::kInner,
+      core::JoinType::kLeft,
+      core::JoinType::kRight,
+      core::JoinType::kFull,
+  };
+  for (const auto& condition : conditions) {
+    for (const auto joinType : joinTypes) {
+      SCOPED_TRACE(
+          fmt::format(
+              "condition: {}, joinType: {}",
+              condition,
+              core::JoinTypeName::toName(joinType)));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      core::PlanNodeId joinNodeId;
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values({probeVectors})
+                      .nestedLoopJoin(
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(buildVectors)
+                              .planNode(),
+                          condition,
+                          {"t0", "t1", "u0", "u1"},
+                          joinType)
+                      .capturePlanNodeId(joinNodeId)
+                      .planNode();
+      auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                      .assertResults(
+                          fmt::format(
+                              "SELECT t0, t1, u0, u1 FROM t {} JOIN u ON {}",
+                              core::JoinTypeName::toName(joinType),
+                              condition));
+      auto planStats = toPlanStats(task->taskStats());
+      ASSERT_GT(
+          planStats.at(joinNodeId)
+              .customStats.at("rangeJoinSkippedBuildRows")
+              .sum,
+          0);
+    }
+  }
+}
+
+TEST_F(NestedLoopJoinTest, filterTiles) {
+  // Many probe rows against a small build vector so that the join condition
+  // is evaluated over tiles of probe rows that span multiple output batches.
+  auto probeVectors = makeRowVector(
+      {"t0", "t1"},
+      {
+          makeFlatVector<int64_t>(
+              1'000, [](auto row) { return row; }, nullEvery(13)),
+          makeFlatVector<StringView>(
+              1'000, [](auto row) { return row % 3 ? "a" : "b"; }),
+      });
+  auto buildVectors = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>(
+              7, [](auto row) { return row; }, nullEvery(5)),
+          makeFlatVector<StringView>(
+              7, [](auto row) { return row % 2 ? "a" : "b"; }),
+      });
+  createDuckDbTable("t", {probeVectors});
+  createDuckDbTable("u", {buildVectors});
+
+  const std::vector<std::string> conditions{
+      "t0 % 7 = u0",
+      "t0 % 7 = u0 or t1 = u1",
+      "t0 + u0 = 100",
+  };
+  const std::vector<core::JoinType> joinTypes{
+      core::JoinType::kInner,
+      core::JoinType::kLeft,
+      core::JoinType::kRight,
+      core::JoinType::kFull,
+  };
+  for (const auto& condition : conditions) {
+    for (const auto joinType : joinTypes) {
+      SCOPED_TRACE(
+          fmt::format(
+              "condition: {}, joinType: {}",
+              condition,
+              core::JoinTypeName::toName(joinType)));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values({probeVectors})
+                      .nestedLoopJoin(
+                          PlanBuilder(planNodeIdGenerator)
+                              .values({buildVectors})
+                              .planNode(),
+                          condition,
+                          {"t0", "t1", "u0", "u1"},
+                          joinType)
+                      .planNode();
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "64")
+          .assertResults(
+              fmt::format(
+                  "SELECT t0, t1, u0, u1 FROM t {} JOIN u ON {}",
+                  core::JoinTypeName::toName(joinType),
+                  condition));
+    }
+  }
+}
+
 TEST_F(NestedLoopJoinTest, mergeBuildVectorsOverflow) {
   const std::vector<RowVectorPtr> buildVectors = {
       makeRowVector({makeFlatVector<int64_t>({1, 2})})};
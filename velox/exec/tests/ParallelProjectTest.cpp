@@ -14,9 +14,13 @@
  * limitations under the License.
  */
 
+#include "velox/common/testutil/TestValue.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
+using facebook::velox::common::testutil::TestValue;
+
 namespace facebook::velox::exec {
 namespace {
 
@@ -44,5 +48,44 @@ TEST_F(ParallelProjectTest, basic) {
   assertQuery(plan, "SELECT c0 + 1, c0 * 2, c1 + 10, c1 * 3 FROM tmp");
 }
 
+TEST_F(ParallelProjectTest, morsels) {
+  TestValue::enable();
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 5; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 1000 + row; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [&](auto row) { return fmt::format("string {}", i * 1000 + row); },
+            nullEvery(7)),
+    }));
+  }
+  createDuckDbTable(data);
+
+  // Makes the exprs look expensive so that the batches after the first are
+  // split into the maximum number of morsels.
+  int32_t numCalls{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::ParallelProject::numMorsels",
+      std::function<void(uint64_t*)>([&](uint64_t* nanosPerRow) {
+        if (*nanosPerRow > 0) {
+          *nanosPerRow = 1'000'000;
+        }
+        ++numCalls;
+      }));
+
+  auto plan = test::PlanBuilder()
+                  .values(data)
+                  .parallelProject(
+                      {{"c0 + 1", "c0 * 2"}, {"upper(c1)", "length(c1)"}})
+                  .planNode();
+
+  test::AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kParallelProjectMaxMorsels, 3)
+      .assertResults("SELECT c0 + 1, c0 * 2, upper(c1), length(c1) FROM tmp");
+  ASSERT_EQ(numCalls, 2 * data.size());
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -236,6 +236,14 @@ TEST_F(PlanNodeSerdeTest, exchange) {
                     .planNode();
     testSerde(plan);
   }
+
+  auto plan = PlanBuilder()
+                  .exchange(
+                      ROW({"a"}, {BIGINT()}),
+                      VectorSerde::Kind::kPresto,
+                      /*broadcast=*/true)
+                  .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, filter) {
@@ -42,7 +42,8 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      uint32_t minNumRadixSortRows = 1024) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -68,7 +69,8 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
             1024,
             // Set threshold to 0 to enable prefix-sort in small dataset.
             0,
-            12},
+            12,
+            minNumRadixSortRows},
         sortPool.get());
     const auto beforeBytes = sortPool->peakBytes();
     ASSERT_EQ(sortPool->peakBytes(), 0);
@@ -80,7 +82,8 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
             1024,
             // Set threshold to 0 to enable prefix-sort in small dataset.
             0,
-            12},
+            12,
+            minNumRadixSortRows},
         sortPool.get(),
         rows);
     ASSERT_GE(maxBytes, sortPool->peakBytes() - beforeBytes);
@@ -331,6 +334,48 @@ TEST_F(PrefixSortTest, fuzzMulti) {
   runFuzzTest(0.0);
 }
 
+TEST_F(PrefixSortTest, radixSort) {
+  const uint32_t kNoRadixSort = std::numeric_limits<uint32_t>::max();
+  const std::vector<TypePtr> keyTypes = {
+      TINYINT(), SMALLINT(), INTEGER(), BIGINT(), DATE(), REAL(), DOUBLE()};
+  for (const auto nullRatio : {0.0, 0.1}) {
+    VectorFuzzer fuzzer({.vectorSize = 1'000, .nullRatio = nullRatio}, pool());
+    for (const auto& type : keyTypes) {
+      SCOPED_TRACE(fmt::format("{}, {}", type->toString(), nullRatio));
+      const auto data = fuzzer.fuzzRow(ROW({type, VARCHAR()}));
+      testPrefixSort({kAsc}, data, 0);
+      testPrefixSort({kDesc}, data, 0);
+      testPrefixSort({kAsc}, data, kNoRadixSort);
+    }
+
+    // Two keys that take up to 16 bytes.
+    const auto data = fuzzer.fuzzRow(ROW({INTEGER(), BIGINT(), VARCHAR()}));
+    testPrefixSort({kAsc, kDesc}, data, 0);
+    testPrefixSort({kDesc, kAsc}, data, 0);
+  }
+
+  // Few distinct values so that most key bytes are the same in all rows.
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return (row * 7) % 3 - 1; }, nullEvery(11)),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 5; }),
+  });
+  testPrefixSort({kAsc, kAsc}, data, 0);
+  testPrefixSort({kDesc, kDesc}, data, 0);
+
+  // Radix sort needs a second buffer as large as the prefix buffer.
+  RowContainer rowContainer({BIGINT()}, pool_.get());
+  storeRows(1'000, makeRowVector({data->childAt(0)}), &rowContainer);
+  const auto radixSortBytes = PrefixSort::maxRequiredBytes(
+      &rowContainer, {kAsc}, common::PrefixSortConfig{1024, 0, 12, 0}, pool());
+  const auto quickSortBytes = PrefixSort::maxRequiredBytes(
+      &rowContainer,
+      {kAsc},
+      common::PrefixSortConfig{1024, 0, 12, kNoRadixSort},
+      pool());
+  ASSERT_GT(radixSortBytes, quickSortBytes);
+}
+
 TEST_F(PrefixSortTest, checkMaxNormalizedKeySizeForMultipleKeys) {
   // Test the normalizedKeySize doesn't exceed the MaxNormalizedKeySize.
   // The normalizedKeySize for BIGINT should be 8 + 1.
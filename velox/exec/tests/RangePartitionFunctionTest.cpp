@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RangePartitionFunction.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook;
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class RangePartitionFunctionTest : public velox::test::VectorTestBase,
+                                   public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+};
+
+TEST_F(RangePartitionFunctionTest, singleKey) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<int64_t>(
+          {5, 10, std::nullopt, 19, 20, 21, 30, 50, -3}),
+      makeFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6, 7, 8}),
+  });
+  auto splitPoints = makeRowVector({makeFlatVector<int64_t>({10, 20, 30})});
+
+  // Ascending, nulls last. Keys equal to a split point go to the next
+  // partition.
+  {
+    RangePartitionFunction function(
+        4, {0}, {core::kAscNullsLast}, splitPoints);
+    std::vector<uint32_t> partitions;
+    ASSERT_FALSE(function.partition(*data, partitions).has_value());
+    ASSERT_EQ(partitions, (std::vector<uint32_t>{0, 1, 3, 1, 2, 2, 3, 3, 0}));
+  }
+
+  // Descending, nulls first. The split points are in descending order.
+  {
+    auto descendingSplitPoints =
+        makeRowVector({makeFlatVector<int64_t>({30, 20, 10})});
+    RangePartitionFunction function(
+        4, {0}, {core::kDescNullsFirst}, descendingSplitPoints);
+    std::vector<uint32_t> partitions;
+    function.partition(*data, partitions);
+    ASSERT_EQ(partitions, (std::vector<uint32_t>{3, 3, 0, 2, 2, 1, 1, 0, 3}));
+  }
+
+  VELOX_ASSERT_THROW(
+      RangePartitionFunction(3, {0}, {core::kAscNullsLast}, splitPoints),
+      "Range partitioning needs one partition more than split points");
+}
+
+TEST_F(RangePartitionFunctionTest, multipleKeys) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>({1, 1, 1, 2, 2, 3}),
+      makeFlatVector<std::string>({"a", "m", "z", "a", "z", "a"}),
+  });
+  auto splitPoints = makeRowVector({
+      makeFlatVector<int32_t>({1, 2}),
+      makeFlatVector<std::string>({"m", "m"}),
+  });
+
+  RangePartitionFunction function(
+      3, {0, 1}, {core::kAscNullsLast, core::kAscNullsLast}, splitPoints);
+  std::vector<uint32_t> partitions;
+  function.partition(*data, partitions);
+  ASSERT_EQ(partitions, (std::vector<uint32_t>{0, 1, 1, 1, 2, 2}));
+}
+
+TEST_F(RangePartitionFunctionTest, spec) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto splitPoints = makeRowVector({makeFlatVector<std::string>({"s", "f"})});
+  auto spec = std::make_shared<RangePartitionFunctionSpec>(
+      rowType,
+      std::vector<column_index_t>{1},
+      std::vector<core::SortOrder>{core::kDescNullsLast},
+      splitPoints);
+  ASSERT_EQ(spec->toString(), "RANGE(c1 DESC NULLS LAST) 2 split points");
+
+  auto copy =
+      RangePartitionFunctionSpec::deserialize(spec->serialize(), pool());
+  ASSERT_EQ(spec->toString(), copy->toString());
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({0, 1, 2, 3}),
+      makeFlatVector<std::string>({"a", "g", "t", "s"}),
+  });
+  std::vector<uint32_t> partitions;
+  std::vector<uint32_t> copyPartitions;
+  spec->create(3, true)->partition(*data, partitions);
+  copy->create(3, true)->partition(*data, copyPartitions);
+  ASSERT_EQ(partitions, copyPartitions);
+  ASSERT_EQ(partitions, (std::vector<uint32_t>{2, 1, 0, 1}));
+
+  VELOX_ASSERT_THROW(
+      std::make_shared<RangePartitionFunctionSpec>(
+          rowType,
+          std::vector<column_index_t>{0},
+          std::vector<core::SortOrder>{core::kAscNullsLast},
+          splitPoints),
+      "Split point type doesn't match range partitioning key");
+}
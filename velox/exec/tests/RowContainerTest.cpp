@@ -1373,6 +1373,56 @@ TEST_P(RowContainerTest, initialNulls) {
   EXPECT_FALSE(isNullAt(*data, row, 1));
 }
 
+TEST_P(RowContainerTest, compactStrings) {
+  constexpr int32_t kNumRows = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          kNumRows, [](auto row) { return std::string(20 + row % 50, 'a'); }),
+      makeArrayVector<int64_t>(
+          kNumRows,
+          [](auto row) { return row % 7; },
+          [](auto row) { return row; },
+          nullEvery(5)),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return std::string(row % 30, 'b' + row % 20); },
+          nullEvery(3)),
+  });
+  auto rowContainer = makeRowContainer(
+      {VARCHAR()}, {ARRAY(BIGINT()), VARCHAR()}, false, GetParam());
+  auto rows = store(*rowContainer, data);
+  ASSERT_TRUE(rowContainer->canCompactStrings());
+
+  // Erases three out of four rows to fragment the variable width data.
+  std::vector<char*> erased;
+  std::vector<char*> kept;
+  for (auto i = 0; i < kNumRows; ++i) {
+    (i % 4 == 0 ? kept : erased).push_back(rows[i]);
+  }
+  rowContainer->eraseRows(folly::Range<char**>(erased.data(), erased.size()));
+
+  const auto allocatedBytes = rowContainer->allocatedBytes();
+  const auto freedBytes = rowContainer->compactStrings();
+  ASSERT_GT(freedBytes, 0);
+  ASSERT_EQ(rowContainer->allocatedBytes(), allocatedBytes - freedBytes);
+  ASSERT_EQ(
+      rowContainer->stringAllocator().checkConsistency(),
+      rowContainer->stringAllocator().currentBytes());
+  if (GetParam()) {
+    ASSERT_EQ(rowContainer->testingRowPointers().size(), kNumRows);
+  }
+
+  auto indices = makeIndices(kept.size(), [](auto row) { return row * 4; });
+  for (auto i = 0; i < data->childrenSize(); ++i) {
+    auto result = BaseVector::create(data->childAt(i)->type(), 0, pool());
+    rowContainer->extractColumn(kept.data(), kept.size(), i, result);
+    assertEqualVectors(
+        BaseVector::wrapInDictionary(
+            nullptr, indices, kept.size(), data->childAt(i)),
+        result);
+  }
+}
+
 TEST_F(RowContainerTest, rowSize) {
   constexpr int32_t kNumRows = 100;
   auto data = makeRowContainer({SMALLINT()}, {VARCHAR()}, true);
@@ -1411,6 +1461,64 @@ TEST_F(RowContainerTest, rowSize) {
   EXPECT_EQ(rows, rowsFromContainer);
 }
 
+TEST_F(RowContainerTest, compactKeys) {
+  // A narrow key and payload keep the row size and next pointer last.
+  auto narrow = makeRowContainer({BIGINT()}, {VARCHAR()});
+  EXPECT_FALSE(narrow->compactKeys());
+  EXPECT_GT(narrow->nextOffset(), narrow->columnAt(1).offset());
+
+  // The layout is expected to be bigint - 2 bytes of bits - rowSize - next
+  // pointer - StringView - 6 bigints. The bits are the null flags of the
+  // dependents, a probed flag and a free flag.
+  auto data = makeRowContainer(
+      {BIGINT()},
+      {VARCHAR(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  EXPECT_TRUE(data->compactKeys());
+  EXPECT_EQ(10, data->rowSizeOffset());
+  EXPECT_EQ(14, data->nextOffset());
+  EXPECT_EQ(22, data->columnAt(1).offset());
+
+  // Not a join build.
+  EXPECT_FALSE(makeRowContainer(
+                   {BIGINT()},
+                   {VARCHAR(),
+                    BIGINT(),
+                    BIGINT(),
+                    BIGINT(),
+                    BIGINT(),
+                    BIGINT(),
+                    BIGINT()},
+                   false)
+                   ->compactKeys());
+
+  constexpr int32_t kNumRows = 100;
+  std::vector<VectorPtr> children{makeFlatVector<int64_t>(
+      kNumRows, [](auto row) { return row; })};
+  children.push_back(makeFlatVector<std::string>(kNumRows, [](auto row) {
+    return std::string(20 + row % 10, 'a' + row % 26);
+  }));
+  for (auto i = 0; i < 6; ++i) {
+    children.push_back(makeFlatVector<int64_t>(
+        kNumRows, [i](auto row) { return row * i; }, nullEvery(i + 2)));
+  }
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+  }
+  SelectivityVector allRows(kNumRows);
+  for (auto column = 0; column < children.size(); ++column) {
+    DecodedVector decoded(*children[column], allRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      data->store(decoded, i, rows[i], column);
+    }
+  }
+  for (auto column = 0; column < children.size(); ++column) {
+    auto result = BaseVector::create(children[column]->type(), 0, pool());
+    data->extractColumn(rows.data(), kNumRows, column, result);
+    assertEqualVectors(children[column], result);
+  }
+}
+
 TEST_P(RowContainerTest, columnSize) {
   const uint64_t kNumRows = 1000;
   auto rowContainer = makeRowContainer(
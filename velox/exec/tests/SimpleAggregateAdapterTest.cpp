@@ -471,6 +471,39 @@ TEST_F(SimpleCountNullsAggregationTest, basic) {
   testAggregations({vectors}, {}, {"simple_count_nulls(c2)"}, {expected});
 }
 
+TEST_F(SimpleCountNullsAggregationTest, streaming) {
+  // Group 2 spans both batches. The masked-out null in group 1 is not counted.
+  std::vector<RowVectorPtr> vectors = {
+      makeRowVector(
+          {"k", "v", "m"},
+          {makeFlatVector<int32_t>({1, 1, 1, 2, 2}),
+           makeNullableFlatVector<double>(
+               {std::nullopt, 1, std::nullopt, std::nullopt, 2}),
+           makeFlatVector<bool>({true, true, false, true, true})}),
+      makeRowVector(
+          {"k", "v", "m"},
+          {makeFlatVector<int32_t>({2, 3, 3}),
+           makeNullableFlatVector<double>({std::nullopt, 3, 4}),
+           makeFlatVector<bool>({true, true, true})}),
+  };
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .streamingAggregation(
+                      {"k"},
+                      {"simple_count_nulls(v)", "simple_count_nulls(v)"},
+                      {"m", ""},
+                      core::AggregationNode::Step::kSingle,
+                      false)
+                  .planNode();
+
+  auto expected = makeRowVector(
+      {makeFlatVector<int32_t>({1, 2, 3}),
+       makeNullableFlatVector<int64_t>({1, 2, std::nullopt}),
+       makeNullableFlatVector<int64_t>({2, 2, std::nullopt})});
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
 // A testing simple avg aggregate function, and it is used to check for
 // expectations for function-level variables. The validation logic is in the
 // Accumulator::addInput method.
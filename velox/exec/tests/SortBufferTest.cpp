@@ -769,6 +769,90 @@ DEBUG_ONLY_TEST_P(SortBufferTest, reserveMemorySort) {
   }
 }
 
+TEST_P(SortBufferTest, rangePartitionedSpill) {
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto spillConfig = common::SpillConfig(
+      [&]() -> const std::string& { return spillDirectory->getPath(); },
+      [&](uint64_t) {},
+      "0.0.0",
+      0,
+      0,
+      1 << 20,
+      executor_.get(),
+      5,
+      10,
+      0,
+      0,
+      0,
+      0,
+      0,
+      "none",
+      0,
+      spillPrefixSortConfig_,
+      "",
+      1'000,
+      "presto",
+      false,
+      /*_sortMergePartitionBits=*/2);
+  folly::Synchronized<common::SpillStats> spillStats;
+  auto sortBuffer = std::make_unique<SortBuffer>(
+      inputType_,
+      sortColumnIndices_,
+      sortCompareFlags_,
+      pool_.get(),
+      &nonReclaimableSection_,
+      prefixSortConfig_,
+      &spillConfig,
+      &spillStats);
+
+  TestScopedSpillInjection scopedSpillInjection(100);
+  VectorFuzzer fuzzer({.vectorSize = 1024}, fuzzerPool_.get());
+  constexpr int kNumInputs = 4;
+  for (int i = 0; i < kNumInputs; ++i) {
+    sortBuffer->addInput(fuzzer.fuzzRow(inputType_));
+  }
+  sortBuffer->noMoreInput();
+  // The splitters are sampled from the first spill run of 1024 rows with
+  // random keys, so all 4 key ranges get rows.
+  ASSERT_EQ(spillStats.rlock()->spilledPartitions, 4);
+
+  // Checks the output is ordered within and across the batches, including
+  // across the borders of the key ranges.
+  RowVectorPtr previous;
+  vector_size_t numOutputRows = 0;
+  const auto compareKeys = [&](const RowVectorPtr& left,
+                               vector_size_t leftRow,
+                               const RowVectorPtr& right,
+                               vector_size_t rightRow) {
+    for (auto i = 0; i < sortColumnIndices_.size(); ++i) {
+      const auto result =
+          left->childAt(sortColumnIndices_[i])
+              ->compare(
+                  right->childAt(sortColumnIndices_[i]).get(),
+                  leftRow,
+                  rightRow,
+                  sortCompareFlags_[i]);
+      if (result.value() != 0) {
+        return result.value();
+      }
+    }
+    return 0;
+  };
+  while (auto output = sortBuffer->getOutput(1'000)) {
+    if (previous != nullptr) {
+      ASSERT_LE(compareKeys(previous, previous->size() - 1, output, 0), 0);
+    }
+    for (auto row = 1; row < output->size(); ++row) {
+      ASSERT_LE(compareKeys(output, row - 1, output, row), 0);
+    }
+    numOutputRows += output->size();
+    // The output vector is reused, so copy it.
+    previous = std::static_pointer_cast<RowVector>(
+        BaseVector::copy(*output, fuzzerPool_.get()));
+  }
+  ASSERT_EQ(numOutputRows, kNumInputs * 1024);
+}
+
 TEST_P(SortBufferTest, emptySpill) {
   for (bool hasPostSpillData : {false, true}) {
     SCOPED_TRACE(fmt::format("hasPostSpillData {}", hasPostSpillData));
@@ -15,8 +15,10 @@
  */
 
 #include "velox/exec/SpatialIndex.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <random>
 
 using namespace ::testing;
 using namespace facebook::velox::exec;
@@ -50,6 +52,28 @@ class SpatialIndexTest : public virtual testing::Test {
     ASSERT_EQ(actual, expected);
   }
 
+  static std::vector<Envelope> makeRandomEnvelopes(
+      int32_t count,
+      float maxSize,
+      std::mt19937& rng) {
+    std::uniform_real_distribution<float> position(-1000, 1000);
+    std::uniform_real_distribution<float> size(0, maxSize);
+    std::vector<Envelope> envelopes;
+    envelopes.reserve(count);
+    for (int32_t i = 0; i < count; ++i) {
+      const float x = position(rng);
+      const float y = position(rng);
+      envelopes.push_back(
+          Envelope{
+              .minX = x,
+              .minY = y,
+              .maxX = x + size(rng),
+              .maxY = y + size(rng),
+              .rowIndex = i});
+    }
+    return envelopes;
+  }
+
   SpatialIndex index_;
   uint32_t branchSize_ = SpatialIndex::kDefaultRTreeBranchSize;
 };
@@ -547,4 +571,54 @@ TEST_F(SpatialIndexTest, testLargeBranchSize) {
   assertQuery(13, 13, 13, 13, {1});
 }
 
+TEST_F(SpatialIndexTest, testBatchQuery) {
+  std::mt19937 rng(1);
+  makeIndex(makeRandomEnvelopes(10'000, 20, rng));
+
+  auto queries = makeRandomEnvelopes(1'000, 50, rng);
+  // Empty and out of bounds queries match nothing.
+  queries.push_back(Envelope::empty());
+  queries.push_back(Envelope::from(5000, 5000, 5001, 5001));
+  auto results = index_.query(queries);
+  ASSERT_EQ(results.size(), queries.size());
+  for (auto i = 0; i < queries.size(); ++i) {
+    auto expected = index_.query(queries[i]);
+    std::sort(expected.begin(), expected.end());
+    std::sort(results[i].begin(), results[i].end());
+    ASSERT_EQ(results[i], expected) << i;
+  }
+  ASSERT_TRUE(results[queries.size() - 2].empty());
+  ASSERT_TRUE(results[queries.size() - 1].empty());
+}
+
+TEST_F(SpatialIndexTest, testParallelBuild) {
+  std::mt19937 rng(1);
+  // Large enough for several parallel steps.
+  auto envelopes = makeRandomEnvelopes(300'000, 5, rng);
+  const auto bounds = Envelope::of(envelopes);
+  folly::CPUThreadPoolExecutor executor(4);
+  SpatialIndex parallelIndex(
+      bounds, envelopes, SpatialIndex::kDefaultRTreeBranchSize, &executor);
+  makeIndex(envelopes);
+  ASSERT_EQ(parallelIndex.bounds().minX, indexBounds().minX);
+  ASSERT_EQ(parallelIndex.bounds().maxY, indexBounds().maxY);
+
+  const auto queries = makeRandomEnvelopes(100, 50, rng);
+  const auto parallelResults = parallelIndex.query(queries);
+  for (auto i = 0; i < queries.size(); ++i) {
+    std::vector<int32_t> expected;
+    for (const auto& envelope : envelopes) {
+      if (Envelope::intersects(envelope, queries[i])) {
+        expected.push_back(envelope.rowIndex);
+      }
+    }
+    auto actual = parallelResults[i];
+    std::sort(actual.begin(), actual.end());
+    ASSERT_EQ(actual, expected) << i;
+
+    // The serial and parallel builds make the same index.
+    ASSERT_EQ(parallelIndex.query(queries[i]), index_.query(queries[i]));
+  }
+}
+
 } // namespace facebook::velox::exec::test
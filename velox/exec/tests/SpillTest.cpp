@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -766,6 +767,104 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, columnarFileFormat) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row / 10; }),
+      makeFlatVector<std::string>(
+          1'000, [](auto row) { return fmt::format("value {}", row % 7); }),
+      makeArrayVector<int32_t>(
+          1'000,
+          [](auto row) { return row % 3; },
+          [](auto row) { return row; },
+          nullEvery(5)),
+  });
+  const auto readFile = [&](common::SpillFileFormat fileFormat) {
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        fmt::format("test_{}", common::spillFileFormatName(fileFormat)),
+        SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+        kGB,
+        0,
+        compressionKind_,
+        std::nullopt,
+        pool(),
+        &spillStats_,
+        "",
+        fileFormat);
+    const SpillPartitionId partitionId{0};
+    state.setPartitionSpilled(partitionId);
+    state.appendToPartition(partitionId, data);
+    const auto files = state.finish(partitionId);
+    VELOX_CHECK_EQ(files.size(), 1);
+    VELOX_CHECK(files[0].fileFormat == fileFormat);
+    auto file = SpillReadFile::create(files[0], 1 << 20, pool(), &spillStats_);
+    RowVectorPtr result;
+    VELOX_CHECK(file->nextBatch(result));
+    VELOX_CHECK(!file->nextBatch(result));
+    return result;
+  };
+
+  test::assertEqualVectors(data, readFile(common::SpillFileFormat::kColumnar));
+  test::assertEqualVectors(data, readFile(common::SpillFileFormat::kPresto));
+}
+
+TEST_P(SpillTest, overflowDirectory) {
+  auto localDirectory = exec::test::TempDirectoryPath::create();
+  auto overflowDirectory = exec::test::TempDirectoryPath::create();
+  auto& quota = LocalSpillQuota::instance();
+  quota.setMaxBytes(1);
+  SCOPE_EXIT {
+    quota.removeDirectory(localDirectory->getPath());
+    quota.setMaxBytes(0);
+  };
+
+  // A target file size of 1 opens a new file for each batch. The first file
+  // uses up the quota, so the next ones overflow.
+  SpillState state(
+      [&]() -> const std::string& { return localDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "overflow",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      1,
+      0,
+      compressionKind_,
+      std::nullopt,
+      pool(),
+      &spillStats_,
+      "",
+      common::SpillFileFormat::kPresto,
+      nullptr,
+      [&]() -> const std::string& { return overflowDirectory->getPath(); });
+  const SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 3; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        100, [&](auto row) { return i * 100 + row; })}));
+    state.appendToPartition(partitionId, batches.back());
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_EQ(files.size(), 3);
+  ASSERT_TRUE(files[0].path.starts_with(localDirectory->getPath()));
+  ASSERT_TRUE(files[1].path.starts_with(overflowDirectory->getPath()));
+  ASSERT_TRUE(files[2].path.starts_with(overflowDirectory->getPath()));
+  ASSERT_EQ(quota.usedBytes(), files[0].size);
+
+  for (auto i = 0; i < files.size(); ++i) {
+    auto file = SpillReadFile::create(files[i], 1 << 20, pool(), &spillStats_);
+    RowVectorPtr result;
+    ASSERT_TRUE(file->nextBatch(result));
+    test::assertEqualVectors(batches[i], result);
+    ASSERT_FALSE(file->nextBatch(result));
+  }
+
+  quota.removeDirectory(localDirectory->getPath());
+  ASSERT_EQ(quota.usedBytes(), 0);
+  ASSERT_FALSE(quota.exceeded());
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -31,10 +31,12 @@
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/connectors/hive/DecodedVectorCache.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveDataSource.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/dwio/common/DictionaryCache.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/orc/reader/OrcReader.h"
 #include "velox/exec/Cursor.h"
@@ -1559,6 +1561,32 @@ TEST_F(TableScanTest, preloadSplits) {
   ASSERT_EQ(stats.at("preloadedSplits").sum, 10);
 }
 
+TEST_F(TableScanTest, prewarmSplits) {
+  auto filePaths = makeFilePaths(10);
+  auto vectors = makeVectors(10, 10);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto runScan = [&](const std::string& maxSplitPrewarmPerDriver) {
+    return AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+        .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "2")
+        .config(
+            core::QueryConfig::kMaxSplitPrewarmPerDriver,
+            maxSplitPrewarmPerDriver)
+        .splits(makeHiveConnectorSplits(filePaths))
+        .assertResults("SELECT * FROM tmp");
+  };
+  auto stats = getTableScanRuntimeStats(runScan("0"));
+  ASSERT_EQ(stats.count("prewarmedSplits"), 0);
+
+  // The splits past the first two are prewarmed before they are preloaded.
+  stats = getTableScanRuntimeStats(runScan("4"));
+  ASSERT_GT(stats.at("prewarmedSplits").sum, 0);
+  ASSERT_GT(stats.at("preloadedSplits").sum, 0);
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
@@ -1814,6 +1842,37 @@ TEST_F(TableScanTest, splitOffsetAndLength) {
       "SELECT * FROM tmp LIMIT 0");
 }
 
+TEST_F(TableScanTest, splitDivision) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(
+      filePath->getPath(),
+      vectors,
+      std::make_shared<facebook::velox::dwrf::Config>(),
+      []() { return std::make_unique<dwrf::DefaultFlushPolicy>(1000, 0); });
+  createDuckDbTable(vectors);
+  const auto fileSize = fs::file_size(filePath->getPath());
+
+  for (int32_t numDrivers : {1, 4}) {
+    SCOPED_TRACE(fmt::format("numDrivers={}", numDrivers));
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .maxDrivers(numDrivers)
+            .config(
+                core::QueryConfig::kTableScanSplitDivisionBytes,
+                std::to_string(fileSize / 4))
+            .split(makeHiveConnectorSplit(filePath->getPath(), 0, fileSize))
+            .assertResults("SELECT * FROM tmp");
+    auto stats = getTableScanRuntimeStats(task);
+    if (numDrivers == 1) {
+      ASSERT_EQ(stats.count("numDividedSplitParts"), 0);
+    } else {
+      ASSERT_EQ(stats.at("numDividedSplitParts").sum, 4);
+      ASSERT_EQ(task->taskStats().numTotalSplits, 4);
+    }
+  }
+}
+
 TEST_F(TableScanTest, fileNotFound) {
   auto assertMissingFile = [&](bool ignoreMissingFiles) {
     auto split =
@@ -2471,6 +2530,307 @@ TEST_F(TableScanTest, statsBasedSkipping) {
   EXPECT_EQ(2, getSkippedStridesStat(task));
 }
 
+TEST_F(TableScanTest, filterResultCache) {
+  // No row of the second file passes the filter but its stats do not show
+  // this.
+  auto filePaths = makeFilePaths(2);
+  std::vector<RowVectorPtr> vectors = {
+      makeRowVector(
+          {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}),
+      makeRowVector(
+          {makeFlatVector<int64_t>(1'000, [](auto row) { return row * 7; })})};
+  for (auto i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto rowType = asRowType(vectors[0]->type());
+  // Only the splits with a modification time use the cache.
+  auto makeSplits = [&](std::optional<int64_t> modificationTime) {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(
+          exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+              .fileProperties({.modificationTime = modificationTime})
+              .build());
+    }
+    return splits;
+  };
+  auto plan = PlanBuilder().tableScan(rowType, {}, "c0 % 7 = 3").planNode();
+  auto runScan = [&](bool enabled,
+                     std::optional<int64_t> modificationTime = 1) {
+    return AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .connectorSessionProperty(
+            kHiveConnectorId,
+            connector::hive::HiveConfig::kFilterResultCacheEnabledSession,
+            enabled ? "true" : "false")
+        .splits(makeSplits(modificationTime))
+        .assertResults("SELECT * FROM tmp WHERE c0 % 7 = 3");
+  };
+
+  auto task = runScan(true, std::nullopt);
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("skippedSplits"), 0);
+  task = runScan(true, std::nullopt);
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("skippedSplits"), 0);
+
+  task = runScan(false);
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("skippedSplits"), 0);
+  task = runScan(true);
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("skippedSplits"), 0);
+  EXPECT_EQ(getTableScanStats(task).rawInputRows, 2'000);
+
+  // The second file is skipped on the next scans with the same filter.
+  task = runScan(true);
+  ASSERT_EQ(getTableScanRuntimeStats(task).at("skippedSplits").sum, 1);
+  EXPECT_EQ(getTableScanStats(task).rawInputRows, 1'000);
+
+  // The result is not used if disabled or with another filter.
+  task = runScan(false);
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("skippedSplits"), 0);
+  task = AssertQueryBuilder(
+             PlanBuilder().tableScan(rowType, {}, "c0 % 7 = 4").planNode(),
+             duckDbQueryRunner_)
+             .connectorSessionProperty(
+                 kHiveConnectorId,
+                 connector::hive::HiveConfig::kFilterResultCacheEnabledSession,
+                 "true")
+             .splits(makeSplits(1))
+             .assertResults("SELECT * FROM tmp WHERE c0 % 7 = 4");
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("skippedSplits"), 0);
+}
+
+TEST_F(TableScanTest, decodedVectorCache) {
+  auto* cache = connector::hive::DecodedVectorCache::create(64 << 20);
+  auto filePaths = makeFilePaths(2);
+  auto vectors = makeVectors(2, 1'000);
+  for (auto i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // Only the splits with a modification time use the cache.
+  auto makeSplits = [&]() {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(
+          exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+              .fileProperties({.modificationTime = 1})
+              .build());
+    }
+    return splits;
+  };
+  auto runScan = [&](const std::string& filter, bool enabled) {
+    return AssertQueryBuilder(
+               PlanBuilder()
+                   .tableScan(rowType_, {filter}, "c0 % 3 = 0")
+                   .project({"c0", "c1", "c4"})
+                   .planNode(),
+               duckDbQueryRunner_)
+        .connectorSessionProperty(
+            kHiveConnectorId,
+            connector::hive::HiveConfig::kDecodedVectorCacheEnabledSession,
+            enabled ? "true" : "false")
+        .splits(makeSplits())
+        .assertResults(fmt::format(
+            "SELECT c0, c1, c4 FROM tmp WHERE {} AND c0 % 3 = 0", filter));
+  };
+  auto cacheHits = [](const std::shared_ptr<Task>& task) {
+    const auto stats = getTableScanRuntimeStats(task);
+    auto it = stats.find("numDecodedVectorCacheHits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  auto task = runScan("c1 < 1000", false);
+  EXPECT_EQ(cacheHits(task), 0);
+  EXPECT_EQ(cache->stats().numEntries, 0);
+  task = runScan("c1 < 1000", true);
+  EXPECT_EQ(cacheHits(task), 0);
+  EXPECT_EQ(cache->stats().numEntries, 2);
+
+  // The next scans with the same columns and filters use the decoded output.
+  task = runScan("c1 < 1000", true);
+  EXPECT_EQ(cacheHits(task), 2);
+  task = runScan("c1 < 1000", true);
+  EXPECT_EQ(cacheHits(task), 2);
+
+  // Another filter or a disabled cache reads the files.
+  task = runScan("c1 < 100", true);
+  EXPECT_EQ(cacheHits(task), 0);
+  EXPECT_EQ(cache->stats().numEntries, 4);
+  task = runScan("c1 < 1000", false);
+  EXPECT_EQ(cacheHits(task), 0);
+
+  cache->shrink(1);
+  EXPECT_EQ(cache->stats().numEntries, 3);
+  cache->clear();
+  EXPECT_EQ(cache->stats().numEntries, 0);
+  EXPECT_EQ(cache->stats().sizeBytes, 0);
+  task.reset();
+  connector::hive::DecodedVectorCache::testingClear();
+}
+
+TEST_F(TableScanTest, dwrfDictionaryCache) {
+  auto* cache = dwio::common::DictionaryCache::create(64 << 20);
+  const std::vector<std::string> strings = {
+      "first dictionary entry", "second dictionary entry", "third entry"};
+  std::vector<RowVectorPtr> vectors = {makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+      makeFlatVector<StringView>(
+          10'000,
+          [&](auto row) { return StringView(strings[row % strings.size()]); }),
+  })};
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+  auto rowType = asRowType(vectors[0]->type());
+
+  // Only the splits with a modification time share the dictionaries.
+  auto runScan = [&](std::optional<int64_t> modificationTime) {
+    auto split = exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+                     .fileProperties({.modificationTime = modificationTime})
+                     .build();
+    AssertQueryBuilder(
+        PlanBuilder().tableScan(rowType, {}, "c0 % 3 = 0").planNode(),
+        duckDbQueryRunner_)
+        .split(split)
+        .assertResults("SELECT * FROM tmp WHERE c0 % 3 = 0");
+  };
+
+  runScan(std::nullopt);
+  EXPECT_EQ(cache->stats().numLookups, 0);
+  runScan(1);
+  EXPECT_EQ(cache->stats().numEntries, 1);
+  EXPECT_EQ(cache->stats().numHits, 0);
+  EXPECT_GT(cache->pool()->usedBytes(), 0);
+  runScan(1);
+  EXPECT_EQ(cache->stats().numEntries, 1);
+  EXPECT_EQ(cache->stats().numHits, 1);
+
+  // A changed file misses.
+  runScan(2);
+  EXPECT_EQ(cache->stats().numEntries, 2);
+  EXPECT_EQ(cache->stats().numHits, 1);
+
+  cache->clear();
+  EXPECT_EQ(cache->pool()->usedBytes(), 0);
+  dwio::common::DictionaryCache::testingClear();
+}
+
+TEST_F(TableScanTest, partitionFiltersSkipSplits) {
+  auto vectors = makeVectors(1, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  // The splits that fail the filters on 'ds' point to a missing file to show
+  // that they are skipped without opening the file.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (const std::string ds : {"2021-12-01", "2021-12-02", "2021-12-03"}) {
+    splits.push_back(
+        exec::test::HiveConnectorSplitBuilder(
+            ds == "2021-12-02" ? filePath->getPath() : "/missing/file")
+            .partitionKey("ds", ds)
+            .build());
+  }
+  connector::ColumnHandleMap assignments = {
+      {"c0", regularColumn("c0", BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())}};
+  auto runScan = [&](const std::string& filter) {
+    auto plan = PlanBuilder()
+                    .startTableScan()
+                    .outputType(ROW({"c0", "ds"}, {BIGINT(), VARCHAR()}))
+                    .remainingFilter(filter)
+                    .assignments(assignments)
+                    .endTableScan()
+                    .planNode();
+    return AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .splits(splits)
+        .assertResults("SELECT c0, '2021-12-02' FROM tmp");
+  };
+
+  // Subfield filter on the partition key.
+  auto task = runScan("ds = '2021-12-02'");
+  ASSERT_EQ(getTableScanRuntimeStats(task).at("skippedSplits").sum, 2);
+
+  // Remaining filter on the partition key, evaluated once per split.
+  task = runScan("substr(ds, 9, 2) = '02'");
+  ASSERT_EQ(getTableScanRuntimeStats(task).at("skippedSplits").sum, 2);
+  EXPECT_EQ(getTableScanStats(task).rawInputRows, 1'000);
+}
+
+TEST_F(TableScanTest, aggregatePushdown) {
+  auto filePaths = makeFilePaths(2);
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000, [&](auto row) { return row + i * 1'000; }),
+         makeFlatVector<int32_t>(
+             1'000, [&](auto row) { return row % 100 - i; }, nullEvery(7))}));
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<HiveAggregate> aggregates = {
+      {HiveAggregate::Kind::kCount, ""},
+      {HiveAggregate::Kind::kMin, "c1"},
+      {HiveAggregate::Kind::kMax, "c1"},
+      {HiveAggregate::Kind::kNullCount, "c1"},
+      {HiveAggregate::Kind::kCount, "c1"}};
+  auto makePlan = [&](common::SubfieldFilters filters) {
+    auto tableHandle = std::make_shared<HiveTableHandle>(
+        kHiveConnectorId,
+        "hive_table",
+        true,
+        std::move(filters),
+        nullptr,
+        asRowType(vectors[0]->type()),
+        std::unordered_map<std::string, std::string>{},
+        std::vector<HiveColumnHandlePtr>{},
+        1.0,
+        aggregates);
+    return PlanBuilder()
+        .startTableScan()
+        .outputType(
+            ROW({"a0", "a1", "a2", "a3", "a4"},
+                {BIGINT(), INTEGER(), INTEGER(), BIGINT(), BIGINT()}))
+        .tableHandle(tableHandle)
+        .assignments({{"c1", makeColumnHandle("c1", INTEGER(), {})}})
+        .endTableScan()
+        .singleAggregation(
+            {}, {"sum(a0)", "min(a1)", "max(a2)", "sum(a3)", "sum(a4)"})
+        .planNode();
+  };
+  const std::string sql =
+      "SELECT count(*), min(c1), max(c1), count(*) - count(c1), count(c1) "
+      "FROM tmp";
+
+  // Both files are answered from their statistics.
+  auto task = assertQuery(makePlan({}), filePaths, sql);
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task).at("numStatisticsAggregatedSplits").sum,
+      2);
+  EXPECT_EQ(getTableScanStats(task).rawInputRows, 0);
+
+  // All rows of the first file pass the filter and some of the second.
+  task = assertQuery(
+      makePlan(singleSubfieldFilter("c0", lessThan(1'500))),
+      filePaths,
+      sql + " WHERE c0 < 1500");
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task).at("numStatisticsAggregatedSplits").sum,
+      1);
+  EXPECT_EQ(getTableScanStats(task).rawInputRows, 1'000);
+
+  // The statistics do not prove that all rows pass a filter on the values.
+  task = assertQuery(
+      makePlan(singleSubfieldFilter("c1", greaterThan(10))),
+      filePaths,
+      sql + " WHERE c1 > 10");
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task).count("numStatisticsAggregatedSplits"), 0);
+}
+
 // Test skipping files and row groups containing constant values based on
 // statistics
 TEST_F(TableScanTest, statsBasedSkippingConstants) {
@@ -3718,6 +4078,37 @@ TEST_F(TableScanTest, remainingFilterLazyWithMultiReferences) {
   ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
 }
 
+TEST_F(TableScanTest, remainingFilterStagedConjuncts) {
+  auto rowType = ROW({"c0", "c1", "c2"}, {BIGINT(), BIGINT(), VARCHAR()});
+  auto filePaths = makeFilePaths(5);
+  auto vectors = makeVectors(5, 1'000, rowType);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // c1 is read by a conditional and projected out, so it is loaded eagerly.
+  // The conjunct on c0 runs first and c1 is loaded only for its passing rows.
+  const std::vector<std::pair<std::string, std::string>> testSettings = {
+      {"c0 % 3 = 0 AND if(c1 % 2 = 0, c1 % 4 = 0, c1 % 3 = 0)",
+       "c0 % 3 = 0 AND CASE WHEN c1 % 2 = 0 THEN c1 % 4 = 0 ELSE c1 % 3 = 0 END"},
+      {"if(c1 % 2 = 0, c1 % 4 = 0, c1 % 3 = 0) AND length(c2) > 2 AND c0 % 2 = 1",
+       "CASE WHEN c1 % 2 = 0 THEN c1 % 4 = 0 ELSE c1 % 3 = 0 END AND length(c2) > 2 AND c0 % 2 = 1"},
+      {"c0 % 7 = 8 AND if(c1 % 2 = 0, c1 % 4 = 0, c1 % 3 = 0)", "false"}};
+  for (const auto& [filter, sql] : testSettings) {
+    SCOPED_TRACE(filter);
+    assertQuery(
+        PlanBuilder(pool_.get())
+            .startTableScan()
+            .outputType(rowType)
+            .remainingFilter(filter)
+            .endTableScan()
+            .planNode(),
+        filePaths,
+        "SELECT * FROM tmp WHERE " + sql);
+  }
+}
+
 TEST_F(TableScanTest, sharedNullBufferFromComplexResult) {
   // Set the map vector to trigger map null buffer writable check.
   const auto mapVector = makeNullableMapVector<StringView, int64_t>(
@@ -5408,6 +5799,66 @@ TEST_F(TableScanTest, dynamicFilters) {
       .assertResults(makeRowVector({makeFlatVector<int64_t>(0)}));
 }
 
+TEST_F(TableScanTest, topNDynamicFilter) {
+  // Each file has a disjoint ascending range of c0. Once TopN has 10 rows from
+  // the first file, the files after it are skipped by their stats.
+  constexpr int32_t kNumFiles = 5;
+  constexpr int32_t kFileRows = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kFileRows, [&](auto row) { return i * kFileRows + row; }),
+        makeFlatVector<std::string>(
+            kFileRows,
+            [&](auto row) {
+              return fmt::format("{:05}", i * kFileRows + row);
+            }),
+    }));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), vectors.back());
+  }
+  createDuckDbTable(vectors);
+  const auto rowType = asRowType(vectors[0]->type());
+
+  const auto runQuery = [&](const std::string& key, bool enabled) {
+    core::PlanNodeId topNId;
+    auto plan = PlanBuilder()
+                    .tableScan(rowType)
+                    .topN({key}, 10, false)
+                    .capturePlanNodeId(topNId)
+                    .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        core::QueryConfig::kTopNDynamicFilterPushdownEnabled,
+                        enabled ? "true" : "false")
+                    .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "0")
+                    .splits(makeHiveConnectorSplits(filePaths))
+                    .assertResults(fmt::format(
+                        "SELECT * FROM tmp ORDER BY {} LIMIT 10", key));
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& scanStats = planStats.at(plan->sources()[0]->id());
+    if (enabled) {
+      ASSERT_EQ(
+          scanStats.dynamicFilterStats.producerNodeIds,
+          std::unordered_set<core::PlanNodeId>({topNId}));
+    } else {
+      ASSERT_TRUE(scanStats.dynamicFilterStats.empty());
+    }
+    const auto runtimeStats = getTableScanRuntimeStats(task);
+    const auto skippedSplits = runtimeStats.count("skippedSplits") == 0
+        ? 0
+        : runtimeStats.at("skippedSplits").sum;
+    ASSERT_EQ(skippedSplits, enabled ? kNumFiles - 1 : 0);
+  };
+
+  runQuery("c0", false);
+  runQuery("c0", true);
+  runQuery("c0 NULLS FIRST", true);
+  runQuery("c1", true);
+}
+
 TEST_F(TableScanTest, dynamicFilterWithRowIndexColumn) {
   // This test ensures dynamic filters can be mapped to correct field when there
   // is row_index column.
@@ -5525,6 +5976,59 @@ TEST_F(TableScanTest, bloomFilterPushdown) {
   }
 }
 
+TEST_F(TableScanTest, bloomFilterPushdownCompositeStringKeys) {
+  auto key = [](int64_t n) { return fmt::format("key-{:020}", n); };
+  auto build = makeRowVector(
+      {"b1", "b2"},
+      {
+          makeFlatVector<int64_t>(1'000, [](auto i) { return (2 * i) % 7; }),
+          makeFlatVector<std::string>(
+              1'000, [&](auto i) { return key(2 * i); }),
+      });
+  auto probe = makeRowVector(
+      {"a1", "a2"},
+      {
+          makeFlatVector<int64_t>(4'000, [](auto i) { return i % 7; }),
+          makeFlatVector<std::string>(4'000, [&](auto i) { return key(i); }),
+      });
+  std::shared_ptr<TempFilePath> files[2];
+  files[0] = TempFilePath::create();
+  writeToFile(files[0]->getPath(), {probe});
+  files[1] = TempFilePath::create();
+  writeToFile(files[1]->getPath(), {build});
+  auto idGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId, buildScanId, joinId;
+  auto plan = PlanBuilder(idGenerator)
+                  .tableScan(ROW({"a1", "a2"}, {BIGINT(), VARCHAR()}))
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin(
+                      {"a1", "a2"},
+                      {"b1", "b2"},
+                      PlanBuilder(idGenerator)
+                          .tableScan(ROW({"b1", "b2"}, {BIGINT(), VARCHAR()}))
+                          .capturePlanNodeId(buildScanId)
+                          .planNode(),
+                      /*filter=*/"",
+                      {"a1", "a2"})
+                  .capturePlanNodeId(joinId)
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan)
+          .config(
+              core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+              std::to_string(4 * build->size()))
+          .split(probeScanId, makeHiveConnectorSplit(files[0]->getPath()))
+          .split(buildScanId, makeHiveConnectorSplit(files[1]->getPath()))
+          .assertResults(build);
+  auto planStats = toPlanStats(task->taskStats());
+  // Both keys get a filter. The string key gets a bloom filter.
+  ASSERT_EQ(
+      planStats.at(joinId).customStats.at("dynamicFiltersProduced").sum, 2);
+  ASSERT_GT(planStats.at(joinId).customStats.at("bloomFilterSize").sum, 0);
+  // The bloom filter drops most non-matching probe rows in the scan.
+  ASSERT_LT(planStats.at(probeScanId).outputRows, 2 * build->size());
+}
+
 // TODO: re-enable this test once we add back driver suspension support for
 // table scan.
 TEST_F(TableScanTest, DISABLED_memoryArbitrationWithSlowTableScan) {
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TaskProgress.h"
+#include "velox/exec/Cursor.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class TaskProgressTest : public OperatorTestBase {
+ protected:
+  std::unique_ptr<TaskCursor> createCursor() {
+    const auto data = makeRowVector(
+        {makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+    CursorParameters params;
+    params.planNode = PlanBuilder()
+                          .values({data}, false, 10)
+                          .filter("c0 % 2 = 0")
+                          .planNode();
+    // Runs the driver on the calling thread so that the counters do not
+    // change between the reports.
+    params.serialExecution = true;
+    return TaskCursor::create(params);
+  }
+};
+
+TEST_F(TaskProgressTest, completion) {
+  TaskProgress progress;
+  ASSERT_FALSE(progress.completion().has_value());
+
+  progress.numTotalSplits = 4;
+  progress.numFinishedSplits = 1;
+  progress.numRunningSplits = 2;
+  ASSERT_DOUBLE_EQ(progress.completion().value(), 0.5);
+
+  progress.finished = true;
+  ASSERT_DOUBLE_EQ(progress.completion().value(), 1.0);
+}
+
+TEST_F(TaskProgressTest, finishedTask) {
+  auto cursor = createCursor();
+  while (cursor->moveNext()) {
+  }
+  ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
+
+  const auto progress = cursor->task()->taskProgress();
+  ASSERT_TRUE(progress.finished);
+  ASSERT_DOUBLE_EQ(progress.completion().value(), 1.0);
+  ASSERT_EQ(progress.pipelines.size(), 1);
+  const auto& pipeline = progress.pipelines[0];
+  ASSERT_EQ(pipeline.numRunningDrivers, 0);
+  ASSERT_EQ(pipeline.numFinishedDrivers, 1);
+  ASSERT_EQ(pipeline.operators.size(), 2);
+  const auto& filter = pipeline.operators[1];
+  ASSERT_EQ(filter.operatorType, "FilterProject");
+  ASSERT_EQ(filter.inputRows, 1'000);
+  ASSERT_EQ(filter.outputRows, 500);
+  ASSERT_EQ(filter.memoryBytes, 0);
+  ASSERT_FALSE(progress.toString().empty());
+}
+
+TEST_F(TaskProgressTest, reporter) {
+  auto cursor = createCursor();
+  std::vector<TaskProgress> deltas;
+  TaskProgressReporter reporter(
+      [&](const Task& task, const TaskProgress& delta) {
+        ASSERT_EQ(task.taskId(), cursor->task()->taskId());
+        deltas.push_back(delta);
+      });
+  reporter.addTask(cursor->task());
+  ASSERT_EQ(reporter.numTasks(), 1);
+
+  while (cursor->moveNext()) {
+    reporter.report();
+  }
+  ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
+  reporter.report();
+  ASSERT_EQ(reporter.numTasks(), 0);
+
+  ASSERT_GE(deltas.size(), 2);
+  ASSERT_TRUE(deltas.back().finished);
+  uint64_t inputRows = 0;
+  uint64_t outputRows = 0;
+  for (auto i = 0; i < deltas.size(); ++i) {
+    ASSERT_EQ(deltas[i].finished, i == deltas.size() - 1);
+    const auto& filter = deltas[i].pipelines[0].operators[1];
+    inputRows += filter.inputRows;
+    outputRows += filter.outputRows;
+  }
+  ASSERT_EQ(inputRows, 1'000);
+  ASSERT_EQ(outputRows, 500);
+
+  // A finished task is no longer reported.
+  const auto numDeltas = deltas.size();
+  reporter.report();
+  ASSERT_EQ(deltas.size(), numDeltas);
+}
+
+TEST_F(TaskProgressTest, backgroundReport) {
+  auto cursor = createCursor();
+  std::atomic_int32_t numReports{0};
+  TaskProgressReporter::Options options;
+  options.intervalMs = 10;
+  TaskProgressReporter reporter(
+      [&](const Task& /*unused*/, const TaskProgress& /*unused*/) {
+        ++numReports;
+      },
+      options);
+  reporter.addTask(cursor->task());
+  reporter.start();
+  while (cursor->moveNext()) {
+  }
+  ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
+  while (reporter.numTasks() > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  reporter.stop();
+  ASSERT_GE(numReports, 1);
+}
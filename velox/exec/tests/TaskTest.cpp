@@ -1059,6 +1059,64 @@ TEST_F(TaskTest, serialExecution) {
   VELOX_ASSERT_THROW(executeSerial(plan), "division by zero");
 }
 
+TEST_F(TaskTest, multipleCursorConsumers) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  constexpr int32_t kNumDrivers = 4;
+
+  for (auto numConsumers : {1, 2, 3, 6}) {
+    SCOPED_TRACE(fmt::format("numConsumers: {}", numConsumers));
+    CursorParameters params;
+    params.planNode = PlanBuilder()
+                          .values({data, data}, true)
+                          .filter("c0 % 10 = 0")
+                          .planNode();
+    params.maxDrivers = kNumDrivers;
+    params.numConsumers = numConsumers;
+    auto cursor = TaskCursor::create(params);
+    ASSERT_EQ(numConsumers, cursor->numConsumers());
+    cursor->start();
+
+    // Each stream is consumed by its own thread.
+    std::vector<std::vector<RowVectorPtr>> results(numConsumers);
+    std::vector<std::thread> consumers;
+    for (auto i = 0; i < numConsumers; ++i) {
+      consumers.emplace_back([&, i]() {
+        while (auto batch = cursor->next(i)) {
+          results[i].push_back(batch);
+        }
+      });
+    }
+    for (auto& consumer : consumers) {
+      consumer.join();
+    }
+
+    auto expected = makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row * 10; }),
+    });
+    for (auto i = 0; i < numConsumers; ++i) {
+      // The drivers are assigned to the streams round-robin.
+      const auto numDrivers =
+          kNumDrivers / numConsumers + (i < kNumDrivers % numConsumers);
+      ASSERT_EQ(results[i].size(), 2 * numDrivers);
+      for (const auto& batch : results[i]) {
+        assertEqualVectors(expected, batch);
+      }
+    }
+    EXPECT_EQ(cursor->next(0), nullptr);
+  }
+
+  CursorParameters params;
+  params.planNode = PlanBuilder().values({data}).planNode();
+  params.numConsumers = 2;
+  auto cursor = TaskCursor::create(params);
+  VELOX_ASSERT_THROW(
+      cursor->moveNext(), "Use next(consumer) with multiple consumers");
+  VELOX_ASSERT_THROW(
+      cursor->next(1), "start() must be called before next(consumer)");
+}
+
 // The purpose of the test is to check the running task list APIs.
 TEST_F(TaskTest, runningTaskList) {
   const auto data = makeRowVector({
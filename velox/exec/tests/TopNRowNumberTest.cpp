@@ -263,6 +263,44 @@ TEST_P(MultiTopNRowNumberTest, manyPartitions) {
   testLimit(1, 1);
 }
 
+TEST_P(MultiTopNRowNumberTest, replaceTopRows) {
+  // Unique sort keys in no particular order so that rows are replaced in the
+  // middle of the top rows. The variable width data column checks the space
+  // of replaced rows is reused correctly.
+  const vector_size_t size = 10'000;
+  auto data = split(
+      makeRowVector(
+          {"d", "s", "p"},
+          {
+              makeFlatVector<std::string>(
+                  size,
+                  [](auto row) {
+                    return std::string(row % 37, 'a' + row % 26);
+                  }),
+              makeFlatVector<int64_t>(
+                  size, [](auto row) { return row * 7'919 % size; }),
+              makeFlatVector<int64_t>(size, [](auto row) { return row % 100; }),
+          }),
+      10);
+
+  createDuckDbTable(data);
+
+  for (auto limit : {1, 3, 10}) {
+    SCOPED_TRACE(fmt::format("Limit: {}", limit));
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .topNRank(functionName_, {"p"}, {"s"}, limit, true)
+                    .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, {}() over (partition by p order by s) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            functionName_,
+            limit));
+  }
+}
+
 TEST_P(MultiTopNRowNumberTest, fewPartitions) {
   const vector_size_t size = 10'000;
   auto data = split(
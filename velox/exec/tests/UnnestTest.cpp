@@ -189,6 +189,42 @@ TEST_P(UnnestTest, arrayWithoutIdentityMap) {
   }
 }
 
+TEST_P(UnnestTest, arrayElementsSliced) {
+  // Arrays of 3 elements split across output batches of 'batchSize_' rows so
+  // that batches start and end within an array.
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeArrayVector<int32_t>(
+          100,
+          [](auto /*row*/) { return 3; },
+          [](auto row, auto index) { return row * 3 + index; }),
+  });
+  createDuckDbTable({vector});
+
+  const auto plan =
+      PlanBuilder().values({vector}).unnest({"c0"}, {"c1"}).planNode();
+  const auto [cursor, results] = readCursor(makeCursorParameters(plan));
+  ASSERT_EQ(results.size(), bits::divRoundUp(300, batchSize_));
+
+  // Every output batch references a contiguous range of the array elements,
+  // so the unnest column is a zero-copy slice of the elements vector.
+  const auto* rawElements = vector->childAt(1)
+                                ->as<ArrayVector>()
+                                ->elements()
+                                ->asFlatVector<int32_t>()
+                                ->rawValues();
+  vector_size_t numRows = 0;
+  for (const auto& result : results) {
+    auto* unnested = result->childAt(1)->asFlatVector<int32_t>();
+    ASSERT_NE(unnested, nullptr);
+    ASSERT_EQ(unnested->rawValues(), rawElements + numRows);
+    numRows += result->size();
+  }
+  ASSERT_EQ(numRows, 300);
+
+  assertQuery(makeCursorParameters(plan), "SELECT c0, UNNEST(c1) FROM tmp");
+}
+
 TEST_P(UnnestTest, arrayWithNull) {
   const auto vector = makeRowVector(
       {makeFlatVector<int64_t>(1024, [](auto row) { return row; }),
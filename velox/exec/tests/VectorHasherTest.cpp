@@ -448,6 +448,32 @@ TEST_F(VectorHasherTest, stringIds) {
   EXPECT_EQ(numInRange, rows.countSelected());
 }
 
+TEST_F(VectorHasherTest, stringIdsRuns) {
+  // Runs of equal strings of different lengths, some out of line.
+  auto vector = makeFlatVector<std::string>(1'000, [](auto row) {
+    return std::string(1 + row / 7 % 20, 'a' + row / 140);
+  });
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 0);
+  SelectivityVector rows(vector->size());
+  raw_vector<uint64_t> hashes(vector->size());
+  hasher->decode(*vector, rows);
+  ASSERT_FALSE(hasher->computeValueIds(rows, hashes));
+  hasher->enableValueIds(1, 0);
+  hasher->decode(*vector, rows);
+  ASSERT_TRUE(hasher->computeValueIds(rows, hashes));
+
+  // Equal strings get the same id and different strings different ids.
+  std::unordered_map<std::string, uint64_t> ids;
+  for (auto i = 0; i < vector->size(); ++i) {
+    auto it = ids.emplace(vector->valueAt(i).str(), hashes[i]).first;
+    ASSERT_EQ(it->second, hashes[i]) << i;
+  }
+  std::unordered_set<uint64_t> distinctIds;
+  for (const auto& [value, id] : ids) {
+    ASSERT_TRUE(distinctIds.insert(id).second) << value;
+  }
+}
+
 // Tests distinct overflow, but starting with a small string
 TEST_F(VectorHasherTest, stringDistinctOverflow) {
   auto hasher = exec::VectorHasher::create(VARCHAR(), 1);
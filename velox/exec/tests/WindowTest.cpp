@@ -223,6 +223,61 @@ TEST_F(WindowTest, spillBatchReadHugePartitions) {
       size / partitionRows);
 }
 
+TEST_F(WindowTest, spillStreaming) {
+  const vector_size_t size = 1'000;
+  // Each partition has 200 rows, which is more than a batch. The sorting key
+  // has peer groups of 3 rows.
+  const uint32_t partitionRows = 200;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<int16_t>(
+              size, [](auto row) { return row / partitionRows; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 3; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s, d)",
+      "rank() over (partition by p order by s)",
+      "sum(d) over (partition by p order by s)"};
+  for (const auto& function : functions) {
+    SCOPED_TRACE(function);
+    core::PlanNodeId windowId;
+    auto plan = PlanBuilder()
+                    .values(split(data, 10))
+                    .window({function})
+                    .capturePlanNodeId(windowId)
+                    .planNode();
+
+    auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "32")
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kWindowSpillEnabled, "true")
+            .config(core::QueryConfig::kWindowSpillStreamingEnabled, "true")
+            .spillDirectory(spillDirectory->getPath())
+            .assertResults(fmt::format("SELECT *, {} FROM tmp", function));
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at(windowId);
+    ASSERT_GT(stats.spilledRows, 0);
+    // The partitions are read in batches of output size.
+    ASSERT_GT(
+        stats.operatorStats.at("Window")
+            ->customStats[Window::kWindowSpillReadNumBatches]
+            .sum,
+        size / partitionRows);
+  }
+}
+
 TEST_F(WindowTest, spillUnsupported) {
   const vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -550,6 +605,64 @@ TEST_F(WindowTest, prePartitionedBuildWithSpill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, parallelEvaluation) {
+  const vector_size_t size = 10'000;
+  const int numPartitions = 500;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 7; }),
+          // Partition key. Partition 0 is larger than an output batch.
+          makeFlatVector<int16_t>(
+              size,
+              [](auto row) {
+                return row < 3'000 ? 0 : 1 + row % numPartitions;
+              }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> windows = {
+      "row_number() over (partition by p order by s desc)",
+      "rank() over (partition by p order by d)",
+      "sum(d) over (partition by p order by s rows between 2 preceding and current row)"};
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(windows)
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+  const auto sql = fmt::format(
+      "SELECT *, {} FROM tmp", fmt::join(windows.begin(), windows.end(), ", "));
+
+  for (const auto numSubPartitions : {1, 4}) {
+    SCOPED_TRACE(fmt::format("numSubPartitions: {}", numSubPartitions));
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+                    .config(core::QueryConfig::kMaxOutputBatchRows, "100")
+                    .config(
+                        core::QueryConfig::kWindowNumSubPartitions,
+                        std::to_string(numSubPartitions))
+                    .config(
+                        core::QueryConfig::kWindowParallelEvaluationWorkers,
+                        "4")
+                    .assertResults(sql);
+
+    // The small partitions are evaluated in parallel, the large one on the
+    // operator thread.
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at(windowId);
+    ASSERT_EQ(
+        stats.customStats.at(Window::kNumParallelPartitions).sum,
+        numPartitions);
+    ASSERT_EQ(
+        stats.customStats.count(Window::kParallelPartitionsCpuTime), 1);
+  }
+}
+
 DEBUG_ONLY_TEST_F(WindowTest, aggregationWithNonDefaultFrame) {
   const vector_size_t size = 1'00;
 
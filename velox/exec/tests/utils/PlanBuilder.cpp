@@ -506,23 +506,26 @@ PlanBuilder& PlanBuilder::traceScan(
     const std::string& traceNodeDir,
     uint32_t pipelineId,
     std::vector<uint32_t> driverIds,
-    const RowTypePtr& outputType) {
+    const RowTypePtr& outputType,
+    std::shared_ptr<const core::TraceScanNode::Inputs> inputs) {
   planNode_ = std::make_shared<core::TraceScanNode>(
       nextPlanNodeId(),
       traceNodeDir,
       pipelineId,
       std::move(driverIds),
-      outputType);
+      outputType,
+      std::move(inputs));
   VELOX_CHECK(!planNode_->supportsBarrier());
   return *this;
 }
 
 PlanBuilder& PlanBuilder::exchange(
     const RowTypePtr& outputType,
-    VectorSerde::Kind serdeKind) {
+    VectorSerde::Kind serdeKind,
+    bool broadcast) {
   VELOX_CHECK_NULL(planNode_, "Exchange must be the source node");
   planNode_ = std::make_shared<core::ExchangeNode>(
-      nextPlanNodeId(), outputType, serdeKind);
+      nextPlanNodeId(), outputType, serdeKind, broadcast);
   VELOX_CHECK(!planNode_->supportsBarrier());
   return *this;
 }
@@ -1217,6 +1220,45 @@ PlanBuilder& PlanBuilder::groupId(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    const std::string& groupIdName) {
+  partialAggregation(groupingKeys, aggregates);
+  const auto* partialAggNode =
+      dynamic_cast<const core::AggregationNode*>(planNode_.get());
+  const auto& partialAggregates = partialAggNode->aggregates();
+  const auto& aggregateNames = partialAggNode->aggregateNames();
+
+  // The final aggregates take the intermediate results of the partial
+  // aggregates as input and keep their names.
+  std::vector<std::string> finalAggregates;
+  std::vector<std::vector<TypePtr>> rawInputTypes;
+  finalAggregates.reserve(partialAggregates.size());
+  rawInputTypes.reserve(partialAggregates.size());
+  for (auto i = 0; i < partialAggregates.size(); ++i) {
+    const auto& aggregate = partialAggregates[i];
+    VELOX_USER_CHECK(
+        aggregate.mask == nullptr && !aggregate.distinct &&
+            aggregate.sortingKeys.empty(),
+        "Grouping sets aggregation doesn't support masks, DISTINCT or ORDER BY: {}",
+        aggregates[i]);
+    finalAggregates.push_back(fmt::format(
+        "{}({}) AS {}",
+        aggregate.call->name(),
+        aggregateNames[i],
+        aggregateNames[i]));
+    rawInputTypes.push_back(aggregate.rawInputTypes);
+  }
+
+  groupId(groupingKeys, groupingSets, aggregateNames, groupIdName);
+
+  auto finalGroupingKeys = groupingKeys;
+  finalGroupingKeys.push_back(groupIdName);
+  return finalAggregation(finalGroupingKeys, finalAggregates, rawInputTypes);
+}
+
 namespace {
 core::PlanNodePtr createLocalMergeNode(
     const core::PlanNodeId& id,
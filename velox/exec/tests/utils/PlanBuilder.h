@@ -661,11 +661,14 @@ class PlanBuilder {
   /// operator uses its driver instance id as the list index to get the traced
   /// driver id for replay.
   /// @param outputType The type of the tracing data.
+  /// @param inputs The traced input batches preloaded in memory, one list per
+  /// entry of 'driverIds'. If null, the scan reads the traced data files.
   PlanBuilder& traceScan(
       const std::string& traceNodeDir,
       uint32_t pipelineId,
       std::vector<uint32_t> driverIds,
-      const RowTypePtr& outputType);
+      const RowTypePtr& outputType,
+      std::shared_ptr<const core::TraceScanNode::Inputs> inputs = nullptr);
 
   /// Add an ExchangeNode.
   ///
@@ -674,9 +677,11 @@ class PlanBuilder {
   ///
   /// @param outputType The type of the data coming in and out of the exchange.
   /// @param serdekind The kind of seralized data format.
+  /// @param broadcast Whether every consumer task receives all the rows.
   PlanBuilder& exchange(
       const RowTypePtr& outputType,
-      VectorSerde::Kind serdekind);
+      VectorSerde::Kind serdekind,
+      bool broadcast = false);
 
   /// Add a MergeExchangeNode using specified ORDER BY clauses.
   ///
@@ -1068,6 +1073,24 @@ class PlanBuilder {
       const std::vector<std::string>& aggregationInputs,
       std::string groupIdName = "group_id");
 
+  /// Add an aggregation over grouping sets that replicates pre-aggregated
+  /// rows instead of the raw input. Adds a partial aggregation on all
+  /// 'groupingKeys', a GroupIdNode over the partial results and a final
+  /// aggregation on the grouping keys and the group ID column. Only the
+  /// finest grouping set is aggregated from the raw input and the coarser
+  /// sets are merged from its intermediate results, so the input to the
+  /// GroupIdNode shrinks by the fan-in of the finest grouping set.
+  ///
+  /// The output has the grouping keys, the group ID column and the aggregates
+  /// in this order. Aggregates are specified as in partialAggregation() and
+  /// must not have masks, DISTINCT or ORDER BY clauses. Grouping keys must be
+  /// input column names without aliases.
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      const std::string& groupIdName = "group_id");
+
   /// Add an ExpandNode using specified projections. See comments for
   /// ExpandNode class for description of this plan node.
   ///
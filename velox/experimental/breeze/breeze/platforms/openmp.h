@@ -360,20 +360,20 @@ struct OpenMPPlatform {
     static_assert(WARP_THREADS == BLOCK_THREADS,
                   "WARP_THREADS must be the same as BLOCK_THREADS");
 
+    // Each thread publishes its value and one thread computes the inclusive
+    // prefix sum over them. This takes 3 barriers instead of one per thread.
     T* scratch = reinterpret_cast<T*>(shared_scratch_);
-#pragma omp single
-    scratch[0] = static_cast<T>(0);
-
-    // FIXME: this is really slow
     int idx = omp_get_thread_num();
-    for (int i = 0; i < BLOCK_THREADS; ++i) {
-      if (idx == i) {
-        scratch[0] += value;
-        value = scratch[0];
-      }
+    scratch[idx] = value;
 #pragma omp barrier
+#pragma omp single
+    {
+      for (int i = 1; i < BLOCK_THREADS; ++i) {
+        scratch[i] += scratch[i - 1];
+      }
     }
-
+    value = scratch[idx];
+#pragma omp barrier
     return value;
   }
   template <typename T>
@@ -420,6 +420,8 @@ struct OpenMPPlatform {
   template <typename SliceT>
   inline void prefetch(SliceT) {}
   int block_idx_;
+  // Scratch shared by all threads of the block. Holds one 'uintmax_t' per
+  // thread.
   void* shared_scratch_;
 };
 
@@ -41,7 +41,7 @@ void OpenMPTestLaunch(int num_blocks,
                       void (*kernel)(PlatformT, SharedMemType*, Params...),
                       disable_deduction_t<Params>... args) {
   SharedMemType shared_mem;
-  char scratch[sizeof(uintmax_t)];
+  alignas(uintmax_t) char scratch[BLOCK_THREADS * sizeof(uintmax_t)];
 #pragma omp parallel shared(shared_mem, scratch) num_threads(BLOCK_THREADS)
   {
     for (int b = 0; b < num_blocks; ++b) {
@@ -56,7 +56,7 @@ void OpenMPTestLaunch(int num_blocks,
 template <int BLOCK_THREADS, typename PlatformT, typename... Params>
 void OpenMPTestLaunch(int num_blocks, void (*kernel)(PlatformT, Params...),
                       disable_deduction_t<Params>... args) {
-  char scratch[sizeof(uintmax_t)];
+  alignas(uintmax_t) char scratch[BLOCK_THREADS * sizeof(uintmax_t)];
 #pragma omp parallel shared(scratch) num_threads(BLOCK_THREADS)
   {
     for (int b = 0; b < num_blocks; ++b) {
@@ -35,6 +35,10 @@ struct CudfConfig {
       "cudf.ast_expression_priority"};
   static constexpr const char* kCudfAllowCpuFallback{"cudf.allow_cpu_fallback"};
   static constexpr const char* kCudfLogFallback{"cudf.log_fallback"};
+  static constexpr const char* kCudfCostBasedPlacement{
+      "cudf.cost_based_placement"};
+  static constexpr const char* kCudfTransferNanosPerByte{
+      "cudf.transfer_nanos_per_byte"};
 
   /// Singleton CudfConfig instance.
   /// Clients must set the configs below before invoking registerCudf().
@@ -78,6 +82,15 @@ struct CudfConfig {
 
   /// Whether to log a reason for falling back to Velox CPU execution.
   bool logFallback{true};
+
+  /// If true, keeps runs of supported operators on CPU when the estimated
+  /// cost of the CPU/GPU transitions around them exceeds the estimated gain
+  /// of running them on GPU.
+  bool costBasedPlacement{false};
+
+  /// Estimated time to move one byte between host and device, used by the
+  /// cost-based placement.
+  double transferNanosPerByte{0.1};
 };
 
 } // namespace facebook::velox::cudf_velox
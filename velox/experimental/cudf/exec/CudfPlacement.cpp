@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/cudf/exec/CudfPlacement.h"
+
+namespace facebook::velox::cudf_velox {
+
+namespace {
+// Size estimate for a variable width or nested value.
+constexpr int64_t kVariableWidthBytes = 32;
+} // namespace
+
+std::vector<bool> placeOperators(
+    const std::vector<OperatorPlacementInfo>& operators,
+    bool isOutputDriver,
+    const PlacementCosts& costs) {
+  const auto numOperators = operators.size();
+  std::vector<bool> onGpu(numOperators);
+  for (auto i = 0; i < numOperators; ++i) {
+    onGpu[i] = operators[i].gpuSupported;
+  }
+
+  const double transitionNanosPerRow =
+      costs.transitionNanos / std::max(1, costs.batchRows);
+  auto begin = 0;
+  while (begin < numOperators) {
+    if (!onGpu[begin]) {
+      ++begin;
+      continue;
+    }
+    auto end = begin;
+    bool pinned = false;
+    double gain = 0;
+    while (end < numOperators && onGpu[end]) {
+      pinned |= operators[end].pinned;
+      gain += operators[end].gainNanosPerRow;
+      ++end;
+    }
+
+    double cost = 0;
+    const auto& first = operators[begin];
+    if (begin > 0 && first.acceptsGpuInput) {
+      cost += first.inputRowBytes * costs.transferNanosPerByte +
+          transitionNanosPerRow;
+    }
+    const auto& last = operators[end - 1];
+    if (last.producesGpuOutput && (end < numOperators || isOutputDriver)) {
+      cost += last.outputRowBytes * costs.transferNanosPerByte +
+          transitionNanosPerRow;
+    }
+
+    if (!pinned && cost >= gain) {
+      std::fill(onGpu.begin() + begin, onGpu.begin() + end, false);
+    }
+    begin = end;
+  }
+  return onGpu;
+}
+
+int64_t estimateRowBytes(const RowTypePtr& type) {
+  int64_t bytes = 0;
+  for (const auto& child : type->children()) {
+    if (child->isPrimitiveType() && child->isFixedWidth()) {
+      bytes += child->cppSizeInBytes();
+    } else {
+      bytes += kVariableWidthBytes;
+    }
+  }
+  return bytes;
+}
+
+} // namespace facebook::velox::cudf_velox
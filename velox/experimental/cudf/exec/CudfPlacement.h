@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/type/Type.h"
+
+#include <vector>
+
+namespace facebook::velox::cudf_velox {
+
+/// What the cost-based placement needs to know about one operator of a
+/// Driver.
+struct OperatorPlacementInfo {
+  /// True if the operator has a cuDF replacement.
+  bool gpuSupported{false};
+
+  /// True if the operator must run on GPU when supported, e.g. because its
+  /// counterpart in another pipeline exchanges cuDF data with it, like a hash
+  /// join build and probe or a local exchange.
+  bool pinned{false};
+
+  /// True if a CPU to GPU transition is inserted before the operator when
+  /// the previous operator runs on CPU.
+  bool acceptsGpuInput{false};
+
+  /// True if a GPU to CPU transition is inserted after the operator when the
+  /// next operator runs on CPU.
+  bool producesGpuOutput{false};
+
+  /// Estimated time saved per input row by running the operator on GPU.
+  double gainNanosPerRow{0};
+
+  /// Estimated bytes per input and output row.
+  int64_t inputRowBytes{0};
+  int64_t outputRowBytes{0};
+};
+
+struct PlacementCosts {
+  /// Time to move one byte between host and device.
+  double transferNanosPerByte{0.1};
+
+  /// Fixed cost of one transition between CPU and GPU for a batch, e.g. the
+  /// stream synchronization and the allocations.
+  double transitionNanos{20'000};
+
+  /// Expected rows per batch over which 'transitionNanos' is amortized.
+  int32_t batchRows{1'024};
+};
+
+/// Returns for each operator of a Driver whether it runs on GPU. Starts from
+/// the supported operators and moves each maximal run of consecutive
+/// supported operators back to CPU if the transitions the run needs cost
+/// more than the run gains. Runs with a pinned operator stay on GPU. An
+/// unsupported operator only splits the run it is in, so that the rest of
+/// the Driver can stay on GPU. 'isOutputDriver' is true if the result of the
+/// last operator leaves the task and must be on CPU.
+std::vector<bool> placeOperators(
+    const std::vector<OperatorPlacementInfo>& operators,
+    bool isOutputDriver,
+    const PlacementCosts& costs);
+
+/// Returns the estimated size in bytes of a row of 'type'. Variable width
+/// and nested columns count a fixed estimate.
+int64_t estimateRowBytes(const RowTypePtr& type);
+
+/// Rough per row gains of running an operator on GPU.
+struct GpuGainNanosPerRow {
+  static constexpr double kOrderBy{40};
+  static constexpr double kTopN{10};
+  static constexpr double kHashJoin{20};
+  static constexpr double kAggregation{10};
+  static constexpr double kPerAggregate{5};
+  static constexpr double kPerExpression{2};
+  static constexpr double kLimit{0};
+  static constexpr double kAssignUniqueId{0.5};
+};
+
+} // namespace facebook::velox::cudf_velox
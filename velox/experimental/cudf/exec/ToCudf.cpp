@@ -26,6 +26,7 @@
 #include "velox/experimental/cudf/exec/CudfLocalPartition.h"
 #include "velox/experimental/cudf/exec/CudfOperator.h"
 #include "velox/experimental/cudf/exec/CudfOrderBy.h"
+#include "velox/experimental/cudf/exec/CudfPlacement.h"
 #include "velox/experimental/cudf/exec/CudfTopN.h"
 #include "velox/experimental/cudf/exec/ToCudf.h"
 #include "velox/experimental/cudf/exec/Utilities.h"
@@ -244,6 +245,85 @@ bool CompileState::compile(bool allowCpuFallback) {
         (isTableScanSupported(op)) || (isAggregationSupported(op));
   };
 
+  auto estimateGainNanosPerRow = [getPlanNode](const exec::Operator* op) {
+    if (isAnyOf<exec::OrderBy>(op)) {
+      return GpuGainNanosPerRow::kOrderBy;
+    }
+    if (isAnyOf<exec::TopN>(op)) {
+      return GpuGainNanosPerRow::kTopN;
+    }
+    if (isAnyOf<exec::HashBuild, exec::HashProbe>(op)) {
+      return GpuGainNanosPerRow::kHashJoin;
+    }
+    if (isAnyOf<exec::HashAggregation, exec::StreamingAggregation>(op)) {
+      auto planNode = std::dynamic_pointer_cast<const core::AggregationNode>(
+          getPlanNode(op->planNodeId()));
+      VELOX_CHECK(planNode != nullptr);
+      return GpuGainNanosPerRow::kAggregation +
+          GpuGainNanosPerRow::kPerAggregate * planNode->aggregates().size();
+    }
+    if (auto filterProjectOp = dynamic_cast<const exec::FilterProject*>(op)) {
+      auto projectPlanNode = std::dynamic_pointer_cast<const core::ProjectNode>(
+          getPlanNode(filterProjectOp->planNodeId()));
+      // Column pass-through projections cost nothing on either side.
+      int32_t numExpressions = filterProjectOp->filterNode() ? 1 : 0;
+      if (projectPlanNode) {
+        for (const auto& projection : projectPlanNode->projections()) {
+          if (!projection->isFieldAccessKind()) {
+            ++numExpressions;
+          }
+        }
+      }
+      return GpuGainNanosPerRow::kPerExpression * numExpressions;
+    }
+    if (isAnyOf<exec::AssignUniqueId>(op)) {
+      return GpuGainNanosPerRow::kAssignUniqueId;
+    }
+    return GpuGainNanosPerRow::kLimit;
+  };
+
+  // Supported operators that the cost-based placement keeps on CPU.
+  std::vector<bool> isPlacedOnCpu(operators.size(), false);
+  if (CudfConfig::getInstance().costBasedPlacement) {
+    std::vector<OperatorPlacementInfo> placementInfos(operators.size());
+    for (auto i = 0; i < operators.size(); ++i) {
+      const auto* op = operators[i];
+      auto& info = placementInfos[i];
+      info.gpuSupported = isSupportedGpuOperators[i];
+      if (!info.gpuSupported) {
+        continue;
+      }
+      // These operators exchange cuDF data with their counterparts in other
+      // pipelines, or produce it regardless of placement.
+      info.pinned = isAnyOf<
+          exec::HashBuild,
+          exec::HashProbe,
+          exec::LocalPartition,
+          exec::LocalExchange,
+          exec::TableScan,
+          CudfOperator>(op);
+      info.acceptsGpuInput = acceptsGpuInput(op);
+      info.producesGpuOutput = producesGpuOutput(op);
+      info.gainNanosPerRow = estimateGainNanosPerRow(op);
+      auto planNode = getPlanNode(op->planNodeId());
+      info.outputRowBytes = estimateRowBytes(planNode->outputType());
+      info.inputRowBytes = planNode->sources().empty()
+          ? info.outputRowBytes
+          : estimateRowBytes(planNode->sources()[0]->outputType());
+    }
+    PlacementCosts costs;
+    costs.transferNanosPerByte = CudfConfig::getInstance().transferNanosPerByte;
+    costs.batchRows = ctx->queryConfig().preferredOutputBatchRows();
+    const auto onGpu =
+        placeOperators(placementInfos, driverFactory_.outputDriver, costs);
+    for (auto i = 0; i < operators.size(); ++i) {
+      if (isSupportedGpuOperators[i] && !onGpu[i]) {
+        isSupportedGpuOperators[i] = false;
+        isPlacedOnCpu[i] = true;
+      }
+    }
+  }
+
   int32_t operatorsOffset = 0;
   for (int32_t operatorIndex = 0; operatorIndex < operators.size();
        ++operatorIndex) {
@@ -253,6 +333,15 @@ bool CompileState::compile(bool allowCpuFallback) {
     auto replacingOperatorIndex = operatorIndex + operatorsOffset;
     VELOX_CHECK(oper);
 
+    if (isPlacedOnCpu[operatorIndex]) {
+      if (CudfConfig::getInstance().debugEnabled) {
+        LOG(INFO) << "Operator: ID " << oper->operatorId() << ": "
+                  << oper->toString() << " is kept on CPU by cost"
+                  << std::endl;
+      }
+      continue;
+    }
+
     const bool previousOperatorIsNotGpu =
         (operatorIndex > 0 and !isSupportedGpuOperators[operatorIndex - 1]);
     const bool nextOperatorIsNotGpu =
@@ -556,6 +645,12 @@ void CudfConfig::initialize(
   if (config.find(kCudfLogFallback) != config.end()) {
     logFallback = folly::to<bool>(config[kCudfLogFallback]);
   }
+  if (config.find(kCudfCostBasedPlacement) != config.end()) {
+    costBasedPlacement = folly::to<bool>(config[kCudfCostBasedPlacement]);
+  }
+  if (config.find(kCudfTransferNanosPerByte) != config.end()) {
+    transferNanosPerByte = folly::to<double>(config[kCudfTransferNanosPerByte]);
+  }
 }
 
 } // namespace facebook::velox::cudf_velox
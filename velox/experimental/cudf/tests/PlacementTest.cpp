@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/cudf/exec/CudfPlacement.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::cudf_velox::test {
+namespace {
+
+OperatorPlacementInfo cpuOperator() {
+  return OperatorPlacementInfo{};
+}
+
+OperatorPlacementInfo
+gpuOperator(double gainNanosPerRow, int64_t rowBytes, bool pinned = false) {
+  OperatorPlacementInfo info;
+  info.gpuSupported = true;
+  info.pinned = pinned;
+  info.acceptsGpuInput = true;
+  info.producesGpuOutput = true;
+  info.gainNanosPerRow = gainNanosPerRow;
+  info.inputRowBytes = rowBytes;
+  info.outputRowBytes = rowBytes;
+  return info;
+}
+
+PlacementCosts noTransitionCost() {
+  PlacementCosts costs;
+  costs.transferNanosPerByte = 1;
+  costs.transitionNanos = 0;
+  return costs;
+}
+
+} // namespace
+
+TEST(PlacementTest, profitableRun) {
+  // A run that gains more than its two transitions stays on GPU.
+  std::vector<OperatorPlacementInfo> operators = {
+      cpuOperator(), gpuOperator(10, 8), gpuOperator(40, 8), cpuOperator()};
+  ASSERT_EQ(
+      placeOperators(operators, false, noTransitionCost()),
+      std::vector<bool>({false, true, true, false}));
+}
+
+TEST(PlacementTest, unprofitableRun) {
+  // A cheap run between CPU operators moves to CPU.
+  std::vector<OperatorPlacementInfo> operators = {
+      cpuOperator(), gpuOperator(2, 16), cpuOperator(), gpuOperator(100, 16)};
+  ASSERT_EQ(
+      placeOperators(operators, true, noTransitionCost()),
+      std::vector<bool>({false, false, false, true}));
+
+  // No transition after the last operator unless the Driver produces the task
+  // output.
+  operators = {cpuOperator(), gpuOperator(20, 16)};
+  ASSERT_EQ(
+      placeOperators(operators, false, noTransitionCost()),
+      std::vector<bool>({false, true}));
+  ASSERT_EQ(
+      placeOperators(operators, true, noTransitionCost()),
+      std::vector<bool>({false, false}));
+}
+
+TEST(PlacementTest, pinnedRun) {
+  std::vector<OperatorPlacementInfo> operators = {
+      cpuOperator(), gpuOperator(0, 100, true), cpuOperator()};
+  ASSERT_EQ(
+      placeOperators(operators, true, noTransitionCost()),
+      std::vector<bool>({false, true, false}));
+}
+
+TEST(PlacementTest, transitionOverhead) {
+  std::vector<OperatorPlacementInfo> operators = {
+      cpuOperator(), gpuOperator(12, 1), cpuOperator()};
+  auto costs = noTransitionCost();
+  ASSERT_EQ(
+      placeOperators(operators, true, costs),
+      std::vector<bool>({false, true, false}));
+
+  // The fixed cost per transition weighs more with small batches.
+  costs.transitionNanos = 1'000;
+  costs.batchRows = 100;
+  ASSERT_EQ(
+      placeOperators(operators, true, costs),
+      std::vector<bool>({false, false, false}));
+  costs.batchRows = 10'000;
+  ASSERT_EQ(
+      placeOperators(operators, true, costs),
+      std::vector<bool>({false, true, false}));
+}
+
+TEST(PlacementTest, estimateRowBytes) {
+  ASSERT_EQ(estimateRowBytes(ROW({BIGINT(), INTEGER(), DOUBLE()})), 20);
+  ASSERT_EQ(estimateRowBytes(ROW({VARCHAR(), ARRAY(BIGINT())})), 64);
+}
+
+} // namespace facebook::velox::cudf_velox::test
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/parquet/ParquetFormatData.h"
+
+#include "velox/experimental/wave/vector/WaveVector.h"
+
+DECLARE_int32(wave_reader_rows_per_tb);
+
+namespace facebook::velox::wave {
+
+namespace {
+
+uint64_t readVarint(std::string_view data, int32_t& pos) {
+  uint64_t value = 0;
+  for (int32_t shift = 0;; shift += 7) {
+    VELOX_CHECK_LT(pos, data.size(), "Truncated varint in Parquet page");
+    const auto byte = static_cast<uint8_t>(data[pos++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+}
+
+// Appends 'numValues' values of the RLE/bit packed hybrid encoding in 'data'
+// to 'result'.
+void decodeHybrid(
+    std::string_view data,
+    int32_t bitWidth,
+    int32_t numValues,
+    std::vector<uint32_t>& result) {
+  VELOX_CHECK_LE(bitWidth, 32);
+  const auto end = result.size() + numValues;
+  const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+  int32_t pos = 0;
+  while (result.size() < end) {
+    const auto header = readVarint(data, pos);
+    if (header & 1) {
+      // Bit packed run of groups of 8 values.
+      const auto count = (header >> 1) * 8;
+      const auto numBits = count * bitWidth;
+      VELOX_CHECK_LE(pos + bits::nbytes(numBits), data.size());
+      const auto numUsed = std::min<uint64_t>(count, end - result.size());
+      for (auto i = 0; i < numUsed; ++i) {
+        uint32_t value = 0;
+        for (auto bit = 0; bit < bitWidth; ++bit) {
+          if (bits::isBitSet(bytes + pos, i * bitWidth + bit)) {
+            value |= 1U << bit;
+          }
+        }
+        result.push_back(value);
+      }
+      pos += bits::nbytes(numBits);
+    } else {
+      // RLE run of one little endian value of the byte width of 'bitWidth'.
+      const auto count = header >> 1;
+      const auto byteWidth = bits::nbytes(bitWidth);
+      VELOX_CHECK_LE(pos + byteWidth, data.size());
+      uint32_t value = 0;
+      for (auto i = 0; i < byteWidth; ++i) {
+        value |= static_cast<uint32_t>(bytes[pos + i]) << (i * 8);
+      }
+      pos += byteWidth;
+      const auto numUsed = std::min<uint64_t>(count, end - result.size());
+      result.insert(result.end(), numUsed, value);
+    }
+  }
+}
+
+// Returns 'values' bit packed with 'bitWidth' bits per value. There is one
+// extra word at the end since the device side unpacking may read past the
+// last value.
+BufferPtr bitPack(
+    const std::vector<uint32_t>& values,
+    int32_t bitWidth,
+    memory::MemoryPool& pool) {
+  const auto numWords = bits::nwords(values.size() * bitWidth) + 1;
+  auto buffer = AlignedBuffer::allocate<uint64_t>(numWords, &pool, 0);
+  auto* words = buffer->asMutable<uint64_t>();
+  for (auto i = 0; i < values.size(); ++i) {
+    const uint64_t bit = static_cast<uint64_t>(i) * bitWidth;
+    const auto shift = bit % 64;
+    words[bit / 64] |= static_cast<uint64_t>(values[i]) << shift;
+    if (shift + bitWidth > 64) {
+      words[bit / 64 + 1] |= static_cast<uint64_t>(values[i]) >> (64 - shift);
+    }
+  }
+  return buffer;
+}
+
+void checkPlainKind(WaveTypeKind kind) {
+  switch (kind) {
+    case WaveTypeKind::TINYINT:
+    case WaveTypeKind::SMALLINT:
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::REAL:
+    case WaveTypeKind::DOUBLE:
+      return;
+    default:
+      VELOX_NYI(
+          "Unsupported Parquet type for Wave decoding: {}",
+          static_cast<int32_t>(kind));
+  }
+}
+
+} // namespace
+
+std::unique_ptr<FormatData> ParquetFormatParams::toFormatData(
+    const std::shared_ptr<const dwio::common::TypeWithId>& type,
+    const velox::common::ScanSpec& scanSpec,
+    OperandId operand) {
+  const ParquetColumnChunk* chunk = nullptr;
+  if (type->id() != 0) {
+    auto it = rowGroup_.columns.find(type->id());
+    VELOX_CHECK(
+        it != rowGroup_.columns.end(),
+        "No Parquet column chunk for column {}",
+        type->id());
+    chunk = &it->second;
+  }
+  return std::make_unique<ParquetFormatData>(
+      operand, rowGroup_.numRows, chunk, pool());
+}
+
+ParquetDecodedPages decodeParquetPages(
+    const ParquetColumnChunk& chunk,
+    int32_t numRows,
+    memory::MemoryPool& pool) {
+  VELOX_CHECK_LE(
+      chunk.maxDefinitionLevel,
+      1,
+      "Nested Parquet columns are not supported by Wave");
+  checkPlainKind(chunk.kind);
+  const auto valueSize = waveTypeKindSize(chunk.kind);
+
+  ParquetDecodedPages result;
+  uint64_t* rawNulls = nullptr;
+  if (chunk.maxDefinitionLevel > 0) {
+    result.nulls =
+        AlignedBuffer::allocate<bool>(numRows, &pool, bits::kNotNull);
+    rawNulls = result.nulls->asMutable<uint64_t>();
+  }
+
+  std::vector<uint32_t> levels;
+  std::vector<uint32_t> indices;
+  std::string plainValues;
+  int32_t row = 0;
+  for (const auto& page : chunk.pages) {
+    int32_t numNonNull = page.numValues;
+    if (rawNulls) {
+      levels.clear();
+      decodeHybrid(page.definitionLevels, 1, page.numValues, levels);
+      for (auto i = 0; i < page.numValues; ++i) {
+        if (levels[i] == 0) {
+          bits::setNull(rawNulls, row + i);
+          --numNonNull;
+        }
+      }
+    }
+    row += page.numValues;
+    result.numNonNull += numNonNull;
+
+    switch (page.encoding) {
+      case ParquetPageEncoding::kPlain:
+        VELOX_CHECK(
+            chunk.dictionary.empty(),
+            "Mixing PLAIN and dictionary pages is not supported by Wave");
+        VELOX_CHECK_GE(page.values.size(), numNonNull * valueSize);
+        plainValues.append(page.values.data(), numNonNull * valueSize);
+        break;
+      case ParquetPageEncoding::kRleDictionary: {
+        VELOX_CHECK(!chunk.dictionary.empty());
+        VELOX_CHECK(!page.values.empty());
+        const int32_t pageBitWidth = static_cast<uint8_t>(page.values[0]);
+        result.bitWidth = std::max(result.bitWidth, pageBitWidth);
+        decodeHybrid(page.values.substr(1), pageBitWidth, numNonNull, indices);
+        break;
+      }
+    }
+  }
+  VELOX_CHECK_EQ(row, numRows);
+
+  if (chunk.dictionary.empty()) {
+    result.bitWidth = valueSize * 8;
+    result.values = AlignedBuffer::allocate<char>(
+        plainValues.size() + sizeof(uint64_t), &pool, 0);
+    memcpy(
+        result.values->asMutable<char>(),
+        plainValues.data(),
+        plainValues.size());
+  } else {
+    VELOX_CHECK_EQ(chunk.dictionary.size() % valueSize, 0);
+    result.values = bitPack(indices, result.bitWidth, pool);
+  }
+  return result;
+}
+
+void ParquetFormatData::preparePages() {
+  if (prepared_) {
+    return;
+  }
+  prepared_ = true;
+  VELOX_CHECK_NOT_NULL(chunk_);
+  pages_ = decodeParquetPages(*chunk_, totalRows_, pool_);
+}
+
+BufferId ParquetFormatData::stageNulls(
+    ResultStaging& deviceStaging,
+    SplitStaging& splitStaging) {
+  if (!pages_.nulls) {
+    nullsStaged_ = true;
+    return kNotRegistered;
+  }
+
+  if (nullsStaged_) {
+    splitStaging.addDependency(nullsStagingId_);
+    return kNotRegistered;
+  }
+  nullsStaged_ = true;
+  Staging staging(
+      pages_.nulls->as<char>(),
+      bits::nwords(totalRows_) * sizeof(uint64_t),
+      common::Region{0, 0});
+  nullsBufferId_ = splitStaging.add(staging);
+  nullsStagingId_ = splitStaging.id();
+  splitStaging.registerPointer(nullsBufferId_, &grid_.nulls, true);
+  return nullsBufferId_;
+}
+
+void ParquetFormatData::griddize(
+    ColumnOp& op,
+    int32_t blockSize,
+    int32_t numBlocks,
+    ResultStaging& deviceStaging,
+    ResultStaging& resultStaging,
+    SplitStaging& staging,
+    DecodePrograms& programs,
+    ReadStream& stream) {
+  constexpr int32_t kCountStride = 1024;
+  if (griddized_) {
+    return;
+  }
+  griddized_ = true;
+  preparePages();
+  if (!pages_.nulls) {
+    return;
+  }
+  // If the whole row group is covered by a single TB, there is no need for a
+  // separate griddize kernel.
+  if (blockSize >= totalRows_) {
+    return;
+  }
+  auto id = stageNulls(deviceStaging, staging);
+
+  auto count = std::make_unique<GpuDecode>();
+  staging.registerPointer(id, &count->data.countBits.bits, true);
+  auto numStrides = bits::roundUp(totalRows_, kCountStride) / kCountStride;
+  auto resultId = deviceStaging.reserve(sizeof(int32_t) * numStrides);
+  deviceStaging.registerPointer(resultId, &count->result, true);
+  deviceStaging.registerPointer(resultId, &grid_.numNonNull, true);
+  count->step = DecodeStep::kCountBits;
+  count->data.countBits.numBits = totalRows_;
+  count->data.countBits.resultStride = kCountStride;
+  programs.programs.emplace_back();
+  programs.programs.back().push_back(std::move(count));
+}
+
+void ParquetFormatData::startOp(
+    ColumnOp& op,
+    const ColumnOp* previousFilter,
+    ResultStaging& deviceStaging,
+    ResultStaging& resultStaging,
+    SplitStaging& splitStaging,
+    DecodePrograms& program,
+    ReadStream& stream) {
+  VELOX_CHECK_NOT_NULL(chunk_);
+  preparePages();
+  BufferId id = kNoBufferId;
+  BufferId dictionaryId = kNoBufferId;
+  // If nulls were not staged on device in griddize() they will be moved now for
+  // the single TB.
+  stageNulls(deviceStaging, splitStaging);
+  if (!staged_) {
+    staged_ = true;
+    Staging staging(
+        pages_.values->as<char>(),
+        pages_.values->size(),
+        common::Region{0, 0});
+    id = splitStaging.add(staging);
+    if (!chunk_->dictionary.empty()) {
+      // PLAIN dictionary values are in the layout of the decoded alphabet, so
+      // they need no separate decoding kernel.
+      Staging dictionary(
+          chunk_->dictionary.data(),
+          chunk_->dictionary.size(),
+          common::Region{0, 0});
+      dictionaryId = splitStaging.add(dictionary);
+    }
+    lastStagingId_ = splitStaging.id();
+  } else {
+    splitStaging.addDependency(lastStagingId_);
+  }
+  auto rowsPerBlock = FLAGS_wave_reader_rows_per_tb;
+  int32_t numBlocks =
+      bits::roundUp(op.rows.size(), rowsPerBlock) / rowsPerBlock;
+  if (numBlocks > 1) {
+    VELOX_CHECK(griddized_);
+  }
+  VELOX_CHECK_LT(numBlocks, 256 * 256, "Overflow 16 bit block number");
+  for (auto blockIdx = 0; blockIdx < numBlocks; ++blockIdx) {
+    auto step = makeStep(
+        op,
+        previousFilter,
+        deviceStaging,
+        splitStaging,
+        stream,
+        chunk_->kind,
+        blockIdx);
+    step->encoding = DecodeStep::kDictionaryOnBitpack;
+    step->dictMode =
+        chunk_->dictionary.empty() ? DictMode::kNone : DictMode::kDict;
+    step->data.dictionaryOnBitpack.alphabet = deviceDictionary_;
+    step->data.dictionaryOnBitpack.baseline = 0;
+    step->data.dictionaryOnBitpack.bitWidth = pages_.bitWidth;
+    step->data.dictionaryOnBitpack.indices = nullptr;
+    step->data.dictionaryOnBitpack.begin = currentRow_;
+    if (id != kNoBufferId) {
+      splitStaging.registerPointer(
+          id, &step->data.dictionaryOnBitpack.indices, true);
+      if (dictionaryId != kNoBufferId) {
+        splitStaging.registerPointer(
+            dictionaryId, &step->data.dictionaryOnBitpack.alphabet, true);
+      }
+      if (blockIdx == 0) {
+        splitStaging.registerPointer(id, &deviceBuffer_, true);
+        if (dictionaryId != kNoBufferId) {
+          splitStaging.registerPointer(dictionaryId, &deviceDictionary_, true);
+        }
+      }
+    } else {
+      step->data.dictionaryOnBitpack.indices =
+          reinterpret_cast<uint64_t*>(deviceBuffer_);
+    }
+    op.isFinal = true;
+    std::vector<std::unique_ptr<GpuDecode>>* steps;
+
+    // Programs are parallel after filters
+    if (stream.filtersDone() || !previousFilter) {
+      program.programs.emplace_back();
+      steps = &program.programs.back();
+    } else {
+      steps = &program.programs[blockIdx];
+    }
+    steps->push_back(std::move(step));
+  }
+}
+
+} // namespace facebook::velox::wave
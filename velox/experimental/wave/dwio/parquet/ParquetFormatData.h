@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/common/TypeWithId.h"
+#include "velox/experimental/wave/dwio/ColumnReader.h"
+#include "velox/experimental/wave/dwio/FormatData.h"
+#include "velox/experimental/wave/dwio/decode/DecodeStep.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+namespace facebook::velox::wave {
+
+/// Encoding of the values of a Parquet data page.
+enum class ParquetPageEncoding {
+  // Fixed width little endian values.
+  kPlain,
+  // 1 byte bit width followed by RLE/bit packed hybrid dictionary indices.
+  kRleDictionary,
+};
+
+/// A decompressed Parquet data page. The page header is parsed by the caller.
+struct ParquetPage {
+  ParquetPageEncoding encoding;
+
+  /// Number of values including nulls.
+  int32_t numValues{0};
+
+  /// RLE/bit packed hybrid definition levels without the length prefix. Empty
+  /// if the column is not nullable.
+  std::string_view definitionLevels;
+
+  /// Encoded values for the non-null rows.
+  std::string_view values;
+};
+
+/// The decompressed pages of a column chunk of a row group.
+struct ParquetColumnChunk {
+  WaveTypeKind kind;
+
+  /// 0 for a required column, 1 for an optional top level column. Nested
+  /// columns are not supported.
+  int32_t maxDefinitionLevel{0};
+
+  /// PLAIN encoded values of the dictionary page. Empty if there is no
+  /// dictionary.
+  std::string_view dictionary;
+
+  std::vector<ParquetPage> pages;
+};
+
+struct ParquetRowGroup {
+  int32_t numRows{0};
+
+  /// Map from the id of the column in the file schema to its chunk.
+  folly::F14FastMap<int32_t, ParquetColumnChunk> columns;
+};
+
+/// The pages of a column chunk expanded on the host into a single bit packed
+/// run for the device.
+struct ParquetDecodedPages {
+  /// Bit packed values or dictionary indices of the non-null rows of all
+  /// pages, followed by one extra word since the device side unpacking may
+  /// read past the last value.
+  BufferPtr values;
+
+  /// Bit width of 'values'.
+  int32_t bitWidth{0};
+
+  /// Null flags of all rows, nullptr if the column has no nulls.
+  BufferPtr nulls;
+
+  /// Number of non-null values in 'values'.
+  int32_t numNonNull{0};
+};
+
+/// Expands the definition levels and the values of the pages of 'chunk',
+/// which has 'numRows' rows. PLAIN values are copied as is. Dictionary
+/// indices are bit packed with the largest bit width of the pages. Only
+/// fixed width integer and floating point columns that are required or
+/// optional at the top level are supported. Strings, booleans, nested columns
+/// and the DELTA encodings raise NYI.
+ParquetDecodedPages decodeParquetPages(
+    const ParquetColumnChunk& chunk,
+    int32_t numRows,
+    memory::MemoryPool& pool);
+
+/// Decodes a Parquet column chunk on device with the same GpuDecode steps
+/// that are used for the other formats. PLAIN pages are decoded as bit packed
+/// values with a bit width of the value size and dictionary pages as bit
+/// packed indices into the staged dictionary. The definition levels and the
+/// RLE runs of the hybrid encoding are expanded on the host when the column
+/// is first staged, so that the device sees a single bit packed run per
+/// column chunk.
+class ParquetFormatData : public wave::FormatData {
+ public:
+  static constexpr int32_t kNotRegistered = -1;
+
+  ParquetFormatData(
+      OperandId operand,
+      int32_t totalRows,
+      const ParquetColumnChunk* chunk,
+      memory::MemoryPool& pool)
+      : operand_(operand), totalRows_(totalRows), chunk_(chunk), pool_(pool) {}
+
+  bool hasNulls() const override {
+    return chunk_ != nullptr && chunk_->maxDefinitionLevel > 0;
+  }
+
+  int32_t totalRows() const override {
+    return totalRows_;
+  }
+
+  void newBatch(int32_t startRow) override {
+    currentRow_ = startRow;
+    queued_ = false;
+  }
+
+  void griddize(
+      ColumnOp& op,
+      int32_t blockSize,
+      int32_t numBlocks,
+      ResultStaging& deviceStaging,
+      ResultStaging& resultStaging,
+      SplitStaging& staging,
+      DecodePrograms& programs,
+      ReadStream& stream) override;
+
+  void startOp(
+      ColumnOp& op,
+      const ColumnOp* previousFilter,
+      ResultStaging& deviceStaging,
+      ResultStaging& resultStaging,
+      SplitStaging& staging,
+      DecodePrograms& program,
+      ReadStream& stream) override;
+
+ private:
+  // Expands the pages of 'chunk_' into 'pages_'. No-op after the first call.
+  void preparePages();
+
+  // Stages movement of nulls to device if any. Returns the id of the buffer or
+  // kNotRegisterd.
+  int32_t stageNulls(ResultStaging& deviceStaging, SplitStaging& splitStaging);
+
+  const OperandId operand_;
+  const int32_t totalRows_;
+  const ParquetColumnChunk* const chunk_;
+  memory::MemoryPool& pool_;
+
+  bool prepared_{false};
+  bool staged_{false};
+  bool nullsStaged_{false};
+  bool queued_{false};
+
+  ParquetDecodedPages pages_;
+
+  // The device side data area start, set after the staged transfer is done.
+  void* deviceBuffer_{nullptr};
+  // Device side dictionary, nullptr if not dictionary encoded.
+  void* deviceDictionary_{nullptr};
+};
+
+class ParquetFormatParams : public wave::FormatParams {
+ public:
+  ParquetFormatParams(
+      memory::MemoryPool& pool,
+      dwio::common::ColumnReaderStatistics& stats,
+      const ParquetRowGroup& rowGroup)
+      : FormatParams(pool, stats), rowGroup_(rowGroup) {}
+
+  std::unique_ptr<FormatData> toFormatData(
+      const std::shared_ptr<const dwio::common::TypeWithId>& type,
+      const velox::common::ScanSpec& scanSpec,
+      OperandId operand) override;
+
+  const ParquetRowGroup& rowGroup() const {
+    return rowGroup_;
+  }
+
+ private:
+  const ParquetRowGroup& rowGroup_;
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/parquet/ParquetFormatData.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+class ParquetFormatDataTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  template <typename T>
+  static std::string_view plain(const std::vector<T>& values) {
+    return std::string_view(
+        reinterpret_cast<const char*>(values.data()),
+        values.size() * sizeof(T));
+  }
+
+  static std::string_view bytes(const std::vector<uint8_t>& values) {
+    return std::string_view(
+        reinterpret_cast<const char*>(values.data()), values.size());
+  }
+
+  // Returns the 'numValues' values of 'bitWidth' bits in 'values'.
+  static std::vector<uint64_t>
+  unpack(const BufferPtr& values, int32_t bitWidth, int32_t numValues) {
+    std::vector<uint64_t> result;
+    const auto* words = values->as<uint64_t>();
+    for (auto i = 0; i < numValues; ++i) {
+      result.push_back(
+          bits::detail::loadBits<uint64_t>(words, i * bitWidth, bitWidth));
+    }
+    return result;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+};
+
+TEST_F(ParquetFormatDataTest, plain) {
+  const std::vector<int32_t> page1 = {1, 2, 3};
+  const std::vector<int32_t> page2 = {4, 5};
+  ParquetColumnChunk chunk{WaveTypeKind::INTEGER};
+  chunk.pages.push_back({ParquetPageEncoding::kPlain, 3, {}, plain(page1)});
+  chunk.pages.push_back({ParquetPageEncoding::kPlain, 2, {}, plain(page2)});
+
+  auto pages = decodeParquetPages(chunk, 5, *pool_);
+  EXPECT_EQ(pages.bitWidth, 32);
+  EXPECT_EQ(pages.numNonNull, 5);
+  EXPECT_EQ(pages.nulls, nullptr);
+  // The values are followed by one word of padding.
+  ASSERT_EQ(pages.values->size(), 5 * sizeof(int32_t) + sizeof(uint64_t));
+  const auto* values = pages.values->as<int32_t>();
+  EXPECT_EQ(
+      std::vector<int32_t>(values, values + 5),
+      std::vector<int32_t>({1, 2, 3, 4, 5}));
+}
+
+TEST_F(ParquetFormatDataTest, rleDictionary) {
+  const std::vector<int64_t> dictionary = {10, 11, 12, 13};
+  // Bit width 2, then an RLE run of 3 values of 2.
+  const std::vector<uint8_t> page1 = {2, 3 << 1, 2};
+  // Bit width 2, then a bit packed run of 8 values of which 5 are used: 0, 1,
+  // 2, 3, 3.
+  const std::vector<uint8_t> page2 = {2, (1 << 1) | 1, 0xe4, 0x1b};
+  ParquetColumnChunk chunk{WaveTypeKind::BIGINT};
+  chunk.dictionary = plain(dictionary);
+  chunk.pages.push_back(
+      {ParquetPageEncoding::kRleDictionary, 3, {}, bytes(page1)});
+  chunk.pages.push_back(
+      {ParquetPageEncoding::kRleDictionary, 5, {}, bytes(page2)});
+
+  auto pages = decodeParquetPages(chunk, 8, *pool_);
+  EXPECT_EQ(pages.bitWidth, 2);
+  EXPECT_EQ(pages.numNonNull, 8);
+  EXPECT_EQ(pages.nulls, nullptr);
+  EXPECT_EQ(
+      unpack(pages.values, pages.bitWidth, 8),
+      std::vector<uint64_t>({2, 2, 2, 0, 1, 2, 3, 3}));
+}
+
+TEST_F(ParquetFormatDataTest, nulls) {
+  const std::vector<int32_t> values = {10, 20};
+  // A bit packed run of 8 definition levels of which 4 are used: 1, 0, 1, 0.
+  const std::vector<uint8_t> levels = {(1 << 1) | 1, 0x05};
+  ParquetColumnChunk chunk{WaveTypeKind::INTEGER, 1};
+  chunk.pages.push_back(
+      {ParquetPageEncoding::kPlain, 4, bytes(levels), plain(values)});
+
+  auto pages = decodeParquetPages(chunk, 4, *pool_);
+  EXPECT_EQ(pages.numNonNull, 2);
+  ASSERT_NE(pages.nulls, nullptr);
+  const auto* nulls = pages.nulls->as<uint64_t>();
+  EXPECT_FALSE(bits::isBitNull(nulls, 0));
+  EXPECT_TRUE(bits::isBitNull(nulls, 1));
+  EXPECT_FALSE(bits::isBitNull(nulls, 2));
+  EXPECT_TRUE(bits::isBitNull(nulls, 3));
+  const auto* decoded = pages.values->as<int32_t>();
+  EXPECT_EQ(decoded[0], 10);
+  EXPECT_EQ(decoded[1], 20);
+}
+
+TEST_F(ParquetFormatDataTest, unsupported) {
+  ParquetColumnChunk strings{WaveTypeKind::VARCHAR};
+  VELOX_ASSERT_THROW(
+      decodeParquetPages(strings, 0, *pool_),
+      "Unsupported Parquet type for Wave decoding");
+
+  ParquetColumnChunk nested{WaveTypeKind::INTEGER, 2};
+  VELOX_ASSERT_THROW(
+      decodeParquetPages(nested, 0, *pool_),
+      "Nested Parquet columns are not supported by Wave");
+}
+
+} // namespace
+} // namespace facebook::velox::wave
@@ -117,35 +117,75 @@ void ConjunctExpr::evalSpecialForm(
   ScopedFinalSelectionSetter scopedFinalSelectionSetter(
       context, &rows, !isAnd_);
 
+  if (!configChecked_) {
+    const auto& config = context.execCtx()->queryCtx()->queryConfig();
+    reorderEnabled_ = config.adaptiveFilterReorderingEnabled();
+    denseEvalEnabled_ = config.denseConjunctEvaluationEnabled();
+    configChecked_ = true;
+  }
+
   bool handleErrors = false;
   LocalSelectivityVector errorRows(context);
   LocalSelectivityVector activeRowsHolder(context, rows);
   auto activeRows = activeRowsHolder.get();
   VELOX_DCHECK(activeRows != nullptr);
   int32_t numActive = activeRows->countSelected();
+  const int32_t numRows = numActive;
+  bool denseMode = denseEvalEnabled_;
+  int32_t numDenseInputs = 0;
   for (int32_t i = 0; i < inputs_.size(); ++i) {
+    const auto inputIndex = inputOrder_[i];
+    bool evalDensely = false;
+    if (denseMode) {
+      if (numActive < kMinDenseFraction * numRows) {
+        // Narrowing the rows pays off for the remaining inputs.
+        denseMode = false;
+        if (numDenseInputs > 0) {
+          ++stats_.numDenseToSparseSwitches;
+        }
+      } else {
+        evalDensely = canEvalDensely(inputIndex, context);
+      }
+    }
+    const auto& evalRows = evalDensely ? rows : *activeRows;
+
     VectorPtr inputResult;
     VectorRecycler inputResultRecycler(inputResult, context.vectorPool());
     EvalErrorsPtr errors;
-    if (handleErrors) {
+    // The errors of a dense input are collected separately so that the ones
+    // on the decided rows can be dropped.
+    const bool swapErrors = handleErrors || evalDensely;
+    if (swapErrors) {
       context.swapErrors(errors);
     }
 
-    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
+    SelectivityTimer timer(selectivity_[inputIndex], numActive);
     if (evaluatesArgumentsOnNonIncreasingSelection()) {
       // Exclude loading rows that we know for sure will have a false result.
-      for (auto* field : inputs_[inputOrder_[i]]->distinctFields()) {
-        if (multiplyReferencedFields_.count(field) > 0) {
+      for (auto* field : inputs_[inputIndex]->distinctFields()) {
+        if (multiplyReferencedFields_.count(field) > 0 ||
+            fieldsToLoadOnUndecidedRows_.count(field) > 0) {
           context.ensureFieldLoaded(field->index(context), *activeRows);
         }
       }
     }
-    inputs_[inputOrder_[i]]->eval(*activeRows, context, inputResult);
+    inputs_[inputIndex]->eval(evalRows, context, inputResult);
+    if (evalDensely) {
+      ++numDenseInputs;
+      ++stats_.numDenseConjunctInputs;
+      if (auto* newErrors = context.errors()) {
+        rows.applyToSelected([&](auto row) {
+          if (!activeRows->isValid(row)) {
+            newErrors->clearError(row);
+          }
+        });
+      }
+    }
     if (context.errors()) {
       handleErrors = true;
     }
     uint64_t* extraActive = nullptr;
-    if (handleErrors) {
+    if (swapErrors || handleErrors) {
       // Add rows with new errors to activeRows and merge these with
       // previous errors.
       extraActive =
@@ -158,7 +198,7 @@ void ConjunctExpr::evalSpecialForm(
       activeRows->updateBounds();
     }
     numActive = activeRows->countSelected();
-    selectivity_[inputOrder_[i]].addOutput(numActive);
+    selectivity_[inputIndex].addOutput(numActive);
 
     if (!numActive) {
       break;
@@ -166,18 +206,24 @@ void ConjunctExpr::evalSpecialForm(
   }
   // Clear errors for 'rows' that are not in 'activeRows'.
   finalizeErrors(rows, *activeRows, throwOnError, context);
-  if (!reorderEnabledChecked_) {
-    reorderEnabled_ = context.execCtx()
-                          ->queryCtx()
-                          ->queryConfig()
-                          .adaptiveFilterReorderingEnabled();
-    reorderEnabledChecked_ = true;
-  }
   if (reorderEnabled_) {
     maybeReorderInputs();
   }
 }
 
+bool ConjunctExpr::canEvalDensely(int32_t index, EvalCtx& context) const {
+  if (!cheapInputs_[index]) {
+    return false;
+  }
+  for (auto* field : inputs_[index]->distinctFields()) {
+    const auto& vector = context.getField(field->index(context));
+    if (isLazyNotLoaded(*vector) || vector->mayHaveNulls()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void ConjunctExpr::maybeReorderInputs() {
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
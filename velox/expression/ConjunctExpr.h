@@ -40,6 +40,10 @@ class ConjunctExpr : public SpecialForm {
     selectivity_.resize(inputs_.size());
     inputOrder_.resize(inputs_.size());
     std::iota(inputOrder_.begin(), inputOrder_.end(), 0);
+    cheapInputs_.reserve(inputs_.size());
+    for (const auto& input : inputs_) {
+      cheapInputs_.push_back(isCheapPredicate(*input));
+    }
 
     std::vector<TypePtr> inputTypes;
     inputTypes.reserve(inputs_.size());
@@ -75,9 +79,47 @@ class ConjunctExpr : public SpecialForm {
     tempNulls_.reset();
   }
 
+  /// Makes an AND load each of 'fields' for the undecided rows when it
+  /// evaluates the first input that references the field, instead of for the
+  /// rows a nested subexpression evaluates it on. The loaded rows then cover
+  /// the rows for which the AND is true, so that the caller can read the
+  /// fields on those rows after the AND.
+  void setFieldsToLoadOnUndecidedRows(
+      std::unordered_set<FieldReference*> fields) {
+    VELOX_CHECK(isAnd_);
+    fieldsToLoadOnUndecidedRows_ = std::move(fields);
+  }
+
  private:
+  // Minimum fraction of the rows of the conjunct that are still undecided
+  // for a cheap input to be evaluated on all the rows of the conjunct. Below
+  // this, the inputs are evaluated on the undecided rows only.
+  static constexpr double kMinDenseFraction = 0.5;
+
   static TypePtr resolveType(const std::vector<TypePtr>& argTypes);
 
+  // Returns true if 'input' is a deterministic function call on columns and
+  // constants, e.g. c0 < 10.
+  static bool isCheapPredicate(const Expr& input) {
+    if (input.isSpecialForm() || !input.isDeterministic() ||
+        input.inputs().empty()) {
+      return false;
+    }
+    for (const auto& argument : input.inputs()) {
+      if (!argument->isConstant() &&
+          !(argument->isFieldAccess() && argument->inputs().empty())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns true if inputs_[index] is a cheap predicate on loaded columns
+  // without nulls. Such an input is evaluated on all the rows of the
+  // conjunct, which lets it take the dense fast paths, instead of on the
+  // undecided rows.
+  bool canEvalDensely(int32_t index, EvalCtx& context) const;
+
   void computePropagatesNulls() override {
     propagatesNulls_ = false;
   }
@@ -100,10 +142,15 @@ class ConjunctExpr : public SpecialForm {
   // temp space for nulls and values of inputs
   BufferPtr tempValues_;
   BufferPtr tempNulls_;
-  bool reorderEnabledChecked_ = false;
+  bool configChecked_ = false;
   bool reorderEnabled_;
+  bool denseEvalEnabled_;
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  // True for the inputs that are cheap predicates, see isCheapPredicate().
+  std::vector<bool> cheapInputs_;
+  // See setFieldsToLoadOnUndecidedRows().
+  std::unordered_set<FieldReference*> fieldsToLoadOnUndecidedRows_;
 
   friend class ConjunctCallToSpecialForm;
 };
@@ -66,6 +66,11 @@ core::TypedExprPtr ConjunctRewrite::rewrite(const core::TypedExprPtr& expr) {
   if (optimizedInputs.size() == 1) {
     return optimizedInputs.front();
   }
+  // Leaves the expression to the later rewrites if there is nothing to
+  // flatten or prune.
+  if (optimizedInputs == expr->inputs()) {
+    return nullptr;
+  }
   return std::make_shared<core::CallTypedExpr>(
       expr->type(), std::move(optimizedInputs), callExpr->name());
 }
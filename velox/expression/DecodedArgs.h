@@ -38,7 +38,7 @@ class DecodedArgs {
       exec::EvalCtx& context) {
     holders_.reserve(args.size());
     for (auto& arg : args) {
-      holders_.emplace_back(context, *arg, rows);
+      holders_.emplace_back(context, arg, rows);
     }
   }
 
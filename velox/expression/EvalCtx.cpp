@@ -58,6 +58,47 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
   inputFlatNoNulls_ = false;
 }
 
+EvalCtx::~EvalCtx() {
+  for (auto& entry : decodedVectorCache_) {
+    execCtx_->releaseDecodedVector(std::move(entry.decoded));
+  }
+}
+
+DecodedVector* EvalCtx::getCachedDecodedVector(
+    const VectorPtr& vector,
+    const SelectivityVector& rows) {
+  const auto maxEntries =
+      execCtx_->optimizationParams().maxDecodedVectorsCached;
+  if (maxEntries == 0 ||
+      vector->encoding() != VectorEncoding::Simple::DICTIONARY) {
+    return nullptr;
+  }
+
+  CachedDecodedVector* freeEntry{nullptr};
+  for (auto& entry : decodedVectorCache_) {
+    const auto cachedVector = entry.vector.lock();
+    if (cachedVector == nullptr) {
+      freeEntry = &entry;
+    } else if (cachedVector.get() == vector.get() && entry.rows == rows) {
+      return entry.decoded.get();
+    }
+  }
+
+  // An entry is only reused once its vector is gone so that the DecodedVectors
+  // handed out for live vectors stay valid.
+  if (freeEntry == nullptr) {
+    if (decodedVectorCache_.size() >= maxEntries) {
+      return nullptr;
+    }
+    freeEntry = &decodedVectorCache_.emplace_back();
+    freeEntry->decoded = execCtx_->getDecodedVector();
+  }
+  freeEntry->vector = vector;
+  freeEntry->rows = rows;
+  freeEntry->decoded->decode(*vector, rows);
+  return freeEntry->decoded.get();
+}
+
 void EvalCtx::saveAndReset(ContextSaver& saver, const SelectivityVector& rows) {
   if (saver.context) {
     return;
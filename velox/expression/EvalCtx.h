@@ -227,6 +227,8 @@ class EvalCtx {
   /// For testing only.
   explicit EvalCtx(core::ExecCtx* execCtx);
 
+  ~EvalCtx();
+
   const RowVector* row() const {
     return row_;
   }
@@ -545,6 +547,22 @@ class EvalCtx {
     return execCtx_->optimizationParams().maxSharedSubexprResultsCached;
   }
 
+  /// Returns the maximum number of dictionary bases to memoize results for in
+  /// a given expression.
+  uint32_t maxDictionaryMemoEntries() const {
+    return execCtx_->optimizationParams().maxDictionaryMemoEntries;
+  }
+
+  /// Returns a DecodedVector of the dictionary encoded 'vector' for 'rows'
+  /// which is shared with the other callers decoding the same 'vector' for the
+  /// same 'rows' in this context. Returns nullptr if 'vector' is not dictionary
+  /// encoded or if the cache is disabled or full. See
+  /// core::QueryConfig::kMaxDecodedVectorsCached. The returned DecodedVector
+  /// stays valid while 'vector' is alive and must not be decoded again.
+  DecodedVector* getCachedDecodedVector(
+      const VectorPtr& vector,
+      const SelectivityVector& rows);
+
   /// Returns true if peeling is enabled.
   bool peelingEnabled() const {
     return execCtx_->optimizationParams().peelingEnabled;
@@ -610,6 +628,19 @@ class EvalCtx {
   // If 'captureErrorDetails()' is false, stores flags indicating which rows had
   // errors without storing actual exceptions.
   EvalErrorsPtr errors_;
+
+  struct CachedDecodedVector {
+    // Weak so that the cache does not keep 'vector' alive nor make it look
+    // shared. An expired entry is reused for another vector.
+    std::weak_ptr<BaseVector> vector;
+    SelectivityVector rows;
+    std::unique_ptr<DecodedVector> decoded;
+  };
+
+  // Decodings of dictionary encoded vectors shared by the functions reading
+  // them. See getCachedDecodedVector(). The DecodedVectors come from and go
+  // back to the pool of 'execCtx_'.
+  std::vector<CachedDecodedVector> decodedVectorCache_;
 };
 
 /// Utility wrapper struct that is used to temporarily reset the value of the
@@ -799,12 +830,29 @@ class LocalDecodedVector {
     get()->decode(vector, rows, loadLazy);
   }
 
+  /// Uses the decoding of 'vector' for 'rows' shared through
+  /// EvalCtx::getCachedDecodedVector() if available. Otherwise decodes
+  /// 'vector' like the constructor above.
+  LocalDecodedVector(
+      EvalCtx& context,
+      const VectorPtr& vector,
+      const SelectivityVector& rows)
+      : context_(context.execCtx()),
+        cached_(context.getCachedDecodedVector(vector, rows)) {
+    if (cached_ == nullptr) {
+      get()->decode(*vector, rows);
+    }
+  }
+
   LocalDecodedVector(LocalDecodedVector&& other) noexcept
-      : context_{other.context_}, vector_{std::move(other.vector_)} {}
+      : context_{other.context_},
+        vector_{std::move(other.vector_)},
+        cached_{other.cached_} {}
 
   void operator=(LocalDecodedVector&& other) noexcept {
     context_ = other.context_;
     vector_ = std::move(other.vector_);
+    cached_ = other.cached_;
   }
 
   ~LocalDecodedVector() {
@@ -814,6 +862,9 @@ class LocalDecodedVector {
   }
 
   DecodedVector* get() {
+    if (cached_ != nullptr) {
+      return cached_;
+    }
     if (!vector_) {
       vector_ = context_ ? context_->getDecodedVector()
                          : std::make_unique<DecodedVector>();
@@ -823,28 +874,35 @@ class LocalDecodedVector {
 
   // Must either use the constructor that provides data or call get() first.
   DecodedVector& operator*() {
-    VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
-    return *vector_;
+    return *decoded();
   }
 
   const DecodedVector& operator*() const {
-    VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
-    return *vector_;
+    return *decoded();
   }
 
   DecodedVector* operator->() {
-    VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
-    return vector_.get();
+    return decoded();
   }
 
   const DecodedVector* operator->() const {
+    return decoded();
+  }
+
+ private:
+  DecodedVector* decoded() const {
+    if (cached_ != nullptr) {
+      return cached_;
+    }
     VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
     return vector_.get();
   }
 
- private:
   core::ExecCtx* context_;
   std::unique_ptr<DecodedVector> vector_;
+  // Not owned. Set if the decoding is shared through
+  // EvalCtx::getCachedDecodedVector().
+  DecodedVector* cached_{nullptr};
 };
 
 /// Utility class used to activate final selection (setting isFinalSelection to
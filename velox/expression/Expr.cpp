@@ -27,6 +27,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprCompiler.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FunctionProfileRegistry.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/PeeledEncoding.h"
 #include "velox/expression/ScopedVarSetter.h"
@@ -1233,10 +1234,54 @@ void Expr::evalWithNulls(
 
 // Optimization that attempts to cache results for inputs that are dictionary
 // encoded and use the same base vector between subsequent input batches.
+Expr::DictionaryMemo* Expr::findOrAddDictionaryMemo(
+    const VectorPtr& base,
+    EvalCtx& context) {
+  // Drops the entries of bases that are gone. A base the memo holds the only
+  // reference to is gone too: its producer has dropped it, so it will not be
+  // seen again. The strong reference then only keeps it from being reused in
+  // place while someone else holds it.
+  for (auto it = dictionaryMemos_.begin(); it != dictionaryMemos_.end();) {
+    if (it->baseWeakPtr.expired() || (it->base && it->base.use_count() == 1)) {
+      releaseDictionaryMemo(*it, context);
+      it = dictionaryMemos_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto it = std::find_if(
+      dictionaryMemos_.begin(), dictionaryMemos_.end(), [&](const auto& memo) {
+        return memo.baseRawPtr == base.get();
+      });
+  if (it != dictionaryMemos_.end()) {
+    std::rotate(it, it + 1, dictionaryMemos_.end());
+    return &dictionaryMemos_.back();
+  }
+
+  // Evicts the least recently used entries to make room.
+  const auto maxEntries =
+      std::max<uint32_t>(1, context.maxDictionaryMemoEntries());
+  while (dictionaryMemos_.size() >= maxEntries) {
+    releaseDictionaryMemo(dictionaryMemos_.front(), context);
+    dictionaryMemos_.erase(dictionaryMemos_.begin());
+  }
+  auto& memo = dictionaryMemos_.emplace_back();
+  memo.baseWeakPtr = base;
+  memo.baseRawPtr = base.get();
+  return nullptr;
+}
+
+void Expr::releaseDictionaryMemo(DictionaryMemo& memo, EvalCtx& context) {
+  context.releaseVector(memo.base);
+  context.releaseVector(memo.cache);
+}
+
 // Since this hold onto a reference to the base vector and the cached results,
 // it can be memory intensive. Therefore in order to reduce this consumption
 // and ensure it is only employed for cases where it can be useful, it only
-// starts caching result after it encounters the same base at least twice.
+// starts caching result after it encounters the same base at least twice. Up
+// to EvalCtx::maxDictionaryMemoEntries() bases are memoized at a time.
 void Expr::evalWithMemo(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1256,52 +1301,43 @@ void Expr::evalWithMemo(
   //
   //    try(coalesce(array_min_by(array[1, 2, 3], x -> x / 0), 0::INTEGER))
 
-  if (base.get() != baseOfDictionaryRawPtr_ ||
-      baseOfDictionaryWeakPtr_.expired()) {
-    baseOfDictionaryRepeats_ = 0;
-    baseOfDictionaryWeakPtr_.reset();
-    baseOfDictionaryRawPtr_ = nullptr;
-    context.releaseVector(baseOfDictionary_);
-    context.releaseVector(dictionaryCache_);
-
+  auto* memo = findOrAddDictionaryMemo(base, context);
+  if (memo == nullptr) {
     evalWithNulls(rows, context, result);
-    baseOfDictionaryWeakPtr_ = base;
-    baseOfDictionaryRawPtr_ = base.get();
     return;
   }
 
-  if (baseOfDictionaryRepeats_ == 0) {
+  if (memo->repeats == 0) {
     evalWithNulls(rows, context, result);
 
-    ++baseOfDictionaryRepeats_;
-    baseOfDictionary_ = base;
-    dictionaryCache_ = result;
-    if (!cachedDictionaryIndices_) {
-      cachedDictionaryIndices_ =
-          context.execCtx()->getSelectivityVector(rows.end());
+    ++memo->repeats;
+    memo->base = base;
+    memo->cache = result;
+    if (!memo->cachedIndices) {
+      memo->cachedIndices = context.execCtx()->getSelectivityVector(rows.end());
     }
-    *cachedDictionaryIndices_ = rows;
-    context.deselectErrors(*cachedDictionaryIndices_);
+    *memo->cachedIndices = rows;
+    context.deselectErrors(*memo->cachedIndices);
     return;
   }
 
-  ++baseOfDictionaryRepeats_;
+  ++memo->repeats;
 
-  if (cachedDictionaryIndices_) {
+  if (memo->cachedIndices) {
     LocalSelectivityVector cachedHolder(context, rows);
     auto cached = cachedHolder.get();
     VELOX_DCHECK(cached != nullptr);
-    cached->intersect(*cachedDictionaryIndices_);
+    cached->intersect(*memo->cachedIndices);
     if (cached->hasSelections()) {
       context.ensureWritable(rows, type(), result);
-      result->copy(dictionaryCache_.get(), *cached, nullptr);
+      result->copy(memo->cache.get(), *cached, nullptr);
     }
   }
   LocalSelectivityVector uncachedHolder(context, rows);
   auto uncached = uncachedHolder.get();
   VELOX_DCHECK(uncached != nullptr);
-  if (cachedDictionaryIndices_) {
-    uncached->deselect(*cachedDictionaryIndices_);
+  if (memo->cachedIndices) {
+    uncached->deselect(*memo->cachedIndices);
   }
   if (uncached->hasSelections()) {
     // Fix finalSelection at "rows" if uncached rows is a strict subset to
@@ -1317,28 +1353,27 @@ void Expr::evalWithMemo(
       context.exprSet()->addToMemo(this);
       auto newCacheSize = uncached->end();
 
-      // dictionaryCache_ is valid only for cachedDictionaryIndices_. Hence, a
-      // safe call to BaseVector::ensureWritable must include all the rows not
-      // covered by cachedDictionaryIndices_. If BaseVector::ensureWritable is
-      // called only for a subset of rows not covered by
-      // cachedDictionaryIndices_, it will attempt to copy rows that are not
-      // valid leading to a crash.
-      LocalSelectivityVector allUncached(context, dictionaryCache_->size());
+      // The cache is valid only for the cached indices. Hence, a safe call to
+      // BaseVector::ensureWritable must include all the rows not covered by
+      // the cached indices. If BaseVector::ensureWritable is called only for
+      // a subset of rows not covered by the cached indices, it will attempt
+      // to copy rows that are not valid leading to a crash.
+      LocalSelectivityVector allUncached(context, memo->cache->size());
       allUncached.get()->setAll();
-      allUncached.get()->deselect(*cachedDictionaryIndices_);
-      context.ensureWritable(*allUncached.get(), type(), dictionaryCache_);
+      allUncached.get()->deselect(*memo->cachedIndices);
+      context.ensureWritable(*allUncached.get(), type(), memo->cache);
 
-      if (cachedDictionaryIndices_->size() < newCacheSize) {
-        cachedDictionaryIndices_->resize(newCacheSize, false);
+      if (memo->cachedIndices->size() < newCacheSize) {
+        memo->cachedIndices->resize(newCacheSize, false);
       }
 
-      cachedDictionaryIndices_->select(*uncached);
+      memo->cachedIndices->select(*uncached);
 
-      // Resize the dictionaryCache_ to accommodate all the necessary rows.
-      if (dictionaryCache_->size() < uncached->end()) {
-        dictionaryCache_->resize(uncached->end());
+      // Resize the cache to accommodate all the necessary rows.
+      if (memo->cache->size() < uncached->end()) {
+        memo->cache->resize(uncached->end());
       }
-      dictionaryCache_->copy(result.get(), *uncached, nullptr);
+      memo->cache->copy(result.get(), *uncached, nullptr);
     }
   }
   context.releaseVector(base);
@@ -1590,10 +1625,20 @@ void Expr::applyFunction(
     const SelectivityVector& rows,
     EvalCtx& context,
     VectorPtr& result) {
+  const auto numRows = rows.countSelected();
   stats_.numProcessedVectors += 1;
-  stats_.numProcessedRows += rows.countSelected();
+  stats_.numProcessedRows += numRows;
   auto timer = cpuWallTimer();
 
+  // Time the sampled batches when the CPU usage is not tracked on every
+  // batch.
+  CpuWallTiming sampledTiming;
+  std::optional<CpuWallTimer> sampleTimer;
+  if (cpuSamplingInterval_ > 0 && !trackCpuUsage_ &&
+      numBatchesSinceSample_++ % cpuSamplingInterval_ == 0) {
+    sampleTimer.emplace(sampledTiming);
+  }
+
   computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
   auto isAscii = type()->isVarchar()
       ? computeIsAsciiForResult(vectorFunction_.get(), inputValues_, rows)
@@ -1632,6 +1677,21 @@ void Expr::applyFunction(
     result->asUnchecked<SimpleVector<StringView>>()->setIsAscii(
         isAscii.value(), rows);
   }
+
+  if (sampleTimer.has_value()) {
+    sampleTimer.reset();
+    uint64_t numNullRows = 0;
+    if (result->mayHaveNulls()) {
+      rows.applyToSelected(
+          [&](auto row) { numNullRows += result->isNullAt(row); });
+    }
+    FunctionProfileRegistry::instance().record(
+        name_,
+        sampledTiming,
+        numRows,
+        numNullRows,
+        cpuSamplingInterval_);
+  }
 }
 
 void Expr::evalSpecialFormWithStats(
@@ -2036,7 +2096,11 @@ void ExprSet::eval(
     // LazyVector and f(a) AND g(b) expression is evaluated first, it will load
     // b only for rows where f(a) is true. However, h(b) projection needs all
     // rows for "b".
+    const bool deferLoads = begin == deferredLoadsIndex_ && end == begin + 1;
     for (const auto& field : multiplyReferencedFields_) {
+      if (deferLoads && deferredLoadFields_.count(field) > 0) {
+        continue;
+      }
       context.ensureFieldLoaded(field->index(context), rows);
     }
   }
@@ -2100,16 +2164,20 @@ void ExprSetSimplified::eval(
   }
 }
 
+bool isExprEvalSimplified(const core::QueryConfig& config) {
+  return config.exprEvalSimplified() || FLAGS_force_eval_simplified;
+}
+
 std::unique_ptr<ExprSet> makeExprSetFromFlag(
     std::vector<core::TypedExprPtr>&& source,
     core::ExecCtx* execCtx,
-    bool lazyDereference) {
-  if (execCtx->queryCtx()->queryConfig().exprEvalSimplified() ||
-      FLAGS_force_eval_simplified) {
+    bool lazyDereference,
+    bool enableConstantFolding) {
+  if (isExprEvalSimplified(execCtx->queryCtx()->queryConfig())) {
     return std::make_unique<ExprSetSimplified>(std::move(source), execCtx);
   }
   return std::make_unique<ExprSet>(
-      std::move(source), execCtx, true, lazyDereference);
+      std::move(source), execCtx, enableConstantFolding, lazyDereference);
 }
 
 std::string printExprWithStats(const exec::ExprSet& exprSet) {
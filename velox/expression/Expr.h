@@ -232,12 +232,7 @@ class Expr {
   }
 
   void clearMemo() {
-    baseOfDictionaryRepeats_ = 0;
-    baseOfDictionaryRawPtr_ = nullptr;
-    baseOfDictionaryWeakPtr_.reset();
-    baseOfDictionary_.reset();
-    dictionaryCache_ = nullptr;
-    cachedDictionaryIndices_ = nullptr;
+    dictionaryMemos_.clear();
   }
 
   virtual void clearCache() {
@@ -406,6 +401,13 @@ class Expr {
     return stats_;
   }
 
+  /// Times one in 'interval' batches of the function call and reports them to
+  /// FunctionProfileRegistry. Ignored if the CPU usage of this expression is
+  /// tracked on every batch or if it is not a function call.
+  void setCpuSamplingInterval(uint32_t interval) {
+    cpuSamplingInterval_ = interval;
+  }
+
   void addNulls(
       const SelectivityVector& rows,
       const uint64_t* rawNulls,
@@ -684,32 +686,51 @@ class Expr {
   // evaluateSharedSubexpr() is called to the cached shared results.
   std::map<InputForSharedResults, SharedResults> sharedSubexprResults_;
 
-  // Pointers to the last base vector of cachable dictionary input. Used to
-  // check if the current input's base vector is the same as the last. If it's
-  // the same, then results can be cached.
-  std::weak_ptr<BaseVector> baseOfDictionaryWeakPtr_;
-  BaseVector* baseOfDictionaryRawPtr_ = nullptr;
+  // Results memoized for the base of a dictionary input.
+  struct DictionaryMemo {
+    std::weak_ptr<BaseVector> baseWeakPtr;
+    BaseVector* baseRawPtr{nullptr};
+
+    // This is a strong reference to the base vector and is only set if
+    // 'repeats' > 0. This is to ensure that the vector held is not modified
+    // and re-used in-place.
+    VectorPtr base;
 
-  // This is a strong reference to the base vector and is only set if
-  // `baseOfDictionaryRepeats_` > 1. This is to ensure that the vector held is
-  // not modified and re-used in-place.
-  VectorPtr baseOfDictionary_;
+    // Number of times the base is seen for a non-first time.
+    int repeats{0};
+
+    // Values computed for the base, 1:1 to the positions in 'baseRawPtr'.
+    VectorPtr cache;
+
+    // The indices that are valid in 'cache'.
+    std::unique_ptr<SelectivityVector> cachedIndices;
+  };
 
-  // Number of times currently held cacheable vector is seen for a non-first
-  // time. Is reset everytime 'baseOfDictionaryRawPtr_' is different from the
-  // current input's base.
-  int baseOfDictionaryRepeats_ = 0;
+  // Drops the memos of the bases that are gone. Returns the memo of 'base'
+  // and makes it the most recently used. Returns nullptr and adds an entry
+  // for 'base' if it is not memoized. The entry replaces the least recently
+  // used one if there are EvalCtx::maxDictionaryMemoEntries() entries.
+  DictionaryMemo* findOrAddDictionaryMemo(
+      const VectorPtr& base,
+      EvalCtx& context);
 
-  // Values computed for the base dictionary, 1:1 to the positions in
-  // 'baseOfDictionaryRawPtr_'.
-  VectorPtr dictionaryCache_;
+  // Returns the vectors held by 'memo' to the vector pool of 'context'.
+  void releaseDictionaryMemo(DictionaryMemo& memo, EvalCtx& context);
 
-  // The indices that are valid in 'dictionaryCache_'.
-  std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
+  // Memos of the most recently seen dictionary bases, the most recent last.
+  // Holds more than one entry when the input alternates between a few
+  // dictionaries, e.g. the stripe dictionaries of a file column.
+  std::vector<DictionaryMemo> dictionaryMemos_;
 
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
+  // Time one in 'cpuSamplingInterval_' batches of applyFunction(), if not 0.
+  uint32_t cpuSamplingInterval_{0};
+
+  // Number of batches of applyFunction() since the last sampled one.
+  uint32_t numBatchesSinceSample_{0};
+
   // If true computeMetaData returns, otherwise meta data is computed and the
   // flag is set to true.
   bool metaDataComputed_ = false;
@@ -788,6 +809,17 @@ class ExprSet {
     return distinctFields_;
   }
 
+  /// Makes eval() of the expression at 'index' alone not load 'fields' up
+  /// front for all rows, even if other expressions reference them. The
+  /// expression must load them for a superset of the rows that the other
+  /// expressions are then evaluated on.
+  void setDeferredLoads(
+      int32_t index,
+      std::unordered_set<FieldReference*> fields) {
+    deferredLoadsIndex_ = index;
+    deferredLoadFields_ = std::move(fields);
+  }
+
   bool lazyDereference() const {
     return lazyDereference_;
   }
@@ -827,6 +859,10 @@ class ExprSet {
   // Fields referenced by multiple expressions in ExprSet.
   std::unordered_set<FieldReference*> multiplyReferencedFields_;
 
+  // See setDeferredLoads().
+  int32_t deferredLoadsIndex_{-1};
+  std::unordered_set<FieldReference*> deferredLoadFields_;
+
   // Distinct Exprs reachable from 'exprs_' for which reset() needs to
   // be called at the start of eval().
   std::vector<std::shared_ptr<Expr>> toReset_;
@@ -863,12 +899,19 @@ class ExprSetSimplified : public ExprSet {
       std::vector<VectorPtr>& result) override;
 };
 
+// Returns true if makeExprSetFromFlag() creates an ExprSetSimplified, which
+// compiles the expressions as is, without rewrites or constant folding.
+bool isExprEvalSimplified(const core::QueryConfig& config);
+
 // Factory method that takes `kExprEvalSimplified` (query parameter) into
-// account and instantiates the correct ExprSet class.
+// account and instantiates the correct ExprSet class. 'enableConstantFolding'
+// is false for expressions that have already been through
+// optimizeExpressions().
 std::unique_ptr<ExprSet> makeExprSetFromFlag(
     std::vector<core::TypedExprPtr>&& source,
     core::ExecCtx* execCtx,
-    bool lazyDereference = false);
+    bool lazyDereference = false,
+    bool enableConstantFolding = true);
 
 /// Evaluates a deterministic expression that doesn't depend on any inputs and
 /// returns the result as single-row vector. Returns nullptr if the expression
@@ -21,6 +21,7 @@
 #include "velox/expression/ExprRewriteRegistry.h"
 #include "velox/expression/ExprUtils.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -73,6 +74,10 @@ struct CompilerCtx {
   /// List of call expression names whose CPU usage should be tracked.
   /// Extracted from the query config.
   std::unordered_set<std::string> cpuUsageTrackingCandidates;
+
+  /// Sampling interval of the batches of the function calls reported to
+  /// FunctionProfileRegistry. 0 disables the sampling.
+  uint32_t cpuSamplingInterval{0};
 };
 
 /// Represents a lexical scope. A top level scope corresponds to a top
@@ -404,6 +409,19 @@ ExprPtr compileRewrittenExpression(
 
   const bool trackCpuUsage = ctx.queryCtx->queryConfig().exprTrackCpuUsage();
 
+  if (ctx.queryCtx->queryConfig().exprFusionEnabled()) {
+    if (auto fused = FusedExpr::tryCompile(
+            expr,
+            [&](const TypedExprPtr& leaf) {
+              return compileExpression(leaf, scope, ctx);
+            },
+            trackCpuUsage)) {
+      fused->computeMetadata();
+      scope->visited[expr.get()] = fused;
+      return fused;
+    }
+  }
+
   const auto& resultType = expr->type();
   auto compiledInputs = compileInputs(expr, scope, ctx);
 
@@ -464,6 +482,9 @@ ExprPtr compileRewrittenExpression(
     }
   }
 
+  if (ctx.cpuSamplingInterval > 0) {
+    result->setCpuSamplingInterval(ctx.cpuSamplingInterval);
+  }
   result->computeMetadata();
   scope->visited[expr.get()] = result;
   return result;
@@ -538,12 +559,42 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
       // to lock function registry once vs. locking for each function call.
       .flatteningCandidates = collectFlatteningCandidates(sources),
       .cpuUsageTrackingCandidates =
-          fetchCallExprNamesForCpuTracking(execCtx->queryCtx()->queryConfig())};
+          fetchCallExprNamesForCpuTracking(execCtx->queryCtx()->queryConfig()),
+      .cpuSamplingInterval =
+          execCtx->queryCtx()->queryConfig().exprCpuSamplingInterval()};
+
+  std::vector<TypedExprPtr> rewrittenSources;
+  if (enableConstantFolding) {
+    rewrittenSources =
+        expression::ExprRewriteRegistry::instance().rewriteExpressionSet(
+            sources);
+    // Keeps the rewritten expressions alive while compiling.
+    scope.rewrittenExpressions = rewrittenSources;
+  }
 
-  for (auto& source : sources) {
+  for (const auto& source :
+       rewrittenSources.empty() ? sources : rewrittenSources) {
     exprs.push_back(compileExpression(source, &scope, ctx));
   }
   return exprs;
 }
 
+std::vector<TypedExprPtr> optimizeExpressions(
+    const std::vector<TypedExprPtr>& sources,
+    core::ExecCtx* execCtx) {
+  auto optimized =
+      expression::ExprRewriteRegistry::instance().rewriteExpressionSet(sources);
+  if (optimized.empty()) {
+    optimized = sources;
+  }
+  for (auto& expr : optimized) {
+    auto folded =
+        expression::optimize(expr, execCtx->queryCtx(), execCtx->pool());
+    if (folded != nullptr) {
+      expr = std::move(folded);
+    }
+  }
+  return optimized;
+}
+
 } // namespace facebook::velox::exec
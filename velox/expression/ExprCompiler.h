@@ -31,4 +31,14 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
     ExprSet* exprSet,
     bool enableConstantFolding = true);
 
+/// Applies the expression set rewrites and the constant folding that
+/// compileExpressions does when 'enableConstantFolding' is true. The result is
+/// immutable and can be compiled by any number of ExprSets with constant
+/// folding disabled, e.g. one per Driver, so that folding, which evaluates
+/// the constant subtrees, happens once. Constants allocated while folding come
+/// from execCtx->pool(), which must outlive the result.
+std::vector<core::TypedExprPtr> optimizeExpressions(
+    const std::vector<core::TypedExprPtr>& sources,
+    core::ExecCtx* execCtx);
+
 } // namespace facebook::velox::exec
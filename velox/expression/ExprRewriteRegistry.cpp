@@ -22,8 +22,15 @@ void ExprRewriteRegistry::registerRewrite(ExpressionRewrite rewrite) {
   registry_.withWLock([&](auto& list) { list.push_back(std::move(rewrite)); });
 }
 
+void ExprRewriteRegistry::registerExpressionSetRewrite(
+    ExpressionSetRewrite rewrite) {
+  setRegistry_.withWLock(
+      [&](auto& list) { list.push_back(std::move(rewrite)); });
+}
+
 void ExprRewriteRegistry::clear() {
   registry_.withWLock([&](auto& list) { list.clear(); });
+  setRegistry_.withWLock([&](auto& list) { list.clear(); });
 }
 
 core::TypedExprPtr ExprRewriteRegistry::rewrite(
@@ -51,4 +58,20 @@ core::TypedExprPtr ExprRewriteRegistry::rewrite(
 
   return result;
 }
+
+std::vector<core::TypedExprPtr> ExprRewriteRegistry::rewriteExpressionSet(
+    const std::vector<core::TypedExprPtr>& exprs) {
+  std::vector<core::TypedExprPtr> result;
+  setRegistry_.withRLock([&](const auto& list) {
+    for (const auto& rewrite : list) {
+      VELOX_CHECK_NOT_NULL(rewrite);
+      auto rewritten = rewrite(result.empty() ? exprs : result);
+      if (!rewritten.empty()) {
+        VELOX_CHECK_EQ(rewritten.size(), exprs.size());
+        result = std::move(rewritten);
+      }
+    }
+  });
+  return result;
+}
 } // namespace facebook::velox::expression
@@ -25,6 +25,13 @@ namespace facebook::velox::expression {
 using ExpressionRewrite =
     std::function<core::TypedExprPtr(const core::TypedExprPtr)>;
 
+/// A re-writer that takes all the top level expressions of an ExprSet and
+/// returns equivalent expressions or an empty vector if re-write is not
+/// possible. Sees the expressions together, e.g. to share work between them
+/// through a common subexpression.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
 class ExprRewriteRegistry {
  public:
   /// Appends a 'rewrite' to 'expressionRewrites'.
@@ -35,6 +42,11 @@ class ExprRewriteRegistry {
   /// terminates the re-write for that particular expression.
   void registerRewrite(ExpressionRewrite rewrite);
 
+  /// Appends a 'rewrite' of the expressions of an ExprSet. These rewrites are
+  /// applied in the order they were registered, each to the result of the
+  /// previous one, before the rewrites of the individual expressions.
+  void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
   /// Clears the registry to remove all registered rewrites.
   void clear();
 
@@ -42,6 +54,11 @@ class ExprRewriteRegistry {
   /// expression only has constant inputs.
   core::TypedExprPtr rewrite(const core::TypedExprPtr& expr);
 
+  /// Rewrites the expressions of an ExprSet to equivalent expressions. Returns
+  /// an empty vector if no rewrite applies.
+  std::vector<core::TypedExprPtr> rewriteExpressionSet(
+      const std::vector<core::TypedExprPtr>& exprs);
+
   static ExprRewriteRegistry& instance() {
     static ExprRewriteRegistry kInstance;
     return kInstance;
@@ -49,5 +66,6 @@ class ExprRewriteRegistry {
 
  private:
   folly::Synchronized<std::vector<ExpressionRewrite>> registry_;
+  folly::Synchronized<std::vector<ExpressionSetRewrite>> setRegistry_;
 };
 } // namespace facebook::velox::expression
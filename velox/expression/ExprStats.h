@@ -35,6 +35,15 @@ struct ExprStats {
   /// evaluation of rows.
   bool defaultNullRowsSkipped{false};
 
+  /// Number of inputs of AND / OR evaluated on all the rows of the
+  /// conjunction instead of on the undecided rows. Requires
+  /// QueryConfig.denseConjunctEvaluationEnabled() to be 'true'.
+  uint64_t numDenseConjunctInputs{0};
+
+  /// Number of times AND / OR switched from evaluating its inputs on all its
+  /// rows to evaluating them on the undecided rows.
+  uint64_t numDenseToSparseSwitches{0};
+
   auto operator<=>(const ExprStats&) const = default;
 
   void add(const ExprStats& other) {
@@ -42,15 +51,19 @@ struct ExprStats {
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
     defaultNullRowsSkipped |= other.defaultNullRowsSkipped;
+    numDenseConjunctInputs += other.numDenseConjunctInputs;
+    numDenseToSparseSwitches += other.numDenseToSparseSwitches;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, defaultNullRowsSkipped: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, defaultNullRowsSkipped: {}, numDenseConjunctInputs: {}, numDenseToSparseSwitches: {}",
         timing.toString(),
         numProcessedRows,
         numProcessedVectors,
-        defaultNullRowsSkipped ? "true" : "false");
+        defaultNullRowsSkipped ? "true" : "false",
+        numDenseConjunctInputs,
+        numDenseToSparseSwitches);
   }
 };
 } // namespace facebook::velox::exec
@@ -49,4 +49,56 @@ bool allInputTypesEquivalent(const core::TypedExprPtr& expr) {
   return true;
 }
 
+core::TypedExprPtr replaceSubexpressions(
+    const core::TypedExprPtr& expr,
+    const std::function<core::TypedExprPtr(const core::TypedExprPtr&)>&
+        replace) {
+  if (auto replacement = replace(expr)) {
+    return replacement;
+  }
+  if (expr->isLambdaKind()) {
+    return expr;
+  }
+
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  bool changed = false;
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(replaceSubexpressions(input, replace));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+
+  if (expr->isCallKind()) {
+    return std::make_shared<core::CallTypedExpr>(
+        expr->type(),
+        std::move(inputs),
+        expr->asUnchecked<core::CallTypedExpr>()->name());
+  }
+  if (expr->isCastKind()) {
+    return std::make_shared<core::CastTypedExpr>(
+        expr->type(),
+        std::move(inputs),
+        expr->asUnchecked<core::CastTypedExpr>()->isTryCast());
+  }
+  if (expr->isDereferenceKind()) {
+    return std::make_shared<core::DereferenceTypedExpr>(
+        expr->type(),
+        inputs[0],
+        expr->asUnchecked<core::DereferenceTypedExpr>()->index());
+  }
+  if (expr->isFieldAccessKind()) {
+    return std::make_shared<core::FieldAccessTypedExpr>(
+        expr->type(),
+        inputs[0],
+        expr->asUnchecked<core::FieldAccessTypedExpr>()->name());
+  }
+  VELOX_CHECK(
+      expr->isConcatKind(), "Unexpected expression: {}", expr->toString());
+  return std::make_shared<core::ConcatTypedExpr>(
+      expr->type()->asRow().names(), std::move(inputs));
+}
+
 } // namespace facebook::velox::expression::utils
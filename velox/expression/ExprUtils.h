@@ -47,4 +47,13 @@ void flattenInput(
     const std::string& flattenCall,
     std::vector<core::TypedExprPtr>& flat);
 
+/// Returns 'expr' with the subexpressions for which 'replace' returns non-null
+/// replaced by its result, or 'expr' if there are none. Subexpressions of a
+/// replaced expression are not visited. Does not look into lambdas, which do
+/// not share subexpressions with the enclosing expression.
+core::TypedExprPtr replaceSubexpressions(
+    const core::TypedExprPtr& expr,
+    const std::function<core::TypedExprPtr(const core::TypedExprPtr&)>&
+        replace);
+
 } // namespace facebook::velox::expression::utils
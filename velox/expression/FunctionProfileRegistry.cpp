@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FunctionProfileRegistry.h"
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::exec {
+
+std::string FunctionProfile::toString() const {
+  return fmt::format(
+      "{}: estimated cpu time: {}, estimated rows: {}, cpu time per row: {}, "
+      "null ratio: {:.2f}, sampled batches: {}",
+      name,
+      succinctNanos(estimatedCpuNanos),
+      estimatedRows,
+      succinctNanos(static_cast<uint64_t>(cpuNanosPerRow())),
+      nullRatio(),
+      numSampledBatches);
+}
+
+// static
+FunctionProfileRegistry& FunctionProfileRegistry::instance() {
+  static FunctionProfileRegistry kInstance;
+  return kInstance;
+}
+
+void FunctionProfileRegistry::record(
+    const std::string& name,
+    const CpuWallTiming& timing,
+    uint64_t numRows,
+    uint64_t numNullRows,
+    uint32_t samplingInterval) {
+  profiles_.withWLock([&](auto& profiles) {
+    auto& profile = profiles[name];
+    if (profile.name.empty()) {
+      profile.name = name;
+    }
+    ++profile.numSampledBatches;
+    profile.numSampledRows += numRows;
+    profile.numSampledNullRows += numNullRows;
+    profile.sampledTiming.add(timing);
+    profile.estimatedRows += numRows * samplingInterval;
+    profile.estimatedCpuNanos += timing.cpuNanos * samplingInterval;
+  });
+}
+
+std::vector<FunctionProfile> FunctionProfileRegistry::topFunctions(
+    size_t maxFunctions,
+    SortKey sortKey) const {
+  std::vector<FunctionProfile> result;
+  profiles_.withRLock([&](const auto& profiles) {
+    result.reserve(profiles.size());
+    for (const auto& [_, profile] : profiles) {
+      result.push_back(profile);
+    }
+  });
+
+  auto sortValue = [sortKey](const FunctionProfile& profile) -> double {
+    switch (sortKey) {
+      case SortKey::kCpu:
+        return profile.estimatedCpuNanos;
+      case SortKey::kRows:
+        return profile.estimatedRows;
+      case SortKey::kCpuPerRow:
+        return profile.cpuNanosPerRow();
+    }
+    VELOX_UNREACHABLE();
+  };
+  const auto numFunctions = std::min(maxFunctions, result.size());
+  std::partial_sort(
+      result.begin(),
+      result.begin() + numFunctions,
+      result.end(),
+      [&](const auto& left, const auto& right) {
+        return sortValue(left) > sortValue(right);
+      });
+  result.resize(numFunctions);
+  return result;
+}
+
+std::optional<FunctionProfile> FunctionProfileRegistry::profile(
+    const std::string& name) const {
+  return profiles_.withRLock(
+      [&](const auto& profiles) -> std::optional<FunctionProfile> {
+        auto it = profiles.find(name);
+        if (it == profiles.end()) {
+          return std::nullopt;
+        }
+        return it->second;
+      });
+}
+
+void FunctionProfileRegistry::clear() {
+  profiles_.wlock()->clear();
+}
+
+} // namespace facebook::velox::exec
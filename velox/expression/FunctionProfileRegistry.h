@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/time/CpuWallTimer.h"
+
+namespace facebook::velox::exec {
+
+/// CPU profile of a function aggregated over all the expressions of all the
+/// tasks of the process that call it. Built from the sampled batches, see
+/// QueryConfig::kExprCpuSamplingInterval.
+struct FunctionProfile {
+  std::string name;
+
+  /// Number of sampled batches.
+  uint64_t numSampledBatches{0};
+
+  /// Number of rows and of null results in the sampled batches.
+  uint64_t numSampledRows{0};
+  uint64_t numSampledNullRows{0};
+
+  /// CPU and wall time of the sampled batches.
+  CpuWallTiming sampledTiming;
+
+  /// Sampled values extrapolated to all the batches: each sampled batch
+  /// counts for as many batches as the sampling interval.
+  uint64_t estimatedRows{0};
+  uint64_t estimatedCpuNanos{0};
+
+  double nullRatio() const {
+    return numSampledRows == 0
+        ? 0
+        : static_cast<double>(numSampledNullRows) / numSampledRows;
+  }
+
+  double cpuNanosPerRow() const {
+    return numSampledRows == 0
+        ? 0
+        : static_cast<double>(sampledTiming.cpuNanos) / numSampledRows;
+  }
+
+  std::string toString() const;
+};
+
+/// Process-wide registry of the function profiles. Expressions report the
+/// sampled batches of their function calls to it, so the functions that cost
+/// the most CPU across queries can be listed.
+class FunctionProfileRegistry {
+ public:
+  enum class SortKey {
+    /// Estimated total CPU time.
+    kCpu,
+    /// Estimated number of processed rows.
+    kRows,
+    /// CPU time per row.
+    kCpuPerRow,
+  };
+
+  static FunctionProfileRegistry& instance();
+
+  /// Adds a sampled batch of 'numRows' rows of function 'name', of which
+  /// 'numNullRows' produced a null, taken once every 'samplingInterval'
+  /// batches.
+  void record(
+      const std::string& name,
+      const CpuWallTiming& timing,
+      uint64_t numRows,
+      uint64_t numNullRows,
+      uint32_t samplingInterval);
+
+  /// Returns up to 'maxFunctions' profiles in descending order of 'sortKey'.
+  std::vector<FunctionProfile> topFunctions(
+      size_t maxFunctions,
+      SortKey sortKey = SortKey::kCpu) const;
+
+  /// Returns the profile of function 'name' or std::nullopt if none of its
+  /// batches has been sampled.
+  std::optional<FunctionProfile> profile(const std::string& name) const;
+
+  void clear();
+
+ private:
+  folly::Synchronized<folly::F14FastMap<std::string, FunctionProfile>>
+      profiles_;
+};
+
+} // namespace facebook::velox::exec
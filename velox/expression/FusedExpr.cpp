@@ -0,0 +1,611 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedExpr.h"
+
+#include <array>
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/CheckedArithmetic.h"
+#include "velox/type/FloatingPointUtil.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+// Rows per chunk. The scratch arrays of a chunk stay in the L1 cache for
+// trees of a few calls.
+constexpr int32_t kChunkSize = 1'024;
+
+folly::Synchronized<folly::F14FastMap<std::string, FusedOp>>& fusedFunctions() {
+  static folly::Synchronized<folly::F14FastMap<std::string, FusedOp>>
+      functions;
+  return functions;
+}
+
+bool isComparison(FusedOp op) {
+  switch (op) {
+    case FusedOp::kPlus:
+    case FusedOp::kMinus:
+    case FusedOp::kMultiply:
+      return false;
+    default:
+      return true;
+  }
+}
+
+// Returns true for the primitive numeric types. Excludes the types that
+// share their physical type, e.g. DATE, DECIMAL and the intervals.
+bool isOperandType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return type->name() == TypeKindName::toName(type->kind());
+    default:
+      return false;
+  }
+}
+
+// Flattens a tree of fusable calls into postorder nodes.
+class TreeBuilder {
+ public:
+  explicit TreeBuilder(TypePtr operandType)
+      : operandType_(std::move(operandType)) {}
+
+  // Adds 'expr' and its inputs. Returns the index of its node or -1 if
+  // 'expr' cannot be fused.
+  int32_t add(const core::TypedExprPtr& expr, bool isRoot) {
+    if (expr->isFieldAccessKind() || expr->isConstantKind()) {
+      if (!expr->type()->equivalent(*operandType_)) {
+        return -1;
+      }
+      FusedExpr::Node node;
+      node.leaf = leaves_.size();
+      leaves_.push_back(expr);
+      nodes_.push_back(std::move(node));
+      return nodes_.size() - 1;
+    }
+    if (!expr->isCallKind() || expr->inputs().size() != 2) {
+      return -1;
+    }
+    const auto* call = expr->asUnchecked<core::CallTypedExpr>();
+    const auto op = fusedFunction(call->name());
+    if (!op.has_value()) {
+      return -1;
+    }
+    if (isComparison(op.value())) {
+      if (!isRoot || !expr->type()->isBoolean()) {
+        return -1;
+      }
+    } else if (!expr->type()->equivalent(*operandType_)) {
+      return -1;
+    }
+    const auto left = add(expr->inputs()[0], false);
+    if (left < 0) {
+      return -1;
+    }
+    const auto right = add(expr->inputs()[1], false);
+    if (right < 0) {
+      return -1;
+    }
+    FusedExpr::Node node;
+    node.op = op.value();
+    node.left = left;
+    node.right = right;
+    node.name = call->name();
+    nodes_.push_back(std::move(node));
+    ++numCalls_;
+    return nodes_.size() - 1;
+  }
+
+  std::vector<FusedExpr::Node>& nodes() {
+    return nodes_;
+  }
+
+  const std::vector<core::TypedExprPtr>& leaves() const {
+    return leaves_;
+  }
+
+  int32_t numCalls() const {
+    return numCalls_;
+  }
+
+ private:
+  const TypePtr operandType_;
+  std::vector<FusedExpr::Node> nodes_;
+  std::vector<core::TypedExprPtr> leaves_;
+  int32_t numCalls_{0};
+};
+
+// Sets 'out' to the result of 'kOp' on 'a' and 'b'. Returns true if an
+// integer result overflows.
+template <FusedOp kOp, typename T>
+FOLLY_ALWAYS_INLINE bool arithmetic(T a, T b, T& out) {
+  if constexpr (std::is_integral_v<T>) {
+    if constexpr (kOp == FusedOp::kPlus) {
+      return __builtin_add_overflow(a, b, &out);
+    } else if constexpr (kOp == FusedOp::kMinus) {
+      return __builtin_sub_overflow(a, b, &out);
+    } else {
+      return __builtin_mul_overflow(a, b, &out);
+    }
+  } else {
+    if constexpr (kOp == FusedOp::kPlus) {
+      out = a + b;
+    } else if constexpr (kOp == FusedOp::kMinus) {
+      out = a - b;
+    } else {
+      out = a * b;
+    }
+    return false;
+  }
+}
+
+template <FusedOp kOp, typename T>
+FOLLY_ALWAYS_INLINE bool compare(T a, T b) {
+  if constexpr (std::is_floating_point_v<T>) {
+    using namespace util::floating_point;
+    if constexpr (kOp == FusedOp::kEq) {
+      return NaNAwareEquals<T>{}(a, b);
+    } else if constexpr (kOp == FusedOp::kNeq) {
+      return !NaNAwareEquals<T>{}(a, b);
+    } else if constexpr (kOp == FusedOp::kLt) {
+      return NaNAwareLessThan<T>{}(a, b);
+    } else if constexpr (kOp == FusedOp::kLte) {
+      return NaNAwareLessThanEqual<T>{}(a, b);
+    } else if constexpr (kOp == FusedOp::kGt) {
+      return NaNAwareGreaterThan<T>{}(a, b);
+    } else {
+      return NaNAwareGreaterThanEqual<T>{}(a, b);
+    }
+  } else {
+    if constexpr (kOp == FusedOp::kEq) {
+      return a == b;
+    } else if constexpr (kOp == FusedOp::kNeq) {
+      return a != b;
+    } else if constexpr (kOp == FusedOp::kLt) {
+      return a < b;
+    } else if constexpr (kOp == FusedOp::kLte) {
+      return a <= b;
+    } else if constexpr (kOp == FusedOp::kGt) {
+      return a > b;
+    } else {
+      return a >= b;
+    }
+  }
+}
+
+template <FusedOp kOp, typename T>
+void arithmeticChunk(
+    const T* left,
+    const T* right,
+    T* out,
+    int32_t numRows,
+    uint8_t* overflows) {
+  for (auto i = 0; i < numRows; ++i) {
+    overflows[i] |= arithmetic<kOp>(left[i], right[i], out[i]);
+  }
+}
+
+template <FusedOp kOp, typename T>
+void compareChunk(const T* left, const T* right, int32_t numRows, bool* out) {
+  for (auto i = 0; i < numRows; ++i) {
+    out[i] = compare<kOp>(left[i], right[i]);
+  }
+}
+
+template <typename T>
+bool compareValues(FusedOp op, T a, T b) {
+  switch (op) {
+    case FusedOp::kEq:
+      return compare<FusedOp::kEq>(a, b);
+    case FusedOp::kNeq:
+      return compare<FusedOp::kNeq>(a, b);
+    case FusedOp::kLt:
+      return compare<FusedOp::kLt>(a, b);
+    case FusedOp::kLte:
+      return compare<FusedOp::kLte>(a, b);
+    case FusedOp::kGt:
+      return compare<FusedOp::kGt>(a, b);
+    case FusedOp::kGte:
+      return compare<FusedOp::kGte>(a, b);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Arithmetic with the errors of the unfused functions.
+template <typename T>
+T checkedArithmetic(FusedOp op, T a, T b) {
+  if constexpr (std::is_integral_v<T>) {
+    switch (op) {
+      case FusedOp::kPlus:
+        return checkedPlus(a, b);
+      case FusedOp::kMinus:
+        return checkedMinus(a, b);
+      case FusedOp::kMultiply:
+        return checkedMultiply(a, b);
+      default:
+        VELOX_UNREACHABLE();
+    }
+  } else {
+    T result;
+    switch (op) {
+      case FusedOp::kPlus:
+        arithmetic<FusedOp::kPlus>(a, b, result);
+        break;
+      case FusedOp::kMinus:
+        arithmetic<FusedOp::kMinus>(a, b, result);
+        break;
+      case FusedOp::kMultiply:
+        arithmetic<FusedOp::kMultiply>(a, b, result);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    return result;
+  }
+}
+
+// Copies the values of 'rows' of 'decoded' to 'out' and sets 'nulls' for
+// the null rows.
+template <typename T>
+void loadLeaf(
+    const DecodedVector& decoded,
+    const vector_size_t* rows,
+    int32_t numRows,
+    T* out,
+    uint8_t* nulls) {
+  if (decoded.isConstantMapping()) {
+    if (decoded.isNullAt(0)) {
+      std::fill(out, out + numRows, T());
+      std::fill(nulls, nulls + numRows, 1);
+    } else {
+      std::fill(out, out + numRows, decoded.valueAt<T>(0));
+    }
+    return;
+  }
+  if (!decoded.mayHaveNulls()) {
+    if (decoded.isIdentityMapping()) {
+      const auto* values = decoded.data<T>();
+      for (auto i = 0; i < numRows; ++i) {
+        out[i] = values[rows[i]];
+      }
+    } else {
+      for (auto i = 0; i < numRows; ++i) {
+        out[i] = decoded.valueAt<T>(rows[i]);
+      }
+    }
+    return;
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    if (decoded.isNullAt(rows[i])) {
+      out[i] = T();
+      nulls[i] = 1;
+    } else {
+      out[i] = decoded.valueAt<T>(rows[i]);
+    }
+  }
+}
+} // namespace
+
+void registerFusedFunction(const std::string& name, FusedOp op) {
+  fusedFunctions().wlock()->insert_or_assign(name, op);
+}
+
+std::optional<FusedOp> fusedFunction(const std::string& name) {
+  auto functions = fusedFunctions().rlock();
+  auto it = functions->find(name);
+  if (it == functions->end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+FusedExpr::FusedExpr(
+    TypePtr type,
+    std::vector<ExprPtr>&& leaves,
+    std::vector<Node> nodes,
+    TypePtr operandType,
+    bool leavesSupportFlatNoNullsFastPath,
+    bool trackCpuUsage)
+    : SpecialForm(
+          SpecialFormKind::kCustom,
+          std::move(type),
+          std::move(leaves),
+          "fused",
+          leavesSupportFlatNoNullsFastPath,
+          trackCpuUsage),
+      nodes_(std::move(nodes)),
+      operandType_(std::move(operandType)) {
+  VELOX_CHECK(!nodes_.empty());
+  VELOX_CHECK(isOperandType(operandType_));
+}
+
+// static
+ExprPtr FusedExpr::tryCompile(
+    const core::TypedExprPtr& expr,
+    const std::function<ExprPtr(const core::TypedExprPtr&)>& compileLeaf,
+    bool trackCpuUsage) {
+  if (!expr->isCallKind() || expr->inputs().size() != 2) {
+    return nullptr;
+  }
+  const auto op =
+      fusedFunction(expr->asUnchecked<core::CallTypedExpr>()->name());
+  if (!op.has_value()) {
+    return nullptr;
+  }
+  const auto& operandType =
+      isComparison(op.value()) ? expr->inputs()[0]->type() : expr->type();
+  if (!isOperandType(operandType)) {
+    return nullptr;
+  }
+  TreeBuilder builder(operandType);
+  if (builder.add(expr, true) < 0 || builder.numCalls() < 2) {
+    return nullptr;
+  }
+  std::vector<ExprPtr> leaves;
+  leaves.reserve(builder.leaves().size());
+  bool supportsFlatNoNullsFastPath = true;
+  for (const auto& leaf : builder.leaves()) {
+    leaves.push_back(compileLeaf(leaf));
+    supportsFlatNoNullsFastPath &=
+        leaves.back()->supportsFlatNoNullsFastPath();
+  }
+  return std::make_shared<FusedExpr>(
+      expr->type(),
+      std::move(leaves),
+      std::move(builder.nodes()),
+      operandType,
+      supportsFlatNoNullsFastPath,
+      trackCpuUsage);
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  std::vector<VectorPtr> leafResults(inputs_.size());
+  std::vector<LocalDecodedVector> decodedLeaves;
+  std::vector<DecodedVector*> leaves;
+  decodedLeaves.reserve(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputs_[i]->eval(rows, context, leafResults[i]);
+    decodedLeaves.emplace_back(context, *leafResults[i], rows);
+    leaves.push_back(decodedLeaves.back().get());
+  }
+
+  context.ensureWritable(rows, type(), result);
+  switch (operandType_->kind()) {
+    case TypeKind::TINYINT:
+      evalTyped<int8_t>(rows, context, leaves, *result);
+      break;
+    case TypeKind::SMALLINT:
+      evalTyped<int16_t>(rows, context, leaves, *result);
+      break;
+    case TypeKind::INTEGER:
+      evalTyped<int32_t>(rows, context, leaves, *result);
+      break;
+    case TypeKind::BIGINT:
+      evalTyped<int64_t>(rows, context, leaves, *result);
+      break;
+    case TypeKind::REAL:
+      evalTyped<float>(rows, context, leaves, *result);
+      break;
+    case TypeKind::DOUBLE:
+      evalTyped<double>(rows, context, leaves, *result);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+void FusedExpr::evalTyped(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    std::vector<DecodedVector*>& leaves,
+    BaseVector& result) {
+  const auto numNodes = nodes_.size();
+  const auto& root = nodes_.back();
+  const bool comparison = isComparison(root.op);
+  auto* flatResult = comparison ? nullptr : result.asUnchecked<FlatVector<T>>();
+  auto* boolResult =
+      comparison ? result.asUnchecked<FlatVector<bool>>() : nullptr;
+
+  // The values of the nodes for the rows of a chunk, kChunkSize per node.
+  std::vector<T> values(numNodes * kChunkSize);
+  std::vector<vector_size_t> chunkRows;
+  chunkRows.reserve(kChunkSize);
+  std::array<uint8_t, kChunkSize> nulls;
+  std::array<uint8_t, kChunkSize> overflows;
+  std::array<bool, kChunkSize> comparisons;
+
+  auto evalChunk = [&]() {
+    const int32_t numRows = chunkRows.size();
+    std::fill(nulls.begin(), nulls.begin() + numRows, 0);
+    std::fill(overflows.begin(), overflows.begin() + numRows, 0);
+    for (auto i = 0; i < numNodes; ++i) {
+      const auto& node = nodes_[i];
+      T* out = values.data() + i * kChunkSize;
+      if (node.leaf >= 0) {
+        loadLeaf(
+            *leaves[node.leaf], chunkRows.data(), numRows, out, nulls.data());
+        continue;
+      }
+      const T* left = values.data() + node.left * kChunkSize;
+      const T* right = values.data() + node.right * kChunkSize;
+      switch (node.op) {
+        case FusedOp::kPlus:
+          arithmeticChunk<FusedOp::kPlus>(
+              left, right, out, numRows, overflows.data());
+          break;
+        case FusedOp::kMinus:
+          arithmeticChunk<FusedOp::kMinus>(
+              left, right, out, numRows, overflows.data());
+          break;
+        case FusedOp::kMultiply:
+          arithmeticChunk<FusedOp::kMultiply>(
+              left, right, out, numRows, overflows.data());
+          break;
+        case FusedOp::kEq:
+          compareChunk<FusedOp::kEq>(left, right, numRows, comparisons.data());
+          break;
+        case FusedOp::kNeq:
+          compareChunk<FusedOp::kNeq>(
+              left, right, numRows, comparisons.data());
+          break;
+        case FusedOp::kLt:
+          compareChunk<FusedOp::kLt>(left, right, numRows, comparisons.data());
+          break;
+        case FusedOp::kLte:
+          compareChunk<FusedOp::kLte>(
+              left, right, numRows, comparisons.data());
+          break;
+        case FusedOp::kGt:
+          compareChunk<FusedOp::kGt>(left, right, numRows, comparisons.data());
+          break;
+        case FusedOp::kGte:
+          compareChunk<FusedOp::kGte>(
+              left, right, numRows, comparisons.data());
+          break;
+      }
+    }
+
+    const T* rootValues = values.data() + (numNodes - 1) * kChunkSize;
+    for (auto i = 0; i < numRows; ++i) {
+      const auto row = chunkRows[i];
+      if (overflows[i]) {
+        // Some call overflowed, possibly on the placeholder of a null. The
+        // row is evaluated again call by call to raise the error of the
+        // first call that overflows on non-null arguments.
+        try {
+          if (comparison) {
+            const auto left = evalRow<T>(root.left, row, leaves);
+            const auto right =
+                left.has_value() ? evalRow<T>(root.right, row, leaves)
+                                 : std::nullopt;
+            if (right.has_value()) {
+              boolResult->set(
+                  row, compareValues(root.op, left.value(), right.value()));
+            } else {
+              result.setNull(row, true);
+            }
+          } else {
+            const auto value = evalRow<T>(nodes_.size() - 1, row, leaves);
+            if (value.has_value()) {
+              flatResult->set(row, value.value());
+            } else {
+              result.setNull(row, true);
+            }
+          }
+        } catch (const VeloxException&) {
+          result.setNull(row, true);
+          context.setVeloxExceptionError(row, std::current_exception());
+        }
+      } else if (nulls[i]) {
+        result.setNull(row, true);
+      } else if (comparison) {
+        boolResult->set(row, comparisons[i]);
+      } else {
+        flatResult->set(row, rootValues[i]);
+      }
+    }
+    chunkRows.clear();
+  };
+
+  rows.applyToSelected([&](auto row) {
+    chunkRows.push_back(row);
+    if (chunkRows.size() == kChunkSize) {
+      evalChunk();
+    }
+  });
+  if (!chunkRows.empty()) {
+    evalChunk();
+  }
+}
+
+template <typename T>
+std::optional<T> FusedExpr::evalRow(
+    int32_t node,
+    vector_size_t row,
+    std::vector<DecodedVector*>& leaves) const {
+  const auto& current = nodes_[node];
+  if (current.leaf >= 0) {
+    const auto& decoded = *leaves[current.leaf];
+    if (decoded.isNullAt(row)) {
+      return std::nullopt;
+    }
+    return decoded.valueAt<T>(row);
+  }
+  // The unfused calls do not evaluate the second argument of a row whose
+  // first argument is null.
+  const auto left = evalRow<T>(current.left, row, leaves);
+  if (!left.has_value()) {
+    return std::nullopt;
+  }
+  const auto right = evalRow<T>(current.right, row, leaves);
+  if (!right.has_value()) {
+    return std::nullopt;
+  }
+  return checkedArithmetic(current.op, left.value(), right.value());
+}
+
+void FusedExpr::appendNode(
+    int32_t node,
+    bool sql,
+    std::vector<VectorPtr>* complexConstants,
+    std::stringstream& out) const {
+  const auto& current = nodes_[node];
+  if (current.leaf >= 0) {
+    const auto& leaf = inputs_[current.leaf];
+    out << (sql ? leaf->toSql(complexConstants) : leaf->toString());
+    return;
+  }
+  if (sql) {
+    out << "\"" << current.name << "\"(";
+  } else {
+    out << current.name << "(";
+  }
+  appendNode(current.left, sql, complexConstants, out);
+  out << ", ";
+  appendNode(current.right, sql, complexConstants, out);
+  out << ")";
+}
+
+std::string FusedExpr::toString(bool recursive) const {
+  if (!recursive) {
+    return name();
+  }
+  std::stringstream out;
+  out << name() << "(";
+  appendNode(nodes_.size() - 1, false, nullptr, out);
+  out << ")";
+  return out.str();
+}
+
+std::string FusedExpr::toSql(std::vector<VectorPtr>* complexConstants) const {
+  std::stringstream out;
+  appendNode(nodes_.size() - 1, true, complexConstants, out);
+  return out.str();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// Scalar functions that FusedExpr evaluates without calling them.
+enum class FusedOp {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kEq,
+  kNeq,
+  kLt,
+  kLte,
+  kGt,
+  kGte,
+};
+
+/// Declares that the function 'name' computes 'op' for the signatures
+/// (T, T) -> T of arithmetic ops and (T, T) -> boolean of comparisons, where T
+/// is TINYINT, SMALLINT, INTEGER, BIGINT, REAL or DOUBLE. Integer arithmetic
+/// must throw on overflow and floating point comparisons must treat NaN as
+/// the largest value, equal to itself, as the Presto functions do. Called by
+/// the function registrations.
+void registerFusedFunction(const std::string& name, FusedOp op);
+
+/// Returns the op of a function registered with registerFusedFunction.
+std::optional<FusedOp> fusedFunction(const std::string& name);
+
+/// Evaluates a tree of arithmetic and comparison calls over columns and
+/// constants in one pass. The leaves are decoded once and the tree is
+/// evaluated in chunks of rows into scratch arrays, without the intermediate
+/// vectors and the per-call dispatch of the unfused tree. The results, nulls
+/// and errors are the same as those of the unfused calls. The inputs of the
+/// expression are the leaves.
+class FusedExpr : public SpecialForm {
+ public:
+  /// A leaf or a call of the tree.
+  struct Node {
+    /// Index in 'inputs' of a leaf, -1 for a call.
+    int32_t leaf{-1};
+    FusedOp op{FusedOp::kPlus};
+    /// Indices of the arguments of a call in the nodes of the tree.
+    int32_t left{-1};
+    int32_t right{-1};
+    /// Function name of a call.
+    std::string name;
+  };
+
+  /// 'nodes' is the tree in postorder, the root last. All the leaves and
+  /// calls other than a comparison root are of 'operandType'.
+  FusedExpr(
+      TypePtr type,
+      std::vector<ExprPtr>&& leaves,
+      std::vector<Node> nodes,
+      TypePtr operandType,
+      bool leavesSupportFlatNoNullsFastPath,
+      bool trackCpuUsage);
+
+  /// Returns the fused form of 'expr', or nullptr if 'expr' is not a tree of
+  /// at least two calls registered with registerFusedFunction over field
+  /// accesses and constants of one type. 'compileLeaf' compiles the leaves.
+  static ExprPtr tryCompile(
+      const core::TypedExprPtr& expr,
+      const std::function<ExprPtr(const core::TypedExprPtr&)>& compileLeaf,
+      bool trackCpuUsage);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  /// Prints the unfused calls inside fused(...).
+  std::string toString(bool recursive = true) const override;
+
+  /// Returns the SQL of the unfused calls.
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override;
+
+ private:
+  void computePropagatesNulls() override {
+    propagatesNulls_ = true;
+  }
+
+  template <typename T>
+  void evalTyped(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      std::vector<DecodedVector*>& leaves,
+      BaseVector& result);
+
+  // Evaluates 'row' call by call with checked arithmetic. Returns
+  // std::nullopt if the result is null. Throws the error of the unfused
+  // calls.
+  template <typename T>
+  std::optional<T> evalRow(
+      int32_t node,
+      vector_size_t row,
+      std::vector<DecodedVector*>& leaves) const;
+
+  // Appends the unfused calls under 'node' to 'out'.
+  void appendNode(
+      int32_t node,
+      bool sql,
+      std::vector<VectorPtr>* complexConstants,
+      std::stringstream& out) const;
+
+  const std::vector<Node> nodes_;
+  const TypePtr operandType_;
+};
+
+} // namespace facebook::velox::exec
@@ -15,8 +15,10 @@
  */
 
 #include <cmath>
+#include <optional>
 
 #include <double-conversion/double-conversion.h>
+#include <fast_float/fast_float.h>
 #include <folly/Expected.h>
 
 #include "velox/expression/PrestoCastHooks.h"
@@ -88,6 +90,28 @@ namespace {
 
 using double_conversion::StringToDoubleConverter;
 
+inline bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Parses 'begin' to 'end' if it is a plain decimal number, e.g. -12.5e3,
+// that starts and ends with a digit. fast_float rounds the same as
+// double-conversion but is faster. Returns std::nullopt for the other inputs,
+// e.g. NaN, Infinity or trailing spaces, which are left to double-conversion.
+template <typename T>
+std::optional<T> tryParseDecimalNumber(const char* begin, const char* end) {
+  const char* digits = begin + (begin < end && *begin == '-');
+  if (digits >= end || !isDigit(*digits) || !isDigit(*(end - 1))) {
+    return std::nullopt;
+  }
+  T result;
+  const auto [ptr, error] = fast_float::from_chars(begin, end, result);
+  if (error != std::errc() || ptr != end) {
+    return std::nullopt;
+  }
+  return result;
+}
+
 template <typename T>
 Expected<T> doCastToFloatingPoint(const StringView& data) {
   static const T kNan = std::numeric_limits<T>::quiet_NaN();
@@ -107,6 +131,9 @@ Expected<T> doCastToFloatingPoint(const StringView& data) {
     // 'data' only contains white spaces.
     return folly::makeUnexpected(Status::UserError());
   }
+  if (auto fastResult = tryParseDecimalNumber<T>(begin, data.end())) {
+    return fastResult.value();
+  }
   if constexpr (std::is_same_v<T, float>) {
     result = stringToDoubleConverter.StringToFloat(
         begin, length, &processedCharactersCount);
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <array>
 #include <exception>
 #include <memory>
 #include <optional>
@@ -151,6 +152,19 @@ class SimpleFunctionAdapter : public VectorFunction {
     }() && ...);
   }
 
+  // Whether callBatch() can be used. It needs fixed width primitive inputs and
+  // output that are read and written as flat arrays, and rows that are null if
+  // any input is null and never null otherwise.
+  static constexpr bool callBatchEligible = FUNC::udf_has_callBatch &&
+      fastPathIteration &&
+      return_type_traits::typeKind != TypeKind::BOOLEAN &&
+      allArgsFlatConstantFastPathEligible() && FUNC::is_default_null_behavior &&
+      !FUNC::can_produce_null_output;
+  static_assert(
+      !FUNC::udf_has_callBatch || callBatchEligible,
+      "callBatch() requires non-boolean fixed width primitive argument and "
+      "return types, default null behavior and a call() that returns void.");
+
   /// When true, a fast path for each possible combination of encodings will be
   /// used for reading arguments when all arguments are flat or constant
   /// primitivies.
@@ -331,7 +345,7 @@ class SimpleFunctionAdapter : public VectorFunction {
     bool isResultReused = false;
     if constexpr (
         !FUNC::can_produce_null_output && !FUNC::udf_has_callNullFree &&
-        return_type_traits::isPrimitiveType &&
+        !FUNC::udf_has_callBatch && return_type_traits::isPrimitiveType &&
         return_type_traits::isFixedWidth) {
       if (!reusableResult->get()) {
         if (auto* arg = findReusableArg<0>(args)) {
@@ -376,6 +390,12 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    if constexpr (callBatchEligible) {
+      if (tryCallBatch(applyContext, args)) {
+        return;
+      }
+    }
+
     std::vector<std::optional<LocalDecodedVector>> decoded;
     if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
@@ -483,6 +503,65 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Calls callBatch() once for the selected rows if they are consecutive and
+  // all arguments are flat or constant. Constant arguments are expanded to
+  // flat arrays. Selected rows have no null inputs because of the default null
+  // behavior. Returns false if callBatch() is not applicable or throws, so that
+  // the per row path evaluates the rows and reports errors per row.
+  bool tryCallBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args) const {
+    const auto& rows = *applyContext.rows;
+    if (!rows.isAllSelected() &&
+        rows.countSelected() != rows.end() - rows.begin()) {
+      return false;
+    }
+    for (const auto& arg : args) {
+      if (!arg->isFlatEncoding() && !arg->isConstantEncoding()) {
+        return false;
+      }
+    }
+    return callBatchImpl(
+        applyContext, args, std::make_index_sequence<FUNC::num_args>());
+  }
+
+  template <size_t... Is>
+  bool callBatchImpl(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    const auto begin = applyContext.rows->begin();
+    const auto numRows = applyContext.rows->end() - begin;
+    auto* pool = applyContext.context.pool();
+    std::array<BufferPtr, FUNC::num_args> expandedConstants;
+    try {
+      fn_->callBatch(
+          numRows,
+          applyContext.resultWriter.data_ + begin,
+          batchArg<Is>(
+              args[Is], begin, numRows, expandedConstants[Is], pool)...);
+    } catch (const std::exception&) {
+      return false;
+    }
+    return true;
+  }
+
+  template <int32_t POSITION>
+  const exec_arg_at<POSITION>* batchArg(
+      const VectorPtr& arg,
+      vector_size_t begin,
+      vector_size_t numRows,
+      BufferPtr& expanded,
+      memory::MemoryPool* pool) const {
+    using TArg = exec_arg_at<POSITION>;
+    if (arg->isConstantEncoding()) {
+      expanded = AlignedBuffer::allocate<TArg>(
+          numRows, pool, arg->asUnchecked<ConstantVector<TArg>>()->valueAt(0));
+      return expanded->as<TArg>();
+    }
+    return arg->asUnchecked<FlatVector<TArg>>()->rawValues() + begin;
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
@@ -556,7 +635,7 @@ class SimpleFunctionAdapter : public VectorFunction {
             applyContext, decodedArgs, rawArgs, readers..., reader);
       } else {
         decodedArgs[POSITION] = LocalDecodedVector(
-            applyContext.context, *rawArgs[POSITION], *applyContext.rows);
+            applyContext.context, rawArgs[POSITION], *applyContext.rows);
 
         auto* oneUnpacked = decodedArgs.at(POSITION).value().get();
         auto reader = VectorReader<arg_at<POSITION>>(oneUnpacked);
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+// Benchmarks sharing the decoding of a dictionary encoded input between the
+// functions reading it, see core::QueryConfig::kMaxDecodedVectorsCached. 'c0'
+// is a nested dictionary and 'c1' a flat vector, so that the expressions are
+// not evaluated on peeled inputs.
+
+namespace facebook::velox::exec {
+namespace {
+
+class DecodedVectorCacheBenchmark
+    : public functions::test::FunctionBenchmarkBase {
+ public:
+  DecodedVectorCacheBenchmark() : FunctionBenchmarkBase() {
+    functions::prestosql::registerArithmeticFunctions();
+    functions::prestosql::registerComparisonFunctions();
+
+    constexpr vector_size_t kSize = 10'000;
+    auto base = vectorMaker_.flatVector<int64_t>(
+        kSize, [](auto row) { return row; }, nullEvery(7));
+    auto inner = BaseVector::wrapInDictionary(
+        nullptr,
+        makeIndices(kSize, [](auto row) { return kSize - 1 - row; }),
+        kSize,
+        base);
+    auto dictionary = BaseVector::wrapInDictionary(
+        makeNulls(kSize, nullEvery(11)),
+        makeIndices(kSize, [](auto row) { return (row * 17) % kSize; }),
+        kSize,
+        inner);
+    data_ = vectorMaker_.rowVector(
+        {dictionary,
+         vectorMaker_.flatVector<int64_t>(
+             kSize, [](auto row) { return row % 100 + 1; })});
+  }
+
+  // Evaluates 'numReaders' expressions reading 'c0' with the decodings of
+  // 'c0' shared between up to 'maxCached' of them.
+  size_t run(int32_t numReaders, uint32_t maxCached) {
+    folly::BenchmarkSuspender suspender;
+    static const std::vector<std::string> kReaders = {
+        "c0 + c1", "c0 * c1", "c0 - c1", "c0 % c1", "c0 > c1", "c0 < c1"};
+    VELOX_CHECK_LE(numReaders, kReaders.size());
+    auto exprSet = compileExpressions(
+        {kReaders.begin(), kReaders.begin() + numReaders}, data_->type());
+    auto queryCtx = core::QueryCtx::create(
+        nullptr,
+        core::QueryConfig(
+            {{core::QueryConfig::kMaxDecodedVectorsCached,
+              std::to_string(maxCached)}}));
+    core::ExecCtx execCtx(pool(), queryCtx.get());
+    SelectivityVector rows(data_->size());
+    suspender.dismiss();
+
+    size_t count = 0;
+    for (auto i = 0; i < 100; ++i) {
+      EvalCtx evalCtx(&execCtx, &exprSet, data_.get());
+      std::vector<VectorPtr> results(numReaders);
+      exprSet.eval(rows, evalCtx, results);
+      count += results[0]->size();
+    }
+    return count;
+  }
+
+ private:
+  static std::function<bool(vector_size_t)> nullEvery(int32_t n) {
+    return [n](auto row) { return row % n == 0; };
+  }
+
+  BufferPtr makeIndices(
+      vector_size_t size,
+      const std::function<vector_size_t(vector_size_t)>& indexAt) {
+    auto indices = allocateIndices(size, pool());
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    for (auto i = 0; i < size; ++i) {
+      rawIndices[i] = indexAt(i);
+    }
+    return indices;
+  }
+
+  BufferPtr makeNulls(
+      vector_size_t size,
+      const std::function<bool(vector_size_t)>& isNullAt) {
+    auto nulls = allocateNulls(size, pool());
+    auto* rawNulls = nulls->asMutable<uint64_t>();
+    for (auto i = 0; i < size; ++i) {
+      bits::setNull(rawNulls, i, isNullAt(i));
+    }
+    return nulls;
+  }
+
+  RowVectorPtr data_;
+};
+
+std::unique_ptr<DecodedVectorCacheBenchmark> benchmark;
+
+BENCHMARK_MULTI(oneReaderNoCache) {
+  return benchmark->run(1, 0);
+}
+
+BENCHMARK_RELATIVE_MULTI(oneReaderCache) {
+  return benchmark->run(1, 4);
+}
+
+BENCHMARK_MULTI(twoReadersNoCache) {
+  return benchmark->run(2, 0);
+}
+
+BENCHMARK_RELATIVE_MULTI(twoReadersCache) {
+  return benchmark->run(2, 4);
+}
+
+BENCHMARK_MULTI(sixReadersNoCache) {
+  return benchmark->run(6, 0);
+}
+
+BENCHMARK_RELATIVE_MULTI(sixReadersCache) {
+  return benchmark->run(6, 4);
+}
+} // namespace
+} // namespace facebook::velox::exec
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  facebook::velox::memory::MemoryManager::initialize(
+      facebook::velox::memory::MemoryManager::Options{});
+  facebook::velox::exec::benchmark =
+      std::make_unique<facebook::velox::exec::DecodedVectorCacheBenchmark>();
+  folly::runBenchmarks();
+  facebook::velox::exec::benchmark.reset();
+  return 0;
+}
@@ -450,6 +450,9 @@ std::unordered_set<std::string> skipFunctionsSOT = {
     "$internal$split_to_map",
     "$internal$canonicalize",
     "$internal$contains",
+    "$internal$regexp_like_any",
+    "$internal$json_extract_scalars",
+    "$internal$url_extract_parts",
     "localtime", // localtime cannot be called with paranthesis:
                  // https://github.com/facebookincubator/velox/issues/14937,
     "jarowinkler_similarity", // https://github.com/facebookincubator/velox/issues/15736
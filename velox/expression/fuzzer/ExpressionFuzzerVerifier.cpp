@@ -17,11 +17,14 @@
 #include "velox/expression/fuzzer/ExpressionFuzzerVerifier.h"
 
 #include <boost/random/uniform_int_distribution.hpp>
+#include <folly/json.h>
 #include <glog/logging.h>
 #include <exception>
+#include <fstream>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/dwio/dwrf/RegisterDwrfWriter.h"
 #include "velox/exec/fuzzer/FuzzerUtil.h"
@@ -101,6 +104,17 @@ ExpressionFuzzerVerifier::ExpressionFuzzerVerifier(
   if (!exec::registerExprSetListener(statListener_)) {
     LOG(WARNING) << "Listener should only be registered once.";
   }
+
+  if (options_.perfMode && !options_.perfBaselinePath.empty()) {
+    std::ifstream in(options_.perfBaselinePath);
+    VELOX_CHECK(
+        in.good(),
+        "Cannot open perf baseline {}",
+        options_.perfBaselinePath);
+    const std::string json(
+        (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    perfBaseline_ = folly::parseJson(json);
+  }
 }
 
 std::pair<std::vector<InputTestCase>, InputRowMetadata>
@@ -359,6 +373,90 @@ void ExpressionFuzzerVerifier::retryWithTry(
   }
 }
 
+std::optional<double> ExpressionFuzzerVerifier::measureNanosPerRow(
+    const std::vector<core::TypedExprPtr>& plans,
+    const std::vector<InputTestCase>& inputTestCases) {
+  try {
+    exec::ExprSet exprSet(plans, &execCtx_, !options_.disableConstantFolding);
+    uint64_t minNanos = std::numeric_limits<uint64_t>::max();
+    uint64_t numRows = 0;
+    for (auto iteration = 0; iteration < options_.perfIterations; ++iteration) {
+      uint64_t nanos = 0;
+      numRows = 0;
+      for (const auto& testCase : inputTestCases) {
+        exec::EvalCtx evalCtx(&execCtx_, &exprSet, testCase.inputVector.get());
+        std::vector<VectorPtr> results(plans.size());
+        {
+          NanosecondTimer timer(&nanos);
+          exprSet.eval(testCase.activeRows, evalCtx, results);
+        }
+        numRows += testCase.activeRows.countSelected();
+      }
+      minNanos = std::min(minNanos, nanos);
+    }
+    if (numRows == 0) {
+      return std::nullopt;
+    }
+    return static_cast<double>(minNanos) / numRows;
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+void ExpressionFuzzerVerifier::recordPerf(
+    const std::vector<core::TypedExprPtr>& plans,
+    const std::vector<InputTestCase>& inputTestCases) {
+  const auto nanosPerRow = measureNanosPerRow(plans, inputTestCases);
+  if (!nanosPerRow.has_value()) {
+    return;
+  }
+  std::string sql;
+  for (const auto& plan : plans) {
+    sql += sql.empty() ? plan->toString() : ", " + plan->toString();
+  }
+  const auto key = std::to_string(currentSeed_);
+  perfResults_[key] =
+      folly::dynamic::object("sql", sql)("nanosPerRow", *nanosPerRow);
+  LOG(INFO) << fmt::format("Perf: {:.1f} ns per row", *nanosPerRow);
+
+  const auto* baseline = perfBaseline_.get_ptr(key);
+  // Skips the steps for which the seed generated another expression, e.g.
+  // because the set of functions changed.
+  if (baseline == nullptr || (*baseline)["sql"].asString() != sql) {
+    return;
+  }
+  ++numPerfCompared_;
+  const auto baselineNanosPerRow = (*baseline)["nanosPerRow"].asDouble();
+  if (*nanosPerRow >= baselineNanosPerRow * options_.perfSlowdownFactor) {
+    ++numPerfRegressions_;
+    LOG(ERROR) << fmt::format(
+        "Perf regression at seed {}: {:.1f} vs {:.1f} ns per row in the "
+        "baseline for {}",
+        currentSeed_,
+        *nanosPerRow,
+        baselineNanosPerRow,
+        sql);
+  }
+}
+
+void ExpressionFuzzerVerifier::finishPerf() {
+  if (!options_.perfOutputPath.empty()) {
+    std::ofstream out(options_.perfOutputPath);
+    VELOX_CHECK(
+        out.good(), "Cannot open perf output {}", options_.perfOutputPath);
+    out << folly::toPrettyJson(perfResults_);
+  }
+  LOG(ERROR) << "Perf: " << perfResults_.size() << " steps timed, "
+             << numPerfCompared_ << " compared to the baseline, "
+             << numPerfRegressions_ << " regressions";
+  VELOX_CHECK_EQ(
+      numPerfRegressions_,
+      0,
+      "{} steps are at least {}x slower than the baseline",
+      numPerfRegressions_,
+      options_.perfSlowdownFactor);
+}
+
 void ExpressionFuzzerVerifier::go() {
   VELOX_CHECK(
       options_.steps > 0 || options_.durationSeconds > 0,
@@ -367,6 +465,9 @@ void ExpressionFuzzerVerifier::go() {
       options_.maxExpressionTreesPerStep,
       0,
       "--max_expression_trees_per_step needs to be greater than zero.");
+  VELOX_CHECK(
+      !options_.perfMode || options_.perfIterations > 0,
+      "--perf_iterations needs to be greater than zero.");
 
   if (expressionFuzzer_.supportedFunctions().empty()) {
     LOG(WARNING) << "No functions to fuzz.";
@@ -479,6 +580,13 @@ void ExpressionFuzzerVerifier::go() {
       retryWithTry(plans, inputsToRetry, resultVectors, inputRowMetadata);
     }
 
+    if (options_.perfMode &&
+        std::none_of(results.begin(), results.end(), [](const auto& result) {
+          return result.exceptionPtr != nullptr;
+        })) {
+      recordPerf(plans, inputTestCases);
+    }
+
     LOG(INFO) << "==============================> Done with iteration " << i;
     reSeed();
     ++i;
@@ -492,6 +600,9 @@ void ExpressionFuzzerVerifier::go() {
              << numFailed;
   LOG(ERROR) << "Total test cases unsupported in the reference DB: "
              << numReferenceUnsupported;
+  if (options_.perfMode) {
+    finishPerf();
+  }
 }
 
 } // namespace facebook::velox::fuzzer
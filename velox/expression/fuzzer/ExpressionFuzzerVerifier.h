@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/dynamic.h>
+
 #include "velox/core/ITypedExpr.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/fuzzer/ReferenceQueryRunner.h"
@@ -113,6 +115,27 @@ class ExpressionFuzzerVerifier {
     // enabled).
     int32_t maxExpressionTreesPerStep = 1;
 
+    // If true, also times the common evaluation path of the steps that do not
+    // throw and flags the steps that got much slower than in
+    // 'perfBaselinePath'. A step is identified by its seed, so a run with the
+    // same seed and flags generates the same expressions and inputs,
+    // including their encodings.
+    bool perfMode = false;
+
+    // Number of timed evaluations per step in perf mode. The fastest counts.
+    int32_t perfIterations = 5;
+
+    // JSON file with the throughputs written by an earlier run to
+    // 'perfOutputPath'. Empty means no comparison.
+    std::string perfBaselinePath;
+
+    // JSON file to write the throughputs of this run to. Empty means none.
+    std::string perfOutputPath;
+
+    // A step is a regression if it is at least this many times slower than in
+    // the baseline. The run fails if any step regresses.
+    double perfSlowdownFactor = 2.0;
+
     VectorFuzzer::Options vectorFuzzerOptions;
 
     ExpressionFuzzer::Options expressionFuzzerOptions;
@@ -210,6 +233,23 @@ class ExpressionFuzzerVerifier {
   /// proportionOfTimesSelected numProcessedRows.
   void logStats();
 
+  // Returns the time in nanoseconds per row of the fastest of
+  // 'options_.perfIterations' evaluations of 'plans' over 'inputTestCases'
+  // with the common path. Returns std::nullopt if the evaluation throws.
+  std::optional<double> measureNanosPerRow(
+      const std::vector<core::TypedExprPtr>& plans,
+      const std::vector<InputTestCase>& inputTestCases);
+
+  // Records the throughput of the current step in perf mode and compares it
+  // to the baseline, if any.
+  void recordPerf(
+      const std::vector<core::TypedExprPtr>& plans,
+      const std::vector<InputTestCase>& inputTestCases);
+
+  // Writes the perf results to 'options_.perfOutputPath' and fails if any step
+  // regressed.
+  void finishPerf();
+
   // Appends an additional row number column called 'row_number' at the end of
   // the 'inputRow'. This column is then used to line up rows when comparing
   // results against a reference database.
@@ -240,6 +280,13 @@ class ExpressionFuzzerVerifier {
   ExpressionFuzzer expressionFuzzer_;
 
   std::shared_ptr<exec::test::ReferenceQueryRunner> referenceQueryRunner_;
+
+  // Perf mode results of an earlier run and of this run, keyed by the seed of
+  // the step.
+  folly::dynamic perfBaseline_ = folly::dynamic::object;
+  folly::dynamic perfResults_ = folly::dynamic::object;
+  size_t numPerfCompared_{0};
+  size_t numPerfRegressions_{0};
 };
 
 } // namespace facebook::velox::fuzzer
@@ -82,6 +82,34 @@ DEFINE_int32(
     "re-use already generated columns and subexpressions (if re-use is "
     "enabled).");
 
+DEFINE_bool(
+    perf_mode,
+    false,
+    "Also time the expressions of the steps that do not throw and compare "
+    "their throughput to --perf_baseline_path.");
+
+DEFINE_int32(
+    perf_iterations,
+    5,
+    "Number of timed evaluations per step in perf mode. The fastest counts.");
+
+DEFINE_string(
+    perf_baseline_path,
+    "",
+    "JSON file with the throughputs written to --perf_output_path by an "
+    "earlier run with the same seed and flags. Empty disables the comparison.");
+
+DEFINE_string(
+    perf_output_path,
+    "",
+    "JSON file to write the throughputs of the steps to in perf mode.");
+
+DEFINE_double(
+    perf_slowdown_factor,
+    2.0,
+    "In perf mode, fail if a step is at least this many times slower than in "
+    "the baseline.");
+
 // The flags bellow are used to initialize ExpressionFuzzer::options.
 DEFINE_string(
     only,
@@ -220,6 +248,11 @@ ExpressionFuzzerVerifier::Options getExpressionFuzzerVerifierOptions(
   opts.commonDictionaryWrapRatio =
       FLAGS_common_dictionary_wraps_generation_ratio;
   opts.maxExpressionTreesPerStep = FLAGS_max_expression_trees_per_step;
+  opts.perfMode = FLAGS_perf_mode;
+  opts.perfIterations = FLAGS_perf_iterations;
+  opts.perfBaselinePath = FLAGS_perf_baseline_path;
+  opts.perfOutputPath = FLAGS_perf_output_path;
+  opts.perfSlowdownFactor = FLAGS_perf_slowdown_factor;
   opts.vectorFuzzerOptions = getVectorFuzzerOptions();
   opts.expressionFuzzerOptions = getExpressionFuzzerOptions(
       skipFunctions, exprTransformers, referenceQueryRunner);
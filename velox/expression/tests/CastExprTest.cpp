@@ -331,6 +331,30 @@ TEST_F(CastExprTest, basics) {
        std::numeric_limits<float>::infinity(),
        -std::numeric_limits<float>::infinity(),
        std::numeric_limits<float>::quiet_NaN()});
+  testCast<std::string, double>(
+      "double",
+      {"1.5e3",
+       "-0.25",
+       "0.1",
+       "12345678901234567890",
+       "1e400",
+       "1e-400",
+       " 2.5",
+       "2.5 ",
+       "+2.5",
+       ".5",
+       "5."},
+      {1'500.0,
+       -0.25,
+       0.1,
+       12345678901234567890.0,
+       std::numeric_limits<double>::infinity(),
+       0.0,
+       2.5,
+       2.5,
+       2.5,
+       0.5,
+       5.0});
 
   gflags::FlagSaver flagSaver;
   FLAGS_experimental_enable_legacy_cast = true;
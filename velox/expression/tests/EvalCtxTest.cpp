@@ -237,3 +237,68 @@ TEST_F(EvalCtxTest, inputFlatNoNulls) {
   EvalCtx context(&execCtx_);
   ASSERT_FALSE(context.inputFlatNoNulls());
 }
+
+TEST_F(EvalCtxTest, decodedVectorCache) {
+  auto queryCtx = core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig({{core::QueryConfig::kMaxDecodedVectorsCached, "1"}}));
+  core::ExecCtx execCtx{pool_.get(), queryCtx.get()};
+  EvalCtx context(&execCtx);
+
+  auto base = makeNullableFlatVector<int64_t>({1, std::nullopt, 3, 4, 5});
+  auto inner = wrapInDictionary(makeIndicesInReverse(5), base);
+  VectorPtr dictionary = wrapInDictionary(makeIndices({0, 0, 2, 3, 4}), inner);
+  SelectivityVector rows(5);
+
+  // The same vector decoded for the same rows shares one decoding.
+  auto* decoded = context.getCachedDecodedVector(dictionary, rows);
+  ASSERT_NE(decoded, nullptr);
+  ASSERT_EQ(decoded->base(), base.get());
+  ASSERT_EQ(context.getCachedDecodedVector(dictionary, rows), decoded);
+  for (auto i = 0; i < rows.size(); ++i) {
+    ASSERT_EQ(decoded->isNullAt(i), dictionary->isNullAt(i));
+    if (!decoded->isNullAt(i)) {
+      ASSERT_EQ(
+          decoded->valueAt<int64_t>(i),
+          dictionary->as<SimpleVector<int64_t>>()->valueAt(i));
+    }
+  }
+  {
+    LocalDecodedVector local(context, dictionary, rows);
+    ASSERT_EQ(local.get(), decoded);
+  }
+
+  // Different rows, non-dictionary vectors and a full cache are not shared.
+  SelectivityVector otherRows(5);
+  otherRows.setValid(1, false);
+  otherRows.updateBounds();
+  ASSERT_EQ(context.getCachedDecodedVector(dictionary, otherRows), nullptr);
+  ASSERT_EQ(context.getCachedDecodedVector(base, rows), nullptr);
+  {
+    LocalDecodedVector local(context, dictionary, otherRows);
+    ASSERT_NE(local.get(), decoded);
+    ASSERT_EQ(local->base(), base.get());
+  }
+
+  // The entry of a released vector is reused.
+  dictionary.reset();
+  VectorPtr otherDictionary = wrapInDictionary(makeIndices({4, 3}), 2, base);
+  SelectivityVector twoRows(2);
+  auto* otherDecoded = context.getCachedDecodedVector(otherDictionary, twoRows);
+  ASSERT_NE(otherDecoded, nullptr);
+  ASSERT_EQ(otherDecoded->valueAt<int64_t>(0), 5);
+  ASSERT_EQ(otherDecoded->valueAt<int64_t>(1), 4);
+
+  // The cache is enabled by default and 0 disables it.
+  EvalCtx defaultContext(&execCtx_);
+  ASSERT_NE(
+      defaultContext.getCachedDecodedVector(otherDictionary, twoRows), nullptr);
+  auto disabledQueryCtx = core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig({{core::QueryConfig::kMaxDecodedVectorsCached, "0"}}));
+  core::ExecCtx disabledExecCtx{pool_.get(), disabledQueryCtx.get()};
+  EvalCtx disabledContext(&disabledExecCtx);
+  ASSERT_EQ(
+      disabledContext.getCachedDecodedVector(otherDictionary, twoRows),
+      nullptr);
+}
@@ -18,6 +18,7 @@
 #include "velox/core/Expressions.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/FunctionProfileRegistry.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/parse/Expressions.h"
@@ -345,6 +346,62 @@ TEST_F(ExprStatsTest, specialForms) {
   ASSERT_TRUE(exec::unregisterExprSetListener(listener));
 }
 
+TEST_F(ExprStatsTest, denseConjuncts) {
+  vector_size_t size = 1'024;
+
+  std::vector<Event> events;
+  auto listener = std::make_shared<TestListener>(events);
+  ASSERT_TRUE(exec::registerExprSetListener(listener));
+
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 7; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 2; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row % 3; }, nullEvery(5)),
+  });
+
+  auto evaluateDense = [&](const std::string& expression, bool dense) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprTrackCpuUsage, "true"},
+        {core::QueryConfig::kDenseConjunctEvaluationEnabled,
+         dense ? "true" : "false"},
+    });
+    events.clear();
+    auto result = evaluate(expression, data);
+    EXPECT_EQ(1, events.size());
+    return result;
+  };
+
+  // c2 = 0 leaves 512 of 1024 rows and c1 > 1 leaves 365. The first two
+  // inputs are evaluated on all rows and the last on the undecided ones.
+  const std::string andExpression = "c2 = 0 and c1 > 1 and c0 < 100";
+  auto expected = evaluateDense(andExpression, false);
+  ASSERT_EQ(0, events.back().stats.at("and").numDenseConjunctInputs);
+  assertEqualVectors(expected, evaluateDense(andExpression, true));
+  auto stats = events.back().stats.at("and");
+  ASSERT_EQ(2, stats.numDenseConjunctInputs);
+  ASSERT_EQ(1, stats.numDenseToSparseSwitches);
+
+  const std::string orExpression = "c2 = 1 or c1 = 0 or c0 > 1000";
+  expected = evaluateDense(orExpression, false);
+  assertEqualVectors(expected, evaluateDense(orExpression, true));
+  stats = events.back().stats.at("or");
+  ASSERT_EQ(2, stats.numDenseConjunctInputs);
+  ASSERT_EQ(1, stats.numDenseToSparseSwitches);
+
+  // Inputs on columns with nulls and inputs that are not a function of
+  // columns and constants are evaluated on the undecided rows.
+  const std::string sparseExpression = "c3 = 1 and c0 + 1 > 10";
+  expected = evaluateDense(sparseExpression, false);
+  assertEqualVectors(expected, evaluateDense(sparseExpression, true));
+  stats = events.back().stats.at("and");
+  ASSERT_EQ(0, stats.numDenseConjunctInputs);
+  ASSERT_EQ(0, stats.numDenseToSparseSwitches);
+
+  ASSERT_TRUE(exec::unregisterExprSetListener(listener));
+}
+
 TEST_F(ExprStatsTest, errorLog) {
   // Register a listener to log exceptions.
   std::vector<Event> events;
@@ -507,3 +564,58 @@ TEST_F(ExprStatsTest, selectiveCpuTrackingForUdfs) {
       {"(c0 + c1) * c1", "pow(c0 + c1, 2)"},
       {"plus", "pow", "multiply", "cast"});
 }
+
+TEST_F(ExprStatsTest, cpuSampling) {
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprTrackCpuUsage, "false"},
+      {core::QueryConfig::kExprCpuSamplingInterval, "3"},
+  });
+  auto& registry = exec::FunctionProfileRegistry::instance();
+  registry.clear();
+
+  vector_size_t size = 10;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row; }, nullEvery(2)),
+  });
+  auto rowType = asRowType(data->type());
+
+  {
+    auto exprSet = compileExpressions({"c0 + c1"}, rowType);
+    for (auto i = 0; i < 7; ++i) {
+      evaluate(*exprSet, data);
+    }
+    // Batches are not timed outside of the samples.
+    ASSERT_EQ(exprSet->exprs()[0]->stats().timing.count, 0);
+  }
+  {
+    auto exprSet = compileExpressions({"c0 * c0"}, rowType);
+    evaluate(*exprSet, data);
+  }
+
+  // The 1st, 4th and 7th batches are sampled. The rows with a null input skip
+  // the function call.
+  auto plus = registry.profile("plus");
+  ASSERT_TRUE(plus.has_value());
+  ASSERT_EQ(plus->numSampledBatches, 3);
+  ASSERT_EQ(plus->numSampledRows, 3 * size / 2);
+  ASSERT_EQ(plus->numSampledNullRows, 0);
+  ASSERT_EQ(plus->estimatedRows, 3 * 3 * size / 2);
+  ASSERT_EQ(plus->sampledTiming.count, 3);
+
+  auto multiply = registry.profile("multiply");
+  ASSERT_TRUE(multiply.has_value());
+  ASSERT_EQ(multiply->numSampledBatches, 1);
+  ASSERT_EQ(multiply->numSampledRows, size);
+  ASSERT_FALSE(registry.profile("minus").has_value());
+
+  auto top =
+      registry.topFunctions(1, exec::FunctionProfileRegistry::SortKey::kRows);
+  ASSERT_EQ(top.size(), 1);
+  ASSERT_EQ(top[0].name, "plus");
+  ASSERT_EQ(registry.topFunctions(10).size(), 2);
+
+  registry.clear();
+  ASSERT_TRUE(registry.topFunctions(10).empty());
+}
@@ -2167,6 +2167,76 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK_EQ(base.use_count(), 1);
 }
 
+TEST_F(ExprTest, memoAlternatingBases) {
+  // Verify that the results for a dictionary base survive a batch over a
+  // different base.
+  auto makeBase = [&]() {
+    return makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  };
+  auto first = makeBase();
+  auto second = makeBase();
+  auto indices = makeIndices(100, [](auto row) { return row * 3; });
+
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto exprSet = compileExpression("c0 % 7 = 1", rowType);
+  auto expectedResult =
+      makeFlatVector<bool>(100, [](auto row) { return (row * 3) % 7 == 1; });
+
+  int64_t expectedRows = 0;
+  // Each base is seen twice before its results are cached.
+  for (auto i = 0; i < 2; ++i) {
+    for (const auto& base : {first, second}) {
+      auto [result, stats] = evaluateWithStats(
+          exprSet.get(), makeRowVector({wrapInDictionary(indices, 100, base)}));
+      assertEqualVectors(expectedResult, result);
+      expectedRows += 100;
+      ASSERT_EQ(stats["eq"].numProcessedRows, expectedRows);
+    }
+  }
+
+  // Both bases are memoized.
+  for (const auto& base : {first, second, first}) {
+    auto [result, stats] = evaluateWithStats(
+        exprSet.get(), makeRowVector({wrapInDictionary(indices, 100, base)}));
+    assertEqualVectors(expectedResult, result);
+    ASSERT_EQ(stats["eq"].numProcessedRows, expectedRows);
+  }
+  ASSERT_NE(first.use_count(), 1);
+  ASSERT_NE(second.use_count(), 1);
+}
+
+TEST_F(ExprTest, memoReleasesDroppedBases) {
+  // Verify that the memo of a base does not outlive the base's other holders.
+  auto makeBase = [&]() {
+    return makeArrayVector<int64_t>(
+        1'000,
+        [](auto row) { return row % 5 + 1; },
+        [](auto row, auto index) { return (row % 3) + index; });
+  };
+  auto base = makeBase();
+  auto indices = makeIndices(100, [](auto row) { return row * 2; });
+
+  auto rowType = ROW({"c0"}, {base->type()});
+  auto exprSet = compileExpression("c0[1] = 1", rowType);
+  auto expectedResult =
+      makeFlatVector<bool>(100, [](auto row) { return (row * 2) % 3 == 1; });
+
+  // The results are cached once the base is seen twice.
+  for (auto i = 0; i < 2; ++i) {
+    auto result = evaluate(
+        exprSet.get(), makeRowVector({wrapInDictionary(indices, 100, base)}));
+    assertEqualVectors(expectedResult, result);
+  }
+  ASSERT_NE(base.use_count(), 1);
+
+  std::weak_ptr<BaseVector> weakBase = base;
+  base = makeBase();
+  auto result = evaluate(
+      exprSet.get(), makeRowVector({wrapInDictionary(indices, 100, base)}));
+  assertEqualVectors(expectedResult, result);
+  ASSERT_TRUE(weakBase.expired());
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gmock/gmock.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+class FusedExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setFusion(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFusionEnabled, enabled ? "true" : "false"},
+    });
+  }
+
+  // Returns the compiled form of 'expression' with fusion enabled.
+  std::string fusedForm(const std::string& expression, const RowTypePtr& type) {
+    setFusion(true);
+    return compileExpression(expression, type)->expr(0)->toString();
+  }
+
+  // Checks that 'expression' is fused and gives the same results as the
+  // unfused calls on 'rows' of 'input'.
+  void testFusion(
+      const std::string& expression,
+      const RowVectorPtr& input,
+      const std::optional<SelectivityVector>& rows = std::nullopt) {
+    setFusion(false);
+    const auto expected = evaluate(expression, input, rows);
+    EXPECT_THAT(
+        fusedForm(expression, asRowType(input->type())),
+        ::testing::StartsWith("fused("));
+    const auto result = evaluate(expression, input, rows);
+    if (rows.has_value()) {
+      assertEqualVectors(expected, result, rows.value());
+    } else {
+      assertEqualVectors(expected, result);
+    }
+  }
+};
+
+TEST_F(FusedExprTest, arithmetic) {
+  const vector_size_t size = 3'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row - 1'000; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 17; }, nullEvery(7)),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 3; }, nullEvery(11)),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 100; }),
+  });
+  testFusion("c0 * c1 + c2", input);
+  testFusion("c0 - c1 * (c2 - c0)", input);
+  testFusion("c0 * c1 + c2 > c3", input);
+  testFusion("c3 = c0 - c2", input);
+
+  // Dictionary and constant leaves, and a subset of the rows.
+  auto indices = makeIndicesInReverse(size);
+  auto dictionaryInput = makeRowVector({
+      wrapInDictionary(indices, size, input->childAt(0)),
+      input->childAt(1),
+      makeConstant<int64_t>(5, size),
+      makeConstant<int64_t>(std::nullopt, size),
+  });
+  SelectivityVector rows(size);
+  for (auto row = 0; row < size; row += 3) {
+    rows.setValid(row, false);
+  }
+  rows.updateBounds();
+  testFusion("c0 * c2 - c1", dictionaryInput, rows);
+  testFusion("c0 * c2 <= c1 + c0", dictionaryInput, rows);
+  testFusion("c0 * c2 - c3", dictionaryInput, rows);
+}
+
+TEST_F(FusedExprTest, types) {
+  const vector_size_t size = 100;
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int8_t>(size, [](auto row) { return row % 10; }),
+      makeFlatVector<double>(
+          size,
+          [](auto row) {
+            return row % 5 == 0 ? std::numeric_limits<double>::quiet_NaN()
+                                : row * 0.5;
+          },
+          nullEvery(9)),
+      makeFlatVector<float>(size, [](auto row) { return row * 0.25; }),
+  });
+  testFusion("c0 * 3 + c0 < 100", input);
+  testFusion("c1 * c1 - c1", input);
+  // NaN is equal to itself and larger than the other values.
+  testFusion("c2 * c2 = c2 + c2", input);
+  testFusion("c2 * c2 > c2 - c2", input);
+  testFusion("c3 + c3 * c3", input);
+
+  // A single call, mixed types and other functions are not fused.
+  const auto type = asRowType(input->type());
+  EXPECT_EQ(fusedForm("c0 + c0", type), "plus(c0, c0)");
+  EXPECT_THAT(
+      fusedForm("cast(c1 as integer) + c0 * c0", type),
+      ::testing::Not(::testing::StartsWith("fused(")));
+  EXPECT_THAT(
+      fusedForm("abs(c0) + c0 * c0", type),
+      ::testing::Not(::testing::StartsWith("fused(")));
+  EXPECT_EQ(
+      fusedForm("c0 + c0 * c0", type), "fused(plus(c0, multiply(c0, c0)))");
+}
+
+TEST_F(FusedExprTest, overflow) {
+  auto input = makeRowVector({
+      makeNullableFlatVector<int64_t>(
+          {1, std::numeric_limits<int64_t>::max(), 3, std::nullopt, 5}),
+      makeFlatVector<int64_t>({2, 2, 2, 2, 2}),
+      makeNullableFlatVector<int64_t>(
+          {10, 20, std::nullopt, std::numeric_limits<int64_t>::max(), 50}),
+  });
+  setFusion(true);
+  VELOX_ASSERT_THROW(
+      evaluate("c0 * c1 + c2", input),
+      "integer overflow: 9223372036854775807 * 2");
+  VELOX_ASSERT_THROW(
+      evaluate("c2 + c1 * c0 > c1", input),
+      "integer overflow: 2 * 9223372036854775807");
+
+  // The rows that overflow are null under TRY. At row 3, c2 + c1 overflows
+  // but c0 is null, so the row is null without an error.
+  testFusion("try(c0 * c1 + c2)", input);
+  testFusion("try(c0 * c1 - (c2 + c1))", input);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>(
+          {12, std::nullopt, std::nullopt, std::nullopt, 60}),
+      evaluate("try(c0 * c1 + c2)", input));
+}
@@ -1703,4 +1703,84 @@ TEST_F(SimpleFunctionTest, timeTypeTest) {
   }
 }
 
+template <typename TExec>
+struct BatchPlusFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(TExec);
+
+  static inline int32_t numBatchCalls = 0;
+
+  void call(int64_t& out, const int64_t& a, const int32_t& b) {
+    VELOX_USER_CHECK_GE(a, 0, "Input must not be negative");
+    out = a + b;
+  }
+
+  void callBatch(
+      int32_t numRows,
+      int64_t* out,
+      const int64_t* a,
+      const int32_t* b) {
+    ++numBatchCalls;
+    for (auto i = 0; i < numRows; ++i) {
+      VELOX_USER_CHECK_GE(a[i], 0, "Input must not be negative");
+      out[i] = a[i] + b[i];
+    }
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<BatchPlusFunction, int64_t, int64_t, int32_t>(
+      {"batch_plus"});
+  auto& numBatchCalls = BatchPlusFunction<exec::VectorExec>::numBatchCalls;
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4}),
+      makeFlatVector<int32_t>({10, 20, 30, 40}),
+  });
+  numBatchCalls = 0;
+  assertEqualVectors(
+      makeFlatVector<int64_t>({11, 22, 33, 44}),
+      evaluate("batch_plus(c0, c1)", data));
+  EXPECT_EQ(numBatchCalls, 1);
+
+  // Constant arguments are expanded.
+  assertEqualVectors(
+      makeFlatVector<int64_t>({6, 7, 8, 9}),
+      evaluate("batch_plus(c0, 5::integer)", data));
+  EXPECT_EQ(numBatchCalls, 2);
+
+  // Rows with null inputs are not selected, so the rows are not consecutive
+  // and call() is used.
+  data = makeRowVector({
+      makeNullableFlatVector<int64_t>({1, std::nullopt, 3, 4}),
+      makeFlatVector<int32_t>({10, 20, 30, 40}),
+  });
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({11, std::nullopt, 33, 44}),
+      evaluate("batch_plus(c0, c1)", data));
+  EXPECT_EQ(numBatchCalls, 2);
+
+  // Dictionary encoded inputs use call().
+  data = makeRowVector({
+      wrapInDictionary(
+          makeIndicesInReverse(4), makeFlatVector<int64_t>({1, 2, 3, 4})),
+      makeFlatVector<int32_t>({10, 20, 30, 40}),
+  });
+  assertEqualVectors(
+      makeFlatVector<int64_t>({14, 23, 32, 41}),
+      evaluate("batch_plus(c0, c1)", data));
+  EXPECT_EQ(numBatchCalls, 2);
+
+  // Errors thrown by callBatch() are reported per row by call().
+  data = makeRowVector({
+      makeFlatVector<int64_t>({1, -2, 3, 4}),
+      makeFlatVector<int32_t>({10, 20, 30, 40}),
+  });
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({11, std::nullopt, 33, 44}),
+      evaluate("try(batch_plus(c0, c1))", data));
+  EXPECT_EQ(numBatchCalls, 3);
+  VELOX_ASSERT_THROW(
+      evaluate("batch_plus(c0, c1)", data), "Input must not be negative");
+}
+
 } // namespace
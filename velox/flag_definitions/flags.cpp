@@ -122,6 +122,17 @@ DEFINE_int32(
 
 DEFINE_bool(velox_ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 
+DEFINE_bool(
+    velox_io_uring_enabled,
+    true,
+    "Use io_uring for vectored local file IO when Velox is built with "
+    "VELOX_ENABLE_IO_URING");
+
+DEFINE_int32(
+    velox_io_uring_queue_depth,
+    64,
+    "Number of in-flight requests of the process-wide io_uring");
+
 DEFINE_bool(
     velox_ssd_verify_write,
     false,
@@ -62,6 +62,24 @@ struct BucketFunction {
     return Status::OK();
   }
 
+  // Hashes a batch of integers or dates in a loop the compiler can vectorize.
+  // Throws on an invalid number of buckets, so that call() reports the error
+  // for each row.
+  template <typename T>
+  FOLLY_ALWAYS_INLINE std::enable_if_t<std::is_integral_v<T>> callBatch(
+      int32_t numRows,
+      int32_t* out,
+      const int32_t* numBuckets,
+      const T* input) {
+    for (auto i = 0; i < numRows; ++i) {
+      VELOX_USER_CHECK_GT(numBuckets[i], 0, "Invalid number of buckets.");
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      out[i] =
+          getBucketIndex(numBuckets[i], Murmur3Hash32::hashInt64(input[i]));
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status
   call(int32_t& out, int32_t numBuckets, const arg_type<Varchar>& input) {
     VELOX_USER_RETURN_LE(numBuckets, 0, "Invalid number of buckets.");
@@ -72,6 +72,13 @@ struct DaysFunction {
       const arg_type<Date>& date) {
     result = date;
   }
+
+  FOLLY_ALWAYS_INLINE void
+  callBatch(int32_t numRows, int32_t* result, const Timestamp* timestamps) {
+    for (auto i = 0; i < numRows; ++i) {
+      result[i] = epochDay(timestamps[i]);
+    }
+  }
 };
 
 // hours(input) -> hours from 1970-01-01 00:00:00
@@ -85,6 +92,13 @@ struct HoursFunction {
       const arg_type<Timestamp>& timestamp) {
     result = epochHour(timestamp);
   }
+
+  FOLLY_ALWAYS_INLINE void
+  callBatch(int32_t numRows, int32_t* result, const Timestamp* timestamps) {
+    for (auto i = 0; i < numRows; ++i) {
+      result[i] = epochHour(timestamps[i]);
+    }
+  }
 };
 
 void registerDateTimeFunctions(const std::string& prefix) {
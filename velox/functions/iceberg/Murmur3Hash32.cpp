@@ -19,15 +19,6 @@
 
 namespace facebook::velox::functions::iceberg {
 
-namespace {
-
-constexpr int32_t kSeed = 0;
-} // namespace
-
-int32_t Murmur3Hash32::hashInt64(uint64_t input) {
-  return Murmur3Hash32Base::hashInt64(input, kSeed);
-}
-
 int32_t Murmur3Hash32::hashBytes(const char* input, uint32_t len) {
   const uint8_t* data = reinterpret_cast<const uint8_t*>(input);
   const int32_t nblocks = len / 4;
@@ -31,12 +31,18 @@ class Murmur3Hash32 : Murmur3Hash32Base {
  public:
   /// Value of type INTEGER and BIGINT is treated as unsigned type.
   /// For the schema evolution, promote int to int64, treat int32 as uint64.
-  static int32_t hashInt64(uint64_t input);
+  /// Inline so that loops over columns of integers can be vectorized.
+  FOLLY_ALWAYS_INLINE static int32_t hashInt64(uint64_t input) {
+    return Murmur3Hash32Base::hashInt64(input, kSeed);
+  }
 
   /// Hash the bytes every 4 bytes, XOR on remaining bytes. Processing for the
   /// remaining bytes is different with Spark murmur3 which combine with the
   /// remaining bytes.
   static int32_t hashBytes(const char* input, uint32_t len);
+
+ private:
+  static constexpr uint32_t kSeed = 0;
 };
 
 } // namespace facebook::velox::functions::iceberg
@@ -15,6 +15,7 @@
  */
 #include "velox/functions/iceberg/BucketFunction.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/iceberg/Murmur3Hash32.h"
 #include "velox/functions/iceberg/tests/IcebergFunctionBaseTest.h"
 
 #include <gtest/gtest.h>
@@ -63,6 +64,45 @@ TEST_F(BucketFunctionTest, integerTypes) {
       "Reason: (-3 vs. 0) Invalid number of buckets.\nExpression: numBuckets <= 0\n");
 }
 
+TEST_F(BucketFunctionTest, integerColumns) {
+  // Flat columns are bucketed in one batch.
+  constexpr vector_size_t kSize = 1'000;
+  auto value = [](vector_size_t row) { return row * 7'919 - 500'000; };
+  auto expected = makeFlatVector<int32_t>(kSize, [&](auto row) {
+    return (Murmur3Hash32::hashInt64(static_cast<int64_t>(value(row))) &
+            std::numeric_limits<int32_t>::max()) %
+        16;
+  });
+  auto numBuckets = makeConstant<int32_t>(16, kSize);
+  velox::test::assertEqualVectors(
+      expected,
+      evaluate(
+          "bucket(c0, c1)",
+          makeRowVector(
+              {numBuckets, makeFlatVector<int32_t>(kSize, value)})));
+  velox::test::assertEqualVectors(
+      expected,
+      evaluate(
+          "bucket(c0, c1)",
+          makeRowVector(
+              {numBuckets, makeFlatVector<int64_t>(kSize, value)})));
+
+  // An invalid number of buckets fails only its row.
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          kSize, [](auto row) { return row == 10 ? 0 : 16; }),
+      makeFlatVector<int64_t>(kSize, value),
+  });
+  auto result = evaluate("try(bucket(c0, c1))", data);
+  for (auto row = 0; row < kSize; ++row) {
+    if (row == 10) {
+      ASSERT_TRUE(result->isNullAt(row));
+    } else {
+      ASSERT_TRUE(expected->equalValueAt(result.get(), row, row));
+    }
+  }
+}
+
 TEST_F(BucketFunctionTest, string) {
   EXPECT_EQ(bucket<std::string>(5, "abcdefg"), 4);
   EXPECT_EQ(bucket<std::string>(128, "abc"), 122);
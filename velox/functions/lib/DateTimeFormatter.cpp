@@ -16,6 +16,8 @@
 
 #include "velox/functions/lib/DateTimeFormatter.h"
 #include <folly/String.h>
+#include <folly/container/F14Map.h>
+#include <array>
 #include <charconv>
 #include <cstring>
 #include "velox/common/base/CountBits.h"
@@ -189,6 +191,12 @@ static std::
             {"DEC", {"EMBER", 12}},
         };
 
+// "00" to "99", the 2 digit decimal representations of 0 to 99.
+constexpr char kDigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536"
+    "37383940414243444546474849505152535455565758596061626364656667686970717273"
+    "7475767778798081828384858687888990919293949596979899";
+
 // Pads the content with desired padding characters. E.g. if we need to pad 999
 // with three 0s in front, the result will be '000999'.
 // @param content the content that is going to be padded.
@@ -208,6 +216,21 @@ int32_t padContent(
     char* maxResultEnd,
     char* result,
     const bool padFront = true) {
+  // Fast path for the 2 digit fields and 4 digit years of the common
+  // patterns, which writes digit pairs from a table.
+  if (padding == '0' && padFront && content >= 0 && content < 10'000) {
+    const auto value = static_cast<int32_t>(content);
+    if (totalDigits == 2 && value < 100) {
+      std::memcpy(result, kDigitPairs + 2 * value, 2);
+      return 2;
+    }
+    if (totalDigits == 4 || (totalDigits < 4 && value >= 1'000)) {
+      std::memcpy(result, kDigitPairs + 2 * (value / 100), 2);
+      std::memcpy(result + 2, kDigitPairs + 2 * (value % 100), 2);
+      return 4;
+    }
+  }
+
   const bool isNegative = content < 0;
   const auto digitLength =
       isNegative ? countDigits(-(__int128_t)content) : countDigits(content);
@@ -1563,8 +1586,153 @@ int32_t DateTimeFormatter::format(
   return resultSize;
 }
 
+void DateTimeFormatter::initFixedWidthLayout() {
+  int32_t offset = 0;
+  bool hasYear = false;
+  bool hasMonth = false;
+  bool hasDay = false;
+  // Bit mask of the seen specifiers to reject repeated fields.
+  uint64_t seen = 0;
+  std::vector<FixedWidthPiece> pieces;
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      // A digit in a literal could be read as part of the previous field.
+      if (token.literal.empty() ||
+          std::any_of(
+              token.literal.begin(), token.literal.end(), characterIsDigit)) {
+        return;
+      }
+      pieces.push_back(
+          {DateTimeFormatSpecifier::ERA,
+           offset,
+           static_cast<int32_t>(token.literal.size()),
+           token.literal});
+      offset += token.literal.size();
+      continue;
+    }
+    const auto specifier = token.pattern.specifier;
+    const auto digits = token.pattern.minRepresentDigits;
+    int32_t width;
+    switch (specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        // Fewer digits would read a variable number of digits.
+        width = 4;
+        hasYear = true;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        width = 2;
+        hasMonth = true;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        width = 2;
+        hasDay = true;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        width = 2;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        // Milliseconds have the same meaning in all formatter types.
+        width = 3;
+        break;
+      default:
+        return;
+    }
+    const auto bit = 1ULL << static_cast<uint8_t>(specifier);
+    if (digits != width || (seen & bit) != 0) {
+      return;
+    }
+    seen |= bit;
+    pieces.push_back({specifier, offset, width, {}});
+    offset += width;
+  }
+  // Without all of year, month and day the defaults depend on the fields
+  // present.
+  if (!hasYear || !hasMonth || !hasDay) {
+    return;
+  }
+  fixedWidthPieces_ = std::move(pieces);
+  fixedWidthSize_ = offset;
+}
+
+std::optional<DateTimeResult> DateTimeFormatter::tryParseFixedWidth(
+    const std::string_view& input) const {
+  if (input.size() != fixedWidthSize_) {
+    return std::nullopt;
+  }
+  int32_t year = 0;
+  int32_t month = 0;
+  int32_t day = 0;
+  int32_t hour = 0;
+  int32_t minute = 0;
+  int32_t second = 0;
+  int32_t millisecond = 0;
+  for (const auto& piece : fixedWidthPieces_) {
+    const char* cur = input.data() + piece.offset;
+    if (!piece.literal.empty()) {
+      if (std::memcmp(cur, piece.literal.data(), piece.literal.size()) != 0) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    int32_t number = 0;
+    for (auto i = 0; i < piece.width; ++i) {
+      if (!characterIsDigit(cur[i])) {
+        return std::nullopt;
+      }
+      number = number * 10 + (cur[i] - '0');
+    }
+    switch (piece.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        year = number;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        month = number;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        day = number;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        hour = number;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        minute = number;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        second = number;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        millisecond = number;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  if (hour > 23 || minute > 59 || second > 59 ||
+      !util::isValidDate(year, month, day)) {
+    return std::nullopt;
+  }
+  const auto daysSinceEpoch = util::daysSinceEpochFromDate(year, month, day);
+  if (daysSinceEpoch.hasError()) {
+    return std::nullopt;
+  }
+  return DateTimeResult{
+      util::fromDatetime(
+          daysSinceEpoch.value(),
+          util::fromTime(
+              hour, minute, second, millisecond * util::kMicrosPerMsec)),
+      nullptr};
+}
+
 Expected<DateTimeResult> DateTimeFormatter::parse(
     const std::string_view& input) const {
+  if (fixedWidthSize_ > 0) {
+    if (auto result = tryParseFixedWidth(input)) {
+      return result.value();
+    }
+  }
+
   Date date;
   const char* cur = input.data();
   const char* end = cur + input.size();
@@ -1682,7 +1850,44 @@ Expected<DateTimeResult> DateTimeFormatter::parse(
       date.timezone};
 }
 
-Expected<std::shared_ptr<DateTimeFormatter>> buildMysqlDateTimeFormatter(
+namespace {
+
+// Upper bound of the formatters cached per thread and formatter type. The
+// cache is cleared when it grows past this, e.g. for a column of distinct
+// format strings.
+constexpr size_t kMaxCachedFormatters = 256;
+
+using FormatterCache =
+    folly::F14FastMap<std::string, std::shared_ptr<DateTimeFormatter>>;
+
+// Returns the formatter for 'format' from the cache of the calling thread or
+// builds and caches it. Formatters are immutable after build, so callers may
+// share them. Errors are not cached.
+template <typename Build>
+Expected<std::shared_ptr<DateTimeFormatter>> cachedFormatter(
+    DateTimeFormatterType type,
+    const std::string_view& format,
+    Build build) {
+  thread_local std::array<
+      FormatterCache,
+      static_cast<size_t>(DateTimeFormatterType::UNKNOWN)>
+      caches;
+  auto& cache = caches[static_cast<size_t>(type)];
+  auto it = cache.find(format);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  auto formatter = build();
+  if (formatter.hasValue()) {
+    if (cache.size() >= kMaxCachedFormatters) {
+      cache.clear();
+    }
+    cache.emplace(format, formatter.value());
+  }
+  return formatter;
+}
+
+Expected<std::shared_ptr<DateTimeFormatter>> buildMysqlFormatter(
     const std::string_view& format) {
   if (format.empty()) {
     if (threadSkipErrorDetails()) {
@@ -1819,7 +2024,7 @@ Expected<std::shared_ptr<DateTimeFormatter>> buildMysqlDateTimeFormatter(
   return builder.setType(DateTimeFormatterType::MYSQL).build();
 }
 
-Expected<std::shared_ptr<DateTimeFormatter>> buildJodaDateTimeFormatter(
+Expected<std::shared_ptr<DateTimeFormatter>> buildJodaFormatter(
     const std::string_view& format) {
   if (format.empty()) {
     if (threadSkipErrorDetails()) {
@@ -1953,7 +2158,7 @@ Expected<std::shared_ptr<DateTimeFormatter>> buildJodaDateTimeFormatter(
   return builder.setType(DateTimeFormatterType::JODA).build();
 }
 
-Expected<std::shared_ptr<DateTimeFormatter>> buildSimpleDateTimeFormatter(
+Expected<std::shared_ptr<DateTimeFormatter>> buildSimpleFormatter(
     const std::string_view& format,
     bool lenient) {
   if (format.empty()) {
@@ -2098,4 +2303,30 @@ Expected<std::shared_ptr<DateTimeFormatter>> buildSimpleDateTimeFormatter(
   return builder.setType(type).build();
 }
 
+} // namespace
+
+Expected<std::shared_ptr<DateTimeFormatter>> buildMysqlDateTimeFormatter(
+    const std::string_view& format) {
+  return cachedFormatter(DateTimeFormatterType::MYSQL, format, [&]() {
+    return buildMysqlFormatter(format);
+  });
+}
+
+Expected<std::shared_ptr<DateTimeFormatter>> buildJodaDateTimeFormatter(
+    const std::string_view& format) {
+  return cachedFormatter(DateTimeFormatterType::JODA, format, [&]() {
+    return buildJodaFormatter(format);
+  });
+}
+
+Expected<std::shared_ptr<DateTimeFormatter>> buildSimpleDateTimeFormatter(
+    const std::string_view& format,
+    bool lenient) {
+  return cachedFormatter(
+      lenient ? DateTimeFormatterType::LENIENT_SIMPLE
+              : DateTimeFormatterType::STRICT_SIMPLE,
+      format,
+      [&]() { return buildSimpleFormatter(format, lenient); });
+}
+
 } // namespace facebook::velox::functions
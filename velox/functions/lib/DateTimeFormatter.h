@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "velox/common/base/Exceptions.h"
@@ -192,7 +193,9 @@ class DateTimeFormatter {
       : literalBuf_(std::move(literalBuf)),
         bufSize_(bufSize),
         tokens_(std::move(tokens)),
-        type_(type) {}
+        type_(type) {
+    initFixedWidthLayout();
+  }
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -211,6 +214,14 @@ class DateTimeFormatter {
   // Returns Unexpected with UserError status if parsing failed.
   Expected<DateTimeResult> parse(const std::string_view& input) const;
 
+  /// Returns true if the format is made of fixed width year, month, day and
+  /// optionally hour, minute, second and millisecond fields separated by
+  /// literals, like 'yyyy-MM-dd HH:mm:ss.SSS'. parse() reads inputs of that
+  /// exact layout without the general per token parsing.
+  bool hasFixedWidthLayout() const {
+    return fixedWidthSize_ > 0;
+  }
+
   /// Returns max size of the formatted string. Can be used to preallocate
   /// memory before calling format() to avoid extra copy.
   uint32_t maxResultSize(const tz::TimeZone* timezone) const;
@@ -233,10 +244,33 @@ class DateTimeFormatter {
       const std::optional<std::string>& zeroOffsetText = std::nullopt) const;
 
  private:
+  // A piece of the fixed width layout: a literal if 'literal' is not empty,
+  // else a numeric field of 'width' digits.
+  struct FixedWidthPiece {
+    DateTimeFormatSpecifier specifier;
+    int32_t offset;
+    int32_t width;
+    std::string_view literal;
+  };
+
+  // Sets 'fixedWidthPieces_' and 'fixedWidthSize_' if 'tokens_' have a fixed
+  // width layout. See hasFixedWidthLayout().
+  void initFixedWidthLayout();
+
+  // Parses an input in the fixed width layout. Returns std::nullopt if
+  // 'input' does not have the layout or a field is out of range, so that the
+  // general path parses it or reports the error.
+  std::optional<DateTimeResult> tryParseFixedWidth(
+      const std::string_view& input) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+
+  std::vector<FixedWidthPiece> fixedWidthPieces_;
+  // Size of an input in the fixed width layout, 0 if there is no such layout.
+  int32_t fixedWidthSize_{0};
 };
 
 Expected<std::shared_ptr<DateTimeFormatter>> buildMysqlDateTimeFormatter(
@@ -123,6 +123,23 @@ struct HllAccumulator {
     }
   }
 
+  /// Inserts 'size' hashes. Hashes inserted after the conversion to the dense
+  /// layout are added in batches.
+  void insertHashes(const uint64_t* hashes, int32_t size) {
+    int32_t i = 0;
+    if (isSparse_) {
+      while (i < size) {
+        if (sparseHll_.insertHash(hashes[i++])) {
+          toDense();
+          break;
+        }
+      }
+    }
+    if (i < size) {
+      denseHll_.insertHashes(hashes + i, size - i);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -138,8 +155,16 @@ struct HllAccumulator {
       SparseHll<TAllocator> other{input, allocator};
       mergeWithSparse(other);
     } else if (DenseHlls::canDeserialize(input)) {
-      DenseHll<TAllocator> other{input, allocator};
-      mergeWithDense(other);
+      // Merges the serialized registers directly without copying them into a
+      // DenseHll first.
+      if (isSparse_) {
+        toDense();
+      }
+      VELOX_USER_CHECK_EQ(
+          indexBitLength_,
+          DenseHlls::deserializeIndexBitLength(input),
+          "Cannot merge HLLs with different number of buckets");
+      denseHll_.mergeWith(input);
     } else {
       VELOX_USER_FAIL("Unexpected type of HLL");
     }
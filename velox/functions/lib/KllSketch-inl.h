@@ -307,6 +307,48 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(folly::Range<const T*> values) {
+  if (values.empty()) {
+    return;
+  }
+  if (n_ == 0) {
+    minValue_ = maxValue_ = values[0];
+  }
+  for (auto value : values) {
+    minValue_ = std::min(minValue_, value, C());
+    maxValue_ = std::max(maxValue_, value, C());
+  }
+
+  size_t i = 0;
+  while (i < values.size()) {
+    const size_t remaining = values.size() - i;
+    if (items_.size() < k_ && numLevels() == 1) {
+      const auto count = std::min<size_t>(k_ - items_.size(), remaining);
+      items_.insert(
+          items_.end(), values.begin() + i, values.begin() + i + count);
+      levels_[1] += count;
+      n_ += count;
+      i += count;
+      isLevelZeroSorted_ = false;
+    } else if (levels_[0] > 0) {
+      // Fills the free space below level zero at the same positions as
+      // inserting the values one at a time.
+      const auto count = std::min<size_t>(levels_[0], remaining);
+      for (size_t j = 0; j < count; ++j) {
+        items_[levels_[0] - 1 - j] = values[i + j];
+      }
+      levels_[0] -= count;
+      n_ += count;
+      i += count;
+      isLevelZeroSorted_ = false;
+    } else {
+      // Level zero is full. Compacts it to make room.
+      doInsert(values[i++]);
+    }
+  }
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
@@ -82,6 +82,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add a batch of values to the sketch. Same result as calling insert() for
+  /// each value in order, but copies the values into level zero in bulk and
+  /// compacts only when it is full.
+  void insert(folly::Range<const T*> values);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
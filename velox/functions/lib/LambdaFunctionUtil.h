@@ -44,14 +44,15 @@ vector_size_t countElements(
 
 // Returns an array of indices that allows aligning captures with the nested
 // elements of an array or vector. For each top-level row, the index equal to
-// the row number is repeated for each of the nested rows.
+// the row number is repeated for each of the nested rows. Returns nullptr if
+// the captures are all constant, since these need no mapping.
 template <typename T>
 BufferPtr toWrapCapture(
     vector_size_t size,
     const Callable* callable,
     const SelectivityVector& topLevelRows,
     const std::shared_ptr<T>& topLevelVector) {
-  if (!callable->hasCapture()) {
+  if (!callable->hasNonConstantCapture()) {
     return nullptr;
   }
 
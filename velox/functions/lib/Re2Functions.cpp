@@ -14,6 +14,11 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+
+#include <re2/set.h>
+
+#include "velox/expression/ExprConstants.h"
+#include "velox/expression/ExprUtils.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -2452,4 +2457,240 @@ regexpReplaceWithLambdaSignatures() {
               .argumentType("function(array(varchar), varchar)")
               .build()};
 }
+
+namespace {
+
+// Matches a string against a set of constant patterns in one pass.
+class Re2SearchAny final : public exec::VectorFunction {
+ public:
+  explicit Re2SearchAny(const std::vector<std::string>& patterns)
+      : set_(RE2::Options(RE2::Quiet), RE2::UNANCHORED) {
+    std::string error;
+    for (const auto& pattern : patterns) {
+      VELOX_USER_CHECK_GE(
+          set_.Add(toStringPiece(pattern), &error),
+          0,
+          "invalid regular expression:{}",
+          error);
+    }
+    VELOX_USER_CHECK(
+        set_.Compile(),
+        "Out of memory compiling {} regular expressions",
+        patterns.size());
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+      const auto str = toSearch->valueAt<StringView>(i);
+      result.set(i, set_.Match(toStringPiece(str), nullptr));
+    });
+  }
+
+ private:
+  RE2::Set set_;
+};
+
+// Returns the value of a non-null VARCHAR constant.
+std::optional<std::string> constantString(const core::TypedExprPtr& expr) {
+  if (!expr->isConstantKind() || !expr->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  const auto* constant = expr->asUnchecked<core::ConstantTypedExpr>();
+  if (constant->isNull()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    return std::string(constant->valueVector()
+                           ->as<SimpleVector<StringView>>()
+                           ->valueAt(0));
+  }
+  return constant->value().value<std::string>();
+}
+
+// Appends to 'patterns' the regular expressions that 'call' matches its first
+// argument against. Returns false if 'call' is not a search, LIKE or search
+// any call with valid constant patterns.
+bool appendSearchPatterns(
+    const core::CallTypedExpr& call,
+    const Re2SearchAnyNames& names,
+    std::vector<std::string>& patterns) {
+  const auto& inputs = call.inputs();
+  if (call.name() == names.searchAny) {
+    for (auto i = 1; i < inputs.size(); ++i) {
+      patterns.push_back(constantString(inputs[i]).value());
+    }
+    return true;
+  }
+  if (call.name() == names.search && inputs.size() == 2) {
+    auto pattern = constantString(inputs[1]);
+    if (!pattern.has_value() || !RE2(*pattern, RE2::Quiet).ok()) {
+      return false;
+    }
+    patterns.push_back(std::move(pattern.value()));
+    return true;
+  }
+  if (call.name() == names.like &&
+      (inputs.size() == 2 || inputs.size() == 3)) {
+    auto pattern = constantString(inputs[1]);
+    if (!pattern.has_value()) {
+      return false;
+    }
+    std::optional<char> escapeChar;
+    if (inputs.size() == 3) {
+      const auto escape = constantString(inputs[2]);
+      if (!escape.has_value() || escape->size() != 1) {
+        return false;
+      }
+      escapeChar = escape->front();
+    }
+    bool validPattern;
+    auto regex =
+        likePatternToRe2(StringView(pattern.value()), escapeChar, validPattern);
+    if (!validPattern) {
+      return false;
+    }
+    // LIKE wildcards match new lines.
+    patterns.push_back(fmt::format("(?s:{})", regex));
+    return true;
+  }
+  return false;
+}
+
+// Returns true if RE2::Set can compile 'patterns' within its memory budget.
+bool canCompileSet(const std::vector<std::string>& patterns) {
+  RE2::Set set(RE2::Options(RE2::Quiet), RE2::UNANCHORED);
+  for (const auto& pattern : patterns) {
+    if (set.Add(toStringPiece(pattern), nullptr) < 0) {
+      return false;
+    }
+  }
+  return set.Compile();
+}
+
+} // namespace
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /* config */) {
+  VELOX_USER_CHECK_GE(
+      inputArgs.size(), 2, "{} requires at least one pattern", name);
+  std::vector<std::string> patterns;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto* constantPattern = inputArgs[i].constantValue.get();
+    VELOX_USER_CHECK(
+        constantPattern != nullptr && !constantPattern->isNullAt(0),
+        "{} requires non-null constant patterns",
+        name);
+    patterns.emplace_back(
+        constantPattern->as<ConstantVector<StringView>>()->valueAt(0));
+  }
+  return std::make_shared<Re2SearchAny>(patterns);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchAnySignatures() {
+  // varchar, varchar... -> boolean
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varchar")
+              .constantArgumentType("varchar")
+              .variableArity("varchar")
+              .build()};
+}
+
+core::TypedExprPtr rewriteRe2SearchDisjunction(
+    const core::TypedExprPtr& expr,
+    const Re2SearchAnyNames& names) {
+  if (!expr->isCallKind() ||
+      expr->asUnchecked<core::CallTypedExpr>()->name() != expression::kOr) {
+    return nullptr;
+  }
+
+  std::vector<core::TypedExprPtr> disjuncts;
+  expression::utils::flattenInput(expr, expression::kOr, disjuncts);
+
+  // The disjuncts that can be merged, grouped by the searched string. Each
+  // group is merged into its first disjunct.
+  struct Group {
+    core::TypedExprPtr input;
+    size_t first;
+    int32_t numCalls{0};
+    std::vector<std::string> patterns;
+  };
+  std::vector<Group> groups;
+  std::vector<int32_t> disjunctGroups(disjuncts.size(), -1);
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    if (!disjuncts[i]->isCallKind()) {
+      continue;
+    }
+    const auto* call = disjuncts[i]->asUnchecked<core::CallTypedExpr>();
+    if (call->inputs().empty()) {
+      continue;
+    }
+    const auto& input = call->inputs()[0];
+    auto it = std::find_if(groups.begin(), groups.end(), [&](const auto& g) {
+      return *g.input == *input;
+    });
+    std::vector<std::string> patterns;
+    if (!appendSearchPatterns(*call, names, patterns)) {
+      continue;
+    }
+    if (it == groups.end()) {
+      groups.push_back({input, static_cast<size_t>(i)});
+      it = groups.end() - 1;
+    }
+    ++it->numCalls;
+    it->patterns.insert(
+        it->patterns.end(),
+        std::make_move_iterator(patterns.begin()),
+        std::make_move_iterator(patterns.end()));
+    disjunctGroups[i] = it - groups.begin();
+  }
+
+  bool merged = false;
+  for (auto& group : groups) {
+    if (group.numCalls >= 2) {
+      if (canCompileSet(group.patterns)) {
+        merged = true;
+      } else {
+        group.numCalls = 0;
+      }
+    }
+  }
+  if (!merged) {
+    return nullptr;
+  }
+
+  std::vector<core::TypedExprPtr> newDisjuncts;
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    const auto groupIndex = disjunctGroups[i];
+    if (groupIndex < 0 || groups[groupIndex].numCalls < 2) {
+      newDisjuncts.push_back(disjuncts[i]);
+      continue;
+    }
+    const auto& group = groups[groupIndex];
+    if (group.first != i) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{group.input};
+    for (const auto& pattern : group.patterns) {
+      inputs.push_back(
+          std::make_shared<core::ConstantTypedExpr>(VARCHAR(), pattern));
+    }
+    newDisjuncts.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(), std::move(inputs), names.searchAny));
+  }
+  if (newDisjuncts.size() == 1) {
+    return newDisjuncts.front();
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      expr->type(), std::move(newDisjuncts), expression::kOr);
+}
 } // namespace facebook::velox::functions
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include <re2/re2.h>
+#include "velox/core/Expressions.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/Udf.h"
 #include "velox/vector/BaseVector.h"
@@ -186,6 +187,41 @@ std::shared_ptr<exec::VectorFunction> makeRe2Search(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures();
 
+/// re2SearchAny(string, pattern1, pattern2, ...) → bool
+///
+/// Returns whether str has a substr that matches any of the constant regex
+/// patterns. Matches all the patterns in one pass over str with RE2::Set.
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchAnySignatures();
+
+/// Names of the functions rewriteRe2SearchDisjunction() merges.
+struct Re2SearchAnyNames {
+  /// The function registered with makeRe2Search, e.g. regexp_like.
+  std::string search;
+  /// The function registered with makeLike.
+  std::string like;
+  /// The function registered with makeRe2SearchAny.
+  std::string searchAny;
+};
+
+/// Rewrites an OR of search and LIKE calls with constant patterns over the
+/// same string into one search any call, e.g.
+///
+///   regexp_like(s, 'a.c') OR s LIKE '%xy%' OR s LIKE 'z%'
+///     -> search_any(s, 'a.c', '(?s:^.*xy.*$)', '(?s:^z.*$)')
+///
+/// The string is then scanned once instead of once per pattern. The other
+/// disjuncts stay as they are. Calls with invalid or non-constant patterns are
+/// not merged, so that they report their errors as before. Returns nullptr if
+/// no two calls could be merged. To be registered with ExprRewriteRegistry.
+core::TypedExprPtr rewriteRe2SearchDisjunction(
+    const core::TypedExprPtr& expr,
+    const Re2SearchAnyNames& names);
+
 /// re2Extract(string, pattern, group_id) → string
 /// re2Extract(string, pattern) → string
 ///
@@ -38,6 +38,16 @@ inline bool isPrimitiveEqual(const T& lhs, const T& rhs) {
   }
 }
 
+// Orders like BaseVector::compare() orders the keys of maps with sorted keys.
+template <typename T>
+inline bool isPrimitiveLess(const T& lhs, const T& rhs) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return util::floating_point::NaNAwareLessThan<T>{}(lhs, rhs);
+  } else {
+    return lhs < rhs;
+  }
+}
+
 template <TypeKind Kind>
 struct SimpleType {
   using type = typename TypeTraits<Kind>::NativeType;
@@ -65,6 +75,8 @@ VectorPtr applyMapTyped(
     const VectorPtr& indexArg,
     exec::EvalCtx& context) {
   static constexpr vector_size_t kMinCachedMapSize = 100;
+  // Minimum size of a map with sorted keys for a binary search of the key.
+  static constexpr vector_size_t kMinBinarySearchMapSize = 16;
   using TKey = typename TypeTraits<kind>::NativeType;
 
   detail::LookupTable<TKey>* typedLookupTable = nullptr;
@@ -102,6 +114,7 @@ VectorPtr applyMapTyped(
 
   auto rawSizes = baseMap->rawSizes();
   auto rawOffsets = baseMap->rawOffsets();
+  const bool sortedKeys = baseMap->hasSortedKeys();
 
   // Lambda that does the search for a key, for each row.
   auto processRow = [&](vector_size_t row, TKey searchKey) {
@@ -133,6 +146,25 @@ VectorPtr applyMapTyped(
         found = true;
       }
 
+    } else if (sortedKeys && size >= kMinBinarySearchMapSize) {
+      // The keys of each map are in ascending order.
+      auto low = offsetStart;
+      auto high = offsetEnd;
+      while (low < high) {
+        const auto middle = low + (high - low) / 2;
+        if (isPrimitiveLess<TKey>(
+                decodedMapKeys->valueAt<TKey>(middle), searchKey)) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      if (low < offsetEnd &&
+          isPrimitiveEqual<TKey>(
+              decodedMapKeys->valueAt<TKey>(low), searchKey)) {
+        rawIndices[row] = low;
+        found = true;
+      }
     } else {
       // Search map without caching.
       for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
@@ -185,68 +217,81 @@ VectorPtr applyMapTyped(
       true /*flattenIfRedundant*/);
 }
 
-/// Applies logic to vectors of FlatMapVector encoding. The implementation is
-/// far simpler than the regular map encoding because FlatMapVector already
-/// supports feature projection. This implementation will serve as a fast-path
-/// execution for now-wrapped vectors.
-VectorPtr applyFlatMap(
+/// Returns the map values for key 'channel' of the FlatMapVector under
+/// 'decodedMap' at 'rows'. Rows where the key is not in the map are null. This
+/// is a zero-copy projection that reads one index and one in-map bit per row.
+VectorPtr projectFlatMapKey(
     const SelectivityVector& rows,
     const DecodedVector& decodedMap,
-    const VectorPtr& elementAt,
+    const FlatMapVector& flatMap,
+    column_index_t channel,
     exec::EvalCtx& context) {
-  // Decode input flat map vector.
-  auto flatMap = decodedMap.base()->as<FlatMapVector>();
-
-  // Optimal use case: unwrapped vector and constant key. We can simply project
-  // the feature using the first value in the arg vector.
-  if (decodedMap.isIdentityMapping() && elementAt->isConstantEncoding()) {
-    if (auto projection = flatMap->projectKey(elementAt, 0)) {
-      return projection;
-    }
+  const auto& values = flatMap.mapValuesAt(channel);
+  if (values == nullptr) {
+    return BaseVector::createNullConstant(
+        flatMap.valueType(), rows.end(), context.pool());
+  }
+  const uint64_t* inMap = nullptr;
+  if (channel < flatMap.inMaps().size() && flatMap.inMaps()[channel]) {
+    inMap = flatMap.inMaps()[channel]->as<uint64_t>();
+  }
+  if (decodedMap.isIdentityMapping() && inMap == nullptr) {
+    return values;
   }
 
-  // Next base case: wrapped vector and constant key. In this scenario we just
-  // need to decode and simply project onto the first index again.
-  else if (elementAt->isConstantEncoding()) {
-    // Define nulls and indices buffers.
-    BufferPtr indices =
-        AlignedBuffer::allocate<vector_size_t>(rows.size(), flatMap->pool());
-    BufferPtr nulls = allocateNulls(rows.size(), flatMap->pool());
-    auto mutableIndices = indices->asMutable<vector_size_t>();
-    auto rawNulls = nulls->asMutable<uint64_t>();
-    for (int i = 0; i < decodedMap.size(); i++) {
-      mutableIndices[i] = decodedMap.indices()[i];
-      if (decodedMap.isNullAt(i)) {
-        bits::setNull(rawNulls, i, true);
-      }
+  auto* pool = context.pool();
+  BufferPtr indices = allocateIndices(rows.end(), pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  NullsBuilder nullsBuilder(rows.end(), pool);
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto index = decodedMap.index(row);
+    rawIndices[row] = index;
+    if (inMap != nullptr && !bits::isBitSet(inMap, index)) {
+      nullsBuilder.setNull(row);
     }
+  });
+  return BaseVector::wrapInDictionary(
+      nullsBuilder.build(), std::move(indices), rows.end(), values);
+}
 
-    if (auto projection = flatMap->projectKey(elementAt, 0)) {
-      // Wrap underlying projected feature stream. This will also help with
-      // memory pressure for large feature element vectors.
-      return BaseVector::wrapInDictionary(
-          std::move(nulls), indices, rows.end(), projection);
+/// Applies logic to vectors of FlatMapVector encoding. The implementation is
+/// far simpler than the regular map encoding because FlatMapVector already
+/// supports feature projection, so no map is ever materialized.
+VectorPtr applyFlatMap(
+    const SelectivityVector& rows,
+    const DecodedVector& decodedMap,
+    const VectorPtr& elementAt,
+    exec::EvalCtx& context) {
+  auto* flatMap = decodedMap.base()->as<FlatMapVector>();
+
+  // Optimal use case: constant key. The key is looked up once and the result
+  // is a projection of its map values.
+  if (elementAt->isConstantEncoding()) {
+    if (auto channel = flatMap->getKeyChannel(elementAt, 0)) {
+      return projectFlatMapKey(
+          rows, decodedMap, *flatMap, channel.value(), context);
     }
+    // Key doesn't exist, return null constant vector.
+    return BaseVector::createNullConstant(
+        flatMap->valueType(), rows.end(), context.pool());
   }
 
   // In the case that elementAt is not constant, we will need to stitch together
   // projected values from across our mapValues list.
-  else {
-    auto result =
-        BaseVector::create(flatMap->valueType(), rows.size(), context.pool());
-    rows.applyToSelected([&](vector_size_t row) {
-      if (auto projection = flatMap->projectKey(elementAt, row)) {
-        result->copy(projection.get(), row, decodedMap.indices()[row], 1);
-      } else {
-        result->setNull(row, true);
-      }
-    });
-    return result;
-  }
-
-  // Key doesn't exist, return null constant vector.
-  return BaseVector::createNullConstant(
-      flatMap->valueType(), rows.end(), context.pool());
+  auto result =
+      BaseVector::create(flatMap->valueType(), rows.end(), context.pool());
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto index = decodedMap.index(row);
+    const auto channel = flatMap->getKeyChannel(elementAt, row);
+    if (channel.has_value() && flatMap->isInMap(channel.value(), index) &&
+        flatMap->mapValuesAt(channel.value()) != nullptr) {
+      result->copy(
+          flatMap->mapValuesAt(channel.value()).get(), row, index, 1);
+    } else {
+      result->setNull(row, true);
+    }
+  });
+  return result;
 }
 
 VectorPtr applyMapComplexType(
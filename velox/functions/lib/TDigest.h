@@ -20,6 +20,7 @@
 #include "velox/common/base/Portability.h"
 
 #include <folly/Bits.h>
+#include <folly/Range.h>
 
 #include <numeric>
 
@@ -70,6 +71,14 @@ class TDigest {
   ///  be added.
   void add(std::vector<int16_t>& positions, double value, int64_t weight = 1);
 
+  /// Add a batch of values with weight 1 to the digest. Same result as calling
+  /// add() for each value in order, but appends the values to the buffer in
+  /// bulk and merges it only when it is full.
+  ///
+  /// @param positions Scratch memory, see add().
+  /// @param values The new values to be added.  Cannot be NaN.
+  void add(std::vector<int16_t>& positions, folly::Range<const double*> values);
+
   /// Compress the buffered values according to the compression parameter
   /// provided.  Must be called before doing any estimation or serialization.
   ///
@@ -229,6 +238,32 @@ void TDigest<A>::add(
   }
 }
 
+template <typename A>
+void TDigest<A>::add(
+    std::vector<int16_t>& positions,
+    folly::Range<const double*> values) {
+  size_t i = 0;
+  while (i < values.size()) {
+    const auto count = std::min<size_t>(
+        values.size() - i,
+        std::max<int64_t>(
+            1,
+            static_cast<int64_t>(maxBufferSize_) -
+                static_cast<int64_t>(size())));
+    for (size_t j = i; j < i + count; ++j) {
+      VELOX_CHECK(!std::isnan(values[j]));
+      min_ = std::min(min_, values[j]);
+      max_ = std::max(max_, values[j]);
+    }
+    weights_.insert(weights_.end(), count, 1);
+    means_.insert(means_.end(), values.begin() + i, values.begin() + i + count);
+    i += count;
+    if (weights_.size() >= maxBufferSize_) {
+      mergeNewValues(positions, 2 * compression_);
+    }
+  }
+}
+
 template <typename A>
 void TDigest<A>::compress(std::vector<int16_t>& positions) {
   if (!weights_.empty()) {
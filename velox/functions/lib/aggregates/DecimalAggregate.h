@@ -138,10 +138,9 @@ class DecimalAggregate : public exec::Aggregate {
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
+      DecimalUtil::BatchSum batchSum;
+      rows.applyToSelected([&](vector_size_t i) { batchSum.add(data[i]); });
+      batchSum.finish(accumulator.sum, accumulator.overflow);
       accumulator.count = rows.countSelected();
       std::vector<char> rawData(LongDecimalWithOverflowState::serializedSize());
       StringView serialized(
@@ -150,12 +149,11 @@ class DecimalAggregate : public exec::Aggregate {
       mergeAccumulators<false>(group, serialized);
     } else {
       LongDecimalWithOverflowState accumulator;
+      DecimalUtil::BatchSum batchSum;
       rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum,
-            decodedRaw_.valueAt<TInputType>(i),
-            accumulator.sum);
+        batchSum.add(decodedRaw_.valueAt<TInputType>(i));
       });
+      batchSum.finish(accumulator.sum, accumulator.overflow);
       accumulator.count = rows.countSelected();
       std::vector<char> rawData(LongDecimalWithOverflowState::serializedSize());
       StringView serialized(
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
+
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/functions/lib/CheckNestedNulls.h"
@@ -306,6 +308,11 @@ class MinMaxByAggregateBase : public exec::Aggregate {
       return;
     }
 
+    if constexpr (kDeferValueCopies) {
+      addRawInputDeferValueCopies(groups, rows, mayUpdate);
+      return;
+    }
+
     const auto* indices = decodedComparison_.indices();
     if (decodedValue_.mayHaveNulls() || decodedComparison_.mayHaveNulls()) {
       rows.applyToSelected([&](vector_size_t i) {
@@ -409,6 +416,13 @@ class MinMaxByAggregateBase : public exec::Aggregate {
       return;
     }
 
+    if constexpr (!std::is_same_v<
+                      ComparisonAccumulatorType,
+                      SingleValueAccumulator>) {
+      addSingleGroupRawInputBestRow(group, rows, mayUpdate);
+      return;
+    }
+
     const auto* indices = decodedComparison_.indices();
     if (decodedValue_.mayHaveNulls() || decodedComparison_.mayHaveNulls()) {
       rows.applyToSelected([&](vector_size_t i) {
@@ -538,6 +552,81 @@ class MinMaxByAggregateBase : public exec::Aggregate {
   }
 
  private:
+  // True if grouped raw input updates the comparison values of the groups
+  // first and copies the non-numeric value of each updated group once per
+  // batch. Only used with numeric comparison values, which have no nested
+  // nulls.
+  static constexpr bool kDeferValueCopies =
+      std::is_same_v<ValueAccumulatorType, SingleValueAccumulator> &&
+      !std::is_same_v<ComparisonAccumulatorType, SingleValueAccumulator>;
+
+  // Finds the row of the batch that wins the comparison using a local
+  // accumulator and then updates 'group' from this row only. Rows that replace
+  // an earlier row of the batch no longer store their values into 'group'.
+  template <typename MayUpdate>
+  void addSingleGroupRawInputBestRow(
+      char* group,
+      const SelectivityVector& rows,
+      MayUpdate mayUpdate) {
+    ComparisonAccumulatorType best{};
+    vector_size_t bestRow = -1;
+    rows.applyToSelected([&](vector_size_t i) {
+      if (decodedComparison_.isNullAt(i)) {
+        return;
+      }
+      if (mayUpdate(&best, decodedComparison_, i, bestRow < 0)) {
+        best = decodedComparison_.valueAt<U>(i);
+        bestRow = i;
+      }
+    });
+    if (bestRow >= 0) {
+      updateValues(
+          group,
+          decodedValue_,
+          decodedComparison_,
+          bestRow,
+          decodedValue_.isNullAt(bestRow),
+          mayUpdate);
+    }
+  }
+
+  // Updates the comparison values of 'groups' and remembers the rows that
+  // replaced them. Then copies the value of the last such row of each group,
+  // which is the winner of the batch.
+  template <typename MayUpdate>
+  void addRawInputDeferValueCopies(
+      char** groups,
+      const SelectivityVector& rows,
+      MayUpdate mayUpdate) {
+    updatedGroups_.clear();
+    rows.applyToSelected([&](vector_size_t i) {
+      if (decodedComparison_.isNullAt(i)) {
+        return;
+      }
+      auto* group = groups[i];
+      const auto isFirstValue = isNull(group);
+      clearNull(group);
+      if (mayUpdate(
+              comparisonValue(group), decodedComparison_, i, isFirstValue)) {
+        store<U>(comparisonValue(group), decodedComparison_, i, allocator_);
+        updatedGroups_.emplace_back(group, i);
+      }
+    });
+
+    copiedGroups_.clear();
+    for (auto it = updatedGroups_.rbegin(); it != updatedGroups_.rend(); ++it) {
+      auto [group, row] = *it;
+      if (!copiedGroups_.insert(group).second) {
+        continue;
+      }
+      const auto isValueNull = decodedValue_.isNullAt(row);
+      valueIsNull(group) = isValueNull;
+      if (LIKELY(!isValueNull)) {
+        store<T>(value(group), decodedValue_, row, allocator_);
+      }
+    }
+  }
+
   template <typename MayUpdate>
   inline void updateValues(
       char* group,
@@ -577,6 +666,11 @@ class MinMaxByAggregateBase : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedComparison_;
   DecodedVector decodedIntermediateResult_;
+
+  // Groups updated by the current batch of raw input and the rows that updated
+  // them, in row order. Used if 'kDeferValueCopies' is true.
+  std::vector<std::pair<char*, vector_size_t>> updatedGroups_;
+  folly::F14FastSet<char*> copiedGroups_;
 };
 
 template <
@@ -17,6 +17,11 @@
 #include "velox/exec/ContainerRowSerde.h"
 
 namespace facebook::velox::aggregate {
+namespace {
+// Set isKey to false to avoid unnecessary sorting.
+const exec::ContainerRowSerdeOptions kSerdeOptions{/*isKey=*/false};
+} // namespace
+
 void ValueList::prepareAppend(HashStringAllocator* allocator) {
   if (!nullsBegin_) {
     nullsBegin_ = allocator->allocate(HashStringAllocator::kMinAlloc);
@@ -65,9 +70,7 @@ void ValueList::appendNonNull(
   allocator->extendWrite(dataCurrent_, stream);
   // The stream may have a tail of a previous write.
   const auto initialSize = stream.size();
-  // Set isKey to false to avoid unnecessary sorting.
-  static const exec::ContainerRowSerdeOptions kOptions{/*isKey=*/false};
-  exec::ContainerRowSerde::serialize(values, index, stream, kOptions);
+  exec::ContainerRowSerde::serialize(values, index, stream, kSerdeOptions);
   ++size_;
   bytes_ += stream.size() - initialSize;
 
@@ -89,18 +92,70 @@ void ValueList::appendValue(
   }
 }
 
+template <typename IsNull, typename Serialize>
+void ValueList::appendBatch(
+    vector_size_t numValues,
+    IsNull isNull,
+    Serialize serialize,
+    HashStringAllocator* allocator) {
+  // The null flags are written to their own allocation, so they are set before
+  // starting the write of the values.
+  bool hasNonNull = false;
+  for (auto i = 0; i < numValues; ++i) {
+    prepareAppend(allocator);
+    if (isNull(i)) {
+      lastNulls_ |= 1UL << (size_ % 64);
+    } else {
+      hasNonNull = true;
+    }
+    ++size_;
+  }
+  if (!hasNonNull) {
+    return;
+  }
+
+  ByteOutputStream stream(allocator);
+  allocator->extendWrite(dataCurrent_, stream);
+  // The stream may have a tail of a previous write.
+  const auto initialSize = stream.size();
+  for (auto i = 0; i < numValues; ++i) {
+    if (!isNull(i)) {
+      serialize(stream, i);
+    }
+  }
+  bytes_ += stream.size() - initialSize;
+  dataCurrent_ =
+      allocator->finishWrite(stream, std::clamp(bytes_ / 2, 24, 1024)).second;
+}
+
+void ValueList::appendValues(
+    const DecodedVector& decoded,
+    folly::Range<const vector_size_t*> rows,
+    HashStringAllocator* allocator) {
+  const auto& base = *decoded.base();
+  appendBatch(
+      rows.size(),
+      [&](auto i) { return decoded.isNullAt(rows[i]); },
+      [&](auto& stream, auto i) {
+        exec::ContainerRowSerde::serialize(
+            base, decoded.index(rows[i]), stream, kSerdeOptions);
+      },
+      allocator);
+}
+
 void ValueList::appendRange(
     const VectorPtr& vector,
     vector_size_t offset,
     vector_size_t size,
     HashStringAllocator* allocator) {
-  for (auto index = offset; index < offset + size; ++index) {
-    if (vector->isNullAt(index)) {
-      appendNull(allocator);
-    } else {
-      appendNonNull(*vector, index, allocator);
-    }
-  }
+  appendBatch(
+      size,
+      [&](auto i) { return vector->isNullAt(offset + i); },
+      [&](auto& stream, auto i) {
+        exec::ContainerRowSerde::serialize(
+            *vector, offset + i, stream, kSerdeOptions);
+      },
+      allocator);
 }
 
 ValueListReader::ValueListReader(ValueList& values)
@@ -47,6 +47,14 @@ class ValueList {
     }
   }
 
+  /// Appends the values of 'decoded' at 'rows'. Writes the serialized values
+  /// in one contiguous write instead of one write per value.
+  void appendValues(
+      const DecodedVector& decoded,
+      folly::Range<const vector_size_t*> rows,
+      HashStringAllocator* allocator);
+
+  /// Appends 'size' values of 'vector' starting at 'offset' in one write.
   void appendRange(
       const VectorPtr& vector,
       vector_size_t offset,
@@ -95,6 +103,16 @@ class ValueList {
 
   void prepareAppend(HashStringAllocator* allocator);
 
+  // Appends 'numValues' values. Sets the null flags of all values first, then
+  // writes the non-null values with 'serialize(stream, i)' for the ith value in
+  // a single write. 'isNull(i)' returns true if the ith value is null.
+  template <typename IsNull, typename Serialize>
+  void appendBatch(
+      vector_size_t numValues,
+      IsNull isNull,
+      Serialize serialize,
+      HashStringAllocator* allocator);
+
   // Writes lastNulls_ word to the 'nulls' block.
   void writeLastNulls(HashStringAllocator* allocator);
 
@@ -15,6 +15,7 @@
  */
 #include "velox/functions/lib/aggregates/ValueList.h"
 #include <gtest/gtest.h>
+#include <numeric>
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 
 using namespace facebook::velox;
@@ -141,3 +142,28 @@ TEST_F(ValueListTest, arrays) {
     }
   }
 }
+
+TEST_F(ValueListTest, appendValues) {
+  for (auto size : kTestSizes) {
+    auto data = makeArrayVector<int32_t>(
+        size,
+        [](auto row) { return row % 7; },
+        [](auto row) { return row % 11; },
+        test::VectorMaker::nullEvery(5));
+
+    // Append the rows in two batches.
+    DecodedVector decoded(*data);
+    std::vector<vector_size_t> rows(size);
+    std::iota(rows.begin(), rows.end(), 0);
+    const auto half = size / 2;
+    aggregate::ValueList values;
+    values.appendValues(decoded, folly::Range(rows.data(), half), allocator());
+    values.appendValues(
+        decoded,
+        folly::Range(rows.data() + half, rows.data() + size),
+        allocator());
+
+    ASSERT_EQ(size, values.size());
+    assertEqualVectors(data, read(values, data->type(), size));
+  }
+}
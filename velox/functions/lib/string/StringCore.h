@@ -264,10 +264,21 @@ applyAppendersRecursive(TOutStr& output, Func appenderFunc, Funcs... funcs) {
  */
 FOLLY_ALWAYS_INLINE int64_t
 lengthUnicode(const char* inputBuffer, size_t bufferLength) {
+  // Counts the bytes that are not continuation bytes (0b10xxxxxx), a batch at
+  // a time. As int8_t the continuation bytes are the values below -64.
+  using Batch = xsimd::batch<int8_t>;
+  const auto lastContinuation = Batch::broadcast(-65);
+  int64_t size = 0;
+  size_t i = 0;
+  for (; i + Batch::size <= bufferLength; i += Batch::size) {
+    const auto batch =
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(inputBuffer) + i);
+    size += __builtin_popcount(simd::toBitMask(batch > lastContinuation));
+  }
+
   // First address after the last byte in the buffer
   auto buffEndAddress = inputBuffer + bufferLength;
-  auto currentChar = inputBuffer;
-  int64_t size = 0;
+  auto currentChar = inputBuffer + i;
   while (currentChar < buffEndAddress) {
     // This function detects bytes that come after the first byte in a
     // multi-byte UTF-8 character (provided that the string is valid UTF-8). We
@@ -343,6 +354,88 @@ cappedByteLengthUnicode(const char* input, int64_t size, int64_t maxChars) {
   return utf8Position;
 }
 
+/// Returns the byte index of the first instance of subString in string at or
+/// after startPosition, or std::string_view::npos if there is none. Same as
+/// std::string_view::find but compares a SIMD batch of candidate positions at a
+/// time.
+FOLLY_ALWAYS_INLINE size_t findSubstring(
+    std::string_view string,
+    std::string_view subString,
+    size_t startPosition = 0) {
+  if (startPosition > string.size()) {
+    return std::string_view::npos;
+  }
+  const auto index = simd::simdStrstr(
+      string.data() + startPosition,
+      string.size() - startPosition,
+      subString.data(),
+      subString.size());
+  return index == std::string_view::npos ? index : index + startPosition;
+}
+
+/// Returns the byte index of the first character of str not in 'chars', or
+/// 'length' if all characters are in 'chars'. Compares a SIMD batch of
+/// characters against each of 'chars' at a time, so 'chars' is expected to be
+/// short, e.g. the characters to trim.
+FOLLY_ALWAYS_INLINE size_t findFirstNotOf(
+    const char* str,
+    size_t length,
+    const char* chars,
+    size_t numChars) {
+  using Batch = xsimd::batch<int8_t>;
+  const auto* data = reinterpret_cast<const int8_t*>(str);
+  size_t i = 0;
+  for (; i + Batch::size <= length; i += Batch::size) {
+    const auto batch = Batch::load_unaligned(data + i);
+    Batch::batch_bool_type matches(false);
+    for (size_t j = 0; j < numChars; ++j) {
+      matches = matches || (batch == Batch::broadcast(chars[j]));
+    }
+    const uint32_t notMatched = ~simd::toBitMask(matches) &
+        static_cast<uint32_t>(simd::allSetBitMask<int8_t>());
+    if (notMatched != 0) {
+      return i + __builtin_ctz(notMatched);
+    }
+  }
+  for (; i < length; ++i) {
+    if (std::memchr(chars, str[i], numChars) == nullptr) {
+      return i;
+    }
+  }
+  return length;
+}
+
+/// Returns the number of bytes of str before the trailing run of characters
+/// in 'chars', i.e. 1 + the byte index of the last character not in 'chars',
+/// or 0 if all characters are in 'chars'. See findFirstNotOf.
+FOLLY_ALWAYS_INLINE size_t findLastNotOfEnd(
+    const char* str,
+    size_t length,
+    const char* chars,
+    size_t numChars) {
+  using Batch = xsimd::batch<int8_t>;
+  const auto* data = reinterpret_cast<const int8_t*>(str);
+  size_t end = length;
+  for (; end >= Batch::size; end -= Batch::size) {
+    const auto batch = Batch::load_unaligned(data + end - Batch::size);
+    Batch::batch_bool_type matches(false);
+    for (size_t j = 0; j < numChars; ++j) {
+      matches = matches || (batch == Batch::broadcast(chars[j]));
+    }
+    const uint32_t notMatched = ~simd::toBitMask(matches) &
+        static_cast<uint32_t>(simd::allSetBitMask<int8_t>());
+    if (notMatched != 0) {
+      return end - Batch::size + 32 - __builtin_clz(notMatched);
+    }
+  }
+  for (; end > 0; --end) {
+    if (std::memchr(chars, str[end - 1], numChars) == nullptr) {
+      return end;
+    }
+  }
+  return 0;
+}
+
 /// Returns the start byte index of the Nth instance of subString in
 /// string. Search starts from startPosition. Positions start with 0. If not
 /// found, -1 is returned. To facilitate finding overlapping strings, the
@@ -358,7 +451,7 @@ static inline int64_t findNthInstanceByteIndexFromStart(
     return -1;
   }
 
-  auto byteIndex = string.find(subString, startPosition);
+  auto byteIndex = findSubstring(string, subString, startPosition);
   // Not found
   if (byteIndex == std::string_view::npos) {
     return -1;
@@ -477,7 +477,7 @@ FOLLY_ALWAYS_INLINE bool splitPart(
 
   while (curPos <= inputSv.size()) {
     size_t start = curPos;
-    curPos = inputSv.find(delim, curPos);
+    curPos = stringCore::findSubstring(inputSv, delim, curPos);
     if (iteration == index) {
       size_t end = curPos;
       if (end == std::string_view::npos) {
@@ -529,6 +529,39 @@ trimAscii(TOutString& output, const TInString& input, TShouldTrim shouldTrim) {
   output.setNoCopy(StringView(start, curPos - start + 1));
 }
 
+/// Trims the characters in 'trimCharacters' from 'input'. Same as trimAscii
+/// with a predicate that matches 'trimCharacters' but tests a SIMD batch of
+/// characters at a time. 'trimCharacters' must be ASCII.
+template <
+    bool leftTrim,
+    bool rightTrim,
+    typename TOutString,
+    typename TInString,
+    typename TTrimString>
+FOLLY_ALWAYS_INLINE void trimAsciiCharacters(
+    TOutString& output,
+    const TInString& input,
+    const TTrimString& trimCharacters) {
+  const auto* chars = trimCharacters.data();
+  const auto numChars = trimCharacters.size();
+  size_t start = 0;
+  if constexpr (leftTrim) {
+    start = stringCore::findFirstNotOf(
+        input.data(), input.size(), chars, numChars);
+  }
+  size_t end = input.size();
+  if constexpr (rightTrim) {
+    end = start +
+        stringCore::findLastNotOfEnd(
+              input.data() + start, input.size() - start, chars, numChars);
+  }
+  if (start >= end) {
+    output.setEmpty();
+    return;
+  }
+  output.setNoCopy(StringView(input.data() + start, end - start));
+}
+
 template <
     bool leftTrim,
     bool rightTrim,
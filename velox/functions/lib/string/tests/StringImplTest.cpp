@@ -1002,6 +1002,62 @@ TEST_F(StringImplTest, isAscii) {
   ASSERT_FALSE(isAscii(s.data(), s.size()));
 }
 
+TEST_F(StringImplTest, lengthLongInput) {
+  // Covers the SIMD batches and the tail of the byte loop.
+  std::string input;
+  for (auto i = 0; i < 50; ++i) {
+    input += i % 3 == 0 ? "\u03b1" : (i % 3 == 1 ? "\u4FE1" : "a");
+    const auto numChars = i + 1;
+    ASSERT_EQ(lengthUnicode(input.data(), input.size()), numChars);
+  }
+  // Bad bytes that are not continuation bytes count as one character each.
+  input = std::string(40, 'a') + "\xFF" + std::string(40, 'b');
+  ASSERT_EQ(lengthUnicode(input.data(), input.size()), 81);
+}
+
+TEST_F(StringImplTest, findSubstring) {
+  const std::string text = std::string(70, 'a') + "xyzb" + std::string(5, 'a');
+  for (size_t start = 0; start <= text.size() + 1; ++start) {
+    for (const std::string_view needle :
+         {"", "a", "b", "xyz", "aaxyzbaa", "xyzbaaaaaa", "q"}) {
+      const auto expected = start > text.size()
+          ? std::string_view::npos
+          : std::string_view(text).find(needle, start);
+      ASSERT_EQ(findSubstring(text, needle, start), expected)
+          << needle << " " << start;
+    }
+  }
+  // The string is not null terminated.
+  const std::string_view prefix(text.data(), 70);
+  ASSERT_EQ(findSubstring(prefix, "x"), std::string_view::npos);
+  ASSERT_EQ(findSubstring(prefix, "ax"), std::string_view::npos);
+}
+
+TEST_F(StringImplTest, findNotOf) {
+  const std::string chars = "xy ";
+  for (size_t prefix = 0; prefix < 70; ++prefix) {
+    for (size_t suffix = 0; suffix < 70; suffix += 7) {
+      std::string input(prefix, prefix % 2 ? 'y' : ' ');
+      input += "ab c";
+      input += std::string(suffix, 'y');
+      ASSERT_EQ(
+          findFirstNotOf(input.data(), input.size(), chars.data(), 3), prefix);
+      ASSERT_EQ(
+          findLastNotOfEnd(input.data(), input.size(), chars.data(), 3),
+          prefix + 4);
+    }
+  }
+  const std::string allTrimmed(50, 'y');
+  ASSERT_EQ(
+      findFirstNotOf(allTrimmed.data(), allTrimmed.size(), chars.data(), 3),
+      50);
+  ASSERT_EQ(
+      findLastNotOfEnd(allTrimmed.data(), allTrimmed.size(), chars.data(), 3),
+      0);
+  ASSERT_EQ(findFirstNotOf(allTrimmed.data(), 50, chars.data(), 0), 0);
+  ASSERT_EQ(findLastNotOfEnd(allTrimmed.data(), 50, chars.data(), 0), 50);
+}
+
 TEST_F(StringImplTest, initcapUnicodePresto) {
   for (const auto& [input, expected] : getInitcapUnicodePrestoTestData()) {
     std::string output;
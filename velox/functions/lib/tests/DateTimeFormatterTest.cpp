@@ -1366,6 +1366,55 @@ TEST_F(JodaDateTimeFormatterTest, betterErrorMessaging) {
       "Value 429 for dayOfMonth must be in the range [1,365] for year 2057 and month 2.");
 }
 
+TEST_F(JodaDateTimeFormatterTest, fixedWidthLayout) {
+  EXPECT_TRUE(getJodaDateTimeFormatter("yyyy-MM-dd")->hasFixedWidthLayout());
+  EXPECT_TRUE(getJodaDateTimeFormatter("yyyy-MM-dd HH:mm:ss.SSS")
+                  ->hasFixedWidthLayout());
+  EXPECT_TRUE(getJodaDateTimeFormatter("yyyyMMdd")->hasFixedWidthLayout());
+  EXPECT_FALSE(getJodaDateTimeFormatter("yyyy-M-dd")->hasFixedWidthLayout());
+  EXPECT_FALSE(getJodaDateTimeFormatter("yyyy-MM")->hasFixedWidthLayout());
+  EXPECT_FALSE(getJodaDateTimeFormatter("yyyy-MM-dd Z")->hasFixedWidthLayout());
+  EXPECT_FALSE(
+      getJodaDateTimeFormatter("yyyy-MM-dd'1'HH")->hasFixedWidthLayout());
+
+  const std::string format = "yyyy-MM-dd HH:mm:ss.SSS";
+  EXPECT_EQ(
+      fromTimestampString("2024-02-29 23:59:58.123"),
+      parseJoda("2024-02-29 23:59:58.123", format).timestamp);
+  EXPECT_EQ(
+      fromTimestampString("0001-01-01 00:00:00.000"),
+      parseJoda("0001-01-01 00:00:00.000", format).timestamp);
+  EXPECT_EQ(
+      fromTimestampString("2024-01-05"),
+      parseJoda("20240105", "yyyyMMdd").timestamp);
+
+  // Inputs outside of the layout take the general path.
+  EXPECT_EQ(
+      fromTimestampString("2024-01-05"),
+      parseJoda("2024-1-5", "yyyy-MM-dd").timestamp);
+  EXPECT_EQ(
+      fromTimestampString("2024-01-05"),
+      parseJoda("+2024-01-05", "yyyy-MM-dd").timestamp);
+  VELOX_ASSERT_THROW(
+      parseJoda("2023-02-29 10:00:00.000", format),
+      "Value 29 for dayOfMonth must be in the range [1,28] for year 2023 and month 2.");
+  VELOX_ASSERT_THROW(
+      parseJoda("2023-13-01", "yyyy-MM-dd"), "Invalid date format");
+  VELOX_ASSERT_THROW(
+      parseJoda("2023/01/01", "yyyy-MM-dd"), "Invalid date format");
+}
+
+TEST_F(JodaDateTimeFormatterTest, formatterCache) {
+  auto formatter = getJodaDateTimeFormatter("yyyy-MM-dd");
+  EXPECT_EQ(formatter, getJodaDateTimeFormatter("yyyy-MM-dd"));
+  EXPECT_NE(formatter, getJodaDateTimeFormatter("yyyy-MM-dd HH"));
+  // The same format string of another formatter type has a separate entry.
+  EXPECT_NE(
+      formatter, buildSimpleDateTimeFormatter("yyyy-MM-dd", true).value());
+  EXPECT_TRUE(buildJodaDateTimeFormatter("q").hasError());
+  EXPECT_TRUE(buildJodaDateTimeFormatter("q").hasError());
+}
+
 class MysqlDateTimeTest : public DateTimeFormatterTest {};
 
 TEST_F(MysqlDateTimeTest, validBuild) {
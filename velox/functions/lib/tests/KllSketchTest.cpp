@@ -129,6 +129,32 @@ TEST_F(KllSketchTest, randomInput) {
   }
 }
 
+TEST_F(KllSketchTest, insertBatch) {
+  constexpr int N = 1e5;
+  KllSketch<double> expected(kDefaultK, {}, 0);
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  std::vector<double> values;
+  for (int i = 0; i < N; ++i) {
+    values.push_back((i * 7'919) % N);
+    expected.insert(values.back());
+    // Insert in batches of different sizes.
+    if (values.size() > static_cast<size_t>(i % 500)) {
+      kll.insert(folly::Range<const double*>(values.data(), values.size()));
+      values.clear();
+    }
+  }
+  kll.insert(folly::Range<const double*>(values.data(), values.size()));
+  ASSERT_EQ(kll.totalCount(), N);
+
+  expected.compact();
+  kll.compact();
+  std::vector<char> expectedData(expected.serializedByteSize());
+  expected.serialize(expectedData.data());
+  std::vector<char> data(kll.serializedByteSize());
+  kll.serialize(data.data());
+  EXPECT_EQ(data, expectedData);
+}
+
 TEST_F(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
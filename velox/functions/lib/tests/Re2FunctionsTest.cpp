@@ -70,6 +70,8 @@ class Re2FunctionsTest : public test::FunctionBaseTest {
     exec::registerStatefulVectorFunction(
         "re2_extract_all", re2ExtractAllSignatures(), makeRe2ExtractAll);
     exec::registerStatefulVectorFunction("like", likeSignatures(), makeLike);
+    exec::registerStatefulVectorFunction(
+        "re2_search_any", re2SearchAnySignatures(), makeRe2SearchAny);
   }
 
  protected:
@@ -1587,5 +1589,52 @@ TEST_F(Re2FunctionsTest, parseSubstrings) {
   test("%aa%bb%%%cc%", {"aa", "bb", "cc"});
 }
 
+TEST_F(Re2FunctionsTest, searchAny) {
+  auto input = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"abc", "xyz", "new\nline q", "none", std::nullopt}),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5}),
+  });
+  assertEqualVectors(
+      makeNullableFlatVector<bool>({true, true, true, false, std::nullopt}),
+      evaluate("re2_search_any(c0, 'a.c', '^x', '(?s:^.*q.*$)')", input));
+  VELOX_ASSERT_THROW(
+      evaluate("re2_search_any(c0, 'a(')", input),
+      "invalid regular expression");
+
+  const Re2SearchAnyNames names{"re2_search", "like", "re2_search_any"};
+  const auto type = asRowType(input->type());
+  auto testRewrite = [&](const std::string& sql, const std::string& expected) {
+    SCOPED_TRACE(sql);
+    const auto expr = makeTypedExpr(sql, type);
+    const auto rewritten = rewriteRe2SearchDisjunction(expr, names);
+    ASSERT_NE(rewritten, nullptr);
+    ASSERT_EQ(*rewritten, *makeTypedExpr(expected, type))
+        << rewritten->toString();
+    assertEqualVectors(evaluate(expr, input), evaluate(rewritten, input));
+  };
+  testRewrite(
+      "re2_search(c0, 'a.c') or c0 like '%l_ne%' or c1 = 4 or "
+      "re2_search(c0, 'z$')",
+      "re2_search_any(c0, 'a.c', '(?s:^.*l.ne.*$)', 'z$') or c1 = 4");
+  testRewrite(
+      "c0 like 'a%' or c0 like 'x#%%' escape '#'",
+      "re2_search_any(c0, '(?s:^a.*$)', '(?s:^x%.*$)')");
+  // Invalid patterns keep their calls.
+  testRewrite(
+      "re2_search(c0, 'a(') or re2_search(c0, 'b') or re2_search(c0, 'c')",
+      "re2_search(c0, 'a(') or re2_search_any(c0, 'b', 'c')");
+
+  // Nothing to merge.
+  for (const auto& sql :
+       {"re2_search(c0, 'a') or c1 = 1",
+        "re2_search(c0, 'a') and re2_search(c0, 'b')",
+        "re2_search(c0, 'a') or re2_search(cast(c1 as varchar), 'b')"}) {
+    EXPECT_EQ(
+        rewriteRe2SearchDisjunction(makeTypedExpr(sql, type), names), nullptr)
+        << sql;
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::functions
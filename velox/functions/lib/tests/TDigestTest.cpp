@@ -65,6 +65,36 @@ TEST_F(TDigestTest, addElementsRandomized) {
   CHECK_QUANTILES(folly::Range(values, N), digest, kSumError, kRankError);
 }
 
+TEST_F(TDigestTest, addBatch) {
+  constexpr int N = 1e5;
+  TDigest expected;
+  TDigest digest;
+  std::vector<int16_t> positions;
+  std::vector<double> values;
+  std::default_random_engine gen(common::testutil::getRandomSeed(42));
+  std::uniform_real_distribution<> dist;
+  for (int i = 0; i < N; ++i) {
+    values.push_back(dist(gen));
+    expected.add(positions, values.back());
+    // Add in batches of different sizes.
+    if (values.size() > static_cast<size_t>(i % 2'000)) {
+      digest.add(
+          positions, folly::Range<const double*>(values.data(), values.size()));
+      values.clear();
+    }
+  }
+  digest.add(
+      positions, folly::Range<const double*>(values.data(), values.size()));
+  expected.compress(positions);
+  digest.compress(positions);
+
+  std::string expectedData(expected.serializedByteSize(), '\0');
+  expected.serialize(expectedData.data());
+  std::string data(digest.serializedByteSize(), '\0');
+  digest.serialize(data.data());
+  ASSERT_EQ(data, expectedData);
+}
+
 TEST_F(TDigestTest, fewElements) {
   TDigest digest;
   std::vector<int16_t> positions;
@@ -19,6 +19,7 @@
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateArraySequence.h>
 #include <geos/geom/Envelope.h>
+#include <geos/geom/prep/PreparedGeometryFactory.h>
 #include <geos/io/GeoJSON.h>
 #include <geos/io/GeoJSONReader.h>
 #include <geos/io/GeoJSONWriter.h>
@@ -200,6 +201,61 @@ struct StPolygonFunction {
 
 // Predicates
 
+namespace detail {
+
+/// A constant geometry argument of a spatial predicate. The geometry is
+/// deserialized and prepared once, so that the indices GEOS builds for the
+/// prepared geometry are reused by every row instead of rebuilt per row.
+class ConstantPreparedGeometry {
+ public:
+  /// Prepares 'geometry' if not nullptr, i.e. if the argument is constant.
+  void initialize(const StringView* geometry) {
+    if (geometry == nullptr) {
+      return;
+    }
+    geometry_ =
+        common::geospatial::GeometryDeserializer::deserialize(*geometry);
+    envelope_ = std::make_unique<geos::geom::Envelope>(
+        *geometry_->getEnvelopeInternal());
+    prepared_ = geos::geom::prep::PreparedGeometryFactory::prepare(
+        geometry_.get());
+  }
+
+  bool isPrepared() const {
+    return prepared_ != nullptr;
+  }
+
+  const geos::geom::prep::PreparedGeometry& prepared() const {
+    return *prepared_;
+  }
+
+  const geos::geom::Envelope& envelope() const {
+    return *envelope_;
+  }
+
+ private:
+  std::unique_ptr<geos::geom::Geometry> geometry_;
+  std::unique_ptr<geos::geom::Envelope> envelope_;
+  std::unique_ptr<geos::geom::prep::PreparedGeometry> prepared_;
+};
+
+/// Returns the envelope of 'geometry', taken from 'constant' if prepared or
+/// else read into 'holder' from the serialized header without deserializing
+/// the geometry.
+inline const geos::geom::Envelope& getEnvelope(
+    const StringView& geometry,
+    const ConstantPreparedGeometry& constant,
+    std::unique_ptr<geos::geom::Envelope>& holder) {
+  if (constant.isPrepared()) {
+    return constant.envelope();
+  }
+  holder = common::geospatial::GeometryDeserializer::deserializeEnvelope(
+      geometry);
+  return *holder;
+}
+
+} // namespace detail
+
 template <typename T>
 struct StRelateFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
@@ -226,13 +282,50 @@ template <typename T>
 struct StContainsFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Geometry>* leftGeometry,
+      const arg_type<Geometry>* rightGeometry) {
+    // A contains B if and only if B is within A, so either side can be the
+    // prepared one.
+    left_.initialize(leftGeometry);
+    if (!left_.isPrepared()) {
+      right_.initialize(rightGeometry);
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status call(
       out_type<bool>& result,
       const arg_type<Geometry>& leftGeometry,
       const arg_type<Geometry>& rightGeometry) {
-    // TODO: When #12771 is merged, check envelopes and short-circuit
+    // An empty geometry has a null envelope, which covers nothing and is
+    // covered by nothing, just like an empty geometry contains nothing and is
+    // contained in nothing.
+    std::unique_ptr<geos::geom::Envelope> leftEnvelope;
+    std::unique_ptr<geos::geom::Envelope> rightEnvelope;
+    if (!detail::getEnvelope(leftGeometry, left_, leftEnvelope)
+             .covers(
+                 detail::getEnvelope(rightGeometry, right_, rightEnvelope))) {
+      result = false;
+      return Status::OK();
+    }
+    if (left_.isPrepared()) {
+      auto rightGeosGeometry =
+          common::geospatial::GeometryDeserializer::deserialize(rightGeometry);
+      GEOS_TRY(
+          result = left_.prepared().contains(rightGeosGeometry.get());
+          , "Failed to check geometry contains");
+      return Status::OK();
+    }
     std::unique_ptr<geos::geom::Geometry> leftGeosGeometry =
         common::geospatial::GeometryDeserializer::deserialize(leftGeometry);
+    if (right_.isPrepared()) {
+      GEOS_TRY(
+          result = right_.prepared().within(leftGeosGeometry.get());
+          , "Failed to check geometry contains");
+      return Status::OK();
+    }
     std::unique_ptr<geos::geom::Geometry> rightGeosGeometry =
         common::geospatial::GeometryDeserializer::deserialize(rightGeometry);
     GEOS_TRY(
@@ -241,6 +334,10 @@ struct StContainsFunction {
 
     return Status::OK();
   }
+
+ private:
+  detail::ConstantPreparedGeometry left_;
+  detail::ConstantPreparedGeometry right_;
 };
 
 template <typename T>
@@ -310,11 +407,41 @@ template <typename T>
 struct StIntersectsFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Geometry>* leftGeometry,
+      const arg_type<Geometry>* rightGeometry) {
+    left_.initialize(leftGeometry);
+    if (!left_.isPrepared()) {
+      right_.initialize(rightGeometry);
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status call(
       out_type<bool>& result,
       const arg_type<Geometry>& leftGeometry,
       const arg_type<Geometry>& rightGeometry) {
-    // TODO: When #12771 is merged, check envelopes and short-circuit
+    // Null envelopes of empty geometries intersect nothing.
+    std::unique_ptr<geos::geom::Envelope> leftEnvelope;
+    std::unique_ptr<geos::geom::Envelope> rightEnvelope;
+    if (!detail::getEnvelope(leftGeometry, left_, leftEnvelope)
+             .intersects(
+                 detail::getEnvelope(rightGeometry, right_, rightEnvelope))) {
+      result = false;
+      return Status::OK();
+    }
+    // Intersection is symmetric, so the prepared side can be either.
+    if (left_.isPrepared() || right_.isPrepared()) {
+      const auto& prepared = left_.isPrepared() ? left_ : right_;
+      auto otherGeosGeometry =
+          common::geospatial::GeometryDeserializer::deserialize(
+              left_.isPrepared() ? rightGeometry : leftGeometry);
+      GEOS_TRY(
+          result = prepared.prepared().intersects(otherGeosGeometry.get());
+          , "Failed to check geometry intersects");
+      return Status::OK();
+    }
     std::unique_ptr<geos::geom::Geometry> leftGeosGeometry =
         common::geospatial::GeometryDeserializer::deserialize(leftGeometry);
     std::unique_ptr<geos::geom::Geometry> rightGeosGeometry =
@@ -325,6 +452,10 @@ struct StIntersectsFunction {
 
     return Status::OK();
   }
+
+ private:
+  detail::ConstantPreparedGeometry left_;
+  detail::ConstantPreparedGeometry right_;
 };
 
 template <typename T>
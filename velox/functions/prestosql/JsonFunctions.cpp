@@ -13,12 +13,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/container/F14Map.h>
 #include <glog/logging.h>
 
 #include "velox/common/base/SortingNetwork.h"
+#include "velox/expression/ExprUtils.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/expression/VectorWriters.h"
 #include "velox/functions/lib/JsonUtil.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/json/JsonStringUtil.h"
 #include "velox/functions/prestosql/json/SIMDJsonExtractor.h"
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
@@ -87,6 +90,48 @@ simdjson::error_code jsonParsingError(const simdjson::padded_string& json) {
   return jsonParsingError(doc);
 }
 
+simdjson::error_code extractJsonScalar(
+    SIMDJsonExtractor& extractor,
+    simdjson::ondemand::document& doc,
+    std::optional<std::string>& result) {
+  bool resultPopulated = false;
+  auto consumer = [&result, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        result = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  };
+
+  bool isDefinitePath = true;
+  return extractor.extract(doc, consumer, isDefinitePath);
+}
+
 namespace {
 
 const std::string_view kArrayStart = "[";
@@ -923,8 +968,232 @@ class JsonInternalCastFunction : public exec::VectorFunction {
   mutable JsonCastOperator jsonCastOperator_;
 };
 
+// Extracts the scalars at several constant paths from the same JSON, parsing
+// and validating the JSON once per row. Returns a row with one VARCHAR field
+// per path, null where json_extract_scalar would return null. Made by
+// rewriteJsonExtractScalars.
+class JsonExtractScalarsFunction : public exec::VectorFunction {
+ public:
+  explicit JsonExtractScalarsFunction(
+      std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors)
+      : extractors_(std::move(extractors)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::LocalDecodedVector decodedJson(context, *args[0], rows);
+    const auto numPaths = extractors_.size();
+    VELOX_CHECK_EQ(outputType->size(), numPaths);
+
+    std::vector<VectorPtr> fields(numPaths);
+    std::vector<FlatVector<StringView>*> flatFields(numPaths);
+    for (auto i = 0; i < numPaths; ++i) {
+      fields[i] = BaseVector::create(VARCHAR(), rows.end(), context.pool());
+      flatFields[i] = fields[i]->asFlatVector<StringView>();
+    }
+
+    std::optional<std::string> value;
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      const auto json = decodedJson->valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(json.data(), json.size());
+      simdjson::ondemand::document doc;
+      if (simdjsonParse(paddedJson).get(doc) || jsonParsingError(doc)) {
+        for (auto* field : flatFields) {
+          field->setNull(row, true);
+        }
+        return;
+      }
+      for (auto i = 0; i < numPaths; ++i) {
+        if (i > 0) {
+          doc.rewind();
+        }
+        value.reset();
+        if (extractJsonScalar(*extractors_[i], doc, value) ||
+            !value.has_value()) {
+          flatFields[i]->setNull(row, true);
+        } else {
+          flatFields[i]->set(row, StringView(*value));
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(fields));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    // json, varchar... -> row(varchar...)
+    // varchar, varchar... -> row(varchar...)
+    std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+    for (const auto* jsonType : {"json", "varchar"}) {
+      signatures.push_back(exec::FunctionSignatureBuilder()
+                               .returnType("row(unknown)")
+                               .argumentType(jsonType)
+                               .constantArgumentType("varchar")
+                               .variableArity("varchar")
+                               .build());
+    }
+    return signatures;
+  }
+
+ private:
+  const std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors_;
+};
+
+// Returns the path of 'expr' if it is a call to 'extractScalarName' with a
+// valid constant path. Invalid paths are left to fail at evaluation.
+std::optional<std::string> constantJsonPath(
+    const core::TypedExprPtr& expr,
+    const std::string& extractScalarName) {
+  if (!expr->isCallKind() ||
+      expr->asUnchecked<core::CallTypedExpr>()->name() != extractScalarName ||
+      expr->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  const auto& path = expr->inputs()[1];
+  if (!path->isConstantKind() || !path->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  const auto* constant = path->asUnchecked<core::ConstantTypedExpr>();
+  if (constant->isNull()) {
+    return std::nullopt;
+  }
+  auto pathString = constant->hasValueVector()
+      ? std::string(constant->valueVector()
+                        ->as<SimpleVector<StringView>>()
+                        ->valueAt(0))
+      : constant->value().value<std::string>();
+  if (SIMDJsonExtractor::tryCompile(pathString) == nullptr) {
+    return std::nullopt;
+  }
+  return pathString;
+}
+
+// The distinct constant paths extracted from a JSON and the call that
+// extracts them all.
+struct JsonPaths {
+  core::TypedExprPtr json;
+  std::vector<std::string> paths;
+  core::TypedExprPtr fusedCall;
+};
+
+using JsonPathsMap = folly::F14FastMap<
+    const core::ITypedExpr*,
+    JsonPaths,
+    core::ITypedExprHasher,
+    core::ITypedExprComparer>;
+
+// Adds the constant paths of the json_extract_scalar calls in 'expr' to
+// 'jsonPaths'. Does not look into lambdas, which do not share subexpressions
+// with the enclosing expression.
+void collectJsonPaths(
+    const core::TypedExprPtr& expr,
+    const std::string& extractScalarName,
+    JsonPathsMap& jsonPaths) {
+  if (auto path = constantJsonPath(expr, extractScalarName)) {
+    const auto& json = expr->inputs()[0];
+    auto& entry = jsonPaths[json.get()];
+    if (entry.json == nullptr) {
+      entry.json = json;
+    }
+    if (std::find(entry.paths.begin(), entry.paths.end(), *path) ==
+        entry.paths.end()) {
+      entry.paths.push_back(std::move(*path));
+    }
+    return;
+  }
+  if (expr->isLambdaKind()) {
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectJsonPaths(input, extractScalarName, jsonPaths);
+  }
+}
+
 } // namespace
 
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::vector<core::TypedExprPtr>& exprs,
+    const std::string& extractScalarName,
+    const std::string& extractScalarsName) {
+  JsonPathsMap jsonPaths;
+  for (const auto& expr : exprs) {
+    collectJsonPaths(expr, extractScalarName, jsonPaths);
+  }
+
+  bool anyFused = false;
+  for (auto& it : jsonPaths) {
+    auto& entry = it.second;
+    if (entry.paths.size() < 2) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{entry.json};
+    std::vector<TypePtr> fieldTypes;
+    for (const auto& path : entry.paths) {
+      inputs.push_back(
+          std::make_shared<core::ConstantTypedExpr>(VARCHAR(), path));
+      fieldTypes.push_back(VARCHAR());
+    }
+    entry.fusedCall = std::make_shared<core::CallTypedExpr>(
+        ROW(std::vector<std::string>(entry.paths), std::move(fieldTypes)),
+        std::move(inputs),
+        extractScalarsName);
+    anyFused = true;
+  }
+  if (!anyFused) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> result;
+  result.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    result.push_back(expression::utils::replaceSubexpressions(
+        expr, [&](const core::TypedExprPtr& subexpr) -> core::TypedExprPtr {
+          auto path = constantJsonPath(subexpr, extractScalarName);
+          if (!path.has_value()) {
+            return nullptr;
+          }
+          const auto& entry = jsonPaths.at(subexpr->inputs()[0].get());
+          if (entry.fusedCall == nullptr) {
+            return subexpr;
+          }
+          const auto index =
+              std::find(entry.paths.begin(), entry.paths.end(), *path) -
+              entry.paths.begin();
+          return std::make_shared<core::DereferenceTypedExpr>(
+              subexpr->type(), entry.fusedCall, index);
+        }));
+  }
+  return result;
+}
+
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$_json_extract_scalars,
+    JsonExtractScalarsFunction::signatures(),
+    [](const std::string& /*name*/,
+       const std::vector<exec::VectorFunctionArg>& inputArgs,
+       const velox::core::QueryConfig&) {
+      std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors;
+      for (auto i = 1; i < inputArgs.size(); ++i) {
+        const auto& path = inputArgs[i].constantValue;
+        VELOX_USER_CHECK(
+            path != nullptr && !path->isNullAt(0),
+            "JSON paths must be non-null constants");
+        const auto pathString = std::string_view(
+            path->as<ConstantVector<StringView>>()->valueAt(0));
+        auto extractor = SIMDJsonExtractor::tryCompile(pathString);
+        VELOX_USER_CHECK_NOT_NULL(
+            extractor, "Invalid JSON path: {}", pathString);
+        extractors.push_back(std::move(extractor));
+      }
+      return std::make_shared<JsonExtractScalarsFunction>(
+          std::move(extractors));
+    });
+
 VELOX_DECLARE_VECTOR_FUNCTION(
     udf_json_format,
     JsonFormatFunction::signatures(),
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/core/Expressions.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
@@ -37,6 +38,24 @@ simdjson::error_code jsonParsingError(const simdjson::padded_string& json);
 /// failure code.
 simdjson::error_code jsonParsingError(simdjson::ondemand::document& doc);
 
+/// Extracts the scalar selected by 'extractor' from 'doc' into 'result' as
+/// json_extract_scalar does. Leaves 'result' empty if the path does not select
+/// exactly one string, number or boolean.
+simdjson::error_code extractJsonScalar(
+    SIMDJsonExtractor& extractor,
+    simdjson::ondemand::document& doc,
+    std::optional<std::string>& result);
+
+/// Rewrites the json_extract_scalar calls with constant paths over the same
+/// JSON in 'exprs' into fields of one 'extractScalarsName' call, which parses
+/// the JSON once per row for all the paths. The call is a common subexpression
+/// of the rewritten expressions. Returns an empty vector if no JSON has
+/// several paths.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::vector<core::TypedExprPtr>& exprs,
+    const std::string& extractScalarName,
+    const std::string& extractScalarsName);
+
 template <typename T>
 struct IsJsonScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
@@ -193,6 +212,17 @@ template <typename T>
 struct JsonExtractScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      // Invalid paths fail in call() for each row.
+      extractor_ = SIMDJsonExtractor::tryCompile(std::string_view(*jsonPath));
+    }
+  }
+
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Json>& json,
@@ -205,45 +235,10 @@ struct JsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
-    std::optional<std::string> resultStr;
-
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
-    };
-
     // TODO: Remove explicit std::string_view cast.
-    auto& extractor =
-        SIMDJsonExtractor::getInstance(std::string_view(jsonPath));
+    auto& extractor = extractor_ != nullptr
+        ? *extractor_
+        : SIMDJsonExtractor::getInstance(std::string_view(jsonPath));
 
     // Check for valid json
     simdjson::padded_string paddedJson(json.data(), json.size());
@@ -252,8 +247,8 @@ struct JsonExtractScalarFunction {
       return val;
     }
 
-    bool isDefinitePath = true;
-    SIMDJSON_TRY(extractor.extract(doc, consumer, isDefinitePath));
+    std::optional<std::string> resultStr;
+    SIMDJSON_TRY(extractJsonScalar(extractor, doc, resultStr));
 
     if (resultStr.has_value()) {
       result.copy_from(*resultStr);
@@ -262,6 +257,9 @@ struct JsonExtractScalarFunction {
       return simdjson::NO_SUCH_FIELD;
     }
   }
+
+  // The extractor of a constant path.
+  std::shared_ptr<SIMDJsonExtractor> extractor_;
 };
 
 template <typename T>
@@ -340,6 +340,73 @@ core::TypedExprPtr toArraySum(
   return plus;
 }
 
+// greatest(s, f(x)) or least(s, f(x)) =>
+//   if(cardinality(array) = 0, initial,
+//      greatest(initial, array_max(transform(array, x -> f(x)))))
+// The step is associative, so that the state is folded over the arrays in one
+// pass instead of one lambda evaluation per element position. A null element
+// or initial state makes both forms null. Limited to integer types, for which
+// the comparisons of greatest/least and array_max/array_min agree.
+core::TypedExprPtr toArrayMinMax(
+    const std::string& prefix,
+    const core::CallTypedExpr& reduce,
+    const RowTypePtr& inputArgs,
+    const core::CallTypedExpr& step) {
+  if (step.inputs().size() != 2) {
+    return nullptr;
+  }
+  auto& s = inputArgs->nameOf(0);
+  core::TypedExprPtr fx;
+  if (isVariableReference(step.inputs()[0], s)) {
+    fx = step.inputs()[1];
+  } else if (isVariableReference(step.inputs()[1], s)) {
+    fx = step.inputs()[0];
+  } else {
+    return nullptr;
+  }
+  if (containsVariableReference(fx, s)) {
+    return nullptr;
+  }
+  auto& initial = reduce.inputs()[1];
+  switch (initial->type()->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    default:
+      return nullptr;
+  }
+  auto& array = reduce.inputs()[0];
+  core::TypedExprPtr values = array;
+  if (!isVariableReference(fx, inputArgs->nameOf(1))) {
+    auto lambda = std::make_shared<core::LambdaTypedExpr>(
+        ROW({inputArgs->nameOf(1)}, {inputArgs->childAt(1)}), fx);
+    values = std::make_shared<core::CallTypedExpr>(
+        ARRAY(fx->type()), prefix + "transform", array, lambda);
+  }
+  const bool isGreatest = step.name() == prefix + "greatest";
+  auto extreme = std::make_shared<core::CallTypedExpr>(
+      initial->type(),
+      prefix + (isGreatest ? "array_max" : "array_min"),
+      values);
+  auto fold = std::make_shared<core::CallTypedExpr>(
+      initial->type(), step.name(), initial, extreme);
+  auto isEmpty = std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(),
+      prefix + "eq",
+      std::make_shared<core::CallTypedExpr>(
+          BIGINT(), prefix + "cardinality", array),
+      std::make_shared<core::ConstantTypedExpr>(
+          BIGINT(), variant::create<int64_t>(0)));
+  auto ifExpr = std::make_shared<core::CallTypedExpr>(
+      initial->type(), expression::kIf, isEmpty, initial, fold);
+  VLOG(1) << "Rewrite expression: " << reduce.toString() << " => "
+          << ifExpr->toString();
+  addThreadLocalRuntimeStat("numReduceRewrite", RuntimeCounter(1));
+  return ifExpr;
+}
+
 core::TypedExprPtr rewriteReduce(
     const std::string& prefix,
     const core::TypedExprPtr& expr) {
@@ -406,6 +473,10 @@ core::TypedExprPtr rewriteReduce(
     auto ifExpr = std::make_shared<core::CallTypedExpr>(
         fx->type(), expression::kIf, inputBody->inputs()[0], fx, gx);
     return toArraySum(prefix, *reduce, inputArgs, ifExpr);
+  } else if (
+      inputBody->name() == prefix + "greatest" ||
+      inputBody->name() == prefix + "least") {
+    return toArrayMinMax(prefix, *reduce, inputArgs, *inputBody);
   }
   return nullptr;
 }
@@ -19,6 +19,7 @@
 #include "velox/expression/StringWriter.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/expression/VectorWriters.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 
@@ -216,7 +217,7 @@ class SplitFunction : public exec::VectorFunction {
     const std::string_view sdelim(delim.data(), delim.size());
     while (true) {
       // Find the byte of the 1st delimiter.
-      auto byteIndex = sinput.find(sdelim, 0);
+      auto byteIndex = stringCore::findSubstring(sinput, sdelim);
 
       // Special case for empty delimiters. Split character by character with an
       // empty string at the end.
@@ -269,16 +269,8 @@ struct TrimFunctionBase {
       out_type<Varchar>& result,
       const arg_type<Varchar>& input,
       const arg_type<Varchar>& trimCharacters) {
-    const auto numChars = trimCharacters.size();
-    const auto* chars = trimCharacters.data();
-    stringImpl::trimAscii<leftTrim, rightTrim>(result, input, [&](char c) {
-      for (auto i = 0; i < numChars; ++i) {
-        if (c == chars[i]) {
-          return true;
-        }
-      }
-      return false;
-    });
+    stringImpl::trimAsciiCharacters<leftTrim, rightTrim>(
+        result, input, trimCharacters);
   }
 };
 
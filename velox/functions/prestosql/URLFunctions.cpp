@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/ExprConstants.h"
+#include "velox/expression/ExprUtils.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/URLFunctions.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+constexpr std::string_view kParameterPrefix = "parameter:";
+
+enum class UrlPart {
+  kProtocol,
+  kHost,
+  kPath,
+  kQuery,
+  kFragment,
+  kPort,
+  kParameter,
+};
+
+// A part of a URL extracted by $internal$url_extract_parts. 'parameter' is the
+// name of the query parameter of a kParameter part.
+struct UrlPartSpec {
+  UrlPart part;
+  std::string parameter;
+};
+
+// The parts extracted by the url_extract_<part> functions with a single
+// argument.
+const folly::F14FastMap<std::string, UrlPart>& singleArgumentParts() {
+  static const folly::F14FastMap<std::string, UrlPart> kParts = {
+      {"protocol", UrlPart::kProtocol},
+      {"host", UrlPart::kHost},
+      {"path", UrlPart::kPath},
+      {"query", UrlPart::kQuery},
+      {"fragment", UrlPart::kFragment},
+      {"port", UrlPart::kPort},
+  };
+  return kParts;
+}
+
+// Parses a part name made by rewriteUrlExtracts: the name of a single
+// argument part or 'parameter:<name>'.
+std::optional<UrlPartSpec> parseUrlPart(std::string_view name) {
+  if (name.substr(0, kParameterPrefix.size()) == kParameterPrefix) {
+    return UrlPartSpec{
+        UrlPart::kParameter,
+        std::string(name.substr(kParameterPrefix.size()))};
+  }
+  const auto& parts = singleArgumentParts();
+  auto it = parts.find(std::string(name));
+  if (it == parts.end()) {
+    return std::nullopt;
+  }
+  return UrlPartSpec{it->second, ""};
+}
+
+// Sets 'row' of 'field' to 'value', unescaping it first if 'hasEncoded'.
+// Unescaped values are copied into 'field'. Others refer to the strings of the
+// URLs, which 'field' shares.
+void setUrlString(
+    FlatVector<StringView>& field,
+    vector_size_t row,
+    const StringView& value,
+    bool hasEncoded,
+    std::string& unescaped) {
+  if (hasEncoded) {
+    detail::urlUnescape(unescaped, value);
+    field.set(row, StringView(unescaped));
+  } else {
+    field.setNoCopy(row, value);
+  }
+}
+
+// Extracts several parts of the same URL, parsing the URL once per row.
+// Returns a row with one field per part, BIGINT for the port and VARCHAR for
+// the others, null where the url_extract_<part> function would return null.
+// Made by rewriteUrlExtracts.
+class UrlExtractPartsFunction : public exec::VectorFunction {
+ public:
+  explicit UrlExtractPartsFunction(std::vector<UrlPartSpec> parts)
+      : parts_(std::move(parts)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::LocalDecodedVector decodedUrl(context, *args[0], rows);
+    const auto numParts = parts_.size();
+    VELOX_CHECK_EQ(outputType->size(), numParts);
+
+    std::vector<VectorPtr> fields(numParts);
+    std::vector<FlatVector<StringView>*> stringFields(numParts, nullptr);
+    std::vector<FlatVector<int64_t>*> portFields(numParts, nullptr);
+    for (auto i = 0; i < numParts; ++i) {
+      fields[i] = BaseVector::create(
+          outputType->childAt(i), rows.end(), context.pool());
+      if (parts_[i].part == UrlPart::kPort) {
+        portFields[i] = fields[i]->asFlatVector<int64_t>();
+      } else {
+        stringFields[i] = fields[i]->asFlatVector<StringView>();
+        stringFields[i]->acquireSharedStringBuffers(args[0].get());
+      }
+    }
+
+    std::string unescaped;
+    std::string unescapedQuery;
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      URI uri;
+      if (!parseUri(decodedUrl->valueAt<StringView>(row), uri)) {
+        for (auto& field : fields) {
+          field->setNull(row, true);
+        }
+        return;
+      }
+
+      // The unescaped query is shared by the parameters.
+      std::optional<StringView> query;
+      for (auto i = 0; i < numParts; ++i) {
+        switch (parts_[i].part) {
+          case UrlPart::kProtocol:
+            stringFields[i]->setNoCopy(row, uri.scheme);
+            break;
+          case UrlPart::kHost:
+            setUrlString(
+                *stringFields[i], row, uri.host, uri.hostHasEncoded, unescaped);
+            break;
+          case UrlPart::kPath:
+            setUrlString(
+                *stringFields[i], row, uri.path, uri.pathHasEncoded, unescaped);
+            break;
+          case UrlPart::kQuery:
+            setUrlString(
+                *stringFields[i],
+                row,
+                uri.query,
+                uri.queryHasEncoded,
+                unescaped);
+            break;
+          case UrlPart::kFragment:
+            setUrlString(
+                *stringFields[i],
+                row,
+                uri.fragment,
+                uri.fragmentHasEncoded,
+                unescaped);
+            break;
+          case UrlPart::kPort:
+            portFields[i]->setNull(row, true);
+            if (!uri.port.empty()) {
+              try {
+                portFields[i]->set(row, to<int64_t>(uri.port));
+              } catch (folly::ConversionError const&) {
+              }
+            }
+            break;
+          case UrlPart::kParameter: {
+            if (!query.has_value()) {
+              query = uri.query;
+              if (uri.queryHasEncoded) {
+                detail::urlUnescape(unescapedQuery, uri.query);
+                query = StringView(unescapedQuery);
+              }
+            }
+            std::optional<StringView> value;
+            if (!query->empty()) {
+              value =
+                  extractParameter(*query, StringView(parts_[i].parameter));
+            }
+            if (value.has_value()) {
+              stringFields[i]->set(row, *value);
+            } else {
+              stringFields[i]->setNull(row, true);
+            }
+            break;
+          }
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(fields));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    // varchar, varchar... -> row(...)
+    return {exec::FunctionSignatureBuilder()
+                .returnType("row(unknown)")
+                .argumentType("varchar")
+                .constantArgumentType("varchar")
+                .variableArity("varchar")
+                .build()};
+  }
+
+ private:
+  const std::vector<UrlPartSpec> parts_;
+};
+
+// Returns the part name of 'expr' if it is a call to one of the
+// url_extract_<part> functions, with a constant parameter name for
+// url_extract_parameter.
+std::optional<std::string> urlPartName(
+    const core::TypedExprPtr& expr,
+    const std::string& prefix) {
+  if (!expr->isCallKind()) {
+    return std::nullopt;
+  }
+  const auto& name = expr->asUnchecked<core::CallTypedExpr>()->name();
+  const auto extractPrefix = prefix + "url_extract_";
+  if (name.compare(0, extractPrefix.size(), extractPrefix) != 0) {
+    return std::nullopt;
+  }
+  const auto part = name.substr(extractPrefix.size());
+  if (singleArgumentParts().count(part) > 0) {
+    return expr->inputs().size() == 1 ? std::optional(part) : std::nullopt;
+  }
+  if (part != "parameter" || expr->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  const auto& parameter = expr->inputs()[1];
+  if (!parameter->isConstantKind() || !parameter->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  const auto* constant = parameter->asUnchecked<core::ConstantTypedExpr>();
+  if (constant->isNull()) {
+    return std::nullopt;
+  }
+  auto parameterName = constant->hasValueVector()
+      ? std::string(constant->valueVector()
+                        ->as<SimpleVector<StringView>>()
+                        ->valueAt(0))
+      : constant->value().value<std::string>();
+  return std::string(kParameterPrefix) + parameterName;
+}
+
+// The distinct parts extracted from a URL and the call that extracts them all.
+struct UrlParts {
+  core::TypedExprPtr url;
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  core::TypedExprPtr fusedCall;
+};
+
+using UrlPartsMap = folly::F14FastMap<
+    const core::ITypedExpr*,
+    UrlParts,
+    core::ITypedExprHasher,
+    core::ITypedExprComparer>;
+
+// Adds the parts extracted by the url_extract_<part> calls in 'expr' to
+// 'urlParts'. Does not look into lambdas or into the conditionally evaluated
+// inputs of special forms: parsing a URL for a part may fail for rows where
+// another part is not evaluated.
+void collectUrlParts(
+    const core::TypedExprPtr& expr,
+    const std::string& prefix,
+    UrlPartsMap& urlParts) {
+  if (auto name = urlPartName(expr, prefix)) {
+    const auto& url = expr->inputs()[0];
+    auto& entry = urlParts[url.get()];
+    if (entry.url == nullptr) {
+      entry.url = url;
+    }
+    if (std::find(entry.names.begin(), entry.names.end(), *name) ==
+        entry.names.end()) {
+      entry.names.push_back(std::move(*name));
+      entry.types.push_back(expr->type());
+    }
+    return;
+  }
+  if (expr->isLambdaKind()) {
+    return;
+  }
+  if (expr->isCallKind()) {
+    const auto& name = expr->asUnchecked<core::CallTypedExpr>()->name();
+    for (const auto* conditional :
+         {expression::kIf,
+          expression::kSwitch,
+          expression::kAnd,
+          expression::kOr,
+          expression::kCoalesce,
+          expression::kTry}) {
+      if (name == conditional) {
+        return;
+      }
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectUrlParts(input, prefix, urlParts);
+  }
+}
+
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteUrlExtracts(
+    const std::vector<core::TypedExprPtr>& exprs,
+    const std::string& prefix) {
+  UrlPartsMap urlParts;
+  for (const auto& expr : exprs) {
+    collectUrlParts(expr, prefix, urlParts);
+  }
+
+  bool anyFused = false;
+  for (auto& it : urlParts) {
+    auto& entry = it.second;
+    if (entry.names.size() < 2) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{entry.url};
+    for (const auto& name : entry.names) {
+      inputs.push_back(
+          std::make_shared<core::ConstantTypedExpr>(VARCHAR(), name));
+    }
+    entry.fusedCall = std::make_shared<core::CallTypedExpr>(
+        ROW(std::vector<std::string>(entry.names),
+            std::vector<TypePtr>(entry.types)),
+        std::move(inputs),
+        prefix + "$internal$url_extract_parts");
+    anyFused = true;
+  }
+  if (!anyFused) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> result;
+  result.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    result.push_back(expression::utils::replaceSubexpressions(
+        expr, [&](const core::TypedExprPtr& subexpr) -> core::TypedExprPtr {
+          auto name = urlPartName(subexpr, prefix);
+          if (!name.has_value()) {
+            return nullptr;
+          }
+          auto it = urlParts.find(subexpr->inputs()[0].get());
+          if (it == urlParts.end() || it->second.fusedCall == nullptr) {
+            return subexpr;
+          }
+          const auto& entry = it->second;
+          const auto index =
+              std::find(entry.names.begin(), entry.names.end(), *name) -
+              entry.names.begin();
+          return std::make_shared<core::DereferenceTypedExpr>(
+              subexpr->type(), entry.fusedCall, index);
+        }));
+  }
+  return result;
+}
+
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$_url_extract_parts,
+    UrlExtractPartsFunction::signatures(),
+    [](const std::string& /*name*/,
+       const std::vector<exec::VectorFunctionArg>& inputArgs,
+       const velox::core::QueryConfig&) {
+      std::vector<UrlPartSpec> parts;
+      for (auto i = 1; i < inputArgs.size(); ++i) {
+        const auto& name = inputArgs[i].constantValue;
+        VELOX_USER_CHECK(
+            name != nullptr && !name->isNullAt(0),
+            "URL parts must be non-null constants");
+        const auto nameString = std::string_view(
+            name->as<ConstantVector<StringView>>()->valueAt(0));
+        auto part = parseUrlPart(nameString);
+        VELOX_USER_CHECK(part.has_value(), "Invalid URL part: {}", nameString);
+        parts.push_back(std::move(*part));
+      }
+      return std::make_shared<UrlExtractPartsFunction>(std::move(parts));
+    });
+
+} // namespace facebook::velox::functions
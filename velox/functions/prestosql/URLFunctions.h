@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/core/Expressions.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/lib/Utf8Utils.h"
@@ -235,6 +236,15 @@ FOLLY_ALWAYS_INLINE void urlUnescape(
 
 } // namespace detail
 
+/// Rewrites the url_extract_<part> calls over the same URL in 'exprs' into
+/// fields of one $internal$url_extract_parts call, which parses the URL once
+/// per row for all the parts. url_extract_parameter calls are fused only for
+/// constant parameter names. The call is a common subexpression of the
+/// rewritten expressions. Returns an empty vector if no URL has several parts.
+std::vector<core::TypedExprPtr> rewriteUrlExtracts(
+    const std::vector<core::TypedExprPtr>& exprs,
+    const std::string& prefix);
+
 template <typename T>
 struct UrlExtractProtocolFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
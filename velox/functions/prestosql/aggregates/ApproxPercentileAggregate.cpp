@@ -95,6 +95,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(folly::Range<const T*> values) {
+    sketch_.insert(values);
+  }
+
   void append(
       T value,
       int64_t count,
@@ -455,20 +459,21 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         checkWeight(weight);
         accumulator->append(value, weight, allocator_, fixedRandomSeed_);
       });
+    } else if (
+        !decodedValue_.mayHaveNulls() && decodedValue_.isIdentityMapping() &&
+        rows.isAllSelected()) {
+      accumulator->append(
+          folly::Range<const T*>(decodedValue_.data<T>(), rows.size()));
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      // Gathers the non-null values to insert them as a batch.
+      values_.clear();
+      rows.applyToSelected([&](auto row) {
+        if (!decodedValue_.isNullAt(row)) {
+          values_.push_back(decodedValue_.valueAt<T>(row));
+        }
+      });
+      accumulator->append(
+          folly::Range<const T*>(values_.data(), values_.size()));
     }
   }
 
@@ -692,6 +697,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   double accuracy_{kMissingNormalizedValue};
   DecodedVector decodedValue_;
   DecodedVector decodedWeight_;
+  // Non-null values of addSingleGroupRawInput() to insert as a batch.
+  std::vector<T> values_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
 
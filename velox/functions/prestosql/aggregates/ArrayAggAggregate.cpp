@@ -257,15 +257,29 @@ class ArrayAggAggregate : public exec::Aggregate {
       bool /*mayPushdown*/) override {
     VELOX_CHECK(!clusteredInput_);
     decodedElements_.decode(*args[0], rows);
-    rows.applyToSelected([&](vector_size_t row) {
-      if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
-        return;
+    collectRows(rows);
+
+    // Orders the rows by group, keeping the input order within a group, so
+    // that the values of each group are appended with a single write.
+    std::stable_sort(
+        rows_.begin(),
+        rows_.end(),
+        [&](vector_size_t left, vector_size_t right) {
+          return std::less<char*>()(groups[left], groups[right]);
+        });
+    for (size_t i = 0; i < rows_.size();) {
+      auto* group = groups[rows_[i]];
+      auto end = i + 1;
+      while (end < rows_.size() && groups[rows_[end]] == group) {
+        ++end;
       }
-      auto group = groups[row];
       auto tracker = trackRowSize(group);
-      value<ArrayAccumulator>(group)->elements.appendValue(
-          decodedElements_, row, allocator_);
-    });
+      value<ArrayAccumulator>(group)->elements.appendValues(
+          decodedElements_,
+          folly::Range<const vector_size_t*>(rows_.data() + i, end - i),
+          allocator_);
+      i = end;
+    }
   }
 
   bool supportsAddRawClusteredInput() const override {
@@ -348,12 +362,11 @@ class ArrayAggAggregate : public exec::Aggregate {
 
     decodedElements_.decode(*args[0], rows);
     auto tracker = trackRowSize(group);
-    rows.applyToSelected([&](vector_size_t row) {
-      if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
-        return;
-      }
-      values.appendValue(decodedElements_, row, allocator_);
-    });
+    collectRows(rows);
+    values.appendValues(
+        decodedElements_,
+        folly::Range<const vector_size_t*>(rows_.data(), rows_.size()),
+        allocator_);
   }
 
   void addSingleGroupIntermediateResults(
@@ -423,11 +436,24 @@ class ArrayAggAggregate : public exec::Aggregate {
     return size;
   }
 
+  // Sets 'rows_' to the selected 'rows' skipping nulls if 'ignoreNulls_'.
+  void collectRows(const SelectivityVector& rows) {
+    rows_.clear();
+    rows.applyToSelected([&](vector_size_t row) {
+      if (!ignoreNulls_ || !decodedElements_.isNullAt(row)) {
+        rows_.push_back(row);
+      }
+    });
+  }
+
   // A boolean representing whether to ignore nulls when aggregating inputs.
   const bool ignoreNulls_;
   // Reusable instance of DecodedVector for decoding input vectors.
   DecodedVector decodedElements_;
   DecodedVector decodedIntermediate_;
+
+  // Rows of raw input to append to the accumulators.
+  std::vector<vector_size_t> rows_;
 };
 
 } // namespace
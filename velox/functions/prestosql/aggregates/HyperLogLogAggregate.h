@@ -184,19 +184,35 @@ class HyperLogLogAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+      auto accumulator =
+          value<velox::common::hll::HllAccumulator<T, HllAsFinalResult>>(
+              group);
+      if constexpr (std::is_same_v<T, bool>) {
+        rows.applyToSelected([&](auto row) {
+          if (decodedValue_.isNullAt(row)) {
+            return;
+          }
+
+          clearNull(group);
+          accumulator->setIndexBitLength(indexBitLength_);
+          accumulator->append(decodedValue_.valueAt<T>(row));
+        });
+      } else {
+        // Hashes all the rows first and inserts the hashes as a batch.
+        hashes_.clear();
+        rows.applyToSelected([&](auto row) {
+          if (!decodedValue_.isNullAt(row)) {
+            hashes_.push_back(
+                common::hll::detail::hashOne<T, HllAsFinalResult>(
+                    decodedValue_.valueAt<T>(row)));
+          }
+        });
+        if (!hashes_.empty()) {
+          clearNull(group);
+          accumulator->setIndexBitLength(indexBitLength_);
+          accumulator->insertHashes(hashes_.data(), hashes_.size());
         }
-
-        auto accumulator =
-            value<velox::common::hll::HllAccumulator<T, HllAsFinalResult>>(
-                group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        accumulator->append(decodedValue_.valueAt<T>(row));
-      });
+      }
     }
   }
 
@@ -352,6 +368,9 @@ class HyperLogLogAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+
+  // Hashes of the input rows of addSingleGroupRawInput().
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
@@ -168,6 +168,19 @@ class TDigestAggregate : public exec::Aggregate {
     decodeArguments(rows, args);
     auto* accumulator = getAccumulator(group);
     std::vector<int16_t> positions;
+    if (!hasWeight_ && !hasCompression_ && !decodedValue_.mayHaveNulls() &&
+        decodedValue_.isIdentityMapping() && rows.isAllSelected()) {
+      // Adds the flat input values as a batch.
+      const folly::Range<const double*> values(
+          decodedValue_.data<double>(), rows.size());
+      for (auto value : values) {
+        if (std::isnan(value)) {
+          VELOX_USER_FAIL("Cannot add NaN to t-digest");
+        }
+      }
+      accumulator->digest.add(positions, values);
+      return;
+    }
     rows.applyToSelected([&](vector_size_t row) {
       if (decodedValue_.isNullAt(row)) {
         return;
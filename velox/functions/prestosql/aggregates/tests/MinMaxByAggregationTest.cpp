@@ -2620,5 +2620,42 @@ TEST_F(MinMaxByTest, TimestampWithTimezone) {
         {data}, {"c1"}, {"max_by(c0, c2)", "min_by(c0, c2)"}, {expected});
   }
 }
+
+TEST_F(MinMaxByTest, varcharValuesMultipleBatches) {
+  // Values are copied once per group and batch. Rows with null comparison
+  // values are ignored and null values can win.
+  std::vector<RowVectorPtr> data = {
+      makeRowVector({
+          makeNullableFlatVector<std::string>(
+              {"long value 1", "long value 2", "long value 3", std::nullopt}),
+          makeFlatVector<int32_t>({1, 1, 2, 2}),
+          makeNullableFlatVector<int64_t>({10, 20, 5, 8}),
+      }),
+      makeRowVector({
+          makeNullableFlatVector<std::string>(
+              {"long value 5",
+               "long value 6",
+               "long value 7",
+               "long value 8",
+               "long value 9"}),
+          makeFlatVector<int32_t>({1, 1, 2, 2, 2}),
+          makeNullableFlatVector<int64_t>({15, 25, 3, 7, std::nullopt}),
+      }),
+  };
+
+  auto expected = makeRowVector({
+      makeNullableFlatVector<std::string>({"long value 6"}),
+      makeNullableFlatVector<std::string>({"long value 7"}),
+  });
+  testAggregations(data, {}, {"max_by(c0, c2)", "min_by(c0, c2)"}, {expected});
+
+  expected = makeRowVector({
+      makeFlatVector<int32_t>({1, 2}),
+      makeNullableFlatVector<std::string>({"long value 6", std::nullopt}),
+      makeNullableFlatVector<std::string>({"long value 1", "long value 7"}),
+  });
+  testAggregations(
+      data, {"c1"}, {"max_by(c0, c2)", "min_by(c0, c2)"}, {expected});
+}
 } // namespace
 } // namespace facebook::velox::aggregate::test
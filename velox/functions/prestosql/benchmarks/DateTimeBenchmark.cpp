@@ -18,6 +18,7 @@
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/type/tz/TimeZoneMap.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
@@ -123,6 +124,27 @@ class DateTimeBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  /// Runs date_trunc over TIMESTAMP WITH TIME ZONE values of 'timeZone' in
+  /// the 2000s.
+  void runDateTruncWithTimeZone(
+      const std::string& unit,
+      const std::string& timeZone) {
+    folly::BenchmarkSuspender suspender;
+    const auto zoneId = tz::getTimeZoneID(timeZone);
+    auto data = vectorMaker_.rowVector({vectorMaker_.flatVector<int64_t>(
+        10'000,
+        [&](auto row) {
+          return pack(946'684'800'000 + row * 31'557'600'000 / 10, zoneId);
+        },
+        nullptr,
+        TIMESTAMP_WITH_TIME_ZONE())});
+    auto exprSet = compileExpression(
+        fmt::format("date_trunc('{}', c0)", unit), data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
   void doRun(exec::ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -162,6 +184,16 @@ BENCHMARK(truncSecond) {
   benchmark.runDateTrunc("second");
 }
 
+BENCHMARK(truncDayWithTimeZone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runDateTruncWithTimeZone("day", "America/Los_Angeles");
+}
+
+BENCHMARK(truncHourWithTimeZone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runDateTruncWithTimeZone("hour", "America/Los_Angeles");
+}
+
 BENCHMARK(year) {
   DateTimeBenchmark benchmark;
   benchmark.run("year");
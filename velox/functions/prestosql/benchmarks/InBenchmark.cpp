@@ -73,6 +73,31 @@ class InBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  /// Runs IN over strings of 'valueLength' characters against 'numValues'
+  /// constant strings of which about half the rows match.
+  void runStrings(size_t numValues, size_t valueLength) {
+    folly::BenchmarkSuspender suspender;
+    auto makeValue = [&](auto i) {
+      auto value = fmt::format("{}", i);
+      return std::string(valueLength - std::min(valueLength, value.size()), 'x')
+          .append(value);
+    };
+    auto data = vectorMaker_.rowVector({vectorMaker_.flatVector<std::string>(
+        1'000, [&](auto row) { return makeValue(row * numValues / 500); })});
+
+    std::ostringstream inList;
+    inList << "'" << makeValue(0) << "'";
+    for (auto i = 1; i < numValues; ++i) {
+      inList << ", '" << makeValue(i) << "'";
+    }
+
+    auto sql = fmt::format("c0 IN ({})", inList.str());
+    auto exprSet = compileExpression(sql, data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 1000; i++) {
@@ -126,6 +151,21 @@ BENCHMARK_RELATIVE(in1K) {
   benchmark.run(1'000);
 }
 
+BENCHMARK(inStrings100) {
+  InBenchmark benchmark;
+  benchmark.runStrings(100, 10);
+}
+
+BENCHMARK(inStrings10K) {
+  InBenchmark benchmark;
+  benchmark.runStrings(10'000, 10);
+}
+
+BENCHMARK(inLongStrings10K) {
+  InBenchmark benchmark;
+  benchmark.runStrings(10'000, 100);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
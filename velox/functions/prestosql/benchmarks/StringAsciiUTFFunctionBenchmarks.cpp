@@ -117,6 +117,41 @@ class StringAsciiUTFFunctionBenchmark
     doRun(exprSet, rowVector);
   }
 
+  // Evaluates 'expression' over 'c0' strings of 'stringLength' characters
+  // with 'padding' spaces on both sides.
+  void runSearch(
+      const std::string& expression,
+      bool utf,
+      size_t stringLength,
+      size_t padding = 0) {
+    folly::BenchmarkSuspender suspender;
+
+    VectorFuzzer::Options opts;
+    if (utf) {
+      opts.charEncodings.clear();
+      opts.charEncodings = {
+          UTF8CharList::UNICODE_CASE_SENSITIVE,
+          UTF8CharList::EXTENDED_UNICODE,
+          UTF8CharList::MATHEMATICAL_SYMBOLS};
+    }
+
+    opts.stringLength = stringLength;
+    opts.vectorSize = 10'000;
+    VectorFuzzer fuzzer(opts, execCtx_.pool());
+    auto vector = fuzzer.fuzzFlat(VARCHAR())->asFlatVector<StringView>();
+    const std::string pad(padding, ' ');
+    auto padded = vectorMaker_.flatVector<std::string>(
+        opts.vectorSize, [&](auto row) {
+          return pad + std::string(vector->valueAt(row)) + pad;
+        });
+
+    auto rowVector = vectorMaker_.rowVector({padded});
+    auto exprSet = compileExpression(expression, rowVector->type());
+
+    suspender.dismiss();
+    doRun(exprSet, rowVector);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     uint32_t cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -175,6 +210,41 @@ BENCHMARK_RELATIVE(aciiRPad) {
   StringAsciiUTFFunctionBenchmark benchmark;
   benchmark.runLPadRPad("rpad", false);
 }
+
+BENCHMARK(utfLength) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runSearch("length(c0)", true, 100);
+}
+
+BENCHMARK_RELATIVE(asciiLength) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runSearch("length(c0)", false, 100);
+}
+
+BENCHMARK(utfStrpos) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runSearch("strpos(c0, 'xyz')", true, 100);
+}
+
+BENCHMARK_RELATIVE(asciiStrpos) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runSearch("strpos(c0, 'xyz')", false, 100);
+}
+
+BENCHMARK(asciiReplace) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runSearch("replace(c0, 'ab', 'c')", false, 100);
+}
+
+BENCHMARK(asciiSplit) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runSearch("split(c0, 'a')", false, 100);
+}
+
+BENCHMARK(asciiTrimCharacters) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runSearch("trim(c0, ' x')", false, 10, 50);
+}
 } // namespace
 
 // Preliminary release run, before ascii optimization.
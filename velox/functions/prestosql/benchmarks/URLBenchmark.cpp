@@ -190,19 +190,7 @@ class UrlBenchmark : public functions::test::FunctionBenchmarkBase {
     folly::BenchmarkSuspender suspender;
 
     size_t size = 1000;
-    std::string url;
-    auto vectorUrls = vectorMaker_.flatVector<StringView>(
-        size,
-        [&](auto row) {
-          // construct some pseudo random url
-          url = fmt::format(
-              "http://somehost{}.com:8080/somepath{}/p.php?k1={}#Refi",
-              row,
-              row % 2,
-              row % 3);
-          return StringView(url);
-        },
-        nullptr);
+    auto vectorUrls = makeUrls(size);
     auto constVector =
         BaseVector::createConstant(VARCHAR(), "k1", size, pool());
     auto rowVector = isParameter
@@ -218,6 +206,43 @@ class UrlBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, rowVector);
   }
 
+  // Extracts several parts of the same URLs, in one ExprSet if 'fused', so
+  // that the URLs are parsed once per row, or in one ExprSet per part.
+  void runUrlExtractParts(bool fused) {
+    folly::BenchmarkSuspender suspender;
+
+    const size_t size = 1000;
+    auto rowVector = vectorMaker_.rowVector({makeUrls(size)});
+    const std::vector<std::string> expressions = {
+        "url_extract_host(c0)",
+        "url_extract_path(c0)",
+        "url_extract_query(c0)",
+        "url_extract_parameter(c0, 'k1')",
+    };
+    std::vector<std::unique_ptr<ExprSet>> exprSets;
+    if (fused) {
+      exprSets.push_back(makeExprSet(expressions, rowVector->type()));
+    } else {
+      for (const auto& expression : expressions) {
+        exprSets.push_back(makeExprSet({expression}, rowVector->type()));
+      }
+    }
+    SelectivityVector rows(size);
+
+    suspender.dismiss();
+
+    uint32_t cnt = 0;
+    for (auto i = 0; i < 100; i++) {
+      for (auto& exprSet : exprSets) {
+        EvalCtx context(&execCtx_, exprSet.get(), rowVector.get());
+        std::vector<VectorPtr> results(exprSet->size());
+        exprSet->eval(rows, context, results);
+        cnt += results.size();
+      }
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     uint32_t cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -225,6 +250,36 @@ class UrlBenchmark : public functions::test::FunctionBenchmarkBase {
     }
     folly::doNotOptimizeAway(cnt);
   }
+
+ private:
+  std::unique_ptr<ExprSet> makeExprSet(
+      const std::vector<std::string>& texts,
+      const TypePtr& rowType) {
+    std::vector<core::TypedExprPtr> typedExprs;
+    for (const auto& text : texts) {
+      typedExprs.push_back(core::Expressions::inferTypes(
+          parse::DuckSqlExpressionsParser(options_).parseExpr(text),
+          rowType,
+          execCtx_.pool()));
+    }
+    return std::make_unique<ExprSet>(typedExprs, &execCtx_);
+  }
+
+  VectorPtr makeUrls(size_t size) {
+    std::string url;
+    return vectorMaker_.flatVector<StringView>(
+        size,
+        [&](auto row) {
+          // construct some pseudo random url
+          url = fmt::format(
+              "http://somehost{}.com:8080/somepath{}/p.php?k1={}#Refi",
+              row,
+              row % 2,
+              row % 3);
+          return StringView(url);
+        },
+        nullptr);
+  }
 };
 
 BENCHMARK(folly_fragment) {
@@ -297,6 +352,16 @@ BENCHMARK_RELATIVE(velox_param) {
   benchmark.runUrlExtract("url_extract_parameter", true);
 }
 
+BENCHMARK(separate_parts) {
+  UrlBenchmark benchmark;
+  benchmark.runUrlExtractParts(false);
+}
+
+BENCHMARK_RELATIVE(fused_parts) {
+  UrlBenchmark benchmark;
+  benchmark.runUrlExtractParts(true);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
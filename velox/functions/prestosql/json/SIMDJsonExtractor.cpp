@@ -43,6 +43,15 @@ namespace facebook::velox::functions {
   return *it.first->second;
 }
 
+/* static */ std::shared_ptr<SIMDJsonExtractor> SIMDJsonExtractor::tryCompile(
+    std::string_view path) {
+  std::shared_ptr<SIMDJsonExtractor> extractor(new SIMDJsonExtractor());
+  if (!extractor->tokenize(folly::trimWhitespace(path).str())) {
+    return nullptr;
+  }
+  return extractor;
+}
+
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
   thread_local static JsonPathTokenizer tokenizer;
 
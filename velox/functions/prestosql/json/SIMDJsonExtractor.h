@@ -84,6 +84,11 @@ class SIMDJsonExtractor {
   /// instance is not passed between threads.
   static SIMDJsonExtractor& getInstance(std::string_view path);
 
+  /// Returns a new extractor for 'path' or nullptr if 'path' is not a valid
+  /// JSON path. Unlike getInstance(), the caller owns the result, e.g. a
+  /// function that compiles a constant path once.
+  static std::shared_ptr<SIMDJsonExtractor> tryCompile(std::string_view path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -92,6 +97,8 @@ class SIMDJsonExtractor {
     }
   }
 
+  SIMDJsonExtractor() = default;
+
   bool tokenize(const std::string& path);
 
   template <typename TConsumer>
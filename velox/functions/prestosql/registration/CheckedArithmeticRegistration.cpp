@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/expression/FusedExpr.h"
 #include "velox/functions/lib/CheckedArithmetic.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 
@@ -26,6 +27,10 @@ void registerCheckedArithmeticFunctions(const std::string& prefix) {
   registerBinaryIntegral<CheckedModulusFunction>({prefix + "mod"});
   registerBinaryIntegral<CheckedDivideFunction>({prefix + "divide"});
   registerUnaryIntegral<CheckedNegateFunction>({prefix + "negate"});
+
+  exec::registerFusedFunction(prefix + "plus", exec::FusedOp::kPlus);
+  exec::registerFusedFunction(prefix + "minus", exec::FusedOp::kMinus);
+  exec::registerFusedFunction(prefix + "multiply", exec::FusedOp::kMultiply);
 }
 
 } // namespace facebook::velox::functions
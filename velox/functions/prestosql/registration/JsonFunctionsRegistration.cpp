@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/expression/ExprRewriteRegistry.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/types/JsonRegistration.h"
@@ -31,6 +32,16 @@ void registerJsonFunctions(const std::string& prefix) {
       {prefix + "json_extract_scalar"});
   registerFunction<JsonExtractScalarFunction, Varchar, Varchar, Varchar>(
       {prefix + "json_extract_scalar"});
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$_json_extract_scalars,
+      prefix + "$internal$json_extract_scalars");
+  expression::ExprRewriteRegistry::instance().registerExpressionSetRewrite(
+      [prefix](const auto& exprs) {
+        return rewriteJsonExtractScalars(
+            exprs,
+            prefix + "json_extract_scalar",
+            prefix + "$internal$json_extract_scalars");
+      });
 
   registerFunction<JsonArrayLengthFunction, int64_t, Json>(
       {prefix + "json_array_length"});
@@ -229,6 +229,16 @@ void registerStringFunctions(const std::string& prefix) {
       makeRe2ExtractAll);
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+  exec::registerStatefulVectorFunction(
+      "$internal$regexp_like_any", re2SearchAnySignatures(), makeRe2SearchAny);
+  expression::ExprRewriteRegistry::instance().registerRewrite(
+      [prefix](const auto& expr) {
+        return rewriteRe2SearchDisjunction(
+            expr,
+            {prefix + "regexp_like",
+             prefix + "like",
+             "$internal$regexp_like_any"});
+      });
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
@@ -22,6 +22,7 @@
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/vector/BaseVector.h"
+#include "velox/vector/FlatMapVector.h"
 #include "velox/vector/SelectivityVector.h"
 
 using namespace facebook::velox;
@@ -474,6 +475,39 @@ TEST_F(ElementAtTest, flatMapTestConstantWrapped) {
                makeFlatVector<int32_t>({1, 2})})));
 }
 
+TEST_F(ElementAtTest, flatMapTestInMap) {
+  // Values stored for keys that are not in the map must not be returned.
+  auto inMap = AlignedBuffer::allocate<bool>(4, pool(), true);
+  bits::clearBit(inMap->asMutable<uint64_t>(), 1);
+  bits::clearBit(inMap->asMutable<uint64_t>(), 3);
+  auto input = std::make_shared<FlatMapVector>(
+      pool(),
+      MAP(BIGINT(), INTEGER()),
+      nullptr,
+      4,
+      makeFlatVector<int64_t>({1, 2}),
+      std::vector<VectorPtr>{
+          makeFlatVector<int32_t>({10, 11, 12, 13}),
+          makeFlatVector<int32_t>({20, 21, 22, 23})},
+      std::vector<BufferPtr>{inMap, nullptr});
+  test::assertEqualVectors(
+      makeNullableFlatVector<int32_t>({10, std::nullopt, 12, std::nullopt}),
+      evaluate("element_at(c0, 1)", makeRowVector({input})));
+  test::assertEqualVectors(
+      makeFlatVector<int32_t>({20, 21, 22, 23}),
+      evaluate("element_at(c0, 2)", makeRowVector({input})));
+  test::assertEqualVectors(
+      makeNullableFlatVector<int32_t>({20, std::nullopt, 22, 23}),
+      evaluate(
+          "element_at(c0, c1)",
+          makeRowVector({input, makeFlatVector<int32_t>({2, 1, 1, 2})})));
+  test::assertEqualVectors(
+      makeNullableFlatVector<int32_t>({12, std::nullopt}),
+      evaluate(
+          "element_at(c0, 1)",
+          makeRowVector({wrapInDictionary(makeIndices({2, 1}), 2, input)})));
+}
+
 TEST_F(ElementAtTest, arrayWithDictionaryElements) {
   {
     auto elementsIndices = makeIndices({6, 5, 4, 3, 2, 1, 0});
@@ -1070,6 +1104,43 @@ TEST_F(ElementAtTest, stringAsKey) {
           "element_at(C0, C1)", makeRowVector({mapVector, searchVector})));
 }
 
+TEST_F(ElementAtTest, sortedKeys) {
+  // Maps with sorted keys and at least 16 keys are searched with a binary
+  // search. Each map has the even keys from 0 to 98.
+  constexpr vector_size_t kNumRows = 6;
+  constexpr vector_size_t kMapSize = 50;
+  auto keys = makeFlatVector<int64_t>(
+      kNumRows * kMapSize, [](auto row) { return row % kMapSize * 2; });
+  auto values = makeFlatVector<int64_t>(kNumRows * kMapSize, [](auto row) {
+    return row % kMapSize * 20 + row / kMapSize;
+  });
+  auto makeMaps = [&](bool sortedKeys) {
+    return std::make_shared<MapVector>(
+        pool(),
+        MAP(BIGINT(), BIGINT()),
+        nullptr,
+        kNumRows,
+        makeIndices(kNumRows, [](auto row) { return row * kMapSize; }),
+        makeIndices(kNumRows, [](auto /*row*/) { return kMapSize; }),
+        keys,
+        values,
+        std::nullopt,
+        sortedKeys);
+  };
+
+  auto searchKeys = makeFlatVector<int64_t>({0, 98, 51, -1, 100, 50});
+  auto expected = makeNullableFlatVector<int64_t>(
+      {0, 981, std::nullopt, std::nullopt, std::nullopt, 505});
+  for (const bool sortedKeys : {true, false}) {
+    SCOPED_TRACE(fmt::format("sortedKeys: {}", sortedKeys));
+    test::assertEqualVectors(
+        expected,
+        evaluate(
+            "element_at(c0, c1)",
+            makeRowVector({makeMaps(sortedKeys), searchKeys})));
+  }
+}
+
 TEST_F(ElementAtTest, mapWithComplexTypeAsKey) {
   VectorPtr mapVector, keyVector, searchVector;
   const auto expected = makeNullableFlatVector<int64_t>({1, 3, std::nullopt});
@@ -667,6 +667,58 @@ TEST_F(GeometryFunctionsTest, testStIntersects) {
       "TopologyException: side location conflict at 1 2. This can occur if the input geometry is invalid.");
 }
 
+TEST_F(GeometryFunctionsTest, constantPreparedGeometry) {
+  // A constant argument is prepared once. The results must match the per row
+  // evaluation, including for the rows that the envelopes reject.
+  auto input = makeRowVector({makeFlatVector<std::string>(
+      {"POINT (1 1)",
+       "POINT (5 5)",
+       "POINT (3 0)",
+       "POINT EMPTY",
+       "LINESTRING (1 1, 2 3)",
+       "LINESTRING (1 1, 6 1)",
+       "POLYGON ((1 1, 1 2, 2 2, 2 1, 1 1))",
+       "POLYGON ((-1 -1, -1 5, 5 5, 5 -1, -1 -1))"})});
+  const std::string polygon =
+      "ST_GeometryFromText('POLYGON ((0 0, 0 4, 4 4, 4 0, 0 0))')";
+  const std::string column = "ST_GeometryFromText(c0)";
+
+  auto assertPrepared = [&](const std::string& function,
+                            const std::vector<bool>& expected) {
+    SCOPED_TRACE(function);
+    auto prepared =
+        evaluate(fmt::format("{}({}, {})", function, polygon, column), input);
+    facebook::velox::test::assertEqualVectors(
+        makeFlatVector<bool>(expected), prepared);
+
+    const std::vector<std::string> wkts(
+        input->size(), "POLYGON ((0 0, 0 4, 4 4, 4 0, 0 0))");
+    auto perRow = evaluate(
+        fmt::format("{}(ST_GeometryFromText(c1), {})", function, column),
+        makeRowVector(
+            {input->childAt(0), makeFlatVector<std::string>(wkts)}));
+    facebook::velox::test::assertEqualVectors(perRow, prepared);
+  };
+
+  assertPrepared(
+      "ST_Contains", {true, false, false, false, true, false, true, false});
+  assertPrepared(
+      "ST_Intersects", {true, false, true, false, true, true, true, true});
+
+  // Constant on the right.
+  auto contained = evaluate(
+      fmt::format("ST_Contains({}, {})", column, polygon), input);
+  facebook::velox::test::assertEqualVectors(
+      makeFlatVector<bool>(
+          {false, false, false, false, false, false, false, true}),
+      contained);
+  auto intersects = evaluate(
+      fmt::format("ST_Intersects({}, {})", column, polygon), input);
+  facebook::velox::test::assertEqualVectors(
+      makeFlatVector<bool>({true, false, true, false, true, true, true, true}),
+      intersects);
+}
+
 TEST_F(GeometryFunctionsTest, testStOverlaps) {
   assertRelation(
       "ST_Overlaps",
@@ -1331,6 +1331,29 @@ TEST_F(JsonCastTest, toRowOfArray) {
   testCast(data, expected);
 }
 
+TEST_F(JsonCastTest, toArrayOfRow) {
+  // The fields of the ROW type are looked up once per cast and reused across
+  // the objects, which set them in any order and case or not at all.
+  auto data = makeFlatVector<std::string>(
+      {
+          R"([{"a": 1, "B": 2}, {"b": 3}, {"A": 4, "c": 5}])",
+          R"([{"b": 6, "a": 7}])",
+          R"([])",
+      },
+      JSON());
+
+  auto expected = makeArrayVector(
+      {0, 3, 4},
+      makeRowVector(
+          {"a", "b"},
+          {
+              makeNullableFlatVector<int64_t>({1, std::nullopt, 4, 7}),
+              makeNullableFlatVector<int64_t>({2, 3, std::nullopt, 6}),
+          }));
+
+  testCast(data, expected);
+}
+
 TEST_F(JsonCastTest, toRowDuplicateKey) {
   std::vector<std::optional<std::string>> jsonStrings = {
       R"({"c0": 1, "c1": 1.1})",
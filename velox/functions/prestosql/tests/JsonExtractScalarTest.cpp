@@ -251,6 +251,50 @@ TEST_F(JsonExtractScalarTest, nanJson) {
   }
 }
 
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  auto data = makeRowVector({makeNullableFlatVector<StringView>(
+      {R"({"a": 1, "b": "x", "c": [1]})",
+       R"({"a": true})",
+       R"({"a": 1)",
+       std::nullopt,
+       R"({"b": "y", "a": null})"},
+      JSON())});
+  auto exprSet = compileExpressions(
+      {"json_extract_scalar(c0, '$.a')",
+       "concat(json_extract_scalar(c0, '$.b'), '!')",
+       "json_extract_scalar(c0, '$.c')",
+       "json_extract_scalar(c0, '$.a')"},
+      asRowType(data->type()));
+  // The paths are extracted from one parse of each row.
+  ASSERT_NE(
+      exprSet->toString().find("$internal$json_extract_scalars"),
+      std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(exprSet->size());
+  exprSet->eval(rows, context, results);
+
+  auto expectedA = makeNullableFlatVector<StringView>(
+      {"1", "true", std::nullopt, std::nullopt, std::nullopt});
+  velox::test::assertEqualVectors(expectedA, results[0]);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<StringView>(
+          {"x!", std::nullopt, std::nullopt, std::nullopt, "y!"}),
+      results[1]);
+  velox::test::assertEqualVectors(
+      makeAllNullFlatVector<StringView>(data->size()), results[2]);
+  velox::test::assertEqualVectors(expectedA, results[3]);
+
+  // An invalid path is not fused and fails as usual.
+  VELOX_ASSERT_THROW(
+      evaluate<SimpleVector<StringView>>(
+          "concat(json_extract_scalar(c0, '$.a'), "
+          "json_extract_scalar(c0, '$.a['))",
+          data),
+      "Invalid JSON path");
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
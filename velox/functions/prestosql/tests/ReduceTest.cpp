@@ -322,6 +322,28 @@ TEST_F(ReduceTest, rewrites) {
     SCOPED_TRACE("if");
     testReduceRewrite(input, "if(x % 2 = 0, s + 1, s)");
   }
+  {
+    SCOPED_TRACE("greatest");
+    testReduceRewrite(input, "greatest(s, x)");
+  }
+  {
+    SCOPED_TRACE("least");
+    testReduceRewrite(input, "least(x * 2, s)");
+  }
+}
+
+TEST_F(ReduceTest, constantCapture) {
+  auto input = makeRowVector({
+      makeArrayVector<int64_t>({{1, 2, 3}, {}, {4, 5}}),
+      makeConstant<int64_t>(10, 3),
+  });
+  auto result = evaluate("reduce(c0, 0, (s, x) -> s + x * c1, s -> s)", input);
+  assertEqualVectors(makeFlatVector<int64_t>({60, 0, 90}), result);
+  result = evaluate("transform(c0, x -> x + c1)", input);
+  assertEqualVectors(
+      makeArrayVector<int64_t>({{11, 12, 13}, {}, {14, 15}}), result);
+  result = evaluate("filter(c0, x -> x > c1 - 8)", input);
+  assertEqualVectors(makeArrayVector<int64_t>({{3}, {}, {4, 5}}), result);
 }
 
 } // namespace
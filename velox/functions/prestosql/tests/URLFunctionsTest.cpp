@@ -671,5 +671,52 @@ TEST_F(URLFunctionsTest, urlDecode) {
   EXPECT_THROW(urlDecode("%1 "), VeloxUserError);
 }
 
+TEST_F(URLFunctionsTest, extractSeveralParts) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {"http://example.com:8080/a%20b?x=1&y=%41#frag",
+       "https://www.ex%61mple.org/path/to/page?y=2&x",
+       "foo bar://invalid",
+       std::nullopt,
+       "http://example.com:99999999999999999999/p?x=3",
+       "mailto:someone"})});
+  const std::vector<std::string> expressions = {
+      "url_extract_protocol(c0)",
+      "url_extract_host(c0)",
+      "concat(url_extract_path(c0), '!')",
+      "url_extract_query(c0)",
+      "url_extract_fragment(c0)",
+      "url_extract_port(c0)",
+      "url_extract_parameter(c0, 'x')",
+      "url_extract_parameter(c0, 'y')",
+      "url_extract_host(c0)",
+  };
+  auto exprSet = compileExpressions(expressions, asRowType(data->type()));
+  // The parts are extracted from one parse of each row.
+  ASSERT_NE(
+      exprSet->toString().find("$internal$url_extract_parts"),
+      std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(exprSet->size());
+  exprSet->eval(rows, context, results);
+
+  // A single part is not fused.
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    velox::test::assertEqualVectors(
+        evaluate(expressions[i], data), results[i]);
+  }
+
+  // Parts in conditionally evaluated inputs are not fused.
+  exprSet = compileExpressions(
+      {"if(url_extract_protocol(c0) = 'http', url_extract_host(c0), "
+       "url_extract_path(c0))"},
+      asRowType(data->type()));
+  ASSERT_EQ(
+      exprSet->toString().find("$internal$url_extract_parts"),
+      std::string::npos);
+}
+
 } // namespace
 } // namespace facebook::velox
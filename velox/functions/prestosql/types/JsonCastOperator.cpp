@@ -740,11 +740,58 @@ simdjson::error_code appendMapKey<TypeKind::TIMESTAMP>(
   return simdjson::INCORRECT_TYPE;
 }
 
+// Parts of the parsing of JSON into a target type that depend only on the
+// type, made once per cast instead of once per row.
+class JsonCastPlan {
+ public:
+  struct RowFields {
+    bool allFieldsAreAscii{true};
+    // Lower-case field names mapped to their indices.
+    folly::F14FastMap<std::string, int32_t> indices;
+    // True for the fields set by the JSON object being parsed.
+    std::vector<bool> isSet;
+  };
+
+  // Returns the fields of 'rowType' for parsing JSON objects into it.
+  RowFields& rowFields(const RowType& rowType) {
+    auto& fields = rowFields_[&rowType];
+    if (fields == nullptr) {
+      fields = makeRowFields(rowType);
+    }
+    return *fields;
+  }
+
+ private:
+  static std::unique_ptr<RowFields> makeRowFields(const RowType& rowType) {
+    auto fields = std::make_unique<RowFields>();
+    const auto size = rowType.size();
+    for (auto i = 0; i < size; ++i) {
+      const auto& name = rowType.nameOf(i);
+      fields->allFieldsAreAscii &=
+          functions::stringCore::isAscii(name.data(), name.size());
+    }
+    for (auto i = 0; i < size; ++i) {
+      std::string key = rowType.nameOf(i);
+      if (fields->allFieldsAreAscii) {
+        folly::toLowerAscii(key);
+      } else {
+        boost::algorithm::to_lower(key);
+      }
+      fields->indices[key] = i;
+    }
+    fields->isSet.resize(size);
+    return fields;
+  }
+
+  folly::F14FastMap<const RowType*, std::unique_ptr<RowFields>> rowFields_;
+};
+
 template <typename Input>
 struct CastFromJsonTypedImpl {
   template <TypeKind kind>
-  static simdjson::error_code apply(Input input, exec::GenericWriter& writer) {
-    return KindDispatcher<kind>::apply(input, writer);
+  static simdjson::error_code
+  apply(Input input, exec::GenericWriter& writer, JsonCastPlan& plan) {
+    return KindDispatcher<kind>::apply(input, writer, plan);
   }
 
  private:
@@ -752,7 +799,8 @@ struct CastFromJsonTypedImpl {
   // class.
   template <TypeKind kind, typename Dummy = void>
   struct KindDispatcher {
-    static simdjson::error_code apply(Input, exec::GenericWriter&) {
+    static simdjson::error_code
+    apply(Input, exec::GenericWriter&, JsonCastPlan&) {
       VELOX_NYI(
           "Casting from JSON to {} is not supported.", TypeTraits<kind>::name);
       return simdjson::error_code::UNEXPECTED_ERROR; // Make compiler happy.
@@ -763,7 +811,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::VARCHAR, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& /*plan*/) {
       SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
 
       if (isJsonType(writer.type())) {
@@ -807,7 +856,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::BOOLEAN, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& /*plan*/) {
       SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
       auto& w = writer.castTo<bool>();
       switch (type) {
@@ -849,7 +899,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::TINYINT, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& /*plan*/) {
       return castJsonToInt<int8_t>(value, writer);
     }
   };
@@ -858,7 +909,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::SMALLINT, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& /*plan*/) {
       return castJsonToInt<int16_t>(value, writer);
     }
   };
@@ -867,7 +919,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::INTEGER, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& /*plan*/) {
       return castJsonToInt<int32_t>(value, writer);
     }
   };
@@ -876,7 +929,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::BIGINT, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& /*plan*/) {
       return castJsonToInt<int64_t>(value, writer);
     }
   };
@@ -885,7 +939,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::REAL, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& /*plan*/) {
       return castJsonToFloatingPoint<float>(value, writer);
     }
   };
@@ -894,7 +949,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::DOUBLE, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& /*plan*/) {
       return castJsonToFloatingPoint<double>(value, writer);
     }
   };
@@ -903,7 +959,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::ARRAY, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& plan) {
       auto& writerTyped = writer.castTo<Array<Any>>();
       auto& elementType = writer.type()->childAt(0);
       SIMDJSON_ASSIGN_OR_RAISE(auto array, value.get_array());
@@ -918,7 +975,8 @@ struct CastFromJsonTypedImpl {
               CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
               elementType->kind(),
               element,
-              writerTyped.add_item()));
+              writerTyped.add_item(),
+              plan));
         }
       }
       return simdjson::SUCCESS;
@@ -929,7 +987,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::MAP, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& plan) {
       auto& writerTyped = writer.castTo<Map<Any, Any>>();
       auto& keyType = writer.type()->childAt(0);
       auto& valueType = writer.type()->childAt(1);
@@ -950,37 +1009,20 @@ struct CastFromJsonTypedImpl {
               CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
               valueType->kind(),
               field.value(),
-              std::get<1>(writers)));
+              std::get<1>(writers),
+              plan));
         }
       }
       return simdjson::SUCCESS;
     }
   };
 
-  static folly::F14FastMap<std::string, int32_t> makeFieldIndicesMap(
-      const RowType& rowType,
-      bool allFieldsAreAscii) {
-    folly::F14FastMap<std::string, int32_t> fieldIndices;
-    const auto size = rowType.size();
-    for (auto i = 0; i < size; ++i) {
-      std::string key = rowType.nameOf(i);
-      if (allFieldsAreAscii) {
-        folly::toLowerAscii(key);
-      } else {
-        boost::algorithm::to_lower(key);
-      }
-
-      fieldIndices[key] = i;
-    }
-
-    return fieldIndices;
-  }
-
   template <typename Dummy>
   struct KindDispatcher<TypeKind::ROW, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastPlan& plan) {
       auto& rowType = writer.type()->asRow();
       auto& writerTyped = writer.castTo<DynamicRow>();
       SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
@@ -1000,25 +1042,15 @@ struct CastFromJsonTypedImpl {
                 CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
                 rowType.childAt(i)->kind(),
                 element,
-                writerTyped.get_writer_at(i)));
+                writerTyped.get_writer_at(i),
+                plan));
           }
           ++i;
         }
       } else {
         SIMDJSON_ASSIGN_OR_RAISE(auto object, value.get_object());
-
-        // TODO Populate this mapping once, not per-row.
-        // Mapping from lower-case field names of the target RowType to their
-        // indices.
-        bool allFieldsAreAscii = true;
-        const auto size = rowType.size();
-        for (auto i = 0; i < size; ++i) {
-          const auto& name = rowType.nameOf(i);
-          allFieldsAreAscii &=
-              functions::stringCore::isAscii(name.data(), name.size());
-        }
-
-        auto fieldIndices = makeFieldIndicesMap(rowType, allFieldsAreAscii);
+        auto& fields = plan.rowFields(rowType);
+        std::fill(fields.isSet.begin(), fields.isSet.end(), false);
 
         std::string key;
         for (auto fieldResult : object) {
@@ -1028,31 +1060,33 @@ struct CastFromJsonTypedImpl {
 
             // boost::algorithm::to_lower is very slow. Use much faster
             // folly::toLowerAscii if possible.
-            if (allFieldsAreAscii) {
+            if (fields.allFieldsAreAscii) {
               folly::toLowerAscii(key);
             } else {
               boost::algorithm::to_lower(key);
             }
 
-            auto it = fieldIndices.find(key);
-            if (it != fieldIndices.end()) {
+            auto it = fields.indices.find(key);
+            if (it != fields.indices.end()) {
               const auto index = it->second;
 
-              VELOX_USER_CHECK_GE(index, 0, "Duplicate field: {}", key);
-              it->second = -1;
+              VELOX_USER_CHECK(
+                  !fields.isSet[index], "Duplicate field: {}", key);
+              fields.isSet[index] = true;
 
               SIMDJSON_TRY(VELOX_DYNAMIC_TYPE_DISPATCH(
                   CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
                   rowType.childAt(index)->kind(),
                   field.value(),
-                  writerTyped.get_writer_at(index)));
+                  writerTyped.get_writer_at(index),
+                  plan));
             }
           }
         }
 
-        for (const auto& [key, index] : fieldIndices) {
-          if (index >= 0) {
-            writerTyped.set_null_at(index);
+        for (auto i = 0; i < fields.isSet.size(); ++i) {
+          if (!fields.isSet[i]) {
+            writerTyped.set_null_at(i);
           }
         }
       }
@@ -1144,14 +1178,15 @@ struct CastFromJsonTypedImpl {
 template <TypeKind kind>
 simdjson::error_code castFromJsonOneRow(
     simdjson::padded_string_view input,
-    exec::VectorWriter<Any>& writer) {
+    exec::VectorWriter<Any>& writer,
+    JsonCastPlan& plan) {
   SIMDJSON_ASSIGN_OR_RAISE(auto doc, simdjsonParse(input));
   if (doc.is_null()) {
     writer.commitNull();
   } else {
     SIMDJSON_TRY(
         CastFromJsonTypedImpl<simdjson::ondemand::document&>::apply<kind>(
-            doc, writer.current()));
+            doc, writer.current(), plan));
     writer.commit(true);
   }
   return simdjson::SUCCESS;
@@ -1230,6 +1265,7 @@ void JsonCastOperator::castFromJson(
     maxSize = std::max(maxSize, input.size());
   });
   paddedInput_.resize(maxSize + simdjson::SIMDJSON_PADDING);
+  JsonCastPlan plan;
   context.applyToSelectedNoThrow(
       rows,
       [&](auto row) INLINE_LAMBDA {
@@ -1242,7 +1278,8 @@ void JsonCastOperator::castFromJson(
         memcpy(paddedInput_.data(), input.data(), input.size());
         simdjson::padded_string_view paddedInput(
             paddedInput_.data(), input.size(), paddedInput_.size());
-        if (auto error = castFromJsonOneRow<kind>(paddedInput, writer)) {
+        if (auto error =
+                castFromJsonOneRow<kind>(paddedInput, writer, plan)) {
           context.setVeloxExceptionError(row, errors_[error]);
           writer.commitNull();
         }
@@ -129,6 +129,37 @@ TEST_F(AggregateWindowTest, variableWidthAggregate) {
       input, "max(c2)", kOverClauses, {""}, false);
 }
 
+// Tests sliding frames that are larger than the fanout of the segment tree used
+// to evaluate them.
+TEST_F(AggregateWindowTest, slidingFrames) {
+  const std::vector<std::string> overClauses = {
+      kOverClauses[0], kOverClauses[6]};
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 50 preceding and 50 following",
+      "rows between current row and 300 following",
+      "rows between 1000 preceding and 20 preceding",
+  };
+  auto input = {
+      makeSinglePartitionVector(1'000), makeSinglePartitionVector(700)};
+  for (const auto& function : kAggregateFunctions) {
+    WindowTestBase::testWindowFunction(
+        input, function, overClauses, frameClauses);
+  }
+
+  auto size = 500;
+  auto varcharInput = {makeRowVector({
+      makeRandomInputVector(BIGINT(), size, 0.2),
+      makeRandomInputVector(SMALLINT(), size, 0.2),
+      makeRandomInputVector(VARCHAR(), size, 0.3),
+      makeRandomInputVector(VARCHAR(), size, 0.3),
+  })};
+  WindowTestBase::testWindowFunction(
+      varcharInput, "min(c2)", overClauses, frameClauses);
+  WindowTestBase::testWindowFunction(
+      varcharInput, "max(c2)", overClauses, frameClauses);
+}
+
 // Tests function with k RANGE PRECEDING (FOLLOWING) frames.
 TEST_F(AggregateWindowTest, rangeFrames) {
   auto aggregateFunctions = kAggregateFunctions;
@@ -46,10 +46,17 @@ int main(int argc, char** argv) {
                              .argumentType("bigint")
                              .build()};
   registerRemoteFunction("remote_plus", plusSignatures, metadata);
+  // Splits batches in pipelined requests of about 1KB.
+  RemoteThriftVectorFunctionMetadata pipelinedMetadata = metadata;
+  pipelinedMetadata.requestBytesTarget = 1 << 10;
+  registerRemoteFunction(
+      "remote_plus_pipelined", plusSignatures, pipelinedMetadata);
   // Registers the actual function under a different prefix. This is only
   // needed when thrift service runs in the same process.
   registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
       {param.functionPrefix + ".remote_plus"});
+  registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+      {param.functionPrefix + ".remote_plus_pipelined"});
   // register this function again, because the benchmark builder somehow doesn't
   // recognize the function registered above (remote.xxx).
   registerFunction<PlusFunction, int64_t, int64_t, int64_t>({"plus"});
@@ -94,6 +101,7 @@ int main(int argc, char** argv) {
               {fuzzer.fuzzFlat(BIGINT()), fuzzer.fuzzFlat(BIGINT())}))
       .addExpression("local_plus", "plus(c0, c1) ")
       .addExpression("remote_plus", "remote_plus(c0, c1) ")
+      .addExpression("remote_plus_pipelined", "remote_plus_pipelined(c0, c1) ")
       .withIterations(1000);
 
   // benchmark comparaing SubstrFunction running locally (same thread)
@@ -16,6 +16,7 @@
 
 #include "velox/functions/remote/client/Remote.h"
 
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
 #include "velox/functions/remote/client/RemoteVectorFunction.h"
 #include "velox/functions/remote/client/ThriftClient.h"
@@ -42,13 +43,34 @@ class RemoteThriftFunction : public RemoteVectorFunction {
     return remoteResponse;
   }
 
+  std::vector<std::unique_ptr<remote::RemoteFunctionResponse>>
+  invokeRemoteFunctions(const std::vector<remote::RemoteFunctionRequest>&
+                            requests) const override {
+    std::vector<folly::SemiFuture<remote::RemoteFunctionResponse>> futures;
+    futures.reserve(requests.size());
+    for (const auto& request : requests) {
+      futures.push_back(thriftClient_->semifuture_invokeFunction(request));
+    }
+    // Drives the event base of the client until all the responses arrive.
+    auto responses = folly::collect(std::move(futures))
+                         .via(&eventBase_)
+                         .getVia(&eventBase_);
+    std::vector<std::unique_ptr<remote::RemoteFunctionResponse>> result;
+    result.reserve(responses.size());
+    for (auto& response : responses) {
+      result.push_back(std::make_unique<remote::RemoteFunctionResponse>(
+          std::move(response)));
+    }
+    return result;
+  }
+
   std::string remoteLocationToString() const override {
     return location_.describe();
   }
 
  private:
   folly::SocketAddress location_;
-  folly::EventBase eventBase_;
+  mutable folly::EventBase eventBase_;
 
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
 };
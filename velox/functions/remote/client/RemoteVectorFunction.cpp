@@ -35,6 +35,8 @@ RemoteVectorFunction::RemoteVectorFunction(
     const std::vector<exec::VectorFunctionArg>& inputArgs,
     const RemoteVectorFunctionMetadata& metadata)
     : functionName_(functionName),
+      requestBytesTarget_(metadata.requestBytesTarget),
+      maxRequestsInFlight_(std::max(1, metadata.maxRequestsInFlight)),
       serdeFormat_(metadata.serdeFormat),
       serde_(getSerde(serdeFormat_)) {
   std::vector<TypePtr> types;
@@ -63,6 +65,28 @@ void RemoteVectorFunction::apply(
   }
 }
 
+std::vector<std::unique_ptr<remote::RemoteFunctionResponse>>
+RemoteVectorFunction::invokeRemoteFunctions(
+    const std::vector<remote::RemoteFunctionRequest>& requests) const {
+  std::vector<std::unique_ptr<remote::RemoteFunctionResponse>> responses;
+  responses.reserve(requests.size());
+  for (const auto& request : requests) {
+    responses.push_back(invokeRemoteFunction(request));
+  }
+  return responses;
+}
+
+vector_size_t RemoteVectorFunction::rowsPerRequest(
+    const RowVector& input) const {
+  const auto numRows = input.size();
+  if (requestBytesTarget_ == 0 || numRows == 0) {
+    return numRows;
+  }
+  const auto bytes = std::max<uint64_t>(1, input.estimateFlatSize());
+  return static_cast<vector_size_t>(std::clamp<uint64_t>(
+      requestBytesTarget_ * numRows / bytes, 1, numRows));
+}
+
 void RemoteVectorFunction::applyRemote(
     const SelectivityVector& rows,
     std::vector<VectorPtr>& args,
@@ -85,35 +109,89 @@ void RemoteVectorFunction::applyRemote(
   functionHandle->name() = functionName_;
   functionHandle->returnType() = serializeType(outputType);
   functionHandle->argumentTypes() = serializedInputTypes_;
+  request.inputs()->pageFormat() = serdeFormat_;
 
-  auto requestInputs = request.inputs();
-  requestInputs->rowCount() = remoteRowVector->size();
-  requestInputs->pageFormat() = serdeFormat_;
-
-  // TODO: serialize only active rows.
-  requestInputs->payload() = rowVectorToIOBuf(
-      remoteRowVector, rows.end(), *context.pool(), serde_.get());
-
-  std::unique_ptr<remote::RemoteFunctionResponse> remoteResponse;
-
-  // Invoke function that communicates with the remote host.
-  try {
-    remoteResponse = invokeRemoteFunction(request);
-  } catch (const std::exception& e) {
-    VELOX_FAIL(
-        "Error while executing remote function '{}' at '{}': {}",
-        functionName_,
-        remoteLocationToString(),
-        e.what());
+  const auto numRows = remoteRowVector->size();
+  const auto batchSize = rowsPerRequest(*remoteRowVector);
+  if (batchSize < numRows) {
+    result = BaseVector::create(outputType, numRows, context.pool());
   }
 
-  const auto& remoteResult = remoteResponse->result().value();
+  // Sends up to 'maxRequestsInFlight_' requests at a time, each with the next
+  // 'batchSize' rows.
+  std::vector<remote::RemoteFunctionRequest> requests;
+  std::vector<vector_size_t> offsets;
+  requests.reserve(maxRequestsInFlight_);
+  offsets.reserve(maxRequestsInFlight_);
+  vector_size_t offset = 0;
+  do {
+    requests.clear();
+    offsets.clear();
+    do {
+      const auto size = std::min(batchSize, numRows - offset);
+      auto requestInputs = requests.emplace_back(request).inputs();
+      requestInputs->rowCount() = size;
+
+      // TODO: serialize only active rows.
+      requestInputs->payload() = size == numRows
+          ? rowVectorToIOBuf(
+                remoteRowVector, numRows, *context.pool(), serde_.get())
+          : rowVectorToIOBuf(
+                std::static_pointer_cast<RowVector>(
+                    remoteRowVector->slice(offset, size)),
+                *context.pool(),
+                serde_.get());
+      offsets.push_back(offset);
+      offset += size;
+    } while (requests.size() < maxRequestsInFlight_ && offset < numRows);
+
+    std::vector<std::unique_ptr<remote::RemoteFunctionResponse>> responses;
+
+    // Invoke function that communicates with the remote host.
+    try {
+      responses = invokeRemoteFunctions(requests);
+    } catch (const std::exception& e) {
+      VELOX_FAIL(
+          "Error while executing remote function '{}' at '{}': {}",
+          functionName_,
+          remoteLocationToString(),
+          e.what());
+    }
+    VELOX_CHECK_EQ(responses.size(), requests.size());
+    for (auto i = 0; i < responses.size(); ++i) {
+      readResponse(
+          *responses[i],
+          offsets[i],
+          batchSize == numRows,
+          outputType,
+          context,
+          result);
+    }
+  } while (offset < numRows);
+}
+
+void RemoteVectorFunction::readResponse(
+    const remote::RemoteFunctionResponse& response,
+    vector_size_t offset,
+    bool allRows,
+    const TypePtr& outputType,
+    exec::EvalCtx& context,
+    VectorPtr& result) const {
+  const auto& remoteResult = response.result().value();
   auto outputRowVector = IOBufToRowVector(
       remoteResult.payload().value(),
       ROW({outputType}),
       *context.pool(),
       serde_.get());
-  result = outputRowVector->childAt(0);
+  if (allRows) {
+    result = outputRowVector->childAt(0);
+  } else {
+    result->copy(
+        outputRowVector->childAt(0).get(),
+        offset,
+        0,
+        outputRowVector->size());
+  }
 
   if (auto errorPayload = remoteResult.errorPayload()) {
     auto errorsRowVector = IOBufToRowVector(
@@ -131,7 +209,7 @@ void RemoteVectorFunction::applyRemote(
       try {
         throw std::runtime_error(std::string(errorsVector->valueAt(i)));
       } catch (const std::exception&) {
-        context.setError(i, std::current_exception());
+        context.setError(offset + i, std::current_exception());
       }
     });
   }
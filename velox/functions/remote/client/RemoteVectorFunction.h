@@ -26,6 +26,14 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
   /// The serialization format to be used to send batches of data to the remote
   /// process.
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Target size in bytes of the rows sent in one request. A batch larger
+  /// than this is split in several requests that are sent without waiting for
+  /// the responses of the previous ones. 0 means one request per batch.
+  uint64_t requestBytesTarget{0};
+
+  /// Maximum number of requests of a batch in flight at a time.
+  int32_t maxRequestsInFlight{4};
 };
 
 /// Main vector function logic. Needs to be extended with the transport-specific
@@ -49,6 +57,13 @@ class RemoteVectorFunction : public exec::VectorFunction {
   virtual std::unique_ptr<remote::RemoteFunctionResponse> invokeRemoteFunction(
       const remote::RemoteFunctionRequest& request) const = 0;
 
+  // Sends 'requests' and returns their responses in the same order. The
+  // requests are independent of each other and may be in flight at the same
+  // time. The default implementation sends one request at a time.
+  virtual std::vector<std::unique_ptr<remote::RemoteFunctionResponse>>
+  invokeRemoteFunctions(
+      const std::vector<remote::RemoteFunctionRequest>& requests) const;
+
   // A string representation of the remote host being connected to. Useful for
   // exception messages.
   virtual std::string remoteLocationToString() const = 0;
@@ -61,7 +76,23 @@ class RemoteVectorFunction : public exec::VectorFunction {
       exec::EvalCtx& context,
       VectorPtr& result) const;
 
+  // Returns the number of rows of 'input' to send in one request.
+  vector_size_t rowsPerRequest(const RowVector& input) const;
+
+  // Copies the rows of 'response' into 'result' starting at 'offset', or sets
+  // 'result' to them if 'allRows' is true. Sets the errors of the rows that
+  // failed in 'context'.
+  void readResponse(
+      const remote::RemoteFunctionResponse& response,
+      vector_size_t offset,
+      bool allRows,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const;
+
   const std::string functionName_;
+  const uint64_t requestBytesTarget_;
+  const int32_t maxRequestsInFlight_;
 
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
@@ -114,6 +114,15 @@ class RemoteFunctionTest
                               .build()};
     registerRemoteFunction("remote_divide", divSignatures, metadata);
 
+    // Sends about 4 rows per request with 2 requests in flight.
+    RemoteThriftVectorFunctionMetadata batchedMetadata = metadata;
+    batchedMetadata.requestBytesTarget = 64;
+    batchedMetadata.maxRequestsInFlight = 2;
+    registerRemoteFunction(
+        "remote_plus_batched", plusSignatures, batchedMetadata);
+    registerRemoteFunction(
+        "remote_divide_batched", divSignatures, batchedMetadata);
+
     auto substrSignatures = {exec::FunctionSignatureBuilder()
                                  .returnType("varchar")
                                  .argumentType("varchar")
@@ -133,8 +142,12 @@ class RemoteFunctionTest
         {params.functionPrefix + ".remote_plus"});
     registerFunction<FailFunction, UnknownValue, int32_t, Varchar>(
         {params.functionPrefix + ".remote_fail"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {params.functionPrefix + ".remote_plus_batched"});
     registerFunction<CheckedDivideFunction, double, double, double>(
         {params.functionPrefix + ".remote_divide"});
+    registerFunction<CheckedDivideFunction, double, double, double>(
+        {params.functionPrefix + ".remote_divide_batched"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
         {params.functionPrefix + ".remote_substr"});
     registerFunction<OpaqueTypeFunction, int64_t, std::shared_ptr<Foo>>(
@@ -155,6 +168,26 @@ TEST_P(RemoteFunctionTest, simple) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, batchedRequests) {
+  auto inputVector = makeFlatVector<int64_t>(101, [](auto row) { return row; });
+  auto results = evaluate<SimpleVector<int64_t>>(
+      "remote_plus_batched(c0, c0)", makeRowVector({inputVector}));
+  auto expected =
+      makeFlatVector<int64_t>(101, [](auto row) { return row * 2; });
+  assertEqualVectors(expected, results);
+
+  // The errors of each request are set on the rows of the request.
+  auto numerators = makeFlatVector<double>(50, [](auto row) { return row; });
+  auto denominators = makeFlatVector<double>(
+      50, [](auto row) { return row % 7 == 3 ? 0 : 1; });
+  auto divided = evaluate<SimpleVector<double>>(
+      "TRY(remote_divide_batched(c0, c1))",
+      makeRowVector({numerators, denominators}));
+  auto expectedDivided = makeFlatVector<double>(
+      50, [](auto row) { return row; }, [](auto row) { return row % 7 == 3; });
+  assertEqualVectors(expectedDivided, divided);
+}
+
 TEST_P(RemoteFunctionTest, string) {
   auto inputVector =
       makeFlatVector<StringView>({"hello", "my", "remote", "world"});
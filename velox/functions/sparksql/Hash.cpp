@@ -302,6 +302,16 @@ void hashSimdTyped(
   const ArgType* __restrict rawA =
       args[hashIdx]->asUnchecked<FlatVector<ArgType>>()->rawValues();
   auto* __restrict rawResult = result.template mutableRawValues<ReturnType>();
+  if (rows->isAllSelected()) {
+    // A plain loop over the range has no per-row bit scanning, so the inlined
+    // fixed width kernels are unrolled and vectorized by the compiler, hashing
+    // several rows of the column per instruction.
+    const auto end = rows->end();
+    for (auto row = rows->begin(); row < end; ++row) {
+      rawResult[row] = hashOne<HashClass>(rawA[row], rawResult[row]);
+    }
+    return;
+  }
   rows->applyToSelected([&](auto row) {
     rawResult[row] = hashOne<HashClass>(rawA[row], rawResult[row]);
   });
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/common/base/BloomFilter.h"
+#include "velox/common/base/SplitBlockBloomFilter.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/functions/Macros.h"
 
@@ -30,13 +31,30 @@ struct BloomFilterMightContainFunction {
       const core::QueryConfig&,
       const arg_type<Varbinary>* serialized,
       const arg_type<int64_t>*) {
-    if (serialized != nullptr) {
-      bloomFilter_.merge(serialized->str().c_str());
+    if (serialized == nullptr) {
+      return;
     }
+    // bloom_filter_agg produces a split block bloom filter if
+    // QueryConfig::kSparkBloomFilterSplitBlockEnabled is set. The first byte
+    // is the version of either form.
+    if (serialized->size() > 0 &&
+        serialized->data()[0] == SplitBlockBloomFilter::kSerializedVersion) {
+      splitBlockBlocks_.resize(
+          SplitBlockBloomFilter::serializedNumBlocks(serialized->data()));
+      SplitBlockBloomFilter::deserialize(
+          serialized->data(), splitBlockBlocks_);
+      splitBlockFilter_.emplace(splitBlockBlocks_);
+      return;
+    }
+    bloomFilter_.merge(serialized->str().c_str());
   }
 
   FOLLY_ALWAYS_INLINE void
   call(bool& result, const arg_type<Varbinary>&, const int64_t& input) {
+    if (splitBlockFilter_.has_value()) {
+      result = splitBlockFilter_->mayContain(folly::hasher<int64_t>()(input));
+      return;
+    }
     result = bloomFilter_.isSet()
         ? bloomFilter_.mayContain(folly::hasher<int64_t>()(input))
         : false;
@@ -44,6 +62,8 @@ struct BloomFilterMightContainFunction {
 
  private:
   BloomFilter<Allocator> bloomFilter_;
+  std::vector<SplitBlockBloomFilter::Block> splitBlockBlocks_;
+  std::optional<SplitBlockBloomFilter> splitBlockFilter_;
 };
 
 } // namespace facebook::velox::functions::sparksql
@@ -17,6 +17,7 @@
 #include "velox/functions/sparksql/aggregates/BloomFilterAggAggregate.h"
 
 #include "velox/common/base/BloomFilter.h"
+#include "velox/common/base/SplitBlockBloomFilter.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/vector/FlatVector.h"
@@ -58,6 +59,57 @@ struct BloomFilterAccumulator {
   BloomFilter<StlAllocator<uint64_t>> bloomFilter;
 };
 
+// Accumulator for a split block bloom filter of about the same size as the
+// BloomFilter for the same capacity. Used if
+// QueryConfig::kSparkBloomFilterSplitBlockEnabled is set.
+struct SplitBlockBloomFilterAccumulator {
+  using Block = SplitBlockBloomFilter::Block;
+
+  explicit SplitBlockBloomFilterAccumulator(HashStringAllocator* allocator)
+      : blocks{AlignedStlAllocator<Block, alignof(Block)>(allocator)} {}
+
+  int32_t serializedSize() const {
+    return SplitBlockBloomFilter::serializedSize(blocks.size());
+  }
+
+  void serialize(char* output) const {
+    filter->serialize(output);
+  }
+
+  void mergeWith(StringView& serialized) {
+    if (!initialized()) {
+      allocate(SplitBlockBloomFilter::serializedNumBlocks(serialized.data()));
+    }
+    filter->merge(serialized.data());
+  }
+
+  bool initialized() const {
+    return filter.has_value();
+  }
+
+  void init(int32_t capacity) {
+    if (!initialized()) {
+      // BloomFilter uses 16 bits per value of capacity.
+      allocate(std::max<int64_t>(
+          1, bits::divRoundUp(capacity * 16L, 8 * sizeof(Block))));
+    }
+  }
+
+  void insert(int64_t value) {
+    filter->insert(folly::hasher<int64_t>()(value));
+  }
+
+  std::vector<Block, AlignedStlAllocator<Block, alignof(Block)>> blocks;
+  std::optional<SplitBlockBloomFilter> filter;
+
+ private:
+  void allocate(int64_t numBlocks) {
+    blocks.resize(numBlocks);
+    filter.emplace(std::span<Block>(blocks.data(), blocks.size()));
+  }
+};
+
+template <typename TAccumulator>
 class BloomFilterAggAggregate : public exec::Aggregate {
  public:
   explicit BloomFilterAggAggregate(
@@ -69,7 +121,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
         maxNumBits_(config.sparkBloomFilterMaxNumBits()) {}
 
   int32_t accumulatorFixedWidthSize() const override {
-    return sizeof(BloomFilterAccumulator);
+    return sizeof(TAccumulator);
   }
 
   bool isFixedSize() const override {
@@ -98,7 +150,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
       }
       auto group = groups[row];
       auto tracker = trackRowSize(group);
-      auto accumulator = value<BloomFilterAccumulator>(group);
+      auto accumulator = value<TAccumulator>(group);
       accumulator->init(capacity_);
       accumulator->insert(decodedRaw_.valueAt<int64_t>(row));
     });
@@ -118,7 +170,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
       auto group = groups[row];
       auto tracker = trackRowSize(group);
       auto serialized = decodedIntermediate_.valueAt<StringView>(row);
-      auto accumulator = value<BloomFilterAccumulator>(group);
+      auto accumulator = value<TAccumulator>(group);
       accumulator->mergeWith(serialized);
     });
   }
@@ -131,7 +183,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
     decodeArguments(rows, args);
     computeCapacity();
     auto tracker = trackRowSize(group);
-    auto accumulator = value<BloomFilterAccumulator>(group);
+    auto accumulator = value<TAccumulator>(group);
     accumulator->init(capacity_);
     if (decodedRaw_.isConstantMapping()) {
       // All values are same, just do for the first.
@@ -156,7 +208,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
     VELOX_CHECK_EQ(args.size(), 1);
     decodedIntermediate_.decode(*args[0], rows);
     auto tracker = trackRowSize(group);
-    auto accumulator = value<BloomFilterAccumulator>(group);
+    auto accumulator = value<TAccumulator>(group);
     rows.applyToSelected([&](auto row) {
       if (UNLIKELY(decodedIntermediate_.isNullAt(row))) {
         return;
@@ -176,7 +228,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
     char* rawBuffer = flatResult->getRawStringBufferWithSpace(totalSize);
     for (vector_size_t i = 0; i < numGroups; ++i) {
       auto group = groups[i];
-      auto accumulator = value<BloomFilterAccumulator>(group);
+      auto accumulator = value<TAccumulator>(group);
       if (UNLIKELY(!accumulator->initialized())) {
         flatResult->setNull(i, true);
         continue;
@@ -202,7 +254,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
       folly::Range<const vector_size_t*> indices) override {
     setAllNulls(groups, indices);
     for (auto i : indices) {
-      new (groups[i] + offset_) BloomFilterAccumulator(allocator_);
+      new (groups[i] + offset_) TAccumulator(allocator_);
     }
   }
 
@@ -240,7 +292,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
     int32_t totalSize = 0;
     for (vector_size_t i = 0; i < numGroups; ++i) {
       auto group = groups[i];
-      auto accumulator = value<BloomFilterAccumulator>(group);
+      auto accumulator = value<TAccumulator>(group);
       if (UNLIKELY(!accumulator->initialized())) {
         continue;
       }
@@ -320,7 +372,14 @@ exec::AggregateRegistrationResult registerBloomFilterAggAggregate(
           const std::vector<TypePtr>& /* argTypes */,
           const TypePtr& resultType,
           const core::QueryConfig& config) -> std::unique_ptr<exec::Aggregate> {
-        return std::make_unique<BloomFilterAggAggregate>(resultType, config);
+        if (config.sparkBloomFilterSplitBlockEnabled()) {
+          return std::make_unique<
+              BloomFilterAggAggregate<SplitBlockBloomFilterAccumulator>>(
+              resultType, config);
+        }
+        return std::make_unique<
+            BloomFilterAggAggregate<BloomFilterAccumulator>>(
+            resultType, config);
       },
       withCompanionFunctions,
       overwrite);
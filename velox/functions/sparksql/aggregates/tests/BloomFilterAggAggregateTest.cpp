@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/BloomFilter.h"
+#include "velox/common/base/SplitBlockBloomFilter.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -105,4 +106,26 @@ TEST_F(BloomFilterAggAggregateTest, config) {
   EXPECT_FALSE(
       expected[0]->childAt(0)->equalValueAt(actual->childAt(0).get(), 0, 0));
 }
+
+TEST_F(BloomFilterAggAggregateTest, splitBlock) {
+  auto vectors = {makeRowVector({makeFlatVector<int64_t>(
+      100, [](vector_size_t row) { return row % 9; })})};
+
+  // 64 bits fit in one block.
+  std::vector<SplitBlockBloomFilter::Block> blocks(1);
+  SplitBlockBloomFilter filter(blocks);
+  for (auto i = 0; i < 9; ++i) {
+    filter.insert(folly::hasher<int64_t>()(i));
+  }
+  std::string data(SplitBlockBloomFilter::serializedSize(blocks.size()), '\0');
+  filter.serialize(data.data());
+  auto expected = {
+      makeRowVector({makeConstant(StringView(data), 1, VARBINARY())})};
+  testAggregations(
+      vectors,
+      {},
+      {"bloom_filter_agg(c0, 5, 64)"},
+      expected,
+      {{core::QueryConfig::kSparkBloomFilterSplitBlockEnabled, "true"}});
+}
 } // namespace facebook::velox::functions::aggregate::sparksql::test
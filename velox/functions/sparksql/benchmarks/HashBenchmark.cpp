@@ -59,6 +59,21 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Shuffle partitioning hashes several columns into one value per row.
+  for (auto nullRatio : {0.0, 0.25}) {
+    benchmarkBuilder
+        .addBenchmarkSet(
+            fmt::format("hash#multiColumn#{}\%nulls", nullRatio * 100),
+            ROW({"c0", "c1", "c2", "c3"},
+                {INTEGER(), BIGINT(), DOUBLE(), VARCHAR()}))
+        .withFuzzerOptions({.vectorSize = 4096, .nullRatio = nullRatio})
+        .addExpression("hash", "hash(c0, c1, c2, c3)")
+        .addExpression("xxhash64", "xxhash64(c0, c1, c2, c3)")
+        .addExpression("hash_fixed_width", "hash(c0, c1, c2)")
+        .addExpression("xxhash64_fixed_width", "xxhash64(c0, c1, c2)")
+        .withIterations(100);
+  }
+
   benchmarkBuilder.registerBenchmarks();
   folly::runBenchmarks();
   return 0;
@@ -16,6 +16,7 @@
 
 #include "velox/functions/sparksql/MightContain.h"
 #include "velox/common/base/BloomFilter.h"
+#include "velox/common/base/SplitBlockBloomFilter.h"
 #include "velox/core/Expressions.h"
 #include "velox/functions/sparksql/tests/SparkFunctionBaseTest.h"
 
@@ -87,6 +88,32 @@ TEST_F(MightContainTest, basic) {
   testMightContain(serialized, values, expected);
 }
 
+TEST_F(MightContainTest, splitBlock) {
+  constexpr int32_t kSize = 1'000;
+  std::vector<SplitBlockBloomFilter::Block> blocks(
+      SplitBlockBloomFilter::numBlocks(kSize, 0.01));
+  SplitBlockBloomFilter filter(blocks);
+  for (auto i = 0; i < kSize; ++i) {
+    filter.insert(folly::hasher<int64_t>()(i));
+  }
+  std::string serialized(
+      SplitBlockBloomFilter::serializedSize(blocks.size()), '\0');
+  filter.serialize(serialized.data());
+
+  auto value =
+      makeFlatVector<int64_t>(kSize, [](vector_size_t row) { return row; });
+  testMightContain(serialized, value, makeConstant(true, kSize));
+
+  // Values that were not inserted give the same answer as the original
+  // filter, including its false positives.
+  auto valueNotContain = makeFlatVector<int64_t>(
+      kSize, [](vector_size_t row) { return row + 123451; });
+  auto expected = makeFlatVector<bool>(kSize, [&](vector_size_t row) {
+    return filter.mayContain(folly::hasher<int64_t>()(row + 123451));
+  });
+  testMightContain(serialized, valueNotContain, expected);
+}
+
 TEST_F(MightContainTest, nullBloomFilter) {
   auto value = makeFlatVector<int64_t>({2, 4});
   auto expected = makeNullConstant(TypeKind::BOOLEAN, value->size());
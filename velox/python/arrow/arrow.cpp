@@ -29,6 +29,68 @@
 
 namespace py = pybind11;
 
+namespace {
+
+// Exports a row vector as a record batch, with the same zero copy modes as
+// to_arrow().
+py::object toRecordBatch(
+    facebook::velox::py::PyVector& vector,
+    bool zeroCopy,
+    facebook::velox::memory::MemoryPool* pool) {
+  if (!vector.vector()->type()->isRow()) {
+    throw std::runtime_error(
+        "Only row vectors can be converted to an Arrow RecordBatch.");
+  }
+  ArrowSchema schema;
+  ArrowArray data;
+  ArrowOptions options;
+  options.exportToStringView = zeroCopy;
+  options.exportToListView = zeroCopy;
+  facebook::velox::exportToArrow(vector.vector(), schema, options);
+  facebook::velox::exportToArrow(vector.vector(), data, pool, options);
+
+  auto batch = *arrow::ImportRecordBatch(&data, &schema);
+  return py::reinterpret_steal<py::object>(arrow::py::wrap_batch(batch));
+}
+
+// Yields one pyarrow.RecordBatch per vector of an iterator, e.g. the one
+// returned by LocalRunner.execute(). Each vector is pulled from the input and
+// converted only when the next batch is requested, so the output of a query
+// is never materialized as a whole.
+class RecordBatchIterator {
+ public:
+  RecordBatchIterator(
+      py::iterator input,
+      bool zeroCopy,
+      facebook::velox::memory::MemoryPool* pool)
+      : input_(std::move(input)), zeroCopy_(zeroCopy), pool_(pool) {}
+
+  RecordBatchIterator& iter() {
+    return *this;
+  }
+
+  py::object next() {
+    // Not using the increment of py::iterator since it fetches the next item
+    // ahead, which would wait for the next vector before returning this one.
+    auto item = py::reinterpret_steal<py::object>(PyIter_Next(input_.ptr()));
+    if (!item) {
+      if (PyErr_Occurred()) {
+        throw py::error_already_set();
+      }
+      throw py::stop_iteration();
+    }
+    return toRecordBatch(
+        item.cast<facebook::velox::py::PyVector&>(), zeroCopy_, pool_);
+  }
+
+ private:
+  py::iterator input_;
+  const bool zeroCopy_;
+  facebook::velox::memory::MemoryPool* const pool_;
+};
+
+} // namespace
+
 /// This module adds two functions `to_velox()` and `to_arrow()` that allow the
 /// conversion between Velox Vectors and Arrow Arrays from a Python program. It
 /// works by extracting the Arrow C structures from the Arrow C++ Array, then
@@ -96,22 +158,33 @@ Converts an arrow object to a velox vector.
   /// bridge.
   m.def(
       "to_arrow",
-      [](velox::py::PyVector& vector) {
+      [](velox::py::PyVector& vector, bool zeroCopy) {
         ArrowSchema schema;
         ArrowArray data;
 
-        velox::exportToArrow(vector.vector(), schema);
-        velox::exportToArrow(vector.vector(), data, leafPool.get());
+        // Strings and arrays are exported as views into the Velox buffers,
+        // which the Arrow array keeps alive until it is released. Dictionary
+        // and constant vectors are passed through as dictionaries and run-end
+        // encoded arrays regardless of the mode.
+        ArrowOptions options;
+        options.exportToStringView = zeroCopy;
+        options.exportToListView = zeroCopy;
+        velox::exportToArrow(vector.vector(), schema, options);
+        velox::exportToArrow(vector.vector(), data, leafPool.get(), options);
 
         auto arrowType = *arrow::ImportType(&schema);
         auto arrowArray = *arrow::ImportArray(&data, arrowType);
         return py::reinterpret_steal<py::object>(
             arrow::py::wrap_array(arrowArray));
       },
+      py::arg("vector"),
+      py::arg("zero_copy") = false,
       R"pbdoc(
 Converts a velox vector to an arrow object.
 
 :param vector: Input arrow object.
+:param zero_copy: Export strings as string views and arrays as list views,
+    so that no string or array element is copied.
 
 :examples:
 
@@ -120,6 +193,60 @@ Converts a velox vector to an arrow object.
     >>> import pyvelox.legacy as pv
     >>> vec = pv.from_list([1, 2, 3, 4, 5])
     >>> arrow = to_arrow(vec)
+    >>> arrow = to_arrow(vec, zero_copy=True)
+
+)pbdoc");
+
+  /// Converts a pyvelox.vector.Vector of ROW type to a pyarrow.RecordBatch.
+  m.def(
+      "to_arrow_batch",
+      [](velox::py::PyVector& vector, bool zeroCopy) {
+        return toRecordBatch(vector, zeroCopy, leafPool.get());
+      },
+      py::arg("vector"),
+      py::arg("zero_copy") = false,
+      R"pbdoc(
+Converts a velox row vector to an arrow record batch.
+
+:param vector: Input velox vector of ROW type.
+:param zero_copy: Export strings as string views and arrays as list views,
+    so that no string or array element is copied.
+
+)pbdoc");
+
+  py::class_<RecordBatchIterator>(m, "RecordBatchIterator")
+      .def("__next__", &RecordBatchIterator::next)
+      .def(
+          "__iter__",
+          &RecordBatchIterator::iter,
+          py::return_value_policy::reference_internal);
+
+  m.def(
+      "to_arrow_batches",
+      [](py::iterable vectors, bool zeroCopy) {
+        return RecordBatchIterator(
+            py::iter(vectors), zeroCopy, leafPool.get());
+      },
+      py::arg("vectors"),
+      py::arg("zero_copy") = false,
+      // Keep the input iterable alive while the batches are consumed.
+      py::keep_alive<0, 1>(),
+      R"pbdoc(
+Lazily converts an iterable of velox row vectors, such as the iterator
+returned by LocalRunner.execute(), into an iterator of arrow record batches.
+Each batch is converted when it is requested, so that the query produces
+its output while it is being consumed.
+
+:param vectors: Iterable of velox vectors of ROW type.
+:param zero_copy: Export strings as string views and arrays as list views,
+    so that no string or array element is copied.
+
+:examples:
+
+.. doctest::
+
+    >>> for batch in to_arrow_batches(runner.execute(), zero_copy=True):
+    ...     process(batch)
 
 )pbdoc");
 }
@@ -14,8 +14,14 @@
 
 # pyre-unsafe
 
+from typing import Iterable, Iterator
+
 from pyvelox.vector import Vector
-from pyarrow import Array
+from pyarrow import Array, RecordBatch
 
 def to_velox(array: Array) -> Vector: ...
-def to_arrow(vector: Vector) -> Array: ...
+def to_arrow(vector: Vector, zero_copy: bool = False) -> Array: ...
+def to_arrow_batch(vector: Vector, zero_copy: bool = False) -> RecordBatch: ...
+def to_arrow_batches(
+    vectors: Iterable[Vector], zero_copy: bool = False
+) -> Iterator[RecordBatch]: ...
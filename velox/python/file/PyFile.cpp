@@ -43,6 +43,37 @@ std::string PyFile::toString() const {
   return fmt::format("{} ({})", filePath_, fileFormat_);
 }
 
+uint64_t PyFile::size() const {
+  return filesystems::getFileSystem(filePath_, nullptr)
+      ->openFileForRead(filePath_)
+      ->size();
+}
+
+// static
+std::vector<PyFile> PyFile::listFiles(
+    const std::string& directory,
+    const std::string& formatString) {
+  const auto format = toFileFormat(formatString);
+  auto fileSystem = filesystems::getFileSystem(directory, nullptr);
+  auto paths = fileSystem->list(directory);
+  std::sort(paths.begin(), paths.end());
+
+  std::vector<PyFile> files;
+  for (const auto& path : paths) {
+    const auto slash = path.find_last_of('/');
+    const auto name =
+        slash == std::string::npos ? path : path.substr(slash + 1);
+    if (name.empty() || name[0] == '.' || name[0] == '_') {
+      continue;
+    }
+    if (fileSystem->isDirectory(path)) {
+      continue;
+    }
+    files.emplace_back(path, format);
+  }
+  return files;
+}
+
 PyType PyFile::getSchema() {
   // If the schema was read yet, we will need to open the file and read its
   // metadata.
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
 #include "velox/dwio/common/Options.h"
 #include "velox/python/type/PyType.h"
 
@@ -67,6 +69,16 @@ class PyFile {
     return PyFile(filePath, dwio::common::FileFormat::TEXT);
   }
 
+  /// Returns the size of the file in bytes. Opens the file.
+  uint64_t size() const;
+
+  /// Returns the files directly under 'directory', sorted by path and all in
+  /// 'formatString' format. Subdirectories and hidden files, whose names start
+  /// with '.' or '_' like '_SUCCESS', are skipped.
+  static std::vector<PyFile> listFiles(
+      const std::string& directory,
+      const std::string& formatString);
+
   bool equals(const PyFile& other) const {
     return filePath_ == other.filePath_ && fileFormat_ == other.fileFormat_;
   }
@@ -53,6 +53,25 @@ PYBIND11_MODULE(file, m) {
       .def("get_schema", &velox::py::PyFile::getSchema, py::doc(R"(
         Returns the schema from a given file. This function will open and
         read metadata from the file using the corresponding file reader.
+      )"))
+      .def("size", &velox::py::PyFile::size, py::doc(R"(
+        Returns the size of the file in bytes.
+      )"));
+
+  m.def(
+      "list_files",
+      &velox::py::PyFile::listFiles,
+      py::arg("directory"),
+      py::arg("format_str"),
+      py::doc(R"(
+        Returns File objects for the files directly under a directory, sorted
+        by path. Subdirectories and hidden files (names starting with '.' or
+        '_') are skipped.
+
+        Args:
+          directory: The directory path.
+          format_str: A string containing the lowercase name of the format
+                      of all the files.
       )"));
 
   m.def("PARQUET", &velox::py::PyFile::createParquet);
@@ -14,11 +14,16 @@
 
 # pyre-unsafe
 
+from typing import List
+
 from pyvelox.type import Type
 
 class File:
     def __init__(self, path: str, format_str: str) -> None: ...
     def get_schema(self) -> Type: ...
+    def size(self) -> int: ...
+
+def list_files(directory: str, format_str: str) -> List[File]: ...
 
 def PARQUET(str) -> File: ...
 def DWRF(str) -> File: ...
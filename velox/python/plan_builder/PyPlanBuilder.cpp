@@ -30,6 +30,34 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
+std::vector<std::shared_ptr<connector::ConnectorSplit>> makeFileSplits(
+    const std::string& connectorId,
+    const PyFile& file,
+    uint64_t splitSizeBytes) {
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  if (splitSizeBytes == 0) {
+    splits.push_back(
+        std::make_shared<connector::hive::HiveConnectorSplit>(
+            connectorId, file.filePath(), file.fileFormat()));
+    return splits;
+  }
+
+  // Readers only read the row groups or stripes that start in the split's
+  // byte range, so every row is read by exactly one split.
+  const auto fileSize = file.size();
+  for (uint64_t start = 0; start == 0 || start < fileSize;
+       start += splitSizeBytes) {
+    splits.push_back(
+        std::make_shared<connector::hive::HiveConnectorSplit>(
+            connectorId,
+            file.filePath(),
+            file.fileFormat(),
+            start,
+            splitSizeBytes));
+  }
+  return splits;
+}
+
 PyPlanNode::PyPlanNode(
     core::PlanNodePtr planNode,
     const std::shared_ptr<PyPlanContext>& planContext)
@@ -102,7 +130,8 @@ PyPlanBuilder& PyPlanBuilder::tableScan(
     const std::string& remainingFilter,
     const std::string& rowIndexColumnName,
     const std::string& connectorId,
-    const std::optional<std::vector<PyFile>>& inputFiles) {
+    const std::optional<std::vector<PyFile>>& inputFiles,
+    uint64_t splitSizeBytes) {
   using namespace connector::hive;
   exec::test::PlanBuilder::TableScanBuilder builder(planBuilder_);
 
@@ -189,9 +218,8 @@ PyPlanBuilder& PyPlanBuilder::tableScan(
   std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
   if (inputFiles.has_value()) {
     for (const auto& inputFile : *inputFiles) {
-      splits.push_back(
-          std::make_shared<connector::hive::HiveConnectorSplit>(
-              connectorId, inputFile.filePath(), inputFile.fileFormat()));
+      auto fileSplits = makeFileSplits(connectorId, inputFile, splitSizeBytes);
+      splits.insert(splits.end(), fileSplits.begin(), fileSplits.end());
     }
   }
 
@@ -104,6 +104,15 @@ class PyPlanNode {
 
 /// Wrapper class for PlanBuilder. It allows us to avoid exposing all details of
 /// the class to users making it easier to use.
+/// Returns the splits to scan 'file'. If 'splitSizeBytes' is greater than 0,
+/// the file is divided into byte ranges of at most 'splitSizeBytes' so that
+/// multiple drivers can scan it in parallel. Otherwise, the whole file is a
+/// single split.
+std::vector<std::shared_ptr<connector::ConnectorSplit>> makeFileSplits(
+    const std::string& connectorId,
+    const PyFile& file,
+    uint64_t splitSizeBytes = 0);
+
 class PyPlanBuilder {
  public:
   /// Constructs a new PyPlanBuilder. If provided, the planContext is used;
@@ -173,6 +182,9 @@ class PyPlanBuilder {
   ///    },
   ///    input_files=[PARQUET("my_file.parquet")],
   ///  )
+  ///
+  /// If 'splitSizeBytes' is greater than 0, each input file is divided in
+  /// splits of at most that many bytes. See makeFileSplits().
   PyPlanBuilder& tableScan(
       const PyType& outputSchema,
       const pybind11::dict& aliases,
@@ -181,7 +193,8 @@ class PyPlanBuilder {
       const std::string& remainingFilter,
       const std::string& rowIndexColumnName,
       const std::string& connectorId,
-      const std::optional<std::vector<PyFile>>& inputFiles);
+      const std::optional<std::vector<PyFile>>& inputFiles,
+      uint64_t splitSizeBytes = 0);
 
   /// Adds a table writer node to write to an output file(s).
   ///
@@ -102,6 +102,7 @@ PYBIND11_MODULE(plan_builder, m) {
           py::arg("row_index") = "",
           py::arg("connector_id") = "hive",
           py::arg("input_files") = std::nullopt,
+          py::arg("split_size_bytes") = 0,
           py::doc(R"(
         Adds a table scan node to the plan.
 
@@ -126,6 +127,9 @@ PYBIND11_MODULE(plan_builder, m) {
           connector_id: ID of the connector to use for this scan.
           input_files: If defined, uses as the input files so that no splits
                       will need to be added later.
+          split_size_bytes: If greater than 0, divides each input file in
+                            splits of at most this many bytes, so that
+                            multiple drivers can scan a file in parallel.
       )"))
       .def(
           "table_write",
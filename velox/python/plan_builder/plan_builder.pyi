@@ -43,6 +43,7 @@ class PlanBuilder:
         row_index: str = "",
         connector_id: str = "prism",
         input_files: list[File] = [],
+        split_size_bytes: int = 0,
     ) -> PlanBuilder: ...
     def tpch_gen(
         self,
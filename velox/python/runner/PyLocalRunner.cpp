@@ -69,7 +69,13 @@ PyTaskIterator::PyTaskIterator(
 }
 
 PyVector PyTaskIterator::next() {
-  if (!cursor_->moveNext()) {
+  bool hasNext;
+  {
+    // Lets other Python threads run while waiting for the task to produce.
+    py::gil_scoped_release release;
+    hasNext = cursor_->moveNext();
+  }
+  if (!hasNext) {
     vector_ = nullptr;
     throw py::stop_iteration(); // Raise StopIteration when done.
   }
@@ -91,10 +97,11 @@ PyLocalRunner::PyLocalRunner(
 void PyLocalRunner::addFileSplit(
     const PyFile& pyFile,
     const std::string& planId,
-    const std::string& connectorId) {
-  scanFiles_[planId].emplace_back(
-      std::make_shared<connector::hive::HiveConnectorSplit>(
-          connectorId, pyFile.filePath(), pyFile.fileFormat()));
+    const std::string& connectorId,
+    uint64_t splitSizeBytes) {
+  auto splits = makeFileSplits(connectorId, pyFile, splitSizeBytes);
+  auto& scanSplits = scanFiles_[planId];
+  scanSplits.insert(scanSplits.end(), splits.begin(), splits.end());
 }
 
 void PyLocalRunner::addQueryConfig(
@@ -103,7 +110,9 @@ void PyLocalRunner::addQueryConfig(
   queryConfigs_[configName] = configValue;
 }
 
-PyTaskIterator PyLocalRunner::execute(int32_t maxDrivers) {
+PyTaskIterator PyLocalRunner::execute(
+    int32_t maxDrivers,
+    uint64_t maxBufferedBytes) {
   // Initialize task cursor and task.
   cursor_ = exec::TaskCursor::create({
       .planNode = planNode_,
@@ -113,6 +122,7 @@ PyTaskIterator PyLocalRunner::execute(int32_t maxDrivers) {
                       .queryConfig(core::QueryConfig(queryConfigs_))
                       .pool(rootPool_)
                       .build(),
+      .bufferedBytes = maxBufferedBytes,
       .outputPool = outputPool_,
   });
 
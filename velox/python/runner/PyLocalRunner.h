@@ -64,20 +64,25 @@ class PyTaskIterator {
 /// @param executor The executor that will be used by drivers.
 class PyLocalRunner {
  public:
+  static constexpr uint64_t kDefaultMaxBufferedBytes{512 * 1024};
+
   PyLocalRunner(
       const PyPlanNode& pyPlanNode,
       const std::shared_ptr<memory::MemoryPool>& pool,
       const std::shared_ptr<folly::CPUThreadPoolExecutor>& executor);
 
-  /// Add a split to scan an entire file.
+  /// Add splits to scan an entire file.
   ///
   /// @param pyFile The Python File object describin the file path and format.
   /// @param planId The plan node ID of the scan.
   /// @param connectorId The connector used by the scan.
+  /// @param splitSizeBytes If greater than 0, the file is divided in splits of
+  /// at most this many bytes that drivers can scan in parallel.
   void addFileSplit(
       const PyFile& pyFile,
       const std::string& planId,
-      const std::string& connectorId);
+      const std::string& connectorId,
+      uint64_t splitSizeBytes = 0);
 
   /// Add a query configuration parameter. These values are passed to the Velox
   /// Task through a query context object.
@@ -97,9 +102,17 @@ class PyLocalRunner {
   /// own task cursor underneath. Consumes all splits whenever execute() is
   /// called.
   ///
+  /// Output vectors are produced while the caller iterates. The task pauses
+  /// when 'maxBufferedBytes' of output are waiting to be consumed, so a slow
+  /// consumer bounds the memory held by the result.
+  ///
   /// @param maxDrivers Maximum number of drivers to use when executing the
   /// plan.
-  PyTaskIterator execute(int32_t maxDrivers = 1);
+  /// @param maxBufferedBytes Maximum bytes of output buffered ahead of the
+  /// consumer.
+  PyTaskIterator execute(
+      int32_t maxDrivers = 1,
+      uint64_t maxBufferedBytes = kDefaultMaxBufferedBytes);
 
   /// Prints a descriptive debug message containing plan and execution stats.
   /// If the task hasn't finished, will print the plan with the current stats.
@@ -58,15 +58,20 @@ PYBIND11_MODULE(runner, m) {
           "execute",
           &velox::py::PyLocalRunner::execute,
           py::arg("max_drivers") = 1,
+          py::arg("max_buffered_bytes") =
+              velox::py::PyLocalRunner::kDefaultMaxBufferedBytes,
           // Keep 'self' alive while iterator is used.
           py::keep_alive<0, 1>(),
           py::doc(R"(
         Executes a given plan returning an iterator to the output produced
-        by the root plan node.
+        by the root plan node. Output is produced while iterating; the task
+        pauses when max_buffered_bytes of output wait to be consumed.
 
         Args:
           max_drivers: Maximum number of drivers (threads) to use when
           executing the plan.
+          max_buffered_bytes: Maximum bytes of output buffered ahead of
+          the consumer.
           )"))
       .def(
           "print_plan_with_stats",
@@ -82,8 +87,9 @@ PYBIND11_MODULE(runner, m) {
           py::arg("file"),
           py::arg("plan_id"),
           py::arg("connector_id") = "prism",
+          py::arg("split_size_bytes") = 0,
           py::doc(R"(
-        Add a split to scan a file, and associate it to the plan node
+        Add splits to scan a file, and associate them to the plan node
         described by plan_id.
 
         Args:
@@ -91,6 +97,9 @@ PYBIND11_MODULE(runner, m) {
           plan_id: The plan node id of the scan to associate this
                    file/split with.
           connector_id: The id of the connector used by the scan.
+          split_size_bytes: If greater than 0, divides the file in splits
+                            of at most this many bytes, so that multiple
+                            drivers can scan it in parallel.
           )"))
       .def(
           "add_query_config",
@@ -16,12 +16,21 @@
 
 from typing import Iterator, Optional
 
+from pyvelox.file import File
 from pyvelox.vector import Vector
 
 class LocalRunner:
     def __init__(self, PlanNode) -> None: ...
-    def execute(self, max_drivers: Optional[int] = None) -> Iterator[Vector]: ...
-    def add_file_split(self, plan_id: str, file_path: str) -> None: ...
+    def execute(
+        self, max_drivers: Optional[int] = None, max_buffered_bytes: int = ...
+    ) -> Iterator[Vector]: ...
+    def add_file_split(
+        self,
+        file: File,
+        plan_id: str,
+        connector_id: str = "prism",
+        split_size_bytes: int = 0,
+    ) -> None: ...
     def add_query_config(self, config_name: str, config_value: str) -> None: ...
     def print_plan_with_stats(self) -> str: ...
 
@@ -328,6 +328,58 @@ int32_t CompactRow::rowRowSize(vector_size_t index) const {
   return size;
 }
 
+raw_vector<vector_size_t> CompactRow::childRows(
+    vector_size_t offset,
+    vector_size_t size) const {
+  raw_vector<vector_size_t> rows(size);
+  if (decoded_.isIdentityMapping()) {
+    std::iota(rows.begin(), rows.end(), offset);
+  } else {
+    for (auto i = 0; i < size; ++i) {
+      rows[i] = decoded_.index(offset + i);
+    }
+  }
+  return rows;
+}
+
+void CompactRow::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    vector_size_t* sizes) const {
+  const auto rows = childRows(offset, size);
+
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + size, fixedSize);
+
+  for (auto childIdx = 0; childIdx < children_.size(); ++childIdx) {
+    if (childIsFixedWidth_[childIdx]) {
+      continue;
+    }
+    const auto& child = children_[childIdx];
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      for (auto i = 0; i < size; ++i) {
+        if (!mayHaveNulls || !child.isNullAt(rows[i])) {
+          sizes[i] +=
+              kSizeBytes + child.decoded_.valueAt<StringView>(rows[i]).size();
+        }
+      }
+    } else {
+      for (auto i = 0; i < size; ++i) {
+        if (!mayHaveNulls || !child.isNullAt(rows[i])) {
+          sizes[i] += child.variableWidthRowSize(rows[i]);
+        }
+      }
+    }
+  }
+}
+
 void CompactRow::serializedRowSizes(
     const folly::Range<const vector_size_t*>& rows,
     vector_size_t** sizes) const {
@@ -385,15 +437,8 @@ void CompactRow::serializeRow(
     vector_size_t size,
     char* buffer,
     const size_t* bufferOffsets) const {
-  raw_vector<vector_size_t> rows(size);
+  const auto rows = childRows(offset, size);
   raw_vector<uint8_t*> nulls(size);
-  if (decoded_.isIdentityMapping()) {
-    std::iota(rows.begin(), rows.end(), offset);
-  } else {
-    for (auto i = 0; i < size; ++i) {
-      rows[i] = decoded_.index(offset + i);
-    }
-  }
 
   // After serializing each column, the 'offsets' are updated accordingly.
   std::vector<size_t> offsets(size);
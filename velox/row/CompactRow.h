@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/memory/RawVector.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
 
@@ -39,6 +40,12 @@ class CompactRow {
   /// 'fixedRowSize' returned std::nullopt.
   int32_t rowSize(vector_size_t index) const;
 
+  /// Writes the serialized sizes of the rows in the range [offset, offset +
+  /// size) into 'sizes'. Computes the sizes one column at a time. Use only if
+  /// 'fixedRowSize' returned std::nullopt.
+  void rowSizes(vector_size_t offset, vector_size_t size, vector_size_t* sizes)
+      const;
+
   /// Serializes row at specified index into 'buffer'.
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer) const;
@@ -130,6 +137,11 @@ class CompactRow {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer) const;
 
+  /// Returns the indices of the rows in [offset, offset + size) in the
+  /// children.
+  raw_vector<vector_size_t> childRows(vector_size_t offset, vector_size_t size)
+      const;
+
   /// Serializes struct values in range [offset, offset + size) to buffer.
   /// Value must not be null.
   void serializeRow(
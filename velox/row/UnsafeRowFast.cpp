@@ -33,6 +33,76 @@ int32_t alignBytes(int32_t numBytes) {
 bool isFixedWidth(const TypePtr& type) {
   return type->isFixedWidth() && !type->isLongDecimal();
 }
+
+// Writes the values of a fixed-width child of a row type for consecutive rows
+// into field 'childIdx' of the rows at 'rowOffsets' of 'buffer'.
+template <TypeKind kind>
+void serializeFixedWidthTyped(
+    const raw_vector<vector_size_t>& rows,
+    uint32_t childIdx,
+    const DecodedVector& decoded,
+    size_t fieldOffset,
+    const size_t* rowOffsets,
+    char* buffer) {
+  if constexpr (kind == TypeKind::UNKNOWN) {
+    for (auto i = 0; i < rows.size(); ++i) {
+      bits::setBit(buffer + rowOffsets[i], childIdx, true);
+    }
+  } else if constexpr (
+      kind == TypeKind::BOOLEAN || kind == TypeKind::TINYINT ||
+      kind == TypeKind::SMALLINT || kind == TypeKind::INTEGER ||
+      kind == TypeKind::BIGINT || kind == TypeKind::REAL ||
+      kind == TypeKind::DOUBLE || kind == TypeKind::TIMESTAMP) {
+    using T = typename TypeTraits<kind>::NativeType;
+    const bool mayHaveNulls = decoded.mayHaveNulls();
+    for (auto i = 0; i < rows.size(); ++i) {
+      char* row = buffer + rowOffsets[i];
+      if (mayHaveNulls && decoded.isNullAt(rows[i])) {
+        bits::setBit(row, childIdx, true);
+        continue;
+      }
+      if constexpr (kind == TypeKind::TIMESTAMP) {
+        const auto micros = decoded.valueAt<Timestamp>(rows[i]).toMicros();
+        ::memcpy(row + fieldOffset, &micros, sizeof(int64_t));
+      } else {
+        const T value = decoded.valueAt<T>(rows[i]);
+        ::memcpy(row + fieldOffset, &value, sizeof(T));
+      }
+    }
+  } else {
+    VELOX_UNREACHABLE(
+        "Unexpected fixed-width type kind: {}", TypeKindName::toName(kind));
+  }
+}
+
+// Writes the VARCHAR or VARBINARY values of a child of a row type for
+// consecutive rows into the variable-width section of the rows at
+// 'rowOffsets' of 'buffer', and their offset and size into field 'childIdx'.
+// Advances 'variableWidthOffsets'.
+void serializeStrings(
+    const raw_vector<vector_size_t>& rows,
+    uint32_t childIdx,
+    const DecodedVector& decoded,
+    size_t fieldOffset,
+    const size_t* rowOffsets,
+    char* buffer,
+    std::vector<size_t>& variableWidthOffsets) {
+  const bool mayHaveNulls = decoded.mayHaveNulls();
+  for (auto i = 0; i < rows.size(); ++i) {
+    char* row = buffer + rowOffsets[i];
+    if (mayHaveNulls && decoded.isNullAt(rows[i])) {
+      bits::setBit(row, childIdx, true);
+      continue;
+    }
+    const auto value = decoded.valueAt<StringView>(rows[i]);
+    if (!value.empty()) {
+      ::memcpy(row + variableWidthOffsets[i], value.data(), value.size());
+    }
+    const uint64_t sizeAndOffset = variableWidthOffsets[i] << 32 | value.size();
+    ::memcpy(row + fieldOffset, &sizeAndOffset, sizeof(uint64_t));
+    variableWidthOffsets[i] += alignBytes(value.size());
+  }
+}
 } // namespace
 
 // static
@@ -165,6 +235,52 @@ int32_t UnsafeRowFast::variableWidthRowSize(vector_size_t index) const {
   };
 }
 
+raw_vector<vector_size_t> UnsafeRowFast::childRows(
+    vector_size_t offset,
+    vector_size_t size) const {
+  raw_vector<vector_size_t> rows(size);
+  if (decoded_.isIdentityMapping()) {
+    std::iota(rows.begin(), rows.end(), offset);
+  } else {
+    for (auto i = 0; i < size; ++i) {
+      rows[i] = decoded_.index(offset + i);
+    }
+  }
+  return rows;
+}
+
+void UnsafeRowFast::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    vector_size_t* sizes) const {
+  const auto rows = childRows(offset, size);
+  const int32_t fixedSize = rowNullBytes_ + children_.size() * kFieldWidth;
+  std::fill(sizes, sizes + size, fixedSize);
+
+  for (auto childIdx = 0; childIdx < children_.size(); ++childIdx) {
+    if (childIsFixedWidth_[childIdx]) {
+      continue;
+    }
+    const auto& child = children_[childIdx];
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      for (auto i = 0; i < size; ++i) {
+        if (!mayHaveNulls || !child.isNullAt(rows[i])) {
+          sizes[i] +=
+              alignBytes(child.decoded_.valueAt<StringView>(rows[i]).size());
+        }
+      }
+    } else {
+      for (auto i = 0; i < size; ++i) {
+        if (!mayHaveNulls || !child.isNullAt(rows[i])) {
+          sizes[i] += alignBytes(child.variableWidthRowSize(rows[i]));
+        }
+      }
+    }
+  }
+}
+
 bool UnsafeRowFast::isNullAt(vector_size_t index) const {
   return decoded_.isNullAt(index);
 }
@@ -173,6 +289,64 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) const {
   return serializeRow(index, buffer);
 }
 
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) const {
+  const auto rows = childRows(offset, size);
+
+  // Offsets of the next variable-width value from the start of each row.
+  std::vector<size_t> variableWidthOffsets(
+      size, rowNullBytes_ + children_.size() * kFieldWidth);
+
+  // Fixed-width and varchar/varbinary children are written with type
+  // specialized loops. Other children are serialized row by row.
+  for (auto childIdx = 0; childIdx < children_.size(); ++childIdx) {
+    const auto& child = children_[childIdx];
+    const size_t fieldOffset = rowNullBytes_ + childIdx * kFieldWidth;
+    if (childIsFixedWidth_[childIdx] && child.fixedWidthTypeKind_) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+          serializeFixedWidthTyped,
+          child.typeKind_,
+          rows,
+          childIdx,
+          child.decoded_,
+          fieldOffset,
+          bufferOffsets,
+          buffer);
+    } else if (
+        child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      serializeStrings(
+          rows,
+          childIdx,
+          child.decoded_,
+          fieldOffset,
+          bufferOffsets,
+          buffer,
+          variableWidthOffsets);
+    } else {
+      const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+      for (auto i = 0; i < size; ++i) {
+        char* row = buffer + bufferOffsets[i];
+        if (mayHaveNulls && child.isNullAt(rows[i])) {
+          bits::setBit(row, childIdx, true);
+        } else if (childIsFixedWidth_[childIdx]) {
+          child.serializeFixedWidth(rows[i], row + fieldOffset);
+        } else {
+          const uint64_t valueSize = child.serializeVariableWidth(
+              rows[i], row + variableWidthOffsets[i]);
+          const uint64_t sizeAndOffset =
+              variableWidthOffsets[i] << 32 | valueSize;
+          ::memcpy(row + fieldOffset, &sizeAndOffset, sizeof(uint64_t));
+          variableWidthOffsets[i] += alignBytes(valueSize);
+        }
+      }
+    }
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer)
     const {
   VELOX_DCHECK(fixedWidthTypeKind_);
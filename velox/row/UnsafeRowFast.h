@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/memory/RawVector.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
 
@@ -39,10 +40,28 @@ class UnsafeRowFast {
   /// 'fixedRowSize' returned std::nullopt.
   int32_t rowSize(vector_size_t index) const;
 
+  /// Writes the serialized sizes of the rows in the range [offset, offset +
+  /// size) into 'sizes'. Computes the sizes one column at a time. Use only if
+  /// 'fixedRowSize' returned std::nullopt.
+  void rowSizes(vector_size_t offset, vector_size_t size, vector_size_t* sizes)
+      const;
+
   /// Serializes row at specified index into 'buffer'.
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer) const;
 
+  /// Serializes rows in the range [offset, offset + size) into 'buffer' at
+  /// given 'bufferOffsets'. Writes one column at a time into all the rows.
+  /// 'buffer' must have sufficient capacity and set to all zeros.
+  /// 'bufferOffsets' must be pre-filled with the write offsets for each row
+  /// and the space between each offset must be no less than the
+  /// 'fixedRowSize' or 'rowSize' of the row.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer) const;
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   /// @param data The start memory address of each row.
@@ -118,6 +137,11 @@ class UnsafeRowFast {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer) const;
 
+  /// Returns the indices of the rows in [offset, offset + size) in the
+  /// children.
+  raw_vector<vector_size_t> childRows(vector_size_t offset, vector_size_t size)
+      const;
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
@@ -39,6 +39,20 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeUnsafeRange(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    const auto numRows = data->size();
+    std::vector<size_t> offsets(numRows);
+
+    UnsafeRowFast fast(data);
+    auto totalSize = computeOffsets(fast, rowType, numRows, offsets);
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    fast.serialize(0, numRows, offsets.data(), buffer->asMutable<char>());
+  }
+
   void deserializeUnsafe(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -144,6 +158,26 @@ class SerializeBenchmark {
     return totalSize;
   }
 
+  // Computes the row sizes one column at a time.
+  size_t computeOffsets(
+      UnsafeRowFast& unsafeRow,
+      const RowTypePtr& rowType,
+      vector_size_t numRows,
+      std::vector<size_t>& offsets) {
+    std::vector<vector_size_t> rowSize(numRows);
+    if (auto fixedRowSize = UnsafeRowFast::fixedRowSize(rowType)) {
+      std::fill(rowSize.begin(), rowSize.end(), fixedRowSize.value());
+    } else {
+      unsafeRow.rowSizes(0, numRows, rowSize.data());
+    }
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      offsets[i] = totalSize;
+      totalSize += rowSize[i];
+    }
+    return totalSize;
+  }
+
   std::vector<char*> serialize(
       UnsafeRowFast& unsafeRow,
       vector_size_t numRows,
@@ -229,6 +263,11 @@ class SerializeBenchmark {
     benchmark.serializeUnsafe(rowType);      \
   }                                          \
                                              \
+  BENCHMARK(unsafe_range_serialize_##name) { \
+    SerializeBenchmark benchmark;            \
+    benchmark.serializeUnsafeRange(rowType); \
+  }                                          \
+                                             \
   BENCHMARK(compact_serialize_##name) {      \
     SerializeBenchmark benchmark;            \
     benchmark.serializeCompact(rowType);     \
@@ -286,6 +325,12 @@ BENCHMARK(decimalsSerialize) {
   benchmark.serializeUnsafe(ROW({BIGINT(), DECIMAL(12, 2), DECIMAL(38, 18)}));
 }
 
+BENCHMARK(decimalsRangeSerialize) {
+  SerializeBenchmark benchmark;
+  benchmark.serializeUnsafeRange(
+      ROW({BIGINT(), DECIMAL(12, 2), DECIMAL(38, 18)}));
+}
+
 BENCHMARK(decimalsDeserialize) {
   SerializeBenchmark benchmark;
   benchmark.deserializeUnsafe(ROW({BIGINT(), DECIMAL(12, 2), DECIMAL(38, 18)}));
@@ -68,6 +68,13 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
         offsets[i] = totalSize;
         totalSize += rowSize[i];
       }
+
+      // Compute the sizes one column at a time.
+      std::vector<vector_size_t> batchRowSizes(numRows);
+      row.rowSizes(0, numRows, batchRowSizes.data());
+      for (auto i = 0; i < numRows; ++i) {
+        ASSERT_EQ(batchRowSizes[i], rowSize[i]) << "Row " << i;
+      }
     }
 
     std::vector<vector_size_t> rows(numRows);
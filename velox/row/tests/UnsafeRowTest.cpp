@@ -91,6 +91,13 @@ class UnsafeRowTest : public ::testing::Test, public VectorTestBase {
         offsets[i] = totalSize;
         totalSize += rowSize[i];
       }
+
+      // Compute the sizes one column at a time.
+      std::vector<vector_size_t> batchRowSizes(numRows);
+      row.rowSizes(0, numRows, batchRowSizes.data());
+      for (auto i = 0; i < numRows; ++i) {
+        ASSERT_EQ(batchRowSizes[i], rowSize[i]) << "Row " << i;
+      }
     }
 
     std::vector<vector_size_t> rows(numRows);
@@ -123,6 +130,21 @@ class UnsafeRowTest : public ::testing::Test, public VectorTestBase {
     VectorPtr outputVector =
         UnsafeRowFast::deserialize(serialized, rowType, pool_.get());
     assertEqualVectors(data, outputVector);
+
+    // Serialize by range with different range sizes. The rows are the same as
+    // when serialized row by row.
+    BufferPtr rangeBuffer =
+        AlignedBuffer::allocate<char>(totalSize, pool_.get(), 0);
+    auto* rawRangeBuffer = rangeBuffer->asMutable<char>();
+    vector_size_t begin = 0;
+    vector_size_t rangeSize = 1;
+    while (begin < numRows) {
+      const auto size = std::min<vector_size_t>(rangeSize, numRows - begin);
+      row.serialize(begin, size, offsets.data() + begin, rawRangeBuffer);
+      begin += size;
+      rangeSize = checkedMultiply<vector_size_t>(rangeSize, 2);
+    }
+    ASSERT_EQ(::memcmp(rawBuffer, rawRangeBuffer, totalSize), 0);
   }
 
   std::shared_ptr<memory::MemoryPool> pool_ =
@@ -0,0 +1,825 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ColumnarSerializer.h"
+
+#include <folly/container/F14Map.h>
+#include <folly/io/IOBuf.h>
+#include <sstream>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Nulls.h"
+#include "velox/common/compression/Compression.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+// Encoding of a sequence of fixed width values or of strings.
+enum class Encoding : int8_t {
+  kPlain = 0,
+  // Pairs of value and run length.
+  kRle = 1,
+  // Distinct values followed by bit packed indices into them.
+  kDictionary = 2,
+  // Minimum value followed by the bit packed differences to it.
+  kBitPacked = 3,
+};
+
+// Dictionaries with more entries than this are not considered.
+constexpr uint64_t kMaxDictionarySize = 64 << 10;
+
+// Blocks smaller than this are not compressed.
+constexpr uint64_t kMinCompressionSize = 256;
+
+// Size of the compressed flag and the uncompressed size of a block.
+constexpr int32_t kBlockHeaderSize = 1 + sizeof(int32_t);
+
+ColumnarVectorSerde::ColumnarOptions toColumnarOptions(
+    const VectorSerde::Options* options) {
+  if (options == nullptr) {
+    return ColumnarVectorSerde::ColumnarOptions();
+  }
+  if (const auto* columnarOptions =
+          dynamic_cast<const ColumnarVectorSerde::ColumnarOptions*>(options)) {
+    return *columnarOptions;
+  }
+  return ColumnarVectorSerde::ColumnarOptions(
+      options->compressionKind, options->minCompressionRatio);
+}
+
+presto::PrestoVectorSerde& prestoSerde() {
+  static presto::PrestoVectorSerde serde;
+  return serde;
+}
+
+// Options for the columns that are stored in the Presto format. Timestamps
+// keep their nanosecond precision.
+const presto::PrestoVectorSerde::PrestoOptions& prestoOptions() {
+  static const presto::PrestoVectorSerde::PrestoOptions options(
+      /*_useLosslessTimestamp=*/true,
+      common::CompressionKind::CompressionKind_NONE);
+  return options;
+}
+
+bool hasColumnarEncoding(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+void writeOne(OutputStream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+uint8_t bitWidth(uint64_t value) {
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+uint64_t bitPackedBytes(uint64_t numValues, uint8_t width) {
+  return bits::nbytes(numValues * width);
+}
+
+// Writes values of 'width' bits each, starting at the least significant bit.
+class BitWriter {
+ public:
+  BitWriter(OutputStream& out, uint8_t width) : out_(out), width_(width) {}
+
+  // 'value' must fit in 'width' bits.
+  void append(uint64_t value) {
+    word_ |= value << numBits_;
+    const int32_t numBits = numBits_ + width_;
+    if (numBits < 64) {
+      numBits_ = numBits;
+      return;
+    }
+    writeOne(out_, word_);
+    word_ = numBits_ == 0 ? 0 : value >> (64 - numBits_);
+    numBits_ = numBits - 64;
+  }
+
+  void finish() {
+    out_.write(reinterpret_cast<const char*>(&word_), bits::nbytes(numBits_));
+  }
+
+ private:
+  OutputStream& out_;
+  const uint8_t width_;
+  uint64_t word_{0};
+  int32_t numBits_{0};
+};
+
+// Reads the values written by BitWriter.
+class BitReader {
+ public:
+  BitReader(const char* data, uint64_t size, uint8_t width)
+      : data_(data),
+        size_(size),
+        width_(width),
+        mask_(width == 64 ? ~0ULL : (1ULL << width) - 1) {}
+
+  uint64_t next() {
+    if (width_ == 0) {
+      return 0;
+    }
+    const auto byte = bit_ / 8;
+    const auto shift = bit_ % 8;
+    uint64_t word = 0;
+    ::memcpy(&word, data_ + byte, std::min<uint64_t>(8, size_ - byte));
+    uint64_t value = word >> shift;
+    if (shift + width_ > 64) {
+      value |= static_cast<uint64_t>(static_cast<uint8_t>(data_[byte + 8]))
+          << (64 - shift);
+    }
+    bit_ += width_;
+    return value & mask_;
+  }
+
+ private:
+  const char* const data_;
+  const uint64_t size_;
+  const uint8_t width_;
+  const uint64_t mask_;
+  uint64_t bit_{0};
+};
+
+// Reads from the uncompressed bytes of a block.
+class BlockReader {
+ public:
+  BlockReader(const char* data, uint64_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    ::memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const char* readBytes(uint64_t size) {
+    VELOX_CHECK_LE(position_ + size, size_, "Corrupted columnar block");
+    const auto* data = data_ + position_;
+    position_ += size;
+    return data;
+  }
+
+  uint64_t remainingSize() const {
+    return size_ - position_;
+  }
+
+ private:
+  const char* const data_;
+  const uint64_t size_;
+  uint64_t position_{0};
+};
+
+// Writes 'values' with the encoding that gives the smallest size.
+template <typename T>
+void writeIntegers(const std::vector<T>& values, OutputStream& out) {
+  static_assert(std::is_integral_v<T>);
+  const uint64_t numValues = values.size();
+  if (numValues == 0) {
+    writeOne(out, Encoding::kPlain);
+    return;
+  }
+
+  int64_t min = values[0];
+  int64_t max = values[0];
+  uint64_t numRuns = 1;
+  for (uint64_t i = 1; i < numValues; ++i) {
+    min = std::min<int64_t>(min, values[i]);
+    max = std::max<int64_t>(max, values[i]);
+    numRuns += values[i] != values[i - 1];
+  }
+  const auto deltaWidth =
+      bitWidth(static_cast<uint64_t>(max) - static_cast<uint64_t>(min));
+
+  // A dictionary only helps if its indices are narrower than the deltas.
+  folly::F14FastMap<T, int32_t> dictionary;
+  std::vector<T> distinctValues;
+  bool useDictionary = deltaWidth > 1 && numRuns > 1;
+  if (useDictionary) {
+    const auto maxDictionarySize =
+        std::min<uint64_t>(kMaxDictionarySize, numValues / 2);
+    for (auto value : values) {
+      if (dictionary.emplace(value, distinctValues.size()).second) {
+        distinctValues.push_back(value);
+        if (distinctValues.size() > maxDictionarySize) {
+          useDictionary = false;
+          break;
+        }
+      }
+    }
+  }
+
+  auto encoding = Encoding::kPlain;
+  uint64_t size = numValues * sizeof(T);
+  const auto rleSize =
+      sizeof(int32_t) + numRuns * (sizeof(T) + sizeof(int32_t));
+  if (rleSize < size) {
+    encoding = Encoding::kRle;
+    size = rleSize;
+  }
+  const auto bitPackedSize =
+      sizeof(int64_t) + 1 + bitPackedBytes(numValues, deltaWidth);
+  if (bitPackedSize < size) {
+    encoding = Encoding::kBitPacked;
+    size = bitPackedSize;
+  }
+  const auto indexWidth =
+      useDictionary ? bitWidth(distinctValues.size() - 1) : 0;
+  if (useDictionary) {
+    const auto dictionarySize = sizeof(int32_t) +
+        distinctValues.size() * sizeof(T) + 1 +
+        bitPackedBytes(numValues, indexWidth);
+    if (dictionarySize < size) {
+      encoding = Encoding::kDictionary;
+      size = dictionarySize;
+    }
+  }
+
+  writeOne(out, encoding);
+  switch (encoding) {
+    case Encoding::kPlain:
+      out.write(
+          reinterpret_cast<const char*>(values.data()),
+          numValues * sizeof(T));
+      break;
+    case Encoding::kRle: {
+      writeOne<int32_t>(out, numRuns);
+      int32_t runLength = 1;
+      for (uint64_t i = 1; i <= numValues; ++i) {
+        if (i < numValues && values[i] == values[i - 1]) {
+          ++runLength;
+          continue;
+        }
+        writeOne(out, values[i - 1]);
+        writeOne(out, runLength);
+        runLength = 1;
+      }
+      break;
+    }
+    case Encoding::kBitPacked: {
+      writeOne(out, min);
+      writeOne(out, deltaWidth);
+      BitWriter writer(out, deltaWidth);
+      for (auto value : values) {
+        writer.append(
+            static_cast<uint64_t>(static_cast<int64_t>(value)) -
+            static_cast<uint64_t>(min));
+      }
+      writer.finish();
+      break;
+    }
+    case Encoding::kDictionary: {
+      writeOne<int32_t>(out, distinctValues.size());
+      out.write(
+          reinterpret_cast<const char*>(distinctValues.data()),
+          distinctValues.size() * sizeof(T));
+      writeOne(out, indexWidth);
+      BitWriter writer(out, indexWidth);
+      for (auto value : values) {
+        writer.append(dictionary[value]);
+      }
+      writer.finish();
+      break;
+    }
+  }
+}
+
+// Reads 'numValues' values written by writeIntegers() into 'values'.
+template <typename T>
+void readIntegers(BlockReader& in, uint64_t numValues, T* values) {
+  const auto encoding = in.read<Encoding>();
+  switch (encoding) {
+    case Encoding::kPlain:
+      ::memcpy(
+          values, in.readBytes(numValues * sizeof(T)), numValues * sizeof(T));
+      return;
+    case Encoding::kRle: {
+      const auto numRuns = in.read<int32_t>();
+      uint64_t numRead = 0;
+      for (int32_t i = 0; i < numRuns; ++i) {
+        const auto value = in.read<T>();
+        const auto runLength = in.read<int32_t>();
+        VELOX_CHECK_LE(numRead + runLength, numValues);
+        std::fill(values + numRead, values + numRead + runLength, value);
+        numRead += runLength;
+      }
+      VELOX_CHECK_EQ(numRead, numValues);
+      return;
+    }
+    case Encoding::kBitPacked: {
+      const auto min = static_cast<uint64_t>(in.read<int64_t>());
+      const auto width = in.read<uint8_t>();
+      const auto size = bitPackedBytes(numValues, width);
+      BitReader reader(in.readBytes(size), size, width);
+      for (uint64_t i = 0; i < numValues; ++i) {
+        values[i] = static_cast<T>(min + reader.next());
+      }
+      return;
+    }
+    case Encoding::kDictionary: {
+      const auto dictionarySize = in.read<int32_t>();
+      std::vector<T> dictionary(dictionarySize);
+      ::memcpy(
+          dictionary.data(),
+          in.readBytes(dictionarySize * sizeof(T)),
+          dictionarySize * sizeof(T));
+      const auto width = in.read<uint8_t>();
+      const auto size = bitPackedBytes(numValues, width);
+      BitReader reader(in.readBytes(size), size, width);
+      for (uint64_t i = 0; i < numValues; ++i) {
+        const auto index = reader.next();
+        VELOX_CHECK_LT(index, dictionarySize);
+        values[i] = dictionary[index];
+      }
+      return;
+    }
+  }
+  VELOX_FAIL("Unknown columnar encoding: {}", static_cast<int32_t>(encoding));
+}
+
+// Writes the non-null values of a flat 'column' of 'T'. Floating point values
+// are encoded as the integers 'U' with the same bits.
+template <typename T, typename U = T>
+void writeFixedWidth(const BaseVector& column, OutputStream& out) {
+  static_assert(sizeof(T) == sizeof(U));
+  const auto* rawValues = column.asUnchecked<FlatVector<T>>()->rawValues();
+  std::vector<U> values;
+  values.reserve(column.size());
+  for (vector_size_t row = 0; row < column.size(); ++row) {
+    if (!column.isNullAt(row)) {
+      U value;
+      ::memcpy(&value, &rawValues[row], sizeof(U));
+      values.push_back(value);
+    }
+  }
+  writeIntegers(values, out);
+}
+
+void writeStrings(const BaseVector& column, OutputStream& out) {
+  const auto* rawValues =
+      column.asUnchecked<FlatVector<StringView>>()->rawValues();
+  std::vector<std::string_view> values;
+  values.reserve(column.size());
+  uint64_t numBytes = 0;
+  for (vector_size_t row = 0; row < column.size(); ++row) {
+    if (!column.isNullAt(row)) {
+      values.emplace_back(rawValues[row].data(), rawValues[row].size());
+      numBytes += rawValues[row].size();
+    }
+  }
+
+  folly::F14FastMap<std::string_view, int32_t> dictionary;
+  std::vector<std::string_view> distinctValues;
+  uint64_t numDistinctBytes = 0;
+  bool useDictionary = !values.empty();
+  const auto maxDictionarySize =
+      std::min<uint64_t>(kMaxDictionarySize, values.size() / 2);
+  for (size_t i = 0; useDictionary && i < values.size(); ++i) {
+    if (dictionary.emplace(values[i], distinctValues.size()).second) {
+      distinctValues.push_back(values[i]);
+      numDistinctBytes += values[i].size();
+      useDictionary = distinctValues.size() <= maxDictionarySize;
+    }
+  }
+  // Compares the bytes and the indices of the dictionary with the bytes of
+  // the values. The lengths are assumed to take 4 bytes each.
+  const auto indexWidth =
+      useDictionary ? bitWidth(distinctValues.size() - 1) : 0;
+  useDictionary = useDictionary &&
+      numDistinctBytes + distinctValues.size() * sizeof(int32_t) +
+              bitPackedBytes(values.size(), indexWidth) <
+          numBytes + values.size() * sizeof(int32_t);
+
+  const auto& stringValues = useDictionary ? distinctValues : values;
+  std::vector<int32_t> lengths;
+  lengths.reserve(stringValues.size());
+  for (const auto& value : stringValues) {
+    lengths.push_back(value.size());
+  }
+  if (useDictionary) {
+    writeOne(out, Encoding::kDictionary);
+    writeOne<int32_t>(out, distinctValues.size());
+  } else {
+    writeOne(out, Encoding::kPlain);
+  }
+  writeIntegers(lengths, out);
+  for (const auto& value : stringValues) {
+    out.write(value.data(), value.size());
+  }
+  if (useDictionary) {
+    writeOne(out, indexWidth);
+    BitWriter writer(out, indexWidth);
+    for (const auto& value : values) {
+      writer.append(dictionary[value]);
+    }
+    writer.finish();
+  }
+}
+
+// Writes 'column' without compression.
+void writeColumn(
+    const VectorPtr& column,
+    memory::MemoryPool* pool,
+    OutputStream& out) {
+  const auto kind = column->typeKind();
+  const bool presto = !hasColumnarEncoding(kind);
+  writeOne(out, presto);
+  if (presto) {
+    std::ostringstream stream;
+    prestoSerde().serializeSingleColumn(
+        column, &prestoOptions(), pool, &stream);
+    const auto data = stream.str();
+    out.write(data.data(), data.size());
+    return;
+  }
+
+  const auto numRows = column->size();
+  const bool hasNulls = column->rawNulls() != nullptr &&
+      bits::countBits(column->rawNulls(), 0, numRows) < numRows;
+  writeOne(out, hasNulls);
+  if (hasNulls) {
+    out.write(
+        reinterpret_cast<const char*>(column->rawNulls()),
+        bits::nbytes(numRows));
+  }
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+      if (numRows > 0) {
+        out.write(column->values()->as<char>(), bits::nbytes(numRows));
+      }
+      break;
+    case TypeKind::TINYINT:
+      writeFixedWidth<int8_t>(*column, out);
+      break;
+    case TypeKind::SMALLINT:
+      writeFixedWidth<int16_t>(*column, out);
+      break;
+    case TypeKind::INTEGER:
+      writeFixedWidth<int32_t>(*column, out);
+      break;
+    case TypeKind::BIGINT:
+      writeFixedWidth<int64_t>(*column, out);
+      break;
+    case TypeKind::REAL:
+      writeFixedWidth<float, int32_t>(*column, out);
+      break;
+    case TypeKind::DOUBLE:
+      writeFixedWidth<double, int64_t>(*column, out);
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      writeStrings(*column, out);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Moves the first 'numNonNull' entries of 'values' to the non-null rows of
+// 'nulls' and sets the null rows to T().
+template <typename T>
+void scatterToNonNullRows(
+    T* values,
+    vector_size_t numNonNull,
+    const uint64_t* nulls,
+    vector_size_t numRows) {
+  auto numLeft = numNonNull;
+  for (auto row = numRows - 1; row >= 0; --row) {
+    if (bits::isBitNull(nulls, row)) {
+      values[row] = T();
+    } else {
+      values[row] = values[--numLeft];
+    }
+  }
+  VELOX_CHECK_EQ(numLeft, 0);
+}
+
+template <typename T, typename U = T>
+VectorPtr readFixedWidth(
+    BlockReader& in,
+    const TypePtr& type,
+    vector_size_t numRows,
+    const BufferPtr& nulls,
+    vector_size_t numNonNull,
+    memory::MemoryPool* pool) {
+  auto values = AlignedBuffer::allocate<T>(numRows, pool);
+  auto* rawValues = values->asMutable<U>();
+  readIntegers<U>(in, numNonNull, rawValues);
+  if (nulls != nullptr) {
+    scatterToNonNullRows(rawValues, numNonNull, nulls->as<uint64_t>(), numRows);
+  }
+  return std::make_shared<FlatVector<T>>(
+      pool, type, nulls, numRows, std::move(values), std::vector<BufferPtr>{});
+}
+
+VectorPtr readStrings(
+    BlockReader& in,
+    const TypePtr& type,
+    vector_size_t numRows,
+    const BufferPtr& nulls,
+    vector_size_t numNonNull,
+    memory::MemoryPool* pool) {
+  const auto encoding = in.read<Encoding>();
+  VELOX_CHECK(
+      encoding == Encoding::kPlain || encoding == Encoding::kDictionary,
+      "Unknown columnar string encoding: {}",
+      static_cast<int32_t>(encoding));
+  const bool dictionary = encoding == Encoding::kDictionary;
+  const vector_size_t numStrings = dictionary ? in.read<int32_t>() : numNonNull;
+
+  std::vector<int32_t> lengths(numStrings);
+  readIntegers<int32_t>(in, numStrings, lengths.data());
+  uint64_t numBytes = 0;
+  for (auto length : lengths) {
+    numBytes += length;
+  }
+  std::vector<BufferPtr> stringBuffers;
+  const char* bytes = nullptr;
+  if (numBytes > 0) {
+    stringBuffers.push_back(AlignedBuffer::allocate<char>(numBytes, pool));
+    ::memcpy(
+        stringBuffers.back()->asMutable<char>(),
+        in.readBytes(numBytes),
+        numBytes);
+    bytes = stringBuffers.back()->as<char>();
+  }
+  std::vector<StringView> strings;
+  strings.reserve(numStrings);
+  for (auto length : lengths) {
+    strings.emplace_back(bytes, length);
+    bytes += length;
+  }
+
+  auto values = AlignedBuffer::allocate<StringView>(numRows, pool);
+  auto* rawValues = values->asMutable<StringView>();
+  if (dictionary) {
+    const auto width = in.read<uint8_t>();
+    const auto size = bitPackedBytes(numNonNull, width);
+    BitReader reader(in.readBytes(size), size, width);
+    for (auto i = 0; i < numNonNull; ++i) {
+      const auto index = reader.next();
+      VELOX_CHECK_LT(index, numStrings);
+      rawValues[i] = strings[index];
+    }
+  } else {
+    std::copy(strings.begin(), strings.end(), rawValues);
+  }
+  if (nulls != nullptr) {
+    scatterToNonNullRows(rawValues, numNonNull, nulls->as<uint64_t>(), numRows);
+  }
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      numRows,
+      std::move(values),
+      std::move(stringBuffers));
+}
+
+VectorPtr readColumn(
+    BlockReader& in,
+    const TypePtr& type,
+    vector_size_t numRows,
+    memory::MemoryPool* pool) {
+  if (in.read<bool>()) {
+    const auto size = in.remainingSize();
+    BufferInputStream stream({ByteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(in.readBytes(size))),
+        static_cast<int64_t>(size),
+        0}});
+    VectorPtr result;
+    prestoSerde().deserializeSingleColumn(
+        &stream, pool, type, &result, &prestoOptions());
+    VELOX_CHECK_EQ(result->size(), numRows);
+    return result;
+  }
+
+  BufferPtr nulls;
+  vector_size_t numNonNull = numRows;
+  if (in.read<bool>()) {
+    nulls = AlignedBuffer::allocate<bool>(numRows, pool);
+    ::memcpy(
+        nulls->asMutable<char>(),
+        in.readBytes(bits::nbytes(numRows)),
+        bits::nbytes(numRows));
+    numNonNull = bits::countBits(nulls->as<uint64_t>(), 0, numRows);
+  }
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN: {
+      auto values = AlignedBuffer::allocate<bool>(numRows, pool);
+      ::memcpy(
+          values->asMutable<char>(),
+          in.readBytes(bits::nbytes(numRows)),
+          bits::nbytes(numRows));
+      return std::make_shared<FlatVector<bool>>(
+          pool,
+          type,
+          nulls,
+          numRows,
+          std::move(values),
+          std::vector<BufferPtr>{});
+    }
+    case TypeKind::TINYINT:
+      return readFixedWidth<int8_t>(in, type, numRows, nulls, numNonNull, pool);
+    case TypeKind::SMALLINT:
+      return readFixedWidth<int16_t>(
+          in, type, numRows, nulls, numNonNull, pool);
+    case TypeKind::INTEGER:
+      return readFixedWidth<int32_t>(
+          in, type, numRows, nulls, numNonNull, pool);
+    case TypeKind::BIGINT:
+      return readFixedWidth<int64_t>(
+          in, type, numRows, nulls, numNonNull, pool);
+    case TypeKind::REAL:
+      return readFixedWidth<float, int32_t>(
+          in, type, numRows, nulls, numNonNull, pool);
+    case TypeKind::DOUBLE:
+      return readFixedWidth<double, int64_t>(
+          in, type, numRows, nulls, numNonNull, pool);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return readStrings(in, type, numRows, nulls, numNonNull, pool);
+    default:
+      VELOX_FAIL("Unexpected columnar column type: {}", type->toString());
+  }
+}
+
+class ColumnarIterativeSerializer : public IterativeVectorSerializer {
+ public:
+  ColumnarIterativeSerializer(
+      RowTypePtr type,
+      memory::MemoryPool* pool,
+      const ColumnarVectorSerde::ColumnarOptions& options)
+      : type_(std::move(type)),
+        pool_(pool),
+        options_(options),
+        codec_(common::compressionKindToCodec(options_.compressionKind)),
+        rows_(BaseVector::create<RowVector>(type_, 0, pool_)) {}
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& /*scratch*/) override {
+    std::vector<BaseVector::CopyRange> copyRanges;
+    copyRanges.reserve(ranges.size());
+    auto numRows = rows_->size();
+    for (const auto& range : ranges) {
+      copyRanges.push_back({range.begin, numRows, range.size});
+      numRows += range.size;
+    }
+    rows_->resize(numRows);
+    rows_->copyRanges(vector.get(), copyRanges);
+  }
+
+  // The encoded columns are not larger than the flat vectors of the buffered
+  // rows, apart from the headers.
+  size_t maxSerializedSize() const override {
+    return 2 * sizeof(int32_t) +
+        type_->size() * (sizeof(int32_t) + kBlockHeaderSize + 2) +
+        rows_->estimateFlatSize();
+  }
+
+  void flush(OutputStream* out) override {
+    const auto numColumns = type_->size();
+    std::vector<std::unique_ptr<folly::IOBuf>> blocks;
+    blocks.reserve(numColumns);
+    for (auto i = 0; i < numColumns; ++i) {
+      blocks.push_back(makeBlock(rows_->childAt(i)));
+    }
+    writeOne<int32_t>(*out, rows_->size());
+    writeOne<int32_t>(*out, numColumns);
+    for (const auto& block : blocks) {
+      writeOne<int32_t>(*out, block->computeChainDataLength());
+    }
+    for (const auto& block : blocks) {
+      for (const auto& range : *block) {
+        out->write(reinterpret_cast<const char*>(range.data()), range.size());
+      }
+    }
+  }
+
+  void clear() override {
+    rows_ = BaseVector::create<RowVector>(type_, 0, pool_);
+  }
+
+ private:
+  // Encodes 'column' and compresses it if that saves enough space.
+  std::unique_ptr<folly::IOBuf> makeBlock(const VectorPtr& column) {
+    IOBufOutputStream stream(*pool_);
+    writeColumn(column, pool_, stream);
+    auto data = stream.getIOBuf();
+    const int32_t uncompressedSize = data->computeChainDataLength();
+    bool compressed = false;
+    if (codec_->type() != folly::compression::CodecType::NO_COMPRESSION &&
+        uncompressedSize >= kMinCompressionSize) {
+      auto compressedData = codec_->compress(data.get());
+      if (compressedData->computeChainDataLength() <=
+          uncompressedSize * options_.minCompressionRatio) {
+        data = std::move(compressedData);
+        compressed = true;
+      }
+    }
+    auto block = folly::IOBuf::create(kBlockHeaderSize);
+    block->writableData()[0] = compressed;
+    ::memcpy(block->writableData() + 1, &uncompressedSize, sizeof(int32_t));
+    block->append(kBlockHeaderSize);
+    block->appendToChain(std::move(data));
+    return block;
+  }
+
+  const RowTypePtr type_;
+  memory::MemoryPool* const pool_;
+  const ColumnarVectorSerde::ColumnarOptions options_;
+  const std::unique_ptr<folly::compression::Codec> codec_;
+  // The rows appended since the last flush.
+  RowVectorPtr rows_;
+};
+} // namespace
+
+std::unique_ptr<IterativeVectorSerializer>
+ColumnarVectorSerde::createIterativeSerializer(
+    RowTypePtr type,
+    int32_t /*numRows*/,
+    StreamArena* streamArena,
+    const Options* options) {
+  return std::make_unique<ColumnarIterativeSerializer>(
+      std::move(type), streamArena->pool(), toColumnarOptions(options));
+}
+
+void ColumnarVectorSerde::deserialize(
+    ByteInputStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    const Options* options) {
+  const auto columnarOptions = toColumnarOptions(options);
+  const auto numRows = source->read<int32_t>();
+  const auto numColumns = source->read<int32_t>();
+  VELOX_CHECK_EQ(numColumns, type->size());
+  std::vector<int32_t> blockSizes(numColumns);
+  for (auto& blockSize : blockSizes) {
+    blockSize = source->read<int32_t>();
+  }
+
+  const auto codec =
+      common::compressionKindToCodec(columnarOptions.compressionKind);
+  std::vector<VectorPtr> children(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    VELOX_CHECK_GE(blockSizes[i], kBlockHeaderSize);
+    const bool compressed = source->read<bool>();
+    const auto uncompressedSize = source->read<int32_t>();
+    const auto dataSize = blockSizes[i] - kBlockHeaderSize;
+    auto data = folly::IOBuf::create(dataSize);
+    source->readBytes(data->writableData(), dataSize);
+    data->append(dataSize);
+    if (compressed) {
+      data = codec->uncompress(data.get(), uncompressedSize);
+      data->coalesce();
+    }
+    VELOX_CHECK_EQ(data->length(), uncompressedSize);
+    BlockReader in(reinterpret_cast<const char*>(data->data()), data->length());
+    children[i] = readColumn(in, type->childAt(i), numRows, pool);
+  }
+  *result = std::make_shared<RowVector>(
+      pool, type, nullptr, numRows, std::move(children));
+}
+
+// static
+void ColumnarVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<ColumnarVectorSerde>());
+}
+
+// static
+void ColumnarVectorSerde::registerNamedVectorSerde() {
+  velox::registerNamedVectorSerde(
+      VectorSerde::Kind::kColumnar, std::make_unique<ColumnarVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
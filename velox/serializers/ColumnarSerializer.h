@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Serializes RowVectors as column-major batches. Used for spilling. Each
+/// top level column is a separate block with its own encoding and
+/// compression.
+///
+/// Integer, floating point and date columns are encoded with the smallest of
+/// plain, run length, dictionary and frame of reference bit packing encodings.
+/// Strings are dictionary encoded or stored as encoded lengths followed by the
+/// bytes. Booleans are stored as bits. The remaining types are stored in the
+/// Presto column format. Each block is compressed on its own with the codec of
+/// the options and is stored uncompressed if it does not reach the minimum
+/// compression ratio.
+///
+/// Batch: numRows(4) | numColumns(4) | blockSize(4) * numColumns | blocks
+/// Block: compressed(1) | uncompressedSize(4) | column
+/// Column: presto(1) | Presto column or hasNulls(1) | [nulls] | values
+class ColumnarVectorSerde : public VectorSerde {
+ public:
+  struct ColumnarOptions : VectorSerde::Options {
+    ColumnarOptions() = default;
+
+    ColumnarOptions(
+        common::CompressionKind _compressionKind,
+        float _minCompressionRatio = 0.8)
+        : VectorSerde::Options(_compressionKind, _minCompressionRatio) {}
+  };
+
+  ColumnarVectorSerde() : VectorSerde(VectorSerde::Kind::kColumnar) {}
+
+  std::unique_ptr<IterativeVectorSerializer> createIterativeSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override;
+
+  static void registerVectorSerde();
+  static void registerNamedVectorSerde();
+};
+
+} // namespace facebook::velox::serializer
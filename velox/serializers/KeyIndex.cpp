@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/KeyIndex.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+template <typename T>
+void append(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read(std::string_view& data) {
+  VELOX_CHECK_GE(data.size(), sizeof(T), "Truncated KeyIndex");
+  T value;
+  std::memcpy(&value, data.data(), sizeof(T));
+  data.remove_prefix(sizeof(T));
+  return value;
+}
+
+} // namespace
+
+KeyIndex::Builder::Builder(KeyEncoder* encoder, int32_t rowsPerEntry)
+    : encoder_(encoder), rowsPerEntry_(rowsPerEntry) {
+  VELOX_CHECK_NOT_NULL(encoder_);
+  VELOX_CHECK_GT(rowsPerEntry_, 0);
+}
+
+void KeyIndex::Builder::add(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+  // First row of 'input' that starts an entry.
+  auto row = (rowsPerEntry_ - numRows_ % rowsPerEntry_) % rowsPerEntry_;
+  std::vector<char> buffer;
+  std::vector<std::string_view> encoded;
+  for (; row < numInput; row += rowsPerEntry_) {
+    encoded.clear();
+    encoder_->encode(input->slice(row, 1), encoded, [&](size_t size) {
+      buffer.resize(size);
+      return buffer.data();
+    });
+    keys_.emplace_back(encoded[0]);
+  }
+  numRows_ += numInput;
+}
+
+KeyIndex KeyIndex::Builder::build() {
+  return KeyIndex(std::move(keys_), rowsPerEntry_, numRows_);
+}
+
+KeyIndex::KeyIndex(
+    std::vector<std::string> keys,
+    int32_t rowsPerEntry,
+    int64_t numRows)
+    : keys_(std::move(keys)), rowsPerEntry_(rowsPerEntry), numRows_(numRows) {
+  VELOX_CHECK_GT(rowsPerEntry_, 0);
+  VELOX_CHECK_EQ(
+      static_cast<int64_t>(keys_.size()),
+      bits::divRoundUp(numRows_, rowsPerEntry_));
+}
+
+KeyIndex::RowRange KeyIndex::lookup(const EncodedKeyBounds& bounds) const {
+  int64_t beginEntry = 0;
+  if (bounds.lowerKey.has_value()) {
+    // The entry before the first entry that starts at or above the lower key
+    // may end with keys at or above the lower key. std::string compares as
+    // unsigned bytes, which is the order of the encoded keys.
+    const auto it =
+        std::lower_bound(keys_.begin(), keys_.end(), bounds.lowerKey.value());
+    beginEntry = std::max<int64_t>(0, it - keys_.begin() - 1);
+  }
+  int64_t endEntry = keys_.size();
+  if (bounds.upperKey.has_value()) {
+    // Entries that start at or above the exclusive upper key have no match.
+    const auto it =
+        std::lower_bound(keys_.begin(), keys_.end(), bounds.upperKey.value());
+    endEntry = it - keys_.begin();
+  }
+  if (beginEntry >= endEntry) {
+    return {};
+  }
+  return {
+      beginEntry * rowsPerEntry_,
+      std::min(numRows_, endEntry * rowsPerEntry_)};
+}
+
+KeyIndex::RowRange KeyIndex::lookup(
+    const IndexBounds& indexBounds,
+    KeyEncoder& encoder) const {
+  const auto encodedBounds = encoder.encodeIndexBounds(indexBounds);
+  if (!encodedBounds.has_value()) {
+    // The lower bound is above the maximum key.
+    return {};
+  }
+  return lookup(encodedBounds.value());
+}
+
+std::string KeyIndex::serialize() const {
+  std::string out;
+  append<int32_t>(out, rowsPerEntry_);
+  append<int64_t>(out, numRows_);
+  for (const auto& key : keys_) {
+    append<int32_t>(out, key.size());
+    out.append(key);
+  }
+  return out;
+}
+
+// static
+KeyIndex KeyIndex::deserialize(std::string_view data) {
+  const auto rowsPerEntry = read<int32_t>(data);
+  const auto numRows = read<int64_t>(data);
+  std::vector<std::string> keys;
+  while (!data.empty()) {
+    const size_t size = read<int32_t>(data);
+    VELOX_CHECK_GE(data.size(), size, "Truncated KeyIndex");
+    keys.emplace_back(data.substr(0, size));
+    data.remove_prefix(size);
+  }
+  return KeyIndex(std::move(keys), rowsPerEntry, numRows);
+}
+
+} // namespace facebook::velox::serializer
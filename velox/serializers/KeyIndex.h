@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/serializers/KeyEncoder.h"
+
+namespace facebook::velox::serializer {
+
+/// Sparse index over the byte-comparable keys of data sorted on the key
+/// columns of a KeyEncoder. Records the encoded key of the first row of every
+/// 'rowsPerEntry' rows, so that a reader can binary search the rows that may
+/// fall in EncodedKeyBounds without reading the rest of the data. The index
+/// is small enough to be kept in file metadata, e.g. as a footer entry
+/// written with serialize().
+class KeyIndex {
+ public:
+  /// Half-open range of row numbers [begin, end).
+  struct RowRange {
+    int64_t begin{0};
+    int64_t end{0};
+
+    bool empty() const {
+      return begin >= end;
+    }
+
+    bool operator==(const RowRange& other) const {
+      return begin == other.begin && end == other.end;
+    }
+  };
+
+  /// Builds a KeyIndex from consecutive batches of sorted input.
+  class Builder {
+   public:
+    /// 'encoder' must outlive the builder.
+    Builder(KeyEncoder* encoder, int32_t rowsPerEntry);
+
+    /// Adds the next 'input' rows. The rows must continue the sort order of
+    /// the previously added rows.
+    void add(const RowVectorPtr& input);
+
+    /// Returns the index over all added rows.
+    KeyIndex build();
+
+   private:
+    KeyEncoder* const encoder_;
+    const int32_t rowsPerEntry_;
+
+    int64_t numRows_{0};
+    std::vector<std::string> keys_;
+  };
+
+  KeyIndex(
+      std::vector<std::string> keys,
+      int32_t rowsPerEntry,
+      int64_t numRows);
+
+  /// Returns the range of rows that contains all rows with keys in 'bounds'.
+  /// The range is at entry granularity, so that rows around the bounds may be
+  /// included. Returns an empty range if no row can match.
+  RowRange lookup(const EncodedKeyBounds& bounds) const;
+
+  /// Returns the range of rows for 'indexBounds' encoded with 'encoder',
+  /// which must be configured like the encoder the index was built with.
+  RowRange lookup(const IndexBounds& indexBounds, KeyEncoder& encoder) const;
+
+  /// Serializes the index into a self-contained string.
+  std::string serialize() const;
+
+  static KeyIndex deserialize(std::string_view data);
+
+  int64_t numRows() const {
+    return numRows_;
+  }
+
+  int32_t rowsPerEntry() const {
+    return rowsPerEntry_;
+  }
+
+  /// Encoded key of the first row of each entry.
+  const std::vector<std::string>& keys() const {
+    return keys_;
+  }
+
+ private:
+  const std::vector<std::string> keys_;
+  const int32_t rowsPerEntry_;
+  const int64_t numRows_;
+};
+
+} // namespace facebook::velox::serializer
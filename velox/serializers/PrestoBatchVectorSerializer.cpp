@@ -19,6 +19,7 @@
 #include "velox/serializers/PrestoSerializerEstimationUtils.h"
 #include "velox/serializers/PrestoSerializerSerializationUtils.h"
 #include "velox/serializers/VectorStream.h"
+#include "velox/vector/FlatMapVector.h"
 
 namespace facebook::velox::serializer::presto::detail {
 void PrestoBatchVectorSerializer::serialize(
@@ -193,6 +194,13 @@ void PrestoBatchVectorSerializer::estimateSerializedSizeImpl(
           arrayVector->elements(), childRanges, childSizes.data(), scratch);
       break;
     }
+    case VectorEncoding::Simple::FLAT_MAP:
+      estimateSerializedSizeImpl(
+          vector->asUnchecked<FlatMapVector>()->toMapVector(),
+          ranges,
+          sizes,
+          scratch);
+      break;
     case VectorEncoding::Simple::LAZY:
       estimateSerializedSizeImpl(
           vector->as<LazyVector>()->loadedVectorShared(),
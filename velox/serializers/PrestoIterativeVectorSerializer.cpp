@@ -26,6 +26,9 @@ PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
     : opts_(opts),
       streamArena_(streamArena),
       codec_(common::compressionKindToCodec(opts.compressionKind)),
+      adaptiveCodecs_(
+          opts.adaptiveCompression ? std::make_unique<AdaptiveCodecs>()
+                                   : nullptr),
       streams_(memory::StlAllocator<VectorStream>(*streamArena->pool())) {
   const auto types = rowType->children();
   const auto numTypes = types.size();
@@ -37,6 +40,8 @@ PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
   }
 }
 
+PrestoIterativeVectorSerializer::~PrestoIterativeVectorSerializer() = default;
+
 void PrestoIterativeVectorSerializer::append(
     const RowVectorPtr& vector,
     const folly::Range<const IndexRange*>& ranges,
@@ -71,9 +76,10 @@ size_t PrestoIterativeVectorSerializer::maxSerializedSize() const {
     dataSize += const_cast<VectorStream&>(stream).serializedSize();
   }
 
-  auto compressedSize = needCompression(*codec_)
-      ? codec_->maxCompressedLength(dataSize)
-      : dataSize;
+  auto compressedSize = adaptiveCodecs_ != nullptr
+      ? adaptiveCodecs_->maxCompressedLength(dataSize)
+      : needCompression(*codec_) ? codec_->maxCompressedLength(dataSize)
+                                 : dataSize;
   return kHeaderSize + compressedSize;
 }
 
@@ -82,7 +88,7 @@ size_t PrestoIterativeVectorSerializer::maxSerializedSize() const {
 // checksum(8) | data
 void PrestoIterativeVectorSerializer::flush(OutputStream* out) {
   constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
-  if (!needCompression(*codec_)) {
+  if (!needCompression(*codec_) && adaptiveCodecs_ == nullptr) {
     flushStreams(
         streams_,
         numRows_,
@@ -94,22 +100,32 @@ void PrestoIterativeVectorSerializer::flush(OutputStream* out) {
     if (numCompressionToSkip_ > 0) {
       const auto noCompressionCodec = common::compressionKindToCodec(
           common::CompressionKind::CompressionKind_NONE);
-      auto [size, ignore] = flushStreams(
+      const auto sizes = flushStreams(
           streams_, numRows_, *streamArena_, *noCompressionCodec, 1, out);
-      stats_.compressionSkippedBytes += size;
+      stats_.compressionSkippedBytes += sizes.uncompressedSize;
       --numCompressionToSkip_;
       ++stats_.numCompressionSkipped;
     } else {
-      auto [size, compressedSize] = flushStreams(
+      const auto sizes = flushStreams(
           streams_,
           numRows_,
           *streamArena_,
           *codec_,
           opts_.minCompressionRatio,
-          out);
-      stats_.compressionInputBytes += size;
-      stats_.compressedBytes += compressedSize;
-      if (compressedSize > size * opts_.minCompressionRatio) {
+          out,
+          adaptiveCodecs_.get());
+      if (sizes.compressionSkipped) {
+        // The data does not compress. There is no need to back off since the
+        // sampling is cheap.
+        stats_.compressionSkippedBytes += sizes.uncompressedSize;
+        ++stats_.numCompressionSkipped;
+        return;
+      }
+      stats_.compressionInputBytes += sizes.uncompressedSize;
+      stats_.compressedBytes += sizes.compressedSize;
+      stats_.compressionCpuNanos += sizes.compressionCpuNanos;
+      if (sizes.compressedSize >
+          sizes.uncompressedSize * opts_.minCompressionRatio) {
         numCompressionToSkip_ = std::min<int64_t>(
             kMaxCompressionAttemptsToSkip, 1 + stats_.numCompressionSkipped);
       }
@@ -137,6 +153,12 @@ PrestoIterativeVectorSerializer::runtimeStats() {
         RuntimeCounter(
             stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes));
   }
+  if (stats_.compressionCpuNanos != 0) {
+    map.emplace(
+        kCompressionCpuNanos,
+        RuntimeCounter(
+            stats_.compressionCpuNanos, RuntimeCounter::Unit::kNanos));
+  }
   return map;
 }
 
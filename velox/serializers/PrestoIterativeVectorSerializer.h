@@ -20,6 +20,7 @@
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::serializer::presto::detail {
+class AdaptiveCodecs;
 
 class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
  public:
@@ -29,6 +30,8 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       StreamArena* streamArena,
       const PrestoVectorSerde::PrestoOptions& opts);
 
+  ~PrestoIterativeVectorSerializer() override;
+
   void append(
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges,
@@ -54,6 +57,8 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   const PrestoVectorSerde::PrestoOptions opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::compression::Codec> codec_;
+  // Set if 'opts_.adaptiveCompression'.
+  const std::unique_ptr<AdaptiveCodecs> adaptiveCodecs_;
 
   int32_t numRows_{0};
   std::vector<VectorStream, memory::StlAllocator<VectorStream>> streams_;
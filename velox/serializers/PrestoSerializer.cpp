@@ -141,8 +141,6 @@ void PrestoVectorSerde::deserialize(
     vector_size_t resultOffset,
     const Options* options) {
   const auto prestoOptions = toPrestoOptions(options);
-  const auto codec =
-      common::compressionKindToCodec(prestoOptions.compressionKind);
   auto maybeHeader = detail::PrestoHeader::read(source);
   VELOX_CHECK(
       maybeHeader.hasValue(),
@@ -190,6 +188,10 @@ void PrestoVectorSerde::deserialize(
     source->readBytes(compressBuf->writableData(), header.compressedSize);
     compressBuf->append(header.compressedSize);
 
+    // An adaptively compressed page records its codec.
+    const auto codec = common::compressionKindToCodec(
+        detail::pageCompressionKind(header.pageCodecMarker)
+            .value_or(prestoOptions.compressionKind));
     // Process chained uncompressed results IOBufs.
     auto uncompress =
         codec->uncompress(compressBuf.get(), header.uncompressedSize);
@@ -86,6 +86,13 @@ class PrestoVectorSerde : public VectorSerde {
     /// affect the encoding of the input vectors. This is only relevant when
     /// using BatchVectorSerializer.
     bool preserveEncodings{false};
+
+    /// If true, the iterative serializer chooses the codec of each page from
+    /// none, LZ4 and ZSTD by sampling the entropy of the page, instead of
+    /// using 'compressionKind'. The codec is recorded in the page header, so
+    /// the pages can be read with any 'compressionKind'. Such pages can only
+    /// be read by Velox.
+    bool adaptiveCompression{false};
   };
 
   PrestoVectorSerde() : VectorSerde(Kind::kPresto) {}
@@ -33,6 +33,17 @@ inline bool isChecksumBitSet(int8_t codec) {
   return (codec & kCheckSumBitMask) == kCheckSumBitMask;
 }
 
+/// Returns the compression kind of an adaptively compressed page or
+/// std::nullopt if the page uses the codec of the deserialization options.
+inline std::optional<common::CompressionKind> pageCompressionKind(
+    int8_t codec) {
+  const auto kind = (codec & kCodecKindMask) >> kCodecKindShift;
+  if (kind == 0) {
+    return std::nullopt;
+  }
+  return static_cast<common::CompressionKind>(kind);
+}
+
 void readTopColumns(
     ByteInputStream& source,
     const RowTypePtr& type,
@@ -15,6 +15,7 @@
  */
 #include "velox/serializers/PrestoSerializerEstimationUtils.h"
 
+#include "velox/vector/FlatMapVector.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorTypeUtils.h"
 
@@ -341,6 +342,13 @@ void estimateSerializedSizeInt(
           scratch);
       break;
     }
+    case VectorEncoding::Simple::FLAT_MAP:
+      estimateSerializedSizeInt(
+          vector->asUnchecked<FlatMapVector>()->toMapVector().get(),
+          ranges,
+          sizes,
+          scratch);
+      break;
     case VectorEncoding::Simple::LAZY:
       estimateSerializedSizeInt(vector->loadedVector(), ranges, sizes, scratch);
       break;
@@ -533,6 +541,13 @@ void estimateSerializedSizeInt(
           scratch);
       break;
     }
+    case VectorEncoding::Simple::FLAT_MAP:
+      estimateSerializedSizeInt(
+          vector->asUnchecked<FlatMapVector>()->toMapVector().get(),
+          rows,
+          sizes,
+          scratch);
+      break;
     case VectorEncoding::Simple::LAZY:
       estimateSerializedSizeInt(vector->loadedVector(), rows, sizes, scratch);
       break;
@@ -16,8 +16,12 @@
 
 #include "velox/serializers/PrestoSerializerSerializationUtils.h"
 
+#include <array>
+#include <cmath>
+
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/DictionaryVector.h"
+#include "velox/vector/FlatMapVector.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorTypeUtils.h"
 
@@ -1085,6 +1089,14 @@ void serializeColumn(
     case VectorEncoding::Simple::MAP:
       serializeMapVectorRanges(vector, ranges, stream, scratch);
       break;
+    case VectorEncoding::Simple::FLAT_MAP:
+      // The wire format has no flat map layout.
+      serializeColumn(
+          vector->asUnchecked<FlatMapVector>()->toMapVector(),
+          ranges,
+          stream,
+          scratch);
+      break;
     case VectorEncoding::Simple::LAZY:
       serializeColumn(
           BaseVector::loadedVectorShared(vector), ranges, stream, scratch);
@@ -1129,6 +1141,13 @@ void serializeColumn(
     case VectorEncoding::Simple::MAP:
       serializeMapVector(vector, rows, stream, scratch);
       break;
+    case VectorEncoding::Simple::FLAT_MAP:
+      serializeColumn(
+          vector->asUnchecked<FlatMapVector>()->toMapVector(),
+          rows,
+          stream,
+          scratch);
+      break;
     case VectorEncoding::Simple::LAZY:
       serializeColumn(
           BaseVector::loadedVectorShared(vector), rows, stream, scratch);
@@ -1200,4 +1219,45 @@ int32_t rowsToRanges(
   }
   return fill;
 }
+
+double sampleEntropy(const folly::IOBuf& iobuf) {
+  // Number of bytes sampled at a fixed stride.
+  constexpr uint64_t kMaxSamples = 16 << 10;
+  const auto size = iobuf.computeChainDataLength();
+  if (size == 0) {
+    return 0;
+  }
+  const uint64_t stride = std::max<uint64_t>(1, size / kMaxSamples);
+  std::array<uint32_t, 256> counts{};
+  uint64_t numSamples = 0;
+  uint64_t offset = 0;
+  for (const auto& range : iobuf) {
+    for (; offset < range.size(); offset += stride) {
+      ++counts[range[offset]];
+      ++numSamples;
+    }
+    offset -= range.size();
+  }
+  double entropy = 0;
+  for (const auto count : counts) {
+    if (count != 0) {
+      const double probability = static_cast<double>(count) / numSamples;
+      entropy -= probability * std::log2(probability);
+    }
+  }
+  return entropy;
+}
+
+AdaptiveCodecs::AdaptiveCodecs()
+    : lz4_(common::compressionKindToCodec(
+          common::CompressionKind::CompressionKind_LZ4)),
+      zstd_(common::compressionKindToCodec(
+          common::CompressionKind::CompressionKind_ZSTD)) {}
+
+folly::compression::Codec* AdaptiveCodecs::select(double entropy) const {
+  if (entropy >= kMaxCompressedEntropy) {
+    return nullptr;
+  }
+  return entropy <= kMaxZstdEntropy ? zstd_.get() : lz4_.get();
+}
 } // namespace facebook::velox::serializer::presto::detail
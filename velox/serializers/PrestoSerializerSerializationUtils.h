@@ -17,6 +17,7 @@
 #include <folly/IPAddressV6.h>
 
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/CpuWallTimer.h"
 #include "velox/functions/prestosql/types/IPPrefixType.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/serializers/VectorStream.h"
@@ -30,6 +31,10 @@ namespace facebook::velox::serializer::presto::detail {
 constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
+// Bits 3 to 5 of the codec marker of an adaptively compressed page hold the
+// CompressionKind of the page. They are zero for the other pages.
+constexpr int8_t kCodecKindShift = 3;
+constexpr int8_t kCodecKindMask = 7 << kCodecKindShift;
 // uncompressed size comes after the number of rows and the codec
 constexpr int32_t kSizeInBytesOffset{4 + 1};
 // There header for a page is:
@@ -157,6 +162,38 @@ vector_size_t computeSelectedIndices(
 struct FlushSizes {
   int64_t uncompressedSize;
   int64_t compressedSize;
+  // CPU time spent compressing.
+  uint64_t compressionCpuNanos{0};
+  // True if adaptive compression did not try to compress the data.
+  bool compressionSkipped{false};
+};
+
+// Returns the entropy in bits per byte of a sample of the bytes in 'iobuf'.
+double sampleEntropy(const folly::IOBuf& iobuf);
+
+// Codecs of adaptive compression. See PrestoOptions::adaptiveCompression.
+class AdaptiveCodecs {
+ public:
+  // Data with more entropy is not compressed.
+  static constexpr double kMaxCompressedEntropy = 7.5;
+  // Data with less entropy is compressed with ZSTD, otherwise with LZ4.
+  static constexpr double kMaxZstdEntropy = 5;
+
+  AdaptiveCodecs();
+
+  // Returns the codec for data with 'entropy' bits per byte or nullptr if the
+  // data should not be compressed.
+  folly::compression::Codec* select(double entropy) const;
+
+  uint64_t maxCompressedLength(uint64_t uncompressedLength) const {
+    return std::max(
+        lz4_->maxCompressedLength(uncompressedLength),
+        zstd_->maxCompressedLength(uncompressedLength));
+  }
+
+ private:
+  const std::unique_ptr<folly::compression::Codec> lz4_;
+  const std::unique_ptr<folly::compression::Codec> zstd_;
 };
 
 FOLLY_ALWAYS_INLINE bool needCompression(
@@ -283,7 +320,8 @@ inline FlushSizes flushCompressed(
     int32_t numRows,
     float minCompressionRatio,
     OutputStream* output,
-    PrestoOutputStreamListener* listener) {
+    PrestoOutputStreamListener* listener,
+    const AdaptiveCodecs* adaptiveCodecs) {
   char codecMask = kCompressedBitMask;
   if (listener) {
     codecMask |= kCheckSumBitMask;
@@ -304,23 +342,46 @@ inline FlushSizes flushCompressed(
   }
 
   const int32_t uncompressedSize = out.tellp();
+  auto iobuf = out.getIOBuf();
+  auto* selectedCodec = &codec;
+  if (adaptiveCodecs != nullptr) {
+    selectedCodec = adaptiveCodecs->select(sampleEntropy(*iobuf));
+    if (selectedCodec == nullptr) {
+      flushSerialization(
+          numRows,
+          uncompressedSize,
+          uncompressedSize,
+          codecMask & ~kCompressedBitMask,
+          iobuf,
+          output,
+          listener);
+      return {uncompressedSize, uncompressedSize, 0, true};
+    }
+    codecMask |= (common::codecTypeToCompressionKind(selectedCodec->type())
+                  << kCodecKindShift) &
+        kCodecKindMask;
+  }
   VELOX_CHECK_LE(
       uncompressedSize,
-      codec.maxUncompressedLength(),
+      selectedCodec->maxUncompressedLength(),
       "UncompressedSize exceeds limit");
-  auto iobuf = out.getIOBuf();
-  const auto compressedBuffer = codec.compress(iobuf.get());
+  CpuWallTiming compressionTiming;
+  std::unique_ptr<folly::IOBuf> compressedBuffer;
+  {
+    CpuWallTimer timer(compressionTiming);
+    compressedBuffer = selectedCodec->compress(iobuf.get());
+  }
   const int32_t compressedSize = compressedBuffer->computeChainDataLength();
   if (compressedSize > uncompressedSize * minCompressionRatio) {
     flushSerialization(
         numRows,
         uncompressedSize,
         uncompressedSize,
-        codecMask & ~kCompressedBitMask,
+        codecMask & ~(kCompressedBitMask | kCodecKindMask),
         iobuf,
         output,
         listener);
-    return {uncompressedSize, uncompressedSize};
+    return {uncompressedSize, uncompressedSize, compressionTiming.cpuNanos};
   }
   flushSerialization(
       numRows,
@@ -330,7 +391,7 @@ inline FlushSizes flushCompressed(
       compressedBuffer,
       output,
       listener);
-  return {uncompressedSize, compressedSize};
+  return {uncompressedSize, compressedSize, compressionTiming.cpuNanos};
 }
 
 template <typename Allocator>
@@ -340,19 +401,27 @@ inline FlushSizes flushStreams(
     const StreamArena& arena,
     folly::compression::Codec& codec,
     float minCompressionRatio,
-    OutputStream* out) {
+    OutputStream* out,
+    const AdaptiveCodecs* adaptiveCodecs = nullptr) {
   auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
   // Reset CRC computation
   if (listener) {
     listener->reset();
   }
 
-  if (!needCompression(codec)) {
+  if (!needCompression(codec) && adaptiveCodecs == nullptr) {
     const auto size = flushUncompressed(streams, numRows, out, listener);
     return {size, size};
   } else {
     return flushCompressed(
-        streams, arena, codec, numRows, minCompressionRatio, out, listener);
+        streams,
+        arena,
+        codec,
+        numRows,
+        minCompressionRatio,
+        out,
+        listener,
+        adaptiveCodecs);
   }
 }
 
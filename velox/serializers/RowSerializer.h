@@ -73,10 +73,15 @@ class RowSerializer : public IterativeVectorSerializer {
     } else {
       vector_size_t index = 0;
       for (const auto& range : ranges) {
-        for (auto i = 0; i < range.size; ++i, ++index) {
-          rowSize[index] = row.rowSize(range.begin + i);
-          totalSize += rowSize[index] + sizeof(TRowSize);
+        if (range.size == 1) {
+          rowSize[index] = row.rowSize(range.begin);
+        } else {
+          row.rowSizes(range.begin, range.size, rowSize.data() + index);
         }
+        index += range.size;
+      }
+      for (const auto size : rowSize) {
+        totalSize += size + sizeof(TRowSize);
       }
     }
 
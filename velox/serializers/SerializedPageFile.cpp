@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <memory>
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 
 namespace facebook::velox::serializer {
 std::unique_ptr<SerializedPageFile> SerializedPageFile::create(
@@ -70,14 +71,28 @@ SerializedPageFileWriter::SerializedPageFileWriter(
     const std::string& fileCreateConfig,
     std::unique_ptr<VectorSerde::Options> serdeOptions,
     VectorSerde* serde,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    folly::Executor* writeExecutor)
     : pathPrefix_(pathPrefix),
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
       serdeOptions_(std::move(serdeOptions)),
       pool_(pool),
-      serde_(serde) {}
+      serde_(serde),
+      writeExecutor_(writeExecutor) {}
+
+SerializedPageFileWriter::~SerializedPageFileWriter() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  // The write accesses 'currentFile_' so it must finish before this is
+  // destroyed. This must not throw. The error is reported by finish().
+  try {
+    pendingWrite_->move();
+  } catch (const std::exception&) {
+  }
+}
 
 SerializedPageFile* SerializedPageFileWriter::ensureFile() {
   if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
@@ -86,13 +101,14 @@ SerializedPageFile* SerializedPageFileWriter::ensureFile() {
   if (currentFile_ == nullptr) {
     currentFile_ = SerializedPageFile::create(
         nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+        fmt::format("{}-{}", nextFilePathPrefix(), finishedFiles_.size()),
         fileCreateConfig_);
   }
   return currentFile_.get();
 }
 
 void SerializedPageFileWriter::closeFile() {
+  waitForPendingWrite();
   if (currentFile_ == nullptr) {
     return;
   }
@@ -107,14 +123,23 @@ size_t SerializedPageFileWriter::numFinishedFiles() const {
   return finishedFiles_.size();
 }
 
+void SerializedPageFileWriter::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto pendingWrite = std::move(pendingWrite_);
+  const auto result = pendingWrite->move();
+  VELOX_CHECK_NOT_NULL(result);
+  updateWriteStats(
+      result->writtenBytes, result->flushTimeNs, result->writeTimeNs);
+}
+
 uint64_t SerializedPageFileWriter::flush() {
   if (batch_ == nullptr) {
     return 0;
   }
 
-  auto* file = ensureFile();
-  VELOX_CHECK_NOT_NULL(file);
-
+  // Serializes the batch while the previous one is being written.
   IOBufOutputStream out(
       *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
   uint64_t flushTimeNs{0};
@@ -123,16 +148,39 @@ uint64_t SerializedPageFileWriter::flush() {
     batch_->flush(&out);
   }
   batch_.reset();
-
-  uint64_t writeTimeNs{0};
-  uint64_t writtenBytes{0};
   auto iobuf = out.getIOBuf();
-  {
-    NanosecondTimer timer(&writeTimeNs);
-    writtenBytes = file->write(std::move(iobuf));
+
+  waitForPendingWrite();
+  auto* file = ensureFile();
+  VELOX_CHECK_NOT_NULL(file);
+
+  if (writeExecutor_ == nullptr) {
+    uint64_t writeTimeNs{0};
+    uint64_t writtenBytes{0};
+    {
+      NanosecondTimer timer(&writeTimeNs);
+      writtenBytes = file->write(std::move(iobuf));
+    }
+    updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
+    return writtenBytes;
   }
-  updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
-  return writtenBytes;
+
+  const auto writeBytes = iobuf->computeChainDataLength();
+  // The task must be copyable to be stored in a std::function.
+  auto data =
+      std::make_shared<std::unique_ptr<folly::IOBuf>>(std::move(iobuf));
+  pendingWrite_ = memory::createAsyncMemoryReclaimTask<WriteResult>(
+      [file, flushTimeNs, data]() {
+        auto result = std::make_unique<WriteResult>();
+        result->flushTimeNs = flushTimeNs;
+        {
+          NanosecondTimer timer(&result->writeTimeNs);
+          result->writtenBytes = file->write(std::move(*data));
+        }
+        return result;
+      });
+  writeExecutor_->add([write = pendingWrite_]() { write->prepare(); });
+  return writeBytes;
 }
 
 uint64_t SerializedPageFileWriter::write(
@@ -184,7 +232,8 @@ SerializedPageFileReader::SerializedPageFileReader(
     const RowTypePtr& type,
     VectorSerde* serde,
     std::unique_ptr<VectorSerde::Options> readOptions,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    io::IoPurpose ioPurpose)
     : readOptions_(std::move(readOptions)),
       pool_(pool),
       serde_(serde),
@@ -192,7 +241,7 @@ SerializedPageFileReader::SerializedPageFileReader(
   auto fs = filesystems::getFileSystem(path, nullptr);
   auto file = fs->openFileForRead(path);
   input_ = std::make_unique<common::FileInputStream>(
-      std::move(file), bufferSize, pool_);
+      std::move(file), bufferSize, pool_, ioPurpose);
 }
 
 bool SerializedPageFileReader::nextBatch(RowVectorPtr& rowVector) {
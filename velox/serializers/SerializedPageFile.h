@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/io/IOBuf.h>
 #include <cstdint>
 #include <memory>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/serializers/VectorStream.h"
@@ -89,7 +91,10 @@ class SerializedPageFileWriter {
   /// before write to file. 'fileCreateConfig' specifies the file layout on
   /// remote storage which is storage system specific. 'serdeOptions' specifies
   /// the serialization options to use. 'serde' specifies the VectorSerde
-  /// instance to use. 'pool' is used for buffering.
+  /// instance to use. 'pool' is used for buffering. If 'writeExecutor' is set,
+  /// the serialized pages are written to file on it while the next page is
+  /// serialized. A flush waits for the previous write to finish, so there is
+  /// at most one write in flight.
   SerializedPageFileWriter(
       const std::string& pathPrefix,
       uint64_t targetFileSize,
@@ -97,9 +102,10 @@ class SerializedPageFileWriter {
       const std::string& fileCreateConfig,
       std::unique_ptr<VectorSerde::Options> serdeOptions,
       VectorSerde* serde,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* writeExecutor = nullptr);
 
-  virtual ~SerializedPageFileWriter() = default;
+  virtual ~SerializedPageFileWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'.
   /// Returns the size to write.
@@ -134,13 +140,23 @@ class SerializedPageFileWriter {
   virtual void updateFileStats(const SerializedPageFile::FileInfo& /* file */) {
   }
 
+  // Invoked upon each file open to get the path prefix of the new file.
+  virtual std::string nextFilePathPrefix() {
+    return pathPrefix_;
+  }
+
   // Closes the current open file pointed by 'currentFile_'.
   virtual void closeFile();
 
   // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // written size. If 'writeExecutor_' is set, returns the size of the write
+  // started in the background.
   virtual uint64_t flush();
 
+  // Waits for the background write started by the last flush if any and
+  // rethrows its error.
+  void waitForPendingWrite();
+
   FOLLY_ALWAYS_INLINE void checkNotFinished() const {
     VELOX_CHECK(!finished_, "SerializedPageFileWriter has finished");
   }
@@ -159,12 +175,23 @@ class SerializedPageFileWriter {
   const std::unique_ptr<VectorSerde::Options> serdeOptions_;
   memory::MemoryPool* const pool_;
   VectorSerde* const serde_;
+  folly::Executor* const writeExecutor_;
 
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
   std::unique_ptr<SerializedPageFile> currentFile_;
   std::vector<SerializedPageFile::FileInfo> finishedFiles_;
+
+ private:
+  struct WriteResult {
+    uint64_t writtenBytes;
+    uint64_t flushTimeNs;
+    uint64_t writeTimeNs;
+  };
+
+  // The background write of the last flushed page to 'currentFile_'.
+  std::shared_ptr<AsyncSource<WriteResult>> pendingWrite_;
 };
 
 /// Used to read the serialized page data from a single file generated by
@@ -177,7 +204,8 @@ class SerializedPageFileReader {
       const RowTypePtr& type,
       VectorSerde* serde,
       std::unique_ptr<VectorSerde::Options> readOptions,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      io::IoPurpose ioPurpose = io::IoPurpose::kOther);
 
   virtual ~SerializedPageFileReader() = default;
 
@@ -0,0 +1,608 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/StreamDictionarySerializer.h"
+
+#include <folly/Random.h>
+#include <sstream>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Nulls.h"
+#include "velox/serializers/PrestoSerializer.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+enum class ColumnEncoding : int8_t {
+  kFlat = 0,
+  kConstant = 1,
+  kDictionary = 2,
+};
+
+presto::PrestoVectorSerde& prestoSerde() {
+  static presto::PrestoVectorSerde serde;
+  return serde;
+}
+
+// Options for the columns that are stored in the Presto format. Timestamps
+// keep their nanosecond precision.
+const presto::PrestoVectorSerde::PrestoOptions& prestoOptions() {
+  static const presto::PrestoVectorSerde::PrestoOptions options(
+      /*_useLosslessTimestamp=*/true,
+      common::CompressionKind::CompressionKind_NONE);
+  return options;
+}
+
+template <typename T>
+void writeOne(OutputStream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::string serializeColumn(const VectorPtr& column, memory::MemoryPool* pool) {
+  std::ostringstream stream;
+  prestoSerde().serializeSingleColumn(column, &prestoOptions(), pool, &stream);
+  return stream.str();
+}
+
+void writeColumn(OutputStream& out, const std::string& data) {
+  writeOne<int32_t>(out, data.size());
+  out.write(data.data(), data.size());
+}
+
+// Reads a column written by writeColumn().
+VectorPtr readColumn(
+    ByteInputStream* source,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  const auto size = source->read<int32_t>();
+  std::string data(size, '\0');
+  source->readBytes(data.data(), size);
+  BufferInputStream stream({ByteRange{
+      reinterpret_cast<uint8_t*>(data.data()), static_cast<int64_t>(size), 0}});
+  VectorPtr result;
+  prestoSerde().deserializeSingleColumn(
+      &stream, pool, type, &result, &prestoOptions());
+  return result;
+}
+
+bool isDictionary(const BaseVector& column) {
+  return column.encoding() == VectorEncoding::Simple::DICTIONARY &&
+      column.valueVector() != nullptr && column.valueVector()->size() > 0;
+}
+
+// The rows of one column appended since the last flush. Keeps the constant or
+// dictionary encoding of the column for as long as the appended vectors have
+// the same constant value or wrap the same base.
+class ColumnBuffer {
+ public:
+  ColumnBuffer(TypePtr type, memory::MemoryPool* pool)
+      : type_(std::move(type)), pool_(pool) {}
+
+  void append(
+      const VectorPtr& column,
+      folly::Range<const vector_size_t*> rows) {
+    if (rows.empty()) {
+      return;
+    }
+    if (numRows_ == 0) {
+      start(column);
+    } else if (!canAppendEncoded(*column)) {
+      flatten();
+    }
+    switch (encoding_) {
+      case ColumnEncoding::kConstant:
+        break;
+      case ColumnEncoding::kDictionary:
+        appendIndices(*column, rows);
+        break;
+      case ColumnEncoding::kFlat:
+        appendFlat(*column, rows);
+        break;
+    }
+    numRows_ += rows.size();
+  }
+
+  // Copies the buffered rows into a flat vector.
+  void flatten() {
+    if (encoding_ == ColumnEncoding::kFlat) {
+      return;
+    }
+    const auto encoded = encodedVector();
+    flat_ = BaseVector::create(type_, numRows_, pool_);
+    flat_->copy(encoded.get(), 0, 0, numRows_);
+    encoding_ = ColumnEncoding::kFlat;
+    constant_ = nullptr;
+    base_ = nullptr;
+    indices_.clear();
+    nulls_.clear();
+    hasNulls_ = false;
+  }
+
+  ColumnEncoding encoding() const {
+    return encoding_;
+  }
+
+  const VectorPtr& base() const {
+    return base_;
+  }
+
+  vector_size_t numRows() const {
+    return numRows_;
+  }
+
+  // Writes the payload of the column. 'dictionaryId' is the id of 'base_' if
+  // dictionary encoded.
+  void write(OutputStream& out, int32_t dictionaryId) {
+    writeOne(out, encoding_);
+    switch (encoding_) {
+      case ColumnEncoding::kFlat:
+        if (flat_ == nullptr) {
+          flat_ = BaseVector::create(type_, 0, pool_);
+        }
+        writeColumn(out, serializeColumn(flat_, pool_));
+        break;
+      case ColumnEncoding::kConstant:
+        writeColumn(
+            out,
+            serializeColumn(
+                BaseVector::wrapInConstant(1, 0, constant_), pool_));
+        break;
+      case ColumnEncoding::kDictionary:
+        VELOX_CHECK_GE(dictionaryId, 0);
+        writeOne(out, dictionaryId);
+        writeOne(out, hasNulls_);
+        if (hasNulls_) {
+          out.write(
+              reinterpret_cast<const char*>(nulls_.data()),
+              bits::nbytes(numRows_));
+        }
+        out.write(
+            reinterpret_cast<const char*>(indices_.data()),
+            numRows_ * sizeof(vector_size_t));
+        break;
+    }
+  }
+
+  uint64_t estimateSerializedSize() const {
+    switch (encoding_) {
+      case ColumnEncoding::kFlat:
+        return flat_ == nullptr ? 0 : flat_->estimateFlatSize();
+      case ColumnEncoding::kConstant:
+        return constant_->estimateFlatSize();
+      case ColumnEncoding::kDictionary:
+        return bits::nbytes(numRows_) + numRows_ * sizeof(vector_size_t);
+    }
+    VELOX_UNREACHABLE();
+  }
+
+  void clear() {
+    encoding_ = ColumnEncoding::kFlat;
+    numRows_ = 0;
+    flat_ = nullptr;
+    constant_ = nullptr;
+    base_ = nullptr;
+    indices_.clear();
+    nulls_.clear();
+    hasNulls_ = false;
+  }
+
+ private:
+  void start(const VectorPtr& column) {
+    if (column->isConstantEncoding()) {
+      encoding_ = ColumnEncoding::kConstant;
+      constant_ = column;
+    } else if (isDictionary(*column)) {
+      encoding_ = ColumnEncoding::kDictionary;
+      base_ = column->valueVector();
+    } else {
+      encoding_ = ColumnEncoding::kFlat;
+      flat_ = BaseVector::create(type_, 0, pool_);
+    }
+  }
+
+  bool canAppendEncoded(const BaseVector& column) const {
+    switch (encoding_) {
+      case ColumnEncoding::kConstant:
+        return column.isConstantEncoding() &&
+            column.equalValueAt(constant_.get(), 0, 0);
+      case ColumnEncoding::kDictionary:
+        return isDictionary(column) && column.valueVector() == base_;
+      case ColumnEncoding::kFlat:
+        return true;
+    }
+    VELOX_UNREACHABLE();
+  }
+
+  void appendIndices(
+      const BaseVector& column,
+      folly::Range<const vector_size_t*> rows) {
+    const auto* indices = column.wrapInfo()->as<vector_size_t>();
+    const auto* nulls = column.rawNulls();
+    for (const auto row : rows) {
+      const auto index = indices_.size();
+      if (index % 64 == 0) {
+        nulls_.push_back(bits::kNotNull64);
+      }
+      if (nulls != nullptr && bits::isBitNull(nulls, row)) {
+        bits::setNull(nulls_.data(), index);
+        hasNulls_ = true;
+        indices_.push_back(0);
+      } else {
+        indices_.push_back(indices[row]);
+      }
+    }
+  }
+
+  void appendFlat(
+      const BaseVector& column,
+      folly::Range<const vector_size_t*> rows) {
+    const auto offset = flat_->size();
+    std::vector<BaseVector::CopyRange> ranges;
+    for (auto i = 0; i < rows.size(); ++i) {
+      if (!ranges.empty() &&
+          ranges.back().sourceIndex + ranges.back().count == rows[i]) {
+        ++ranges.back().count;
+      } else {
+        ranges.push_back({rows[i], offset + i, 1});
+      }
+    }
+    flat_->resize(offset + rows.size());
+    flat_->copyRanges(&column, ranges);
+  }
+
+  // Returns the buffered rows with their constant or dictionary encoding.
+  VectorPtr encodedVector() const {
+    if (encoding_ == ColumnEncoding::kConstant) {
+      return BaseVector::wrapInConstant(numRows_, 0, constant_);
+    }
+    VELOX_CHECK(encoding_ == ColumnEncoding::kDictionary);
+    auto indices = AlignedBuffer::allocate<vector_size_t>(numRows_, pool_);
+    ::memcpy(
+        indices->asMutable<vector_size_t>(),
+        indices_.data(),
+        numRows_ * sizeof(vector_size_t));
+    BufferPtr nulls;
+    if (hasNulls_) {
+      nulls = AlignedBuffer::allocate<bool>(numRows_, pool_);
+      ::memcpy(
+          nulls->asMutable<uint64_t>(), nulls_.data(), bits::nbytes(numRows_));
+    }
+    return BaseVector::wrapInDictionary(
+        std::move(nulls), std::move(indices), numRows_, base_);
+  }
+
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+  ColumnEncoding encoding_{ColumnEncoding::kFlat};
+  vector_size_t numRows_{0};
+  // The rows if flat.
+  VectorPtr flat_;
+  // The constant vector of the rows if constant.
+  VectorPtr constant_;
+  // The base vector, indices and nulls of the rows if dictionary encoded.
+  VectorPtr base_;
+  std::vector<vector_size_t> indices_;
+  std::vector<uint64_t> nulls_;
+  bool hasNulls_{false};
+};
+
+class StreamDictionarySerializer : public IterativeVectorSerializer {
+ public:
+  StreamDictionarySerializer(RowTypePtr type, memory::MemoryPool* pool)
+      : type_(std::move(type)),
+        pool_(pool),
+        streamId_(folly::Random::rand64()) {
+    columns_.reserve(type_->size());
+    for (const auto& child : type_->children()) {
+      columns_.emplace_back(child, pool_);
+    }
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& /*scratch*/) override {
+    std::vector<vector_size_t> rows;
+    for (const auto& range : ranges) {
+      for (auto i = 0; i < range.size; ++i) {
+        rows.push_back(range.begin + i);
+      }
+    }
+    appendRows(vector, rows);
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const vector_size_t*>& rows,
+      Scratch& /*scratch*/) override {
+    appendRows(vector, rows);
+  }
+
+  size_t maxSerializedSize() const override {
+    size_t size = sizeof(uint64_t) + 3 * sizeof(int32_t);
+    for (const auto& column : columns_) {
+      size += 1 + 2 * sizeof(int32_t) + column.estimateSerializedSize();
+      if (column.encoding() == ColumnEncoding::kDictionary &&
+          !shipped_.contains(column.base().get())) {
+        size += 3 * sizeof(int32_t) + column.base()->estimateFlatSize();
+      }
+    }
+    return size;
+  }
+
+  void flush(OutputStream* out) override {
+    // Ships the dictionaries that are not yet shipped and flattens the
+    // dictionary columns that are not worth it.
+    std::vector<int32_t> dictionaryIds(columns_.size(), -1);
+    std::vector<Definition> definitions;
+    for (auto i = 0; i < columns_.size(); ++i) {
+      if (columns_[i].encoding() == ColumnEncoding::kDictionary) {
+        dictionaryIds[i] = dictionaryId(i, definitions);
+        if (dictionaryIds[i] < 0) {
+          columns_[i].flatten();
+        }
+      }
+    }
+
+    writeOne(*out, streamId_);
+    writeOne<int32_t>(*out, definitions.size());
+    for (const auto& definition : definitions) {
+      writeOne(*out, definition.dictionaryId);
+      writeOne(*out, definition.column);
+      writeColumn(*out, definition.data);
+    }
+    writeOne<int32_t>(*out, numRows_);
+    writeOne<int32_t>(*out, columns_.size());
+    for (auto i = 0; i < columns_.size(); ++i) {
+      columns_[i].write(*out, dictionaryIds[i]);
+    }
+  }
+
+  void clear() override {
+    for (auto& column : columns_) {
+      column.clear();
+    }
+    numRows_ = 0;
+  }
+
+ private:
+  struct Definition {
+    int32_t dictionaryId;
+    int32_t column;
+    std::string data;
+  };
+
+  struct ShippedDictionary {
+    // Keeps the base alive so that its address is not reused.
+    VectorPtr base;
+    int32_t dictionaryId;
+  };
+
+  void appendRows(
+      const RowVectorPtr& vector,
+      folly::Range<const vector_size_t*> rows) {
+    for (auto i = 0; i < columns_.size(); ++i) {
+      columns_[i].append(
+          BaseVector::loadedVectorShared(vector->childAt(i)), rows);
+    }
+    numRows_ += rows.size();
+  }
+
+  // Returns the id of the dictionary of 'column'. Adds a definition to
+  // 'definitions' if the dictionary is not yet shipped. Returns -1 if the
+  // dictionary is not to be shipped.
+  int32_t dictionaryId(int32_t column, std::vector<Definition>& definitions) {
+    const auto& base = columns_[column].base();
+    const auto it = shipped_.find(base.get());
+    if (it != shipped_.end()) {
+      return it->second.dictionaryId;
+    }
+    constexpr auto kMaxBytes =
+        StreamDictionaryVectorSerde::kMaxStreamDictionaryBytes;
+    if (base->size() > columns_[column].numRows() ||
+        shippedBytes_ >= kMaxBytes) {
+      return -1;
+    }
+    auto data = serializeColumn(base, pool_);
+    if (shippedBytes_ + data.size() > kMaxBytes) {
+      return -1;
+    }
+    const int32_t dictionaryId = shipped_.size();
+    shipped_.emplace(base.get(), ShippedDictionary{base, dictionaryId});
+    shippedBytes_ += data.size();
+    definitions.push_back({dictionaryId, column, std::move(data)});
+    return dictionaryId;
+  }
+
+  const RowTypePtr type_;
+  memory::MemoryPool* const pool_;
+  // Identifies the pages of 'this' to the consumers.
+  const uint64_t streamId_;
+  std::vector<ColumnBuffer> columns_;
+  vector_size_t numRows_{0};
+  // The dictionaries shipped in the earlier pages, by base vector.
+  folly::F14FastMap<const BaseVector*, ShippedDictionary> shipped_;
+  uint64_t shippedBytes_{0};
+};
+} // namespace
+
+void StreamDictionaryCache::addDictionaries(
+    const folly::IOBuf& page,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool) {
+  std::vector<ByteRange> ranges;
+  for (const auto& range : page) {
+    if (!range.empty()) {
+      ranges.push_back(
+          {const_cast<uint8_t*>(range.data()),
+           static_cast<int64_t>(range.size()),
+           0});
+    }
+  }
+  BufferInputStream source(std::move(ranges));
+  addDictionaries(&source, type, pool);
+}
+
+uint64_t StreamDictionaryCache::addDictionaries(
+    ByteInputStream* source,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool) {
+  const auto streamId = source->read<uint64_t>();
+  const auto numDefinitions = source->read<int32_t>();
+  for (auto i = 0; i < numDefinitions; ++i) {
+    const auto dictionaryId = source->read<int32_t>();
+    const auto column = source->read<int32_t>();
+    VELOX_CHECK_LT(column, type->size());
+    if (find(streamId, dictionaryId) != nullptr) {
+      source->skip(source->read<int32_t>());
+      continue;
+    }
+    auto dictionary = readColumn(source, type->childAt(column), pool);
+    std::lock_guard<std::mutex> l(mutex_);
+    dictionaries_.emplace(Key{streamId, dictionaryId}, std::move(dictionary));
+  }
+  return streamId;
+}
+
+VectorPtr StreamDictionaryCache::find(uint64_t streamId, int32_t dictionaryId)
+    const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto it = dictionaries_.find(Key{streamId, dictionaryId});
+  return it == dictionaries_.end() ? nullptr : it->second;
+}
+
+size_t StreamDictionaryCache::size() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return dictionaries_.size();
+}
+
+void StreamDictionaryCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  dictionaries_.clear();
+}
+
+void StreamDictionaryVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t** sizes,
+    Scratch& scratch) {
+  const auto* rowVector = vector->loadedVector()->asChecked<RowVector>();
+  for (const auto& child : rowVector->children()) {
+    const auto* column = child->loadedVector();
+    if (column->isConstantEncoding()) {
+      continue;
+    }
+    if (isDictionary(*column)) {
+      for (auto i = 0; i < rows.size(); ++i) {
+        *sizes[i] += sizeof(vector_size_t);
+      }
+      continue;
+    }
+    prestoSerde().estimateSerializedSize(column, rows, sizes, scratch);
+  }
+}
+
+std::unique_ptr<IterativeVectorSerializer>
+StreamDictionaryVectorSerde::createIterativeSerializer(
+    RowTypePtr type,
+    int32_t /*numRows*/,
+    StreamArena* streamArena,
+    const Options* /*options*/) {
+  return std::make_unique<StreamDictionarySerializer>(
+      std::move(type), streamArena->pool());
+}
+
+void StreamDictionaryVectorSerde::deserialize(
+    ByteInputStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    vector_size_t resultOffset,
+    const Options* options) {
+  const auto* dictionaryOptions =
+      dynamic_cast<const StreamDictionaryOptions*>(options);
+  VELOX_CHECK_NOT_NULL(
+      dictionaryOptions, "StreamDictionary serde needs its options");
+  auto& dictionaries = *dictionaryOptions->dictionaries;
+  const auto streamId = dictionaries.addDictionaries(source, type, pool);
+  const auto numRows = source->read<int32_t>();
+  const auto numColumns = source->read<int32_t>();
+  VELOX_CHECK_EQ(numColumns, type->size());
+
+  std::vector<VectorPtr> children(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    const auto encoding = static_cast<ColumnEncoding>(source->read<int8_t>());
+    const auto& columnType = type->childAt(i);
+    switch (encoding) {
+      case ColumnEncoding::kFlat:
+        children[i] = readColumn(source, columnType, pool);
+        VELOX_CHECK_EQ(children[i]->size(), numRows);
+        break;
+      case ColumnEncoding::kConstant:
+        children[i] = BaseVector::wrapInConstant(
+            numRows, 0, readColumn(source, columnType, pool));
+        break;
+      case ColumnEncoding::kDictionary: {
+        const auto dictionaryId = source->read<int32_t>();
+        auto dictionary = dictionaries.find(streamId, dictionaryId);
+        VELOX_CHECK_NOT_NULL(
+            dictionary,
+            "Dictionary {} of stream {} is not registered",
+            dictionaryId,
+            streamId);
+        BufferPtr nulls;
+        if (source->read<bool>()) {
+          nulls = AlignedBuffer::allocate<bool>(numRows, pool);
+          source->readBytes(nulls->asMutable<char>(), bits::nbytes(numRows));
+        }
+        auto indices = AlignedBuffer::allocate<vector_size_t>(numRows, pool);
+        source->readBytes(
+            indices->asMutable<char>(), numRows * sizeof(vector_size_t));
+        children[i] = BaseVector::wrapInDictionary(
+            std::move(nulls), std::move(indices), numRows, dictionary);
+        break;
+      }
+      default:
+        VELOX_FAIL(
+            "Unknown stream dictionary column encoding: {}",
+            static_cast<int32_t>(encoding));
+    }
+  }
+  auto page = std::make_shared<RowVector>(
+      pool, type, nullptr, numRows, std::move(children));
+  if (resultOffset == 0) {
+    *result = std::move(page);
+    return;
+  }
+  auto merged =
+      BaseVector::create<RowVector>(type, resultOffset + numRows, pool);
+  merged->copy(result->get(), 0, 0, resultOffset);
+  merged->copy(page.get(), resultOffset, 0, numRows);
+  *result = std::move(merged);
+}
+
+// static
+void StreamDictionaryVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<StreamDictionaryVectorSerde>());
+}
+
+// static
+void StreamDictionaryVectorSerde::registerNamedVectorSerde() {
+  velox::registerNamedVectorSerde(
+      VectorSerde::Kind::kStreamDictionary,
+      std::make_unique<StreamDictionaryVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+#include <folly/io/IOBuf.h>
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Dictionaries received by the consumers of a stream dictionary exchange,
+/// keyed by the stream that shipped them. Thread safe. A stream is the
+/// sequence of pages serialized by one IterativeVectorSerializer, e.g. the
+/// pages of one PartitionedOutput destination.
+class StreamDictionaryCache {
+ public:
+  /// Registers the dictionaries defined at the start of the serialized
+  /// 'page'. The columns of the dictionaries are of 'type'. Dictionaries that
+  /// are already registered are skipped.
+  void addDictionaries(
+      const folly::IOBuf& page,
+      const RowTypePtr& type,
+      memory::MemoryPool* pool);
+
+  /// Same as above but reads the definitions from 'source' and leaves
+  /// 'source' positioned after them. Returns the id of the stream.
+  uint64_t addDictionaries(
+      ByteInputStream* source,
+      const RowTypePtr& type,
+      memory::MemoryPool* pool);
+
+  /// Returns the dictionary 'dictionaryId' of 'streamId' or nullptr if it is
+  /// not registered.
+  VectorPtr find(uint64_t streamId, int32_t dictionaryId) const;
+
+  /// Number of registered dictionaries.
+  size_t size() const;
+
+  void clear();
+
+ private:
+  struct Key {
+    uint64_t streamId;
+    int32_t dictionaryId;
+
+    bool operator==(const Key& other) const {
+      return streamId == other.streamId && dictionaryId == other.dictionaryId;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return folly::hash::hash_combine(key.streamId, key.dictionaryId);
+    }
+  };
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<Key, VectorPtr, KeyHasher> dictionaries_;
+};
+
+/// Shuffle serde that preserves the dictionary and constant encodings of the
+/// top level columns. A dictionary is shipped once per stream, in the first
+/// page that references it, and the later pages of the stream reference it by
+/// id. The consumer wraps the indices of each page around the dictionary it
+/// received without copy. Constant columns are shipped as one value. The
+/// other columns, and the dictionaries themselves, are in the Presto column
+/// format.
+///
+/// A producer reuses a dictionary when the next appended vector wraps the
+/// same base vector, e.g. the string dictionary of a file stripe or the build
+/// side columns of a hash join. A base is only shipped if it has no more rows
+/// than the page that references it, and each stream ships up to
+/// kMaxStreamDictionaryBytes of dictionaries. The other dictionary columns
+/// are flattened.
+///
+/// All the pages of a stream must reach the same consumer in order, so the
+/// serde does not work with arbitrary output buffers. Each consumer must
+/// register the dictionaries of a page in a StreamDictionaryCache before
+/// deserializing any later page of the stream: ExchangeClient does this when
+/// the consumer drivers dequeue the pages.
+///
+/// Page: streamId(8) | numDefinitions(4) | definitions | numRows(4) |
+///       numColumns(4) | columns
+/// Definition: dictionaryId(4) | column(4) | size(4) | Presto column
+/// Column: encoding(1) | payload
+///   flat and constant: size(4) | Presto column, of one row if constant
+///   dictionary: dictionaryId(4) | hasNulls(1) | [nulls] | indices
+class StreamDictionaryVectorSerde : public VectorSerde {
+ public:
+  static constexpr uint64_t kMaxStreamDictionaryBytes = 16 << 20;
+
+  struct StreamDictionaryOptions : VectorSerde::Options {
+    StreamDictionaryOptions()
+        : dictionaries(std::make_shared<StreamDictionaryCache>()) {}
+
+    /// The dictionaries of the streams being deserialized. Shared by the
+    /// consumers of an exchange.
+    std::shared_ptr<StreamDictionaryCache> dictionaries;
+  };
+
+  StreamDictionaryVectorSerde()
+      : VectorSerde(VectorSerde::Kind::kStreamDictionary) {}
+
+  /// Adds 4 bytes per row for the dictionary encoded columns and nothing for
+  /// the constant ones. The other columns are estimated as by the Presto
+  /// serde.
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  std::unique_ptr<IterativeVectorSerializer> createIterativeSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  bool supportsAppendInDeserialize() const override {
+    return true;
+  }
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override {
+    deserialize(source, pool, std::move(type), result, 0, options);
+  }
+
+  /// Sets 'result' to the page with its dictionary and constant columns if
+  /// 'resultOffset' is 0. Otherwise, copies the page into 'result' at
+  /// 'resultOffset'. 'options' must be StreamDictionaryOptions.
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      vector_size_t resultOffset,
+      const Options* options) override;
+
+  static void registerVectorSerde();
+  static void registerNamedVectorSerde();
+};
+
+} // namespace facebook::velox::serializer
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/StringReferenceSerializer.h"
+
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/LazyVector.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+enum class StringTag : char {
+  kInline = 0,
+  kReference = 1,
+};
+
+constexpr int32_t kReferenceSize = 1 + 2 * sizeof(int32_t);
+
+presto::PrestoVectorSerde& prestoSerde() {
+  static presto::PrestoVectorSerde serde;
+  return serde;
+}
+
+// Options for the Presto page of the tagged columns. Timestamps keep their
+// nanosecond precision.
+const presto::PrestoVectorSerde::PrestoOptions& prestoOptions() {
+  static const presto::PrestoVectorSerde::PrestoOptions options(
+      /*_useLosslessTimestamp=*/true,
+      common::CompressionKind::CompressionKind_NONE);
+  return options;
+}
+
+template <typename T>
+void writeOne(OutputStream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+bool isDeferred(const Type& type) {
+  return type.kind() == TypeKind::VARCHAR || type.kind() == TypeKind::VARBINARY;
+}
+
+// Replaces the tagged values of a string column with the strings they stand
+// for. The referenced strings point into the payload of the page.
+class StringReferenceLoader : public VectorLoader {
+ public:
+  StringReferenceLoader(VectorPtr tagged, BufferPtr payload)
+      : tagged_(std::move(tagged)), payload_(std::move(payload)) {}
+
+ private:
+  void loadInternal(
+      RowSet rows,
+      ValueHook* /*hook*/,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    DecodedVector decoded(*tagged_);
+    auto flat = BaseVector::create<FlatVector<StringView>>(
+        tagged_->type(), resultSize, tagged_->pool());
+    bool referencesPayload{false};
+    for (const auto row : rows) {
+      if (decoded.isNullAt(row)) {
+        flat->setNull(row, true);
+        continue;
+      }
+      const auto value = decoded.valueAt<StringView>(row);
+      VELOX_CHECK_GT(value.size(), 0);
+      const auto* data = value.data();
+      if (static_cast<StringTag>(data[0]) == StringTag::kInline) {
+        flat->set(row, StringView(data + 1, value.size() - 1));
+        continue;
+      }
+      VELOX_CHECK_EQ(value.size(), kReferenceSize);
+      VELOX_CHECK_NOT_NULL(payload_);
+      int32_t offset;
+      int32_t length;
+      ::memcpy(&offset, data + 1, sizeof(int32_t));
+      ::memcpy(&length, data + 1 + sizeof(int32_t), sizeof(int32_t));
+      VELOX_CHECK_LE(offset + length, payload_->size());
+      flat->setNoCopy(row, StringView(payload_->as<char>() + offset, length));
+      referencesPayload = true;
+    }
+    if (referencesPayload) {
+      flat->addStringBuffer(payload_);
+    }
+    *result = std::move(flat);
+  }
+
+  const VectorPtr tagged_;
+  const BufferPtr payload_;
+};
+
+class StringReferenceSerializer : public IterativeVectorSerializer {
+ public:
+  StringReferenceSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const StringReferenceVectorSerde::StringReferenceOptions& options)
+      : type_(std::move(type)),
+        pool_(streamArena->pool()),
+        minReferenceLength_(options.minReferenceLength),
+        presto_(prestoSerde().createIterativeSerializer(
+            type_,
+            numRows,
+            streamArena,
+            &prestoOptions())) {}
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& scratch) override {
+    std::vector<vector_size_t> rows;
+    for (const auto& range : ranges) {
+      for (auto i = 0; i < range.size; ++i) {
+        rows.push_back(range.begin + i);
+      }
+    }
+    appendRows(vector, rows, scratch);
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const vector_size_t*>& rows,
+      Scratch& scratch) override {
+    appendRows(vector, rows, scratch);
+  }
+
+  size_t maxSerializedSize() const override {
+    return sizeof(int32_t) + payloadSize_ + presto_->maxSerializedSize();
+  }
+
+  void flush(OutputStream* out) override {
+    writeOne<int32_t>(*out, payloadSize_);
+    if (payloadSize_ > 0) {
+      out->write(payload_->as<char>(), payloadSize_);
+    }
+    presto_->flush(out);
+    payloadSize_ = 0;
+  }
+
+  void clear() override {
+    presto_->clear();
+    payload_.reset();
+    payloadSize_ = 0;
+  }
+
+ private:
+  void appendRows(
+      const RowVectorPtr& vector,
+      folly::Range<const vector_size_t*> rows,
+      Scratch& scratch) {
+    const vector_size_t numRows = rows.size();
+    if (numRows == 0) {
+      return;
+    }
+    auto indices = allocateIndices(numRows, pool_);
+    ::memcpy(
+        indices->asMutable<vector_size_t>(),
+        rows.data(),
+        numRows * sizeof(vector_size_t));
+    std::vector<VectorPtr> children(type_->size());
+    for (auto i = 0; i < children.size(); ++i) {
+      auto child = BaseVector::loadedVectorShared(vector->childAt(i));
+      if (isDeferred(*type_->childAt(i))) {
+        children[i] = tagStrings(*child, rows);
+      } else {
+        children[i] =
+            BaseVector::wrapInDictionary(nullptr, indices, numRows, child);
+      }
+    }
+    auto tagged = std::make_shared<RowVector>(
+        pool_, type_, nullptr, numRows, std::move(children));
+    const IndexRange range{0, numRows};
+    presto_->append(tagged, folly::Range(&range, 1), scratch);
+  }
+
+  // Returns the 'rows' of 'column' with a tag before each value. Moves the
+  // long strings to 'payload_'.
+  VectorPtr tagStrings(
+      const BaseVector& column,
+      folly::Range<const vector_size_t*> rows) {
+    DecodedVector decoded(column);
+    auto tagged = BaseVector::create<FlatVector<StringView>>(
+        column.type(), rows.size(), pool_);
+    for (auto i = 0; i < rows.size(); ++i) {
+      if (decoded.isNullAt(rows[i])) {
+        tagged->setNull(i, true);
+        continue;
+      }
+      const auto value = decoded.valueAt<StringView>(rows[i]);
+      if (value.size() < minReferenceLength_) {
+        auto* data = tagged->getRawStringBufferWithSpace(value.size() + 1);
+        data[0] = static_cast<char>(StringTag::kInline);
+        ::memcpy(data + 1, value.data(), value.size());
+        tagged->setNoCopy(i, StringView(data, value.size() + 1));
+        continue;
+      }
+      const int32_t offset = payloadSize_;
+      const int32_t length = value.size();
+      appendToPayload(value);
+      auto* data = tagged->getRawStringBufferWithSpace(kReferenceSize);
+      data[0] = static_cast<char>(StringTag::kReference);
+      ::memcpy(data + 1, &offset, sizeof(int32_t));
+      ::memcpy(data + 1 + sizeof(int32_t), &length, sizeof(int32_t));
+      tagged->setNoCopy(i, StringView(data, kReferenceSize));
+    }
+    return tagged;
+  }
+
+  void appendToPayload(StringView value) {
+    const auto size = payloadSize_ + value.size();
+    if (payload_ == nullptr) {
+      payload_ = AlignedBuffer::allocate<char>(size, pool_);
+    } else if (payload_->capacity() < size) {
+      AlignedBuffer::reallocate<char>(&payload_, size * 2);
+    }
+    ::memcpy(
+        payload_->asMutable<char>() + payloadSize_, value.data(), value.size());
+    payloadSize_ = size;
+    payload_->setSize(size);
+  }
+
+  const RowTypePtr type_;
+  memory::MemoryPool* const pool_;
+  const int32_t minReferenceLength_;
+  // Serializes the tagged columns.
+  const std::unique_ptr<IterativeVectorSerializer> presto_;
+  // The long strings appended since the last flush. The first 'payloadSize_'
+  // bytes are used. Allocated from the pool of the serializer.
+  BufferPtr payload_;
+  int32_t payloadSize_{0};
+};
+} // namespace
+
+void StringReferenceVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t** sizes,
+    Scratch& scratch) {
+  const auto* rowVector = vector->loadedVector()->asChecked<RowVector>();
+  for (const auto& child : rowVector->children()) {
+    const auto* column = child->loadedVector();
+    if (!isDeferred(*column->type())) {
+      prestoSerde().estimateSerializedSize(column, rows, sizes, scratch);
+      continue;
+    }
+    DecodedVector decoded(*column);
+    for (auto i = 0; i < rows.size(); ++i) {
+      *sizes[i] += sizeof(int32_t);
+      if (decoded.isNullAt(rows[i])) {
+        continue;
+      }
+      const auto size = decoded.valueAt<StringView>(rows[i]).size();
+      *sizes[i] += size < kDefaultMinReferenceLength ? 1 + size
+                                                     : kReferenceSize + size;
+    }
+  }
+}
+
+std::unique_ptr<IterativeVectorSerializer>
+StringReferenceVectorSerde::createIterativeSerializer(
+    RowTypePtr type,
+    int32_t numRows,
+    StreamArena* streamArena,
+    const Options* options) {
+  const auto* referenceOptions =
+      dynamic_cast<const StringReferenceOptions*>(options);
+  static const StringReferenceOptions kDefaultOptions;
+  return std::make_unique<StringReferenceSerializer>(
+      std::move(type),
+      numRows,
+      streamArena,
+      referenceOptions == nullptr ? kDefaultOptions : *referenceOptions);
+}
+
+void StringReferenceVectorSerde::deserialize(
+    ByteInputStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    vector_size_t resultOffset,
+    const Options* /*options*/) {
+  BufferPtr payload;
+  const auto size = source->read<int32_t>();
+  if (size > 0) {
+    payload = AlignedBuffer::allocate<char>(size, pool);
+    source->readBytes(payload->asMutable<char>(), size);
+  }
+
+  RowVectorPtr page;
+  prestoSerde().deserialize(source, pool, type, &page, &prestoOptions());
+  const auto numRows = page->size();
+  for (auto i = 0; i < type->size(); ++i) {
+    if (!isDeferred(*type->childAt(i))) {
+      continue;
+    }
+    auto& child = page->childAt(i);
+    child = std::make_shared<LazyVector>(
+        pool,
+        type->childAt(i),
+        numRows,
+        std::make_unique<StringReferenceLoader>(child, payload));
+  }
+  if (resultOffset == 0) {
+    *result = std::move(page);
+    return;
+  }
+  for (auto& child : page->children()) {
+    child = BaseVector::loadedVectorShared(child);
+  }
+  auto merged =
+      BaseVector::create<RowVector>(type, resultOffset + numRows, pool);
+  merged->copy(result->get(), 0, 0, resultOffset);
+  merged->copy(page.get(), resultOffset, 0, numRows);
+  *result = std::move(merged);
+}
+
+// static
+void StringReferenceVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<StringReferenceVectorSerde>());
+}
+
+// static
+void StringReferenceVectorSerde::registerNamedVectorSerde() {
+  velox::registerNamedVectorSerde(
+      VectorSerde::Kind::kStringReference,
+      std::make_unique<StringReferenceVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Shuffle serde that defers the long strings of the top level VARCHAR and
+/// VARBINARY columns. The long strings of a page are moved to one payload at
+/// the start of the page and the string columns carry a reference to each of
+/// them. The consumer copies the payload once into a buffer of its pool and
+/// wraps these columns in LazyVectors whose long strings point into that
+/// buffer, so that the long strings are neither decoded nor copied one by one.
+/// The other columns are in the Presto format. The pages are self-contained
+/// and are as large as Presto pages, so the serde does not reduce the bytes
+/// sent over the network.
+///
+/// Page: size(4) | payload | Presto page
+/// The string columns of the Presto page have a tag byte before each value:
+///   0: the value follows
+///   1: offset(4) | length(4) of the value in the payload
+class StringReferenceVectorSerde : public VectorSerde {
+ public:
+  static constexpr int32_t kDefaultMinReferenceLength = 64;
+
+  struct StringReferenceOptions : VectorSerde::Options {
+    /// Strings of at least this many bytes are moved to the payload.
+    int32_t minReferenceLength{kDefaultMinReferenceLength};
+  };
+
+  StringReferenceVectorSerde()
+      : VectorSerde(VectorSerde::Kind::kStringReference) {}
+
+  /// Estimates the strings of at least kDefaultMinReferenceLength bytes as
+  /// references and the other columns as the Presto serde. The bytes of the
+  /// deferred strings are counted so that a page stays within the memory
+  /// limits of its consumer.
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  std::unique_ptr<IterativeVectorSerializer> createIterativeSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  bool supportsAppendInDeserialize() const override {
+    return true;
+  }
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override {
+    deserialize(source, pool, std::move(type), result, 0, options);
+  }
+
+  /// Sets 'result' to the page with lazy string columns if 'resultOffset' is
+  /// 0. Otherwise, loads the page and copies it into 'result' at
+  /// 'resultOffset'.
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      vector_size_t resultOffset,
+      const Options* options) override;
+
+  static void registerVectorSerde();
+  static void registerNamedVectorSerde();
+};
+
+} // namespace facebook::velox::serializer
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ColumnarSerializer.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+class ColumnarSerializerTest
+    : public ::testing::Test,
+      public velox::test::VectorTestBase,
+      public testing::WithParamInterface<common::CompressionKind> {
+ public:
+  static std::vector<common::CompressionKind> getTestParams() {
+    return {
+        common::CompressionKind::CompressionKind_NONE,
+        common::CompressionKind::CompressionKind_ZLIB,
+        common::CompressionKind::CompressionKind_SNAPPY,
+        common::CompressionKind::CompressionKind_ZSTD,
+        common::CompressionKind::CompressionKind_LZ4};
+  }
+
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  // Serializes 'vector' as one batch, appending its rows in ranges of
+  // increasing size.
+  std::string serialize(const RowVectorPtr& vector) {
+    std::vector<IndexRange> ranges;
+    vector_size_t offset = 0;
+    vector_size_t rangeSize = 1;
+    while (offset < vector->size()) {
+      const auto size = std::min(rangeSize, vector->size() - offset);
+      ranges.push_back(IndexRange{offset, size});
+      offset += size;
+      rangeSize *= 2;
+    }
+
+    auto arena = std::make_unique<StreamArena>(pool());
+    const ColumnarVectorSerde::ColumnarOptions options(GetParam());
+    auto serializer = serde_.createIterativeSerializer(
+        asRowType(vector->type()), vector->size(), arena.get(), &options);
+    serializer->append(vector, folly::Range(ranges.data(), ranges.size()));
+    const auto maxSize = serializer->maxSerializedSize();
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer->flush(&out);
+    EXPECT_LE(output.tellp(), maxSize);
+    return output.str();
+  }
+
+  RowVectorPtr deserialize(
+      const RowTypePtr& type,
+      const std::string& data) {
+    BufferInputStream source({ByteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(data.data())),
+        static_cast<int64_t>(data.size()),
+        0}});
+    const ColumnarVectorSerde::ColumnarOptions options(GetParam());
+    RowVectorPtr result;
+    serde_.deserialize(&source, pool(), type, &result, &options);
+    EXPECT_TRUE(source.atEnd());
+    return result;
+  }
+
+  void testRoundTrip(const RowVectorPtr& vector) {
+    const auto data = serialize(vector);
+    test::assertEqualVectors(
+        vector, deserialize(asRowType(vector->type()), data));
+  }
+
+  ColumnarVectorSerde serde_;
+};
+
+TEST_P(ColumnarSerializerTest, fuzz) {
+  const auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      VARBINARY(),
+      TIMESTAMP(),
+      DATE(),
+      DECIMAL(20, 2),
+      ROW({VARCHAR(), INTEGER()}),
+      ARRAY(INTEGER()),
+      MAP(VARCHAR(), ARRAY(INTEGER())),
+  });
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 1'000;
+  opts.nullRatio = 0.1;
+  opts.containerLength = 10;
+  const auto seed = folly::Random::rand32();
+  SCOPED_TRACE(fmt::format("seed: {}", seed));
+  VectorFuzzer fuzzer(opts, pool(), seed);
+  for (auto i = 0; i < 5; ++i) {
+    testRoundTrip(fuzzer.fuzzInputRow(rowType));
+  }
+}
+
+TEST_P(ColumnarSerializerTest, encodings) {
+  constexpr vector_size_t kSize = 10'000;
+  auto data = makeRowVector({
+      // Run length.
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row / 1'000; }),
+      // Bit packed.
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return 1'000'000 + (row * 7) % 13; }),
+      // Dictionary.
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row % 3) * 1'000'000'000'000LL; },
+          nullEvery(7)),
+      makeFlatVector<double>(kSize, [](auto row) { return (row % 4) * 0.5; }),
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto row) { return fmt::format("long string value {}", row % 5); },
+          nullEvery(11)),
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return std::string(row % 20, 'x'); }),
+      makeFlatVector<bool>(kSize, [](auto row) { return row % 3 == 0; }),
+  });
+  const auto serialized = serialize(data);
+  test::assertEqualVectors(
+      data, deserialize(asRowType(data->type()), serialized));
+  // The flat data takes more than 500KB.
+  ASSERT_LT(serialized.size(), 100'000);
+}
+
+TEST_P(ColumnarSerializerTest, empty) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(std::vector<int64_t>{}),
+       makeFlatVector<std::string>(std::vector<std::string>{})});
+  auto arena = std::make_unique<StreamArena>(pool());
+  const ColumnarVectorSerde::ColumnarOptions options(GetParam());
+  auto serializer = serde_.createIterativeSerializer(
+      asRowType(data->type()), 0, arena.get(), &options);
+  std::ostringstream output;
+  OStreamOutputStream out(&output);
+  serializer->flush(&out);
+  auto result = deserialize(asRowType(data->type()), output.str());
+  ASSERT_EQ(result->size(), 0);
+}
+
+VELOX_INSTANTIATE_TEST_SUITE_P(
+    ColumnarSerializerTest,
+    ColumnarSerializerTest,
+    testing::ValuesIn(ColumnarSerializerTest::getTestParams()),
+    [](const testing::TestParamInfo<common::CompressionKind>& info) {
+      return common::compressionKindToString(info.param);
+    });
+} // namespace
+} // namespace facebook::velox::serializer
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/KeyIndex.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer::test {
+namespace {
+
+class KeyIndexTest : public testing::Test, public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  void SetUp() override {
+    encoder_ = KeyEncoder::create(
+        {"c0"},
+        ROW({"c0", "c1"}, {BIGINT(), VARCHAR()}),
+        {core::kAscNullsFirst},
+        pool());
+  }
+
+  // Builds an index over 'numRows' rows with c0 = 2 * row, added in batches
+  // of 'batchSize'.
+  KeyIndex makeIndex(int32_t numRows, int32_t batchSize, int32_t rowsPerEntry) {
+    KeyIndex::Builder builder(encoder_.get(), rowsPerEntry);
+    for (auto start = 0; start < numRows; start += batchSize) {
+      const auto size = std::min(batchSize, numRows - start);
+      builder.add(makeRowVector({
+          makeFlatVector<int64_t>(
+              size, [&](auto row) { return 2 * (start + row); }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::to_string(row); }),
+      }));
+    }
+    return builder.build();
+  }
+
+  std::optional<IndexBound> bound(
+      std::optional<int64_t> value,
+      bool inclusive) {
+    if (!value.has_value()) {
+      return std::nullopt;
+    }
+    return IndexBound{
+        makeRowVector({"c0"}, {makeFlatVector<int64_t>({value.value()})}),
+        inclusive};
+  }
+
+  KeyIndex::RowRange lookup(
+      const KeyIndex& index,
+      std::optional<int64_t> lower,
+      std::optional<int64_t> upper,
+      bool inclusive = true) {
+    IndexBounds bounds;
+    bounds.indexColumns = {"c0"};
+    bounds.lowerBound = bound(lower, inclusive);
+    bounds.upperBound = bound(upper, inclusive);
+    return index.lookup(bounds, *encoder_);
+  }
+
+  std::unique_ptr<KeyEncoder> encoder_;
+};
+
+TEST_F(KeyIndexTest, build) {
+  // Entries straddle the batches.
+  const auto index = makeIndex(1'000, 300, 100);
+  ASSERT_EQ(index.numRows(), 1'000);
+  ASSERT_EQ(index.keys().size(), 10);
+  const auto expected = makeIndex(1'000, 1'000, 100);
+  ASSERT_EQ(index.keys(), expected.keys());
+
+  ASSERT_EQ(makeIndex(1'001, 7, 100).keys().size(), 11);
+}
+
+TEST_F(KeyIndexTest, lookup) {
+  const auto index = makeIndex(1'000, 300, 100);
+  using RowRange = KeyIndex::RowRange;
+
+  // Rows 250 to 260.
+  ASSERT_EQ(lookup(index, 500, 520), (RowRange{200, 300}));
+  // The first key of an entry may also end the previous entry.
+  ASSERT_EQ(lookup(index, 600, 600), (RowRange{200, 400}));
+  ASSERT_EQ(lookup(index, 600, 600, false), (RowRange{}));
+  ASSERT_EQ(lookup(index, 601, 799, false), (RowRange{300, 400}));
+
+  ASSERT_EQ(lookup(index, std::nullopt, 150), (RowRange{0, 100}));
+  ASSERT_EQ(lookup(index, 1'500, std::nullopt), (RowRange{700, 1'000}));
+  ASSERT_TRUE(lookup(index, std::nullopt, -1).empty());
+  ASSERT_TRUE(lookup(index, 700, 500).empty());
+  ASSERT_TRUE(
+      lookup(index, std::numeric_limits<int64_t>::max(), std::nullopt, false)
+          .empty());
+}
+
+TEST_F(KeyIndexTest, serialize) {
+  const auto index = makeIndex(1'234, 100, 64);
+  const auto copy = KeyIndex::deserialize(index.serialize());
+  ASSERT_EQ(copy.numRows(), index.numRows());
+  ASSERT_EQ(copy.rowsPerEntry(), index.rowsPerEntry());
+  ASSERT_EQ(copy.keys(), index.keys());
+
+  const auto data = index.serialize();
+  VELOX_ASSERT_THROW(
+      KeyIndex::deserialize(std::string_view(data).substr(0, data.size() - 1)),
+      "Truncated KeyIndex");
+}
+
+} // namespace
+} // namespace facebook::velox::serializer::test
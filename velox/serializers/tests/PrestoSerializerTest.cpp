@@ -25,6 +25,7 @@
 #include "velox/functions/prestosql/types/IPPrefixType.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/serializers/PrestoBatchVectorSerializer.h"
+#include "velox/serializers/PrestoSerializerDeserializationUtils.h"
 #include "velox/serializers/PrestoVectorLexer.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -998,6 +999,23 @@ TEST_P(PrestoSerializerTest, emptyMap) {
   testRoundTrip(mapVector);
 }
 
+TEST_P(PrestoSerializerTest, flatMap) {
+  // The wire format has no flat map layout. FlatMapVectors are written as maps.
+  auto flatMap = makeNullableFlatMapVector<int32_t, int64_t>({
+      {{{1, 10}, {2, std::nullopt}}},
+      std::nullopt,
+      {{{3, 30}}},
+      std::vector<std::pair<int32_t, std::optional<int64_t>>>{},
+      {{{1, 11}, {3, 31}}},
+  });
+  auto rowVector = makeRowVector({flatMap});
+  std::ostringstream out;
+  serialize(rowVector, &out, nullptr);
+  auto deserialized =
+      deserialize(asRowType(rowVector->type()), out.str(), nullptr);
+  assertEqualVectors(makeRowVector({flatMap->toMapVector()}), deserialized);
+}
+
 TEST_P(PrestoSerializerTest, timestampWithTimeZone) {
   auto timestamp = makeFlatVector<int64_t>(
       100,
@@ -1716,6 +1734,70 @@ TEST_P(PrestoSerializerTest, lexer) {
   }
 }
 
+TEST_P(PrestoSerializerTest, adaptiveCompression) {
+  // The codec of the pages does not depend on the compression kind.
+  if (GetParam() != common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.adaptiveCompression = true;
+  auto arena = std::make_unique<StreamArena>(pool_.get());
+  auto rowType = ROW({"s"}, {VARCHAR()});
+  auto serializer =
+      serde_->createIterativeSerializer(rowType, 1'000, arena.get(), &options);
+
+  auto serializePage = [&](const RowVectorPtr& vector) {
+    serializer->clear();
+    serializer->append(vector);
+    std::ostringstream output;
+    serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+    return output.str();
+  };
+
+  const auto repetitive = makeRowVector(
+      {"s"}, {makeFlatVector<std::string>(1'000, [](auto row) {
+        return std::string(50, 'a' + row % 3);
+      })});
+  folly::Random::DefaultGenerator rng(1);
+  const auto random = makeRowVector(
+      {"s"}, {makeFlatVector<std::string>(1'000, [&](auto /*row*/) {
+        std::string value(100, '\0');
+        for (auto& c : value) {
+          c = folly::Random::rand32(rng);
+        }
+        return value;
+      })});
+
+  const auto repetitivePage = serializePage(repetitive);
+  const auto randomPage = serializePage(random);
+  // The codec marker follows the number of rows.
+  const int8_t repetitiveMarker = repetitivePage[4];
+  const int8_t randomMarker = randomPage[4];
+  EXPECT_TRUE(
+      serializer::presto::detail::isCompressedBitSet(repetitiveMarker));
+  EXPECT_EQ(
+      serializer::presto::detail::pageCompressionKind(repetitiveMarker),
+      common::CompressionKind::CompressionKind_ZSTD);
+  EXPECT_FALSE(serializer::presto::detail::isCompressedBitSet(randomMarker));
+  EXPECT_FALSE(serializer::presto::detail::pageCompressionKind(randomMarker)
+                   .has_value());
+
+  // The pages are read with the default options. The lexer does not support
+  // compressed pages.
+  test::assertEqualVectors(
+      repetitive, deserialize(rowType, repetitivePage, nullptr, true));
+  test::assertEqualVectors(
+      random, deserialize(rowType, randomPage, nullptr, true));
+
+  const auto stats = serializer->runtimeStats();
+  EXPECT_GT(stats.at(IterativeVectorSerializer::kCompressionCpuNanos).value, 0);
+  EXPECT_EQ(
+      stats.at(IterativeVectorSerializer::kCompressionSkippedBytes).value,
+      randomPage.size() - serializer::presto::detail::kHeaderSize);
+}
+
 TEST_P(PrestoSerializerTest, checksum) {
   std::ostringstream output;
   // The payload (doesn't matter what as long as it's not 0).
@@ -16,6 +16,7 @@
 #include "velox/serializers/SerializedPageFile.h"
 #include <boost/random/uniform_int_distribution.hpp>
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <vector>
 #include "folly/experimental/EventCount.h"
@@ -385,6 +386,59 @@ TEST_P(SerializedPageFileTest, serializedPageRoundTripMultipleBatches) {
       fuzzer::mergeRowVectors(readVectors, pool()));
 }
 
+TEST_P(SerializedPageFileTest, roundTripWithWriteExecutor) {
+  const uint64_t kTargetFileSize = 1024;
+  const uint64_t kWriteBufferSize = 100;
+  const uint64_t kReadBufferSize = 256;
+  const uint32_t kNumWrites = 30;
+  const uint32_t kRowsPerBatch = 50;
+
+  folly::CPUThreadPoolExecutor executor(2);
+  SerializedPageFileWriter writer(
+      getTestFilePath(),
+      kTargetFileSize,
+      kWriteBufferSize,
+      "",
+      createSerdeOptions(),
+      serde_,
+      pool(),
+      &executor);
+
+  std::vector<RowVectorPtr> originalVectors;
+  IndexRange range{0, kRowsPerBatch};
+  folly::Range<IndexRange*> ranges(&range, 1);
+  for (int i = 0; i < kNumWrites; ++i) {
+    auto vector = createTestVector(kRowsPerBatch);
+    originalVectors.push_back(vector);
+    writer.write(vector, ranges);
+    if (i == kNumWrites / 2) {
+      writer.finishFile();
+    }
+  }
+
+  auto fileInfos = writer.finish();
+  ASSERT_GT(fileInfos.size(), 1);
+
+  std::vector<RowVectorPtr> readVectors;
+  for (const auto& fileInfo : fileInfos) {
+    EXPECT_GT(fileInfo.size, 0);
+    SerializedPageFileReader reader(
+        fileInfo.path,
+        kReadBufferSize,
+        asRowType(originalVectors[0]->type()),
+        serde_,
+        createSerdeOptions(),
+        pool());
+    RowVectorPtr readVector;
+    while (reader.nextBatch(readVector)) {
+      readVectors.push_back(readVector);
+    }
+  }
+  test::assertEqualVectors(
+      fuzzer::mergeRowVectors(originalVectors, pool()),
+      fuzzer::mergeRowVectors(readVectors, pool()));
+}
+
 TEST_P(SerializedPageFileTest, roundTripWithComplexTypes) {
   // Skip UnsafeRow for complex types as it has limitations with nested
   // structures
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/StreamDictionarySerializer.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+using Options = StreamDictionaryVectorSerde::StreamDictionaryOptions;
+
+class StreamDictionarySerializerTest : public ::testing::Test,
+                                       public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  void SetUp() override {
+    arena_ = std::make_unique<StreamArena>(pool());
+    serializer_ =
+        serde_.createIterativeSerializer(type_, 0, arena_.get(), nullptr);
+  }
+
+  // Serializes the rows of 'vectors' as one page.
+  std::string serialize(const std::vector<RowVectorPtr>& vectors) {
+    for (const auto& vector : vectors) {
+      const IndexRange range{0, vector->size()};
+      serializer_->append(vector, folly::Range(&range, 1));
+    }
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer_->flush(&out);
+    serializer_->clear();
+    return output.str();
+  }
+
+  RowVectorPtr deserialize(const std::string& data, const Options& options) {
+    BufferInputStream source({ByteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(data.data())),
+        static_cast<int64_t>(data.size()),
+        0}});
+    RowVectorPtr result;
+    serde_.deserialize(&source, pool(), type_, &result, &options);
+    EXPECT_TRUE(source.atEnd());
+    return result;
+  }
+
+  // Returns rows with a dictionary encoded column over 'base', a constant and
+  // a flat column.
+  RowVectorPtr makeRows(const VectorPtr& base, vector_size_t numRows) {
+    auto indices = makeIndices(numRows, [&](auto row) {
+      return (row * 7) % base->size();
+    });
+    auto nulls = makeNulls(numRows, [](auto row) { return row % 11 == 0; });
+    return makeRowVector(
+        {"d", "c", "f"},
+        {BaseVector::wrapInDictionary(nulls, indices, numRows, base),
+         makeConstant<int64_t>(42, numRows),
+         makeFlatVector<int32_t>(numRows, [](auto row) { return row; })});
+  }
+
+  const RowTypePtr type_{
+      ROW({"d", "c", "f"}, {VARCHAR(), BIGINT(), INTEGER()})};
+  StreamDictionaryVectorSerde serde_;
+  std::unique_ptr<StreamArena> arena_;
+  std::unique_ptr<IterativeVectorSerializer> serializer_;
+};
+
+TEST_F(StreamDictionarySerializerTest, dictionaryShippedOnce) {
+  auto base = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("long string value {}", row); });
+  const auto first = makeRows(base, 100);
+  const auto second = makeRows(base, 100);
+  const auto firstPage = serialize({first});
+  const auto secondPage = serialize({second});
+  // The second page has only the indices.
+  EXPECT_LT(secondPage.size(), firstPage.size());
+
+  const Options options;
+  const auto firstResult = deserialize(firstPage, options);
+  const auto secondResult = deserialize(secondPage, options);
+  test::assertEqualVectors(first, firstResult);
+  test::assertEqualVectors(second, secondResult);
+  EXPECT_EQ(options.dictionaries->size(), 1);
+
+  // Both pages wrap the same dictionary.
+  for (const auto& result : {firstResult, secondResult}) {
+    EXPECT_EQ(
+        result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+    EXPECT_TRUE(result->childAt(1)->isConstantEncoding());
+    EXPECT_EQ(result->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+  }
+  EXPECT_EQ(
+      firstResult->childAt(0)->valueVector(),
+      secondResult->childAt(0)->valueVector());
+
+  // A consumer that did not see the first page cannot read the second.
+  VELOX_ASSERT_THROW(
+      deserialize(secondPage, Options()), "is not registered");
+
+  // The dictionaries can be registered ahead of deserializing.
+  const Options prepared;
+  prepared.dictionaries->addDictionaries(
+      *folly::IOBuf::copyBuffer(firstPage), type_, pool());
+  EXPECT_EQ(prepared.dictionaries->size(), 1);
+  test::assertEqualVectors(second, deserialize(secondPage, prepared));
+}
+
+TEST_F(StreamDictionarySerializerTest, mixedEncodings) {
+  auto base = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("value {}", row); });
+  auto otherBase = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("other {}", row); });
+  const auto first = makeRows(base, 50);
+  auto second = makeRows(otherBase, 50);
+  // A different constant value.
+  second->childAt(1) = makeConstant<int64_t>(7, 50);
+  const auto page = serialize({first, second});
+
+  const Options options;
+  const auto result = deserialize(page, options);
+  auto expected = makeRowVector(
+      {"d", "c", "f"},
+      {makeFlatVector<std::string>(
+           100, [](auto /*row*/) { return std::string(); }),
+       makeFlatVector<int64_t>(100, [](auto /*row*/) { return 0; }),
+       makeFlatVector<int32_t>(100, [](auto /*row*/) { return 0; })});
+  expected->copy(first.get(), 0, 0, 50);
+  expected->copy(second.get(), 50, 0, 50);
+  test::assertEqualVectors(expected, result);
+  EXPECT_EQ(options.dictionaries->size(), 0);
+  for (const auto& child : result->children()) {
+    EXPECT_EQ(child->encoding(), VectorEncoding::Simple::FLAT);
+  }
+}
+
+TEST_F(StreamDictionarySerializerTest, largeDictionaryFlattened) {
+  // A base with more rows than the page is not shipped.
+  auto base = makeFlatVector<std::string>(
+      1'000, [](auto row) { return fmt::format("value {}", row); });
+  const auto rows = makeRows(base, 100);
+  const Options options;
+  const auto result = deserialize(serialize({rows}), options);
+  test::assertEqualVectors(rows, result);
+  EXPECT_EQ(options.dictionaries->size(), 0);
+  EXPECT_EQ(result->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+}
+
+TEST_F(StreamDictionarySerializerTest, appendInDeserialize) {
+  auto base = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("value {}", row); });
+  const auto first = makeRows(base, 20);
+  const auto second = makeRows(base, 30);
+  const auto firstPage = serialize({first});
+  const auto secondPage = serialize({second});
+
+  const Options options;
+  RowVectorPtr result;
+  for (const auto* page : {&firstPage, &secondPage}) {
+    BufferInputStream source({ByteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(page->data())),
+        static_cast<int64_t>(page->size()),
+        0}});
+    serde_.deserialize(
+        &source,
+        pool(),
+        type_,
+        &result,
+        result == nullptr ? 0 : result->size(),
+        &options);
+  }
+  ASSERT_EQ(result->size(), 50);
+  test::assertEqualVectors(first, result->slice(0, 20));
+  test::assertEqualVectors(second, result->slice(20, 30));
+}
+
+} // namespace
+} // namespace facebook::velox::serializer
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/StringReferenceSerializer.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+using Options = StringReferenceVectorSerde::StringReferenceOptions;
+
+class StringReferenceSerializerTest : public ::testing::Test,
+                                      public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  // Serializes the rows of 'vectors' as one page.
+  std::string serialize(
+      const std::vector<RowVectorPtr>& vectors,
+      const Options& options) {
+    StreamArena arena(pool());
+    auto serializer =
+        serde_.createIterativeSerializer(type_, 0, &arena, &options);
+    for (const auto& vector : vectors) {
+      const IndexRange range{0, vector->size()};
+      serializer->append(vector, folly::Range(&range, 1));
+    }
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer->flush(&out);
+    return output.str();
+  }
+
+  RowVectorPtr deserialize(
+      const std::string& data,
+      const Options& options,
+      RowVectorPtr result = nullptr) {
+    BufferInputStream source({ByteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(data.data())),
+        static_cast<int64_t>(data.size()),
+        0}});
+    serde_.deserialize(
+        &source,
+        pool(),
+        type_,
+        &result,
+        result == nullptr ? 0 : result->size(),
+        &options);
+    EXPECT_TRUE(source.atEnd());
+    return result;
+  }
+
+  // Returns rows with a string column of long and short values and nulls, and
+  // a bigint column.
+  RowVectorPtr makeRows(vector_size_t numRows, int32_t seed = 0) {
+    return makeRowVector(
+        {"s", "i"},
+        {makeFlatVector<std::string>(
+             numRows,
+             [&](auto row) {
+               return row % 3 == 0
+                   ? std::string(100 + row, 'a' + (row + seed) % 26)
+                   : fmt::format("short {}", row + seed);
+             },
+             [](auto row) { return row % 7 == 0; }),
+         makeFlatVector<int64_t>(
+             numRows, [&](auto row) { return row + seed; })});
+  }
+
+  const RowTypePtr type_{ROW({"s", "i"}, {VARCHAR(), BIGINT()})};
+  StringReferenceVectorSerde serde_;
+  Options options_;
+};
+
+TEST_F(StringReferenceSerializerTest, lazyStrings) {
+  const auto rows = makeRows(100);
+  const auto page = serialize({rows}, options_);
+  // The long strings are in the payload at the start of the page.
+  int32_t payloadSize;
+  ::memcpy(&payloadSize, page.data(), sizeof(int32_t));
+  EXPECT_GT(payloadSize, 34 * 100);
+
+  const auto result = deserialize(page, options_);
+  EXPECT_TRUE(isLazyNotLoaded(*result->childAt(0)));
+  EXPECT_FALSE(isLazyNotLoaded(*result->childAt(1)));
+
+  // Loads only a few rows.
+  SelectivityVector selected(result->size(), false);
+  selected.setValid(3, true);
+  selected.setValid(4, true);
+  selected.setValid(7, true);
+  selected.updateBounds();
+  LazyVector::ensureLoadedRows(result->childAt(0), selected);
+  auto* strings = result->childAt(0)->loadedVector();
+  auto* expected = rows->childAt(0).get();
+  for (const auto row : {3, 4, 7}) {
+    EXPECT_TRUE(strings->equalValueAt(expected, row, row)) << row;
+  }
+
+  // The page stays readable, e.g. by each consumer of a broadcast.
+  test::assertEqualVectors(rows, deserialize(page, options_));
+}
+
+TEST_F(StringReferenceSerializerTest, payloadOutlivesPage) {
+  const auto rows = makeRows(100);
+  auto page = serialize({rows}, options_);
+  const auto result = deserialize(page, options_);
+  // The long strings refer to the copy of the payload owned by the result.
+  page.assign(page.size(), '\0');
+  page.clear();
+  page.shrink_to_fit();
+  test::assertEqualVectors(rows, result);
+}
+
+TEST_F(StringReferenceSerializerTest, minReferenceLength) {
+  const auto rows = makeRows(100);
+  Options options = options_;
+  options.minReferenceLength = 1'000;
+  const auto page = serialize({rows}, options);
+  int32_t payloadSize;
+  ::memcpy(&payloadSize, page.data(), sizeof(int32_t));
+  EXPECT_EQ(payloadSize, 0);
+  test::assertEqualVectors(rows, deserialize(page, options));
+}
+
+TEST_F(StringReferenceSerializerTest, appendInDeserialize) {
+  const auto first = makeRows(20);
+  const auto second = makeRows(30, 5);
+  const auto firstPage = serialize({first}, options_);
+  const auto secondPage = serialize({second}, options_);
+  auto result = deserialize(firstPage, options_);
+  result = deserialize(secondPage, options_, result);
+  ASSERT_EQ(result->size(), 50);
+  test::assertEqualVectors(first, result->slice(0, 20));
+  test::assertEqualVectors(second, result->slice(20, 30));
+}
+
+TEST_F(StringReferenceSerializerTest, rows) {
+  const auto rows = makeRows(100);
+  StreamArena arena(pool());
+  auto serializer =
+      serde_.createIterativeSerializer(type_, 0, &arena, &options_);
+  const std::vector<vector_size_t> selected{0, 3, 5, 9, 99};
+  Scratch scratch;
+  serializer->append(
+      rows, folly::Range(selected.data(), selected.size()), scratch);
+  std::ostringstream output;
+  OStreamOutputStream out(&output);
+  serializer->flush(&out);
+
+  const auto result = deserialize(output.str(), options_);
+  ASSERT_EQ(result->size(), selected.size());
+  for (auto i = 0; i < selected.size(); ++i) {
+    EXPECT_TRUE(result->equalValueAt(rows.get(), i, selected[i])) << i;
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::serializer
@@ -41,7 +41,8 @@ core::PlanNodePtr HashJoinReplayer::createPlanNode(
               nodeTraceDir_,
               pipelineIds_.at(1), // Build side
               driverIds_,
-              exec::trace::getDataType(planFragment_, nodeId_, 1))
+              exec::trace::getDataType(planFragment_, nodeId_, 1),
+              tracedInputs(pipelineIds_.at(1)))
           .planNode(),
       hashJoinNode->outputType());
 }
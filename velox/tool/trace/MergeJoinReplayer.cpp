@@ -40,7 +40,8 @@ core::PlanNodePtr MergeJoinReplayer::createPlanNode(
               nodeTraceDir_,
               pipelineIds_.at(1), // Right side
               driverIds_,
-              exec::trace::getDataType(planFragment_, nodeId_, 1))
+              exec::trace::getDataType(planFragment_, nodeId_, 1),
+              tracedInputs(pipelineIds_.at(1)))
           .planNode(),
       mergeJoinNode->outputType());
 }
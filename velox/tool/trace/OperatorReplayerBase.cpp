@@ -14,11 +14,16 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
 #include <folly/json.h>
 
+#include <chrono>
 #include <utility>
 
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/core/PlanNode.h"
+#include "velox/exec/Operator.h"
+#include "velox/exec/OperatorTraceReader.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/TaskTraceReader.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -32,6 +37,39 @@
 using namespace facebook::velox;
 
 namespace facebook::velox::tool::trace {
+namespace {
+uint64_t customStatSum(
+    const exec::PlanNodeStats& stats,
+    const std::string& name) {
+  const auto it = stats.customStats.find(name);
+  return it == stats.customStats.end() ? 0 : it->second.sum;
+}
+
+// Logs the minimum and the median of 'metric' over 'runs'.
+template <typename Format>
+void logPerfMetric(
+    const std::vector<OperatorReplayerBase::PerfRun>& runs,
+    const std::string& name,
+    uint64_t OperatorReplayerBase::PerfRun::*metric,
+    Format format) {
+  std::vector<uint64_t> values;
+  values.reserve(runs.size());
+  for (const auto& run : runs) {
+    values.push_back(run.*metric);
+  }
+  std::sort(values.begin(), values.end());
+  LOG(INFO) << fmt::format(
+      "\t{}: min {}, median {}",
+      name,
+      format(values.front()),
+      format(values[values.size() / 2]));
+}
+
+std::string formatCount(uint64_t count) {
+  return std::to_string(count);
+}
+} // namespace
+
 OperatorReplayerBase::OperatorReplayerBase(
     const std::string& traceDir,
     const std::string& queryId,
@@ -101,6 +139,90 @@ RowVectorPtr OperatorReplayerBase::run(bool copyResults) {
   return result;
 }
 
+void OperatorReplayerBase::preloadInputs() {
+  const auto* replayNode =
+      core::PlanNode::findNodeById(planFragment_.get(), nodeId_);
+  if (replayNode->sources().empty() || !inputs_.empty()) {
+    return;
+  }
+  if (inputPool_ == nullptr) {
+    inputPool_ = memory::memoryManager()->addLeafPool(
+        fmt::format("{}_replayer_inputs", nodeName_));
+  }
+  for (auto i = 0; i < pipelineIds_.size(); ++i) {
+    const auto dataType = exec::trace::getDataType(planFragment_, nodeId_, i);
+    auto inputs = std::make_shared<core::TraceScanNode::Inputs>();
+    inputs->reserve(driverIds_.size());
+    for (const auto driverId : driverIds_) {
+      const exec::trace::OperatorTraceInputReader reader(
+          exec::trace::getOpTraceDirectory(
+              nodeTraceDir_, pipelineIds_[i], driverId),
+          dataType,
+          inputPool_.get());
+      auto& driverInputs = inputs->emplace_back();
+      RowVectorPtr batch;
+      while (reader.read(batch)) {
+        if (batch->size() > 0) {
+          driverInputs.push_back(std::move(batch));
+        }
+      }
+    }
+    inputs_.emplace(pipelineIds_[i], std::move(inputs));
+  }
+  LOG(INFO) << "Preloaded traced inputs: "
+            << succinctBytes(inputPool_->usedBytes());
+}
+
+std::vector<OperatorReplayerBase::PerfRun> OperatorReplayerBase::runPerf(
+    int32_t numIterations) {
+  VELOX_USER_CHECK_GT(numIterations, 0);
+  preloadInputs();
+  queryConfigs_[core::QueryConfig::kOperatorTrackPerfCounters] = "true";
+
+  std::vector<PerfRun> runs;
+  runs.reserve(numIterations);
+  perfRuns_ = &runs;
+  SCOPE_EXIT {
+    perfRuns_ = nullptr;
+  };
+  for (auto i = 0; i < numIterations; ++i) {
+    const auto startTime = std::chrono::steady_clock::now();
+    run(/*copyResults=*/false);
+    VELOX_CHECK_EQ(runs.size(), i + 1);
+    runs.back().wallNanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startTime)
+            .count();
+    const auto& run = runs.back();
+    LOG(INFO) << fmt::format(
+        "Iteration {}: Wall time: {}, Cpu time: {}, Peak memory: {}, "
+        "Instructions: {}, Cycles: {}, Cache misses: {}, Branch misses: {}",
+        i,
+        succinctNanos(run.wallNanos),
+        succinctNanos(run.cpuNanos),
+        succinctBytes(run.peakMemoryBytes),
+        run.instructions,
+        run.cycles,
+        run.cacheMisses,
+        run.branchMisses);
+  }
+
+  const auto nanos = [](uint64_t value) { return succinctNanos(value); };
+  const auto bytes = [](uint64_t value) { return succinctBytes(value); };
+  LOG(INFO) << fmt::format(
+      "Performance of replaying {} over {} iterations:",
+      nodeName_,
+      numIterations);
+  logPerfMetric(runs, "Wall time", &PerfRun::wallNanos, nanos);
+  logPerfMetric(runs, "Cpu time", &PerfRun::cpuNanos, nanos);
+  logPerfMetric(runs, "Peak memory", &PerfRun::peakMemoryBytes, bytes);
+  logPerfMetric(runs, "Instructions", &PerfRun::instructions, formatCount);
+  logPerfMetric(runs, "Cycles", &PerfRun::cycles, formatCount);
+  logPerfMetric(runs, "Cache misses", &PerfRun::cacheMisses, formatCount);
+  logPerfMetric(runs, "Branch misses", &PerfRun::branchMisses, formatCount);
+  return runs;
+}
+
 core::PlanNodePtr OperatorReplayerBase::createPlan() {
   const auto* replayNode =
       core::PlanNode::findNodeById(planFragment_.get(), nodeId_);
@@ -117,7 +239,8 @@ core::PlanNodePtr OperatorReplayerBase::createPlan() {
           nodeTraceDir_,
           pipelineIds_.front(),
           driverIds_,
-          exec::trace::getDataType(planFragment_, nodeId_))
+          exec::trace::getDataType(planFragment_, nodeId_),
+          tracedInputs(pipelineIds_.front()))
       .addNode(replayNodeFactory(replayNode))
       .capturePlanNodeId(replayPlanNodeId_)
       .planNode();
@@ -143,6 +266,12 @@ std::shared_ptr<core::QueryCtx> OperatorReplayerBase::createQueryCtx() {
       executor_);
 }
 
+std::shared_ptr<const core::TraceScanNode::Inputs>
+OperatorReplayerBase::tracedInputs(uint32_t pipelineId) const {
+  const auto it = inputs_.find(pipelineId);
+  return it == inputs_.end() ? nullptr : it->second;
+}
+
 std::function<core::PlanNodePtr(std::string, core::PlanNodePtr)>
 OperatorReplayerBase::replayNodeFactory(const core::PlanNode* node) const {
   return [=, this](
@@ -153,9 +282,22 @@ OperatorReplayerBase::replayNodeFactory(const core::PlanNode* node) const {
 }
 
 void OperatorReplayerBase::printStats(
-    const std::shared_ptr<exec::Task>& task) const {
+    const std::shared_ptr<exec::Task>& task) {
   const auto taskStats = exec::toPlanStats(task->taskStats());
   const auto& nodeStats = taskStats.at(replayPlanNodeId_);
+  if (perfRuns_ != nullptr) {
+    auto& run = perfRuns_->emplace_back();
+    run.cpuNanos = nodeStats.cpuWallTiming.cpuNanos;
+    run.peakMemoryBytes = task->pool()->peakBytes();
+    run.instructions =
+        customStatSum(nodeStats, exec::Operator::kPerfInstructions);
+    run.cycles = customStatSum(nodeStats, exec::Operator::kPerfCycles);
+    run.cacheMisses =
+        customStatSum(nodeStats, exec::Operator::kPerfCacheMisses);
+    run.branchMisses =
+        customStatSum(nodeStats, exec::Operator::kPerfBranchMisses);
+    return;
+  }
   LOG(INFO) << "Stats of replaying execution:";
   LOG(INFO) << nodeStats.toString(
       /*includeInputStats=*/true,
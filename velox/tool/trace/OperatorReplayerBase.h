@@ -48,6 +48,30 @@ class OperatorReplayerBase {
 
   virtual RowVectorPtr run(bool copyResults = true);
 
+  /// The measurements of the replayed operator in one iteration of
+  /// runPerf(). The hardware counters are zero if perf_event_open is not
+  /// available.
+  struct PerfRun {
+    uint64_t wallNanos{0};
+    uint64_t cpuNanos{0};
+    uint64_t peakMemoryBytes{0};
+    uint64_t instructions{0};
+    uint64_t cycles{0};
+    uint64_t cacheMisses{0};
+    uint64_t branchMisses{0};
+  };
+
+  /// Reads the traced inputs of the replayed operator into memory. The
+  /// following runs scan them from memory instead of the trace files. No-op
+  /// for a leaf operator, which has no traced inputs.
+  void preloadInputs();
+
+  /// Replays the operator 'numIterations' times over the preloaded traced
+  /// inputs and logs the cpu time, wall time, peak memory and hardware
+  /// counters of each iteration and their minimum and median. Excluding the
+  /// trace file reads makes the numbers comparable across operator changes.
+  std::vector<PerfRun> runPerf(int32_t numIterations);
+
  protected:
   virtual core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
@@ -58,6 +82,11 @@ class OperatorReplayerBase {
 
   std::shared_ptr<core::QueryCtx> createQueryCtx();
 
+  /// Returns the preloaded inputs of 'pipelineId' or nullptr if the inputs
+  /// are not preloaded.
+  std::shared_ptr<const core::TraceScanNode::Inputs> tracedInputs(
+      uint32_t pipelineId) const;
+
   const std::string queryId_;
   const std::string taskId_;
   const std::string nodeId_;
@@ -79,9 +108,20 @@ class OperatorReplayerBase {
   core::PlanNodePtr planFragment_;
   core::PlanNodeId replayPlanNodeId_;
 
-  void printStats(const std::shared_ptr<exec::Task>& task) const;
+  /// Logs the stats of the finished replay 'task'. Records them as a PerfRun
+  /// instead if called from runPerf().
+  void printStats(const std::shared_ptr<exec::Task>& task);
 
  private:
+  std::shared_ptr<memory::MemoryPool> inputPool_;
+  // Preloaded inputs keyed by pipeline id.
+  std::unordered_map<
+      uint32_t,
+      std::shared_ptr<const core::TraceScanNode::Inputs>>
+      inputs_;
+  // Set while runPerf() is running.
+  std::vector<PerfRun>* perfRuns_{nullptr};
+
   std::function<core::PlanNodePtr(std::string, core::PlanNodePtr)>
   replayNodeFactory(const core::PlanNode* node) const;
 };
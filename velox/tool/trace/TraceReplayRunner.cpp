@@ -105,6 +105,10 @@ DEFINE_uint64(
     0,
     "Specify the query memory capacity limit in GB. If it is zero, then there is no limit.");
 DEFINE_bool(copy_results, false, "Copy the replaying results.");
+DEFINE_int32(
+    perf_iterations,
+    0,
+    "If positive, replays the operator this many times over the traced inputs preloaded in memory and reports its cpu time, wall time, peak memory and hardware counters.");
 DEFINE_string(
     function_prefix,
     "",
@@ -471,6 +475,10 @@ void TraceReplayRunner::run() {
     return;
   }
   VELOX_USER_CHECK(!FLAGS_task_id.empty(), "--task_id must be provided");
+  if (FLAGS_perf_iterations > 0) {
+    createReplayer()->runPerf(FLAGS_perf_iterations);
+    return;
+  }
   createReplayer()->run(FLAGS_copy_results);
 }
 } // namespace facebook::velox::tool::trace
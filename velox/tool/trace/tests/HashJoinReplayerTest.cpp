@@ -323,6 +323,69 @@ TEST_F(HashJoinReplayerTest, partialDriverIds) {
   faultyFs->clearFileFaultInjections();
 }
 
+TEST_F(HashJoinReplayerTest, perfMode) {
+  const std::shared_ptr<TempDirectoryPath> testDir =
+      TempDirectoryPath::create(true);
+  const std::string tableDir =
+      fmt::format("{}/{}", testDir->getPath(), "table");
+  const auto traceRoot =
+      fmt::format("{}/{}/traceRoot/", testDir->getPath(), "perfMode");
+  std::shared_ptr<Task> task;
+  auto tracePlanWithSplits = createPlan(
+      tableDir,
+      core::JoinType::kInner,
+      probeKeys_,
+      buildKeys_,
+      probeInput_,
+      buildInput_);
+  AssertQueryBuilder traceBuilder(tracePlanWithSplits.plan);
+  traceBuilder.maxDrivers(4)
+      .config(core::QueryConfig::kQueryTraceEnabled, true)
+      .config(core::QueryConfig::kQueryTraceDir, traceRoot)
+      .config(core::QueryConfig::kQueryTraceMaxBytes, 100UL << 30)
+      .config(core::QueryConfig::kQueryTraceTaskRegExp, ".*")
+      .config(core::QueryConfig::kQueryTraceNodeId, traceNodeId_);
+  for (const auto& [planNodeId, nodeSplits] : tracePlanWithSplits.splits) {
+    traceBuilder.splits(planNodeId, nodeSplits);
+  }
+  const auto traceResult = traceBuilder.copyResults(pool(), task);
+
+  HashJoinReplayer replayer(
+      traceRoot,
+      task->queryCtx()->queryId(),
+      task->taskId(),
+      traceNodeId_,
+      "HashJoin",
+      /*spillBaseDir=*/"",
+      /*driverIds=*/"",
+      /*queryCapacity=*/0,
+      executor_.get());
+  replayer.preloadInputs();
+
+  // The replays after the preload must not read any traced data file.
+  const auto taskTraceDir = exec::trace::getTaskTraceDirectory(
+      traceRoot, task->queryCtx()->queryId(), task->taskId());
+  auto faultyFs = faultyFileSystem();
+  faultyFs->setFileInjectionHook([&](FaultFileOperation* op) {
+    if ((op->type == FaultFileOperation::Type::kRead ||
+         op->type == FaultFileOperation::Type::kReadv) &&
+        op->path.find(taskTraceDir) != std::string::npos) {
+      VELOX_FAIL("Read traced file {}", op->path);
+    }
+  });
+  assertEqualResults({traceResult}, {replayer.run()});
+
+  const auto runs = replayer.runPerf(3);
+  ASSERT_EQ(runs.size(), 3);
+  for (const auto& run : runs) {
+    ASSERT_GT(run.wallNanos, 0);
+    ASSERT_GT(run.cpuNanos, 0);
+    ASSERT_GT(run.peakMemoryBytes, 0);
+  }
+  VELOX_ASSERT_THROW(replayer.runPerf(0), "(0 vs. 0)");
+  faultyFs->clearFileFaultInjections();
+}
+
 TEST_F(HashJoinReplayerTest, runner) {
   const auto testDir = TempDirectoryPath::create();
   const auto traceRoot = fmt::format("{}/{}", testDir->getPath(), "traceRoot");
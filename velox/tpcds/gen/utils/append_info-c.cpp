@@ -16,10 +16,8 @@
 
 #include "velox/tpcds/gen/utils/append_info-c.h"
 
-#include <fmt/format.h>
 #include "velox/tpcds/gen/dsdgen/include/append_info.h"
 #include "velox/tpcds/gen/dsdgen/include/config.h"
-#include "velox/tpcds/gen/dsdgen/include/date.h"
 #include "velox/tpcds/gen/dsdgen/include/nulls.h"
 #include "velox/tpcds/gen/dsdgen/include/porting.h"
 #include "velox/vector/FlatVector.h"
@@ -106,21 +104,19 @@ void append_boolean(int32_t column, append_info info, int32_t value) {
   append_info->colIndex++;
 }
 
-// value is a Julian date
-// FIXME: direct int conversion, offsets should be constant
+// The Julian day number of 1970-01-01.
+constexpr int64_t kEpochJulianDay = 2'440'588;
+
+// value is a Julian day number, as converted by jtodt(). Dates are stored as
+// days since epoch, which is a constant offset from the Julian day number.
 void append_date(int32_t column, append_info info, int64_t value) {
   auto append_info = (tpcds::TpcdsTableDef*)info;
   if (append_info->IsNull(column) || value < 0) {
     append_info->children[append_info->colIndex]->setNull(
         append_info->rowIndex, true);
   } else {
-    date_t dTemp;
-    jtodt(&dTemp, (int)value);
-    auto stringDate =
-        fmt::format("{}-{}-{}", dTemp.year, dTemp.month, dTemp.day);
-    auto date = DATE()->toDays(stringDate);
     append_info->children[append_info->colIndex]->asFlatVector<int32_t>()->set(
-        append_info->rowIndex, date);
+        append_info->rowIndex, value - kEpochJulianDay);
   }
   append_info->colIndex++;
 }
@@ -53,7 +53,7 @@ static folly::Singleton<DBGenBackend> DBGenBackendSingleton;
 
 } // namespace
 
-DBGenIterator::DBGenIterator(double scaleFactor) {
+DBGenIterator::DBGenIterator(double scaleFactor, bool generateComments) {
   auto dbgenBackend = DBGenBackendSingleton.try_get();
   VELOX_CHECK_NOT_NULL(dbgenBackend, "Unable to initialize dbgen's dbgunk.");
   VELOX_CHECK_GE(scaleFactor, 0, "Tpch scale factor must be non-negative");
@@ -62,6 +62,7 @@ DBGenIterator::DBGenIterator(double scaleFactor) {
   } else {
     dbgenCtx_.scale_factor = static_cast<long>(scaleFactor);
   }
+  dbgenCtx_.skip_comments = !generateComments;
 }
 
 void DBGenIterator::initNation(size_t offset) {
@@ -31,7 +31,8 @@ namespace facebook::velox::tpch {
 /// synthetically generated data, backed by DBGEN.
 class DBGenIterator {
  public:
-  explicit DBGenIterator(double scaleFactor);
+  /// If 'generateComments' is false, the comment columns are left empty.
+  explicit DBGenIterator(double scaleFactor, bool generateComments = true);
 
   // Before generating records using the gen*() functions below, call the
   // appropriate init*() function to correctly initialize the seed given the
@@ -17,6 +17,7 @@
 #include "velox/tpch/gen/TpchGen.h"
 #include <velox/tpch/gen/dbgen/include/tpch_constants.hpp>
 #include "velox/tpch/gen/DBGenIterator.h"
+#include "velox/type/TimestampConversion.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::tpch {
@@ -81,8 +82,20 @@ double decimalToDouble(int64_t value) {
   return static_cast<double>(value) * 0.01;
 }
 
-int32_t toDate(std::string_view stringDate) {
-  return DATE()->toDays(stringDate);
+// Dbgen formats the dates as 'YYYY-MM-DD'. Parses them directly instead of
+// going through the generic date parser, which is costly for the 3 dates of
+// every lineitem.
+int32_t toDate(const char* date) {
+  const auto digits = [&](int32_t begin, int32_t end) {
+    int32_t value = 0;
+    for (auto i = begin; i < end; ++i) {
+      value = value * 10 + (date[i] - '0');
+    }
+    return value;
+  };
+  return util::daysSinceEpochFromDate(
+             digits(0, 4), digits(5, 7), digits(8, 10))
+      .value();
 }
 
 } // namespace
@@ -358,7 +371,8 @@ RowVectorPtr genTpchOrders(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    bool generateComments) {
   // Create schema and allocate vectors.
   auto ordersRowType = getTableSchema(Table::TBL_ORDERS);
   size_t vectorSize = getVectorSize(
@@ -375,7 +389,7 @@ RowVectorPtr genTpchOrders(
   auto shipPriorityVector = children[7]->asFlatVector<int32_t>();
   auto commentVector = children[8]->asFlatVector<StringView>();
 
-  DBGenIterator dbgenIt(scaleFactor);
+  DBGenIterator dbgenIt(scaleFactor, generateComments);
   dbgenIt.initOrder(offset);
   order_t order;
 
@@ -403,7 +417,8 @@ RowVectorPtr genTpchLineItem(
     memory::MemoryPool* pool,
     size_t maxOrderRows,
     size_t ordersOffset,
-    double scaleFactor) {
+    double scaleFactor,
+    bool generateComments) {
   // We control the buffer size based on the orders table, then allocate the
   // underlying buffer using the worst case (orderVectorSize * 7).
   size_t orderVectorSize = getVectorSize(
@@ -433,7 +448,7 @@ RowVectorPtr genTpchLineItem(
   auto shipModeVector = children[14]->asFlatVector<StringView>();
   auto commentVector = children[15]->asFlatVector<StringView>();
 
-  DBGenIterator dbgenIt(scaleFactor);
+  DBGenIterator dbgenIt(scaleFactor, generateComments);
   dbgenIt.initOrder(ordersOffset);
   order_t order;
 
@@ -493,7 +508,8 @@ RowVectorPtr genTpchPart(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    bool generateComments) {
   // Create schema and allocate vectors.
   auto partRowType = getTableSchema(Table::TBL_PART);
   size_t vectorSize =
@@ -510,7 +526,7 @@ RowVectorPtr genTpchPart(
   auto retailPriceVector = children[7]->asFlatVector<double>();
   auto commentVector = children[8]->asFlatVector<StringView>();
 
-  DBGenIterator dbgenIt(scaleFactor);
+  DBGenIterator dbgenIt(scaleFactor, generateComments);
   dbgenIt.initPart(offset);
   part_t part;
 
@@ -537,7 +553,8 @@ RowVectorPtr genTpchSupplier(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    bool generateComments) {
   // Create schema and allocate vectors.
   auto supplierRowType = getTableSchema(Table::TBL_SUPPLIER);
   size_t vectorSize = getVectorSize(
@@ -552,7 +569,7 @@ RowVectorPtr genTpchSupplier(
   auto acctbalVector = children[5]->asFlatVector<double>();
   auto commentVector = children[6]->asFlatVector<StringView>();
 
-  DBGenIterator dbgenIt(scaleFactor);
+  DBGenIterator dbgenIt(scaleFactor, generateComments);
   dbgenIt.initSupplier(offset);
   supplier_t supp;
 
@@ -581,7 +598,8 @@ RowVectorPtr genTpchPartSupp(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    bool generateComments) {
   // Create schema and allocate vectors.
   auto partSuppRowType = getTableSchema(Table::TBL_PARTSUPP);
   size_t vectorSize = getVectorSize(
@@ -594,7 +612,7 @@ RowVectorPtr genTpchPartSupp(
   auto supplyCostVector = children[3]->asFlatVector<double>();
   auto commentVector = children[4]->asFlatVector<StringView>();
 
-  DBGenIterator dbgenIt(scaleFactor);
+  DBGenIterator dbgenIt(scaleFactor, generateComments);
   part_t part;
 
   // The iteration logic is a bit more complicated as partsupp records are
@@ -641,7 +659,8 @@ RowVectorPtr genTpchCustomer(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    bool generateComments) {
   // Create schema and allocate vectors.
   auto customerRowType = getTableSchema(Table::TBL_CUSTOMER);
   size_t vectorSize = getVectorSize(
@@ -657,7 +676,7 @@ RowVectorPtr genTpchCustomer(
   auto mktSegmentVector = children[6]->asFlatVector<StringView>();
   auto commentVector = children[7]->asFlatVector<StringView>();
 
-  DBGenIterator dbgenIt(scaleFactor);
+  DBGenIterator dbgenIt(scaleFactor, generateComments);
   dbgenIt.initCustomer(offset);
   customer_t cust;
 
@@ -688,7 +707,8 @@ RowVectorPtr genTpchNation(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    bool generateComments) {
   // Create schema and allocate vectors.
   auto nationRowType = getTableSchema(Table::TBL_NATION);
   size_t vectorSize = getVectorSize(
@@ -700,7 +720,7 @@ RowVectorPtr genTpchNation(
   auto regionKeyVector = children[2]->asFlatVector<int64_t>();
   auto commentVector = children[3]->asFlatVector<StringView>();
 
-  DBGenIterator dbgenIt(scaleFactor);
+  DBGenIterator dbgenIt(scaleFactor, generateComments);
   dbgenIt.initNation(offset);
   code_t code;
 
@@ -722,7 +742,8 @@ RowVectorPtr genTpchRegion(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    bool generateComments) {
   // Create schema and allocate vectors.
   auto regionRowType = getTableSchema(Table::TBL_REGION);
   size_t vectorSize = getVectorSize(
@@ -733,7 +754,7 @@ RowVectorPtr genTpchRegion(
   auto nameVector = children[1]->asFlatVector<StringView>();
   auto commentVector = children[2]->asFlatVector<StringView>();
 
-  DBGenIterator dbgenIt(scaleFactor);
+  DBGenIterator dbgenIt(scaleFactor, generateComments);
   dbgenIt.initRegion(offset);
   code_t code;
 
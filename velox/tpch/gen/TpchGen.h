@@ -33,6 +33,12 @@ namespace facebook::velox::tpch {
 /// If not enough records are available given a particular scale factor and
 /// offset, less than maxRows records might be returned.
 ///
+/// If `generateComments` is false, the comment columns are returned as empty
+/// strings. Generating the comment text is the most expensive part of the
+/// generation, so callers which do not read these columns should skip it. The
+/// other columns are not affected since dbgen draws every column from its own
+/// random stream.
+///
 /// Data is always returned in a RowVector.
 
 enum class Table : uint8_t {
@@ -93,7 +99,8 @@ RowVectorPtr genTpchOrders(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    bool generateComments = true);
 
 /// NOTE: This function's parameters have different semantic from the function
 /// above. Dbgen does not provide deterministic random access to lineitem
@@ -131,7 +138,8 @@ RowVectorPtr genTpchLineItem(
     memory::MemoryPool* pool,
     size_t maxOrdersRows = 10000,
     size_t ordersOffset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    bool generateComments = true);
 
 /// Returns a row vector containing at most `maxRows` rows of the "part"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -151,7 +159,8 @@ RowVectorPtr genTpchPart(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    bool generateComments = true);
 
 /// Returns a row vector containing at most `maxRows` rows of the "supplier"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -169,7 +178,8 @@ RowVectorPtr genTpchSupplier(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    bool generateComments = true);
 
 /// Returns a row vector containing at most `maxRows` rows of the "partsupp"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -185,7 +195,8 @@ RowVectorPtr genTpchPartSupp(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    bool generateComments = true);
 
 /// Returns a row vector containing at most `maxRows` rows of the "customer"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -204,7 +215,8 @@ RowVectorPtr genTpchCustomer(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    bool generateComments = true);
 
 /// Returns a row vector containing at most `maxRows` rows of the "nation"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -219,7 +231,8 @@ RowVectorPtr genTpchNation(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    bool generateComments = true);
 
 /// Returns a row vector containing at most `maxRows` rows of the "region"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -233,7 +246,8 @@ RowVectorPtr genTpchRegion(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    bool generateComments = true);
 
 /// Gets the specified TPC-H query number as a string.
 std::string getQuery(int query);
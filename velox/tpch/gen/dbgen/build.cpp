@@ -66,6 +66,15 @@ namespace facebook::velox::tpch::dbgen {
       static_cast<int>(avg * V_STR_LOW), \
       static_cast<int>(avg * V_STR_HGH), \
       seed)
+/* Leaves the comment empty if the comments are skipped. */
+#define COMMENT(avg, seed, tgt, ctx) \
+  do {                               \
+    if ((ctx)->skip_comments) {      \
+      *(tgt) = '\0';                 \
+    } else {                         \
+      TEXT(avg, seed, tgt);          \
+    }                                \
+  } while (0)
 static void gen_phone PROTO((DSS_HUGE ind, char* target, seed_t* seed));
 
 DSS_HUGE
@@ -132,7 +141,7 @@ long mk_cust(DSS_HUGE n_cust, customer_t* c, DBGenContext* ctx) {
   gen_phone(i, c->phone, &ctx->Seed[C_PHNE_SD]);
   RANDOM(c->acctbal, C_ABAL_MIN, C_ABAL_MAX, &ctx->Seed[C_ABAL_SD]);
   pick_str(&c_mseg_set, &ctx->Seed[C_MSEG_SD], c->mktsegment);
-  TEXT(C_CMNT_LEN, &ctx->Seed[C_CMNT_SD], c->comment);
+  COMMENT(C_CMNT_LEN, &ctx->Seed[C_CMNT_SD], c->comment, ctx);
   c->clen = static_cast<int>(strlen(c->comment));
 
   return (0);
@@ -190,7 +199,7 @@ long mk_order(DSS_HUGE index, order_t* o, DBGenContext* ctx, long upd_num) {
       MAX((ctx->scale_factor * O_CLRK_SCL), O_CLRK_SCL),
       &ctx->Seed[O_CLRK_SD]);
   sprintf(o->clerk, orderSzFormat, O_CLRK_TAG, clk_num);
-  TEXT(O_CMNT_LEN, &ctx->Seed[O_CMNT_SD], o->comment);
+  COMMENT(O_CMNT_LEN, &ctx->Seed[O_CMNT_SD], o->comment, ctx);
   o->clen = static_cast<int>(strlen(o->comment));
 #ifdef DEBUG
   if (o->clen > O_CMNT_MAX)
@@ -212,7 +221,7 @@ long mk_order(DSS_HUGE index, order_t* o, DBGenContext* ctx, long upd_num) {
     RANDOM(o->l[lcnt].tax, L_TAX_MIN, L_TAX_MAX, &ctx->Seed[L_TAX_SD]);
     pick_str(&l_instruct_set, &ctx->Seed[L_SHIP_SD], o->l[lcnt].shipinstruct);
     pick_str(&l_smode_set, &ctx->Seed[L_SMODE_SD], o->l[lcnt].shipmode);
-    TEXT(L_CMNT_LEN, &ctx->Seed[L_CMNT_SD], o->l[lcnt].comment);
+    COMMENT(L_CMNT_LEN, &ctx->Seed[L_CMNT_SD], o->l[lcnt].comment, ctx);
     o->l[lcnt].clen = static_cast<int>(strlen(o->l[lcnt].comment));
     if (ctx->scale_factor >= 30000)
       RANDOM64(
@@ -282,7 +291,7 @@ long mk_part(DSS_HUGE index, part_t* p, DBGenContext* ctx) {
   RANDOM(p->size, P_SIZE_MIN, P_SIZE_MAX, &ctx->Seed[P_SIZE_SD]);
   pick_str(&p_cntr_set, &ctx->Seed[P_CNTR_SD], p->container);
   p->retailprice = rpb_routine(index);
-  TEXT(P_CMNT_LEN, &ctx->Seed[P_CMNT_SD], p->comment);
+  COMMENT(P_CMNT_LEN, &ctx->Seed[P_CMNT_SD], p->comment, ctx);
   p->clen = static_cast<int>(strlen(p->comment));
 
   for (snum = 0; snum < SUPP_PER_PART; snum++) {
@@ -290,7 +299,7 @@ long mk_part(DSS_HUGE index, part_t* p, DBGenContext* ctx) {
     PART_SUPP_BRIDGE(p->s[snum].suppkey, index, snum);
     RANDOM(p->s[snum].qty, PS_QTY_MIN, PS_QTY_MAX, &ctx->Seed[PS_QTY_SD]);
     RANDOM(p->s[snum].scost, PS_SCST_MIN, PS_SCST_MAX, &ctx->Seed[PS_SCST_SD]);
-    TEXT(PS_CMNT_LEN, &ctx->Seed[PS_CMNT_SD], p->s[snum].comment);
+    COMMENT(PS_CMNT_LEN, &ctx->Seed[PS_CMNT_SD], p->s[snum].comment, ctx);
     p->s[snum].clen = static_cast<int>(strlen(p->s[snum].comment));
   }
   return (0);
@@ -308,8 +317,11 @@ long mk_supp(DSS_HUGE index, supplier_t* s, DBGenContext* ctx) {
   gen_phone(i, s->phone, &ctx->Seed[S_PHNE_SD]);
   RANDOM(s->acctbal, S_ABAL_MIN, S_ABAL_MAX, &ctx->Seed[S_ABAL_SD]);
 
-  TEXT(S_CMNT_LEN, &ctx->Seed[S_CMNT_SD], s->comment);
+  COMMENT(S_CMNT_LEN, &ctx->Seed[S_CMNT_SD], s->comment, ctx);
   s->clen = static_cast<int>(strlen(s->comment));
+  if (ctx->skip_comments) {
+    return (0);
+  }
   /*
    * these calls should really move inside the if stmt below, but this
    * will simplify seedless parallel load
@@ -380,7 +392,7 @@ int mk_nation(DSS_HUGE index, code_t* c, DBGenContext* ctx) {
   c->code = index - 1;
   c->text = nations.list[index - 1].text;
   c->join = nations.list[index - 1].weight;
-  TEXT(N_CMNT_LEN, &ctx->Seed[N_CMNT_SD], c->comment);
+  COMMENT(N_CMNT_LEN, &ctx->Seed[N_CMNT_SD], c->comment, ctx);
   c->clen = static_cast<int>(strlen(c->comment));
   return (0);
 }
@@ -389,7 +401,7 @@ int mk_region(DSS_HUGE index, code_t* c, DBGenContext* ctx) {
   c->code = index - 1;
   c->text = regions.list[index - 1].text;
   c->join = 0; /* for completeness */
-  TEXT(R_CMNT_LEN, &ctx->Seed[R_CMNT_SD], c->comment);
+  COMMENT(R_CMNT_LEN, &ctx->Seed[R_CMNT_SD], c->comment, ctx);
   c->clen = static_cast<int>(strlen(c->comment));
   return (0);
 }
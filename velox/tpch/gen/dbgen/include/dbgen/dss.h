@@ -601,6 +601,9 @@ struct DBGenContext {
 
   long scale_factor = 1;
   long* permute = nullptr;
+  /* If true, the comments are left empty. row_stop_h() still advances their
+   * random streams, so the other columns are the same. */
+  bool skip_comments = false;
 };
 
 } // namespace facebook::velox::tpch::dbgen
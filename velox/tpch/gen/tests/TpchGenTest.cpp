@@ -25,6 +25,28 @@ namespace {
 using namespace facebook::velox;
 using namespace facebook::velox::tpch;
 
+// Verifies that 'actual', generated without the comments, has empty comments
+// and matches 'expected' on all the other columns.
+void assertNoComments(
+    const RowVectorPtr& expected,
+    const RowVectorPtr& actual) {
+  ASSERT_EQ(expected->size(), actual->size());
+  const auto& names = asRowType(expected->type())->names();
+  for (size_t column = 0; column < names.size(); ++column) {
+    const auto& expectedColumn = expected->childAt(column);
+    const auto& actualColumn = actual->childAt(column);
+    for (vector_size_t row = 0; row < expected->size(); ++row) {
+      if (names[column].ends_with("_comment")) {
+        ASSERT_TRUE(
+            actualColumn->asFlatVector<StringView>()->valueAt(row).empty());
+      } else {
+        ASSERT_TRUE(expectedColumn->equalValueAt(actualColumn.get(), row, row))
+            << names[column] << " at " << row;
+      }
+    }
+  }
+}
+
 // Nation tests.
 
 class TpchGenTestNationTest : public testing::Test {
@@ -309,6 +331,12 @@ TEST_F(TpchGenTestOrdersTest, reproducible) {
   }
 }
 
+TEST_F(TpchGenTestOrdersTest, noComments) {
+  assertNoComments(
+      genTpchOrders(pool_.get(), 1'000, 2'000),
+      genTpchOrders(pool_.get(), 1'000, 2'000, 1, false));
+}
+
 // Lineitem.
 class TpchGenTestLineItemTest : public testing::Test {
  protected:
@@ -427,6 +455,12 @@ TEST_F(TpchGenTestLineItemTest, reproducible) {
   }
 }
 
+TEST_F(TpchGenTestLineItemTest, noComments) {
+  assertNoComments(
+      genTpchLineItem(pool_.get(), 1'000, 2'000),
+      genTpchLineItem(pool_.get(), 1'000, 2'000, 1, false));
+}
+
 // Supplier.
 class TpchGenTestSupplierTest : public testing::Test {
  protected:
@@ -523,6 +557,12 @@ TEST_F(TpchGenTestSupplierTest, reproducible) {
   }
 }
 
+TEST_F(TpchGenTestSupplierTest, noComments) {
+  assertNoComments(
+      genTpchSupplier(pool_.get(), 1'000, 100),
+      genTpchSupplier(pool_.get(), 1'000, 100, 1, false));
+}
+
 // Part.
 class TpchGenTestPartTest : public testing::Test {
  protected:
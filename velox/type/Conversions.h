@@ -20,6 +20,8 @@
 #include <folly/Conv.h>
 #include <folly/Expected.h>
 #include <cctype>
+#include <cstring>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -151,6 +153,61 @@ Expected<T> callFollyTo(const F& v) {
   return result.value();
 }
 
+// Returns true if the 8 bytes of 'chunk' are ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return (chunk & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL &&
+      ((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) ==
+      0x3030303030303030ULL;
+}
+
+// Returns the value of the 8 ASCII digits in 'chunk', loaded little endian.
+// Combines pairs of digits, then pairs of pairs, with one multiply each.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  chunk -= 0x3030303030303030ULL;
+  chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+  chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+  return static_cast<uint32_t>(chunk * 10000 + (chunk >> 32));
+}
+
+// Parses 'v' if it is an optional '-' followed by 1 to 18 ASCII digits and
+// the value fits in T. Returns std::nullopt otherwise, leaving the other
+// inputs and the error reporting to folly.
+template <typename T>
+std::optional<T> tryParseSimpleInteger(std::string_view v) {
+  const bool negative = !v.empty() && v[0] == '-';
+  const char* digits = v.data() + negative;
+  const size_t numDigits = v.size() - negative;
+  if (numDigits == 0 || numDigits > 18) {
+    return std::nullopt;
+  }
+  uint64_t value = 0;
+  size_t i = 0;
+  for (; i + 8 <= numDigits; i += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, digits + i, sizeof(chunk));
+    if (!isEightDigits(chunk)) {
+      return std::nullopt;
+    }
+    value = value * 100'000'000 + parseEightDigits(chunk);
+  }
+  for (; i < numDigits; ++i) {
+    const uint8_t digit = digits[i] - '0';
+    if (digit > 9) {
+      return std::nullopt;
+    }
+    value = value * 10 + digit;
+  }
+  const int64_t result =
+      negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+  if constexpr (sizeof(T) < sizeof(int64_t)) {
+    if (result < std::numeric_limits<T>::min() ||
+        result > std::numeric_limits<T>::max()) {
+      return std::nullopt;
+    }
+  }
+  return static_cast<T>(result);
+}
+
 } // namespace detail
 
 /// To BOOLEAN converter.
@@ -340,6 +397,9 @@ struct Converter<
       return convertStringToInt(v);
     } else {
       auto trimmed = trimWhiteSpace(v.data(), v.size());
+      if (auto result = detail::tryParseSimpleInteger<T>(trimmed)) {
+        return result.value();
+      }
       return detail::callFollyTo<T>(trimmed);
     }
   }
@@ -349,6 +409,9 @@ struct Converter<
       return convertStringToInt(std::string_view(v));
     } else {
       auto trimmed = trimWhiteSpace(v.data(), v.size());
+      if (auto result = detail::tryParseSimpleInteger<T>(trimmed)) {
+        return result.value();
+      }
       return detail::callFollyTo<T>(trimmed);
     }
   }
@@ -358,6 +421,9 @@ struct Converter<
       return convertStringToInt(v);
     } else {
       auto trimmed = trimWhiteSpace(v.data(), v.length());
+      if (auto result = detail::tryParseSimpleInteger<T>(trimmed)) {
+        return result.value();
+      }
       return detail::callFollyTo<T>(trimmed);
     }
   }
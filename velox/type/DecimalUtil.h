@@ -464,6 +464,40 @@ class DecimalUtil {
     return sum;
   }
 
+  /// Sums a batch of decimals without a per-value overflow check. Adds the
+  /// signed upper and the unsigned lower 64 bits of the values into separate
+  /// 128-bit sums, which cannot overflow for fewer than 2^63 values, so that
+  /// the loop has no branches and the compiler can vectorize it. The exact
+  /// sum is converted to the sum and overflow of addWithOverflow once at the
+  /// end.
+  class BatchSum {
+   public:
+    template <typename T>
+    FOLLY_ALWAYS_INLINE void add(T value) {
+      static_assert(
+          std::is_same_v<T, int64_t> || std::is_same_v<T, int128_t>,
+          "BatchSum takes short or long decimals");
+      const auto wide = static_cast<int128_t>(value);
+      upper_ += static_cast<int64_t>(wide >> 64);
+      lower_ += static_cast<uint64_t>(wide);
+    }
+
+    /// Sets 'sum' and 'overflow' so that the exact sum is 'sum' + 'overflow' *
+    /// kOverflowMultiplier, like when adding all values with addWithOverflow.
+    /// 'sum' is in [0, 2^127).
+    void finish(int128_t& sum, int64_t& overflow) const {
+      // The exact sum is 'upper' * 2^64 + the lower 64 bits of 'lower_'.
+      const int128_t upper = upper_ + static_cast<int128_t>(lower_ >> 64);
+      const auto remainder = upper & ((int128_t(1) << 63) - 1);
+      overflow = static_cast<int64_t>(upper >> 63);
+      sum = (remainder << 64) | static_cast<uint64_t>(lower_);
+    }
+
+   private:
+    int128_t upper_{0};
+    __uint128_t lower_{0};
+  };
+
   /// avg = (sum + overflow * kOverflowMultiplier) / count
   static void
   computeAverage(int128_t& avg, int128_t sum, int64_t count, int64_t overflow);
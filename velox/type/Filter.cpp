@@ -22,6 +22,8 @@
 
 #include "velox/type/Filter.h"
 
+#include "velox/common/base/BitUtil.h"
+
 namespace facebook::velox::common {
 
 namespace {
@@ -53,6 +55,8 @@ const auto& filterKindNames() {
       {FilterKind::kHugeintValuesUsingHashTable, "HugeintValuesUsingHashTable"},
       {FilterKind::kBigintValuesUsingBloomFilter,
        "BigintValuesUsingBloomFilter"},
+      {FilterKind::kBytesValuesUsingBloomFilter,
+       "BytesValuesUsingBloomFilter"},
   };
   return kNames;
 }
@@ -115,6 +119,8 @@ void Filter::registerSerDe() {
       "BigintValuesUsingBitmask", BigintValuesUsingBitmask::create);
   registry.Register(
       "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
+  registry.Register(
+      "BytesValuesUsingBloomFilter", BytesValuesUsingBloomFilter::create);
   registry.Register(
       "NegatedBigintValuesUsingHashTable",
       NegatedBigintValuesUsingHashTable::create);
@@ -383,26 +389,28 @@ bool BigintValuesUsingBitmask::testingEquals(const Filter& other) const {
   return false;
 }
 
-folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
-  auto obj = Filter::serializeBase();
+namespace {
+void serializeBloomFilterBlocks(
+    const std::vector<SplitBlockBloomFilter::Block>& blocks,
+    folly::dynamic& obj) {
   folly::dynamic words = folly::dynamic::array;
-  for (auto& block : blocks_) {
+  for (auto& block : blocks) {
     for (auto word : block.data) {
       words.push_back(word);
     }
   }
   obj["numHashes"] = xsimd::batch<uint32_t>::size;
   obj["blockWords"] = words;
-  return obj;
 }
 
-std::unique_ptr<Filter> BigintValuesUsingBloomFilter::create(
-    const folly::dynamic& obj) {
+std::vector<SplitBlockBloomFilter::Block> deserializeBloomFilterBlocks(
+    const folly::dynamic& obj,
+    std::string_view filterName) {
   VELOX_USER_CHECK_EQ(
       obj["numHashes"].asInt(),
       xsimd::batch<uint32_t>::size,
-      "Cannot deserialize BigintValuesUsingBloomFilter serialized on hardware with different SIMD length");
-  auto nullAllowed = deserializeNullAllowed(obj);
+      "Cannot deserialize {} serialized on hardware with different SIMD length",
+      filterName);
   std::vector<SplitBlockBloomFilter::Block> blocks;
   int i = 0;
   SplitBlockBloomFilter::Block current{};
@@ -413,6 +421,31 @@ std::unique_ptr<Filter> BigintValuesUsingBloomFilter::create(
       i = 0;
     }
   }
+  return blocks;
+}
+
+bool bloomFilterBlocksEqual(
+    const std::vector<SplitBlockBloomFilter::Block>& left,
+    const std::vector<SplitBlockBloomFilter::Block>& right) {
+  return left.size() == right.size() &&
+      memcmp(
+          left.data(),
+          right.data(),
+          left.size() * sizeof(SplitBlockBloomFilter::Block)) == 0;
+}
+} // namespace
+
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase();
+  serializeBloomFilterBlocks(blocks_, obj);
+  return obj;
+}
+
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::create(
+    const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto blocks =
+      deserializeBloomFilterBlocks(obj, "BigintValuesUsingBloomFilter");
   return std::unique_ptr<BigintValuesUsingBloomFilter>(
       new BigintValuesUsingBloomFilter(nullAllowed, std::move(blocks)));
 }
@@ -423,11 +456,31 @@ bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
   if (!typedOther) {
     return false;
   }
-  return blocks_.size() == typedOther->blocks_.size() &&
-      memcmp(
-          blocks_.data(),
-          typedOther->blocks_.data(),
-          blocks_.size() * sizeof(SplitBlockBloomFilter::Block)) == 0;
+  return bloomFilterBlocksEqual(blocks_, typedOther->blocks_);
+}
+
+folly::dynamic BytesValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase();
+  serializeBloomFilterBlocks(blocks_, obj);
+  return obj;
+}
+
+std::unique_ptr<Filter> BytesValuesUsingBloomFilter::create(
+    const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto blocks =
+      deserializeBloomFilterBlocks(obj, "BytesValuesUsingBloomFilter");
+  return std::unique_ptr<BytesValuesUsingBloomFilter>(
+      new BytesValuesUsingBloomFilter(nullAllowed, std::move(blocks)));
+}
+
+bool BytesValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto* typedOther =
+      Filter::testingBaseEquals<BytesValuesUsingBloomFilter>(other);
+  if (!typedOther) {
+    return false;
+  }
+  return bloomFilterBlocksEqual(blocks_, typedOther->blocks_);
 }
 
 folly::dynamic NegatedBigintValuesUsingHashTable::serialize() const {
@@ -606,6 +659,23 @@ std::unique_ptr<Filter> BytesValues::create(const folly::dynamic& obj) {
   return std::make_unique<BytesValues>(values, nullAllowed);
 }
 
+void BytesValues::initializeProbeBits() {
+  for (auto length : lengths_) {
+    if (length < kMaxShortLength) {
+      shortLengths_[length / 64] |= 1ULL << (length % 64);
+    }
+  }
+  // About 8 bits per value keeps false positives near 10%.
+  const auto numBits = std::clamp<uint64_t>(
+      bits::nextPowerOfTwo(values_.size() * 8), 64, kMaxPrefixBits);
+  prefixShift_ = 64 - __builtin_ctzll(numBits);
+  prefixBits_.resize(numBits / 64);
+  for (const auto& value : values_) {
+    const auto bit = prefixBit(value.data(), value.size());
+    prefixBits_[bit / 64] |= 1ULL << (bit % 64);
+  }
+}
+
 bool BytesValues::testingEquals(const Filter& other) const {
   if (const auto* otherBytesValues =
           Filter::testingBaseEquals<BytesValues>(other)) {
@@ -1486,6 +1556,7 @@ std::unique_ptr<Filter> MultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
     case FilterKind::kNegatedBytesRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(/*nullAllowed=*/false);
@@ -2371,6 +2442,41 @@ std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
   }
 }
 
+std::unique_ptr<Filter> BytesValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return clone(false);
+    case FilterKind::kBytesValues: {
+      std::vector<std::string> values;
+      for (const auto& value : other->as<BytesValues>()->values()) {
+        if (testBytes(value.data(), value.size())) {
+          values.push_back(value);
+        }
+      }
+      const bool bothNullAllowed = nullAllowed_ && other->testNull();
+      if (values.empty()) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BytesValues>(values, bothNullAllowed);
+    }
+    case FilterKind::kBytesRange:
+    case FilterKind::kNegatedBytesRange:
+    case FilterKind::kNegatedBytesValues:
+    case FilterKind::kMultiRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
+      // Bloom filter allows false positive so dropping it will not affect
+      // correctness.
+      return other->clone();
+    default:
+      VELOX_FAIL("Cannot merge {} with {}", kindName(), other->kindName());
+  }
+}
+
 namespace {
 // compareResult = left < right for upper, right < left for lower
 bool mergeExclusive(int compareResult, bool left, bool right) {
@@ -2391,6 +2497,7 @@ std::unique_ptr<Filter> BytesRange::mergeWith(const Filter* other) const {
     case FilterKind::kNegatedBytesValues:
     case FilterKind::kNegatedBytesRange:
     case FilterKind::kMultiRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kBytesRange: {
       bool bothNullAllowed = nullAllowed_ && other->testNull();
@@ -2467,6 +2574,7 @@ std::unique_ptr<Filter> NegatedBytesRange::mergeWith(
     case FilterKind::kIsNotNull:
       return this->clone(false);
     case FilterKind::kBytesValues:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kNegatedBytesValues:
     case FilterKind::kBytesRange:
@@ -2486,6 +2594,7 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
     case FilterKind::kMultiRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2600,6 +2709,7 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
     case FilterKind::kBytesValues:
     case FilterKind::kNegatedBytesRange:
     case FilterKind::kMultiRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <array>
+
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
 #include <xsimd/xsimd.hpp>
@@ -53,6 +55,7 @@ enum class FilterKind {
   kTimestampRange,
   kHugeintValuesUsingHashTable,
   kBigintValuesUsingBloomFilter,
+  kBytesValuesUsingBloomFilter,
 };
 
 VELOX_DECLARE_ENUM_NAME(FilterKind);
@@ -1369,6 +1372,76 @@ class BigintValuesUsingBloomFilter final : public Filter {
   SplitBlockBloomFilter filter_;
 };
 
+/// Approximate IN-list filter for string data types. Passes all values that
+/// were inserted and, with a probability of about 1%, some that were not. Used
+/// for pushing down the keys of a join build side that has too many distinct
+/// values for BytesValues.
+class BytesValuesUsingBloomFilter final : public Filter {
+ public:
+  BytesValuesUsingBloomFilter(int64_t capacity, bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBytesValuesUsingBloomFilter),
+        blocks_(BigintValuesUsingBloomFilter::numBlocks(capacity)),
+        filter_(blocks_) {}
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return filter_.mayContain(hash(std::string_view(value, length)));
+  }
+
+  bool testLength(int32_t /*length*/) const final {
+    return true;
+  }
+
+  bool testBytesRange(
+      std::optional<std::string_view> /*min*/,
+      std::optional<std::string_view> /*max*/,
+      bool /*hasNull*/) const final {
+    return true;
+  }
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed) const override {
+    return std::unique_ptr<BytesValuesUsingBloomFilter>(
+        new BytesValuesUsingBloomFilter(
+            nullAllowed.value_or(nullAllowed_), blocks_));
+  }
+
+  folly::dynamic serialize() const override;
+
+  static std::unique_ptr<Filter> create(const folly::dynamic& obj);
+
+  bool testingEquals(const Filter& other) const override;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const override;
+
+  void insert(std::string_view value) {
+    filter_.insert(hash(value));
+  }
+
+  uint64_t blockIndex(std::string_view value) const {
+    return filter_.blockIndex(hash(value));
+  }
+
+  int64_t blocksByteSize() const {
+    return blocks_.size() * sizeof(SplitBlockBloomFilter::Block);
+  }
+
+ private:
+  static uint64_t hash(std::string_view value) {
+    return folly::hasher<std::string_view>()(value);
+  }
+
+  // Private constructor used by clone() and create().
+  BytesValuesUsingBloomFilter(
+      bool nullAllowed,
+      std::vector<SplitBlockBloomFilter::Block> blocks)
+      : Filter(true, nullAllowed, FilterKind::kBytesValuesUsingBloomFilter),
+        blocks_(std::move(blocks)),
+        filter_(blocks_) {}
+
+  std::vector<SplitBlockBloomFilter::Block> blocks_;
+  SplitBlockBloomFilter filter_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -2258,6 +2331,7 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+    initializeProbeBits();
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -2265,7 +2339,10 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        shortLengths_(other.shortLengths_),
+        prefixBits_(other.prefixBits_),
+        prefixShift_(other.prefixShift_) {}
 
   folly::dynamic serialize() const override;
 
@@ -2281,12 +2358,21 @@ class BytesValues final : public Filter {
   }
 
   bool testLength(int32_t length) const final {
+    if (length < kMaxShortLength) {
+      return shortLengths_[length / 64] & (1ULL << (length % 64));
+    }
     return lengths_.contains(length);
   }
 
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    if (!testLength(length)) {
+      return false;
+    }
+    const auto bit = prefixBit(value, length);
+    if (!(prefixBits_[bit / 64] & (1ULL << (bit % 64)))) {
+      return false;
+    }
+    return values_.contains(std::string_view(value, length));
   }
 
   bool testBytesRange(
@@ -2303,10 +2389,37 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Lengths below this are looked up in 'shortLengths_'.
+  static constexpr int32_t kMaxShortLength = 256;
+
+  // Upper bound on the number of bits in 'prefixBits_'.
+  static constexpr int32_t kMaxPrefixBits = 1 << 16;
+
+  // Returns the bit of 'prefixBits_' for the length and the first 8 bytes of
+  // 'value'. This is much cheaper than hashing the whole value.
+  uint64_t prefixBit(const char* value, int32_t length) const {
+    uint64_t prefix = 0;
+    if (length > 0) {
+      memcpy(&prefix, value, std::min<int32_t>(length, sizeof(prefix)));
+    }
+    return ((prefix ^ length) * 0x9E3779B97F4A7C15ULL) >> prefixShift_;
+  }
+
+  // Sets up 'shortLengths_' and 'prefixBits_' from 'values_'.
+  void initializeProbeBits();
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+
+  // Bit per length below kMaxShortLength that occurs in 'values_'.
+  std::array<uint64_t, kMaxShortLength / 64> shortLengths_{};
+
+  // Bit per prefixBit() of the values in 'values_'. Most probes that do not
+  // match are rejected by this before hashing the whole probe.
+  std::vector<uint64_t> prefixBits_;
+  int32_t prefixShift_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -134,4 +134,43 @@ int32_t StringView::linearSearch(
   return linearSearchSimple(key, strings, indices, numStrings);
 #endif
 }
+
+// static
+void StringView::equalsBatch(
+    const StringView* left,
+    const StringView* right,
+    int32_t numStrings,
+    uint64_t* result) {
+  int32_t i = 0;
+#if XSIMD_WITH_AVX2
+  constexpr int32_t kBatch = xsimd::batch<uint64_t>::size;
+  // Each batch holds 2 StringViews. Even lanes are size and prefix, odd lanes
+  // are the inlined bytes or the data pointer.
+  constexpr int32_t kPerBatch = kBatch / 2;
+  for (; i + kPerBatch <= numStrings; i += kPerBatch) {
+    const auto mask = simd::toBitMask(
+        xsimd::load_unaligned(reinterpret_cast<const uint64_t*>(left + i)) ==
+        xsimd::load_unaligned(reinterpret_cast<const uint64_t*>(right + i)));
+    for (auto j = 0; j < kPerBatch; ++j) {
+      const auto lanes = (mask >> (2 * j)) & 3;
+      bool equal = false;
+      if (lanes & 1) {
+        // Same size and prefix. Both words equal decides all strings that are
+        // inline or share the data pointer.
+        const auto size = left[i + j].size();
+        equal = lanes == 3 || size <= kPrefixSize ||
+            (size > kInlineSize &&
+             memcmp(
+                 left[i + j].data() + kPrefixSize,
+                 right[i + j].data() + kPrefixSize,
+                 size - kPrefixSize) == 0);
+      }
+      bits::setBit(result, i + j, equal);
+    }
+  }
+#endif
+  for (; i < numStrings; ++i) {
+    bits::setBit(result, i, left[i] == right[i]);
+  }
+}
 } // namespace facebook::velox
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -213,6 +214,23 @@ struct StringView {
     return (result != 0) ? result : size_ - other.size_;
   }
 
+  /// Returns the result of compare() if it can be decided from the size,
+  /// prefix and inlined bytes alone, std::nullopt if the out of line data of
+  /// both strings must be compared. Lets callers that hold out of line data in
+  /// non-contiguous memory skip materializing it in most cases.
+  std::optional<int32_t> comparePrefix(const StringView& other) const {
+    if (prefixAsInt() != other.prefixAsInt()) {
+      return memcmp(prefix_, other.prefix_, kPrefixSize);
+    }
+    if (std::min(size_, other.size_) <= kPrefixSize) {
+      return static_cast<int32_t>(size_ - other.size_);
+    }
+    if (isInline() && other.isInline()) {
+      return compare(other);
+    }
+    return std::nullopt;
+  }
+
   auto operator<=>(const StringView& other) const {
     const auto cmp = compare(other);
     return cmp < 0 ? std::strong_ordering::less
@@ -315,6 +333,16 @@ struct StringView {
       const int32_t* indices,
       int32_t numStrings);
 
+  /// Sets bit 'i' of 'result' if 'left[i] == right[i]' and clears it otherwise
+  /// for i >= 0 < numStrings. Compares sizes, prefixes and inlined bytes of
+  /// several pairs at a time with SIMD and reads out of line data only for
+  /// pairs that agree on size and prefix.
+  static void equalsBatch(
+      const StringView* left,
+      const StringView* right,
+      int32_t numStrings,
+      uint64_t* result);
+
  private:
   int64_t sizeAndPrefixAsInt64() const {
     return reinterpret_cast<const int64_t*>(this)[0];
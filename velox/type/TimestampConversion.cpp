@@ -702,6 +702,86 @@ bool tryParseTimestampString(
   return true;
 }
 
+// Returns the value of the 'numDigits' digits at 'buf' or -1 if one is not a
+// digit.
+inline int32_t parseFixedDigits(const char* buf, int32_t numDigits) {
+  int32_t result = 0;
+  for (auto i = 0; i < numDigits; ++i) {
+    if (!characterIsDigit(buf[i])) {
+      return -1;
+    }
+    result = result * 10 + (buf[i] - '0');
+  }
+  return result;
+}
+
+// Fast path for the common YYYY-MM-DD dates, which are parsed the same in
+// all modes. Returns false for the other strings, which go through
+// tryParseDateString().
+bool tryParseIsoDate(const char* buf, size_t len, int64_t& daysSinceEpoch) {
+  if (len != 10 || buf[4] != '-' || buf[7] != '-') {
+    return false;
+  }
+  const auto year = parseFixedDigits(buf, 4);
+  const auto month = parseFixedDigits(buf + 5, 2);
+  const auto day = parseFixedDigits(buf + 8, 2);
+  if (year < 0 || month < 0 || day < 0) {
+    return false;
+  }
+  const auto expected = daysSinceEpochFromDate(year, month, day);
+  if (expected.hasError()) {
+    return false;
+  }
+  daysSinceEpoch = expected.value();
+  return true;
+}
+
+// Fast path for the common YYYY-MM-DD HH:MM:SS[.fraction] timestamps, with a
+// 'T' instead of the space in the modes that allow it. Returns false for the
+// other strings, which go through tryParseTimestampString().
+bool tryParseIsoTimestamp(
+    const char* buf,
+    size_t len,
+    Timestamp& result,
+    TimestampParseMode parseMode) {
+  static constexpr size_t kSecondsLength = 19;
+  if (len < kSecondsLength || buf[13] != ':' || buf[16] != ':') {
+    return false;
+  }
+  const char separator = buf[10];
+  const bool validSeparator = parseMode == TimestampParseMode::kIso8601
+      ? separator == 'T'
+      : separator == ' ' ||
+          (separator == 'T' && parseMode != TimestampParseMode::kPrestoCast);
+  int64_t daysSinceEpoch;
+  if (!validSeparator || !tryParseIsoDate(buf, 10, daysSinceEpoch)) {
+    return false;
+  }
+  const auto hour = parseFixedDigits(buf + 11, 2);
+  const auto minute = parseFixedDigits(buf + 14, 2);
+  const auto second = parseFixedDigits(buf + 17, 2);
+  if (hour < 0 || hour >= 24 || minute < 0 || minute >= 60 || second < 0 ||
+      second > 60) {
+    return false;
+  }
+  int32_t micros = 0;
+  if (len > kSecondsLength) {
+    if (buf[kSecondsLength] != '.' || len == kSecondsLength + 1) {
+      return false;
+    }
+    // Digits after the microseconds are ignored.
+    int32_t multiplier = 100'000;
+    for (auto pos = kSecondsLength + 1; pos < len; ++pos, multiplier /= 10) {
+      if (!characterIsDigit(buf[pos])) {
+        return false;
+      }
+      micros += (buf[pos] - '0') * multiplier;
+    }
+  }
+  result = fromDatetime(daysSinceEpoch, fromTime(hour, minute, second, micros));
+  return true;
+}
+
 } // namespace
 
 bool isLeapYear(int32_t year) {
@@ -859,6 +939,9 @@ Expected<int32_t> fromDateString(const char* str, size_t len, ParseMode mode) {
   int64_t daysSinceEpoch;
   size_t pos = 0;
 
+  if (tryParseIsoDate(str, len, daysSinceEpoch)) {
+    return daysSinceEpoch;
+  }
   if (!tryParseDateString(str, len, pos, daysSinceEpoch, mode)) {
     if (threadSkipErrorDetails()) {
       return folly::makeUnexpected(Status::UserError());
@@ -961,6 +1044,9 @@ fromTimestampString(const char* str, size_t len, TimestampParseMode parseMode) {
   size_t pos = 0;
   Timestamp resultTimestamp;
 
+  if (tryParseIsoTimestamp(str, len, resultTimestamp, parseMode)) {
+    return resultTimestamp;
+  }
   if (!tryParseTimestampString(str, len, pos, resultTimestamp, parseMode)) {
     return folly::makeUnexpected(parserError(str, len));
   }
@@ -981,6 +1067,9 @@ Expected<ParsedTimestampWithTimeZone> fromTimestampWithTimezoneString(
   size_t pos = 0;
   Timestamp resultTimestamp;
 
+  if (tryParseIsoTimestamp(str, len, resultTimestamp, parseMode)) {
+    return {{resultTimestamp, nullptr, std::nullopt}};
+  }
   if (!tryParseTimestampString(str, len, pos, resultTimestamp, parseMode)) {
     return folly::makeUnexpected(parserError(str, len));
   }
@@ -527,6 +527,47 @@ TEST_F(ConversionsTest, toIntegralTypes) {
         /*expectError*/ true);
   }
 
+  // From strings of up to 18 digits, which are parsed 8 digits at a time,
+  // and longer strings, which fall back to folly.
+  {
+    testConversion<std::string, int64_t>(
+        {
+            "0",
+            "-0",
+            "00000000123",
+            "12345678",
+            "-123456789",
+            "123456789012345678",
+            "-123456789012345678",
+            "9223372036854775807",
+            "-9223372036854775808",
+            "+12345678",
+        },
+        {
+            0,
+            0,
+            123,
+            12'345'678,
+            -123'456'789,
+            123'456'789'012'345'678,
+            -123'456'789'012'345'678,
+            std::numeric_limits<int64_t>::max(),
+            std::numeric_limits<int64_t>::min(),
+            12'345'678,
+        },
+        /*truncate*/ false);
+    testConversion<std::string, int8_t>(
+        {"127", "-128"}, {127, -128}, /*truncate*/ false);
+    testConversion<std::string, int8_t>(
+        {"128", "-129"}, {}, /*truncate*/ false, false, /*expectError*/ true);
+    testConversion<std::string, int64_t>(
+        {"1234567a", "12345678a", "1234:678", "-", "9223372036854775808"},
+        {},
+        /*truncate*/ false,
+        false,
+        /*expectError*/ true);
+  }
+
   // From integral types.
   {
     // When TRUNCATE = false.
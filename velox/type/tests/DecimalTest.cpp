@@ -402,6 +402,59 @@ TEST(DecimalAggregateTest, adjustSumForOverflow) {
   EXPECT_FALSE(accumulator.adjustedSum().has_value());
 }
 
+TEST(DecimalAggregateTest, batchSum) {
+  auto validate = [](const std::vector<int128_t>& values) {
+    int128_t expectedSum = 0;
+    int64_t expectedOverflow = 0;
+    DecimalUtil::BatchSum batchSum;
+    for (auto value : values) {
+      expectedOverflow +=
+          DecimalUtil::addWithOverflow(expectedSum, expectedSum, value);
+      batchSum.add(value);
+    }
+    int128_t sum;
+    int64_t overflow;
+    batchSum.finish(sum, overflow);
+    ASSERT_EQ(
+        DecimalUtil::adjustSumForOverflow(sum, overflow),
+        DecimalUtil::adjustSumForOverflow(expectedSum, expectedOverflow));
+  };
+
+  const auto max = DecimalUtil::kLongDecimalMax;
+  const auto min = DecimalUtil::kLongDecimalMin;
+  validate({});
+  validate({1, -2, 3});
+  validate({-1, -1, -1});
+  validate({max, max, min});
+  validate({min, min, max});
+  validate({max, max, max, min, min});
+  validate({min, min, min, max, max, max, -7});
+  // Overflows that do not cancel out.
+  validate({max, max});
+  validate({min, min});
+
+  // Many overflows in both directions that cancel out.
+  std::vector<int128_t> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(max - i);
+  }
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(min + 2 * i);
+  }
+  validate(values);
+
+  // Short decimals widen to 128 bits.
+  DecimalUtil::BatchSum batchSum;
+  batchSum.add<int64_t>(std::numeric_limits<int64_t>::min());
+  batchSum.add<int64_t>(-1);
+  int128_t sum;
+  int64_t overflow;
+  batchSum.finish(sum, overflow);
+  ASSERT_EQ(
+      DecimalUtil::adjustSumForOverflow(sum, overflow),
+      int128_t(std::numeric_limits<int64_t>::min()) - 1);
+}
+
 TEST(DecimalTest, rescaleDouble) {
   assertRescaleDouble(-3333.03, DECIMAL(10, 4), -33'330'300);
   assertRescaleDouble(-3333.03, DECIMAL(20, 1), -33'330);
@@ -679,6 +679,64 @@ TEST(FilterTest, bigintValuesUsingBloomFilterMergeWith) {
   }
 }
 
+TEST(FilterTest, bytesValuesUsingBloomFilter) {
+  BytesValuesUsingBloomFilter filter(10, false);
+  folly::F14FastSet<std::string> inserted;
+  for (const auto* value : {"apple", "banana", "a much longer value", ""}) {
+    filter.insert(value);
+    inserted.insert(value);
+  }
+  ASSERT_FALSE(filter.testNull());
+  for (const auto* value :
+       {"apple", "banana", "a much longer value", "", "pear", "applf"}) {
+    ASSERT_EQ(
+        filter.testBytes(value, strlen(value)), inserted.contains(value));
+  }
+  ASSERT_TRUE(filter.testLength(100));
+  ASSERT_TRUE(filter.testBytesRange("x", "y", false));
+  Filter::registerSerDe();
+  auto deserialized = ISerializable::deserialize<BytesValuesUsingBloomFilter>(
+      filter.serialize());
+  ASSERT_TRUE(deserialized->testingEquals(filter));
+  filter.insert("pear");
+  ASSERT_TRUE(filter.testBytes("pear", 4));
+  ASSERT_FALSE(deserialized->testingEquals(filter));
+  auto nullAllowedClone = filter.clone(true);
+  ASSERT_TRUE(nullAllowedClone->testNull());
+  ASSERT_TRUE(nullAllowedClone->clone(false)->testingEquals(filter));
+}
+
+TEST(FilterTest, bytesValuesUsingBloomFilterMergeWith) {
+  BytesValuesUsingBloomFilter filter(4, false);
+  for (const auto* value : {"a", "bb", "ccc"}) {
+    filter.insert(value);
+  }
+  auto test = [&](const Filter& other, const Filter& expected) {
+    auto merged = filter.mergeWith(&other);
+    ASSERT_TRUE(merged->testingEquals(expected));
+    auto merged2 = other.mergeWith(&filter);
+    ASSERT_TRUE(merged->testingEquals(*merged2));
+  };
+  {
+    SCOPED_TRACE("BytesValues");
+    test(
+        BytesValues({"a", "ccc", "dddd"}, true),
+        BytesValues({"a", "ccc"}, false));
+  }
+  {
+    SCOPED_TRACE("BytesRange");
+    BytesRange other("a", false, false, "b", false, false, false);
+    test(other, other);
+  }
+  {
+    SCOPED_TRACE("IsNotNull");
+    test(IsNotNull(), filter);
+  }
+  // Merging with a bloom filter on integers is an error.
+  BigintValuesUsingBloomFilter bigintFilter(4, false);
+  EXPECT_THROW(filter.mergeWith(&bigintFilter), VeloxRuntimeError);
+}
+
 TEST(FilterTest, bigintMultiRange) {
   // x between 1 and 10 or x between 100 and 120
   auto filter = bigintOr(between(1, 10), between(100, 120));
@@ -1133,6 +1191,32 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesLarge) {
+  // Values with a shared prefix, an empty value and lengths above 256.
+  std::vector<std::string> values;
+  values.push_back("");
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(fmt::format("prefix-{}", i * 2));
+  }
+  values.push_back(std::string(300, 'x'));
+  auto filter = in(values);
+  for (auto i = 0; i < 20'000; ++i) {
+    const auto value = fmt::format("prefix-{}", i);
+    EXPECT_EQ(testBytes(*filter, value), i % 2 == 0) << value;
+  }
+  EXPECT_TRUE(testBytes(*filter, ""));
+  EXPECT_TRUE(testBytes(*filter, std::string(300, 'x')));
+  EXPECT_FALSE(testBytes(*filter, std::string(300, 'y')));
+  EXPECT_FALSE(testBytes(*filter, std::string(301, 'x')));
+  EXPECT_TRUE(filter->testLength(0));
+  EXPECT_TRUE(filter->testLength(300));
+  EXPECT_FALSE(filter->testLength(299));
+
+  auto copy = filter->clone();
+  EXPECT_TRUE(testBytes(*copy, "prefix-10"));
+  EXPECT_FALSE(testBytes(*copy, "prefix-11"));
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
@@ -313,3 +313,82 @@ TEST(StringView, linearSearch) {
 
 } // namespace
 } // namespace facebook::velox
+
+TEST(StringView, comparePrefix) {
+  std::vector<std::string> strings = {
+      "",
+      "a",
+      "abc",
+      "abcd",
+      "abcde",
+      "abcdefghijkl",
+      "abcdefghijklm",
+      "abcdefghijklz",
+      "abce",
+      "abcezzzzzzzzzzzz",
+      "b"};
+  for (const auto& left : strings) {
+    for (const auto& right : strings) {
+      StringView leftView(left);
+      StringView rightView(right);
+      const auto expected = leftView.compare(rightView);
+      const auto result = leftView.comparePrefix(rightView);
+      if (result.has_value()) {
+        EXPECT_EQ(expected < 0, *result < 0) << left << " vs " << right;
+        EXPECT_EQ(expected == 0, *result == 0) << left << " vs " << right;
+      } else {
+        // Only strings that are both out of line with the same prefix need
+        // their out of line data.
+        EXPECT_FALSE(leftView.isInline() && rightView.isInline());
+        EXPECT_EQ(
+            std::string_view(left).substr(0, 4),
+            std::string_view(right).substr(0, 4));
+      }
+    }
+  }
+}
+
+TEST(StringView, equalsBatch) {
+  constexpr int32_t kSize = 1003;
+  std::vector<std::string> left(kSize);
+  std::vector<std::string> right(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    // Sizes from 0 to 30 with an occasional difference in the first, the
+    // inlined or the last byte.
+    left[i] = std::string(i % 31, 'a' + i % 3);
+    right[i] = left[i];
+    if (!right[i].empty()) {
+      switch (i % 7) {
+        case 1:
+          right[i].front() = 'x';
+          break;
+        case 2:
+          right[i][right[i].size() / 2] = 'x';
+          break;
+        case 3:
+          right[i].back() = 'x';
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  std::vector<StringView> leftViews(kSize);
+  std::vector<StringView> rightViews(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    leftViews[i] = StringView(left[i]);
+    // Every 5th pair shares the out of line data.
+    rightViews[i] = i % 5 == 0 ? leftViews[i] : StringView(right[i]);
+  }
+
+  for (auto size : {0, 1, 2, 3, 64, 65, kSize}) {
+    std::vector<uint64_t> result(bits::nwords(size), ~0UL);
+    StringView::equalsBatch(
+        leftViews.data(), rightViews.data(), size, result.data());
+    for (auto i = 0; i < size; ++i) {
+      EXPECT_EQ(
+          leftViews[i] == rightViews[i], bits::isBitSet(result.data(), i))
+          << i;
+    }
+  }
+}
@@ -210,6 +210,7 @@ TEST(DateTimeUtilTest, daysSinceEpochFromWeekOfMonthDateNonLenient) {
 TEST(DateTimeUtilTest, fromDateString) {
   for (ParseMode mode : {ParseMode::kPrestoCast, ParseMode::kSparkCast}) {
     EXPECT_EQ(0, parseDate("1970-01-01", mode));
+    EXPECT_EQ(19782, parseDate("2024-02-29", mode));
     EXPECT_EQ(3789742, parseDate("12345-12-18", mode));
 
     EXPECT_EQ(1, parseDate("1970-1-2", mode));
@@ -276,6 +277,8 @@ TEST(DateTimeUtilTest, fromDateStringInvalid) {
     testCastFromDateStringInvalid("2015.03.18", mode);
     testCastFromDateStringInvalid("20150318", mode);
     testCastFromDateStringInvalid("2015-031-8", mode);
+    testCastFromDateStringInvalid("2023-02-29", mode);
+    testCastFromDateStringInvalid("2015-13-01", mode);
   }
 
   testCastFromDateStringInvalid("-1-1-1", ParseMode::kSparkCast);
@@ -310,6 +313,22 @@ TEST(DateTimeUtilTest, fromTimestampString) {
   EXPECT_EQ(
       Timestamp(946729316, 0),
       parseTimestamp("2000-01-01T12:21:56", TimestampParseMode::kIso8601));
+
+  // Fractions of seconds. Digits after the microseconds are ignored.
+  EXPECT_EQ(
+      Timestamp(946729316, 500'000'000),
+      parseTimestamp("2000-01-01 12:21:56.5"));
+  EXPECT_EQ(
+      Timestamp(946729316, 123'456'000),
+      parseTimestamp("2000-01-01 12:21:56.123456789"));
+  EXPECT_EQ(
+      Timestamp(946729316, 123'000'000),
+      parseTimestamp(
+          "2000-01-01T12:21:56.123", TimestampParseMode::kSparkCast));
+  EXPECT_EQ(
+      Timestamp(946729316, 0),
+      parseTimestamp("2000-01-01T12:21:56", TimestampParseMode::kLegacyCast));
+  EXPECT_EQ(Timestamp(946729320, 0), parseTimestamp("2000-01-01 12:21:60"));
 }
 
 TEST(DateTimeUtilTest, fromTimestampStringInvalid) {
@@ -335,6 +354,16 @@ TEST(DateTimeUtilTest, fromTimestampStringInvalid) {
   VELOX_ASSERT_THROW(
       parseTimestamp("1970-01-01 00:00:00 America/Los_Angeles"), parserError);
 
+  // Invalid time fields.
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 24:00:00"), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 12:60:00"), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 12:21:56."), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-02-30 12:21:56"), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01T12:21:56"), parserError);
+  VELOX_ASSERT_THROW(
+      parseTimestamp("2000-01-01 12:21:56", TimestampParseMode::kIso8601),
+      parserError);
+
   // Cannot have spaces after T.
   VELOX_ASSERT_THROW(
       parseTimestamp("2000-01-01T 12:21:56", TimestampParseMode::kIso8601),
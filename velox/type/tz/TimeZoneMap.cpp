@@ -451,24 +451,121 @@ std::vector<int16_t> getTimeZoneIDs() {
   return ids;
 }
 
+const TimeZone::Transitions& TimeZone::transitions() const {
+  folly::call_once(transitionsOnce_, [&]() {
+    auto& begins = transitions_.begins;
+    auto& offsets = transitions_.offsets;
+    auto current = kMinTransitionSeconds;
+    while (current < kMaxTransitionSeconds) {
+      const auto info = tz_->get_info(date::sys_seconds{seconds{current}});
+      const auto offset = static_cast<int32_t>(info.offset.count());
+      // Changes of the abbreviation or the daylight savings with the same
+      // offset do not matter for the conversions.
+      if (offsets.empty() || offsets.back() != offset) {
+        begins.push_back(current);
+        offsets.push_back(offset);
+      }
+      const auto end = info.end.time_since_epoch().count();
+      VELOX_CHECK_GT(end, current);
+      current = end;
+    }
+    for (auto i = 1; i < begins.size(); ++i) {
+      if (begins[i] + offsets[i] <= begins[i - 1] + offsets[i - 1]) {
+        transitions_.localBeginsSorted = false;
+        break;
+      }
+    }
+  });
+  return transitions_;
+}
+
+int32_t TimeZone::findTransition(int64_t seconds) const {
+  if (seconds < kMinTransitionSeconds || seconds >= kMaxTransitionSeconds) {
+    return -1;
+  }
+  const auto& begins = transitions().begins;
+  return std::upper_bound(begins.begin(), begins.end(), seconds) -
+      begins.begin() - 1;
+}
+
+std::optional<int32_t> TimeZone::findUniqueLocalOffset(int64_t seconds) const {
+  // Local times this close to the covered range may have their GMT time
+  // outside of it.
+  static constexpr int64_t kMargin = 2 * 86'400;
+  const auto& [begins, offsets, localBeginsSorted] = transitions();
+  if (!localBeginsSorted || seconds < kMinTransitionSeconds + kMargin ||
+      seconds >= kMaxTransitionSeconds - kMargin) {
+    return std::nullopt;
+  }
+  // Finds the last offset that starts at or before local 'seconds'.
+  int32_t low = 0;
+  int32_t high = begins.size();
+  while (low < high) {
+    const auto mid = (low + high) / 2;
+    if (begins[mid] + offsets[mid] <= seconds) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  const auto index = low - 1;
+  if (index < 0) {
+    return std::nullopt;
+  }
+  // In the gap before the next offset.
+  if (index + 1 < begins.size() &&
+      seconds - offsets[index] >= begins[index + 1]) {
+    return std::nullopt;
+  }
+  // Also in the overlap with the previous offset.
+  if (index > 0 && seconds - offsets[index - 1] < begins[index]) {
+    return std::nullopt;
+  }
+  return offsets[index];
+}
+
 TimeZone::seconds TimeZone::to_sys(
     TimeZone::seconds timestamp,
     TimeZone::TChoose choose) const {
+  if (tz_ != nullptr) {
+    if (const auto offset = findUniqueLocalOffset(timestamp.count())) {
+      return timestamp - seconds(*offset);
+    }
+  }
   return toSysImpl(timestamp, choose, tz_, offset_);
 }
 
 TimeZone::milliseconds TimeZone::to_sys(
     TimeZone::milliseconds timestamp,
     TimeZone::TChoose choose) const {
+  if (tz_ != nullptr) {
+    if (const auto offset = findUniqueLocalOffset(
+            std::chrono::floor<seconds>(timestamp).count())) {
+      return timestamp - seconds(*offset);
+    }
+  }
   return toSysImpl(timestamp, choose, tz_, offset_);
 }
 
 TimeZone::seconds TimeZone::to_local(TimeZone::seconds timestamp) const {
+  if (tz_ != nullptr) {
+    const auto index = findTransition(timestamp.count());
+    if (index >= 0) {
+      return timestamp + seconds(transitions_.offsets[index]);
+    }
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
 TimeZone::milliseconds TimeZone::to_local(
     TimeZone::milliseconds timestamp) const {
+  if (tz_ != nullptr) {
+    const auto index =
+        findTransition(std::chrono::floor<seconds>(timestamp).count());
+    if (index >= 0) {
+      return timestamp + seconds(transitions_.offsets[index]);
+    }
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
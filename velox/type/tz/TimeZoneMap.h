@@ -21,6 +21,8 @@
 #include <string>
 #include <vector>
 
+#include <folly/synchronization/CallOnce.h>
+
 namespace facebook::velox::tzdb {
 class time_zone;
 }
@@ -194,10 +196,40 @@ class TimeZone {
       TChoose choose = TChoose::kFail) const;
 
  private:
+  // GMT seconds from which 'transitions_' covers the time zone, 1900-01-01.
+  static constexpr int64_t kMinTransitionSeconds = -2'208'988'800;
+  // GMT seconds up to which 'transitions_' covers the time zone, 2100-01-01.
+  static constexpr int64_t kMaxTransitionSeconds = 4'102'444'800;
+
+  // The offsets of the time zone between kMinTransitionSeconds and
+  // kMaxTransitionSeconds. Offset 'i' applies from GMT second 'begins[i]'
+  // to 'begins[i + 1]'. Built on first use since looking up the tz database
+  // for each value is slow.
+  struct Transitions {
+    std::vector<int64_t> begins;
+    std::vector<int32_t> offsets;
+    // True if the local times at which the offsets start are increasing,
+    // so that local times can be looked up with a binary search.
+    bool localBeginsSorted{true};
+  };
+
+  const Transitions& transitions() const;
+
+  // Returns the index in 'transitions_' of the offset for GMT 'seconds' or
+  // -1 if 'seconds' is not covered.
+  int32_t findTransition(int64_t seconds) const;
+
+  // Returns the offset for local 'seconds' if it maps to exactly one GMT
+  // time and std::nullopt if it is ambiguous, nonexistent or not covered.
+  std::optional<int32_t> findUniqueLocalOffset(int64_t seconds) const;
+
   const tzdb::time_zone* tz_{nullptr};
   const std::chrono::minutes offset_{0};
   const std::string timeZoneName_;
   const int16_t timeZoneID_;
+
+  mutable folly::once_flag transitionsOnce_;
+  mutable Transitions transitions_;
 };
 
 } // namespace facebook::velox::tz
@@ -19,6 +19,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/date.h"
+#include "velox/external/tzdb/time_zone.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
 namespace facebook::velox::tz {
@@ -116,6 +117,48 @@ TEST(TimeZoneMapTest, offsetToSys) {
   EXPECT_NE(toSysTime("-07:00", ts), toSysTime("America/Los_Angeles", ts));
 }
 
+TEST(TimeZoneMapTest, cachedTransitions) {
+  // Seconds from 1901 to 2099 in steps of a little over 7 hours, so that
+  // the steps cover all hours and minutes over the years.
+  static constexpr int64_t kBegin = -2'177'452'800;
+  static constexpr int64_t kEnd = 4'070'908'800;
+  static constexpr int64_t kStep = 7 * 3'600 + 61;
+
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Australia/Lord_Howe",
+        "Pacific/Apia",
+        "Asia/Kolkata"}) {
+    SCOPED_TRACE(name);
+    const auto* zone = locateZone(name);
+    const auto* tz = zone->tz();
+    for (auto ts = kBegin; ts < kEnd; ts += kStep) {
+      const date::sys_seconds sys{seconds{ts}};
+      ASSERT_EQ(
+          zone->to_local(seconds{ts}), tz->to_local(sys).time_since_epoch())
+          << ts;
+
+      const date::local_seconds local{seconds{ts}};
+      ASSERT_EQ(
+          zone->to_sys(seconds{ts}, TimeZone::TChoose::kEarliest),
+          tz->to_sys(local, tzdb::choose::earliest).time_since_epoch())
+          << ts;
+      ASSERT_EQ(
+          zone->to_sys(seconds{ts}, TimeZone::TChoose::kLatest),
+          tz->to_sys(local, tzdb::choose::latest).time_since_epoch())
+          << ts;
+    }
+  }
+
+  // Ambiguous and nonexistent local times still throw by default.
+  const auto* zone = locateZone("America/Los_Angeles");
+  // 2024-11-03 01:30:00 happened twice.
+  EXPECT_THROW(zone->to_sys(seconds{1730597400}), tzdb::ambiguous_local_time);
+  // 2024-03-10 02:30:00 did not happen.
+  EXPECT_THROW(zone->to_sys(seconds{1710037800}), tzdb::nonexistent_local_time);
+}
+
 TEST(TimeZoneMapTest, timePointBoundary) {
   using namespace date;
 
@@ -25,6 +25,7 @@
 #include <folly/Format.h>
 #include <folly/Range.h>
 #include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
 
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
@@ -51,6 +52,9 @@ class VectorPool;
 class BaseVector;
 using VectorPtr = std::shared_ptr<BaseVector>;
 
+/// The buffers counted by BaseVector::retainedSize(RetainedBufferSet&).
+using RetainedBufferSet = folly::F14FastSet<const Buffer*>;
+
 /// Set of options that validate() accepts.
 struct VectorValidateOptions {
   /// If set to true then an unloaded lazy vector is loaded and validate is
@@ -800,7 +804,7 @@ class BaseVector {
   /// Returns the byte size of memory that is kept live through 'this'.
   uint64_t retainedSize() const {
     uint64_t totalStringBufferSize{0};
-    return retainedSizeImpl(totalStringBufferSize);
+    return retainedSizeImpl(totalStringBufferSize, nullptr);
   }
 
   /// Returns the byte size of memory that is kept live through 'this'. Also add
@@ -808,7 +812,26 @@ class BaseVector {
   /// totalStringBufferSize. To get the total size of all string buffers, set
   /// the initial value of totalStringBufferSize to 0 when calling this method.
   uint64_t retainedSize(uint64_t& totalStringBufferSize) const {
-    return retainedSizeImpl(totalStringBufferSize);
+    return retainedSizeImpl(totalStringBufferSize, nullptr);
+  }
+
+  /// Same as retainedSize() but counts a buffer shared by several vectors,
+  /// e.g. a string buffer shared by the slices of a vector or a dictionary base
+  /// wrapped by several columns, only once. Skips the buffers already in
+  /// 'retainedBuffers' and adds the counted ones to it, so the same set can be
+  /// passed for several vectors to get the memory kept live by all of them.
+  uint64_t retainedSize(RetainedBufferSet& retainedBuffers) const {
+    uint64_t totalStringBufferSize{0};
+    return retainedSizeImpl(totalStringBufferSize, &retainedBuffers);
+  }
+
+  /// Same as retainedSize(uint64_t&) if 'retainedBuffers' is null, or as
+  /// retainedSize(RetainedBufferSet&) otherwise. The string buffers are added
+  /// to 'totalStringBufferSize' only when they are counted.
+  uint64_t retainedSize(
+      uint64_t& totalStringBufferSize,
+      RetainedBufferSet* retainedBuffers) const {
+    return retainedSizeImpl(totalStringBufferSize, retainedBuffers);
   }
 
   /// Returns an estimate of the 'retainedSize' of a flat representation of the
@@ -992,12 +1015,30 @@ class BaseVector {
   }
 
   virtual uint64_t retainedSizeImpl(
-      uint64_t& /*totalStringBufferSize*/) const = 0;
+      uint64_t& /*totalStringBufferSize*/,
+      RetainedBufferSet* /*retainedBuffers*/) const = 0;
 
   uint64_t retainedSizeImpl() const {
     return nulls_ ? nulls_->capacity() : 0;
   }
 
+  uint64_t retainedSizeImpl(RetainedBufferSet* retainedBuffers) const {
+    return retainedBufferSize(nulls_, retainedBuffers);
+  }
+
+  /// Returns the capacity of 'buffer', or 0 if 'buffer' is null or already in
+  /// 'retainedBuffers'. Adds 'buffer' to 'retainedBuffers' if not null.
+  static uint64_t retainedBufferSize(
+      const BufferPtr& buffer,
+      RetainedBufferSet* retainedBuffers) {
+    if (buffer == nullptr ||
+        (retainedBuffers != nullptr &&
+         !retainedBuffers->insert(buffer.get()).second)) {
+      return 0;
+    }
+    return buffer->capacity();
+  }
+
   TypePtr type_;
   const TypeKind typeKind_;
   // Whether `type_` is a type that provides custom comparison operations.
@@ -196,8 +196,10 @@ class BiasVector : public SimpleVector<T> {
 #endif
 
   uint64_t retainedSizeImpl(
-      uint64_t& /*totalStringBufferSize*/) const override {
-    return BaseVector::retainedSizeImpl() + values_->capacity();
+      uint64_t& /*totalStringBufferSize*/,
+      RetainedBufferSet* retainedBuffers) const override {
+    return BaseVector::retainedSizeImpl(retainedBuffers) +
+        retainedBufferSize(values_, retainedBuffers);
   }
 
   TypeKind valueType_;
@@ -284,11 +284,13 @@ class RowVector : public BaseVector {
       vector_size_t count,
       vector_size_t childSize);
 
-  uint64_t retainedSizeImpl(uint64_t& totalStringBufferSize) const override {
-    auto size = BaseVector::retainedSizeImpl();
+  uint64_t retainedSizeImpl(
+      uint64_t& totalStringBufferSize,
+      RetainedBufferSet* retainedBuffers) const override {
+    auto size = BaseVector::retainedSizeImpl(retainedBuffers);
     for (auto& child : children_) {
       if (child) {
-        size += child->retainedSize(totalStringBufferSize);
+        size += child->retainedSize(totalStringBufferSize, retainedBuffers);
       }
     }
     return size;
@@ -553,9 +555,13 @@ class ArrayVector : public ArrayVectorBase {
   void validate(const VectorValidateOptions& options) const override;
 
  private:
-  uint64_t retainedSizeImpl(uint64_t& totalStringBufferSize) const override {
-    return BaseVector::retainedSizeImpl() + offsets_->capacity() +
-        sizes_->capacity() + elements_->retainedSize(totalStringBufferSize);
+  uint64_t retainedSizeImpl(
+      uint64_t& totalStringBufferSize,
+      RetainedBufferSet* retainedBuffers) const override {
+    return BaseVector::retainedSizeImpl(retainedBuffers) +
+        retainedBufferSize(offsets_, retainedBuffers) +
+        retainedBufferSize(sizes_, retainedBuffers) +
+        elements_->retainedSize(totalStringBufferSize, retainedBuffers);
   }
 
   VectorPtr elements_;
@@ -746,10 +752,14 @@ class MapVector : public ArrayVectorBase {
   std::shared_ptr<MapVector> updateImpl(
       const folly::Range<DecodedVector*>& others) const;
 
-  uint64_t retainedSizeImpl(uint64_t& totalStringBufferSize) const override {
-    return BaseVector::retainedSizeImpl() + offsets_->capacity() +
-        sizes_->capacity() + keys_->retainedSize(totalStringBufferSize) +
-        values_->retainedSize(totalStringBufferSize);
+  uint64_t retainedSizeImpl(
+      uint64_t& totalStringBufferSize,
+      RetainedBufferSet* retainedBuffers) const override {
+    return BaseVector::retainedSizeImpl(retainedBuffers) +
+        retainedBufferSize(offsets_, retainedBuffers) +
+        retainedBufferSize(sizes_, retainedBuffers) +
+        keys_->retainedSize(totalStringBufferSize, retainedBuffers) +
+        values_->retainedSize(totalStringBufferSize, retainedBuffers);
   }
 
   VectorPtr keys_;
@@ -478,14 +478,18 @@ class ConstantVector final : public SimpleVector<T> {
     *BaseVector::nulls_->asMutable<uint64_t>() = bits::kNull64;
   }
 
-  uint64_t retainedSizeImpl(uint64_t& totalStringBufferSize) const override {
+  uint64_t retainedSizeImpl(
+      uint64_t& totalStringBufferSize,
+      RetainedBufferSet* retainedBuffers) const override {
     VELOX_DCHECK(initialized_);
     if (valueVector_) {
-      return valueVector_->retainedSize(totalStringBufferSize);
+      return valueVector_->retainedSize(totalStringBufferSize, retainedBuffers);
     }
     if (stringBuffer_) {
-      totalStringBufferSize += stringBuffer_->capacity();
-      return stringBuffer_->capacity();
+      const auto bufferSize =
+          retainedBufferSize(stringBuffer_, retainedBuffers);
+      totalStringBufferSize += bufferSize;
+      return bufferSize;
     }
     return sizeof(T);
   }
@@ -266,10 +266,13 @@ class DictionaryVector : public SimpleVector<T> {
 
   void setInternalState();
 
-  uint64_t retainedSizeImpl(uint64_t& totalStringBufferSize) const override {
-    return BaseVector::retainedSizeImpl() +
-        dictionaryValues_->retainedSize(totalStringBufferSize) +
-        indices_->capacity();
+  uint64_t retainedSizeImpl(
+      uint64_t& totalStringBufferSize,
+      RetainedBufferSet* retainedBuffers) const override {
+    return BaseVector::retainedSizeImpl(retainedBuffers) +
+        dictionaryValues_->retainedSize(
+            totalStringBufferSize, retainedBuffers) +
+        retainedBufferSize(indices_, retainedBuffers);
   }
 
   BufferPtr indices_;
@@ -462,6 +462,83 @@ VectorPtr newRow(
       options.pool, source.type(), std::move(nulls), size, std::move(children));
 }
 
+vector_size_t numNestedRows(
+    const ArrayVectorBase& source,
+    const folly::Range<const BaseVector::CopyRange*>& ranges) {
+  vector_size_t numRows = 0;
+  for (auto& range : ranges) {
+    for (vector_size_t i = 0; i < range.count; ++i) {
+      auto j = range.sourceIndex + i;
+      if (!source.isNullAt(j)) {
+        numRows += source.sizeAt(j);
+      }
+    }
+  }
+  return numRows;
+}
+
+// Returns a copy of 'ranges' in 'source' that references the nested vectors of
+// 'source' at their original offsets instead of copying them.  Slices 'source'
+// if there is a single range.  Returns nullptr if 'ranges' reference too small
+// a part of the nested vectors and these should be compacted into a copy.
+VectorPtr tryShareNested(
+    const EncodedVectorCopyOptions& options,
+    const VectorPtr& source,
+    const folly::Range<const BaseVector::CopyRange*>& ranges,
+    vector_size_t nestedSize) {
+  VELOX_DCHECK(options.reuseSource);
+  auto& vector = *source->asUnchecked<ArrayVectorBase>();
+  if (numNestedRows(vector, ranges) <
+      options.compactNestedThreshold * nestedSize) {
+    return nullptr;
+  }
+  if (ranges.size() == 1 && ranges[0].targetIndex == 0) {
+    if (ranges[0].sourceIndex == 0 && ranges[0].count == source->size()) {
+      return source;
+    }
+    return source->slice(ranges[0].sourceIndex, ranges[0].count);
+  }
+  auto size = newTargetSize(ranges);
+  auto nulls = newNulls(size, options.pool, source->rawNulls(), ranges);
+  auto offsets = allocateIndices(size, options.pool);
+  auto sizes = allocateIndices(size, options.pool);
+  auto* rawOffsets = offsets->asMutable<vector_size_t>();
+  auto* rawSizes = sizes->asMutable<vector_size_t>();
+  for (auto& range : ranges) {
+    for (vector_size_t i = 0; i < range.count; ++i) {
+      auto j = range.sourceIndex + i;
+      auto k = range.targetIndex + i;
+      if (vector.isNullAt(j)) {
+        rawOffsets[k] = 0;
+        rawSizes[k] = 0;
+      } else {
+        rawOffsets[k] = vector.offsetAt(j);
+        rawSizes[k] = vector.sizeAt(j);
+      }
+    }
+  }
+  if (source->encoding() == VectorEncoding::Simple::MAP) {
+    auto* map = source->asUnchecked<MapVector>();
+    return std::make_shared<MapVector>(
+        options.pool,
+        source->type(),
+        std::move(nulls),
+        size,
+        std::move(offsets),
+        std::move(sizes),
+        map->mapKeys(),
+        map->mapValues());
+  }
+  return std::make_shared<ArrayVector>(
+      options.pool,
+      source->type(),
+      std::move(nulls),
+      size,
+      std::move(offsets),
+      std::move(sizes),
+      source->asUnchecked<ArrayVector>()->elements());
+}
+
 VectorPtr newMap(
     const EncodedVectorCopyOptions& options,
     const MapVector& source,
@@ -965,6 +1042,32 @@ void copyIntoComplex(
       std::move(nulls), std::move(indices), size, target);
 }
 
+void copyIntoFlatMap(
+    const EncodedVectorCopyOptions& options,
+    const VectorPtr& sourceBase,
+    const DecodedVector& decodedSource,
+    const folly::Range<const BaseVector::CopyRange*>& ranges,
+    VectorPtr& target,
+    bool targetMutable) {
+  VELOX_CHECK(
+      decodedSource.isIdentityMapping() &&
+          sourceBase->encoding() == VectorEncoding::Simple::FLAT_MAP,
+      "EncodedVectorCopy copyInto FlatMapVector requires a flat map source.");
+  if (!targetMutable) {
+    BaseVector::CopyRange range{0, 0, target->size()};
+    target = newFlatMap(
+        options,
+        *target->asUnchecked<FlatMapVector>(),
+        folly::Range(&range, 1));
+  }
+  // FlatMapVector::copyRanges() writes into the map values in place, so copy
+  // on write the parts shared with other vectors.
+  target->ensureWritable(SelectivityVector::empty());
+  target->resize(targetSize(target->size(), ranges));
+  target->copyRanges(sourceBase.get(), ranges);
+  setSourceNulls(sourceBase->rawNulls(), *target, ranges);
+}
+
 void copyIntoLazy(
     const EncodedVectorCopyOptions& options,
     const VectorPtr& source,
@@ -1043,8 +1146,9 @@ void copyIntoExisting(
           options, decodedSource, sourceBase, ranges, target, targetMutable);
       break;
     case VectorEncoding::Simple::FLAT_MAP:
-      VELOX_UNSUPPORTED(
-          "EncodedVectorCopy copyInto does not support FlatMapVector.");
+      copyIntoFlatMap(
+          options, sourceBase, decodedSource, ranges, target, targetMutable);
+      break;
     case VectorEncoding::Simple::LAZY:
       copyIntoLazy(options, source, ranges, target, targetMutable);
       break;
@@ -1099,12 +1203,28 @@ void copyImpl(
     case VectorEncoding::Simple::ROW:
       target = newRow(options, *source->asUnchecked<RowVector>(), ranges);
       break;
-    case VectorEncoding::Simple::MAP:
-      target = newMap(options, *source->asUnchecked<MapVector>(), ranges);
+    case VectorEncoding::Simple::MAP: {
+      auto* map = source->asUnchecked<MapVector>();
+      if (options.reuseSource) {
+        target =
+            tryShareNested(options, source, ranges, map->mapKeys()->size());
+      }
+      if (!target) {
+        target = newMap(options, *map, ranges);
+      }
       break;
-    case VectorEncoding::Simple::ARRAY:
-      target = newArray(options, *source->asUnchecked<ArrayVector>(), ranges);
+    }
+    case VectorEncoding::Simple::ARRAY: {
+      auto* array = source->asUnchecked<ArrayVector>();
+      if (options.reuseSource) {
+        target =
+            tryShareNested(options, source, ranges, array->elements()->size());
+      }
+      if (!target) {
+        target = newArray(options, *array, ranges);
+      }
       break;
+    }
     case VectorEncoding::Simple::FLAT_MAP:
       target =
           newFlatMap(options, *source->asUnchecked<FlatMapVector>(), ranges);
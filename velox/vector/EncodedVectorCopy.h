@@ -26,7 +26,10 @@ struct EncodedVectorCopyOptions {
   memory::MemoryPool* pool;
 
   /// Whether we can reuse any part from the source vector in target.  If this
-  /// is true, the source and target must have the same memory pool.
+  /// is true, the source and target must have the same memory pool.  A new
+  /// ARRAY or MAP target then shares the nested vectors of the source instead
+  /// of copying them, unless it references less than
+  /// `compactNestedThreshold' of them.
   bool reuseSource;
 
   /// How many nested rows in ARRAY or MAP need to be referenced in order to
@@ -408,12 +408,13 @@ class FlatMapVector : public BaseVector {
       CompareFlags flags) const;
 
   uint64_t retainedSizeImpl(
-      uint64_t& /*totalStringBufferSize*/) const override {
+      uint64_t& /*totalStringBufferSize*/,
+      RetainedBufferSet* retainedBuffers) const override {
     // TODO: since FlatMapVector didn't override BaseVector::retainedSize(),
     // this override of retainedSizeImpl keeps the original behavior of
     // FlatMapVector::retainedSize(). We should update this method to reflect
     // the actual memory usage of FlatMapVector.
-    return BaseVector::retainedSizeImpl();
+    return BaseVector::retainedSizeImpl(retainedBuffers);
   }
 
   // Vector containing the distinct map keys.
@@ -436,13 +436,24 @@ VectorPtr FlatVector<T>::slice(vector_size_t offset, vector_size_t length)
           Buffer::slice<T>(values_, offset, newNumValues - offset, this->pool_);
     }
   }
-  return std::make_shared<FlatVector<T>>(
+  auto result = std::make_shared<FlatVector<T>>(
       this->pool_,
       this->type_,
       this->sliceNulls(offset, length),
       length,
       std::move(values),
       std::vector<BufferPtr>(stringBuffers_));
+  if constexpr (std::is_same_v<T, StringView>) {
+    // The slice is all ASCII if all the sliced rows are known to be.
+    if (this->asciiInfo.isAllAscii()) {
+      auto computedRows = this->asciiInfo.readLockedAsciiComputedRows();
+      if (computedRows->size() >= offset + length &&
+          bits::isAllSet(computedRows->allBits(), offset, offset + length)) {
+        result->setAllIsAscii(true);
+      }
+    }
+  }
+  return result;
 }
 
 template <typename T>
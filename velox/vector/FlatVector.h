@@ -588,12 +588,15 @@ class FlatVector final : public SimpleVector<T> {
   // should not have string buffers.
   void transferAndUpdateStringBuffers(velox::memory::MemoryPool* pool);
 
-  uint64_t retainedSizeImpl(uint64_t& totalStringBufferSize) const override {
-    auto size =
-        BaseVector::retainedSizeImpl() + (values_ ? values_->capacity() : 0);
+  uint64_t retainedSizeImpl(
+      uint64_t& totalStringBufferSize,
+      RetainedBufferSet* retainedBuffers) const override {
+    auto size = BaseVector::retainedSizeImpl(retainedBuffers) +
+        retainedBufferSize(values_, retainedBuffers);
     for (auto& buffer : stringBuffers_) {
-      size += buffer->capacity();
-      totalStringBufferSize += buffer->capacity();
+      const auto bufferSize = retainedBufferSize(buffer, retainedBuffers);
+      size += bufferSize;
+      totalStringBufferSize += bufferSize;
     }
     return size;
   }
@@ -34,6 +34,13 @@ class Callable {
 
   virtual bool hasCapture() const = 0;
 
+  /// True if any capture is not constant. Constant captures are broadcast to
+  /// the rows of 'apply' without a 'wrapCapture' mapping, so that callers need
+  /// to build the mapping only if this is true.
+  virtual bool hasNonConstantCapture() const {
+    return hasCapture();
+  }
+
   /// Applies 'this' to 'args' for 'rows' and returns the result in
   /// '*result'.
   /// @param rows The rows that this callable applies to. It is the element rows
@@ -208,7 +215,8 @@ class FunctionVector : public BaseVector {
 
  private:
   uint64_t retainedSizeImpl(
-      uint64_t& /*totalStringBufferSize*/) const override {
+      uint64_t& /*totalStringBufferSize*/,
+      RetainedBufferSet* /*retainedBuffers*/) const override {
     VELOX_UNREACHABLE("retainedSize should not be called on FunctionVector");
   }
 
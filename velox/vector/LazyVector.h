@@ -427,9 +427,12 @@ class LazyVector : public BaseVector {
 
   void loadVectorInternal() const;
 
-  uint64_t retainedSizeImpl(uint64_t& totalStringBufferSize) const override {
-    return isLoaded() ? loadedVector()->retainedSize(totalStringBufferSize)
-                      : BaseVector::retainedSizeImpl();
+  uint64_t retainedSizeImpl(
+      uint64_t& totalStringBufferSize,
+      RetainedBufferSet* retainedBuffers) const override {
+    return isLoaded()
+        ? loadedVector()->retainedSize(totalStringBufferSize, retainedBuffers)
+        : BaseVector::retainedSizeImpl(retainedBuffers);
   }
 
   std::unique_ptr<VectorLoader> loader_;
@@ -220,9 +220,12 @@ class SequenceVector : public SimpleVector<T> {
 
   bool checkLoadRange(size_t idx, size_t count) const;
 
-  uint64_t retainedSizeImpl(uint64_t& totalStringBufferSize) const override {
-    return sequenceValues_->retainedSize(totalStringBufferSize) +
-        sequenceLengths_->capacity();
+  uint64_t retainedSizeImpl(
+      uint64_t& totalStringBufferSize,
+      RetainedBufferSet* retainedBuffers) const override {
+    return sequenceValues_->retainedSize(
+               totalStringBufferSize, retainedBuffers) +
+        retainedBufferSize(sequenceLengths_, retainedBuffers);
   }
 
   VectorPtr sequenceValues_;
@@ -31,6 +31,7 @@ void StringVectorBuffer::appendByte(int8_t value) {
   ensureCapacity(1);
   VELOX_CHECK_GT(writableCapacity(), 0, "No writable capacity");
   rawBuffer_[currentPosition_++] = value;
+  isAscii_ &= value >= 0;
 }
 
 void StringVectorBuffer::flushRow(vector_size_t rowId) {
@@ -46,6 +46,13 @@ class StringVectorBuffer {
   /// Sets the row at 'rowId' with current buffered data without data copy.
   void flushRow(vector_size_t rowId);
 
+  /// Records on the vector whether the appended bytes are all ASCII for
+  /// 'rows', the flushed rows, so that string functions take their ASCII
+  /// paths without scanning the rows.
+  void setIsAscii(const SelectivityVector& rows) {
+    vector_->setIsAscii(isAscii_, rows);
+  }
+
  private:
   FOLLY_ALWAYS_INLINE size_t writableCapacity() const {
     VELOX_CHECK_GE(currentCapacity_, currentPosition_);
@@ -83,6 +90,8 @@ class StringVectorBuffer {
   size_t currentCapacity_ = 0;
   // The total size of the buffers have been allocated.
   size_t totalCapacity_ = 0;
+  // True if all the appended bytes are ASCII.
+  bool isAscii_ = true;
 };
 
 } // namespace facebook::velox
@@ -51,6 +51,9 @@ struct CompressionStats {
   // Bytes for which compression was not attempted because of past
   // non-performance.
   int64_t compressionSkippedBytes{0};
+
+  // CPU time spent compressing.
+  uint64_t compressionCpuNanos{0};
 };
 
 /// Serializer that can iteratively build up a buffer of serialized rows from
@@ -135,6 +138,8 @@ class IterativeVectorSerializer {
   /// The number of bytes that skip in-efficient compression.
   static inline const std::string kCompressionSkippedBytes{
       "compressionSkippedBytes"};
+  /// The CPU time spent compressing.
+  static inline const std::string kCompressionCpuNanos{"compressionCpuNanos"};
 
   /// Returns serializer-dependent counters, e.g. about compression, data
   /// distribution, encoding etc.
@@ -210,6 +215,9 @@ class VectorSerde {
     kPresto,
     kCompactRow,
     kUnsafeRow,
+    kColumnar,
+    kStreamDictionary,
+    kStringReference,
   };
 
   static std::string kindName(Kind type);
@@ -315,6 +315,9 @@ const char* exportArrowFormatStr(
     // Complex/nested types.
     case TypeKind::ARRAY:
       static_assert(sizeof(vector_size_t) == 4);
+      if (options.exportToListView) {
+        return "+vl"; // list view
+      }
       return "+l"; // list
     case TypeKind::MAP:
       return "+m"; // map
@@ -788,6 +791,15 @@ void exportViews(
   holder.resizeBuffers(numBuffers);
   out.buffers = holder.getArrowBuffers();
 
+  // The views are rewritten below, so they are copied rather than shared with
+  // 'vec'. The string buffers are shared.
+  auto views = AlignedBuffer::allocate<StringView>(out.length, pool);
+  auto* rawViews = views->asMutable<StringView>();
+  const auto* rawValues = vec.rawValues();
+  vector_size_t numViews = 0;
+  rows.apply([&](vector_size_t i) { rawViews[numViews++] = rawValues[i]; });
+  holder.setBuffer(1, views);
+
   // Given the difference b/w structures of the non-inline Arrow Utf8View and
   // Velox::StringView as
   //
@@ -835,9 +847,10 @@ void exportViews(
   int32_t bufferIdxCache = 0;
   uint64_t bufferAddrCache = 0;
 
+  vector_size_t index = 0;
   rows.apply([&](vector_size_t i) {
     auto view = const_cast<uint32_t*>(
-        reinterpret_cast<const uint32_t*>(&utf8Views[2 * i]));
+        reinterpret_cast<const uint32_t*>(&utf8Views[2 * index++]));
     if (!vec.isNullAt(i) && view[0] > 12) {
       const uint64_t currAddr = *reinterpret_cast<uint64_t*>(&view[2]);
       // 2. Search for correct index with the buffer-pointer as key. Cache the
@@ -924,7 +937,6 @@ void exportFlat(
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
       if (options.exportToStringView) {
-        exportValues(vec, rows, options, out, pool, holder);
         exportViews(
             *vec.asUnchecked<FlatVector<StringView>>(),
             rows,
@@ -1051,6 +1063,50 @@ void exportArrays(
   out.children = holder.getChildrenArrays();
 }
 
+// Exports 'vec' as an Arrow ListView sharing the offsets, sizes and elements
+// of 'vec'. Only the offsets and sizes of the selected rows are gathered if
+// 'rows' is a subset, and the offsets and sizes of null rows are zeroed since
+// Velox does not guarantee that they are in bounds. The elements are always
+// exported whole.
+void exportListViews(
+    const ArrayVector& vec,
+    const Selection& rows,
+    const ArrowOptions& options,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  out.n_buffers = 3;
+  if (!rows.changed() && !vec.mayHaveNulls()) {
+    holder.setBuffer(1, vec.offsets());
+    holder.setBuffer(2, vec.sizes());
+  } else {
+    auto offsets = AlignedBuffer::allocate<vector_size_t>(out.length, pool);
+    auto sizes = AlignedBuffer::allocate<vector_size_t>(out.length, pool);
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    auto* rawSizes = sizes->asMutable<vector_size_t>();
+    vector_size_t j = 0;
+    rows.apply([&](vector_size_t i) {
+      const bool isNull = vec.isNullAt(i);
+      rawOffsets[j] = isNull ? 0 : vec.offsetAt(i);
+      rawSizes[j] = isNull ? 0 : vec.sizeAt(i);
+      ++j;
+    });
+    holder.setBuffer(1, offsets);
+    holder.setBuffer(2, sizes);
+  }
+
+  const auto& elements = *vec.elements()->loadedVector();
+  holder.resizeChildren(1);
+  exportToArrowImpl(
+      elements,
+      Selection(elements.size()),
+      options,
+      *holder.allocateChild(0),
+      pool);
+  out.n_children = 1;
+  out.children = holder.getChildrenArrays();
+}
+
 void exportMaps(
     const MapVector& vec,
     const Selection& rows,
@@ -1243,8 +1299,21 @@ void exportToArrowImpl(
           *vec.asUnchecked<RowVector>(), rows, options, out, pool, *holder);
       break;
     case VectorEncoding::Simple::ARRAY:
-      exportArrays(
-          *vec.asUnchecked<ArrayVector>(), rows, options, out, pool, *holder);
+      options.exportToListView
+          ? exportListViews(
+                *vec.asUnchecked<ArrayVector>(),
+                rows,
+                options,
+                out,
+                pool,
+                *holder)
+          : exportArrays(
+                *vec.asUnchecked<ArrayVector>(),
+                rows,
+                options,
+                out,
+                pool,
+                *holder);
       break;
     case VectorEncoding::Simple::MAP:
       exportMaps(
@@ -1375,6 +1444,15 @@ TypePtr importFromArrowImpl(
           VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
           return ARRAY(importFromArrow(*arrowSchema.children[0]));
 
+        // List view.
+        case 'v':
+          if (format[2] == 'l') {
+            VELOX_CHECK_EQ(arrowSchema.n_children, 1);
+            VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
+            return ARRAY(importFromArrow(*arrowSchema.children[0]));
+          }
+          break;
+
         // Map.
         case 'm': {
           VELOX_CHECK_EQ(arrowSchema.n_children, 1);
@@ -1702,12 +1780,24 @@ ArrayVectorPtr createArrayVector(
     bool isViewer,
     WrapInBufferViewFunc wrapInBufferView) {
   static_assert(sizeof(vector_size_t) == sizeof(int32_t));
-  VELOX_CHECK_EQ(arrowArray.n_buffers, 2);
   VELOX_CHECK_EQ(arrowArray.n_children, 1);
-  auto offsets = wrapInBufferView(
-      arrowArray.buffers[1], (arrowArray.length + 1) * sizeof(vector_size_t));
-  auto sizes =
-      computeSizes(offsets->as<vector_size_t>(), arrowArray.length, pool);
+  BufferPtr offsets;
+  BufferPtr sizes;
+  if (strcmp(arrowSchema.format, "+vl") == 0) {
+    // ListView has the same layout as ArrayVector.
+    VELOX_CHECK_EQ(arrowArray.n_buffers, 3);
+    offsets = wrapInBufferView(
+        arrowArray.buffers[1], arrowArray.length * sizeof(vector_size_t));
+    sizes = wrapInBufferView(
+        arrowArray.buffers[2], arrowArray.length * sizeof(vector_size_t));
+  } else {
+    VELOX_CHECK_EQ(arrowArray.n_buffers, 2);
+    offsets = wrapInBufferView(
+        arrowArray.buffers[1],
+        (arrowArray.length + 1) * sizeof(vector_size_t));
+    sizes =
+        computeSizes(offsets->as<vector_size_t>(), arrowArray.length, pool);
+  }
   auto elements = importFromArrowImpl(
       *arrowSchema.children[0], *arrowArray.children[0], pool, isViewer);
   return std::make_shared<ArrayVector>(
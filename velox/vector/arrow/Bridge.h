@@ -40,6 +40,9 @@ struct ArrowOptions {
   std::optional<std::string> timestampTimeZone{std::nullopt};
   // Export VARCHAR and VARBINARY to Arrow 15 StringView format
   bool exportToStringView = false;
+  // Export ARRAY to Arrow ListView format. The offsets, sizes and elements of
+  // the ArrayVector are referenced as is instead of being compacted.
+  bool exportToListView = false;
 };
 
 namespace facebook::velox {
@@ -616,6 +616,39 @@ TEST_F(ArrowBridgeArrayExportTest, flatString) {
   testFlatVector<std::string>({});
 }
 
+TEST_F(ArrowBridgeArrayExportTest, flatStringView) {
+  const ArrowOptions options{.exportToStringView = true};
+  auto vec = vectorMaker_.flatVectorNullable<std::string>({
+      "my string",
+      "another slightly longer string",
+      std::nullopt,
+      "",
+      "another even longer string to ensure it's for sure not stored inline!!!",
+  });
+  const auto expected = BaseVector::copy(*vec);
+
+  // Exporting twice checks that the views of 'vec' are left as is.
+  for (auto i = 0; i < 2; ++i) {
+    auto array = toArrow(vec, options, pool_.get());
+    ASSERT_OK(array->ValidateFull());
+    ASSERT_EQ(*array->type(), *arrow::utf8_view());
+    auto& views = static_cast<const arrow::StringViewArray&>(*array);
+    ASSERT_EQ(views.length(), 5);
+    EXPECT_EQ(views.GetView(1), "another slightly longer string");
+    EXPECT_TRUE(views.IsNull(2));
+    EXPECT_EQ(views.GetView(3), "");
+    EXPECT_EQ(
+        views.GetView(4),
+        "another even longer string to ensure it's for sure not stored "
+        "inline!!!");
+    // The string buffers are shared.
+    EXPECT_EQ(
+        views.data_buffers()[0]->data(),
+        vec->asFlatVector<StringView>()->stringBuffers()[0]->as<uint8_t>());
+    test::assertEqualVectors(expected, vec);
+  }
+}
+
 TEST_F(ArrowBridgeArrayExportTest, rowVector) {
   std::vector<std::optional<int64_t>> col1 = {1, 2, 3, 4};
   std::vector<std::optional<double>> col2 = {99.9, 88.8, 77.7, std::nullopt};
@@ -895,6 +928,55 @@ TEST_F(ArrowBridgeArrayExportTest, arrayNested) {
   EXPECT_EQ(values.Value(1), 1);
 }
 
+TEST_F(ArrowBridgeArrayExportTest, arrayListView) {
+  const ArrowOptions options{.exportToListView = true};
+  auto elements = vectorMaker_.flatVector<int64_t>({1, 2, 3, 4, 5});
+  auto offsets = makeBuffer<vector_size_t>({3, 0, 1});
+  auto sizes = makeBuffer<vector_size_t>({2, 3, 0});
+  auto vec = std::make_shared<ArrayVector>(
+      pool_.get(), ARRAY(BIGINT()), nullptr, 3, offsets, sizes, elements);
+
+  // Offsets, sizes and elements are exported without copies.
+  ArrowArray data;
+  velox::exportToArrow(vec, data, pool_.get(), options);
+  ASSERT_EQ(data.n_buffers, 3);
+  EXPECT_EQ(data.buffers[1], offsets->as<void>());
+  EXPECT_EQ(data.buffers[2], sizes->as<void>());
+  ASSERT_EQ(data.n_children, 1);
+  EXPECT_EQ(data.children[0]->length, 5);
+  EXPECT_EQ(data.children[0]->buffers[1], elements->values()->as<void>());
+  data.release(&data);
+
+  auto array = toArrow(vec, options, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  ASSERT_EQ(*array->type(), *arrow::list_view(arrow::int64()));
+  auto& listView = static_cast<const arrow::ListViewArray&>(*array);
+  EXPECT_EQ(listView.value_offset(0), 3);
+  EXPECT_EQ(listView.value_length(0), 2);
+  EXPECT_EQ(listView.value_offset(1), 0);
+  EXPECT_EQ(listView.value_length(1), 3);
+  EXPECT_EQ(listView.value_length(2), 0);
+
+  // Offsets and sizes of null rows are zeroed.
+  vec->setNull(0, true);
+  array = toArrow(vec, options, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  EXPECT_EQ(array->null_count(), 1);
+  auto& nullableListView = static_cast<const arrow::ListViewArray&>(*array);
+  EXPECT_EQ(nullableListView.value_offset(0), 0);
+  EXPECT_EQ(nullableListView.value_length(0), 0);
+  EXPECT_EQ(nullableListView.value_length(1), 3);
+
+  ArrowSchema schema;
+  velox::exportToArrow(vec, schema, options);
+  velox::exportToArrow(vec, data, pool_.get(), options);
+  EXPECT_STREQ(schema.format, "+vl");
+  auto result = importFromArrowAsViewer(schema, data, pool_.get());
+  test::assertEqualVectors(vec, result);
+  schema.release(&schema);
+  data.release(&data);
+}
+
 TEST_F(ArrowBridgeArrayExportTest, mapSimple) {
   auto allOnes = [](vector_size_t) { return 1; };
   auto vec =
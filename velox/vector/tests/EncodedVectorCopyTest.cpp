@@ -648,6 +648,30 @@ TEST_P(EncodedVectorCopyTest, flatMapVector) {
         }),
         actual);
   }
+  {
+    SCOPED_TRACE("Copy into existing");
+    VectorPtr target = vectorMaker_.flatMapVector<int64_t, int64_t>({
+        {{1, 11}},
+        {{5, 55}},
+    });
+    auto shared = target;
+    BaseVector::CopyRange range = {1, 1, 2};
+    copy(source, folly::Range(&range, 1), target);
+    test::assertEqualVectors(
+        vectorMaker_.flatMapVector<int64_t, int64_t>({
+            {{1, 11}},
+            {{2, 20}},
+            {{3, 30}},
+        }),
+        target);
+    // The vector held by another reference must not change.
+    test::assertEqualVectors(
+        vectorMaker_.flatMapVector<int64_t, int64_t>({
+            {{1, 11}},
+            {{5, 55}},
+        }),
+        shared);
+  }
 
   // Complex values
   auto valueType = ROW({{"a", BIGINT()}});
@@ -701,6 +725,62 @@ TEST_P(EncodedVectorCopyTest, flatArray) {
       source, folly::Range(&range, 1), target, expected, expectedNewSliceCopy);
 }
 
+TEST_P(EncodedVectorCopyTest, flatArraySharedElements) {
+  auto sourceElements = makeFlatVector<int64_t>({1, 2, 3, 4});
+  auto source = makeArrayVector({0, 1, 2, 3}, sourceElements);
+  // Swap the halves of 'source'.
+  std::vector<BaseVector::CopyRange> ranges = {{2, 0, 2}, {0, 2, 2}};
+  VectorPtr target;
+  copy(source, ranges, target);
+  test::assertEqualVectors(
+      makeArrayVector<int64_t>({{3}, {4}, {1}, {2}}), target);
+  auto* targetArray = target->asChecked<ArrayVector>();
+  if (reuseSource()) {
+    ASSERT_EQ(targetArray->elements().get(), sourceElements.get());
+    ASSERT_EQ(targetArray->offsetAt(0), 2);
+  } else {
+    ASSERT_NE(targetArray->elements().get(), sourceElements.get());
+  }
+
+  // A single range is a slice.
+  BaseVector::CopyRange range = {1, 0, 3};
+  target = nullptr;
+  copy(source, folly::Range(&range, 1), target);
+  test::assertEqualVectors(source->slice(1, 3), target);
+  if (reuseSource()) {
+    ASSERT_EQ(
+        target->asChecked<ArrayVector>()->elements().get(),
+        sourceElements.get());
+  }
+
+  // Too few elements referenced for sharing.
+  range = {3, 0, 1};
+  target = nullptr;
+  copy(source, folly::Range(&range, 1), target);
+  test::assertEqualVectors(source->slice(3, 1), target);
+  ASSERT_EQ(target->asChecked<ArrayVector>()->elements()->size(), 1);
+}
+
+TEST_P(EncodedVectorCopyTest, flatMapSharedKeysAndValues) {
+  auto keys = makeFlatVector<int64_t>({1, 2, 3, 4});
+  auto values = makeFlatVector<int64_t>({5, 6, 7, 8});
+  auto source = makeMapVector({0, 1, 2, 3}, keys, values);
+  std::vector<BaseVector::CopyRange> ranges = {{2, 0, 2}, {0, 2, 2}};
+  VectorPtr target;
+  copy(source, ranges, target);
+  test::assertEqualVectors(
+      makeMapVector<int64_t, int64_t>(
+          {{{3, 7}}, {{4, 8}}, {{1, 5}}, {{2, 6}}}),
+      target);
+  auto* targetMap = target->asChecked<MapVector>();
+  if (reuseSource()) {
+    ASSERT_EQ(targetMap->mapKeys().get(), keys.get());
+    ASSERT_EQ(targetMap->mapValues().get(), values.get());
+  } else {
+    ASSERT_NE(targetMap->mapKeys().get(), keys.get());
+  }
+}
+
 TEST_P(EncodedVectorCopyTest, constantArray) {
   auto sourceElements = makeFlatVector<int64_t>({42, 43});
   auto source =
@@ -815,9 +895,6 @@ TEST_P(EncodedVectorCopyTest, fuzzerNewCopy) {
       test::assertEqualVectors(
           source->slice(range.sourceIndex, range.count), target);
     }
-
-    // Copy does not support copyInto non-null for FlatMapVector. Let's avoid
-    // throwing for these particular cases until there is support.
   }
 }
 
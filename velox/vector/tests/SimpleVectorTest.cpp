@@ -314,6 +314,24 @@ TEST_F(SimpleVectorNonParameterizedTest, isAscii) {
   }
 }
 
+TEST_F(SimpleVectorNonParameterizedTest, sliceKeepsAscii) {
+  auto vector = maker_.encodedVector(VectorEncoding::Simple::FLAT, stringData_);
+  // All but the first row are ASCII.
+  SelectivityVector rows(stringData_.size());
+  rows.setValid(0, false);
+  rows.updateBounds();
+  vector->computeAndSetIsAscii(rows);
+
+  auto slice = std::dynamic_pointer_cast<SimpleVector<StringView>>(
+      vector->slice(1, stringData_.size() - 1));
+  assertIsAscii(slice, SelectivityVector(slice->size()), true);
+
+  // A slice with rows of unknown asciiness stays unknown.
+  slice = std::dynamic_pointer_cast<SimpleVector<StringView>>(
+      vector->slice(0, 3));
+  ASSERT_FALSE(slice->isAscii(SelectivityVector(slice->size())).has_value());
+}
+
 TEST_F(SimpleVectorNonParameterizedTest, isAsciiIndex) {
   for (auto encoding : kAsciiEncodings) {
     LOG(INFO) << "Running:" << encoding;
@@ -144,4 +144,25 @@ TEST_F(StringVectorBufferTest, appendAndFlushMaxCapacity) {
       testAppendAndFlush(stringVec, 20, 20),
       "Cannot grow buffer with totalCapacity:20B to meet minRequiredCapacity:41B");
 }
+
+TEST_F(StringVectorBufferTest, isAscii) {
+  for (const auto& strings :
+       {std::vector<std::string>{"ascii", "only"},
+        std::vector<std::string>{"not", "\xc3\xa0scii"}}) {
+    auto vector = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), strings.size(), pool_.get());
+    StringVectorBuffer buffer(vector.get(), 10, 100);
+    for (auto i = 0; i < strings.size(); ++i) {
+      for (char c : strings[i]) {
+        buffer.appendByte(c);
+      }
+      buffer.flushRow(i);
+    }
+    SelectivityVector rows(strings.size());
+    buffer.setIsAscii(rows);
+    auto ascii = vector->isAscii(rows);
+    ASSERT_TRUE(ascii.has_value());
+    EXPECT_EQ(ascii.value(), strings[1] == "only");
+  }
+}
 } // namespace facebook::velox::test
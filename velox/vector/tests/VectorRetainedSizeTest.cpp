@@ -284,4 +284,43 @@ TEST_F(VectorRetainedSizeTest, sharedStringBuffers) {
   }
 }
 
+TEST_F(VectorRetainedSizeTest, dedupSharedBuffers) {
+  auto baseVector = makeFlatVector<std::string>(
+      1'000, [&](auto /*row*/) { return std::string(100, 'a'); });
+  auto indices = makeIndices(100, folly::identity);
+
+  // Two columns wrapping the same base count the base only once.
+  auto rowVector = makeRowVector({
+      wrapInDictionary(indices, 100, baseVector),
+      wrapInDictionary(indices, 100, baseVector),
+  });
+  const auto baseSize = baseVector->retainedSize();
+  const auto indicesSize = indices->capacity();
+  ASSERT_EQ(rowVector->retainedSize(), 2 * (baseSize + indicesSize));
+  RetainedBufferSet retainedBuffers;
+  ASSERT_EQ(rowVector->retainedSize(retainedBuffers), baseSize + indicesSize);
+
+  // The buffers already counted are skipped.
+  ASSERT_EQ(rowVector->retainedSize(retainedBuffers), 0);
+  ASSERT_EQ(baseVector->retainedSize(retainedBuffers), 0);
+
+  // The slices of a vector share its string buffers.
+  auto slice1 = baseVector->slice(0, 500);
+  auto slice2 = baseVector->slice(500, 500);
+  const auto stringBufferSize = getTotalStringBufferSize(baseVector);
+  uint64_t totalStringBufferSize = 0;
+  RetainedBufferSet sliceBuffers;
+  const auto sliceSize = slice1->retainedSize(sliceBuffers) +
+      slice2->retainedSize(totalStringBufferSize, &sliceBuffers);
+  ASSERT_EQ(
+      sliceSize,
+      slice1->retainedSize() + slice2->retainedSize() - stringBufferSize);
+  ASSERT_EQ(totalStringBufferSize, 0);
+
+  // Without sharing the result is the same as retainedSize().
+  auto flat = makeFlatVector<int32_t>(1'000, folly::identity);
+  RetainedBufferSet flatBuffers;
+  ASSERT_EQ(flat->retainedSize(flatBuffers), flat->retainedSize());
+}
+
 } // namespace facebook::velox::test